@@ -35,6 +35,14 @@ DEFINE_int32(meta_client_retry_interval_secs, 1, "meta client sleep interval bet
 DEFINE_int32(meta_client_timeout_ms, 60 * 1000, "meta client timeout");
 DEFINE_string(cluster_id_path, "cluster.id", "file path saved clusterId");
 DEFINE_int32(check_plan_killed_frequency, 8, "check plan killed every 1<<n times");
+DEFINE_int32(stats_load_interval_secs,
+             60,
+             "Interval in seconds graphd loads the statistics of all spaces made by the stats "
+             "jobs, which are used to estimate the rows of plans. 0 means not to load them");
+DEFINE_bool(meta_client_follower_read,
+            false,
+            "Whether the meta data loaded periodically is read from any metad, the followers of "
+            "which may lag behind the leader by meta_follower_read_max_lag logs of metad");
 DEFINE_uint32(failed_login_attempts,
               0,
               "how many consecutive incorrect passwords input to a SINGLE graph service node cause "
@@ -68,6 +76,7 @@ MetaClient::MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool
     : ioThreadPool_(ioThreadPool),
       addrs_(std::move(addrs)),
       options_(options),
+      leaders_(new LeaderCache()),
       metadata_(new MetaData()) {
   CHECK(ioThreadPool_ != nullptr) << "IOThreadPool is required";
   CHECK(!addrs_.empty())
@@ -85,6 +94,7 @@ MetaClient::MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool
 MetaClient::~MetaClient() {
   notifyStop();
   stop();
+  delete leaders_.load();
   delete metadata_.load();
   VLOG(3) << "~MetaClient";
 }
@@ -197,6 +207,42 @@ void MetaClient::heartBeatThreadFunc() {
   // if MetaServer has some changes, refresh the localCache_
   loadData();
   loadCfg();
+  if (options_.role_ == cpp2::HostRole::GRAPH) {
+    loadStats();
+  }
+}
+
+void MetaClient::loadStats() {
+  if (FLAGS_stats_load_interval_secs <= 0) {
+    return;
+  }
+  auto now = time::WallClock::fastNowInSec();
+  if (now - statsLoadTimeInSec_ < FLAGS_stats_load_interval_secs) {
+    return;
+  }
+  statsLoadTimeInSec_ = now;
+  decltype(stats_) stats;
+  // spaceIndexByName_ is only updated by loadData in the same thread
+  for (const auto& space : spaceIndexByName_) {
+    auto ret = getStats(space.second).get();
+    if (!ret.ok()) {
+      // The stats job has never run in the space
+      VLOG(2) << "Get stats of space " << space.first << " failed, status: " << ret.status();
+      continue;
+    }
+    auto item = std::move(ret).value();
+    if (item.get_status() != cpp2::JobStatus::FINISHED) {
+      // A new stats job is running, keep the statistics of the last one
+      auto last = getStatsFromCache(space.second);
+      if (last != nullptr) {
+        stats.emplace(space.second, std::move(last));
+      }
+      continue;
+    }
+    stats.emplace(space.second, std::make_shared<const cpp2::StatsItem>(std::move(item)));
+  }
+  folly::SharedMutex::WriteHolder holder(statsLock_);
+  stats_ = std::move(stats);
 }
 
 bool MetaClient::loadUsersAndRoles() {
@@ -304,6 +350,26 @@ bool MetaClient::loadData() {
 
   for (auto space : ret.value()) {
     auto spaceId = space.first;
+    // The spaces unchanged since the last load are reused, only their names are indexed again
+    auto lastIter = localCache_.find(spaceId);
+    if (changedSpaces_.has_value() && changedSpaces_->count(spaceId) == 0 &&
+        lastIter != localCache_.end()) {
+      auto spaceCache = std::make_shared<SpaceInfoCache>(*lastIter->second);
+      addSchemaNames(spaceId,
+                     *spaceCache,
+                     spaceTagIndexByName,
+                     spaceTagIndexById,
+                     spaceEdgeIndexByName,
+                     spaceEdgeIndexByType,
+                     spaceNewestTagVerMap,
+                     spaceNewestEdgeVerMap,
+                     spaceAllEdgeMap);
+      cache.emplace(spaceId, std::move(spaceCache));
+      spaceIndexByName.emplace(space.second, spaceId);
+      continue;
+    }
+    VLOG(2) << "Reload space " << spaceId;
+
     MetaClient::PartTerms partTerms;
     auto r = getPartsAlloc(spaceId, &partTerms).get();
     if (!r.ok()) {
@@ -387,16 +453,39 @@ bool MetaClient::loadData() {
   loadLeader(hostItems, spaceIndexByName_);
 
   localDataLastUpdateTime_.store(metadLastUpdateTime_.load());
+  changedSpaces_.reset();
   auto newMetaData = new MetaData();
 
+  // Only loadData publishes the snapshots, so the current one could be read without rcu here
+  const auto& lastCache = metadata_.load()->localCache_;
   for (auto& spaceInfo : localCache_) {
     GraphSpaceID spaceId = spaceInfo.first;
     std::shared_ptr<SpaceInfoCache> info = spaceInfo.second;
     std::shared_ptr<SpaceInfoCache> infoDeepCopy = std::make_shared<SpaceInfoCache>(*info);
-    infoDeepCopy->tagSchemas_ = buildTagSchemas(infoDeepCopy->tagItemVec_);
-    infoDeepCopy->edgeSchemas_ = buildEdgeSchemas(infoDeepCopy->edgeItemVec_);
-    infoDeepCopy->tagIndexes_ = buildIndexes(infoDeepCopy->tagIndexItemVec_);
-    infoDeepCopy->edgeIndexes_ = buildIndexes(infoDeepCopy->edgeIndexItemVec_);
+    // The schemas and the indexes unchanged are shared with the last snapshot rather than rebuilt,
+    // which are immutable once published
+    auto lastIter = lastCache.find(spaceId);
+    const SpaceInfoCache* last = lastIter == lastCache.end() ? nullptr : lastIter->second.get();
+    if (last != nullptr && last->tagItemVec_ == infoDeepCopy->tagItemVec_) {
+      infoDeepCopy->tagSchemas_ = last->tagSchemas_;
+    } else {
+      infoDeepCopy->tagSchemas_ = buildTagSchemas(infoDeepCopy->tagItemVec_);
+    }
+    if (last != nullptr && last->edgeItemVec_ == infoDeepCopy->edgeItemVec_) {
+      infoDeepCopy->edgeSchemas_ = last->edgeSchemas_;
+    } else {
+      infoDeepCopy->edgeSchemas_ = buildEdgeSchemas(infoDeepCopy->edgeItemVec_);
+    }
+    if (last != nullptr && last->tagIndexItemVec_ == infoDeepCopy->tagIndexItemVec_) {
+      infoDeepCopy->tagIndexes_ = last->tagIndexes_;
+    } else {
+      infoDeepCopy->tagIndexes_ = buildIndexes(infoDeepCopy->tagIndexItemVec_);
+    }
+    if (last != nullptr && last->edgeIndexItemVec_ == infoDeepCopy->edgeIndexItemVec_) {
+      infoDeepCopy->edgeIndexes_ = last->edgeIndexes_;
+    } else {
+      infoDeepCopy->edgeIndexes_ = buildIndexes(infoDeepCopy->edgeIndexItemVec_);
+    }
     newMetaData->localCache_[spaceId] = infoDeepCopy;
   }
   newMetaData->spaceIndexByName_ = spaceIndexByName_;
@@ -512,12 +601,34 @@ bool MetaClient::loadSchemas(GraphSpaceID spaceId,
 
   auto tagItemVec = tagRet.value();
   auto edgeItemVec = edgeRet.value();
-  allEdgeMap[spaceId] = {};
   spaceInfoCache->tagItemVec_ = tagItemVec;
   spaceInfoCache->tagSchemas_ = buildTagSchemas(tagItemVec);
   spaceInfoCache->edgeItemVec_ = edgeItemVec;
   spaceInfoCache->edgeSchemas_ = buildEdgeSchemas(edgeItemVec);
+  addSchemaNames(spaceId,
+                 *spaceInfoCache,
+                 tagNameIdMap,
+                 tagIdNameMap,
+                 edgeNameTypeMap,
+                 edgeTypeNameMap,
+                 newestTagVerMap,
+                 newestEdgeVerMap,
+                 allEdgeMap);
+  return true;
+}
 
+void MetaClient::addSchemaNames(GraphSpaceID spaceId,
+                                const SpaceInfoCache& spaceInfoCache,
+                                SpaceTagNameIdMap& tagNameIdMap,
+                                SpaceTagIdNameMap& tagIdNameMap,
+                                SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                                SpaceEdgeTypeNameMap& edgeTypeNameMap,
+                                SpaceNewestTagVerMap& newestTagVerMap,
+                                SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                                SpaceAllEdgeMap& allEdgeMap) {
+  const auto& tagItemVec = spaceInfoCache.tagItemVec_;
+  const auto& edgeItemVec = spaceInfoCache.edgeItemVec_;
+  allEdgeMap[spaceId] = {};
   for (auto& tagIt : tagItemVec) {
     tagNameIdMap.emplace(std::make_pair(spaceId, tagIt.get_tag_name()), tagIt.get_tag_id());
     tagIdNameMap.emplace(std::make_pair(spaceId, tagIt.get_tag_id()), tagIt.get_tag_name());
@@ -559,8 +670,6 @@ bool MetaClient::loadSchemas(GraphSpaceID spaceId,
             << ", Name " << edgeIt.get_edge_name() << ", Version " << edgeIt.get_version()
             << " Successfully!";
   }
-
-  return true;
 }
 
 Indexes buildIndexes(std::vector<cpp2::IndexItem> indexItemVec) {
@@ -786,6 +895,8 @@ void MetaClient::getResponse(Request req,
                      } else if (code == nebula::cpp2::ErrorCode::E_LEADER_CHANGED ||
                                 code == nebula::cpp2::ErrorCode::E_MACHINE_NOT_FOUND) {
                        updateLeader(resp.get_leader());
+                       // The followers which can't serve the read send it to the leader
+                       toLeader = true;
                        if (retry < retryLimit) {
                          evb->runAfterDelay(
                              [req = std::move(req),
@@ -1215,7 +1326,7 @@ void MetaClient::loadRemoteListeners() {
 
 /// ================================== public methods =================================
 
-PartitionID MetaClient::partId(int32_t numParts, const VertexID id) const {
+PartitionID MetaClient::partId(int32_t numParts, const VertexID& id) const {
   memory::MemoryCheckOffGuard g;
   // If the length of the id is 8, we will treat it as int64_t to be compatible
   // with the version 1.0
@@ -1294,7 +1405,8 @@ folly::Future<StatusOr<std::vector<SpaceIdName>>> MetaClient::listSpaces() {
       [this](cpp2::ListSpacesResp&& resp) -> decltype(auto) {
         return this->toSpaceIdName(resp.get_spaces());
       },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1308,7 +1420,8 @@ folly::Future<StatusOr<cpp2::SpaceItem>> MetaClient::getSpace(std::string name)
       std::move(req),
       [](auto client, auto request) { return client->future_getSpace(request); },
       [](cpp2::GetSpaceResp&& resp) -> decltype(auto) { return std::move(resp).get_item(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1397,6 +1510,21 @@ folly::Future<StatusOr<std::vector<cpp2::PartItem>>> MetaClient::listParts(
   return future;
 }
 
+folly::Future<StatusOr<std::vector<cpp2::HotPartItem>>> MetaClient::listHotParts(
+    GraphSpaceID spaceId) {
+  memory::MemoryCheckOffGuard g;
+  cpp2::ListHotPartsReq req;
+  req.space_id_ref() = spaceId;
+  folly::Promise<StatusOr<std::vector<cpp2::HotPartItem>>> promise;
+  auto future = promise.getFuture();
+  getResponse(
+      std::move(req),
+      [](auto client, auto request) { return client->future_listHotParts(request); },
+      [](cpp2::ListHotPartsResp&& resp) -> decltype(auto) { return resp.get_parts(); },
+      std::move(promise));
+  return future;
+}
+
 folly::Future<StatusOr<std::unordered_map<PartitionID, std::vector<HostAddr>>>>
 MetaClient::getPartsAlloc(GraphSpaceID spaceId, PartTerms* partTerms) {
   memory::MemoryCheckOffGuard g;
@@ -1419,7 +1547,8 @@ MetaClient::getPartsAlloc(GraphSpaceID spaceId, PartTerms* partTerms) {
         }
         return parts;
       },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1437,6 +1566,12 @@ StatusOr<GraphSpaceID> MetaClient::getSpaceIdByNameFromCache(const std::string&
   return Status::SpaceNotFound(fmt::format("SpaceName `{}`", name));
 }
 
+std::shared_ptr<const cpp2::StatsItem> MetaClient::getStatsFromCache(GraphSpaceID space) {
+  folly::SharedMutex::ReadHolder holder(statsLock_);
+  auto found = stats_.find(space);
+  return found == stats_.end() ? nullptr : found->second;
+}
+
 StatusOr<std::string> MetaClient::getSpaceNameByIdFromCache(GraphSpaceID spaceId) {
   memory::MemoryCheckOffGuard g;
   if (!ready_) {
@@ -1656,7 +1791,8 @@ folly::Future<StatusOr<std::vector<cpp2::TagItem>>> MetaClient::listTagSchemas(
       std::move(req),
       [](auto client, auto request) { return client->future_listTags(request); },
       [](cpp2::ListTagsResp&& resp) -> decltype(auto) { return std::move(resp).get_tags(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1752,7 +1888,8 @@ folly::Future<StatusOr<std::vector<cpp2::EdgeItem>>> MetaClient::listEdgeSchemas
       std::move(req),
       [](auto client, auto request) { return client->future_listEdges(request); },
       [](cpp2::ListEdgesResp&& resp) -> decltype(auto) { return std::move(resp).get_edges(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1875,7 +2012,8 @@ folly::Future<StatusOr<std::vector<cpp2::IndexItem>>> MetaClient::listTagIndexes
       std::move(req),
       [](auto client, auto request) { return client->future_listTagIndexes(request); },
       [](cpp2::ListTagIndexesResp&& resp) -> decltype(auto) { return std::move(resp).get_items(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -2000,7 +2138,8 @@ folly::Future<StatusOr<std::vector<cpp2::IndexItem>>> MetaClient::listEdgeIndexe
       [](cpp2::ListEdgeIndexesResp&& resp) -> decltype(auto) {
         return std::move(resp).get_items();
       },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -2394,26 +2533,31 @@ StatusOr<HostAddr> MetaClient::getStorageLeaderFromCache(GraphSpaceID spaceId, P
     return Status::Error("Not ready!");
   }
 
+  folly::rcu_reader guard;
+  auto* leaders = leaders_.load();
   {
-    folly::SharedMutex::ReadHolder holder(leadersLock_);
-    auto iter = leadersInfo_.leaderMap_.find({spaceId, partId});
-    if (iter != leadersInfo_.leaderMap_.end()) {
+    auto iter = leaders->leaderMap_.find({spaceId, partId});
+    if (iter != leaders->leaderMap_.end()) {
       return iter->second;
     }
   }
   {
-    // no leader found, pick one in round-robin
+    // no leader found, pick one in round-robin, the racing requests might pick the same one
     auto partHostsRet = getPartHostsFromCache(spaceId, partId);
     if (!partHostsRet.ok()) {
       return partHostsRet.status();
     }
     auto partHosts = partHostsRet.value();
-    folly::SharedMutex::WriteHolder wh(leadersLock_);
     VLOG(1) << "No leader exists. Choose one in round-robin.";
-    auto index = (leadersInfo_.pickedIndex_[{spaceId, partId}] + 1) % partHosts.hosts_.size();
+    size_t index = 0;
+    auto indexIter = leaders->pickedIndex_.find({spaceId, partId});
+    if (indexIter != leaders->pickedIndex_.end()) {
+      index = indexIter->second + 1;
+    }
+    index %= partHosts.hosts_.size();
     auto picked = partHosts.hosts_[index];
-    leadersInfo_.leaderMap_[{spaceId, partId}] = picked;
-    leadersInfo_.pickedIndex_[{spaceId, partId}] = index;
+    leaders->leaderMap_.insert_or_assign(std::make_pair(spaceId, partId), picked);
+    leaders->pickedIndex_.insert_or_assign(std::make_pair(spaceId, partId), index);
     return picked;
   }
 }
@@ -2423,15 +2567,15 @@ void MetaClient::updateStorageLeader(GraphSpaceID spaceId,
                                      const HostAddr& leader) {
   memory::MemoryCheckOffGuard g;
   VLOG(1) << "Update the leader for [" << spaceId << ", " << partId << "] to " << leader;
-  folly::SharedMutex::WriteHolder holder(leadersLock_);
-  leadersInfo_.leaderMap_[{spaceId, partId}] = leader;
+  folly::rcu_reader guard;
+  leaders_.load()->leaderMap_.insert_or_assign(std::make_pair(spaceId, partId), leader);
 }
 
 void MetaClient::invalidStorageLeader(GraphSpaceID spaceId, PartitionID partId) {
   memory::MemoryCheckOffGuard g;
   VLOG(1) << "Invalidate the leader for [" << spaceId << ", " << partId << "]";
-  folly::SharedMutex::WriteHolder holder(leadersLock_);
-  leadersInfo_.leaderMap_.erase({spaceId, partId});
+  folly::rcu_reader guard;
+  leaders_.load()->leaderMap_.erase({spaceId, partId});
 }
 
 StatusOr<LeaderInfo> MetaClient::getLeaderInfo() {
@@ -2439,8 +2583,16 @@ StatusOr<LeaderInfo> MetaClient::getLeaderInfo() {
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::SharedMutex::ReadHolder holder(leadersLock_);
-  return leadersInfo_;
+  LeaderInfo leaderInfo;
+  folly::rcu_reader guard;
+  const auto* leaders = leaders_.load();
+  for (const auto& [part, leader] : leaders->leaderMap_) {
+    leaderInfo.leaderMap_.emplace(part, leader);
+  }
+  for (const auto& [part, index] : leaders->pickedIndex_) {
+    leaderInfo.pickedIndex_.emplace(part, index);
+  }
+  return leaderInfo;
 }
 
 const std::vector<HostAddr>& MetaClient::getAddresses() {
@@ -2608,6 +2760,9 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
   req.host_ref() = options_.localHost_;
   req.role_ref() = options_.role_;
   req.git_info_sha_ref() = options_.gitInfoSHA_;
+  if (localDataLastUpdateTime_ >= 0) {
+    req.last_update_time_in_ms_ref() = localDataLastUpdateTime_.load();
+  }
   if (options_.role_ == cpp2::HostRole::STORAGE ||
       options_.role_ == cpp2::HostRole::STORAGE_LISTENER) {
     if (options_.clusterId_.load() == 0) {
@@ -2643,6 +2798,12 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
     } else {
       req.disk_parts_ref() = diskParts;
     }
+
+    if (listener_ != nullptr && options_.role_ == cpp2::HostRole::STORAGE) {
+      std::vector<cpp2::PartHotness> hotParts;
+      listener_->fetchHotParts(hotParts);
+      req.hot_parts_ref() = std::move(hotParts);
+    }
   }
 
   // info used in the agent, only set once
@@ -2680,6 +2841,12 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
         heartbeatTime_ = time::WallClock::fastNowInMilliSec();
         metadLastUpdateTime_ = resp.get_last_update_time_in_ms();
         VLOG(1) << "Metad last update time: " << metadLastUpdateTime_;
+        if (resp.changed_spaces_ref().has_value()) {
+          changedSpaces_.emplace(resp.changed_spaces_ref()->begin(),
+                                 resp.changed_spaces_ref()->end());
+        } else {
+          changedSpaces_.reset();
+        }
         metaServerVersion_ = resp.get_meta_version();
 
         bool succeeded = resp.get_code() == nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -2788,7 +2955,8 @@ folly::Future<StatusOr<std::unordered_map<std::string, std::string>>> MetaClient
       std::move(req),
       [](auto client, auto request) { return client->future_listUsers(request); },
       [](cpp2::ListUsersResp&& resp) -> decltype(auto) { return std::move(resp).get_users(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -2836,7 +3004,8 @@ folly::Future<StatusOr<std::vector<cpp2::RoleItem>>> MetaClient::getUserRoles(st
       std::move(req),
       [](auto client, auto request) { return client->future_getUserRoles(request); },
       [](cpp2::ListRolesResp&& resp) -> decltype(auto) { return std::move(resp).get_roles(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -3234,7 +3403,7 @@ Status MetaClient::refreshCache() {
 void MetaClient::loadLeader(const std::vector<cpp2::HostItem>& hostItems,
                             const SpaceNameIdMap& spaceIndexByName) {
   memory::MemoryCheckOffGuard g;
-  LeaderInfo leaderInfo;
+  auto leaders = std::make_unique<LeaderCache>();
   for (auto& item : hostItems) {
     for (auto& spaceEntry : item.get_leader_parts()) {
       auto spaceName = spaceEntry.first;
@@ -3245,7 +3414,8 @@ void MetaClient::loadLeader(const std::vector<cpp2::HostItem>& hostItems,
       }
       auto spaceId = iter->second;
       for (const auto& partId : spaceEntry.second) {
-        leaderInfo.leaderMap_[{spaceId, partId}] = item.get_hostAddr();
+        leaders->leaderMap_.insert_or_assign(std::make_pair(spaceId, partId),
+                                             item.get_hostAddr());
         auto partHosts = getPartHostsFromCache(spaceId, partId);
         size_t leaderIndex = 0;
         if (partHosts.ok()) {
@@ -3257,7 +3427,7 @@ void MetaClient::loadLeader(const std::vector<cpp2::HostItem>& hostItems,
             }
           }
         }
-        leaderInfo.pickedIndex_[{spaceId, partId}] = leaderIndex;
+        leaders->pickedIndex_.insert_or_assign(std::make_pair(spaceId, partId), leaderIndex);
       }
     }
     LOG(INFO) << "Load leader of " << item.get_hostAddr() << " in "
@@ -3267,8 +3437,10 @@ void MetaClient::loadLeader(const std::vector<cpp2::HostItem>& hostItems,
     // todo(doodle): in worst case, storage and meta isolated, so graph may get a outdate
     // leader info. The problem could be solved if leader term are cached as well.
     LOG(INFO) << "Load leader ok";
-    folly::SharedMutex::WriteHolder wh(leadersLock_);
-    leadersInfo_ = std::move(leaderInfo);
+    // The leaders updated in the old cache meanwhile are lost, they are found again by the
+    // storage clients
+    auto oldLeaders = leaders_.exchange(leaders.release());
+    folly::rcu_retire(oldLeaders);
   }
 }
 
@@ -169,6 +169,7 @@ class MetaChangedListener {
   virtual void fetchLeaderInfo(
       std::unordered_map<GraphSpaceID, std::vector<cpp2::LeaderInfo>>& leaders) = 0;
   virtual void fetchDiskParts(kvstore::SpaceDiskPartsMap& diskParts) = 0;
+  virtual void fetchHotParts(std::vector<cpp2::PartHotness>& hotParts) = 0;
   virtual void onListenerSpaceAdded(GraphSpaceID spaceId, cpp2::ListenerType type) = 0;
   virtual void onListenerSpaceRemoved(GraphSpaceID spaceId, cpp2::ListenerType type) = 0;
   virtual void onListenerPartAdded(GraphSpaceID spaceId,
@@ -248,6 +249,11 @@ class MetaClient : public BaseMetaClient {
 
   bool isMetadReady();
 
+  // The version of the local meta cache, it changes once the cache is reloaded
+  int64_t localDataVersion() const {
+    return localDataLastUpdateTime_.load();
+  }
+
   bool waitForMetadReady(int count = -1, int retryIntervalSecs = FLAGS_heartbeat_interval_secs);
 
   void notifyStop();
@@ -297,6 +303,9 @@ class MetaClient : public BaseMetaClient {
   folly::Future<StatusOr<std::vector<cpp2::PartItem>>> listParts(GraphSpaceID spaceId,
                                                                  std::vector<PartitionID> partIds);
 
+  // The hottest parts of the space reported by the storaged alive, the hottest first
+  folly::Future<StatusOr<std::vector<cpp2::HotPartItem>>> listHotParts(GraphSpaceID spaceId);
+
   using PartTerms = std::unordered_map<PartitionID, TermID>;
   folly::Future<StatusOr<PartsAlloc>> getPartsAlloc(GraphSpaceID spaceId,
                                                     MetaClient::PartTerms* partTerms = nullptr);
@@ -538,6 +547,10 @@ class MetaClient : public BaseMetaClient {
   // get all latest version edge
   StatusOr<std::vector<std::string>> getAllEdgeFromCache(const GraphSpaceID& space);
 
+  // The statistics of the last stats job of space finished, nullptr if there is none or the
+  // statistics are not loaded, only graphd loads them
+  std::shared_ptr<const cpp2::StatsItem> getStatsFromCache(GraphSpaceID space);
+
   PartsMap getPartsMapFromCache(const HostAddr& host);
 
   StatusOr<PartHosts> getPartHostsFromCache(GraphSpaceID spaceId, PartitionID partId);
@@ -548,7 +561,7 @@ class MetaClient : public BaseMetaClient {
 
   StatusOr<int32_t> partsNum(GraphSpaceID spaceId);
 
-  PartitionID partId(int32_t numParts, VertexID id) const;
+  PartitionID partId(int32_t numParts, const VertexID& id) const;
 
   StatusOr<std::shared_ptr<const NebulaSchemaProvider>> getTagSchemaFromCache(GraphSpaceID spaceId,
                                                                               TagID tagID,
@@ -686,8 +699,22 @@ class MetaClient : public BaseMetaClient {
                    SpaceNewestEdgeVerMap& newestEdgeVerMap,
                    SpaceAllEdgeMap& allEdgemap);
 
+  // Add the names and the newest versions of the schemas of the space to the maps
+  void addSchemaNames(GraphSpaceID spaceId,
+                      const SpaceInfoCache& spaceInfoCache,
+                      SpaceTagNameIdMap& tagNameIdMap,
+                      SpaceTagIdNameMap& tagIdNameMap,
+                      SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                      SpaceEdgeTypeNameMap& edgeTypeNameMap,
+                      SpaceNewestTagVerMap& newestTagVerMap,
+                      SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                      SpaceAllEdgeMap& allEdgeMap);
+
   bool loadUsersAndRoles();
 
+  // Load the statistics of all spaces every stats_load_interval_secs
+  void loadStats();
+
   bool loadIndexes(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCache> cache);
 
   bool loadListeners(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCache> cache);
@@ -773,13 +800,21 @@ class MetaClient : public BaseMetaClient {
   std::atomic<int64_t> localDataLastUpdateTime_{-1};
   std::atomic<int64_t> localCfgLastUpdateTime_{-1};
   std::atomic<int64_t> metadLastUpdateTime_{0};
+  // The spaces changed since localDataLastUpdateTime_ told by the last heartbeat, the others are
+  // not reloaded. None if unknown, then all are reloaded
+  std::optional<std::unordered_set<GraphSpaceID>> changedSpaces_;
 
   int64_t metaServerVersion_{-1};
   static constexpr int64_t EXPECT_META_VERSION = 4;
 
-  // leadersLock_ is used to protect leadersInfo
-  folly::SharedMutex leadersLock_;
-  LeaderInfo leadersInfo_;
+  // The leaders of the parts, looked up by each request to storage without a lock. It's replaced
+  // as a whole by loadLeader and retired by rcu, and its entries are updated in place when the
+  // storage clients find a leader changed.
+  struct LeaderCache {
+    folly::ConcurrentHashMap<std::pair<GraphSpaceID, PartitionID>, HostAddr> leaderMap_;
+    folly::ConcurrentHashMap<std::pair<GraphSpaceID, PartitionID>, size_t> pickedIndex_;
+  };
+  std::atomic<LeaderCache*> leaders_;
 
   LocalCache localCache_;
   std::vector<HostAddr> addrs_;
@@ -792,6 +827,11 @@ class MetaClient : public BaseMetaClient {
   // Only report dir info once when started
   bool dirInfoReported_ = false;
 
+  // statsLock_ is used to protect stats_
+  folly::SharedMutex statsLock_;
+  std::unordered_map<GraphSpaceID, std::shared_ptr<const cpp2::StatsItem>> stats_;
+  int64_t statsLoadTimeInSec_{0};
+
   struct MetaData {
     int64_t localLastUpdateTime_{-2};
     LocalCache localCache_;
@@ -34,6 +34,12 @@ cpp2::RequestCommon StorageClient::CommonRequestParam::toReqCommon() const {
   common.session_id_ref() = session;
   common.plan_id_ref() = plan;
   common.profile_detail_ref() = profile;
+  if (followerRead) {
+    common.follower_read_ref() = true;
+  }
+  if (sampleRatio < 1.0) {
+    common.sample_ratio_ref() = sampleRatio;
+  }
   return common;
 }
 
@@ -52,13 +58,17 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     const std::vector<cpp2::OrderBy>& orderBy,
     int64_t limit,
     const Expression* filter,
-    const Expression* tagFilter) {
+    const Expression* tagFilter,
+    bool statsOnly,
+    const std::vector<cpp2::VertexProp>* dstVertexProps,
+    bool flatEdges) {
   auto cbStatus = getIdFromValue(param.space);
   if (!cbStatus.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
         std::runtime_error(cbStatus.status().toString()));
   }
-  auto status = clusterIdsToHosts(param.space, vids, std::move(cbStatus).value());
+  auto status =
+      clusterIdsToHosts(param.space, vids, std::move(cbStatus).value(), param.followerRead);
   if (!status.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
         std::runtime_error(status.status().toString()));
@@ -101,6 +111,15 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     if (tagFilter != nullptr) {
       spec.tag_filter_ref() = tagFilter->encode();
     }
+    if (statsOnly) {
+      spec.stats_only_ref() = true;
+    }
+    if (dstVertexProps != nullptr) {
+      spec.dst_vertex_props_ref() = *dstVertexProps;
+    }
+    if (flatEdges) {
+      spec.flat_edges_ref() = true;
+    }
     req.traverse_spec_ref() = std::move(spec);
   }
 
@@ -114,7 +133,8 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
 StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
     const CommonRequestParam& param,
     const std::vector<Value>& vertices,
-    const std::vector<EdgeType>& edgeTypes) {
+    const std::vector<EdgeType>& edgeTypes,
+    int32_t steps) {
   auto cbStatus = getIdFromValue(param.space);
   if (!cbStatus.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetDstBySrcResponse>>(
@@ -137,6 +157,9 @@ StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
     req.parts_ref() = std::move(c.second);
     req.edge_types_ref() = edgeTypes;
     req.common_ref() = common;
+    if (steps > 1) {
+      req.steps_ref() = steps;
+    }
   }
 
   return collectResponse(param.evb,
@@ -240,7 +263,8 @@ StorageRpcRespFuture<cpp2::GetPropResponse> StorageClient::getProps(
         std::runtime_error(cbStatus.status().toString()));
   }
 
-  auto status = clusterIdsToHosts(param.space, input.rows, std::move(cbStatus).value());
+  auto status =
+      clusterIdsToHosts(param.space, input.rows, std::move(cbStatus).value(), param.followerRead);
   if (!status.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetPropResponse>>(
         std::runtime_error(status.status().toString()));
@@ -590,9 +614,10 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanEdge(
     const CommonRequestParam& param,
     const std::vector<cpp2::EdgeProp>& edgeProp,
     int64_t limit,
-    const Expression* filter) {
+    const Expression* filter,
+    const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors) {
   std::unordered_map<HostAddr, cpp2::ScanEdgeRequest> requests;
-  auto status = getHostPartsWithCursor(param.space);
+  auto status = getHostPartsWithCursor(param.space, cursors, param.followerRead);
   if (!status.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::ScanResponse>>(
         std::runtime_error(status.status().toString()));
@@ -621,9 +646,10 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanVertex(
     const CommonRequestParam& param,
     const std::vector<cpp2::VertexProp>& vertexProp,
     int64_t limit,
-    const Expression* filter) {
+    const Expression* filter,
+    const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors) {
   std::unordered_map<HostAddr, cpp2::ScanVertexRequest> requests;
-  auto status = getHostPartsWithCursor(param.space);
+  auto status = getHostPartsWithCursor(param.space, cursors, param.followerRead);
   if (!status.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::ScanResponse>>(
         std::runtime_error(status.status().toString()));
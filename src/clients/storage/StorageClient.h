@@ -46,6 +46,10 @@ class StorageClient
     bool profile{false};
     bool useExperimentalFeature{false};
     folly::EventBase* evb{nullptr};
+    // Whether the reads could be served by the followers not far behind the leader
+    bool followerRead{false};
+    // The ratio of the vertices and edges kept by the scans, all of them are kept by 1
+    double sampleRatio{1.0};
 
     CommonRequestParam(GraphSpaceID space_,
                        SessionID sess,
@@ -79,12 +83,19 @@ class StorageClient
       const std::vector<cpp2::OrderBy>& orderBy = std::vector<cpp2::OrderBy>(),
       int64_t limit = std::numeric_limits<int64_t>::max(),
       const Expression* filter = nullptr,
-      const Expression* tagFilter = nullptr);
+      const Expression* tagFilter = nullptr,
+      // Only return the stats of each vertex, without the edges
+      bool statsOnly = false,
+      // The props of the dsts returned along with the edges by the hosts leading them
+      const std::vector<cpp2::VertexProp>* dstVertexProps = nullptr,
+      // Return the edges in columns by GetNeighborsResponse::edges
+      bool flatEdges = false);
 
   StorageRpcRespFuture<cpp2::GetDstBySrcResponse> getDstBySrc(
       const CommonRequestParam& param,
       const std::vector<Value>& vertices,
-      const std::vector<EdgeType>& edgeTypes);
+      const std::vector<EdgeType>& edgeTypes,
+      int32_t steps = 1);
 
   StorageRpcRespFuture<cpp2::GetPropResponse> getProps(
       const CommonRequestParam& param,
@@ -152,16 +163,20 @@ class StorageClient
   StorageRpcRespFuture<cpp2::GetNeighborsResponse> lookupAndTraverse(
       const CommonRequestParam& param, cpp2::IndexSpec indexSpec, cpp2::TraverseSpec traverseSpec);
 
-  StorageRpcRespFuture<cpp2::ScanResponse> scanEdge(const CommonRequestParam& param,
-                                                    const std::vector<cpp2::EdgeProp>& vertexProp,
-                                                    int64_t limit,
-                                                    const Expression* filter);
+  // Scan all parts if cursors is nullptr, otherwise continue the scan of the parts in cursors
+  StorageRpcRespFuture<cpp2::ScanResponse> scanEdge(
+      const CommonRequestParam& param,
+      const std::vector<cpp2::EdgeProp>& vertexProp,
+      int64_t limit,
+      const Expression* filter,
+      const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors = nullptr);
 
   StorageRpcRespFuture<cpp2::ScanResponse> scanVertex(
       const CommonRequestParam& param,
       const std::vector<cpp2::VertexProp>& vertexProp,
       int64_t limit,
-      const Expression* filter);
+      const Expression* filter,
+      const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors = nullptr);
 
   folly::SemiFuture<StorageRpcResponse<cpp2::KVGetResponse>> get(GraphSpaceID space,
                                                                  std::vector<std::string>&& keys,
@@ -6,6 +6,7 @@
 #ifndef CLIENTS_STORAGE_STORAGECLIENTBASE_INL_H
 #define CLIENTS_STORAGE_STORAGECLIENTBASE_INL_H
 
+#include <folly/Demangle.h>
 #include <folly/ExceptionWrapper.h>
 #include <folly/Try.h>
 #include <folly/futures/Future.h>
@@ -22,6 +23,7 @@
 #include "common/stats/StatsManager.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/time/WallClock.h"
+#include "common/tracing/Tracing.h"
 #include "interface/gen-cpp2/common_types.h"
 
 namespace nebula {
@@ -30,8 +32,10 @@ namespace storage {
 template <typename ClientType, typename ClientManagerType>
 StorageClientBase<ClientType, ClientManagerType>::StorageClientBase(
     std::shared_ptr<folly::IOThreadPoolExecutor> threadPool, meta::MetaClient* metaClient)
-    : metaClient_(metaClient), ioThreadPool_(threadPool) {
-  clientsMan_ = std::make_unique<ClientManagerType>(FLAGS_enable_ssl);
+    : metaClient_(metaClient), ioThreadPool_(threadPool), loads_(threadPool.get()) {
+  auto connsPerHost = std::max(1, FLAGS_storage_client_connections_per_host);
+  clientsMan_ =
+      std::make_unique<ClientManagerType>(FLAGS_enable_ssl, static_cast<size_t>(connsPerHost));
 }
 
 template <typename ClientType, typename ClientManagerType>
@@ -48,6 +52,20 @@ StatusOr<HostAddr> StorageClientBase<ClientType, ClientManagerType>::getLeader(
   return metaClient_->getStorageLeaderFromCache(spaceId, partId);
 }
 
+template <typename ClientType, typename ClientManagerType>
+StatusOr<HostAddr> StorageClientBase<ClientType, ClientManagerType>::getReadHost(
+    GraphSpaceID spaceId, PartitionID partId, bool followerRead) const {
+  if (followerRead) {
+    auto partHosts = getPartHosts(spaceId, partId);
+    if (partHosts.ok() && !partHosts.value().hosts_.empty()) {
+      // The follower too far behind the leader rejects the read with the leader in response
+      const auto& hosts = partHosts.value().hosts_;
+      return hosts[folly::Random::rand32(hosts.size())];
+    }
+  }
+  return getLeader(spaceId, partId);
+}
+
 template <typename ClientType, typename ClientManagerType>
 void StorageClientBase<ClientType, ClientManagerType>::updateLeader(GraphSpaceID spaceId,
                                                                     PartitionID partId,
@@ -91,7 +109,7 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
     // Future process code will be executed on the IO thread
     // Since all requests are sent using the same eventbase, all
     // then-callback will be executed on the same IO thread
-    auto fut = getResponse(evb, req.first, req.second, std::move(remoteFunc))
+    auto fut = getHedgedResponse(evb, req.first, req.second, std::move(remoteFunc))
                    .ensure([totalLatencies, i, start]() {
                      (*totalLatencies)[i] = time::WallClock::fastNowInMicroSec() - start;
                    });
@@ -152,6 +170,121 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
       });
 }
 
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class RemoteFunc, class Response>
+folly::Future<StatusOr<Response>>
+StorageClientBase<ClientType, ClientManagerType>::getHedgedResponse(folly::EventBase* evb,
+                                                                    const HostAddr& host,
+                                                                    const Request& request,
+                                                                    RemoteFunc&& remoteFunc) {
+  auto& hedger = ReadHedger::of<Request>();
+  auto start = time::WallClock::fastNowInMicroSec();
+  auto delayUs = FLAGS_storage_client_hedge_reads ? hedger.delayUs() : 0;
+  auto hedgeHost = delayUs > 0 ? hedgeHostOf(host, request) : std::nullopt;
+  if (!hedgeHost.has_value()) {
+    return getResponse(evb, host, request, std::forward<RemoteFunc>(remoteFunc))
+        .ensure([&hedger, start]() {
+          hedger.addLatency(time::WallClock::fastNowInMicroSec() - start);
+        });
+  }
+
+  if (evb == nullptr) {
+    evb = loads_.pick();
+  }
+  if (evb == nullptr) {
+    evb = DCHECK_NOTNULL(ioThreadPool_)->getEventBase();
+  }
+  // All the callbacks run in the evb, the first response succeeded is taken, or the last one
+  struct Race {
+    folly::Promise<StatusOr<Response>> promise;
+    bool done{false};
+    int32_t pending{1};
+  };
+  auto race = std::make_shared<Race>();
+  auto finish = [race](folly::Try<StatusOr<Response>>&& resp, bool hedged) {
+    race->pending--;
+    if (race->done) {
+      return;
+    }
+    bool succeeded = resp.hasValue() && resp.value().ok() &&
+                     resp.value().value().get_result().get_failed_parts().empty();
+    if (succeeded || race->pending == 0) {
+      race->done = true;
+      if (hedged) {
+        stats::StatsManager::addValue(kNumHedgedRpcsWon);
+      }
+      race->promise.setTry(std::move(resp));
+    }
+  };
+
+  std::decay_t<RemoteFunc> hedgeFunc = remoteFunc;
+  getResponse(evb, host, request, std::forward<RemoteFunc>(remoteFunc))
+      .thenTry([&hedger, start, finish](folly::Try<StatusOr<Response>>&& resp) mutable {
+        hedger.addLatency(time::WallClock::fastNowInMicroSec() - start);
+        finish(std::move(resp), false);
+      });
+  folly::futures::sleepUnsafe(std::chrono::microseconds(delayUs))
+      .via(evb)
+      .thenValue([hedgeFunc = std::move(hedgeFunc),
+                  hedgeHost = std::move(hedgeHost).value(),
+                  request,
+                  evb,
+                  race,
+                  finish,
+                  this](auto&&) mutable {
+        if (race->done || !ReadHedger::tryHedge()) {
+          return;
+        }
+        race->pending++;
+        stats::StatsManager::addValue(kNumHedgedRpcs);
+        getResponse(evb, hedgeHost, request, std::move(hedgeFunc))
+            .thenTry([finish](folly::Try<StatusOr<Response>>&& resp) mutable {
+              finish(std::move(resp), true);
+            });
+      });
+  return race->promise.getFuture();
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request>
+std::optional<HostAddr> StorageClientBase<ClientType, ClientManagerType>::hedgeHostOf(
+    const HostAddr& host, const Request& request) const {
+  if constexpr (tracing::HasCommon<Request>::value) {
+    const auto* common = request.get_common();
+    if (common == nullptr || !common->follower_read_ref().value_or(false)) {
+      return std::nullopt;
+    }
+    std::optional<std::vector<HostAddr>> candidates;
+    for (auto partId : getReqPartsId(request)) {
+      auto partHosts = getPartHosts(request.get_space_id(), partId);
+      if (!partHosts.ok()) {
+        return std::nullopt;
+      }
+      const auto& hosts = partHosts.value().hosts_;
+      if (!candidates.has_value()) {
+        candidates = hosts;
+        candidates->erase(std::remove(candidates->begin(), candidates->end(), host),
+                          candidates->end());
+      } else {
+        candidates->erase(std::remove_if(candidates->begin(),
+                                         candidates->end(),
+                                         [&hosts](const auto& candidate) {
+                                           return std::find(hosts.begin(), hosts.end(),
+                                                            candidate) == hosts.end();
+                                         }),
+                          candidates->end());
+      }
+      if (candidates->empty()) {
+        return std::nullopt;
+      }
+    }
+    if (candidates.has_value()) {
+      return (*candidates)[folly::Random::rand32(candidates->size())];
+    }
+  }
+  return std::nullopt;
+}
+
 template <typename ClientType, typename ClientManagerType>
 template <class Request, class RemoteFunc, class Response>
 folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerType>::getResponse(
@@ -160,25 +293,47 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
       folly::isFuture<std::invoke_result_t<RemoteFunc, ClientType*, const Request&>>::value);
 
   stats::StatsManager::addValue(kNumRpcSentToStoraged);
+  if (evb == nullptr) {
+    evb = loads_.pick();
+  }
   if (evb == nullptr) {
     evb = DCHECK_NOTNULL(ioThreadPool_)->getEventBase();
   }
+  auto hostLoad = loads_.add(evb, host);
 
   auto spaceId = request.get_space_id();
-  return folly::via(evb)
-      .thenValue([remoteFunc = std::move(remoteFunc), request, evb, host, this](auto&&) {
+  // The host whose writes are stalled is backed off as it asks
+  auto retryAfterMs = std::make_shared<int64_t>(0);
+  // The processor of storaged runs in a child span of the rpc
+  auto span = tracing::Span::child("storage rpc", tracing::SpanKind::kClient);
+  if (span.sampled()) {
+    span.addAttribute("request", folly::demangle(typeid(Request)).toStdString());
+    span.addAttribute("host", host.toString());
+  }
+  return backpressure_.acquire(host)
+      .via(evb)
+      .thenValue([remoteFunc = std::move(remoteFunc),
+                  request,
+                  evb,
+                  host,
+                  traceParent = span.context(),
+                  this](auto&&) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
+        tracing::setTraceParent(&request, traceParent);
         // NOTE: Create new channel on each thread to avoid TIMEOUT RPC error
         auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
         // Encoding invoke Cpp2Ops::write the request to protocol is in current thread,
         // do not need to turn on in Cpp2Ops::write
         return remoteFunc(client.get(), request);
       })
-      .thenValue([spaceId, this](Response&& resp) mutable -> StatusOr<Response> {
+      .thenValue([spaceId, retryAfterMs, this](Response&& resp) mutable -> StatusOr<Response> {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         auto& result = resp.get_result();
+        if (result.retry_after_ms_ref().has_value()) {
+          *retryAfterMs = *result.retry_after_ms_ref();
+        }
         for (auto& part : result.get_failed_parts()) {
           auto partId = part.get_part_id();
           auto code = part.get_code();
@@ -233,6 +388,11 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
           LOG(ERROR) << "Request to " << host << " failed.";
           return Status::Error("RPC failure in StorageClient.");
         }
+      })
+      .ensure([host, retryAfterMs, evb, hostLoad, span = std::move(span), this]() mutable {
+        span.end();
+        loads_.remove(evb, hostLoad);
+        backpressure_.release(host, *retryAfterMs);
       });
 }
 
@@ -243,7 +403,8 @@ StatusOr<std::unordered_map<
     std::unordered_map<PartitionID, std::vector<typename Container::value_type>>>>
 StorageClientBase<ClientType, ClientManagerType>::clusterIdsToHosts(GraphSpaceID spaceId,
                                                                     const Container& ids,
-                                                                    GetIdFunc f) const {
+                                                                    GetIdFunc f,
+                                                                    bool followerRead) const {
   std::unordered_map<HostAddr,
                      std::unordered_map<PartitionID, std::vector<typename Container::value_type>>>
       clusters;
@@ -253,24 +414,27 @@ StorageClientBase<ClientType, ClientManagerType>::clusterIdsToHosts(GraphSpaceID
     return Status::Error("Space not found, spaceid: %d", spaceId);
   }
   auto numParts = status.value();
-  std::unordered_map<PartitionID, HostAddr> leaders;
-  for (int32_t partId = 1; partId <= numParts; ++partId) {
-    auto leader = getLeader(spaceId, partId);
-    if (!leader.ok()) {
-      return leader.status();
+  // Bucket the ids by the parts first, then look up the hosts of only the parts having ids, each
+  // once, rather than hashing each id into the maps of the hosts
+  std::vector<std::vector<typename Container::value_type>> partIds(numParts + 1);
+  if (ids.size() > static_cast<size_t>(numParts)) {
+    auto perPart = ids.size() / numParts + 1;
+    for (auto& bucket : partIds) {
+      bucket.reserve(perPart);
     }
-    leaders[partId] = std::move(leader).value();
   }
   for (auto& id : ids) {
-    CHECK(!!metaClient_);
-    status = metaClient_->partId(numParts, f(id));
-    if (!status.ok()) {
-      return status.status();
+    partIds[metaClient_->partId(numParts, f(id))].emplace_back(id);
+  }
+  for (PartitionID partId = 1; partId <= numParts; ++partId) {
+    if (partIds[partId].empty()) {
+      continue;
     }
-
-    auto part = status.value();
-    const auto& leader = leaders[part];
-    clusters[leader][part].emplace_back(std::move(id));
+    auto host = getReadHost(spaceId, partId, followerRead);
+    if (!host.ok()) {
+      return host.status();
+    }
+    clusters[host.value()].emplace(partId, std::move(partIds[partId]));
   }
   return clusters;
 }
@@ -298,18 +462,30 @@ StorageClientBase<ClientType, ClientManagerType>::getHostParts(GraphSpaceID spac
 template <typename ClientType, typename ClientManagerType>
 StatusOr<std::unordered_map<HostAddr, std::unordered_map<PartitionID, cpp2::ScanCursor>>>
 StorageClientBase<ClientType, ClientManagerType>::getHostPartsWithCursor(
-    GraphSpaceID spaceId) const {
+    GraphSpaceID spaceId,
+    const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors,
+    bool followerRead) const {
   std::unordered_map<HostAddr, std::unordered_map<PartitionID, cpp2::ScanCursor>> hostParts;
+  if (cursors != nullptr) {
+    for (const auto& [partId, cursor] : *cursors) {
+      auto leader = getReadHost(spaceId, partId, followerRead);
+      if (!leader.ok()) {
+        return leader.status();
+      }
+      hostParts[leader.value()].emplace(partId, cursor);
+    }
+    return hostParts;
+  }
+
   auto status = metaClient_->partsNum(spaceId);
   if (!status.ok()) {
     return Status::Error("Space not found, spaceid: %d", spaceId);
   }
 
-  // TODO support cursor
   cpp2::ScanCursor c;
   auto parts = status.value();
   for (auto partId = 1; partId <= parts; partId++) {
-    auto leader = getLeader(spaceId, partId);
+    auto leader = getReadHost(spaceId, partId, followerRead);
     if (!leader.ok()) {
       return leader.status();
     }
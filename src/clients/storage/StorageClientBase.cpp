@@ -5,11 +5,254 @@
 
 #include "clients/storage/StorageClientBase.h"
 
+#include <folly/Random.h>
+
+#include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
+
 DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
 DEFINE_uint32(storage_client_retry_interval_ms,
               1000,
               "storage client sleep interval milliseconds between retry");
+DEFINE_int32(storage_client_stalled_host_concurrency,
+             16,
+             "max requests in flight to a host once its writes are stalled, which is adapted by "
+             "the responses of the host");
+DEFINE_bool(storage_client_hedge_reads,
+            false,
+            "Whether to send a read allowed to be served by the followers again to another "
+            "replica holding its parts, once it's slower than most of its kind");
+DEFINE_int32(storage_client_hedge_percentile,
+             95,
+             "The percentile of the recent latencies of the reads, after which a read is hedged");
+DEFINE_int32(storage_client_hedge_min_delay_ms, 5, "The min delay before a read is hedged");
+DEFINE_int32(storage_client_hedge_budget_pct,
+             5,
+             "The max hedged reads, in percent of the reads sent to storaged");
+DEFINE_int32(storage_client_connections_per_host,
+             1,
+             "The connections to a storaged host kept by each IO thread, which the requests to "
+             "the host take in turn");
 
 namespace nebula {
-namespace storage {}  // namespace storage
+namespace storage {
+
+RpcLoads::RpcLoads(folly::IOThreadPoolExecutor* pool) {
+  if (pool == nullptr) {
+    return;
+  }
+  for (auto& evb : pool->getAllEventBases()) {
+    evbIndex_.emplace(evb.get(), evbs_.size());
+    evbs_.emplace_back(evb.get());
+  }
+  // Zeroed
+  evbLoads_ = std::make_unique<std::atomic<int64_t>[]>(evbs_.size());
+}
+
+folly::EventBase* RpcLoads::pick() const {
+  if (evbs_.empty()) {
+    return nullptr;
+  }
+  auto first = folly::Random::rand32(evbs_.size());
+  auto second = folly::Random::rand32(evbs_.size());
+  return evbLoads_[second].load(std::memory_order_relaxed) <
+                 evbLoads_[first].load(std::memory_order_relaxed)
+             ? evbs_[second]
+             : evbs_[first];
+}
+
+std::atomic<int64_t>* RpcLoads::loadOf(folly::EventBase* evb) const {
+  auto iter = evbIndex_.find(evb);
+  return iter == evbIndex_.end() ? nullptr : &evbLoads_[iter->second];
+}
+
+std::shared_ptr<std::atomic<int64_t>> RpcLoads::add(folly::EventBase* evb, const HostAddr& host) {
+  if (auto* load = loadOf(evb)) {
+    load->fetch_add(1, std::memory_order_relaxed);
+  }
+  std::shared_ptr<std::atomic<int64_t>> hostLoad;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto iter = hostLoads_.find(host);
+    if (iter != hostLoads_.end()) {
+      hostLoad = iter->second;
+    } else {
+      hostLoad = std::make_shared<std::atomic<int64_t>>(0);
+      hostLoads_.emplace(host, hostLoad);
+      stats::StatsManager::registerGauge(
+          "num_inflight_rpc_to_storaged", {{"host", host.toString()}}, [hostLoad]() {
+            return hostLoad->load(std::memory_order_relaxed);
+          });
+    }
+  }
+  hostLoad->fetch_add(1, std::memory_order_relaxed);
+  return hostLoad;
+}
+
+void RpcLoads::remove(folly::EventBase* evb,
+                      const std::shared_ptr<std::atomic<int64_t>>& hostLoad) {
+  if (auto* load = loadOf(evb)) {
+    load->fetch_sub(1, std::memory_order_relaxed);
+  }
+  hostLoad->fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::atomic<int64_t> ReadHedger::tokens_{0};
+
+void ReadHedger::addLatency(int64_t latencyUs) {
+  latencies_.add(latencyUs);
+  if (tokens_.load(std::memory_order_relaxed) < kMaxTokens) {
+    tokens_.fetch_add(FLAGS_storage_client_hedge_budget_pct, std::memory_order_relaxed);
+  }
+  auto now = time::WallClock::fastNowInMilliSec();
+  if (now >= refreshAtMs_.load(std::memory_order_relaxed)) {
+    refresh(now);
+  }
+}
+
+// static
+bool ReadHedger::tryHedge() {
+  auto tokens = tokens_.load(std::memory_order_relaxed);
+  while (tokens >= kHedgeCost) {
+    if (tokens_.compare_exchange_weak(tokens, tokens - kHedgeCost)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReadHedger::refresh(int64_t nowMs) {
+  std::unique_lock<std::mutex> guard(refreshLock_, std::try_to_lock);
+  if (!guard.owns_lock() || nowMs < refreshAtMs_.load()) {
+    return;
+  }
+  refreshAtMs_ = nowMs + kWindowMs;
+  auto current = latencies_.snapshot();
+  // The window is extended until it has enough samples
+  if (current.count - last_.count < kMinSamples) {
+    return;
+  }
+  stats::LatencyHistogram::Snapshot window;
+  for (size_t i = 0; i < window.counts.size(); i++) {
+    window.counts[i] = current.counts[i] - last_.counts[i];
+  }
+  window.count = current.count - last_.count;
+  window.sum = current.sum - last_.sum;
+  last_ = std::move(current);
+  auto delay = window.percentile(FLAGS_storage_client_hedge_percentile);
+  delayUs_ = std::max<int64_t>(delay, FLAGS_storage_client_hedge_min_delay_ms * 1000L);
+}
+
+folly::SemiFuture<folly::Unit> HostBackpressure::acquire(const HostAddr& host) {
+  if (numLimited_.load() == 0) {
+    return folly::makeSemiFuture();
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = hosts_.find(host);
+  if (iter == hosts_.end()) {
+    return folly::makeSemiFuture();
+  }
+  auto& state = iter->second;
+  auto now = time::WallClock::fastNowInMilliSec();
+  if (state.waiters.empty() && now >= state.resumeAtMs && state.inflight < state.limit) {
+    ++state.inflight;
+    return folly::makeSemiFuture();
+  }
+  state.waiters.emplace_back();
+  auto future = state.waiters.back().getSemiFuture();
+  scheduleWake(host, &state, now);
+  return future;
+}
+
+void HostBackpressure::release(const HostAddr& host, int64_t retryAfterMs) {
+  if (retryAfterMs <= 0 && numLimited_.load() == 0) {
+    return;
+  }
+  std::vector<folly::Promise<folly::Unit>> ready;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto now = time::WallClock::fastNowInMilliSec();
+    auto iter = hosts_.find(host);
+    if (retryAfterMs > 0) {
+      if (iter == hosts_.end()) {
+        iter = hosts_.emplace(host, State()).first;
+        iter->second.limit = std::max(1, FLAGS_storage_client_stalled_host_concurrency);
+        ++numLimited_;
+      } else {
+        iter->second.limit = std::max(1, iter->second.limit / 2);
+      }
+      iter->second.resumeAtMs = std::max(iter->second.resumeAtMs, now + retryAfterMs);
+    } else if (iter == hosts_.end()) {
+      return;
+    } else {
+      ++iter->second.limit;
+    }
+
+    auto& state = iter->second;
+    if (state.inflight > 0) {
+      --state.inflight;
+    }
+    if (retryAfterMs <= 0 && state.waiters.empty() &&
+        state.limit >= 2 * std::max(1, FLAGS_storage_client_stalled_host_concurrency)) {
+      // The host is well again
+      hosts_.erase(iter);
+      --numLimited_;
+      return;
+    }
+    if (now < state.resumeAtMs) {
+      if (!state.waiters.empty()) {
+        scheduleWake(host, &state, now);
+      }
+    } else {
+      popReady(&state, now, &ready);
+    }
+  }
+  for (auto& promise : ready) {
+    promise.setValue();
+  }
+}
+
+void HostBackpressure::popReady(State* state,
+                                int64_t now,
+                                std::vector<folly::Promise<folly::Unit>>* ready) {
+  while (!state->waiters.empty() && now >= state->resumeAtMs && state->inflight < state->limit) {
+    ++state->inflight;
+    ready->emplace_back(std::move(state->waiters.front()));
+    state->waiters.pop_front();
+  }
+}
+
+void HostBackpressure::scheduleWake(const HostAddr& host, State* state, int64_t now) {
+  if (state->wakeScheduled || now >= state->resumeAtMs) {
+    return;
+  }
+  state->wakeScheduled = true;
+  folly::futures::sleepUnsafe(std::chrono::milliseconds(state->resumeAtMs - now))
+      .thenValue([this, host](auto&&) { wake(host); });
+}
+
+void HostBackpressure::wake(const HostAddr& host) {
+  std::vector<folly::Promise<folly::Unit>> ready;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto iter = hosts_.find(host);
+    if (iter == hosts_.end()) {
+      return;
+    }
+    auto& state = iter->second;
+    state.wakeScheduled = false;
+    auto now = time::WallClock::fastNowInMilliSec();
+    if (now < state.resumeAtMs) {
+      // Stalled again
+      scheduleWake(host, &state, now);
+      return;
+    }
+    popReady(&state, now, &ready);
+  }
+  for (auto& promise : ready) {
+    promise.setValue();
+  }
+}
+
+}  // namespace storage
 }  // namespace nebula
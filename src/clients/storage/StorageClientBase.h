@@ -9,16 +9,26 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 
+#include <deque>
+#include <mutex>
+
 #include "clients/meta/MetaClient.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
 #include "common/meta/Common.h"
+#include "common/stats/LatencyHistogram.h"
 #include "common/thrift/ThriftClientManager.h"
 #include "interface/gen-cpp2/storage_types.h"
 
 DECLARE_int32(storage_client_timeout_ms);
 DECLARE_uint32(storage_client_retry_interval_ms);
+DECLARE_int32(storage_client_stalled_host_concurrency);
+DECLARE_bool(storage_client_hedge_reads);
+DECLARE_int32(storage_client_hedge_percentile);
+DECLARE_int32(storage_client_hedge_min_delay_ms);
+DECLARE_int32(storage_client_hedge_budget_pct);
+DECLARE_int32(storage_client_connections_per_host);
 
 namespace nebula {
 namespace storage {
@@ -104,6 +114,124 @@ class StorageRpcResponse final {
   std::vector<std::tuple<HostAddr, int32_t, int32_t>> hostLatency_;
 };
 
+/**
+ * HostBackpressure limits the requests to the hosts whose writes are stalled.
+ *
+ * A host answering with retry_after_ms is paused until then, rather than retried by the clients
+ * at once. Its requests in flight are then limited, from storage_client_stalled_host_concurrency,
+ * halved on each stall and raised by one on each response without, until the limit is lifted
+ * once it's twice the initial one.
+ */
+class HostBackpressure final {
+ public:
+  // The future is fulfilled once a request could be sent to host
+  folly::SemiFuture<folly::Unit> acquire(const HostAddr& host);
+
+  // A request to host is done, which asks the requests to retry after retryAfterMs if positive
+  void release(const HostAddr& host, int64_t retryAfterMs);
+
+ private:
+  struct State {
+    int32_t limit{0};
+    int32_t inflight{0};
+    int64_t resumeAtMs{0};
+    bool wakeScheduled{false};
+    std::deque<folly::Promise<folly::Unit>> waiters;
+  };
+
+  // Move the waiters could be sent into ready
+  static void popReady(State* state, int64_t now, std::vector<folly::Promise<folly::Unit>>* ready);
+
+  // Wake the waiters of host once it's resumed
+  void scheduleWake(const HostAddr& host, State* state, int64_t now);
+
+  void wake(const HostAddr& host);
+
+  std::mutex lock_;
+  std::atomic<size_t> numLimited_{0};
+  std::unordered_map<HostAddr, State> hosts_;
+};
+
+/**
+ * RpcLoads tracks the requests in flight to storaged, by the event bases of the IO pool they are
+ * sent by and by the hosts.
+ *
+ * A request sent without an event base goes by the less loaded of two event bases picked at
+ * random, rather than by the next one, so the requests to the others aren't queued behind a few
+ * IO threads busy with the slow hosts. The requests in flight to each host are exposed by the
+ * gauge num_inflight_rpc_to_storaged of the host.
+ */
+class RpcLoads final {
+ public:
+  explicit RpcLoads(folly::IOThreadPoolExecutor* pool);
+
+  // The event base to send a request by, nullptr if there is no IO pool
+  folly::EventBase* pick() const;
+
+  // A request to host is sent by evb, the counter returned is given back to remove
+  std::shared_ptr<std::atomic<int64_t>> add(folly::EventBase* evb, const HostAddr& host);
+
+  void remove(folly::EventBase* evb, const std::shared_ptr<std::atomic<int64_t>>& hostLoad);
+
+ private:
+  std::atomic<int64_t>* loadOf(folly::EventBase* evb) const;
+
+  std::vector<folly::EventBase*> evbs_;
+  std::unique_ptr<std::atomic<int64_t>[]> evbLoads_;
+  std::unordered_map<folly::EventBase*, size_t> evbIndex_;
+
+  std::mutex lock_;
+  std::unordered_map<HostAddr, std::shared_ptr<std::atomic<int64_t>>> hostLoads_;
+};
+
+/**
+ * ReadHedger decides when a read which could be served by the followers is sent again to another
+ * replica, so one slow host doesn't hold the whole fan-out, and the first answer is taken.
+ *
+ * A request is hedged once it's slower than the storage_client_hedge_percentile latency of the
+ * requests of the same type in the last second, but not sooner than
+ * storage_client_hedge_min_delay_ms. The hedges are limited to storage_client_hedge_budget_pct
+ * percent of the requests by a token bucket shared by all the types.
+ */
+class ReadHedger final {
+ public:
+  // The hedger of the requests of type Request
+  template <class Request>
+  static ReadHedger& of() {
+    static ReadHedger hedger;
+    return hedger;
+  }
+
+  // The delay after which to hedge a request, 0 if not to hedge until enough samples
+  int64_t delayUs() const {
+    return delayUs_.load(std::memory_order_relaxed);
+  }
+
+  // Add the latency of a request which is not a hedge, each of them earns the budget
+  void addLatency(int64_t latencyUs);
+
+  // Take a hedge from the budget, false if it's used up
+  static bool tryHedge();
+
+ private:
+  static constexpr int64_t kWindowMs = 1000;
+  static constexpr uint64_t kMinSamples = 20;
+  // A hedge costs kHedgeCost tokens, a request earns storage_client_hedge_budget_pct of it
+  static constexpr int64_t kHedgeCost = 100;
+  static constexpr int64_t kMaxTokens = 100 * kHedgeCost;
+
+  void refresh(int64_t nowMs);
+
+  stats::LatencyHistogram latencies_;
+  std::atomic<int64_t> delayUs_{0};
+  std::atomic<int64_t> refreshAtMs_{0};
+  std::mutex refreshLock_;
+  // The latencies until the last refresh
+  stats::LatencyHistogram::Snapshot last_;
+
+  static std::atomic<int64_t> tokens_;
+};
+
 /**
  * A base class for all storage clients
  */
@@ -121,6 +249,10 @@ class StorageClientBase {
   void invalidLeader(GraphSpaceID spaceId, PartitionID partId);
   void invalidLeader(GraphSpaceID spaceId, std::vector<PartitionID>& partsId);
 
+  // The host to read the part, which is a random replica if the follower read is allowed,
+  // otherwise the leader
+  StatusOr<HostAddr> getReadHost(GraphSpaceID spaceId, PartitionID partId, bool followerRead) const;
+
   template <class Request,
             class RemoteFunc,
             class Response =
@@ -139,18 +271,43 @@ class StorageClientBase {
                                                 const Request& request,
                                                 RemoteFunc&& remoteFunc);
 
+  // The response of the host, or of another replica holding all the parts of the read if the host
+  // is slower than ReadHedger expects and the hedge sent to the replica answers first
+  template <class Request,
+            class RemoteFunc,
+            class Response = typename std::result_of<RemoteFunc(ClientType* client,
+                                                                const Request&)>::type::value_type>
+  folly::Future<StatusOr<Response>> getHedgedResponse(folly::EventBase* evb,
+                                                      const HostAddr& host,
+                                                      const Request& request,
+                                                      RemoteFunc&& remoteFunc);
+
+  // A replica other than the host which holds all the parts of the request, none unless the
+  // request could be served by the followers
+  template <class Request>
+  std::optional<HostAddr> hedgeHostOf(const HostAddr& host, const Request& request) const;
+
   // Cluster given ids into the host they belong to
   // The method returns a map
   //  host_addr (A host, but in most case, the leader will be chosen)
   //      => (partition -> [ids that belong to the shard])
+  // The replicas of the parts are chosen instead of the leaders if followerRead is true
   template <class Container, class GetIdFunc>
   StatusOr<std::unordered_map<
       HostAddr,
       std::unordered_map<PartitionID, std::vector<typename Container::value_type>>>>
-  clusterIdsToHosts(GraphSpaceID spaceId, const Container& ids, GetIdFunc f) const;
-
+  clusterIdsToHosts(GraphSpaceID spaceId,
+                    const Container& ids,
+                    GetIdFunc f,
+                    bool followerRead = false) const;
+
+  // Group the parts by their leaders, all parts of the space are scanned from the beginning if
+  // cursors is nullptr, otherwise only the parts in cursors are scanned from their next cursors.
+  // The replicas of the parts are chosen instead of the leaders if followerRead is true
   StatusOr<std::unordered_map<HostAddr, std::unordered_map<PartitionID, cpp2::ScanCursor>>>
-  getHostPartsWithCursor(GraphSpaceID spaceId) const;
+  getHostPartsWithCursor(GraphSpaceID spaceId,
+                         const std::unordered_map<PartitionID, cpp2::ScanCursor>* cursors = nullptr,
+                         bool followerRead = false) const;
 
   virtual StatusOr<meta::PartHosts> getPartHosts(GraphSpaceID spaceId, PartitionID partId) const {
     CHECK(metaClient_ != nullptr);
@@ -204,6 +361,8 @@ class StorageClientBase {
  private:
   std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
   std::unique_ptr<ClientManagerType> clientsMan_;
+  HostBackpressure backpressure_;
+  RpcLoads loads_;
 };
 
 }  // namespace storage
@@ -9,12 +9,17 @@ namespace nebula {
 
 stats::CounterId kNumRpcSentToStoraged;
 stats::CounterId kNumRpcSentToStoragedFailed;
+stats::CounterId kNumHedgedRpcs;
+stats::CounterId kNumHedgedRpcsWon;
 
 void initStorageClientStats() {
   kNumRpcSentToStoraged =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged", "rate, sum");
   kNumRpcSentToStoragedFailed =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged_failed", "rate, sum");
+  kNumHedgedRpcs = stats::StatsManager::registerStats("num_hedged_rpc_to_storaged", "rate, sum");
+  kNumHedgedRpcsWon =
+      stats::StatsManager::registerStats("num_hedged_rpc_to_storaged_won", "rate, sum");
 }
 
 }  // namespace nebula
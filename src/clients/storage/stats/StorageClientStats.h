@@ -12,6 +12,9 @@ namespace nebula {
 
 extern stats::CounterId kNumRpcSentToStoraged;
 extern stats::CounterId kNumRpcSentToStoragedFailed;
+// The reads sent again to another replica, and the ones answered first by it
+extern stats::CounterId kNumHedgedRpcs;
+extern stats::CounterId kNumHedgedRpcsWon;
 
 void initStorageClientStats();
 
@@ -10,6 +10,19 @@
 
 namespace nebula {
 
+// The element count of an encoded LIST_* or SET_* property never exceeds
+// 65535, so the higher bits of the int32 count word carry the element encoding.
+// A count word without any flag is the original int32/float encoding.
+constexpr int32_t kContainerSizeMask = 0x00FFFFFF;
+// INT elements are encoded as int64, and FLOAT elements as double
+constexpr int32_t kContainerWideElements = 0x01000000;
+// INT elements are sorted, the first one is encoded as a zigzag varint and the
+// others as the varint deltas to the previous one
+constexpr int32_t kContainerDeltaVarint = 0x02000000;
+// The elements of a SET_* property are deduplicated and in ascending order,
+// NaN is after all other floats
+constexpr int32_t kContainerSorted = 0x04000000;
+
 template <typename IntType>
 typename std::enable_if<std::is_integral<typename std::remove_cv<
                             typename std::remove_reference<IntType>::type>::type>::value,
@@ -4,40 +4,256 @@
  */
 #include "codec/RowReaderV2.h"
 
+#include <folly/Varint.h>
+
+#include "codec/Common.h"
+
 namespace nebula {
 
 using nebula::cpp2::PropertyType;
 
-template <typename T, typename Container>
-Value extractIntOrFloat(const folly::StringPiece& data, size_t& offset) {
-  int32_t containerOffset;
-  memcpy(reinterpret_cast<void*>(&containerOffset), data.data() + offset, sizeof(int32_t));
-  if (static_cast<size_t>(containerOffset) >= data.size()) {
-    LOG(ERROR) << "Container offset out of bounds. Offset: " << containerOffset
-               << ", Data size: " << data.size();
+bool CollectionView::isSet() const {
+  return type_ == PropertyType::SET_STRING || type_ == PropertyType::SET_INT ||
+         type_ == PropertyType::SET_FLOAT;
+}
+
+Value::Type CollectionView::elemType() const {
+  switch (type_) {
+    case PropertyType::LIST_INT:
+    case PropertyType::SET_INT:
+      return Value::Type::INT;
+    case PropertyType::LIST_FLOAT:
+    case PropertyType::SET_FLOAT:
+      return Value::Type::FLOAT;
+    case PropertyType::LIST_STRING:
+    case PropertyType::SET_STRING:
+      return Value::Type::STRING;
+    default:
+      return Value::Type::__EMPTY__;
+  }
+}
+
+template <typename Visitor>
+bool CollectionView::visit(Visitor&& visitor) const {
+  const char* pos = data_.begin();
+  const char* end = data_.end();
+  auto elemType = this->elemType();
+  int64_t prev = 0;
+  bool broken = false;
+  // Visit a fixed width element, return false to stop the visit
+  auto visitFixed = [&](auto zero) {
+    using T = decltype(zero);
+    if (pos + sizeof(T) > end) {
+      LOG(ERROR) << "Reading beyond data bounds for " << static_cast<int>(type_);
+      broken = true;
+      return false;
+    }
+    T val;
+    memcpy(reinterpret_cast<void*>(&val), pos, sizeof(T));
+    pos += sizeof(T);
+    return visitor(val);
+  };
+  for (size_t i = 0; i < size_; ++i) {
+    switch (elemType) {
+      case Value::Type::INT: {
+        if (flags_ & kContainerDeltaVarint) {
+          folly::ByteRange range(reinterpret_cast<const uint8_t*>(pos),
+                                 reinterpret_cast<const uint8_t*>(end));
+          auto encoded = folly::tryDecodeVarint(range);
+          if (encoded.hasError()) {
+            LOG(ERROR) << "Broken varint for " << static_cast<int>(type_);
+            return false;
+          }
+          prev = i == 0 ? folly::decodeZigZag(*encoded)
+                        : static_cast<int64_t>(static_cast<uint64_t>(prev) + *encoded);
+          pos = reinterpret_cast<const char*>(range.begin());
+          if (!visitor(prev)) {
+            return true;
+          }
+        } else if (flags_ & kContainerWideElements) {
+          if (!visitFixed(int64_t(0))) {
+            return !broken;
+          }
+        } else {
+          if (!visitFixed(int32_t(0))) {
+            return !broken;
+          }
+        }
+        break;
+      }
+      case Value::Type::FLOAT: {
+        if (flags_ & kContainerWideElements) {
+          if (!visitFixed(double(0))) {
+            return !broken;
+          }
+        } else {
+          if (!visitFixed(float(0))) {
+            return !broken;
+          }
+        }
+        break;
+      }
+      case Value::Type::STRING: {
+        int32_t strLen;
+        if (pos + sizeof(int32_t) > end) {
+          LOG(ERROR) << "Reading beyond data bounds for " << static_cast<int>(type_);
+          return false;
+        }
+        memcpy(reinterpret_cast<void*>(&strLen), pos, sizeof(int32_t));
+        pos += sizeof(int32_t);
+        if (strLen < 0 || pos + strLen > end) {
+          LOG(ERROR) << "String length out of bounds for " << static_cast<int>(type_);
+          return false;
+        }
+        folly::StringPiece val(pos, strLen);
+        pos += strLen;
+        if (!visitor(val)) {
+          return true;
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+template <typename T>
+Value toValue(const T& elem) {
+  if constexpr (std::is_same_v<T, folly::StringPiece>) {
+    return elem.str();
+  } else {
+    return Value(elem);
+  }
+}
+
+}  // namespace
+
+Value CollectionView::at(size_t i) const {
+  if (i >= size_) {
     return Value::kNullValue;
   }
-  int32_t containerSize;
-  memcpy(reinterpret_cast<void*>(&containerSize), data.data() + containerOffset, sizeof(int32_t));
-  containerOffset += sizeof(int32_t);
-  Container container;
-  for (int32_t i = 0; i < containerSize; ++i) {
-    T value;
-    if (static_cast<size_t>(containerOffset + sizeof(T)) > data.size()) {
-      LOG(ERROR) << "Reading beyond data bounds. Attempting to read at offset: " << containerOffset
-                 << ", Data size: " << data.size();
-      return Value::kNullValue;
+  Value result = Value::kNullValue;
+  size_t curr = 0;
+  visit([&](const auto& elem) {
+    if (curr++ == i) {
+      result = toValue(elem);
+      return false;
     }
-    memcpy(reinterpret_cast<void*>(&value), data.data() + containerOffset, sizeof(T));
-    containerOffset += sizeof(T);
+    return true;
+  });
+  return result;
+}
 
-    if constexpr (std::is_same_v<Container, List>) {
-      container.values.emplace_back(Value(value));
-    } else if constexpr (std::is_same_v<Container, Set>) {
-      container.values.insert(Value(value));
+bool CollectionView::isSorted() const {
+  return flags_ & kContainerSorted;
+}
+
+namespace {
+
+// Binary search the fixed width elements sorted in ascending order
+template <typename T>
+bool binarySearch(folly::StringPiece data, size_t size, int64_t target) {
+  if (target < std::numeric_limits<T>::min() || target > std::numeric_limits<T>::max() ||
+      data.size() < size * sizeof(T)) {
+    return false;
+  }
+  size_t low = 0;
+  size_t high = size;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    T val;
+    memcpy(reinterpret_cast<void*>(&val), data.data() + mid * sizeof(T), sizeof(T));
+    if (val < target) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
-  return Value(std::move(container));
+  if (low == size) {
+    return false;
+  }
+  T val;
+  memcpy(reinterpret_cast<void*>(&val), data.data() + low * sizeof(T), sizeof(T));
+  return val == target;
+}
+
+}  // namespace
+
+bool CollectionView::contains(const Value& value) const {
+  bool found = false;
+  auto elemType = this->elemType();
+  bool sorted = isSorted();
+  if (value.isNumeric() && (elemType == Value::Type::INT || elemType == Value::Type::FLOAT)) {
+    bool exact = value.isInt() && elemType == Value::Type::INT;
+    if (exact && sorted && !(flags_ & kContainerDeltaVarint)) {
+      return (flags_ & kContainerWideElements)
+                 ? binarySearch<int64_t>(data_, size_, value.getInt())
+                 : binarySearch<int32_t>(data_, size_, value.getInt());
+    }
+    visit([&](const auto& elem) {
+      using T = std::decay_t<decltype(elem)>;
+      if constexpr (std::is_arithmetic_v<T>) {
+        if (exact) {
+          found = elem == value.getInt();
+          // No larger elements could match
+          return !found && !(sorted && elem > value.getInt());
+        }
+        // The same as the numeric equality of Value
+        found = std::abs(static_cast<double>(elem) -
+                         (value.isInt() ? value.getInt() : value.getFloat())) < kEpsilon;
+      }
+      return !found;
+    });
+  } else if (value.isStr() && elemType == Value::Type::STRING) {
+    folly::StringPiece target(value.getStr());
+    visit([&](const auto& elem) {
+      using T = std::decay_t<decltype(elem)>;
+      if constexpr (std::is_same_v<T, folly::StringPiece>) {
+        found = elem == target;
+        return !found && !(sorted && elem > target);
+      }
+      return !found;
+    });
+  }
+  return found;
+}
+
+Value CollectionView::materialize() const {
+  bool ok = true;
+  if (isSet()) {
+    Set set;
+    set.reserve(size_);
+    ok = visit([&set](const auto& elem) {
+      set.values.emplace(toValue(elem));
+      return true;
+    });
+    return ok ? Value(std::move(set)) : Value::kNullValue;
+  }
+  List list;
+  list.reserve(size_);
+  ok = visit([&list](const auto& elem) {
+    list.values.emplace_back(toValue(elem));
+    return true;
+  });
+  if (!ok) {
+    return Value::kNullValue;
+  }
+  switch (elemType()) {
+    case Value::Type::INT:
+      list.setKind(List::Kind::kInt);
+      break;
+    case Value::Type::FLOAT:
+      list.setKind(List::Kind::kFloat);
+      break;
+    default:
+      list.setKind(List::Kind::kString);
+      break;
+  }
+  return Value(std::move(list));
 }
 
 bool RowReaderV2::resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row) {
@@ -229,78 +445,26 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
       }
       CHECK_LT(strOffset, data_.size());
       auto wkb = std::string(&data_[strOffset], strLen);
-      // Parse a geography from the wkb, normalize it and then verify its validity.
-      auto geogRet = Geography::fromWKB(wkb, true, true);
+      // The geography is normalized and validated when written, so it's only parsed from the wkb
+      auto geogRet = Geography::fromWKB(wkb);
       if (!geogRet.ok()) {
         LOG(WARNING) << "Geography::fromWKB failed: " << geogRet.status();
         return Value::kNullBadData;  // Is it ok to return Value::kNullBadData?
       }
       return std::move(geogRet).value();
     }
-    case PropertyType::LIST_STRING: {
-      int32_t listOffset;
-      memcpy(reinterpret_cast<void*>(&listOffset), &data_[offset], sizeof(int32_t));
-      if (static_cast<size_t>(listOffset) >= data_.size()) {
-        LOG(ERROR) << "List offset out of bounds for LIST_STRING.";
-        return Value::kNullValue;
-      }
-      int32_t listSize;
-      memcpy(reinterpret_cast<void*>(&listSize), &data_[listOffset], sizeof(int32_t));
-      listOffset += sizeof(int32_t);
-
-      List list;
-      for (int32_t i = 0; i < listSize; ++i) {
-        int32_t strLen;
-        memcpy(reinterpret_cast<void*>(&strLen), &data_[listOffset], sizeof(int32_t));
-        listOffset += sizeof(int32_t);
-        if (static_cast<size_t>(listOffset + strLen) > data_.size()) {
-          LOG(ERROR) << "String length out of bounds for LIST_STRING.";
-          return Value::kNullValue;
-        }
-        std::string str(&data_[listOffset], strLen);
-        listOffset += strLen;
-        list.values.emplace_back(str);
-      }
-      return Value(std::move(list));
-    }
+    case PropertyType::LIST_STRING:
     case PropertyType::LIST_INT:
-      return nebula::extractIntOrFloat<int32_t, List>(data_, offset);
     case PropertyType::LIST_FLOAT:
-      return nebula::extractIntOrFloat<float, List>(data_, offset);
-    case PropertyType::SET_STRING: {
-      int32_t setOffset;
-      memcpy(reinterpret_cast<void*>(&setOffset), &data_[offset], sizeof(int32_t));
-      if (static_cast<size_t>(setOffset) >= data_.size()) {
-        LOG(ERROR) << "Set offset out of bounds for SET_STRING.";
+    case PropertyType::SET_STRING:
+    case PropertyType::SET_INT:
+    case PropertyType::SET_FLOAT: {
+      CollectionView view;
+      if (!getCollectionView(index, view)) {
         return Value::kNullValue;
       }
-      int32_t setSize;
-      memcpy(reinterpret_cast<void*>(&setSize), &data_[setOffset], sizeof(int32_t));
-      setOffset += sizeof(int32_t);
-
-      Set set;
-      std::unordered_set<std::string> uniqueStrings;
-      for (int32_t i = 0; i < setSize; ++i) {
-        int32_t strLen;
-        memcpy(reinterpret_cast<void*>(&strLen), &data_[setOffset], sizeof(int32_t));
-        setOffset += sizeof(int32_t);
-        if (static_cast<size_t>(setOffset + strLen) > data_.size()) {
-          LOG(ERROR) << "String length out of bounds for SET_STRING.";
-          return Value::kNullValue;
-        }
-        std::string str(&data_[setOffset], strLen);
-        setOffset += strLen;
-        uniqueStrings.insert(std::move(str));
-      }
-      for (const auto& str : uniqueStrings) {
-        set.values.insert(Value(str));
-      }
-      return Value(std::move(set));
+      return view.materialize();
     }
-    case PropertyType::SET_INT:
-      return nebula::extractIntOrFloat<int32_t, Set>(data_, offset);
-    case PropertyType::SET_FLOAT:
-      return nebula::extractIntOrFloat<float, Set>(data_, offset);
     case PropertyType::UNKNOWN:
       break;
   }
@@ -308,6 +472,82 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
   return Value::kNullBadType;
 }
 
+bool RowReaderV2::getCollectionView(const int64_t index, CollectionView& view) const {
+  if (index < 0 || static_cast<size_t>(index) >= schema_->getNumFields()) {
+    return false;
+  }
+  auto field = schema_->field(index);
+  switch (field->type()) {
+    case PropertyType::LIST_STRING:
+    case PropertyType::LIST_INT:
+    case PropertyType::LIST_FLOAT:
+    case PropertyType::SET_STRING:
+    case PropertyType::SET_INT:
+    case PropertyType::SET_FLOAT:
+      break;
+    default:
+      return false;
+  }
+  if (field->nullable() && isNull(field->nullFlagPos())) {
+    return false;
+  }
+
+  size_t offset = headerLen_ + numNullBytes_ + field->offset();
+  int32_t containerOffset;
+  memcpy(reinterpret_cast<void*>(&containerOffset), &data_[offset], sizeof(int32_t));
+  if (containerOffset < 0 ||
+      static_cast<size_t>(containerOffset) + sizeof(int32_t) > data_.size()) {
+    LOG(ERROR) << "Container offset out of bounds. Offset: " << containerOffset
+               << ", Data size: " << data_.size();
+    return false;
+  }
+  int32_t sizeWord;
+  memcpy(reinterpret_cast<void*>(&sizeWord), &data_[containerOffset], sizeof(int32_t));
+  if (sizeWord < 0) {
+    LOG(ERROR) << "Illegal container size: " << sizeWord;
+    return false;
+  }
+  view.type_ = field->type();
+  view.size_ = sizeWord & kContainerSizeMask;
+  view.flags_ = sizeWord & ~kContainerSizeMask;
+  view.data_ = folly::StringPiece(data_.begin() + containerOffset + sizeof(int32_t), data_.end());
+  return true;
+}
+
+bool RowReaderV2::getStringView(const int64_t index, folly::StringPiece& view) const {
+  if (index < 0 || static_cast<size_t>(index) >= schema_->getNumFields()) {
+    return false;
+  }
+  auto field = schema_->field(index);
+  if (field->nullable() && isNull(field->nullFlagPos())) {
+    return false;
+  }
+  size_t offset = headerLen_ + numNullBytes_ + field->offset();
+  switch (field->type()) {
+    case PropertyType::STRING: {
+      int32_t strOffset;
+      int32_t strLen;
+      memcpy(reinterpret_cast<void*>(&strOffset), &data_[offset], sizeof(int32_t));
+      memcpy(reinterpret_cast<void*>(&strLen), &data_[offset + sizeof(int32_t)], sizeof(int32_t));
+      if (static_cast<size_t>(strOffset) == data_.size() && strLen == 0) {
+        view = folly::StringPiece();
+        return true;
+      }
+      if (strOffset < 0 || strLen < 0 ||
+          static_cast<size_t>(strOffset) + static_cast<size_t>(strLen) > data_.size()) {
+        return false;
+      }
+      view = folly::StringPiece(&data_[strOffset], strLen);
+      return true;
+    }
+    case PropertyType::FIXED_STRING:
+      view = folly::StringPiece(&data_[offset], field->size());
+      return true;
+    default:
+      return false;
+  }
+}
+
 int64_t RowReaderV2::getTimestamp() const noexcept {
   return *reinterpret_cast<const int64_t*>(data_.begin() + (data_.size() - sizeof(int64_t)));
 }
@@ -15,6 +15,59 @@ namespace nebula {
 
 class RowReaderWrapper;
 
+/**
+ * A read-only view over an encoded LIST_* or SET_* property. The elements are
+ * decoded on demand from the row buffer, so the size, membership and subscript
+ * could be evaluated without materializing the whole List or Set. The view is
+ * only valid as long as the underlying row buffer.
+ */
+class CollectionView final {
+  friend class RowReaderV2;
+
+ public:
+  CollectionView() = default;
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  bool isSet() const;
+
+  // Whether the elements are deduplicated and in ascending order, which holds
+  // for the SET_* properties written by the current version
+  bool isSorted() const;
+
+  // The type of the elements, INT, FLOAT or STRING
+  Value::Type elemType() const;
+
+  // Return the ith element, or NULL if out of range
+  Value at(size_t i) const;
+
+  bool contains(const Value& value) const;
+
+  // Decode all elements into a List or Set, a NULL is returned if the encoded
+  // data is broken
+  Value materialize() const;
+
+ private:
+  // Visit the elements in the encoded order until the visitor returns false.
+  // The string elements are passed as StringPiece without copy. Return false if
+  // the encoded data is broken.
+  template <typename Visitor>
+  bool visit(Visitor&& visitor) const;
+
+  nebula::cpp2::PropertyType type_{nebula::cpp2::PropertyType::UNKNOWN};
+  // The encoded elements, right after the element count
+  folly::StringPiece data_;
+  size_t size_{0};
+  // The element encoding flags in the count word, see codec/Common.h
+  int32_t flags_{0};
+};
+
 /**
  * This class decodes the data from version 2.0
  */
@@ -30,6 +83,15 @@ class RowReaderV2 {
   Value getValueByIndex(const int64_t index) const;
   int64_t getTimestamp() const noexcept;
 
+  // Get the lazy view of a LIST_* or SET_* property. Return false if the field
+  // is not a collection, is NULL or its encoded data is broken.
+  bool getCollectionView(const int64_t index, CollectionView& view) const;
+
+  // Get the bytes of a STRING or FIXED_STRING property without copy, which are
+  // only valid as long as the row buffer. Return false if the field is not a
+  // string or is NULL.
+  bool getStringView(const int64_t index, folly::StringPiece& view) const;
+
   size_t headerLen() const noexcept {
     return headerLen_;
   }
@@ -153,6 +153,16 @@ class RowReaderWrapper {
     return currReader_->getValueByIndex(index);
   }
 
+  bool getCollectionView(const int64_t index, CollectionView& view) const {
+    DCHECK(!!currReader_);
+    return currReader_->getCollectionView(index, view);
+  }
+
+  bool getStringView(const int64_t index, folly::StringPiece& view) const {
+    DCHECK(!!currReader_);
+    return currReader_->getStringView(index, view);
+  }
+
   int64_t getTimestamp() const noexcept {
     DCHECK(!!currReader_);
     return currReader_->getTimestamp();
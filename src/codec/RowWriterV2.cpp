@@ -5,6 +5,8 @@
 
 #include "codec/RowWriterV2.h"
 
+#include <folly/Varint.h>
+
 #include <cmath>
 
 #include "codec/Common.h"
@@ -17,7 +19,7 @@ namespace nebula {
 using nebula::cpp2::PropertyType;
 
 // Function used to identify the data type written
-WriteResult writeItem(const Value& item, Value::Type valueType, std::string& buffer) {
+WriteResult writeItem(const Value& item, Value::Type valueType, bool wide, std::string& buffer) {
   switch (valueType) {
     case Value::Type::STRING: {
       std::string str = item.getStr();
@@ -27,13 +29,23 @@ WriteResult writeItem(const Value& item, Value::Type valueType, std::string& buf
       break;
     }
     case Value::Type::INT: {
-      int32_t intVal = item.getInt();
-      buffer.append(reinterpret_cast<const char*>(&intVal), sizeof(int32_t));
+      if (wide) {
+        int64_t intVal = item.getInt();
+        buffer.append(reinterpret_cast<const char*>(&intVal), sizeof(int64_t));
+      } else {
+        int32_t intVal = item.getInt();
+        buffer.append(reinterpret_cast<const char*>(&intVal), sizeof(int32_t));
+      }
       break;
     }
     case Value::Type::FLOAT: {
-      float floatVal = item.getFloat();
-      buffer.append(reinterpret_cast<const char*>(&floatVal), sizeof(float));
+      if (wide) {
+        double floatVal = item.getFloat();
+        buffer.append(reinterpret_cast<const char*>(&floatVal), sizeof(double));
+      } else {
+        float floatVal = item.getFloat();
+        buffer.append(reinterpret_cast<const char*>(&floatVal), sizeof(float));
+      }
       break;
     }
     default:
@@ -43,9 +55,98 @@ WriteResult writeItem(const Value& item, Value::Type valueType, std::string& buf
   return WriteResult::SUCCEEDED;
 }
 
+// Whether any INT or FLOAT element would lose its value when narrowed to
+// int32 or float. The rows keep the original encoding otherwise, so they are
+// still readable by the older versions.
+template <typename Container>
+bool needWideElements(const Container& container, Value::Type valueType) {
+  for (const auto& item : container.values) {
+    if (item.type() != valueType) {
+      continue;
+    }
+    if (valueType == Value::Type::INT) {
+      auto intVal = item.getInt();
+      if (intVal < std::numeric_limits<int32_t>::min() ||
+          intVal > std::numeric_limits<int32_t>::max()) {
+        return true;
+      }
+    } else if (valueType == Value::Type::FLOAT) {
+      auto floatVal = item.getFloat();
+      if (!std::isnan(floatVal) && static_cast<double>(static_cast<float>(floatVal)) != floatVal) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Write the sorted INT elements as the varint deltas
+void writeIntDeltaVarint(const std::vector<const Value*>& elements, std::string& buffer) {
+  uint8_t varint[folly::kMaxVarintLength64];
+  for (size_t i = 0; i < elements.size(); ++i) {
+    uint64_t encoded = i == 0 ? folly::encodeZigZag(elements[i]->getInt())
+                              : static_cast<uint64_t>(elements[i]->getInt()) -
+                                    static_cast<uint64_t>(elements[i - 1]->getInt());
+    auto len = folly::encodeVarint(encoded, varint);
+    buffer.append(reinterpret_cast<const char*>(varint), len);
+  }
+}
+
+// Sort and deduplicate the elements of the given type. NaN is ordered after
+// all other floats.
+template <typename Set>
+std::vector<const Value*> sortedElements(const Set& container, Value::Type valueType) {
+  std::vector<const Value*> elements;
+  elements.reserve(container.values.size());
+  for (const auto& item : container.values) {
+    elements.emplace_back(&item);
+  }
+  switch (valueType) {
+    case Value::Type::INT: {
+      auto less = [](const Value* lhs, const Value* rhs) { return lhs->getInt() < rhs->getInt(); };
+      auto equal = [](const Value* lhs, const Value* rhs) {
+        return lhs->getInt() == rhs->getInt();
+      };
+      std::sort(elements.begin(), elements.end(), less);
+      elements.erase(std::unique(elements.begin(), elements.end(), equal), elements.end());
+      break;
+    }
+    case Value::Type::FLOAT: {
+      auto less = [](const Value* lhs, const Value* rhs) {
+        auto l = lhs->getFloat();
+        auto r = rhs->getFloat();
+        return l < r || (!std::isnan(l) && std::isnan(r));
+      };
+      auto equal = [](const Value* lhs, const Value* rhs) {
+        auto l = lhs->getFloat();
+        auto r = rhs->getFloat();
+        return l == r || (std::isnan(l) && std::isnan(r));
+      };
+      std::sort(elements.begin(), elements.end(), less);
+      elements.erase(std::unique(elements.begin(), elements.end(), equal), elements.end());
+      break;
+    }
+    case Value::Type::STRING: {
+      auto less = [](const Value* lhs, const Value* rhs) { return lhs->getStr() < rhs->getStr(); };
+      auto equal = [](const Value* lhs, const Value* rhs) {
+        return lhs->getStr() == rhs->getStr();
+      };
+      std::sort(elements.begin(), elements.end(), less);
+      elements.erase(std::unique(elements.begin(), elements.end(), equal), elements.end());
+      break;
+    }
+    default:
+      break;
+  }
+  return elements;
+}
+
 // Function used to identify List data types (List<string>, List<int>, List<float>)
 template <typename List>
-WriteResult writeList(const List& container, Value::Type valueType, std::string& buffer) {
+WriteResult writeList(const List& container,
+                      Value::Type valueType,
+                      bool wide,
+                      std::string& buffer) {
   int32_t listSize = container.values.size();
   if (listSize == 0) {
     return WriteResult::SUCCEEDED;
@@ -58,7 +159,7 @@ WriteResult writeList(const List& container, Value::Type valueType, std::string&
     }
   }
   for (const auto& item : container.values) {
-    auto result = writeItem(item, valueType, buffer);
+    auto result = writeItem(item, valueType, wide, buffer);
     if (result != WriteResult::SUCCEEDED) {
       return result;
     }
@@ -67,6 +168,7 @@ WriteResult writeList(const List& container, Value::Type valueType, std::string&
 }
 
 // Function used to identify Set data types (Set<string>, Set<int>, Set<float>)
+// The elements are written in the ascending order, with the count word
 template <typename Set>
 WriteResult writeSet(const Set& container, Value::Type valueType, std::string& buffer) {
   for (const auto& item : container.values) {
@@ -76,16 +178,27 @@ WriteResult writeSet(const Set& container, Value::Type valueType, std::string& b
       return WriteResult::TYPE_MISMATCH;
     }
   }
-  std::unordered_set<Value> serialized;
-  for (const auto& item : container.values) {
-    if (serialized.find(item) != serialized.end()) {
-      continue;
-    }
-    auto result = writeItem(item, valueType, buffer);
+  auto elements = sortedElements(container, valueType);
+  bool wide = needWideElements(container, valueType);
+  // The wide integer sets, e.g. the 64-bit id sets, are kept compact as the
+  // varint deltas
+  bool delta = wide && valueType == Value::Type::INT;
+  int32_t sizeWord = static_cast<int32_t>(elements.size()) | kContainerSorted;
+  if (delta) {
+    sizeWord |= kContainerDeltaVarint;
+  } else if (wide) {
+    sizeWord |= kContainerWideElements;
+  }
+  buffer.append(reinterpret_cast<const char*>(&sizeWord), sizeof(int32_t));
+  if (delta) {
+    writeIntDeltaVarint(elements, buffer);
+    return WriteResult::SUCCEEDED;
+  }
+  for (const auto* item : elements) {
+    auto result = writeItem(*item, valueType, wide, buffer);
     if (result != WriteResult::SUCCEEDED) {
       return result;
     }
-    serialized.insert(item);
   }
   return WriteResult::SUCCEEDED;
 }
@@ -898,9 +1011,14 @@ WriteResult RowWriterV2::write(ssize_t index, const Geography& v) {
       folly::to<uint32_t>(geoShape) != folly::to<uint32_t>(v.shape())) {
     return WriteResult::TYPE_MISMATCH;
   }
-  // Geography is stored as WKB format.
+  // Geography is stored as WKB format, normalized and validated, so it's trusted when read.
   // WKB is a binary string.
-  std::string wkb = v.asWKB();
+  Geography geog = v;
+  geog.normalize();
+  if (!geog.isValid().ok()) {
+    return WriteResult::INCORRECT_VALUE;
+  }
+  std::string wkb = geog.asWKB();
   return write(index, folly::StringPiece(wkb), true);
 }
 
@@ -916,7 +1034,6 @@ WriteResult RowWriterV2::write(ssize_t index, const List& list) {
   if (isSet_[index]) {
     outOfSpaceStr_ = true;
   }
-  buf_.append(reinterpret_cast<const char*>(&listSize), sizeof(int32_t));
   Value::Type valueType;
   if (field->type() == PropertyType::LIST_STRING) {
     valueType = Value::Type::STRING;
@@ -928,7 +1045,10 @@ WriteResult RowWriterV2::write(ssize_t index, const List& list) {
     LOG(ERROR) << "Unsupported list type: " << static_cast<int>(field->type());
     return WriteResult::TYPE_MISMATCH;
   }
-  auto result = writeList(list, valueType, buf_);
+  bool wide = needWideElements(list, valueType);
+  int32_t sizeWord = wide ? (listSize | kContainerWideElements) : listSize;
+  buf_.append(reinterpret_cast<const char*>(&sizeWord), sizeof(int32_t));
+  auto result = writeList(list, valueType, wide, buf_);
   if (result != WriteResult::SUCCEEDED) {
     return result;
   }
@@ -952,7 +1072,6 @@ WriteResult RowWriterV2::write(ssize_t index, const Set& set) {
   if (isSet_[index]) {
     outOfSpaceStr_ = true;
   }
-  buf_.append(reinterpret_cast<const char*>(&setSize), sizeof(int32_t));
   Value::Type valueType;
   if (field->type() == PropertyType::SET_STRING) {
     valueType = Value::Type::STRING;
@@ -0,0 +1,156 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+
+using nebula::CollectionView;
+using nebula::List;
+using nebula::RowReaderWrapper;
+using nebula::RowWriterV2;
+using nebula::Set;
+using nebula::Value;
+using nebula::cpp2::PropertyType;
+using nebula::meta::NebulaSchemaProvider;
+
+// The schema of a collection property, its value and the row encoded
+struct Collections {
+  NebulaSchemaProvider schema;
+  Value value;
+  std::string encoded;
+};
+
+// The max size of a collection property is 65535
+const std::vector<size_t> kSizes = {10, 1000, 65535};  // NOLINT
+std::unordered_map<std::string, Collections> collections;  // NOLINT
+
+std::string key(PropertyType type, size_t size) {
+  return folly::stringPrintf("%s_%lu", apache::thrift::util::enumNameSafe(type).c_str(), size);
+}
+
+void prepare(PropertyType type) {
+  for (auto size : kSizes) {
+    auto& c = collections[key(type, size)];
+    c.schema.addField("col", type);
+    std::vector<Value> values;
+    for (size_t i = 0; i < size; i++) {
+      if (type == PropertyType::LIST_STRING || type == PropertyType::SET_STRING) {
+        values.emplace_back(folly::stringPrintf("value_%08lu", i * 7919 % size));
+      } else if (type == PropertyType::LIST_FLOAT || type == PropertyType::SET_FLOAT) {
+        values.emplace_back(static_cast<double>(i * 7919 % size) / 3);
+      } else {
+        values.emplace_back(static_cast<int64_t>(i * 7919 % size));
+      }
+    }
+    if (type == PropertyType::SET_STRING || type == PropertyType::SET_INT ||
+        type == PropertyType::SET_FLOAT) {
+      c.value = Set(std::unordered_set<Value>(values.begin(), values.end()));
+    } else {
+      c.value = List(std::move(values));
+    }
+    RowWriterV2 writer(&c.schema);
+    CHECK(writer.set(0, c.value) == nebula::WriteResult::SUCCEEDED);
+    CHECK(writer.finish() == nebula::WriteResult::SUCCEEDED);
+    c.encoded = std::move(writer).moveEncodedStr();
+  }
+}
+
+size_t write(size_t iters, PropertyType type, size_t size) {
+  auto& c = collections.at(key(type, size));
+  for (size_t i = 0; i < iters; i++) {
+    RowWriterV2 writer(&c.schema);
+    writer.set(0, c.value);
+    writer.finish();
+    std::string encoded = std::move(writer).moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+  return iters;
+}
+
+size_t read(size_t iters, PropertyType type, size_t size) {
+  auto& c = collections.at(key(type, size));
+  for (size_t i = 0; i < iters; i++) {
+    auto reader = RowReaderWrapper::getRowReader(&c.schema, c.encoded);
+    auto value = reader->getValueByIndex(0);
+    folly::doNotOptimizeAway(value);
+  }
+  return iters;
+}
+
+// Look up an element in the encoded collection without decoding it
+size_t contains(size_t iters, PropertyType type, size_t size) {
+  auto& c = collections.at(key(type, size));
+  auto reader = RowReaderWrapper::getRowReader(&c.schema, c.encoded);
+  for (size_t i = 0; i < iters; i++) {
+    CollectionView view;
+    reader->getCollectionView(0, view);
+    Value target = type == PropertyType::LIST_STRING || type == PropertyType::SET_STRING
+                       ? Value(folly::stringPrintf("value_%08lu", i % size))
+                       : Value(static_cast<int64_t>(i % size));
+    folly::doNotOptimizeAway(view.contains(target));
+  }
+  return iters;
+}
+
+/*************************
+ * Beginning of benchmarks
+ ************************/
+BENCHMARK_NAMED_PARAM(write, ListInt_10, PropertyType::LIST_INT, 10)
+BENCHMARK_NAMED_PARAM(write, ListInt_1K, PropertyType::LIST_INT, 1000)
+BENCHMARK_NAMED_PARAM(write, ListInt_64K, PropertyType::LIST_INT, 65535)
+BENCHMARK_NAMED_PARAM(write, ListFloat_1K, PropertyType::LIST_FLOAT, 1000)
+BENCHMARK_NAMED_PARAM(write, ListString_10, PropertyType::LIST_STRING, 10)
+BENCHMARK_NAMED_PARAM(write, ListString_1K, PropertyType::LIST_STRING, 1000)
+BENCHMARK_NAMED_PARAM(write, ListString_64K, PropertyType::LIST_STRING, 65535)
+BENCHMARK_NAMED_PARAM(write, SetInt_10, PropertyType::SET_INT, 10)
+BENCHMARK_NAMED_PARAM(write, SetInt_1K, PropertyType::SET_INT, 1000)
+BENCHMARK_NAMED_PARAM(write, SetInt_64K, PropertyType::SET_INT, 65535)
+BENCHMARK_NAMED_PARAM(write, SetString_1K, PropertyType::SET_STRING, 1000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(read, ListInt_10, PropertyType::LIST_INT, 10)
+BENCHMARK_NAMED_PARAM(read, ListInt_1K, PropertyType::LIST_INT, 1000)
+BENCHMARK_NAMED_PARAM(read, ListInt_64K, PropertyType::LIST_INT, 65535)
+BENCHMARK_NAMED_PARAM(read, ListFloat_1K, PropertyType::LIST_FLOAT, 1000)
+BENCHMARK_NAMED_PARAM(read, ListString_10, PropertyType::LIST_STRING, 10)
+BENCHMARK_NAMED_PARAM(read, ListString_1K, PropertyType::LIST_STRING, 1000)
+BENCHMARK_NAMED_PARAM(read, ListString_64K, PropertyType::LIST_STRING, 65535)
+BENCHMARK_NAMED_PARAM(read, SetInt_10, PropertyType::SET_INT, 10)
+BENCHMARK_NAMED_PARAM(read, SetInt_1K, PropertyType::SET_INT, 1000)
+BENCHMARK_NAMED_PARAM(read, SetInt_64K, PropertyType::SET_INT, 65535)
+BENCHMARK_NAMED_PARAM(read, SetString_1K, PropertyType::SET_STRING, 1000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(contains, ListInt_10, PropertyType::LIST_INT, 10)
+BENCHMARK_NAMED_PARAM(contains, ListInt_1K, PropertyType::LIST_INT, 1000)
+BENCHMARK_NAMED_PARAM(contains, ListInt_64K, PropertyType::LIST_INT, 65535)
+BENCHMARK_NAMED_PARAM(contains, SetInt_1K, PropertyType::SET_INT, 1000)
+BENCHMARK_NAMED_PARAM(contains, SetInt_64K, PropertyType::SET_INT, 65535)
+BENCHMARK_NAMED_PARAM(contains, ListString_1K, PropertyType::LIST_STRING, 1000)
+BENCHMARK_NAMED_PARAM(contains, SetString_1K, PropertyType::SET_STRING, 1000)
+/*************************
+ * End of benchmarks
+ ************************/
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  for (auto type : {PropertyType::LIST_INT,
+                    PropertyType::LIST_FLOAT,
+                    PropertyType::LIST_STRING,
+                    PropertyType::SET_INT,
+                    PropertyType::SET_STRING}) {
+    prepare(type);
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
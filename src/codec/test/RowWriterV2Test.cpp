@@ -495,6 +495,33 @@ TEST(RowWriterV2, EmptyString) {
   EXPECT_EQ("", v2.getStr());
 }
 
+TEST(RowWriterV2, Geography) {
+  meta::NebulaSchemaProvider schema(0 /*Schema version*/);
+  schema.addField("Col01", PropertyType::GEOGRAPHY, 0, true, "", meta::cpp2::GeoShape::ANY);
+  {
+    // Normalized when written, so it's read as it is
+    RowWriterV2 writer(&schema);
+    Geography line = LineString(
+        std::vector<Coordinate>{Coordinate(0, 1), Coordinate(0, 1), Coordinate(3, 7)});
+    EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, line));
+    ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+    std::string encoded = std::move(writer).moveEncodedStr();
+    auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+    auto v = reader->getValueByIndex(0);
+    ASSERT_TRUE(v.isGeography());
+    EXPECT_EQ(
+        Geography(LineString(std::vector<Coordinate>{Coordinate(0, 1), Coordinate(3, 7)})),
+        v.getGeography());
+  }
+  {
+    // Invalid ones are rejected, as they are trusted when read
+    RowWriterV2 writer(&schema);
+    Geography point = Point(Coordinate(200.0, 100.0));
+    EXPECT_EQ(WriteResult::INCORRECT_VALUE, writer.set(0, point));
+  }
+}
+
 TEST(RowWriterV2, NumericLimit) {
   meta::NebulaSchemaProvider schema(1 /*Schema version*/);
   schema.addField("Col01", PropertyType::INT8);
@@ -807,6 +834,192 @@ TEST(RowWriterV2, TimestampTest) {
   }
 }
 
+TEST(RowWriterV2, CollectionView) {
+  meta::NebulaSchemaProvider schema(1);
+  schema.addField("Col01", PropertyType::LIST_INT);
+  schema.addField("Col02", PropertyType::LIST_STRING);
+  schema.addField("Col03", PropertyType::SET_FLOAT);
+  schema.addField("Col04", PropertyType::INT64);
+  schema.addField("Col05", PropertyType::LIST_STRING, 0, true);
+
+  RowWriterV2 writer(&schema);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, List({1, 2, 3})));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(1, List({"a", "bc", ""})));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(2, Set({1.5, 2.5})));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(3, 10));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setNull(4));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+  std::string encoded = std::move(writer).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+
+  CollectionView view;
+  ASSERT_TRUE(reader->getCollectionView(0, view));
+  EXPECT_EQ(3, view.size());
+  EXPECT_FALSE(view.isSet());
+  EXPECT_EQ(Value::Type::INT, view.elemType());
+  EXPECT_EQ(Value(2), view.at(1));
+  EXPECT_TRUE(view.at(3).isNull());
+  EXPECT_TRUE(view.contains(3));
+  EXPECT_TRUE(view.contains(3.0));
+  EXPECT_FALSE(view.contains(4));
+  EXPECT_FALSE(view.contains("3"));
+  EXPECT_EQ(Value(List({1, 2, 3})), view.materialize());
+  EXPECT_EQ(Value(List({1, 2, 3})), reader->getValueByIndex(0));
+
+  ASSERT_TRUE(reader->getCollectionView(1, view));
+  EXPECT_EQ(3, view.size());
+  EXPECT_EQ(Value("bc"), view.at(1));
+  EXPECT_TRUE(view.contains(""));
+  EXPECT_FALSE(view.contains("b"));
+  EXPECT_EQ(Value(List({"a", "bc", ""})), view.materialize());
+
+  ASSERT_TRUE(reader->getCollectionView(2, view));
+  EXPECT_TRUE(view.isSet());
+  EXPECT_EQ(Value::Type::FLOAT, view.elemType());
+  EXPECT_TRUE(view.contains(2.5));
+  EXPECT_FALSE(view.contains(2));
+  EXPECT_EQ(Value(Set({1.5, 2.5})), view.materialize());
+
+  // Not a collection, or NULL
+  EXPECT_FALSE(reader->getCollectionView(3, view));
+  EXPECT_FALSE(reader->getCollectionView(4, view));
+  EXPECT_FALSE(reader->getCollectionView(5, view));
+}
+
+TEST(RowWriterV2, StringView) {
+  meta::NebulaSchemaProvider schema(1);
+  schema.addField("Col01", PropertyType::STRING);
+  schema.addField("Col02", PropertyType::FIXED_STRING, 8);
+  schema.addField("Col03", PropertyType::STRING);
+  schema.addField("Col04", PropertyType::INT64);
+  schema.addField("Col05", PropertyType::STRING, 0, true);
+
+  RowWriterV2 writer(&schema);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, "follow"));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(1, "abc"));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(2, ""));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(3, 10));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setNull(4));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+  std::string encoded = std::move(writer).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+
+  folly::StringPiece view;
+  ASSERT_TRUE(reader->getStringView(0, view));
+  EXPECT_EQ("follow", view);
+  EXPECT_TRUE(view.begin() >= encoded.data() && view.end() <= encoded.data() + encoded.size());
+  // The same bytes as the value read, with the padding of the fixed string
+  ASSERT_TRUE(reader->getStringView(1, view));
+  EXPECT_EQ(reader->getValueByIndex(1).getStr(), view.str());
+  ASSERT_TRUE(reader->getStringView(2, view));
+  EXPECT_TRUE(view.empty());
+
+  // Not a string, or NULL
+  EXPECT_FALSE(reader->getStringView(3, view));
+  EXPECT_FALSE(reader->getStringView(4, view));
+  EXPECT_FALSE(reader->getStringView(5, view));
+}
+
+TEST(RowWriterV2, WideCollection) {
+  meta::NebulaSchemaProvider schema(1);
+  schema.addField("Col01", PropertyType::LIST_INT);
+  schema.addField("Col02", PropertyType::LIST_FLOAT);
+  schema.addField("Col03", PropertyType::SET_INT);
+  schema.addField("Col04", PropertyType::SET_FLOAT);
+  schema.addField("Col05", PropertyType::SET_INT);
+
+  int64_t big = std::numeric_limits<int64_t>::max();
+  int64_t small = std::numeric_limits<int64_t>::min();
+  List intList({big, 1, small});
+  List floatList({0.1, 1.5, 1e100});
+  Set intSet({big, small, 0, 10000000000, -10000000000});
+  Set floatSet({0.1, 0.2});
+  // Fit into int32, keep the original encoding
+  Set narrowSet({1, -2, 3});
+
+  RowWriterV2 writer(&schema);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, intList));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(1, floatList));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(2, intSet));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(3, floatSet));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(4, narrowSet));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+  std::string encoded = std::move(writer).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  EXPECT_EQ(Value(intList), reader->getValueByIndex(0));
+  EXPECT_EQ(Value(floatList), reader->getValueByIndex(1));
+  EXPECT_EQ(Value(intSet), reader->getValueByIndex(2));
+  EXPECT_EQ(Value(floatSet), reader->getValueByIndex(3));
+  EXPECT_EQ(Value(narrowSet), reader->getValueByIndex(4));
+
+  CollectionView view;
+  ASSERT_TRUE(reader->getCollectionView(2, view));
+  EXPECT_EQ(5, view.size());
+  // Sorted by the delta encoding
+  EXPECT_EQ(Value(small), view.at(0));
+  EXPECT_EQ(Value(big), view.at(4));
+  EXPECT_TRUE(view.contains(-10000000000));
+  EXPECT_FALSE(view.contains(10000000001));
+}
+
+TEST(RowWriterV2, SortedSet) {
+  meta::NebulaSchemaProvider schema(1);
+  schema.addField("Col01", PropertyType::SET_STRING);
+  schema.addField("Col02", PropertyType::SET_INT);
+  schema.addField("Col03", PropertyType::SET_FLOAT);
+  schema.addField("Col04", PropertyType::LIST_INT);
+
+  Set strSet({"b", "c", "a", ""});
+  Set intSet({5, -3, 100, 7});
+  Set floatSet({2.5, -1.5, std::numeric_limits<double>::quiet_NaN(), 0.0});
+  RowWriterV2 writer(&schema);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, strSet));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(1, intSet));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(2, floatSet));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(3, List({3, 1, 2})));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+  std::string encoded = std::move(writer).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  EXPECT_EQ(Value(strSet), reader->getValueByIndex(0));
+  EXPECT_EQ(Value(intSet), reader->getValueByIndex(1));
+
+  CollectionView view;
+  ASSERT_TRUE(reader->getCollectionView(0, view));
+  EXPECT_TRUE(view.isSorted());
+  EXPECT_EQ(Value(""), view.at(0));
+  EXPECT_EQ(Value("c"), view.at(3));
+  EXPECT_TRUE(view.contains("b"));
+  EXPECT_FALSE(view.contains("bb"));
+
+  ASSERT_TRUE(reader->getCollectionView(1, view));
+  EXPECT_TRUE(view.isSorted());
+  EXPECT_EQ(Value(-3), view.at(0));
+  EXPECT_EQ(Value(100), view.at(3));
+  for (auto v : {-3, 5, 7, 100}) {
+    EXPECT_TRUE(view.contains(v));
+  }
+  for (auto v : {-4, 0, 6, 101}) {
+    EXPECT_FALSE(view.contains(v));
+  }
+  EXPECT_FALSE(view.contains(10000000000));
+  EXPECT_TRUE(view.contains(7.0));
+
+  ASSERT_TRUE(reader->getCollectionView(2, view));
+  EXPECT_TRUE(view.isSorted());
+  EXPECT_EQ(Value(-1.5), view.at(0));
+  EXPECT_EQ(Value(2.5), view.at(2));
+  EXPECT_TRUE(std::isnan(view.at(3).getFloat()));
+
+  // The lists keep the original order
+  ASSERT_TRUE(reader->getCollectionView(3, view));
+  EXPECT_FALSE(view.isSorted());
+  EXPECT_EQ(Value(List({3, 1, 2})), view.materialize());
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
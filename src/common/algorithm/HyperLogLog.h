@@ -0,0 +1,117 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_ALGORITHM_HYPERLOGLOG_H_
+#define COMMON_ALGORITHM_HYPERLOGLOG_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * @brief The HyperLogLog estimate of the number of the distinct hashes added, whose standard
+ * error is about 1.04 / sqrt(2 ^ kPrecision), i.e. 0.8%.
+ *
+ * The hashes are kept exactly until there are more than kSparseLimit, so a small count is exact
+ * and costs little memory, which matters since there is a sketch per group. The sketches are
+ * mergeable, merging them is the same as adding the hashes of both into one.
+ *
+ * The hashes should be well mixed, e.g. by folly::hash::twang_mix64.
+ */
+class HyperLogLog final {
+ public:
+  static constexpr uint32_t kPrecision = 14;
+  static constexpr size_t kNumRegisters = 1 << kPrecision;
+  static constexpr size_t kSparseLimit = 512;
+
+  void add(uint64_t hash) {
+    if (registers_.empty()) {
+      auto iter = std::lower_bound(sparse_.begin(), sparse_.end(), hash);
+      if (iter != sparse_.end() && *iter == hash) {
+        return;
+      }
+      sparse_.insert(iter, hash);
+      if (sparse_.size() > kSparseLimit) {
+        toDense();
+      }
+      return;
+    }
+    addToRegister(hash);
+  }
+
+  void merge(const HyperLogLog& other) {
+    if (other.registers_.empty()) {
+      for (auto hash : other.sparse_) {
+        add(hash);
+      }
+      return;
+    }
+    if (registers_.empty()) {
+      toDense();
+    }
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+      setRegister(i, other.registers_[i]);
+    }
+  }
+
+  uint64_t estimate() const {
+    if (registers_.empty()) {
+      return sparse_.size();
+    }
+    constexpr double m = kNumRegisters;
+    constexpr double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / inverseSum_;
+    // The linear counting is more accurate for the small cardinalities
+    if (estimate <= 2.5 * m && zeros_ > 0) {
+      estimate = m * std::log(m / zeros_);
+    }
+    return static_cast<uint64_t>(std::llround(estimate));
+  }
+
+ private:
+  void toDense() {
+    registers_.assign(kNumRegisters, 0);
+    inverseSum_ = kNumRegisters;
+    zeros_ = kNumRegisters;
+    for (auto hash : sparse_) {
+      addToRegister(hash);
+    }
+    sparse_.clear();
+    sparse_.shrink_to_fit();
+  }
+
+  void addToRegister(uint64_t hash) {
+    size_t index = hash >> (64 - kPrecision);
+    // The guard bit bounds the rank by 64 - kPrecision + 1
+    uint64_t rest = (hash << kPrecision) | (1ULL << (kPrecision - 1));
+    setRegister(index, static_cast<uint8_t>(__builtin_clzll(rest) + 1));
+  }
+
+  // Keep the larger rank, and the sum of 2 ^ -rank and the zeros up to date so the estimate is
+  // cheap to read after each add
+  void setRegister(size_t index, uint8_t rank) {
+    auto& reg = registers_[index];
+    if (rank <= reg) {
+      return;
+    }
+    if (reg == 0) {
+      zeros_--;
+    }
+    inverseSum_ += std::ldexp(1.0, -rank) - std::ldexp(1.0, -reg);
+    reg = rank;
+  }
+
+  // The sorted distinct hashes before there are too many
+  std::vector<uint64_t> sparse_;
+  std::vector<uint8_t> registers_;
+  double inverseSum_{0};
+  size_t zeros_{0};
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+
+#endif  // COMMON_ALGORITHM_HYPERLOGLOG_H_
@@ -28,20 +28,33 @@ class ReservoirSampling final {
   }
 
   bool sampling(T&& sample) {
-    if (cnt_ < num_) {
+    auto slot = nextSlot();
+    if (slot < 0) {
+      return false;
+    }
+    put(slot, std::move(sample));
+    return true;
+  }
+
+  // The slot of the next item in the samples if it's kept, or -1 if it's not. So the items not
+  // kept needn't be built at all, and the kept ones are put to their slots then.
+  int64_t nextSlot() {
+    auto cnt = cnt_++;
+    if (cnt < num_) {
+      return static_cast<int64_t>(cnt);
+    }
+    // Each of the first cnt + 1 items is kept by the chance of num_ / (cnt + 1)
+    auto index = folly::Random::rand64(cnt + 1);
+    return index < num_ ? static_cast<int64_t>(index) : -1;
+  }
+
+  void put(int64_t slot, T&& sample) {
+    DCHECK_GE(slot, 0);
+    if (static_cast<size_t>(slot) == samples_.size()) {
       samples_.emplace_back(std::move(sample));
-      ++cnt_;
-      return true;
     } else {
-      auto index = folly::Random::rand64(cnt_);
-      if (index < num_) {
-        samples_[index] = (std::move(sample));
-        ++cnt_;
-        return true;
-      }
+      samples_[slot] = std::move(sample);
     }
-    ++cnt_;
-    return false;
   }
 
   std::vector<T> samples() {
@@ -0,0 +1,158 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_ALGORITHM_TDIGEST_H_
+#define COMMON_ALGORITHM_TDIGEST_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * @brief The merging t-digest, which estimates the quantiles of the values added by the centroids
+ * of them. The centroids near the tails are smaller, so the extreme quantiles, e.g. p99, are more
+ * accurate than the median. There are at most about the compression centroids.
+ *
+ * The values are buffered and merged into the centroids when the buffer is full or a quantile is
+ * read. The digests are mergeable, merging them keeps the accuracy.
+ */
+class TDigest final {
+ public:
+  static constexpr double kDefaultCompression = 100;
+
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  explicit TDigest(double compression = kDefaultCompression)
+      : compression_(std::max(compression, 10.0)) {
+    buffer_.reserve(bufferSize());
+  }
+
+  void add(double value, double weight = 1) {
+    if (std::isnan(value) || weight <= 0) {
+      return;
+    }
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    buffer_.push_back({value, weight});
+    if (buffer_.size() >= bufferSize()) {
+      compress();
+    }
+  }
+
+  void merge(const TDigest& other) {
+    if (other.empty()) {
+      return;
+    }
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    compress();
+  }
+
+  bool empty() const {
+    return centroids_.empty() && buffer_.empty();
+  }
+
+  // The estimated value at the quantile q in [0, 1], NaN if nothing is added
+  double quantile(double q) {
+    compress();
+    if (centroids_.empty()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    if (centroids_.size() == 1) {
+      return centroids_[0].mean;
+    }
+    // Each centroid is regarded as centered at the middle of its weight, and the values between
+    // the centers are interpolated linearly
+    auto target = q * totalWeight_;
+    const auto& first = centroids_.front();
+    if (target <= first.weight / 2) {
+      return min_ + (first.mean - min_) * target / (first.weight / 2);
+    }
+    double cumulative = 0;
+    for (size_t i = 0; i + 1 < centroids_.size(); ++i) {
+      const auto& cur = centroids_[i];
+      const auto& next = centroids_[i + 1];
+      auto center = cumulative + cur.weight / 2;
+      auto nextCenter = cumulative + cur.weight + next.weight / 2;
+      if (target <= nextCenter) {
+        return cur.mean + (next.mean - cur.mean) * (target - center) / (nextCenter - center);
+      }
+      cumulative += cur.weight;
+    }
+    const auto& last = centroids_.back();
+    auto center = totalWeight_ - last.weight / 2;
+    return std::min(max_, last.mean + (max_ - last.mean) * (target - center) / (last.weight / 2));
+  }
+
+ private:
+  size_t bufferSize() const {
+    return static_cast<size_t>(compression_) * 5;
+  }
+
+  // The scale function k1, which bounds the weight of a centroid by its quantile
+  double kOf(double q) const {
+    return compression_ / (2 * M_PI) * std::asin(2 * q - 1);
+  }
+
+  double qOf(double k) const {
+    if (k >= compression_ / 4) {
+      return 1;
+    }
+    return (std::sin(k * 2 * M_PI / compression_) + 1) / 2;
+  }
+
+  void compress() {
+    if (buffer_.empty()) {
+      return;
+    }
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.mean < rhs.mean;
+    });
+    double total = 0;
+    for (const auto& c : buffer_) {
+      total += c.weight;
+    }
+    centroids_.clear();
+    double weightSoFar = 0;
+    double weightLimit = total * qOf(kOf(0) + 1);
+    auto cur = buffer_[0];
+    for (size_t i = 1; i < buffer_.size(); ++i) {
+      const auto& next = buffer_[i];
+      if (weightSoFar + cur.weight + next.weight <= weightLimit) {
+        cur.weight += next.weight;
+        cur.mean += (next.mean - cur.mean) * next.weight / cur.weight;
+        continue;
+      }
+      weightSoFar += cur.weight;
+      centroids_.emplace_back(cur);
+      weightLimit = total * qOf(kOf(weightSoFar / total) + 1);
+      cur = next;
+    }
+    centroids_.emplace_back(cur);
+    totalWeight_ = total;
+    buffer_.clear();
+  }
+
+  const double compression_;
+  // Sorted by the means
+  std::vector<Centroid> centroids_;
+  std::vector<Centroid> buffer_;
+  double totalWeight_{0};
+  double min_{std::numeric_limits<double>::infinity()};
+  double max_{-std::numeric_limits<double>::infinity()};
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+
+#endif  // COMMON_ALGORITHM_TDIGEST_H_
@@ -40,5 +40,34 @@ TEST(ReservoirSamplingTest, Sample) {
     }
   }
 }
+
+TEST(ReservoirSamplingTest, NextSlot) {
+  // Each item is kept by the same chance
+  constexpr int64_t kItems = 20;
+  constexpr int64_t kRounds = 20000;
+  ReservoirSampling<int64_t> sampler(5);
+  std::vector<int64_t> counts(kItems, 0);
+  for (int64_t round = 0; round < kRounds; ++round) {
+    for (int64_t i = 0; i < kItems; ++i) {
+      auto slot = sampler.nextSlot();
+      if (i < 5) {
+        EXPECT_EQ(i, slot);
+      }
+      if (slot >= 0) {
+        EXPECT_LT(slot, 5);
+        sampler.put(slot, int64_t(i));
+      }
+    }
+    auto result = sampler.samples();
+    EXPECT_EQ(5, result.size());
+    for (auto i : result) {
+      ++counts[i];
+    }
+  }
+  // The expected count of each item is kRounds / 4
+  for (auto count : counts) {
+    EXPECT_LT(std::abs(count - kRounds / 4), kRounds / 40);
+  }
+}
 }  // namespace algorithm
 }  // namespace nebula
@@ -12,13 +12,12 @@ void* Arena::allocateAligned(const std::size_t alloc) {
   DCHECK_NE(alloc, 0);  // don't allow zero sized allocation
   // replace the modulo operation by bit and
   static_assert(kAlignment && !(kAlignment & (kAlignment - 1)), "Align must be power of 2.");
+  if (UNLIKELY(alloc > kMaxChunkSize - kAlignment)) {
+    return allocateLarge(alloc);
+  }
   const std::size_t pad =
       kAlignment - (reinterpret_cast<uintptr_t>(currentPtr_) & (kAlignment - 1));
   const std::size_t consumption = alloc + pad;
-  if (UNLIKELY(consumption > kMaxChunkSize)) {
-    DLOG(FATAL) << "Arena can't allocate so large memory.";
-    return nullptr;
-  }
   if (LIKELY(consumption <= availableSize_)) {
     void* ptr = currentPtr_ + pad;
     currentPtr_ += consumption;
@@ -26,6 +26,11 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
       delete[] currentChunk_;
       currentChunk_ = prev;
     }
+    while (largeChunk_ != nullptr) {
+      auto *prev = largeChunk_->prev;
+      delete[] largeChunk_;
+      largeChunk_ = prev;
+    }
 #ifndef NDEBUG
     allocatedSize_ = 0;
 #endif
@@ -62,6 +67,16 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
     };
   };
 
+  // The allocation larger than the chunks is in its own chunk, which keeps the current chunk
+  void *allocateLarge(std::size_t size) {
+    std::byte *ptr = new std::byte[size + sizeof(Chunk)];
+    largeChunk_ = new (ptr) Chunk(largeChunk_);
+#ifndef NDEBUG
+    allocatedSize_ += size;
+#endif
+    return ptr + sizeof(Chunk);
+  }
+
   // allocate new chunk
   // The current pointer will keep alignment
   void newChunk(std::size_t size) {
@@ -73,6 +88,7 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
   }
 
   Chunk *currentChunk_{nullptr};
+  Chunk *largeChunk_{nullptr};
 // These are debug info
 // Remove to speed up in Release build
 #ifndef NDEBUG
@@ -87,4 +103,42 @@ class Arena : public boost::noncopyable, cpp::NonMovable {
   std::byte *currentPtr_{nullptr};
 };
 
+// The STL allocator from an arena, the memory is released with the arena rather than deallocate,
+// so it fits the containers which only grow and are dropped at once, e.g.
+//   ArenaAllocator<int> alloc(&arena);
+//   std::vector<int, ArenaAllocator<int>> v(alloc);
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena *arena) : arena_(DCHECK_NOTNULL(arena)) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}  // NOLINT
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(arena_->allocateAligned(n * sizeof(T)));
+  }
+
+  void deallocate(T *, std::size_t) {}
+
+  Arena *arena() const {
+    return arena_;
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &rhs) const {
+    return arena_ == rhs.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &rhs) const {
+    return arena_ != rhs.arena();
+  }
+
+ private:
+  Arena *arena_;
+};
+
 }  // namespace nebula
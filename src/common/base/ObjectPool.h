@@ -9,8 +9,6 @@
 #include <folly/SpinLock.h>
 
 #include <boost/core/noncopyable.hpp>
-#include <functional>
-#include <list>
 #include <type_traits>
 
 #include "common/base/Arena.h"
@@ -31,9 +29,17 @@ class ObjectPool final : private boost::noncopyable, private cpp::NonMovable {
     clear();
   }
 
+  // Destroy the objects in the order they're made, the memory is kept until the pool is destroyed
   void clear() {
     SLGuard g(lock_);
-    objects_.clear();
+    for (auto *block = head_; block != nullptr; block = block->next) {
+      for (size_t i = 0; i < block->size; ++i) {
+        block->objects[i].destroy(block->objects[i].ptr);
+      }
+      block->size = 0;
+    }
+    tail_ = head_;
+    size_ = 0;
   }
 
   template <typename T, typename... Args>
@@ -43,39 +49,65 @@ class ObjectPool final : private boost::noncopyable, private cpp::NonMovable {
       // alloc happens here(may throw bad_alloc), use guard to guarantee unlock
       SLGuard g(lock_);
       ptr = arena_.allocateAligned(sizeof(T));
+      if constexpr (std::is_trivially_destructible_v<T>) {
+        ++size_;
+      }
+    }
+    // The object is constructed out of the lock, since it may make the others in the pool
+    auto *obj = new (ptr) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      add(obj);
     }
-    return add(new (ptr) T(std::forward<Args>(args)...));
+    return obj;
   }
 
   bool empty() const {
-    return objects_.empty();
+    return size_ == 0;
   }
 
  private:
-  // Holder the ownership of the any object
-  class OwnershipHolder {
-   public:
-    template <typename T>
-    explicit OwnershipHolder(T *obj)
-        : obj_(obj), deleteFn_([](void *p) { reinterpret_cast<T *>(p)->~T(); }) {}
-
-    ~OwnershipHolder() {
-      deleteFn_(obj_);
-    }
+  // An object owned, destroyed by the destructor of its type
+  struct Object {
+    void *ptr;
+    void (*destroy)(void *);
+  };
+
+  // The objects to destroy are kept in the blocks allocated from the arena as well, so making an
+  // object is a pointer bump in the arena, and the pool is released by freeing the chunks of the
+  // arena after calling the destructors. The trivially destructible objects are not kept.
+  struct Block {
+    static constexpr size_t kCapacity = 128;
 
-   private:
-    void *obj_;
-    std::function<void(void *)> deleteFn_;
+    Block *next{nullptr};
+    size_t size{0};
+    Object objects[kCapacity];
   };
 
   template <typename T>
-  T *add(T *obj) {
+  void add(T *obj) {
     SLGuard g(lock_);
-    objects_.emplace_back(obj);
-    return obj;
+    if (tail_ == nullptr || tail_->size == Block::kCapacity) {
+      if (tail_ != nullptr && tail_->next != nullptr) {
+        // The blocks emptied by clear
+        tail_ = tail_->next;
+      } else {
+        auto *block = new (arena_.allocateAligned(sizeof(Block))) Block();
+        if (tail_ == nullptr) {
+          head_ = block;
+        } else {
+          tail_->next = block;
+        }
+        tail_ = block;
+      }
+    }
+    tail_->objects[tail_->size++] = Object{obj, [](void *p) { reinterpret_cast<T *>(p)->~T(); }};
+    ++size_;
   }
 
-  std::list<OwnershipHolder> objects_;
+  Block *head_{nullptr};
+  Block *tail_{nullptr};
+  // The number of the objects made
+  size_t size_{0};
   Arena arena_;
 
   folly::SpinLock lock_;
@@ -4,7 +4,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "common/base/Arena.h"
 
@@ -41,4 +44,32 @@ TEST(ArenaTest, Construct) {
   }
 }
 
+TEST(ArenaTest, Large) {
+  Arena a;
+  void *small = a.allocateAligned(16);
+  auto available = a.availableSize();
+  // The large allocation doesn't consume the current chunk
+  void *large = a.allocateAligned(1024 * 1024);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % std::alignment_of<std::max_align_t>::value, 0);
+  EXPECT_EQ(a.availableSize(), available);
+  std::memset(large, 0xff, 1024 * 1024);
+  EXPECT_NE(small, large);
+}
+
+TEST(ArenaTest, Allocator) {
+  Arena a;
+  ArenaAllocator<int64_t> alloc(&a);
+  std::vector<int64_t, ArenaAllocator<int64_t>> v(alloc);
+  for (int64_t i = 0; i < 100000; ++i) {
+    v.emplace_back(i);
+  }
+  for (int64_t i = 0; i < 100000; ++i) {
+    EXPECT_EQ(v[i], i);
+  }
+  std::vector<std::string, ArenaAllocator<std::string>> strs(alloc);
+  strs.emplace_back("Hello World!");
+  EXPECT_EQ(strs.front(), "Hello World!");
+  EXPECT_EQ(v.get_allocator(), ArenaAllocator<std::string>(&a));
+}
+
 }  // namespace nebula
@@ -5,6 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "common/base/ObjectPool.h"
 
 namespace nebula {
@@ -33,4 +36,44 @@ TEST(ObjectPoolTest, TestPooling) {
   ASSERT_EQ(instances, 0);
 }
 
+TEST(ObjectPoolTest, DestroyInOrder) {
+  std::vector<int> destroyed;
+  struct Tracked {
+    Tracked(std::vector<int>* d, int i) : destroyed(d), id(i) {}
+    ~Tracked() {
+      destroyed->emplace_back(id);
+    }
+    std::vector<int>* destroyed;
+    int id;
+  };
+  {
+    ObjectPool pool;
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(pool.makeAndAdd<Tracked>(&destroyed, i)->id, i);
+    }
+    ASSERT_EQ(*pool.makeAndAdd<std::string>(100, 'a'), std::string(100, 'a'));
+    ASSERT_TRUE(destroyed.empty());
+  }
+  ASSERT_EQ(destroyed.size(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(destroyed[i], i);
+  }
+}
+
+TEST(ObjectPoolTest, ClearAndReuse) {
+  ObjectPool pool;
+  ASSERT_TRUE(pool.empty());
+  ASSERT_EQ(*pool.makeAndAdd<int>(1), 1);
+  ASSERT_FALSE(pool.empty());
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 300; ++i) {
+      ASSERT_NE(pool.makeAndAdd<MyClass>(), nullptr);
+    }
+    ASSERT_EQ(instances, 300);
+    pool.clear();
+    ASSERT_EQ(instances, 0);
+    ASSERT_TRUE(pool.empty());
+  }
+}
+
 }  // namespace nebula
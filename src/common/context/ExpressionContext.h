@@ -24,6 +24,16 @@ namespace nebula {
  **************************************************************************/
 class ExpressionContext {
  public:
+  // The operations on a collection property evaluated in place by evalCollectionProp
+  enum class CollectionOp : uint8_t {
+    // size(prop)
+    kSize,
+    // operand IN prop
+    kContains,
+    // prop[operand]
+    kAt,
+  };
+
   virtual ~ExpressionContext() = default;
 
   // Get the latest version value for the given variable name, such as $a, $b
@@ -36,6 +46,12 @@ class ExpressionContext {
   // Get the value of innerVar.
   virtual const Value& getInnerVar(const std::string& var) const = 0;
 
+  // Bind the innerVar to val by reference until it's set or bound again, val must outlive the
+  // binding. It's copied by the contexts which don't bind by reference.
+  virtual void bindInnerVar(const std::string& var, const Value& val) {
+    setInnerVar(var, val);
+  }
+
   // Get the given version value for the given variable name, such as $a, $b
   virtual const Value& getVersionedVar(const std::string& var, int64_t version) const = 0;
 
@@ -75,6 +91,39 @@ class ExpressionContext {
   // Get Value by Column index
   virtual const Value& getColumn(int32_t index) const = 0;
 
+  // Evaluate op on the collection property of the edge, or of the tag if isEdge is false, without
+  // reading the whole collection, e.g. on an encoded row. Return false if it's not supported or the
+  // property is not a collection, then the property is read and evaluated as usual.
+  virtual bool evalCollectionProp(bool isEdge,
+                                  const std::string& sym,
+                                  const std::string& prop,
+                                  CollectionOp op,
+                                  const Value& operand,
+                                  Value& result) const {
+    UNUSED(isEdge);
+    UNUSED(sym);
+    UNUSED(prop);
+    UNUSED(op);
+    UNUSED(operand);
+    UNUSED(result);
+    return false;
+  }
+
+  // Borrow the string property of the edge, or of the tag if isEdge is false, without copying it
+  // into a Value, e.g. from an encoded row. The view is only valid until the context moves to the
+  // next row. Return false if it's not supported or the property is not a string, then the
+  // property is read as usual.
+  virtual bool getStringPropView(bool isEdge,
+                                 const std::string& sym,
+                                 const std::string& prop,
+                                 folly::StringPiece& view) const {
+    UNUSED(isEdge);
+    UNUSED(sym);
+    UNUSED(prop);
+    UNUSED(view);
+    return false;
+  }
+
   // Get regex
   const std::regex& getRegex(const std::string& pattern) {
     auto iter = regex_.find(pattern);
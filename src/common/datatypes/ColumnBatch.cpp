@@ -0,0 +1,294 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/datatypes/ColumnBatch.h"
+
+namespace nebula {
+
+// static
+Column Column::fromValues(const std::vector<Value>& values) {
+  Column column;
+  for (const auto& value : values) {
+    column.append(value);
+  }
+  return column;
+}
+
+// static
+Column Column::ofBools(std::vector<uint8_t> values, std::vector<uint64_t> nulls) {
+  Column column;
+  column.kind_ = Kind::kBool;
+  column.size_ = values.size();
+  column.bools_ = std::move(values);
+  column.setNulls(std::move(nulls));
+  return column;
+}
+
+// static
+Column Column::ofInts(std::vector<int64_t> values, std::vector<uint64_t> nulls) {
+  Column column;
+  column.kind_ = Kind::kInt;
+  column.size_ = values.size();
+  column.ints_ = std::move(values);
+  column.setNulls(std::move(nulls));
+  return column;
+}
+
+// static
+Column Column::ofFloats(std::vector<double> values, std::vector<uint64_t> nulls) {
+  Column column;
+  column.kind_ = Kind::kFloat;
+  column.size_ = values.size();
+  column.floats_ = std::move(values);
+  column.setNulls(std::move(nulls));
+  return column;
+}
+
+void Column::setNulls(std::vector<uint64_t> nulls) {
+  // Clear the bits beyond the size, so that the appended values are not NULLs
+  auto words = (size_ + 63) >> 6;
+  if (nulls.size() > words) {
+    nulls.resize(words);
+  }
+  if ((size_ & 63) != 0 && nulls.size() == words) {
+    nulls.back() &= (1UL << (size_ & 63)) - 1;
+  }
+  nullCount_ = 0;
+  for (auto word : nulls) {
+    nullCount_ += __builtin_popcountll(word);
+  }
+  nulls_ = std::move(nulls);
+}
+
+// static
+Column::Kind Column::kindOf(const Value& value) {
+  switch (value.type()) {
+    case Value::Type::NULLVALUE:
+      return value.getNull() == NullType::__NULL__ ? Kind::kNull : Kind::kBoxed;
+    case Value::Type::BOOL:
+      return Kind::kBool;
+    case Value::Type::INT:
+      return Kind::kInt;
+    case Value::Type::FLOAT:
+      return Kind::kFloat;
+    case Value::Type::STRING:
+      return Kind::kString;
+    default:
+      return Kind::kBoxed;
+  }
+}
+
+void Column::append(const Value& value) {
+  if (kind_ == Kind::kBoxed) {
+    values_.emplace_back(value);
+    ++size_;
+    return;
+  }
+  auto kind = kindOf(value);
+  if (kind == Kind::kNull) {
+    appendNull();
+    return;
+  }
+  if (kind == Kind::kBoxed || (kind_ != Kind::kNull && kind != kind_)) {
+    toBoxed();
+    values_.emplace_back(value);
+    ++size_;
+    return;
+  }
+  if (kind_ == Kind::kNull) {
+    // The leading NULLs get the default values of the kind
+    kind_ = kind;
+    switch (kind_) {
+      case Kind::kBool:
+        bools_.resize(size_);
+        break;
+      case Kind::kInt:
+        ints_.resize(size_);
+        break;
+      case Kind::kFloat:
+        floats_.resize(size_);
+        break;
+      case Kind::kString:
+        strs_.resize(size_);
+        break;
+      default:
+        break;
+    }
+  }
+  appendTyped(value);
+}
+
+void Column::appendNull() {
+  switch (kind_) {
+    case Kind::kBool:
+      bools_.emplace_back(0);
+      break;
+    case Kind::kInt:
+      ints_.emplace_back(0);
+      break;
+    case Kind::kFloat:
+      floats_.emplace_back(0.0);
+      break;
+    case Kind::kString:
+      strs_.emplace_back();
+      break;
+    case Kind::kBoxed:
+      values_.emplace_back(Value::kNullValue);
+      ++size_;
+      return;
+    case Kind::kNull:
+      break;
+  }
+  if ((size_ >> 6) >= nulls_.size()) {
+    nulls_.resize((size_ >> 6) + 1, 0);
+  }
+  nulls_[size_ >> 6] |= 1UL << (size_ & 63);
+  ++nullCount_;
+  ++size_;
+}
+
+void Column::appendTyped(const Value& value) {
+  switch (kind_) {
+    case Kind::kBool:
+      bools_.emplace_back(value.getBool());
+      break;
+    case Kind::kInt:
+      ints_.emplace_back(value.getInt());
+      break;
+    case Kind::kFloat:
+      floats_.emplace_back(value.getFloat());
+      break;
+    case Kind::kString:
+      strs_.emplace_back(value.getStr());
+      break;
+    default:
+      LOG(FATAL) << "Unexpected column kind " << static_cast<int>(kind_);
+  }
+  ++size_;
+}
+
+void Column::toBoxed() {
+  std::vector<Value> values;
+  values.reserve(size_ + 1);
+  for (size_t i = 0; i < size_; ++i) {
+    values.emplace_back(value(i));
+  }
+  kind_ = Kind::kBoxed;
+  values_ = std::move(values);
+  nulls_.clear();
+  nullCount_ = 0;
+  bools_.clear();
+  ints_.clear();
+  floats_.clear();
+  strs_.clear();
+}
+
+Value Column::value(size_t i) const {
+  DCHECK_LT(i, size_);
+  if (kind_ == Kind::kBoxed) {
+    return values_[i];
+  }
+  if (isNull(i)) {
+    return Value::kNullValue;
+  }
+  switch (kind_) {
+    case Kind::kBool:
+      return Value(bools_[i] != 0);
+    case Kind::kInt:
+      return Value(ints_[i]);
+    case Kind::kFloat:
+      return Value(floats_[i]);
+    case Kind::kString:
+      return Value(strs_[i]);
+    default:
+      return Value::kNullValue;
+  }
+}
+
+bool Column::operator==(const Column& rhs) const {
+  if (size_ != rhs.size_) {
+    return false;
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    if (value(i) != rhs.value(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ColumnBatch::ColumnBatch(std::vector<std::string> colNames) : colNames_(std::move(colNames)) {
+  columns_.resize(colNames_.size());
+}
+
+// static
+ColumnBatch ColumnBatch::fromDataSet(const DataSet& ds) {
+  std::vector<size_t> cols(ds.colNames.size());
+  for (size_t i = 0; i < cols.size(); ++i) {
+    cols[i] = i;
+  }
+  return fromRows(ds.colNames, ds.rows, 0, ds.rows.size(), cols);
+}
+
+// static
+ColumnBatch ColumnBatch::fromRows(const std::vector<std::string>& colNames,
+                                  const std::vector<Row>& rows,
+                                  size_t begin,
+                                  size_t end,
+                                  const std::vector<size_t>& cols) {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, rows.size());
+  ColumnBatch batch;
+  for (auto col : cols) {
+    DCHECK_LT(col, colNames.size());
+    Column column;
+    for (size_t i = begin; i < end; ++i) {
+      const auto& row = rows[i];
+      column.append(col < row.size() ? row[col] : Value::kEmpty);
+    }
+    batch.colNames_.emplace_back(colNames[col]);
+    batch.columns_.emplace_back(std::move(column));
+  }
+  batch.rowSize_ = end - begin;
+  return batch;
+}
+
+void ColumnBatch::addColumn(std::string name, Column column) {
+  if (columns_.empty()) {
+    rowSize_ = column.size();
+  }
+  DCHECK_EQ(column.size(), rowSize_);
+  colNames_.emplace_back(std::move(name));
+  columns_.emplace_back(std::move(column));
+}
+
+void ColumnBatch::appendRow(const Row& row) {
+  DCHECK_EQ(row.size(), columns_.size());
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    columns_[i].append(row[i]);
+  }
+  ++rowSize_;
+}
+
+Row ColumnBatch::row(size_t i) const {
+  DCHECK_LT(i, rowSize_);
+  Row row;
+  row.values.reserve(columns_.size());
+  for (const auto& column : columns_) {
+    row.values.emplace_back(column.value(i));
+  }
+  return row;
+}
+
+DataSet ColumnBatch::toDataSet() const {
+  DataSet ds(colNames_);
+  ds.rows.reserve(rowSize_);
+  for (size_t i = 0; i < rowSize_; ++i) {
+    ds.rows.emplace_back(row(i));
+  }
+  return ds;
+}
+
+}  // namespace nebula
@@ -0,0 +1,179 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_COLUMNBATCH_H_
+#define COMMON_DATATYPES_COLUMNBATCH_H_
+
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+// A column of a ColumnBatch. When all the values are NULL or of the same BOOL, INT, FLOAT or STRING
+// type, they are kept unboxed in a typed vector, and the NULLs are marked in a bitmap, while the
+// slots of them in the typed vector hold the default values. Otherwise the column holds the boxed
+// Values.
+class Column final {
+ public:
+  enum class Kind : uint8_t {
+    // No value other than the plain NULL has been appended
+    kNull = 0,
+    kBool = 1,
+    kInt = 2,
+    kFloat = 3,
+    kString = 4,
+    kBoxed = 5,
+  };
+
+  Column() = default;
+
+  static Column fromValues(const std::vector<Value>& values);
+
+  // The typed columns of the values, where the bits set in nulls mark the NULLs
+  static Column ofBools(std::vector<uint8_t> values, std::vector<uint64_t> nulls);
+  static Column ofInts(std::vector<int64_t> values, std::vector<uint64_t> nulls);
+  static Column ofFloats(std::vector<double> values, std::vector<uint64_t> nulls);
+
+  // The column turns into the boxed one when the value doesn't fit its kind
+  void append(const Value& value);
+
+  Kind kind() const {
+    return kind_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Whether there is any plain NULL in a typed column, the boxed column checks its Values instead
+  bool hasNull() const {
+    return nullCount_ != 0;
+  }
+
+  bool isNull(size_t i) const {
+    if (kind_ == Kind::kBoxed) {
+      return values_[i].isNull();
+    }
+    return (i >> 6) < nulls_.size() && ((nulls_[i >> 6] >> (i & 63)) & 1);
+  }
+
+  // The NULL bitmap of a typed column, which may be shorter than the column
+  const std::vector<uint64_t>& nullBitmap() const {
+    return nulls_;
+  }
+
+  const std::vector<uint8_t>& bools() const {
+    DCHECK(kind_ == Kind::kBool);
+    return bools_;
+  }
+
+  const std::vector<int64_t>& ints() const {
+    DCHECK(kind_ == Kind::kInt);
+    return ints_;
+  }
+
+  const std::vector<double>& floats() const {
+    DCHECK(kind_ == Kind::kFloat);
+    return floats_;
+  }
+
+  const std::vector<std::string>& strs() const {
+    DCHECK(kind_ == Kind::kString);
+    return strs_;
+  }
+
+  const std::vector<Value>& values() const {
+    DCHECK(kind_ == Kind::kBoxed);
+    return values_;
+  }
+
+  // The boxed value at i
+  Value value(size_t i) const;
+
+  bool operator==(const Column& rhs) const;
+
+ private:
+  static Kind kindOf(const Value& value);
+
+  void setNulls(std::vector<uint64_t> nulls);
+
+  void appendNull();
+
+  void appendTyped(const Value& value);
+
+  // Box all the values appended so far
+  void toBoxed();
+
+  Kind kind_{Kind::kNull};
+  size_t size_{0};
+  size_t nullCount_{0};
+  std::vector<uint64_t> nulls_;
+  std::vector<uint8_t> bools_;
+  std::vector<int64_t> ints_;
+  std::vector<double> floats_;
+  std::vector<std::string> strs_;
+  std::vector<Value> values_;
+};
+
+// The columnar form of the rows of a DataSet, which lets the operators work on the whole columns
+// instead of the boxed values row by row. It's converted back to a DataSet before returning to
+// the clients.
+class ColumnBatch final {
+ public:
+  ColumnBatch() = default;
+  explicit ColumnBatch(std::vector<std::string> colNames);
+
+  static ColumnBatch fromDataSet(const DataSet& ds);
+
+  // The columns of cols in the rows [begin, end)
+  static ColumnBatch fromRows(const std::vector<std::string>& colNames,
+                              const std::vector<Row>& rows,
+                              size_t begin,
+                              size_t end,
+                              const std::vector<size_t>& cols);
+
+  const std::vector<std::string>& colNames() const {
+    return colNames_;
+  }
+
+  size_t colSize() const {
+    return columns_.size();
+  }
+
+  size_t rowSize() const {
+    return rowSize_;
+  }
+
+  const Column& column(size_t index) const {
+    return columns_[index];
+  }
+
+  // Append a column of rowSize() values, or the first column of an empty batch
+  void addColumn(std::string name, Column column);
+
+  void appendRow(const Row& row);
+
+  Row row(size_t i) const;
+
+  DataSet toDataSet() const;
+
+  bool operator==(const ColumnBatch& rhs) const {
+    return colNames_ == rhs.colNames_ && rowSize_ == rhs.rowSize_ && columns_ == rhs.columns_;
+  }
+
+ private:
+  std::vector<std::string> colNames_;
+  std::vector<Column> columns_;
+  size_t rowSize_{0};
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_COLUMNBATCH_H_
@@ -15,6 +15,38 @@ namespace nebula {
 const int64_t kDaysSoFar[] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};
 const int64_t kLeapDaysSoFar[] = {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366};
 
+namespace {
+
+// Append value in decimal, padded with '0' to width digits at least
+void appendPadded(std::string& str, uint32_t value, size_t width) {
+  char buf[16];
+  size_t n = 0;
+  do {
+    buf[n++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (n < width) {
+    buf[n++] = '0';
+  }
+  while (n > 0) {
+    str.push_back(buf[--n]);
+  }
+}
+
+// hh:mm:ss.uuuuuu000, the same as the format "{:0>2}:{:0>2}:{:0>2}.{:0>6}000"
+void appendTime(std::string& str, uint8_t hour, uint8_t minute, uint8_t sec, uint32_t microsec) {
+  appendPadded(str, hour, 2);
+  str.push_back(':');
+  appendPadded(str, minute, 2);
+  str.push_back(':');
+  appendPadded(str, sec, 2);
+  str.push_back('.');
+  appendPadded(str, microsec, 6);
+  str.append("000");
+}
+
+}  // namespace
+
 int8_t dayOfMonth(int16_t year, int8_t month) {
   return isLeapYear(year) ? kLeapDaysSoFar[month] - kLeapDaysSoFar[month - 1]
                           : kDaysSoFar[month] - kDaysSoFar[month - 1];
@@ -206,11 +238,14 @@ void Time::subDuration(const Duration& duration) {
 }
 
 std::string Time::toString() const {
-  return folly::sformat("{:0>2}:{:0>2}:{:0>2}.{:0>6}000",
-                        static_cast<uint8_t>(hour),
-                        static_cast<uint8_t>(minute),
-                        static_cast<uint8_t>(sec),
-                        static_cast<uint32_t>(microsec));
+  std::string str;
+  str.reserve(18);
+  appendTime(str,
+             static_cast<uint8_t>(hour),
+             static_cast<uint8_t>(minute),
+             static_cast<uint8_t>(sec),
+             static_cast<uint32_t>(microsec));
+  return str;
 }
 
 void DateTime::addDuration(const Duration& duration) {
@@ -328,14 +363,18 @@ void DateTime::subDuration(const Duration& duration) {
 
 std::string DateTime::toString() const {
   // It's in current timezone already
-  return folly::sformat("{}-{:0>2}-{:0>2}T{:0>2}:{:0>2}:{:0>2}.{:0>6}000",
-                        static_cast<int16_t>(year),
-                        static_cast<uint8_t>(month),
-                        static_cast<uint8_t>(day),
-                        static_cast<uint8_t>(hour),
-                        static_cast<uint8_t>(minute),
-                        static_cast<uint8_t>(sec),
-                        static_cast<uint32_t>(microsec));
+  auto str = folly::to<std::string>(static_cast<int16_t>(year));
+  str.push_back('-');
+  appendPadded(str, static_cast<uint8_t>(month), 2);
+  str.push_back('-');
+  appendPadded(str, static_cast<uint8_t>(day), 2);
+  str.push_back('T');
+  appendTime(str,
+             static_cast<uint8_t>(hour),
+             static_cast<uint8_t>(minute),
+             static_cast<uint8_t>(sec),
+             static_cast<uint32_t>(microsec));
+  return str;
 }
 
 }  // namespace nebula
@@ -8,6 +8,7 @@
 
 #include <unordered_map>
 
+#include "common/datatypes/PropMap.h"
 #include "common/datatypes/Value.h"
 #include "common/thrift/ThriftTypes.h"
 
@@ -19,7 +20,7 @@ struct Edge {
   EdgeType type;
   std::string name;
   EdgeRanking ranking;
-  std::unordered_map<std::string, Value> props;
+  PropMap props;
   std::atomic<size_t> refcnt{1};
 
   Edge() {}
@@ -37,7 +38,7 @@ struct Edge {
        EdgeType t,
        std::string n,
        EdgeRanking r,
-       std::unordered_map<std::string, Value>&& p)
+       PropMap p)
       : src(std::move(s)),
         dst(std::move(d)),
         type(std::move(t)),
@@ -0,0 +1,342 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/datatypes/IntSetKernels.h"
+
+#include <algorithm>
+
+#include "common/base/Base.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Set.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define NEBULA_INT_SET_KERNELS_X86 1
+#endif
+
+namespace nebula {
+
+namespace {
+
+// Where the vectorized merge stopped. The bits of matched stand for the elements
+// of the lhs block starting at i which have been matched already.
+struct MergeState {
+  size_t i{0};
+  size_t j{0};
+  size_t width{0};
+  uint32_t matched{0};
+};
+
+// Finish the merge from where the vectorized merge stopped.
+// onMatch(i) is called for every lhs[i] found in rhs, and onMiss(i) for the others.
+template <typename OnMatch, typename OnMiss>
+void scalarMerge(const int64_t* lhs,
+                 size_t lsize,
+                 const int64_t* rhs,
+                 size_t rsize,
+                 const MergeState& state,
+                 OnMatch&& onMatch,
+                 OnMiss&& onMiss) {
+  auto matchedBefore = [&state](size_t i) {
+    return i >= state.i && i < state.i + state.width && ((state.matched >> (i - state.i)) & 1);
+  };
+  size_t i = state.i;
+  size_t j = state.j;
+  while (i < lsize && j < rsize) {
+    if (matchedBefore(i)) {
+      ++i;
+    } else if (lhs[i] < rhs[j]) {
+      onMiss(i++);
+    } else if (lhs[i] > rhs[j]) {
+      ++j;
+    } else {
+      onMatch(i++);
+      ++j;
+    }
+  }
+  for (; i < lsize; ++i) {
+    if (!matchedBefore(i)) {
+      onMiss(i);
+    }
+  }
+}
+
+#ifdef NEBULA_INT_SET_KERNELS_X86
+
+// Compare a block of 4 lhs elements with a block of 4 rhs elements in all
+// rotations, and advance the block whose maximum is smaller. Since both arrays
+// are sorted and deduplicated, every pair of equal elements meets in one step.
+// onMatch(i) is called for every matched lhs[i], onBlockDone(i, width, mask) when
+// the lhs block starting at i is passed with the matched bits in mask.
+template <typename OnMatch, typename OnBlockDone>
+__attribute__((target("avx2"))) MergeState avx2Merge(const int64_t* lhs,
+                                                      size_t lsize,
+                                                      const int64_t* rhs,
+                                                      size_t rsize,
+                                                      OnMatch&& onMatch,
+                                                      OnBlockDone&& onBlockDone) {
+  MergeState state;
+  state.width = 4;
+  size_t& i = state.i;
+  size_t& j = state.j;
+  uint32_t& matched = state.matched;
+  while (i + 4 <= lsize && j + 4 <= rsize) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + j));
+    __m256i m = _mm256_cmpeq_epi64(a, b);
+    m = _mm256_or_si256(
+        m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1))));
+    m = _mm256_or_si256(
+        m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(1, 0, 3, 2))));
+    m = _mm256_or_si256(
+        m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3))));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+    for (uint32_t bits = mask; bits != 0; bits &= bits - 1) {
+      onMatch(i + __builtin_ctz(bits));
+    }
+    matched |= mask;
+    auto lmax = lhs[i + 3];
+    auto rmax = rhs[j + 3];
+    if (lmax <= rmax) {
+      onBlockDone(i, state.width, matched);
+      matched = 0;
+      i += 4;
+    }
+    if (rmax <= lmax) {
+      j += 4;
+    }
+  }
+  return state;
+}
+
+// The same as avx2Merge with blocks of 2 elements
+template <typename OnMatch, typename OnBlockDone>
+__attribute__((target("sse4.2"))) MergeState sse42Merge(const int64_t* lhs,
+                                                         size_t lsize,
+                                                         const int64_t* rhs,
+                                                         size_t rsize,
+                                                         OnMatch&& onMatch,
+                                                         OnBlockDone&& onBlockDone) {
+  MergeState state;
+  state.width = 2;
+  size_t& i = state.i;
+  size_t& j = state.j;
+  uint32_t& matched = state.matched;
+  while (i + 2 <= lsize && j + 2 <= rsize) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + j));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi64(a, b),
+                             _mm_cmpeq_epi64(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+    for (uint32_t bits = mask; bits != 0; bits &= bits - 1) {
+      onMatch(i + __builtin_ctz(bits));
+    }
+    matched |= mask;
+    auto lmax = lhs[i + 1];
+    auto rmax = rhs[j + 1];
+    if (lmax <= rmax) {
+      onBlockDone(i, state.width, matched);
+      matched = 0;
+      i += 2;
+    }
+    if (rmax <= lmax) {
+      j += 2;
+    }
+  }
+  return state;
+}
+
+__attribute__((target("avx2"))) bool avx2Contains(const int64_t* data,
+                                                   size_t size,
+                                                   int64_t target) {
+  __m256i t = _mm256_set1_epi64x(target);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    if (!_mm256_testz_si256(_mm256_cmpeq_epi64(v, t), _mm256_cmpeq_epi64(v, t))) {
+      return true;
+    }
+  }
+  return std::find(data + i, data + size, target) != data + size;
+}
+
+__attribute__((target("sse4.2"))) bool sse42Contains(const int64_t* data,
+                                                      size_t size,
+                                                      int64_t target) {
+  __m128i t = _mm_set1_epi64x(target);
+  size_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi64(v, t)) != 0) {
+      return true;
+    }
+  }
+  return std::find(data + i, data + size, target) != data + size;
+}
+
+#endif  // NEBULA_INT_SET_KERNELS_X86
+
+// Run the vectorized merge of the given isa, then finish it in scalar
+template <typename OnMatch, typename OnBlockDone, typename OnMiss>
+void merge(const int64_t* lhs,
+           size_t lsize,
+           const int64_t* rhs,
+           size_t rsize,
+           IntSetKernels::Isa isa,
+           OnMatch&& onMatch,
+           OnBlockDone&& onBlockDone,
+           OnMiss&& onMiss) {
+  MergeState state;
+#ifdef NEBULA_INT_SET_KERNELS_X86
+  if (isa == IntSetKernels::Isa::kAVX2) {
+    state = avx2Merge(lhs, lsize, rhs, rsize, onMatch, onBlockDone);
+  } else if (isa == IntSetKernels::Isa::kSSE42) {
+    state = sse42Merge(lhs, lsize, rhs, rsize, onMatch, onBlockDone);
+  }
+#else
+  UNUSED(isa);
+  UNUSED(onBlockDone);
+#endif
+  scalarMerge(lhs, lsize, rhs, rsize, state, onMatch, onMiss);
+}
+
+}  // namespace
+
+// static
+IntSetKernels::Isa IntSetKernels::detectIsa() {
+#ifdef NEBULA_INT_SET_KERNELS_X86
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return Isa::kAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+      return Isa::kSSE42;
+    }
+    return Isa::kScalar;
+  }();
+  return isa;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+// static
+size_t IntSetKernels::intersectionSize(
+    const int64_t* lhs, size_t lsize, const int64_t* rhs, size_t rsize, Isa isa) {
+  size_t count = 0;
+  merge(
+      lhs,
+      lsize,
+      rhs,
+      rsize,
+      isa,
+      [&count](size_t) { ++count; },
+      [](size_t, size_t, uint32_t) {},
+      [](size_t) {});
+  return count;
+}
+
+// static
+void IntSetKernels::intersection(const int64_t* lhs,
+                                 size_t lsize,
+                                 const int64_t* rhs,
+                                 size_t rsize,
+                                 std::vector<int64_t>& result,
+                                 Isa isa) {
+  result.clear();
+  result.reserve(std::min(lsize, rsize));
+  merge(
+      lhs,
+      lsize,
+      rhs,
+      rsize,
+      isa,
+      [lhs, &result](size_t i) { result.emplace_back(lhs[i]); },
+      [](size_t, size_t, uint32_t) {},
+      [](size_t) {});
+}
+
+// static
+void IntSetKernels::difference(const int64_t* lhs,
+                               size_t lsize,
+                               const int64_t* rhs,
+                               size_t rsize,
+                               std::vector<int64_t>& result,
+                               Isa isa) {
+  result.clear();
+  result.reserve(lsize);
+  merge(
+      lhs,
+      lsize,
+      rhs,
+      rsize,
+      isa,
+      [](size_t) {},
+      [lhs, &result](size_t i, size_t width, uint32_t matched) {
+        // The block is passed, so the unmatched elements are not in rhs
+        for (size_t k = 0; k < width; ++k) {
+          if (((matched >> k) & 1) == 0) {
+            result.emplace_back(lhs[i + k]);
+          }
+        }
+      },
+      [lhs, &result](size_t i) { result.emplace_back(lhs[i]); });
+}
+
+// static
+void IntSetKernels::setUnion(
+    const int64_t* lhs, size_t lsize, const int64_t* rhs, size_t rsize, std::vector<int64_t>& result) {
+  result.clear();
+  result.reserve(lsize + rsize);
+  std::set_union(lhs, lhs + lsize, rhs, rhs + rsize, std::back_inserter(result));
+}
+
+// static
+bool IntSetKernels::contains(const int64_t* data, size_t size, int64_t target, Isa isa) {
+#ifdef NEBULA_INT_SET_KERNELS_X86
+  if (isa == Isa::kAVX2) {
+    return avx2Contains(data, size, target);
+  } else if (isa == Isa::kSSE42) {
+    return sse42Contains(data, size, target);
+  }
+#else
+  UNUSED(isa);
+#endif
+  return std::find(data, data + size, target) != data + size;
+}
+
+// static
+bool IntSetKernels::toSortedInts(const Value& container, std::vector<int64_t>& result) {
+  result.clear();
+  auto collect = [&result](const auto& values) {
+    result.reserve(values.size());
+    for (const auto& v : values) {
+      if (!v.isInt()) {
+        return false;
+      }
+      result.emplace_back(v.getInt());
+    }
+    return true;
+  };
+  if (container.isList()) {
+    if (!collect(container.getList().values)) {
+      return false;
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return true;
+  }
+  if (container.isSet()) {
+    if (!collect(container.getSet().values)) {
+      return false;
+    }
+    std::sort(result.begin(), result.end());
+    return true;
+  }
+  return false;
+}
+
+}  // namespace nebula
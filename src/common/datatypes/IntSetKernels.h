@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_INTSETKERNELS_H_
+#define COMMON_DATATYPES_INTSETKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula {
+
+struct Value;
+
+/**
+ * Set operations over the integer sets, which are represented as sorted and
+ * deduplicated int64 arrays. The intersection, difference and membership are
+ * vectorized with AVX2 or SSE4.2 when the CPU supports them, which is detected
+ * once at runtime. Otherwise the scalar merge is used.
+ */
+class IntSetKernels final {
+ public:
+  enum class Isa : uint8_t {
+    kScalar = 0,
+    kSSE42 = 1,
+    kAVX2 = 2,
+  };
+
+  // The best instruction set supported by the current CPU
+  static Isa detectIsa();
+
+  static size_t intersectionSize(const int64_t* lhs,
+                                 size_t lsize,
+                                 const int64_t* rhs,
+                                 size_t rsize,
+                                 Isa isa = detectIsa());
+
+  static void intersection(const int64_t* lhs,
+                           size_t lsize,
+                           const int64_t* rhs,
+                           size_t rsize,
+                           std::vector<int64_t>& result,
+                           Isa isa = detectIsa());
+
+  // Elements in lhs but not in rhs
+  static void difference(const int64_t* lhs,
+                         size_t lsize,
+                         const int64_t* rhs,
+                         size_t rsize,
+                         std::vector<int64_t>& result,
+                         Isa isa = detectIsa());
+
+  // The union is bound by the output bandwidth, so it's always a scalar merge
+  static void setUnion(const int64_t* lhs,
+                       size_t lsize,
+                       const int64_t* rhs,
+                       size_t rsize,
+                       std::vector<int64_t>& result);
+
+  // Whether target is in the array, the array needs not to be sorted
+  static bool contains(const int64_t* data, size_t size, int64_t target, Isa isa = detectIsa());
+
+  // Collect the elements of a LIST or SET value into a sorted and deduplicated
+  // array. Return false if the value is not a container, or any element is not
+  // an integer.
+  static bool toSortedInts(const Value& container, std::vector<int64_t>& result);
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_INTSETKERNELS_H_
@@ -7,18 +7,38 @@
 #define COMMON_DATATYPES_LIST_H_
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
+#include "common/base/Logging.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
 
 struct List {
+  // The element type of a list which is known to be homogeneous. The readers of
+  // LIST_INT/LIST_FLOAT/LIST_STRING properties mark the decoded list, so that the
+  // lookups over it could compare the unboxed values directly instead of going
+  // through the generic Value comparison. kBoxed means nothing is known.
+  //
+  // The values are public and could be written directly, so the kind is only kept
+  // by the list marked, or moved from it, and by the Values sharing it, whose
+  // writable accessors drop it. A list copied starts boxed, as its values may be
+  // written directly after.
+  enum class Kind : uint8_t {
+    kBoxed = 0,
+    kInt = 1,
+    kFloat = 2,
+    kString = 3,
+  };
+
   std::vector<Value> values;
 
   List() = default;
-  List(const List&) = default;
-  List(List&&) noexcept = default;
+  List(const List& rhs) : values(rhs.values) {}
+  List(List&& rhs) noexcept : values(std::move(rhs.values)), kind_(rhs.kind_) {
+    rhs.kind_ = Kind::kBoxed;
+  }
   explicit List(std::vector<Value>&& vals) {
     values = std::move(vals);
   }
@@ -32,6 +52,36 @@ struct List {
     return values.empty();
   }
 
+  Kind kind() const {
+    return kind_;
+  }
+
+  // Mark the list as holding only the elements of the given kind, the caller
+  // must guarantee that all the elements match.
+  void setKind(Kind kind) {
+    kind_ = kind;
+  }
+
+  // Fall back to the boxed mode, this must be called before the values are
+  // modified directly.
+  void resetKind() {
+    kind_ = Kind::kBoxed;
+  }
+
+  static bool matchKind(Kind kind, const Value& v) {
+    switch (kind) {
+      case Kind::kInt:
+        return v.isInt();
+      case Kind::kFloat:
+        return v.isFloat();
+      case Kind::kString:
+        return v.isStr();
+      case Kind::kBoxed:
+        return true;
+    }
+    return false;
+  }
+
   void reserve(std::size_t n) {
     values.reserve(n);
   }
@@ -40,9 +90,15 @@ struct List {
             typename = typename std::enable_if<std::is_convertible<T, Value>::value>::type>
   void emplace_back(T&& v) {
     values.emplace_back(std::forward<T>(v));
+    if (kind_ != Kind::kBoxed && !matchKind(kind_, values.back())) {
+      kind_ = Kind::kBoxed;
+    }
   }
 
   void append(List&& other) {
+    if (kind_ != other.kind_ && !other.empty()) {
+      kind_ = empty() ? other.kind_ : Kind::kBoxed;
+    }
     values.reserve(size() + other.size());
     values.insert(values.end(),
                   std::make_move_iterator(other.values.begin()),
@@ -51,6 +107,7 @@ struct List {
 
   void clear() {
     values.clear();
+    kind_ = Kind::kBoxed;
   }
 
   void __clear() {
@@ -62,6 +119,7 @@ struct List {
       return *this;
     }
     values = rhs.values;
+    kind_ = Kind::kBoxed;
     return *this;
   }
   List& operator=(List&& rhs) noexcept {
@@ -69,6 +127,8 @@ struct List {
       return *this;
     }
     values = std::move(rhs.values);
+    kind_ = rhs.kind_;
+    rhs.kind_ = Kind::kBoxed;
     return *this;
   }
 
@@ -84,11 +144,49 @@ struct List {
     return values[i];
   }
 
+  // The element could be overwritten by anything, so the list falls back to
+  // the boxed mode.
   Value& operator[](size_t i) {
+    kind_ = Kind::kBoxed;
     return values[i];
   }
 
   bool contains(const Value& value) const {
+    switch (kind_) {
+      case Kind::kInt: {
+        if (value.isInt()) {
+          auto target = value.getInt();
+          return std::any_of(values.begin(), values.end(), [target](const Value& v) {
+            DCHECK(v.isInt()) << "The list of kInt holds " << v.type();
+            return v.getInt() == target;
+          });
+        }
+        break;
+      }
+      case Kind::kFloat: {
+        if (value.isFloat() && !std::isnan(value.getFloat())) {
+          auto target = value.getFloat();
+          return std::any_of(values.begin(), values.end(), [target](const Value& v) {
+            DCHECK(v.isFloat()) << "The list of kFloat holds " << v.type();
+            return std::abs(v.getFloat() - target) < kEpsilon;
+          });
+        }
+        break;
+      }
+      case Kind::kString: {
+        if (value.isStr()) {
+          const auto& target = value.getStr();
+          return std::any_of(values.begin(), values.end(), [&target](const Value& v) {
+            DCHECK(v.isStr()) << "The list of kString holds " << v.type();
+            return v.getStr() == target;
+          });
+        }
+        // A string never equals to a value of other types
+        return false;
+      }
+      case Kind::kBoxed:
+        break;
+    }
     return std::find(values.begin(), values.end(), value) != values.end();
   }
 
@@ -100,6 +198,9 @@ struct List {
   folly::dynamic toJson() const;
   // Extract the metadata of each element
   folly::dynamic getMetaData() const;
+
+ private:
+  Kind kind_{Kind::kBoxed};
 };
 
 inline std::ostream& operator<<(std::ostream& os, const List& l) {
@@ -116,6 +217,24 @@ inline List List::createFromVector(const std::vector<T>& items) {
   }
   return List(std::move(values));
 }
+// The hash of List with the bits well mixed, see MixedValueHash
+struct MixedListHash {
+  std::size_t operator()(const List& l) const {
+    if (l.values.size() == 1) {
+      return MixedValueHash()(l.values[0]);
+    }
+    size_t seed = 0;
+    for (auto& v : l.values) {
+      seed ^= MixedValueHash()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+
+  std::size_t operator()(const List* l) const {
+    return !l ? 0 : operator()(*l);
+  }
+};
+
 }  // namespace nebula
 
 namespace std {
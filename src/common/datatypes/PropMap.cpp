@@ -0,0 +1,127 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/datatypes/PropMap.h"
+
+namespace nebula {
+
+PropNames::PropNames(std::vector<std::string> names) {
+  names_.reserve(names.size());
+  for (auto& name : names) {
+    add(std::move(name));
+  }
+}
+
+size_t PropNames::indexOf(const std::string& name) const {
+  if (names_.size() > kIndexThreshold) {
+    auto found = index_.find(name);
+    return found == index_.end() ? names_.size() : found->second;
+  }
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (names_[i] == name) {
+      return i;
+    }
+  }
+  return names_.size();
+}
+
+void PropNames::add(std::string name) {
+  names_.emplace_back(std::move(name));
+  if (names_.size() > kIndexThreshold) {
+    if (index_.empty()) {
+      for (size_t i = 0; i < names_.size(); ++i) {
+        index_.emplace(names_[i], i);
+      }
+    } else {
+      index_.emplace(names_.back(), names_.size() - 1);
+    }
+  }
+}
+
+PropMap::PropMap(const Map& map) {
+  values_.reserve(map.size());
+  for (const auto& kv : map) {
+    emplace(kv.first, kv.second);
+  }
+}
+
+PropMap::PropMap(std::initializer_list<Map::value_type> props) {
+  values_.reserve(props.size());
+  for (const auto& kv : props) {
+    emplace(kv.first, kv.second);
+  }
+}
+
+const Value& PropMap::at(const std::string& name) const {
+  auto i = indexOf(name);
+  if (i >= size()) {
+    throw std::out_of_range("Prop not found: " + name);
+  }
+  return values_[i];
+}
+
+Value& PropMap::at(const std::string& name) {
+  auto i = indexOf(name);
+  if (i >= size()) {
+    throw std::out_of_range("Prop not found: " + name);
+  }
+  return values_[i];
+}
+
+Value& PropMap::operator[](const std::string& name) {
+  return emplace(name, Value()).first->second;
+}
+
+std::pair<PropMap::iterator, bool> PropMap::emplace(std::string name, Value value) {
+  auto i = indexOf(name);
+  if (i < size()) {
+    return {iterator(names_.get(), values_.data(), i), false};
+  }
+  addName(std::move(name));
+  values_.emplace_back(std::move(value));
+  return {iterator(names_.get(), values_.data(), i), true};
+}
+
+PropMap::Map PropMap::toMap() const {
+  Map map;
+  map.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    map.emplace((*names_)[i], values_[i]);
+  }
+  return map;
+}
+
+bool PropMap::operator==(const PropMap& rhs) const {
+  if (size() != rhs.size()) {
+    return false;
+  }
+  if (names_ == rhs.names_) {
+    return values_ == rhs.values_;
+  }
+  for (size_t i = 0; i < size(); ++i) {
+    auto j = rhs.indexOf((*names_)[i]);
+    if (j >= rhs.size() || values_[i] != rhs.values_[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PropMap::addName(std::string name) {
+  if (names_ == nullptr) {
+    names_ = std::make_shared<PropNames>();
+  } else if (names_.use_count() > 1 || names_->size() != values_.size()) {
+    // Copy the names shared, or the ones beyond the values, e.g. of the PropMap cleared
+    std::vector<std::string> names;
+    names.reserve(values_.size() + 1);
+    for (size_t i = 0; i < values_.size(); ++i) {
+      names.emplace_back((*names_)[i]);
+    }
+    names_ = std::make_shared<PropNames>(std::move(names));
+  }
+  names_->add(std::move(name));
+}
+
+}  // namespace nebula
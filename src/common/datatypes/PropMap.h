@@ -0,0 +1,226 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_PROPMAP_H_
+#define COMMON_DATATYPES_PROPMAP_H_
+
+#include <folly/container/F14Map.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/base/Logging.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+// The names of the props of the tags or the edges, in the order of their values in PropMap. It's
+// shared by the PropMaps read by the same columns, e.g. of a response from storage, so the names
+// are kept once for all of them.
+class PropNames final {
+ public:
+  PropNames() = default;
+  explicit PropNames(std::vector<std::string> names);
+
+  size_t size() const {
+    return names_.size();
+  }
+
+  const std::string& operator[](size_t i) const {
+    return names_[i];
+  }
+
+  // The index of name, size() if not found
+  size_t indexOf(const std::string& name) const;
+
+  void add(std::string name);
+
+ private:
+  // The names are searched linearly if there are not so many
+  static constexpr size_t kIndexThreshold = 8;
+
+  std::vector<std::string> names_;
+  folly::F14FastMap<std::string, size_t> index_;
+};
+
+// The props of a tag or an edge, as the values in the order of the shared PropNames, so building
+// the props of a tag or an edge read from storage allocates no hash map nor the names. It's
+// accessed like an unordered_map of the names to the values, except that the entries iterated are
+// proxies of the names and the values, and a name added to the PropNames shared copies them.
+class PropMap final {
+ public:
+  using Map = std::unordered_map<std::string, Value>;
+
+  // A prop iterated, like the value_type of Map
+  template <typename V>
+  struct Entry {
+    const std::string& first;
+    V& second;
+
+    operator Map::value_type() const {  // NOLINT
+      return Map::value_type(first, second);
+    }
+  };
+
+  template <typename V>
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry<V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Entry<V>*;
+    using reference = Entry<V>;
+
+    struct Arrow {
+      Entry<V> entry;
+      const Entry<V>* operator->() const {
+        return &entry;
+      }
+    };
+
+    Iterator(const PropNames* names, V* values, size_t i) : names_(names), values_(values), i_(i) {}
+
+    Entry<V> operator*() const {
+      return Entry<V>{(*names_)[i_], values_[i_]};
+    }
+
+    Arrow operator->() const {
+      return Arrow{**this};
+    }
+
+    Iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++i_;
+      return ret;
+    }
+
+    bool operator==(const Iterator& rhs) const {
+      return i_ == rhs.i_;
+    }
+
+    bool operator!=(const Iterator& rhs) const {
+      return i_ != rhs.i_;
+    }
+
+   private:
+    const PropNames* names_;
+    V* values_;
+    size_t i_;
+  };
+
+  using iterator = Iterator<Value>;
+  using const_iterator = Iterator<const Value>;
+
+  PropMap() = default;
+  PropMap(const PropMap&) = default;
+  PropMap(PropMap&&) noexcept = default;
+  PropMap& operator=(const PropMap&) = default;
+  PropMap& operator=(PropMap&&) noexcept = default;
+
+  PropMap(const Map& map);  // NOLINT
+  PropMap(std::initializer_list<Map::value_type> props);
+
+  // The values in the order of names
+  PropMap(std::shared_ptr<PropNames> names, std::vector<Value> values)
+      : names_(std::move(names)), values_(std::move(values)) {
+    DCHECK_EQ(names_->size(), values_.size());
+  }
+
+  size_t size() const {
+    return values_.size();
+  }
+
+  bool empty() const {
+    return values_.empty();
+  }
+
+  void clear() {
+    names_.reset();
+    values_.clear();
+  }
+
+  void reserve(size_t n) {
+    values_.reserve(n);
+  }
+
+  iterator begin() {
+    return iterator(names_.get(), values_.data(), 0);
+  }
+  iterator end() {
+    return iterator(names_.get(), values_.data(), values_.size());
+  }
+  const_iterator begin() const {
+    return const_iterator(names_.get(), values_.data(), 0);
+  }
+  const_iterator end() const {
+    return const_iterator(names_.get(), values_.data(), values_.size());
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+
+  iterator find(const std::string& name) {
+    return iterator(names_.get(), values_.data(), indexOf(name));
+  }
+  const_iterator find(const std::string& name) const {
+    return const_iterator(names_.get(), values_.data(), indexOf(name));
+  }
+
+  size_t count(const std::string& name) const {
+    return indexOf(name) < size() ? 1 : 0;
+  }
+
+  // Throw std::out_of_range if not found, like Map::at
+  const Value& at(const std::string& name) const;
+  Value& at(const std::string& name);
+
+  // The value of name, which is added as empty if not found
+  Value& operator[](const std::string& name);
+
+  // Add the prop if it's not found, like Map::emplace
+  std::pair<iterator, bool> emplace(std::string name, Value value);
+
+  const std::shared_ptr<PropNames>& names() const {
+    return names_;
+  }
+
+  const std::vector<Value>& values() const {
+    return values_;
+  }
+
+  // Build the map, e.g. for the properties function and the serialization
+  Map toMap() const;
+
+  // The same props regardless of their order
+  bool operator==(const PropMap& rhs) const;
+
+  bool operator!=(const PropMap& rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  size_t indexOf(const std::string& name) const {
+    return names_ == nullptr ? 0 : names_->indexOf(name);
+  }
+
+  // Add the name, copying the names if they're shared
+  void addName(std::string name);
+
+  std::shared_ptr<PropNames> names_;
+  std::vector<Value> values_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_DATATYPES_PROPMAP_H_
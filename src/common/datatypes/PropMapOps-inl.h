@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_PROPMAPOPS_H_
+#define COMMON_DATATYPES_PROPMAPOPS_H_
+
+#include <thrift/lib/cpp2/GeneratedCodeHelper.h>
+#include <thrift/lib/cpp2/gen/module_types_tcc.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropMap.h"
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+// The PropMap is serialized as map<binary, Value> from its values directly, without building a map
+
+template <class Protocol>
+uint32_t writePropMap(Protocol* proto, const nebula::PropMap& props) {
+  uint32_t xfer = 0;
+  xfer += proto->writeMapBegin(protocol::T_STRING, protocol::T_STRUCT, props.size());
+  for (const auto& prop : props) {
+    xfer += proto->writeBinary(prop.first);
+    xfer += Cpp2Ops<nebula::Value>::write(proto, &prop.second);
+  }
+  xfer += proto->writeMapEnd();
+  return xfer;
+}
+
+template <class Protocol>
+void readPropMap(Protocol* proto, nebula::PropMap& props) {
+  std::unordered_map<std::string, nebula::Value> map;
+  pm::protocol_methods<type_class::map<type_class::binary, type_class::structure>,
+                       std::unordered_map<std::string, nebula::Value>>::read(*proto, map);
+  props = nebula::PropMap(map);
+}
+
+template <bool ZC, class Protocol>
+uint32_t propMapSerializedSize(Protocol const* proto, const nebula::PropMap& props) {
+  uint32_t xfer = 0;
+  xfer += proto->serializedSizeMapBegin(protocol::T_STRING, protocol::T_STRUCT, props.size());
+  for (const auto& prop : props) {
+    if constexpr (ZC) {
+      xfer += proto->serializedSizeZCBinary(prop.first);
+      xfer += Cpp2Ops<nebula::Value>::serializedSizeZC(proto, &prop.second);
+    } else {
+      xfer += proto->serializedSizeBinary(prop.first);
+      xfer += Cpp2Ops<nebula::Value>::serializedSize(proto, &prop.second);
+    }
+  }
+  xfer += proto->serializedSizeMapEnd();
+  return xfer;
+}
+
+}  // namespace detail
+}  // namespace thrift
+}  // namespace apache
+
+#endif  // COMMON_DATATYPES_PROPMAPOPS_H_
@@ -7,22 +7,83 @@
 
 #include <folly/String.h>
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace nebula {
 
 Set Set::set_intersection(const Set& lhs, const Set& rhs) {
-  if (lhs.size() <= rhs.size()) {
-    Set iset;
-    for (const Value& key : lhs.values) {
-      if (rhs.values.count(key) > 0) {
-        iset.values.insert(key);
-      }
+  // Always probe the bigger one
+  const Set& small = lhs.size() <= rhs.size() ? lhs : rhs;
+  const Set& big = lhs.size() <= rhs.size() ? rhs : lhs;
+  Set iset;
+  iset.values.reserve(small.size());
+  for (const Value& key : small.values) {
+    if (big.values.count(key) > 0) {
+      iset.values.insert(key);
     }
-    return iset;
-  } else {
-    return set_intersection(rhs, lhs);
   }
+  return iset;
+}
+
+Set Set::set_union(const Set& lhs, const Set& rhs) {
+  const Set& small = lhs.size() <= rhs.size() ? lhs : rhs;
+  const Set& big = lhs.size() <= rhs.size() ? rhs : lhs;
+  Set uset(big);
+  uset.values.reserve(big.size() + small.size());
+  uset.values.insert(small.values.begin(), small.values.end());
+  return uset;
+}
+
+Set Set::set_difference(const Set& lhs, const Set& rhs) {
+  Set dset;
+  dset.values.reserve(lhs.size());
+  for (const Value& key : lhs.values) {
+    if (rhs.values.count(key) == 0) {
+      dset.values.insert(key);
+    }
+  }
+  return dset;
+}
+
+std::vector<Value> Set::toSortedVector() const {
+  std::vector<Value> sorted(values.begin(), values.end());
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+std::vector<Value> Set::sorted_intersection(const std::vector<Value>& lhs,
+                                            const std::vector<Value>& rhs) {
+  std::vector<Value> result;
+  result.reserve(std::min(lhs.size(), rhs.size()));
+  std::set_intersection(
+      lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+  return result;
+}
+
+std::vector<Value> Set::sorted_union(const std::vector<Value>& lhs,
+                                     const std::vector<Value>& rhs) {
+  std::vector<Value> result;
+  result.reserve(lhs.size() + rhs.size());
+  std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+  return result;
+}
+
+std::vector<Value> Set::sorted_difference(const std::vector<Value>& lhs,
+                                          const std::vector<Value>& rhs) {
+  std::vector<Value> result;
+  result.reserve(lhs.size());
+  std::set_difference(
+      lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+  return result;
+}
+
+Set Set::fromSortedVector(std::vector<Value>&& sorted) {
+  Set set;
+  set.values.reserve(sorted.size());
+  set.values.insert(std::make_move_iterator(sorted.begin()), std::make_move_iterator(sorted.end()));
+  return set;
 }
 
 std::string Set::toString() const {
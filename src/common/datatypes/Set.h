@@ -7,6 +7,7 @@
 #define COMMON_DATATYPES_SET_H_
 
 #include <unordered_set>
+#include <vector>
 
 #include "common/datatypes/Value.h"
 
@@ -39,6 +40,22 @@ struct Set {
   // Extract the metadata of each element
   folly::dynamic getMetaData() const;
   static Set set_intersection(const Set& lhs, const Set& rhs);
+  static Set set_union(const Set& lhs, const Set& rhs);
+  // Elements in lhs but not in rhs
+  static Set set_difference(const Set& lhs, const Set& rhs);
+
+  // The compact representation of a set: all elements are kept in a contiguous
+  // array in ascending order, so the set operations could be done by merging
+  // instead of probing the hash nodes one by one.
+  std::vector<Value> toSortedVector() const;
+  // The merge kernels over the sorted and deduplicated arrays produced by toSortedVector()
+  static std::vector<Value> sorted_intersection(const std::vector<Value>& lhs,
+                                                const std::vector<Value>& rhs);
+  static std::vector<Value> sorted_union(const std::vector<Value>& lhs,
+                                         const std::vector<Value>& rhs);
+  static std::vector<Value> sorted_difference(const std::vector<Value>& lhs,
+                                              const std::vector<Value>& rhs);
+  static Set fromSortedVector(std::vector<Value>&& sorted);
 
   Set& operator=(const Set& rhs) {
     if (this == &rhs) {
@@ -67,6 +84,14 @@ struct Set {
   size_t size() const {
     return values.size();
   }
+
+  bool empty() const {
+    return values.empty();
+  }
+
+  void reserve(std::size_t n) {
+    values.reserve(n);
+  }
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Set& s) {
@@ -77,6 +102,7 @@ inline std::ostream& operator<<(std::ostream& os, const Set& s) {
 template <typename T>
 inline Set Set::createFromVector(const std::vector<T>& items) {
   std::unordered_set<Value> values;
+  values.reserve(items.size());
   for (const auto& item : items) {
     values.emplace(Value(item));
   }
@@ -0,0 +1,119 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/datatypes/StringDictionary.h"
+
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+
+void StringDictionary::intern(Value& value) {
+  std::lock_guard<std::mutex> guard(lock_);
+  internValue(value);
+}
+
+void StringDictionary::intern(DataSet& ds) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto& row : ds.rows) {
+    for (auto& value : row.values) {
+      internValue(value);
+    }
+  }
+}
+
+size_t StringDictionary::size() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return strings_.size();
+}
+
+void StringDictionary::internValue(Value& value) {
+  switch (value.type()) {
+    case Value::Type::STRING: {
+      const auto& str = value.getStr();
+      if (str.size() > maxLength_) {
+        return;
+      }
+      auto found = strings_.find(folly::StringPiece(str));
+      if (found != strings_.end()) {
+        value = found->second;
+      } else if (strings_.size() < capacity_) {
+        // The key refers to the string shared by the value kept
+        strings_.emplace(folly::StringPiece(str), value);
+      }
+      return;
+    }
+    case Value::Type::LIST: {
+      // The types of the elements are kept, so is the kind of the list
+      auto kind = value.getList().kind();
+      auto& list = value.mutableList();
+      for (auto& v : list.values) {
+        internValue(v);
+      }
+      list.setKind(kind);
+      return;
+    }
+    case Value::Type::MAP: {
+      for (auto& kv : value.mutableMap().kvs) {
+        internValue(kv.second);
+      }
+      return;
+    }
+    case Value::Type::SET: {
+      // The elements of a set are immutable, so it's rebuilt
+      auto& set = value.mutableSet();
+      std::unordered_set<Value> values;
+      values.reserve(set.values.size());
+      for (const auto& v : set.values) {
+        Value interned = v;
+        internValue(interned);
+        values.emplace(std::move(interned));
+      }
+      set.values = std::move(values);
+      return;
+    }
+    case Value::Type::DATASET: {
+      for (auto& row : value.mutableDataSet().rows) {
+        for (auto& v : row.values) {
+          internValue(v);
+        }
+      }
+      return;
+    }
+    case Value::Type::VERTEX: {
+      // A shared vertex might be read by the others
+      if (value.getVertexPtr()->refcnt.load() != 1) {
+        return;
+      }
+      auto& vertex = value.mutableVertex();
+      internValue(vertex.vid);
+      for (auto& tag : vertex.tags) {
+        for (auto&& prop : tag.props) {
+          internValue(prop.second);
+        }
+      }
+      return;
+    }
+    case Value::Type::EDGE: {
+      if (value.getEdgePtr()->refcnt.load() != 1) {
+        return;
+      }
+      auto& edge = value.mutableEdge();
+      internValue(edge.src);
+      internValue(edge.dst);
+      for (auto&& prop : edge.props) {
+        internValue(prop.second);
+      }
+      return;
+    }
+    default:
+      return;
+  }
+}
+
+}  // namespace nebula
@@ -0,0 +1,55 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_STRINGDICTIONARY_H_
+#define COMMON_DATATYPES_STRINGDICTIONARY_H_
+
+#include <folly/container/F14Map.h>
+
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * @brief The dictionary of the strings of a query, which replaces the strings of the values by the
+ * equal ones interned, so a string repeated in the results, e.g. a category or a country of
+ * millions of rows, shares one SharedString, and copying or comparing it is cheap.
+ *
+ * Only the strings at most maxLength bytes are interned, the longer ones are seldom repeated. A
+ * full dictionary still replaces the strings interned, but interns no more. It's thread safe, the
+ * values interned must not be shared with the other threads, e.g. just received from storage.
+ */
+class StringDictionary final {
+ public:
+  StringDictionary(size_t capacity, size_t maxLength)
+      : capacity_(capacity), maxLength_(maxLength) {}
+
+  /**
+   * @brief Intern the strings of the value, and of the lists, sets, maps, data sets, and the
+   * vertices and edges not shared, in it.
+   */
+  void intern(Value& value);
+
+  void intern(DataSet& ds);
+
+  size_t size() const;
+
+ private:
+  void internValue(Value& value);
+
+  const size_t capacity_;
+  const size_t maxLength_;
+  mutable std::mutex lock_;
+  // Keyed by the strings of the values kept, which are never mutated
+  folly::F14FastMap<folly::StringPiece, Value> strings_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_DATATYPES_STRINGDICTIONARY_H_
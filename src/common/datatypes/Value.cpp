@@ -66,7 +66,7 @@ Value::Value(const Value& rhs) : type_(Value::Type::__EMPTY__) {
       break;
     }
     case Type::STRING: {
-      setS(*rhs.value_.sVal);
+      setS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -605,7 +605,7 @@ const double& Value::getFloat() const {
 
 const std::string& Value::getStr() const {
   CHECK_EQ(type_, Type::STRING);
-  return *value_.sVal;
+  return value_.sVal->str;
 }
 
 const Date& Value::getDate() const {
@@ -655,12 +655,12 @@ const Path* Value::getPathPtr() const {
 
 const List& Value::getList() const {
   CHECK_EQ(type_, Type::LIST);
-  return *(value_.lVal);
+  return value_.lVal->val;
 }
 
 const List* Value::getListPtr() const {
   CHECK_EQ(type_, Type::LIST);
-  return value_.lVal.get();
+  return &value_.lVal->val;
 }
 
 const Map& Value::getMap() const {
@@ -675,12 +675,12 @@ const Map* Value::getMapPtr() const {
 
 const Set& Value::getSet() const {
   CHECK_EQ(type_, Type::SET);
-  return *(value_.uVal);
+  return value_.uVal->val;
 }
 
 const Set* Value::getSetPtr() const {
   CHECK_EQ(type_, Type::SET);
-  return value_.uVal.get();
+  return &value_.uVal->val;
 }
 
 const DataSet& Value::getDataSet() const {
@@ -735,7 +735,14 @@ double& Value::mutableFloat() {
 
 std::string& Value::mutableStr() {
   CHECK_EQ(type_, Type::STRING);
-  return *value_.sVal;
+  if (value_.sVal->refcnt.load() > 1) {
+    auto* copy = new SharedString(value_.sVal->str);
+    if (value_.sVal->unref() == 0) {
+      delete value_.sVal;
+    }
+    value_.sVal = copy;
+  }
+  return value_.sVal->str;
 }
 
 Date& Value::mutableDate() {
@@ -770,7 +777,16 @@ Path& Value::mutablePath() {
 
 List& Value::mutableList() {
   CHECK_EQ(type_, Type::LIST);
-  return *(value_.lVal);
+  if (value_.lVal->refcnt.load() > 1) {
+    auto* copy = new SharedContainer<List>(value_.lVal->val);
+    if (value_.lVal->unref() == 0) {
+      delete value_.lVal;
+    }
+    value_.lVal = copy;
+  }
+  // The caller may modify the elements directly
+  value_.lVal->val.resetKind();
+  return value_.lVal->val;
 }
 
 Map& Value::mutableMap() {
@@ -780,7 +796,14 @@ Map& Value::mutableMap() {
 
 Set& Value::mutableSet() {
   CHECK_EQ(type_, Type::SET);
-  return *(value_.uVal);
+  if (value_.uVal->refcnt.load() > 1) {
+    auto* copy = new SharedContainer<Set>(value_.uVal->val);
+    if (value_.uVal->unref() == 0) {
+      delete value_.uVal;
+    }
+    value_.uVal = copy;
+  }
+  return value_.uVal->val;
 }
 
 DataSet& Value::mutableDataSet() {
@@ -828,7 +851,9 @@ double Value::moveFloat() {
 
 std::string Value::moveStr() {
   CHECK_EQ(type_, Type::STRING);
-  std::string v = std::move(*value_.sVal);
+  // Move the string only if it's not shared by the others
+  std::string v =
+      value_.sVal->refcnt.load() == 1 ? std::move(value_.sVal->str) : value_.sVal->str;
   clear();
   return v;
 }
@@ -877,7 +902,9 @@ Path Value::movePath() {
 
 List Value::moveList() {
   CHECK_EQ(type_, Type::LIST);
-  List list = std::move(*(value_.lVal));
+  // The list shared by the other values is copied
+  List list = value_.lVal->refcnt.load() == 1 ? std::move(value_.lVal->val) : value_.lVal->val;
+  list.resetKind();
   clear();
   return list;
 }
@@ -891,7 +918,7 @@ Map Value::moveMap() {
 
 Set Value::moveSet() {
   CHECK_EQ(type_, Type::SET);
-  Set set = std::move(*(value_.uVal));
+  Set set = value_.uVal->refcnt.load() == 1 ? std::move(value_.uVal->val) : value_.uVal->val;
   clear();
   return set;
 }
@@ -939,7 +966,12 @@ void Value::clearSlow() {
       break;
     }
     case Type::STRING: {
-      destruct(value_.sVal);
+      if (value_.sVal) {
+        if (value_.sVal->unref() == 0) {
+          delete value_.sVal;
+        }
+        value_.sVal = nullptr;
+      }
       break;
     }
     case Type::DATE: {
@@ -979,7 +1011,12 @@ void Value::clearSlow() {
       break;
     }
     case Type::LIST: {
-      destruct(value_.lVal);
+      if (value_.lVal) {
+        if (value_.lVal->unref() == 0) {
+          delete value_.lVal;
+        }
+        value_.lVal = nullptr;
+      }
       break;
     }
     case Type::MAP: {
@@ -987,7 +1024,12 @@ void Value::clearSlow() {
       break;
     }
     case Type::SET: {
-      destruct(value_.uVal);
+      if (value_.uVal) {
+        if (value_.uVal->unref() == 0) {
+          delete value_.uVal;
+        }
+        value_.uVal = nullptr;
+      }
       break;
     }
     case Type::DATASET: {
@@ -1032,8 +1074,11 @@ Value& Value::operator=(Value&& rhs) noexcept {
       break;
     }
     case Type::STRING: {
-      setS(std::move(rhs.value_.sVal));
-      break;
+      value_.sVal = rhs.value_.sVal;
+      type_ = Type::STRING;
+      rhs.value_.sVal = nullptr;
+      rhs.type_ = Type::__EMPTY__;
+      return *this;
     }
     case Type::DATE: {
       setD(std::move(rhs.value_.dVal));
@@ -1066,16 +1111,22 @@ Value& Value::operator=(Value&& rhs) noexcept {
       break;
     }
     case Type::LIST: {
-      setL(std::move(rhs.value_.lVal));
-      break;
+      value_.lVal = rhs.value_.lVal;
+      type_ = Type::LIST;
+      rhs.value_.lVal = nullptr;
+      rhs.type_ = Type::__EMPTY__;
+      return *this;
     }
     case Type::MAP: {
       setM(std::move(rhs.value_.mVal));
       break;
     }
     case Type::SET: {
-      setU(std::move(rhs.value_.uVal));
-      break;
+      value_.uVal = rhs.value_.uVal;
+      type_ = Type::SET;
+      rhs.value_.uVal = nullptr;
+      rhs.type_ = Type::__EMPTY__;
+      return *this;
     }
     case Type::DATASET: {
       setG(std::move(rhs.value_.gVal));
@@ -1124,7 +1175,7 @@ Value& Value::operator=(const Value& rhs) {
       break;
     }
     case Type::STRING: {
-      setS(*rhs.value_.sVal);
+      setS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -1224,23 +1275,24 @@ void Value::setF(double&& v) {
   type_ = Type::FLOAT;
 }
 
-void Value::setS(std::unique_ptr<std::string> v) {
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(std::move(v));
+void Value::setS(SharedString* v) {
+  value_.sVal = v;
+  value_.sVal->ref();
   type_ = Type::STRING;
 }
 
 void Value::setS(const std::string& v) {
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(v));
+  new (std::addressof(value_.sVal)) SharedString*(new SharedString(v));
   type_ = Type::STRING;
 }
 
 void Value::setS(std::string&& v) {
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(std::move(v)));
+  new (std::addressof(value_.sVal)) SharedString*(new SharedString(std::move(v)));
   type_ = Type::STRING;
 }
 
 void Value::setS(const char* v) {
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(v));
+  new (std::addressof(value_.sVal)) SharedString*(new SharedString(std::string(v)));
   type_ = Type::STRING;
 }
 
@@ -1326,23 +1378,25 @@ void Value::setP(Path&& v) {
   type_ = Type::PATH;
 }
 
-void Value::setL(const std::unique_ptr<List>& v) {
-  new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(*v));
+void Value::setL(SharedContainer<List>* v) {
+  value_.lVal = v;
+  value_.lVal->ref();
   type_ = Type::LIST;
 }
 
 void Value::setL(std::unique_ptr<List>&& v) {
-  new (std::addressof(value_.lVal)) std::unique_ptr<List>(std::move(v));
+  new (std::addressof(value_.lVal))
+      SharedContainer<List>*(new SharedContainer<List>(std::move(*v)));
   type_ = Type::LIST;
 }
 
 void Value::setL(const List& v) {
-  new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(v));
+  new (std::addressof(value_.lVal)) SharedContainer<List>*(new SharedContainer<List>(v));
   type_ = Type::LIST;
 }
 
 void Value::setL(List&& v) {
-  new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(std::move(v)));
+  new (std::addressof(value_.lVal)) SharedContainer<List>*(new SharedContainer<List>(std::move(v)));
   type_ = Type::LIST;
 }
 
@@ -1366,23 +1420,24 @@ void Value::setM(Map&& v) {
   type_ = Type::MAP;
 }
 
-void Value::setU(const std::unique_ptr<Set>& v) {
-  new (std::addressof(value_.uVal)) std::unique_ptr<Set>(new Set(*v));
+void Value::setU(SharedContainer<Set>* v) {
+  value_.uVal = v;
+  value_.uVal->ref();
   type_ = Type::SET;
 }
 
 void Value::setU(std::unique_ptr<Set>&& v) {
-  new (std::addressof(value_.uVal)) std::unique_ptr<Set>(std::move(v));
+  new (std::addressof(value_.uVal)) SharedContainer<Set>*(new SharedContainer<Set>(std::move(*v)));
   type_ = Type::SET;
 }
 
 void Value::setU(const Set& v) {
-  new (std::addressof(value_.uVal)) std::unique_ptr<Set>(new Set(v));
+  new (std::addressof(value_.uVal)) SharedContainer<Set>*(new SharedContainer<Set>(v));
   type_ = Type::SET;
 }
 
 void Value::setU(Set&& v) {
-  new (std::addressof(value_.vVal)) std::unique_ptr<Set>(new Set(std::move(v)));
+  new (std::addressof(value_.uVal)) SharedContainer<Set>*(new SharedContainer<Set>(std::move(v)));
   type_ = Type::SET;
 }
 
@@ -2757,6 +2812,9 @@ bool Value::equals(const Value& rhs) const {
       }
     }
     case Value::Type::STRING: {
+      if (value_.sVal == rhs.value_.sVal) {
+        return true;
+      }
       return getStr() == rhs.getStr();
     }
     case Value::Type::DATE: {
@@ -2786,12 +2844,18 @@ bool Value::equals(const Value& rhs) const {
       return getPath() == rhs.getPath();
     }
     case Value::Type::LIST: {
+      if (value_.lVal == rhs.value_.lVal) {
+        return true;
+      }
       return getList() == rhs.getList();
     }
     case Value::Type::MAP: {
       return getMap() == rhs.getMap();
     }
     case Value::Type::SET: {
+      if (value_.uVal == rhs.value_.uVal) {
+        return true;
+      }
       return getSet() == rhs.getSet();
     }
     case Value::Type::DATASET: {
@@ -3023,6 +3087,14 @@ std::size_t VertexHash::operator()(const Value& v) const {
   }
 }
 
+std::size_t MixedValueHash::operator()(const Value& v) const {
+  // The hashes of the strings are well mixed already
+  if (v.isStr()) {
+    return std::hash<std::string>()(v.getStr());
+  }
+  return folly::hash::twang_mix64(std::hash<Value>()(v));
+}
+
 bool VertexEqual::operator()(const Value& lhs, const Value& rhs) const {
   if (lhs.type() == rhs.type()) {
     if (lhs.isVertex()) {
@@ -8,6 +8,7 @@
 
 #include <folly/dynamic.h>
 
+#include <atomic>
 #include <memory>
 
 #include "common/datatypes/Date.h"
@@ -34,6 +35,43 @@ struct Set;
 struct DataSet;
 struct Geography;
 
+// The string of a Value, shared by the copies of the Value by the reference count like Vertex and
+// Edge, so copying a string Value doesn't copy the string, and a string repeated in the results,
+// e.g. interned by StringDictionary, is kept once. It's copied before mutated if shared.
+struct SharedString {
+  std::string str;
+  std::atomic<size_t> refcnt{1};
+
+  explicit SharedString(const std::string& s) : str(s) {}
+  explicit SharedString(std::string&& s) : str(std::move(s)) {}
+
+  size_t ref() {
+    return ++refcnt;
+  }
+  size_t unref() {
+    return --refcnt;
+  }
+};
+
+// The List or the Set of a Value, shared by the copies of the Value like SharedString, so copying
+// a large container, e.g. the props of a row from storage, doesn't copy its elements. It's copied
+// before mutated if shared. T is complete wherever it's instantiated, i.e. in Value.cpp.
+template <typename T>
+struct SharedContainer {
+  T val;
+  std::atomic<size_t> refcnt{1};
+
+  explicit SharedContainer(const T& v) : val(v) {}
+  explicit SharedContainer(T&& v) : val(std::move(v)) {}
+
+  size_t ref() {
+    return ++refcnt;
+  }
+  size_t unref() {
+    return --refcnt;
+  }
+};
+
 enum class NullType {
   __NULL__ = 0,
   NaN = 1,
@@ -391,16 +429,16 @@ struct Value {
     bool bVal;
     int64_t iVal;
     double fVal;
-    std::unique_ptr<std::string> sVal;
+    SharedString* sVal;
     Date dVal;
     Time tVal;
     DateTime dtVal;
     Vertex* vVal;
     Edge* eVal;
     std::unique_ptr<Path> pVal;
-    std::unique_ptr<List> lVal;
+    SharedContainer<List>* lVal;
     std::unique_ptr<Map> mVal;
-    std::unique_ptr<Set> uVal;
+    SharedContainer<Set>* uVal;
     std::unique_ptr<DataSet> gVal;
     std::unique_ptr<Geography> ggVal;
     std::unique_ptr<Duration> duVal;
@@ -430,7 +468,7 @@ struct Value {
   void setS(const std::string& v);
   void setS(std::string&& v);
   void setS(const char* v);
-  void setS(std::unique_ptr<std::string> v);
+  void setS(SharedString* v);
   // Date value
   void setD(const Date& v);
   void setD(Date&& v);
@@ -454,7 +492,7 @@ struct Value {
   void setP(const Path& v);
   void setP(Path&& v);
   // List value
-  void setL(const std::unique_ptr<List>& v);
+  void setL(SharedContainer<List>* v);
   void setL(std::unique_ptr<List>&& v);
   void setL(const List& v);
   void setL(List&& v);
@@ -464,7 +502,7 @@ struct Value {
   void setM(const Map& v);
   void setM(Map&& v);
   // Set value
-  void setU(const std::unique_ptr<Set>& v);
+  void setU(SharedContainer<Set>* v);
   void setU(std::unique_ptr<Set>&& v);
   void setU(const Set& v);
   void setU(Set&& v);
@@ -554,6 +592,13 @@ struct VertexHash {
   std::size_t operator()(const Value& v) const;
 };
 
+// The hash of Value with the bits well mixed, for the in-memory hash tables which index by a part of
+// the bits, e.g. the power-of-two tables. std::hash<Value> returns the integers themselves, and
+// it's kept as is since the hash function of nGQL returns it.
+struct MixedValueHash {
+  std::size_t operator()(const Value& v) const;
+};
+
 struct VertexEqual {
   bool operator()(const Value& lhs, const Value& rhs) const;
 };
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/datatypes/PropMap.h"
 #include "common/datatypes/Value.h"
 #include "common/thrift/ThriftTypes.h"
 
@@ -17,12 +18,12 @@ namespace nebula {
 
 struct Tag {
   std::string name;
-  std::unordered_map<std::string, Value> props;
+  PropMap props;
 
   Tag() = default;
   Tag(Tag&& tag) noexcept : name(std::move(tag.name)), props(std::move(tag.props)) {}
   Tag(const Tag& tag) : name(tag.name), props(tag.props) {}
-  Tag(std::string tagName, std::unordered_map<std::string, Value> tagProps)
+  Tag(std::string tagName, PropMap tagProps)
       : name(std::move(tagName)), props(std::move(tagProps)) {}
   explicit Tag(const std::string& tagName) : name(tagName), props() {}
 
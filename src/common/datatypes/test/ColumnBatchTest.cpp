@@ -0,0 +1,115 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/ColumnBatch.h"
+
+namespace nebula {
+
+TEST(ColumnBatchTest, Column) {
+  {
+    auto column = Column::fromValues({1, Value::kNullValue, 3});
+    EXPECT_EQ(Column::Kind::kInt, column.kind());
+    EXPECT_EQ(3, column.size());
+    EXPECT_TRUE(column.hasNull());
+    EXPECT_FALSE(column.isNull(0));
+    EXPECT_TRUE(column.isNull(1));
+    EXPECT_EQ((std::vector<int64_t>{1, 0, 3}), column.ints());
+    EXPECT_EQ(Value(3), column.value(2));
+    EXPECT_EQ(Value::kNullValue, column.value(1));
+  }
+  {
+    // The leading NULLs are kept when the kind is decided
+    auto column = Column::fromValues({Value::kNullValue, Value::kNullValue, 1.5, "a"});
+    EXPECT_EQ(Column::Kind::kBoxed, column.kind());
+    EXPECT_EQ(4, column.size());
+    EXPECT_TRUE(column.isNull(0));
+    EXPECT_TRUE(column.isNull(1));
+    EXPECT_EQ(Value(1.5), column.value(2));
+    EXPECT_EQ(Value("a"), column.value(3));
+  }
+  {
+    auto column = Column::fromValues({Value::kNullValue, "a", "b"});
+    EXPECT_EQ(Column::Kind::kString, column.kind());
+    EXPECT_EQ((std::vector<std::string>{"", "a", "b"}), column.strs());
+    EXPECT_TRUE(column.isNull(0));
+  }
+  {
+    auto column = Column::fromValues({true, false});
+    EXPECT_EQ(Column::Kind::kBool, column.kind());
+    EXPECT_FALSE(column.hasNull());
+    EXPECT_EQ(Value(false), column.value(1));
+  }
+  {
+    // Only the plain NULL fits in the typed column
+    auto column = Column::fromValues({1, Value(NullType::BAD_TYPE)});
+    EXPECT_EQ(Column::Kind::kBoxed, column.kind());
+    EXPECT_EQ(Value(NullType::BAD_TYPE), column.value(1));
+  }
+  {
+    std::vector<Value> values;
+    for (int64_t i = 0; i < 200; ++i) {
+      values.emplace_back(i % 3 == 0 ? Value::kNullValue : Value(i / 2.0));
+    }
+    auto column = Column::fromValues(values);
+    EXPECT_EQ(Column::Kind::kFloat, column.kind());
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(i % 3 == 0, column.isNull(i));
+      EXPECT_EQ(values[i], column.value(i));
+    }
+  }
+  {
+    auto column = Column::fromValues({Value::kNullValue});
+    EXPECT_EQ(Column::Kind::kNull, column.kind());
+    EXPECT_EQ(Value::kNullValue, column.value(0));
+  }
+}
+
+TEST(ColumnBatchTest, DataSet) {
+  DataSet ds({"int", "str", "mixed"});
+  for (int64_t i = 0; i < 10; ++i) {
+    ds.emplace_back(Row({i,
+                         i % 4 == 0 ? Value::kNullValue : Value(folly::to<std::string>(i)),
+                         i % 2 == 0 ? Value(i) : Value(List({i}))}));
+  }
+  auto batch = ColumnBatch::fromDataSet(ds);
+  EXPECT_EQ(ds.colNames, batch.colNames());
+  EXPECT_EQ(3, batch.colSize());
+  EXPECT_EQ(10, batch.rowSize());
+  EXPECT_EQ(Column::Kind::kInt, batch.column(0).kind());
+  EXPECT_EQ(Column::Kind::kString, batch.column(1).kind());
+  EXPECT_EQ(Column::Kind::kBoxed, batch.column(2).kind());
+  EXPECT_EQ(ds.rows[5], batch.row(5));
+  EXPECT_EQ(ds, batch.toDataSet());
+
+  auto part = ColumnBatch::fromRows(ds.colNames, ds.rows, 2, 6, {2, 0});
+  EXPECT_EQ((std::vector<std::string>{"mixed", "int"}), part.colNames());
+  EXPECT_EQ(4, part.rowSize());
+  EXPECT_EQ(Row({Value(List({3})), 3}), part.row(1));
+
+  ColumnBatch appended(ds.colNames);
+  for (const auto& row : ds.rows) {
+    appended.appendRow(row);
+  }
+  EXPECT_EQ(batch, appended);
+
+  ColumnBatch added;
+  added.addColumn("int", Column::fromValues({1, 2}));
+  added.addColumn("float", Column::fromValues({1.0, Value::kNullValue}));
+  EXPECT_EQ(2, added.rowSize());
+  EXPECT_EQ(Row({2, Value::kNullValue}), added.row(1));
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -170,6 +170,45 @@ BENCHMARK_RELATIVE(HashTupleEdge, n) {
   }
 }
 
+BENCHMARK_DRAW_LINE();
+
+// Build and copy the edges of 8 props, as the iterators of the responses from storage do
+static const std::vector<std::string> kPropNames{"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7"};
+
+BENCHMARK(BuildEdgePropsByMap, n) {
+  std::vector<Value> row;
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < kPropNames.size(); ++i) {
+      row.emplace_back(static_cast<int64_t>(i));
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    std::unordered_map<std::string, Value> props;
+    for (size_t j = 0; j < kPropNames.size(); ++j) {
+      props.emplace(kPropNames[j], row[j]);
+    }
+    Edge edge(1, 2, 1, "like", 0, std::move(props));
+    Edge copy(edge);
+    folly::doNotOptimizeAway(copy);
+  }
+}
+
+BENCHMARK_RELATIVE(BuildEdgePropsBySharedNames, n) {
+  std::vector<Value> row;
+  std::shared_ptr<nebula::PropNames> names;
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < kPropNames.size(); ++i) {
+      row.emplace_back(static_cast<int64_t>(i));
+    }
+    names = std::make_shared<nebula::PropNames>(kPropNames);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    Edge edge(1, 2, 1, "like", 0, nebula::PropMap(names, row));
+    Edge copy(edge);
+    folly::doNotOptimizeAway(copy);
+  }
+}
+
 int main() {
   folly::runBenchmarks();
   return 0;
@@ -4,9 +4,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "common/base/Base.h"
 #include "common/datatypes/Edge.h"
+#include "common/datatypes/EdgeOps-inl.h"
 
 namespace nebula {
 TEST(Edge, Format) {
@@ -143,4 +145,89 @@ TEST(Edge, id) {
   }
 }
 
+TEST(PropMap, Access) {
+  PropMap props{{"p1", 1}, {"p2", "a"}};
+  EXPECT_EQ(2, props.size());
+  EXPECT_EQ(1, props.count("p1"));
+  EXPECT_EQ(0, props.count("p3"));
+  EXPECT_EQ(Value(1), props.at("p1"));
+  EXPECT_THROW(props.at("p3"), std::out_of_range);
+
+  auto found = props.find("p2");
+  ASSERT_NE(found, props.end());
+  EXPECT_EQ("p2", found->first);
+  EXPECT_EQ(Value("a"), found->second);
+  EXPECT_EQ(props.end(), props.find("p3"));
+
+  EXPECT_FALSE(props.emplace("p1", 2).second);
+  EXPECT_EQ(Value(1), props["p1"]);
+  EXPECT_TRUE(props.emplace("p3", 3.0).second);
+  props["p4"] = true;
+  EXPECT_EQ(4, props.size());
+
+  PropMap::Map expected{{"p1", 1}, {"p2", "a"}, {"p3", 3.0}, {"p4", true}};
+  EXPECT_EQ(expected, props.toMap());
+  PropMap::Map iterated;
+  for (const auto& prop : props) {
+    iterated.emplace(prop.first, prop.second);
+  }
+  EXPECT_EQ(expected, iterated);
+
+  // The same props in another order
+  EXPECT_EQ(PropMap(expected), props);
+  props["p4"] = false;
+  EXPECT_NE(PropMap(expected), props);
+
+  props.clear();
+  EXPECT_TRUE(props.empty());
+  EXPECT_EQ(props.begin(), props.end());
+  props.emplace("p5", 5);
+  EXPECT_EQ((PropMap::Map{{"p5", 5}}), props.toMap());
+}
+
+TEST(PropMap, SharedNames) {
+  auto names = std::make_shared<PropNames>(std::vector<std::string>{"p1", "p2"});
+  PropMap props1(names, {1, 2});
+  PropMap props2(names, {3, 4});
+  EXPECT_EQ(props1.names(), props2.names());
+  EXPECT_EQ(Value(4), props2.at("p2"));
+  EXPECT_NE(props1, props2);
+  EXPECT_EQ(props1, PropMap(names, {1, 2}));
+
+  // The names shared are copied when a name is added
+  props2.emplace("p3", 5);
+  EXPECT_NE(props1.names(), props2.names());
+  EXPECT_EQ(2, names->size());
+  EXPECT_EQ(2, props1.size());
+  EXPECT_EQ(3, props2.size());
+  EXPECT_EQ(Value(5), props2.at("p3"));
+  EXPECT_EQ(0, props1.count("p3"));
+
+  // The names are indexed once there are many
+  std::vector<std::string> many;
+  std::vector<Value> values;
+  for (int i = 0; i < 20; ++i) {
+    many.emplace_back(folly::stringPrintf("p%d", i));
+    values.emplace_back(i);
+  }
+  PropMap props3(std::make_shared<PropNames>(std::move(many)), std::move(values));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(Value(i), props3.at(folly::stringPrintf("p%d", i)));
+  }
+  EXPECT_EQ(0, props3.count("p20"));
+}
+
+TEST(Edge, SerializeProps) {
+  auto names = std::make_shared<PropNames>(std::vector<std::string>{"p1", "p2"});
+  Edge edge("1", "2", 1, "like", 0, PropMap(names, {1, "a"}));
+  std::string buf;
+  apache::thrift::CompactSerializer::serialize(edge, &buf);
+  Edge copy;
+  auto size = apache::thrift::CompactSerializer::deserialize(buf, copy);
+  EXPECT_EQ(buf.size(), size);
+  EXPECT_EQ(edge, copy);
+  EXPECT_EQ(edge.props, copy.props);
+  EXPECT_EQ((PropMap::Map{{"p1", 1}, {"p2", "a"}}), copy.props.toMap());
+}
+
 }  // namespace nebula
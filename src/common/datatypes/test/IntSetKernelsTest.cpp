@@ -0,0 +1,109 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "common/base/Base.h"
+#include "common/datatypes/IntSetKernels.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Set.h"
+
+namespace nebula {
+
+static const std::vector<IntSetKernels::Isa> kAllIsa = {
+    IntSetKernels::Isa::kScalar, IntSetKernels::Isa::kSSE42, IntSetKernels::Isa::kAVX2};
+
+static std::vector<IntSetKernels::Isa> supportedIsa() {
+  std::vector<IntSetKernels::Isa> isas;
+  for (auto isa : kAllIsa) {
+    if (isa <= IntSetKernels::detectIsa()) {
+      isas.emplace_back(isa);
+    }
+  }
+  return isas;
+}
+
+TEST(IntSetKernelsTest, Basic) {
+  std::vector<int64_t> lhs = {1, 3, 5, 7, 9, 11, 13, 15, 17};
+  std::vector<int64_t> rhs = {2, 3, 4, 5, 15, 16, 17, 18};
+  for (auto isa : supportedIsa()) {
+    std::vector<int64_t> result;
+    IntSetKernels::intersection(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result, isa);
+    EXPECT_EQ((std::vector<int64_t>{3, 5, 15, 17}), result);
+    EXPECT_EQ(4,
+              IntSetKernels::intersectionSize(lhs.data(), lhs.size(), rhs.data(), rhs.size(), isa));
+    IntSetKernels::difference(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result, isa);
+    EXPECT_EQ((std::vector<int64_t>{1, 7, 9, 11, 13}), result);
+    EXPECT_TRUE(IntSetKernels::contains(rhs.data(), rhs.size(), 16, isa));
+    EXPECT_FALSE(IntSetKernels::contains(rhs.data(), rhs.size(), 6, isa));
+    EXPECT_FALSE(IntSetKernels::contains(rhs.data(), 0, 2, isa));
+  }
+  std::vector<int64_t> result;
+  IntSetKernels::setUnion(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result);
+  EXPECT_EQ((std::vector<int64_t>{1, 2, 3, 4, 5, 7, 9, 11, 13, 15, 16, 17, 18}), result);
+}
+
+TEST(IntSetKernelsTest, Random) {
+  for (size_t round = 0; round < 1000; ++round) {
+    std::set<int64_t> lset, rset;
+    auto range = folly::Random::rand32(1, 200);
+    auto lsize = folly::Random::rand32(100);
+    auto rsize = folly::Random::rand32(100);
+    for (size_t i = 0; i < lsize; ++i) {
+      lset.emplace(folly::Random::rand32(range));
+    }
+    for (size_t i = 0; i < rsize; ++i) {
+      rset.emplace(folly::Random::rand32(range));
+    }
+    std::vector<int64_t> lhs(lset.begin(), lset.end());
+    std::vector<int64_t> rhs(rset.begin(), rset.end());
+    std::vector<int64_t> expectIntersection, expectDifference;
+    std::set_intersection(lhs.begin(),
+                          lhs.end(),
+                          rhs.begin(),
+                          rhs.end(),
+                          std::back_inserter(expectIntersection));
+    std::set_difference(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expectDifference));
+
+    for (auto isa : supportedIsa()) {
+      std::vector<int64_t> result;
+      IntSetKernels::intersection(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result, isa);
+      EXPECT_EQ(expectIntersection, result);
+      EXPECT_EQ(expectIntersection.size(),
+                IntSetKernels::intersectionSize(
+                    lhs.data(), lhs.size(), rhs.data(), rhs.size(), isa));
+      IntSetKernels::difference(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result, isa);
+      EXPECT_EQ(expectDifference, result);
+      int64_t target = folly::Random::rand32(range);
+      EXPECT_EQ(lset.count(target) > 0,
+                IntSetKernels::contains(lhs.data(), lhs.size(), target, isa));
+    }
+  }
+}
+
+TEST(IntSetKernelsTest, ToSortedInts) {
+  std::vector<int64_t> result;
+  EXPECT_TRUE(IntSetKernels::toSortedInts(Value(List({3, 1, 2, 3})), result));
+  EXPECT_EQ((std::vector<int64_t>{1, 2, 3}), result);
+  EXPECT_TRUE(
+      IntSetKernels::toSortedInts(Value(Set::createFromVector(std::vector<int64_t>{5, 4})), result));
+  EXPECT_EQ((std::vector<int64_t>{4, 5}), result);
+  EXPECT_FALSE(IntSetKernels::toSortedInts(Value(List({1, "a"})), result));
+  EXPECT_FALSE(IntSetKernels::toSortedInts(Value(1), result));
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -111,6 +111,94 @@ BENCHMARK(HashIntValue, n) {
   }
 }
 
+BENCHMARK_DRAW_LINE();
+
+// Linear probing in a power-of-two table, where the hashes differing only in the high bits collide
+template <typename Hash>
+size_t probeTable(const std::vector<Value> &values) {
+  size_t capacity = 1;
+  while (capacity < values.size() * 2) {
+    capacity <<= 1;
+  }
+  std::vector<const Value *> slots(capacity, nullptr);
+  size_t probes = 0;
+  Hash hash;
+  for (const auto &value : values) {
+    for (auto i = hash(value) & (capacity - 1);; i = (i + 1) & (capacity - 1)) {
+      ++probes;
+      if (slots[i] == nullptr) {
+        slots[i] = &value;
+        break;
+      }
+      if (*slots[i] == value) {
+        break;
+      }
+    }
+  }
+  return probes;
+}
+
+// The vids of the space with the high bits set, in the stride of the parts
+std::vector<Value> stridedInts() {
+  std::vector<Value> values;
+  for (int64_t i = 0; i < 4096; i++) {
+    values.emplace_back((int64_t(1) << 40) + i * 1024);
+  }
+  return values;
+}
+
+std::vector<Value> sequentialInts() {
+  std::vector<Value> values;
+  for (int64_t i = 0; i < 4096; i++) {
+    values.emplace_back(i);
+  }
+  return values;
+}
+
+std::vector<Value> randomInts() {
+  std::vector<Value> values;
+  std::uniform_int_distribution<int64_t> range;
+  for (int64_t i = 0; i < 4096; i++) {
+    values.emplace_back(range(rng));
+  }
+  return values;
+}
+
+template <typename Hash>
+void probeTableBenchmark(size_t iters, std::vector<Value> (*gen)()) {
+  std::vector<Value> values;
+  BENCHMARK_SUSPEND {
+    values = gen();
+  }
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(probeTable<Hash>(values));
+  }
+}
+
+BENCHMARK(StdHashStridedInt, iters) {
+  probeTableBenchmark<std::hash<Value>>(iters, stridedInts);
+}
+
+BENCHMARK_RELATIVE(MixedHashStridedInt, iters) {
+  probeTableBenchmark<nebula::MixedValueHash>(iters, stridedInts);
+}
+
+BENCHMARK(StdHashSequentialInt, iters) {
+  probeTableBenchmark<std::hash<Value>>(iters, sequentialInts);
+}
+
+BENCHMARK_RELATIVE(MixedHashSequentialInt, iters) {
+  probeTableBenchmark<nebula::MixedValueHash>(iters, sequentialInts);
+}
+
+BENCHMARK(StdHashRandomInt, iters) {
+  probeTableBenchmark<std::hash<Value>>(iters, randomInts);
+}
+
+BENCHMARK_RELATIVE(MixedHashRandomInt, iters) {
+  probeTableBenchmark<nebula::MixedValueHash>(iters, randomInts);
+}
+
 int main() {
   folly::runBenchmarks();
   return 0;
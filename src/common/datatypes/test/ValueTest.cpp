@@ -18,6 +18,7 @@
 #include "common/datatypes/Map.h"
 #include "common/datatypes/Path.h"
 #include "common/datatypes/Set.h"
+#include "common/datatypes/StringDictionary.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/ValueOps-inl.h"
 #include "common/datatypes/Vertex.h"
@@ -1877,6 +1878,230 @@ TEST(Value, Hash) {
   }
 }
 
+TEST(Value, MixedHash) {
+  // The equal values have the same hash
+  EXPECT_EQ(MixedValueHash()(Value(1)), MixedValueHash()(Value(1)));
+  EXPECT_EQ(MixedValueHash()(Value("abc")), MixedValueHash()(Value("abc")));
+  EXPECT_EQ(MixedListHash()(List({1, "abc"})), MixedListHash()(List({1, "abc"})));
+  // The single-column rows are hashed as the only value
+  EXPECT_EQ(MixedListHash()(List({2})), MixedValueHash()(Value(2)));
+  {
+    // The integers differing only in the high bits spread over the low bits
+    std::unordered_set<size_t> lowBits;
+    for (int64_t i = 0; i < 1024; ++i) {
+      lowBits.emplace(MixedValueHash()(Value((int64_t(1) << 40) + i * 1024)) & 1023);
+    }
+    EXPECT_GT(lowBits.size(), 512);
+  }
+  {
+    std::vector<Row> rows;
+    for (int64_t i = 0; i < 128; ++i) {
+      rows.emplace_back(Row({i * 65536, i % 2}));
+    }
+    robin_hood::unordered_flat_set<const Row*, MixedListHash> unique;
+    for (auto& row : rows) {
+      unique.emplace(&row);
+    }
+    EXPECT_EQ(unique.size(), 128);
+    Row dup({0, 0});
+    EXPECT_FALSE(unique.emplace(&dup).second);
+  }
+}
+
+TEST(Value, TypedList) {
+  {
+    List list({1, 2, 3});
+    list.setKind(List::Kind::kInt);
+    EXPECT_TRUE(list.contains(2));
+    EXPECT_FALSE(list.contains(4));
+    // Numeric values compare across the integer and float
+    EXPECT_TRUE(list.contains(2.0));
+    EXPECT_FALSE(list.contains("2"));
+    EXPECT_FALSE(list.contains(Value::kNullValue));
+
+    list.emplace_back(4);
+    EXPECT_EQ(List::Kind::kInt, list.kind());
+    list.emplace_back("5");
+    EXPECT_EQ(List::Kind::kBoxed, list.kind());
+    EXPECT_TRUE(list.contains("5"));
+    EXPECT_TRUE(list.contains(4));
+  }
+  {
+    List list({"a", "b"});
+    list.setKind(List::Kind::kString);
+    EXPECT_TRUE(list.contains("a"));
+    EXPECT_FALSE(list.contains("c"));
+    EXPECT_FALSE(list.contains(1));
+
+    // The writable accessors drop the kind
+    List written = list;
+    written.setKind(List::Kind::kString);
+    written[0] = 1;
+    EXPECT_EQ(List::Kind::kBoxed, written.kind());
+    EXPECT_TRUE(written.contains(1));
+
+    // A copy starts boxed, so the values written directly are found
+    List copy = list;
+    EXPECT_EQ(List::Kind::kBoxed, copy.kind());
+    copy.values.emplace_back(1);
+    EXPECT_TRUE(copy.contains(1));
+    List assigned;
+    assigned = list;
+    EXPECT_EQ(List::Kind::kBoxed, assigned.kind());
+
+    // A move keeps it, and the list moved from is boxed
+    List moved = std::move(copy);
+    EXPECT_EQ(List::Kind::kBoxed, moved.kind());
+    List movedTyped = std::move(list);
+    EXPECT_EQ(List::Kind::kString, movedTyped.kind());
+    EXPECT_EQ(List::Kind::kBoxed, list.kind());  // NOLINT
+
+    // The values sharing the list keep it until any of them is written
+    Value shared(std::move(movedTyped));
+    Value other = shared;
+    EXPECT_EQ(List::Kind::kString, other.getList().kind());
+    other.mutableList().values.emplace_back(1);
+    EXPECT_EQ(List::Kind::kString, shared.getList().kind());
+    EXPECT_TRUE(other.getList().contains(1));
+    EXPECT_FALSE(shared.getList().contains(1));
+  }
+  {
+    List list({1.5, 2.5});
+    list.setKind(List::Kind::kFloat);
+    EXPECT_TRUE(list.contains(2.5));
+    EXPECT_FALSE(list.contains(3.5));
+    EXPECT_FALSE(list.contains(std::nan("")));
+
+    Value v(std::move(list));
+    EXPECT_EQ(List::Kind::kFloat, v.getList().kind());
+    v.mutableList().values.emplace_back("x");
+    EXPECT_EQ(List::Kind::kBoxed, v.getList().kind());
+    EXPECT_TRUE(v.getList().contains("x"));
+  }
+}
+
+TEST(Value, SetOperations) {
+  Set lhs = Set::createFromVector(std::vector<int64_t>{1, 2, 3, 4});
+  Set rhs = Set::createFromVector(std::vector<int64_t>{3, 4, 5});
+  EXPECT_EQ(Set::createFromVector(std::vector<int64_t>{3, 4}), Set::set_intersection(lhs, rhs));
+  EXPECT_EQ(Set::createFromVector(std::vector<int64_t>{1, 2, 3, 4, 5}),
+            Set::set_union(lhs, rhs));
+  EXPECT_EQ(Set::createFromVector(std::vector<int64_t>{1, 2}), Set::set_difference(lhs, rhs));
+  EXPECT_EQ(Set::createFromVector(std::vector<int64_t>{5}), Set::set_difference(rhs, lhs));
+  EXPECT_TRUE(Set::set_intersection(lhs, Set()).empty());
+
+  auto sortedLhs = lhs.toSortedVector();
+  auto sortedRhs = rhs.toSortedVector();
+  EXPECT_EQ((std::vector<Value>{1, 2, 3, 4}), sortedLhs);
+  EXPECT_EQ((std::vector<Value>{3, 4}), Set::sorted_intersection(sortedLhs, sortedRhs));
+  EXPECT_EQ((std::vector<Value>{1, 2, 3, 4, 5}), Set::sorted_union(sortedLhs, sortedRhs));
+  EXPECT_EQ((std::vector<Value>{1, 2}), Set::sorted_difference(sortedLhs, sortedRhs));
+  EXPECT_EQ(Set::set_union(lhs, rhs),
+            Set::fromSortedVector(Set::sorted_union(sortedLhs, sortedRhs)));
+
+  Set strs = Set::createFromVector(std::vector<std::string>{"b", "a", "c"});
+  EXPECT_EQ((std::vector<Value>{"a", "b", "c"}), strs.toSortedVector());
+}
+
+TEST(Value, SharedString) {
+  Value str(std::string(64, 'a'));
+  Value copy = str;
+  EXPECT_EQ(&str.getStr(), &copy.getStr());
+  // Copied before mutated
+  copy.mutableStr().append("b");
+  EXPECT_EQ(std::string(64, 'a'), str.getStr());
+  EXPECT_EQ(std::string(64, 'a') + "b", copy.getStr());
+
+  copy = str;
+  EXPECT_EQ(std::string(64, 'a'), copy.moveStr());
+  EXPECT_EQ(std::string(64, 'a'), str.getStr());
+  EXPECT_EQ(std::string(64, 'a'), str.moveStr());
+  EXPECT_TRUE(str.empty());
+
+  Value moved = Value("x");
+  Value to = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ("x", to.getStr());
+}
+
+TEST(Value, SharedContainer) {
+  Value list(List({1, 2, 3}));
+  Value copy = list;
+  EXPECT_EQ(list.getListPtr(), copy.getListPtr());
+  EXPECT_EQ(list, copy);
+  // Copied before mutated
+  copy.mutableList().emplace_back(4);
+  EXPECT_NE(list.getListPtr(), copy.getListPtr());
+  EXPECT_EQ(List({1, 2, 3}), list.getList());
+  EXPECT_EQ(List({1, 2, 3, 4}), copy.getList());
+
+  copy = list;
+  EXPECT_EQ(List({1, 2, 3}), copy.moveList());
+  EXPECT_EQ(List({1, 2, 3}), list.getList());
+  EXPECT_EQ(List({1, 2, 3}), list.moveList());
+  EXPECT_TRUE(list.empty());
+
+  Value set(Set(std::unordered_set<Value>{1, "a"}));
+  Value setCopy = set;
+  EXPECT_EQ(set.getSetPtr(), setCopy.getSetPtr());
+  setCopy.mutableSet().values.emplace(2);
+  EXPECT_EQ(2, set.getSet().size());
+  EXPECT_EQ(3, setCopy.getSet().size());
+
+  Value moved = std::move(setCopy);
+  EXPECT_TRUE(setCopy.empty());
+  EXPECT_EQ(3, moved.getSet().size());
+}
+
+TEST(Value, StringDictionary) {
+  auto make = [] {
+    DataSet ds({"str", "list", "set", "map", "vertex"});
+    for (int i = 0; i < 3; ++i) {
+      List list({"a", std::string(16, 'a')});
+      list.setKind(List::Kind::kString);
+      Vertex vertex("v", {Tag("tag", {{"prop", "b"}})});
+      ds.emplace_back(Row({"a",
+                           std::move(list),
+                           Set(std::unordered_set<Value>{"b", 1}),
+                           Map({{"key", "a"}}),
+                           std::move(vertex)}));
+    }
+    return ds;
+  };
+  StringDictionary dict(2, 8);
+  auto ds = make();
+  dict.intern(ds);
+  EXPECT_EQ(make(), ds);
+  // Only a and b are interned, the long one and v are out of the capacity
+  EXPECT_EQ(2, dict.size());
+
+  const auto& first = ds.rows[0].values;
+  const auto& a = first[0].getStr();
+  const auto& b = first[4].getVertex().tags[0].props.at("prop").getStr();
+  for (size_t i = 1; i < ds.rows.size(); ++i) {
+    const auto& row = ds.rows[i].values;
+    EXPECT_EQ(&a, &row[0].getStr());
+    const auto& list = row[1].getList();
+    EXPECT_EQ(List::Kind::kString, list.kind());
+    EXPECT_EQ(&a, &list.values[0].getStr());
+    EXPECT_NE(&first[1].getList().values[1].getStr(), &list.values[1].getStr());
+    EXPECT_EQ(&b, &row[2].getSet().values.find("b")->getStr());
+    EXPECT_EQ(&a, &row[3].getMap().kvs.at("key").getStr());
+    EXPECT_EQ(&b, &row[4].getVertex().tags[0].props.at("prop").getStr());
+    EXPECT_NE(&first[4].getVertex().vid.getStr(), &row[4].getVertex().vid.getStr());
+  }
+
+  // The values interned outlive the dictionary
+  Value interned("a");
+  {
+    StringDictionary other(1, 8);
+    other.intern(ds);
+    other.intern(interned);
+  }
+  EXPECT_EQ(&a, &interned.getStr());
+  EXPECT_EQ("a", interned.getStr());
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
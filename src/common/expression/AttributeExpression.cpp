@@ -39,7 +39,7 @@ const Value &AttributeExpression::eval(ExpressionContext &ctx) {
       if (iter == tags.end()) {
         return Value::kNullValue;
       }
-      result_.setMap(Map(iter->props));
+      result_.setMap(Map(iter->props.toMap()));
       return result_;
     }
     case Value::Type::EDGE: {
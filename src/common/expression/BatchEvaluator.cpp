@@ -0,0 +1,685 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/BatchEvaluator.h"
+
+#include <cmath>
+#include <functional>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ColumnExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/function/FunctionManager.h"
+
+namespace nebula {
+
+namespace {
+
+using Kind = Expression::Kind;
+using BatchColumnFn = std::function<size_t(const Expression*)>;
+
+// The unboxed values of an operand, whose step is 0 for a constant
+template <typename T>
+struct Elements {
+  const T* data;
+  size_t step;
+
+  const T& operator[](size_t i) const {
+    return data[i * step];
+  }
+};
+
+// A constant, or a column of the batch, or an evaluated column
+struct Operand {
+  bool isConstant{false};
+  Value constant;
+  const Column* ref{nullptr};
+  Column owned;
+  // The unboxed constant
+  uint8_t constBool{0};
+  int64_t constInt{0};
+  double constFloat{0.0};
+
+  static Operand ofConstant(Value value) {
+    Operand operand;
+    operand.isConstant = true;
+    operand.constant = std::move(value);
+    if (operand.constant.isBool()) {
+      operand.constBool = operand.constant.getBool();
+    } else if (operand.constant.isInt()) {
+      operand.constInt = operand.constant.getInt();
+    } else if (operand.constant.isFloat()) {
+      operand.constFloat = operand.constant.getFloat();
+    }
+    return operand;
+  }
+
+  static Operand ofColumn(const Column* column) {
+    Operand operand;
+    operand.ref = column;
+    return operand;
+  }
+
+  static Operand ofColumn(Column column) {
+    Operand operand;
+    operand.owned = std::move(column);
+    return operand;
+  }
+
+  const Column& column() const {
+    return ref != nullptr ? *ref : owned;
+  }
+
+  // The kind of the unboxed values, or kBoxed if they are not unboxed
+  Column::Kind kind() const {
+    if (isConstant) {
+      switch (constant.type()) {
+        case Value::Type::BOOL:
+          return Column::Kind::kBool;
+        case Value::Type::INT:
+          return Column::Kind::kInt;
+        case Value::Type::FLOAT:
+          return Column::Kind::kFloat;
+        case Value::Type::STRING:
+          return Column::Kind::kString;
+        default:
+          return Column::Kind::kBoxed;
+      }
+    }
+    auto kind = column().kind();
+    return kind == Column::Kind::kNull ? Column::Kind::kBoxed : kind;
+  }
+
+  bool hasNull() const {
+    return !isConstant && column().hasNull();
+  }
+
+  Value value(size_t i) const {
+    return isConstant ? constant : column().value(i);
+  }
+
+  Elements<uint8_t> bools() const {
+    return isConstant ? Elements<uint8_t>{&constBool, 0}
+                      : Elements<uint8_t>{column().bools().data(), 1};
+  }
+
+  Elements<int64_t> ints() const {
+    return isConstant ? Elements<int64_t>{&constInt, 0}
+                      : Elements<int64_t>{column().ints().data(), 1};
+  }
+
+  Elements<double> floats() const {
+    return isConstant ? Elements<double>{&constFloat, 0}
+                      : Elements<double>{column().floats().data(), 1};
+  }
+
+  Elements<std::string> strs() const {
+    return isConstant ? Elements<std::string>{&constant.getStr(), 0}
+                      : Elements<std::string>{column().strs().data(), 1};
+  }
+
+  // Merge the NULLs of the operand into the bitmap
+  void mergeNulls(std::vector<uint64_t>& nulls) const {
+    if (isConstant) {
+      return;
+    }
+    const auto& bitmap = column().nullBitmap();
+    for (size_t w = 0; w < bitmap.size() && w < nulls.size(); ++w) {
+      nulls[w] |= bitmap[w];
+    }
+  }
+
+  Column toColumn(size_t size) && {
+    if (isConstant) {
+      Column column;
+      for (size_t i = 0; i < size; ++i) {
+        column.append(constant);
+      }
+      return column;
+    }
+    return ref != nullptr ? *ref : std::move(owned);
+  }
+};
+
+bool isNullBit(const std::vector<uint64_t>& nulls, size_t i) {
+  return (nulls[i >> 6] >> (i & 63)) & 1;
+}
+
+// Apply op on the values element by element, the same as the row by row evaluation
+template <typename Op>
+Operand boxedBinary(const Operand& lhs, const Operand& rhs, size_t size, Op&& op) {
+  if (lhs.isConstant && rhs.isConstant) {
+    return Operand::ofConstant(op(lhs.constant, rhs.constant));
+  }
+  Column column;
+  for (size_t i = 0; i < size; ++i) {
+    column.append(op(lhs.value(i), rhs.value(i)));
+  }
+  return Operand::ofColumn(std::move(column));
+}
+
+template <typename Op>
+Operand boxedUnary(const Operand& operand, size_t size, Op&& op) {
+  if (operand.isConstant) {
+    return Operand::ofConstant(op(operand.constant));
+  }
+  Column column;
+  for (size_t i = 0; i < size; ++i) {
+    column.append(op(operand.value(i)));
+  }
+  return Operand::ofColumn(std::move(column));
+}
+
+Value relational(Kind kind, const Value& lhs, const Value& rhs) {
+  // The same as RelationalExpression::eval
+  switch (kind) {
+    case Kind::kRelEQ:
+      return lhs.equal(rhs);
+    case Kind::kRelNE:
+      return !lhs.equal(rhs);
+    case Kind::kRelLT:
+      return lhs.lessThan(rhs);
+    case Kind::kRelLE:
+      return lhs.lessThan(rhs) || lhs.equal(rhs);
+    case Kind::kRelGT:
+      return rhs.lessThan(lhs);
+    case Kind::kRelGE:
+      return rhs.lessThan(lhs) || lhs.equal(rhs);
+    default:
+      DLOG(FATAL) << "Unexpected relational kind: " << kind;
+      return Value::kNullBadType;
+  }
+}
+
+Value arithmetic(Kind kind, const Value& lhs, const Value& rhs) {
+  // The same as ArithmeticExpression::eval
+  switch (kind) {
+    case Kind::kAdd:
+      return lhs + rhs;
+    case Kind::kMinus:
+      return lhs - rhs;
+    case Kind::kMultiply:
+      return lhs * rhs;
+    case Kind::kDivision:
+      return lhs / rhs;
+    case Kind::kMod:
+      return lhs % rhs;
+    default:
+      DLOG(FATAL) << "Unexpected arithmetic kind: " << kind;
+      return Value::kNullBadType;
+  }
+}
+
+// The same as LogicalExpression::evalAnd and evalOr, where the values are the operands
+Value logicalAndOr(bool isAnd, const std::vector<Value>& values) {
+  Value result = isAnd;
+  for (const auto& value : values) {
+    if (value.isBadNull() || (value.isImplicitBool() && value.implicitBool() != isAnd)) {
+      return value;
+    }
+    if (!value.isImplicitBool()) {
+      if (value.isNull()) {
+        result = value;
+      } else if (value.empty() && !result.isNull()) {
+        result = value;
+      } else {
+        return Value::kNullBadType;
+      }
+    }
+  }
+  return result;
+}
+
+// The same as LogicalExpression::evalXor
+Value logicalXor(const std::vector<Value>& values) {
+  Value result;
+  bool hasEmpty = false;
+  bool firstBool = true;
+  for (const auto& value : values) {
+    if (value.isNull()) {
+      return value;
+    }
+    if (!value.isImplicitBool()) {
+      if (value.empty()) {
+        result = value;
+        hasEmpty = true;
+        continue;
+      }
+      return Value::kNullBadType;
+    }
+    if (hasEmpty) {
+      continue;
+    }
+    if (firstBool) {
+      result = static_cast<bool>(value.implicitBool());
+      firstBool = false;
+    } else {
+      result = static_cast<bool>(result.implicitBool() ^ value.implicitBool());
+    }
+  }
+  return result;
+}
+
+template <typename L, typename R, typename Eq, typename Lt>
+void compare(Kind kind, size_t size, L l, R r, Eq eq, Lt lt, std::vector<uint8_t>& out) {
+  switch (kind) {
+    case Kind::kRelEQ:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = eq(l[i], r[i]);
+      }
+      break;
+    case Kind::kRelNE:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = !eq(l[i], r[i]);
+      }
+      break;
+    case Kind::kRelLT:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = lt(l[i], r[i]);
+      }
+      break;
+    case Kind::kRelLE:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = lt(l[i], r[i]) || eq(l[i], r[i]);
+      }
+      break;
+    case Kind::kRelGT:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = lt(r[i], l[i]);
+      }
+      break;
+    case Kind::kRelGE:
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = lt(r[i], l[i]) || eq(l[i], r[i]);
+      }
+      break;
+    default:
+      DLOG(FATAL) << "Unexpected relational kind: " << kind;
+  }
+}
+
+// Compare the unboxed values, return false if they are not unboxed. A NULL compared to any value
+// is NULL, so the NULLs of the result are those of the operands.
+bool typedRelational(Kind kind, const Operand& lhs, const Operand& rhs, size_t size, Operand* res) {
+  auto exactEq = [](const auto& a, const auto& b) { return a == b; };
+  auto exactLt = [](const auto& a, const auto& b) { return a < b; };
+  // The numbers within kEpsilon are equal, the same as Value::equal and Value::lessThan
+  auto numericEq = [](auto a, auto b) { return std::abs(a - b) < kEpsilon; };
+  auto numericLt = [](auto a, auto b) { return std::abs(a - b) >= kEpsilon && a < b; };
+
+  std::vector<uint8_t> out(size);
+  auto lk = lhs.kind();
+  auto rk = rhs.kind();
+  if (lk == Column::Kind::kInt && rk == Column::Kind::kInt) {
+    compare(kind, size, lhs.ints(), rhs.ints(), exactEq, exactLt, out);
+  } else if (lk == Column::Kind::kInt && rk == Column::Kind::kFloat) {
+    compare(kind, size, lhs.ints(), rhs.floats(), numericEq, numericLt, out);
+  } else if (lk == Column::Kind::kFloat && rk == Column::Kind::kInt) {
+    compare(kind, size, lhs.floats(), rhs.ints(), numericEq, numericLt, out);
+  } else if (lk == Column::Kind::kFloat && rk == Column::Kind::kFloat) {
+    compare(kind, size, lhs.floats(), rhs.floats(), numericEq, numericLt, out);
+  } else if (lk == Column::Kind::kString && rk == Column::Kind::kString) {
+    compare(kind, size, lhs.strs(), rhs.strs(), exactEq, exactLt, out);
+  } else if (lk == Column::Kind::kBool && rk == Column::Kind::kBool) {
+    compare(kind, size, lhs.bools(), rhs.bools(), exactEq, exactLt, out);
+  } else {
+    return false;
+  }
+  std::vector<uint64_t> nulls((size + 63) >> 6, 0);
+  lhs.mergeNulls(nulls);
+  rhs.mergeNulls(nulls);
+  *res = Operand::ofColumn(Column::ofBools(std::move(out), std::move(nulls)));
+  return true;
+}
+
+template <typename L, typename R, typename T, typename Op>
+void compute(size_t size, L l, R r, Op op, std::vector<T>& out) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = op(l[i], r[i]);
+  }
+}
+
+template <typename L, typename R>
+void computeFloats(Kind kind, size_t size, L l, R r, std::vector<double>& out) {
+  switch (kind) {
+    case Kind::kAdd:
+      compute(size, l, r, [](double a, double b) { return a + b; }, out);
+      break;
+    case Kind::kMinus:
+      compute(size, l, r, [](double a, double b) { return a - b; }, out);
+      break;
+    default:
+      compute(size, l, r, [](double a, double b) { return a * b; }, out);
+      break;
+  }
+}
+
+// Compute +, - and * of the unboxed numbers, return false if they are not unboxed, or any integer
+// overflows, which is left to the Value operations to get the overflow error.
+bool typedArithmetic(Kind kind, const Operand& lhs, const Operand& rhs, size_t size, Operand* res) {
+  if (kind != Kind::kAdd && kind != Kind::kMinus && kind != Kind::kMultiply) {
+    return false;
+  }
+  auto lk = lhs.kind();
+  auto rk = rhs.kind();
+  auto isNumeric = [](Column::Kind k) {
+    return k == Column::Kind::kInt || k == Column::Kind::kFloat;
+  };
+  if (!isNumeric(lk) || !isNumeric(rk)) {
+    return false;
+  }
+  std::vector<uint64_t> nulls((size + 63) >> 6, 0);
+  lhs.mergeNulls(nulls);
+  rhs.mergeNulls(nulls);
+
+  if (lk == Column::Kind::kInt && rk == Column::Kind::kInt) {
+    std::vector<int64_t> out(size);
+    auto l = lhs.ints();
+    auto r = rhs.ints();
+    bool overflow = false;
+    for (size_t i = 0; i < size; ++i) {
+      bool o = false;
+      switch (kind) {
+        case Kind::kAdd:
+          o = __builtin_add_overflow(l[i], r[i], &out[i]);
+          break;
+        case Kind::kMinus:
+          o = __builtin_sub_overflow(l[i], r[i], &out[i]);
+          break;
+        default:
+          o = __builtin_mul_overflow(l[i], r[i], &out[i]);
+          break;
+      }
+      // The result of a NULL is NULL whatever it is
+      overflow |= o && !isNullBit(nulls, i);
+    }
+    if (overflow) {
+      return false;
+    }
+    *res = Operand::ofColumn(Column::ofInts(std::move(out), std::move(nulls)));
+    return true;
+  }
+
+  std::vector<double> out(size);
+  if (lk == Column::Kind::kInt) {
+    computeFloats(kind, size, lhs.ints(), rhs.floats(), out);
+  } else if (rk == Column::Kind::kInt) {
+    computeFloats(kind, size, lhs.floats(), rhs.ints(), out);
+  } else {
+    computeFloats(kind, size, lhs.floats(), rhs.floats(), out);
+  }
+  *res = Operand::ofColumn(Column::ofFloats(std::move(out), std::move(nulls)));
+  return true;
+}
+
+Operand evalOperand(const Expression* expr,
+                    const ColumnBatch& batch,
+                    const BatchColumnFn& batchColumn) {
+  auto size = batch.rowSize();
+  switch (expr->kind()) {
+    case Kind::kConstant:
+      return Operand::ofConstant(static_cast<const ConstantExpression*>(expr)->value());
+    case Kind::kInputProperty:
+    case Kind::kColumn:
+      return Operand::ofColumn(&batch.column(batchColumn(expr)));
+    case Kind::kRelEQ:
+    case Kind::kRelNE:
+    case Kind::kRelLT:
+    case Kind::kRelLE:
+    case Kind::kRelGT:
+    case Kind::kRelGE: {
+      auto* binary = static_cast<const BinaryExpression*>(expr);
+      auto lhs = evalOperand(binary->left(), batch, batchColumn);
+      auto rhs = evalOperand(binary->right(), batch, batchColumn);
+      Operand res;
+      bool allConstant = lhs.isConstant && rhs.isConstant;
+      if (!allConstant && typedRelational(expr->kind(), lhs, rhs, size, &res)) {
+        return res;
+      }
+      return boxedBinary(lhs, rhs, size, [kind = expr->kind()](const Value& l, const Value& r) {
+        return relational(kind, l, r);
+      });
+    }
+    case Kind::kAdd:
+    case Kind::kMinus:
+    case Kind::kMultiply:
+    case Kind::kDivision:
+    case Kind::kMod: {
+      auto* binary = static_cast<const BinaryExpression*>(expr);
+      auto lhs = evalOperand(binary->left(), batch, batchColumn);
+      auto rhs = evalOperand(binary->right(), batch, batchColumn);
+      Operand res;
+      bool allConstant = lhs.isConstant && rhs.isConstant;
+      if (!allConstant && typedArithmetic(expr->kind(), lhs, rhs, size, &res)) {
+        return res;
+      }
+      return boxedBinary(lhs, rhs, size, [kind = expr->kind()](const Value& l, const Value& r) {
+        return arithmetic(kind, l, r);
+      });
+    }
+    case Kind::kLogicalAnd:
+    case Kind::kLogicalOr:
+    case Kind::kLogicalXor: {
+      auto kind = expr->kind();
+      std::vector<Operand> operands;
+      bool allConstant = true;
+      bool allBools = true;
+      for (auto* operand : static_cast<const LogicalExpression*>(expr)->operands()) {
+        operands.emplace_back(evalOperand(operand, batch, batchColumn));
+        allConstant = allConstant && operands.back().isConstant;
+        allBools = allBools && operands.back().kind() == Column::Kind::kBool &&
+                   !operands.back().hasNull();
+      }
+      if (allBools && !allConstant) {
+        // Without NULLs, the logical expressions are the bool operations of all the operands
+        std::vector<uint8_t> out(size, kind == Kind::kLogicalAnd ? 1 : 0);
+        for (const auto& operand : operands) {
+          auto bools = operand.bools();
+          for (size_t i = 0; i < size; ++i) {
+            if (kind == Kind::kLogicalAnd) {
+              out[i] &= bools[i];
+            } else if (kind == Kind::kLogicalOr) {
+              out[i] |= bools[i];
+            } else {
+              out[i] ^= bools[i];
+            }
+          }
+        }
+        return Operand::ofColumn(Column::ofBools(std::move(out), {}));
+      }
+      auto fold = [kind](const std::vector<Value>& values) {
+        return kind == Kind::kLogicalXor ? logicalXor(values)
+                                         : logicalAndOr(kind == Kind::kLogicalAnd, values);
+      };
+      std::vector<Value> values(operands.size());
+      if (allConstant) {
+        for (size_t j = 0; j < operands.size(); ++j) {
+          values[j] = operands[j].constant;
+        }
+        return Operand::ofConstant(fold(values));
+      }
+      Column column;
+      for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < operands.size(); ++j) {
+          values[j] = operands[j].value(i);
+        }
+        column.append(fold(values));
+      }
+      return Operand::ofColumn(std::move(column));
+    }
+    case Kind::kUnaryPlus:
+      return evalOperand(static_cast<const UnaryExpression*>(expr)->operand(), batch, batchColumn);
+    case Kind::kUnaryNegate: {
+      auto operand =
+          evalOperand(static_cast<const UnaryExpression*>(expr)->operand(), batch, batchColumn);
+      return boxedUnary(operand, size, [](const Value& v) { return -v; });
+    }
+    case Kind::kUnaryNot: {
+      auto operand =
+          evalOperand(static_cast<const UnaryExpression*>(expr)->operand(), batch, batchColumn);
+      if (!operand.isConstant && operand.kind() == Column::Kind::kBool) {
+        // The NOT of NULL is NULL
+        auto bools = operand.bools();
+        std::vector<uint8_t> out(size);
+        for (size_t i = 0; i < size; ++i) {
+          out[i] = !bools[i];
+        }
+        return Operand::ofColumn(Column::ofBools(std::move(out), operand.column().nullBitmap()));
+      }
+      return boxedUnary(operand, size, [](const Value& v) { return !v; });
+    }
+    case Kind::kIsNull:
+    case Kind::kIsNotNull: {
+      bool isNull = expr->kind() == Kind::kIsNull;
+      auto operand =
+          evalOperand(static_cast<const UnaryExpression*>(expr)->operand(), batch, batchColumn);
+      if (operand.isConstant) {
+        return Operand::ofConstant(operand.constant.isNull() == isNull);
+      }
+      const auto& column = operand.column();
+      std::vector<uint8_t> out(size);
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = column.isNull(i) == isNull;
+      }
+      return Operand::ofColumn(Column::ofBools(std::move(out), {}));
+    }
+    case Kind::kFunctionCall: {
+      // Only the functions with a batch body are accepted, e.g. the batch UDFs
+      auto* call = static_cast<const FunctionCallExpression*>(expr);
+      const auto& args = call->args()->args();
+      std::vector<Operand> operands;
+      operands.reserve(args.size());
+      for (auto* arg : args) {
+        auto operand = evalOperand(arg, batch, batchColumn);
+        if (operand.isConstant) {
+          operand = Operand::ofColumn(std::move(operand).toColumn(size));
+        }
+        operands.emplace_back(std::move(operand));
+      }
+      std::vector<const Column*> columns;
+      columns.reserve(operands.size());
+      for (const auto& operand : operands) {
+        columns.emplace_back(&operand.column());
+      }
+      auto body = FunctionManager::getBatchBody(call->name(), args.size());
+      auto result = body != nullptr ? body(columns, size) : Column();
+      if (result.size() != size) {
+        Column bad;
+        for (size_t i = 0; i < size; ++i) {
+          bad.append(Value::kNullBadData);
+        }
+        return Operand::ofColumn(std::move(bad));
+      }
+      return Operand::ofColumn(std::move(result));
+    }
+    default:
+      DLOG(FATAL) << "Unexpected expression in batch: " << expr->toString();
+      return Operand::ofConstant(Value::kNullBadType);
+  }
+}
+
+}  // namespace
+
+bool BatchEvaluator::accept(const Expression* expr) {
+  std::vector<size_t> cols;
+  if (!collect(expr, &cols)) {
+    return false;
+  }
+  for (auto col : cols) {
+    if (batchCols_.emplace(col, inputCols_.size()).second) {
+      inputCols_.emplace_back(col);
+    }
+  }
+  return true;
+}
+
+Column BatchEvaluator::eval(const Expression* expr, const ColumnBatch& batch) const {
+  DCHECK_EQ(batch.colSize(), inputCols_.size());
+  auto batchColumn = [this](const Expression* e) { return batchCols_.at(resolve(e)); };
+  return evalOperand(expr, batch, batchColumn).toColumn(batch.rowSize());
+}
+
+int64_t BatchEvaluator::resolve(const Expression* expr) const {
+  if (expr->kind() == Expression::Kind::kInputProperty) {
+    auto found = colIndices_.find(static_cast<const InputPropertyExpression*>(expr)->prop());
+    return found == colIndices_.end() ? -1 : static_cast<int64_t>(found->second);
+  }
+  DCHECK(expr->kind() == Expression::Kind::kColumn);
+  // The same as Iterator::getColumnByIndex
+  int64_t index = static_cast<const ColumnExpression*>(expr)->index();
+  auto size = static_cast<int64_t>(colSize_);
+  if (size == 0 || (index > 0 && index >= size) || (index < 0 && -index > size)) {
+    return -1;
+  }
+  return (size + index) % size;
+}
+
+bool BatchEvaluator::collect(const Expression* expr, std::vector<size_t>* cols) const {
+  switch (expr->kind()) {
+    case Kind::kConstant:
+      return true;
+    case Kind::kInputProperty:
+    case Kind::kColumn: {
+      auto col = resolve(expr);
+      if (col < 0) {
+        return false;
+      }
+      cols->emplace_back(col);
+      return true;
+    }
+    case Kind::kRelEQ:
+    case Kind::kRelNE:
+    case Kind::kRelLT:
+    case Kind::kRelLE:
+    case Kind::kRelGT:
+    case Kind::kRelGE:
+    case Kind::kAdd:
+    case Kind::kMinus:
+    case Kind::kMultiply:
+    case Kind::kDivision:
+    case Kind::kMod: {
+      auto* binary = static_cast<const BinaryExpression*>(expr);
+      return collect(binary->left(), cols) && collect(binary->right(), cols);
+    }
+    case Kind::kLogicalAnd:
+    case Kind::kLogicalOr:
+    case Kind::kLogicalXor: {
+      for (auto* operand : static_cast<const LogicalExpression*>(expr)->operands()) {
+        if (!collect(operand, cols)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Kind::kUnaryPlus:
+    case Kind::kUnaryNegate:
+    case Kind::kUnaryNot:
+    case Kind::kIsNull:
+    case Kind::kIsNotNull:
+      return collect(static_cast<const UnaryExpression*>(expr)->operand(), cols);
+    case Kind::kFunctionCall: {
+      auto* call = static_cast<const FunctionCallExpression*>(expr);
+      const auto& args = call->args()->args();
+      if (FunctionManager::getBatchBody(call->name(), args.size()) == nullptr) {
+        return false;
+      }
+      for (auto* arg : args) {
+        if (!collect(arg, cols)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace nebula
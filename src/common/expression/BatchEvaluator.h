@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_EXPRESSION_BATCHEVALUATOR_H_
+#define COMMON_EXPRESSION_BATCHEVALUATOR_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/datatypes/ColumnBatch.h"
+#include "common/expression/Expression.h"
+
+namespace nebula {
+
+// Evaluate an expression over all the rows of a ColumnBatch into a column at once, instead of
+// calling Expression::eval row by row. The constants, the input properties, the column
+// expressions, and the relational, arithmetic, logical and some unary expressions over them are
+// supported, as well as the calls of the functions evaluating in batch, e.g. the batch UDFs. The
+// results are the same as evaluating the expression on each row: the unboxed columns of the common
+// types are computed in tight loops, and the others fall back to the operations of Value element
+// by element.
+//
+// Usage:
+//   BatchEvaluator evaluator(colIndices, colSize);
+//   if (evaluator.accept(expr)) {
+//     auto batch = ColumnBatch::fromRows(colNames, rows, begin, end, evaluator.inputColumns());
+//     auto column = evaluator.eval(expr, batch);
+//   }
+class BatchEvaluator final {
+ public:
+  // The input rows have colSize columns, whose indices by name are in colIndices
+  BatchEvaluator(const std::unordered_map<std::string, size_t>& colIndices, size_t colSize)
+      : colIndices_(colIndices), colSize_(colSize) {}
+
+  // Whether expr could be evaluated in batch. The input columns it reads are recorded if so.
+  bool accept(const Expression* expr);
+
+  // The input columns read by the accepted expressions, which are the columns of the batch
+  const std::vector<size_t>& inputColumns() const {
+    return inputCols_;
+  }
+
+  // Evaluate an accepted expression over the batch of inputColumns()
+  Column eval(const Expression* expr, const ColumnBatch& batch) const;
+
+ private:
+  // The input column read by a property or column expression, or -1 if it can't be resolved
+  int64_t resolve(const Expression* expr) const;
+
+  bool collect(const Expression* expr, std::vector<size_t>* cols) const;
+
+  const std::unordered_map<std::string, size_t>& colIndices_;
+  size_t colSize_;
+  std::vector<size_t> inputCols_;
+  // The position in the batch of each input column
+  std::unordered_map<size_t, size_t> batchCols_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_EXPRESSION_BATCHEVALUATOR_H_
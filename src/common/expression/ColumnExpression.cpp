@@ -10,8 +10,7 @@
 namespace nebula {
 
 const Value &ColumnExpression::eval(ExpressionContext &ctx) {
-  result_ = ctx.getColumn(index_);
-  return result_;
+  return ctx.getColumn(index_);
 }
 
 bool ColumnExpression::operator==(const Expression &expr) const {
@@ -25,6 +25,10 @@ class ColumnExpression final : public Expression {
 
   const Value& eval(ExpressionContext& ctx) override;
 
+  int32_t index() const {
+    return index_;
+  }
+
   void accept(ExprVisitor* visitor) override;
 
   Expression* clone() const override {
@@ -45,7 +49,6 @@ class ColumnExpression final : public Expression {
   void resetFrom(Decoder&) override;
 
  private:
-  Value result_;
   int32_t index_;
 };
 
@@ -0,0 +1,548 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/CompiledExpression.h"
+
+#include <optional>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/SubscriptExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/geo/GeoFunction.h"
+
+namespace nebula {
+
+namespace {
+
+using Kind = Expression::Kind;
+using EvalFn = CompiledExpression::EvalFn;
+using CollectionOp = ExpressionContext::CollectionOp;
+
+bool isProperty(const Expression* expr) {
+  auto kind = expr->kind();
+  return kind == Kind::kEdgeProperty || kind == Kind::kTagProperty || kind == Kind::kSrcProperty;
+}
+
+Value relation(Kind kind, const Value& lhs, const Value& rhs) {
+  switch (kind) {
+    case Kind::kRelEQ:
+      return lhs.equal(rhs);
+    case Kind::kRelNE:
+      return !lhs.equal(rhs);
+    case Kind::kRelLT:
+      return lhs.lessThan(rhs);
+    case Kind::kRelLE:
+      return lhs.lessThan(rhs) || lhs.equal(rhs);
+    case Kind::kRelGT:
+      return rhs.lessThan(lhs);
+    case Kind::kRelGE:
+      return rhs.lessThan(lhs) || lhs.equal(rhs);
+    default:
+      DLOG(FATAL) << "Illegal kind for comparison: " << kind;
+      return Value::kNullBadType;
+  }
+}
+
+bool isTyped(const Value& val, const int64_t*) {
+  return val.isInt();
+}
+
+bool isTyped(const Value& val, const std::string*) {
+  return val.isStr();
+}
+
+int64_t typed(const Value& val, const int64_t*) {
+  return val.getInt();
+}
+
+const std::string& typed(const Value& val, const std::string*) {
+  return val.getStr();
+}
+
+// Compare the operand with constant c of type T, by Cmp if the operand is of T too
+template <typename Cmp, typename T>
+EvalFn compareTyped(Kind kind, EvalFn operand, Value c, bool constLeft) {
+  return [kind, operand = std::move(operand), c = std::move(c), constLeft, result = Value()](
+             ExpressionContext& ctx) mutable -> const Value& {
+    const auto& val = operand(ctx);
+    const T* type = nullptr;
+    if (LIKELY(isTyped(val, type))) {
+      result = constLeft ? Cmp()(typed(c, type), typed(val, type))
+                         : Cmp()(typed(val, type), typed(c, type));
+    } else {
+      result = constLeft ? relation(kind, c, val) : relation(kind, val, c);
+    }
+    return result;
+  };
+}
+
+template <typename T>
+EvalFn compare(Kind kind, EvalFn operand, Value c, bool constLeft) {
+  switch (kind) {
+    case Kind::kRelEQ:
+      return compareTyped<std::equal_to<T>, T>(kind, std::move(operand), std::move(c), constLeft);
+    case Kind::kRelNE:
+      return compareTyped<std::not_equal_to<T>, T>(
+          kind, std::move(operand), std::move(c), constLeft);
+    case Kind::kRelLT:
+      return compareTyped<std::less<T>, T>(kind, std::move(operand), std::move(c), constLeft);
+    case Kind::kRelLE:
+      return compareTyped<std::less_equal<T>, T>(kind, std::move(operand), std::move(c), constLeft);
+    case Kind::kRelGT:
+      return compareTyped<std::greater<T>, T>(kind, std::move(operand), std::move(c), constLeft);
+    default:
+      return compareTyped<std::greater_equal<T>, T>(
+          kind, std::move(operand), std::move(c), constLeft);
+  }
+}
+
+// Compare the string property with constant c by Cmp on the bytes borrowed from the context, or
+// by fallback if the context doesn't lend it
+template <typename Cmp>
+EvalFn compareStringPropTyped(const PropertyExpression* prop,
+                              EvalFn fallback,
+                              std::string c,
+                              bool constLeft) {
+  return [isEdge = prop->kind() == Kind::kEdgeProperty,
+          sym = prop->sym(),
+          prop = prop->prop(),
+          fallback = std::move(fallback),
+          c = std::move(c),
+          constLeft,
+          result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+    folly::StringPiece view;
+    if (!ctx.getStringPropView(isEdge, sym, prop, view)) {
+      return fallback(ctx);
+    }
+    folly::StringPiece constant(c);
+    result = constLeft ? Cmp()(constant, view) : Cmp()(view, constant);
+    return result;
+  };
+}
+
+EvalFn compareStringProp(
+    Kind kind, const PropertyExpression* prop, EvalFn fallback, std::string c, bool constLeft) {
+  using Piece = folly::StringPiece;
+  switch (kind) {
+    case Kind::kRelEQ:
+      return compareStringPropTyped<std::equal_to<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+    case Kind::kRelNE:
+      return compareStringPropTyped<std::not_equal_to<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+    case Kind::kRelLT:
+      return compareStringPropTyped<std::less<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+    case Kind::kRelLE:
+      return compareStringPropTyped<std::less_equal<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+    case Kind::kRelGT:
+      return compareStringPropTyped<std::greater<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+    default:
+      return compareStringPropTyped<std::greater_equal<Piece>>(
+          prop, std::move(fallback), std::move(c), constLeft);
+  }
+}
+
+// The same as LogicalExpression::evalAnd and evalOr, the operands are short circuited by isAnd
+EvalFn andOr(std::vector<EvalFn> operands, bool isAnd) {
+  return [operands = std::move(operands), isAnd, result = Value()](
+             ExpressionContext& ctx) mutable -> const Value& {
+    result = isAnd;
+    for (auto& operand : operands) {
+      const auto& value = operand(ctx);
+      if (value.isBadNull() || (value.isImplicitBool() && value.implicitBool() != isAnd)) {
+        result = value;
+        return result;
+      }
+      if (!value.isImplicitBool()) {
+        if (value.isNull()) {
+          result = value;
+        } else if (value.empty() && !result.isNull()) {
+          result = value;
+        } else {
+          result = Value::kNullBadType;
+          return result;
+        }
+      }
+    }
+    return result;
+  };
+}
+
+// The same as LogicalExpression::evalXor
+EvalFn exclusiveOr(std::vector<EvalFn> operands) {
+  return [operands = std::move(operands), result = Value()](
+             ExpressionContext& ctx) mutable -> const Value& {
+    bool hasEmpty = false;
+    bool firstBool = true;
+    for (auto& operand : operands) {
+      const auto& value = operand(ctx);
+      if (value.isNull()) {
+        result = value;
+        return result;
+      }
+      if (!value.isImplicitBool()) {
+        if (value.empty()) {
+          result = value;
+          hasEmpty = true;
+          continue;
+        }
+        result = Value::kNullBadType;
+        return result;
+      }
+      if (hasEmpty) {
+        continue;
+      }
+      if (firstBool) {
+        result = static_cast<bool>(value.implicitBool());
+        firstBool = false;
+      } else {
+        result = static_cast<bool>(result.implicitBool() ^ value.implicitBool());
+      }
+    }
+    return result;
+  };
+}
+
+}  // namespace
+
+/*static*/ CompiledExpression CompiledExpression::compile(const Expression* expr) {
+  CompiledExpression compiled;
+  compiled.eval_ = compiled.compileExpr(expr);
+  return compiled;
+}
+
+CompiledExpression::EvalFn CompiledExpression::compileExpr(const Expression* expr) {
+  switch (expr->kind()) {
+    case Kind::kConstant: {
+      return [val = static_cast<const ConstantExpression*>(expr)->value()](
+                 ExpressionContext&) -> const Value& { return val; };
+    }
+    case Kind::kInputProperty:
+    case Kind::kVarProperty: {
+      auto* prop = static_cast<const PropertyExpression*>(expr);
+      return [isInput = expr->kind() == Kind::kInputProperty,
+              sym = prop->sym(),
+              prop = prop->prop(),
+              index = std::optional<size_t>()](ExpressionContext& ctx) mutable -> const Value& {
+        if (UNLIKELY(!index.has_value())) {
+          auto found = isInput ? ctx.getInputPropIndex(prop) : ctx.getVarPropIndex(sym, prop);
+          if (!found.ok()) {
+            return Value::kEmpty;
+          }
+          index = found.value();
+        }
+        return ctx.getColumn(index.value());
+      };
+    }
+    case Kind::kTagProperty:
+    case Kind::kSrcProperty: {
+      auto* prop = static_cast<const PropertyExpression*>(expr);
+      return [isSrc = expr->kind() == Kind::kSrcProperty,
+              sym = prop->sym(),
+              prop = prop->prop(),
+              result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+        result = isSrc ? ctx.getSrcProp(sym, prop) : ctx.getTagProp(sym, prop);
+        return result;
+      };
+    }
+    case Kind::kDstProperty: {
+      auto* prop = static_cast<const PropertyExpression*>(expr);
+      return [sym = prop->sym(), prop = prop->prop()](ExpressionContext& ctx) -> const Value& {
+        return ctx.getDstProp(sym, prop);
+      };
+    }
+    case Kind::kEdgeProperty:
+    case Kind::kEdgeSrc:
+    case Kind::kEdgeType:
+    case Kind::kEdgeRank:
+    case Kind::kEdgeDst: {
+      auto* prop = static_cast<const PropertyExpression*>(expr);
+      return [sym = prop->sym(), prop = prop->prop(), result = Value()](
+                 ExpressionContext& ctx) mutable -> const Value& {
+        result = ctx.getEdgeProp(sym, prop);
+        return result;
+      };
+    }
+    case Kind::kRelEQ:
+    case Kind::kRelNE:
+    case Kind::kRelLT:
+    case Kind::kRelLE:
+    case Kind::kRelGT:
+    case Kind::kRelGE: {
+      return compileRelational(expr);
+    }
+    case Kind::kRelIn:
+    case Kind::kRelNotIn: {
+      auto* rel = static_cast<const RelationalExpression*>(expr);
+      if (isProperty(rel->right()) && rel->left()->kind() == Kind::kConstant) {
+        return compileCollection(expr, rel->right(), CollectionOp::kContains, rel->left());
+      }
+      return interpret(expr);
+    }
+    case Kind::kFunctionCall: {
+      auto* func = static_cast<const FunctionCallExpression*>(expr);
+      const auto& args = func->args()->args();
+      if (args.size() == 1 && isProperty(args[0]) &&
+          folly::StringPiece(func->name()).equals("size", folly::AsciiCaseInsensitive())) {
+        return compileCollection(expr, args[0], CollectionOp::kSize, nullptr);
+      }
+      auto geography = compileGeography(expr);
+      if (geography != nullptr) {
+        return geography;
+      }
+      return interpret(expr);
+    }
+    case Kind::kSubscript: {
+      auto* sub = static_cast<const SubscriptExpression*>(expr);
+      if (isProperty(sub->left()) && sub->right()->kind() == Kind::kConstant) {
+        return compileCollection(expr, sub->left(), CollectionOp::kAt, sub->right());
+      }
+      return interpret(expr);
+    }
+    case Kind::kAdd:
+    case Kind::kMinus:
+    case Kind::kMultiply:
+    case Kind::kDivision:
+    case Kind::kMod: {
+      auto* arith = static_cast<const ArithmeticExpression*>(expr);
+      return [kind = expr->kind(),
+              lhs = compileExpr(arith->left()),
+              rhs = compileExpr(arith->right()),
+              result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+        const auto& l = lhs(ctx);
+        const auto& r = rhs(ctx);
+        switch (kind) {
+          case Kind::kAdd:
+            result = l + r;
+            break;
+          case Kind::kMinus:
+            result = l - r;
+            break;
+          case Kind::kMultiply:
+            result = l * r;
+            break;
+          case Kind::kDivision:
+            result = l / r;
+            break;
+          default:
+            result = l % r;
+            break;
+        }
+        return result;
+      };
+    }
+    case Kind::kLogicalAnd:
+    case Kind::kLogicalOr:
+    case Kind::kLogicalXor: {
+      std::vector<EvalFn> operands;
+      for (auto* operand : static_cast<const LogicalExpression*>(expr)->operands()) {
+        operands.emplace_back(compileExpr(operand));
+      }
+      if (expr->kind() == Kind::kLogicalXor) {
+        return exclusiveOr(std::move(operands));
+      }
+      return andOr(std::move(operands), expr->kind() == Kind::kLogicalAnd);
+    }
+    case Kind::kUnaryPlus:
+    case Kind::kUnaryNegate:
+    case Kind::kUnaryNot:
+    case Kind::kIsNull:
+    case Kind::kIsNotNull:
+    case Kind::kIsEmpty:
+    case Kind::kIsNotEmpty: {
+      return [kind = expr->kind(),
+              operand = compileExpr(static_cast<const UnaryExpression*>(expr)->operand()),
+              result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+        const auto& val = operand(ctx);
+        switch (kind) {
+          case Kind::kUnaryPlus:
+            result = val;
+            break;
+          case Kind::kUnaryNegate:
+            result = -val;
+            break;
+          case Kind::kUnaryNot:
+            result = !val;
+            break;
+          case Kind::kIsNull:
+            result = val.isNull();
+            break;
+          case Kind::kIsNotNull:
+            result = !val.isNull();
+            break;
+          case Kind::kIsEmpty:
+            result = val.empty();
+            break;
+          default:
+            result = !val.empty();
+            break;
+        }
+        return result;
+      };
+    }
+    default:
+      return interpret(expr);
+  }
+}
+
+CompiledExpression::EvalFn CompiledExpression::compileRelational(const Expression* expr) {
+  auto* rel = static_cast<const RelationalExpression*>(expr);
+  auto kind = expr->kind();
+  const Expression* lhs = rel->left();
+  const Expression* rhs = rel->right();
+  bool constLeft = lhs->kind() == Kind::kConstant;
+  if (constLeft != (rhs->kind() == Kind::kConstant)) {
+    auto* operand = constLeft ? rhs : lhs;
+    const auto& c = static_cast<const ConstantExpression*>(constLeft ? lhs : rhs)->value();
+    if (c.isInt()) {
+      return compare<int64_t>(kind, compileExpr(operand), c, constLeft);
+    }
+    if (c.isStr()) {
+      auto compiled = compare<std::string>(kind, compileExpr(operand), c, constLeft);
+      if (isProperty(operand)) {
+        // The string property is compared without being copied if the context lends it
+        return compareStringProp(kind,
+                                 static_cast<const PropertyExpression*>(operand),
+                                 std::move(compiled),
+                                 c.getStr(),
+                                 constLeft);
+      }
+      return compiled;
+    }
+  }
+  return [kind, lhs = compileExpr(lhs), rhs = compileExpr(rhs), result = Value()](
+             ExpressionContext& ctx) mutable -> const Value& {
+    const auto& l = lhs(ctx);
+    const auto& r = rhs(ctx);
+    result = relation(kind, l, r);
+    return result;
+  };
+}
+
+CompiledExpression::EvalFn CompiledExpression::compileCollection(const Expression* expr,
+                                                                const Expression* collection,
+                                                                CollectionOp op,
+                                                                const Expression* operand) {
+  auto* prop = static_cast<const PropertyExpression*>(collection);
+  return [isEdge = collection->kind() == Kind::kEdgeProperty,
+          negate = expr->kind() == Kind::kRelNotIn,
+          sym = prop->sym(),
+          prop = prop->prop(),
+          op,
+          operand = operand == nullptr
+                        ? Value::kEmpty
+                        : static_cast<const ConstantExpression*>(operand)->value(),
+          clone = expr->clone(),
+          result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+    if (!ctx.evalCollectionProp(isEdge, sym, prop, op, operand, result)) {
+      // Not supported by the context, e.g. the collection is NULL, read it as usual
+      return clone->eval(ctx);
+    }
+    if (negate && result.isBool()) {
+      result = !result.getBool();
+    }
+    return result;
+  };
+}
+
+CompiledExpression::EvalFn CompiledExpression::compileGeography(const Expression* expr) {
+  enum class Func { kIntersects, kCovers, kCoveredBy, kDWithin, kDistance };
+  static const std::unordered_map<std::string, std::pair<Func, size_t>> kFuncs = {
+      {"st_intersects", {Func::kIntersects, 2}},
+      {"st_covers", {Func::kCovers, 2}},
+      {"st_coveredby", {Func::kCoveredBy, 2}},
+      {"st_dwithin", {Func::kDWithin, 3}},
+      {"st_distance", {Func::kDistance, 2}},
+  };
+  auto* call = static_cast<const FunctionCallExpression*>(expr);
+  auto found = kFuncs.find(folly::toLowerAscii(call->name()));
+  const auto& args = call->args()->args();
+  if (found == kFuncs.end() || args.size() < found->second.second ||
+      args.size() > (found->second.first == Func::kDWithin ? 4 : 2)) {
+    return nullptr;
+  }
+  auto isGeography = [](const Expression* arg) {
+    return arg->kind() == Kind::kConstant &&
+           static_cast<const ConstantExpression*>(arg)->value().isGeography();
+  };
+  // The geographies of two constants are folded when planned
+  bool constLeft = isGeography(args[0]);
+  if (constLeft == isGeography(args[1])) {
+    return nullptr;
+  }
+  const auto& constant = static_cast<const ConstantExpression*>(args[constLeft ? 0 : 1])->value();
+  auto prepared = std::make_shared<geo::PreparedGeography>(constant.getGeography());
+  std::vector<EvalFn> operands;
+  for (auto* arg : args) {
+    operands.emplace_back(compileExpr(arg));
+  }
+  // The same checks as the bodies of the functions in FunctionManager
+  return [func = found->second.first,
+          operands = std::move(operands),
+          prepared = std::move(prepared),
+          constLeft,
+          result = Value()](ExpressionContext& ctx) mutable -> const Value& {
+    const auto& other = operands[constLeft ? 1 : 0](ctx);
+    if (!other.isGeography()) {
+      result = Value::kNullBadType;
+      return result;
+    }
+    geo::PreparedGeography row(other.getGeography());
+    const auto& a = constLeft ? *prepared : row;
+    const auto& b = constLeft ? row : *prepared;
+    switch (func) {
+      case Func::kIntersects:
+        result = geo::GeoFunction::intersects(a, b);
+        break;
+      case Func::kCovers:
+        result = geo::GeoFunction::covers(a, b);
+        break;
+      case Func::kCoveredBy:
+        result = geo::GeoFunction::covers(b, a);
+        break;
+      case Func::kDistance:
+        result = geo::GeoFunction::distance(a, b);
+        break;
+      case Func::kDWithin: {
+        const auto& distance = operands[2](ctx);
+        if (!distance.isNumeric()) {
+          result = Value::kNullBadType;
+          return result;
+        }
+        bool exclusive = false;
+        if (operands.size() == 4) {
+          const auto& flag = operands[3](ctx);
+          if (!flag.isBool()) {
+            result = Value::kNullBadType;
+            return result;
+          }
+          exclusive = flag.getBool();
+        }
+        result = geo::GeoFunction::dWithin(
+            a, b, distance.isFloat() ? distance.getFloat() : distance.getInt(), exclusive);
+        break;
+      }
+    }
+    return result;
+  };
+}
+
+CompiledExpression::EvalFn CompiledExpression::interpret(const Expression* expr) {
+  ++interpreted_;
+  // The clone keeps its own results and caches, the same as the expressions of each job
+  return [clone = expr->clone()](ExpressionContext& ctx) -> const Value& {
+    return clone->eval(ctx);
+  };
+}
+
+}  // namespace nebula
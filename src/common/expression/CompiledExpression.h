@@ -0,0 +1,77 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_EXPRESSION_COMPILEDEXPRESSION_H_
+#define COMMON_EXPRESSION_COMPILEDEXPRESSION_H_
+
+#include <functional>
+
+#include "common/context/ExpressionContext.h"
+#include "common/expression/Expression.h"
+
+namespace nebula {
+
+// An expression compiled into a tree of closures, evaluated row by row like Expression::eval but
+// without walking the expression tree for each row. The properties read are bound when compiled,
+// the column of an input property is resolved on the first row, and the comparisons with an
+// integer or string constant are specialized for the type, falling back to the operations of
+// Value for the values of the other types. The constants, the properties, the relational,
+// arithmetic, logical and some unary expressions are compiled, the others are evaluated by a clone
+// of themselves, so the results are always the same as Expression::eval. The size of a collection
+// property, and the IN and subscript of it by a constant, are evaluated by the context in place if
+// it can, e.g. on the encoded row in storage, and so is a string property compared with a string
+// constant, on the bytes borrowed from the row. The geography predicates and measures, e.g.
+// ST_Intersects, of a constant geography prepare its S2 shape once for all the rows.
+//
+// It's not thread safe, compile one for each thread evaluating the expression.
+//
+// Usage:
+//   auto compiled = CompiledExpression::compile(expr);
+//   for (; iter->valid(); iter->next()) {
+//     auto& val = compiled.eval(ctx(iter.get()));
+//   }
+class CompiledExpression final {
+ public:
+  using EvalFn = std::function<const Value&(ExpressionContext&)>;
+
+  // Compile expr, which must outlive the compiled one
+  static CompiledExpression compile(const Expression* expr);
+
+  const Value& eval(ExpressionContext& ctx) const {
+    return eval_(ctx);
+  }
+
+  // The number of subexpressions left to the interpreter
+  size_t interpreted() const {
+    return interpreted_;
+  }
+
+ private:
+  CompiledExpression() = default;
+
+  EvalFn compileExpr(const Expression* expr);
+
+  EvalFn compileRelational(const Expression* expr);
+
+  // Compile the size, IN or subscript expr of a collection property with the constant operand,
+  // which is evaluated by ExpressionContext::evalCollectionProp if the context supports it, or by a
+  // clone of expr
+  EvalFn compileCollection(const Expression* expr,
+                           const Expression* collection,
+                           ExpressionContext::CollectionOp op,
+                           const Expression* operand);
+
+  // Compile the geography predicate or measure of a constant geography, whose S2 region and index
+  // are prepared once rather than for each row, nullptr if expr isn't such a one
+  EvalFn compileGeography(const Expression* expr);
+
+  EvalFn interpret(const Expression* expr);
+
+  EvalFn eval_;
+  size_t interpreted_{0};
+};
+
+}  // namespace nebula
+#endif  // COMMON_EXPRESSION_COMPILEDEXPRESSION_H_
@@ -51,14 +51,25 @@ bool ListExpression::operator==(const Expression &rhs) const {
 }
 
 const Value &ListExpression::eval(ExpressionContext &ctx) {
-  // TODO(dutor) Reuse `result_' iff all elements are constant
-  std::vector<Value> items;
-  items.reserve(size());
+  if (!prepared_) {
+    std::vector<Value> items;
+    items.reserve(size());
+    varItems_.clear();
+    for (size_t i = 0; i < items_.size(); ++i) {
+      items.emplace_back(items_[i]->eval(ctx));
+      if (items_[i]->kind() != Kind::kConstant) {
+        varItems_.emplace_back(i);
+      }
+    }
+    result_.setList(List(std::move(items)));
+    prepared_ = true;
+    return result_;
+  }
 
-  for (auto &expr : items_) {
-    items.emplace_back(expr->eval(ctx));
+  auto &values = result_.mutableList().values;
+  for (auto i : varItems_) {
+    values[i] = items_[i]->eval(ctx);
   }
-  result_.setList(List(std::move(items)));
 
   return result_;
 }
@@ -122,14 +133,34 @@ bool SetExpression::operator==(const Expression &rhs) const {
 }
 
 const Value &SetExpression::eval(ExpressionContext &ctx) {
-  // TODO(dutor) Reuse `result_' iff all elements are constant
-  std::unordered_set<Value> set;
-  set.reserve(size());
+  if (!prepared_) {
+    std::unordered_set<Value> set;
+    set.reserve(size());
+    varItems_.clear();
+    varValues_.clear();
+    for (size_t i = 0; i < items_.size(); ++i) {
+      if (items_[i]->kind() == Kind::kConstant) {
+        set.emplace(items_[i]->eval(ctx));
+      } else {
+        varItems_.emplace_back(i);
+      }
+    }
+    result_.setSet(Set(std::move(set)));
+    prepared_ = true;
+  }
 
-  for (auto &expr : items_) {
-    set.emplace(expr->eval(ctx));
+  // Replace the values of the last evaluation, the constant ones are kept
+  auto &set = result_.mutableSet().values;
+  for (auto &v : varValues_) {
+    set.erase(v);
+  }
+  varValues_.clear();
+  for (auto i : varItems_) {
+    auto ret = set.emplace(items_[i]->eval(ctx));
+    if (ret.second) {
+      varValues_.emplace_back(*ret.first);
+    }
   }
-  result_.setSet(Set(std::move(set)));
 
   return result_;
 }
@@ -198,14 +229,27 @@ bool MapExpression::operator==(const Expression &rhs) const {
 }
 
 const Value &MapExpression::eval(ExpressionContext &ctx) {
-  // TODO(dutor) Reuse `result_' iff all elements are constant
-  std::unordered_map<std::string, Value> map;
-  map.reserve(size());
+  if (!prepared_) {
+    std::unordered_map<std::string, Value> map;
+    map.reserve(size());
+    varItems_.clear();
+    for (size_t i = 0; i < items_.size(); ++i) {
+      auto &kv = items_[i];
+      // Only the first item of the duplicated keys takes effect
+      auto ret = map.emplace(kv.first, kv.second->eval(ctx));
+      if (ret.second && kv.second->kind() != Kind::kConstant) {
+        varItems_.emplace_back(i);
+      }
+    }
+    result_.setMap(Map(std::move(map)));
+    prepared_ = true;
+    return result_;
+  }
 
-  for (auto &kv : items_) {
-    map.emplace(kv.first, kv.second->eval(ctx));
+  auto &map = result_.mutableMap().kvs;
+  for (auto i : varItems_) {
+    map[items_[i].first] = items_[i].second->eval(ctx);
   }
-  result_.setMap(Map(std::move(map)));
 
   return result_;
 }
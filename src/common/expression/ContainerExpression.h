@@ -94,6 +94,7 @@ class ListExpression final : public ContainerExpression {
   void setItem(size_t index, Expression *item) {
     DCHECK_LT(index, items_.size());
     items_[index] = item;
+    prepared_ = false;
   }
 
   const std::vector<Expression *> getKeys() const override {
@@ -102,6 +103,7 @@ class ListExpression final : public ContainerExpression {
 
   void setItems(std::vector<Expression *> items) {
     items_ = items;
+    prepared_ = false;
   }
 
   size_t size() const override {
@@ -141,6 +143,9 @@ class ListExpression final : public ContainerExpression {
  private:
   std::vector<Expression *> items_;
   Value result_;
+  // The constant items are evaluated once, only the items in `varItems_' are evaluated again
+  std::vector<size_t> varItems_;
+  bool prepared_{false};
 };
 
 class SetExpression final : public ContainerExpression {
@@ -162,6 +167,7 @@ class SetExpression final : public ContainerExpression {
   void setItem(size_t index, Expression *item) {
     DCHECK_LT(index, items_.size());
     items_[index] = item;
+    prepared_ = false;
   }
 
   const std::vector<Expression *> getKeys() const override {
@@ -170,6 +176,7 @@ class SetExpression final : public ContainerExpression {
 
   void setItems(std::vector<Expression *> items) {
     items_ = items;
+    prepared_ = false;
   }
 
   size_t size() const override {
@@ -209,6 +216,11 @@ class SetExpression final : public ContainerExpression {
  private:
   std::vector<Expression *> items_;
   Value result_;
+  // The constant items are evaluated once, only the items in `varItems_' are evaluated again
+  std::vector<size_t> varItems_;
+  bool prepared_{false};
+  // The values of `varItems_' which are not in the set of the constant items
+  std::vector<Value> varValues_;
 };
 
 class MapExpression final : public ContainerExpression {
@@ -231,11 +243,13 @@ class MapExpression final : public ContainerExpression {
 
   void setItems(std::vector<Item> items) {
     items_ = items;
+    prepared_ = false;
   }
 
   void setItem(size_t index, Item item) {
     DCHECK_LT(index, items_.size());
     items_[index] = item;
+    prepared_ = false;
   }
 
   std::vector<Item> get() {
@@ -287,6 +301,9 @@ class MapExpression final : public ContainerExpression {
  private:
   std::vector<Item> items_;
   Value result_;
+  // The constant items are evaluated once, only the items in `varItems_' are evaluated again
+  std::vector<size_t> varItems_;
+  bool prepared_{false};
 };
 
 }  // namespace nebula
@@ -9,6 +9,8 @@
 #include "common/base/Base.h"
 #include "common/base/ObjectPool.h"
 #include "common/context/ExpressionContext.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Set.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
@@ -213,6 +215,25 @@ class Expression {
  protected:
   static Expression* decode(ObjectPool* pool, Decoder& decoder);
 
+  // Visit the elements of a list or a set, in the order of the list or unspecified for the set,
+  // until visit returns false
+  template <typename Visitor>
+  static void forEachElement(const Value& collection, Visitor&& visit) {
+    if (collection.isList()) {
+      for (const auto& v : collection.getList().values) {
+        if (!visit(v)) {
+          return;
+        }
+      }
+    } else {
+      for (const auto& v : collection.getSet().values) {
+        if (!visit(v)) {
+          return;
+        }
+      }
+    }
+  }
+
   // Serialize the content of the expression to the given encoder
   virtual void writeTo(Encoder& encoder) const = 0;
 
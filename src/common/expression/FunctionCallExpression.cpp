@@ -67,6 +67,7 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
   if (funcResult.ok()) {
     func_ = std::move(funcResult).value();
   }
+  moveFunc_ = FunctionManager::getMoveBody(name_, args_->numArgs());
 }
 
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
@@ -74,10 +75,34 @@ const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
   for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
     parameter.emplace_back(arg->eval(ctx));
   }
-  result_ = DCHECK_NOTNULL(func_)(parameter);
+  auto* first = moveFunc_ != nullptr ? movableFirstArg(parameter) : nullptr;
+  if (first != nullptr) {
+    result_ = moveFunc_(std::move(first->result_), parameter);
+  } else {
+    result_ = DCHECK_NOTNULL(func_)(parameter);
+  }
   return result_;
 }
 
+FunctionCallExpression* FunctionCallExpression::movableFirstArg(
+    const std::vector<std::reference_wrapper<const Value>>& parameter) const {
+  const auto& args = args_->args();
+  if (args.empty() || args[0]->kind() != Kind::kFunctionCall) {
+    return nullptr;
+  }
+  auto* first = static_cast<FunctionCallExpression*>(args[0]);
+  if (&parameter[0].get() != &first->result_) {
+    return nullptr;
+  }
+  // The same expression might be the other arguments as well
+  for (size_t i = 1; i < parameter.size(); ++i) {
+    if (&parameter[i].get() == &first->result_) {
+      return nullptr;
+    }
+  }
+  return first;
+}
+
 std::string FunctionCallExpression::toString() const {
   std::stringstream out;
 
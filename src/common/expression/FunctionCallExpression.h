@@ -124,12 +124,18 @@ class FunctionCallExpression final : public Expression {
       if (funcResult.ok()) {
         func_ = funcResult.value();
       }
+      moveFunc_ = FunctionManager::getMoveBody(name_, args_->numArgs());
     }
   }
 
   void writeTo(Encoder& encoder) const override;
   void resetFrom(Decoder& decoder) override;
 
+  // The first argument evaluated to the result of another function call, which is computed by
+  // each eval and only referred here, so it could be moved to moveFunc_
+  FunctionCallExpression* movableFirstArg(
+      const std::vector<std::reference_wrapper<const Value>>& parameter) const;
+
  private:
   std::string name_;
   ArgumentList* args_;
@@ -137,6 +143,7 @@ class FunctionCallExpression final : public Expression {
   // runtime cache
   Value result_;
   FunctionManager::Function func_;
+  FunctionManager::MoveFunction moveFunc_;
 };
 
 }  // namespace nebula
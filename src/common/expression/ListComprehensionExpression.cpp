@@ -10,35 +10,39 @@
 namespace nebula {
 
 const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
-  List ret;
-
   auto& listVal = collection_->eval(ctx);
   if (listVal.isNull() || listVal.empty()) {
     result_ = listVal;
     return result_;
   }
-  if (!listVal.isList()) {
+  if (!listVal.isList() && !listVal.isSet()) {
     result_ = Value::kNullBadType;
     return result_;
   }
 
-  auto& list = listVal.getList();
-
   if (filter_ == nullptr && mapping_ == nullptr) {
-    result_ = std::move(list);
+    if (listVal.isList()) {
+      result_ = listVal;
+    } else {
+      const auto& values = listVal.getSet().values;
+      result_ = List(std::vector<Value>(values.begin(), values.end()));
+    }
     return result_;
   }
 
-  for (size_t i = 0; i < list.size(); ++i) {
-    auto& v = list[i];
-    ctx.setInnerVar(innerVar_, v);
+  List ret;
+  bool badType = false;
+  forEachElement(listVal, [&](const Value& v) {
+    // The element is bound by reference, and only copied if it's output
+    ctx.bindInnerVar(innerVar_, v);
     if (filter_ != nullptr) {
       auto& filterVal = filter_->eval(ctx);
       if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isImplicitBool()) {
-        return Value::kNullBadType;
+        badType = true;
+        return false;
       }
       if (filterVal.empty() || filterVal.isNull() || !filterVal.implicitBool()) {
-        continue;
+        return true;
       }
     }
 
@@ -47,6 +51,10 @@ const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
     } else {
       ret.emplace_back(v);
     }
+    return true;
+  });
+  if (badType) {
+    return Value::kNullBadType;
   }
 
   result_ = std::move(ret);
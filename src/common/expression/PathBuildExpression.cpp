@@ -123,13 +123,13 @@ bool PathBuildExpression::getEdge(const Value& value, const Value& lastStepVid,
     step.type = edge.type;
     step.name = edge.name;
     step.ranking = edge.ranking;
-    step.props = edge.props;
+    step.props = edge.props.toMap();
     step.dst.vid = edge.dst;
   } else if (lastStepVid == edge.dst) {
     step.type = -edge.type;
     step.name = edge.name;
     step.ranking = edge.ranking;
-    step.props = edge.props;
+    step.props = edge.props.toMap();
     step.dst.vid = edge.src;
   } else {
     return false;
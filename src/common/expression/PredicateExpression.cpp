@@ -83,66 +83,76 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
     result_ = listVal;
     return result_;
   }
-  if (!listVal.isList()) {
+  if (!listVal.isList() && !listVal.isSet()) {
     result_ = Value::kNullBadType;
     return result_;
   }
-  auto& list = listVal.getList();
 
+  // The elements are bound by reference without copying
   switch (type) {
     case Type::ALL: {
       result_ = true;
-      for (size_t i = 0; i < list.size(); ++i) {
-        auto& v = list[i];
-        ctx.setInnerVar(innerVar_, v);
+      forEachElement(listVal, [&](const Value& v) {
+        ctx.bindInnerVar(innerVar_, v);
         auto& filterVal = filter_->eval(ctx);
         if (filterVal.empty() || filterVal.isNull()) {
-          return Value::kNullValue;
+          result_ = Value::kNullValue;
+          return false;
         } else if (!filterVal.isImplicitBool()) {
-          return Value::kNullBadType;
+          result_ = Value::kNullBadType;
+          return false;
         } else if (!filterVal.implicitBool()) {
           result_ = false;
-          return result_;
+          return false;
         }
-      }
+        return true;
+      });
       return result_;
     }
     case Type::ANY: {
       result_ = false;
-      for (size_t i = 0; i < list.size(); ++i) {
-        auto& v = list[i];
-        ctx.setInnerVar(innerVar_, v);
+      forEachElement(listVal, [&](const Value& v) {
+        ctx.bindInnerVar(innerVar_, v);
         auto& filterVal = filter_->eval(ctx);
         if (filterVal.empty() || filterVal.isNull()) {
           result_ = Value::kNullValue;
         } else if (!filterVal.isImplicitBool()) {
-          return Value::kNullBadType;
+          result_ = Value::kNullBadType;
+          return false;
         } else if (filterVal.implicitBool()) {
           result_ = true;
-          return result_;
+          return false;
         }
-      }
+        return true;
+      });
       return result_;
     }
     case Type::SINGLE: {
       bool hasNull = false;
       // If there are more than one satisfied, the result is false
       bool hasSatisfied = false;
-      for (size_t i = 0; i < list.size(); ++i) {
-        auto& v = list[i];
-        ctx.setInnerVar(innerVar_, v);
+      bool done = false;
+      forEachElement(listVal, [&](const Value& v) {
+        ctx.bindInnerVar(innerVar_, v);
         auto& filterVal = filter_->eval(ctx);
         if (filterVal.empty() || filterVal.isNull()) {
           hasNull = true;
         } else if (!filterVal.isImplicitBool()) {
-          return Value::kNullBadType;
+          result_ = Value::kNullBadType;
+          done = true;
+          return false;
         } else if (filterVal.implicitBool()) {
           if (hasSatisfied) {
             result_ = false;
-            return result_;
+            done = true;
+            return false;
           }
           hasSatisfied = true;
         }
+        return true;
+      });
+      if (done) {
+        return result_;
       }
       if (hasNull) {
         result_ = Value::kNullValue;
@@ -153,20 +163,21 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
     }
     case Type::NONE: {
       result_ = true;
-      for (size_t i = 0; i < list.size(); ++i) {
-        auto& v = list[i];
-        ctx.setInnerVar(innerVar_, v);
+      forEachElement(listVal, [&](const Value& v) {
+        ctx.bindInnerVar(innerVar_, v);
         auto& filterVal = filter_->eval(ctx);
         if (filterVal.empty() || filterVal.isNull()) {
           result_ = Value::kNullValue;
-          return result_;
+          return false;
         } else if (!filterVal.isImplicitBool()) {
-          return Value::kNullBadType;
+          result_ = Value::kNullBadType;
+          return false;
         } else if (filterVal.implicitBool()) {
           result_ = false;
-          return result_;
+          return false;
         }
-      }
+        return true;
+      });
       return result_;
     }
       // no default so the compiler will warning when lack
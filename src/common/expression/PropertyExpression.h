@@ -200,6 +200,11 @@ class InputPropertyExpression final : public PropertyExpression {
     return InputPropertyExpression::make(pool_, prop());
   }
 
+  // Bind the index of the column read, which is resolved on the first evaluation if none
+  void bindPropIndex(std::optional<std::size_t> index) {
+    propIndex_ = index;
+  }
+
  private:
   friend ObjectPool;
   explicit InputPropertyExpression(ObjectPool* pool, const std::string& prop = "")
@@ -231,6 +236,11 @@ class VariablePropertyExpression final : public PropertyExpression {
     return VariablePropertyExpression::make(pool_, sym(), prop());
   }
 
+  // Bind the index of the column read, which is resolved on the first evaluation if none
+  void bindPropIndex(std::optional<std::size_t> index) {
+    propIndex_ = index;
+  }
+
  private:
   friend ObjectPool;
   explicit VariablePropertyExpression(ObjectPool* pool,
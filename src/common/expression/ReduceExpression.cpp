@@ -17,19 +17,19 @@ const Value& ReduceExpression::eval(ExpressionContext& ctx) {
     result_ = listVal;
     return result_;
   }
-  if (!listVal.isList()) {
+  if (!listVal.isList() && !listVal.isSet()) {
     result_ = Value::kNullBadType;
     return result_;
   }
-  auto& list = listVal.getList();
 
   ctx.setInnerVar(accumulator_, initVal);
-  for (size_t i = 0; i < list.size(); ++i) {
-    auto& v = list[i];
-    ctx.setInnerVar(innerVar_, v);
+  forEachElement(listVal, [&](const Value& v) {
+    ctx.bindInnerVar(innerVar_, v);
+    // The accumulator is copied, the result of the mapping is overwritten by the next element
     auto& mappingVal = mapping_->eval(ctx);
     ctx.setInnerVar(accumulator_, mappingVal);
-  }
+    return true;
+  });
 
   result_ = ctx.getInnerVar(accumulator_);
   return result_;
@@ -5,6 +5,9 @@
 
 #include "common/expression/RelationalExpression.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "common/datatypes/List.h"
 #include "common/datatypes/Map.h"
 #include "common/datatypes/Set.h"
@@ -57,11 +60,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
       if (rhs.isNull() && !rhs.isBadNull()) {
         result_ = Value::kNullValue;
       } else if (rhs.isList()) {
-        auto& list = rhs.getList();
-        result_ = list.contains(lhs);
-        if (UNLIKELY(result_.isBool() && !result_.getBool() && list.contains(Value::kNullValue))) {
-          result_ = Value::kNullValue;
-        }
+        result_ = evalInList(lhs, rhs.getList());
       } else if (rhs.isSet()) {
         auto& set = rhs.getSet();
         result_ = set.contains(lhs);
@@ -87,10 +86,9 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
       if (rhs.isNull() && !rhs.isBadNull()) {
         result_ = Value::kNullValue;
       } else if (rhs.isList()) {
-        auto& list = rhs.getList();
-        result_ = !list.contains(lhs);
-        if (UNLIKELY(result_.isBool() && result_.getBool() && list.contains(Value::kNullValue))) {
-          result_ = Value::kNullValue;
+        result_ = evalInList(lhs, rhs.getList());
+        if (result_.isBool()) {
+          result_ = !result_.getBool();
         }
       } else if (rhs.isSet()) {
         auto& set = rhs.getSet();
@@ -208,6 +206,67 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
   return result_;
 }
 
+RelationalExpression::InListLookup::InListLookup(const List& l) : list(&l), size(l.size()) {
+  for (const auto& v : l.values) {
+    if (v.isInt()) {
+      ints.emplace(v.getInt());
+    } else if (v.isStr()) {
+      strs.emplace(v.getStr());
+    } else {
+      hasNull = hasNull || v == Value::kNullValue;
+      others.emplace_back(&v);
+    }
+  }
+}
+
+bool RelationalExpression::InListLookup::contains(const Value& value) const {
+  if (value.isStr()) {
+    // A string never equals to a value of other types
+    return strs.count(value.getStr()) > 0;
+  }
+  if (value.isInt() && ints.count(value.getInt())) {
+    return true;
+  }
+  if (value.isFloat() && !ints.empty()) {
+    // The numeric comparison tolerates kEpsilon, so a float may equal to the nearest integer
+    auto f = value.getFloat();
+    if (std::abs(f - std::round(f)) < kEpsilon && std::abs(f) < 9.2e18 &&
+        ints.count(static_cast<int64_t>(std::round(f)))) {
+      return true;
+    }
+  }
+  return std::any_of(
+      others.begin(), others.end(), [&value](const Value* v) { return *v == value; });
+}
+
+Value RelationalExpression::evalInList(const Value& lhs, const List& list) {
+  bool found = false;
+  bool hasNull = false;
+  if (rhs_->kind() == Kind::kConstant && list.size() >= kInListLookupMinSize) {
+    if (inListLookup_ == nullptr || inListLookup_->list != &list ||
+        inListLookup_->size != list.size()) {
+      inListLookup_ = std::make_unique<InListLookup>(list);
+    }
+    found = inListLookup_->contains(lhs);
+    hasNull = inListLookup_->hasNull;
+  } else if (list.kind() != List::Kind::kBoxed) {
+    // A typed list has no NULL
+    found = list.contains(lhs);
+  } else {
+    for (const auto& v : list.values) {
+      if (v == lhs) {
+        found = true;
+        break;
+      }
+      hasNull = hasNull || v == Value::kNullValue;
+    }
+  }
+  if (found) {
+    return true;
+  }
+  return hasNull ? Value::kNullValue : Value(false);
+}
+
 std::string RelationalExpression::toString() const {
   std::string op;
   switch (kind_) {
@@ -6,6 +6,9 @@
 #ifndef COMMON_EXPRESSION_RELATIONALEXPRESSION_H_
 #define COMMON_EXPRESSION_RELATIONALEXPRESSION_H_
 
+#include <memory>
+#include <unordered_set>
+
 #include "common/expression/BinaryExpression.h"
 
 namespace nebula {
@@ -128,8 +131,32 @@ class RelationalExpression final : public BinaryExpression {
   RelationalExpression(ObjectPool* pool, Kind kind, Expression* lhs, Expression* rhs)
       : BinaryExpression(pool, kind, lhs, rhs) {}
 
+  // Lookup of the elements of a constant list on the right side of IN/NOT IN. It is built on the
+  // first evaluation, so each evaluation costs O(1) instead of scanning the whole list.
+  struct InListLookup {
+    // The list the lookup is built from
+    const List* list{nullptr};
+    size_t size{0};
+    std::unordered_set<int64_t> ints;
+    std::unordered_set<std::string> strs;
+    // Elements which are not looked up by hash, e.g. the float which equals to a near number
+    std::vector<const Value*> others;
+    bool hasNull{false};
+
+    explicit InListLookup(const List& l);
+    // Whether the value is in the list
+    bool contains(const Value& value) const;
+  };
+
+  // Evaluate `lhs IN list` in one pass, to be NULL if not found but the list has a NULL
+  Value evalInList(const Value& lhs, const List& list);
+
  private:
+  // Only the lists with at least so many elements are worth building the lookup
+  static constexpr size_t kInListLookupMinSize = 16;
+
   Value result_;
+  std::unique_ptr<InListLookup> inListLookup_;
 };
 
 }  // namespace nebula
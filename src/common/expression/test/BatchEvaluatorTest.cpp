@@ -0,0 +1,165 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/BatchEvaluator.h"
+#include "common/expression/test/TestBase.h"
+
+namespace nebula {
+
+class BatchEvaluatorTest : public ExpressionTest {};
+
+TEST_F(BatchEvaluatorTest, SameAsRowByRow) {
+  DataSet ds({"int", "float", "str", "mixed", "bool", "big"});
+  for (int64_t i = 0; i < 100; ++i) {
+    Value mixed;
+    switch (i % 4) {
+      case 0:
+        mixed = i;
+        break;
+      case 1:
+        mixed = folly::to<std::string>(i);
+        break;
+      case 2:
+        mixed = Value(NullType::BAD_TYPE);
+        break;
+      default:
+        break;
+    }
+    ds.emplace_back(Row({i % 7 == 0 ? Value::kNullValue : Value(i % 10),
+                         i / 4.0,
+                         folly::to<std::string>(i % 13),
+                         mixed,
+                         i % 5 == 0 ? Value::kNullValue : Value(i % 3 == 0),
+                         i % 2 == 0 ? Value(std::numeric_limits<int64_t>::max() - i % 3) : Value(i)}));
+  }
+  std::unordered_map<std::string, size_t> colIndices;
+  for (size_t i = 0; i < ds.colNames.size(); ++i) {
+    colIndices.emplace(ds.colNames[i], i);
+  }
+
+  // Each case builds the same expression over the leaves of the columns, which are the input
+  // properties for the batch, and the constants of a row for the row by row evaluation.
+  using Leaf = std::function<Expression*(const std::string&)>;
+  auto constant = [](Value v) { return ConstantExpression::make(&pool, std::move(v)); };
+  std::vector<std::function<Expression*(const Leaf&)>> cases = {
+      [&](const Leaf& col) {
+        return RelationalExpression::makeGT(&pool, col("int"), constant(3));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeLE(&pool, col("float"), col("int"));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeEQ(&pool, constant(2.0), col("int"));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeNE(&pool, col("str"), constant("7"));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeLT(&pool, col("str"), col("mixed"));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeGE(&pool, col("mixed"), constant(10));
+      },
+      [&](const Leaf& col) {
+        return RelationalExpression::makeEQ(&pool, col("bool"), constant(true));
+      },
+      [&](const Leaf& col) {
+        return ArithmeticExpression::makeAdd(&pool, col("int"), col("float"));
+      },
+      [&](const Leaf& col) {
+        return ArithmeticExpression::makeMultiply(&pool, col("int"), constant(3));
+      },
+      [&](const Leaf& col) {
+        // Overflows in some rows
+        return ArithmeticExpression::makeAdd(&pool, col("big"), col("int"));
+      },
+      [&](const Leaf& col) {
+        return ArithmeticExpression::makeDivision(&pool, col("float"), col("int"));
+      },
+      [&](const Leaf& col) {
+        return ArithmeticExpression::makeMod(&pool, col("int"), constant(4));
+      },
+      [&](const Leaf& col) {
+        return ArithmeticExpression::makeMinus(&pool, col("mixed"), constant(1));
+      },
+      [&](const Leaf& col) {
+        return LogicalExpression::makeAnd(
+            &pool,
+            RelationalExpression::makeGT(&pool, col("int"), constant(2)),
+            RelationalExpression::makeLT(&pool, col("float"), constant(20.0)));
+      },
+      [&](const Leaf& col) {
+        return LogicalExpression::makeOr(&pool, col("bool"), col("mixed"));
+      },
+      [&](const Leaf& col) {
+        auto* expr = LogicalExpression::makeXor(&pool, col("bool"), constant(true));
+        expr->operands().emplace_back(
+            RelationalExpression::makeEQ(&pool, col("str"), constant("1")));
+        return expr;
+      },
+      [&](const Leaf& col) {
+        return LogicalExpression::makeAnd(
+            &pool,
+            RelationalExpression::makeGT(&pool, col("float"), constant(1.0)),
+            RelationalExpression::makeGT(&pool, col("float"), constant(3.0)));
+      },
+      [&](const Leaf& col) { return UnaryExpression::makeNot(&pool, col("bool")); },
+      [&](const Leaf& col) { return UnaryExpression::makeNot(&pool, col("mixed")); },
+      [&](const Leaf& col) { return UnaryExpression::makeNegate(&pool, col("int")); },
+      [&](const Leaf& col) { return UnaryExpression::makeIsNull(&pool, col("int")); },
+      [&](const Leaf& col) { return UnaryExpression::makeIsNotNull(&pool, col("mixed")); },
+      [&](const Leaf&) {
+        return ArithmeticExpression::makeAdd(&pool, constant(1), constant(2));
+      },
+  };
+
+  for (auto& build : cases) {
+    BatchEvaluator evaluator(colIndices, ds.colNames.size());
+    auto* batchExpr = build([](const std::string& name) -> Expression* {
+      return InputPropertyExpression::make(&pool, name);
+    });
+    ASSERT_TRUE(evaluator.accept(batchExpr)) << batchExpr->toString();
+    auto batch =
+        ColumnBatch::fromRows(ds.colNames, ds.rows, 0, ds.rowSize(), evaluator.inputColumns());
+    auto column = evaluator.eval(batchExpr, batch);
+    ASSERT_EQ(ds.rowSize(), column.size());
+    for (size_t i = 0; i < ds.rowSize(); ++i) {
+      auto* rowExpr = build([&](const std::string& name) -> Expression* {
+        return constant(ds.rows[i][colIndices[name]]);
+      });
+      EXPECT_EQ(rowExpr->eval(gExpCtxt), column.value(i))
+          << batchExpr->toString() << " at row " << i << ": " << ds.rows[i];
+    }
+  }
+}
+
+TEST_F(BatchEvaluatorTest, Accept) {
+  std::unordered_map<std::string, size_t> colIndices = {{"a", 0}, {"b", 1}, {"c", 2}};
+  BatchEvaluator evaluator(colIndices, colIndices.size());
+  EXPECT_TRUE(evaluator.accept(RelationalExpression::makeGT(
+      &pool, InputPropertyExpression::make(&pool, "c"), ColumnExpression::make(&pool, -3))));
+  EXPECT_EQ((std::vector<size_t>{2, 0}), evaluator.inputColumns());
+  // The unknown property and the function call without a batch body are evaluated row by row
+  EXPECT_FALSE(evaluator.accept(InputPropertyExpression::make(&pool, "d")));
+  EXPECT_FALSE(evaluator.accept(ColumnExpression::make(&pool, 3)));
+  auto* func = FunctionCallExpression::make(
+      &pool, "abs", std::vector<Expression*>{InputPropertyExpression::make(&pool, "b")});
+  EXPECT_FALSE(evaluator.accept(
+      ArithmeticExpression::makeAdd(&pool, func, ConstantExpression::make(&pool, 1))));
+  EXPECT_EQ((std::vector<size_t>{2, 0}), evaluator.inputColumns());
+
+  DataSet ds({"a", "b", "c"});
+  ds.emplace_back(Row({1, 2, 3}));
+  ds.emplace_back(Row({4, 5, 3}));
+  auto batch = ColumnBatch::fromRows(ds.colNames, ds.rows, 0, 2, evaluator.inputColumns());
+  auto* expr = RelationalExpression::makeGT(
+      &pool, InputPropertyExpression::make(&pool, "c"), ColumnExpression::make(&pool, -3));
+  auto column = evaluator.eval(expr, batch);
+  EXPECT_EQ(Column::Kind::kBool, column.kind());
+  EXPECT_EQ(Value(true), column.value(0));
+  EXPECT_EQ(Value(false), column.value(1));
+}
+
+}  // namespace nebula
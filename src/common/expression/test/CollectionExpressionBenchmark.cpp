@@ -0,0 +1,141 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+
+#include "common/base/ObjectPool.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/test/ExpressionContextMock.h"
+#include "common/function/AggFunctionManager.h"
+#include "common/function/FunctionManager.h"
+
+nebula::ExpressionContextMock gExpCtxt;
+nebula::ObjectPool pool;
+namespace nebula {
+
+// The collections of the sizes, the elements of a list are in a random order
+struct Collections {
+  List list;
+  Set set;
+  // Half of the elements are in set
+  Set other;
+  Expression* in{nullptr};
+};
+
+static std::unordered_map<size_t, Collections> collections;
+
+static void prepare(size_t size) {
+  auto& c = collections[size];
+  for (size_t i = 0; i < size; i++) {
+    auto value = static_cast<int64_t>(i * 7919 % size);
+    c.list.values.emplace_back(value);
+    c.set.values.emplace(value);
+    c.other.values.emplace(value + static_cast<int64_t>(size / 2));
+  }
+  c.in = RelationalExpression::makeIn(
+      &pool, ConstantExpression::make(&pool, 0), ConstantExpression::make(&pool, c.list));
+}
+
+size_t setIntersection(size_t iters, size_t size) {
+  auto& c = collections.at(size);
+  for (size_t i = 0; i < iters; i++) {
+    auto result = Set::set_intersection(c.set, c.other);
+    folly::doNotOptimizeAway(result);
+  }
+  return iters;
+}
+
+// Add an element to the set by the function setadd, which copies the set
+size_t setAdd(size_t iters, size_t size) {
+  auto& c = collections.at(size);
+  auto func = FunctionManager::get("setadd", 2);
+  CHECK(func.ok());
+  Value set(c.set);
+  Value elem(static_cast<int64_t>(size * 2));
+  for (size_t i = 0; i < iters; i++) {
+    auto result = func.value()({set, elem});
+    folly::doNotOptimizeAway(result);
+  }
+  return iters;
+}
+
+size_t toSet(size_t iters, size_t size) {
+  auto& c = collections.at(size);
+  auto func = FunctionManager::get("toset", 1);
+  CHECK(func.ok());
+  Value list(c.list);
+  for (size_t i = 0; i < iters; i++) {
+    auto result = func.value()({list});
+    folly::doNotOptimizeAway(result);
+  }
+  return iters;
+}
+
+// Aggregate all the elements of the list by COLLECT_SET
+size_t collectSet(size_t iters, size_t size) {
+  auto& c = collections.at(size);
+  auto func = AggFunctionManager::get("COLLECT_SET");
+  CHECK(func.ok());
+  for (size_t i = 0; i < iters; i++) {
+    AggData aggData;
+    for (auto& value : c.list.values) {
+      func.value()(&aggData, value);
+    }
+    folly::doNotOptimizeAway(aggData.result());
+  }
+  return iters;
+}
+
+// The element looked up is at a random position of the list
+size_t inList(size_t iters, size_t size) {
+  auto& c = collections.at(size);
+  for (size_t i = 0; i < iters; i++) {
+    auto result = Expression::eval(c.in, gExpCtxt);
+    folly::doNotOptimizeAway(result);
+  }
+  return iters;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(setIntersection, 10, 10)
+BENCHMARK_NAMED_PARAM_MULTI(setIntersection, 1K, 1000)
+BENCHMARK_NAMED_PARAM_MULTI(setIntersection, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(setAdd, 10, 10)
+BENCHMARK_NAMED_PARAM_MULTI(setAdd, 1K, 1000)
+BENCHMARK_NAMED_PARAM_MULTI(setAdd, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(toSet, 10, 10)
+BENCHMARK_NAMED_PARAM_MULTI(toSet, 1K, 1000)
+BENCHMARK_NAMED_PARAM_MULTI(toSet, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(collectSet, 10, 10)
+BENCHMARK_NAMED_PARAM_MULTI(collectSet, 1K, 1000)
+BENCHMARK_NAMED_PARAM_MULTI(collectSet, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(inList, 10, 10)
+BENCHMARK_NAMED_PARAM_MULTI(inList, 1K, 1000)
+BENCHMARK_NAMED_PARAM_MULTI(inList, 100K, 100000)
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  for (size_t size : {10, 1000, 100000}) {
+    nebula::prepare(size);
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,149 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/CompiledExpression.h"
+#include "common/expression/test/TestBase.h"
+
+namespace nebula {
+
+class CompiledExpressionTest : public ExpressionTest {};
+
+TEST_F(CompiledExpressionTest, SameAsInterpreted) {
+  auto constant = [](Value v) -> Expression* {
+    return ConstantExpression::make(&pool, std::move(v));
+  };
+  std::vector<std::function<Expression*()>> leaves = {
+      [] { return InputPropertyExpression::make(&pool, "int"); },
+      [] { return InputPropertyExpression::make(&pool, "float"); },
+      [] { return InputPropertyExpression::make(&pool, "string16"); },
+      [] { return InputPropertyExpression::make(&pool, "bool_true"); },
+      [] { return InputPropertyExpression::make(&pool, "null"); },
+      [] { return InputPropertyExpression::make(&pool, "empty"); },
+      [] { return InputPropertyExpression::make(&pool, "nonexistent"); },
+      [] { return VariablePropertyExpression::make(&pool, "var", "int"); },
+      [] { return SourcePropertyExpression::make(&pool, "source", "int"); },
+      [] { return EdgePropertyExpression::make(&pool, "edge", "string16"); },
+  };
+  std::vector<Value> constants = {
+      1, 2, 1.1, std::string(16, 'a'), "b", true, Value::kNullValue, Value()};
+  std::vector<Expression::Kind> relations = {Expression::Kind::kRelEQ,
+                                             Expression::Kind::kRelNE,
+                                             Expression::Kind::kRelLT,
+                                             Expression::Kind::kRelLE,
+                                             Expression::Kind::kRelGT,
+                                             Expression::Kind::kRelGE};
+
+  std::vector<Expression*> exprs;
+  for (auto& leaf : leaves) {
+    for (auto& c : constants) {
+      for (auto kind : relations) {
+        exprs.emplace_back(RelationalExpression::makeKind(&pool, kind, leaf(), constant(c)));
+        exprs.emplace_back(RelationalExpression::makeKind(&pool, kind, constant(c), leaf()));
+      }
+      exprs.emplace_back(ArithmeticExpression::makeAdd(&pool, leaf(), constant(c)));
+      exprs.emplace_back(ArithmeticExpression::makeMod(&pool, constant(c), leaf()));
+    }
+    for (auto& other : leaves) {
+      exprs.emplace_back(RelationalExpression::makeLE(&pool, leaf(), other()));
+      exprs.emplace_back(LogicalExpression::makeAnd(&pool, leaf(), other()));
+      exprs.emplace_back(LogicalExpression::makeOr(&pool, leaf(), other()));
+      exprs.emplace_back(LogicalExpression::makeXor(&pool, leaf(), other()));
+    }
+    exprs.emplace_back(UnaryExpression::makeNot(&pool, leaf()));
+    exprs.emplace_back(UnaryExpression::makeNegate(&pool, leaf()));
+    exprs.emplace_back(UnaryExpression::makeIsNull(&pool, leaf()));
+    exprs.emplace_back(UnaryExpression::makeIsNotEmpty(&pool, leaf()));
+  }
+
+  for (auto* expr : exprs) {
+    auto compiled = CompiledExpression::compile(expr);
+    EXPECT_EQ(0, compiled.interpreted()) << expr->toString();
+    auto* interpreted = expr->clone();
+    // Evaluated twice for the columns resolved on the first row
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(interpreted->eval(gExpCtxt), compiled.eval(gExpCtxt)) << expr->toString();
+    }
+  }
+}
+
+TEST_F(CompiledExpressionTest, Interpreted) {
+  // The function call is left to the interpreter, the comparison over it is compiled
+  auto* func = FunctionCallExpression::make(
+      &pool, "abs", std::vector<Expression*>{InputPropertyExpression::make(&pool, "int")});
+  auto* expr = LogicalExpression::makeAnd(
+      &pool,
+      RelationalExpression::makeGT(&pool, func, ConstantExpression::make(&pool, 0)),
+      RelationalExpression::makeIn(&pool,
+                                   InputPropertyExpression::make(&pool, "string16"),
+                                   ListExpression::make(&pool)));
+  auto compiled = CompiledExpression::compile(expr);
+  EXPECT_EQ(2, compiled.interpreted());
+  EXPECT_EQ(expr->clone()->eval(gExpCtxt), compiled.eval(gExpCtxt));
+}
+
+TEST_F(CompiledExpressionTest, CollectionProperty) {
+  // The mock context doesn't evaluate the collections in place, so they are read as usual
+  auto list = [] { return EdgePropertyExpression::make(&pool, "edge", "list"); };
+  auto constant = [](Value v) -> Expression* {
+    return ConstantExpression::make(&pool, std::move(v));
+  };
+  std::vector<Expression*> exprs = {
+      FunctionCallExpression::make(&pool, "size", std::vector<Expression*>{list()}),
+      FunctionCallExpression::make(
+          &pool,
+          "SIZE",
+          std::vector<Expression*>{SourcePropertyExpression::make(&pool, "source", "null")}),
+      RelationalExpression::makeIn(&pool, constant("aaaa"), list()),
+      RelationalExpression::makeIn(&pool, constant(1), list()),
+      RelationalExpression::makeIn(&pool, constant(Value::kNullValue), list()),
+      RelationalExpression::makeNotIn(&pool, constant("aaaa"), list()),
+      RelationalExpression::makeNotIn(&pool, constant("b"), list()),
+      SubscriptExpression::make(&pool, list(), constant(0)),
+      SubscriptExpression::make(&pool, list(), constant(-1)),
+      SubscriptExpression::make(&pool, list(), constant(16)),
+      SubscriptExpression::make(&pool, list(), constant("a")),
+  };
+  for (auto* expr : exprs) {
+    auto compiled = CompiledExpression::compile(expr);
+    EXPECT_EQ(0, compiled.interpreted()) << expr->toString();
+    EXPECT_EQ(expr->clone()->eval(gExpCtxt), compiled.eval(gExpCtxt)) << expr->toString();
+  }
+}
+
+TEST_F(CompiledExpressionTest, Geography) {
+  // The constant geography is prepared once, the point of the row is built by the interpreter
+  auto polygon = Geography::fromWKT("POLYGON((0 0, 4 0, 4 4, 0 4, 0 0))").value();
+  auto constant = [](Value v) -> Expression* {
+    return ConstantExpression::make(&pool, std::move(v));
+  };
+  auto point = [&] {
+    return FunctionCallExpression::make(
+        &pool,
+        "ST_Point",
+        std::vector<Expression*>{constant(1), InputPropertyExpression::make(&pool, "int")});
+  };
+  auto call = [](const std::string& name, std::vector<Expression*> args) -> Expression* {
+    return FunctionCallExpression::make(&pool, name, std::move(args));
+  };
+  std::vector<Expression*> exprs = {
+      call("ST_Intersects", {constant(polygon), point()}),
+      call("ST_Covers", {constant(polygon), point()}),
+      call("ST_CoveredBy", {point(), constant(polygon)}),
+      call("ST_DWithin", {point(), constant(polygon), constant(1000.0)}),
+      call("ST_DWithin", {constant(polygon), point(), constant(10), constant(true)}),
+      call("ST_DWithin", {constant(polygon), point(), constant("a")}),
+      call("ST_Distance", {point(), constant(polygon)}),
+      call("ST_Distance", {InputPropertyExpression::make(&pool, "int"), constant(polygon)}),
+  };
+  for (auto* expr : exprs) {
+    auto compiled = CompiledExpression::compile(expr);
+    EXPECT_GE(1, compiled.interpreted()) << expr->toString();
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(expr->clone()->eval(gExpCtxt), compiled.eval(gExpCtxt)) << expr->toString();
+    }
+  }
+}
+
+}  // namespace nebula
@@ -101,4 +101,38 @@ TEST_F(ExpressionTest, MapEvaluate) {
     ASSERT_EQ(expected, value);
   }
 }
+
+TEST_F(ExpressionTest, ContainerEvaluateVariableItems) {
+  // The constant items are evaluated once, and the variable items are evaluated every time
+  auto elist = ExpressionList::make(&pool);
+  (*elist)
+      .add(ConstantExpression::make(&pool, 1))
+      .add(VariableExpression::make(&pool, "n"))
+      .add(ConstantExpression::make(&pool, "Hello"));
+  auto listExpr = ListExpression::make(&pool, elist);
+  auto setExpr = SetExpression::make(&pool, elist);
+  auto *items = MapItemList::make(&pool);
+  (*items)
+      .add("key1", ConstantExpression::make(&pool, 1))
+      .add("key2", VariableExpression::make(&pool, "n"))
+      .add("key1", VariableExpression::make(&pool, "n"));
+  auto mapExpr = MapExpression::make(&pool, items);
+
+  gExpCtxt.setVar("n", 1);
+  EXPECT_EQ(Value(List({1, 1, "Hello"})), Expression::eval(listExpr, gExpCtxt));
+  EXPECT_EQ(Value(Set({1, "Hello"})), Expression::eval(setExpr, gExpCtxt));
+  EXPECT_EQ(Value(Map({{"key1", 1}, {"key2", 1}})), Expression::eval(mapExpr, gExpCtxt));
+
+  gExpCtxt.setVar("n", 2);
+  EXPECT_EQ(Value(List({1, 2, "Hello"})), Expression::eval(listExpr, gExpCtxt));
+  EXPECT_EQ(Value(Set({1, 2, "Hello"})), Expression::eval(setExpr, gExpCtxt));
+  EXPECT_EQ(Value(Map({{"key1", 1}, {"key2", 2}})), Expression::eval(mapExpr, gExpCtxt));
+
+  gExpCtxt.setVar("n", "World");
+  EXPECT_EQ(Value(List({1, "World", "Hello"})), Expression::eval(listExpr, gExpCtxt));
+  EXPECT_EQ(Value(Set({1, "World", "Hello"})), Expression::eval(setExpr, gExpCtxt));
+
+  listExpr->setItem(0, ConstantExpression::make(&pool, 3));
+  EXPECT_EQ(Value(List({3, "World", "Hello"})), Expression::eval(listExpr, gExpCtxt));
+}
 }  // namespace nebula
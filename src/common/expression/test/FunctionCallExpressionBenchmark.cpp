@@ -6,6 +6,7 @@
 #include <folly/Benchmark.h>
 
 #include <memory>
+#include <unordered_map>
 
 #include "common/base/ObjectPool.h"
 #include "common/expression/ConstantExpression.h"
@@ -16,9 +17,11 @@ nebula::ExpressionContextMock gExpCtxt;
 nebula::ObjectPool pool;
 namespace nebula {
 
-static FunctionCallExpression* expr = nullptr;
+// The calls benchmarked, by the names of the benchmarks
+static std::unordered_map<std::string, FunctionCallExpression*> exprs;
 
-size_t funcCall(size_t iters) {
+size_t funcCall(size_t iters, const std::string& name) {
+  auto* expr = exprs.at(name);
   for (size_t i = 0; i < iters; ++i) {
     Value eval = Expression::eval(expr, gExpCtxt);
     folly::doNotOptimizeAway(eval);
@@ -26,14 +29,42 @@ size_t funcCall(size_t iters) {
   return iters;
 }
 
-BENCHMARK_NAMED_PARAM_MULTI(funcCall, FunctionCallBM)
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, abs, "abs")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, lower, "lower")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, upper, "upper")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, trim, "trim")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, length, "length")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, strcasecmp, "strcasecmp")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, split, "split")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, replace, "replace")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, lpad, "lpad")
+BENCHMARK_NAMED_PARAM_MULTI(funcCall, rpad, "rpad")
+
+static void addCall(const std::string& name, const std::vector<Value>& values) {
+  ArgumentList* args = ArgumentList::make(&pool);
+  for (const auto& value : values) {
+    args->addArgument(ConstantExpression::make(&pool, value));
+  }
+  exprs[name] = FunctionCallExpression::make(&pool, name, args);
+}
 
 }  // namespace nebula
 
 int main(int argc, char** argv) {
-  nebula::ArgumentList* args = nebula::ArgumentList::make(&pool);
-  args->addArgument(nebula::ConstantExpression::make(&pool, 1));
-  nebula::expr = nebula::FunctionCallExpression::make(&pool, "abs", args);
+  std::string text;
+  for (size_t i = 0; i < 16; ++i) {
+    text += "Nebula Graph is a distributed graph database, 分布式图数据库, ";
+  }
+  nebula::addCall("abs", {1});
+  nebula::addCall("lower", {text});
+  nebula::addCall("upper", {text});
+  nebula::addCall("trim", {"  " + text + "  "});
+  nebula::addCall("length", {text});
+  nebula::addCall("strcasecmp", {text, text + "a"});
+  nebula::addCall("split", {text, ", "});
+  nebula::addCall("replace", {text, "graph", "GRAPH"});
+  nebula::addCall("lpad", {"nebula", 1024, "-="});
+  nebula::addCall("rpad", {"nebula", 1024, "-="});
 
   folly::init(&argc, &argv, true);
   folly::runBenchmarks();
@@ -99,6 +99,33 @@ TEST_F(FunctionCallExpressionTest, FunctionCallTest) {
   }
 }
 
+TEST_F(FunctionCallExpressionTest, MoveFirstArgument) {
+  // reverse(tail(listappend(tail([3, 1, 4]), 5))) moves the result of each inner call
+  auto* list = ListExpression::make(&pool);
+  list->add(ConstantExpression::make(&pool, 3));
+  list->add(ConstantExpression::make(&pool, 1));
+  list->add(ConstantExpression::make(&pool, 4));
+  auto* tail = FunctionCallExpression::make(&pool, "tail", {list});
+  auto* append =
+      FunctionCallExpression::make(&pool, "listappend", {tail, ConstantExpression::make(&pool, 5)});
+  auto* reverse = FunctionCallExpression::make(
+      &pool, "reverse", {FunctionCallExpression::make(&pool, "tail", {append})});
+  // setadd(toset([3, 1, 4]), 2)
+  auto* setadd = FunctionCallExpression::make(
+      &pool,
+      "setadd",
+      {FunctionCallExpression::make(&pool, "toset", {list}), ConstantExpression::make(&pool, 2)});
+  // Evaluated twice, as the inner results moved are computed again, the constant list is kept
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(Value(List({5, 4})), Expression::eval(reverse, gExpCtxt));
+    EXPECT_EQ(Value(Set({1, 2, 3, 4})), Expression::eval(setadd, gExpCtxt));
+  }
+  // The same call as both arguments is not moved
+  auto* sameTail = FunctionCallExpression::make(&pool, "tail", {list});
+  auto* appendSelf = FunctionCallExpression::make(&pool, "listappend", {sameTail, sameTail});
+  EXPECT_EQ(Value(List({1, 4, Value(List({1, 4}))})), Expression::eval(appendSelf, gExpCtxt));
+}
+
 TEST_F(FunctionCallExpressionTest, FunctionCallToStringTest) {
   {
     ArgumentList *argList = ArgumentList::make(&pool);
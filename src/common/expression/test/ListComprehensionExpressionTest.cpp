@@ -73,6 +73,23 @@ TEST_F(ListComprehensionExpressionTest, ListComprehensionEvaluate) {
     ASSERT_TRUE(value.isList());
     ASSERT_EQ(expected, value.getList());
   }
+  {
+    // [n IN {0, 1, 2, 4, 5} WHERE n >= 2 | n + 10], the set is iterated directly
+    auto expr = ListComprehensionExpression::make(
+        &pool,
+        "n",
+        ConstantExpression::make(&pool, Value(Set({0, 1, 2, 4, 5}))),
+        RelationalExpression::makeGE(
+            &pool, VariableExpression::makeInner(&pool, "n"), ConstantExpression::make(&pool, 2)),
+        ArithmeticExpression::makeAdd(
+            &pool, VariableExpression::makeInner(&pool, "n"), ConstantExpression::make(&pool, 10)));
+
+    auto value = Expression::eval(expr, gExpCtxt);
+    ASSERT_TRUE(value.isList());
+    auto values = value.getList().values;
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(std::vector<Value>({12, 14, 15}), values);
+  }
 }
 
 TEST_F(ListComprehensionExpressionTest, ListComprehensionExprToString) {
@@ -30,6 +30,20 @@ TEST_F(PredicateExpressionTest, PredicateEvaluate) {
     ASSERT_TRUE(value.isBool());
     ASSERT_EQ(false, value.getBool());
   }
+  {
+    // single(n IN {0, 1, 2} WHERE n >= 2), the set is iterated directly
+    auto expr = PredicateExpression::make(
+        &pool,
+        "single",
+        "n",
+        ConstantExpression::make(&pool, Value(Set({0, 1, 2}))),
+        RelationalExpression::makeGE(
+            &pool, VariableExpression::makeInner(&pool, "n"), ConstantExpression::make(&pool, 2)));
+
+    auto value = Expression::eval(expr, gExpCtxt);
+    ASSERT_TRUE(value.isBool());
+    ASSERT_EQ(true, value.getBool());
+  }
   {
     // any(n IN nodes(p) WHERE n.age >= 19)
     auto v1 = Vertex("101", {Tag("player", {{"name", "joe"}, {"age", 18}})});
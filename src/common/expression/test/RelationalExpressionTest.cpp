@@ -501,6 +501,43 @@ TEST_F(RelationalExpressionTest, InList) {
   }
 }
 
+TEST_F(RelationalExpressionTest, InLargeConstantList) {
+  std::vector<Value> values;
+  for (int64_t i = 0; i < 100; ++i) {
+    values.emplace_back(i * 2);
+  }
+  values.emplace_back("Hello");
+  values.emplace_back(0.5);
+  auto inList = [&values](Expression::Kind kind, Value lhs, bool withNull) {
+    auto list = values;
+    if (withNull) {
+      list.emplace_back(Value::kNullValue);
+    }
+    auto expr = RelationalExpression::makeKind(&pool,
+                                               kind,
+                                               ConstantExpression::make(&pool, std::move(lhs)),
+                                               ConstantExpression::make(&pool, List(list)));
+    // Evaluate twice to use the lookup built in the first evaluation
+    Expression::eval(expr, gExpCtxt);
+    return Expression::eval(expr, gExpCtxt);
+  };
+  for (auto withNull : {false, true}) {
+    EXPECT_EQ(Value(true), inList(Expression::Kind::kRelIn, 198, withNull));
+    EXPECT_EQ(Value(true), inList(Expression::Kind::kRelIn, 4.0, withNull));
+    EXPECT_EQ(Value(true), inList(Expression::Kind::kRelIn, 0.5, withNull));
+    EXPECT_EQ(Value(true), inList(Expression::Kind::kRelIn, "Hello", withNull));
+    EXPECT_EQ(Value(false), inList(Expression::Kind::kRelNotIn, 198, withNull));
+    EXPECT_EQ(Value(false), inList(Expression::Kind::kRelNotIn, "Hello", withNull));
+    auto notFound = withNull ? Value::kNullValue : Value(false);
+    EXPECT_EQ(notFound, inList(Expression::Kind::kRelIn, 3, withNull));
+    EXPECT_EQ(notFound, inList(Expression::Kind::kRelIn, 4.5, withNull));
+    EXPECT_EQ(notFound, inList(Expression::Kind::kRelIn, "World", withNull));
+    auto notFoundNotIn = withNull ? Value::kNullValue : Value(true);
+    EXPECT_EQ(notFoundNotIn, inList(Expression::Kind::kRelNotIn, 3, withNull));
+    EXPECT_TRUE(inList(Expression::Kind::kRelIn, Value::kNullValue, withNull).isNull());
+  }
+}
+
 TEST_F(RelationalExpressionTest, InSet) {
   {
     auto *elist = ExpressionList::make(&pool);
@@ -5,11 +5,44 @@
 
 #include "AggFunctionManager.h"
 
+#include <folly/hash/Hash.h>
+
 #include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
 #include "common/datatypes/Set.h"
 
 namespace nebula {
 
+// The quantiles in the result of APPROX_QUANTILES
+static const std::vector<std::pair<std::string, double>> kApproxQuantiles = {{"min", 0.0},
+                                                                             {"p25", 0.25},
+                                                                             {"p50", 0.5},
+                                                                             {"p75", 0.75},
+                                                                             {"p90", 0.9},
+                                                                             {"p95", 0.95},
+                                                                             {"p99", 0.99},
+                                                                             {"max", 1.0}};
+
+void AggData::estimate() const {
+  estimated_ = true;
+  if (result_.isBadNull()) {
+    return;
+  }
+  if (hll_ != nullptr) {
+    result_ = static_cast<int64_t>(hll_->estimate());
+  } else if (digest_ != nullptr) {
+    if (digest_->empty()) {
+      result_ = Value::kNullValue;
+      return;
+    }
+    Map quantiles;
+    for (const auto& [name, q] : kApproxQuantiles) {
+      quantiles.kvs.emplace(name, digest_->quantile(q));
+    }
+    result_ = std::move(quantiles);
+  }
+}
+
 // static
 AggFunctionManager& AggFunctionManager::instance() {
   static AggFunctionManager instance;
@@ -273,6 +306,265 @@ AggFunctionManager::AggFunctionManager() {
       set.values.emplace(val);
     };
   }
+  {
+    // The estimated count of the distinct values by HyperLogLog, whose error is about 1%, but the
+    // small counts are exact
+    auto& func = functions_["APPROX_COUNT_DISTINCT"];
+    func = [](AggData* aggData, const Value& val) {
+      auto* hll = aggData->hll();
+      if (hll == nullptr) {
+        hll = new algorithm::HyperLogLog();
+        aggData->setHll(hll);
+      }
+      if (val.isNull() || val.empty()) {
+        return;
+      }
+      hll->add(folly::hash::twang_mix64(std::hash<Value>()(val)));
+      aggData->sketchChanged();
+    };
+  }
+  {
+    // The estimated quantiles of the numeric values by t-digest, as a map from min, p25, p50, p75,
+    // p90, p95, p99 and max to the values
+    auto& func = functions_["APPROX_QUANTILES"];
+    func = [](AggData* aggData, const Value& val) {
+      auto* digest = aggData->digest();
+      if (digest == nullptr) {
+        if (aggData->result().isBadNull()) {
+          return;
+        }
+        digest = new algorithm::TDigest();
+        aggData->setDigest(digest);
+      }
+      if (val.isNull() || val.empty()) {
+        return;
+      }
+      if (UNLIKELY(!val.isNumeric())) {
+        aggData->setDigest(nullptr);
+        aggData->setResult(Value::kNullBadType);
+        return;
+      }
+      digest->add(val.isInt() ? static_cast<double>(val.getInt()) : val.getFloat());
+      aggData->sketchChanged();
+    };
+  }
+
+  // The merge operations. The partial state with a NULL result has aggregated nothing, and a bad
+  // result always wins.
+  {
+    auto& merge = merges_[""];
+    merge = [](AggData* aggData, const AggData& partial) {
+      // The value of the last row is kept
+      aggData->setResult(partial.result());
+    };
+  }
+  {
+    auto plus = [](AggData* aggData, const AggData& partial) {
+      auto& res = aggData->result();
+      const auto& other = partial.result();
+      if (res.isBadNull() || other.isNull()) {
+        if (other.isBadNull()) {
+          res = other;
+        }
+        return;
+      }
+      if (res.isNull()) {
+        res = other;
+        return;
+      }
+      res = res + other;
+    };
+    merges_["COUNT"] = plus;
+    merges_["SUM"] = plus;
+  }
+  {
+    auto& merge = merges_["AVG"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      auto& res = aggData->result();
+      const auto& other = partial.result();
+      if (res.isBadNull() || other.isNull()) {
+        if (other.isBadNull()) {
+          res = other;
+        }
+        return;
+      }
+      if (res.isNull()) {
+        aggData->sum() = partial.sum();
+        aggData->cnt() = partial.cnt();
+        res = other;
+        return;
+      }
+      auto& sum = aggData->sum();
+      auto& cnt = aggData->cnt();
+      sum = sum + partial.sum();
+      cnt = cnt + partial.cnt();
+      res = sum / cnt;
+    };
+  }
+  {
+    auto compare = [](bool takeGreater) {
+      return [takeGreater](AggData* aggData, const AggData& partial) {
+        auto& res = aggData->result();
+        const auto& other = partial.result();
+        if (res.isBadNull() || other.isNull()) {
+          if (other.isBadNull()) {
+            res = other;
+          }
+          return;
+        }
+        if (res.isNull() || (takeGreater ? other > res : other < res)) {
+          res = other;
+        }
+      };
+    };
+    merges_["MAX"] = compare(true);
+    merges_["MIN"] = compare(false);
+  }
+  {
+    auto& merge = merges_["STD"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      auto& res = aggData->result();
+      const auto& other = partial.result();
+      if (res.isBadNull() || other.isNull()) {
+        if (other.isBadNull()) {
+          res = other;
+        }
+        return;
+      }
+      auto& cnt = aggData->cnt();
+      auto& avg = aggData->avg();
+      auto& deviation = aggData->deviation();
+      if (res.isNull()) {
+        cnt = partial.cnt();
+        avg = partial.avg();
+        deviation = partial.deviation();
+        res = other;
+        return;
+      }
+      if (!cnt.isFloat() || !avg.isFloat() || !deviation.isFloat() || !partial.cnt().isFloat() ||
+          !partial.avg().isFloat() || !partial.deviation().isFloat()) {
+        res = Value::kNullBadType;
+        return;
+      }
+      // Combine the population variances of both parts
+      double n1 = cnt.getFloat(), n2 = partial.cnt().getFloat();
+      double avg1 = avg.getFloat(), avg2 = partial.avg().getFloat();
+      double n = n1 + n2;
+      double delta = avg2 - avg1;
+      double m2 = deviation.getFloat() * n1 + partial.deviation().getFloat() * n2 +
+                  delta * delta * n1 * n2 / n;
+      cnt = n;
+      avg = avg1 + delta * n2 / n;
+      deviation = m2 / n;
+      res = std::sqrt(deviation.getFloat());
+    };
+  }
+  {
+    auto bitwise = [](auto op) {
+      return [op](AggData* aggData, const AggData& partial) {
+        auto& res = aggData->result();
+        const auto& other = partial.result();
+        if (res.isBadNull() || other.isNull()) {
+          if (other.isBadNull()) {
+            res = other;
+          }
+          return;
+        }
+        if (res.isNull()) {
+          res = other;
+          return;
+        }
+        res = op(res, other);
+      };
+    };
+    merges_["BIT_AND"] = bitwise([](const Value& l, const Value& r) { return l & r; });
+    merges_["BIT_OR"] = bitwise([](const Value& l, const Value& r) { return l | r; });
+    merges_["BIT_XOR"] = bitwise([](const Value& l, const Value& r) { return l ^ r; });
+  }
+  {
+    auto& merge = merges_["COLLECT"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      auto& res = aggData->result();
+      const auto& other = partial.result();
+      if (res.isBadNull() || other.isNull()) {
+        if (other.isBadNull()) {
+          res = other;
+        }
+        return;
+      }
+      if (res.isNull()) {
+        res = other;
+        return;
+      }
+      if (!res.isList() || !other.isList()) {
+        res = Value::kNullBadData;
+        return;
+      }
+      res.mutableList().values.insert(res.mutableList().values.end(),
+                                      other.getList().values.begin(),
+                                      other.getList().values.end());
+    };
+  }
+  {
+    auto& merge = merges_["COLLECT_SET"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      auto& res = aggData->result();
+      const auto& other = partial.result();
+      if (res.isBadNull() || other.isNull()) {
+        if (other.isBadNull()) {
+          res = other;
+        }
+        return;
+      }
+      if (res.isNull()) {
+        res = other;
+        return;
+      }
+      if (!res.isSet() || !other.isSet()) {
+        res = Value::kNullBadData;
+        return;
+      }
+      res.mutableSet().values.insert(other.getSet().values.begin(), other.getSet().values.end());
+    };
+  }
+  {
+    auto& merge = merges_["APPROX_COUNT_DISTINCT"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      if (partial.hll() == nullptr) {
+        return;
+      }
+      if (aggData->hll() == nullptr) {
+        aggData->setHll(new algorithm::HyperLogLog());
+      }
+      aggData->hll()->merge(*partial.hll());
+      aggData->sketchChanged();
+    };
+  }
+  {
+    auto& merge = merges_["APPROX_QUANTILES"];
+    merge = [](AggData* aggData, const AggData& partial) {
+      // The digest is dropped once it's bad, so the bad state is known without estimating
+      auto isBad = [](const AggData& data) {
+        return data.digest() == nullptr && data.result().isBadNull();
+      };
+      if (isBad(*aggData)) {
+        return;
+      }
+      if (isBad(partial)) {
+        aggData->setDigest(nullptr);
+        aggData->setResult(Value::kNullBadType);
+        return;
+      }
+      if (partial.digest() == nullptr) {
+        return;
+      }
+      if (aggData->digest() == nullptr) {
+        aggData->setDigest(new algorithm::TDigest());
+      }
+      aggData->digest()->merge(*partial.digest());
+      aggData->sketchChanged();
+    };
+  }
 }
 
 StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::get(const std::string& func) {
@@ -281,6 +573,12 @@ StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::get(const std::str
   return result.value();
 }
 
+StatusOr<AggFunctionManager::AggMerge> AggFunctionManager::getMerge(const std::string& func) {
+  auto result = instance().getMergeInternal(func);
+  NG_RETURN_IF_ERROR(result);
+  return result.value();
+}
+
 Status AggFunctionManager::find(const std::string& func) {
   auto result = instance().getInternal(func);
   NG_RETURN_IF_ERROR(result);
@@ -298,6 +596,17 @@ StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::getInternal(std::s
   return iter->second;
 }
 
+StatusOr<AggFunctionManager::AggMerge> AggFunctionManager::getMergeInternal(
+    std::string func) const {
+  std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+  auto iter = merges_.find(func);
+  if (iter == merges_.end()) {
+    return Status::Error("Unknown merge of aggregate function `%s'", func.c_str());
+  }
+
+  return iter->second;
+}
+
 Status AggFunctionManager::load(const std::string& soname, const std::vector<std::string>& funcs) {
   return instance().loadInternal(soname, funcs);
 }
@@ -6,6 +6,8 @@
 #ifndef COMMON_FUNCTION_AGGFUNCTIONMANAGER_H_
 #define COMMON_FUNCTION_AGGFUNCTIONMANAGER_H_
 
+#include "common/algorithm/HyperLogLog.h"
+#include "common/algorithm/TDigest.h"
 #include "common/base/Base.h"
 #include "common/base/Status.h"
 #include "common/base/StatusOr.h"
@@ -79,10 +81,16 @@ class AggData final {
   }
 
   const Value& result() const {
+    if (UNLIKELY(!estimated_)) {
+      estimate();
+    }
     return result_;
   }
 
   Value& result() {
+    if (UNLIKELY(!estimated_)) {
+      estimate();
+    }
     return result_;
   }
 
@@ -106,24 +114,70 @@ class AggData final {
     uniques_.reset(uniques);
   }
 
+  const algorithm::HyperLogLog* hll() const {
+    return hll_.get();
+  }
+
+  algorithm::HyperLogLog* hll() {
+    return hll_.get();
+  }
+
+  void setHll(algorithm::HyperLogLog* hll) {
+    hll_.reset(hll);
+    estimated_ = false;
+  }
+
+  const algorithm::TDigest* digest() const {
+    return digest_.get();
+  }
+
+  algorithm::TDigest* digest() {
+    return digest_.get();
+  }
+
+  void setDigest(algorithm::TDigest* digest) {
+    digest_.reset(digest);
+    estimated_ = false;
+  }
+
+  // The sketch is changed, the result is estimated again when it's read
+  void sketchChanged() {
+    estimated_ = false;
+  }
+
  private:
+  // Estimate the result from the sketch of the approximate aggregate functions, which is too
+  // expensive to do at each value aggregated
+  void estimate() const;
+
   Value cnt_;
   Value sum_;
   Value avg_;
   Value deviation_;
-  Value result_;
+  mutable Value result_;
   std::unique_ptr<Set> uniques_;
+  std::unique_ptr<algorithm::HyperLogLog> hll_;
+  std::unique_ptr<algorithm::TDigest> digest_;
+  mutable bool estimated_{true};
 };
 
 class AggFunctionManager final {
  public:
   using AggFunction = std::function<void(AggData*, const Value&)>;
+  // Merge the partial state of the rows after those aggregated into the first AggData
+  using AggMerge = std::function<void(AggData*, const AggData&)>;
 
   /**
    * To obtain a aggregate function named `func'
    */
   static StatusOr<AggFunction> get(const std::string& func);
 
+  /**
+   * To obtain the merge operation of the aggregate function named `func', which combines
+   * the partial states aggregated separately, e.g. by multiple jobs.
+   */
+  static StatusOr<AggMerge> getMerge(const std::string& func);
+
   /**
    * To Check the validity of the function named `func'
    * Only used for parser check.
@@ -151,11 +205,14 @@ class AggFunctionManager final {
 
   StatusOr<AggFunction> getInternal(std::string func) const;
 
+  StatusOr<AggMerge> getMergeInternal(std::string func) const;
+
   Status loadInternal(const std::string& soname, const std::vector<std::string>& funcs);
 
   Status unloadInternal(const std::string& soname, const std::vector<std::string>& funcs);
 
   std::unordered_map<std::string, AggFunction> functions_;
+  std::unordered_map<std::string, AggMerge> merges_;
 };
 
 }  // namespace nebula
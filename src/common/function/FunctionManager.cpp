@@ -10,14 +10,16 @@
 #include <proxygen/lib/utils/CryptUtil.h>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/replace.hpp>
 #include <cstdint>
 
 #include "FunctionUdfManager.h"
+#include "StringKernels.h"
+#include "VectorKernels.h"
 #include "common/base/Base.h"
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Geography.h"
+#include "common/datatypes/IntSetKernels.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Map.h"
 #include "common/datatypes/Path.h"
@@ -180,6 +182,57 @@ std::unordered_map<std::string, std::vector<TypeSignature>> FunctionManager::typ
      {TypeSignature({Value::Type::SET, Value::Type::STRING}, Value::Type::SET),
       TypeSignature({Value::Type::SET, Value::Type::INT}, Value::Type::SET),
       TypeSignature({Value::Type::SET, Value::Type::FLOAT}, Value::Type::SET)}},
+    {"setremove",
+     {TypeSignature({Value::Type::SET, Value::Type::STRING}, Value::Type::SET),
+      TypeSignature({Value::Type::SET, Value::Type::INT}, Value::Type::SET),
+      TypeSignature({Value::Type::SET, Value::Type::FLOAT}, Value::Type::SET)}},
+    {"listappend",
+     {TypeSignature({Value::Type::LIST, Value::Type::STRING}, Value::Type::LIST),
+      TypeSignature({Value::Type::LIST, Value::Type::INT}, Value::Type::LIST),
+      TypeSignature({Value::Type::LIST, Value::Type::FLOAT}, Value::Type::LIST)}},
+    {"listremoveat", {TypeSignature({Value::Type::LIST, Value::Type::INT}, Value::Type::LIST)}},
+    {"dot_product", {TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::FLOAT)}},
+    {"l2_distance", {TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::FLOAT)}},
+    {"intersection",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::SET)}},
+    {"union",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::SET)}},
+    {"difference",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::SET),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::SET)}},
+    {"intersection_size",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::INT),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::INT),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::INT),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::INT)}},
+    {"containsall",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::BOOL),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::BOOL),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::BOOL),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::BOOL)}},
+    {"jaccard",
+     {TypeSignature({Value::Type::SET, Value::Type::SET}, Value::Type::FLOAT),
+      TypeSignature({Value::Type::SET, Value::Type::LIST}, Value::Type::FLOAT),
+      TypeSignature({Value::Type::LIST, Value::Type::SET}, Value::Type::FLOAT),
+      TypeSignature({Value::Type::LIST, Value::Type::LIST}, Value::Type::FLOAT)}},
+    {"list_sort",
+     {TypeSignature({Value::Type::LIST}, Value::Type::LIST),
+      TypeSignature({Value::Type::LIST, Value::Type::BOOL}, Value::Type::LIST)}},
+    {"list_topk",
+     {TypeSignature({Value::Type::LIST, Value::Type::INT}, Value::Type::LIST),
+      TypeSignature({Value::Type::LIST, Value::Type::INT, Value::Type::BOOL}, Value::Type::LIST)}},
+    {"list_distinct", {TypeSignature({Value::Type::LIST}, Value::Type::LIST)}},
+    {"list_slice",
+     {TypeSignature({Value::Type::LIST, Value::Type::INT}, Value::Type::LIST),
+      TypeSignature({Value::Type::LIST, Value::Type::INT, Value::Type::INT}, Value::Type::LIST)}},
     {"reverse",
      {TypeSignature({Value::Type::STRING}, Value::Type::STRING),
       TypeSignature({Value::Type::LIST}, Value::Type::LIST)}},
@@ -497,6 +550,155 @@ StatusOr<Value::Type> FunctionManager::getReturnType(const std::string &funcName
   return Status::Error("Parameter's type error");
 }
 
+// Apply a set operation on two containers, each of which could be a LIST or a SET.
+// The integer containers are handled by the vectorized kernels over the sorted arrays,
+// and the others fall back to the hash based operations of Set.
+template <typename IntOp, typename SetOp>
+static Value setOperation(const Value &lhs, const Value &rhs, IntOp &&intOp, SetOp &&setOp) {
+  if (lhs.isNull() || rhs.isNull()) {
+    return Value::kNullValue;
+  }
+  if ((!lhs.isList() && !lhs.isSet()) || (!rhs.isList() && !rhs.isSet())) {
+    return Value::kNullBadType;
+  }
+  std::vector<int64_t> lints, rints;
+  if (IntSetKernels::toSortedInts(lhs, lints) && IntSetKernels::toSortedInts(rhs, rints)) {
+    return intOp(lints, rints);
+  }
+  auto toSet = [](const Value &v) -> Set {
+    if (v.isSet()) {
+      return v.getSet();
+    }
+    Set set;
+    set.values.reserve(v.getList().size());
+    set.values.insert(v.getList().values.begin(), v.getList().values.end());
+    return set;
+  };
+  return setOp(toSet(lhs), toSet(rhs));
+}
+
+static Set intsToSet(const std::vector<int64_t> &ints) {
+  Set set;
+  set.values.reserve(ints.size());
+  for (auto i : ints) {
+    set.values.emplace(i);
+  }
+  return set;
+}
+
+// Sort the first k of the values, all of them if k is not less than the size. A list of integers
+// is sorted as an int64 array without comparing the values.
+static void sortValues(std::vector<Value> &values, size_t k, bool ascending) {
+  k = std::min(k, values.size());
+  bool allInts =
+      std::all_of(values.begin(), values.end(), [](const Value &v) { return v.isInt(); });
+  if (allInts) {
+    std::vector<int64_t> ints;
+    ints.reserve(values.size());
+    for (const auto &v : values) {
+      ints.emplace_back(v.getInt());
+    }
+    if (ascending) {
+      std::partial_sort(ints.begin(), ints.begin() + k, ints.end());
+    } else {
+      std::partial_sort(ints.begin(), ints.begin() + k, ints.end(), std::greater<int64_t>());
+    }
+    values.resize(k);
+    for (size_t i = 0; i < k; ++i) {
+      values[i] = ints[i];
+    }
+    return;
+  }
+  auto less = [ascending](const Value &lhs, const Value &rhs) {
+    return ascending ? lhs < rhs : rhs < lhs;
+  };
+  if (k == values.size()) {
+    std::stable_sort(values.begin(), values.end(), less);
+  } else {
+    std::partial_sort(values.begin(), values.begin() + k, values.end(), less);
+    values.resize(k);
+  }
+}
+
+// list_sort(list[, ascending]) and list_topk(list, k[, ascending]), on the list owned
+static Value sortList(Value &&list, const std::vector<FunctionManager::ArgType> &args, bool topK) {
+  if (list.isNull()) {
+    return Value::kNullValue;
+  }
+  size_t ascendingArg = topK ? 2 : 1;
+  if (!list.isList() || (topK && !args[1].get().isInt()) ||
+      (args.size() > ascendingArg && !args[ascendingArg].get().isBool())) {
+    return Value::kNullBadType;
+  }
+  // The largest are the top by default
+  bool ascending = args.size() > ascendingArg ? args[ascendingArg].get().getBool() : !topK;
+  auto &values = list.mutableList().values;
+  size_t k = values.size();
+  if (topK) {
+    k = static_cast<size_t>(std::max<int64_t>(args[1].get().getInt(), 0));
+  }
+  sortValues(values, k, ascending);
+  return std::move(list);
+}
+
+// Apply op on the two lists of numbers as the vectors of floats, e.g. the embeddings of the
+// LIST_FLOAT properties, which must be of the same size
+template <typename Op>
+static Value vectorOperation(const Value &lhs, const Value &rhs, Op &&op) {
+  if (lhs.isNull() || rhs.isNull()) {
+    return Value::kNullValue;
+  }
+  std::vector<double> x, y;
+  if (!VectorKernels::toDoubles(lhs, x) || !VectorKernels::toDoubles(rhs, y)) {
+    return Value::kNullBadType;
+  }
+  if (x.size() != y.size()) {
+    return Value::kNullBadData;
+  }
+  return op(x, y);
+}
+
+// static
+bool FunctionManager::mutateInPlace(const std::string &func,
+                                    Value &container,
+                                    const Value &operand) {
+  std::string name = func;
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  if (name == "setadd" || name == "setremove") {
+    if (!container.isSet()) {
+      return false;
+    }
+    auto &set = container.mutableSet();
+    if (name == "setadd") {
+      set.values.emplace(operand);
+    } else {
+      set.values.erase(operand);
+    }
+    return true;
+  }
+  if (name == "listappend") {
+    if (!container.isList()) {
+      return false;
+    }
+    container.mutableList().emplace_back(operand);
+    return true;
+  }
+  if (name == "listremoveat") {
+    if (!container.isList() || !operand.isInt()) {
+      return false;
+    }
+    auto &list = container.mutableList();
+    int64_t size = list.size();
+    // The negative index counts from the end, the same as the subscript
+    auto index = operand.getInt() < 0 ? operand.getInt() + size : operand.getInt();
+    if (index >= 0 && index < size) {
+      list.values.erase(list.values.begin() + index);
+    }
+    return true;
+  }
+  return false;
+}
+
 FunctionManager::FunctionManager() {
   {
     // absolute value
@@ -1190,7 +1392,7 @@ FunctionManager::FunctionManager() {
     attr.body_ = [](const auto &args) -> Value {
       if (args[0].get().isStr() && args[1].get().isStr()) {
         return static_cast<int64_t>(
-            ::strcasecmp(args[0].get().getStr().c_str(), args[1].get().getStr().c_str()));
+            StringKernels::caseCompare(args[0].get().getStr(), args[1].get().getStr()));
       }
       return Value::kNullBadType;
     };
@@ -1207,7 +1409,7 @@ FunctionManager::FunctionManager() {
         }
         case Value::Type::STRING: {
           std::string value(args[0].get().getStr());
-          folly::toLowerAscii(value);
+          StringKernels::toLowerAscii(value.data(), value.size());
           return value;
         }
         default: {
@@ -1215,6 +1417,21 @@ FunctionManager::FunctionManager() {
         }
       }
     };
+    attr.moveBody_ = [](Value &&first, const auto &) -> Value {
+      switch (first.type()) {
+        case Value::Type::NULLVALUE: {
+          return Value::kNullValue;
+        }
+        case Value::Type::STRING: {
+          auto &str = first.mutableStr();
+          StringKernels::toLowerAscii(str.data(), str.size());
+          return std::move(first);
+        }
+        default: {
+          return Value::kNullBadType;
+        }
+      }
+    };
     functions_["tolower"] = attr;
   }
   {
@@ -1229,9 +1446,7 @@ FunctionManager::FunctionManager() {
         }
         case Value::Type::STRING: {
           std::string value(args[0].get().getStr());
-          std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
-            return std::toupper(c);
-          });
+          StringKernels::toUpperAscii(value.data(), value.size());
           return value;
         }
         default: {
@@ -1239,6 +1454,21 @@ FunctionManager::FunctionManager() {
         }
       }
     };
+    attr.moveBody_ = [](Value &&first, const auto &) -> Value {
+      switch (first.type()) {
+        case Value::Type::NULLVALUE: {
+          return Value::kNullValue;
+        }
+        case Value::Type::STRING: {
+          auto &str = first.mutableStr();
+          StringKernels::toUpperAscii(str.data(), str.size());
+          return std::move(first);
+        }
+        default: {
+          return Value::kNullBadType;
+        }
+      }
+    };
     functions_["toupper"] = attr;
   }
   {
@@ -1252,12 +1482,10 @@ FunctionManager::FunctionManager() {
           return Value::kNullValue;
         }
         case Value::Type::STRING: {
-          auto value = args[0].get().getStr();
-          return static_cast<int64_t>(value.length());
+          return static_cast<int64_t>(args[0].get().getStr().length());
         }
         case Value::Type::PATH: {
-          auto path = args[0].get().getPath();
-          return static_cast<int64_t>(path.steps.size());
+          return static_cast<int64_t>(args[0].get().getPath().steps.size());
         }
         default: {
           return Value::kNullBadType;
@@ -1276,8 +1504,7 @@ FunctionManager::FunctionManager() {
           return Value::kNullValue;
         }
         case Value::Type::STRING: {
-          std::string value(args[0].get().getStr());
-          return folly::trimWhitespace(value).toString();
+          return folly::trimWhitespace(args[0].get().getStr()).toString();
         }
         default: {
           return Value::kNullBadType;
@@ -1296,8 +1523,7 @@ FunctionManager::FunctionManager() {
           return Value::kNullValue;
         }
         case Value::Type::STRING: {
-          std::string value(args[0].get().getStr());
-          return folly::ltrimWhitespace(value).toString();
+          return folly::ltrimWhitespace(args[0].get().getStr()).toString();
         }
         default: {
           return Value::kNullBadType;
@@ -1316,8 +1542,7 @@ FunctionManager::FunctionManager() {
           return Value::kNullValue;
         }
         case Value::Type::STRING: {
-          std::string value(args[0].get().getStr());
-          return folly::rtrimWhitespace(value).toString();
+          return folly::rtrimWhitespace(args[0].get().getStr()).toString();
         }
         default: {
           return Value::kNullBadType;
@@ -1395,10 +1620,23 @@ FunctionManager::FunctionManager() {
         return Value::kNullValue;
       }
       if (args[0].get().isStr() && args[1].get().isStr() && args[2].get().isStr()) {
-        std::string origStr(args[0].get().getStr());
-        std::string search(args[1].get().getStr());
-        std::string newStr(args[2].get().getStr());
-        return boost::replace_all_copy(origStr, search, newStr);
+        const auto &origStr = args[0].get().getStr();
+        const auto &search = args[1].get().getStr();
+        const auto &newStr = args[2].get().getStr();
+        if (search.empty()) {
+          return origStr;
+        }
+        std::string result;
+        result.reserve(origStr.size());
+        size_t pos = 0;
+        for (auto found = StringKernels::find(origStr, search);
+             found != StringKernels::npos;
+             found = StringKernels::find(origStr, search, pos)) {
+          result.append(origStr, pos, found - pos).append(newStr);
+          pos = found + search.size();
+        }
+        result.append(origStr, pos, std::string::npos);
+        return result;
       }
       if (args[0].get().isList()) {
         List list = args[0].get().getList();
@@ -1451,15 +1689,287 @@ FunctionManager::FunctionManager() {
     attr.maxArity_ = 2;
     attr.isAlwaysPure_ = true;
     attr.body_ = [](const auto &args) -> Value {
-      if (args[0].get().isSet()) {
-        auto set = args[0].get().getSet();
-        auto newValue = args[1].get();
-        if (set.values.find(newValue) == set.values.end()) {
-          set.values.insert(newValue);
+      Value set = args[0].get();
+      if (!mutateInPlace("setadd", set, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return set;
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      if (!mutateInPlace("setadd", first, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return std::move(first);
+    };
+  }
+  {
+    auto &attr = functions_["setremove"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      Value set = args[0].get();
+      if (!mutateInPlace("setremove", set, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return set;
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      if (!mutateInPlace("setremove", first, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return std::move(first);
+    };
+  }
+  {
+    auto &attr = functions_["listappend"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      Value list = args[0].get();
+      if (!mutateInPlace("listappend", list, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return list;
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      if (!mutateInPlace("listappend", first, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return std::move(first);
+    };
+  }
+  {
+    auto &attr = functions_["listremoveat"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      Value list = args[0].get();
+      if (!mutateInPlace("listremoveat", list, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return list;
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      if (!mutateInPlace("listremoveat", first, args[1].get())) {
+        return Value::kNullBadType;
+      }
+      return std::move(first);
+    };
+  }
+  {
+    auto &attr = functions_["intersection"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [](const auto &lhs, const auto &rhs) -> Value {
+            std::vector<int64_t> result;
+            IntSetKernels::intersection(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result);
+            return intsToSet(result);
+          },
+          [](const Set &lhs, const Set &rhs) -> Value { return Set::set_intersection(lhs, rhs); });
+    };
+  }
+  {
+    auto &attr = functions_["union"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [](const auto &lhs, const auto &rhs) -> Value {
+            std::vector<int64_t> result;
+            IntSetKernels::setUnion(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result);
+            return intsToSet(result);
+          },
+          [](const Set &lhs, const Set &rhs) -> Value { return Set::set_union(lhs, rhs); });
+    };
+  }
+  {
+    auto &attr = functions_["difference"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [](const auto &lhs, const auto &rhs) -> Value {
+            std::vector<int64_t> result;
+            IntSetKernels::difference(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result);
+            return intsToSet(result);
+          },
+          [](const Set &lhs, const Set &rhs) -> Value { return Set::set_difference(lhs, rhs); });
+    };
+  }
+  {
+    // The size of the intersection, without building the intermediate set
+    auto &attr = functions_["intersection_size"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [](const auto &lhs, const auto &rhs) -> Value {
+            return static_cast<int64_t>(
+                IntSetKernels::intersectionSize(lhs.data(), lhs.size(), rhs.data(), rhs.size()));
+          },
+          [](const Set &lhs, const Set &rhs) -> Value {
+            const Set &small = lhs.size() <= rhs.size() ? lhs : rhs;
+            const Set &big = lhs.size() <= rhs.size() ? rhs : lhs;
+            int64_t count = 0;
+            for (const auto &v : small.values) {
+              count += big.contains(v);
+            }
+            return count;
+          });
+    };
+  }
+  {
+    // Whether all the elements of the second are in the first
+    auto &attr = functions_["containsall"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [](const auto &lhs, const auto &rhs) -> Value {
+            auto common =
+                IntSetKernels::intersectionSize(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+            return common == rhs.size();
+          },
+          [](const Set &lhs, const Set &rhs) -> Value {
+            for (const auto &v : rhs.values) {
+              if (!lhs.contains(v)) {
+                return false;
+              }
+            }
+            return true;
+          });
+    };
+  }
+  {
+    // The size of the intersection over the size of the union, 0 if both are empty
+    auto &attr = functions_["jaccard"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      auto jaccard = [](size_t lsize, size_t rsize, size_t common) -> Value {
+        auto unionSize = lsize + rsize - common;
+        return unionSize == 0 ? 0.0 : static_cast<double>(common) / unionSize;
+      };
+      return setOperation(
+          args[0].get(),
+          args[1].get(),
+          [&jaccard](const auto &lhs, const auto &rhs) -> Value {
+            return jaccard(
+                lhs.size(),
+                rhs.size(),
+                IntSetKernels::intersectionSize(lhs.data(), lhs.size(), rhs.data(), rhs.size()));
+          },
+          [&jaccard](const Set &lhs, const Set &rhs) -> Value {
+            const Set &small = lhs.size() <= rhs.size() ? lhs : rhs;
+            const Set &big = lhs.size() <= rhs.size() ? rhs : lhs;
+            size_t common = 0;
+            for (const auto &v : small.values) {
+              common += big.contains(v);
+            }
+            return jaccard(lhs.size(), rhs.size(), common);
+          });
+    };
+  }
+  {
+    auto &attr = functions_["list_sort"];
+    attr.minArity_ = 1;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return sortList(Value(args[0].get()), args, false);
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      return sortList(std::move(first), args, false);
+    };
+  }
+  {
+    // The k largest elements, or the smallest if ascending, in order
+    auto &attr = functions_["list_topk"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 3;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return sortList(Value(args[0].get()), args, true);
+    };
+    attr.moveBody_ = [](Value &&first, const auto &args) -> Value {
+      return sortList(std::move(first), args, true);
+    };
+  }
+  {
+    // The distinct elements in the order of their first occurrences
+    auto &attr = functions_["list_distinct"];
+    attr.minArity_ = 1;
+    attr.maxArity_ = 1;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      const auto &arg = args[0].get();
+      if (arg.isNull()) {
+        return Value::kNullValue;
+      }
+      if (!arg.isList()) {
+        return Value::kNullBadType;
+      }
+      const auto &values = arg.getList().values;
+      List result;
+      result.reserve(values.size());
+      std::unordered_set<Value> seen;
+      seen.reserve(values.size());
+      for (const auto &v : values) {
+        if (seen.emplace(v).second) {
+          result.emplace_back(v);
         }
-        return set;
       }
-      return Value::kNullBadType;
+      return result;
+    };
+  }
+  {
+    // list_slice(list, start[, end]), the elements in [start, end), the negative indexes count
+    // from the end, the same as the subscript
+    auto &attr = functions_["list_slice"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 3;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      const auto &arg = args[0].get();
+      if (arg.isNull()) {
+        return Value::kNullValue;
+      }
+      if (!arg.isList() || !args[1].get().isInt() ||
+          (args.size() == 3 && !args[2].get().isInt())) {
+        return Value::kNullBadType;
+      }
+      const auto &values = arg.getList().values;
+      int64_t size = values.size();
+      auto normalize = [size](int64_t index) {
+        return std::clamp<int64_t>(index < 0 ? index + size : index, 0, size);
+      };
+      auto begin = normalize(args[1].get().getInt());
+      auto end = args.size() == 3 ? normalize(args[2].get().getInt()) : size;
+      if (begin >= end) {
+        return List();
+      }
+      return List(std::vector<Value>(values.begin() + begin, values.begin() + end));
     };
   }
   {
@@ -1488,6 +1998,26 @@ FunctionManager::FunctionManager() {
         }
       }
     };
+    attr.moveBody_ = [](Value &&first, const auto &) -> Value {
+      switch (first.type()) {
+        case Value::Type::NULLVALUE: {
+          return Value::kNullValue;
+        }
+        case Value::Type::STRING: {
+          auto &str = first.mutableStr();
+          std::reverse(str.begin(), str.end());
+          return std::move(first);
+        }
+        case Value::Type::LIST: {
+          auto &values = first.mutableList().values;
+          std::reverse(values.begin(), values.end());
+          return std::move(first);
+        }
+        default: {
+          return Value::kNullBadType;
+        }
+      }
+    };
   }
   {
     auto &attr = functions_["split"];
@@ -1506,14 +2036,21 @@ FunctionManager::FunctionManager() {
           if (!args[1].get().isStr()) {
             return Value::kNullBadType;
           }
-          std::string origStr(args[0].get().getStr());
-          std::string delim(args[1].get().getStr());
+          const auto &origStr = args[0].get().getStr();
+          const auto &delim = args[1].get().getStr();
           List res;
-          std::vector<folly::StringPiece> substrings;
-          folly::split<folly::StringPiece>(delim, origStr, substrings);
-          for (auto str : substrings) {
-            res.emplace_back(str.toString());
+          if (delim.empty()) {
+            res.emplace_back(origStr);
+            return res;
           }
+          size_t pos = 0;
+          for (auto found = StringKernels::find(origStr, delim);
+               found != StringKernels::npos;
+               found = StringKernels::find(origStr, delim, pos)) {
+            res.emplace_back(origStr.substr(pos, found - pos));
+            pos = found + delim.size();
+          }
+          res.emplace_back(origStr.substr(pos));
           return res;
         }
         default: {
@@ -1589,7 +2126,19 @@ FunctionManager::FunctionManager() {
     attr.minArity_ = 1;
     attr.maxArity_ = 1;
     attr.isAlwaysPure_ = true;
-    attr.body_ = [](const auto &args) -> Value { return Value(args[0].get()).toSet(); };
+    attr.body_ = [](const auto &args) -> Value { return args[0].get().toSet(); };
+    attr.moveBody_ = [](Value &&first, const auto &) -> Value {
+      if (!first.isList()) {
+        return first.toSet();
+      }
+      Set set;
+      auto &values = first.mutableList().values;
+      set.values.reserve(values.size());
+      for (auto &item : values) {
+        set.values.emplace(std::move(item));
+      }
+      return set;
+    };
   }
   {
     auto &attr = functions_["lpad"];
@@ -1598,23 +2147,25 @@ FunctionManager::FunctionManager() {
     attr.isAlwaysPure_ = true;
     attr.body_ = [](const auto &args) -> Value {
       if (args[0].get().isStr() && args[1].get().isInt() && args[2].get().isStr()) {
-        auto value = args[0].get().getStr();
+        const auto &value = args[0].get().getStr();
         auto size = args[1].get().getInt();
         if (size < 0) {
           return std::string("");
         } else if (size < static_cast<int64_t>(value.size())) {
           return value.substr(0, static_cast<int32_t>(size));
         } else {
-          auto extra = args[2].get().getStr();
+          const auto &extra = args[2].get().getStr();
+          std::string result;
+          // An empty extra pads nothing
+          result.reserve(extra.empty() ? value.size() : size);
           size -= value.size();
-          std::stringstream stream;
-          while (size > static_cast<int64_t>(extra.size())) {
-            stream << extra;
+          while (!extra.empty() && size > static_cast<int64_t>(extra.size())) {
+            result.append(extra);
             size -= extra.size();
           }
-          stream << extra.substr(0, size);
-          stream << value;
-          return stream.str();
+          result.append(extra, 0, size);
+          result.append(value);
+          return result;
         }
       }
       return Value::kNullBadType;
@@ -1627,7 +2178,7 @@ FunctionManager::FunctionManager() {
     attr.isAlwaysPure_ = true;
     attr.body_ = [](const auto &args) -> Value {
       if (args[0].get().isStr() && args[1].get().isInt() && args[2].get().isStr()) {
-        auto value = args[0].get().getStr();
+        const auto &value = args[0].get().getStr();
         if (args[1].get().getInt() < 0) {
           return "";
         }
@@ -1635,16 +2186,18 @@ FunctionManager::FunctionManager() {
         if (size < value.size()) {
           return value.substr(0, static_cast<int32_t>(size));
         } else {
-          auto extra = args[2].get().getStr();
-          std::stringstream stream;
-          stream << value;
+          const auto &extra = args[2].get().getStr();
+          std::string result;
+          // An empty extra pads nothing
+          result.reserve(extra.empty() ? value.size() : size);
+          result.append(value);
           size -= value.size();
-          while (size > extra.size()) {
-            stream << extra;
+          while (!extra.empty() && size > extra.size()) {
+            result.append(extra);
             size -= extra.size();
           }
-          stream << extra.substr(0, size);
-          return stream.str();
+          result.append(extra, 0, size);
+          return result;
         }
       }
       return Value::kNullBadType;
@@ -1727,6 +2280,18 @@ FunctionManager::FunctionManager() {
     attr.maxArity_ = INT64_MAX;
     attr.isAlwaysPure_ = true;
     attr.body_ = [](const auto &args) -> Value {
+      // The similarity of two vectors
+      if (args.size() == 2 && args[0].get().isList() && args[1].get().isList()) {
+        return vectorOperation(args[0].get(), args[1].get(), [](const auto &x, const auto &y) {
+          auto s1 = VectorKernels::dot(x.data(), y.data(), x.size());
+          auto s2 = VectorKernels::dot(x.data(), x.data(), x.size());
+          auto s3 = VectorKernels::dot(y.data(), y.data(), y.size());
+          if (std::abs(s2) <= kEpsilon || std::abs(s3) <= kEpsilon) {
+            return static_cast<double>(-2);
+          }
+          return s1 / (std::sqrt(s2) * std::sqrt(s3));
+        });
+      }
       if (args.size() % 2 != 0) {
         LOG(ERROR) << "The number of arguments must be even.";
         // value range of cos is [-1, 1]
@@ -1755,6 +2320,28 @@ FunctionManager::FunctionManager() {
       }
     };
   }
+  {
+    auto &attr = functions_["dot_product"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return vectorOperation(args[0].get(), args[1].get(), [](const auto &x, const auto &y) {
+        return VectorKernels::dot(x.data(), y.data(), x.size());
+      });
+    };
+  }
+  {
+    auto &attr = functions_["l2_distance"];
+    attr.minArity_ = 2;
+    attr.maxArity_ = 2;
+    attr.isAlwaysPure_ = true;
+    attr.body_ = [](const auto &args) -> Value {
+      return vectorOperation(args[0].get(), args[1].get(), [](const auto &x, const auto &y) {
+        return std::sqrt(VectorKernels::squaredL2(x.data(), y.data(), x.size()));
+      });
+    };
+  }
   {
     auto &attr = functions_["size"];
     attr.minArity_ = 1;
@@ -2052,13 +2639,15 @@ FunctionManager::FunctionManager() {
         case Value::Type::VERTEX: {
           Map props;
           for (auto &tag : args[0].get().getVertex().tags) {
-            props.kvs.insert(tag.props.cbegin(), tag.props.cend());
+            for (const auto &prop : tag.props) {
+              props.kvs.emplace(prop.first, prop.second);
+            }
           }
           return Value(std::move(props));
         }
         case Value::Type::EDGE: {
           Map props;
-          props.kvs = args[0].get().getEdge().props;
+          props.kvs = args[0].get().getEdge().props.toMap();
           return Value(std::move(props));
         }
         case Value::Type::MAP: {
@@ -2372,14 +2961,14 @@ FunctionManager::FunctionManager() {
         }
         case Value::Type::VERTEX: {
           for (auto &tag : args[0].get().getVertex().tags) {
-            for (auto &prop : tag.props) {
+            for (const auto &prop : tag.props) {
               tmp.emplace(prop.first);
             }
           }
           break;
         }
         case Value::Type::EDGE: {
-          for (auto &prop : args[0].get().getEdge().props) {
+          for (const auto &prop : args[0].get().getEdge().props) {
             tmp.emplace(prop.first);
           }
           break;
@@ -2446,6 +3035,23 @@ FunctionManager::FunctionManager() {
         }
       }
     };
+    attr.moveBody_ = [](Value &&first, const auto &) -> Value {
+      switch (first.type()) {
+        case Value::Type::NULLVALUE: {
+          return Value::kNullValue;
+        }
+        case Value::Type::LIST: {
+          auto &values = first.mutableList().values;
+          if (!values.empty()) {
+            values.erase(values.begin());
+          }
+          return std::move(first);
+        }
+        default: {
+          return Value::kNullBadType;
+        }
+      }
+    };
   }
   {
     auto &attr = functions_["relationships"];
@@ -3112,6 +3718,25 @@ StatusOr<FunctionManager::Function> FunctionManager::get(const std::string &func
   return result.value().body_;
 }
 
+// static
+FunctionManager::MoveFunction FunctionManager::getMoveBody(const std::string &func, size_t arity) {
+  auto result = instance().getInternal(func, arity);
+  if (!result.ok()) {
+    return nullptr;
+  }
+  return result.value().moveBody_;
+}
+
+// static
+FunctionManager::BatchFunction FunctionManager::getBatchBody(const std::string &func,
+                                                             size_t arity) {
+  auto result = instance().getInternal(func, arity);
+  if (!result.ok()) {
+    return nullptr;
+  }
+  return result.value().batchBody_;
+}
+
 // static
 Status FunctionManager::find(const std::string &func, const size_t arity) {
   auto result = instance().getInternal(func, arity);
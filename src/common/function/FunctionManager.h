@@ -10,6 +10,7 @@
 
 #include "common/base/Status.h"
 #include "common/base/StatusOr.h"
+#include "common/datatypes/ColumnBatch.h"
 #include "common/datatypes/Value.h"
 
 /**
@@ -33,12 +34,29 @@ class FunctionManager final {
  public:
   using ArgType = std::reference_wrapper<const Value>;
   using Function = std::function<Value(const std::vector<ArgType> &)>;
+  // The body of a function taking the ownership of its first argument, which is a temporary not
+  // used by the caller any more, so a container could be changed in place and moved to the return.
+  // args[0] refers to the first, which should only be accessed by first.
+  using MoveFunction = std::function<Value(Value &&first, const std::vector<ArgType> &args)>;
+  // The body evaluating size rows at once, args are the columns of the arguments of the rows, and
+  // the results are returned in a column of size values.
+  using BatchFunction = std::function<Column(const std::vector<const Column *> &args, size_t size)>;
 
   /**
    * To obtain a function named `func', with the actual arity.
    */
   static StatusOr<Function> get(const std::string &func, size_t arity);
 
+  /**
+   * To obtain the body of `func' taking the ownership of its first argument, nullptr if none.
+   */
+  static MoveFunction getMoveBody(const std::string &func, size_t arity);
+
+  /**
+   * To obtain the body of `func' evaluating the rows in batch, nullptr if none.
+   */
+  static BatchFunction getBatchBody(const std::string &func, size_t arity);
+
   /**
    * To Check the validity of the function named `func', with the actual arity.
    * Only used for parser check.
@@ -63,6 +81,13 @@ class FunctionManager final {
   static StatusOr<Value::Type> getReturnType(const std::string &funcName,
                                              const std::vector<Value::Type> &argsType);
 
+  /**
+   * To apply the collection mutation `func', i.e. setadd, setremove, listappend
+   * or listremoveat, on `container' in place rather than on a copy of it.
+   * Return false if `func' is not such a function or the arguments mismatch.
+   */
+  static bool mutateInPlace(const std::string &func, Value &container, const Value &operand);
+
   // The attributes of the function call
   struct FunctionAttributes final {
     size_t minArity_{0};
@@ -78,6 +103,10 @@ class FunctionManager final {
     // allocating huge amount of memory for these functions.
     bool isAlwaysPure_{false};
     Function body_;
+    // The same as body_ but takes the ownership of the first argument, optional
+    MoveFunction moveBody_;
+    // The same as body_ but over the columns of many rows, optional
+    BatchFunction batchBody_;
   };
 
   // Sets the function to NON-pure for all numbers of arity it take, which means the function is
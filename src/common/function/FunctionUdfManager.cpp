@@ -22,6 +22,8 @@ static std::unordered_map<std::string, Value::Type> udfFunReturnType_;
 static std::unordered_map<std::string, std::vector<std::vector<nebula::Value::Type>>>
     udfFunInputType_;
 std::unordered_map<std::string, FunctionManager::FunctionAttributes> udfFunctions_;
+// The libraries loaded by the paths, which are kept open so they are not loaded again at each call
+static std::unordered_map<std::string, void *> udfHandles_;
 
 std::atomic<bool> expired_{};
 std::atomic<bool> try_to_expire_{};
@@ -70,6 +72,14 @@ FunctionUdfManager::destroy_f *FunctionUdfManager::deleteGraphFunctionClass(void
   return destroy_func;
 }
 
+FunctionUdfManager::create_batch_f *FunctionUdfManager::getGraphBatchFunctionClass(
+    void *func_handle) {
+  auto *create_func = reinterpret_cast<create_batch_f *>(dlsym(func_handle, "createBatch"));
+  // Not an error, the batch function is optional
+  dlerror();
+  return create_func;
+}
+
 FunctionUdfManager::FunctionUdfManager() {
   initAndLoadSoFunction();
   expired_ = true;
@@ -98,9 +108,17 @@ void FunctionUdfManager::initAndLoadSoFunction() {
     std::string so_path_string = path + file;
     const char *soPath = so_path_string.c_str();
     try {
-      void *func_handle = dlopen(soPath, RTLD_LAZY);
-      if (!func_handle) {
-        LOG(ERROR) << "Cannot load udf library: " << dlerror();
+      auto handleIter = udfHandles_.find(so_path_string);
+      void *func_handle = nullptr;
+      if (handleIter != udfHandles_.end()) {
+        func_handle = handleIter->second;
+      } else {
+        func_handle = dlopen(soPath, RTLD_LAZY);
+        if (!func_handle) {
+          LOG(ERROR) << "Cannot load udf library: " << dlerror();
+          continue;
+        }
+        udfHandles_.emplace(so_path_string, func_handle);
       }
       dlerror();
 
@@ -115,10 +133,9 @@ void FunctionUdfManager::initAndLoadSoFunction() {
       char *funName = gf->name();
       udfFunInputType_.emplace(funName, gf->inputType());
       udfFunReturnType_.emplace(funName, gf->returnType());
-      addSoUdfFunction(funName, soPath, gf->minArity(), gf->maxArity(), gf->isPure());
+      addSoUdfFunction(funName, func_handle, gf->minArity(), gf->maxArity(), gf->isPure());
 
       destroy_func(gf);
-      dlclose(func_handle);
     } catch (...) {
       LOG(ERROR) << "load So library Error: " << soPath;
     }
@@ -172,33 +189,36 @@ StatusOr<const FunctionManager::FunctionAttributes> nebula::FunctionUdfManager::
 }
 
 void FunctionUdfManager::addSoUdfFunction(
-    char *funName, const char *soPath, size_t minArity, size_t maxArity, bool isPure) {
+    char *funName, void *func_handle, size_t minArity, size_t maxArity, bool isPure) {
   auto &attr = udfFunctions_[funName];
   attr.minArity_ = minArity;
   attr.maxArity_ = maxArity;
   attr.isAlwaysPure_ = isPure;
-  std::string path = soPath;
-  attr.body_ = [path](const auto &args) -> Value {
+  // The library stays open, only the function object is created for each call
+  create_f *create_func = getGraphFunctionClass(func_handle);
+  destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
+  attr.body_ = [create_func, destroy_func](const auto &args) -> Value {
     try {
-      char *soPath2 = const_cast<char *>(path.c_str());
-      void *func_handle = dlopen(soPath2, RTLD_LAZY);
-      if (!func_handle) {
-        LOG(ERROR) << "Cannot load udf library: " << dlerror();
-      }
-      dlerror();
-
-      create_f *create_func = getGraphFunctionClass(func_handle);
-      destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
-
-      GraphFunction *gf = create_func();
-      Value res = gf->body(args);
-      destroy_func(gf);
-      dlclose(func_handle);
-      return res;
+      std::unique_ptr<GraphFunction, destroy_f *> gf(create_func(), destroy_func);
+      return gf->body(args);
     } catch (...) {
       return Value::kNullBadData;
     }
   };
+  create_batch_f *create_batch_func = getGraphBatchFunctionClass(func_handle);
+  if (create_batch_func == nullptr) {
+    attr.batchBody_ = nullptr;
+    return;
+  }
+  attr.batchBody_ = [create_batch_func, destroy_func](const auto &args, size_t size) -> Column {
+    try {
+      std::unique_ptr<GraphBatchFunction, destroy_f *> gf(create_batch_func(), destroy_func);
+      return gf->bodyBatch(args, size);
+    } catch (...) {
+      // The evaluator takes a column of the wrong size as BAD_DATA
+      return Column();
+    }
+  };
 }
 
 }  // namespace nebula
@@ -17,6 +17,7 @@ class FunctionUdfManager {
  public:
   typedef GraphFunction *(create_f)();
   typedef void(destroy_f)(GraphFunction *);
+  typedef GraphBatchFunction *(create_batch_f)();
 
   static StatusOr<Value::Type> getUdfReturnType(const std::string functionName,
                                                 const std::vector<Value::Type> &argsType);
@@ -31,8 +32,14 @@ class FunctionUdfManager {
  private:
   static create_f *getGraphFunctionClass(void *func_handle);
   static destroy_f *deleteGraphFunctionClass(void *func_handle);
-
-  void addSoUdfFunction(char *funName, const char *soPath, size_t i, size_t i1, bool b);
+  // nullptr if the library has no batch function
+  static create_batch_f *getGraphBatchFunctionClass(void *func_handle);
+
+  void addSoUdfFunction(char *funName,
+                        void *func_handle,
+                        size_t minArity,
+                        size_t maxArity,
+                        bool isPure);
   void initAndLoadSoFunction();
 };
 
@@ -8,12 +8,16 @@
 
 #include <vector>
 
+#include "common/datatypes/ColumnBatch.h"
 #include "common/datatypes/Value.h"
 
 class GraphFunction;
+class GraphBatchFunction;
 
 extern "C" GraphFunction *create();
 extern "C" void destroy(GraphFunction *function);
+// Optional, exported by the libraries of the batch functions only
+extern "C" GraphBatchFunction *createBatch();
 
 class GraphFunction {
  public:
@@ -35,4 +39,16 @@ class GraphFunction {
       const std::vector<std::reference_wrapper<const nebula::Value>> &args) = 0;
 };
 
+// A function which also evaluates many rows in a call, whose library exports createBatch besides
+// create and destroy. The rows are passed as the columns of the arguments, where the values of the
+// same BOOL, INT, FLOAT or STRING type are unboxed in the typed vectors, e.g. Column::ints(), so
+// the call and the Value marshaling of each row are saved.
+class GraphBatchFunction : public GraphFunction {
+ public:
+  // The results of the size rows, args[i] is the column of the i-th argument of the rows. The
+  // column returned should have size values, otherwise the results are all BAD_DATA.
+  virtual nebula::Column bodyBatch(const std::vector<const nebula::Column *> &args,
+                                   size_t size) = 0;
+};
+
 #endif  // COMMON_FUNCTION_GRAPHFUNCTION_H
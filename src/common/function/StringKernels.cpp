@@ -0,0 +1,189 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/function/StringKernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "common/base/Base.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define NEBULA_STRING_KERNELS_X86 1
+#endif
+
+namespace nebula {
+
+namespace {
+
+// Flip the case of the bytes in [first, last], i.e. of the ASCII letters of one case
+void scalarFlipCase(char* data, size_t size, char first, char last) {
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] >= first && data[i] <= last) {
+      data[i] = static_cast<char>(data[i] ^ 0x20);
+    }
+  }
+}
+
+int lowerChar(unsigned char c) {
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+// Compare from i, where the string ended is taken as NUL
+int scalarCaseCompare(folly::StringPiece lhs, folly::StringPiece rhs, size_t i) {
+  for (;; ++i) {
+    int l = i < lhs.size() ? lowerChar(lhs[i]) : 0;
+    int r = i < rhs.size() ? lowerChar(rhs[i]) : 0;
+    if (l != r || l == 0) {
+      return l - r;
+    }
+  }
+}
+
+#ifdef NEBULA_STRING_KERNELS_X86
+
+// The bytes of v in [first, last] get their case flipped. The compares are signed, so the bytes
+// not of ASCII, which are negative, are never in the range.
+__attribute__((target("avx2"))) inline __m256i avx2FlipCaseVec(__m256i v, char first, char last) {
+  auto in = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(first - 1))),
+                             _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), v));
+  return _mm256_xor_si256(v, _mm256_and_si256(in, _mm256_set1_epi8(0x20)));
+}
+
+// The bytes of the whole vectors are done, returns how many they are
+__attribute__((target("avx2"))) size_t avx2FlipCase(char* data,
+                                                    size_t size,
+                                                    char first,
+                                                    char last) {
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    auto* p = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(p, avx2FlipCaseVec(_mm256_loadu_si256(p), first, last));
+  }
+  return i;
+}
+
+// The candidates are the positions whose first and last bytes match the needle, which are checked
+// by memcmp then. Returns the position stopped at in end if there is no match before it.
+__attribute__((target("avx2"))) size_t avx2Find(
+    const char* s, size_t n, const char* needle, size_t k, size_t pos, size_t& end) {
+  auto first = _mm256_set1_epi8(needle[0]);
+  auto last = _mm256_set1_epi8(needle[k - 1]);
+  size_t i = pos;
+  for (; i + k - 1 + 32 <= n; i += 32) {
+    auto bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    auto bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + k - 1));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl))));
+    while (mask != 0) {
+      auto bit = static_cast<size_t>(__builtin_ctz(mask));
+      if (k <= 2 || std::memcmp(s + i + bit + 1, needle + 1, k - 2) == 0) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  end = i;
+  return StringKernels::npos;
+}
+
+// Skip the blocks equal regardless of case and without NUL, returns where the difference may be
+__attribute__((target("avx2"))) size_t avx2CaseEqualPrefix(const char* lhs,
+                                                           const char* rhs,
+                                                           size_t n) {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    l = avx2FlipCaseVec(l, 'A', 'Z');
+    r = avx2FlipCaseVec(r, 'A', 'Z');
+    auto eq = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r)));
+    auto nul = _mm256_movemask_epi8(_mm256_cmpeq_epi8(l, _mm256_setzero_si256()));
+    if (eq != 0xFFFFFFFFu || nul != 0) {
+      break;
+    }
+  }
+  return i;
+}
+
+#endif  // NEBULA_STRING_KERNELS_X86
+
+void flipCase(char* data, size_t size, char first, char last, StringKernels::Isa isa) {
+  size_t done = 0;
+#ifdef NEBULA_STRING_KERNELS_X86
+  if (isa == StringKernels::Isa::kAVX2) {
+    done = avx2FlipCase(data, size, first, last);
+  }
+#else
+  UNUSED(isa);
+#endif
+  scalarFlipCase(data + done, size - done, first, last);
+}
+
+}  // namespace
+
+StringKernels::Isa StringKernels::detectIsa() {
+#ifdef NEBULA_STRING_KERNELS_X86
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return Isa::kAVX2;
+    }
+    return Isa::kScalar;
+  }();
+  return isa;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+void StringKernels::toLowerAscii(char* data, size_t size, Isa isa) {
+  flipCase(data, size, 'A', 'Z', isa);
+}
+
+void StringKernels::toUpperAscii(char* data, size_t size, Isa isa) {
+  flipCase(data, size, 'a', 'z', isa);
+}
+
+size_t StringKernels::find(folly::StringPiece haystack,
+                           folly::StringPiece needle,
+                           size_t pos,
+                           Isa isa) {
+  DCHECK(!needle.empty());
+  if (pos >= haystack.size() || needle.size() > haystack.size() - pos) {
+    return npos;
+  }
+#ifdef NEBULA_STRING_KERNELS_X86
+  if (isa == Isa::kAVX2) {
+    size_t end = pos;
+    auto found = avx2Find(haystack.data(), haystack.size(), needle.data(), needle.size(), pos, end);
+    if (found != npos) {
+      return found;
+    }
+    pos = end;
+  }
+#else
+  UNUSED(isa);
+#endif
+  auto found = std::string_view(haystack.data(), haystack.size())
+                   .find(std::string_view(needle.data(), needle.size()), pos);
+  return found == std::string_view::npos ? npos : found;
+}
+
+int StringKernels::caseCompare(folly::StringPiece lhs, folly::StringPiece rhs, Isa isa) {
+  size_t i = 0;
+#ifdef NEBULA_STRING_KERNELS_X86
+  if (isa == Isa::kAVX2) {
+    i = avx2CaseEqualPrefix(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+  }
+#else
+  UNUSED(isa);
+#endif
+  return scalarCaseCompare(lhs, rhs, i);
+}
+
+}  // namespace nebula
@@ -0,0 +1,54 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_FUNCTION_STRINGKERNELS_H_
+#define COMMON_FUNCTION_STRINGKERNELS_H_
+
+#include <folly/Range.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nebula {
+
+/**
+ * The byte kernels of the string functions. The case mapping, the search and the case insensitive
+ * comparison are vectorized with AVX2 when the CPU supports it, which is detected once at runtime.
+ * Otherwise, and for the bytes left over by the vectors, they are done one byte at a time.
+ *
+ * The case of the ASCII letters is mapped only, the other bytes, e.g. of the multi-byte UTF-8
+ * characters, are kept as they are, the same as the functions did byte by byte.
+ */
+class StringKernels final {
+ public:
+  enum class Isa : uint8_t {
+    kScalar = 0,
+    kAVX2 = 1,
+  };
+
+  // The best instruction set supported by the current CPU
+  static Isa detectIsa();
+
+  // Map the ASCII letters in data to lower case in place
+  static void toLowerAscii(char* data, size_t size, Isa isa = detectIsa());
+
+  // Map the ASCII letters in data to upper case in place
+  static void toUpperAscii(char* data, size_t size, Isa isa = detectIsa());
+
+  // The position of the first needle in haystack from pos, or npos if there is none. The needle
+  // must not be empty.
+  static size_t find(folly::StringPiece haystack,
+                     folly::StringPiece needle,
+                     size_t pos = 0,
+                     Isa isa = detectIsa());
+
+  // The same as ::strcasecmp on the strings, i.e. they are compared until the first NUL of either
+  static int caseCompare(folly::StringPiece lhs, folly::StringPiece rhs, Isa isa = detectIsa());
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+};
+
+}  // namespace nebula
+#endif  // COMMON_FUNCTION_STRINGKERNELS_H_
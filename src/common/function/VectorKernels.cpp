@@ -0,0 +1,134 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/function/VectorKernels.h"
+
+#include "common/base/Base.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Value.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define NEBULA_VECTOR_KERNELS_X86 1
+#endif
+
+namespace nebula {
+
+namespace {
+
+#ifdef NEBULA_VECTOR_KERNELS_X86
+
+__attribute__((target("avx2"))) inline double avx2Sum(__m256d acc) {
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// The elements of the whole vectors are done, whose number is returned in done
+__attribute__((target("avx2"))) double avx2Dot(const double* x,
+                                               const double* y,
+                                               size_t size,
+                                               size_t& done) {
+  auto acc0 = _mm256_setzero_pd();
+  auto acc1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    acc1 = _mm256_add_pd(acc1,
+                         _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+  }
+  for (; i + 4 <= size; i += 4) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+  }
+  done = i;
+  return avx2Sum(_mm256_add_pd(acc0, acc1));
+}
+
+__attribute__((target("avx2"))) double avx2SquaredL2(const double* x,
+                                                     const double* y,
+                                                     size_t size,
+                                                     size_t& done) {
+  auto acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    auto diff = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(diff, diff));
+  }
+  done = i;
+  return avx2Sum(acc);
+}
+
+#endif  // NEBULA_VECTOR_KERNELS_X86
+
+}  // namespace
+
+VectorKernels::Isa VectorKernels::detectIsa() {
+#ifdef NEBULA_VECTOR_KERNELS_X86
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return Isa::kAVX2;
+    }
+    return Isa::kScalar;
+  }();
+  return isa;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+double VectorKernels::dot(const double* x, const double* y, size_t size, Isa isa) {
+  double sum = 0;
+  size_t i = 0;
+#ifdef NEBULA_VECTOR_KERNELS_X86
+  if (isa == Isa::kAVX2) {
+    sum = avx2Dot(x, y, size, i);
+  }
+#else
+  UNUSED(isa);
+#endif
+  for (; i < size; ++i) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+double VectorKernels::squaredL2(const double* x, const double* y, size_t size, Isa isa) {
+  double sum = 0;
+  size_t i = 0;
+#ifdef NEBULA_VECTOR_KERNELS_X86
+  if (isa == Isa::kAVX2) {
+    sum = avx2SquaredL2(x, y, size, i);
+  }
+#else
+  UNUSED(isa);
+#endif
+  for (; i < size; ++i) {
+    auto diff = x[i] - y[i];
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+bool VectorKernels::toDoubles(const Value& list, std::vector<double>& result) {
+  if (!list.isList()) {
+    return false;
+  }
+  const auto& values = list.getList().values;
+  result.clear();
+  result.reserve(values.size());
+  for (const auto& value : values) {
+    if (value.isFloat()) {
+      result.emplace_back(value.getFloat());
+    } else if (value.isInt()) {
+      result.emplace_back(static_cast<double>(value.getInt()));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace nebula
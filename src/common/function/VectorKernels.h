@@ -0,0 +1,46 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_FUNCTION_VECTORKERNELS_H_
+#define COMMON_FUNCTION_VECTORKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula {
+
+struct Value;
+
+/**
+ * The kernels of the similarity functions over the vectors of floats, e.g. the embeddings kept
+ * in the LIST_FLOAT properties. They are vectorized with AVX2 when the CPU supports it, which is
+ * detected once at runtime, and done one element at a time otherwise.
+ *
+ * The sums are accumulated in the lanes of the vectors, so they may differ from the ones added
+ * in order in the last bits.
+ */
+class VectorKernels final {
+ public:
+  enum class Isa : uint8_t {
+    kScalar = 0,
+    kAVX2 = 1,
+  };
+
+  // The best instruction set supported by the current CPU
+  static Isa detectIsa();
+
+  // sum(x[i] * y[i])
+  static double dot(const double* x, const double* y, size_t size, Isa isa = detectIsa());
+
+  // sum((x[i] - y[i])^2)
+  static double squaredL2(const double* x, const double* y, size_t size, Isa isa = detectIsa());
+
+  // The numbers of the list as floats, false if it's not a list of numbers
+  static bool toDoubles(const Value& list, std::vector<double>& result);
+};
+
+}  // namespace nebula
+#endif  // COMMON_FUNCTION_VECTORKERNELS_H_
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
 #include "common/datatypes/Set.h"
 #include "common/function/AggFunctionManager.h"
 #include "common/time/TimeUtils.h"
@@ -127,6 +128,105 @@ TEST_F(AggFunctionManagerTest, aggFunc) {
   }
 }
 
+TEST_F(AggFunctionManagerTest, merge) {
+  // Merging the partial states of the split data gives the same result as the whole data
+  std::vector<Value> data = {3, 1, NullType::__NULL__, 4, 1, 5, Value(), 9, 2, 6};
+  for (auto name : {"",
+                    "count",
+                    "sum",
+                    "avg",
+                    "max",
+                    "min",
+                    "std",
+                    "bit_and",
+                    "bit_or",
+                    "bit_xor",
+                    "collect",
+                    "collect_set",
+                    "approx_count_distinct"}) {
+    auto aggFunc = AggFunctionManager::get(name).value();
+    auto merge = AggFunctionManager::getMerge(name);
+    ASSERT_TRUE(merge.ok()) << name;
+    AggData whole;
+    for (auto& v : data) {
+      aggFunc(&whole, v);
+    }
+    for (size_t split = 1; split < data.size(); ++split) {
+      AggData first, second;
+      for (size_t i = 0; i < data.size(); ++i) {
+        aggFunc(i < split ? &first : &second, data[i]);
+      }
+      merge.value()(&first, second);
+      EXPECT_EQ(whole.result(), first.result()) << name << " split at " << split;
+    }
+  }
+  {
+    // A bad partial state makes the merged one bad
+    auto merge = AggFunctionManager::getMerge("sum").value();
+    AggData good, bad;
+    good.setResult(1);
+    bad.setResult(Value::kNullBadType);
+    merge(&good, bad);
+    EXPECT_TRUE(good.result().isBadNull());
+  }
+  EXPECT_FALSE(AggFunctionManager::getMerge("unknown").ok());
+}
+
+TEST_F(AggFunctionManagerTest, approxFunc) {
+  {
+    TEST_FUNCTION(approx_count_distinct, testData_["empty"], 0);
+    TEST_FUNCTION(approx_count_distinct, testData_["null"], 0);
+    TEST_FUNCTION(approx_count_distinct, testData_["int"], 3);
+    TEST_FUNCTION(approx_count_distinct, std::vector<Value>({1, "a", 1, "a", 2.5}), 3);
+  }
+  {
+    TEST_FUNCTION(approx_quantiles, testData_["empty"], Value::kNullValue);
+    TEST_FUNCTION(approx_quantiles, testData_["null"], Value::kNullValue);
+    TEST_FUNCTION(approx_quantiles, std::vector<Value>({1, "a", 2}), Value::kNullBadType);
+    TEST_FUNCTION(approx_quantiles,
+                  std::vector<Value>({3}),
+                  Value(Map({{"min", Value(3.0)},
+                             {"p25", Value(3.0)},
+                             {"p50", Value(3.0)},
+                             {"p75", Value(3.0)},
+                             {"p90", Value(3.0)},
+                             {"p95", Value(3.0)},
+                             {"p99", Value(3.0)},
+                             {"max", Value(3.0)}})));
+  }
+  {
+    // The estimates of many values merged from the partial states
+    auto count = AggFunctionManager::get("approx_count_distinct").value();
+    auto countMerge = AggFunctionManager::getMerge("approx_count_distinct").value();
+    auto quantiles = AggFunctionManager::get("approx_quantiles").value();
+    auto quantilesMerge = AggFunctionManager::getMerge("approx_quantiles").value();
+    constexpr int64_t kNum = 100000;
+    AggData countParts[2], quantilesParts[2];
+    for (int64_t i = 1; i <= kNum; ++i) {
+      count(&countParts[i % 2], i);
+      count(&countParts[(i + 1) % 2], i);
+      quantiles(&quantilesParts[i % 2], i);
+    }
+    countMerge(&countParts[0], countParts[1]);
+    quantilesMerge(&quantilesParts[0], quantilesParts[1]);
+    EXPECT_NEAR(countParts[0].result().getInt(), kNum, kNum * 0.03);
+    const auto& result = quantilesParts[0].result().getMap();
+    EXPECT_EQ(1.0, result.at("min").getFloat());
+    EXPECT_EQ(kNum, result.at("max").getFloat());
+    EXPECT_NEAR(result.at("p50").getFloat(), kNum * 0.5, kNum * 0.01);
+    EXPECT_NEAR(result.at("p99").getFloat(), kNum * 0.99, kNum * 0.001);
+  }
+  {
+    auto merge = AggFunctionManager::getMerge("approx_quantiles").value();
+    auto quantiles = AggFunctionManager::get("approx_quantiles").value();
+    AggData good, bad;
+    quantiles(&good, 1);
+    quantiles(&bad, "a");
+    merge(&good, bad);
+    EXPECT_TRUE(good.result().isBadNull());
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
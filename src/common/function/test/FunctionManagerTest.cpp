@@ -2066,6 +2066,132 @@ TEST_F(FunctionManagerTest, Any) {
   { TEST_FUNCTION(_any, std::vector<Value>({Value(1)}), Value(1)); }
 }
 
+TEST_F(FunctionManagerTest, CollectionMutation) {
+  Value set(Set({1, 2}));
+  Value list(List({1, 2, 3}));
+  {
+    TEST_FUNCTION(setadd, std::vector<Value>({set, 3}), Value(Set({1, 2, 3})));
+    TEST_FUNCTION(setadd, std::vector<Value>({set, 2}), set);
+    TEST_FUNCTION(setremove, std::vector<Value>({set, 2}), Value(Set({1})));
+    TEST_FUNCTION(setremove, std::vector<Value>({set, 5}), set);
+    TEST_FUNCTION(setremove, std::vector<Value>({list, 1}), Value::kNullBadType);
+  }
+  {
+    TEST_FUNCTION(listappend, std::vector<Value>({list, 1}), Value(List({1, 2, 3, 1})));
+    TEST_FUNCTION(listremoveat, std::vector<Value>({list, 0}), Value(List({2, 3})));
+    TEST_FUNCTION(listremoveat, std::vector<Value>({list, -1}), Value(List({1, 2})));
+    TEST_FUNCTION(listremoveat, std::vector<Value>({list, 3}), list);
+    TEST_FUNCTION(listremoveat, std::vector<Value>({list, "a"}), Value::kNullBadType);
+    TEST_FUNCTION(listappend, std::vector<Value>({set, 1}), Value::kNullBadType);
+  }
+  {
+    Value target = list;
+    EXPECT_TRUE(FunctionManager::mutateInPlace("ListAppend", target, 4));
+    EXPECT_EQ(Value(List({1, 2, 3, 4})), target);
+    EXPECT_FALSE(FunctionManager::mutateInPlace("erase", target, 4));
+  }
+}
+
+TEST_F(FunctionManagerTest, SetOperations) {
+  auto intSet = [](std::vector<int64_t> ints) { return Value(Set::createFromVector(ints)); };
+  Value lhs = intSet({1, 2, 3, 4, 5});
+  Value rhs(List({4, 5, 6, 4}));
+  {
+    TEST_FUNCTION(intersection, std::vector<Value>({lhs, rhs}), intSet({4, 5}));
+    TEST_FUNCTION(union, std::vector<Value>({lhs, rhs}), intSet({1, 2, 3, 4, 5, 6}));
+    TEST_FUNCTION(difference, std::vector<Value>({lhs, rhs}), intSet({1, 2, 3}));
+    TEST_FUNCTION(difference, std::vector<Value>({rhs, lhs}), intSet({6}));
+    TEST_FUNCTION(intersection_size, std::vector<Value>({lhs, rhs}), 2);
+    TEST_FUNCTION(intersection_size, std::vector<Value>({lhs, intSet({})}), 0);
+  }
+  // Not all integers
+  {
+    Value strs(Set::createFromVector(std::vector<std::string>{"a", "b"}));
+    Value mixed(List({"b", 1}));
+    TEST_FUNCTION(intersection,
+                  std::vector<Value>({strs, mixed}),
+                  Value(Set::createFromVector(std::vector<std::string>{"b"})));
+    TEST_FUNCTION(union, std::vector<Value>({strs, mixed}), Value(Set({"a", "b", 1})));
+    TEST_FUNCTION(difference,
+                  std::vector<Value>({strs, mixed}),
+                  Value(Set::createFromVector(std::vector<std::string>{"a"})));
+    TEST_FUNCTION(intersection_size, std::vector<Value>({mixed, strs}), 1);
+  }
+  {
+    TEST_FUNCTION(intersection, std::vector<Value>({lhs, Value::kNullValue}), Value::kNullValue);
+    TEST_FUNCTION(union, std::vector<Value>({lhs, Value(1)}), Value::kNullBadType);
+  }
+  {
+    TEST_FUNCTION(containsall, std::vector<Value>({lhs, intSet({5, 1})}), true);
+    TEST_FUNCTION(containsall, std::vector<Value>({lhs, rhs}), false);
+    TEST_FUNCTION(containsall, std::vector<Value>({lhs, intSet({})}), true);
+    Value strList(List({"b", 1}));
+    TEST_FUNCTION(containsall, std::vector<Value>({Value(List({"b", 1, "a"})), strList}), true);
+    TEST_FUNCTION(jaccard, std::vector<Value>({lhs, rhs}), 2.0 / 6);
+    TEST_FUNCTION(jaccard, std::vector<Value>({intSet({}), intSet({})}), 0.0);
+    TEST_FUNCTION(jaccard, std::vector<Value>({Value(List({"b", 2})), strList}), 1.0 / 3);
+    TEST_FUNCTION(jaccard, std::vector<Value>({Value::kNullValue, rhs}), Value::kNullValue);
+  }
+}
+
+TEST_F(FunctionManagerTest, ListOperations) {
+  Value ints(List({3, 1, 4, 1, 5, 9, 2, 6}));
+  Value mixed(List({"b", 2, "a", 1.5, 2}));
+  {
+    TEST_FUNCTION(list_sort, std::vector<Value>({ints}), Value(List({1, 1, 2, 3, 4, 5, 6, 9})));
+    TEST_FUNCTION(
+        list_sort, std::vector<Value>({ints, false}), Value(List({9, 6, 5, 4, 3, 2, 1, 1})));
+    TEST_FUNCTION(list_sort, std::vector<Value>({mixed}), Value(List({1.5, 2, 2, "a", "b"})));
+    TEST_FUNCTION(list_sort, std::vector<Value>({ints, 1}), Value::kNullBadType);
+  }
+  {
+    TEST_FUNCTION(list_topk, std::vector<Value>({ints, 3}), Value(List({9, 6, 5})));
+    TEST_FUNCTION(list_topk, std::vector<Value>({ints, 3, true}), Value(List({1, 1, 2})));
+    TEST_FUNCTION(list_topk, std::vector<Value>({ints, 0}), Value(List()));
+    TEST_FUNCTION(list_topk, std::vector<Value>({mixed, 2}), Value(List({"b", "a"})));
+    TEST_FUNCTION(list_topk, std::vector<Value>({Value(List({1, 2})), 5}), Value(List({2, 1})));
+  }
+  {
+    TEST_FUNCTION(list_distinct, std::vector<Value>({ints}), Value(List({3, 1, 4, 5, 9, 2, 6})));
+    TEST_FUNCTION(list_distinct, std::vector<Value>({mixed}), Value(List({"b", 2, "a", 1.5})));
+    TEST_FUNCTION(list_distinct, std::vector<Value>({Value::kNullValue}), Value::kNullValue);
+  }
+  {
+    TEST_FUNCTION(list_slice, std::vector<Value>({ints, 1, 3}), Value(List({1, 4})));
+    TEST_FUNCTION(list_slice, std::vector<Value>({ints, -2}), Value(List({2, 6})));
+    TEST_FUNCTION(list_slice, std::vector<Value>({ints, -100, 2}), Value(List({3, 1})));
+    TEST_FUNCTION(list_slice, std::vector<Value>({ints, 5, 2}), Value(List()));
+    TEST_FUNCTION(list_slice, std::vector<Value>({ints, "1"}), Value::kNullBadType);
+  }
+}
+
+TEST_F(FunctionManagerTest, VectorFunctions) {
+  // Long enough to be done by the vectors
+  Value x(List({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  Value y(List({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}));
+  Value z(List({3.0, 0.0, 4.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}));
+  Value empty(List({0, 0, 0, 0, 0, 0, 0, 0, 0}));
+  {
+    TEST_FUNCTION(dot_product, std::vector<Value>({x, y}), 285.0);
+    TEST_FUNCTION(dot_product, std::vector<Value>({x, z}), 15.0);
+    TEST_FUNCTION(dot_product, std::vector<Value>({x, Value(List({1, 2}))}), Value::kNullBadData);
+    TEST_FUNCTION(dot_product, std::vector<Value>({x, Value(List({"a"}))}), Value::kNullBadType);
+    TEST_FUNCTION(dot_product, std::vector<Value>({x, Value::kNullValue}), Value::kNullValue);
+  }
+  {
+    TEST_FUNCTION(l2_distance, std::vector<Value>({z, empty}), 5.0);
+    TEST_FUNCTION(l2_distance, std::vector<Value>({x, y}), 0.0);
+  }
+  {
+    TEST_FUNCTION(cos_similarity, std::vector<Value>({x, y}), 1.0);
+    TEST_FUNCTION(cos_similarity, std::vector<Value>({z, Value(List({0, 0, 5, 0, 0, 0, 0, 0, 0}))}),
+                  0.8);
+    TEST_FUNCTION(cos_similarity, std::vector<Value>({x, empty}), -2.0);
+    // The numbers as the arguments
+    TEST_FUNCTION(cos_similarity, std::vector<Value>({3, 4, 3, 4}), 1.0);
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
@@ -0,0 +1,111 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+#include <strings.h>
+
+#include "common/base/Base.h"
+#include "common/function/StringKernels.h"
+
+namespace nebula {
+
+static const std::vector<StringKernels::Isa> kAllIsa = {StringKernels::Isa::kScalar,
+                                                        StringKernels::Isa::kAVX2};
+
+static std::vector<StringKernels::Isa> supportedIsa() {
+  std::vector<StringKernels::Isa> isas;
+  for (auto isa : kAllIsa) {
+    if (isa <= StringKernels::detectIsa()) {
+      isas.emplace_back(isa);
+    }
+  }
+  return isas;
+}
+
+static int sign(int v) {
+  return (v > 0) - (v < 0);
+}
+
+// The strings of the bytes around the letters, the other ASCII ones and the ones of UTF-8
+static std::string randomString(size_t size) {
+  static const std::string kBytes("aAbBzZ@[`{\xc3\xa9\x80\0", 14);
+  std::string str;
+  for (size_t i = 0; i < size; ++i) {
+    str.push_back(kBytes[folly::Random::rand32(kBytes.size())]);
+  }
+  return str;
+}
+
+TEST(StringKernelsTest, Basic) {
+  for (auto isa : supportedIsa()) {
+    std::string str = "Hello, NebulaGraph! 你好, Nebula. The quick brown fox";
+    std::string lower = str;
+    StringKernels::toLowerAscii(lower.data(), lower.size(), isa);
+    EXPECT_EQ("hello, nebulagraph! 你好, nebula. the quick brown fox", lower);
+    std::string upper = str;
+    StringKernels::toUpperAscii(upper.data(), upper.size(), isa);
+    EXPECT_EQ("HELLO, NEBULAGRAPH! 你好, NEBULA. THE QUICK BROWN FOX", upper);
+
+    EXPECT_EQ(7u, StringKernels::find(str, "Nebula", 0, isa));
+    EXPECT_EQ(str.find("Nebula", 8), StringKernels::find(str, "Nebula", 8, isa));
+    EXPECT_EQ(str.find("fox"), StringKernels::find(str, "fox", 0, isa));
+    EXPECT_EQ(StringKernels::npos, StringKernels::find(str, "cat", 0, isa));
+    EXPECT_EQ(StringKernels::npos, StringKernels::find(str, "Hello", str.size(), isa));
+    EXPECT_EQ(StringKernels::npos, StringKernels::find("a", "ab", 0, isa));
+
+    EXPECT_EQ(0, StringKernels::caseCompare(str, upper, isa));
+    EXPECT_EQ(0, StringKernels::caseCompare("", "", isa));
+    EXPECT_LT(StringKernels::caseCompare(lower, lower + "a", isa), 0);
+    EXPECT_GT(StringKernels::caseCompare(upper + "b", lower + "A", isa), 0);
+    EXPECT_EQ(0, StringKernels::caseCompare(std::string("ab\0c", 4), "AB", isa));
+  }
+}
+
+TEST(StringKernelsTest, Random) {
+  for (size_t round = 0; round < 1000; ++round) {
+    auto str = randomString(folly::Random::rand32(200));
+    std::string lower = str, upper = str;
+    for (auto &c : lower) {
+      if (c >= 'A' && c <= 'Z') {
+        c = static_cast<char>(c - 'A' + 'a');
+      }
+    }
+    for (auto &c : upper) {
+      if (c >= 'a' && c <= 'z') {
+        c = static_cast<char>(c - 'a' + 'A');
+      }
+    }
+    auto needle = randomString(folly::Random::rand32(1, 4));
+    auto pos = folly::Random::rand32(str.size() + 2);
+    auto expectFound = str.find(needle, pos);
+    auto other = str;
+    if (!other.empty() && folly::Random::oneIn(2)) {
+      other[folly::Random::rand32(other.size())] = 'a';
+    }
+    auto expectCompare = sign(::strcasecmp(str.c_str(), other.c_str()));
+
+    for (auto isa : supportedIsa()) {
+      std::string result = str;
+      StringKernels::toLowerAscii(result.data(), result.size(), isa);
+      EXPECT_EQ(lower, result);
+      result = str;
+      StringKernels::toUpperAscii(result.data(), result.size(), isa);
+      EXPECT_EQ(upper, result);
+      EXPECT_EQ(expectFound, StringKernels::find(str, needle, pos, isa));
+      EXPECT_EQ(expectCompare, sign(StringKernels::caseCompare(str, other, isa)));
+    }
+  }
+}
+
+}  // namespace nebula
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -19,9 +19,40 @@
 namespace nebula {
 namespace geo {
 
+PreparedGeography::PreparedGeography(const Geography& geog) : geog_(&geog), region_(geog.asS2()) {
+  if (region_ != nullptr && geog.shape() == GeoShape::LINESTRING) {
+    lineIndex_ = std::make_unique<MutableS2ShapeIndex>();
+    lineIndex_->Add(std::make_unique<S2Polyline::Shape>(static_cast<S2Polyline*>(region_.get())));
+  }
+}
+
+const S2ShapeIndex& PreparedGeography::index() const {
+  if (lineIndex_ != nullptr) {
+    return *lineIndex_;
+  }
+  DCHECK(shape() == GeoShape::POLYGON);
+  return static_cast<const S2Polygon*>(region_.get())->index();
+}
+
 bool GeoFunction::intersects(const Geography& a, const Geography& b) {
-  auto aRegion = a.asS2();
-  auto bRegion = b.asS2();
+  return intersects(PreparedGeography(a), PreparedGeography(b));
+}
+
+bool GeoFunction::covers(const Geography& a, const Geography& b) {
+  return covers(PreparedGeography(a), PreparedGeography(b));
+}
+
+bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distance, bool exclusive) {
+  return dWithin(PreparedGeography(a), PreparedGeography(b), distance, exclusive);
+}
+
+double GeoFunction::distance(const Geography& a, const Geography& b) {
+  return distance(PreparedGeography(a), PreparedGeography(b));
+}
+
+bool GeoFunction::intersects(const PreparedGeography& a, const PreparedGeography& b) {
+  auto* aRegion = a.region();
+  auto* bRegion = b.region();
   if (UNLIKELY(!aRegion || !bRegion)) {
     return false;
   }
@@ -30,14 +61,14 @@ bool GeoFunction::intersects(const Geography& a, const Geography& b) {
     case GeoShape::POINT: {
       switch (b.shape()) {
         case GeoShape::POINT:
-          return static_cast<S2PointRegion*>(aRegion.get())
-              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion.get())->point()));
+          return static_cast<S2PointRegion*>(aRegion)
+              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion)->point()));
         case GeoShape::LINESTRING:
-          return static_cast<S2Polyline*>(bRegion.get())
-              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(aRegion.get())->point()));
+          return static_cast<S2Polyline*>(bRegion)
+              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(aRegion)->point()));
         case GeoShape::POLYGON:
-          return static_cast<S2Polygon*>(bRegion.get())
-              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(aRegion.get())->point()));
+          return static_cast<S2Polygon*>(bRegion)
+              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(aRegion)->point()));
         case GeoShape::UNKNOWN:
         default: {
           LOG(ERROR)
@@ -49,14 +80,14 @@ bool GeoFunction::intersects(const Geography& a, const Geography& b) {
     case GeoShape::LINESTRING: {
       switch (b.shape()) {
         case GeoShape::POINT:
-          return static_cast<S2Polyline*>(aRegion.get())
-              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion.get())->point()));
+          return static_cast<S2Polyline*>(aRegion)
+              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion)->point()));
         case GeoShape::LINESTRING:
-          return static_cast<S2Polyline*>(aRegion.get())
-              ->Intersects(static_cast<S2Polyline*>(bRegion.get()));
+          return static_cast<S2Polyline*>(aRegion)
+              ->Intersects(static_cast<S2Polyline*>(bRegion));
         case GeoShape::POLYGON:
-          return static_cast<S2Polygon*>(bRegion.get())
-              ->Intersects(*static_cast<S2Polyline*>(aRegion.get()));
+          return static_cast<S2Polygon*>(bRegion)
+              ->Intersects(*static_cast<S2Polyline*>(aRegion));
         case GeoShape::UNKNOWN:
         default: {
           LOG(ERROR)
@@ -68,14 +99,14 @@ bool GeoFunction::intersects(const Geography& a, const Geography& b) {
     case GeoShape::POLYGON: {
       switch (b.shape()) {
         case GeoShape::POINT:
-          return static_cast<S2Polygon*>(aRegion.get())
-              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion.get())->point()));
+          return static_cast<S2Polygon*>(aRegion)
+              ->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion)->point()));
         case GeoShape::LINESTRING:
-          return static_cast<S2Polygon*>(aRegion.get())
-              ->Intersects(*static_cast<S2Polyline*>(bRegion.get()));
+          return static_cast<S2Polygon*>(aRegion)
+              ->Intersects(*static_cast<S2Polyline*>(bRegion));
         case GeoShape::POLYGON:
-          return static_cast<S2Polygon*>(aRegion.get())
-              ->Intersects(static_cast<S2Polygon*>(bRegion.get()));
+          return static_cast<S2Polygon*>(aRegion)
+              ->Intersects(static_cast<S2Polygon*>(bRegion));
         case GeoShape::UNKNOWN:
         default: {
           LOG(ERROR)
@@ -95,9 +126,9 @@ bool GeoFunction::intersects(const Geography& a, const Geography& b) {
   return false;
 }
 
-bool GeoFunction::covers(const Geography& a, const Geography& b) {
-  auto aRegion = a.asS2();
-  auto bRegion = b.asS2();
+bool GeoFunction::covers(const PreparedGeography& a, const PreparedGeography& b) {
+  auto* aRegion = a.region();
+  auto* bRegion = b.region();
   if (UNLIKELY(!aRegion || !bRegion)) {
     return false;
   }
@@ -106,8 +137,8 @@ bool GeoFunction::covers(const Geography& a, const Geography& b) {
     case GeoShape::POINT: {
       switch (b.shape()) {
         case GeoShape::POINT:
-          return static_cast<S2PointRegion*>(aRegion.get())
-              ->Contains(static_cast<S2PointRegion*>(bRegion.get())->point());
+          return static_cast<S2PointRegion*>(aRegion)
+              ->Contains(static_cast<S2PointRegion*>(bRegion)->point());
         case GeoShape::LINESTRING:
         case GeoShape::POLYGON:
           return false;
@@ -119,18 +150,20 @@ bool GeoFunction::covers(const Geography& a, const Geography& b) {
       }
     }
     case GeoShape::LINESTRING: {
-      S2Polyline* aLine = static_cast<S2Polyline*>(aRegion.get());
+      S2Polyline* aLine = static_cast<S2Polyline*>(aRegion);
       switch (b.shape()) {
         case GeoShape::POINT:
-          return aLine->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion.get())->point()));
+          return aLine->MayIntersect(S2Cell(static_cast<S2PointRegion*>(bRegion)->point()));
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
+          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion);
           if (aLine->NearlyCovers(*bLine, S1Angle::Radians(1e-15))) {
             return true;
           }
-          // LineString should covers its reverse
-          aLine->Reverse();
-          return aLine->NearlyCovers(*bLine, S1Angle::Radians(1e-15));
+          // LineString should covers its reverse, which is reversed on a copy as the regions of
+          // the prepared geographies are shared by the calls
+          std::unique_ptr<S2Polyline> reversed(aLine->Clone());
+          reversed->Reverse();
+          return reversed->NearlyCovers(*bLine, S1Angle::Radians(1e-15));
         }
         case GeoShape::POLYGON:
           return false;
@@ -142,20 +175,21 @@ bool GeoFunction::covers(const Geography& a, const Geography& b) {
       }
     }
     case GeoShape::POLYGON: {
-      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion.get());
+      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion);
       switch (b.shape()) {
         case GeoShape::POINT:
-          return aPolygon->Contains(static_cast<S2PointRegion*>(bRegion.get())->point());
+          return aPolygon->Contains(static_cast<S2PointRegion*>(bRegion)->point());
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
+          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion);
           if (aPolygon->Contains(*bLine)) {
             return true;
           }
-          bLine->Reverse();
-          return aPolygon->Contains(*bLine);
+          std::unique_ptr<S2Polyline> reversed(bLine->Clone());
+          reversed->Reverse();
+          return aPolygon->Contains(*reversed);
         }
         case GeoShape::POLYGON:
-          return aPolygon->Contains(static_cast<S2Polygon*>(bRegion.get()));
+          return aPolygon->Contains(static_cast<S2Polygon*>(bRegion));
         case GeoShape::UNKNOWN:
         default: {
           LOG(ERROR)
@@ -179,28 +213,30 @@ bool GeoFunction::coveredBy(const Geography& a, const Geography& b) {
   return covers(b, a);
 }
 
-bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distance, bool exclusive) {
-  auto aRegion = a.asS2();
-  auto bRegion = b.asS2();
+bool GeoFunction::dWithin(const PreparedGeography& a,
+                          const PreparedGeography& b,
+                          double distance,
+                          bool exclusive) {
+  auto* aRegion = a.region();
+  auto* bRegion = b.region();
   if (UNLIKELY(!aRegion || !bRegion)) {
     return false;
   }
 
   switch (a.shape()) {
     case GeoShape::POINT: {
-      const S2Point& aPoint = static_cast<S2PointRegion*>(aRegion.get())->point();
+      const S2Point& aPoint = static_cast<S2PointRegion*>(aRegion)->point();
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
           double closestDistance = S2Earth::GetDistanceMeters(aPoint, bPoint);
           return exclusive ? closestDistance < distance : closestDistance <= distance;
         }
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
-          return s2PointAndS2PolylineAreWithinDistance(aPoint, bLine, distance, exclusive);
+          return s2PointAndS2PolylineAreWithinDistance(aPoint, b.index(), distance, exclusive);
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
           return s2PointAndS2PolygonAreWithinDistance(aPoint, bPolygon, distance, exclusive);
         }
         case GeoShape::UNKNOWN:
@@ -212,19 +248,14 @@ bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distanc
       }
     }
     case GeoShape::LINESTRING: {
-      S2Polyline* aLine = static_cast<S2Polyline*>(aRegion.get());
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
-          return s2PointAndS2PolylineAreWithinDistance(bPoint, aLine, distance, exclusive);
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
+          return s2PointAndS2PolylineAreWithinDistance(bPoint, a.index(), distance, exclusive);
         }
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
-          MutableS2ShapeIndex aIndex, bIndex;
-          aIndex.Add(std::make_unique<S2Polyline::Shape>(aLine));
-          bIndex.Add(std::make_unique<S2Polyline::Shape>(bLine));
-          S2ClosestEdgeQuery query(&aIndex);
-          S2ClosestEdgeQuery::ShapeIndexTarget target(&bIndex);
+          S2ClosestEdgeQuery query(&a.index());
+          S2ClosestEdgeQuery::ShapeIndexTarget target(&b.index());
           if (exclusive) {
             return query.IsDistanceLess(&target,
                                         S2Earth::ToChordAngle(util::units::Meters(distance)));
@@ -233,8 +264,8 @@ bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distanc
                                              S2Earth::ToChordAngle(util::units::Meters(distance)));
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
-          return s2PolylineAndS2PolygonAreWithinDistance(aLine, bPolygon, distance, exclusive);
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
+          return s2PolylineAndS2PolygonAreWithinDistance(a.index(), bPolygon, distance, exclusive);
         }
         case GeoShape::UNKNOWN:
         default: {
@@ -245,18 +276,17 @@ bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distanc
       }
     }
     case GeoShape::POLYGON: {
-      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion.get());
+      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion);
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
           return s2PointAndS2PolygonAreWithinDistance(bPoint, aPolygon, distance, exclusive);
         }
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
-          return s2PolylineAndS2PolygonAreWithinDistance(bLine, aPolygon, distance, exclusive);
+          return s2PolylineAndS2PolygonAreWithinDistance(b.index(), aPolygon, distance, exclusive);
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
           S2ClosestEdgeQuery query(&aPolygon->index());
           S2ClosestEdgeQuery::ShapeIndexTarget target(&bPolygon->index());
           if (exclusive) {
@@ -285,27 +315,27 @@ bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distanc
   return false;
 }
 
-double GeoFunction::distance(const Geography& a, const Geography& b) {
-  auto aRegion = a.asS2();
-  auto bRegion = b.asS2();
+double GeoFunction::distance(const PreparedGeography& a, const PreparedGeography& b) {
+  auto* aRegion = a.region();
+  auto* bRegion = b.region();
   if (UNLIKELY(!aRegion || !bRegion)) {
     return -1.0;
   }
 
   switch (a.shape()) {
     case GeoShape::POINT: {
-      const S2Point& aPoint = static_cast<S2PointRegion*>(aRegion.get())->point();
+      const S2Point& aPoint = static_cast<S2PointRegion*>(aRegion)->point();
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
           return S2Earth::GetDistanceMeters(aPoint, bPoint);
         }
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
+          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion);
           return distanceOfS2PolylineWithS2Point(bLine, aPoint);
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
           return distanceOfS2PolygonWithS2Point(bPolygon, aPoint);
         }
         case GeoShape::UNKNOWN:
@@ -317,24 +347,20 @@ double GeoFunction::distance(const Geography& a, const Geography& b) {
       }
     }
     case GeoShape::LINESTRING: {
-      S2Polyline* aLine = static_cast<S2Polyline*>(aRegion.get());
+      S2Polyline* aLine = static_cast<S2Polyline*>(aRegion);
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
           return distanceOfS2PolylineWithS2Point(aLine, bPoint);
         }
         case GeoShape::LINESTRING: {
-          const S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
-          MutableS2ShapeIndex aIndex, bIndex;
-          aIndex.Add(std::make_unique<S2Polyline::Shape>(aLine));
-          bIndex.Add(std::make_unique<S2Polyline::Shape>(bLine));
-          S2ClosestEdgeQuery query(&aIndex);
-          S2ClosestEdgeQuery::ShapeIndexTarget target(&bIndex);
+          S2ClosestEdgeQuery query(&a.index());
+          S2ClosestEdgeQuery::ShapeIndexTarget target(&b.index());
           return S2Earth::ToMeters(query.GetDistance(&target));
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
-          return distanceOfS2PolygonWithS2Polyline(bPolygon, aLine);
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
+          return distanceOfS2PolygonWithS2Polyline(bPolygon, a.index());
         }
         case GeoShape::UNKNOWN:
         default: {
@@ -345,18 +371,17 @@ double GeoFunction::distance(const Geography& a, const Geography& b) {
       }
     }
     case GeoShape::POLYGON: {
-      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion.get());
+      S2Polygon* aPolygon = static_cast<S2Polygon*>(aRegion);
       switch (b.shape()) {
         case GeoShape::POINT: {
-          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+          const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion)->point();
           return distanceOfS2PolygonWithS2Point(aPolygon, bPoint);
         }
         case GeoShape::LINESTRING: {
-          S2Polyline* bLine = static_cast<S2Polyline*>(bRegion.get());
-          return distanceOfS2PolygonWithS2Polyline(aPolygon, bLine);
+          return distanceOfS2PolygonWithS2Polyline(aPolygon, b.index());
         }
         case GeoShape::POLYGON: {
-          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion.get());
+          S2Polygon* bPolygon = static_cast<S2Polygon*>(bRegion);
           S2ClosestEdgeQuery query(&aPolygon->index());
           S2ClosestEdgeQuery::ShapeIndexTarget target(&bPolygon->index());
           return S2Earth::ToMeters(query.GetDistance(&target));
@@ -496,11 +521,9 @@ double GeoFunction::distanceOfS2PolylineWithS2Point(const S2Polyline* aLine,
 }
 
 double GeoFunction::distanceOfS2PolygonWithS2Polyline(const S2Polygon* aPolygon,
-                                                      const S2Polyline* bLine) {
+                                                      const S2ShapeIndex& bLineIndex) {
   S2ClosestEdgeQuery query(&aPolygon->index());
-  MutableS2ShapeIndex bIndex;
-  bIndex.Add(std::make_unique<S2Polyline::Shape>(bLine));
-  S2ClosestEdgeQuery::ShapeIndexTarget target(&bIndex);
+  S2ClosestEdgeQuery::ShapeIndexTarget target(&bLineIndex);
   return S2Earth::ToMeters(query.GetDistance(&target));
 }
 
@@ -510,12 +533,10 @@ double GeoFunction::distanceOfS2PolygonWithS2Point(const S2Polygon* aPolygon,
 }
 
 bool GeoFunction::s2PointAndS2PolylineAreWithinDistance(const S2Point& aPoint,
-                                                        const S2Polyline* bLine,
+                                                        const S2ShapeIndex& bLineIndex,
                                                         double distance,
                                                         bool exclusive) {
-  MutableS2ShapeIndex bIndex;
-  bIndex.Add(std::make_unique<S2Polyline::Shape>(bLine));
-  S2ClosestEdgeQuery query(&bIndex);
+  S2ClosestEdgeQuery query(&bLineIndex);
   S2ClosestEdgeQuery::PointTarget target(aPoint);
   if (exclusive) {
     return query.IsDistanceLess(&target, S2Earth::ToChordAngle(util::units::Meters(distance)));
@@ -535,13 +556,11 @@ bool GeoFunction::s2PointAndS2PolygonAreWithinDistance(const S2Point& aPoint,
   return query.IsDistanceLessOrEqual(&target, S2Earth::ToChordAngle(util::units::Meters(distance)));
 }
 
-bool GeoFunction::s2PolylineAndS2PolygonAreWithinDistance(const S2Polyline* aLine,
+bool GeoFunction::s2PolylineAndS2PolygonAreWithinDistance(const S2ShapeIndex& aLineIndex,
                                                           const S2Polygon* bPolygon,
                                                           double distance,
                                                           bool exclusive) {
-  MutableS2ShapeIndex aIndex;
-  aIndex.Add(std::make_unique<S2Polyline::Shape>(aLine));
-  S2ClosestEdgeQuery::ShapeIndexTarget target(&aIndex);
+  S2ClosestEdgeQuery::ShapeIndexTarget target(&aLineIndex);
   S2ClosestEdgeQuery query(&bPolygon->index());
   if (exclusive) {
     return query.IsDistanceLess(&target, S2Earth::ToChordAngle(util::units::Meters(distance)));
@@ -6,6 +6,7 @@
 #ifndef COMMON_GEO_GEOFUNCTION_H
 #define COMMON_GEO_GEOFUNCTION_H
 
+#include <s2/mutable_s2shape_index.h>
 #include <s2/s2region_coverer.h>
 
 #include "common/datatypes/Geography.h"
@@ -13,17 +14,50 @@
 namespace nebula {
 namespace geo {
 
+// A geography with its S2 region, and the index of its edges for a linestring, built once, so a
+// constant geography evaluated against many others, e.g. the one of ST_Intersects(g, $^.v.geo) in
+// a filter, doesn't build them for each row. The geography must outlive it. The region is only
+// read by the functions, but the index is built lazily by S2 on the first query, so it's not
+// meant to be shared by the threads.
+class PreparedGeography final {
+ public:
+  explicit PreparedGeography(const Geography& geog);
+
+  const Geography& geography() const {
+    return *geog_;
+  }
+
+  GeoShape shape() const {
+    return geog_->shape();
+  }
+
+  // nullptr if the geography couldn't be converted
+  S2Region* region() const {
+    return region_.get();
+  }
+
+  // The index of the edges of a linestring or polygon
+  const S2ShapeIndex& index() const;
+
+ private:
+  const Geography* geog_;
+  std::unique_ptr<S2Region> region_;
+  std::unique_ptr<MutableS2ShapeIndex> lineIndex_;
+};
+
 class GeoFunction {
  public:
   // Returns true if any point in the set that comprises A is also a member of the set of points
   // that
   // make up B.
   static bool intersects(const Geography& a, const Geography& b);
+  static bool intersects(const PreparedGeography& a, const PreparedGeography& b);
 
   // Returns true if no point in b lies exterior of b.
   // The difference between ST_Covers, ST_Contains and ST_ContainsProperly, see
   // http://lin-ear-th-inking.blogspot.com/2007/06/subtleties-of-ogc-covers-spatial.html
   static bool covers(const Geography& a, const Geography& b);
+  static bool covers(const PreparedGeography& a, const PreparedGeography& b);
   static bool coveredBy(const Geography& a, const Geography& b);
 
   // Returns true if any of a is within distance meters of b.
@@ -33,9 +67,14 @@ class GeoFunction {
                       const Geography& b,
                       double distance,
                       bool exclusive = false);
+  static bool dWithin(const PreparedGeography& a,
+                      const PreparedGeography& b,
+                      double distance,
+                      bool exclusive = false);
 
   // Return the closest distance in meters of a and b.
   static double distance(const Geography& a, const Geography& b);
+  static double distance(const PreparedGeography& a, const PreparedGeography& b);
 
   static uint64_t s2CellIdFromPoint(const Geography& a, int level = 30);
 
@@ -52,12 +91,12 @@ class GeoFunction {
   static double distanceOfS2PolylineWithS2Point(const S2Polyline* aLine, const S2Point& bPoint);
 
   static double distanceOfS2PolygonWithS2Polyline(const S2Polygon* aPolygon,
-                                                  const S2Polyline* bLine);
+                                                  const S2ShapeIndex& bLineIndex);
 
   static double distanceOfS2PolygonWithS2Point(const S2Polygon* aPolygon, const S2Point& bPoint);
 
   static bool s2PointAndS2PolylineAreWithinDistance(const S2Point& aPoint,
-                                                    const S2Polyline* bLine,
+                                                    const S2ShapeIndex& bLineIndex,
                                                     double distance,
                                                     bool exclusive);
 
@@ -66,7 +105,7 @@ class GeoFunction {
                                                    double distance,
                                                    bool exclusive);
 
-  static bool s2PolylineAndS2PolygonAreWithinDistance(const S2Polyline* aLine,
+  static bool s2PolylineAndS2PolygonAreWithinDistance(const S2ShapeIndex& aLineIndex,
                                                       const S2Polygon* bPolygon,
                                                       double distance,
                                                       bool exclusive);
@@ -144,7 +144,32 @@ std::vector<ScanRange> GeoIndex::intersects(const S2Region& r, bool isPoint) con
     }
   }
 
-  return scanRanges;
+  return mergeRanges(std::move(scanRanges));
+}
+
+std::vector<ScanRange> GeoIndex::mergeRanges(std::vector<ScanRange> ranges) {
+  // A prefix of a cell id is the range of the cell id only, since the column is a fixed uint64
+  std::vector<std::pair<uint64_t, uint64_t>> bounds;
+  bounds.reserve(ranges.size());
+  for (const auto& range : ranges) {
+    bounds.emplace_back(range.rangeMin, range.isRangeScan ? range.rangeMax : range.rangeMin);
+  }
+  std::sort(bounds.begin(), bounds.end());
+  std::vector<ScanRange> merged;
+  for (size_t i = 0; i < bounds.size();) {
+    auto [min, max] = bounds[i];
+    for (++i; i < bounds.size() && max != std::numeric_limits<uint64_t>::max() &&
+              bounds[i].first <= max + 1;
+         ++i) {
+      max = std::max(max, bounds[i].second);
+    }
+    if (min == max) {
+      merged.emplace_back(min);
+    } else {
+      merged.emplace_back(min, max);
+    }
+  }
+  return merged;
 }
 
 std::vector<S2CellId> GeoIndex::coveringCells(const S2Region& r, bool isPoint) const {
@@ -76,6 +76,10 @@ class GeoIndex {
   // ST_Distance(g, x, distance), x is the indexed geography column
   std::vector<ScanRange> dWithin(const Geography& g, double distance) const;
 
+  // Sort the ranges and merge the overlapping or adjacent ones, so the same cells are scanned by
+  // fewer ranges. A range of a single cell is scanned by its prefix
+  static std::vector<ScanRange> mergeRanges(std::vector<ScanRange> ranges);
+
  private:
   std::vector<ScanRange> intersects(const S2Region& r, bool isPoint = false) const;
 
@@ -1007,6 +1007,32 @@ TEST(Distance, polygon2Polygon) {
   }
 }
 
+TEST(PreparedGeography, sameAsUnprepared) {
+  std::vector<Geography> geogs = {
+      Geography::fromWKT("POINT(1.0 1.0)").value(),
+      Geography::fromWKT("POINT(5.0 5.0)").value(),
+      Geography::fromWKT("LINESTRING(0.0 0.0, 2.0 2.0, 4.0 0.0)").value(),
+      Geography::fromWKT("LINESTRING(4.0 0.0, 2.0 2.0)").value(),
+      Geography::fromWKT("POLYGON((0.0 0.0, 3.0 0.0, 3.0 3.0, 0.0 3.0, 0.0 0.0))").value(),
+      Geography::fromWKT("POLYGON((10.0 10.0, 11.0 10.0, 11.0 11.0, 10.0 10.0))").value(),
+  };
+  for (const auto& a : geogs) {
+    // A prepared geography is evaluated against many others, and kept unchanged by them
+    PreparedGeography prepared(a);
+    for (size_t i = 0; i < 2; ++i) {
+      for (const auto& b : geogs) {
+        PreparedGeography other(b);
+        EXPECT_EQ(GeoFunction::intersects(a, b), GeoFunction::intersects(prepared, other));
+        EXPECT_EQ(GeoFunction::covers(a, b), GeoFunction::covers(prepared, other));
+        EXPECT_EQ(GeoFunction::covers(b, a), GeoFunction::covers(other, prepared));
+        EXPECT_EQ(GeoFunction::dWithin(a, b, 100000.0),
+                  GeoFunction::dWithin(prepared, other, 100000.0));
+        EXPECT_EQ(GeoFunction::distance(a, b), GeoFunction::distance(prepared, other));
+      }
+    }
+  }
+}
+
 TEST(s2CellIdFromPoint, point) {
   {
     auto point = Geography::fromWKT("POINT(1.0 1.0)").value();
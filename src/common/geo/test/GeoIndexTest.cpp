@@ -306,6 +306,37 @@ TEST(indexCells, polygon) {
   }
 }
 
+TEST(mergeRanges, basic) {
+  auto max = std::numeric_limits<uint64_t>::max();
+  std::vector<ScanRange> ranges = {ScanRange(22, 30),
+                                   ScanRange(21),
+                                   ScanRange(10, 20),
+                                   ScanRange(5),
+                                   ScanRange(45, 60),
+                                   ScanRange(40, 50),
+                                   ScanRange(max),
+                                   ScanRange(max - 1)};
+  std::vector<ScanRange> expect = {
+      ScanRange(5), ScanRange(10, 30), ScanRange(40, 60), ScanRange(max - 1, max)};
+  EXPECT_EQ(expect, GeoIndex::mergeRanges(ranges));
+  EXPECT_TRUE(GeoIndex::mergeRanges({}).empty());
+}
+
+TEST(mergeRanges, cells) {
+  // Two sibling cells are separated by the id of their parent, which is merged with them
+  auto parent = S2CellId::FromFace(1).child(2);
+  auto left = parent.child(1);
+  auto right = parent.child(2);
+  std::vector<ScanRange> ranges = {ScanRange(right.range_min().id(), right.range_max().id()),
+                                   ScanRange(left.range_min().id(), left.range_max().id()),
+                                   ScanRange(parent.id())};
+  std::vector<ScanRange> expect = {ScanRange(left.range_min().id(), right.range_max().id())};
+  EXPECT_EQ(expect, GeoIndex::mergeRanges(ranges));
+  // Without the parent, they're not adjacent
+  ranges.pop_back();
+  EXPECT_EQ(2, GeoIndex::mergeRanges(ranges).size());
+}
+
 }  // namespace geo
 }  // namespace nebula
 
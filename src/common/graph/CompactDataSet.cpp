@@ -0,0 +1,879 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/graph/CompactDataSet.h"
+
+#include <folly/Varint.h>
+#include <folly/compression/Compression.h>
+#include <folly/lang/Bits.h>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Geography.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+DEFINE_uint32(compact_result_compression_min_size,
+              4096,
+              "The compact encoded results shorter than it are not compressed");
+
+namespace nebula {
+
+namespace {
+
+enum class ColumnKind : uint8_t {
+  kNull = 0,
+  kBool = 1,
+  kInt = 2,
+  kFloat = 3,
+  kString = 4,
+  kBoxed = 5,
+};
+
+enum class ValueTag : uint8_t {
+  kEmpty = 0,
+  kNull = 1,
+  kBool = 2,
+  kInt = 3,
+  kFloat = 4,
+  kString = 5,
+  kDate = 6,
+  kTime = 7,
+  kDateTime = 8,
+  kVertex = 9,
+  kEdge = 10,
+  kPath = 11,
+  kList = 12,
+  kMap = 13,
+  kSet = 14,
+  kDataSet = 15,
+  kGeography = 16,
+  kDuration = 17,
+};
+
+// The values of a column are written once in a dictionary if each is repeated at least so often
+constexpr size_t kMinRepeats = 2;
+
+folly::io::Codec* lz4Codec() {
+  // Codecs are not thread safe, each thread has its own
+  static thread_local auto codec = folly::io::getCodec(folly::io::CodecType::LZ4_FRAME);
+  return codec.get();
+}
+
+const Value& cellOf(const Row& row, size_t col) {
+  return col < row.values.size() ? row.values[col] : Value::kEmpty;
+}
+
+bool isPlainNull(const Value& value) {
+  return value.isNull() && value.getNull() == NullType::__NULL__;
+}
+
+ColumnKind kindOf(const Value& value) {
+  switch (value.type()) {
+    case Value::Type::BOOL:
+      return ColumnKind::kBool;
+    case Value::Type::INT:
+      return ColumnKind::kInt;
+    case Value::Type::FLOAT:
+      return ColumnKind::kFloat;
+    case Value::Type::STRING:
+      return ColumnKind::kString;
+    default:
+      return ColumnKind::kBoxed;
+  }
+}
+
+// The typed kind if all the values are of it or the plain NULL
+ColumnKind kindOf(const std::vector<Row>& rows, size_t col) {
+  auto kind = ColumnKind::kNull;
+  for (const auto& row : rows) {
+    const auto& value = cellOf(row, col);
+    if (isPlainNull(value)) {
+      continue;
+    }
+    auto valueKind = kindOf(value);
+    if (kind == ColumnKind::kNull) {
+      kind = valueKind;
+    } else if (kind != valueKind) {
+      return ColumnKind::kBoxed;
+    }
+    if (kind == ColumnKind::kBoxed) {
+      return kind;
+    }
+  }
+  return kind;
+}
+
+struct ValuePtrHash {
+  size_t operator()(const Value* value) const {
+    return std::hash<Value>()(*value);
+  }
+};
+
+struct ValuePtrEqual {
+  bool operator()(const Value* lhs, const Value* rhs) const {
+    return *lhs == *rhs;
+  }
+};
+
+class Writer final {
+ public:
+  explicit Writer(std::string* out) : out_(out) {}
+
+  void byte(uint8_t b) {
+    out_->push_back(static_cast<char>(b));
+  }
+
+  void varint(uint64_t v) {
+    uint8_t buf[folly::kMaxVarintLength64];
+    auto len = folly::encodeVarint(v, buf);
+    out_->append(reinterpret_cast<const char*>(buf), len);
+  }
+
+  void signedVarint(int64_t v) {
+    varint(folly::encodeZigZag(v));
+  }
+
+  void float64(double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    bits = folly::Endian::little(bits);
+    out_->append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+  }
+
+  void str(folly::StringPiece s) {
+    varint(s.size());
+    out_->append(s.data(), s.size());
+  }
+
+  // The number of the name, or 0 followed by the name at its first occurrence
+  void name(const std::string& s) {
+    auto [iter, inserted] = names_.emplace(s, names_.size() + 1);
+    if (inserted) {
+      varint(0);
+      str(s);
+    } else {
+      varint(iter->second);
+    }
+  }
+
+  void column(const std::vector<Row>& rows, size_t col);
+
+  void value(const Value& value);
+
+ private:
+  // Write the bits of the rows, the set bits are where pred is true
+  template <class Pred>
+  void bits(const std::vector<Row>& rows, size_t col, Pred pred) {
+    uint8_t b = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+      if (pred(cellOf(rows[i], col))) {
+        b |= 1 << (i & 7);
+      }
+      if ((i & 7) == 7) {
+        byte(b);
+        b = 0;
+      }
+    }
+    if (rows.size() & 7) {
+      byte(b);
+    }
+  }
+
+  void nullBitmap(const std::vector<Row>& rows, size_t col) {
+    bool hasNull = std::any_of(rows.begin(), rows.end(), [col](const auto& row) {
+      return isPlainNull(cellOf(row, col));
+    });
+    byte(hasNull);
+    if (hasNull) {
+      bits(rows, col, isPlainNull);
+    }
+  }
+
+  void strings(const std::vector<Row>& rows, size_t col);
+
+  void boxed(const std::vector<Row>& rows, size_t col);
+
+  // The props of a step, or a tag or an edge
+  template <typename Props>
+  void props(const Props& props) {
+    varint(props.size());
+    for (const auto& prop : props) {
+      name(prop.first);
+      value(prop.second);
+    }
+  }
+
+  void vertex(const Vertex& v) {
+    value(v.vid);
+    varint(v.tags.size());
+    for (const auto& tag : v.tags) {
+      name(tag.name);
+      props(tag.props);
+    }
+  }
+
+  std::string* out_;
+  std::unordered_map<std::string, uint64_t> names_;
+};
+
+void Writer::column(const std::vector<Row>& rows, size_t col) {
+  auto kind = kindOf(rows, col);
+  byte(static_cast<uint8_t>(kind));
+  switch (kind) {
+    case ColumnKind::kNull:
+      break;
+    case ColumnKind::kBool:
+      nullBitmap(rows, col);
+      bits(rows, col, [](const Value& v) { return v.isBool() && v.getBool(); });
+      break;
+    case ColumnKind::kInt:
+      nullBitmap(rows, col);
+      for (const auto& row : rows) {
+        const auto& v = cellOf(row, col);
+        signedVarint(v.isInt() ? v.getInt() : 0);
+      }
+      break;
+    case ColumnKind::kFloat:
+      nullBitmap(rows, col);
+      for (const auto& row : rows) {
+        const auto& v = cellOf(row, col);
+        float64(v.isFloat() ? v.getFloat() : 0.0);
+      }
+      break;
+    case ColumnKind::kString:
+      nullBitmap(rows, col);
+      strings(rows, col);
+      break;
+    case ColumnKind::kBoxed:
+      boxed(rows, col);
+      break;
+  }
+}
+
+void Writer::strings(const std::vector<Row>& rows, size_t col) {
+  std::unordered_map<std::string_view, uint64_t> dict;
+  std::vector<std::string_view> distinct;
+  std::vector<uint64_t> indexes;
+  indexes.reserve(rows.size());
+  for (const auto& row : rows) {
+    const auto& v = cellOf(row, col);
+    if (!v.isStr()) {
+      continue;
+    }
+    std::string_view s = v.getStr();
+    auto [iter, inserted] = dict.emplace(s, distinct.size());
+    if (inserted) {
+      distinct.emplace_back(s);
+    }
+    indexes.emplace_back(iter->second);
+  }
+  bool useDict = distinct.size() * kMinRepeats <= indexes.size();
+  byte(useDict);
+  if (useDict) {
+    varint(distinct.size());
+    for (auto s : distinct) {
+      str(folly::StringPiece(s.data(), s.size()));
+    }
+    for (auto index : indexes) {
+      varint(index);
+    }
+  } else {
+    for (auto index : indexes) {
+      auto s = distinct[index];
+      str(folly::StringPiece(s.data(), s.size()));
+    }
+  }
+}
+
+void Writer::boxed(const std::vector<Row>& rows, size_t col) {
+  std::unordered_map<const Value*, uint64_t, ValuePtrHash, ValuePtrEqual> dict;
+  std::vector<const Value*> distinct;
+  std::vector<uint64_t> indexes;
+  indexes.reserve(rows.size());
+  for (const auto& row : rows) {
+    const auto* v = &cellOf(row, col);
+    auto [iter, inserted] = dict.emplace(v, distinct.size());
+    if (inserted) {
+      distinct.emplace_back(v);
+    }
+    indexes.emplace_back(iter->second);
+  }
+  bool useDict = distinct.size() * kMinRepeats <= indexes.size();
+  byte(useDict);
+  if (useDict) {
+    varint(distinct.size());
+    for (const auto* v : distinct) {
+      value(*v);
+    }
+    for (auto index : indexes) {
+      varint(index);
+    }
+  } else {
+    for (const auto& row : rows) {
+      value(cellOf(row, col));
+    }
+  }
+}
+
+void Writer::value(const Value& v) {
+  switch (v.type()) {
+    case Value::Type::__EMPTY__: {
+      byte(static_cast<uint8_t>(ValueTag::kEmpty));
+      break;
+    }
+    case Value::Type::NULLVALUE: {
+      byte(static_cast<uint8_t>(ValueTag::kNull));
+      byte(static_cast<uint8_t>(v.getNull()));
+      break;
+    }
+    case Value::Type::BOOL: {
+      byte(static_cast<uint8_t>(ValueTag::kBool));
+      byte(v.getBool());
+      break;
+    }
+    case Value::Type::INT: {
+      byte(static_cast<uint8_t>(ValueTag::kInt));
+      signedVarint(v.getInt());
+      break;
+    }
+    case Value::Type::FLOAT: {
+      byte(static_cast<uint8_t>(ValueTag::kFloat));
+      float64(v.getFloat());
+      break;
+    }
+    case Value::Type::STRING: {
+      byte(static_cast<uint8_t>(ValueTag::kString));
+      str(v.getStr());
+      break;
+    }
+    case Value::Type::DATE: {
+      const auto& date = v.getDate();
+      byte(static_cast<uint8_t>(ValueTag::kDate));
+      signedVarint(date.year);
+      byte(date.month);
+      byte(date.day);
+      break;
+    }
+    case Value::Type::TIME: {
+      const auto& time = v.getTime();
+      byte(static_cast<uint8_t>(ValueTag::kTime));
+      byte(time.hour);
+      byte(time.minute);
+      byte(time.sec);
+      varint(time.microsec);
+      break;
+    }
+    case Value::Type::DATETIME: {
+      const auto& dt = v.getDateTime();
+      byte(static_cast<uint8_t>(ValueTag::kDateTime));
+      signedVarint(dt.year);
+      byte(dt.month);
+      byte(dt.day);
+      byte(dt.hour);
+      byte(dt.minute);
+      byte(dt.sec);
+      varint(dt.microsec);
+      break;
+    }
+    case Value::Type::VERTEX: {
+      byte(static_cast<uint8_t>(ValueTag::kVertex));
+      vertex(v.getVertex());
+      break;
+    }
+    case Value::Type::EDGE: {
+      const auto& edge = v.getEdge();
+      byte(static_cast<uint8_t>(ValueTag::kEdge));
+      value(edge.src);
+      value(edge.dst);
+      signedVarint(edge.type);
+      name(edge.name);
+      signedVarint(edge.ranking);
+      props(edge.props);
+      break;
+    }
+    case Value::Type::PATH: {
+      const auto& path = v.getPath();
+      byte(static_cast<uint8_t>(ValueTag::kPath));
+      vertex(path.src);
+      varint(path.steps.size());
+      for (const auto& step : path.steps) {
+        vertex(step.dst);
+        signedVarint(step.type);
+        name(step.name);
+        signedVarint(step.ranking);
+        props(step.props);
+      }
+      break;
+    }
+    case Value::Type::LIST: {
+      const auto& list = v.getList();
+      byte(static_cast<uint8_t>(ValueTag::kList));
+      varint(list.values.size());
+      for (const auto& item : list.values) {
+        value(item);
+      }
+      break;
+    }
+    case Value::Type::MAP: {
+      byte(static_cast<uint8_t>(ValueTag::kMap));
+      props(v.getMap().kvs);
+      break;
+    }
+    case Value::Type::SET: {
+      const auto& set = v.getSet();
+      byte(static_cast<uint8_t>(ValueTag::kSet));
+      varint(set.values.size());
+      for (const auto& item : set.values) {
+        value(item);
+      }
+      break;
+    }
+    case Value::Type::DATASET: {
+      const auto& ds = v.getDataSet();
+      byte(static_cast<uint8_t>(ValueTag::kDataSet));
+      varint(ds.colNames.size());
+      for (const auto& colName : ds.colNames) {
+        str(colName);
+      }
+      varint(ds.rows.size());
+      for (const auto& row : ds.rows) {
+        for (size_t i = 0; i < ds.colNames.size(); i++) {
+          value(cellOf(row, i));
+        }
+      }
+      break;
+    }
+    case Value::Type::GEOGRAPHY: {
+      byte(static_cast<uint8_t>(ValueTag::kGeography));
+      str(v.getGeography().asWKB());
+      break;
+    }
+    case Value::Type::DURATION: {
+      const auto& duration = v.getDuration();
+      byte(static_cast<uint8_t>(ValueTag::kDuration));
+      signedVarint(duration.seconds);
+      signedVarint(duration.microseconds);
+      signedVarint(duration.months);
+      break;
+    }
+  }
+}
+
+class Reader final {
+ public:
+  explicit Reader(folly::StringPiece data) : data_(data) {}
+
+  bool done() const {
+    return data_.empty();
+  }
+
+  uint8_t byte() {
+    need(1);
+    auto b = static_cast<uint8_t>(data_[0]);
+    data_.advance(1);
+    return b;
+  }
+
+  uint64_t varint() {
+    return folly::decodeVarint(data_);
+  }
+
+  int64_t signedVarint() {
+    return folly::decodeZigZag(varint());
+  }
+
+  double float64() {
+    need(sizeof(uint64_t));
+    uint64_t bits;
+    std::memcpy(&bits, data_.data(), sizeof(bits));
+    data_.advance(sizeof(bits));
+    bits = folly::Endian::little(bits);
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+  }
+
+  std::string str() {
+    auto len = varint();
+    need(len);
+    std::string s(data_.data(), len);
+    data_.advance(len);
+    return s;
+  }
+
+  std::string name() {
+    auto id = varint();
+    if (id == 0) {
+      names_.emplace_back(str());
+      return names_.back();
+    }
+    if (id > names_.size()) {
+      throw std::out_of_range("Unknown name");
+    }
+    return names_[id - 1];
+  }
+
+  // The bits of num rows, empty if they are all unset as a NULL bitmap says
+  std::vector<bool> bits(size_t num) {
+    need((num + 7) / 8);
+    std::vector<bool> ret(num);
+    for (size_t i = 0; i < num; i++) {
+      ret[i] = (static_cast<uint8_t>(data_[i >> 3]) >> (i & 7)) & 1;
+    }
+    data_.advance((num + 7) / 8);
+    return ret;
+  }
+
+  std::vector<bool> nullBitmap(size_t num) {
+    return byte() ? bits(num) : std::vector<bool>();
+  }
+
+  void column(std::vector<Row>& rows, size_t col);
+
+  Value value();
+
+ private:
+  void need(size_t num) const {
+    if (data_.size() < num) {
+      throw std::out_of_range("Truncated");
+    }
+  }
+
+  // A number of the items to follow, each of which takes at least a byte
+  size_t count() {
+    auto num = varint();
+    need(num);
+    return num;
+  }
+
+  std::unordered_map<std::string, Value> props() {
+    std::unordered_map<std::string, Value> ret;
+    auto num = count();
+    for (size_t i = 0; i < num; i++) {
+      auto key = name();
+      ret[std::move(key)] = value();
+    }
+    return ret;
+  }
+
+  Vertex vertex() {
+    Vertex v;
+    v.vid = value();
+    auto num = count();
+    v.tags.reserve(num);
+    for (size_t i = 0; i < num; i++) {
+      auto tagName = name();
+      v.tags.emplace_back(std::move(tagName), props());
+    }
+    return v;
+  }
+
+  folly::StringPiece data_;
+  std::vector<std::string> names_;
+};
+
+void Reader::column(std::vector<Row>& rows, size_t col) {
+  auto kind = static_cast<ColumnKind>(byte());
+  auto setNulls = [&rows, col](const std::vector<bool>& nulls) {
+    for (size_t i = 0; i < nulls.size(); i++) {
+      if (nulls[i]) {
+        rows[i].values[col] = Value::kNullValue;
+      }
+    }
+  };
+  switch (kind) {
+    case ColumnKind::kNull: {
+      for (auto& row : rows) {
+        row.values[col] = Value::kNullValue;
+      }
+      break;
+    }
+    case ColumnKind::kBool: {
+      auto nulls = nullBitmap(rows.size());
+      auto values = bits(rows.size());
+      for (size_t i = 0; i < rows.size(); i++) {
+        rows[i].values[col] = static_cast<bool>(values[i]);
+      }
+      setNulls(nulls);
+      break;
+    }
+    case ColumnKind::kInt: {
+      auto nulls = nullBitmap(rows.size());
+      for (auto& row : rows) {
+        row.values[col] = signedVarint();
+      }
+      setNulls(nulls);
+      break;
+    }
+    case ColumnKind::kFloat: {
+      auto nulls = nullBitmap(rows.size());
+      for (auto& row : rows) {
+        row.values[col] = float64();
+      }
+      setNulls(nulls);
+      break;
+    }
+    case ColumnKind::kString: {
+      auto nulls = nullBitmap(rows.size());
+      setNulls(nulls);
+      bool useDict = byte();
+      std::vector<std::string> dict;
+      if (useDict) {
+        auto num = count();
+        dict.reserve(num);
+        for (size_t i = 0; i < num; i++) {
+          dict.emplace_back(str());
+        }
+      }
+      for (size_t i = 0; i < rows.size(); i++) {
+        if (!nulls.empty() && nulls[i]) {
+          continue;
+        }
+        if (!useDict) {
+          rows[i].values[col] = str();
+          continue;
+        }
+        auto index = varint();
+        if (index >= dict.size()) {
+          throw std::out_of_range("Bad dictionary index");
+        }
+        rows[i].values[col] = dict[index];
+      }
+      break;
+    }
+    case ColumnKind::kBoxed: {
+      bool useDict = byte();
+      std::vector<Value> dict;
+      if (useDict) {
+        auto num = count();
+        dict.reserve(num);
+        for (size_t i = 0; i < num; i++) {
+          dict.emplace_back(value());
+        }
+      }
+      for (auto& row : rows) {
+        if (!useDict) {
+          row.values[col] = value();
+          continue;
+        }
+        auto index = varint();
+        if (index >= dict.size()) {
+          throw std::out_of_range("Bad dictionary index");
+        }
+        row.values[col] = dict[index];
+      }
+      break;
+    }
+    default:
+      throw std::out_of_range(
+          folly::stringPrintf("Unknown column kind %d", static_cast<int32_t>(kind)));
+  }
+}
+
+Value Reader::value() {
+  auto tag = static_cast<ValueTag>(byte());
+  switch (tag) {
+    case ValueTag::kEmpty:
+      return Value::kEmpty;
+    case ValueTag::kNull:
+      return Value(static_cast<NullType>(byte()));
+    case ValueTag::kBool:
+      return Value(static_cast<bool>(byte()));
+    case ValueTag::kInt:
+      return Value(signedVarint());
+    case ValueTag::kFloat:
+      return Value(float64());
+    case ValueTag::kString:
+      return Value(str());
+    case ValueTag::kDate: {
+      auto year = static_cast<int16_t>(signedVarint());
+      auto month = static_cast<int8_t>(byte());
+      auto day = static_cast<int8_t>(byte());
+      return Value(Date(year, month, day));
+    }
+    case ValueTag::kTime: {
+      auto hour = static_cast<int8_t>(byte());
+      auto minute = static_cast<int8_t>(byte());
+      auto sec = static_cast<int8_t>(byte());
+      auto microsec = static_cast<int32_t>(varint());
+      return Value(Time(hour, minute, sec, microsec));
+    }
+    case ValueTag::kDateTime: {
+      auto year = static_cast<int16_t>(signedVarint());
+      auto month = static_cast<int8_t>(byte());
+      auto day = static_cast<int8_t>(byte());
+      auto hour = static_cast<int8_t>(byte());
+      auto minute = static_cast<int8_t>(byte());
+      auto sec = static_cast<int8_t>(byte());
+      auto microsec = static_cast<int32_t>(varint());
+      return Value(DateTime(year, month, day, hour, minute, sec, microsec));
+    }
+    case ValueTag::kVertex:
+      return Value(vertex());
+    case ValueTag::kEdge: {
+      Edge edge;
+      edge.src = value();
+      edge.dst = value();
+      edge.type = static_cast<EdgeType>(signedVarint());
+      edge.name = name();
+      edge.ranking = signedVarint();
+      edge.props = props();
+      return Value(std::move(edge));
+    }
+    case ValueTag::kPath: {
+      Path path;
+      path.src = vertex();
+      auto num = count();
+      path.steps.reserve(num);
+      for (size_t i = 0; i < num; i++) {
+        Step step;
+        step.dst = vertex();
+        step.type = static_cast<EdgeType>(signedVarint());
+        step.name = name();
+        step.ranking = signedVarint();
+        step.props = props();
+        path.steps.emplace_back(std::move(step));
+      }
+      return Value(std::move(path));
+    }
+    case ValueTag::kList: {
+      List list;
+      auto num = count();
+      list.values.reserve(num);
+      for (size_t i = 0; i < num; i++) {
+        list.values.emplace_back(value());
+      }
+      return Value(std::move(list));
+    }
+    case ValueTag::kMap: {
+      Map map;
+      map.kvs = props();
+      return Value(std::move(map));
+    }
+    case ValueTag::kSet: {
+      Set set;
+      auto num = count();
+      for (size_t i = 0; i < num; i++) {
+        set.values.emplace(value());
+      }
+      return Value(std::move(set));
+    }
+    case ValueTag::kDataSet: {
+      DataSet ds;
+      auto numCols = count();
+      for (size_t i = 0; i < numCols; i++) {
+        ds.colNames.emplace_back(str());
+      }
+      auto numRows = varint();
+      for (size_t i = 0; i < numRows; i++) {
+        Row row;
+        row.values.reserve(numCols);
+        for (size_t j = 0; j < numCols; j++) {
+          row.values.emplace_back(value());
+        }
+        ds.rows.emplace_back(std::move(row));
+      }
+      return Value(std::move(ds));
+    }
+    case ValueTag::kGeography: {
+      auto geo = Geography::fromWKB(str());
+      if (!geo.ok()) {
+        throw std::out_of_range(geo.status().toString());
+      }
+      return Value(std::move(geo).value());
+    }
+    case ValueTag::kDuration: {
+      Duration duration;
+      duration.seconds = signedVarint();
+      duration.microseconds = static_cast<int32_t>(signedVarint());
+      duration.months = static_cast<int32_t>(signedVarint());
+      return Value(std::move(duration));
+    }
+  }
+  throw std::out_of_range(folly::stringPrintf("Unknown value tag %d", static_cast<int32_t>(tag)));
+}
+
+}  // namespace
+
+// static
+std::string CompactDataSet::encode(const DataSet& ds, bool compress) {
+  std::string encoded;
+  encoded.push_back(static_cast<char>(kVersion));
+  encoded.push_back(static_cast<char>(Compression::kNone));
+  Writer writer(&encoded);
+  writer.varint(ds.colNames.size());
+  for (const auto& colName : ds.colNames) {
+    writer.str(colName);
+  }
+  writer.varint(ds.rows.size());
+  for (size_t i = 0; i < ds.colNames.size(); i++) {
+    writer.column(ds.rows, i);
+  }
+
+  constexpr size_t kHeaderSize = 2;
+  auto body = folly::StringPiece(encoded).subpiece(kHeaderSize);
+  if (!compress || body.size() < FLAGS_compact_result_compression_min_size) {
+    return encoded;
+  }
+  auto compressed = lz4Codec()->compress(body);
+  if (compressed.size() >= body.size()) {
+    return encoded;
+  }
+  std::string ret;
+  ret.reserve(kHeaderSize + compressed.size());
+  ret.push_back(static_cast<char>(kVersion));
+  ret.push_back(static_cast<char>(Compression::kLz4));
+  ret.append(compressed);
+  return ret;
+}
+
+// static
+StatusOr<DataSet> CompactDataSet::decode(folly::StringPiece encoded) {
+  try {
+    Reader header(encoded);
+    auto version = header.byte();
+    if (version != kVersion) {
+      return Status::Error("Unknown compact data set version %d", version);
+    }
+    auto compression = static_cast<Compression>(header.byte());
+    auto body = encoded.subpiece(2);
+    std::string uncompressed;
+    if (compression == Compression::kLz4) {
+      uncompressed = lz4Codec()->uncompress(body);
+      body = uncompressed;
+    } else if (compression != Compression::kNone) {
+      return Status::Error("Unknown compact data set compression %d",
+                           static_cast<int32_t>(compression));
+    }
+
+    Reader reader(body);
+    DataSet ds;
+    auto numCols = reader.varint();
+    for (size_t i = 0; i < numCols; i++) {
+      ds.colNames.emplace_back(reader.str());
+    }
+    auto numRows = reader.varint();
+    ds.rows.resize(numRows);
+    for (auto& row : ds.rows) {
+      row.values.resize(numCols);
+    }
+    for (size_t i = 0; i < numCols; i++) {
+      reader.column(ds.rows, i);
+    }
+    if (!reader.done()) {
+      return Status::Error("Trailing bytes of the compact data set");
+    }
+    return ds;
+  } catch (const std::exception& e) {
+    return Status::Error("Corrupted compact data set: %s", e.what());
+  }
+}
+
+}  // namespace nebula
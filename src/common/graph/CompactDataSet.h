@@ -0,0 +1,55 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_GRAPH_COMPACTDATASET_H_
+#define COMMON_GRAPH_COMPACTDATASET_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/DataSet.h"
+
+DECLARE_uint32(compact_result_compression_min_size);
+
+namespace nebula {
+
+/**
+ * @brief The columnar encoding of a DataSet returned to the clients which ask for it, which is
+ * much smaller and cheaper to serialize than the rows of Value unions of thrift.
+ *
+ * The encoded starts with a byte of the version and a byte of the compression. The rest, LZ4
+ * framed if it's compressed, is made of the column names, the number of the rows and the columns.
+ * All the integers are varints, and the signed ones are zigzag encoded. Each column starts with
+ * its kind:
+ *  - kNull: all NULL
+ *  - kBool, kInt, kFloat: a NULL bitmap, then the packed bits, the varints or the little endian
+ *    doubles of the rows, where a NULL holds the default
+ *  - kString, kBoxed: a NULL bitmap for kString, then the values of the rows, or the dictionary of
+ *    the distinct values and the indexes of the rows into it if there are many repeated values
+ *
+ * A NULL bitmap is a byte of whether there is any NULL, followed by a bit per row if so. The names
+ * of the tags, the edges, the properties and the map keys in the boxed values are numbered by
+ * their first occurrence in the whole data set, and only the numbers are written for the others.
+ */
+class CompactDataSet final {
+ public:
+  static constexpr uint8_t kVersion = 1;
+
+  enum class Compression : uint8_t {
+    kNone = 0,
+    kLz4 = 1,
+  };
+
+  /**
+   * @brief Encode the data set, which is compressed if compress is true and it's larger than
+   * FLAGS_compact_result_compression_min_size and smaller after compression.
+   */
+  static std::string encode(const DataSet& ds, bool compress);
+
+  static StatusOr<DataSet> decode(folly::StringPiece encoded);
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_GRAPH_COMPACTDATASET_H_
@@ -53,6 +53,12 @@ struct TccStructTraits<::nebula::ExecutionResponse> {
     } else if (_fname == "comment") {
       fid = 7;
       _ftype = apache::thrift::protocol::T_STRING;
+    } else if (_fname == "compact_data") {
+      fid = 8;
+      _ftype = apache::thrift::protocol::T_STRING;
+    } else if (_fname == "cursor_id") {
+      fid = 9;
+      _ftype = apache::thrift::protocol::T_I64;
     }
   }
 };
@@ -104,6 +110,17 @@ uint32_t Cpp2Ops<::nebula::ExecutionResponse>::write(Protocol* proto,
     xfer += proto->writeBinary(*obj->comment);
     xfer += proto->writeFieldEnd();
   }
+  if (obj->compactData != nullptr) {
+    xfer += proto->writeFieldBegin("compact_data", apache::thrift::protocol::T_STRING, 8);
+    xfer += proto->writeBinary(*obj->compactData);
+    xfer += proto->writeFieldEnd();
+  }
+  if (obj->cursorId != nullptr) {
+    xfer += proto->writeFieldBegin("cursor_id", apache::thrift::protocol::T_I64, 9);
+    xfer += ::apache::thrift::detail::pm::protocol_methods<::apache::thrift::type_class::integral,
+                                                           int64_t>::write(*proto, *obj->cursorId);
+    xfer += proto->writeFieldEnd();
+  }
   xfer += proto->writeFieldStop();
   xfer += proto->writeStructEnd();
   return xfer;
@@ -183,7 +200,24 @@ _readField_comment : {
   //    this->__isset.comment = true;
 }
 
-  if (UNLIKELY(!_readState.advanceToNextField(proto, 7, 0, apache::thrift::protocol::T_STOP))) {
+  if (UNLIKELY(!_readState.advanceToNextField(proto, 7, 8, apache::thrift::protocol::T_STRING))) {
+    goto _loop;
+  }
+_readField_compact_data : {
+  obj->compactData = std::make_unique<std::string>();
+  proto->readBinary(*obj->compactData);
+}
+
+  if (UNLIKELY(!_readState.advanceToNextField(proto, 8, 9, apache::thrift::protocol::T_I64))) {
+    goto _loop;
+  }
+_readField_cursor_id : {
+  obj->cursorId = std::make_unique<int64_t>(0);
+  ::apache::thrift::detail::pm::protocol_methods<::apache::thrift::type_class::integral,
+                                                 int64_t>::read(*proto, *obj->cursorId);
+}
+
+  if (UNLIKELY(!_readState.advanceToNextField(proto, 9, 0, apache::thrift::protocol::T_STOP))) {
     goto _loop;
   }
 
@@ -257,6 +291,20 @@ _loop:
         goto _skip;
       }
     }
+    case 8: {
+      if (LIKELY(_readState.fieldType == apache::thrift::protocol::T_STRING)) {
+        goto _readField_compact_data;
+      } else {
+        goto _skip;
+      }
+    }
+    case 9: {
+      if (LIKELY(_readState.fieldType == apache::thrift::protocol::T_I64)) {
+        goto _readField_cursor_id;
+      } else {
+        goto _skip;
+      }
+    }
     default: {
 _skip:
       proto->skip(_readState.fieldType);
@@ -301,6 +349,16 @@ uint32_t Cpp2Ops<::nebula::ExecutionResponse>::serializedSize(
     xfer += proto->serializedFieldSize("comment", apache::thrift::protocol::T_STRING, 7);
     xfer += proto->serializedSizeBinary(obj->comment);
   }
+  if (obj->compactData != nullptr) {
+    xfer += proto->serializedFieldSize("compact_data", apache::thrift::protocol::T_STRING, 8);
+    xfer += proto->serializedSizeBinary(obj->compactData);
+  }
+  if (obj->cursorId != nullptr) {
+    xfer += proto->serializedFieldSize("cursor_id", apache::thrift::protocol::T_I64, 9);
+    xfer += ::apache::thrift::detail::pm::
+        protocol_methods<::apache::thrift::type_class::integral, int64_t>::serializedSize<false>(
+            *proto, *obj->cursorId);
+  }
   xfer += proto->serializedSizeStop();
   return xfer;
 }
@@ -339,6 +397,16 @@ uint32_t Cpp2Ops<::nebula::ExecutionResponse>::serializedSizeZC(
     xfer += proto->serializedFieldSize("comment", apache::thrift::protocol::T_STRING, 7);
     xfer += proto->serializedSizeZCBinary(*obj->comment);
   }
+  if (obj->compactData != nullptr) {
+    xfer += proto->serializedFieldSize("compact_data", apache::thrift::protocol::T_STRING, 8);
+    xfer += proto->serializedSizeZCBinary(*obj->compactData);
+  }
+  if (obj->cursorId != nullptr) {
+    xfer += proto->serializedFieldSize("cursor_id", apache::thrift::protocol::T_I64, 9);
+    xfer += ::apache::thrift::detail::pm::
+        protocol_methods<::apache::thrift::type_class::integral, int64_t>::serializedSize<false>(
+            *proto, *obj->cursorId);
+  }
   xfer += proto->serializedSizeStop();
   return xfer;
 }
@@ -483,6 +483,8 @@ struct ExecutionResponse {
     errorMsg.reset();
     planDesc.reset();
     comment.reset();
+    compactData.reset();
+    cursorId.reset();
   }
 
   void clear() {
@@ -511,6 +513,12 @@ struct ExecutionResponse {
     if (!checkPointer(comment.get(), rhs.comment.get())) {
       return false;
     }
+    if (!checkPointer(compactData.get(), rhs.compactData.get())) {
+      return false;
+    }
+    if (!checkPointer(cursorId.get(), rhs.cursorId.get())) {
+      return false;
+    }
     return true;
   }
 
@@ -521,6 +529,10 @@ struct ExecutionResponse {
   std::unique_ptr<std::string> errorMsg{nullptr};
   std::unique_ptr<PlanDescription> planDesc{nullptr};
   std::unique_ptr<std::string> comment{nullptr};
+  // The data encoded by CompactDataSet instead of data, if the client asks for it
+  std::unique_ptr<std::string> compactData{nullptr};
+  // The cursor to fetch the rest of the rows by, if there are more than the fetch size
+  std::unique_ptr<int64_t> cursorId{nullptr};
 
   // Returns the response as a JSON string
   // only errorCode and latencyInUs are required fields, the rest are optional
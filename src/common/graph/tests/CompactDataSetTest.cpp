@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Duration.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Geography.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+#include "common/graph/CompactDataSet.h"
+
+namespace nebula {
+
+TEST(CompactDataSetTest, TypedColumns) {
+  DataSet ds({"bool", "int", "float", "string", "null"});
+  for (int64_t i = 0; i < 100; i++) {
+    Value str = i % 7 == 0 ? Value::kNullValue : Value(folly::to<std::string>("str", i % 3));
+    ds.emplace_back(Row({i % 2 == 0,
+                         i % 5 == 0 ? Value::kNullValue : Value(i * -1000),
+                         i * 0.5,
+                         std::move(str),
+                         Value::kNullValue}));
+  }
+  auto encoded = CompactDataSet::encode(ds, false);
+  auto decoded = CompactDataSet::decode(encoded);
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(ds, decoded.value());
+}
+
+TEST(CompactDataSetTest, BoxedColumns) {
+  Vertex vertex("v1", {Tag("tag", {{"name", "Tim"}, {"age", 30}})});
+  Edge edge("v1", "v2", 1, "like", 2, {{"likeness", 90.5}});
+  Path path(vertex, {Step(Vertex("v2", {}), 1, "like", 0, {{"likeness", 1}})});
+  DataSet inner({"a"});
+  inner.emplace_back(Row({1}));
+
+  DataSet ds({"mixed", "structured", "containers"});
+  ds.emplace_back(Row({1, vertex, List({1, "a", Value::kNullValue})}));
+  ds.emplace_back(Row({"a", edge, Set({1, 2})}));
+  ds.emplace_back(Row({Value::kNullBadType, path, Map({{"k", "v"}})}));
+  ds.emplace_back(Row({Value::kEmpty, inner, Value::kNullValue}));
+  ds.emplace_back(Row({Date(2023, 1, 2), Time(1, 2, 3, 4), DateTime(2023, 1, 2, 3, 4, 5, 6)}));
+  ds.emplace_back(Row({Duration(1, 2, 3), Geography(Point(Coordinate(1.0, 2.0))), vertex}));
+  auto encoded = CompactDataSet::encode(ds, false);
+  auto decoded = CompactDataSet::decode(encoded);
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(ds, decoded.value());
+}
+
+TEST(CompactDataSetTest, Dictionary) {
+  Vertex vertex("v1", {Tag("person", {{"name", "Tim"}, {"address", std::string(100, 'a')}})});
+  DataSet ds({"vertex", "string"});
+  for (int64_t i = 0; i < 1000; i++) {
+    ds.emplace_back(Row({vertex, std::string(100, 'b')}));
+  }
+  auto encoded = CompactDataSet::encode(ds, false);
+  // Each of the repeated values is written once with the indexes of the rows
+  EXPECT_LT(encoded.size(), 2 * 1000 + 1000);
+  auto decoded = CompactDataSet::decode(encoded);
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(ds, decoded.value());
+}
+
+TEST(CompactDataSetTest, Compress) {
+  DataSet ds({"id", "name"});
+  for (int64_t i = 0; i < 10000; i++) {
+    ds.emplace_back(Row({i, folly::to<std::string>("name of the vertex ", i)}));
+  }
+  auto plain = CompactDataSet::encode(ds, false);
+  auto compressed = CompactDataSet::encode(ds, true);
+  EXPECT_LT(compressed.size(), plain.size());
+  EXPECT_EQ(static_cast<uint8_t>(CompactDataSet::Compression::kLz4), compressed[1]);
+  auto decoded = CompactDataSet::decode(compressed);
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(ds, decoded.value());
+
+  // The small ones are not compressed
+  DataSet small({"id"});
+  small.emplace_back(Row({1}));
+  auto encoded = CompactDataSet::encode(small, true);
+  EXPECT_EQ(static_cast<uint8_t>(CompactDataSet::Compression::kNone), encoded[1]);
+}
+
+TEST(CompactDataSetTest, Corrupted) {
+  DataSet ds({"id", "name"});
+  ds.emplace_back(Row({1, "Tim"}));
+  auto encoded = CompactDataSet::encode(ds, false);
+  EXPECT_FALSE(CompactDataSet::decode(encoded.substr(0, encoded.size() - 1)).ok());
+  EXPECT_FALSE(CompactDataSet::decode(encoded + "x").ok());
+  EXPECT_FALSE(CompactDataSet::decode("").ok());
+  encoded[0] = 100;
+  EXPECT_FALSE(CompactDataSet::decode(encoded).ok());
+}
+
+}  // namespace nebula
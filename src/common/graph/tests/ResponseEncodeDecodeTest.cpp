@@ -62,6 +62,14 @@ TEST(ResponseEncodeDecodeTest, Basic) {
                                          nullptr,
                                          std::make_unique<std::string>("test_space"),
                                          std::make_unique<std::string>("Error Msg.")});
+    resps.emplace_back(ExecutionResponse{ErrorCode::SUCCEEDED,
+                                         233,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         std::make_unique<std::string>("compact data")});
     for (const auto &resp : resps) {
       std::string buf;
       buf.reserve(128);
@@ -151,6 +159,14 @@ TEST(ResponseEncodeDecodeTest, ToJson) {
                                          nullptr,
                                          std::make_unique<std::string>("test_space"),
                                          std::make_unique<std::string>("Error Msg.")});
+    resps.emplace_back(ExecutionResponse{ErrorCode::SUCCEEDED,
+                                         233,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         std::make_unique<std::string>("compact data")});
     for (const auto &resp : resps) {
       std::string buf;
       buf.reserve(128);
@@ -8,15 +8,18 @@
 namespace nebula {
 
 StatusOr<int64_t> SegmentId::getId() {
+  auto ret = getIds(1);
+  NG_RETURN_IF_ERROR(ret);
+  return ret.value().first;
+}
+
+StatusOr<std::pair<int64_t, int64_t>> SegmentId::getIds(int64_t num) {
+  if (num <= 0) {
+    return Status::Error("The number of ids should be positive");
+  }
   std::lock_guard<std::mutex> guard(mutex_);
 
-  if (cur_ < segmentStart_ + step_ - 1) {
-    // non-block prefetch next segment
-    if (cur_ == segmentStart_ + (step_ / 2) - 1) {
-      asyncFetchSegment();
-    }
-    cur_ += 1;
-  } else {  // cur == segment end
+  if (cur_ >= segmentStart_ + step_ - 1) {  // cur == segment end
     if (segmentStart_ >= nextSegmentStart_) {
       // indicate asyncFetchSegment() failed or fetchSegment() slow
       LOG(ERROR)
@@ -27,10 +30,18 @@ StatusOr<int64_t> SegmentId::getId() {
       nextSegmentStart_ = xRet.value();
     }
     segmentStart_ = nextSegmentStart_;
-    cur_ = segmentStart_;
+    cur_ = segmentStart_ - 1;
   }
 
-  return cur_;
+  auto first = cur_ + 1;
+  auto count = std::min(num, segmentStart_ + step_ - first);
+  // non-block prefetch next segment once the ids reach the half of the segment
+  auto half = segmentStart_ + (step_ / 2);
+  if (first <= half && half < first + count) {
+    asyncFetchSegment();
+  }
+  cur_ += count;
+  return std::make_pair(first, count);
 }
 
 void SegmentId::asyncFetchSegment() {
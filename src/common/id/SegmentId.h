@@ -25,6 +25,10 @@ class SegmentId {
 
   StatusOr<int64_t> getId();
 
+  // Reserve the ids [first, first + count) at once, as {first, count}, 0 < count <= num.
+  // The count is less than num at the end of a segment, get the rest by calling again.
+  StatusOr<std::pair<int64_t, int64_t>> getIds(int64_t num);
+
  private:
   // when get id fast or fetchSegment() slow or fail, getSegmentId() directly.
   // In this case, the new segment will overlap with the old one.
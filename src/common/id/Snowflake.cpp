@@ -30,6 +30,34 @@ int64_t Snowflake::getId() {
   return getIdByTs(timestamp);
 }
 
+std::pair<int64_t, int64_t> Snowflake::getIds(int64_t num) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  int64_t timestamp = getTimestamp();
+  if (timestamp < lastTimestamp_ || num <= 1) {
+    if (timestamp < lastTimestamp_) {
+      LOG(ERROR) << "Clock back";
+      return {kFirstBitRevert & getIdByTs(timestamp), 1};
+    }
+    return {getIdByTs(timestamp), 1};
+  }
+
+  int64_t first = 0;
+  if (lastTimestamp_ == timestamp) {
+    if (sequence_ == kMaxSequence) {
+      timestamp = nextTimestamp();
+    } else {
+      first = sequence_ + 1;
+    }
+  }
+  // The sequences are the lowest bits, so the ids of one millisecond are consecutive
+  auto count = std::min(num, kMaxSequence - first + 1);
+  sequence_ = first + count - 1;
+  lastTimestamp_ = timestamp;
+  auto id = (timestamp - kStartStmp) << kTimestampLeft | workerId_ << kWorkerIdLeft | first;
+  return {id, count};
+}
+
 // get snowflake id by timestamp
 // update lastTimestamp_ or sequence_
 int64_t Snowflake::getIdByTs(int64_t timestamp) {
@@ -24,6 +24,11 @@ class Snowflake {
 
   int64_t getId();
 
+  // Reserve the ids [first, first + count) at once, as {first, count}, 0 < count <= num.
+  // They are of the sequences of one millisecond, so count is less than num beyond the
+  // sequences left, get the rest by calling again.
+  std::pair<int64_t, int64_t> getIds(int64_t num);
+
  private:
   static int64_t getTimestamp();
 
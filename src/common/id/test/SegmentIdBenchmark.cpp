@@ -57,6 +57,44 @@ size_t SegmentIdCurrencyTest(size_t iters, int threadNum) {
   return iters * ops * threadNum;
 }
 
+// The ids are got in batches of batchSize, it returns the number of ids
+size_t SegmentIdBatchCurrencyTest(size_t iters, int threadNum, int64_t batchSize) {
+  constexpr size_t ops = 1000000UL;
+  int step = 120000000;
+
+  MockMetaClient metaClient = MockMetaClient();
+  std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager(
+      PriorityThreadManager::newPriorityThreadManager(32));
+  threadManager->setNamePrefix("executor");
+  threadManager->start();
+
+  nebula::SegmentId generator = nebula::SegmentId(&metaClient, threadManager.get());
+  nebula::Status status = generator.init(step);
+  ASSERT(status.ok());
+
+  auto proc = [&]() {
+    auto n = static_cast<int64_t>(iters * ops);
+    for (int64_t i = 0; i < n;) {
+      auto ids = generator.getIds(std::min(batchSize, n - i));
+      folly::doNotOptimizeAway(ids);
+      i += ids.value().second;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadNum);
+
+  for (int i = 0; i < threadNum; i++) {
+    threads.emplace_back(std::thread(proc));
+  }
+
+  for (int i = 0; i < threadNum; i++) {
+    threads[i].join();
+  }
+
+  return iters * ops * threadNum;
+}
+
 BENCHMARK_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 1_thread, 1)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 2_thread, 2)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 4_thread, 4)
@@ -64,6 +102,12 @@ BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 8_thread, 8)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 16_thread, 16)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 32_thread, 32)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdCurrencyTest, 64_thread, 64)
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(SegmentIdBatchCurrencyTest, 1_thread_batch_100, 1, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdBatchCurrencyTest, 8_thread_batch_100, 8, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdBatchCurrencyTest, 64_thread_batch_100, 64, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SegmentIdBatchCurrencyTest, 64_thread_batch_1000, 64, 1000)
 
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
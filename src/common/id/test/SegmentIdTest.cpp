@@ -82,4 +82,37 @@ TEST_F(TestSegmentId, TestConcurrencyBigStep) {
   }
 }
 
+// the ids of the batches are not duplicated, and cover all the ids of the segment
+TEST_F(TestSegmentId, TestConcurrencyBatch) {
+  SegmentId generator = SegmentId(&metaClient_, threadManager_.get());
+  Status status = generator.init(120000000);
+  int batch = 100;
+
+  auto proc = [&]() {
+    for (int i = 0; i < times_ / batch; i++) {
+      auto ids = generator.getIds(batch);
+      ASSERT_TRUE(ids.ok());
+      auto [first, count] = ids.value();
+      ASSERT_EQ(batch, count);
+      for (int64_t id = first; id < first + count; id++) {
+        ASSERT_TRUE(map_.find(id) == map_.end()) << "id: " << id;
+        map_.insert(id, 0);
+      }
+    }
+  };
+
+  for (int i = 0; i < threadNum_; i++) {
+    threads_.emplace_back(std::thread(proc));
+  }
+
+  for (int i = 0; i < threadNum_; i++) {
+    threads_[i].join();
+  }
+
+  for (int i = 0; i < (times_ * threadNum_); i++) {
+    ASSERT_TRUE(map_.find(i) != map_.end()) << "id: " << i;
+  }
+  ASSERT_FALSE(generator.getIds(0).ok());
+}
+
 }  // namespace nebula
@@ -47,6 +47,34 @@ size_t SnowflakeCurrencyTest(size_t iters, int threadNum) {
   return iters * ops * threadNum;
 }
 
+// The ids are got in batches of batchSize, it returns the number of ids
+size_t SnowflakeBatchCurrencyTest(size_t iters, int threadNum, int64_t batchSize) {
+  constexpr size_t ops = 100000UL;
+
+  nebula::Snowflake generator;
+  std::vector<std::thread> threads;
+  threads.reserve(threadNum);
+
+  auto proc = [&iters, &generator, batchSize]() {
+    auto n = static_cast<int64_t>(iters * ops);
+    for (int64_t i = 0; i < n;) {
+      auto ids = generator.getIds(std::min(batchSize, n - i));
+      folly::doNotOptimizeAway(ids);
+      i += ids.second;
+    }
+  };
+
+  for (int i = 0; i < threadNum; i++) {
+    threads.emplace_back(std::thread(proc));
+  }
+
+  for (int i = 0; i < threadNum; i++) {
+    threads[i].join();
+  }
+
+  return iters * ops * threadNum;
+}
+
 BENCHMARK_NAMED_PARAM_MULTI(SnowflakeTest, 1UL)
 BENCHMARK_DRAW_LINE();
 
@@ -57,6 +85,12 @@ BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeCurrencyTest, 8_thread, 8)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeCurrencyTest, 16_thread, 16)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeCurrencyTest, 32_thread, 32)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeCurrencyTest, 64_thread, 64)
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(SnowflakeBatchCurrencyTest, 1_thread_batch_100, 1, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeBatchCurrencyTest, 8_thread_batch_100, 8, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeBatchCurrencyTest, 64_thread_batch_100, 64, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(SnowflakeBatchCurrencyTest, 64_thread_batch_1000, 64, 1000)
 
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,4 +61,39 @@ TEST(SnowflakeTest, TestConcurrency) {
   }
 }
 
+TEST(SnowflakeTest, TestBatch) {
+  Snowflake::workerId_ = 1;
+  int threadNum = 16;
+  int times = 1000;
+  int batch = 100;
+
+  Snowflake generator;
+  folly::ConcurrentHashMap<int64_t, int> map;
+  std::vector<std::thread> threads;
+  threads.reserve(threadNum);
+
+  auto proc = [&]() {
+    for (int i = 0; i < times; i++) {
+      auto [first, count] = generator.getIds(batch);
+      ASSERT_GT(count, 0);
+      ASSERT_LE(count, batch);
+      // The ids of a batch are of one millisecond
+      ASSERT_EQ(getTimestamp(first), getTimestamp(first + count - 1));
+      for (int64_t id = first; id < first + count; id++) {
+        ASSERT_EQ(getWorkerId(id), 1);
+        ASSERT_TRUE(map.find(id) == map.end()) << "id: " << id;
+        map.insert(id, 0);
+      }
+    }
+  };
+
+  for (int i = 0; i < threadNum; i++) {
+    threads.emplace_back(std::thread(proc));
+  }
+
+  for (int i = 0; i < threadNum; i++) {
+    threads[i].join();
+  }
+}
+
 }  // namespace nebula
@@ -18,6 +18,154 @@ ThreadMemoryStats::~ThreadMemoryStats() {
   }
 }
 
+MemoryTrackerNode* MemoryStats::bindNode(MemoryTrackerNode* node) {
+  auto& stats = threadMemoryStats_;
+  auto* previous = stats.node;
+  if (previous == node) {
+    return previous;
+  }
+  if (previous != nullptr && stats.pending != 0) {
+    previous->consume(stats.pending, false);
+  }
+  stats.pending = 0;
+  stats.node = node;
+  return previous;
+}
+
+bool MemoryStats::allocNode(int64_t size, bool throw_if_memory_exceeded) {
+  auto& stats = threadMemoryStats_;
+  stats.pending += size;
+  if (stats.pending < kNodeFlushBytes_) {
+    return true;
+  }
+  bool checkLimit = stats.throwOnMemoryExceeded && throw_if_memory_exceeded;
+  if (!stats.node->consume(stats.pending, checkLimit)) {
+    stats.pending -= size;
+    stats.throwOnMemoryExceeded = false;
+    return false;
+  }
+  stats.pending = 0;
+  return true;
+}
+
+void MemoryStats::freeNode(int64_t size) {
+  auto& stats = threadMemoryStats_;
+  stats.pending -= size;
+  if (stats.pending <= -kNodeFlushBytes_) {
+    stats.node->consume(stats.pending, false);
+    stats.pending = 0;
+  }
+}
+
+bool MemoryStats::cancelLargestQuery(MemoryTrackerNode* node) {
+  auto* largest = MemoryTrackerNode::largestQuery();
+  if (largest == nullptr || (node != nullptr && node->query() == largest)) {
+    return false;
+  }
+  largest->cancel();
+  return true;
+}
+
+std::mutex MemoryTrackerNode::queriesLock_;
+MemoryTrackerNode* MemoryTrackerNode::queries_ = nullptr;
+
+MemoryTrackerNode::MemoryTrackerNode(std::shared_ptr<MemoryTrackerNode> parent,
+                                     int64_t limit,
+                                     bool isQuery)
+    : parent_(std::move(parent)), limit_(limit), isQuery_(isQuery) {
+  if (isQuery_) {
+    std::lock_guard<std::mutex> guard(queriesLock_);
+    next_ = queries_;
+    if (queries_ != nullptr) {
+      queries_->prev_ = this;
+    }
+    queries_ = this;
+  }
+}
+
+MemoryTrackerNode::~MemoryTrackerNode() {
+  if (isQuery_) {
+    std::lock_guard<std::mutex> guard(queriesLock_);
+    if (prev_ != nullptr) {
+      prev_->next_ = next_;
+    } else {
+      queries_ = next_;
+    }
+    if (next_ != nullptr) {
+      next_->prev_ = prev_;
+    }
+  }
+  if (parent_ != nullptr) {
+    parent_->consume(-used(), false);
+  }
+}
+
+bool MemoryTrackerNode::consume(int64_t bytes, bool checkLimit) {
+  for (auto* node = this; node != nullptr; node = node->parent_.get()) {
+    auto used = node->used_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (checkLimit && bytes > 0 && (used > node->limit_ || node->cancelled())) {
+      // Revert the nodes added to
+      auto* end = node->parent_.get();
+      for (auto* added = this; added != end; added = added->parent_.get()) {
+        added->used_.fetch_sub(bytes, std::memory_order_relaxed);
+      }
+      return false;
+    }
+  }
+  if (bytes > 0) {
+    for (auto* node = this; node != nullptr; node = node->parent_.get()) {
+      auto used = node->used();
+      auto peak = node->peak();
+      while (used > peak && !node->peak_.compare_exchange_weak(peak, used)) {
+      }
+    }
+  }
+  return true;
+}
+
+const MemoryTrackerNode* MemoryTrackerNode::query() const {
+  auto* node = this;
+  while (node != nullptr && !node->isQuery_) {
+    node = node->parent_.get();
+  }
+  return node;
+}
+
+MemoryTrackerNode* MemoryTrackerNode::largestQuery() {
+  std::lock_guard<std::mutex> guard(queriesLock_);
+  MemoryTrackerNode* largest = nullptr;
+  for (auto* node = queries_; node != nullptr; node = node->next_) {
+    if (largest == nullptr || node->used() > largest->used()) {
+      largest = node;
+    }
+  }
+  return largest;
+}
+
+const folly::RequestToken& MemoryTrackerData::token() {
+  static folly::RequestToken token("nebula::memory");
+  return token;
+}
+
+std::shared_ptr<MemoryTrackerNode> MemoryTrackerData::current() {
+  auto* data = folly::RequestContext::get()->getContextData(token());
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return static_cast<MemoryTrackerData*>(data)->node();
+}
+
+MemoryCheckGuard::MemoryCheckGuard() : node(MemoryTrackerData::current()) {
+  previous = MemoryStats::throwOnMemoryExceeded();
+  MemoryStats::turnOnThrow();
+  previousNode = MemoryStats::bindNode(node.get());
+}
+
+MemoryCheckGuard::~MemoryCheckGuard() {
+  MemoryStats::bindNode(previousNode);
+  MemoryStats::setThrowOnMemoryExceeded(previous);
+}
+
 void MemoryTracker::alloc(int64_t size) {
   bool throw_if_memory_exceeded = true;
   allocImpl(size, throw_if_memory_exceeded);
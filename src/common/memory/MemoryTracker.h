@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include <folly/io/async/Request.h>
+
 #include <atomic>
 #include <new>
 
@@ -35,6 +37,8 @@ constexpr size_t
     CACHE_LINE_SIZE = 64;
 #endif
 
+class MemoryTrackerNode;
+
 // Memory stats for each thread.
 struct ThreadMemoryStats {
   ThreadMemoryStats();
@@ -43,6 +47,9 @@ struct ThreadMemoryStats {
   // reserved bytes size in current thread
   int64_t reserved;
   bool throwOnMemoryExceeded{false};
+  // The node the memory of current thread is attributed to, and the bytes not added to it yet
+  MemoryTrackerNode* node{nullptr};
+  int64_t pending{0};
 };
 
 /**
@@ -81,10 +88,27 @@ class MemoryStats {
     // Only update after successful allocations, failed allocations should not be taken into
     // account.
     threadMemoryStats_.reserved = willBe;
+    if (UNLIKELY(threadMemoryStats_.node != nullptr) &&
+        !allocNode(size, throw_if_memory_exceeded)) {
+      // The node of current thread exceeds its limit, revert the global
+      freeLocal(size);
+      throw std::bad_alloc();
+    }
   }
 
   /// Inform size of memory deallocation
   inline ALWAYS_INLINE void free(int64_t size) {
+    if (UNLIKELY(threadMemoryStats_.node != nullptr)) {
+      freeNode(size);
+    }
+    freeLocal(size);
+  }
+
+  /// Attribute the memory of current thread to node from now on, nullptr to stop it. Return
+  /// the node attributed to before.
+  static MemoryTrackerNode* bindNode(MemoryTrackerNode* node);
+
+  inline ALWAYS_INLINE void freeLocal(int64_t size) {
     threadMemoryStats_.reserved += size;
     // Return if local reserved exceed limit
     while (threadMemoryStats_.reserved > kLocalReservedLimit_) {
@@ -159,6 +183,12 @@ class MemoryStats {
   inline ALWAYS_INLINE void allocGlobal(int64_t size, bool throw_if_memory_exceeded) {
     int64_t willBe = size + used_.fetch_add(size, std::memory_order_relaxed);
     if (threadMemoryStats_.throwOnMemoryExceeded && throw_if_memory_exceeded && willBe > limit_) {
+      // Cancel the largest query rather than fail the one allocating, unless it's the largest or
+      // the memory is far beyond the limit already
+      if (willBe - limit_ <= limit_ / kOvercommitRatio_ &&
+          cancelLargestQuery(threadMemoryStats_.node)) {
+        return;
+      }
       // revert
       used_.fetch_sub(size, std::memory_order_relaxed);
       threadMemoryStats_.throwOnMemoryExceeded = false;
@@ -166,6 +196,12 @@ class MemoryStats {
     }
   }
 
+  bool allocNode(int64_t size, bool throw_if_memory_exceeded);
+
+  void freeNode(int64_t size);
+
+  static bool cancelLargestQuery(MemoryTrackerNode* node);
+
  private:
   // Global
   alignas(CACHE_LINE_SIZE) int64_t limit_{std::numeric_limits<int64_t>::max()};
@@ -174,19 +210,124 @@ class MemoryStats {
   static thread_local ThreadMemoryStats threadMemoryStats_;
   // Each thread reserves this amount of memory
   static constexpr int64_t kLocalReservedLimit_ = 1 * MiB;
+  // Each thread adds to its node once it has this amount of memory pending
+  static constexpr int64_t kNodeFlushBytes_ = 64 * KiB;
+  // The memory could exceed the limit by 1/kOvercommitRatio_ while the query cancelled releases
+  static constexpr int64_t kOvercommitRatio_ = 20;
 };
 
-// A guard to only enable memory check (throw when memory exceed) during its lifetime.
-struct MemoryCheckGuard {
-  bool previous;
-  MemoryCheckGuard() {
-    previous = MemoryStats::throwOnMemoryExceeded();
-    MemoryStats::turnOnThrow();
+/**
+ * @brief The memory attributed to a scope, the scopes are nested as the session, the query and
+ * the operator, and each one counts the memory of the scopes under it.
+ *
+ * The memory of a thread is attributed to the node of the folly request context it runs in, which
+ * is bound by MemoryCheckGuard, and added to the node once it has kNodeFlushBytes_ pending. The
+ * memory allocated by one node and freed by another is counted as used in the former and negative
+ * in the latter, their parent counts right, and a node gives back what it counts to its parents
+ * when it's destroyed.
+ */
+class MemoryTrackerNode {
+ public:
+  explicit MemoryTrackerNode(std::shared_ptr<MemoryTrackerNode> parent = nullptr,
+                             int64_t limit = std::numeric_limits<int64_t>::max(),
+                             bool isQuery = false);
+
+  ~MemoryTrackerNode();
+
+  /**
+   * @brief Add bytes to the node and its parents, negative to release
+   *
+   * @param bytes
+   * @param checkLimit Whether to fail if any node would exceed its limit or the query is cancelled
+   * @return false if failed, nothing is added then
+   */
+  bool consume(int64_t bytes, bool checkLimit);
+
+  int64_t used() const {
+    return used_.load(std::memory_order_relaxed);
   }
 
-  ~MemoryCheckGuard() {
-    MemoryStats::setThrowOnMemoryExceeded(previous);
+  int64_t peak() const {
+    return peak_.load(std::memory_order_relaxed);
+  }
+
+  int64_t limit() const {
+    return limit_;
+  }
+
+  bool cancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Cancel the query, its allocations checked fail from now on
+   */
+  void cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
   }
+
+  /**
+   * @brief The query node the node is under, or itself, nullptr if it's not under a query
+   */
+  const MemoryTrackerNode* query() const;
+
+  /**
+   * @brief The query using the most memory, nullptr if there is no query
+   */
+  static MemoryTrackerNode* largestQuery();
+
+ private:
+  std::shared_ptr<MemoryTrackerNode> parent_;
+  const int64_t limit_;
+  const bool isQuery_;
+  std::atomic<int64_t> used_{0};
+  std::atomic<int64_t> peak_{0};
+  std::atomic<bool> cancelled_{false};
+
+  // The list of all query nodes, linked without allocating as the allocations pick from it
+  MemoryTrackerNode* prev_{nullptr};
+  MemoryTrackerNode* next_{nullptr};
+  static std::mutex queriesLock_;
+  static MemoryTrackerNode* queries_;
+};
+
+/**
+ * @brief The MemoryTrackerNode of a folly request context, which the futures of the request carry
+ * to the threads they run in
+ */
+class MemoryTrackerData final : public folly::RequestData {
+ public:
+  explicit MemoryTrackerData(std::shared_ptr<MemoryTrackerNode> node) : node_(std::move(node)) {}
+
+  static const folly::RequestToken& token();
+
+  /**
+   * @brief The node of the request context of current thread, nullptr if none
+   */
+  static std::shared_ptr<MemoryTrackerNode> current();
+
+  bool hasCallback() override {
+    return false;
+  }
+
+  const std::shared_ptr<MemoryTrackerNode>& node() const {
+    return node_;
+  }
+
+ private:
+  std::shared_ptr<MemoryTrackerNode> node_;
+};
+
+// A guard to only enable memory check (throw when memory exceed) during its lifetime, the memory
+// is attributed to the MemoryTrackerNode of the request context meanwhile.
+struct MemoryCheckGuard {
+  bool previous;
+  std::shared_ptr<MemoryTrackerNode> node;
+  MemoryTrackerNode* previousNode;
+
+  MemoryCheckGuard();
+
+  ~MemoryCheckGuard();
 };
 
 struct MemoryCheckOffGuard {
@@ -0,0 +1,61 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/memory/MemoryTracker.h"
+
+namespace nebula {
+namespace memory {
+
+TEST(MemoryTrackerNodeTest, ConsumeTest) {
+  auto session = std::make_shared<MemoryTrackerNode>();
+  auto query = std::make_shared<MemoryTrackerNode>(session, 100, true);
+  auto op = std::make_shared<MemoryTrackerNode>(query);
+  EXPECT_EQ(query.get(), op->query());
+  EXPECT_EQ(nullptr, session->query());
+
+  EXPECT_TRUE(op->consume(60, true));
+  EXPECT_EQ(60, op->used());
+  EXPECT_EQ(60, query->used());
+  EXPECT_EQ(60, session->used());
+  // Exceed the limit of the query, nothing is added
+  EXPECT_FALSE(op->consume(50, true));
+  EXPECT_EQ(60, op->used());
+  EXPECT_EQ(60, session->used());
+  // Not checked
+  EXPECT_TRUE(op->consume(50, false));
+  EXPECT_EQ(110, query->used());
+  EXPECT_TRUE(op->consume(-80, true));
+  EXPECT_EQ(30, session->used());
+  EXPECT_EQ(110, op->peak());
+
+  // The memory counted is given back to the parents
+  op.reset();
+  EXPECT_EQ(0, query->used());
+  EXPECT_EQ(0, session->used());
+}
+
+TEST(MemoryTrackerNodeTest, CancelTest) {
+  auto unlimited = std::numeric_limits<int64_t>::max();
+  auto small = std::make_shared<MemoryTrackerNode>(nullptr, unlimited, true);
+  auto large = std::make_shared<MemoryTrackerNode>(nullptr, unlimited, true);
+  EXPECT_TRUE(small->consume(10, true));
+  EXPECT_TRUE(large->consume(100, true));
+  EXPECT_EQ(large.get(), MemoryTrackerNode::largestQuery());
+
+  large->cancel();
+  EXPECT_FALSE(large->consume(10, true));
+  EXPECT_TRUE(large->consume(-50, true));
+  EXPECT_TRUE(small->consume(10, true));
+
+  large.reset();
+  EXPECT_EQ(small.get(), MemoryTrackerNode::largestQuery());
+  small.reset();
+  EXPECT_EQ(nullptr, MemoryTrackerNode::largestQuery());
+}
+
+}  // namespace memory
+}  // namespace nebula
@@ -59,6 +59,11 @@ std::unordered_map<std::string, std::pair<cpp2::ConfigMode, bool>> GflagsManager
       {"wal_ttl", {cpp2::ConfigMode::MUTABLE, false}},
       {"clean_wal_interval_secs", {cpp2::ConfigMode::MUTABLE, false}},
       {"accept_partial_success", {cpp2::ConfigMode::MUTABLE, false}},
+      {"rocksdb_space_block_cache", {cpp2::ConfigMode::MUTABLE, false}},
+      {"rocksdb_space_row_cache_num", {cpp2::ConfigMode::MUTABLE, false}},
+      {"rocksdb_scan_fill_cache", {cpp2::ConfigMode::MUTABLE, false}},
+      {"rocksdb_scan_readahead_size", {cpp2::ConfigMode::MUTABLE, false}},
+      {"kv_prefetch_batch_size", {cpp2::ConfigMode::MUTABLE, false}},
 
       {"rocksdb_db_options", {cpp2::ConfigMode::MUTABLE, true}},
       {"rocksdb_column_family_options", {cpp2::ConfigMode::MUTABLE, true}},
@@ -104,6 +109,11 @@ std::unordered_map<std::string, std::pair<cpp2::ConfigMode, bool>> GflagsManager
 
 /*static*/ std::unordered_map<std::string, std::function<void()>> GflagsManager::callbackMap_;
 
+/*static*/ void GflagsManager::registerCallback(const std::string& conf,
+                                                std::function<void()> callback) {
+  callbackMap_[conf] = std::move(callback);
+}
+
 /*static*/ void GflagsManager::onModified(const std::string& conf) {
   auto it = callbackMap_.find(conf);
   if (it != callbackMap_.end()) {
@@ -30,6 +30,10 @@ class GflagsManager final {
 
   static void onModified(const std::string& conf);
 
+  // Call the callback after conf is modified, it should be registered before the meta client
+  // starts to pull the configs
+  static void registerCallback(const std::string& conf, std::function<void()> callback);
+
  private:
   static std::unordered_map<std::string, std::pair<cpp2::ConfigMode, bool>> parseConfigJson(
       const std::string& json);
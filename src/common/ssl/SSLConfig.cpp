@@ -36,4 +36,9 @@ std::shared_ptr<folly::SSLContext> createSSLContext() {
   return context;
 }
 
+std::shared_ptr<folly::SSLContext> clientSSLContext() {
+  static auto context = createSSLContext();
+  return context;
+}
+
 }  // namespace nebula
@@ -23,5 +23,9 @@ extern std::shared_ptr<wangle::SSLContextConfig> sslContextConfig();
 
 extern std::shared_ptr<folly::SSLContext> createSSLContext();
 
+// The context shared by the client connections, which is created once rather than per connection,
+// with the trusted certificates loaded
+extern std::shared_ptr<folly::SSLContext> clientSSLContext();
+
 }  // namespace nebula
 #endif
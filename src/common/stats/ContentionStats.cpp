@@ -0,0 +1,52 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/stats/ContentionStats.h"
+
+#include <folly/concurrency/ConcurrentHashMap.h>
+
+#include "common/stats/StatsManager.h"
+
+namespace nebula {
+namespace stats {
+
+// static
+std::shared_ptr<ExecutorStats> ExecutorStats::of(const std::string& pool) {
+  static folly::ConcurrentHashMap<std::string, std::shared_ptr<ExecutorStats>> pools;
+  auto iter = pools.find(pool);
+  if (iter != pools.end()) {
+    return iter->second;
+  }
+  // Someone else might have inserted it meanwhile
+  return pools.insert(pool, std::make_shared<ExecutorStats>(pool)).first->second;
+}
+
+ExecutorStats::ExecutorStats(const std::string& pool)
+    : pool_(pool),
+      waits_(StatsManager::latencyHisto("executor_queue_wait_us", {{"pool", pool}})),
+      runs_(StatsManager::latencyHisto("executor_task_run_us", {{"pool", pool}})) {}
+
+void ExecutorStats::onQueued() {
+  // Only the executors whose queues are observed have the gauge
+  std::call_once(gaugeOnce_, [this] {
+    StatsManager::registerGauge("executor_pending_tasks",
+                                {{"pool", pool_}},
+                                [pending = pending_] { return pending->load(); });
+  });
+  pending_->fetch_add(1, std::memory_order_relaxed);
+}
+
+void ExecutorStats::onRun(std::chrono::microseconds wait, std::chrono::microseconds run) {
+  pending_->fetch_sub(1, std::memory_order_relaxed);
+  waits_->add(wait.count());
+  runs_->add(run.count());
+}
+
+std::shared_ptr<LatencyHistogram> lockWaitHisto(const std::string& lock) {
+  return StatsManager::latencyHisto("lock_wait_us", {{"lock", lock}});
+}
+
+}  // namespace stats
+}  // namespace nebula
@@ -0,0 +1,88 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_STATS_CONTENTIONSTATS_H_
+#define COMMON_STATS_CONTENTIONSTATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/stats/LatencyHistogram.h"
+#include "common/thread/TaskObserver.h"
+
+namespace nebula {
+namespace stats {
+
+/**
+ * @brief The queueing of the tasks of an executor, labeled by the pool:
+ *  - executor_queue_wait_us: the time a task waits in the queue
+ *  - executor_task_run_us: the time a task runs
+ *  - executor_pending_tasks: the gauge of the tasks queued or running, if the queue is observed
+ * A long wait with a short run means the pool is saturated, while a long run means the work is
+ * slow.
+ */
+class ExecutorStats final : public thread::TaskObserver {
+ public:
+  // The stats of the pool, shared by the executors of the same name
+  static std::shared_ptr<ExecutorStats> of(const std::string& pool);
+
+  explicit ExecutorStats(const std::string& pool);
+
+  void onQueued() override;
+
+  void onRun(std::chrono::microseconds wait, std::chrono::microseconds run) override;
+
+ private:
+  std::string pool_;
+  std::shared_ptr<LatencyHistogram> waits_;
+  std::shared_ptr<LatencyHistogram> runs_;
+  // Shared with the gauge, which might be read after the stats is destroyed
+  std::shared_ptr<std::atomic<int64_t>> pending_ = std::make_shared<std::atomic<int64_t>>(0);
+  std::once_flag gaugeOnce_;
+};
+
+// The histogram of the time waited for the lock of the name, which is lock_wait_us{lock=name}
+std::shared_ptr<LatencyHistogram> lockWaitHisto(const std::string& lock);
+
+/**
+ * @brief Lock the mutex in the scope like std::lock_guard, whose wait is added to the histogram
+ * if the mutex is held by others. An uncontended lock costs a try_lock only, so the count of the
+ * histogram is the times contended. Nothing is recorded if the histogram is nullptr.
+ */
+template <class Mutex>
+class TimedLockGuard final {
+ public:
+  TimedLockGuard(Mutex& mutex, LatencyHistogram* waits) : mutex_(mutex) {
+    if (waits == nullptr) {
+      mutex_.lock();
+      return;
+    }
+    if (mutex_.try_lock()) {
+      return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    mutex_.lock();
+    waits->add(std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - begin)
+                   .count());
+  }
+
+  TimedLockGuard(const TimedLockGuard&) = delete;
+  TimedLockGuard& operator=(const TimedLockGuard&) = delete;
+
+  ~TimedLockGuard() {
+    mutex_.unlock();
+  }
+
+ private:
+  Mutex& mutex_;
+};
+
+}  // namespace stats
+}  // namespace nebula
+
+#endif  // COMMON_STATS_CONTENTIONSTATS_H_
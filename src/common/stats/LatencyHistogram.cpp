@@ -0,0 +1,104 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/stats/LatencyHistogram.h"
+
+namespace nebula {
+namespace stats {
+
+// static
+size_t LatencyHistogram::bucketOf(int64_t value) {
+  if (value < kSubBuckets) {
+    return value < 0 ? 0 : static_cast<size_t>(value);
+  }
+  int32_t exponent = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+  if (exponent > kMaxExponent) {
+    return kNumBuckets - 1;
+  }
+  auto group = exponent - kSubBucketBits;
+  auto sub = (value >> group) - kSubBuckets;
+  return kSubBuckets + group * kSubBuckets + sub;
+}
+
+// static
+int64_t LatencyHistogram::lowerBoundOf(size_t bucket) {
+  if (bucket < static_cast<size_t>(kSubBuckets)) {
+    return bucket;
+  }
+  auto group = (bucket - kSubBuckets) / kSubBuckets;
+  auto sub = (bucket - kSubBuckets) % kSubBuckets;
+  return static_cast<int64_t>(kSubBuckets + sub) << group;
+}
+
+// static
+const std::vector<int64_t>& LatencyHistogram::exportedBounds() {
+  static const std::vector<int64_t> bounds = []() {
+    std::vector<int64_t> ret;
+    for (int32_t exponent = 3; exponent <= kMaxExponent; exponent++) {
+      ret.emplace_back(1L << exponent);
+      ret.emplace_back(3L << (exponent - 1));
+    }
+    return ret;
+  }();
+  return bounds;
+}
+
+// static
+size_t LatencyHistogram::shardOfThread() {
+  static std::atomic<size_t> next{0};
+  static thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return shard;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+  Snapshot snapshot;
+  for (const auto& shard : shards_) {
+    for (size_t i = 0; i < kNumBuckets; i++) {
+      auto count = shard.counts[i].load(std::memory_order_relaxed);
+      snapshot.counts[i] += count;
+      snapshot.count += count;
+    }
+    snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    counts[i] += other.counts[i];
+  }
+  count += other.count;
+  sum += other.sum;
+}
+
+uint64_t LatencyHistogram::Snapshot::countBelow(int64_t bound) const {
+  auto end = bucketOf(bound);
+  uint64_t ret = 0;
+  for (size_t i = 0; i < end; i++) {
+    ret += counts[i];
+  }
+  return ret;
+}
+
+int64_t LatencyHistogram::Snapshot::percentile(double pct) const {
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(std::ceil(pct / 100 * count));
+  rank = std::min(std::max<uint64_t>(rank, 1), count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    seen += counts[i];
+    if (seen >= rank) {
+      // The middle of the bucket
+      auto lower = lowerBoundOf(i);
+      return lower + (lowerBoundOf(i + 1) - lower) / 2;
+    }
+  }
+  return lowerBoundOf(kNumBuckets - 1);
+}
+
+}  // namespace stats
+}  // namespace nebula
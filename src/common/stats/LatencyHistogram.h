@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_STATS_LATENCYHISTOGRAM_H_
+#define COMMON_STATS_LATENCYHISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace stats {
+
+/**
+ * @brief A cumulative histogram of latencies in the HDR style, i.e. the buckets are log-linear:
+ * each power of two range is divided into 2^kSubBucketBits buckets of the same width, so the
+ * relative error of a value is within 1/2^kSubBucketBits (about 3%), from 1us to hours.
+ *
+ * A value is added to the shard of the current thread by a relaxed atomic increment, without any
+ * lock, and reading merges the shards, so it's cheap to record in the hot path and per label.
+ * The histogram is cumulative since it's created, the rates and the quantiles of the time windows
+ * are left to who scrapes it, e.g. Prometheus.
+ */
+class LatencyHistogram final {
+ public:
+  static constexpr int32_t kSubBucketBits = 5;
+  static constexpr int64_t kSubBuckets = 1L << kSubBucketBits;
+  // The values beyond 2^(kMaxExponent + 1) are counted in the last bucket
+  static constexpr int32_t kMaxExponent = 35;
+  static constexpr size_t kNumBuckets = kSubBuckets * (kMaxExponent - kSubBucketBits + 2);
+  static constexpr size_t kNumShards = 4;
+
+  // The merged counts of the shards, which could be merged with the ones of other histograms
+  struct Snapshot {
+    std::vector<uint64_t> counts = std::vector<uint64_t>(kNumBuckets, 0);
+    uint64_t count{0};
+    int64_t sum{0};
+
+    void merge(const Snapshot& other);
+
+    // The number of the values less than bound, which is a bucket boundary
+    uint64_t countBelow(int64_t bound) const;
+
+    // The estimated value of the percentile pct in [0, 100], 0 if empty
+    int64_t percentile(double pct) const;
+  };
+
+  LatencyHistogram() = default;
+
+  void add(int64_t value) {
+    auto& shard = shards_[shardOfThread()];
+    shard.counts[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  Snapshot snapshot() const;
+
+  static size_t bucketOf(int64_t value);
+
+  // The smallest value of bucket
+  static int64_t lowerBoundOf(size_t bucket);
+
+  /**
+   * @brief The boundaries exported, at each power of two and the middle of it, which are aligned
+   * with the buckets.
+   */
+  static const std::vector<int64_t>& exportedBounds();
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kNumBuckets> counts{};
+    std::atomic<int64_t> sum{0};
+  };
+
+  static size_t shardOfThread();
+
+  std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace stats
+}  // namespace nebula
+
+#endif  // COMMON_STATS_LATENCYHISTOGRAM_H_
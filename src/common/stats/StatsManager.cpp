@@ -299,6 +299,95 @@ void StatsManager::decValue(const CounterId& id, VT value) {
   addValue(id, -value);
 }
 
+// static
+std::string StatsManager::labeledName(folly::StringPiece name,
+                                      const std::vector<LabelPair>& labels) {
+  std::string ret = name.str();
+  if (labels.empty()) {
+    return ret;
+  }
+  ret.append("{");
+  for (auto& [k, v] : labels) {
+    ret.append(k).append("=").append(v).append(",");
+  }
+  ret.back() = '}';
+  return ret;
+}
+
+// static
+std::shared_ptr<LatencyHistogram> StatsManager::latencyHisto(
+    folly::StringPiece name, const std::vector<LabelPair>& labels) {
+  auto& sm = get();
+  auto key = labeledName(name, labels);
+  auto iter = sm.latencyHistos_.find(key);
+  if (iter != sm.latencyHistos_.end()) {
+    return iter->second->histo_;
+  }
+  auto info = std::make_shared<LatencyHistoInfo>();
+  info->name_ = name.str();
+  info->labels_ = labels;
+  info->histo_ = std::make_shared<LatencyHistogram>();
+  // Someone else might have inserted it meanwhile
+  auto ret = sm.latencyHistos_.insert(std::move(key), std::move(info));
+  return ret.first->second->histo_;
+}
+
+// static
+void StatsManager::removeLatencyHisto(folly::StringPiece name,
+                                      const std::vector<LabelPair>& labels) {
+  get().latencyHistos_.erase(labeledName(name, labels));
+}
+
+// static
+void StatsManager::registerGauge(folly::StringPiece name,
+                                 const std::vector<LabelPair>& labels,
+                                 std::function<VT()> read) {
+  get().gauges_.insert_or_assign(labeledName(name, labels),
+                                 std::make_shared<std::function<VT()>>(std::move(read)));
+}
+
+// static
+void StatsManager::removeGauge(folly::StringPiece name, const std::vector<LabelPair>& labels) {
+  get().gauges_.erase(labeledName(name, labels));
+}
+
+// static
+void StatsManager::readAllLatencyHistos(std::string* text) {
+  auto& sm = get();
+  // The histograms of the same name are grouped under one TYPE line
+  std::map<std::string, std::vector<std::shared_ptr<LatencyHistoInfo>>> groups;
+  for (auto iter = sm.latencyHistos_.cbegin(); iter != sm.latencyHistos_.cend(); ++iter) {
+    groups[iter->second->name_].emplace_back(iter->second);
+  }
+  for (auto& [name, infos] : groups) {
+    text->append("# TYPE ").append(name).append(" histogram\n");
+    for (auto& info : infos) {
+      std::string labels;
+      for (auto& [k, v] : info->labels_) {
+        labels.append(k).append("=\"").append(v).append("\",");
+      }
+      auto snapshot = info->histo_->snapshot();
+      for (auto bound : LatencyHistogram::exportedBounds()) {
+        folly::stringAppendf(text,
+                             "%s_bucket{%sle=\"%ld\"} %lu\n",
+                             name.c_str(),
+                             labels.c_str(),
+                             bound,
+                             snapshot.countBelow(bound));
+      }
+      folly::stringAppendf(
+          text, "%s_bucket{%sle=\"+Inf\"} %lu\n", name.c_str(), labels.c_str(), snapshot.count);
+      if (!labels.empty()) {
+        labels.pop_back();
+        labels = "{" + labels + "}";
+      }
+      folly::stringAppendf(text, "%s_sum%s %ld\n", name.c_str(), labels.c_str(), snapshot.sum);
+      folly::stringAppendf(
+          text, "%s_count%s %lu\n", name.c_str(), labels.c_str(), snapshot.count);
+    }
+  }
+}
+
 // static
 bool StatsManager::strToPct(folly::StringPiece part, double& pct) {
   static const int32_t divisors[] = {1, 1, 10, 100, 1000, 10000};
@@ -452,6 +541,10 @@ void StatsManager::readAllValue(folly::dynamic& vals) {
       }
     }
   }
+
+  for (auto iter = sm.gauges_.cbegin(); iter != sm.gauges_.cend(); ++iter) {
+    vals.push_back(folly::dynamic::object(iter->first, (*iter->second)()));
+  }
 }
 
 // static
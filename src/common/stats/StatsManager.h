@@ -14,6 +14,7 @@
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
+#include "common/stats/LatencyHistogram.h"
 #include "common/time/WallClock.h"
 
 namespace nebula {
@@ -136,6 +137,19 @@ class StatsManager final {
   static void addValue(const CounterId& id, VT value = 1);
   static void decValue(const CounterId& id, VT value = 1);
 
+  // The latency histogram of the name and the labels, which is created on the first call. The
+  // caller could keep the histogram to add values to it without looking it up again.
+  static std::shared_ptr<LatencyHistogram> latencyHisto(folly::StringPiece name,
+                                                        const std::vector<LabelPair>& labels = {});
+  static void removeLatencyHisto(folly::StringPiece name, const std::vector<LabelPair>& labels);
+
+  // The gauge of the name and the labels, whose value is read by read when the stats are read,
+  // e.g. the length of a queue. Registering it again replaces the reader.
+  static void registerGauge(folly::StringPiece name,
+                            const std::vector<LabelPair>& labels,
+                            std::function<VT()> read);
+  static void removeGauge(folly::StringPiece name, const std::vector<LabelPair>& labels);
+
   // The parameter counter here must be a qualified counter name, which includes
   // all three parts (counter name, method/percentile, and time range). Here are
   // some examples:
@@ -151,7 +165,10 @@ class StatsManager final {
                                 StatsMethod method);
   static StatusOr<VT> readHisto(const CounterId& id, TimeRange range, double pct);
   static StatusOr<VT> readHisto(const std::string& counterName, TimeRange range, double pct);
+  // The gauges are read as <name>{<k1>=<v1>,...} along the other stats
   static void readAllValue(folly::dynamic& vals);
+  // Append all the latency histograms in the Prometheus text format
+  static void readAllLatencyHistos(std::string* text);
 
  private:
   static StatsManager& get();
@@ -169,6 +186,9 @@ class StatsManager final {
   template <class StatsHolder>
   static VT readValue(StatsHolder& stats, TimeRange range, StatsMethod method);
 
+  // <name>{<k1>=<v1>,<k2>=<v2>}, the name itself if no label
+  static std::string labeledName(folly::StringPiece name, const std::vector<LabelPair>& labels);
+
  private:
   struct CounterInfo {
     CounterId id_;
@@ -210,6 +230,16 @@ class StatsManager final {
   std::unordered_map<std::string,
                      std::pair<std::unique_ptr<std::mutex>, std::unique_ptr<HistogramType>>>
       histograms_;
+
+  struct LatencyHistoInfo {
+    std::string name_;
+    std::vector<LabelPair> labels_;
+    std::shared_ptr<LatencyHistogram> histo_;
+  };
+  // The labeled name => the latency histogram
+  folly::ConcurrentHashMap<std::string, std::shared_ptr<LatencyHistoInfo>> latencyHistos_;
+  // The labeled name => the reader of the gauge
+  folly::ConcurrentHashMap<std::string, std::shared_ptr<std::function<VT()>>> gauges_;
 };
 
 }  // namespace stats
@@ -0,0 +1,90 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/base/Base.h"
+#include "common/stats/ContentionStats.h"
+#include "common/stats/StatsManager.h"
+#include "common/thread/GenericWorker.h"
+
+namespace nebula {
+namespace stats {
+
+static int64_t readGauge(const std::string& name) {
+  auto vals = folly::dynamic::array();
+  StatsManager::readAllValue(vals);
+  for (auto& val : vals) {
+    if (val.count(name)) {
+      return val[name].asInt();
+    }
+  }
+  return -1;
+}
+
+TEST(ContentionStatsTest, ExecutorTest) {
+  auto stats = ExecutorStats::of("test-worker");
+  EXPECT_EQ(stats, ExecutorStats::of("test-worker"));
+  thread::GenericWorker worker;
+  worker.setTaskObserver(stats);
+  ASSERT_TRUE(worker.start());
+
+  folly::Baton<> running;
+  folly::Baton<> release;
+  auto first = worker.addTask([&] {
+    running.post();
+    release.wait();
+  });
+  auto second = worker.addTask([] {});
+  running.wait();
+  EXPECT_EQ(2, readGauge("executor_pending_tasks{pool=test-worker}"));
+  release.post();
+  std::move(first).get();
+  std::move(second).get();
+  ASSERT_TRUE(worker.stop());
+  ASSERT_TRUE(worker.wait());
+  EXPECT_EQ(0, readGauge("executor_pending_tasks{pool=test-worker}"));
+
+  auto waits =
+      StatsManager::latencyHisto("executor_queue_wait_us", {{"pool", "test-worker"}})->snapshot();
+  EXPECT_EQ(2, waits.count);
+  auto runs =
+      StatsManager::latencyHisto("executor_task_run_us", {{"pool", "test-worker"}})->snapshot();
+  EXPECT_EQ(2, runs.count);
+}
+
+TEST(ContentionStatsTest, LockTest) {
+  auto waits = lockWaitHisto("test");
+  std::mutex mutex;
+  // Not contended
+  { TimedLockGuard<std::mutex> guard(mutex, waits.get()); }
+  EXPECT_EQ(0, waits->snapshot().count);
+
+  std::unique_lock<std::mutex> holder(mutex);
+  std::thread locker([&] { TimedLockGuard<std::mutex> guard(mutex, waits.get()); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  holder.unlock();
+  locker.join();
+  auto snapshot = waits->snapshot();
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_GE(snapshot.sum, 10000);
+
+  // Nothing recorded without the histogram
+  { TimedLockGuard<std::mutex> guard(mutex, nullptr); }
+}
+
+}  // namespace stats
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/stats/LatencyHistogram.h"
+#include "common/stats/StatsManager.h"
+
+namespace nebula {
+namespace stats {
+
+TEST(LatencyHistogramTest, BucketTest) {
+  // Linear below the sub buckets
+  for (int64_t value = 0; value < LatencyHistogram::kSubBuckets; value++) {
+    EXPECT_EQ(value, LatencyHistogram::bucketOf(value));
+    EXPECT_EQ(value, LatencyHistogram::lowerBoundOf(value));
+  }
+  EXPECT_EQ(0, LatencyHistogram::bucketOf(-1));
+  // The lower bound of each bucket falls in it, and the buckets are continuous
+  for (size_t bucket = 1; bucket < LatencyHistogram::kNumBuckets; bucket++) {
+    auto lower = LatencyHistogram::lowerBoundOf(bucket);
+    EXPECT_EQ(bucket, LatencyHistogram::bucketOf(lower));
+    EXPECT_EQ(bucket - 1, LatencyHistogram::bucketOf(lower - 1));
+    // The relative error is bounded
+    auto width = LatencyHistogram::lowerBoundOf(bucket + 1) - lower;
+    if (lower >= LatencyHistogram::kSubBuckets) {
+      EXPECT_LE(width * LatencyHistogram::kSubBuckets, lower);
+    } else {
+      EXPECT_EQ(1, width);
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::kNumBuckets - 1, LatencyHistogram::bucketOf(1L << 40));
+  for (auto bound : LatencyHistogram::exportedBounds()) {
+    EXPECT_EQ(bound, LatencyHistogram::lowerBoundOf(LatencyHistogram::bucketOf(bound)));
+  }
+}
+
+TEST(LatencyHistogramTest, PercentileTest) {
+  LatencyHistogram histo;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&histo]() {
+      for (int64_t value = 1; value <= 10000; value++) {
+        histo.add(value);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto snapshot = histo.snapshot();
+  EXPECT_EQ(40000, snapshot.count);
+  EXPECT_EQ(4 * 10000L * 10001 / 2, snapshot.sum);
+  EXPECT_EQ(4 * 9, snapshot.countBelow(10));
+  for (double pct : {50.0, 90.0, 99.0, 99.9}) {
+    auto expected = pct * 100;
+    auto value = snapshot.percentile(pct);
+    EXPECT_LE(std::abs(value - expected), expected / LatencyHistogram::kSubBuckets) << pct;
+  }
+
+  // Merge the snapshot of another histogram
+  LatencyHistogram other;
+  other.add(1000000);
+  snapshot.merge(other.snapshot());
+  EXPECT_EQ(40001, snapshot.count);
+  EXPECT_EQ(40000, snapshot.countBelow(1L << 19));
+  EXPECT_EQ(0, LatencyHistogram().snapshot().percentile(99));
+}
+
+TEST(LatencyHistogramTest, PrometheusTest) {
+  auto histo = StatsManager::latencyHisto("test_latency_us", {{"space", "1"}});
+  EXPECT_EQ(histo.get(), StatsManager::latencyHisto("test_latency_us", {{"space", "1"}}).get());
+  EXPECT_NE(histo.get(), StatsManager::latencyHisto("test_latency_us", {{"space", "2"}}).get());
+  histo->add(10);
+  histo->add(100);
+
+  std::string text;
+  StatsManager::readAllLatencyHistos(&text);
+  EXPECT_NE(std::string::npos, text.find("# TYPE test_latency_us histogram\n"));
+  EXPECT_NE(std::string::npos, text.find("test_latency_us_bucket{space=\"1\",le=\"8\"} 0\n"));
+  EXPECT_NE(std::string::npos, text.find("test_latency_us_bucket{space=\"1\",le=\"12\"} 1\n"));
+  EXPECT_NE(std::string::npos, text.find("test_latency_us_bucket{space=\"1\",le=\"+Inf\"} 2\n"));
+  EXPECT_NE(std::string::npos, text.find("test_latency_us_sum{space=\"1\"} 110\n"));
+  EXPECT_NE(std::string::npos, text.find("test_latency_us_count{space=\"2\"} 0\n"));
+
+  StatsManager::removeLatencyHisto("test_latency_us", {{"space", "2"}});
+  text.clear();
+  StatsManager::readAllLatencyHistos(&text);
+  EXPECT_EQ(std::string::npos, text.find("space=\"2\""));
+}
+
+}  // namespace stats
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 #include "common/stats/StatsManager.h"
 
 using nebula::stats::CounterId;
+using nebula::stats::LatencyHistogram;
 using nebula::stats::StatsManager;
 
 CounterId kCounterStats;
@@ -31,6 +32,28 @@ void statsBM(const CounterId& counterId, uint32_t numThreads, uint32_t iters) {
   }
 }
 
+void latencyBM(uint32_t numThreads, uint32_t iters, bool lookup) {
+  auto histo = StatsManager::latencyHisto("latency", {{"space", "1"}});
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < numThreads; i++) {
+    auto itersInThread =
+        i == 0 ? iters - (iters / numThreads) * (numThreads - 1) : iters / numThreads;
+    threads.emplace_back([&histo, itersInThread, lookup]() {
+      for (uint32_t k = 0; k < itersInThread; k++) {
+        if (lookup) {
+          StatsManager::latencyHisto("latency", {{"space", "1"}})->add(k);
+        } else {
+          histo->add(k);
+        }
+      }
+    });
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
 BENCHMARK(add_stats_value_1t, iters) {
   statsBM(kCounterStats, 1, iters);
 }
@@ -57,6 +80,24 @@ BENCHMARK(add_histogram_value_8t, iters) {
   statsBM(kCounterHisto, 8, iters);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(add_latency_value_1t, iters) {
+  latencyBM(1, iters, false);
+}
+
+BENCHMARK(add_latency_value_4t, iters) {
+  latencyBM(4, iters, false);
+}
+
+BENCHMARK(add_latency_value_8t, iters) {
+  latencyBM(8, iters, false);
+}
+
+BENCHMARK(add_labeled_latency_value_8t, iters) {
+  latencyBM(8, iters, true);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv, true);
 
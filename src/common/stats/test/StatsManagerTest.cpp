@@ -163,6 +163,29 @@ TEST(StatsManager, ReadAllTest) {
   EXPECT_FALSE(counterExists(stats2, "stat04{space=test}.p95.5", val));
 }
 
+TEST(StatsManager, GaugeTest) {
+  std::atomic<int64_t> pending{3};
+  StatsManager::registerGauge("gauge01", {{"pool", "test"}}, [&] { return pending.load(); });
+
+  auto stats = folly::dynamic::array();
+  StatsManager::readAllValue(stats);
+  int64_t val;
+  EXPECT_TRUE(counterExists(stats, "gauge01{pool=test}", val));
+  EXPECT_EQ(3, val);
+
+  // Read when the stats are read
+  pending = 5;
+  stats = folly::dynamic::array();
+  StatsManager::readAllValue(stats);
+  EXPECT_TRUE(counterExists(stats, "gauge01{pool=test}", val));
+  EXPECT_EQ(5, val);
+
+  StatsManager::removeGauge("gauge01", {{"pool", "test"}});
+  stats = folly::dynamic::array();
+  StatsManager::readAllValue(stats);
+  EXPECT_FALSE(counterExists(stats, "gauge01{pool=test}", val));
+}
+
 }  // namespace stats
 }  // namespace nebula
 
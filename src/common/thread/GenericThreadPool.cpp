@@ -25,6 +25,7 @@ bool GenericThreadPool::start(size_t nrThreads, const std::string &name) {
   auto ok = true;
   for (auto i = 0UL; ok && i < nrThreads_; i++) {
     pool_.emplace_back(std::make_unique<GenericWorker>());
+    pool_.back()->setTaskObserver(observer_);
     auto workerName = folly::stringPrintf("%s-%lu", name.c_str(), i);
     ok = ok && pool_.back()->start(std::move(workerName));
   }
@@ -60,6 +60,11 @@ class GenericThreadPool final : public boost::noncopyable, public nebula::cpp::N
    */
   bool wait();
 
+  // Observe the tasks of all workers, must be set before the pool is started
+  void setTaskObserver(std::shared_ptr<TaskObserver> observer) {
+    observer_ = std::move(observer);
+  }
+
   template <typename F, typename... Args>
   using ReturnType = typename std::result_of<F(Args...)>::type;
   template <typename F, typename... Args>
@@ -127,6 +132,7 @@ class GenericThreadPool final : public boost::noncopyable, public nebula::cpp::N
   size_t nrThreads_{0};
   std::atomic<size_t> nextThread_{0};
   std::vector<std::unique_ptr<GenericWorker>> pool_;
+  std::shared_ptr<TaskObserver> observer_;
 };
 
 template <typename F, typename... Args>
@@ -100,6 +100,27 @@ void GenericWorker::notify() {
   DCHECK(len == sizeof(one));
 }
 
+void GenericWorker::addPendingTask(std::function<void()> task) {
+  if (observer_ != nullptr) {
+    observer_->onQueued();
+    auto queued = std::chrono::steady_clock::now();
+    task = [observer = observer_, queued, task = std::move(task)] {
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+      auto begin = std::chrono::steady_clock::now();
+      task();
+      auto end = std::chrono::steady_clock::now();
+      observer->onRun(duration_cast<microseconds>(begin - queued),
+                      duration_cast<microseconds>(end - begin));
+    };
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    pendingTasks_.emplace_back(std::move(task));
+  }
+  notify();
+}
+
 void GenericWorker::onNotify() {
   if (stopped_.load(std::memory_order_acquire)) {
     event_base_loopexit(evbase_, nullptr);
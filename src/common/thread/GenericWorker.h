@@ -13,6 +13,7 @@
 #include "common/base/Base.h"
 #include "common/cpp/helpers.h"
 #include "common/thread/NamedThread.h"
+#include "common/thread/TaskObserver.h"
 
 /**
  * GenericWorker implements a event-based task executor that executes tasks
@@ -69,6 +70,14 @@ class GenericWorker final : public boost::noncopyable, public nebula::cpp::NonMo
    */
   bool wait();
 
+  /**
+   * @brief Observe the tasks added by addTask, the timers are not observed. Must be set before the
+   * worker is started.
+   */
+  void setTaskObserver(std::shared_ptr<TaskObserver> observer) {
+    observer_ = std::move(observer);
+  }
+
   template <typename F, typename... Args>
   using ReturnType = typename std::result_of<F(Args...)>::type;
   template <typename F, typename... Args>
@@ -128,6 +137,9 @@ class GenericWorker final : public boost::noncopyable, public nebula::cpp::NonMo
  private:
   void purgeTimerInternal(uint64_t id);
 
+  // Queue the task to run in the worker thread, timed if observed
+  void addPendingTask(std::function<void()> task);
+
  private:
   struct Timer {
     explicit Timer(std::function<void(void)> cb);
@@ -165,6 +177,7 @@ class GenericWorker final : public boost::noncopyable, public nebula::cpp::NonMo
   std::vector<uint64_t> purgingTimers_;
   std::unordered_map<uint64_t, TimerPtr> activeTimers_;
   std::unique_ptr<NamedThread> thread_;
+  std::shared_ptr<TaskObserver> observer_;
 };
 
 template <typename F, typename... Args>
@@ -174,18 +187,14 @@ auto GenericWorker::addTask(F &&f, Args &&... args) ->
   auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
       std::bind(std::forward<F>(f), std::forward<Args>(args)...));
   auto future = promise->getSemiFuture();
-  {
-    std::lock_guard<std::mutex> guard(lock_);
-    pendingTasks_.emplace_back([=] {
-      try {
-        (*task)();
-        promise->setValue(folly::unit);
-      } catch (const std::exception &ex) {
-        promise->setException(ex);
-      }
-    });
-  }
-  notify();
+  addPendingTask([=] {
+    try {
+      (*task)();
+      promise->setValue(folly::unit);
+    } catch (const std::exception &ex) {
+      promise->setException(ex);
+    }
+  });
   return future;
 }
 
@@ -197,11 +206,7 @@ auto GenericWorker::addTask(F &&f, Args &&... args) ->
   auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
       std::bind(std::forward<F>(f), std::forward<Args>(args)...));
   auto future = promise->getSemiFuture();
-  {
-    std::lock_guard<std::mutex> guard(lock_);
-    pendingTasks_.emplace_back([=] { promise->setWith(*task); });
-  }
-  notify();
+  addPendingTask([=] { promise->setWith(*task); });
   return future;
 }
 
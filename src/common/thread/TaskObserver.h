@@ -0,0 +1,33 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_THREAD_TASKOBSERVER_H_
+#define COMMON_THREAD_TASKOBSERVER_H_
+
+#include <chrono>
+
+namespace nebula {
+namespace thread {
+
+/**
+ * @brief Observe the tasks of an executor, e.g. to tell whether the latency comes from the tasks
+ * queued behind the others or from the tasks themselves. It's called by the threads adding and
+ * running the tasks, so it must be thread safe and cheap.
+ */
+class TaskObserver {
+ public:
+  virtual ~TaskObserver() = default;
+
+  // A task is added to the queue
+  virtual void onQueued() = 0;
+
+  // A task is done, which waited in the queue for wait and ran for run
+  virtual void onRun(std::chrono::microseconds wait, std::chrono::microseconds run) = 0;
+};
+
+}  // namespace thread
+}  // namespace nebula
+
+#endif  // COMMON_THREAD_TASKOBSERVER_H_
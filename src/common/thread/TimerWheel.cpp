@@ -0,0 +1,165 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/thread/TimerWheel.h"
+
+DEFINE_uint32(timer_wheel_tick_ms, 10, "The milliseconds of a tick of the shared timer wheel");
+
+namespace nebula {
+namespace thread {
+
+// static
+TimerWheel& TimerWheel::instance() {
+  static TimerWheel wheel(std::max(FLAGS_timer_wheel_tick_ms, 1U));
+  return wheel;
+}
+
+TimerWheel::TimerWheel(uint32_t tickMs, bool manual) : tickMs_(tickMs) {
+  CHECK_GT(tickMs_, 0U);
+  wheels_.resize(kLevels);
+  wheels_[0].resize(kInnerSlots);
+  for (uint32_t level = 1; level < kLevels; ++level) {
+    wheels_[level].resize(kOuterSlots);
+  }
+  if (!manual) {
+    thread_ = std::make_unique<NamedThread>("timer-wheel", &TimerWheel::loop, this);
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    stopped_ = true;
+  }
+  cond_.notify_all();
+  if (thread_ != nullptr) {
+    thread_->join();
+  }
+}
+
+uint64_t TimerWheel::schedule(uint64_t ms, std::function<void()> task) {
+  auto ticks = std::max<uint64_t>((ms + tickMs_ - 1) / tickMs_, 1);
+  Slot pending;
+  std::lock_guard<std::mutex> g(lock_);
+  auto id = nextId_++;
+  auto it = pending.insert(pending.end(), Timer{id, now_ + ticks, 0, 0, std::move(task)});
+  timers_.emplace(id, it);
+  addLocked(pending, it);
+  return id;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+  // The task is destroyed out of the lock, as it might own the objects cancelling their timers
+  Slot cancelled;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto found = timers_.find(id);
+    if (found == timers_.end()) {
+      return false;
+    }
+    auto it = found->second;
+    timers_.erase(found);
+    cancelled.splice(cancelled.end(), wheels_[it->level][it->index], it);
+  }
+  return true;
+}
+
+size_t TimerWheel::size() const {
+  std::lock_guard<std::mutex> g(lock_);
+  return timers_.size();
+}
+
+void TimerWheel::advance(uint64_t ticks) {
+  for (uint64_t i = 0; i < ticks; ++i) {
+    Slot due;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      due = tickLocked();
+    }
+    run(due);
+  }
+}
+
+void TimerWheel::addLocked(Slot& from, Slot::iterator it) {
+  // The timers already due fire in the next tick
+  auto expire = std::max(it->expire, now_ + 1);
+  auto delta = std::min(expire - now_, kMaxTicks - 1);
+  expire = now_ + delta;
+  it->expire = expire;
+  uint32_t level = 0;
+  while (level + 1 < kLevels && delta >= (1UL << shift(level + 1))) {
+    ++level;
+  }
+  auto mask = level == 0 ? kInnerSlots - 1 : kOuterSlots - 1;
+  it->level = level;
+  it->index = (expire >> shift(level)) & mask;
+  auto& slot = wheels_[level][it->index];
+  slot.splice(slot.end(), from, it);
+}
+
+void TimerWheel::cascadeLocked(uint32_t level, uint64_t index) {
+  Slot cascading;
+  cascading.splice(cascading.end(), wheels_[level][index]);
+  while (!cascading.empty()) {
+    addLocked(cascading, cascading.begin());
+  }
+}
+
+TimerWheel::Slot TimerWheel::tickLocked() {
+  ++now_;
+  // The outer wheels turn a slot when the inner one completes a round
+  if ((now_ & (kInnerSlots - 1)) == 0) {
+    for (uint32_t level = 1; level < kLevels; ++level) {
+      auto index = (now_ >> shift(level)) & (kOuterSlots - 1);
+      cascadeLocked(level, index);
+      if (index != 0) {
+        break;
+      }
+    }
+  }
+  Slot due;
+  due.splice(due.end(), wheels_[0][now_ & (kInnerSlots - 1)]);
+  for (const auto& timer : due) {
+    timers_.erase(timer.id);
+  }
+  return due;
+}
+
+// static
+void TimerWheel::run(Slot& due) {
+  for (auto& timer : due) {
+    try {
+      timer.task();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Timer " << timer.id << " failed: " << e.what();
+    }
+  }
+}
+
+void TimerWheel::loop() {
+  auto tick = std::chrono::milliseconds(tickMs_);
+  auto next = std::chrono::steady_clock::now() + tick;
+  std::unique_lock<std::mutex> guard(lock_);
+  while (!stopped_) {
+    if (cond_.wait_until(guard, next, [this] { return stopped_; })) {
+      break;
+    }
+    // The ticks missed by a slow task are caught up at once
+    auto now = std::chrono::steady_clock::now();
+    while (next <= now && !stopped_) {
+      next += tick;
+      auto due = tickLocked();
+      if (due.empty()) {
+        continue;
+      }
+      guard.unlock();
+      run(due);
+      guard.lock();
+    }
+  }
+}
+
+}  // namespace thread
+}  // namespace nebula
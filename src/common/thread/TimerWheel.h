@@ -0,0 +1,118 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#ifndef COMMON_THREAD_TIMERWHEEL_H_
+#define COMMON_THREAD_TIMERWHEEL_H_
+
+#include <gflags/gflags_declare.h>
+
+#include <condition_variable>
+#include <list>
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+#include "common/thread/NamedThread.h"
+
+DECLARE_uint32(timer_wheel_tick_ms);
+
+namespace nebula {
+namespace thread {
+
+/**
+ * A hierarchical timer wheel, which keeps the oneshot timers of the whole process in the slots of
+ * four wheels of 256, 64, 64 and 64 ticks, so a timer is added or cancelled in O(1), and only the
+ * timers of the current slot are touched in each tick. A timer in an outer wheel is cascaded into
+ * the inner ones as its time comes near, the same as the timers of the Linux kernel.
+ *
+ * The timers of the subsystems with many of them, e.g. the status polling of each raft part and
+ * the expiry of each session, are added to the shared wheel rather than to the event loops of the
+ * GenericWorkers, which keep a heap of them and allocate an event for each one.
+ *
+ * The timers fire in the thread of the wheel one after one, so a task should be short, and hand
+ * the heavy work to its own workers. The precision is one tick of FLAGS_timer_wheel_tick_ms.
+ */
+class TimerWheel final : public cpp::NonCopyable, public cpp::NonMovable {
+ public:
+  // The wheel shared by the process, started on the first use
+  static TimerWheel& instance();
+
+  /**
+   * @param tickMs  milliseconds of a tick
+   * @param manual  the ticks are only advanced by `advance', without the thread, for the tests
+   */
+  explicit TimerWheel(uint32_t tickMs, bool manual = false);
+  ~TimerWheel();
+
+  /**
+   * To add a oneshot timer.
+   * @ms      milliseconds from now when the task is executed, rounded up to the ticks
+   * @task    a callable object
+   * @return  ID of the timer, which is never 0
+   */
+  uint64_t schedule(uint64_t ms, std::function<void()> task);
+
+  /**
+   * To cancel a timer, return false if it has fired or been cancelled
+   * @id      ID returned by `schedule'
+   */
+  bool cancel(uint64_t id);
+
+  // The number of the timers not fired yet
+  size_t size() const;
+
+  // Advance the wheel by the ticks, and execute the timers due in them
+  void advance(uint64_t ticks);
+
+ private:
+  static constexpr uint32_t kLevels = 4;
+  static constexpr uint32_t kInnerBits = 8;
+  static constexpr uint32_t kOuterBits = 6;
+  static constexpr uint64_t kInnerSlots = 1UL << kInnerBits;
+  static constexpr uint64_t kOuterSlots = 1UL << kOuterBits;
+  // The max ticks from now of a timer, the later ones are kept in the last slots of the wheels
+  static constexpr uint64_t kMaxTicks = 1UL << (kInnerBits + (kLevels - 1) * kOuterBits);
+
+  struct Timer {
+    uint64_t id;
+    uint64_t expire;
+    // The slot holding the timer, so it's cancelled without a search
+    uint32_t level;
+    uint64_t index;
+    std::function<void()> task;
+  };
+  using Slot = std::list<Timer>;
+
+  // The bits of the ticks below the slots of the wheel
+  static uint32_t shift(uint32_t level) {
+    return level == 0 ? 0 : kInnerBits + (level - 1) * kOuterBits;
+  }
+
+  // Put the timer at it of from into the slot of its expiry, lock_ must be held
+  void addLocked(Slot& from, Slot::iterator it);
+
+  // Move the timers of the slot of an outer wheel into the inner ones, lock_ must be held
+  void cascadeLocked(uint32_t level, uint64_t index);
+
+  // Advance a tick and take the timers due, lock_ must be held
+  Slot tickLocked();
+
+  static void run(Slot& due);
+
+  void loop();
+
+  const uint32_t tickMs_;
+  mutable std::mutex lock_;
+  std::condition_variable cond_;
+  bool stopped_{false};
+  uint64_t now_{0};
+  uint64_t nextId_{1};
+  std::vector<std::vector<Slot>> wheels_;
+  std::unordered_map<uint64_t, Slot::iterator> timers_;
+  std::unique_ptr<NamedThread> thread_;
+};
+
+}  // namespace thread
+}  // namespace nebula
+
+#endif  // COMMON_THREAD_TIMERWHEEL_H_
@@ -86,6 +86,40 @@ TEST(GenericWorker, addTask) {
   }
 }
 
+TEST(GenericWorker, TaskObserver) {
+  struct CountingObserver : public TaskObserver {
+    void onQueued() override {
+      ++queued;
+    }
+    void onRun(std::chrono::microseconds wait, std::chrono::microseconds run) override {
+      ++ran;
+      maxWait = std::max(maxWait.load(), wait.count());
+      maxRun = std::max(maxRun.load(), run.count());
+    }
+    std::atomic<int> queued{0};
+    std::atomic<int> ran{0};
+    std::atomic<int64_t> maxWait{0};
+    std::atomic<int64_t> maxRun{0};
+  };
+  auto observer = std::make_shared<CountingObserver>();
+  GenericWorker worker;
+  worker.setTaskObserver(observer);
+  ASSERT_TRUE(worker.start());
+  // The second task waits for the first one
+  auto first = worker.addTask([] { ::usleep(20000); });
+  auto second = worker.addTask([] { return 1; });
+  ASSERT_EQ(1, std::move(second).get());
+  std::move(first).get();
+  // The timers are not observed
+  worker.addDelayTask(1, [] {}).get();
+  ASSERT_TRUE(worker.stop());
+  ASSERT_TRUE(worker.wait());
+  ASSERT_EQ(2, observer->queued);
+  ASSERT_EQ(2, observer->ran);
+  ASSERT_GE(observer->maxWait, 20000);
+  ASSERT_GE(observer->maxRun, 20000);
+}
+
 static testing::AssertionResult msAboutEqual(size_t expected, size_t actual) {
   if (std::max(expected, actual) - std::min(expected, actual) <= 10) {
     return testing::AssertionSuccess();
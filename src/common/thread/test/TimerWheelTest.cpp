@@ -0,0 +1,93 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/thread/TimerWheel.h"
+
+namespace nebula {
+namespace thread {
+
+TEST(TimerWheel, FireInTicks) {
+  TimerWheel wheel(10, true);
+  // The timers in all the wheels, and on the bounds of them
+  std::vector<uint64_t> ticks = {1, 2, 255, 256, 257, 300, 16383, 16384, 20000, 1048577, 3000000};
+  std::vector<uint64_t> fired(ticks.size(), 0);
+  uint64_t now = 0;
+  for (size_t i = 0; i < ticks.size(); ++i) {
+    wheel.schedule(ticks[i] * 10, [&, i] { fired[i] = now; });
+  }
+  // Rounded up to the ticks
+  uint64_t rounded = 0;
+  wheel.schedule(15, [&] { rounded = now; });
+  EXPECT_EQ(ticks.size() + 1, wheel.size());
+  for (now = 1; now <= 3000000; ++now) {
+    wheel.advance(1);
+  }
+  for (size_t i = 0; i < ticks.size(); ++i) {
+    EXPECT_EQ(ticks[i], fired[i]) << i;
+  }
+  EXPECT_EQ(2, rounded);
+  EXPECT_EQ(0, wheel.size());
+}
+
+TEST(TimerWheel, ScheduleLater) {
+  TimerWheel wheel(1, true);
+  wheel.advance(1000);
+  uint64_t now = 1000;
+  std::vector<uint64_t> fired;
+  for (uint64_t ms : {1, 100, 5000, 70000}) {
+    wheel.schedule(ms, [&, ms] { fired.emplace_back(now - 1000 == ms ? ms : 0); });
+  }
+  while (now < 80000) {
+    ++now;
+    wheel.advance(1);
+  }
+  std::vector<uint64_t> expected = {1, 100, 5000, 70000};
+  EXPECT_EQ(expected, fired);
+}
+
+TEST(TimerWheel, Cancel) {
+  TimerWheel wheel(1, true);
+  int fired = 0;
+  auto id1 = wheel.schedule(10, [&] { ++fired; });
+  auto id2 = wheel.schedule(1000, [&] { ++fired; });
+  auto id3 = wheel.schedule(100000, [&] { ++fired; });
+  EXPECT_TRUE(wheel.cancel(id2));
+  EXPECT_FALSE(wheel.cancel(id2));
+  // Cancelled after cascaded into the inner wheel
+  wheel.advance(99990);
+  EXPECT_EQ(1, fired);
+  EXPECT_FALSE(wheel.cancel(id1));
+  EXPECT_TRUE(wheel.cancel(id3));
+  wheel.advance(100);
+  EXPECT_EQ(1, fired);
+  EXPECT_EQ(0, wheel.size());
+}
+
+TEST(TimerWheel, RescheduleInTask) {
+  TimerWheel wheel(1, true);
+  int fired = 0;
+  std::function<void()> task = [&] {
+    if (++fired < 3) {
+      wheel.schedule(10, task);
+    }
+  };
+  wheel.schedule(10, task);
+  wheel.advance(100);
+  EXPECT_EQ(3, fired);
+}
+
+TEST(TimerWheel, Thread) {
+  TimerWheel wheel(1);
+  folly::Baton<> baton;
+  wheel.schedule(20, [&] { baton.post(); });
+  EXPECT_TRUE(baton.try_wait_for(std::chrono::seconds(5)));
+}
+
+}  // namespace thread
+}  // namespace nebula
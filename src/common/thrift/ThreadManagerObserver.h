@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_THRIFT_THREADMANAGEROBSERVER_H_
+#define COMMON_THRIFT_THREADMANAGEROBSERVER_H_
+
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+
+#include "common/base/Base.h"
+#include "common/stats/ContentionStats.h"
+#include "common/stats/StatsManager.h"
+
+namespace nebula {
+
+/**
+ * @brief Add the tasks run by the thrift thread managers to the executor stats of their pools,
+ * e.g. executor-pri3 of the priority thread manager named executor.
+ */
+class ThreadManagerObserver final : public apache::thrift::concurrency::ThreadManager::Observer {
+ public:
+  void preRun(folly::RequestContext*) override {}
+
+  void postRun(folly::RequestContext*,
+               const apache::thrift::concurrency::ThreadManager::RunStats& runStats) override {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    // A thread runs the tasks of one pool only, whose stats is looked up once
+    thread_local std::string pool;
+    thread_local std::shared_ptr<stats::ExecutorStats> executorStats;
+    if (executorStats == nullptr || pool != runStats.threadPoolName) {
+      pool = runStats.threadPoolName;
+      executorStats = stats::ExecutorStats::of(pool);
+    }
+    executorStats->onRun(duration_cast<microseconds>(runStats.workBegin - runStats.queueBegin),
+                         duration_cast<microseconds>(runStats.workEnd - runStats.workBegin));
+  }
+};
+
+/**
+ * @brief Observe the tasks of all thrift thread managers of the process, and export the pending
+ * tasks of the manager as executor_pending_tasks{pool=name}.
+ */
+inline void watchThreadManager(
+    const std::string& name,
+    const std::shared_ptr<apache::thrift::concurrency::ThreadManager>& manager) {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    apache::thrift::concurrency::ThreadManager::setObserver(
+        std::make_shared<ThreadManagerObserver>());
+  });
+  std::weak_ptr<apache::thrift::concurrency::ThreadManager> weak = manager;
+  stats::StatsManager::registerGauge(
+      "executor_pending_tasks", {{"pool", name}}, [weak]() -> int64_t {
+        auto locked = weak.lock();
+        return locked == nullptr ? 0 : static_cast<int64_t>(locked->pendingTaskCount());
+      });
+}
+
+}  // namespace nebula
+
+#endif  // COMMON_THRIFT_THREADMANAGEROBSERVER_H_
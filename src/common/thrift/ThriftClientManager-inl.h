@@ -14,11 +14,89 @@
 #include "common/base/Base.h"
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
+#include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
 
 DECLARE_int32(conn_timeout_ms);
 
 namespace nebula {
 namespace thrift {
+
+namespace detail {
+
+struct SSLSessions {
+  std::mutex lock;
+  std::unordered_map<HostAddr, std::shared_ptr<SSL_SESSION>> sessions;
+
+  std::shared_ptr<SSL_SESSION> get(const HostAddr& host) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto iter = sessions.find(host);
+    return iter == sessions.end() ? nullptr : iter->second;
+  }
+};
+
+// Keep the session of a new TLS connection once it's established, and record the latency of the
+// connections by whether their sessions are resumed, in ssl_connect_latency_us{resumed}
+class SSLSessionCallback final : public folly::AsyncSocket::ConnectCallback {
+ public:
+  SSLSessionCallback(folly::AsyncSSLSocket* sock,
+                     const HostAddr& host,
+                     std::shared_ptr<SSLSessions> sessions)
+      : sock_(sock),
+        host_(host),
+        sessions_(std::move(sessions)),
+        start_(time::WallClock::fastNowInMicroSec()) {}
+
+  void connectSuccess() noexcept override {
+    bool resumed = sock_->getSSLSessionReused();
+    stats::StatsManager::latencyHisto("ssl_connect_latency_us",
+                                      {{"resumed", resumed ? "true" : "false"}})
+        ->add(time::WallClock::fastNowInMicroSec() - start_);
+    if (!resumed) {
+      // The reference is taken
+      auto* session = sock_->getSSLSession();
+      if (session != nullptr) {
+        std::lock_guard<std::mutex> guard(sessions_->lock);
+        sessions_->sessions[host_] = std::shared_ptr<SSL_SESSION>(session, SSL_SESSION_free);
+      }
+    }
+    delete this;
+  }
+
+  void connectErr(const folly::AsyncSocketException& ex) noexcept override {
+    VLOG(2) << "TLS connection to " << host_ << " failed: " << ex.what();
+    {
+      // Start over by a full handshake
+      std::lock_guard<std::mutex> guard(sessions_->lock);
+      sessions_->sessions.erase(host_);
+    }
+    delete this;
+  }
+
+ private:
+  folly::AsyncSSLSocket* sock_;
+  HostAddr host_;
+  std::shared_ptr<SSLSessions> sessions_;
+  int64_t start_;
+};
+
+}  // namespace detail
+
+template <class ClientType>
+bool ThriftClientManager<ClientType>::usable(const HostAddr& host, ClientType* client) {
+  auto channel = dynamic_cast<apache::thrift::RocketClientChannel*>(client->getChannel());
+  if (channel == nullptr || !channel->good()) {
+    VLOG(2) << "Invalid Channel: " << channel << " for host: " << host;
+    return false;
+  }
+  auto transport = dynamic_cast<folly::AsyncSocket*>(channel->getTransport());
+  if (transport == nullptr || transport->hangup()) {
+    VLOG(2) << "Transport is closed by peers " << transport << " for host: " << host;
+    return false;
+  }
+  return true;
+}
+
 template <class ClientType>
 std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAddr& host,
                                                                     folly::EventBase* evb,
@@ -28,25 +106,18 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
     evb = folly::EventBaseManager::get()->getEventBase();
   }
   // Get client from client manager if it is ok.
-  auto it = clientMap_->find(std::make_pair(host, evb));
-  if (it != clientMap_->end()) {
-    do {
-      auto channel = dynamic_cast<apache::thrift::RocketClientChannel*>(it->second->getChannel());
-      if (channel == nullptr || !channel->good()) {
-        // Remove bad connection to create a new one.
-        clientMap_->erase(it);
-        VLOG(2) << "Invalid Channel: " << channel << " for host: " << host;
-        break;
-      }
-      auto transport = dynamic_cast<folly::AsyncSocket*>(channel->getTransport());
-      if (transport == nullptr || transport->hangup()) {
-        clientMap_->erase(it);
-        VLOG(2) << "Transport is closed by peers " << transport << " for host: " << host;
-        break;
-      }
+  auto& clients = (*clientMap_)[std::make_pair(host, evb)];
+  if (clients.clients.size() != connsPerHost_) {
+    clients.clients.resize(connsPerHost_);
+  }
+  auto& slot = clients.clients[clients.next++ % connsPerHost_];
+  if (slot != nullptr) {
+    if (usable(host, slot.get())) {
       VLOG(2) << "Getting a client to " << host;
-      return it->second;
-    } while (false);
+      return slot;
+    }
+    // Remove bad connection to create a new one.
+    slot.reset();
   }
 
   // Need to create a new client and insert it to client map.
@@ -73,10 +144,16 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
 
   VLOG(2) << "Connecting to " << host << " for " << ++connectionCount << " times";
   folly::AsyncTransport::UniquePtr socket;
-  evb->runImmediatelyOrRunInEventBaseThreadAndWait([this, &socket, evb, resolved]() {
+  evb->runImmediatelyOrRunInEventBaseThreadAndWait([this, &socket, evb, host, resolved]() {
     if (enableSSL_) {
-      auto sock = folly::AsyncSSLSocket::newSocket(nebula::createSSLContext(), evb);
-      sock->connect(nullptr, resolved.host, resolved.port, FLAGS_conn_timeout_ms);
+      auto sock = folly::AsyncSSLSocket::newSocket(nebula::clientSSLContext(), evb);
+      // Resume the session of the last connection to the host, to skip the full handshake
+      auto session = sslSessions_->get(host);
+      if (session != nullptr) {
+        sock->setSSLSession(session.get(), false);
+      }
+      auto* callback = new detail::SSLSessionCallback(sock.get(), host, sslSessions_);
+      sock->connect(callback, resolved.host, resolved.port, FLAGS_conn_timeout_ms);
       socket = folly::AsyncTransport::UniquePtr(sock.release());
     } else {
       socket = folly::AsyncTransport::UniquePtr(
@@ -92,7 +169,7 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
   std::shared_ptr<ClientType> client(new ClientType(std::move(clientChannel)), [evb](auto* p) {
     evb->runImmediatelyOrRunInEventBaseThreadAndWait([p] { delete p; });
   });
-  clientMap_->emplace(std::make_pair(host, evb), client);
+  slot = client;
   return client;
 }
 
@@ -15,6 +15,10 @@
 namespace nebula {
 namespace thrift {
 
+namespace detail {
+struct SSLSessions;
+}  // namespace detail
+
 template <class ClientType>
 class ThriftClientManager final {
  public:
@@ -27,17 +31,31 @@ class ThriftClientManager final {
     VLOG(3) << "~ThriftClientManager";
   }
 
-  explicit ThriftClientManager(bool enableSSL = false) : enableSSL_(enableSSL) {
+  // Each thread keeps connsPerHost connections to a host by an event base, and takes them in turn
+  explicit ThriftClientManager(bool enableSSL = false, size_t connsPerHost = 1)
+      : enableSSL_(enableSSL),
+        connsPerHost_(std::max<size_t>(connsPerHost, 1)),
+        sslSessions_(std::make_shared<detail::SSLSessions>()) {
     VLOG(3) << "ThriftClientManager";
   }
 
  private:
-  using ClientMap =
-      std::unordered_map<std::pair<HostAddr, folly::EventBase*>, std::shared_ptr<ClientType>>;
+  struct Clients {
+    std::vector<std::shared_ptr<ClientType>> clients;
+    size_t next{0};
+  };
+
+  using ClientMap = std::unordered_map<std::pair<HostAddr, folly::EventBase*>, Clients>;
+
+  // Whether the connection of client is still usable
+  static bool usable(const HostAddr& host, ClientType* client);
 
   folly::ThreadLocal<ClientMap> clientMap_;
   // whether enable ssl
   bool enableSSL_{false};
+  size_t connsPerHost_{1};
+  // The TLS sessions of the hosts, shared by the threads, which the next connections resume
+  std::shared_ptr<detail::SSLSessions> sslSessions_;
 };
 
 }  // namespace thrift
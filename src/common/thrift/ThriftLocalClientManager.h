@@ -31,8 +31,9 @@ class LocalClientManager final {
     VLOG(3) << "~LocalClientManager";
   }
 
-  explicit LocalClientManager(bool enableSSL = false) {
+  explicit LocalClientManager(bool enableSSL = false, size_t connsPerHost = 1) {
     UNUSED(enableSSL);
+    UNUSED(connsPerHost);
     VLOG(3) << "LocalClientManager";
   }
 };
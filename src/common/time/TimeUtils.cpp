@@ -17,6 +17,141 @@ namespace time {
 // The mainstream Linux kernel's implementation constrains this
 constexpr int64_t kMaxTimestamp = std::numeric_limits<int64_t>::max() / 1000000000;
 
+namespace {
+
+// Read the n digits of str from pos
+bool readDigits(const std::string &str, size_t &pos, size_t n, int32_t &value) {
+  if (pos + n > str.size()) {
+    return false;
+  }
+  value = 0;
+  for (size_t i = 0; i < n; ++i) {
+    auto c = str[pos + i];
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + (c - '0');
+  }
+  pos += n;
+  return true;
+}
+
+bool readChar(const std::string &str, size_t &pos, char c) {
+  if (pos < str.size() && str[pos] == c) {
+    ++pos;
+    return true;
+  }
+  return false;
+}
+
+// YYYY-MM-DD
+bool fastReadDate(const std::string &str, size_t &pos, Date &date) {
+  int32_t year = 0, month = 0, day = 0;
+  if (!readDigits(str, pos, 4, year) || !readChar(str, pos, '-') ||
+      !readDigits(str, pos, 2, month) || !readChar(str, pos, '-') ||
+      !readDigits(str, pos, 2, day)) {
+    return false;
+  }
+  date = Date(year, month, day);
+  return TimeUtils::validateDate(date).ok();
+}
+
+// hh:mm:ss[.f], where the fraction is of 6 digits at most
+bool fastReadTime(const std::string &str, size_t &pos, Time &time) {
+  int32_t hour = 0, minute = 0, sec = 0, microsec = 0;
+  if (!readDigits(str, pos, 2, hour) || !readChar(str, pos, ':') ||
+      !readDigits(str, pos, 2, minute) || !readChar(str, pos, ':') ||
+      !readDigits(str, pos, 2, sec)) {
+    return false;
+  }
+  if (readChar(str, pos, '.')) {
+    size_t digits = 0;
+    for (int32_t digit = 0; digits < 6 && readDigits(str, pos, 1, digit); ++digits) {
+      microsec = microsec * 10 + digit;
+    }
+    if (digits == 0 || (pos < str.size() && str[pos] >= '0' && str[pos] <= '9')) {
+      return false;
+    }
+    for (; digits < 6; ++digits) {
+      microsec *= 10;
+    }
+  }
+  time = Time(hour, minute, sec, microsec);
+  return TimeUtils::validateTime(time).ok();
+}
+
+// [(+|-)hh:mm], the offset in seconds of the timezone
+bool fastReadTimezone(const std::string &str, size_t &pos, bool &withTimeZone, int64_t &offset) {
+  withTimeZone = false;
+  offset = 0;
+  if (pos == str.size()) {
+    return true;
+  }
+  int64_t sign = 1;
+  if (!readChar(str, pos, '+')) {
+    if (!readChar(str, pos, '-')) {
+      return false;
+    }
+    sign = -1;
+  }
+  int32_t hour = 0, minute = 0;
+  if (!readDigits(str, pos, 2, hour) || !readChar(str, pos, ':') ||
+      !readDigits(str, pos, 2, minute) || pos != str.size()) {
+    return false;
+  }
+  Time time(hour, minute, 0, 0);
+  if (!TimeUtils::validateTime(time).ok()) {
+    return false;
+  }
+  withTimeZone = true;
+  offset = sign * TimeConversion::timeToSeconds(time);
+  return true;
+}
+
+// The ISO 8601 forms most used, i.e. YYYY-MM-DD[(T| )hh:mm:ss[.f][(+|-)hh:mm]], are parsed here
+// rather than by DatetimeReader. The others, and the invalid ones for the errors, are left to it.
+bool fastParseDateTime(const std::string &str, Result &result) {
+  size_t pos = 0;
+  Date date;
+  if (!fastReadDate(str, pos, date)) {
+    return false;
+  }
+  if (pos == str.size()) {
+    result = Result{DateTime(date), false};
+    return true;
+  }
+  Time time;
+  bool withTimeZone = false;
+  int64_t offset = 0;
+  if ((!readChar(str, pos, 'T') && !readChar(str, pos, ' ')) || !fastReadTime(str, pos, time) ||
+      !fastReadTimezone(str, pos, withTimeZone, offset)) {
+    return false;
+  }
+  result = Result{TimeConversion::dateTimeShift(DateTime(date, time), -offset), withTimeZone};
+  return true;
+}
+
+bool fastParseTime(const std::string &str, TimeResult &result) {
+  size_t pos = 0;
+  Time time;
+  bool withTimeZone = false;
+  int64_t offset = 0;
+  if (!fastReadTime(str, pos, time) || !fastReadTimezone(str, pos, withTimeZone, offset)) {
+    return false;
+  }
+  DateTime dt(1970, 1, 1, time.hour, time.minute, time.sec, time.microsec);
+  result = TimeResult{TimeConversion::dateTimeShift(dt, -offset).time(), withTimeZone};
+  return true;
+}
+
+// The reader is reused in the thread, rather than built with its scanner and parser per parse
+DatetimeReader &reader() {
+  static thread_local DatetimeReader reader;
+  return reader;
+}
+
+}  // namespace
+
 /*static*/ StatusOr<DateTime> TimeUtils::dateTimeFromMap(const Map &m) {
   // TODO(shylock) support timezone parameter
   DateTime dt;
@@ -209,22 +344,32 @@ StatusOr<Value> TimeUtils::toTimestamp(const Value &val) {
 }
 
 /*static*/ StatusOr<Result> TimeUtils::parseDateTime(const std::string &str) {
-  auto p = DatetimeReader();
-  auto result = p.readDatetime(str);
+  Result fast;
+  if (fastParseDateTime(str, fast)) {
+    return fast;
+  }
+  auto result = reader().readDatetime(str);
   NG_RETURN_IF_ERROR(result);
   return result.value();
 }
 
 /*static*/ StatusOr<Date> TimeUtils::parseDate(const std::string &str) {
-  auto p = DatetimeReader();
-  auto result = p.readDate(str);
+  size_t pos = 0;
+  Date fast;
+  if (fastReadDate(str, pos, fast) && pos == str.size()) {
+    return fast;
+  }
+  auto result = reader().readDate(str);
   NG_RETURN_IF_ERROR(result);
   return result.value();
 }
 
 /*static*/ StatusOr<TimeResult> TimeUtils::parseTime(const std::string &str) {
-  auto p = DatetimeReader();
-  return p.readTime(str);
+  TimeResult fast;
+  if (fastParseTime(str, fast)) {
+    return fast;
+  }
+  return reader().readTime(str);
 }
 
 }  // namespace time
@@ -26,6 +26,18 @@ namespace time {
 
 /*static*/ Timezone Timezone::globalTimezone;
 
+/*static*/ StatusOr<int32_t> Timezone::regionUtcOffsetSecs(const std::string &region) {
+  static thread_local std::unordered_map<std::string, int32_t> offsets;
+  auto found = offsets.find(region);
+  if (found != offsets.end()) {
+    return found->second;
+  }
+  Timezone zone;
+  NG_RETURN_IF_ERROR(zone.loadFromDb(region));
+  offsets.emplace(region, zone.utcOffsetSecs());
+  return zone.utcOffsetSecs();
+}
+
 /*static*/ Status Timezone::initializeGlobalTimezone() {
   // use system timezone configuration if not set.
   if (FLAGS_timezone_name.empty()) {
@@ -13,6 +13,7 @@
 
 #include "common/base/Base.h"
 #include "common/base/Status.h"
+#include "common/base/StatusOr.h"
 
 DECLARE_string(timezone_file);
 
@@ -39,6 +40,7 @@ class Timezone {
       return Status::Error("Not supported timezone `%s'.", region.c_str());
     }
     zoneInfo_ = zoneInfo;
+    utcOffsetSecs_ = zoneInfo_->base_utc_offset().total_seconds();
     return Status::OK();
   }
 
@@ -47,6 +49,7 @@ class Timezone {
   NG_MUST_USE_RESULT Status parsePosixTimezone(const std::string &posixTimezone) {
     try {
       zoneInfo_.reset(new ::boost::local_time::posix_time_zone(posixTimezone));
+      utcOffsetSecs_ = zoneInfo_->base_utc_offset().total_seconds();
     } catch (const std::exception &e) {
       return Status::Error(
           "Malformed timezone format: `%s', exception: `%s'.", posixTimezone.c_str(), e.what());
@@ -58,11 +61,16 @@ class Timezone {
     return DCHECK_NOTNULL(zoneInfo_)->std_zone_name();
   }
 
-  // offset in seconds
+  // offset in seconds, which is kept when the zone is loaded, as it's read for each datetime
   int32_t utcOffsetSecs() const {
-    return DCHECK_NOTNULL(zoneInfo_)->base_utc_offset().total_seconds();
+    DCHECK(zoneInfo_ != nullptr);
+    return utcOffsetSecs_;
   }
 
+  // The offset in seconds of the region in the tz database, which is cached in the thread since
+  // the database is loaded once
+  static StatusOr<int32_t> regionUtcOffsetSecs(const std::string &region);
+
   // TODO(shylock) Get Timzone info(I.E. GMT offset) directly from IANA tzdb
   // to support non-global timezone configuration
   // See the timezone format from
@@ -80,6 +88,7 @@ class Timezone {
 
   ::boost::shared_ptr<::boost::date_time::time_zone_base<::boost::posix_time::ptime, char>>
       zoneInfo_{nullptr};
+  int32_t utcOffsetSecs_{0};
 };
 
 }  // namespace time
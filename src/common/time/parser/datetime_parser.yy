@@ -261,12 +261,11 @@ unsigned_time_zone_offset
 
 time_zone_name
   : TIME_ZONE_NAME {
-    auto zone = nebula::time::Timezone();
-    auto result = zone.loadFromDb(*$1);
+    auto result = nebula::time::Timezone::regionUtcOffsetSecs(*$1);
     if (!result.ok()) {
-      throw DatetimeParser::syntax_error(@1, result.toString());
+      throw DatetimeParser::syntax_error(@1, result.status().toString());
     }
-    $$ = zone.utcOffsetSecs();
+    $$ = result.value();
     delete $1;
   }
   ;
@@ -8,6 +8,7 @@
 #include "common/base/Base.h"
 #include "common/time/TimeUtils.h"
 #include "common/time/TimezoneInfo.h"
+#include "common/time/parser/DatetimeReader.h"
 
 namespace nebula {
 
@@ -169,6 +170,52 @@ TEST(Time, Parse) {
   }
 }
 
+TEST(Time, FastParse) {
+  // The ones parsed by the fast path get the same results as DatetimeReader
+  std::vector<std::string> datetimes = {"2019-03-04",
+                                        "2019-03-04T22:00:30",
+                                        "2019-03-04 22:00:30.5",
+                                        "2019-03-04T22:00:30.000123",
+                                        "2019-03-04T22:00:30.1234567",
+                                        "2019-03-04T22:00:30+08:00",
+                                        "2019-03-04T02:00:30-10:30",
+                                        "2019-03-04T22:00:30.12+00:00",
+                                        "2019-02-29",
+                                        "2019-03-04T24:00:00",
+                                        "2019-03-04T22:00:30.",
+                                        "2019-03-04T22:00:30+24:00",
+                                        "2019-3-4T22:00:30",
+                                        "2019-03-04T22:00",
+                                        "-2019-03-04"};
+  for (const auto &str : datetimes) {
+    auto result = time::TimeUtils::parseDateTime(str);
+    auto expected = time::DatetimeReader().readDatetime(str);
+    ASSERT_EQ(expected.ok(), result.ok()) << str;
+    if (expected.ok()) {
+      EXPECT_EQ(expected.value(), result.value()) << str;
+    }
+  }
+  std::vector<std::string> dates = {"2019-03-04", "2019-02-30", "2019-03-04T22:00:30", "2019-3"};
+  for (const auto &str : dates) {
+    auto result = time::TimeUtils::parseDate(str);
+    auto expected = time::DatetimeReader().readDate(str);
+    ASSERT_EQ(expected.ok(), result.ok()) << str;
+    if (expected.ok()) {
+      EXPECT_EQ(expected.value(), result.value()) << str;
+    }
+  }
+  std::vector<std::string> times = {
+      "22:00:30", "22:00:30.25", "02:00:30+08:00", "22:60:00", "22:00", "22:00:30Z"};
+  for (const auto &str : times) {
+    auto result = time::TimeUtils::parseTime(str);
+    auto expected = time::DatetimeReader().readTime(str);
+    ASSERT_EQ(expected.ok(), result.ok()) << str;
+    if (expected.ok()) {
+      EXPECT_EQ(expected.value(), result.value()) << str;
+    }
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
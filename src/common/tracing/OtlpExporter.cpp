@@ -0,0 +1,130 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/tracing/OtlpExporter.h"
+
+#include <folly/json.h>
+
+#include "common/http/HttpClient.h"
+
+DEFINE_double(trace_sample_ratio,
+              0,
+              "The ratio of the queries traced, in [0, 1], 0 to disable tracing. The requests to "
+              "storaged follow the sampling of the query they belong to");
+DEFINE_string(trace_collector_url,
+              "",
+              "The url to post the spans to by OTLP/HTTP in JSON, e.g. "
+              "http://127.0.0.1:4318/v1/traces");
+DEFINE_int32(trace_export_interval_ms, 1000, "The interval to post the finished spans");
+DEFINE_int32(trace_export_batch_size, 512, "The max number of spans posted in a request");
+DEFINE_int32(trace_export_queue_size,
+             8192,
+             "The max number of spans waiting to be posted, the spans beyond are dropped");
+
+namespace nebula {
+namespace tracing {
+
+Status OtlpExporter::init(const std::string& serviceName) {
+  if (FLAGS_trace_sample_ratio <= 0 || FLAGS_trace_collector_url.empty()) {
+    return Status::OK();
+  }
+  if (FLAGS_trace_sample_ratio > 1) {
+    return Status::Error("Invalid trace_sample_ratio %f", FLAGS_trace_sample_ratio);
+  }
+  LOG(INFO) << "Trace " << FLAGS_trace_sample_ratio << " of the queries to "
+            << FLAGS_trace_collector_url;
+  Tracer::instance().init(FLAGS_trace_sample_ratio, std::make_unique<OtlpExporter>(serviceName));
+  return Status::OK();
+}
+
+OtlpExporter::OtlpExporter(std::string serviceName) : serviceName_(std::move(serviceName)) {
+  worker_ = std::make_unique<thread::GenericWorker>();
+  CHECK(worker_->start("trace-exporter"));
+  worker_->addRepeatTask(FLAGS_trace_export_interval_ms, &OtlpExporter::flush, this);
+}
+
+OtlpExporter::~OtlpExporter() {
+  worker_->stop();
+  worker_->wait();
+}
+
+void OtlpExporter::exportSpan(std::unique_ptr<SpanData> span) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (queue_.size() >= static_cast<size_t>(FLAGS_trace_export_queue_size)) {
+    dropped_++;
+    return;
+  }
+  queue_.emplace_back(std::move(span));
+}
+
+void OtlpExporter::flush() {
+  std::vector<std::unique_ptr<SpanData>> spans;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    spans.swap(queue_);
+  }
+  auto dropped = dropped_.exchange(0);
+  if (dropped > 0) {
+    LOG(WARNING) << dropped << " spans dropped as the export queue is full";
+  }
+
+  auto batchSize = static_cast<size_t>(std::max(1, FLAGS_trace_export_batch_size));
+  std::vector<std::string> headers = {"Content-Type: application/json"};
+  for (size_t begin = 0; begin < spans.size(); begin += batchSize) {
+    std::vector<std::unique_ptr<SpanData>> batch(
+        std::make_move_iterator(spans.begin() + begin),
+        std::make_move_iterator(spans.begin() + std::min(begin + batchSize, spans.size())));
+    auto resp = HttpClient::instance().post(FLAGS_trace_collector_url, headers, toJson(batch));
+    if (resp.curlCode != CURLE_OK) {
+      LOG_EVERY_N(WARNING, 100) << "Failed to export " << batch.size()
+                                << " spans: " << resp.curlMessage;
+    }
+  }
+}
+
+std::string OtlpExporter::toJson(const std::vector<std::unique_ptr<SpanData>>& spans) const {
+  folly::dynamic array = folly::dynamic::array;
+  for (const auto& span : spans) {
+    array.push_back(toJson(*span));
+  }
+  folly::dynamic serviceName = folly::dynamic::object("key", "service.name")(
+      "value", folly::dynamic::object("stringValue", serviceName_));
+  folly::dynamic resource =
+      folly::dynamic::object("attributes", folly::dynamic::array(std::move(serviceName)));
+  folly::dynamic scopeSpans = folly::dynamic::object(
+      "scope", folly::dynamic::object("name", "nebula"))("spans", std::move(array));
+  folly::dynamic resourceSpans = folly::dynamic::object("resource", std::move(resource))(
+      "scopeSpans", folly::dynamic::array(std::move(scopeSpans)));
+  return folly::toJson(
+      folly::dynamic::object("resourceSpans", folly::dynamic::array(std::move(resourceSpans))));
+}
+
+folly::dynamic OtlpExporter::toJson(const SpanData& span) const {
+  folly::dynamic attributes = folly::dynamic::array;
+  for (const auto& [key, value] : span.attributes) {
+    attributes.push_back(folly::dynamic::object("key", key)(
+        "value", folly::dynamic::object("stringValue", value)));
+  }
+  // The ids are in hex and the times are strings of nanoseconds in OTLP/JSON
+  folly::dynamic obj = folly::dynamic::object;
+  obj["traceId"] = span.context.traceId();
+  obj["spanId"] = SpanContext::toHex(span.context.spanId);
+  obj["name"] = span.name;
+  obj["kind"] = static_cast<int>(span.kind);
+  obj["startTimeUnixNano"] = folly::to<std::string>(span.startUs * 1000);
+  obj["endTimeUnixNano"] = folly::to<std::string>(span.endUs * 1000);
+  obj["attributes"] = std::move(attributes);
+  if (span.parentSpanId != 0) {
+    obj["parentSpanId"] = SpanContext::toHex(span.parentSpanId);
+  }
+  if (!span.error.empty()) {
+    // STATUS_CODE_ERROR
+    obj["status"] = folly::dynamic::object("code", 2)("message", span.error);
+  }
+  return obj;
+}
+
+}  // namespace tracing
+}  // namespace nebula
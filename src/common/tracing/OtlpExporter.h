@@ -0,0 +1,66 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_TRACING_OTLPEXPORTER_H_
+#define COMMON_TRACING_OTLPEXPORTER_H_
+
+#include <folly/dynamic.h>
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/thread/GenericWorker.h"
+#include "common/tracing/Tracing.h"
+
+DECLARE_double(trace_sample_ratio);
+DECLARE_string(trace_collector_url);
+DECLARE_int32(trace_export_interval_ms);
+DECLARE_int32(trace_export_batch_size);
+DECLARE_int32(trace_export_queue_size);
+
+namespace nebula {
+namespace tracing {
+
+/**
+ * @brief OtlpExporter exports the finished spans to a trace collector, e.g. the OpenTelemetry
+ * collector or Jaeger, by OTLP/HTTP in JSON.
+ *
+ * The spans are queued and posted in batches by a background worker, the spans arriving when the
+ * queue is full are dropped, so that tracing never blocks or bloats a daemon whose collector is
+ * slow or down.
+ */
+class OtlpExporter final : public SpanExporter {
+ public:
+  /**
+   * @brief Enable the tracing of the daemon by the flags, nothing is done if the sample ratio is 0
+   * or no collector is given.
+   */
+  static Status init(const std::string& serviceName);
+
+  explicit OtlpExporter(std::string serviceName);
+
+  ~OtlpExporter() override;
+
+  void exportSpan(std::unique_ptr<SpanData> span) override;
+
+  // Post the queued spans, called by the worker periodically
+  void flush();
+
+  // The request body of the spans in OTLP/JSON
+  std::string toJson(const std::vector<std::unique_ptr<SpanData>>& spans) const;
+
+ private:
+  folly::dynamic toJson(const SpanData& span) const;
+
+  std::string serviceName_;
+  std::mutex lock_;
+  std::vector<std::unique_ptr<SpanData>> queue_;
+  std::atomic<int64_t> dropped_{0};
+  std::unique_ptr<thread::GenericWorker> worker_;
+};
+
+}  // namespace tracing
+}  // namespace nebula
+
+#endif  // COMMON_TRACING_OTLPEXPORTER_H_
@@ -0,0 +1,375 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_TRACING_TRACING_H_
+#define COMMON_TRACING_TRACING_H_
+
+#include <folly/Random.h>
+#include <folly/io/async/Request.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nebula {
+namespace tracing {
+
+/**
+ * @brief The identity of a span, which is propagated to the spans of other processes in the W3C
+ * traceparent format, i.e. "00-<32 hex trace id>-<16 hex span id>-<2 hex flags>".
+ */
+struct SpanContext {
+  uint64_t traceIdHigh{0};
+  uint64_t traceIdLow{0};
+  uint64_t spanId{0};
+  bool sampled{false};
+
+  bool valid() const {
+    return (traceIdHigh != 0 || traceIdLow != 0) && spanId != 0;
+  }
+
+  std::string traceId() const {
+    return toHex(traceIdHigh) + toHex(traceIdLow);
+  }
+
+  std::string toString() const {
+    return "00-" + traceId() + "-" + toHex(spanId) + (sampled ? "-01" : "-00");
+  }
+
+  static std::optional<SpanContext> parse(const std::string& str) {
+    // version-traceid-spanid-flags
+    if (str.size() != 55 || str[2] != '-' || str[35] != '-' || str[52] != '-') {
+      return std::nullopt;
+    }
+    SpanContext ctx;
+    uint64_t flags = 0;
+    if (!fromHex(str, 3, 16, &ctx.traceIdHigh) || !fromHex(str, 19, 16, &ctx.traceIdLow) ||
+        !fromHex(str, 36, 16, &ctx.spanId) || !fromHex(str, 53, 2, &flags) || !ctx.valid()) {
+      return std::nullopt;
+    }
+    ctx.sampled = flags & 0x01;
+    return ctx;
+  }
+
+  static std::string toHex(uint64_t value) {
+    static const char* kDigits = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i, value >>= 4) {
+      hex[i] = kDigits[value & 0x0f];
+    }
+    return hex;
+  }
+
+ private:
+  static bool fromHex(const std::string& str, size_t pos, size_t len, uint64_t* value) {
+    *value = 0;
+    for (size_t i = pos; i < pos + len; ++i) {
+      auto c = str[i];
+      uint64_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        digit = c - 'a' + 10;
+      } else {
+        return false;
+      }
+      *value = (*value << 4) | digit;
+    }
+    return true;
+  }
+};
+
+enum class SpanKind : int8_t {
+  kInternal = 1,
+  kServer = 2,
+  kClient = 3,
+};
+
+// A finished span, to be exported
+struct SpanData {
+  std::string name;
+  SpanKind kind{SpanKind::kInternal};
+  SpanContext context;
+  // 0 for a root span
+  uint64_t parentSpanId{0};
+  // In microseconds since the epoch
+  int64_t startUs{0};
+  int64_t endUs{0};
+  std::vector<std::pair<std::string, std::string>> attributes;
+  // Empty if the span succeeded
+  std::string error;
+};
+
+class SpanExporter {
+ public:
+  virtual ~SpanExporter() = default;
+
+  // Called by the thread finishing the span, which should not block
+  virtual void exportSpan(std::unique_ptr<SpanData> span) = 0;
+};
+
+/**
+ * @brief Tracer decides which traces are sampled, head-based, i.e. once when a trace begins, the
+ * spans of a trace not sampled cost nothing but a branch. Tracing is off until init is called.
+ */
+class Tracer {
+ public:
+  static Tracer& instance() {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  // Called once at startup, before any span begins
+  void init(double sampleRatio, std::unique_ptr<SpanExporter> exporter) {
+    sampleRatio_ = sampleRatio;
+    exporter_ = std::move(exporter);
+    enabled_.store(sampleRatio_ > 0 && exporter_ != nullptr);
+  }
+
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // The context of a new trace, sampled by the ratio
+  SpanContext newTrace() const {
+    SpanContext ctx;
+    ctx.sampled = folly::Random::randDouble01() < sampleRatio_;
+    if (ctx.sampled) {
+      ctx.traceIdHigh = folly::Random::rand64();
+      ctx.traceIdLow = folly::Random::rand64() | 1;
+      ctx.spanId = newSpanId();
+    }
+    return ctx;
+  }
+
+  static uint64_t newSpanId() {
+    return folly::Random::rand64() | 1;
+  }
+
+  void finish(std::unique_ptr<SpanData> span) {
+    if (enabled()) {
+      exporter_->exportSpan(std::move(span));
+    }
+  }
+
+ private:
+  Tracer() = default;
+
+  std::atomic<bool> enabled_{false};
+  double sampleRatio_{0};
+  std::unique_ptr<SpanExporter> exporter_;
+};
+
+/**
+ * @brief The span of an operation, which ends when it's destroyed if not ended yet. A span not
+ * sampled is empty, no memory is allocated and all the operations on it are no-ops.
+ */
+class Span {
+ public:
+  Span() = default;
+
+  Span(Span&&) = default;
+
+  Span& operator=(Span&& other) {
+    if (this != &other) {
+      end();
+      data_ = std::move(other.data_);
+    }
+    return *this;
+  }
+
+  ~Span() {
+    end();
+  }
+
+  /**
+   * @brief Begin a span of the trace of parent, or of a new trace if there is no parent.
+   */
+  static Span start(std::string name,
+                    const std::optional<SpanContext>& parent = std::nullopt,
+                    SpanKind kind = SpanKind::kInternal) {
+    auto& tracer = Tracer::instance();
+    if (!tracer.enabled()) {
+      return Span();
+    }
+    if (parent.has_value()) {
+      if (!parent->sampled) {
+        return Span();
+      }
+      SpanContext ctx = *parent;
+      ctx.spanId = Tracer::newSpanId();
+      return Span(std::move(name), kind, ctx, parent->spanId);
+    }
+    auto ctx = tracer.newTrace();
+    if (!ctx.sampled) {
+      return Span();
+    }
+    return Span(std::move(name), kind, ctx, 0);
+  }
+
+  /**
+   * @brief Begin a child span of the span of the request context of current thread, see SpanScope.
+   */
+  static Span child(const std::string& name, SpanKind kind = SpanKind::kInternal);
+
+  bool sampled() const {
+    return data_ != nullptr;
+  }
+
+  // An invalid context if not sampled
+  SpanContext context() const {
+    return sampled() ? data_->context : SpanContext();
+  }
+
+  int64_t startUs() const {
+    return sampled() ? data_->startUs : 0;
+  }
+
+  void addAttribute(std::string key, std::string value) {
+    if (sampled()) {
+      data_->attributes.emplace_back(std::move(key), std::move(value));
+    }
+  }
+
+  void setError(std::string error) {
+    if (sampled()) {
+      data_->error = std::move(error);
+    }
+  }
+
+  // Export a child span which has been timed by the caller, e.g. by accumulating the durations
+  void addChild(std::string name, int64_t startUs, int64_t endUs) const {
+    if (sampled()) {
+      auto data = std::make_unique<SpanData>();
+      data->name = std::move(name);
+      data->context = data_->context;
+      data->context.spanId = Tracer::newSpanId();
+      data->parentSpanId = data_->context.spanId;
+      data->startUs = startUs;
+      data->endUs = endUs;
+      Tracer::instance().finish(std::move(data));
+    }
+  }
+
+  void end() {
+    if (sampled()) {
+      data_->endUs = nowInUSec();
+      Tracer::instance().finish(std::move(data_));
+    }
+  }
+
+  static int64_t nowInUSec() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+ private:
+  Span(std::string name, SpanKind kind, SpanContext ctx, uint64_t parentSpanId)
+      : data_(std::make_unique<SpanData>()) {
+    data_->name = std::move(name);
+    data_->kind = kind;
+    data_->context = ctx;
+    data_->parentSpanId = parentSpanId;
+    data_->startUs = nowInUSec();
+  }
+
+  std::unique_ptr<SpanData> data_;
+};
+
+// The context of the span which the spans started by current request are children of
+class TraceData final : public folly::RequestData {
+ public:
+  explicit TraceData(SpanContext context) : context_(context) {}
+
+  static const folly::RequestToken& token() {
+    static folly::RequestToken token("nebula::tracing");
+    return token;
+  }
+
+  // The context of the request context of current thread, nullopt if none
+  static std::optional<SpanContext> current() {
+    auto* data = folly::RequestContext::get()->getContextData(token());
+    if (data == nullptr) {
+      return std::nullopt;
+    }
+    return static_cast<TraceData*>(data)->context_;
+  }
+
+  bool hasCallback() override {
+    return false;
+  }
+
+ private:
+  SpanContext context_;
+};
+
+/**
+ * @brief Make span the parent of the spans started in the scope, including the ones started by
+ * the futures it creates, which inherit the request context. Nothing is done if not sampled.
+ */
+class SpanScope {
+ public:
+  explicit SpanScope(const Span& span) {
+    if (span.sampled()) {
+      guard_.emplace(TraceData::token(), std::make_unique<TraceData>(span.context()));
+    }
+  }
+
+ private:
+  std::optional<folly::ShallowCopyRequestContextScopeGuard> guard_;
+};
+
+inline Span Span::child(const std::string& name, SpanKind kind) {
+  if (!Tracer::instance().enabled()) {
+    return Span();
+  }
+  auto parent = TraceData::current();
+  if (!parent.has_value()) {
+    return Span();
+  }
+  return start(name, parent, kind);
+}
+
+template <typename Request, typename = void>
+struct HasCommon : std::false_type {};
+
+template <typename Request>
+struct HasCommon<Request, std::void_t<decltype(std::declval<Request&>().get_common())>>
+    : std::true_type {};
+
+/**
+ * @brief The parent span carried by a request of storage.thrift, in its RequestCommon.
+ */
+template <typename Request>
+std::optional<SpanContext> traceParentOf(const Request& req) {
+  if constexpr (HasCommon<Request>::value) {
+    const auto* common = req.get_common();
+    if (common != nullptr && common->trace_parent_ref().has_value()) {
+      return SpanContext::parse(*common->trace_parent_ref());
+    }
+  }
+  return std::nullopt;
+}
+
+template <typename Request>
+void setTraceParent(Request* req, const SpanContext& parent) {
+  if constexpr (HasCommon<Request>::value) {
+    // The clients always fill the RequestCommon of the requests supporting it
+    if (parent.sampled && req->common_ref().has_value()) {
+      req->common_ref().value().trace_parent_ref() = parent.toString();
+    }
+  }
+}
+
+}  // namespace tracing
+}  // namespace nebula
+
+#endif  // COMMON_TRACING_TRACING_H_
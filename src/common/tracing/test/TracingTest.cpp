@@ -0,0 +1,97 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/tracing/Tracing.h"
+
+namespace nebula {
+namespace tracing {
+
+class CollectExporter final : public SpanExporter {
+ public:
+  void exportSpan(std::unique_ptr<SpanData> span) override {
+    spans.emplace_back(std::move(span));
+  }
+
+  std::vector<std::unique_ptr<SpanData>> spans;
+};
+
+TEST(TracingTest, SpanContextTest) {
+  SpanContext ctx;
+  ctx.traceIdHigh = 0x0af7651916cd43dd;
+  ctx.traceIdLow = 0x8448eb211c80319c;
+  ctx.spanId = 0xb7ad6b7169203331;
+  ctx.sampled = true;
+  auto str = ctx.toString();
+  EXPECT_EQ("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01", str);
+  auto parsed = SpanContext::parse(str);
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(ctx.traceIdHigh, parsed->traceIdHigh);
+  EXPECT_EQ(ctx.traceIdLow, parsed->traceIdLow);
+  EXPECT_EQ(ctx.spanId, parsed->spanId);
+  EXPECT_TRUE(parsed->sampled);
+
+  EXPECT_FALSE(SpanContext::parse("").has_value());
+  EXPECT_FALSE(
+      SpanContext::parse("00-0af7651916cd43dd8448eb211c80319c-b7ad6b716920333x-01").has_value());
+  // All zero ids are invalid
+  EXPECT_FALSE(
+      SpanContext::parse("00-00000000000000000000000000000000-b7ad6b7169203331-01").has_value());
+}
+
+TEST(TracingTest, SpanTest) {
+  // Nothing is traced before init
+  EXPECT_FALSE(Span::start("query").sampled());
+
+  auto exporter = std::make_unique<CollectExporter>();
+  auto* spans = &exporter->spans;
+  Tracer::instance().init(1, std::move(exporter));
+
+  // No parent in the request context
+  EXPECT_FALSE(Span::child("executor").sampled());
+  {
+    auto root = Span::start("query");
+    ASSERT_TRUE(root.sampled());
+    root.addAttribute("query", "YIELD 1");
+    {
+      SpanScope scope(root);
+      auto child = Span::child("executor", SpanKind::kClient);
+      ASSERT_TRUE(child.sampled());
+      EXPECT_EQ(root.context().traceId(), child.context().traceId());
+      EXPECT_NE(root.context().spanId, child.context().spanId);
+      child.setError("failed");
+    }
+    EXPECT_FALSE(Span::child("executor").sampled());
+    root.addChild("node", root.startUs(), root.startUs() + 10);
+    ASSERT_EQ(2, spans->size());
+  }
+  ASSERT_EQ(3, spans->size());
+  const auto& child = *(*spans)[0];
+  const auto& node = *(*spans)[1];
+  const auto& root = *(*spans)[2];
+  EXPECT_EQ("executor", child.name);
+  EXPECT_EQ(SpanKind::kClient, child.kind);
+  EXPECT_EQ("failed", child.error);
+  EXPECT_EQ(root.context.spanId, child.parentSpanId);
+  EXPECT_EQ(root.context.spanId, node.parentSpanId);
+  EXPECT_EQ(10, node.endUs - node.startUs);
+  EXPECT_EQ(0, root.parentSpanId);
+  EXPECT_LE(root.startUs, root.endUs);
+  ASSERT_EQ(1, root.attributes.size());
+  EXPECT_EQ("YIELD 1", root.attributes[0].second);
+
+  // The sampling of the remote parent is followed
+  SpanContext parent = root.context;
+  parent.sampled = false;
+  EXPECT_FALSE(Span::start("processor", parent).sampled());
+  parent.sampled = true;
+  auto remote = Span::start("processor", parent, SpanKind::kServer);
+  ASSERT_TRUE(remote.sampled());
+  EXPECT_EQ(root.context.traceIdLow, remote.context().traceIdLow);
+}
+
+}  // namespace tracing
+}  // namespace nebula
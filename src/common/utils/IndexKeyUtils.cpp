@@ -26,9 +26,42 @@ std::vector<std::string> IndexKeyUtils::encodeValues(std::vector<Value>&& values
   bool hasGeo = std::find_if(cols.begin(), cols.end(), findGeo) != cols.end();
   // Only support to create index on a single geography column currently;
   DCHECK(!hasGeo || cols.size() == 1);
+  // The element index is always on a single LIST_* or SET_* column
+  bool isElementIndex = cols.size() == 1 && isElementIndexColumn(cols[0].type.get_type());
   std::vector<std::string> indexes;
 
-  if (!hasGeo) {
+  if (isElementIndex) {
+    hasNullCol = cols[0].nullable_ref().value_or(false);
+    DCHECK_EQ(values.size(), 1);
+    const auto& value = values.back();
+    auto type = IndexKeyUtils::toValueType(cols[0].type.get_type());
+    const auto* len = cols[0].type.get_type_length();
+    if (value.isList() || value.isSet()) {
+      // The duplicated elements share the same index key
+      std::unordered_set<std::string> keys;
+      auto encodeElement = [&](const Value& elem) {
+        if (elem.type() != type) {
+          return;
+        }
+        auto key = type == Value::Type::STRING ? encodeValue(elem, *len) : encodeValue(elem);
+        if (keys.emplace(key).second) {
+          indexes.emplace_back(std::move(key));
+        }
+      };
+      if (value.isList()) {
+        for (const auto& elem : value.getList().values) {
+          encodeElement(elem);
+        }
+      } else {
+        for (const auto& elem : value.getSet().values) {
+          encodeElement(elem);
+        }
+      }
+    } else {
+      nullableBitSet |= 0x8000;
+      indexes.emplace_back(encodeNullValue(type, len));
+    }
+  } else if (!hasGeo) {
     std::string index;
     for (size_t i = 0; i < values.size(); i++) {
       auto isNullable = cols[i].nullable_ref().value_or(false);
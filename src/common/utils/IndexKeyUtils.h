@@ -54,20 +54,38 @@ class IndexKeyUtils final {
         return Value::Type::GEOGRAPHY;
       case PropertyType::DURATION:
         return Value::Type::DURATION;
+      // The index on a LIST_* or SET_* property is an element index, in which every element
+      // has its own index key, so the index value is of the element type
       case PropertyType::LIST_STRING:
-      case PropertyType::LIST_INT:
-      case PropertyType::LIST_FLOAT:
-        return Value::Type::LIST;
       case PropertyType::SET_STRING:
+        return Value::Type::STRING;
+      case PropertyType::LIST_INT:
       case PropertyType::SET_INT:
+        return Value::Type::INT;
+      case PropertyType::LIST_FLOAT:
       case PropertyType::SET_FLOAT:
-        return Value::Type::SET;
+        return Value::Type::FLOAT;
       case PropertyType::UNKNOWN:
         return Value::Type::__EMPTY__;
     }
     return Value::Type::__EMPTY__;
   }
 
+  // Whether the index column is of the element index
+  static bool isElementIndexColumn(PropertyType type) {
+    switch (type) {
+      case PropertyType::LIST_STRING:
+      case PropertyType::LIST_INT:
+      case PropertyType::LIST_FLOAT:
+      case PropertyType::SET_STRING:
+      case PropertyType::SET_INT:
+      case PropertyType::SET_FLOAT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   static std::string encodeNullValue(Value::Type type, const int16_t* strLen) {
     size_t len = 0;
     switch (type) {
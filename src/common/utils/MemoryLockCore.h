@@ -6,12 +6,20 @@
 #ifndef COMMON_UTILS_MEMORYLOCKCORE_H
 #define COMMON_UTILS_MEMORYLOCKCORE_H
 
-#include <folly/concurrency/ConcurrentHashMap.h>
+#include <folly/hash/Hash.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #include "common/base/Base.h"
 
 namespace nebula {
 
+// The keys are spread over the stripes by the hash of them, each stripe of its own mutex, so the
+// lockers of the keys of different stripes don't contend. The keys could be locked at once, or
+// waited for the holders of them to unlock.
 template <typename Key>
 class MemoryLockCore {
  public:
@@ -28,20 +36,32 @@ class MemoryLockCore {
   }
 
   bool try_lock(const Key& key) {
-    return hashMap_.insert(std::make_pair(key, 0)).second;
+    auto& stripe = stripeOf(key);
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    if (!stripe.keys.emplace(key).second) {
+      ++conflicts_;
+      return false;
+    }
+    return true;
   }
 
   void unlock(const Key& key) {
-    hashMap_.erase(key);
+    auto& stripe = stripeOf(key);
+    {
+      std::lock_guard<std::mutex> guard(stripe.mutex);
+      stripe.keys.erase(key);
+      if (stripe.waiters == 0) {
+        return;
+      }
+    }
+    stripe.cv.notify_all();
   }
 
   template <class Iter>
   std::pair<Iter, bool> lockBatch(Iter begin, Iter end) {
     Iter curr = begin;
-    bool inserted = false;
     while (curr != end) {
-      std::tie(std::ignore, inserted) = hashMap_.insert(std::make_pair(*curr, 0));
-      if (!inserted) {
+      if (!try_lock(*curr)) {
         unlockBatch(begin, curr);
         return std::make_pair(curr, false);
       }
@@ -55,10 +75,30 @@ class MemoryLockCore {
     return lockBatch(collection.begin(), collection.end());
   }
 
+  // Lock the keys one by one, waiting at most timeout in all for the holders of them, the same as
+  // lockBatch otherwise. The keys must be sorted and deduplicated, so the lockers waiting for each
+  // other lock the keys in the same order without deadlock. waited is set if any key is held.
+  template <class Iter>
+  std::pair<Iter, bool> lockSortedBatch(Iter begin,
+                                        Iter end,
+                                        std::chrono::milliseconds timeout,
+                                        bool* waited = nullptr) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    Iter curr = begin;
+    while (curr != end) {
+      if (!lockUntil(*curr, deadline, waited)) {
+        unlockBatch(begin, curr);
+        return std::make_pair(curr, false);
+      }
+      ++curr;
+    }
+    return std::make_pair(end, true);
+  }
+
   template <class Iter>
   void unlockBatch(Iter begin, Iter end) {
     for (; begin != end; ++begin) {
-      hashMap_.erase(*begin);
+      unlock(*begin);
     }
   }
 
@@ -68,19 +108,78 @@ class MemoryLockCore {
   }
 
   void clear() {
-    hashMap_.clear();
+    for (auto& stripe : stripes_) {
+      {
+        std::lock_guard<std::mutex> guard(stripe.mutex);
+        stripe.keys.clear();
+      }
+      stripe.cv.notify_all();
+    }
   }
 
   size_t size() {
-    return hashMap_.size();
+    size_t size = 0;
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> guard(stripe.mutex);
+      size += stripe.keys.size();
+    }
+    return size;
   }
 
   bool contains(const Key& key) {
-    return hashMap_.find(key) == hashMap_.end();
+    auto& stripe = stripeOf(key);
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    return stripe.keys.find(key) == stripe.keys.end();
+  }
+
+  // The times the keys were held by others when locked
+  size_t numConflicts() const {
+    return conflicts_.load(std::memory_order_relaxed);
+  }
+
+  // The times the keys were still held by others after waiting
+  size_t numTimeouts() const {
+    return timeouts_.load(std::memory_order_relaxed);
   }
 
  protected:
-  folly::ConcurrentHashMap<Key, int> hashMap_;
+  static constexpr size_t kNumStripes = 64;
+
+  struct Stripe {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_set<Key> keys;
+    // The lockers waiting for the keys of the stripe
+    size_t waiters{0};
+  };
+
+  Stripe& stripeOf(const Key& key) {
+    return stripes_[std::hash<Key>()(key) % kNumStripes];
+  }
+
+  bool lockUntil(const Key& key, std::chrono::steady_clock::time_point deadline, bool* waited) {
+    auto& stripe = stripeOf(key);
+    std::unique_lock<std::mutex> guard(stripe.mutex);
+    if (stripe.keys.emplace(key).second) {
+      return true;
+    }
+    ++conflicts_;
+    if (waited != nullptr) {
+      *waited = true;
+    }
+    ++stripe.waiters;
+    bool locked =
+        stripe.cv.wait_until(guard, deadline, [&] { return stripe.keys.emplace(key).second; });
+    --stripe.waiters;
+    if (!locked) {
+      ++timeouts_;
+    }
+    return locked;
+  }
+
+  std::array<Stripe, kNumStripes> stripes_;
+  std::atomic<size_t> conflicts_{0};
+  std::atomic<size_t> timeouts_{0};
 };
 
 }  // namespace nebula
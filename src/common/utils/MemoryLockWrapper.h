@@ -7,6 +7,7 @@
 #define COMMON_UTILS_MEMORYLOCKWRAPPER_H
 
 #include <algorithm>
+#include <chrono>
 
 #include "common/utils/MemoryLockCore.h"
 
@@ -35,10 +36,32 @@ class MemoryLockGuard {
     }
   }
 
+  // Lock the keys in the sorted order, waiting at most timeout for the holders of them instead of
+  // failing at once
+  MemoryLockGuard(MemoryLockCore<Key>* lock,
+                  std::vector<Key> keys,
+                  std::chrono::milliseconds timeout)
+      : lock_(lock), keys_(std::move(keys)) {
+    std::sort(keys_.begin(), keys_.end());
+    keys_.erase(unique(keys_.begin(), keys_.end()), keys_.end());
+    auto start = std::chrono::steady_clock::now();
+    std::tie(iter_, locked_) =
+        lock_->lockSortedBatch(keys_.begin(), keys_.end(), timeout, &waited_);
+    if (waited_) {
+      waitedUs_ = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    }
+  }
+
   MemoryLockGuard(const MemoryLockGuard&) = delete;
 
   MemoryLockGuard(MemoryLockGuard&& lg) noexcept
-      : lock_(lg.lock_), keys_(std::move(lg.keys_)), locked_(lg.locked_) {}
+      : lock_(lg.lock_),
+        keys_(std::move(lg.keys_)),
+        locked_(lg.locked_),
+        waited_(lg.waited_),
+        waitedUs_(lg.waitedUs_) {}
 
   MemoryLockGuard& operator=(const MemoryLockGuard&) = delete;
 
@@ -47,6 +70,8 @@ class MemoryLockGuard {
       lock_ = lg.lock_;
       keys_ = std::move(lg.keys_);
       locked_ = lg.locked_;
+      waited_ = lg.waited_;
+      waitedUs_ = lg.waitedUs_;
     }
     return *this;
   }
@@ -72,6 +97,24 @@ class MemoryLockGuard {
     return *iter_;
   }
 
+  // Whether any key was held by others when locked
+  bool waited() const noexcept {
+    return waited_;
+  }
+
+  // How long the keys held by others were waited for, 0 if not waited
+  int64_t waitedUs() const noexcept {
+    return waitedUs_;
+  }
+
+  // Unlock the keys before the guard is destroyed
+  void unlock() {
+    if (locked_) {
+      lock_->unlockBatch(keys_);
+      locked_ = false;
+    }
+  }
+
   void setAutoUnlock(bool autoUnlock) {
     autoUnlock_ = autoUnlock;
   }
@@ -81,6 +124,8 @@ class MemoryLockGuard {
   std::vector<Key> keys_;
   typename std::vector<Key>::iterator iter_;
   bool locked_{false};
+  bool waited_{false};
+  int64_t waitedUs_{0};
   bool autoUnlock_{true};
 };
 
@@ -5,6 +5,7 @@
 
 #include "common/utils/MetaKeyUtils.h"
 
+#include <folly/lang/Bits.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -56,6 +57,11 @@ static const std::unordered_map<
                  {"ft_index", {"__ft_index__", nullptr}},
                  {"local_id", {"__local_id__", MetaKeyUtils::parseLocalIdSpace}},
                  {"disk_parts", {"__disk_parts__", MetaKeyUtils::parseDiskPartsSpace}},
+                 // The hot parts are reported again, no need to back up
+                 {"hot_parts", {"__hot_parts__", nullptr}},
+                 // The clients reload all the meta data after a restore, no need to back up
+                 {"meta_changes", {"__meta_changes__", nullptr}},
+                 {"meta_changes_cover", {"__meta_changes_cover__", nullptr}},
                  {"job_manager", {"__job_mgr__", nullptr}}};
 
 // clang-format off
@@ -80,6 +86,9 @@ static const std::string kGroupsTable         = systemTableMaps.at("groups").fir
 static const std::string kZonesTable          = systemTableMaps.at("zones").first;    // NOLINT
 static const std::string kListenerTable       = tableMaps.at("listener").first;       // NOLINT
 static const std::string kDiskPartsTable      = tableMaps.at("disk_parts").first;     // NOLINT
+static const std::string kHotPartsTable       = tableMaps.at("hot_parts").first;      // NOLINT
+static const std::string kMetaChangesTable    = tableMaps.at("meta_changes").first;   // NOLINT
+static const std::string kMetaChangesCoverKey = tableMaps.at("meta_changes_cover").first;// NOLINT
 
 /*
  * There will be one job, and a bunch of tasks use this prefix.
@@ -1399,6 +1408,71 @@ meta::cpp2::PartitionList MetaKeyUtils::parseDiskPartsVal(const folly::StringPie
   return partList;
 }
 
+/**
+ * hotPartsKey = kHotPartsTable + serialized(hostAddr)
+ */
+std::string MetaKeyUtils::hotPartsKey(const HostAddr& host) {
+  std::string key;
+  key.append(kHotPartsTable.data(), kHotPartsTable.size())
+      .append(MetaKeyUtils::serializeHostAddr(host));
+  return key;
+}
+
+const std::string& MetaKeyUtils::hotPartsPrefix() {
+  return kHotPartsTable;
+}
+
+HostAddr MetaKeyUtils::parseHotPartsKey(folly::StringPiece key) {
+  key.advance(kHotPartsTable.size());
+  return MetaKeyUtils::deserializeHostAddr(key);
+}
+
+std::string MetaKeyUtils::hotPartsVal(const meta::cpp2::HostHotParts& hotParts) {
+  std::string val;
+  apache::thrift::CompactSerializer::serialize(hotParts, &val);
+  return val;
+}
+
+meta::cpp2::HostHotParts MetaKeyUtils::parseHotPartsVal(folly::StringPiece rawData) {
+  meta::cpp2::HostHotParts hotParts;
+  apache::thrift::CompactSerializer::deserialize(rawData, hotParts);
+  return hotParts;
+}
+
+/**
+ * metaChangeKey = kMetaChangesTable + bigEndian(timeInMilliSec) + spaceId
+ */
+std::string MetaKeyUtils::metaChangeKey(int64_t timeInMilliSec, GraphSpaceID spaceId) {
+  auto key = metaChangeStartKey(timeInMilliSec);
+  key.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+  return key;
+}
+
+std::string MetaKeyUtils::metaChangeStartKey(int64_t timeInMilliSec) {
+  std::string key;
+  key.reserve(kMetaChangesTable.size() + sizeof(int64_t) + sizeof(GraphSpaceID));
+  // The big endian keeps the changes ordered by the time
+  auto time = folly::Endian::big(timeInMilliSec);
+  key.append(kMetaChangesTable.data(), kMetaChangesTable.size())
+      .append(reinterpret_cast<const char*>(&time), sizeof(int64_t));
+  return key;
+}
+
+const std::string& MetaKeyUtils::metaChangePrefix() {
+  return kMetaChangesTable;
+}
+
+std::pair<int64_t, GraphSpaceID> MetaKeyUtils::parseMetaChangeKey(folly::StringPiece key) {
+  key.advance(kMetaChangesTable.size());
+  auto time = folly::Endian::big(*reinterpret_cast<const int64_t*>(key.data()));
+  auto spaceId = *reinterpret_cast<const GraphSpaceID*>(key.data() + sizeof(int64_t));
+  return {time, spaceId};
+}
+
+const std::string& MetaKeyUtils::metaChangesCoverKey() {
+  return kMetaChangesCoverKey;
+}
+
 const std::string& MetaKeyUtils::jobPrefix() {
   return kJobTable;
 }
@@ -433,6 +433,30 @@ class MetaKeyUtils final {
 
   static meta::cpp2::PartitionList parseDiskPartsVal(const folly::StringPiece& rawData);
 
+  // The hottest parts reported by each storaged in the heartbeats
+  static std::string hotPartsKey(const HostAddr& host);
+
+  static const std::string& hotPartsPrefix();
+
+  static HostAddr parseHotPartsKey(folly::StringPiece key);
+
+  static std::string hotPartsVal(const meta::cpp2::HostHotParts& hotParts);
+
+  static meta::cpp2::HostHotParts parseHotPartsVal(folly::StringPiece rawData);
+
+  // The spaces changed by each bump of the last update time, ordered by the time
+  static std::string metaChangeKey(int64_t timeInMilliSec, GraphSpaceID spaceId);
+
+  // The key before the changes at or after the time
+  static std::string metaChangeStartKey(int64_t timeInMilliSec);
+
+  static const std::string& metaChangePrefix();
+
+  static std::pair<int64_t, GraphSpaceID> parseMetaChangeKey(folly::StringPiece key);
+
+  // The time since which all the changes are logged, the value is the time in ms
+  static const std::string& metaChangesCoverKey();
+
   // job related
   static const std::string& jobPrefix();
 
@@ -258,12 +258,42 @@ std::vector<std::string> NebulaKeyUtils::snapshotPrefix(PartitionID partId) {
     result.emplace_back(edgePrefix(partId));
     result.emplace_back(IndexKeyUtils::indexPrefix(partId));
     result.emplace_back(kvPrefix(partId));
+    result.emplace_back(neighborhoodPrefix(partId));
     // kSystem will be written when balance data
     // kOperation will be blocked by jobmanager later
   }
   return result;
 }
 
+// static
+std::string NebulaKeyUtils::neighborhoodKey(size_t vIdLen,
+                                            PartitionID partId,
+                                            const VertexID& vId,
+                                            EdgeType type,
+                                            const std::string& aggregate) {
+  CHECK_GE(vIdLen, vId.size());
+  PartitionID item =
+      (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kNeighborhood);
+  std::string key;
+  key.reserve(sizeof(PartitionID) + vIdLen + sizeof(EdgeType) + aggregate.size());
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+      .append(vId.data(), vId.size())
+      .append(vIdLen - vId.size(), '\0')
+      .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType))
+      .append(aggregate);
+  return key;
+}
+
+// static
+std::string NebulaKeyUtils::neighborhoodPrefix(PartitionID partId) {
+  PartitionID item =
+      (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kNeighborhood);
+  std::string key;
+  key.reserve(sizeof(PartitionID));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+  return key;
+}
+
 std::string NebulaKeyUtils::systemPrefix() {
   int8_t type = static_cast<uint32_t>(NebulaKeyType::kSystem);
   std::string key;
@@ -112,6 +112,29 @@ class NebulaKeyUtils final {
 
   static std::string systemPrefix();
 
+  /**
+   * The key of an aggregate materialized of the edges of a type of a vertex: type(1) + partId(3) +
+   * vertexId(*) + edgeType(4) + aggregate(*), the aggregate is its definition, e.g. "count"
+   * */
+  static std::string neighborhoodKey(size_t vIdLen,
+                                     PartitionID partId,
+                                     const VertexID& vId,
+                                     EdgeType type,
+                                     const std::string& aggregate);
+
+  static std::string neighborhoodPrefix(PartitionID partId);
+
+  static bool isNeighborhood(const folly::StringPiece& rawKey) {
+    constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+    auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+    return static_cast<NebulaKeyType>(type) == NebulaKeyType::kNeighborhood;
+  }
+
+  static EdgeType getNeighborhoodEdgeType(size_t vIdLen, const folly::StringPiece& rawKey) {
+    auto offset = sizeof(PartitionID) + vIdLen;
+    return readInt<EdgeType>(rawKey.data() + offset, sizeof(EdgeType));
+  }
+
   static std::vector<std::string> snapshotPrefix(PartitionID partId);
 
   static PartitionID getPart(const folly::StringPiece& rawKey) {
@@ -155,6 +178,16 @@ class NebulaKeyUtils final {
     return static_cast<NebulaKeyType>(type) == NebulaKeyType::kEdge;
   }
 
+  // Whether the key or the prefix is of the edges
+  static bool isEdgeType(const folly::StringPiece& rawKey) {
+    constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+    if (rawKey.size() < len) {
+      return false;
+    }
+    auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+    return static_cast<NebulaKeyType>(type) == NebulaKeyType::kEdge;
+  }
+
   static bool isVertex(const folly::StringPiece& rawKey) {
     constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
     auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
@@ -0,0 +1,180 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/utils/NeighborhoodAggregate.h"
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/datatypes/List.h"
+#include "common/datatypes/Set.h"
+
+namespace nebula {
+
+namespace {
+
+// The values of the changes of union with the numbers of the edges of them
+void addUnion(const Value& changes, std::unordered_map<Value, int64_t>* counts) {
+  for (const auto& change : changes.getList().values) {
+    const auto& pair = change.getList().values;
+    (*counts)[pair[0]] += pair[1].getInt();
+  }
+}
+
+}  // namespace
+
+// static
+StatusOr<std::vector<NeighborhoodAggregate>> NeighborhoodAggregate::parse(
+    const std::string& definitions) {
+  std::vector<folly::StringPiece> items;
+  folly::split(',', definitions, items);
+  std::vector<NeighborhoodAggregate> aggregates;
+  std::unordered_set<std::string> parsed;
+  for (auto item : items) {
+    auto definition = folly::trimWhitespace(item).str();
+    auto lower = folly::toLowerAscii(definition);
+    if (lower == "count") {
+      aggregates.emplace_back(Kind::kCount, "");
+    } else {
+      auto open = definition.find('(');
+      if (open == std::string::npos || definition.back() != ')') {
+        return Status::Error("Invalid materialized aggregate `%s'", definition.c_str());
+      }
+      auto func = folly::trimWhitespace(folly::StringPiece(lower).subpiece(0, open));
+      auto prop = folly::trimWhitespace(
+          folly::StringPiece(definition).subpiece(open + 1, definition.size() - open - 2));
+      if (prop.empty()) {
+        return Status::Error("Invalid materialized aggregate `%s'", definition.c_str());
+      }
+      if (func == "sum") {
+        aggregates.emplace_back(Kind::kSum, prop.str());
+      } else if (func == "union") {
+        aggregates.emplace_back(Kind::kUnion, prop.str());
+      } else {
+        return Status::Error("Unsupported materialized aggregate `%s'", definition.c_str());
+      }
+    }
+    if (!parsed.emplace(aggregates.back().toString()).second) {
+      return Status::Error("Duplicate materialized aggregate `%s'", definition.c_str());
+    }
+  }
+  return aggregates;
+}
+
+// static
+std::string NeighborhoodAggregate::toString(const std::vector<NeighborhoodAggregate>& aggregates) {
+  std::vector<std::string> definitions;
+  definitions.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    definitions.emplace_back(aggregate.toString());
+  }
+  return folly::join(", ", definitions);
+}
+
+std::string NeighborhoodAggregate::toString() const {
+  switch (kind_) {
+    case Kind::kCount:
+      return "count";
+    case Kind::kSum:
+      return "sum(" + prop_ + ")";
+    case Kind::kUnion:
+      return "union(" + prop_ + ")";
+  }
+  return "";
+}
+
+Value NeighborhoodAggregate::delta(const Value& oldValue, const Value& newValue) const {
+  switch (kind_) {
+    case Kind::kCount: {
+      if (oldValue.empty() == newValue.empty()) {
+        return Value::kEmpty;
+      }
+      return newValue.empty() ? -1L : 1L;
+    }
+    case Kind::kSum: {
+      Value change = (newValue.isNumeric() ? newValue : Value(0L)) -
+                     (oldValue.isNumeric() ? oldValue : Value(0L));
+      if (!change.isNumeric() || change == Value(0L)) {
+        return Value::kEmpty;
+      }
+      return change;
+    }
+    case Kind::kUnion: {
+      bool oldCounted = !oldValue.empty() && !oldValue.isNull();
+      bool newCounted = !newValue.empty() && !newValue.isNull();
+      if (oldCounted && newCounted && oldValue == newValue) {
+        return Value::kEmpty;
+      }
+      List changes;
+      if (oldCounted) {
+        changes.emplace_back(List({oldValue, -1L}));
+      }
+      if (newCounted) {
+        changes.emplace_back(List({newValue, 1L}));
+      }
+      if (changes.empty()) {
+        return Value::kEmpty;
+      }
+      return changes;
+    }
+  }
+  return Value::kEmpty;
+}
+
+// static
+Value NeighborhoodAggregate::merge(const Value& lhs, const Value& rhs) {
+  if (lhs.empty()) {
+    return rhs;
+  }
+  if (rhs.empty()) {
+    return lhs;
+  }
+  if (!lhs.isList() || !rhs.isList()) {
+    return lhs + rhs;
+  }
+  std::unordered_map<Value, int64_t> counts;
+  addUnion(lhs, &counts);
+  addUnion(rhs, &counts);
+  List merged;
+  merged.reserve(counts.size());
+  for (auto& [value, count] : counts) {
+    // The values of no edge are dropped
+    if (count != 0) {
+      merged.emplace_back(List({value, count}));
+    }
+  }
+  return merged;
+}
+
+Value NeighborhoodAggregate::result(const Value& merged) const {
+  if (kind_ != Kind::kUnion) {
+    return merged.empty() ? Value(0L) : merged;
+  }
+  Set values;
+  if (merged.isList()) {
+    for (const auto& change : merged.getList().values) {
+      const auto& pair = change.getList().values;
+      if (pair[1].getInt() > 0) {
+        values.values.emplace(pair[0]);
+      }
+    }
+  }
+  return values;
+}
+
+// static
+std::string NeighborhoodAggregate::encode(const Value& value) {
+  std::string raw;
+  apache::thrift::CompactSerializer::serialize(value, &raw);
+  return raw;
+}
+
+// static
+Value NeighborhoodAggregate::decode(folly::StringPiece raw) {
+  Value value;
+  apache::thrift::CompactSerializer::deserialize(raw, value);
+  return value;
+}
+
+}  // namespace nebula
@@ -0,0 +1,84 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_UTILS_NEIGHBORHOODAGGREGATE_H_
+#define COMMON_UTILS_NEIGHBORHOODAGGREGATE_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * @brief An aggregate of the edges of each vertex materialized by an edge type, which is defined
+ * by the `MATERIALIZED` property of the edge, e.g. `MATERIALIZED = "count, sum(weight)"`:
+ *   count     the number of the edges
+ *   sum(p)    the sum of the property p of the edges, the NULLs are skipped
+ *   union(p)  the distinct values of the property p of the edges, the NULLs are skipped
+ *
+ * The aggregate of the out-edges, or of the in-edges for the negative type, of a vertex is kept in
+ * a key of the part of the vertex. The writes of the edges merge their changes into the key by the
+ * merge operator rather than reading it, so the edges of a vertex are written without conflicts.
+ * The changes of count and sum are added, the one of union is the list of the values changed, each
+ * with the number of the edges added or removed of it, as a value is kept until its last edge.
+ */
+class NeighborhoodAggregate final {
+ public:
+  enum class Kind : uint8_t {
+    kCount,
+    kSum,
+    kUnion,
+  };
+
+  NeighborhoodAggregate(Kind kind, std::string prop) : kind_(kind), prop_(std::move(prop)) {}
+
+  // Parse the definitions separated by the commas
+  static StatusOr<std::vector<NeighborhoodAggregate>> parse(const std::string& definitions);
+
+  // The definitions in the form parsed
+  static std::string toString(const std::vector<NeighborhoodAggregate>& aggregates);
+
+  Kind kind() const {
+    return kind_;
+  }
+
+  // The property aggregated, empty for count
+  const std::string& prop() const {
+    return prop_;
+  }
+
+  // The definition, e.g. "sum(weight)", which ends the keys of the aggregate too
+  std::string toString() const;
+
+  /**
+   * @brief The change of the aggregate by the write of an edge
+   *
+   * @param oldValue The property of the edge before the write, NULL for count, EMPTY if the edge
+   *                 didn't exist
+   * @param newValue The property of the edge after the write, NULL for count, EMPTY if the edge is
+   *                 deleted
+   * @return Value EMPTY if the aggregate is not changed
+   */
+  Value delta(const Value& oldValue, const Value& newValue) const;
+
+  // Merge two changes, or a change into the aggregate merged before
+  static Value merge(const Value& lhs, const Value& rhs);
+
+  // The aggregate of the changes merged, which are EMPTY if there is none
+  Value result(const Value& merged) const;
+
+  static std::string encode(const Value& value);
+
+  static Value decode(folly::StringPiece raw);
+
+ private:
+  Kind kind_;
+  std::string prop_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_UTILS_NEIGHBORHOODAGGREGATE_H_
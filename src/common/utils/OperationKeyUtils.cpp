@@ -67,4 +67,40 @@ std::string OperationKeyUtils::operationPrefix(PartitionID partId) {
   return result;
 }
 
+// static
+std::string OperationKeyUtils::pendingIndexKey(PartitionID part, const std::string& dataKey) {
+  return pendingIndexPrefix(part).append(dataKey);
+}
+
+// static
+std::string OperationKeyUtils::pendingIndexVal(int64_t ts, const std::string& oldValue) {
+  std::string result;
+  result.reserve(sizeof(int64_t) + oldValue.size());
+  result.append(reinterpret_cast<const char*>(&ts), sizeof(int64_t)).append(oldValue);
+  return result;
+}
+
+// static
+std::string OperationKeyUtils::getPendingDataKey(const folly::StringPiece& rawKey) {
+  return rawKey.subpiece(sizeof(PartitionID)).toString();
+}
+
+// static
+int64_t OperationKeyUtils::getPendingTs(const folly::StringPiece& rawValue) {
+  return readInt<int64_t>(rawValue.data(), sizeof(int64_t));
+}
+
+// static
+folly::StringPiece OperationKeyUtils::getPendingOldValue(const folly::StringPiece& rawValue) {
+  return rawValue.subpiece(sizeof(int64_t));
+}
+
+// static
+std::string OperationKeyUtils::pendingIndexPrefix(PartitionID part) {
+  uint32_t item = (part << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kPendingIndex);
+  std::string result;
+  result.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+  return result;
+}
+
 }  // namespace nebula
@@ -30,6 +30,21 @@ class OperationKeyUtils final {
 
   static std::string operationPrefix(PartitionID part);
 
+  // The pending record of a row not applied to the async indexes yet, keyed by the data key
+  static std::string pendingIndexKey(PartitionID part, const std::string& dataKey);
+
+  // The value of a pending record, the time of the first write pending and the value of the row
+  // whose index entries are the ones written, empty if none
+  static std::string pendingIndexVal(int64_t ts, const std::string& oldValue);
+
+  static std::string getPendingDataKey(const folly::StringPiece& rawKey);
+
+  static int64_t getPendingTs(const folly::StringPiece& rawValue);
+
+  static folly::StringPiece getPendingOldValue(const folly::StringPiece& rawValue);
+
+  static std::string pendingIndexPrefix(PartitionID part);
+
  private:
   OperationKeyUtils() = delete;
 };
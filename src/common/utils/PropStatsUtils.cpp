@@ -0,0 +1,302 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/utils/PropStatsUtils.h"
+
+#include "common/base/MurmurHash2.h"
+
+namespace nebula {
+
+namespace {
+
+constexpr size_t kRegisters = 1UL << PropStatsUtils::kSketchBits;
+
+}  // namespace
+
+ValueStatsBuilder::ValueStatsBuilder() : registers_(kRegisters, '\0'), rand_(kRegisters) {}
+
+void ValueStatsBuilder::add(const Value& value) {
+  if (value.isNull() || value.empty()) {
+    nulls_++;
+    return;
+  }
+  addUnordered(value);
+  sample(value);
+  countFrequency(value);
+}
+
+void ValueStatsBuilder::addUnordered(const Value& value) {
+  if (value.isNull() || value.empty()) {
+    nulls_++;
+    return;
+  }
+  values_++;
+  auto h = PropStatsUtils::hash(value);
+  // The first bits choose the register, which keeps the max position of the first 1 of the rest
+  auto index = h >> (64 - PropStatsUtils::kSketchBits);
+  auto rest = h << PropStatsUtils::kSketchBits;
+  uint8_t rank = rest == 0 ? 64 - PropStatsUtils::kSketchBits + 1 : __builtin_clzll(rest) + 1;
+  auto& reg = reinterpret_cast<uint8_t&>(registers_[index]);
+  reg = std::max(reg, rank);
+}
+
+void ValueStatsBuilder::sample(const Value& value) {
+  orderedValues_++;
+  if (samples_.size() < PropStatsUtils::kSamples) {
+    samples_.emplace_back(value);
+    return;
+  }
+  // Each value is kept by the probability kSamples / orderedValues_
+  auto index = rand_() % orderedValues_;
+  if (index < PropStatsUtils::kSamples) {
+    samples_[index] = value;
+  }
+}
+
+void ValueStatsBuilder::countFrequency(const Value& value) {
+  auto found = frequencies_.find(value);
+  if (found != frequencies_.end()) {
+    found->second++;
+    return;
+  }
+  if (frequencies_.size() < PropStatsUtils::kFrequencyCounters) {
+    frequencies_.emplace(value, 1);
+    return;
+  }
+  // Replace the least frequent one, the new value may have appeared that many times
+  auto least = frequencies_.begin();
+  for (auto it = frequencies_.begin(); it != frequencies_.end(); ++it) {
+    if (it->second < least->second) {
+      least = it;
+    }
+  }
+  auto count = least->second + 1;
+  frequencies_.erase(least);
+  frequencies_.emplace(value, count);
+}
+
+meta::cpp2::ValueStats ValueStatsBuilder::build() {
+  meta::cpp2::ValueStats stats;
+  stats.values_ref() = values_;
+  stats.nulls_ref() = nulls_;
+  stats.ndv_sketch_ref() = registers_;
+
+  std::sort(samples_.begin(), samples_.end());
+  std::vector<Value> bounds;
+  std::vector<int64_t> bucketValues;
+  auto buckets = std::min(PropStatsUtils::kBuckets, samples_.size());
+  size_t start = 0;
+  int64_t counted = 0;
+  for (size_t i = 0; i < buckets; ++i) {
+    auto end = (i + 1) * samples_.size() / buckets;
+    // Scale the samples in the bucket to the values
+    auto count = (i + 1 == buckets) ? orderedValues_ - counted
+                                    : static_cast<int64_t>(end - start) * orderedValues_ /
+                                          static_cast<int64_t>(samples_.size());
+    counted += count;
+    const auto& bound = samples_[end - 1];
+    if (!bounds.empty() && bounds.back() == bound) {
+      bucketValues.back() += count;
+    } else {
+      bounds.emplace_back(bound);
+      bucketValues.emplace_back(count);
+    }
+    start = end;
+  }
+  stats.bucket_bounds_ref() = std::move(bounds);
+  stats.bucket_values_ref() = std::move(bucketValues);
+
+  std::vector<std::pair<Value, int64_t>> tops(frequencies_.begin(), frequencies_.end());
+  std::sort(tops.begin(), tops.end(), [](const auto& l, const auto& r) {
+    return l.second > r.second;
+  });
+  if (tops.size() > PropStatsUtils::kTopValues) {
+    tops.resize(PropStatsUtils::kTopValues);
+  }
+  for (auto& top : tops) {
+    stats.top_values_ref()->emplace_back(std::move(top.first));
+    stats.top_frequencies_ref()->emplace_back(top.second);
+  }
+  return stats;
+}
+
+/*static*/ uint64_t PropStatsUtils::hash(const Value& value) {
+  MurmurHash2 murmur;
+  switch (value.type()) {
+    case Value::Type::BOOL: {
+      char b = value.getBool() ? 1 : 0;
+      return murmur(&b, 1);
+    }
+    case Value::Type::INT: {
+      auto i = value.getInt();
+      return murmur(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    case Value::Type::FLOAT: {
+      auto f = value.getFloat();
+      return murmur(reinterpret_cast<const char*>(&f), sizeof(f));
+    }
+    case Value::Type::STRING:
+      return murmur(value.getStr());
+    default:
+      return murmur(value.toString());
+  }
+}
+
+/*static*/ double PropStatsUtils::ndv(const meta::cpp2::ValueStats& stats) {
+  const auto& registers = stats.get_ndv_sketch();
+  if (registers.size() != kRegisters || stats.get_values() == 0) {
+    return static_cast<double>(stats.get_values());
+  }
+  double m = static_cast<double>(kRegisters);
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto reg : registers) {
+    auto r = static_cast<uint8_t>(reg);
+    sum += std::ldexp(1.0, -static_cast<int>(r));
+    if (r == 0) {
+      zeros++;
+    }
+  }
+  auto alpha = 0.7213 / (1 + 1.079 / m);
+  auto estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    // Linear counting is more accurate for the small cardinality
+    estimate = m * std::log(m / static_cast<double>(zeros));
+  }
+  return std::min(estimate, static_cast<double>(stats.get_values()));
+}
+
+/*static*/ void PropStatsUtils::merge(meta::cpp2::ValueStats& lhs,
+                                      const meta::cpp2::ValueStats& rhs) {
+  mergeHistogram(lhs, rhs);
+  mergeTopValues(lhs, rhs);
+  *lhs.values_ref() += rhs.get_values();
+  *lhs.nulls_ref() += rhs.get_nulls();
+  auto& registers = *lhs.ndv_sketch_ref();
+  const auto& other = rhs.get_ndv_sketch();
+  if (registers.size() != other.size()) {
+    // One of them is empty
+    if (registers.size() < other.size()) {
+      registers = other;
+    }
+    return;
+  }
+  for (size_t i = 0; i < registers.size(); ++i) {
+    registers[i] = std::max(static_cast<uint8_t>(registers[i]), static_cast<uint8_t>(other[i]));
+  }
+}
+
+/*static*/ void PropStatsUtils::merge(meta::cpp2::PropStats& lhs,
+                                      const meta::cpp2::PropStats& rhs) {
+  merge(*lhs.values_ref(), rhs.get_values());
+  if (rhs.elements_ref().has_value()) {
+    if (lhs.elements_ref().has_value()) {
+      merge(*lhs.elements_ref(), *rhs.elements_ref());
+    } else {
+      lhs.elements_ref() = *rhs.elements_ref();
+    }
+  }
+}
+
+/*static*/ void PropStatsUtils::mergeProps(meta::cpp2::StatsItem& lhs,
+                                           const meta::cpp2::StatsItem& rhs) {
+  auto mergeSchemas = [](auto& lhsSchemas, const auto& rhsSchemas) {
+    for (const auto& schema : rhsSchemas) {
+      auto& props = lhsSchemas[schema.first];
+      for (const auto& prop : schema.second) {
+        auto found = props.find(prop.first);
+        if (found == props.end()) {
+          props.emplace(prop.first, prop.second);
+        } else {
+          merge(found->second, prop.second);
+        }
+      }
+    }
+  };
+  if (rhs.tag_props_ref().has_value()) {
+    if (lhs.tag_props_ref().has_value()) {
+      mergeSchemas(*lhs.tag_props_ref(), *rhs.tag_props_ref());
+    } else {
+      lhs.tag_props_ref() = *rhs.tag_props_ref();
+    }
+  }
+  if (rhs.edge_props_ref().has_value()) {
+    if (lhs.edge_props_ref().has_value()) {
+      mergeSchemas(*lhs.edge_props_ref(), *rhs.edge_props_ref());
+    } else {
+      lhs.edge_props_ref() = *rhs.edge_props_ref();
+    }
+  }
+}
+
+/*static*/ void PropStatsUtils::mergeHistogram(meta::cpp2::ValueStats& lhs,
+                                               const meta::cpp2::ValueStats& rhs) {
+  // Take each bucket as its values at the bound, and split them into equi-depth buckets again
+  std::vector<std::pair<Value, int64_t>> points;
+  int64_t total = 0;
+  auto addPoints = [&points, &total](const meta::cpp2::ValueStats& stats) {
+    const auto& bounds = stats.get_bucket_bounds();
+    const auto& values = stats.get_bucket_values();
+    for (size_t i = 0; i < bounds.size() && i < values.size(); ++i) {
+      points.emplace_back(bounds[i], values[i]);
+      total += values[i];
+    }
+  };
+  addPoints(lhs);
+  addPoints(rhs);
+  std::sort(points.begin(), points.end(), [](const auto& l, const auto& r) {
+    return l.first < r.first;
+  });
+  std::vector<Value> bounds;
+  std::vector<int64_t> bucketValues;
+  auto depth = std::max<int64_t>((total + kBuckets - 1) / kBuckets, 1);
+  int64_t count = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    count += points[i].second;
+    if (count < depth && i + 1 != points.size()) {
+      continue;
+    }
+    if (!bounds.empty() && bounds.back() == points[i].first) {
+      bucketValues.back() += count;
+    } else {
+      bounds.emplace_back(points[i].first);
+      bucketValues.emplace_back(count);
+    }
+    count = 0;
+  }
+  lhs.bucket_bounds_ref() = std::move(bounds);
+  lhs.bucket_values_ref() = std::move(bucketValues);
+}
+
+/*static*/ void PropStatsUtils::mergeTopValues(meta::cpp2::ValueStats& lhs,
+                                               const meta::cpp2::ValueStats& rhs) {
+  std::unordered_map<Value, int64_t> frequencies;
+  auto addTops = [&frequencies](const meta::cpp2::ValueStats& stats) {
+    const auto& values = stats.get_top_values();
+    const auto& counts = stats.get_top_frequencies();
+    for (size_t i = 0; i < values.size() && i < counts.size(); ++i) {
+      frequencies[values[i]] += counts[i];
+    }
+  };
+  addTops(lhs);
+  addTops(rhs);
+  std::vector<std::pair<Value, int64_t>> tops(frequencies.begin(), frequencies.end());
+  std::sort(tops.begin(), tops.end(), [](const auto& l, const auto& r) {
+    return l.second > r.second;
+  });
+  if (tops.size() > kTopValues) {
+    tops.resize(kTopValues);
+  }
+  std::vector<Value> values;
+  std::vector<int64_t> counts;
+  for (auto& top : tops) {
+    values.emplace_back(std::move(top.first));
+    counts.emplace_back(top.second);
+  }
+  lhs.top_values_ref() = std::move(values);
+  lhs.top_frequencies_ref() = std::move(counts);
+}
+
+}  // namespace nebula
@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_UTILS_PROPSTATSUTILS_H_
+#define COMMON_UTILS_PROPSTATSUTILS_H_
+
+#include <random>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "interface/gen-cpp2/meta_types.h"
+
+namespace nebula {
+
+/**
+ * @brief Builds the ValueStats of the values added one by one, e.g. the values of a property in a
+ * part. The distinct values are counted by a HyperLogLog sketch, the equi-depth histogram is made
+ * of a reservoir sample, and the most frequent values are kept by the space saving algorithm, so
+ * the memory is bounded whatever the number of values.
+ */
+class ValueStatsBuilder final {
+ public:
+  ValueStatsBuilder();
+
+  /**
+   * @brief Add a value, NULL is counted as null
+   */
+  void add(const Value& value);
+
+  /**
+   * @brief Add a value without order, e.g. a list, only the number of values and the distinct ones
+   * are counted
+   */
+  void addUnordered(const Value& value);
+
+  /**
+   * @brief Build the stats of the values added
+   */
+  meta::cpp2::ValueStats build();
+
+ private:
+  void sample(const Value& value);
+
+  void countFrequency(const Value& value);
+
+  int64_t values_{0};
+  int64_t nulls_{0};
+  // The values ordered, sampled for the histogram
+  int64_t orderedValues_{0};
+  std::string registers_;
+  std::vector<Value> samples_;
+  // The counters of the space saving algorithm
+  std::unordered_map<Value, int64_t> frequencies_;
+  std::mt19937_64 rand_;
+};
+
+class PropStatsUtils final {
+ public:
+  // The registers of the sketch is 2^kSketchBits
+  static constexpr size_t kSketchBits = 12;
+  static constexpr size_t kBuckets = 64;
+  static constexpr size_t kSamples = 4096;
+  static constexpr size_t kTopValues = 16;
+  // Counters kept by the space saving algorithm, more than kTopValues to be more accurate
+  static constexpr size_t kFrequencyCounters = 64;
+
+  PropStatsUtils() = delete;
+
+  /**
+   * @brief The hash of value, the same on all hosts
+   */
+  static uint64_t hash(const Value& value);
+
+  /**
+   * @brief Estimate the number of distinct values by the sketch
+   */
+  static double ndv(const meta::cpp2::ValueStats& stats);
+
+  /**
+   * @brief Merge the stats of the other values into lhs, the histogram and the most frequent
+   * values are approximate after merging
+   */
+  static void merge(meta::cpp2::ValueStats& lhs, const meta::cpp2::ValueStats& rhs);
+
+  static void merge(meta::cpp2::PropStats& lhs, const meta::cpp2::PropStats& rhs);
+
+  /**
+   * @brief Merge the stats of the properties of tags and edges of rhs into lhs
+   */
+  static void mergeProps(meta::cpp2::StatsItem& lhs, const meta::cpp2::StatsItem& rhs);
+
+ private:
+  static void mergeHistogram(meta::cpp2::ValueStats& lhs, const meta::cpp2::ValueStats& rhs);
+
+  static void mergeTopValues(meta::cpp2::ValueStats& lhs, const meta::cpp2::ValueStats& rhs);
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_UTILS_PROPSTATSUTILS_H_
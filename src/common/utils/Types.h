@@ -19,8 +19,10 @@ enum class NebulaKeyType : uint32_t {
   kOperation = 0x00000005,
   kKeyValue = 0x00000006,
   kVertex = 0x00000007,
-  kPrime = 0x00000008,        // used in TOSS, if we write a lock succeed
-  kDoublePrime = 0x00000009,  // used in TOSS, if we get RPC back from remote.
+  kPrime = 0x00000008,         // used in TOSS, if we write a lock succeed
+  kDoublePrime = 0x00000009,   // used in TOSS, if we get RPC back from remote.
+  kPendingIndex = 0x0000000A,  // the rows not applied to the async indexes yet
+  kNeighborhood = 0x0000000B,  // the aggregates materialized of the edges of the vertices
 };
 
 enum class NebulaSystemKeyType : uint32_t {
@@ -204,6 +204,60 @@ TEST(IndexKeyUtilsTest, encodeDouble) {
   EXPECT_TRUE(evalDouble(600.5));
 }
 
+TEST(IndexKeyUtilsTest, encodeElementIndex) {
+  auto indexItem = [](const PropertyType type) {
+    meta::cpp2::ColumnDef col;
+    col.name = "col";
+    col.type.type_ref() = type;
+    col.nullable_ref() = true;
+    if (type == PropertyType::LIST_STRING || type == PropertyType::SET_STRING) {
+      col.type.type_length_ref() = 4;
+    }
+    auto item = std::make_unique<meta::cpp2::IndexItem>();
+    item->fields_ref() = {col};
+    return item;
+  };
+  u_short notNull = 0x0000;
+  std::string notNullBits(reinterpret_cast<const char*>(&notNull), sizeof(u_short));
+  {
+    // one key for each distinct element
+    auto item = indexItem(PropertyType::LIST_INT);
+    std::vector<Value> values = {Value(List({3, 1, 3, 2}))};
+    auto raws = IndexKeyUtils::encodeValues(std::move(values), item.get());
+    std::vector<std::string> expected = {IndexKeyUtils::encodeValue(3) + notNullBits,
+                                         IndexKeyUtils::encodeValue(1) + notNullBits,
+                                         IndexKeyUtils::encodeValue(2) + notNullBits};
+    EXPECT_EQ(expected, raws);
+  }
+  {
+    auto item = indexItem(PropertyType::SET_STRING);
+    std::vector<Value> values = {Value(Set(std::unordered_set<Value>{"a", "abcdef"}))};
+    auto raws = IndexKeyUtils::encodeValues(std::move(values), item.get());
+    std::sort(raws.begin(), raws.end());
+    std::vector<std::string> expected = {IndexKeyUtils::encodeValue("a", 4) + notNullBits,
+                                         IndexKeyUtils::encodeValue("abcdef", 4) + notNullBits};
+    EXPECT_EQ(expected, raws);
+  }
+  {
+    // an empty collection has no key
+    auto item = indexItem(PropertyType::LIST_FLOAT);
+    std::vector<Value> values = {Value(List())};
+    auto raws = IndexKeyUtils::encodeValues(std::move(values), item.get());
+    EXPECT_TRUE(raws.empty());
+  }
+  {
+    // null has a null key
+    auto item = indexItem(PropertyType::SET_INT);
+    std::vector<Value> values = {Value(NullType::__NULL__)};
+    auto raws = IndexKeyUtils::encodeValues(std::move(values), item.get());
+    ASSERT_EQ(1, raws.size());
+    u_short isNull = 0x8000;
+    EXPECT_EQ(IndexKeyUtils::encodeNullValue(Value::Type::INT, nullptr) +
+                  std::string(reinterpret_cast<const char*>(&isNull), sizeof(u_short)),
+              raws[0]);
+  }
+}
+
 TEST(IndexKeyUtilsTest, vertexIndexKeyV1) {
   auto values = getIndexValues();
   auto key = IndexKeyUtils::vertexIndexKeys(8, 1, 1, getStringId(1), {std::move(values)})[0];
@@ -0,0 +1,79 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Set.h"
+#include "common/utils/NeighborhoodAggregate.h"
+
+namespace nebula {
+
+TEST(NeighborhoodAggregateTest, Parse) {
+  auto aggregates = NeighborhoodAggregate::parse("COUNT, sum(weight) ,Union( name )");
+  ASSERT_TRUE(aggregates.ok());
+  ASSERT_EQ(3, aggregates.value().size());
+  EXPECT_EQ(NeighborhoodAggregate::Kind::kCount, aggregates.value()[0].kind());
+  EXPECT_EQ(NeighborhoodAggregate::Kind::kSum, aggregates.value()[1].kind());
+  EXPECT_EQ("weight", aggregates.value()[1].prop());
+  EXPECT_EQ(NeighborhoodAggregate::Kind::kUnion, aggregates.value()[2].kind());
+  EXPECT_EQ("name", aggregates.value()[2].prop());
+  EXPECT_EQ("count, sum(weight), union(name)", NeighborhoodAggregate::toString(aggregates.value()));
+
+  EXPECT_FALSE(NeighborhoodAggregate::parse("count, count").ok());
+  EXPECT_FALSE(NeighborhoodAggregate::parse("avg(weight)").ok());
+  EXPECT_FALSE(NeighborhoodAggregate::parse("sum()").ok());
+  EXPECT_FALSE(NeighborhoodAggregate::parse("sum(weight").ok());
+  EXPECT_FALSE(NeighborhoodAggregate::parse("").ok());
+}
+
+TEST(NeighborhoodAggregateTest, CountAndSum) {
+  NeighborhoodAggregate count(NeighborhoodAggregate::Kind::kCount, "");
+  NeighborhoodAggregate sum(NeighborhoodAggregate::Kind::kSum, "weight");
+  EXPECT_EQ(Value(1L), count.delta(Value::kEmpty, Value::kNullValue));
+  EXPECT_EQ(Value(-1L), count.delta(Value::kNullValue, Value::kEmpty));
+  EXPECT_TRUE(count.delta(Value::kNullValue, Value::kNullValue).empty());
+
+  // Insert 3 and 5, update 3 to 4 and delete 5
+  Value merged;
+  for (const auto& [oldValue, newValue] : std::vector<std::pair<Value, Value>>{
+           {Value::kEmpty, 3L}, {Value::kEmpty, 5L}, {3L, 4L}, {5L, Value::kEmpty}}) {
+    merged = NeighborhoodAggregate::merge(merged, sum.delta(oldValue, newValue));
+  }
+  EXPECT_EQ(Value(4L), sum.result(merged));
+  EXPECT_TRUE(sum.delta(4L, 4L).empty());
+  EXPECT_TRUE(sum.delta(Value::kEmpty, Value::kNullValue).empty());
+  EXPECT_EQ(Value(0L), sum.result(Value::kEmpty));
+  EXPECT_EQ(Value(0L), count.result(Value::kEmpty));
+}
+
+TEST(NeighborhoodAggregateTest, Union) {
+  NeighborhoodAggregate values(NeighborhoodAggregate::Kind::kUnion, "name");
+  // Two edges of "a" and one of "b", then one edge of "a" and the one of "b" are deleted
+  Value merged;
+  for (const auto& [oldValue, newValue] :
+       std::vector<std::pair<Value, Value>>{{Value::kEmpty, "a"},
+                                            {Value::kEmpty, "a"},
+                                            {Value::kEmpty, "b"},
+                                            {"a", Value::kEmpty},
+                                            {"b", Value::kNullValue}}) {
+    auto delta = values.delta(oldValue, newValue);
+    // The changes merged partially are kept the same as the ones merged in order
+    merged = NeighborhoodAggregate::merge(
+        merged, NeighborhoodAggregate::decode(NeighborhoodAggregate::encode(delta)));
+  }
+  EXPECT_EQ(Value(Set({"a"})), values.result(merged));
+  EXPECT_TRUE(values.delta("a", "a").empty());
+  EXPECT_EQ(Value(Set()), values.result(Value::kEmpty));
+
+  auto lhs = NeighborhoodAggregate::merge(values.delta(Value::kEmpty, "c"),
+                                          values.delta(Value::kEmpty, "d"));
+  auto rhs = NeighborhoodAggregate::merge(values.delta("c", Value::kEmpty),
+                                          values.delta("d", "e"));
+  EXPECT_EQ(Value(Set({"e"})), values.result(NeighborhoodAggregate::merge(lhs, rhs)));
+}
+
+}  // namespace nebula
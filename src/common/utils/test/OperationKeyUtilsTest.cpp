@@ -22,6 +22,20 @@ TEST(OperationKeyUtilsTest, DeleteKeyTest) {
   ASSERT_TRUE(OperationKeyUtils::isDeleteOperation(opKey));
 }
 
+TEST(OperationKeyUtilsTest, PendingIndexTest) {
+  PartitionID part = 1;
+  auto key = OperationKeyUtils::pendingIndexKey(part, "data key");
+  ASSERT_TRUE(folly::StringPiece(key).startsWith(OperationKeyUtils::pendingIndexPrefix(part)));
+  ASSERT_FALSE(folly::StringPiece(key).startsWith(OperationKeyUtils::operationPrefix(part)));
+  ASSERT_EQ(OperationKeyUtils::getPendingDataKey(key), "data key");
+
+  auto val = OperationKeyUtils::pendingIndexVal(12345, "old value");
+  ASSERT_EQ(OperationKeyUtils::getPendingTs(val), 12345);
+  ASSERT_EQ(OperationKeyUtils::getPendingOldValue(val), "old value");
+  val = OperationKeyUtils::pendingIndexVal(12345, "");
+  ASSERT_TRUE(OperationKeyUtils::getPendingOldValue(val).empty());
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
@@ -0,0 +1,101 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/utils/PropStatsUtils.h"
+
+namespace nebula {
+
+static int64_t sum(const std::vector<int64_t>& values) {
+  return std::accumulate(values.begin(), values.end(), int64_t(0));
+}
+
+TEST(PropStatsUtilsTest, Build) {
+  ValueStatsBuilder builder;
+  for (int64_t i = 0; i < 100000; ++i) {
+    // 0 appears 10000 times, the others once
+    builder.add(i % 10 == 0 ? 0 : i);
+  }
+  builder.add(Value::kNullValue);
+  auto stats = builder.build();
+  EXPECT_EQ(100000, stats.get_values());
+  EXPECT_EQ(1, stats.get_nulls());
+
+  auto ndv = PropStatsUtils::ndv(stats);
+  EXPECT_NEAR(90001, ndv, 90001 * 0.05);
+
+  const auto& bounds = stats.get_bucket_bounds();
+  ASSERT_FALSE(bounds.empty());
+  ASSERT_EQ(bounds.size(), stats.get_bucket_values().size());
+  EXPECT_LE(bounds.size(), PropStatsUtils::kBuckets);
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+  EXPECT_EQ(100000, sum(stats.get_bucket_values()));
+
+  ASSERT_FALSE(stats.get_top_values().empty());
+  EXPECT_EQ(Value(0), stats.get_top_values().front());
+  EXPECT_LE(10000, stats.get_top_frequencies().front());
+}
+
+TEST(PropStatsUtilsTest, Empty) {
+  ValueStatsBuilder builder;
+  auto stats = builder.build();
+  EXPECT_EQ(0, stats.get_values());
+  EXPECT_EQ(0, PropStatsUtils::ndv(stats));
+  EXPECT_TRUE(stats.get_bucket_bounds().empty());
+  EXPECT_TRUE(stats.get_top_values().empty());
+}
+
+TEST(PropStatsUtilsTest, Unordered) {
+  ValueStatsBuilder builder;
+  for (int64_t i = 0; i < 1000; ++i) {
+    builder.addUnordered(Value(List({Value(i), Value(i + 1)})));
+  }
+  auto stats = builder.build();
+  EXPECT_EQ(1000, stats.get_values());
+  EXPECT_NEAR(1000, PropStatsUtils::ndv(stats), 1000 * 0.05);
+  EXPECT_TRUE(stats.get_bucket_bounds().empty());
+  EXPECT_TRUE(stats.get_top_values().empty());
+}
+
+TEST(PropStatsUtilsTest, Merge) {
+  // Two parts sharing half of the values
+  ValueStatsBuilder left;
+  ValueStatsBuilder right;
+  for (int64_t i = 0; i < 20000; ++i) {
+    left.add(folly::to<std::string>("v", i));
+    right.add(folly::to<std::string>("v", i + 10000));
+  }
+  auto stats = left.build();
+  PropStatsUtils::merge(stats, right.build());
+  EXPECT_EQ(40000, stats.get_values());
+  EXPECT_NEAR(30000, PropStatsUtils::ndv(stats), 30000 * 0.05);
+
+  const auto& bounds = stats.get_bucket_bounds();
+  ASSERT_EQ(bounds.size(), stats.get_bucket_values().size());
+  EXPECT_LE(bounds.size(), PropStatsUtils::kBuckets);
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+  EXPECT_EQ(40000, sum(stats.get_bucket_values()));
+  EXPECT_LE(stats.get_top_values().size(), PropStatsUtils::kTopValues);
+
+  meta::cpp2::StatsItem lhs;
+  meta::cpp2::StatsItem rhs;
+  meta::cpp2::PropStats prop;
+  prop.values_ref() = stats;
+  std::map<std::string, meta::cpp2::PropStats> props;
+  props.emplace("name", prop);
+  rhs.tag_props_ref() = std::unordered_map<std::string, decltype(props)>{{"player", props}};
+  PropStatsUtils::mergeProps(lhs, rhs);
+  PropStatsUtils::mergeProps(lhs, rhs);
+  ASSERT_TRUE(lhs.tag_props_ref().has_value());
+  const auto& merged = lhs.tag_props_ref()->at("player").at("name");
+  EXPECT_EQ(80000, merged.get_values().get_values());
+  // The same values merged twice are not counted as distinct
+  EXPECT_NEAR(30000, PropStatsUtils::ndv(merged.get_values()), 30000 * 0.05);
+  EXPECT_FALSE(lhs.edge_props_ref().has_value());
+}
+
+}  // namespace nebula
@@ -15,10 +15,12 @@
 #include "common/process/ProcessUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/time/TimezoneInfo.h"
+#include "common/tracing/OtlpExporter.h"
 #include "daemons/SetupLogging.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/GraphServer.h"
 #include "graph/service/GraphService.h"
+#include "graph/service/PlanStatsHandler.h"
 #include "graph/stats/GraphStats.h"
 #include "version/Version.h"
 #include "webservice/WebService.h"
@@ -119,8 +121,17 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  status = nebula::tracing::OtlpExporter::init("nebula-graphd");
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return EXIT_FAILURE;
+  }
+
   LOG(INFO) << "Starting Graph HTTP Service";
   auto webSvc = std::make_unique<nebula::WebService>();
+  webSvc->router().get("/plan_stats").handler([](nebula::web::PathParams &&) {
+    return new nebula::graph::PlanStatsHandler();
+  });
   status = webSvc->start();
   if (!status.ok()) {
     return EXIT_FAILURE;
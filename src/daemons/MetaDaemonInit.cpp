@@ -17,6 +17,7 @@
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/thread/GenericThreadPool.h"
+#include "common/thrift/ThreadManagerObserver.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "kvstore/KVStore.h"
 #include "kvstore/NebulaStore.h"
@@ -81,6 +82,7 @@ std::unique_ptr<nebula::kvstore::KVStore> initKV(std::vector<nebula::HostAddr> p
           numMetaWorkerThreads));
   threadManager->setNamePrefix("executor");
   threadManager->start();
+  nebula::watchThreadManager("executor", threadManager);
   nebula::kvstore::KVOptions options;
 #ifndef BUILD_STANDALONE
   auto absolute = boost::filesystem::absolute(FLAGS_data_path);
@@ -20,6 +20,7 @@
 #include "common/process/ProcessUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/time/TimezoneInfo.h"
+#include "common/tracing/OtlpExporter.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "daemons/SetupLogging.h"
 #include "folly/ScopeGuard.h"
@@ -169,6 +170,12 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  status = nebula::tracing::OtlpExporter::init("nebula-standalone");
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return EXIT_FAILURE;
+  }
+
   // Initialize the global timezone, it's only used for datetime type compute
   // won't affect the process timezone.
   status = nebula::time::Timezone::initializeGlobalTimezone();
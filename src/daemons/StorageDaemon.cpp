@@ -12,6 +12,7 @@
 #include "common/network/NetworkUtils.h"
 #include "common/process/ProcessUtils.h"
 #include "common/time/TimezoneInfo.h"
+#include "common/tracing/OtlpExporter.h"
 #include "daemons/SetupLogging.h"
 #include "storage/StorageServer.h"
 #include "storage/stats/StorageStats.h"
@@ -168,6 +169,12 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  status = nebula::tracing::OtlpExporter::init("nebula-storaged");
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return EXIT_FAILURE;
+  }
+
   // Initialize the global timezone, it's only used for datetime type compute
   // won't affect the process timezone.
   status = nebula::time::Timezone::initializeGlobalTimezone();
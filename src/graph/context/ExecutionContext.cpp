@@ -55,7 +55,12 @@ void ExecutionContext::truncHistory(const std::string& name, size_t numVersionsT
       return;
     }
     // Only keep the latest N values
-    it->second.erase(it->second.begin(), it->second.end() - numVersionsToKeep);
+    auto end = it->second.end() - numVersionsToKeep;
+    if (FLAGS_enable_async_gc) {
+      GC::instance().clear(std::vector<Result>(std::make_move_iterator(it->second.begin()),
+                                               std::make_move_iterator(end)));
+    }
+    it->second.erase(it->second.begin(), end);
   }
 }
 
@@ -119,5 +124,31 @@ const std::vector<Result>& ExecutionContext::getHistory(const std::string& name)
   }
 }
 
+ExecutionContext::Snapshot ExecutionContext::snapshot() const {
+  folly::RWSpinLock::ReadHolder holder(lock_);
+  Snapshot snapshot;
+  for (const auto& var : valueMap_) {
+    if (var.second.empty()) {
+      continue;
+    }
+    const auto& result = var.second.back();
+    snapshot.emplace(var.first, std::make_pair(result.value(), result.iterRef()->kind()));
+  }
+  return snapshot;
+}
+
+void ExecutionContext::restore(const Snapshot& snapshot) {
+  folly::RWSpinLock::WriteHolder holder(lock_);
+  for (auto& var : valueMap_) {
+    var.second.clear();
+  }
+  for (const auto& var : snapshot) {
+    // Copy the value, the executors may move it out of the result
+    ResultBuilder builder;
+    builder.value(Value(var.second.first)).iter(var.second.second);
+    valueMap_[var.first].emplace_back(builder.build());
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -74,6 +74,16 @@ class ExecutionContext {
     return valueMap_.find(name) != valueMap_.end();
   }
 
+  // The latest value of each variable with the kind of its iterator
+  using Snapshot = std::unordered_map<std::string, std::pair<Value, Iterator::Kind>>;
+
+  // Copy the values set before the plan runs, e.g. the parameters and the constants set by the
+  // validators, so the context could be restored to run the same plan again
+  Snapshot snapshot() const;
+
+  // Drop the results of all the variables but keep the variables, then set the values of snapshot
+  void restore(const Snapshot& snapshot);
+
  private:
   friend class QueryInstance;
   Value moveValue(const std::string& name);
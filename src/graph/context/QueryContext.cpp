@@ -5,6 +5,8 @@
 
 #include "graph/context/QueryContext.h"
 
+#include "graph/service/GraphFlags.h"
+
 namespace nebula {
 namespace graph {
 
@@ -40,6 +42,26 @@ void QueryContext::init() {
   idGen_ = std::make_unique<IdGenerator>(0);
   symTable_ = std::make_unique<SymbolTable>(objPool_.get(), ectx_.get());
   vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
+  resetStrDict();
+}
+
+void QueryContext::resetStrDict() {
+  if (FLAGS_query_string_dict_capacity == 0) {
+    strDict_.reset();
+    return;
+  }
+  strDict_ = std::make_unique<StringDictionary>(FLAGS_query_string_dict_capacity,
+                                                FLAGS_query_string_dict_max_length);
+}
+
+void QueryContext::reuse(RequestContextPtr rctx) {
+  rctx_ = std::move(rctx);
+  killed_.store(false);
+  sampledError_.store(0.0);
+  ep_->renewId();
+  symTable_->resetUserCount();
+  // The strings are interned per query
+  resetStrDict();
 }
 
 }  // namespace graph
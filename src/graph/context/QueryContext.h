@@ -6,12 +6,16 @@
 #ifndef GRAPH_CONTEXT_QUERYCONTEXT_H_
 #define GRAPH_CONTEXT_QUERYCONTEXT_H_
 
+#include <folly/Random.h>
+
 #include "clients/meta/MetaClient.h"
 #include "clients/storage/StorageClient.h"
 #include "common/base/ObjectPool.h"
 #include "common/charset/Charset.h"
 #include "common/cpp/helpers.h"
+#include "common/datatypes/StringDictionary.h"
 #include "common/datatypes/Value.h"
+#include "common/memory/MemoryTracker.h"
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
 #include "graph/context/ExecutionContext.h"
@@ -55,6 +59,10 @@ class QueryContext {
     rctx_ = std::move(rctx);
   }
 
+  // Prepare the context of a cached plan to run for a new request, the execution context
+  // should have been restored when the last run finished
+  void reuse(RequestContextPtr rctx);
+
   void setSchemaManager(meta::SchemaManager* sm) {
     sm_ = sm;
   }
@@ -123,6 +131,11 @@ class QueryContext {
     return symTable_.get();
   }
 
+  // The dictionary interning the strings of the results from storage, null if it's disabled
+  StringDictionary* strDict() const {
+    return strDict_.get();
+  }
+
   void setPartialSuccess() {
     DCHECK(rctx_ != nullptr);
     rctx_->resp().errorCode = ErrorCode::E_PARTIAL_SUCCEEDED;
@@ -132,8 +145,51 @@ class QueryContext {
     killed_.exchange(true);
   }
 
+  // Killed by the user, or cancelled by the memory tracker to release memory
   bool isKilled() const {
-    return killed_.load();
+    return killed_.load() || (memoryTracker_ != nullptr && memoryTracker_->cancelled());
+  }
+
+  // The memory tracker of the run of the query, set before the run starts
+  void setMemoryTracker(std::shared_ptr<memory::MemoryTrackerNode> memoryTracker) {
+    memoryTracker_ = std::move(memoryTracker);
+  }
+
+  const std::shared_ptr<memory::MemoryTrackerNode>& memoryTracker() const {
+    return memoryTracker_;
+  }
+
+  // Whether the functions called by the query are all pure, i.e. its result depends on the data
+  // only, which is told by the parser
+  bool deterministic() const {
+    return deterministic_;
+  }
+
+  void setNonDeterministic() {
+    deterministic_ = false;
+  }
+
+  // The ratio by which the query is sampled, 1 if it's answered exactly
+  double sampleRatio() const {
+    return rctx_ != nullptr ? rctx_->sampleRatio() : 1.0;
+  }
+
+  // Whether a source of the query is kept by its Bernoulli sampling
+  bool sampled() const {
+    auto ratio = sampleRatio();
+    return ratio >= 1.0 || folly::Random::randDouble01() < ratio;
+  }
+
+  // Record the relative standard error of a count scaled by the aggregates of the sampled rows
+  void addSampledError(double error) {
+    auto greatest = sampledError_.load();
+    while (error > greatest && !sampledError_.compare_exchange_weak(greatest, error)) {
+    }
+  }
+
+  // The greatest relative standard error of the counts scaled, 0 if there is none
+  double sampledError() const {
+    return sampledError_.load();
   }
 
   // This is only valid in building stage!
@@ -145,6 +201,8 @@ class QueryContext {
  private:
   void init();
 
+  void resetStrDict();
+
   RequestContextPtr rctx_;
   std::unique_ptr<ValidateContext> vctx_;
   std::unique_ptr<ExecutionContext> ectx_;
@@ -160,8 +218,12 @@ class QueryContext {
   std::unique_ptr<ObjectPool> objPool_;
   std::unique_ptr<IdGenerator> idGen_;
   std::unique_ptr<SymbolTable> symTable_;
+  std::unique_ptr<StringDictionary> strDict_;
 
   std::atomic<bool> killed_{false};
+  bool deterministic_{true};
+  std::atomic<double> sampledError_{0.0};
+  std::shared_ptr<memory::MemoryTrackerNode> memoryTracker_;
 };
 
 }  // namespace graph
@@ -15,13 +15,19 @@ const Value& QueryExpressionContext::getVar(const std::string& var) const {
 }
 
 void QueryExpressionContext::setInnerVar(const std::string& var, Value val) {
-  exprValueMap_[var] = std::move(val);
+  auto& innerVar = exprValueMap_[var];
+  innerVar.value = std::move(val);
+  innerVar.bound = nullptr;
+}
+
+void QueryExpressionContext::bindInnerVar(const std::string& var, const Value& val) {
+  exprValueMap_[var].bound = &val;
 }
 
 const Value& QueryExpressionContext::getInnerVar(const std::string& var) const {
   auto it = exprValueMap_.find(var);
   if (it == exprValueMap_.end()) return Value::kEmpty;
-  return it->second;
+  return it->second.bound != nullptr ? *it->second.bound : it->second.value;
 }
 
 const Value& QueryExpressionContext::getVersionedVar(const std::string& var,
@@ -31,6 +31,9 @@ class QueryExpressionContext final : public ExpressionContext {
   // Get the value of innerVar
   const Value& getInnerVar(const std::string& var) const override;
 
+  // Bind the innerVar to val without copying it, e.g. the elements iterated by ListComprehension
+  void bindInnerVar(const std::string& var, const Value& val) override;
+
   // Get the given version value for the given variable name, such as $a, $b
   const Value& getVersionedVar(const std::string& var, int64_t version) const override;
 
@@ -83,8 +86,14 @@ class QueryExpressionContext final : public ExpressionContext {
   ExecutionContext* ectx_{nullptr};
   Iterator* iter_{nullptr};
 
+  // The value of an innerVar, which is either owned or bound by reference
+  struct InnerVar {
+    Value value;
+    const Value* bound{nullptr};
+  };
+
   // Expression value map that stores the value of innerVar
-  std::unordered_map<std::string, Value> exprValueMap_;
+  std::unordered_map<std::string, InnerVar> exprValueMap_;
 };
 
 }  // namespace graph
@@ -50,6 +50,10 @@ struct Variable {
 
   // the count of use the variable
   std::atomic<uint64_t> userCount{0};
+
+  // Written in a loop and only the latest version is read, so the older versions are dropped as
+  // soon as a new one is set, see Scheduler::analyzeLifetime
+  bool latestOnly{false};
 };
 
 class SymbolTable final {
@@ -75,6 +79,9 @@ class SymbolTable final {
 
   Variable* getVar(const std::string& varName);
 
+  // Reset the user count of all variables, the lifetime is analyzed again when the plan is reused
+  void resetUserCount();
+
   std::string toString() const;
 
  private:
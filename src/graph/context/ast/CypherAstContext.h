@@ -113,6 +113,8 @@ struct Path final {
 
   enum PathType : int8_t { kDefault, kAllShortest, kSingleShortest };
   PathType pathType{PathType::kDefault};
+  // The edge property as the weight of shortestPath, empty if the path is not weighted
+  std::string weightProp;
 };
 
 struct CypherClauseContextBase : AstContext {
@@ -148,6 +148,18 @@ struct SubgraphContext final : public AstContext {
   bool getEdgeProp{false};
 };
 
+struct RandomWalkContext final : public AstContext {
+  Starts from;
+  StepClause steps;
+  Over over;
+  // walks started from each vertex
+  size_t walks{1};
+  // return and in-out parameters of node2vec
+  double p{1.0};
+  double q{1.0};
+  std::vector<std::string> colNames;
+};
+
 struct FetchVerticesContext final : public AstContext {
   Starts from;
   bool distinct{false};
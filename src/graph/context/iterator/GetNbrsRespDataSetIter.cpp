@@ -20,12 +20,30 @@ bool isDataSetInvalid(const DataSet* dataset) {
          colNames.back().find(kExprPrefix) != 0;  // the last column could  not be _expr column now
 }
 
-GetNbrsRespDataSetIter::GetNbrsRespDataSetIter(const DataSet* dataset)
+GetNbrsRespDataSetIter::GetNbrsRespDataSetIter(
+    const DataSet* dataset, const std::vector<storage::cpp2::NeighborEdges>* edges)
     : dataset_(DCHECK_NOTNULL(dataset)), curRowIdx_(0) {
   DCHECK(!isDataSetInvalid(dataset));
   for (size_t i = 0, e = dataset->colNames.size(); i < e; ++i) {
     buildPropIndex(dataset->colNames[i], i);
   }
+  if (edges == nullptr) {
+    return;
+  }
+  // The flat edges follow the order of the edge columns
+  std::vector<PropIndex*> edgeCols;
+  edgeCols.reserve(edgePropsMap_.size());
+  for (auto& entry : edgePropsMap_) {
+    edgeCols.emplace_back(&entry.second);
+  }
+  std::sort(edgeCols.begin(), edgeCols.end(), [](const PropIndex* a, const PropIndex* b) {
+    return a->colIdx < b->colIdx;
+  });
+  DCHECK_EQ(edgeCols.size(), edges->size());
+  for (size_t i = 0; i < std::min(edgeCols.size(), edges->size()); ++i) {
+    DCHECK_EQ((*edges)[i].get_offsets().size(), dataset->rowSize() + 1);
+    edgeCols[i]->flatEdges = &(*edges)[i];
+  }
 }
 
 void GetNbrsRespDataSetIter::buildPropIndex(const std::string& colName, size_t colIdx) {
@@ -39,7 +57,8 @@ void GetNbrsRespDataSetIter::buildPropIndex(const std::string& colName, size_t c
   PropIndex propIdx;
   propIdx.colIdx = colIdx;
 
-  propIdx.propIdxMap.reserve(pieces.size() - 2);
+  propIdx.propNames = std::make_shared<PropNames>();
+  propIdx.propIndices.reserve(pieces.size() - 2);
   // if size == 2, it is the tag defined without props.
   for (size_t i = 2; i < pieces.size(); ++i) {
     const auto& name = pieces[i];
@@ -55,7 +74,8 @@ void GetNbrsRespDataSetIter::buildPropIndex(const std::string& colName, size_t c
     } else if (name == kTag) {
       // Skip the _tag prop of vertex since it is not used to create vertex
     } else {
-      propIdx.propIdxMap.emplace(name, idx);
+      propIdx.propNames->add(name);
+      propIdx.propIndices.emplace_back(idx);
     }
   }
 
@@ -69,6 +89,35 @@ void GetNbrsRespDataSetIter::buildPropIndex(const std::string& colName, size_t c
   }
 }
 
+template <typename GetProp>
+PropMap GetNbrsRespDataSetIter::buildProps(const PropIndex& propIdx, GetProp&& getProp) {
+  std::vector<Value> values;
+  values.reserve(propIdx.propIndices.size());
+  for (auto pIdx : propIdx.propIndices) {
+    values.emplace_back(getProp(pIdx));
+  }
+  return PropMap(propIdx.propNames, std::move(values));
+}
+
+template <typename GetProp>
+Value GetNbrsRespDataSetIter::createEdge(const PropIndex& propIdx,
+                                         GetProp&& getProp,
+                                         const Value& src,
+                                         const std::string& edgeName) {
+  Edge edge;
+  edge.name = edgeName;
+  edge.src = src;
+  edge.dst = getProp(propIdx.edgeDstIdx);
+  const Value& typeVal = getProp(propIdx.edgeTypeIdx);
+  edge.type = typeVal.isInt() ? typeVal.getInt() : 0;
+  const Value& rankVal = getProp(propIdx.edgeRankIdx);
+  edge.ranking = rankVal.isInt() ? rankVal.getInt() : 0;
+
+  edge.props = buildProps(propIdx, getProp);
+
+  return edge;
+}
+
 Value GetNbrsRespDataSetIter::getVid() const {
   DCHECK(valid());
   const Row& curRow = dataset_->rows[curRowIdx_];
@@ -89,12 +138,10 @@ Value GetNbrsRespDataSetIter::getVertex() const {
       const List& propList = propColumn.getList();
 
       Tag tag(tagName);
-      tag.props.reserve(propIdx.propIdxMap.size());
-      for (const auto& [propName, pIdx] : propIdx.propIdxMap) {
-        DCHECK_LT(pIdx, propList.size());
-        tag.props.emplace(propName, propList[pIdx]);
-      }
-
+      tag.props = buildProps(propIdx, [&propList](size_t i) -> const Value& {
+        DCHECK_LT(i, propList.size());
+        return propList[i];
+      });
       vertex.tags.emplace_back(std::move(tag));
     }
   }
@@ -109,26 +156,20 @@ Value GetNbrsRespDataSetIter::createEdgeByPropList(const PropIndex& propIdx,
     return Value::kEmpty;
   }
   const List& propList = edgeVal.getList();
-  DCHECK_LT(propIdx.edgeDstIdx, propList.size());
-  DCHECK_LT(propIdx.edgeTypeIdx, propList.size());
-  DCHECK_LT(propIdx.edgeRankIdx, propList.size());
-
-  Edge edge;
-  edge.name = edgeName;
-  edge.src = src;
-  edge.dst = propList[propIdx.edgeDstIdx];
-  const Value& typeVal = propList[propIdx.edgeTypeIdx];
-  edge.type = typeVal.isInt() ? typeVal.getInt() : 0;
-  const Value& rankVal = propList[propIdx.edgeRankIdx];
-  edge.ranking = rankVal.isInt() ? rankVal.getInt() : 0;
-
-  edge.props.reserve(propIdx.propIdxMap.size());
-  for (const auto& [propName, pIdx] : propIdx.propIdxMap) {
-    DCHECK_LT(pIdx, propList.size());
-    edge.props.emplace(propName, propList[pIdx]);
-  }
+  return createEdge(
+      propIdx,
+      [&propList](size_t i) -> const Value& {
+        DCHECK_LT(i, propList.size());
+        return propList[i];
+      },
+      src,
+      edgeName);
+}
 
-  return edge;
+std::pair<size_t, size_t> GetNbrsRespDataSetIter::flatEdgeRange(const PropIndex& propIdx) const {
+  const auto& offsets = propIdx.flatEdges->get_offsets();
+  DCHECK_LT(curRowIdx_ + 1, offsets.size());
+  return {offsets[curRowIdx_], offsets[curRowIdx_ + 1]};
 }
 
 std::vector<Value> GetNbrsRespDataSetIter::getAdjEdges(VidHashSet* dstSet) const {
@@ -137,6 +178,30 @@ std::vector<Value> GetNbrsRespDataSetIter::getAdjEdges(VidHashSet* dstSet) const
   std::vector<Value> adjEdges;
   const Row& curRow = dataset_->rows[curRowIdx_];
   for (const auto& [edgeName, propIdx] : edgePropsMap_) {
+    if (propIdx.flatEdges != nullptr) {
+      auto [begin, end] = flatEdgeRange(propIdx);
+      const auto& props = propIdx.flatEdges->get_props();
+      if (props.empty()) {
+        continue;
+      }
+      // skip the edge direction symbol: `-/+`
+      auto name = edgeName.substr(1);
+      for (size_t i = begin; i < end; ++i) {
+        Value edge = createEdge(
+            propIdx,
+            [&props, i](size_t p) -> const Value& {
+              DCHECK_LT(p, props.size());
+              return props[p][i];
+            },
+            curRow[0],
+            name);
+        if (dstSet) {
+          dstSet->emplace(edge.getEdge().dst);
+        }
+        adjEdges.emplace_back(std::move(edge));
+      }
+      continue;
+    }
     DCHECK_LT(propIdx.colIdx, curRow.size());
     const Value& edgeColumn = curRow[propIdx.colIdx];
     if (edgeColumn.isList()) {
@@ -162,6 +227,16 @@ std::unordered_set<Value> GetNbrsRespDataSetIter::getAdjDsts() const {
   std::unordered_set<Value> adjDsts;
   const Row& curRow = dataset_->rows[curRowIdx_];
   for (const auto& [edgeName, propIdx] : edgePropsMap_) {
+    if (propIdx.flatEdges != nullptr) {
+      auto [begin, end] = flatEdgeRange(propIdx);
+      const auto& props = propIdx.flatEdges->get_props();
+      if (begin < end) {
+        DCHECK_LT(propIdx.edgeDstIdx, props.size());
+        const auto& dsts = props[propIdx.edgeDstIdx];
+        adjDsts.insert(dsts.begin() + begin, dsts.begin() + end);
+      }
+      continue;
+    }
     DCHECK_LT(propIdx.colIdx, curRow.size());
     const Value& edgeColumn = curRow[propIdx.colIdx];
     if (edgeColumn.isList()) {
@@ -186,6 +261,11 @@ size_t GetNbrsRespDataSetIter::size() {
   for (; valid(); next()) {
     const Row& curRow = dataset_->rows[curRowIdx_];
     for (const auto& [edgeName, propIdx] : edgePropsMap_) {
+      if (propIdx.flatEdges != nullptr) {
+        auto [begin, end] = flatEdgeRange(propIdx);
+        size += end - begin;
+        continue;
+      }
       DCHECK_LT(propIdx.colIdx, curRow.size());
       const Value& edgeColumn = curRow[propIdx.colIdx];
       if (edgeColumn.isList()) {
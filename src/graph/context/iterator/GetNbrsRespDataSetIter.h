@@ -7,14 +7,19 @@
 #define GRAPH_CONTEXT_ITERATOR_GETNBRSRESPDATASETITER_H_
 
 #include "common/datatypes/DataSet.h"
+#include "common/datatypes/PropMap.h"
 #include "common/datatypes/Value.h"
+#include "interface/gen-cpp2/storage_types.h"
 
 namespace nebula {
 namespace graph {
 
 class GetNbrsRespDataSetIter final {
  public:
-  explicit GetNbrsRespDataSetIter(const DataSet* dataset);
+  // The edges are in the edge columns of the dataset, or in the flat edges, one per edge column,
+  // if they're given
+  explicit GetNbrsRespDataSetIter(const DataSet* dataset,
+                                  const std::vector<storage::cpp2::NeighborEdges>* edges = nullptr);
 
   bool valid() const {
     return curRowIdx_ < dataset_->rowSize();
@@ -39,15 +44,32 @@ class GetNbrsRespDataSetIter final {
     size_t edgeTypeIdx;
     size_t edgeRankIdx;
     size_t edgeDstIdx;
-    std::unordered_map<std::string, size_t> propIdxMap;
+    // The names of the props shared by the tags or the edges built, and their indices in the list
+    std::shared_ptr<PropNames> propNames;
+    std::vector<size_t> propIndices;
+    // The edges of the edge column in columns
+    const storage::cpp2::NeighborEdges* flatEdges{nullptr};
   };
 
+  // The prop of index i is got by getProp(i)
+  template <typename GetProp>
+  static PropMap buildProps(const PropIndex& propIdx, GetProp&& getProp);
+
+  template <typename GetProp>
+  static Value createEdge(const PropIndex& propIdx,
+                          GetProp&& getProp,
+                          const Value& src,
+                          const std::string& edgeName);
+
   void buildPropIndex(const std::string& colName, size_t colIdx);
   Value createEdgeByPropList(const PropIndex& propIdx,
                              const Value& edgeVal,
                              const Value& src,
                              const std::string& edgeName) const;
 
+  // The range of the flat edges of the current row
+  std::pair<size_t, size_t> flatEdgeRange(const PropIndex& propIdx) const;
+
   const DataSet* dataset_;
   size_t curRowIdx_;
 
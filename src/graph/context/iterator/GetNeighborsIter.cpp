@@ -164,6 +164,17 @@ Status GetNeighborsIter::buildPropIndex(const std::string& props,
   propIdx.colIdx = columnId;
   propIdx.propList.resize(pieces.size() - 2);
   std::move(pieces.begin() + 2, pieces.end(), propIdx.propList.begin());
+  propIdx.propNames = std::make_shared<PropNames>();
+  for (size_t i = 0; i < propIdx.propList.size(); ++i) {
+    const auto& propName = propIdx.propList[i];
+    bool reserved = isEdge ? (propName == kDst || propName == kRank || propName == kType ||
+                              propName == kSrc)
+                           : propName == nebula::kTag;
+    if (!reserved) {
+      propIdx.propNames->add(propName);
+      propIdx.propNameIndices.emplace_back(i);
+    }
+  }
   std::string name = pieces[1];
   if (isEdge) {
     // The first character of the edge name is +/-.
@@ -180,6 +191,16 @@ Status GetNeighborsIter::buildPropIndex(const std::string& props,
   return Status::OK();
 }
 
+// The props of the names shared, copying the values only
+PropMap GetNeighborsIter::buildProps(const PropIndex& propIdx, const std::vector<Value>& values) {
+  std::vector<Value> props;
+  props.reserve(propIdx.propNameIndices.size());
+  for (auto i : propIdx.propNameIndices) {
+    props.emplace_back(i < values.size() ? values[i] : Value::kEmpty);
+  }
+  return PropMap(propIdx.propNames, std::move(props));
+}
+
 bool GetNeighborsIter::valid() const {
   return Iterator::valid() && valid_ && currentDs_ < dsIndices_.end() &&
          currentRow_ < rowsUpperBound_ && colIdx_ < currentDs_->colUpperBound;
@@ -289,20 +310,19 @@ void GetNeighborsIter::erase() {
 }
 
 void GetNeighborsIter::sample(const int64_t count) {
-  algorithm::ReservoirSampling<std::tuple<List*, List>> sampler_(count);
+  algorithm::ReservoirSampling<std::tuple<const List*, List>> sampler_(count);
   doReset(0);
   for (; valid(); next()) {
     // <current List of Edge, value of Edge>
-    std::tuple<List*, List> t =
-        std::make_tuple(const_cast<List*>(currentCol_), std::move(*currentEdge_));
+    std::tuple<const List*, List> t = std::make_tuple(currentCol_, *currentEdge_);
     sampler_.sampling(std::move(t));
   }
-  doReset(0);
-  clearEdges();
+  auto cols = clearEdges();
   auto samples = std::move(sampler_).samples();
   for (auto& sample : samples) {
-    auto* col = std::get<0>(sample);
-    col->emplace_back(std::move(std::get<1>(sample)));
+    auto found = cols.find(std::get<0>(sample));
+    DCHECK(found != cols.end());
+    found->second->mutableList().emplace_back(std::move(std::get<1>(sample)));
   }
   doReset(0);
 }
@@ -366,17 +386,12 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag, const std::str
     }
     return Value::kEmpty;
   } else {
-    auto& tagPropIndices = currentDs_->tagPropsMap;
-    auto index = tagPropIndices.find(tag);
-    if (index == tagPropIndices.end()) {
-      return Value::kEmpty;
-    }
-    auto propIndexIter = index->second.propIndices.find(prop);
-    if (propIndexIter == index->second.propIndices.end()) {
+    auto resolved = resolveTagProp(tag, prop);
+    if (resolved.first < 0) {
       return Value::kEmpty;
     }
-    colId = index->second.colIdx;
-    propId = propIndexIter->second;
+    colId = resolved.first;
+    propId = resolved.second;
     DCHECK_GT(row.size(), colId);
     if (row[colId].empty()) {
       return Value::kEmpty;
@@ -398,22 +413,70 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge, const std::s
     return Value::kEmpty;
   }
 
+  auto propIdx = resolveEdgeProp(edge, prop);
+  if (propIdx < 0) {
+    return Value::kEmpty;
+  }
+  return currentEdge_->values[propIdx];
+}
+
+std::pair<int64_t, int64_t> GetNeighborsIter::resolveTagProp(const std::string& tag,
+                                                             const std::string& prop) const {
+  auto& resolvedProps = currentDs_->resolvedTagProps;
+  for (const auto& resolved : resolvedProps) {
+    if (resolved.name == &tag && resolved.prop == &prop && resolved.nameCopy == tag &&
+        resolved.propCopy == prop) {
+      return {resolved.colIdx, resolved.propIdx};
+    }
+  }
+
+  int64_t colIdx = -1;
+  int64_t propIdx = -1;
+  auto& tagPropIndices = currentDs_->tagPropsMap;
+  auto index = tagPropIndices.find(tag);
+  if (index != tagPropIndices.end()) {
+    auto propIndexIter = index->second.propIndices.find(prop);
+    if (propIndexIter != index->second.propIndices.end()) {
+      colIdx = index->second.colIdx;
+      propIdx = propIndexIter->second;
+    }
+  }
+  if (resolvedProps.size() < kMaxResolvedProps) {
+    resolvedProps.emplace_back(ResolvedProp{&tag, &prop, tag, prop, colIdx, propIdx});
+  }
+  return {colIdx, propIdx};
+}
+
+int64_t GetNeighborsIter::resolveEdgeProp(const std::string& edge, const std::string& prop) const {
+  auto& resolvedProps = currentDs_->resolvedEdgeProps;
+  for (const auto& resolved : resolvedProps) {
+    if (resolved.colIdx == colIdx_ && resolved.name == &edge && resolved.prop == &prop &&
+        resolved.nameCopy == edge && resolved.propCopy == prop) {
+      return resolved.propIdx;
+    }
+  }
+
+  int64_t propIdx = -1;
   auto& currentEdge = currentEdgeName();
   if (edge != "*" && (currentEdge.compare(1, std::string::npos, edge) != 0)) {
     DLOG(INFO) << "Current edge: " << currentEdgeName() << " Wanted: " << edge;
-    return Value::kEmpty;
-  }
-  auto index = currentDs_->edgePropsMap.find(currentEdge);
-  if (index == currentDs_->edgePropsMap.end()) {
-    DLOG(INFO) << "No edge found: " << edge << " Current edge: " << currentEdge;
-    return Value::kEmpty;
+  } else {
+    auto index = currentDs_->edgePropsMap.find(currentEdge);
+    if (index == currentDs_->edgePropsMap.end()) {
+      DLOG(INFO) << "No edge found: " << edge << " Current edge: " << currentEdge;
+    } else {
+      auto propIndex = index->second.propIndices.find(prop);
+      if (propIndex == index->second.propIndices.end()) {
+        VLOG(1) << "No edge prop found: " << prop;
+      } else {
+        propIdx = propIndex->second;
+      }
+    }
   }
-  auto propIndex = index->second.propIndices.find(prop);
-  if (propIndex == index->second.propIndices.end()) {
-    VLOG(1) << "No edge prop found: " << prop;
-    return Value::kEmpty;
+  if (resolvedProps.size() < kMaxResolvedProps) {
+    resolvedProps.emplace_back(ResolvedProp{&edge, &prop, edge, prop, colIdx_, propIdx});
   }
-  return currentEdge_->values[propIndex->second];
+  return propIdx;
 }
 
 Value GetNeighborsIter::getVertex(const std::string& name) {
@@ -442,11 +505,7 @@ Value GetNeighborsIter::getVertex(const std::string& name) {
     DCHECK_EQ(tagPropNameList.size(), propList.values.size());
     Tag tag;
     tag.name = tagProp.first;
-    for (size_t i = 0; i < propList.size(); ++i) {
-      if (tagPropNameList[i] != nebula::kTag) {
-        tag.props.emplace(tagPropNameList[i], propList[i]);
-      }
-    }
+    tag.props = buildProps(tagProp.second, propList.values);
     vertex.tags.emplace_back(std::move(tag));
   }
   prevVertex_ = Value(std::move(vertex));
@@ -529,16 +588,9 @@ Value GetNeighborsIter::getEdge() const {
   if (edgeProp == edgePropMap.end()) {
     return Value::kNullValue;
   }
-  auto& edgeNamePropList = edgeProp->second.propList;
   auto& propList = currentEdge_->values;
-  DCHECK_EQ(edgeNamePropList.size(), propList.size());
-  for (size_t i = 0; i < propList.size(); ++i) {
-    auto propName = edgeNamePropList[i];
-    if (propName == kDst || propName == kRank || propName == kType || propName == kSrc) {
-      continue;
-    }
-    edge.props.emplace(edgeNamePropList[i], propList[i]);
-  }
+  DCHECK_EQ(edgeProp->second.propList.size(), propList.size());
+  edge.props = buildProps(edgeProp->second, propList);
   return Value(std::move(edge));
 }
 
@@ -556,49 +608,36 @@ List GetNeighborsIter::getEdges() {
   return edges;
 }
 
-void GetNeighborsIter::nextCol() {
-  if (!valid()) {
-    return;
-  }
-  DCHECK(!noEdge_);
-
-  // go to next column
-  while (++colIdx_) {
-    if (colIdx_ < currentDs_->colUpperBound) {
-      const auto& currentCol = currentRow_->operator[](colIdx_);
-      if (!currentCol.isList() || currentCol.getList().empty()) {
-        continue;
-      }
-
-      currentCol_ = &currentCol.getList();
-      // edgeIdxUpperBound_ = currentCol_->size();
-      // edgeIdx_ = -1;
-      break;
-    }
-    // go to next row
-    if (++currentRow_ < rowsUpperBound_) {
-      colIdx_ = currentDs_->colLowerBound;
+std::unordered_map<const List*, Value*> GetNeighborsIter::clearEdges() {
+  std::unordered_map<const List*, Value*> cols;
+  if (noEdge_) {
+    return cols;
+  }
+  // Copied if the data sets are shared with another value. The columns of the copy still share
+  // their lists, and the lists are copied on write as well, so the value shared is kept
+  auto dsIndex = dsIndices_.begin();
+  for (auto& val : value_->mutableList().values) {
+    auto& ds = val.mutableDataSet();
+    if (ds.rowSize() == 0) {
       continue;
     }
-
-    // go to next dataset
-    if (++currentDs_ < dsIndices_.end()) {
-      colIdx_ = currentDs_->colLowerBound;
-      currentRow_ = currentDs_->ds->begin();
-      rowsUpperBound_ = currentDs_->ds->end();
-      continue;
+    DCHECK(dsIndex != dsIndices_.end());
+    dsIndex->ds = &ds;
+    for (auto& row : ds.rows) {
+      for (auto i = dsIndex->colLowerBound + 1; i < dsIndex->colUpperBound; ++i) {
+        auto& col = row.values[i];
+        if (!col.isList() || col.getList().empty()) {
+          continue;
+        }
+        cols.emplace(&col.getList(), &col);
+        col.mutableList().clear();
+      }
     }
-    break;
-  }
-  if (currentDs_ == dsIndices_.end()) {
-    return;
-  }
-}
-
-void GetNeighborsIter::clearEdges() {
-  for (; colValid(); nextCol()) {
-    const_cast<List*>(currentCol_)->clear();
+    ++dsIndex;
   }
+  // The positions are in the data sets before they're copied
+  doReset(0);
+  return cols;
 }
 
 }  // namespace graph
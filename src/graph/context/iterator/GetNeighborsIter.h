@@ -10,6 +10,7 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "common/datatypes/PropMap.h"
 #include "graph/context/iterator/Iterator.h"
 
 namespace nebula {
@@ -119,21 +120,36 @@ class GetNeighborsIter final : public Iterator {
     return currentDs_->tagEdgeNameIndices.find(colIdx_)->second;
   }
 
-  bool colValid() {
-    return !noEdge_ && valid();
-  }
-
-  // move to next List of Edge data
-  void nextCol();
-
-  void clearEdges();
+  // Clear the lists of the edges, the lists read before are mapped to the columns of them
+  std::unordered_map<const List*, Value*> clearEdges();
 
   struct PropIndex {
     size_t colIdx;
     std::vector<std::string> propList;
     std::unordered_map<std::string, size_t> propIndices;
+    // The names of the props of the tags or the edges got, without the reserved ones, shared by
+    // all of them, and their indices in propList
+    std::shared_ptr<PropNames> propNames;
+    std::vector<size_t> propNameIndices;
+  };
+
+  // The position of a prop in a DataSet, resolved once for the names held by an expression. It's
+  // looked up by the addresses of the names, and the names are compared as well to tell apart the
+  // temporaries at the same addresses, which is still cheaper than hashing them for each row.
+  struct ResolvedProp {
+    const std::string* name;
+    const std::string* prop;
+    std::string nameCopy;
+    std::string propCopy;
+    // The column of the tag, or of the edge for the edge props
+    int64_t colIdx;
+    // The index in the props of the column, -1 if not found
+    int64_t propIdx;
   };
 
+  // More names are not cached, e.g. the temporaries of getEdge
+  static constexpr size_t kMaxResolvedProps = 64;
+
   struct DataSetIndex {
     const DataSet* ds;
     // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
@@ -146,6 +162,9 @@ class GetNeighborsIter final : public Iterator {
     std::unordered_map<std::string, PropIndex> tagPropsMap;
     // _edge:e1:p1:p2  ->  {e1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
     std::unordered_map<std::string, PropIndex> edgePropsMap;
+    // The props resolved by resolveTagProp and resolveEdgeProp
+    mutable std::vector<ResolvedProp> resolvedTagProps;
+    mutable std::vector<ResolvedProp> resolvedEdgeProps;
 
     int64_t colLowerBound{-1};
     int64_t colUpperBound{-1};
@@ -162,6 +181,14 @@ class GetNeighborsIter final : public Iterator {
                         bool isEdge,
                         DataSetIndex* dsIndex);
 
+  static PropMap buildProps(const PropIndex& propIdx, const std::vector<Value>& values);
+
+  // The column and the index of the prop of the tag in the current DataSet, -1 if not found
+  std::pair<int64_t, int64_t> resolveTagProp(const std::string& tag, const std::string& prop) const;
+
+  // The index of the prop in the current edge if it's the edge, -1 if not
+  int64_t resolveEdgeProp(const std::string& edge, const std::string& prop) const;
+
   StatusOr<DataSetIndex> makeDataSetIndex(const DataSet& ds);
 
   FRIEND_TEST(IteratorTest, TestHead);
@@ -58,9 +58,26 @@ Status PropIter::buildPropIndex(const std::string& props, size_t columnId) {
     propIndices.emplace(pieces[1], columnId);
     propsMap.emplace(name, std::move(propIndices));
   }
+  const auto& prop = pieces[1];
+  if (prop != nebula::kTag) {
+    dsIndex_.tagProps[name].add(prop, columnId);
+  }
+  if (prop != kSrc && prop != kDst && prop != kType && prop != kRank) {
+    dsIndex_.edgeProps[name].add(prop, columnId);
+  }
   return Status::OK();
 }
 
+PropMap PropIter::SharedProps::build(const Row& row) const {
+  std::vector<Value> values;
+  values.reserve(columns.size());
+  for (auto column : columns) {
+    DCHECK_LT(column, row.size());
+    values.emplace_back(row[column]);
+  }
+  return PropMap(names, std::move(values));
+}
+
 const Value& PropIter::getColumn(const std::string& col) const {
   if (!valid()) {
     return Value::kNullValue;
@@ -149,10 +166,9 @@ Value PropIter::getVertex(const std::string& name) {
     }
     Tag tag;
     tag.name = tagProp.first;
-    for (auto& propIndex : tagProp.second) {
-      if (propIndex.first != nebula::kTag) {  // "_tag"
-        tag.props.emplace(propIndex.first, row[propIndex.second]);
-      }
+    auto props = dsIndex_.tagProps.find(tagProp.first);
+    if (props != dsIndex_.tagProps.end()) {
+      tag.props = props->second.build(row);
     }
     vertex.tags.emplace_back(std::move(tag));
   }
@@ -206,13 +222,9 @@ Value PropIter::getEdge() const {
     }
     edge.ranking = rank.getInt();
 
-    for (auto& propIndex : edgeProp.second) {
-      if (propIndex.first == kSrc || propIndex.first == kDst || propIndex.first == kType ||
-          propIndex.first == kRank) {
-        continue;
-      }
-      DCHECK_LT(propIndex.second, row.size());
-      edge.props.emplace(propIndex.first, row[propIndex.second]);
+    auto props = dsIndex_.edgeProps.find(edgeName);
+    if (props != dsIndex_.edgeProps.end()) {
+      edge.props = props->second.build(row);
     }
     return Value(std::move(edge));
   }
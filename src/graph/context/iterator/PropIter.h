@@ -6,6 +6,7 @@
 #ifndef GRAPH_CONTEXT_ITERATOR_PROPITER_H_
 #define GRAPH_CONTEXT_ITERATOR_PROPITER_H_
 
+#include "common/datatypes/PropMap.h"
 #include "graph/context/iterator/SequentialIter.h"
 
 namespace nebula {
@@ -55,6 +56,22 @@ class PropIter final : public SequentialIter {
 
   Status buildPropIndex(const std::string& props, size_t columnIdx);
 
+  // The names of the props shared by the tags or the edges built, and their columns
+  struct SharedProps {
+    std::shared_ptr<PropNames> names{std::make_shared<PropNames>()};
+    std::vector<size_t> columns;
+
+    void add(const std::string& name, size_t column) {
+      if (names->indexOf(name) < names->size()) {
+        return;
+      }
+      names->add(name);
+      columns.emplace_back(column);
+    }
+
+    PropMap build(const Row& row) const;
+  };
+
   struct DataSetIndex {
     const DataSet* ds;
     // vertex | _vid | tag1.prop1 | tag1.prop2 | tag2,prop1 | tag2,prop2 | ...
@@ -66,6 +83,9 @@ class PropIter final : public SequentialIter {
     // {tag1 : {prop1 : 1, prop2 : 2}
     // {edge1 : {prop1 : 4, prop2 : 5}
     std::unordered_map<std::string, std::unordered_map<std::string, size_t>> propsMap;
+    // The props of the tags without _tag, and of the edges without _src, _type, _rank and _dst
+    std::unordered_map<std::string, SharedProps> tagProps;
+    std::unordered_map<std::string, SharedProps> edgeProps;
   };
 
  private:
@@ -126,6 +126,28 @@ StatusOr<std::size_t> SequentialIter::getColumnIndex(const std::string& col) con
   return index->second;
 }
 
+ColumnBatch SequentialIter::columnBatch(const std::vector<size_t>& cols) const {
+  return columnBatch(cols, 0, rows_->size());
+}
+
+ColumnBatch SequentialIter::columnBatch(const std::vector<size_t>& cols,
+                                        size_t begin,
+                                        size_t end) const {
+  std::vector<std::string> colNames(colIndices_.size());
+  for (auto& kv : colIndices_) {
+    colNames[kv.second] = kv.first;
+  }
+  return ColumnBatch::fromRows(colNames, *rows_, begin, std::min(end, rows_->size()), cols);
+}
+
+ColumnBatch SequentialIter::columnBatch() const {
+  std::vector<size_t> cols(colIndices_.size());
+  for (size_t i = 0; i < cols.size(); ++i) {
+    cols[i] = i;
+  }
+  return columnBatch(cols);
+}
+
 const Value& SequentialIter::getTagProp(const std::string& tag, const std::string& prop) const {
   const auto& val = this->getColumn("VERTEX");
   if (val.isVertex()) {
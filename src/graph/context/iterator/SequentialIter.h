@@ -6,6 +6,7 @@
 #ifndef GRAPH_CONTEXT_ITERATOR_SEQUENTIALITER_H_
 #define GRAPH_CONTEXT_ITERATOR_SEQUENTIALITER_H_
 
+#include "common/datatypes/ColumnBatch.h"
 #include "graph/context/iterator/Iterator.h"
 
 namespace nebula {
@@ -68,6 +69,15 @@ class SequentialIter : public Iterator {
     return colIndices_;
   }
 
+  // The columnar form of the columns of cols in all the rows, regardless of the current position
+  ColumnBatch columnBatch(const std::vector<size_t>& cols) const;
+
+  // The columnar form of the columns of cols in the rows [begin, end)
+  ColumnBatch columnBatch(const std::vector<size_t>& cols, size_t begin, size_t end) const;
+
+  // The columnar form of all the columns
+  ColumnBatch columnBatch() const;
+
   size_t size() const override {
     return rows_->size();
   }
@@ -79,6 +79,30 @@ TEST(IteratorTest, Sequential) {
   }
 }
 
+TEST(IteratorTest, SequentialColumnBatch) {
+  DataSet ds;
+  ds.colNames = {"col1", "col2"};
+  for (auto i = 0; i < 10; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    row.values.emplace_back(folly::to<std::string>(i));
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto val = std::make_shared<Value>(ds);
+  SequentialIter iter(val);
+  iter.next();
+  auto batch = iter.columnBatch();
+  EXPECT_EQ(10, batch.rowSize());
+  EXPECT_EQ(Column::Kind::kInt, batch.column(0).kind());
+  EXPECT_EQ(Column::Kind::kString, batch.column(1).kind());
+  EXPECT_EQ(ds, batch.toDataSet());
+
+  iter.erase();
+  auto col2 = iter.columnBatch({1});
+  EXPECT_EQ(std::vector<std::string>{"col2"}, col2.colNames());
+  EXPECT_EQ(9, col2.rowSize());
+  EXPECT_EQ("2", col2.column(0).strs()[1]);
+}
 TEST(IteratorTest, GetNeighborNoEdge) {
   DataSet ds1;
   ds1.colNames = {kVid, "_stats", "_tag:tag1:prop1:prop2", "_expr"};
@@ -299,6 +323,33 @@ TEST(IteratorTest, GetNeighbor) {
     EXPECT_EQ(result.size(), 40);
     EXPECT_EQ(expected, result);
   }
+  // The props resolved are not mistaken for the other names at the same addresses
+  {
+    GetNeighborsIter iter(val);
+    std::string name;
+    std::string prop;
+    std::vector<Value> expected;
+    for (auto i = 0; i < 20; ++i) {
+      expected.insert(expected.end(), {0, 1, 0, 1});
+    }
+    for (auto i = 0; i < 20; ++i) {
+      expected.insert(expected.end(), {Value(), Value(), Value(), Value()});
+    }
+    std::vector<Value> result;
+    for (; iter.valid(); iter.next()) {
+      name = "tag1";
+      prop = "prop1";
+      result.emplace_back(iter.getTagProp(name, prop));
+      prop = "prop2";
+      result.emplace_back(iter.getTagProp(name, prop));
+      name = "edge1";
+      prop = "prop1";
+      result.emplace_back(iter.getEdgeProp(name, prop));
+      prop = "prop2";
+      result.emplace_back(iter.getEdgeProp(name, prop));
+    }
+    EXPECT_EQ(expected, result);
+  }
   // erase
   {
     GetNeighborsIter iter(val);
@@ -836,6 +887,49 @@ TEST(IteratorTest, EraseBySwap) {
   }
   EXPECT_EQ(result, expected);
 }
+
+TEST(IteratorTest, GetNeighborSampleCopyOnWrite) {
+  DataSet ds;
+  ds.colNames = {kVid, "_stats", "_edge:+edge1:prop1:_dst:_type:_rank", "_expr"};
+  for (auto i = 0; i < 3; ++i) {
+    Row row;
+    row.values.emplace_back(folly::to<std::string>(i));
+    row.values.emplace_back(Value());
+    List edges;
+    for (auto j = 0; j < 2; ++j) {
+      edges.values.emplace_back(List({j, folly::to<std::string>(j), 1, 0}));
+    }
+    row.values.emplace_back(std::move(edges));
+    row.values.emplace_back(Value());
+    ds.rows.emplace_back(std::move(row));
+  }
+  List datasets;
+  datasets.values.emplace_back(std::move(ds));
+  const Value expected(datasets);
+
+  {
+    // The copies share the lists of the result sampled
+    auto val = std::make_shared<Value>(expected);
+    Value copy = *val;
+    Value edges = val->getList()[0].getDataSet().rows[0][2];
+    GetNeighborsIter iter(val);
+    EXPECT_EQ(6, iter.size());
+    iter.sample(4);
+    EXPECT_EQ(4, iter.size());
+    EXPECT_EQ(expected, copy);
+    EXPECT_EQ(expected.getList()[0].getDataSet().rows[0][2], edges);
+  }
+  {
+    // All the edges are cleared
+    auto val = std::make_shared<Value>(expected);
+    Value copy = *val;
+    GetNeighborsIter iter(val);
+    iter.sample(0);
+    EXPECT_EQ(0, iter.size());
+    EXPECT_EQ(expected, copy);
+    EXPECT_NE(expected, *val);
+  }
+}
 }  // namespace graph
 }  // namespace nebula
 
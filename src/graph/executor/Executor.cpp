@@ -9,8 +9,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <limits>
 
 #include "common/base/ObjectPool.h"
+#include "common/expression/ConstantExpression.h"
 #include "common/memory/MemoryUtils.h"
 #include "common/stats/StatsManager.h"
 #include "graph/context/ExecutionContext.h"
@@ -49,6 +51,7 @@
 #include "graph/executor/algo/BFSShortestPathExecutor.h"
 #include "graph/executor/algo/CartesianProductExecutor.h"
 #include "graph/executor/algo/MultiShortestPathExecutor.h"
+#include "graph/executor/algo/RandomWalkExecutor.h"
 #include "graph/executor/algo/ShortestPathExecutor.h"
 #include "graph/executor/algo/SubgraphExecutor.h"
 #include "graph/executor/logic/ArgumentExecutor.h"
@@ -458,6 +461,9 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
     case PlanNode::Kind::kShowParts: {
       return pool->makeAndAdd<ShowPartsExecutor>(node, qctx);
     }
+    case PlanNode::Kind::kShowHotParts: {
+      return pool->makeAndAdd<ShowHotPartsExecutor>(node, qctx);
+    }
     case PlanNode::Kind::kShowCharset: {
       return pool->makeAndAdd<ShowCharsetExecutor>(node, qctx);
     }
@@ -479,6 +485,9 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
     case PlanNode::Kind::kSubgraph: {
       return pool->makeAndAdd<SubgraphExecutor>(node, qctx);
     }
+    case PlanNode::Kind::kRandomWalk: {
+      return pool->makeAndAdd<RandomWalkExecutor>(node, qctx);
+    }
     case PlanNode::Kind::kAddHosts: {
       return pool->makeAndAdd<AddHostsExecutor>(node, qctx);
     }
@@ -598,6 +607,11 @@ Executor::Executor(const std::string &name, const PlanNode *node, QueryContext *
 Executor::~Executor() {}
 
 Status Executor::open() {
+  const auto &queryMemory = qctx_->memoryTracker();
+  if (queryMemory != nullptr && queryMemory->cancelled()) {
+    // Cancelled to release the memory for the other queries
+    return memoryExceededStatus();
+  }
   if (qctx_->isKilled()) {
     VLOG(1) << "Execution is being killed. session: " << qctx()->rctx()->session()->id()
             << "ep: " << qctx()->plan()->id() << "query: " << qctx()->rctx()->query();
@@ -609,6 +623,7 @@ Status Executor::open() {
   numRows_ = 0;
   execTime_ = 0;
   totalDuration_.reset();
+  memoryTracker_ = std::make_shared<memory::MemoryTrackerNode>(queryMemory);
   return Status::OK();
 }
 
@@ -619,6 +634,12 @@ Status Executor::close() {
   stats.totalDurationInUs = totalDuration_.elapsedInUSec();
   stats.rows = numRows_;
   stats.execDurationInUs = execTime_;
+  if (memoryTracker_ != nullptr) {
+    memoryPeak_ = std::max(memoryPeak_, memoryTracker_->peak());
+  }
+  if (memoryPeak_ > 0) {
+    otherStats_.emplace("memory peak", memory::ReadableSize(memoryPeak_));
+  }
   if (!otherStats_.empty()) {
     stats.otherStats =
         std::make_unique<std::unordered_map<std::string, std::string>>(std::move(otherStats_));
@@ -736,6 +757,64 @@ bool Executor::movable(const Variable *var) {
   return var->userCount.load(std::memory_order_acquire) == 1;
 }
 
+size_t Executor::outputRowLimit() const {
+  constexpr auto kUnlimited = std::numeric_limits<size_t>::max();
+  // The variables of the users may be read by the other sentences
+  auto *var = node()->outputVarPtr();
+  if (node()->loopLayers() != 0 || var->readBy.size() != 1 ||
+      var->name.compare(0, 2, "__") != 0) {
+    return kUnlimited;
+  }
+  auto *reader = *var->readBy.begin();
+  if (reader->kind() != PlanNode::Kind::kLimit || reader->loopLayers() != 0) {
+    return kUnlimited;
+  }
+  auto *limit = static_cast<const Limit *>(reader);
+  if (limit->inputVar() != var->name) {
+    return kUnlimited;
+  }
+  // The count referring to the variables or parameters is only known when the limit runs
+  auto *countExpr = limit->countExpr();
+  if (countExpr == nullptr || countExpr->kind() != Expression::Kind::kConstant ||
+      !static_cast<const ConstantExpression *>(countExpr)->value().isInt()) {
+    return kUnlimited;
+  }
+  auto offset = limit->offset();
+  auto count = static_cast<const ConstantExpression *>(countExpr)->value().getInt();
+  if (offset < 0 || count < 0 || offset > std::numeric_limits<int64_t>::max() - count) {
+    return kUnlimited;
+  }
+  return static_cast<size_t>(offset + count);
+}
+
+// static
+size_t Executor::sampledSources(const PlanNode *node) {
+  std::unordered_set<const PlanNode *> visited;
+  std::function<size_t(const PlanNode *)> count = [&](const PlanNode *current) -> size_t {
+    size_t sources = 0;
+    for (auto *dep : current->dependencies()) {
+      if (!visited.emplace(dep).second) {
+        continue;
+      }
+      auto below = count(dep);
+      switch (dep->kind()) {
+        case PlanNode::Kind::kScanVertices:
+        case PlanNode::Kind::kScanEdges:
+          sources += below + 1;
+          break;
+        case PlanNode::Kind::kTraverse:
+        case PlanNode::Kind::kExpand:
+          sources += below == 0 ? 1 : below;
+          break;
+        default:
+          sources += below;
+      }
+    }
+    return sources;
+  };
+  return count(node);
+}
+
 Status Executor::finish(Result &&result) {
   // MemoryTrackerVerified
   if (!FLAGS_enable_lifetime_optimize ||
@@ -743,6 +822,10 @@ Status Executor::finish(Result &&result) {
     numRows_ = result.size();
     result.checkMemory(node()->isQueryNode());
     ectx_->setResult(node()->outputVar(), std::move(result));
+    if (FLAGS_enable_lifetime_optimize && node()->outputVarPtr()->latestOnly) {
+      // The versions of the former iterations are read by nobody
+      ectx_->truncHistory(node()->outputVar(), 1);
+    }
   } else {
     VLOG(1) << "Drop variable " << node()->outputVar();
   }
@@ -773,5 +856,12 @@ size_t Executor::getBatchSize(size_t totalSize) const {
   return batchSize;
 }
 
+size_t Executor::getMorselSize(size_t batchSize) const {
+  if (FLAGS_morsel_size <= 0) {
+    return batchSize;
+  }
+  return std::min(batchSize, static_cast<size_t>(FLAGS_morsel_size));
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -6,6 +6,7 @@
 #include <folly/futures/Future.h>
 
 #include <boost/core/noncopyable.hpp>
+#include <atomic>
 #include <mutex>
 
 #include "common/cpp/helpers.h"
@@ -54,6 +55,11 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
     return node_;
   }
 
+  // The memory tracker of the current run, under the tracker of the query
+  const std::shared_ptr<memory::MemoryTrackerNode> &memoryTracker() const {
+    return memoryTracker_;
+  }
+
   const std::set<Executor *> &depends() const {
     return depends_;
   }
@@ -108,6 +114,16 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
     return movable(qctx_->symTable()->getVar(var));
   }
 
+  // The number of the leading output rows which would be read. When the output is only read by a
+  // Limit, the rows after its offset + count are dropped anyway, so the executor could stop
+  // producing them early. It's unlimited otherwise.
+  size_t outputRowLimit() const;
+
+  // The count of the sources sampled independently by the nodes the node depends on, when the
+  // query is sampled, i.e. the scans and the traversals from the sources not sampled. The rows
+  // aggregated from them are sampled by the ratio to the power of the count.
+  static size_t sampledSources(const PlanNode *node);
+
   // Store the result of this executor to execution context
   Status finish(Result &&result);
   // Store the default result which not used for later executor
@@ -115,9 +131,16 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
 
   size_t getBatchSize(size_t totalSize) const;
 
+  // The rows of a morsel pulled by the jobs of runMultiJobs, at most batchSize
+  size_t getMorselSize(size_t batchSize) const;
+
   // ScatterFunc: A callback function that handle partial records of a dataset.
   // GatherFunc: A callback function that gather all results of ScatterFunc, and do post works.
   // Iterator: An iterator of a dataset.
+  // The dataset is split into the morsels of getMorselSize rows, and each of the jobs, as many
+  // as the batches of getBatchSize rows, pulls the next morsel until all are handled, so a slow
+  // morsel doesn't leave the other jobs idle. ScatterFunc is called for each morsel, and the
+  // results are gathered in the order of the morsels.
   template <
       class ScatterFunc,
       class ScatterResult = typename std::result_of<ScatterFunc(size_t, size_t, Iterator *)>::type,
@@ -161,6 +184,8 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
   uint64_t numRows_{0};
   uint64_t execTime_{0};
   time::Duration totalDuration_;
+  std::shared_ptr<memory::MemoryTrackerNode> memoryTracker_;
+  int64_t memoryPeak_{0};
 
  private:
   std::mutex statsLock_;
@@ -171,31 +196,50 @@ template <class ScatterFunc, class ScatterResult, class GatherFunc>
 auto Executor::runMultiJobs(ScatterFunc &&scatter, GatherFunc &&gather, Iterator *iter) {
   size_t totalSize = iter->size();
   size_t batchSize = getBatchSize(totalSize);
+  size_t morselSize = getMorselSize(batchSize);
+  size_t numJobs = (totalSize + batchSize - 1) / batchSize;
+  size_t numMorsels = (totalSize + morselSize - 1) / morselSize;
+
+  struct Morsels {
+    explicit Morsels(size_t num) : results(num) {}
+
+    std::atomic<size_t> next{0};
+    std::vector<folly::Try<ScatterResult>> results;
+  };
+  auto morsels = std::make_shared<Morsels>(numMorsels);
 
   // Start multiple jobs for handling the results
-  std::vector<folly::Future<ScatterResult>> futures;
-  size_t begin = 0, end = 0, dispathedCnt = 0;
-  while (dispathedCnt < totalSize) {
-    end = begin + batchSize > totalSize ? totalSize : begin + batchSize;
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(numJobs);
+  for (size_t i = 0; i < numJobs; ++i) {
     futures.emplace_back(folly::via(
         runner(),
-        [begin, end, tmpIter = iter->copy(), f = std::move(scatter)]() mutable -> ScatterResult {
+        [morsels, totalSize, morselSize, cursor = iter->copy(), f = scatter]() mutable {
           // MemoryTrackerVerified
           memory::MemoryCheckGuard guard;
-          // Since not all iterators are linear, so iterates to the begin pos
-          size_t tmp = 0;
-          for (; tmpIter->valid() && tmp < begin; ++tmp) {
-            tmpIter->next();
+          // The morsels are pulled in order, so the cursor of the job only moves forward to the
+          // begin of each, since not all iterators are linear
+          size_t pos = 0;
+          for (auto m = morsels->next.fetch_add(1, std::memory_order_relaxed);
+               m < morsels->results.size();
+               m = morsels->next.fetch_add(1, std::memory_order_relaxed)) {
+            size_t begin = m * morselSize;
+            size_t end = std::min(begin + morselSize, totalSize);
+            for (; cursor->valid() && pos < begin; ++pos) {
+              cursor->next();
+            }
+            auto tmpIter = cursor->copy();
+            morsels->results[m] =
+                folly::makeTryWith([&]() { return f(begin, end, tmpIter.get()); });
           }
-
-          return f(begin, end, tmpIter.get());
         }));
-    begin = end;
-    dispathedCnt += batchSize;
   }
 
   // Gather all results and do post works
-  return folly::collectAll(futures).via(runner()).thenValue(std::move(gather));
+  return folly::collectAll(futures)
+      .via(runner())
+      .thenValue([morsels](auto &&) { return std::move(morsels->results); })
+      .thenValue(std::move(gather));
 }
 }  // namespace graph
 }  // namespace nebula
@@ -8,6 +8,7 @@
 
 #include "graph/context/Iterator.h"
 #include "graph/context/QueryExpressionContext.h"
+#include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/util/SchemaUtil.h"
 #include "graph/util/Utils.h"
@@ -194,6 +195,7 @@ std::vector<Value> StorageAccessExecutor::handlePropResp(PropRpcResponse &&resps
   nebula::DataSet v;
   for (auto &resp : resps.responses()) {
     if (resp.props_ref().has_value()) {
+      internStrings(*resp.props_ref());
       if (UNLIKELY(!v.append(std::move(*resp.props_ref())))) {
         // it's impossible according to the interface
         LOG(WARNING) << "Heterogeneous props dataset";
@@ -211,6 +213,85 @@ std::vector<Value> StorageAccessExecutor::handlePropResp(PropRpcResponse &&resps
   return vertices;
 }
 
+void StorageAccessExecutor::internStrings(DataSet &ds) const {
+  auto *dict = qctx()->strDict();
+  if (dict != nullptr) {
+    dict->intern(ds);
+  }
+}
+
+void StorageAccessExecutor::internStrings(std::vector<storage::cpp2::NeighborEdges> &edges) const {
+  auto *dict = qctx()->strDict();
+  if (dict == nullptr) {
+    return;
+  }
+  for (auto &column : edges) {
+    for (auto &values : *column.props_ref()) {
+      for (auto &value : values) {
+        dict->intern(value);
+      }
+    }
+  }
+}
+
+std::unordered_set<Value> StorageAccessExecutor::runtimeFilterKeys(const Explore *node) const {
+  std::unordered_set<Value> keys;
+  QueryExpressionContext ctx(ectx_);
+  auto *key = node->runtimeFilterKey();
+  auto iter = ectx_->getResult(node->runtimeFilterVar()).iter();
+  for (; iter->valid(); iter->next()) {
+    auto &value = key->eval(ctx(iter.get()));
+    if (!value.isNull() && !value.empty()) {
+      keys.emplace(value);
+    }
+  }
+  return keys;
+}
+
+Expression *StorageAccessExecutor::addRuntimeFilter(Expression *filter,
+                                                    const std::unordered_set<Value> &keys,
+                                                    const std::vector<std::string> &tags) const {
+  if (tags.empty()) {
+    return filter;
+  }
+  auto *pool = qctx()->objPool();
+  Expression *values = nullptr;
+  Value min, max;
+  if (keys.size() <= FLAGS_runtime_filter_max_values) {
+    List list(std::vector<Value>(keys.begin(), keys.end()));
+    values = ConstantExpression::make(pool, Value(std::move(list)));
+  } else {
+    for (auto &key : keys) {
+      if (!key.isInt()) {
+        return filter;
+      }
+      if (min.empty() || key < min) {
+        min = key;
+      }
+      if (max.empty() || key > max) {
+        max = key;
+      }
+    }
+  }
+  auto *runtimeFilter = LogicalExpression::makeOr(pool);
+  for (auto &tag : tags) {
+    auto *vid = TagPropertyExpression::make(pool, tag, kVid);
+    if (values != nullptr) {
+      runtimeFilter->addOperand(RelationalExpression::makeIn(pool, vid, values->clone()));
+    } else {
+      runtimeFilter->addOperand(LogicalExpression::makeAnd(
+          pool,
+          RelationalExpression::makeGE(pool, vid, ConstantExpression::make(pool, min)),
+          RelationalExpression::makeLE(pool, vid->clone(), ConstantExpression::make(pool, max))));
+    }
+  }
+  Expression *result = runtimeFilter;
+  if (tags.size() == 1U) {
+    result = runtimeFilter->operands().front();
+  }
+  return filter == nullptr ? result : LogicalExpression::makeAnd(pool, filter->clone(), result);
+}
+
 void StorageAccessExecutor::addGetNeighborStats(RpcResponse &resp, size_t stepNum, bool reverse) {
   folly::dynamic stats = folly::dynamic::array();
   auto &hostLatency = resp.hostLatency();
@@ -24,6 +24,7 @@ class Expression;
 
 namespace graph {
 
+class Explore;
 class Iterator;
 struct SpaceInfo;
 
@@ -183,6 +184,21 @@ class StorageAccessExecutor : public Executor {
                                              const std::vector<VertexProp> *vertexPropPtr);
 
   std::vector<Value> handlePropResp(PropRpcResponse &&resps);
+
+  // Intern the strings of a data set from storage by the dictionary of the query
+  void internStrings(DataSet &ds) const;
+
+  // Intern the strings of the props of the flat edges of GetNeighbors
+  void internStrings(std::vector<storage::cpp2::NeighborEdges> &edges) const;
+
+  // The distinct keys of the build side of the runtime filter of node
+  std::unordered_set<Value> runtimeFilterKeys(const Explore *node) const;
+
+  // Add the runtime filter on the vid of the vertices of tags to filter, it's the keys if they're
+  // not too many, or else their range if they're integers
+  Expression *addRuntimeFilter(Expression *filter,
+                               const std::unordered_set<Value> &keys,
+                               const std::vector<std::string> &tags) const;
 };
 
 }  // namespace graph
@@ -53,5 +53,70 @@ folly::Future<Status> ShowPartsExecutor::execute() {
                           .build());
       });
 }
+
+folly::Future<Status> ShowHotPartsExecutor::execute() {
+  SCOPED_TIMER(&execTime_);
+
+  auto* shpNode = asNode<ShowHotParts>(node());
+  const auto& spaceId = shpNode->getSpaceId();
+  const auto& space = qctx()->rctx()->session()->space();
+  bool isIntVid = (*space.spaceDesc.vid_type_ref()).type == nebula::cpp2::PropertyType::INT64;
+  return qctx()
+      ->getMetaClient()
+      ->listHotParts(spaceId)
+      .via(runner())
+      .thenValue([this, spaceId, isIntVid](StatusOr<std::vector<meta::cpp2::HotPartItem>> resp) {
+        if (!resp.ok()) {
+          LOG(WARNING) << "SpaceId: " << spaceId << ", Show Hot Parts fail: " << resp.status();
+          return resp.status();
+        }
+        auto items = std::move(resp).value();
+
+        DataSet dataSet({"Host",
+                         "Partition ID",
+                         "Read QPS",
+                         "Write QPS",
+                         "Read Bytes/s",
+                         "Write Bytes/s",
+                         "Hot Vertices"});
+        for (auto& item : items) {
+          const auto& hotness = item.get_hotness();
+          List vertices;
+          for (const auto& vertex : hotness.get_hot_vertices()) {
+            Map map;
+            map.kvs.emplace("vid", toVid(vertex.get_vid(), isIntVid));
+            map.kvs.emplace("count", vertex.get_count());
+            vertices.values.emplace_back(std::move(map));
+          }
+          Row row;
+          row.values.emplace_back(NetworkUtils::toHostsStr({item.get_host()}));
+          row.values.emplace_back(hotness.get_part_id());
+          row.values.emplace_back(hotness.get_read_qps());
+          row.values.emplace_back(hotness.get_write_qps());
+          row.values.emplace_back(hotness.get_read_bytes_per_sec());
+          row.values.emplace_back(hotness.get_write_bytes_per_sec());
+          row.values.emplace_back(std::move(vertices));
+          dataSet.emplace_back(std::move(row));
+        }
+        return finish(ResultBuilder()
+                          .value(Value(std::move(dataSet)))
+                          .iter(Iterator::Kind::kDefault)
+                          .build());
+      });
+}
+
+// static
+Value ShowHotPartsExecutor::toVid(const std::string& vid, bool isIntVid) {
+  if (isIntVid) {
+    if (vid.size() != sizeof(int64_t)) {
+      return Value::kNullBadData;
+    }
+    int64_t id;
+    memcpy(&id, vid.data(), sizeof(int64_t));
+    return id;
+  }
+  auto end = vid.find_last_not_of('\0');
+  return end == std::string::npos ? std::string() : vid.substr(0, end + 1);
+}
 }  // namespace graph
 }  // namespace nebula
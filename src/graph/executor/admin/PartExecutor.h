@@ -18,6 +18,18 @@ class ShowPartsExecutor final : public Executor {
   folly::Future<Status> execute() override;
 };
 
+class ShowHotPartsExecutor final : public Executor {
+ public:
+  ShowHotPartsExecutor(const PlanNode *node, QueryContext *qctx)
+      : Executor("ShowHotPartsExecutor", node, qctx) {}
+
+  folly::Future<Status> execute() override;
+
+ private:
+  // The vid of the key, which is padded for the fixed string vids
+  static Value toVid(const std::string &vid, bool isIntVid);
+};
+
 }  // namespace graph
 }  // namespace nebula
 
@@ -32,7 +32,8 @@ folly::Future<Status> ShowQueriesExecutor::showCurrentSessionQueries() {
                    "StartTime",
                    "DurationInUSec",
                    "Status",
-                   "Query"});
+                   "Query",
+                   "MemoryInBytes"});
   auto* session = qctx()->rctx()->session();
   auto sessionInMeta = session->getSession();
 
@@ -57,7 +58,8 @@ folly::Future<Status> ShowQueriesExecutor::showAllSessionQueries() {
                          "StartTime",
                          "DurationInUSec",
                          "Status",
-                         "Query"});
+                         "Query",
+                         "MemoryInBytes"});
         for (auto& session : sessions) {
           addQueries(session, dataSet);
         }
@@ -83,6 +85,7 @@ void ShowQueriesExecutor::addQueries(const meta::cpp2::Session& session, DataSet
     row.values.emplace_back(query.second.get_duration());
     row.values.emplace_back(apache::thrift::util::enumNameSafe(query.second.get_status()));
     row.values.emplace_back(query.second.get_query());
+    row.values.emplace_back(query.second.get_memory_bytes());
     dataSet.rows.emplace_back(std::move(row));
   }
 }
@@ -161,8 +161,8 @@ folly::Future<Status> AllPathsExecutor::getNeighbors(bool reverse) {
         auto& responses = std::move(resps).responses();
         List list;
         for (auto& resp : responses) {
-          auto dataset = resp.get_vertices();
-          if (dataset == nullptr) {
+          auto dataset = resp.vertices_ref();
+          if (!dataset.has_value()) {
             LOG(INFO) << "Empty dataset in response";
             continue;
           }
@@ -493,11 +493,12 @@ std::vector<Row> AllPathsExecutor::buildOneWayPathFromHashTable(bool reverse) {
     auto& paths = findVid->second;
     Value emptyPropVertex(Vertex(vid, {}));
     if (!reverse) {
-      for (auto& path : paths) {
+      for (auto* nPath : paths) {
         cnt_.fetch_add(1, std::memory_order_relaxed);
         if (cnt_.load(std::memory_order_relaxed) > limit_) {
           break;
         }
+        auto path = convertNPath2List(nPath, reverse);
         Row row;
         row.values.emplace_back(emptyPropVertex);
         auto& dstVertex = path.back();
@@ -508,11 +509,12 @@ std::vector<Row> AllPathsExecutor::buildOneWayPathFromHashTable(bool reverse) {
         result.emplace_back(std::move(row));
       }
     } else {
-      for (auto& path : paths) {
+      for (auto* nPath : paths) {
         cnt_.fetch_add(1, std::memory_order_relaxed);
         if (cnt_.load(std::memory_order_relaxed) > limit_) {
           break;
         }
+        auto path = convertNPath2List(nPath, reverse);
         Row row;
         row.values.emplace_back(path.front());
         std::vector<Value> tmp(path.begin() + 1, path.end());
@@ -538,27 +540,26 @@ folly::Future<Status> AllPathsExecutor::conjunctPath(std::vector<NPath*>& leftPa
   }
   bool reverse = false;
   if (leftPaths.size() < rightPaths.size()) {
-    buildHashTable(leftPaths, reverse);
+    buildHashTable(leftPaths);
     probePaths_ = std::move(rightPaths);
   } else {
     reverse = true;
-    buildHashTable(rightPaths, reverse);
+    buildHashTable(rightPaths);
     probePaths_ = std::move(leftPaths);
   }
   auto oneWayPath = buildOneWayPathFromHashTable(!reverse);
 
   size_t probeSize = probePaths_.size();
+  // Split the probe paths to FLAGS_num_path_thread batches at least, each of FLAGS_path_batch_size
+  // at most
+  size_t threadNum = std::max<size_t>(FLAGS_num_path_thread, 1);
+  size_t batchSize = (probeSize + threadNum - 1) / threadNum;
+  batchSize = std::max<size_t>(std::min<size_t>(batchSize, FLAGS_path_batch_size), 1);
   std::vector<folly::Future<std::vector<Row>>> futures;
-  if (probeSize < FLAGS_path_batch_size) {
+  for (size_t start = 0; start < probeSize; start += batchSize) {
+    auto end = std::min(start + batchSize, probeSize);
     futures.emplace_back(folly::via(
-        runner(), [this, probeSize, reverse]() { return probe(0, probeSize, reverse); }));
-  } else {
-    for (size_t start = 0; start < probeSize; start += FLAGS_path_batch_size) {
-      auto tmp = start + FLAGS_path_batch_size;
-      auto end = tmp > probeSize ? probeSize : tmp;
-      futures.emplace_back(folly::via(
-          runner(), [this, start, end, reverse]() { return probe(start, end, reverse); }));
-    }
+        runner(), [this, start, end, reverse]() { return probe(start, end, reverse); }));
   }
   return folly::collectAll(futures)
       .via(runner())
@@ -604,17 +605,11 @@ folly::Future<Status> AllPathsExecutor::conjunctPath(std::vector<NPath*>& leftPa
       });
 }
 
-void AllPathsExecutor::buildHashTable(std::vector<NPath*>& paths, bool reverse) {
+void AllPathsExecutor::buildHashTable(std::vector<NPath*>& paths) {
   for (auto& path : paths) {
     auto& edgeVal = path->edge;
     const auto& edge = edgeVal.getEdge();
-    auto findDst = hashTable_.find(edge.dst);
-    if (findDst == hashTable_.end()) {
-      std::vector<std::vector<Value>> tmp({convertNPath2List(path, reverse)});
-      hashTable_.emplace(edge.dst, std::move(tmp));
-    } else {
-      findDst->second.emplace_back(convertNPath2List(path, reverse));
-    }
+    hashTable_[edge.dst].emplace_back(path);
   }
 }
 
@@ -633,7 +628,7 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
     return row;
   };
 
-  size_t minLength = reverse ? rightSteps_ * 2 : leftSteps_ * 2;
+  size_t minSteps = reverse ? rightSteps_ : leftSteps_;
   std::vector<Row> result;
   Row emptyPropVerticesRow;
   for (size_t i = start; i < end; ++i) {
@@ -649,19 +644,26 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
       continue;
     }
     auto valueList = convertNPath2List(probePath, !reverse);
+    VidHashSet probeVertices;
+    if (noLoop_) {
+      for (const auto& v : valueList) {
+        if (v.isVertex()) {
+          probeVertices.emplace(v);
+        }
+      }
+      probeVertices.emplace(intersectVertex);
+    }
 
-    for (auto& path : findDst->second) {
-      if (path.size() != minLength) {
+    for (auto* nPath : findDst->second) {
+      if (nPath->steps != minSteps) {
         continue;
       }
-      auto& leftPath = reverse ? valueList : path;
-      auto& rightPath = reverse ? path : valueList;
       if (noLoop_) {
-        if (hasSameVertices(leftPath, intersectVid, rightPath)) {
+        if (hasSameVertices(nPath, probeVertices)) {
           continue;
         }
       } else {
-        if (hasSameEdge(leftPath, rightPath)) {
+        if (hasSameEdge(nPath, valueList)) {
           continue;
         }
       }
@@ -669,6 +671,10 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
       if (cnt_.load(std::memory_order_relaxed) > limit_) {
         break;
       }
+      // only the paths in the result are converted
+      auto path = convertNPath2List(nPath, reverse);
+      auto& leftPath = reverse ? valueList : path;
+      auto& rightPath = reverse ? path : valueList;
       result.emplace_back(buildPath(leftPath, intersectVertex, rightPath));
     }
     emptyPropVerticesRow.values.emplace_back(intersectVertex);
@@ -723,13 +729,11 @@ bool AllPathsExecutor::hasSameVertices(NPath* path, const Edge& edge) {
   return false;
 }
 
-bool AllPathsExecutor::hasSameEdge(std::vector<Value>& leftPaths, std::vector<Value>& rightPaths) {
-  for (auto& leftEdge : leftPaths) {
-    if (!leftEdge.isEdge()) {
-      continue;
-    }
-    for (auto& rightEdge : rightPaths) {
-      if (rightEdge.isEdge() && rightEdge.getEdge().keyEqual(leftEdge.getEdge())) {
+bool AllPathsExecutor::hasSameEdge(NPath* path, const std::vector<Value>& values) {
+  for (NPath* head = path; head != nullptr; head = head->p) {
+    const auto& edge = head->edge.getEdge();
+    for (const auto& value : values) {
+      if (value.isEdge() && value.getEdge().keyEqual(edge)) {
         return true;
       }
     }
@@ -737,24 +741,10 @@ bool AllPathsExecutor::hasSameEdge(std::vector<Value>& leftPaths, std::vector<Va
   return false;
 }
 
-bool AllPathsExecutor::hasSameVertices(const std::vector<Value>& leftPaths,
-                                       const Value& intersectVertex,
-                                       const std::vector<Value>& rightPaths) {
-  bool flag = leftPaths.size() > rightPaths.size();
-  const auto& hashPath = flag ? rightPaths : leftPaths;
-  const auto& probePath = flag ? leftPaths : rightPaths;
-  VidHashSet hashTable;
-  for (const auto& v : hashPath) {
-    if (v.isVertex()) {
-      hashTable.emplace(v);
-    }
-  }
-  hashTable.emplace(intersectVertex);
-  for (const auto& v : probePath) {
-    if (v.isVertex()) {
-      if (hashTable.find(v) != hashTable.end()) {
-        return true;
-      }
+bool AllPathsExecutor::hasSameVertices(NPath* path, const VidHashSet& vertices) {
+  for (NPath* head = path; head != nullptr; head = head->p) {
+    if (vertices.find(head->vertex) != vertices.end()) {
+      return true;
     }
   }
   return false;
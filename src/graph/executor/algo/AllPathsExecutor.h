@@ -27,6 +27,11 @@
 // when expanding, if the vid has already been visited, do not visit again
 // leftAdjList_ save result of forward expansion
 // rightAdjList_ save result of backward expansion
+
+// the paths are trees of NPath sharing their prefixes, each NPath points to its parent. They are
+// only converted to the list of values when the path is in the result
+// hashTable_ indexes the paths of the smaller side by their dst, the paths of the other side probe
+// it in batches spread over FLAGS_num_path_thread
 namespace nebula {
 namespace graph {
 class AllPaths;
@@ -51,10 +56,14 @@ class AllPathsExecutor final : public StorageAccessExecutor {
     NPath* p{nullptr};
     const Value& vertex;
     const Value& edge;
+    // number of edges from the init vid
+    size_t steps{1};
     NPath(const Value& v, const Value& e) : vertex(v), edge(e) {}
-    NPath(NPath* path, const Value& v, const Value& e) : p(path), vertex(v), edge(e) {}
-    NPath(NPath&& v) noexcept : p(v.p), vertex(std::move(v.vertex)), edge(std::move(v.edge)) {}
-    NPath(const NPath& v) : p(v.p), vertex(v.vertex), edge(v.edge) {}
+    NPath(NPath* path, const Value& v, const Value& e)
+        : p(path), vertex(v), edge(e), steps(path->steps + 1) {}
+    NPath(NPath&& v) noexcept
+        : p(v.p), vertex(std::move(v.vertex)), edge(std::move(v.edge)), steps(v.steps) {}
+    NPath(const NPath& v) : p(v.p), vertex(v.vertex), edge(v.edge), steps(v.steps) {}
     ~NPath() {}
   };
 
@@ -83,7 +92,7 @@ class AllPathsExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> buildResult();
 
-  void buildHashTable(std::vector<NPath*>& paths, bool reverse);
+  void buildHashTable(std::vector<NPath*>& paths);
 
   std::vector<Row> probe(size_t start, size_t end, bool reverse);
 
@@ -94,11 +103,9 @@ class AllPathsExecutor final : public StorageAccessExecutor {
 
   bool hasSameVertices(NPath* path, const Edge& edge);
 
-  bool hasSameEdge(std::vector<Value>& leftPaths, std::vector<Value>& rightPaths);
+  bool hasSameEdge(NPath* path, const std::vector<Value>& values);
 
-  bool hasSameVertices(const std::vector<Value>& leftPaths,
-                       const Value& intersectVertex,
-                       const std::vector<Value>& rightPaths);
+  bool hasSameVertices(NPath* path, const VidHashSet& vertices);
 
   void buildOneWayPath(std::vector<NPath*>& paths, bool reverse);
 
@@ -131,7 +138,7 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   class NewTag {};
   folly::ThreadLocalPtr<std::deque<NPath>, NewTag> threadLocalPtr_;
 
-  std::unordered_map<Value, std::vector<std::vector<Value>>> hashTable_;
+  std::unordered_map<Value, std::vector<NPath*>> hashTable_;
   std::vector<NPath*> probePaths_;
 };
 }  // namespace graph
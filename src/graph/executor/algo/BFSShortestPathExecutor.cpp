@@ -89,16 +89,13 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
   auto iter = reverse ? ectx_->getResult(pathNode_->rightInputVar()).iter()
                       : ectx_->getResult(pathNode_->leftInputVar()).iter();
   DCHECK(!!iter);
+  auto& vids = reverse ? rightVids_ : leftVids_;
   auto& visitedVids = reverse ? rightVisitedVids_ : leftVisitedVids_;
   auto& allEdges = reverse ? allRightEdges_ : allLeftEdges_;
   allEdges.emplace_back();
   auto& currentEdges = allEdges.back();
 
-  auto iterSize = iter->size();
-  visitedVids.reserve(visitedVids.size() + iterSize);
-
-  HashSet uniqueDst;
-  uniqueDst.reserve(iterSize);
+  DenseIdSet uniqueDst;
   DataSet nextStepVids;
   nextStepVids.colNames = {nebula::kVid};
   if (step_ == 1) {
@@ -109,8 +106,8 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
       }
       auto& edge = edgeVal.getEdge();
       auto dst = edge.dst;
-      visitedVids.emplace(edge.src);
-      if (uniqueDst.emplace(dst).second) {
+      visitedVids.insert(vids.intern(edge.src));
+      if (uniqueDst.insert(vids.intern(dst))) {
         nextStepVids.rows.emplace_back(Row({dst}));
       }
       currentEdges.emplace(std::move(dst), std::move(edge));
@@ -123,10 +120,11 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
       }
       auto& edge = edgeVal.getEdge();
       auto dst = edge.dst;
-      if (visitedVids.find(dst) != visitedVids.end()) {
+      auto dstId = vids.intern(dst);
+      if (visitedVids.contains(dstId)) {
         continue;
       }
-      if (uniqueDst.emplace(dst).second) {
+      if (uniqueDst.insert(dstId)) {
         nextStepVids.rows.emplace_back(Row({dst}));
       }
       currentEdges.emplace(std::move(dst), std::move(edge));
@@ -140,8 +138,7 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
     ectx_->setValue(terminateEarlyVar_, true);
     return Status::OK();
   }
-  visitedVids.insert(std::make_move_iterator(uniqueDst.begin()),
-                     std::make_move_iterator(uniqueDst.end()));
+  visitedVids.merge(uniqueDst);
   return Status::OK();
 }
 
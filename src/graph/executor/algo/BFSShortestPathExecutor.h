@@ -7,6 +7,7 @@
 #include <robin_hood.h>
 
 #include "graph/executor/Executor.h"
+#include "graph/util/VidInterner.h"
 
 // BFSShortestPath has two inputs.  GetNeighbors(From) & GetNeighbors(To)
 // There are two Main functions
@@ -38,6 +39,8 @@
 //
 // `leftVisitedVids_` : keep already visited vid to avoid repeated visits (left)
 // `rightVisitedVids_` : keep already visited vid to avoid repeated visits (right)
+//  both are bitmaps of the ids interned by `leftVids_` and `rightVids_`, each side has its own
+//  interner as the two sides are built concurrently
 // `currentDs_`: keep the paths matched in current step
 namespace nebula {
 namespace graph {
@@ -65,8 +68,10 @@ class BFSShortestPathExecutor final : public Executor {
   const BFSShortestPath* pathNode_{nullptr};
   bool singleShortest_{false};
   size_t step_{1};
-  HashSet leftVisitedVids_;
-  HashSet rightVisitedVids_;
+  VidInterner leftVids_;
+  VidInterner rightVids_;
+  DenseIdSet leftVisitedVids_;
+  DenseIdSet rightVisitedVids_;
   std::vector<std::unordered_multimap<Value, Edge>> allLeftEdges_;
   std::vector<std::unordered_multimap<Value, Edge>> allRightEdges_;
   DataSet currentDs_;
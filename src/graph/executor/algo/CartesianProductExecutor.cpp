@@ -4,8 +4,14 @@
 
 #include "graph/executor/algo/CartesianProductExecutor.h"
 
+#include <limits>
+#include <optional>
+
+#include "common/expression/CompiledExpression.h"
+#include "graph/context/iterator/SequentialIter.h"
 #include "graph/planner/plan/Algo.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -18,37 +24,144 @@ folly::Future<Status> CartesianProductExecutor::execute() {
   if (vars.size() < 2) {
     return Status::Error("vars's size : %zu, must be greater than 2", vars.size());
   }
-  DataSet result;
-  auto* lds = const_cast<DataSet*>(&ectx_->getResult(vars[0]).value().getDataSet());
-  for (size_t i = 1; i < vars.size(); ++i) {
-    const auto& rds = ectx_->getResult(vars[i]).value().getDataSet();
-    DataSet ds;
-    doCartesianProduct(*lds, rds, ds);
-    result = std::move(ds);
-    lds = &result;
+  std::vector<std::shared_ptr<Value>> inputs;
+  inputs.reserve(vars.size());
+  for (const auto& var : vars) {
+    inputs.emplace_back(ectx_->getResult(var).valuePtr());
   }
+  std::vector<std::string> colNames;
   for (auto& cols : cartesianProduct->allColNames()) {
-    result.colNames.reserve(result.colNames.size() + cols.size());
-    result.colNames.insert(result.colNames.end(),
-                           std::make_move_iterator(cols.begin()),
-                           std::make_move_iterator(cols.end()));
+    colNames.reserve(colNames.size() + cols.size());
+    colNames.insert(colNames.end(),
+                    std::make_move_iterator(cols.begin()),
+                    std::make_move_iterator(cols.end()));
   }
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
+  return doCartesianProduct(std::move(inputs), std::move(colNames), nullptr);
 }
 
-void CartesianProductExecutor::doCartesianProduct(const DataSet& lds,
-                                                  const DataSet& rds,
-                                                  DataSet& result) {
-  result.rows.reserve(lds.size() * rds.size());
-  for (auto i = lds.begin(); i < lds.end(); ++i) {
-    for (auto j = rds.begin(); j < rds.end(); ++j) {
-      Row row;
-      row.reserve(i->size() + j->size());
-      row.values.insert(row.values.end(), i->values.begin(), i->values.end());
-      row.values.insert(row.values.end(), j->values.begin(), j->values.end());
+folly::Future<Status> CartesianProductExecutor::doCartesianProduct(
+    std::vector<std::shared_ptr<Value>> inputs,
+    std::vector<std::string> colNames,
+    const Expression* filter) {
+  std::vector<const DataSet*> datasets;
+  datasets.reserve(inputs.size());
+  bool empty = false;
+  for (const auto& input : inputs) {
+    datasets.emplace_back(&input->getDataSet());
+    empty = empty || datasets.back()->rows.empty();
+  }
+  size_t limit = outputRowLimit();
+  DataSet result;
+  result.colNames = colNames;
+  if (empty || limit == 0) {
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  }
+
+  // The rows needed by a limit are generated in one job, which stops as soon as they're met
+  if (FLAGS_max_job_size == 1 || limit != std::numeric_limits<size_t>::max()) {
+    auto rows = productJob(datasets, 0, datasets.front()->rows.size(), colNames, filter, limit);
+    NG_RETURN_IF_ERROR(rows);
+    result.rows = std::move(rows).value().rows;
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  }
+
+  SequentialIter iter(inputs.front());
+  auto scatter = [this, inputs, datasets, colNames, filter](
+                     size_t begin, size_t end, Iterator*) -> StatusOr<DataSet> {
+    return productJob(datasets, begin, end, colNames, filter, std::numeric_limits<size_t>::max());
+  };
+  auto gather = [this, result = std::move(result)](
+                    std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
+    // MemoryTrackerVerified
+    memory::MemoryCheckGuard guard;
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      auto&& rows = std::move(res).value();
+      result.rows.insert(result.rows.end(),
+                         std::make_move_iterator(rows.begin()),
+                         std::make_move_iterator(rows.end()));
+    }
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  };
+  return runMultiJobs(std::move(scatter), std::move(gather), &iter);
+}
+
+StatusOr<DataSet> CartesianProductExecutor::productJob(const std::vector<const DataSet*>& inputs,
+                                                       size_t begin,
+                                                       size_t end,
+                                                       const std::vector<std::string>& colNames,
+                                                       const Expression* filter,
+                                                       size_t limit) {
+  DataSet result;
+  // The rows to filter are generated and evaluated in the chunks, so no more than a chunk of the
+  // rows dropped is kept at a time
+  DataSet chunk;
+  chunk.colNames = colNames;
+  size_t chunkSize = std::max(FLAGS_min_batch_size, 1);
+  QueryExpressionContext ctx(ectx_);
+  std::optional<CompiledExpression> compiled;
+  if (filter != nullptr) {
+    compiled = CompiledExpression::compile(filter);
+  }
+  auto flush = [&]() -> Status {
+    auto dataset = std::make_shared<Value>(std::move(chunk));
+    auto& rows = dataset->mutableDataSet().rows;
+    SequentialIter iter(dataset);
+    for (size_t i = 0; iter.valid() && result.rows.size() < limit; iter.next(), ++i) {
+      const auto& val = compiled->eval(ctx(&iter));
+      if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
+        return Status::Error(
+            "Failed to evaluate condition: %s. For boolean conditions, please write in their full "
+            "forms like <condition> == <true/false> or <condition> IS [NOT] NULL.",
+            filter->toString().c_str());
+      }
+      if (!(val.empty() || val.isNull() || (val.isImplicitBool() && !val.implicitBool()))) {
+        result.rows.emplace_back(std::move(rows[i]));
+      }
+    }
+    chunk = DataSet();
+    chunk.colNames = colNames;
+    return Status::OK();
+  };
+
+  // The indices of the rows of the inputs, which go like an odometer with the last one innermost
+  std::vector<size_t> indices(inputs.size(), 0);
+  indices[0] = begin;
+  while (indices[0] < end && result.rows.size() < limit) {
+    Row row;
+    row.reserve(colNames.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const auto& values = inputs[i]->rows[indices[i]].values;
+      row.values.insert(row.values.end(), values.begin(), values.end());
+    }
+    if (filter == nullptr) {
       result.rows.emplace_back(std::move(row));
+    } else {
+      chunk.rows.emplace_back(std::move(row));
+      if (chunk.rows.size() >= chunkSize) {
+        NG_RETURN_IF_ERROR(flush());
+      }
+    }
+    for (size_t i = inputs.size(); i-- > 0;) {
+      if (++indices[i] < inputs[i]->rows.size() || i == 0) {
+        break;
+      }
+      indices[i] = 0;
     }
   }
+  if (!chunk.rows.empty() && result.rows.size() < limit) {
+    NG_RETURN_IF_ERROR(flush());
+  }
+  return result;
 }
 
 CrossJoinExecutor::CrossJoinExecutor(const PlanNode* node, QueryContext* qctx)
@@ -60,12 +173,9 @@ folly::Future<Status> CrossJoinExecutor::execute() {
   SCOPED_TIMER(&execTime_);
 
   auto* cj = asNode<CrossJoin>(node());
-  const auto& lds = ectx_->getResult(cj->leftInputVar()).value().getDataSet();
-  const auto& rds = ectx_->getResult(cj->rightInputVar()).value().getDataSet();
-  DataSet result;
-  doCartesianProduct(lds, rds, result);
-  result.colNames = cj->colNames();
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
+  std::vector<std::shared_ptr<Value>> inputs = {ectx_->getResult(cj->leftInputVar()).valuePtr(),
+                                                ectx_->getResult(cj->rightInputVar()).valuePtr()};
+  return doCartesianProduct(std::move(inputs), cj->colNames(), cj->filter());
 }
 }  // namespace graph
 }  // namespace nebula
@@ -17,7 +17,22 @@ class CartesianProductExecutor : public Executor {
   folly::Future<Status> execute() override;
 
  protected:
-  void doCartesianProduct(const DataSet& lds, const DataSet& rds, DataSet& result);
+  // The product of the datasets of the inputs, in the order of the nested loops over their rows
+  // with the last input innermost. The rows are generated lazily in the jobs over the morsels of
+  // the first input, only the ones meeting the filter are kept, and the generation stops at the
+  // rows needed by the Limit reading the output, so the whole product is never materialized.
+  folly::Future<Status> doCartesianProduct(std::vector<std::shared_ptr<Value>> inputs,
+                                           std::vector<std::string> colNames,
+                                           const Expression* filter);
+
+ private:
+  // The product rows of the rows [begin, end) of the first input meeting filter, at most limit
+  StatusOr<DataSet> productJob(const std::vector<const DataSet*>& inputs,
+                               size_t begin,
+                               size_t end,
+                               const std::vector<std::string>& colNames,
+                               const Expression* filter,
+                               size_t limit);
 
  private:
   std::vector<std::vector<std::string>> colNames_;
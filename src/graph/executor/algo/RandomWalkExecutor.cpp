@@ -0,0 +1,231 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/algo/RandomWalkExecutor.h"
+
+#include "common/memory/MemoryTracker.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/util/Utils.h"
+
+using nebula::storage::StorageClient;
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> RandomWalkExecutor::execute() {
+  SCOPED_TIMER(&execTime_);
+  auto iter = ectx_->getResult(walk_->inputVar()).iter();
+  auto res = buildRequestListByVidType(iter.get(), walk_->src(), true);
+  NG_RETURN_IF_ERROR(res);
+  auto vids = std::move(res).value();
+  walks_.reserve(vids.size() * walk_->walks());
+  active_.reserve(vids.size() * walk_->walks());
+  for (const auto& vid : vids) {
+    for (size_t i = 0; i < walk_->walks(); ++i) {
+      active_.emplace_back(walks_.size());
+      walks_.emplace_back(List(std::vector<Value>{vid}));
+    }
+  }
+  return walk();
+}
+
+folly::Future<Status> RandomWalkExecutor::walk() {
+  if (currentStep_ > walk_->steps() || active_.empty()) {
+    return buildResult();
+  }
+  groups_.clear();
+  for (auto idx : active_) {
+    groups_[walks_[idx].values.back()].emplace_back(idx);
+  }
+
+  std::vector<Value> vids;
+  vids.reserve(groups_.size());
+  if (walk_->unbiased()) {
+    // Each vertex samples as many neighbors as the walks at it
+    size_t limit = 0;
+    for (const auto& group : groups_) {
+      vids.emplace_back(group.first);
+      limit = std::max(limit, group.second.size());
+    }
+    return getNeighbors(std::move(vids), static_cast<int64_t>(limit));
+  }
+
+  for (const auto& group : groups_) {
+    if (neighbors_.find(group.first) == neighbors_.end()) {
+      vids.emplace_back(group.first);
+    }
+  }
+  if (vids.empty()) {
+    biasedStep();
+    ++currentStep_;
+    return walk();
+  }
+  return getNeighbors(std::move(vids), -1);
+}
+
+folly::Future<Status> RandomWalkExecutor::getNeighbors(std::vector<Value> vids, int64_t limit) {
+  time::Duration getNbrTime;
+  StorageClient* storageClient = qctx_->getStorageClient();
+  StorageClient::CommonRequestParam param(walk_->space(),
+                                          qctx_->rctx()->session()->id(),
+                                          qctx_->plan()->id(),
+                                          qctx_->plan()->isProfileEnabled());
+  return storageClient
+      ->getNeighbors(param,
+                     {nebula::kVid},
+                     std::move(vids),
+                     {},
+                     storage::cpp2::EdgeDirection::OUT_EDGE,
+                     nullptr,
+                     nullptr,
+                     walk_->edgeProps(),
+                     nullptr,
+                     false,
+                     limit >= 0,
+                     {},
+                     limit,
+                     nullptr,
+                     nullptr)
+      .via(runner())
+      .thenValue([this, getNbrTime](RpcResponse&& resps) mutable {
+        // MemoryTrackerVerified
+        memory::MemoryCheckGuard guard;
+        addState(folly::sformat("step[{}].total_rpc_time", currentStep_), getNbrTime);
+        auto& hostLatency = resps.hostLatency();
+        for (size_t i = 0; i < hostLatency.size(); ++i) {
+          size_t size = 0u;
+          auto& result = resps.responses()[i];
+          if (result.vertices_ref().has_value()) {
+            size = (*result.vertices_ref()).size();
+          }
+          auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+          addState(folly::sformat("step[{}].resp[{}]", currentStep_, i), info);
+        }
+        auto status = handleResponse(std::move(resps));
+        if (!status.ok()) {
+          return folly::makeFuture<Status>(std::move(status));
+        }
+        ++currentStep_;
+        return walk();
+      });
+}
+
+Status RandomWalkExecutor::handleResponse(RpcResponse&& resps) {
+  auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
+  NG_RETURN_IF_ERROR(result);
+  auto dsts = collectNeighbors(std::move(resps));
+  if (walk_->unbiased()) {
+    uniformStep(std::move(dsts));
+    return Status::OK();
+  }
+  for (auto& src : dsts) {
+    auto& neighbors = neighbors_[src.first];
+    neighbors.dstSet.insert(src.second.begin(), src.second.end());
+    neighbors.dsts = std::move(src.second);
+  }
+  // The vertices without any neighbor are cached too, so they are not fetched again
+  for (const auto& group : groups_) {
+    neighbors_.emplace(group.first, Neighbors());
+  }
+  biasedStep();
+  return Status::OK();
+}
+
+std::unordered_map<Value, std::vector<Value>> RandomWalkExecutor::collectNeighbors(
+    RpcResponse&& resps) {
+  List list;
+  for (auto& resp : resps.responses()) {
+    auto dataset = resp.vertices_ref();
+    if (!dataset.has_value()) {
+      continue;
+    }
+    list.values.emplace_back(std::move(*dataset));
+  }
+  auto listVal = std::make_shared<Value>(std::move(list));
+  GetNeighborsIter iter(listVal);
+
+  std::unordered_map<Value, std::vector<Value>> dsts;
+  for (; iter.valid(); iter.next()) {
+    auto edgeVal = iter.getEdge();
+    if (UNLIKELY(!edgeVal.isEdge())) {
+      continue;
+    }
+    auto& edge = edgeVal.mutableEdge();
+    dsts[edge.src].emplace_back(std::move(edge.dst));
+  }
+  return dsts;
+}
+
+void RandomWalkExecutor::uniformStep(std::unordered_map<Value, std::vector<Value>>&& samples) {
+  std::vector<size_t> active;
+  active.reserve(active_.size());
+  for (const auto& group : groups_) {
+    auto found = samples.find(group.first);
+    if (found == samples.end() || found->second.empty()) {
+      continue;
+    }
+    const auto& dsts = found->second;
+    auto offset = folly::Random::rand64(dsts.size());
+    for (size_t i = 0; i < group.second.size(); ++i) {
+      auto idx = group.second[i];
+      walks_[idx].values.emplace_back(dsts[(offset + i) % dsts.size()]);
+      active.emplace_back(idx);
+    }
+  }
+  active_ = std::move(active);
+}
+
+void RandomWalkExecutor::biasedStep() {
+  std::vector<size_t> active;
+  active.reserve(active_.size());
+  for (const auto& group : groups_) {
+    auto found = neighbors_.find(group.first);
+    DCHECK(found != neighbors_.end());
+    if (found->second.dsts.empty()) {
+      continue;
+    }
+    for (auto idx : group.second) {
+      auto next = biasedNext(walks_[idx], found->second);
+      walks_[idx].values.emplace_back(std::move(next));
+      active.emplace_back(idx);
+    }
+  }
+  active_ = std::move(active);
+}
+
+const Value& RandomWalkExecutor::biasedNext(const List& walk, const Neighbors& neighbors) {
+  const auto& dsts = neighbors.dsts;
+  if (walk.values.size() < 2) {
+    return dsts[folly::Random::rand64(dsts.size())];
+  }
+  const auto& prev = walk.values[walk.values.size() - 2];
+  auto prevNeighbors = neighbors_.find(prev);
+  DCHECK(prevNeighbors != neighbors_.end());
+  double returnWeight = 1.0 / walk_->p();
+  double outWeight = 1.0 / walk_->q();
+  double maxWeight = std::max({returnWeight, 1.0, outWeight});
+  while (true) {
+    const auto& next = dsts[folly::Random::rand64(dsts.size())];
+    double weight = next == prev                                ? returnWeight
+                    : prevNeighbors->second.dstSet.count(next) ? 1.0
+                                                               : outWeight;
+    if (folly::Random::randDouble01() * maxWeight < weight) {
+      return next;
+    }
+  }
+}
+
+folly::Future<Status> RandomWalkExecutor::buildResult() {
+  DataSet ds;
+  ds.colNames = walk_->colNames();
+  ds.rows.reserve(walks_.size());
+  for (auto& walk : walks_) {
+    ds.rows.emplace_back(Row({Value(std::move(walk))}));
+  }
+  walks_.clear();
+  neighbors_.clear();
+  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_ALGO_RANDOMWALKEXECUTOR_H_
+#define GRAPH_EXECUTOR_ALGO_RANDOMWALKEXECUTOR_H_
+
+#include "graph/executor/StorageAccessExecutor.h"
+#include "graph/planner/plan/Algo.h"
+
+// RandomWalk advances all the walks by one step each getNeighbors, so the number of requests is
+// the number of steps rather than the number of walks times the steps.
+//
+// The walks at the same vertex are grouped. For a uniform walk the neighbors are sampled in storage
+// by GetNeighborsSampleNode, at most the size of the largest group for each vertex, and the walks
+// of a group take the samples round-robin from a random offset, so each of them goes to any
+// neighbor by the same chance.
+//
+// A walk biased by p and q like node2vec needs to know whether the candidate is a neighbor of the
+// vertex it comes from, so the whole neighbors of the vertices walked are fetched once and cached.
+// The candidate is drawn uniformly and accepted by the chance of its weight, i.e. 1/p back to the
+// previous vertex, 1 to the common neighbors, and 1/q to the others, over the max weight.
+//
+// A walk ends early at the vertex without any neighbor over the edges.
+namespace nebula {
+namespace graph {
+
+class RandomWalkExecutor final : public StorageAccessExecutor {
+ public:
+  using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
+
+  RandomWalkExecutor(const PlanNode* node, QueryContext* qctx)
+      : StorageAccessExecutor("RandomWalkExecutor", node, qctx) {
+    walk_ = asNode<RandomWalk>(node);
+  }
+
+  folly::Future<Status> execute() override;
+
+ private:
+  struct Neighbors {
+    std::vector<Value> dsts;
+    std::unordered_set<Value> dstSet;
+  };
+
+  folly::Future<Status> walk();
+
+  folly::Future<Status> getNeighbors(std::vector<Value> vids, int64_t limit);
+
+  Status handleResponse(RpcResponse&& resps);
+
+  // The dsts of each src in the response
+  std::unordered_map<Value, std::vector<Value>> collectNeighbors(RpcResponse&& resps);
+
+  // Move the walks by the dsts sampled in storage
+  void uniformStep(std::unordered_map<Value, std::vector<Value>>&& samples);
+
+  // Move the walks by the cached neighbors
+  void biasedStep();
+
+  // The next vertex of the walk at the vertex with the neighbors, by rejection sampling
+  const Value& biasedNext(const List& walk, const Neighbors& neighbors);
+
+  folly::Future<Status> buildResult();
+
+ private:
+  const RandomWalk* walk_{nullptr};
+  size_t currentStep_{1};
+  std::vector<List> walks_;
+  // the indexes of the walks not ended
+  std::vector<size_t> active_;
+  // the walks in active_ grouped by the vertex they are at
+  std::unordered_map<Value, std::vector<size_t>> groups_;
+  // the whole neighbors of the vertices walked, only for the biased walk
+  std::unordered_map<Value, Neighbors> neighbors_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_EXECUTOR_ALGO_RANDOMWALKEXECUTOR_H_
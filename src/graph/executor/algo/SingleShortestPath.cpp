@@ -55,16 +55,22 @@ void SingleShortestPath::init(const HashSet& startVids, const HashSet& endVids,
   leftVisitedVids_.resize(rowSize);
   rightVisitedVids_.resize(rowSize);
 
-  allLeftPaths_.resize(rowSize);
+  allLeftPaths_.reserve(rowSize);
   allRightPaths_.reserve(rowSize);
+  leftDegrees_.resize(rowSize, 1.0);
+  rightDegrees_.resize(rowSize, 1.0);
   resultDs_.resize(rowSize);
   for (const auto& startVid : startVids) {
     HashSet srcVid({startVid});
     for (const auto& endVid : endVids) {
-      robin_hood::unordered_flat_map<Value, std::vector<Row>, std::hash<Value>> steps;
-      std::vector<Row> dummy;
-      steps.emplace(endVid, std::move(dummy));
-      HalfPath originRightPath({std::move(steps)});
+      robin_hood::unordered_flat_map<Value, std::vector<Row>, std::hash<Value>> srcSteps;
+      srcSteps.emplace(startVid, std::vector<Row>());
+      HalfPath originLeftPath({std::move(srcSteps)});
+      allLeftPaths_.emplace_back(std::move(originLeftPath));
+
+      robin_hood::unordered_flat_map<Value, std::vector<Row>, std::hash<Value>> dstSteps;
+      dstSteps.emplace(endVid, std::vector<Row>());
+      HalfPath originRightPath({std::move(dstSteps)});
       allRightPaths_.emplace_back(std::move(originRightPath));
 
       HashSet dstVid({endVid});
@@ -75,29 +81,15 @@ void SingleShortestPath::init(const HashSet& startVids, const HashSet& endVids,
 }
 
 folly::Future<Status> SingleShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
-  std::vector<folly::Future<Status>> futures;
-  futures.reserve(2);
-  futures.emplace_back(getNeighbors(rowNum, stepNum, false));
-  futures.emplace_back(getNeighbors(rowNum, stepNum, true));
-  return folly::collectAll(futures)
+  auto reverse = expandReverse(rowNum);
+  return getNeighbors(rowNum, stepNum, reverse)
       .via(runner())
-      .thenValue([this, rowNum, stepNum](std::vector<folly::Try<Status>>&& resps) {
+      .thenValue([this, rowNum, stepNum, reverse](Status&& resp) {
         memory::MemoryCheckGuard guard;
-        for (auto& respVal : resps) {
-          if (respVal.hasException()) {
-            auto ex = respVal.exception().get_exception<std::bad_alloc>();
-            if (ex) {
-              throw std::bad_alloc();
-            } else {
-              throw std::runtime_error(respVal.exception().what().c_str());
-            }
-          }
-          auto resp = std::move(respVal).value();
-          if (!resp.ok()) {
-            return folly::makeFuture<Status>(std::move(resp));
-          }
+        if (!resp.ok()) {
+          return folly::makeFuture<Status>(std::move(resp));
         }
-        return handleResponse(rowNum, stepNum);
+        return handleResponse(rowNum, stepNum, reverse);
       })
       .thenError(folly::tag_t<std::bad_alloc>{},
                  [](const std::bad_alloc&) {
@@ -108,6 +100,16 @@ folly::Future<Status> SingleShortestPath::shortestPath(size_t rowNum, size_t ste
       });
 }
 
+bool SingleShortestPath::expandReverse(size_t rowNum) const {
+  auto leftEdges = leftVids_[rowNum].size() * leftDegrees_[rowNum];
+  auto rightEdges = rightVids_[rowNum].size() * rightDegrees_[rowNum];
+  if (leftEdges != rightEdges) {
+    return rightEdges < leftEdges;
+  }
+  // Take turns when they are even, so that both sides move forward on regular graphs
+  return allRightPaths_[rowNum].size() < allLeftPaths_[rowNum].size();
+}
+
 folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
                                                        size_t stepNum,
                                                        bool reverse) {
@@ -120,6 +122,7 @@ folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
   auto& inputVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   std::vector<Value> vids(inputVids.begin(), inputVids.end());
   inputVids.clear();
+  auto vidCnt = vids.size();
   return storageClient
       ->getNeighbors(param,
                      {nebula::kVid},
@@ -137,14 +140,17 @@ folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
                      nullptr,
                      nullptr)
       .via(runner())
-      .thenValue([this, rowNum, stepNum, getNbrTime, reverse](auto&& resp) {
+      .thenValue([this, rowNum, stepNum, getNbrTime, reverse, vidCnt](auto&& resp) {
         memory::MemoryCheckGuard guard;
         addStats(resp, stepNum, getNbrTime.elapsedInUSec(), reverse);
-        return buildPath(rowNum, std::move(resp), reverse);
+        return buildPath(rowNum, std::move(resp), reverse, vidCnt);
       });
 }
 
-Status SingleShortestPath::buildPath(size_t rowNum, RpcResponse&& resps, bool reverse) {
+Status SingleShortestPath::buildPath(size_t rowNum,
+                                     RpcResponse&& resps,
+                                     bool reverse,
+                                     size_t vidCnt) {
   auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
   NG_RETURN_IF_ERROR(result);
   auto& responses = std::move(resps).responses();
@@ -159,10 +165,13 @@ Status SingleShortestPath::buildPath(size_t rowNum, RpcResponse&& resps, bool re
   }
   auto listVal = std::make_shared<Value>(std::move(list));
   auto iter = std::make_unique<GetNeighborsIter>(listVal);
-  return doBuildPath(rowNum, iter.get(), reverse);
+  return doBuildPath(rowNum, iter.get(), reverse, vidCnt);
 }
 
-Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse) {
+Status SingleShortestPath::doBuildPath(size_t rowNum,
+                                       GetNeighborsIter* iter,
+                                       bool reverse,
+                                       size_t vidCnt) {
   auto iterSize = iter->size();
   auto& visitedVids = reverse ? rightVisitedVids_[rowNum] : leftVisitedVids_[rowNum];
   visitedVids.reserve(visitedVids.size() + iterSize);
@@ -173,12 +182,14 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
   auto& nextStepVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   nextStepVids.reserve(iterSize);
 
+  size_t edgeCnt = 0;
   QueryExpressionContext ctx(qctx_->ectx());
   for (iter->reset(); iter->valid(); iter->next()) {
     auto edgeVal = iter->getEdge();
     if (UNLIKELY(!edgeVal.isEdge())) {
       continue;
     }
+    ++edgeCnt;
     auto& edge = edgeVal.getEdge();
     auto& dst = edge.dst;
     if (visitedVids.find(dst) != visitedVids.end()) {
@@ -200,22 +211,28 @@ Status SingleShortestPath::doBuildPath(size_t rowNum, GetNeighborsIter* iter, bo
     }
   }
   visitedVids.insert(nextStepVids.begin(), nextStepVids.end());
+  auto& degree = reverse ? rightDegrees_[rowNum] : leftDegrees_[rowNum];
+  degree = vidCnt == 0 ? 0.0 : static_cast<double>(edgeCnt) / vidCnt;
   return Status::OK();
 }
 
-folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t stepNum) {
+folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum,
+                                                         size_t stepNum,
+                                                         bool reverse) {
   return folly::makeFuture<Status>(Status::OK())
       .via(runner())
-      .thenValue([this, rowNum, stepNum](auto&& status) {
+      .thenValue([this, rowNum, reverse](auto&& status) {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
 
         UNUSED(status);
-        return conjunctPath(rowNum, stepNum);
+        return conjunctPath(rowNum, reverse);
       })
       .thenValue([this, rowNum, stepNum](auto&& result) {
         memory::MemoryCheckGuard guard;
-        if (result || stepNum * 2 >= maxStep_) {
+        // The steps of the path if both sides meet in the next step
+        auto pathSteps = allLeftPaths_[rowNum].size() + allRightPaths_[rowNum].size() - 1;
+        if (result || pathSteps > maxStep_) {
           return folly::makeFuture<Status>(Status::OK());
         }
         auto& leftVids = leftVids_[rowNum];
@@ -227,67 +244,44 @@ folly::Future<Status> SingleShortestPath::handleResponse(size_t rowNum, size_t s
       });
 }
 
-folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, size_t stepNum) {
-  const auto& leftStep = allLeftPaths_[rowNum].back();
-  const auto& prevRightStep = allRightPaths_[rowNum][stepNum - 1];
+folly::Future<bool> SingleShortestPath::conjunctPath(size_t rowNum, bool reverse) {
+  const auto& paths = reverse ? allRightPaths_[rowNum] : allLeftPaths_[rowNum];
+  const auto& otherPaths = reverse ? allLeftPaths_[rowNum] : allRightPaths_[rowNum];
+  const auto& currentStep = paths.back();
+  // The vids of the other side visited in previous steps may be reached as well, only those of
+  // the smallest step make the shortest paths
+  auto otherStep = otherPaths.size();
   std::vector<Value> meetVids;
-  for (const auto& step : leftStep) {
-    if (prevRightStep.find(step.first) != prevRightStep.end()) {
-      meetVids.push_back(step.first);
-      if (singleShortest_) {
-        break;
+  for (const auto& step : currentStep) {
+    for (size_t i = 0; i < otherPaths.size() && i <= otherStep; ++i) {
+      if (otherPaths[i].find(step.first) == otherPaths[i].end()) {
+        continue;
       }
-    }
-  }
-  if (!meetVids.empty()) {
-    buildOddPath(rowNum, meetVids);
-    return folly::makeFuture<bool>(true);
-  }
-  if (stepNum * 2 > maxStep_) {
-    return folly::makeFuture<bool>(false);
-  }
-
-  const auto& rightStep = allRightPaths_[rowNum].back();
-  for (const auto& step : leftStep) {
-    if (rightStep.find(step.first) != rightStep.end()) {
-      meetVids.push_back(step.first);
-      if (singleShortest_) {
-        break;
+      if (i < otherStep) {
+        otherStep = i;
+        meetVids.clear();
       }
+      meetVids.push_back(step.first);
+      break;
     }
   }
   if (meetVids.empty()) {
     return folly::makeFuture<bool>(false);
   }
-  return buildEvenPath(rowNum, meetVids);
-}
-
-void SingleShortestPath::buildOddPath(size_t rowNum, const std::vector<Value>& meetVids) {
-  for (auto& meetVid : meetVids) {
-    auto leftPaths = createLeftPath(rowNum, meetVid);
-    auto rightPaths = createRightPath(rowNum, meetVid, true);
-    for (auto& leftPath : leftPaths) {
-      for (auto& rightPath : rightPaths) {
-        Row path = leftPath;
-        auto& steps = path.values.back().mutableList().values;
-        steps.insert(steps.end(), rightPath.values.begin(), rightPath.values.end() - 1);
-        if (hasSameEdge(steps)) {
-          continue;
-        }
-        path.emplace_back(rightPath.values.back());
-        resultDs_[rowNum].rows.emplace_back(std::move(path));
-        if (singleShortest_) {
-          return;
-        }
-      }
-    }
+  if (singleShortest_) {
+    meetVids.resize(1);
   }
+  auto currentStepNum = paths.size() - 1;
+  return reverse ? buildPaths(rowNum, meetVids, otherStep, currentStepNum)
+                 : buildPaths(rowNum, meetVids, currentStepNum, otherStep);
 }
 
-folly::Future<bool> SingleShortestPath::buildEvenPath(size_t rowNum,
-                                                      const std::vector<Value>& meetVids) {
+folly::Future<bool> SingleShortestPath::buildPaths(size_t rowNum,
+                                                   const std::vector<Value>& meetVids,
+                                                   size_t leftStep,
+                                                   size_t rightStep) {
   auto future = getMeetVidsProps(meetVids);
-  return future.via(runner()).thenValue([this, rowNum](auto&& vertices) {
+  return future.via(runner()).thenValue([this, rowNum, leftStep, rightStep](auto&& vertices) {
     // MemoryTrackerVerified
     memory::MemoryCheckGuard guard;
 
@@ -298,19 +292,21 @@ folly::Future<bool> SingleShortestPath::buildEvenPath(size_t rowNum,
       if (!meetVertex.isVertex()) {
         continue;
       }
-      auto meetVid = meetVertex.getVertex().vid;
-      auto leftPaths = createLeftPath(rowNum, meetVid);
-      auto rightPaths = createRightPath(rowNum, meetVid, false);
+      auto leftPaths = createLeftPath(rowNum, meetVertex, leftStep);
+      auto rightPaths = createRightPath(rowNum, meetVertex, rightStep);
       for (auto& leftPath : leftPaths) {
         for (auto& rightPath : rightPaths) {
-          Row path = leftPath;
-          auto& steps = path.values.back().mutableList().values;
-          steps.emplace_back(meetVertex);
-          steps.insert(steps.end(), rightPath.values.begin(), rightPath.values.end() - 1);
+          // [src, edge, vertex, ..., edge, dst]
+          std::vector<Value> values = leftPath;
+          values.insert(values.end(), rightPath.begin(), rightPath.end());
+          std::vector<Value> steps(values.begin() + 1, values.end() - 1);
           if (hasSameEdge(steps)) {
             continue;
           }
-          path.emplace_back(rightPath.values.back());
+          Row path;
+          path.emplace_back(values.front());
+          path.emplace_back(List(std::move(steps)));
+          path.emplace_back(values.back());
           resultDs_[rowNum].rows.emplace_back(std::move(path));
           if (singleShortest_) {
             return true;
@@ -322,78 +318,54 @@ folly::Future<bool> SingleShortestPath::buildEvenPath(size_t rowNum,
   });
 }
 
-std::vector<Row> SingleShortestPath::createLeftPath(size_t rowNum, const Value& meetVid) {
+std::vector<std::vector<Value>> SingleShortestPath::createLeftPath(size_t rowNum,
+                                                                   const Value& meetVertex,
+                                                                   size_t step) {
   auto& allSteps = allLeftPaths_[rowNum];
-  auto& lastSteps = allSteps.back();
-  auto findMeetVid = lastSteps.find(meetVid);
-  std::vector<Row> leftPaths(findMeetVid->second);
-  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend(); ++stepIter) {
-    std::vector<Row> temp;
+  std::vector<std::vector<Value>> leftPaths({{}});
+  for (; step > 0; --step) {
+    std::vector<std::vector<Value>> temp;
     for (auto& leftPath : leftPaths) {
-      Value id = leftPath.values.front().getVertex().vid;
-      auto findId = stepIter->find(id);
-      for (auto& step : findId->second) {
+      const auto& id = leftPath.empty() ? meetVertex.getVertex().vid
+                                        : leftPath.front().getVertex().vid;
+      auto findId = allSteps[step].find(id);
+      if (findId == allSteps[step].end()) {
+        continue;
+      }
+      for (auto& customStep : findId->second) {
         auto newPath = leftPath;
-        newPath.values.insert(newPath.values.begin(), step.values.begin(), step.values.end());
+        newPath.insert(newPath.begin(), customStep.values.begin(), customStep.values.end());
         temp.emplace_back(std::move(newPath));
       }
     }
     leftPaths.swap(temp);
   }
-  std::vector<Row> result;
-  result.reserve(leftPaths.size());
-  for (auto& path : leftPaths) {
-    Row row;
-    auto src = path.values.front();
-    path.values.erase(path.values.begin());
-    row.emplace_back(std::move(src));
-    row.emplace_back(std::move(path));
-    result.emplace_back(std::move(row));
-  }
-  return result;
+  return leftPaths;
 }
 
-std::vector<Row> SingleShortestPath::createRightPath(size_t rowNum,
-                                                     const Value& meetVid,
-                                                     bool oddStep) {
+std::vector<std::vector<Value>> SingleShortestPath::createRightPath(size_t rowNum,
+                                                                    const Value& meetVertex,
+                                                                    size_t step) {
   auto& allSteps = allRightPaths_[rowNum];
-  std::vector<Row> rightPaths;
-  auto& lastSteps = allSteps.back();
-  if (oddStep) {
-    for (auto& steps : lastSteps) {
-      bool flag = false;
-      for (auto& step : steps.second) {
-        auto& vertex = step.values.front();
-        if (vertex.getVertex().vid == meetVid) {
-          rightPaths.emplace_back(Row({vertex}));
-          flag = true;
-          break;
-        }
-      }
-      if (flag) {
-        break;
-      }
-    }
-  } else {
-    auto findMeetVid = lastSteps.find(meetVid);
-    rightPaths = findMeetVid->second;
-  }
-  for (auto stepIter = allSteps.rbegin() + 1; stepIter != allSteps.rend() - 1; ++stepIter) {
-    std::vector<Row> temp;
+  std::vector<std::vector<Value>> rightPaths({{meetVertex}});
+  for (; step > 0; --step) {
+    std::vector<std::vector<Value>> temp;
     for (auto& rightPath : rightPaths) {
-      Value id = rightPath.values.front().getVertex().vid;
-      auto findId = stepIter->find(id);
-      for (auto& step : findId->second) {
+      const auto& id = rightPath.back().getVertex().vid;
+      auto findId = allSteps[step].find(id);
+      if (findId == allSteps[step].end()) {
+        continue;
+      }
+      // the custom step of the right side is [vertex(d), edge(d->c)] of the dst c
+      for (auto& customStep : findId->second) {
         auto newPath = rightPath;
-        newPath.values.insert(newPath.values.begin(), step.values.begin(), step.values.end());
+        newPath.emplace_back(customStep.values.back());
+        newPath.emplace_back(customStep.values.front());
         temp.emplace_back(std::move(newPath));
       }
     }
     rightPaths.swap(temp);
   }
-  for (auto& path : rightPaths) {
-    std::reverse(path.values.begin(), path.values.end());
-  }
   return rightPaths;
 }
 
@@ -10,6 +10,11 @@
 namespace nebula {
 namespace graph {
 
+// Expand one side of the path each step, the side with less edges to fetch estimated by its
+// frontier and the average degree of its last expansion, as the frontiers of the two sides usually
+// grow very differently. The vids reached by the expanded side are checked against all vids
+// visited by the other side, the paths are found once they meet.
+// The step 0 of each HalfPath is the start or end vid with no steps.
 class SingleShortestPath final : public ShortestPathBase {
  public:
   using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
@@ -30,29 +35,42 @@ class SingleShortestPath final : public ShortestPathBase {
 
   folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
 
-  folly::Future<Status> getNeighbors(size_t rowNum, size_t stepNum, bool reverse);
+  // Whether to expand the right side in the next step
+  bool expandReverse(size_t rowNum) const;
 
-  Status buildPath(size_t rowNum, RpcResponse&& resps, bool reverse);
+  folly::Future<Status> getNeighbors(size_t rowNum, size_t stepNum, bool reverse);
 
-  Status doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse);
+  Status buildPath(size_t rowNum, RpcResponse&& resps, bool reverse, size_t vidCnt);
 
-  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum);
+  Status doBuildPath(size_t rowNum, GetNeighborsIter* iter, bool reverse, size_t vidCnt);
 
-  folly::Future<bool> conjunctPath(size_t rowNum, size_t stepNum);
+  folly::Future<Status> handleResponse(size_t rowNum, size_t stepNum, bool reverse);
 
-  folly::Future<bool> buildEvenPath(size_t rowNum, const std::vector<Value>& meetVids);
+  folly::Future<bool> conjunctPath(size_t rowNum, bool reverse);
 
-  void buildOddPath(size_t rowNum, const std::vector<Value>& meetVids);
+  folly::Future<bool> buildPaths(size_t rowNum,
+                                 const std::vector<Value>& meetVids,
+                                 size_t leftStep,
+                                 size_t rightStep);
 
-  std::vector<Row> createRightPath(size_t rowNum, const Value& meetVid, bool evenStep);
+  // Paths from the start vid to meetVertex, eg [vertex(a), edge(a->b), vertex(b), edge(b->c)]
+  std::vector<std::vector<Value>> createLeftPath(size_t rowNum,
+                                                 const Value& meetVertex,
+                                                 size_t step);
 
-  std::vector<Row> createLeftPath(size_t rowNum, const Value& meetVid);
+  // Paths from meetVertex to the end vid, eg [vertex(c), edge(c->d), vertex(d)]
+  std::vector<std::vector<Value>> createRightPath(size_t rowNum,
+                                                  const Value& meetVertex,
+                                                  size_t step);
 
  private:
   std::vector<HashSet> leftVisitedVids_;
   std::vector<HashSet> rightVisitedVids_;
   std::vector<HalfPath> allLeftPaths_;
   std::vector<HalfPath> allRightPaths_;
+  // Average degree of the vids expanded last time of each side
+  std::vector<double> leftDegrees_;
+  std::vector<double> rightDegrees_;
 };
 
 }  // namespace graph
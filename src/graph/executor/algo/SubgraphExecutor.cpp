@@ -80,8 +80,8 @@ folly::Future<Status> SubgraphExecutor::handleResponse(RpcResponse&& resps) {
   auto& responses = resps.responses();
   List list;
   for (auto& resp : responses) {
-    auto dataset = resp.get_vertices();
-    if (dataset == nullptr) {
+    auto dataset = resp.vertices_ref();
+    if (!dataset.has_value()) {
       continue;
     }
     list.values.emplace_back(std::move(*dataset));
@@ -105,7 +105,8 @@ void SubgraphExecutor::filterEdges(int version) {
     auto* gnIter = static_cast<GetNeighborsIter*>(iterPtr);
     while (gnIter->valid()) {
       const auto& dst = gnIter->getEdgeProp("*", nebula::kDst);
-      if (validVids_.find(dst) == validVids_.end()) {
+      auto id = visited_.find(dst);
+      if (id == VidInterner::kInvalidId || !validIds_.contains(id)) {
         auto edge = gnIter->getEdge();
         gnIter->erase();
       } else {
@@ -128,17 +129,18 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   ResultBuilder builder;
   builder.value(iter->valuePtr());
 
-  HashMap currentVids;
-  currentVids.reserve(gnSize);
-  historyVids_.reserve(historyVids_.size() + gnSize);
+  // the vids visited in this step with their steps, merged into visitedSteps_ after the step
+  DenseIdSet currentIds;
+  std::vector<std::pair<Id, uint32_t>> currentSteps;
+  currentSteps.reserve(gnSize);
   auto startVids = iter->vids();
-  if (currentStep_ == 1) {
-    for (auto& startVid : startVids) {
-      currentVids.emplace(startVid, 0);
+  for (auto& startVid : startVids) {
+    auto id = visited_.intern(startVid);
+    if (currentStep_ == 1 && currentIds.insert(id)) {
+      currentSteps.emplace_back(id, 0);
     }
+    validIds_.insert(id);
   }
-  validVids_.insert(std::make_move_iterator(startVids.begin()),
-                    std::make_move_iterator(startVids.end()));
   auto& biDirectEdgeTypes = subgraph_->biDirectEdgeTypes();
   while (iter->valid()) {
     const auto& dst = iter->getEdgeProp("*", nebula::kDst);
@@ -147,8 +149,8 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
       iter->next();
       continue;
     }
-    auto findIter = historyVids_.find(dst);
-    if (findIter != historyVids_.end()) {
+    auto id = visited_.find(dst);
+    if (id != VidInterner::kInvalidId && isVisited(id)) {
       if (biDirectEdgeTypes.empty()) {
         iter->next();
       } else {
@@ -159,7 +161,7 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         }
         auto type = typeVal.getInt();
         if (biDirectEdgeTypes.find(type) != biDirectEdgeTypes.end()) {
-          if (type < 0 || findIter->second + 2 == currentStep_) {
+          if (type < 0 || visitedSteps_[id] + 2 == currentStep_) {
             iter->erase();
           } else {
             iter->next();
@@ -173,9 +175,13 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         iter->erase();
         continue;
       }
-      if (currentVids.emplace(dst, currentStep_).second) {
+      if (id == VidInterner::kInvalidId) {
+        id = visited_.intern(dst);
+      }
+      if (currentIds.insert(id)) {
+        currentSteps.emplace_back(id, currentStep_);
         // next vids for getNeighbor
-        vids_.emplace_back(std::move(dst));
+        vids_.emplace_back(dst);
       }
       iter->next();
     }
@@ -183,9 +189,11 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   iter->reset();
   builder.iter(std::move(iter));
   finish(builder.build());
-  // update historyVids
-  historyVids_.insert(std::make_move_iterator(currentVids.begin()),
-                      std::make_move_iterator(currentVids.end()));
+  // update visitedSteps
+  visitedSteps_.resize(visited_.size(), kUnvisited);
+  for (const auto& [id, step] : currentSteps) {
+    visitedSteps_[id] = step;
+  }
   if (currentStep_ != 1 && subgraph_->tagFilter()) {
     filterEdges(-1);
   }
@@ -5,10 +5,9 @@
 #ifndef GRAPH_EXECUTOR_ALGO_SUBGRAPHEXECUTOR_H_
 #define GRAPH_EXECUTOR_ALGO_SUBGRAPHEXECUTOR_H_
 
-#include <robin_hood.h>
-
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Algo.h"
+#include "graph/util/VidInterner.h"
 
 // Subgraph receive result from GetNeighbors
 // There are two Main functions
@@ -16,9 +15,13 @@
 // Second: Delete previously visited edges and save the result(iter) to the variable `resultVar`
 //
 // Member:
-// `historyVids_` : is hash table
-//    KEY   : the VID of the visited destination Vertex
-//    VALUE : the number of steps to visit the KEY (starting vertex is 0)
+// `visited_` : interns the VIDs of the visited destination Vertex to dense ids
+// `visitedSteps_` : indexed by the id, the number of steps to visit the vertex (starting vertex is
+// 0), kUnvisited if it's interned in the current step and not merged yet
+// `validIds_` : the ids of the vertices returned by GetNeighbors, i.e. they exist and pass the tag
+// filter
+// Each step is finished as a version of the output, so only the vids interned and the flat arrays
+// indexed by them are kept between the steps
 // since each vertex will only be visited once, if it is a one-way edge expansion, there will be no
 // duplicate edges. we only need to focus on the case of two-way expansion
 //
@@ -44,8 +47,7 @@ using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsRespo
 
 class SubgraphExecutor : public StorageAccessExecutor {
  public:
-  using HashMap = robin_hood::unordered_flat_map<Value, size_t, std::hash<Value>>;
-  using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
+  using Id = VidInterner::Id;
 
   SubgraphExecutor(const PlanNode* node, QueryContext* qctx)
       : StorageAccessExecutor("SubgraphExecutor", node, qctx) {
@@ -64,13 +66,21 @@ class SubgraphExecutor : public StorageAccessExecutor {
   folly::Future<Status> handleResponse(RpcResponse&& resps);
 
  private:
-  HashMap historyVids_;
+  static constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+
+  // whether the vertex of id is visited before the current step
+  bool isVisited(Id id) const {
+    return id < visitedSteps_.size() && visitedSteps_[id] != kUnvisited;
+  }
+
+  VidInterner visited_;
+  std::vector<uint32_t> visitedSteps_;
   const Subgraph* subgraph_{nullptr};
   size_t currentStep_{1};
   size_t totalSteps_{1};
   std::vector<Value> vids_;
   // save vids already visited
-  HashSet validVids_;
+  DenseIdSet validIds_;
 };
 
 }  // namespace graph
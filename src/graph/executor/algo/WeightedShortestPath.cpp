@@ -0,0 +1,357 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+#include "graph/executor/algo/WeightedShortestPath.h"
+
+#include "graph/service/GraphFlags.h"
+
+using nebula::storage::StorageClient;
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> WeightedShortestPath::execute(const HashSet& startVids,
+                                                    const HashSet& endVids,
+                                                    DataSet* result) {
+  if (maxStep_ == 0) {
+    return Status::OK();
+  }
+  size_t rowSize = startVids.size() * endVids.size();
+  init(startVids, endVids, rowSize);
+  std::vector<folly::Future<Status>> futures;
+  futures.reserve(rowSize);
+  for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
+    resultDs_[rowNum].colNames = pathNode_->colNames();
+    futures.emplace_back(shortestPath(rowNum, 1));
+  }
+  return folly::collectAll(futures).via(runner()).thenValue(
+      [this, result](std::vector<folly::Try<Status>>&& resps) {
+        memory::MemoryCheckGuard guard;
+        for (auto& respVal : resps) {
+          if (respVal.hasException()) {
+            auto ex = respVal.exception().get_exception<std::bad_alloc>();
+            if (ex) {
+              throw std::bad_alloc();
+            } else {
+              throw std::runtime_error(respVal.exception().what().c_str());
+            }
+          }
+          auto resp = std::move(respVal).value();
+          NG_RETURN_IF_ERROR(resp);
+        }
+        result->colNames = pathNode_->colNames();
+        for (auto& ds : resultDs_) {
+          result->append(std::move(ds));
+        }
+        return Status::OK();
+      });
+}
+
+void WeightedShortestPath::init(const HashSet& startVids, const HashSet& endVids, size_t rowSize) {
+  leftPaths_.resize(rowSize);
+  rightPaths_.resize(rowSize);
+  meets_.resize(rowSize);
+  resultDs_.resize(rowSize);
+  size_t rowNum = 0;
+  for (const auto& startVid : startVids) {
+    for (const auto& endVid : endVids) {
+      Label start;
+      start.vid = startVid;
+      addLabel(leftPaths_[rowNum], std::move(start));
+      Label end;
+      end.vid = endVid;
+      addLabel(rightPaths_[rowNum], std::move(end));
+      ++rowNum;
+    }
+  }
+}
+
+folly::Future<Status> WeightedShortestPath::shortestPath(size_t rowNum, size_t stepNum) {
+  bool reverse = false;
+  std::vector<size_t> labels;
+  while (labels.empty()) {
+    if (finished(rowNum)) {
+      return buildResult(rowNum);
+    }
+    // Expand the side of less labels queued, which usually has less edges to fetch
+    reverse = rightPaths_[rowNum].queue.size() < leftPaths_[rowNum].queue.size();
+    labels = popLabels(rowNum, reverse);
+  }
+  return getNeighbors(rowNum, stepNum, reverse, std::move(labels))
+      .via(runner())
+      .thenValue([this, rowNum, stepNum](Status&& resp) {
+        memory::MemoryCheckGuard guard;
+        if (!resp.ok()) {
+          return folly::makeFuture<Status>(std::move(resp));
+        }
+        return shortestPath(rowNum, stepNum + 1);
+      })
+      .thenError(folly::tag_t<std::bad_alloc>{},
+                 [](const std::bad_alloc&) {
+                   return folly::makeFuture<Status>(Executor::memoryExceededStatus());
+                 })
+      .thenError(folly::tag_t<std::exception>{}, [](const std::exception& e) {
+        return folly::makeFuture<Status>(std::runtime_error(e.what()));
+      });
+}
+
+double WeightedShortestPath::topDist(HalfPath& half) {
+  auto& queue = half.queue;
+  while (!queue.empty() && half.labels[queue.top().second].dominated) {
+    queue.pop();
+  }
+  return queue.empty() ? std::numeric_limits<double>::infinity() : queue.top().first;
+}
+
+bool WeightedShortestPath::finished(size_t rowNum) {
+  auto leftDist = topDist(leftPaths_[rowNum]);
+  auto rightDist = topDist(rightPaths_[rowNum]);
+  if (std::isinf(leftDist) || std::isinf(rightDist)) {
+    return true;
+  }
+  return leftDist + rightDist >= meets_[rowNum].dist;
+}
+
+std::vector<size_t> WeightedShortestPath::popLabels(size_t rowNum, bool reverse) {
+  auto& half = reverse ? rightPaths_[rowNum] : leftPaths_[rowNum];
+  auto bestDist = meets_[rowNum].dist;
+  auto batchSize = std::max<size_t>(FLAGS_weighted_path_batch_size, 1);
+  std::unordered_set<Value> vids;
+  std::vector<size_t> labels;
+  while (!half.queue.empty()) {
+    auto idx = half.queue.top().second;
+    const auto& label = half.labels[idx];
+    if (vids.size() >= batchSize && vids.find(label.vid) == vids.end()) {
+      break;
+    }
+    half.queue.pop();
+    // The label can't make a path within the max steps or shorter than the one found
+    if (label.dominated || label.steps >= maxStep_ || label.dist >= bestDist) {
+      continue;
+    }
+    vids.emplace(label.vid);
+    labels.emplace_back(idx);
+  }
+  return labels;
+}
+
+folly::Future<Status> WeightedShortestPath::getNeighbors(size_t rowNum,
+                                                         size_t stepNum,
+                                                         bool reverse,
+                                                         std::vector<size_t> labels) {
+  StorageClient* storageClient = qctx_->getStorageClient();
+  time::Duration getNbrTime;
+  storage::StorageClient::CommonRequestParam param(pathNode_->space(),
+                                                   qctx_->rctx()->session()->id(),
+                                                   qctx_->plan()->id(),
+                                                   qctx_->plan()->isProfileEnabled());
+  auto& half = reverse ? rightPaths_[rowNum] : leftPaths_[rowNum];
+  HashSet uniqueVids;
+  std::vector<Value> vids;
+  for (auto idx : labels) {
+    const auto& vid = half.labels[idx].vid;
+    if (uniqueVids.emplace(vid).second) {
+      vids.emplace_back(vid);
+    }
+  }
+  return storageClient
+      ->getNeighbors(param,
+                     {nebula::kVid},
+                     std::move(vids),
+                     {},
+                     pathNode_->edgeDirection(),
+                     nullptr,
+                     nullptr,
+                     reverse ? pathNode_->reverseEdgeProps() : pathNode_->edgeProps(),
+                     nullptr,
+                     false,
+                     false,
+                     {},
+                     -1,
+                     nullptr,
+                     nullptr)
+      .via(runner())
+      .thenValue([this, rowNum, stepNum, getNbrTime, reverse, labels = std::move(labels)](
+                     RpcResponse&& resps) {
+        memory::MemoryCheckGuard guard;
+        addStats(resps, stepNum, getNbrTime.elapsedInUSec(), reverse);
+        auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
+        NG_RETURN_IF_ERROR(result);
+        List list;
+        for (auto& resp : resps.responses()) {
+          auto dataset = resp.get_vertices();
+          if (dataset == nullptr) {
+            continue;
+          }
+          list.values.emplace_back(std::move(*dataset));
+        }
+        auto listVal = std::make_shared<Value>(std::move(list));
+        auto iter = std::make_unique<GetNeighborsIter>(listVal);
+        return doBuildPath(rowNum, iter.get(), reverse, labels);
+      });
+}
+
+Status WeightedShortestPath::doBuildPath(size_t rowNum,
+                                         GetNeighborsIter* iter,
+                                         bool reverse,
+                                         const std::vector<size_t>& labels) {
+  auto& half = reverse ? rightPaths_[rowNum] : leftPaths_[rowNum];
+  std::unordered_map<Value, std::vector<size_t>> srcLabels;
+  for (auto idx : labels) {
+    srcLabels[half.labels[idx].vid].emplace_back(idx);
+  }
+  for (iter->reset(); iter->valid(); iter->next()) {
+    auto edgeVal = iter->getEdge();
+    if (UNLIKELY(!edgeVal.isEdge())) {
+      continue;
+    }
+    const auto& edge = edgeVal.getEdge();
+    double weight = 0;
+    if (!weightOf(edge, weight)) {
+      continue;
+    }
+    if (weight < 0) {
+      return Status::Error("The weight `%s' of shortestPath is negative: %s",
+                           pathNode_->weightProp().c_str(),
+                           edge.toString().c_str());
+    }
+    auto found = srcLabels.find(edge.src);
+    if (found == srcLabels.end()) {
+      continue;
+    }
+    for (auto parent : found->second) {
+      // Copy the fields of parent, the labels may be reallocated when a new one is added
+      Label label;
+      label.vid = edge.dst;
+      label.dist = half.labels[parent].dist + weight;
+      label.steps = half.labels[parent].steps + 1;
+      label.parent = parent;
+      label.edge = edgeVal;
+      auto idx = addLabel(half, std::move(label));
+      if (idx >= 0) {
+        meet(rowNum, reverse, idx);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+int64_t WeightedShortestPath::addLabel(HalfPath& half, Label&& label) {
+  auto& ids = half.vidLabels[label.vid];
+  for (auto id : ids) {
+    const auto& other = half.labels[id];
+    if (other.steps <= label.steps && other.dist <= label.dist) {
+      return -1;
+    }
+  }
+  auto dominated = [&half, &label](size_t id) {
+    auto& other = half.labels[id];
+    if (other.steps >= label.steps && other.dist >= label.dist) {
+      other.dominated = true;
+      return true;
+    }
+    return false;
+  };
+  ids.erase(std::remove_if(ids.begin(), ids.end(), dominated), ids.end());
+  int64_t idx = half.labels.size();
+  half.queue.emplace(label.dist, idx);
+  ids.emplace_back(idx);
+  half.labels.emplace_back(std::move(label));
+  return idx;
+}
+
+void WeightedShortestPath::meet(size_t rowNum, bool reverse, size_t labelIdx) {
+  const auto& half = reverse ? rightPaths_[rowNum] : leftPaths_[rowNum];
+  const auto& other = reverse ? leftPaths_[rowNum] : rightPaths_[rowNum];
+  const auto& label = half.labels[labelIdx];
+  auto found = other.vidLabels.find(label.vid);
+  if (found == other.vidLabels.end()) {
+    return;
+  }
+  auto& best = meets_[rowNum];
+  for (auto otherIdx : found->second) {
+    const auto& otherLabel = other.labels[otherIdx];
+    if (label.steps + otherLabel.steps > maxStep_) {
+      continue;
+    }
+    auto dist = label.dist + otherLabel.dist;
+    if (dist < best.dist) {
+      best.dist = dist;
+      best.left = reverse ? otherIdx : labelIdx;
+      best.right = reverse ? labelIdx : otherIdx;
+    }
+  }
+}
+
+folly::Future<Status> WeightedShortestPath::buildResult(size_t rowNum) {
+  const auto& best = meets_[rowNum];
+  if (best.left < 0) {
+    return Status::OK();
+  }
+  // vids[i] and vids[i + 1] are connected by edges[i]
+  std::vector<Value> vids;
+  std::vector<Value> edges;
+  const auto& leftLabels = leftPaths_[rowNum].labels;
+  for (auto idx = best.left; idx >= 0; idx = leftLabels[idx].parent) {
+    vids.emplace_back(leftLabels[idx].vid);
+    if (leftLabels[idx].parent >= 0) {
+      edges.emplace_back(leftLabels[idx].edge);
+    }
+  }
+  std::reverse(vids.begin(), vids.end());
+  std::reverse(edges.begin(), edges.end());
+  const auto& rightLabels = rightPaths_[rowNum].labels;
+  for (auto idx = best.right; rightLabels[idx].parent >= 0; idx = rightLabels[idx].parent) {
+    edges.emplace_back(rightLabels[idx].edge);
+    vids.emplace_back(rightLabels[rightLabels[idx].parent].vid);
+  }
+
+  auto future = getMeetVidsProps(vids);
+  return future.via(runner()).thenValue(
+      [this, rowNum, vids = std::move(vids), edges = std::move(edges)](auto&& vertices) {
+        memory::MemoryCheckGuard guard;
+        std::unordered_map<Value, Value> vertexMap;
+        for (auto& vertex : vertices) {
+          if (vertex.isVertex()) {
+            vertexMap.emplace(vertex.getVertex().vid, vertex);
+          }
+        }
+        auto vertexOf = [&vertexMap](const Value& vid) {
+          auto found = vertexMap.find(vid);
+          return found == vertexMap.end() ? Value(Vertex(vid, {})) : found->second;
+        };
+        std::vector<Value> steps;
+        for (size_t i = 0; i < edges.size(); ++i) {
+          steps.emplace_back(edges[i]);
+          if (i + 1 < edges.size()) {
+            steps.emplace_back(vertexOf(vids[i + 1]));
+          }
+        }
+        Row path;
+        path.emplace_back(vertexOf(vids.front()));
+        path.emplace_back(List(std::move(steps)));
+        path.emplace_back(vertexOf(vids.back()));
+        resultDs_[rowNum].rows.emplace_back(std::move(path));
+        return Status::OK();
+      });
+}
+
+bool WeightedShortestPath::weightOf(const Edge& edge, double& weight) const {
+  auto found = edge.props.find(pathNode_->weightProp());
+  if (found == edge.props.end()) {
+    return false;
+  }
+  const auto& value = found->second;
+  if (value.isInt()) {
+    weight = static_cast<double>(value.getInt());
+    return true;
+  }
+  if (value.isFloat()) {
+    weight = value.getFloat();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace graph
+}  // namespace nebula
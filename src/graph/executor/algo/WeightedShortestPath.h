@@ -0,0 +1,105 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+#ifndef GRAPH_EXECUTOR_ALGO_WEIGHTEDSHORTESTPATH_H_
+#define GRAPH_EXECUTOR_ALGO_WEIGHTEDSHORTESTPATH_H_
+
+#include "graph/executor/algo/ShortestPathBase.h"
+#include "graph/planner/plan/Algo.h"
+
+// Bidirectional dijkstra taking the sum of the edge property `weightProp` as the length of the
+// path, the number of steps of the path is at most the max of the step range.
+//
+// Each side keeps the labels of the vids reached, a label is the distance from the start (or end)
+// vid with the number of steps, reached by an edge from its parent label. A vid keeps the labels
+// not dominated by the others, i.e. no other label of the vid is both shorter and of less steps,
+// as a longer label of less steps may still make a path within the max steps.
+//
+// Each step the side with less labels queued pops the shortest labels of at most
+// FLAGS_weighted_path_batch_size vids, and expands them by one getNeighbors. The labels reached
+// are checked against the labels of the other side to find the shortest path so far. A label may
+// be improved after it's expanded, then it's queued and expanded again. It stops when the shortest
+// labels queued of the two sides sum to no less than the shortest path found, as none of the
+// labels to expand would make a shorter one, or either side has nothing to expand.
+namespace nebula {
+namespace graph {
+
+class WeightedShortestPath final : public ShortestPathBase {
+ public:
+  WeightedShortestPath(const ShortestPath* node,
+                       QueryContext* qctx,
+                       std::unordered_map<std::string, std::string>* stats)
+      : ShortestPathBase(node, qctx, stats) {}
+
+  folly::Future<Status> execute(const HashSet& startVids,
+                                const HashSet& endVids,
+                                DataSet* result) override;
+
+ private:
+  struct Label {
+    Value vid;
+    double dist{0};
+    size_t steps{0};
+    // index of the parent label in the same side, -1 for the start or end vid
+    int64_t parent{-1};
+    // the edge from the vid of the parent label
+    Value edge;
+    bool dominated{false};
+  };
+
+  struct HalfPath {
+    std::vector<Label> labels;
+    std::unordered_map<Value, std::vector<size_t>> vidLabels;
+    using QueueItem = std::pair<double, size_t>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+  };
+
+  // The shortest path found, the left and right labels meet at the same vid
+  struct Meet {
+    double dist{std::numeric_limits<double>::infinity()};
+    int64_t left{-1};
+    int64_t right{-1};
+  };
+
+  void init(const HashSet& startVids, const HashSet& endVids, size_t rowSize);
+
+  folly::Future<Status> shortestPath(size_t rowNum, size_t stepNum);
+
+  // The distance of the shortest label queued, the dominated labels on the top are dropped
+  double topDist(HalfPath& half);
+
+  bool finished(size_t rowNum);
+
+  // Pop the labels to expand of the side
+  std::vector<size_t> popLabels(size_t rowNum, bool reverse);
+
+  folly::Future<Status> getNeighbors(size_t rowNum,
+                                     size_t stepNum,
+                                     bool reverse,
+                                     std::vector<size_t> labels);
+
+  Status doBuildPath(size_t rowNum,
+                     GetNeighborsIter* iter,
+                     bool reverse,
+                     const std::vector<size_t>& labels);
+
+  // Add the label if it's not dominated, return its index or -1
+  int64_t addLabel(HalfPath& half, Label&& label);
+
+  void meet(size_t rowNum, bool reverse, size_t labelIdx);
+
+  folly::Future<Status> buildResult(size_t rowNum);
+
+  // Return false if the weight of edge is not a number, e.g. NULL
+  bool weightOf(const Edge& edge, double& weight) const;
+
+ private:
+  std::vector<HalfPath> leftPaths_;
+  std::vector<HalfPath> rightPaths_;
+  std::vector<Meet> meets_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_ALGO_WEIGHTEDSHORTESTPATH_H_
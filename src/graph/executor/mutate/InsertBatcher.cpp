@@ -0,0 +1,165 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/mutate/InsertBatcher.h"
+
+#include <folly/futures/Future.h>
+
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+InsertBatcher& InsertBatcher::instance() {
+  static InsertBatcher batcher;
+  return batcher;
+}
+
+folly::SemiFuture<InsertBatcher::Response> InsertBatcher::addVertices(
+    storage::StorageClient* client,
+    const RequestParam& param,
+    std::vector<storage::cpp2::NewVertex> vertices,
+    TagPropNames propNames,
+    bool ifNotExists,
+    bool ignoreExistedIndex) {
+  if (FLAGS_insert_batch_window_us == 0 || param.profile) {
+    return client->addVertices(
+        param, std::move(vertices), std::move(propNames), ifNotExists, ignoreExistedIndex);
+  }
+  // The inserts of the same tags and props share a batch
+  std::map<TagID, const std::vector<std::string>*> tags;
+  for (const auto& [tagId, names] : propNames) {
+    tags.emplace(tagId, &names);
+  }
+  auto key = folly::to<std::string>(
+      reinterpret_cast<uintptr_t>(client), ":", param.space, ":", ifNotExists, ignoreExistedIndex);
+  for (const auto& [tagId, names] : tags) {
+    key.append(folly::to<std::string>(":", tagId, "(", folly::join(",", *names), ")"));
+  }
+  return add(&vertexBatches_,
+             std::move(key),
+             client,
+             param,
+             std::move(vertices),
+             std::move(propNames),
+             ifNotExists,
+             ignoreExistedIndex);
+}
+
+folly::SemiFuture<InsertBatcher::Response> InsertBatcher::addEdges(
+    storage::StorageClient* client,
+    const RequestParam& param,
+    std::vector<storage::cpp2::NewEdge> edges,
+    std::vector<std::string> propNames,
+    bool ifNotExists,
+    bool ignoreExistedIndex) {
+  if (FLAGS_insert_batch_window_us == 0 || param.profile) {
+    return client->addEdges(
+        param, std::move(edges), std::move(propNames), ifNotExists, ignoreExistedIndex);
+  }
+  auto key = folly::to<std::string>(reinterpret_cast<uintptr_t>(client),
+                                    ":",
+                                    param.space,
+                                    ":",
+                                    ifNotExists,
+                                    ignoreExistedIndex,
+                                    ":",
+                                    folly::join(",", propNames));
+  return add(&edgeBatches_,
+             std::move(key),
+             client,
+             param,
+             std::move(edges),
+             std::move(propNames),
+             ifNotExists,
+             ignoreExistedIndex);
+}
+
+template <typename Row, typename PropNames>
+folly::SemiFuture<InsertBatcher::Response> InsertBatcher::add(Batches<Row, PropNames>* batches,
+                                                              std::string key,
+                                                              storage::StorageClient* client,
+                                                              const RequestParam& param,
+                                                              std::vector<Row> rows,
+                                                              PropNames propNames,
+                                                              bool ifNotExists,
+                                                              bool ignoreExistedIndex) {
+  std::shared_ptr<Batch<Row, PropNames>> batch;
+  folly::SemiFuture<Response> future = folly::SemiFuture<Response>::makeEmpty();
+  bool full = false;
+  bool created = false;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& found = (*batches)[key];
+    if (found == nullptr) {
+      found = std::make_shared<Batch<Row, PropNames>>(
+          client, param, std::move(propNames), ifNotExists, ignoreExistedIndex);
+      created = true;
+    }
+    batch = found;
+    batch->rows.insert(batch->rows.end(),
+                       std::make_move_iterator(rows.begin()),
+                       std::make_move_iterator(rows.end()));
+    batch->promises.emplace_back();
+    future = batch->promises.back().getSemiFuture();
+    full = batch->rows.size() >= FLAGS_insert_batch_max_rows;
+  }
+  if (full) {
+    flush(batches, key, batch);
+  } else if (created) {
+    folly::futures::sleepUnsafe(std::chrono::microseconds(FLAGS_insert_batch_window_us))
+        .thenValue([this, batches, key = std::move(key), batch](auto&&) {
+          flush(batches, key, batch);
+        });
+  }
+  return future;
+}
+
+template <typename Row, typename PropNames>
+void InsertBatcher::flush(Batches<Row, PropNames>* batches,
+                          const std::string& key,
+                          std::shared_ptr<Batch<Row, PropNames>> batch) {
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (batch->sent) {
+      return;
+    }
+    batch->sent = true;
+    auto iter = batches->find(key);
+    if (iter != batches->end() && iter->second == batch) {
+      batches->erase(iter);
+    }
+  }
+  // The batch is no longer added to once sent
+  send(batch.get()).toUnsafeFuture().thenTry([batch](folly::Try<Response>&& resp) {
+    for (auto& promise : batch->promises) {
+      if (resp.hasException()) {
+        promise.setException(resp.exception());
+      } else {
+        promise.setValue(resp.value());
+      }
+    }
+  });
+}
+
+folly::SemiFuture<InsertBatcher::Response> InsertBatcher::send(
+    Batch<storage::cpp2::NewVertex, TagPropNames>* batch) {
+  return batch->client->addVertices(batch->param,
+                                    std::move(batch->rows),
+                                    std::move(batch->propNames),
+                                    batch->ifNotExists,
+                                    batch->ignoreExistedIndex);
+}
+
+folly::SemiFuture<InsertBatcher::Response> InsertBatcher::send(
+    Batch<storage::cpp2::NewEdge, std::vector<std::string>>* batch) {
+  return batch->client->addEdges(batch->param,
+                                 std::move(batch->rows),
+                                 std::move(batch->propNames),
+                                 batch->ifNotExists,
+                                 batch->ignoreExistedIndex);
+}
+
+}  // namespace graph
+}  // namespace nebula
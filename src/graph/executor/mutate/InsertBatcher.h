@@ -0,0 +1,104 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_MUTATE_INSERTBATCHER_H_
+#define GRAPH_EXECUTOR_MUTATE_INSERTBATCHER_H_
+
+#include <mutex>
+
+#include "clients/storage/StorageClient.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace graph {
+
+// InsertBatcher coalesces the inserts of the queries at the same time into fewer storage requests.
+//
+// The inserts of the same space, props and flags within insert_batch_window_us are sent as one
+// AddVertices/AddEdges, which the storage client splits by host as usual, so the many small inserts
+// of the ingestion take one round trip per host rather than one per statement. A batch is sent
+// once the window passes or it has insert_batch_max_rows rows. The inserts of a batch share its
+// response, as a part failed may hold the rows of any of them.
+class InsertBatcher final {
+ public:
+  using Response = storage::StorageRpcResponse<storage::cpp2::ExecResponse>;
+  using RequestParam = storage::StorageClient::CommonRequestParam;
+  using TagPropNames = std::unordered_map<TagID, std::vector<std::string>>;
+
+  static InsertBatcher& instance();
+
+  folly::SemiFuture<Response> addVertices(storage::StorageClient* client,
+                                          const RequestParam& param,
+                                          std::vector<storage::cpp2::NewVertex> vertices,
+                                          TagPropNames propNames,
+                                          bool ifNotExists,
+                                          bool ignoreExistedIndex);
+
+  folly::SemiFuture<Response> addEdges(storage::StorageClient* client,
+                                       const RequestParam& param,
+                                       std::vector<storage::cpp2::NewEdge> edges,
+                                       std::vector<std::string> propNames,
+                                       bool ifNotExists,
+                                       bool ignoreExistedIndex);
+
+ private:
+  template <typename Row, typename PropNames>
+  struct Batch {
+    Batch(storage::StorageClient* c,
+          const RequestParam& p,
+          PropNames names,
+          bool notExists,
+          bool ignoreIndex)
+        : client(c),
+          param(p),
+          propNames(std::move(names)),
+          ifNotExists(notExists),
+          ignoreExistedIndex(ignoreIndex) {}
+
+    storage::StorageClient* client;
+    RequestParam param;
+    PropNames propNames;
+    bool ifNotExists;
+    bool ignoreExistedIndex;
+    std::vector<Row> rows;
+    std::vector<folly::Promise<Response>> promises;
+    bool sent{false};
+  };
+
+  template <typename Row, typename PropNames>
+  using Batches = std::unordered_map<std::string, std::shared_ptr<Batch<Row, PropNames>>>;
+
+  InsertBatcher() = default;
+
+  // Add the rows to the batch of key in batches, the batch is created with the rest if absent
+  template <typename Row, typename PropNames>
+  folly::SemiFuture<Response> add(Batches<Row, PropNames>* batches,
+                                  std::string key,
+                                  storage::StorageClient* client,
+                                  const RequestParam& param,
+                                  std::vector<Row> rows,
+                                  PropNames propNames,
+                                  bool ifNotExists,
+                                  bool ignoreExistedIndex);
+
+  // Send the batch of key unless it's sent
+  template <typename Row, typename PropNames>
+  void flush(Batches<Row, PropNames>* batches,
+             const std::string& key,
+             std::shared_ptr<Batch<Row, PropNames>> batch);
+
+  static folly::SemiFuture<Response> send(Batch<storage::cpp2::NewVertex, TagPropNames>* batch);
+
+  static folly::SemiFuture<Response> send(
+      Batch<storage::cpp2::NewEdge, std::vector<std::string>>* batch);
+
+  std::mutex lock_;
+  Batches<storage::cpp2::NewVertex, TagPropNames> vertexBatches_;
+  Batches<storage::cpp2::NewEdge, std::vector<std::string>> edgeBatches_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_MUTATE_INSERTBATCHER_H_
@@ -4,6 +4,7 @@
 
 #include "graph/executor/mutate/InsertExecutor.h"
 
+#include "graph/executor/mutate/InsertBatcher.h"
 #include "graph/planner/plan/Mutate.h"
 #include "graph/service/GraphFlags.h"
 
@@ -24,13 +25,13 @@ folly::Future<Status> InsertVerticesExecutor::insertVertices() {
   auto plan = qctx()->plan();
   StorageClient::CommonRequestParam param(
       ivNode->getSpace(), qctx()->rctx()->session()->id(), plan->id(), plan->isProfileEnabled());
-  return qctx()
-      ->getStorageClient()
-      ->addVertices(param,
-                    ivNode->getVertices(),
-                    ivNode->getPropNames(),
-                    ivNode->getIfNotExists(),
-                    ivNode->getIgnoreExistedIndex())
+  return InsertBatcher::instance()
+      .addVertices(qctx()->getStorageClient(),
+                   param,
+                   ivNode->getVertices(),
+                   ivNode->getPropNames(),
+                   ivNode->getIfNotExists(),
+                   ivNode->getIgnoreExistedIndex())
       .via(runner())
       .ensure([addVertTime]() {
         VLOG(1) << "Add vertices time: " << addVertTime.elapsedInUSec() << "us";
@@ -56,13 +57,13 @@ folly::Future<Status> InsertEdgesExecutor::insertEdges() {
   StorageClient::CommonRequestParam param(
       ieNode->getSpace(), qctx()->rctx()->session()->id(), plan->id(), plan->isProfileEnabled());
   param.useExperimentalFeature = false;
-  return qctx()
-      ->getStorageClient()
-      ->addEdges(param,
-                 ieNode->getEdges(),
-                 ieNode->getPropNames(),
-                 ieNode->getIfNotExists(),
-                 ieNode->getIgnoreExistedIndex())
+  return InsertBatcher::instance()
+      .addEdges(qctx()->getStorageClient(),
+                param,
+                ieNode->getEdges(),
+                ieNode->getPropNames(),
+                ieNode->getIfNotExists(),
+                ieNode->getIgnoreExistedIndex())
       .via(runner())
       .ensure(
           [addEdgeTime]() { VLOG(1) << "Add edge time: " << addEdgeTime.elapsedInUSec() << "us"; })
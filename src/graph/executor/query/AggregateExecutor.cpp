@@ -4,7 +4,10 @@
 
 #include "graph/executor/query/AggregateExecutor.h"
 
+#include <cmath>
+
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -17,7 +20,6 @@ folly::Future<Status> AggregateExecutor::execute() {
   auto groupItems = agg->groupItems();
   auto iter = ectx_->getResult(agg->inputVar()).iter();
   DCHECK(!!iter);
-  QueryExpressionContext ctx(ectx_);
   // We could directly return size of input dataset for `COUNT(*)`
   if (groupKeys.empty() && groupItems.size() == 1) {
     auto str = groupItems[0]->toString();
@@ -26,14 +28,14 @@ folly::Future<Status> AggregateExecutor::execute() {
       DataSet ds;
       ds.colNames = agg->colNames();
       ds.rows.emplace_back(Row({Value(static_cast<int64_t>(iter->size()))}));
+      scaleSampled(&ds);
       return finish(ResultBuilder().value(Value(std::move(ds))).build());
     }
   }
 
-  std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
-
   // generate default result when input dataset is empty
   if (UNLIKELY(!iter->valid())) {
+    std::vector<AggGroups> result(1);
     List defaultValues;
     bool allAggItems = true;
     for (size_t i = 0; i < groupItems.size(); ++i) {
@@ -53,49 +55,209 @@ folly::Future<Status> AggregateExecutor::execute() {
         cols.emplace_back(new AggData());
         cols[i]->setResult(defaultValues[i]);
       }
-      result.emplace(std::make_pair(dummyKey, std::move(cols)));
+      result[0].emplace(std::make_pair(dummyKey, std::move(cols)));
+    }
+    return finish(ResultBuilder().value(Value(toDataSet(result))).build());
+  }
+
+  // The partial states are merged by the merge operations of the aggregate functions, except the
+  // distinct ones, whose values are deduplicated inside each partial state.
+  auto merges = std::make_shared<std::vector<AggFunctionManager::AggMerge>>();
+  bool mergeable = true;
+  for (auto* item : groupItems) {
+    auto* aggExpr = item->kind() == Expression::Kind::kAggregate
+                        ? static_cast<AggregateExpression*>(item)
+                        : nullptr;
+    auto merge = AggFunctionManager::getMerge(aggExpr != nullptr ? aggExpr->name() : "");
+    if (!merge.ok() || (aggExpr != nullptr && aggExpr->distinct())) {
+      mergeable = false;
+      break;
+    }
+    merges->emplace_back(std::move(merge).value());
+  }
+
+  if (FLAGS_max_job_size <= 1 || !mergeable) {
+    auto result = handleJob(0, iter->size(), iter.get(), 1);
+    return finish(ResultBuilder().value(Value(toDataSet(result))).build());
+  }
+
+  // Two phases: each job pre-aggregates its rows into the partitions by the hash of the group
+  // keys, then each partition of all jobs is merged in parallel, in the order of the jobs.
+  size_t numPartitions = FLAGS_max_job_size;
+  auto scatter = [this, numPartitions](
+                     size_t begin, size_t end, Iterator* tmpIter) -> StatusOr<Partitions> {
+    return handleJob(begin, end, tmpIter, numPartitions);
+  };
+
+  auto gather = [this, numPartitions, merges](std::vector<folly::Try<StatusOr<Partitions>>>&&
+                                                  results) -> folly::Future<Status> {
+    memory::MemoryCheckGuard guard;
+    auto partials = std::make_shared<std::vector<Partitions>>();
+    partials->reserve(results.size());
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      partials->emplace_back(std::move(res).value());
+    }
+
+    std::vector<folly::Future<AggGroups>> futures;
+    futures.reserve(numPartitions);
+    for (size_t p = 0; p < numPartitions; ++p) {
+      futures.emplace_back(folly::via(runner(), [partials, merges, p]() {
+        memory::MemoryCheckGuard guard;
+        return mergePartition(partials.get(), p, *merges);
+      }));
     }
+    return folly::collect(futures).via(runner()).thenValue(
+        [this](std::vector<AggGroups>&& merged) {
+          memory::MemoryCheckGuard guard;
+          return finish(ResultBuilder().value(Value(toDataSet(merged))).build());
+        });
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), iter.get());
+}
+
+AggregateExecutor::Partitions AggregateExecutor::handleJob(size_t begin,
+                                                           size_t end,
+                                                           Iterator* iter,
+                                                           size_t numPartitions) {
+  auto* agg = asNode<Aggregate>(node());
+  // The aggregate expressions point to the AggData being updated, so each job has its own copy
+  std::vector<Expression*> groupKeys;
+  for (auto* key : agg->groupKeys()) {
+    groupKeys.emplace_back(key->clone());
+    ExpressionUtils::bindColumns(groupKeys.back(), iter);
+  }
+  std::vector<Expression*> groupItems;
+  for (auto* item : agg->groupItems()) {
+    groupItems.emplace_back(item->clone());
+    ExpressionUtils::bindColumns(groupItems.back(), iter);
   }
+  QueryExpressionContext ctx(ectx_);
 
-  for (; iter->valid(); iter->next()) {
+  Partitions partitions(numPartitions);
+  for (; iter->valid() && begin++ < end; iter->next()) {
     List list;
     for (auto* key : groupKeys) {
-      list.values.emplace_back(key->eval(ctx(iter.get())));
+      list.values.emplace_back(key->eval(ctx(iter)));
     }
 
+    auto& result = partitions[numPartitions > 1 ? MixedListHash()(list) % numPartitions : 0];
     auto it = result.find(list);
     if (it == result.end()) {
       std::vector<std::unique_ptr<AggData>> cols;
       for (size_t i = 0; i < groupItems.size(); ++i) {
         cols.emplace_back(new AggData());
       }
-      result.emplace(std::make_pair(list, std::move(cols)));
+      it = result.emplace(std::move(list), std::move(cols)).first;
     } else {
       DCHECK_EQ(it->second.size(), groupItems.size());
     }
 
+    auto& cols = it->second;
     for (size_t i = 0; i < groupItems.size(); ++i) {
       auto* item = groupItems[i];
       if (item->kind() == Expression::Kind::kAggregate) {
-        static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
-        item->eval(ctx(iter.get()));
+        static_cast<AggregateExpression*>(item)->setAggData(cols[i].get());
+        item->eval(ctx(iter));
       } else {
-        result[list][i]->setResult(item->eval(ctx(iter.get())));
+        cols[i]->setResult(item->eval(ctx(iter)));
+      }
+    }
+  }
+  return partitions;
+}
+
+// static
+AggregateExecutor::AggGroups AggregateExecutor::mergePartition(
+    std::vector<Partitions>* partials,
+    size_t partition,
+    const std::vector<AggFunctionManager::AggMerge>& merges) {
+  DCHECK(!partials->empty());
+  auto result = std::move((*partials)[0][partition]);
+  for (size_t job = 1; job < partials->size(); ++job) {
+    for (auto& kv : (*partials)[job][partition]) {
+      auto it = result.find(kv.first);
+      if (it == result.end()) {
+        result.emplace(kv.first, std::move(kv.second));
+        continue;
+      }
+      DCHECK_EQ(it->second.size(), merges.size());
+      for (size_t i = 0; i < merges.size(); ++i) {
+        merges[i](it->second[i].get(), *kv.second[i]);
       }
     }
   }
+  return result;
+}
 
+DataSet AggregateExecutor::toDataSet(const std::vector<AggGroups>& groups) {
+  auto* agg = asNode<Aggregate>(node());
   DataSet ds;
   ds.colNames = agg->colNames();
-  ds.rows.reserve(result.size());
-  for (auto& kv : result) {
-    Row row;
-    for (auto& v : kv.second) {
-      row.values.emplace_back(v->result());
+  size_t size = 0;
+  for (auto& result : groups) {
+    size += result.size();
+  }
+  ds.rows.reserve(size);
+  for (auto& result : groups) {
+    for (auto& kv : result) {
+      Row row;
+      for (auto& v : kv.second) {
+        row.values.emplace_back(v->result());
+      }
+      ds.rows.emplace_back(std::move(row));
+    }
+  }
+  scaleSampled(&ds);
+  return ds;
+}
+
+void AggregateExecutor::scaleSampled(DataSet* ds) {
+  auto ratio = qctx()->sampleRatio();
+  if (ratio >= 1.0) {
+    return;
+  }
+  auto sources = sampledSources(node());
+  if (sources == 0) {
+    return;
+  }
+  ratio = std::pow(ratio, sources);
+  const auto& groupItems = asNode<Aggregate>(node())->groupItems();
+  for (size_t i = 0; i < groupItems.size(); ++i) {
+    if (groupItems[i]->kind() != Expression::Kind::kAggregate) {
+      continue;
+    }
+    auto* aggExpr = static_cast<const AggregateExpression*>(groupItems[i]);
+    auto name = aggExpr->name();
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    // The distinct values don't grow with the rows in proportion
+    bool count = name == "COUNT";
+    if (aggExpr->distinct() || (!count && name != "SUM")) {
+      continue;
+    }
+    for (auto& row : ds->rows) {
+      auto& value = row.values[i];
+      if (value.isInt()) {
+        // Each row is sampled independently, so the count sampled is binomial
+        if (count && value.getInt() > 0) {
+          qctx()->addSampledError(std::sqrt((1.0 - ratio) / value.getInt()));
+        }
+        value = static_cast<int64_t>(std::llround(value.getInt() / ratio));
+      } else if (value.isFloat()) {
+        value = value.getFloat() / ratio;
+      }
     }
-    ds.rows.emplace_back(std::move(row));
   }
-  return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
 }  // namespace graph
@@ -5,6 +5,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 
+#include "common/function/AggFunctionManager.h"
 #include "graph/executor/Executor.h"
 // calculate a set of data uniformly. use values ​​from multiple records as input
 // and convert those values ​​into one value to aggregate all records
@@ -17,6 +18,24 @@ class AggregateExecutor final : public Executor {
       : Executor("AggregateExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  using AggGroups =
+      std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>>;
+  // The groups partitioned by the hash of the group keys
+  using Partitions = std::vector<AggGroups>;
+
+  Partitions handleJob(size_t begin, size_t end, Iterator *iter, size_t numPartitions);
+
+  // Merge the given partition of the partial results of all jobs
+  static AggGroups mergePartition(std::vector<Partitions> *partials,
+                                  size_t partition,
+                                  const std::vector<AggFunctionManager::AggMerge> &merges);
+
+  DataSet toDataSet(const std::vector<AggGroups> &groups);
+
+  // Scale the counts and sums of the rows sampled by the query to estimate the ones of all rows
+  void scaleSampled(DataSet *ds);
 };
 
 }  // namespace graph
@@ -4,8 +4,12 @@
 
 #include "graph/executor/query/AppendVerticesExecutor.h"
 
+#include <folly/container/F14Map.h>
+
 #include <iterator>
 
+#include "graph/service/GraphFlags.h"
+
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetPropResponse;
@@ -47,6 +51,8 @@ folly::Future<Status> AppendVerticesExecutor::appendVertices() {
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
 
+  param.followerRead = FLAGS_enable_follower_read;
+
   time::Duration getPropsTime;
   return DCHECK_NOTNULL(storageClient)
       ->getProps(param,
@@ -111,7 +117,8 @@ Status AppendVerticesExecutor::handleResp(
   auto result = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
   NG_RETURN_IF_ERROR(result);
   auto state = std::move(result).value();
-  std::unordered_map<Value, Value> map;
+  // DstId -> Vertex, the rows of the same dst share the vertex built once
+  folly::F14FastMap<Value, Value, MixedValueHash> map;
   auto *av = asNode<AppendVertices>(node());
   auto *vFilter = av->vFilter();
   QueryExpressionContext ctx(qctx()->ectx());
@@ -136,7 +143,10 @@ Status AppendVerticesExecutor::handleResp(
           row.values.emplace_back(iter.getVertex());
           ds.rows.emplace_back(std::move(row));
         } else {
-          map.emplace(iter.getColumn(kVid), iter.getVertex());
+          auto &vid = iter.getColumn(kVid);
+          if (map.find(vid) == map.end()) {
+            map.emplace(vid, iter.getVertex());
+          }
         }
       }
     }
@@ -152,6 +162,7 @@ Status AppendVerticesExecutor::handleResp(
     auto dstFound = map.find(src->eval(ctx(inputIter.get())));
     if (dstFound != map.end()) {
       Row row = mv ? inputIter->moveRow() : *inputIter->row();
+      // Copying the vertex value only refers to the vertex
       row.values.emplace_back(dstFound->second);
       ds.rows.emplace_back(std::move(row));
     }
@@ -168,6 +179,8 @@ folly::Future<Status> AppendVerticesExecutor::handleRespMultiJobs(
   auto inputIter = qctx()->ectx()->getResult(av->inputVar()).iter();
   result_.colNames = av->colNames();
   result_.rows.reserve(inputIter->size());
+  // The jobs move the disjoint ranges of the input rows
+  mv_ = movable(av->inputVars().front());
 
   nebula::DataSet v;
   for (auto &resp : rpcResp.responses()) {
@@ -290,7 +303,10 @@ void AppendVerticesExecutor::buildMap(size_t begin, size_t end, Iterator *iter)
         continue;
       }
     }
-    dsts_.emplace(iter->getColumn(kVid), iter->getVertex());
+    auto &vid = iter->getColumn(kVid);
+    if (dsts_.find(vid) == dsts_.end()) {
+      dsts_.emplace(vid, iter->getVertex());
+    }
   }
 }
 
@@ -304,7 +320,7 @@ DataSet AppendVerticesExecutor::handleJob(size_t begin, size_t end, Iterator *it
   for (; iter->valid() && begin++ < end; iter->next()) {
     auto dstFound = dsts_.find(src->eval(ctx(iter)));
     if (dstFound != dsts_.end()) {
-      Row row = *iter->row();
+      Row row = mv_ ? iter->moveRow() : *iter->row();
       row.values.emplace_back(dstFound->second);
       ds.rows.emplace_back(std::move(row));
     }
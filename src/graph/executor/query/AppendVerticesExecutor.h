@@ -40,9 +40,11 @@ class AppendVerticesExecutor final : public GetPropExecutor {
   void buildMap(size_t begin, size_t end, Iterator *iter);
 
   // dsts_ and result_ are used for handling the response by multi jobs
-  // DstId -> Vertex
+  // DstId -> Vertex, which is referred rather than copied by the rows of the dst
   folly::ConcurrentHashMap<Value, Value> dsts_;
   DataSet result_;
+  // Whether the input rows are movable
+  bool mv_{false};
 };
 
 }  // namespace graph
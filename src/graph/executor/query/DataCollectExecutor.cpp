@@ -7,6 +7,7 @@
 #include <robin_hood.h>
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -14,6 +15,8 @@ folly::Future<Status> DataCollectExecutor::execute() {
   return doCollect().ensure([this]() {
     result_ = Value::kEmpty;
     colNames_.clear();
+    vertexMap_.clear();
+    edgeMap_.clear();
   });
 }
 
@@ -42,8 +45,7 @@ folly::Future<Status> DataCollectExecutor::doCollect() {
       break;
     }
     case DataCollect::DCKind::kPathProp: {
-      NG_RETURN_IF_ERROR(collectPathProp(vars));
-      break;
+      return collectPathProp(vars);
     }
     default:
       DLOG(FATAL) << "Unknown data collect type: " << static_cast<int32_t>(dc->kind());
@@ -145,15 +147,12 @@ Status DataCollectExecutor::collectAllPaths(const std::vector<std::string>& vars
   return Status::OK();
 }
 
-Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars) {
-  DataSet ds;
-  ds.colNames = colNames_;
+folly::Future<Status> DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars) {
   // 0: vertices's props, 1: Edges's props 2: paths without prop
   DCHECK_EQ(vars.size(), 3);
 
   auto vIter = ectx_->getResult(vars[0]).iter();
-  std::unordered_map<Value, Vertex> vertexMap;
-  vertexMap.reserve(vIter->size());
+  vertexMap_.reserve(vIter->size());
   DCHECK(vIter->isPropIter());
   for (; vIter->valid(); vIter->next()) {
     const auto& vertexVal = vIter->getVertex();
@@ -161,12 +160,11 @@ Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars
       continue;
     }
     const auto& vertex = vertexVal.getVertex();
-    vertexMap.insert(std::make_pair(vertex.vid, std::move(vertex)));
+    vertexMap_.insert(std::make_pair(vertex.vid, std::move(vertex)));
   }
 
   auto eIter = ectx_->getResult(vars[1]).iter();
-  std::unordered_map<std::tuple<Value, EdgeType, EdgeRanking, Value>, Edge> edgeMap;
-  edgeMap.reserve(eIter->size());
+  edgeMap_.reserve(eIter->size());
   DCHECK(eIter->isPropIter());
   for (; eIter->valid(); eIter->next()) {
     const auto& edgeVal = eIter->getEdge();
@@ -175,26 +173,67 @@ Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars
     }
     auto& edge = edgeVal.getEdge();
     auto edgeKey = std::make_tuple(edge.src, edge.type, edge.ranking, edge.dst);
-    edgeMap.insert(std::make_pair(std::move(edgeKey), std::move(edge)));
+    edgeMap_.insert(std::make_pair(std::move(edgeKey), std::move(edge)));
   }
 
   auto pIter = ectx_->getResult(vars[2]).iter();
   DCHECK(pIter->isSequentialIter());
-  for (; pIter->valid(); pIter->next()) {
-    const auto& pathVal = pIter->getColumn(0);
+  if (FLAGS_max_job_size <= 1) {
+    auto ds = fillPathProp(0, pIter->size(), pIter.get());
+    ds.colNames = std::move(colNames_);
+    return finish(ResultBuilder().value(Value(std::move(ds))).build());
+  }
+
+  // The paths are filled by the jobs, which only read the maps of the props
+  auto scatter = [this](size_t begin, size_t end, Iterator* tmpIter) -> StatusOr<DataSet> {
+    return fillPathProp(begin, end, tmpIter);
+  };
+
+  auto gather = [this](std::vector<folly::Try<StatusOr<DataSet>>>&& results) {
+    memory::MemoryCheckGuard guard;
+    DataSet ds;
+    ds.colNames = std::move(colNames_);
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      auto&& rows = std::move(res).value();
+      ds.rows.insert(ds.rows.end(),
+                     std::make_move_iterator(rows.begin()),
+                     std::make_move_iterator(rows.end()));
+    }
+    finish(ResultBuilder().value(Value(std::move(ds))).build());
+    return Status::OK();
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), pIter.get());
+}
+
+DataSet DataCollectExecutor::fillPathProp(size_t begin, size_t end, Iterator* iter) const {
+  DataSet ds;
+  ds.rows.reserve(end - begin);
+  for (; iter->valid() && begin++ < end; iter->next()) {
+    const auto& pathVal = iter->getColumn(0);
     if (UNLIKELY(!pathVal.isPath())) {
       continue;
     }
     auto path = pathVal.getPath();
     auto src = path.src.vid;
-    auto found = vertexMap.find(src);
-    if (found != vertexMap.end()) {
+    auto found = vertexMap_.find(src);
+    if (found != vertexMap_.end()) {
       path.src = found->second;
     }
     for (auto& step : path.steps) {
       auto dst = step.dst.vid;
-      found = vertexMap.find(dst);
-      if (found != vertexMap.end()) {
+      found = vertexMap_.find(dst);
+      if (found != vertexMap_.end()) {
         step.dst = found->second;
       }
 
@@ -205,14 +244,17 @@ Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars
         type = -type;
       }
       auto edgeKey = std::make_tuple(src, type, ranking, dst);
-      auto edge = edgeMap[edgeKey];
-      step.props = edge.props;
+      auto edge = edgeMap_.find(edgeKey);
+      if (edge != edgeMap_.end()) {
+        step.props = edge->second.props.toMap();
+      } else {
+        step.props.clear();
+      }
       src = step.dst.vid;
     }
     ds.rows.emplace_back(Row({std::move(path)}));
   }
-  result_.setDataSet(std::move(ds));
-  return Status::OK();
+  return ds;
 }
 
 }  // namespace graph
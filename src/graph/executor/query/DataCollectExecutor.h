@@ -5,6 +5,8 @@
 #ifndef GRAPH_EXECUTOR_QUERY_DATACOLLECTEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_DATACOLLECTEXECUTOR_H_
 
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Vertex.h"
 #include "graph/executor/Executor.h"
 // DataCollect used to collect multiple versions of results(LOOP operator exist in execution plan)
 // OR used after filter operator (the result of the filter operator has no dataset but an iterator)
@@ -43,10 +45,16 @@ class DataCollectExecutor final : public Executor {
 
   Status collectAllPaths(const std::vector<std::string>& vars);
 
-  Status collectPathProp(const std::vector<std::string>& vars);
+  folly::Future<Status> collectPathProp(const std::vector<std::string>& vars);
+
+  // Populate the props into the paths [begin, end), by multi jobs if the paths are too many
+  DataSet fillPathProp(size_t begin, size_t end, Iterator* iter) const;
 
   std::vector<std::string> colNames_;
   Value result_;
+  // The props of the vertices and the edges of collectPathProp, read by the jobs
+  std::unordered_map<Value, Vertex> vertexMap_;
+  std::unordered_map<std::tuple<Value, EdgeType, EdgeRanking, Value>, Edge> edgeMap_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -6,7 +6,10 @@
 
 #include <robin_hood.h>
 
+#include "graph/executor/query/PartitionedRowSet.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+
 namespace nebula {
 namespace graph {
 folly::Future<Status> DedupExecutor::execute() {
@@ -25,7 +28,11 @@ folly::Future<Status> DedupExecutor::execute() {
   if (UNLIKELY(iter->isGetNeighborsIter() || iter->isDefaultIter())) {
     return Status::Error("Invalid iterator kind, %d", static_cast<uint16_t>(iter->kind()));
   }
-  robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> unique;
+  if (FLAGS_max_job_size > 1 && (iter->isSequentialIter() || iter->isPropIter()) &&
+      iter->size() > static_cast<size_t>(FLAGS_min_batch_size)) {
+    return dedupMultiJobs(std::move(result));
+  }
+  robin_hood::unordered_flat_set<const Row*, MixedListHash> unique;
   unique.reserve(iter->size());
   while (iter->valid()) {
     if (!unique.emplace(iter->row()).second) {
@@ -38,5 +45,56 @@ folly::Future<Status> DedupExecutor::execute() {
   return finish(std::move(result));
 }
 
+folly::Future<Status> DedupExecutor::dedupMultiJobs(Result result) {
+  using HashedRows = std::vector<PartitionedRowSet::HashedRow>;
+  auto* iter = result.iterRef();
+  size_t numPartitions = FLAGS_max_job_size;
+  auto scatter = [](size_t begin, size_t end, Iterator* tmpIter) -> StatusOr<HashedRows> {
+    return PartitionedRowSet::hashRows(tmpIter, begin, end);
+  };
+
+  auto gather = [this, numPartitions, result = std::move(result)](
+                    std::vector<folly::Try<StatusOr<HashedRows>>>&& results) mutable
+      -> folly::Future<Status> {
+    memory::MemoryCheckGuard guard;
+    auto hashed = std::make_shared<HashedRows>();
+    hashed->reserve(result.iterRef()->size());
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      auto rows = std::move(res).value();
+      hashed->insert(hashed->end(), rows.begin(), rows.end());
+    }
+
+    // The first one of the equal rows is kept, so the rows stay in order
+    auto set = std::make_shared<PartitionedRowSet>(numPartitions);
+    auto firsts = std::make_shared<std::vector<uint8_t>>(hashed->size(), 0);
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(numPartitions);
+    for (size_t p = 0; p < numPartitions; ++p) {
+      futures.emplace_back(folly::via(runner(), [set, hashed, firsts, p]() {
+        memory::MemoryCheckGuard guard;
+        set->build(p, *hashed, firsts.get());
+      }));
+    }
+    return folly::collect(futures).via(runner()).thenValue(
+        [this, firsts, result = std::move(result)](auto&&) mutable {
+          memory::MemoryCheckGuard guard;
+          PartitionedRowSet::keepRows(result.iterRef(), *firsts);
+          return finish(std::move(result));
+        });
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), iter);
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -16,6 +16,10 @@ class DedupExecutor final : public Executor {
   DedupExecutor(const PlanNode *node, QueryContext *qctx) : Executor("DedupExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Hash the rows in jobs by ranges, then dedup each partition of the hashes in its own job
+  folly::Future<Status> dedupMultiJobs(Result result);
 };
 
 }  // namespace graph
@@ -75,6 +75,7 @@ folly::Future<Status> ExpandAllExecutor::GetDstBySrc() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes())
@@ -139,6 +140,7 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   QueryExpressionContext qec(qctx()->ectx());
@@ -160,7 +162,9 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
                      std::vector<storage::cpp2::OrderBy>(),
                      limit,
                      expand_->filter(),
-                     nullptr)
+                     nullptr,
+                     false,
+                     expand_->dstVertexProps())
       .via(runner())
       .thenValue([this](RpcResponse&& resp) mutable {
         // MemoryTrackerVerified
@@ -190,6 +194,7 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
             return expandFromCache();
           }
         }
+        setDstVertices();
         return finish(ResultBuilder().value(Value(std::move(result_))).build());
       });
 }
@@ -226,6 +231,7 @@ folly::Future<Status> ExpandAllExecutor::expandFromCache() {
       return getNeighbors();
     }
   }
+  setDstVertices();
   return finish(ResultBuilder().value(Value(std::move(result_))).build());
 }
 
@@ -329,10 +335,16 @@ folly::Future<Status> ExpandAllExecutor::handleResponse(RpcResponse&& resps) {
   NG_RETURN_IF_ERROR(handleCompleteness(resps, FLAGS_accept_partial_success));
   List list;
   for (auto& resp : resps.responses()) {
-    auto dataset = resp.get_vertices();
-    if (dataset) {
+    auto dataset = resp.vertices_ref();
+    if (dataset.has_value()) {
+      internStrings(*dataset);
       list.values.emplace_back(std::move(*dataset));
     }
+    auto dstVertices = resp.dst_vertices_ref();
+    if (dstVertices.has_value() && !dstVertices_.append(std::move(*dstVertices))) {
+      // it's impossible according to the interface, GetVertices fetches the dsts missing
+      LOG(ERROR) << "Heterogeneous dst vertices dataset";
+    }
   }
   auto listVal = std::make_shared<Value>(std::move(list));
   auto iter = std::make_unique<GetNeighborsIter>(listVal);
@@ -470,6 +482,15 @@ void ExpandAllExecutor::buildResult(const List& vList, const List& eList, bool i
   result_.rows.emplace_back(std::move(row));
 }
 
+void ExpandAllExecutor::setDstVertices() {
+  if (expand_->dstVerticesVar().empty()) {
+    return;
+  }
+  ectx_->setResult(
+      expand_->dstVerticesVar(),
+      ResultBuilder().value(Value(std::move(dstVertices_))).iter(Iterator::Kind::kProp).build());
+}
+
 void ExpandAllExecutor::resetNextStepVids(std::unordered_set<Value>& visitedVids) {
   auto vidIter = nextStepVids_.begin();
   while (vidIter != nextStepVids_.end()) {
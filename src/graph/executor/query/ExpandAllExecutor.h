@@ -85,6 +85,9 @@ class ExpandAllExecutor final : public StorageAccessExecutor {
 
   void resetNextStepVids(std::unordered_set<Value>& visitedVids);
 
+  // Keep the dst vertices returned along with the neighbors for the GetVertices joined
+  void setDstVertices();
+
   bool limitORsample(std::vector<int64_t>& samples);
 
  private:
@@ -93,6 +96,7 @@ class ExpandAllExecutor final : public StorageAccessExecutor {
   size_t currentStep_{0};
   size_t maxSteps_{0};
   DataSet result_;
+  DataSet dstVertices_;
   YieldColumns* edgeColumns_{nullptr};
   YieldColumns* vertexColumns_{nullptr};
 
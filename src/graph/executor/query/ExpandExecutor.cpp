@@ -43,6 +43,12 @@ folly::Future<Status> ExpandExecutor::execute() {
   sample_ = expand_->sample();
   stepLimits_ = expand_->stepLimits();
   NG_RETURN_IF_ERROR(buildRequestVids());
+  // The sources are sampled here unless the rows they come from are sampled by the scans
+  if (qctx()->sampleRatio() < 1.0 && sampledSources(node()) == 0) {
+    for (auto it = nextStepVids_.begin(); it != nextStepVids_.end();) {
+      it = qctx()->sampled() ? std::next(it) : nextStepVids_.erase(it);
+    }
+  }
   if (nextStepVids_.empty()) {
     DataSet emptyDs;
     return finish(ResultBuilder().value(Value(std::move(emptyDs))).build());
@@ -61,12 +67,19 @@ folly::Future<Status> ExpandExecutor::execute() {
     return finish(ResultBuilder().value(Value(std::move(ds))).build());
   }
   if (expand_->joinInput() || !stepLimits_.empty()) {
+    for (const auto& vid : nextStepVids_) {
+      nextStepIds_.insert(vids_.intern(vid));
+    }
+    nextStepVids_.clear();
     return getNeighbors();
   }
   return GetDstBySrc();
 }
 
 folly::Future<Status> ExpandExecutor::GetDstBySrc() {
+  // nextStepVids_ are reached after currentStep_ steps
+  auto steps = FLAGS_expand_steps_in_storage ? maxSteps_ - currentStep_ : 1;
+  auto base = currentStep_;
   currentStep_++;
   time::Duration getDstTime;
   StorageClient* storageClient = qctx_->getStorageClient();
@@ -74,15 +87,16 @@ folly::Future<Status> ExpandExecutor::GetDstBySrc() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
-  return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes())
+  return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes(), steps)
       .via(runner())
       .ensure([this, getDstTime]() {
         SCOPED_TIMER(&execTime_);
         addState("total_rpc_time", getDstTime);
       })
-      .thenValue([this](StorageRpcResponse<GetDstBySrcResponse>&& resps) {
+      .thenValue([this, steps, base](StorageRpcResponse<GetDstBySrcResponse>&& resps) {
         memory::MemoryCheckGuard guard;
         nextStepVids_.clear();
         SCOPED_TIMER(&execTime_);
@@ -100,35 +114,45 @@ folly::Future<Status> ExpandExecutor::GetDstBySrc() {
         if (!result.ok()) {
           return folly::makeFuture<Status>(result.status());
         }
+        if (result.value() != Result::State::kSuccess) {
+          dstsState_ = result.value();
+        }
         auto& responses = resps.responses();
-        if (currentStep_ < maxSteps_) {
-          for (auto& resp : responses) {
-            auto* dataset = resp.get_dsts();
-            if (dataset == nullptr) continue;
-            for (auto& row : dataset->rows) {
-              nextStepVids_.insert(row.values.begin(), row.values.end());
+        for (auto& resp : responses) {
+          if (resp.remote_dsts_ref().has_value()) {
+            // the dsts storaged can't expand in place, expand the rest of steps of them later
+            for (auto& [step, remotes] : *resp.remote_dsts_ref()) {
+              auto& pending = pendingVids_[base + step];
+              pending.insert(std::make_move_iterator(remotes.begin()),
+                             std::make_move_iterator(remotes.end()));
             }
           }
-          if (nextStepVids_.empty()) {
-            DataSet emptyDs;
-            finish(ResultBuilder().value(Value(std::move(emptyDs))).build());
-            return folly::makeFuture<Status>(Status::OK());
-          }
-          return GetDstBySrc();
-        } else {
-          ResultBuilder builder;
-          builder.state(result.value());
-          DataSet ds;
-          for (auto& resp : responses) {
-            auto* dataset = resp.get_dsts();
-            if (dataset == nullptr) continue;
+          auto* dataset = resp.get_dsts();
+          if (dataset == nullptr) continue;
+          if (base + steps < maxSteps_) {
+            auto& pending = pendingVids_[base + steps];
+            for (auto& row : dataset->rows) {
+              pending.insert(row.values.begin(), row.values.end());
+            }
+          } else {
             dataset->colNames = expand_->colNames();
-            ds.append(std::move(*dataset));
+            dsts_.append(std::move(*dataset));
           }
-          builder.value(Value(std::move(ds))).iter(Iterator::Kind::kSequential);
-          finish(builder.build());
-          return folly::makeFuture<Status>(Status::OK());
         }
+        if (!pendingVids_.empty()) {
+          // the vids of less steps first, so the vids of more steps are merged before expanded
+          auto first = pendingVids_.begin();
+          currentStep_ = first->first;
+          nextStepVids_ = std::move(first->second);
+          pendingVids_.erase(first);
+          return GetDstBySrc();
+        }
+        ResultBuilder builder;
+        builder.state(dstsState_);
+        dsts_.colNames = expand_->colNames();
+        builder.value(Value(std::move(dsts_))).iter(Iterator::Kind::kSequential);
+        finish(builder.build());
+        return folly::makeFuture<Status>(Status::OK());
       });
 }
 
@@ -139,8 +163,12 @@ folly::Future<Status> ExpandExecutor::getNeighbors() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
-  std::vector<Value> vids(nextStepVids_.size());
-  std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
+  param.followerRead = FLAGS_enable_follower_read;
+  std::vector<Value> vids;
+  vids.reserve(nextStepIds_.size());
+  for (auto id : nextStepIds_) {
+    vids.emplace_back(vids_.vid(id));
+  }
   auto stepLimit =
       stepLimits_.empty() ? std::numeric_limits<int64_t>::max() : stepLimits_[currentStep_ - 1];
   return storageClient
@@ -158,12 +186,15 @@ folly::Future<Status> ExpandExecutor::getNeighbors() {
                      std::vector<storage::cpp2::OrderBy>(),
                      stepLimit,
                      nullptr,
-                     nullptr)
+                     nullptr,
+                     false,
+                     nullptr,
+                     true)
       .via(runner())
       .thenValue([this](RpcResponse&& resp) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
-        nextStepVids_.clear();
+        nextStepIds_.clear();
         SCOPED_TIMER(&execTime_);
         addStats(resp);
         time::Duration expandTime;
@@ -181,7 +212,7 @@ folly::Future<Status> ExpandExecutor::getNeighbors() {
           return Status::Error("Execution had been killed");
         }
         if (currentStep_ < maxSteps_) {
-          if (!nextStepVids_.empty()) {
+          if (!nextStepIds_.empty()) {
             return getNeighbors();
           }
           if (!preVisitedVids_.empty()) {
@@ -201,14 +232,16 @@ folly::Future<Status> ExpandExecutor::expandFromCache() {
     curLimit_ = 0;
     curMaxLimit_ =
         stepLimits_.empty() ? std::numeric_limits<int64_t>::max() : stepLimits_[currentStep_ - 1];
-    std::unordered_map<Value, std::unordered_set<Value>> dst2VidsMap;
-    std::unordered_set<Value> visitedVids;
+    Dst2VidsMap dst2VidsMap;
+    DenseIdSet visitedVids;
 
     std::vector<int64_t> samples;
     if (sample_) {
       int64_t size = 0;
-      for (auto& vid : preVisitedVids_) {
-        size += adjDsts_[vid].size();
+      for (auto vid : preVisitedVids_) {
+        if (vid < adjDsts_.size()) {
+          size += adjDsts_[vid].size();
+        }
       }
       algorithm::ReservoirSampling<int64_t> sampler(curMaxLimit_, size);
       samples = sampler.samples();
@@ -220,25 +253,23 @@ folly::Future<Status> ExpandExecutor::expandFromCache() {
     visitedVids.swap(preVisitedVids_);
     std::string timeName = "graphCacheExpandTime+" + folly::to<std::string>(currentStep_);
     addState(timeName, expandTime);
-    if (!nextStepVids_.empty()) {
+    if (!nextStepIds_.empty()) {
       return getNeighbors();
     }
   }
   return buildResult();
 }
 
-void ExpandExecutor::getNeighborsFromCache(
-    std::unordered_map<Value, std::unordered_set<Value>>& dst2VidsMap,
-    std::unordered_set<Value>& visitedVids,
-    std::vector<int64_t>& samples) {
-  for (const auto& vid : preVisitedVids_) {
-    auto findVid = adjDsts_.find(vid);
-    if (findVid == adjDsts_.end()) {
+void ExpandExecutor::getNeighborsFromCache(Dst2VidsMap& dst2VidsMap,
+                                           DenseIdSet& visitedVids,
+                                           std::vector<int64_t>& samples) {
+  for (auto vid : preVisitedVids_) {
+    if (!isCached(vid)) {
       continue;
     }
-    auto& dsts = findVid->second;
+    const auto& dsts = adjDsts_[vid];
 
-    for (const auto& dst : dsts) {
+    for (auto dst : dsts) {
       if (sample_) {
         if (samples.empty()) {
           break;
@@ -257,10 +288,10 @@ void ExpandExecutor::getNeighborsFromCache(
       if (currentStep_ >= maxSteps_) {
         continue;
       }
-      if (adjDsts_.find(dst) == adjDsts_.end()) {
-        nextStepVids_.emplace(dst);
+      if (!isCached(dst)) {
+        nextStepIds_.insert(dst);
       } else {
-        visitedVids.emplace(dst);
+        visitedVids.insert(dst);
       }
     }
   }
@@ -273,15 +304,15 @@ void ExpandExecutor::getNeighborsFromCache(
 // 5、 get the dsts corresponding to the vid that has been visited in the previous step by adjDsts_
 folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
   NG_RETURN_IF_ERROR(handleCompleteness(resps, FLAGS_accept_partial_success));
-  std::unordered_map<Value, std::unordered_set<Value>> dst2VidsMap;
-  std::unordered_set<Value> visitedVids;
+  Dst2VidsMap dst2VidsMap;
+  DenseIdSet visitedVids;
   std::vector<int64_t> samples;
   if (sample_) {
     size_t size = 0;
     for (auto& resp : resps.responses()) {
       auto dataset = resp.get_vertices();
       if (!dataset) continue;
-      GetNbrsRespDataSetIter iter(dataset);
+      GetNbrsRespDataSetIter iter(dataset, resp.get_edges());
       size += iter.size();
     }
     algorithm::ReservoirSampling<int64_t> sampler(curMaxLimit_, size);
@@ -294,18 +325,26 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
     if (!dataset) {
       continue;
     }
-    for (GetNbrsRespDataSetIter iter(dataset); iter.valid(); iter.next()) {
-      auto dsts = iter.getAdjDsts();
-      if (dsts.empty()) {
+    for (GetNbrsRespDataSetIter iter(dataset, resp.get_edges()); iter.valid(); iter.next()) {
+      auto adjDsts = iter.getAdjDsts();
+      if (adjDsts.empty()) {
         continue;
       }
-      const auto& src = iter.getVid();
+      auto src = vids_.intern(iter.getVid());
+      std::vector<Id> dsts;
+      dsts.reserve(adjDsts.size());
+      for (const auto& dst : adjDsts) {
+        dsts.emplace_back(vids_.intern(dst));
+      }
       // do not cache in the last step
-      if (currentStep_ < maxSteps_) {
-        adjDsts_.emplace(src, dsts);
+      if (currentStep_ < maxSteps_ && !isCached(src)) {
+        if (src >= adjDsts_.size()) {
+          adjDsts_.resize(vids_.size());
+        }
+        adjDsts_[src] = dsts;
       }
 
-      for (const auto& dst : dsts) {
+      for (auto dst : dsts) {
         if (sample_) {
           if (samples.empty()) {
             break;
@@ -327,13 +366,13 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
         }
         if (!stepLimits_.empty()) {
           // do not use cache when stepLimits_ is not empty
-          nextStepVids_.emplace(dst);
+          nextStepIds_.insert(dst);
           continue;
         }
-        if (adjDsts_.find(dst) == adjDsts_.end()) {
-          nextStepVids_.emplace(dst);
+        if (!isCached(dst)) {
+          nextStepIds_.insert(dst);
         } else {
-          visitedVids.emplace(dst);
+          visitedVids.insert(dst);
         }
       }
     }
@@ -346,15 +385,12 @@ folly::Future<Status> ExpandExecutor::handleResponse(RpcResponse&& resps) {
   return Status::OK();
 }
 
-void ExpandExecutor::updateDst2VidsMap(
-    std::unordered_map<Value, std::unordered_set<Value>>& dst2VidsMap,
-    const Value& src,
-    const Value& dst) {
+void ExpandExecutor::updateDst2VidsMap(Dst2VidsMap& dst2VidsMap, Id src, Id dst) {
   auto findSrc = preDst2VidsMap_.find(src);
   if (findSrc == preDst2VidsMap_.end()) {
     auto findDst = dst2VidsMap.find(dst);
     if (findDst == dst2VidsMap.end()) {
-      std::unordered_set<Value> tmp({src});
+      std::unordered_set<Id> tmp({src});
       dst2VidsMap.emplace(dst, std::move(tmp));
     } else {
       findDst->second.emplace(src);
@@ -372,11 +408,11 @@ void ExpandExecutor::updateDst2VidsMap(
 folly::Future<Status> ExpandExecutor::buildResult() {
   DataSet ds;
   ds.colNames = expand_->colNames();
-  for (auto pair : preDst2VidsMap_) {
-    auto& dst = pair.first;
+  for (const auto& pair : preDst2VidsMap_) {
+    const auto& dst = vids_.vid(pair.first);
     for (auto src : pair.second) {
       Row row;
-      row.values.emplace_back(src);
+      row.values.emplace_back(vids_.vid(src));
       row.values.emplace_back(dst);
       ds.rows.emplace_back(std::move(row));
     }
@@ -7,12 +7,15 @@
 
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/util/VidInterner.h"
 
 // The go statement is divided into two operators, expand operator and expandAll operator.
 // expand is responsible for expansion and does not take attributes.
 
 // if no need join, invoke the getDstBySrc interface to output only one column,
-// which is the set of destination vids(deduplication) after maxSteps expansion
+// which is the set of destination vids(deduplication) after maxSteps expansion.
+// If expand_steps_in_storage is set, storaged expands the rest of the steps of each request and
+// only returns the dsts of the parts it doesn't lead, which are expanded again by later requests
 
 // if need to join with the previous statement, invoke the getNeighbors interface,
 // and we need save the mapping relationship between the init vid and the destination vid
@@ -26,6 +29,10 @@
 // when expanding, if the vid has already been visited, do not need to go through RPC
 // just get the result directly through adjList_
 
+// When expanding by getNeighbors, the vids are interned to dense ids as the responses are read,
+// the frontier, visited vids and adjacency list are indexed by the ids and the vids are only looked
+// up again to build the requests and the result
+
 namespace nebula {
 namespace graph {
 class ExpandExecutor final : public StorageAccessExecutor {
@@ -43,15 +50,16 @@ class ExpandExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> GetDstBySrc();
 
-  void getNeighborsFromCache(std::unordered_map<Value, std::unordered_set<Value>>& dst2VidMap,
-                             std::unordered_set<Value>& visitedVids,
+  using Id = VidInterner::Id;
+  using Dst2VidsMap = std::unordered_map<Id, std::unordered_set<Id>>;
+
+  void getNeighborsFromCache(Dst2VidsMap& dst2VidMap,
+                             DenseIdSet& visitedVids,
                              std::vector<int64_t>& samples);
 
   folly::Future<Status> expandFromCache();
 
-  void updateDst2VidsMap(std::unordered_map<Value, std::unordered_set<Value>>& dst2VidMap,
-                         const Value& src,
-                         const Value& dst);
+  void updateDst2VidsMap(Dst2VidsMap& dst2VidMap, Id src, Id dst);
 
   folly::Future<Status> buildResult();
 
@@ -59,6 +67,11 @@ class ExpandExecutor final : public StorageAccessExecutor {
   folly::Future<Status> handleResponse(RpcResponse&& resps);
 
  private:
+  // whether the dsts of id are cached in adjDsts_
+  bool isCached(Id id) const {
+    return id < adjDsts_.size() && !adjDsts_[id].empty();
+  }
+
   const Expand* expand_;
   size_t currentStep_{0};
   size_t maxSteps_{0};
@@ -68,14 +81,25 @@ class ExpandExecutor final : public StorageAccessExecutor {
   int64_t curMaxLimit_{std::numeric_limits<int64_t>::max()};
   std::vector<int64_t> stepLimits_;
 
+  // vids of the input, and of each step when expanding by getDstBySrc
   std::unordered_set<Value> nextStepVids_;
-  std::unordered_set<Value> preVisitedVids_;
-  std::unordered_map<Value, std::unordered_set<Value>> adjDsts_;
+  // vids to expand by getDstBySrc keyed by the steps they are reached in, storaged returns the
+  // dsts it can't expand in place when expanding multiple steps
+  std::map<size_t, std::unordered_set<Value>> pendingVids_;
+  // dsts of maxSteps expanded by getDstBySrc
+  DataSet dsts_;
+  Result::State dstsState_{Result::State::kSuccess};
+
+  VidInterner vids_;
+  DenseIdSet nextStepIds_;
+  DenseIdSet preVisitedVids_;
+  // indexed by the id of src, empty if the dsts of src are not cached
+  std::vector<std::vector<Id>> adjDsts_;
 
   // keep the mapping relationship between the init vid and the destination vid
   // during the expansion.  KEY : edge's dst, VALUE : init vids
   // then we can know which init vids can reach the current destination point
-  std::unordered_map<Value, std::unordered_set<Value>> preDst2VidsMap_;
+  Dst2VidsMap preDst2VidsMap_;
 };
 
 }  // namespace graph
@@ -4,6 +4,11 @@
 
 #include "graph/executor/query/FilterExecutor.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "common/expression/BatchEvaluator.h"
+#include "common/expression/CompiledExpression.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
 
@@ -20,7 +25,8 @@ folly::Future<Status> FilterExecutor::execute() {
     return status;
   }
 
-  if (FLAGS_max_job_size == 1 || iter->isGetNeighborsIter()) {
+  // The filter stops early in a single job when a limit only needs a part of the rows
+  if (FLAGS_max_job_size == 1 || iter->isGetNeighborsIter() || outputRowLimit() < iter->size()) {
     // TODO :GetNeighborsIterator is not an thread safe implementation.
     return handleSingleJobFilter();
   } else {
@@ -70,11 +76,25 @@ folly::Future<Status> FilterExecutor::execute() {
 
 StatusOr<DataSet> FilterExecutor::handleJob(size_t begin, size_t end, Iterator *iter) {
   auto *filter = asNode<Filter>(node());
-  QueryExpressionContext ctx(ectx_);
-  auto condition = filter->condition()->clone();
   DataSet ds;
+  std::vector<uint8_t> mask;
+  auto batched = batchFilter(filter->condition(), iter, begin, end, &mask);
+  NG_RETURN_IF_ERROR(batched);
+  if (batched.value()) {
+    auto rows = static_cast<SequentialIter *>(iter)->begin() + begin;
+    for (size_t i = 0; i < mask.size(); ++i) {
+      if (mask[i]) {
+        ds.rows.emplace_back(rows[i]);
+      }
+    }
+    return ds;
+  }
+
+  QueryExpressionContext ctx(ectx_);
+  auto condition = filter->condition();
+  auto compiled = CompiledExpression::compile(condition);
   for (; iter->valid() && begin++ < end; iter->next()) {
-    auto val = condition->eval(ctx(iter));
+    const auto &val = compiled.eval(ctx(iter));
     if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
       return Status::Error("Failed to evaluate condition: %s. %s%s",
                            condition->toString().c_str(),
@@ -105,10 +125,43 @@ Status FilterExecutor::handleSingleJobFilter() {
   ResultBuilder builder;
   QueryExpressionContext ctx(ectx_);
   auto condition = filter->condition();
+  // The rows not evaluated in batch are evaluated by the compiled condition
+  auto compiled = CompiledExpression::compile(condition);
+  // The rows after the limit of the consumer are dropped anyway, so the filter stops when the
+  // limit is reached, and the condition is evaluated in batch by the chunks of about the limit.
+  size_t limit =
+      iter->isGetNeighborsIter() ? std::numeric_limits<size_t>::max() : outputRowLimit();
+  size_t total = iter->size();
+  size_t chunk = limit < total ? std::max<size_t>(limit, FLAGS_min_batch_size) : total;
   if (LIKELY(canMoveData)) {
     builder.value(result.valuePtr());
-    while (iter->valid()) {
-      auto val = condition->eval(ctx(iter));
+    std::vector<uint8_t> mask;
+    auto batched = batchFilter(condition, iter, 0, std::min(chunk, total), &mask);
+    NG_RETURN_IF_ERROR(batched);
+    if (batched.value()) {
+      // Keep the rows meeting the condition in order, which is also a stable filter
+      auto rows = static_cast<SequentialIter *>(iter)->begin();
+      size_t kept = 0;
+      for (size_t begin = 0; begin < total && kept < limit;) {
+        for (size_t i = 0; i < mask.size() && kept < limit; ++i) {
+          if (mask[i]) {
+            if (kept != begin + i) {
+              rows[kept] = std::move(rows[begin + i]);
+            }
+            ++kept;
+          }
+        }
+        begin += mask.size();
+        if (begin < total && kept < limit) {
+          auto next = batchFilter(condition, iter, begin, std::min(begin + chunk, total), &mask);
+          NG_RETURN_IF_ERROR(next);
+        }
+      }
+      iter->eraseRange(kept, total);
+    }
+    size_t kept = 0;
+    while (!batched.value() && iter->valid() && kept < limit) {
+      const auto &val = compiled.eval(ctx(iter));
       if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
         return Status::Error("Failed to evaluate condition: %s. %s%s",
                              condition->toString().c_str(),
@@ -122,9 +175,14 @@ Status FilterExecutor::handleSingleJobFilter() {
           iter->unstableErase();
         }
       } else {
+        ++kept;
         iter->next();
       }
     }
+    if (!batched.value() && iter->valid()) {
+      // The rows kept are in the front
+      iter->eraseRange(kept, iter->size());
+    }
 
     iter->reset();
     builder.iter(std::move(result).iter());
@@ -132,9 +190,27 @@ Status FilterExecutor::handleSingleJobFilter() {
   } else {
     DataSet ds;
     ds.colNames = result.getColNames();
-    ds.rows.reserve(iter->size());
-    for (; iter->valid(); iter->next()) {
-      auto val = condition->eval(ctx(iter));
+    ds.rows.reserve(std::min(limit, total));
+    std::vector<uint8_t> mask;
+    auto batched = batchFilter(condition, iter, 0, std::min(chunk, total), &mask);
+    NG_RETURN_IF_ERROR(batched);
+    if (batched.value()) {
+      auto rows = static_cast<SequentialIter *>(iter)->begin();
+      for (size_t begin = 0; begin < total && ds.rows.size() < limit;) {
+        for (size_t i = 0; i < mask.size() && ds.rows.size() < limit; ++i) {
+          if (mask[i]) {
+            ds.rows.emplace_back(rows[begin + i]);
+          }
+        }
+        begin += mask.size();
+        if (begin < total && ds.rows.size() < limit) {
+          auto next = batchFilter(condition, iter, begin, std::min(begin + chunk, total), &mask);
+          NG_RETURN_IF_ERROR(next);
+        }
+      }
+    }
+    for (; !batched.value() && iter->valid() && ds.rows.size() < limit; iter->next()) {
+      const auto &val = compiled.eval(ctx(iter));
       if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
         return Status::Error("Failed to evaluate condition: %s. %s%s",
                              condition->toString().c_str(),
@@ -151,5 +227,41 @@ Status FilterExecutor::handleSingleJobFilter() {
   }
 }
 
+StatusOr<bool> FilterExecutor::batchFilter(const Expression *condition,
+                                           Iterator *iter,
+                                           size_t begin,
+                                           size_t end,
+                                           std::vector<uint8_t> *mask) {
+  if (!iter->isSequentialIter()) {
+    return false;
+  }
+  auto *seqIter = static_cast<SequentialIter *>(iter);
+  BatchEvaluator evaluator(seqIter->getColIndices(), seqIter->getColIndices().size());
+  if (!evaluator.accept(condition)) {
+    return false;
+  }
+  auto batch = seqIter->columnBatch(evaluator.inputColumns(), begin, end);
+  auto result = evaluator.eval(condition, batch);
+  mask->assign(result.size(), 0);
+  if (result.kind() == Column::Kind::kBool) {
+    const auto &bools = result.bools();
+    for (size_t i = 0; i < result.size(); ++i) {
+      (*mask)[i] = bools[i] && !result.isNull(i);
+    }
+    return true;
+  }
+  for (size_t i = 0; i < result.size(); ++i) {
+    auto val = result.value(i);
+    if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
+      return Status::Error("Failed to evaluate condition: %s. %s%s",
+                           condition->toString().c_str(),
+                           "For boolean conditions, please write in their full forms like",
+                           " <condition> == <true/false> or <condition> IS [NOT] NULL.");
+    }
+    (*mask)[i] = !(val.empty() || val.isNull() || (val.isImplicitBool() && !val.implicitBool()));
+  }
+  return true;
+}
+
 }  // namespace graph
 }  // namespace nebula
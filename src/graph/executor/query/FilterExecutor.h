@@ -22,6 +22,15 @@ class FilterExecutor final : public Executor {
   StatusOr<DataSet> handleJob(size_t begin, size_t end, Iterator *iter);
 
   Status handleSingleJobFilter();
+
+ private:
+  // Evaluate the condition over the rows [begin, end) of a sequential iterator in batch, and mark
+  // the rows meeting the condition in mask. Return false if it can't be evaluated in batch.
+  StatusOr<bool> batchFilter(const Expression *condition,
+                             Iterator *iter,
+                             size_t begin,
+                             size_t end,
+                             std::vector<uint8_t> *mask);
 };
 
 }  // namespace graph
@@ -4,8 +4,10 @@
 
 #include "graph/executor/query/FulltextIndexScanExecutor.h"
 
+#include "common/base/ConcurrentLRUCache.h"
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
+#include "common/time/WallClock.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/util/Constants.h"
 #include "graph/util/FTIndexUtils.h"
@@ -16,6 +18,43 @@ using nebula::storage::cpp2::GetPropResponse;
 
 namespace nebula::graph {
 
+namespace {
+
+struct CachedResult {
+  plugin::ESQueryResult result;
+  int64_t expiredAtMs;
+};
+
+using ResultCache = ConcurrentLRUCache<std::string, std::shared_ptr<const CachedResult>>;
+
+ResultCache& resultCache() {
+  static ResultCache cache(std::max<size_t>(FLAGS_ft_query_cache_capacity, 64));
+  return cache;
+}
+
+// The key of a query, whose whitespaces are collapsed, so the queries differing only in them share
+// the results
+std::string cacheKey(GraphSpaceID space,
+                     const std::string& index,
+                     const std::string& query,
+                     int64_t offset,
+                     int64_t count) {
+  std::string normalized;
+  normalized.reserve(query.size());
+  for (auto c : folly::trimWhitespace(query)) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      if (normalized.back() != ' ') {
+        normalized.push_back(' ');
+      }
+    } else {
+      normalized.push_back(c);
+    }
+  }
+  return folly::sformat("{}/{}/{}/{}/{}", space, index, offset, count, normalized);
+}
+
+}  // namespace
+
 folly::Future<Status> FulltextIndexScanExecutor::execute() {
   auto esAdapterResult = FTIndexUtils::getESAdapter(qctx_->getMetaClient());
   if (!esAdapterResult.ok()) {
@@ -94,6 +133,21 @@ StatusOr<plugin::ESQueryResult> FulltextIndexScanExecutor::accessFulltextIndex(
         return plugin::ESQueryResult();
       }
       execFunc = [=, &esAdapter]() { return esAdapter.queryString(index, query, offset, count); };
+      if (FLAGS_ft_query_cache_ttl_ms > 0) {
+        auto key = cacheKey(qctx()->rctx()->session()->space().id, index, query, offset, count);
+        auto now = time::WallClock::fastNowInMilliSec();
+        auto cached = resultCache().get(key);
+        if (cached.ok() && cached.value()->expiredAtMs > now) {
+          return cached.value()->result;
+        }
+        auto result = execFunc();
+        if (result.ok()) {
+          resultCache().insert(std::move(key),
+                               std::make_shared<const CachedResult>(CachedResult{
+                                   result.value(), now + FLAGS_ft_query_cache_ttl_ms}));
+        }
+        return result;
+      }
       break;
     }
     default: {
@@ -5,6 +5,7 @@
 #include "graph/executor/query/GetEdgesExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/SchemaUtil.h"
 
 using nebula::storage::StorageClient;
@@ -85,6 +86,7 @@ folly::Future<Status> GetEdgesExecutor::getEdges() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   return DCHECK_NOTNULL(client)
       ->getProps(param,
                  std::move(edges),
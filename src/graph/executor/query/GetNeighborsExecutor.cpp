@@ -26,6 +26,10 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
   NG_RETURN_IF_ERROR(res);
   auto vids = std::move(res).value();
   if (vids.empty()) {
+    if (gn_->statsOnly()) {
+      DataSet emptyResult(gn_->colNames());
+      return finish(ResultBuilder().value(Value(std::move(emptyResult))).build());
+    }
     List emptyResult;
     return finish(ResultBuilder()
                       .value(Value(std::move(emptyResult)))
@@ -40,6 +44,7 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   return storageClient
       ->getNeighbors(param,
                      {nebula::kVid},
@@ -55,7 +60,8 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
                      gn_->orderBy(),
                      gn_->limit(qec),
                      gn_->filter(),
-                     nullptr)
+                     nullptr,
+                     gn_->statsOnly())
       .via(runner())
       .ensure([this, getNbrTime]() {
         SCOPED_TIMER(&execTime_);
@@ -74,7 +80,7 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
           auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
           addState(folly::sformat("resp[{}]", i), info);
         }
-        return handleResponse(resp);
+        return gn_->statsOnly() ? handleStatsResponse(resp) : handleResponse(resp);
       });
 }
 
@@ -87,16 +93,49 @@ Status GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
   auto& responses = resps.responses();
   List list;
   for (auto& resp : responses) {
-    auto dataset = resp.get_vertices();
-    if (dataset == nullptr) {
+    auto dataset = resp.vertices_ref();
+    if (!dataset.has_value()) {
       continue;
     }
 
+    internStrings(*dataset);
     list.values.emplace_back(std::move(*dataset));
   }
   builder.value(Value(std::move(list))).iter(Iterator::Kind::kGetNeighbors);
   return finish(builder.build());
 }
 
+Status GetNeighborsExecutor::handleStatsResponse(RpcResponse& resps) {
+  auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
+  NG_RETURN_IF_ERROR(result);
+  ResultBuilder builder;
+  builder.state(result.value());
+
+  DataSet ds(gn_->colNames());
+  for (auto& resp : resps.responses()) {
+    auto dataset = resp.get_vertices();
+    if (dataset == nullptr) {
+      continue;
+    }
+    for (auto& row : dataset->rows) {
+      // The first column is the vid, and the second one is the list of the stats
+      DCHECK_GE(row.size(), 2u);
+      Row newRow;
+      newRow.values.reserve(ds.colNames.size());
+      newRow.values.emplace_back(std::move(row.values[0]));
+      if (row.values[1].isList()) {
+        auto& stats = row.values[1].mutableList().values;
+        for (auto& stat : stats) {
+          newRow.values.emplace_back(std::move(stat));
+        }
+      }
+      newRow.values.resize(ds.colNames.size());
+      ds.rows.emplace_back(std::move(newRow));
+    }
+  }
+  builder.value(Value(std::move(ds)));
+  return finish(builder.build());
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -26,6 +26,8 @@ class GetNeighborsExecutor final : public StorageAccessExecutor {
  private:
   using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
   Status handleResponse(RpcResponse& resps);
+  // The stats only responses are flattened into a dataset of the vid and the stats of each vertex
+  Status handleStatsResponse(RpcResponse& resps);
 
  private:
   const GetNeighbors* gn_;
@@ -18,9 +18,11 @@ class GetPropExecutor : public StorageAccessExecutor {
   GetPropExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
       : StorageAccessExecutor(name, node, qctx) {}
 
+  // The rows of prefetched, which are not requested from storage, are merged as well
   template <typename Response>
   Status handleResp(storage::StorageRpcResponse<Response> &&rpcResp,
-                    const std::vector<std::string> &colNames) {
+                    const std::vector<std::string> &colNames,
+                    nebula::DataSet *prefetched = nullptr) {
     auto result = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
     NG_RETURN_IF_ERROR(result);
     auto state = std::move(result).value();
@@ -28,6 +30,7 @@ class GetPropExecutor : public StorageAccessExecutor {
     nebula::DataSet v;
     for (auto &resp : rpcResp.responses()) {
       if (resp.props_ref().has_value()) {
+        internStrings(*resp.props_ref());
         if (UNLIKELY(!v.append(std::move(*resp.props_ref())))) {
           // it's impossible according to the interface
           LOG(ERROR) << "Heterogeneous props dataset";
@@ -37,6 +40,10 @@ class GetPropExecutor : public StorageAccessExecutor {
         state = Result::State::kPartialSuccess;
       }
     }
+    if (prefetched != nullptr && !prefetched->rows.empty() && !v.append(std::move(*prefetched))) {
+      LOG(ERROR) << "Heterogeneous props dataset";
+      state = Result::State::kPartialSuccess;
+    }
     if (!colNames.empty()) {
       DCHECK_EQ(colNames.size(), v.colSize());
       v.colNames = colNames;
@@ -44,6 +51,81 @@ class GetPropExecutor : public StorageAccessExecutor {
     return finish(
         ResultBuilder().value(std::move(v)).iter(Iterator::Kind::kProp).state(state).build());
   }
+
+  using ScanCursors = std::unordered_map<PartitionID, storage::cpp2::ScanCursor>;
+  using ScanRpcResponse = storage::StorageRpcResponse<storage::cpp2::ScanResponse>;
+
+  // Scan the parts page by page, the scan(cursors) returns the page continuing the parts in cursors.
+  // The next page is requested before the rows of current page are merged, so that the storage
+  // keeps iterating the parts while the graph is merging the rows.
+  template <typename ScanFunc>
+  folly::Future<Status> scanByPage(folly::SemiFuture<ScanRpcResponse> &&page,
+                                   ScanFunc &&scan,
+                                   std::vector<std::string> colNames) {
+    return std::move(page).via(runner()).thenValue(
+        [this, scan = std::forward<ScanFunc>(scan), colNames = std::move(colNames)](
+            ScanRpcResponse &&rpcResp) mutable -> folly::Future<Status> {
+          memory::MemoryCheckGuard guard;
+          SCOPED_TIMER(&execTime_);
+          auto &hostLatency = rpcResp.hostLatency();
+          for (size_t i = 0; i < hostLatency.size(); ++i) {
+            auto info =
+                util::collectRespProfileData(rpcResp.responses()[i].get_result(), hostLatency[i]);
+            addState(folly::sformat("page[{}].resp[{}]", numPages_, i), std::move(info));
+          }
+          ++numPages_;
+          auto result = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
+          NG_RETURN_IF_ERROR(result);
+          if (result.value() != Result::State::kSuccess) {
+            pagesState_ = result.value();
+          }
+
+          ScanCursors cursors;
+          for (auto &resp : rpcResp.responses()) {
+            for (auto &[partId, cursor] : resp.get_cursors()) {
+              if (cursor.next_cursor_ref().has_value()) {
+                cursors.emplace(partId, cursor);
+              }
+            }
+          }
+          folly::Optional<folly::SemiFuture<ScanRpcResponse>> next;
+          if (!cursors.empty()) {
+            next = scan(&cursors);
+          }
+
+          for (auto &resp : rpcResp.responses()) {
+            if (resp.props_ref().has_value()) {
+              internStrings(*resp.props_ref());
+              if (UNLIKELY(!pages_.append(std::move(*resp.props_ref())))) {
+                // it's impossible according to the interface
+                LOG(ERROR) << "Heterogeneous props dataset";
+                pagesState_ = Result::State::kPartialSuccess;
+              }
+            } else {
+              pagesState_ = Result::State::kPartialSuccess;
+            }
+          }
+          if (next.has_value()) {
+            return scanByPage(std::move(next).value(), std::move(scan), std::move(colNames));
+          }
+
+          if (!colNames.empty()) {
+            DCHECK_EQ(colNames.size(), pages_.colSize());
+            pages_.colNames = std::move(colNames);
+          }
+          return finish(ResultBuilder()
+                            .value(std::move(pages_))
+                            .iter(Iterator::Kind::kProp)
+                            .state(pagesState_)
+                            .build());
+        });
+  }
+
+ private:
+  // The rows merged from the scanned pages
+  nebula::DataSet pages_;
+  Result::State pagesState_{Result::State::kSuccess};
+  size_t numPages_{0};
 };
 
 }  // namespace graph
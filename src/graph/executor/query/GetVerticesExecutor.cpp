@@ -4,6 +4,8 @@
 
 #include "graph/executor/query/GetVerticesExecutor.h"
 
+#include "graph/service/GraphFlags.h"
+
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetPropResponse;
@@ -24,10 +26,15 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
   auto res = buildRequestDataSet(gv);
   NG_RETURN_IF_ERROR(res);
   auto vertices = std::move(res).value();
+  takePrefetched(gv, vertices);
   if (vertices.rows.empty()) {
     // TODO: add test for empty input.
+    DataSet result(gv->colNames());
+    if (!prefetched_.rows.empty()) {
+      result.rows = std::move(prefetched_.rows);
+    }
     return finish(
-        ResultBuilder().value(Value(DataSet(gv->colNames()))).iter(Iterator::Kind::kProp).build());
+        ResultBuilder().value(Value(std::move(result))).iter(Iterator::Kind::kProp).build());
   }
 
   time::Duration getPropsTime;
@@ -35,6 +42,7 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   return DCHECK_NOTNULL(storageClient)
       ->getProps(param,
                  std::move(vertices),
@@ -54,10 +62,45 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
         memory::MemoryCheckGuard guard;
         SCOPED_TIMER(&execTime_);
         addStats(rpcResp);
-        return handleResp(std::move(rpcResp), gv->colNames());
+        return handleResp(std::move(rpcResp), gv->colNames(), &prefetched_);
       });
 }
 
+void GetVerticesExecutor::takePrefetched(const GetVertices *gv, DataSet &vertices) {
+  if (gv->prefetchedVar().empty()) {
+    return;
+  }
+  // The variable is read by this node only
+  auto value = ectx_->getResult(gv->prefetchedVar()).valuePtr();
+  ectx_->dropResult(gv->prefetchedVar());
+  if (value == nullptr || !value->isDataSet() || value->getDataSet().rows.empty()) {
+    return;
+  }
+  const auto &fetched = value->getDataSet();
+  // The first column of the props of the vertices is their vid
+  std::unordered_map<Value, const Row *> prefetched;
+  prefetched.reserve(fetched.rows.size());
+  for (const auto &row : fetched.rows) {
+    if (!row.values.empty()) {
+      prefetched.emplace(row.values.front(), &row);
+    }
+  }
+  prefetched_.colNames = fetched.colNames;
+  std::vector<Row> rest;
+  rest.reserve(vertices.rows.size());
+  for (auto &row : vertices.rows) {
+    auto found = prefetched.find(row.values.front());
+    if (found == prefetched.end() || found->second == nullptr) {
+      rest.emplace_back(std::move(row));
+      continue;
+    }
+    prefetched_.rows.emplace_back(*found->second);
+    // The vertices are taken once, even if duplicated in the input
+    found->second = nullptr;
+  }
+  vertices.rows = std::move(rest);
+}
+
 StatusOr<DataSet> GetVerticesExecutor::buildRequestDataSet(const GetVertices *gv) {
   if (gv == nullptr) {
     return nebula::DataSet({kVid});
@@ -22,6 +22,11 @@ class GetVerticesExecutor final : public GetPropExecutor {
   StatusOr<DataSet> buildRequestDataSet(const GetVertices *gv);
 
   folly::Future<Status> getVertices();
+
+  // Move the vertices of the prefetched variable of gv from vertices into prefetched_
+  void takePrefetched(const GetVertices *gv, DataSet &vertices);
+
+  DataSet prefetched_;
 };
 
 }  // namespace graph
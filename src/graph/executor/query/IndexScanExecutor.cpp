@@ -72,6 +72,23 @@ folly::Future<Status> IndexScanExecutor::indexScan() {
     return Status::Error("There is no index to use at runtime");
   }
 
+  if (!lookup->runtimeFilterVar().empty()) {
+    auto keys = runtimeFilterKeys(lookup);
+    if (keys.empty()) {
+      DataSet ds(lookup->colNames());
+      return finish(
+          ResultBuilder().value(Value(std::move(ds))).iter(Iterator::Kind::kProp).build());
+    }
+    auto tagName = qctx()->schemaMng()->toTagName(lookup->space(), lookup->schemaId());
+    NG_RETURN_IF_ERROR(tagName);
+    for (auto &ictx : ictxs) {
+      const auto &filterStr = ictx.get_filter();
+      auto *filter = filterStr.empty() ? nullptr : Expression::decode(objPool, filterStr);
+      filter = addRuntimeFilter(filter, keys, {tagName.value()});
+      ictx.filter_ref() = filter == nullptr ? "" : Expression::encode(*filter);
+    }
+  }
+
   StorageClient::CommonRequestParam param(lookup->space(),
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
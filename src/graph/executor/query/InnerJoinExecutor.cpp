@@ -39,7 +39,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
   }
 
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
+    JoinHashTable<Value> hashTable;
     hashTable.reserve(bucketSize);
     if (lhsIter_->size() < rhsIter_->size()) {
       buildSingleKeyHashTable(hashKeys.front(), lhsIter_.get(), hashTable);
@@ -52,7 +52,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    JoinHashTable<List> hashTable;
     hashTable.reserve(bucketSize);
     if (lhsIter_->size() < rhsIter_->size()) {
       buildHashTable(hashKeys, lhsIter_.get(), hashTable);
@@ -65,14 +65,14 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
       result = probe(hashKeys, lhsIter_.get(), hashTable);
     }
   }
+  addProbeStats(exchange_ ? lhsIter_->size() : rhsIter_->size(), result.rows.size());
   result.colNames = colNames;
   return finish(ResultBuilder().value(Value(std::move(result))).build());
 }
 
-DataSet InnerJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+DataSet InnerJoinExecutor::probe(const std::vector<Expression*>& probeKeys,
+                                 Iterator* probeIter,
+                                 const JoinHashTable<List>& hashTable) const {
   DataSet ds;
   QueryExpressionContext ctx(ectx_);
   ds.rows.reserve(probeIter->size());
@@ -94,10 +94,9 @@ DataSet InnerJoinExecutor::probe(
   return ds;
 }
 
-DataSet InnerJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
+DataSet InnerJoinExecutor::singleKeyProbe(Expression* probeKey,
+                                          Iterator* probeIter,
+                                          const JoinHashTable<Value>& hashTable) const {
   DataSet ds;
   QueryExpressionContext ctx(ectx_);
   for (; probeIter->valid(); probeIter->next()) {
@@ -172,7 +171,8 @@ folly::Future<Status> InnerJoinExecutor::probe(const std::vector<Expression*>& p
     return ds;
   };
 
-  auto gather = [this](std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
+  auto gather = [this, probeRows = probeIter->size()](
+                    std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
     memory::MemoryCheckGuard guard;
     DataSet result;
     auto* joinNode = asNode<Join>(node());
@@ -193,6 +193,7 @@ folly::Future<Status> InnerJoinExecutor::probe(const std::vector<Expression*>& p
                          std::make_move_iterator(rows.begin()),
                          std::make_move_iterator(rows.end()));
     }
+    addProbeStats(probeRows, result.rows.size());
     finish(ResultBuilder().value(Value(std::move(result))).build());
     return Status::OK();
   };
@@ -214,7 +215,8 @@ folly::Future<Status> InnerJoinExecutor::singleKeyProbe(Expression* probeKey, It
     return ds;
   };
 
-  auto gather = [this](std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
+  auto gather = [this, probeRows = probeIter->size()](
+                    std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
     memory::MemoryCheckGuard guard;
     DataSet result;
     auto* joinNode = asNode<Join>(node());
@@ -235,6 +237,7 @@ folly::Future<Status> InnerJoinExecutor::singleKeyProbe(Expression* probeKey, It
                          std::make_move_iterator(rows.begin()),
                          std::make_move_iterator(rows.end()));
     }
+    addProbeStats(probeRows, result.rows.size());
     finish(ResultBuilder().value(Value(std::move(result))).build());
     return Status::OK();
   };
@@ -243,26 +246,26 @@ folly::Future<Status> InnerJoinExecutor::singleKeyProbe(Expression* probeKey, It
 }
 
 template <class T>
-void InnerJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
+void InnerJoinExecutor::buildNewRow(const JoinHashTable<T>& hashTable,
                                     const T& val,
                                     Row rRow,
                                     DataSet& ds) const {
-  const auto& range = hashTable.find(val);
-  if (range == hashTable.end()) {
+  const auto* range = hashTable.find(val);
+  if (range == nullptr) {
     return;
   }
-  for (std::size_t i = 0, e = range->second.size() - 1; i < e; ++i) {
+  for (std::size_t i = 0, e = range->size() - 1; i < e; ++i) {
     if (exchange_) {
-      ds.rows.emplace_back(newRow(rRow, *range->second[i]));
+      ds.rows.emplace_back(newRow(rRow, *(*range)[i]));
     } else {
-      ds.rows.emplace_back(newRow(*range->second[i], rRow));
+      ds.rows.emplace_back(newRow(*(*range)[i], rRow));
     }
   }
   // Move probe row in last new row creating
   if (exchange_) {
-    ds.rows.emplace_back(newRow(std::move(rRow), *range->second.back()));
+    ds.rows.emplace_back(newRow(std::move(rRow), *range->back()));
   } else {
-    ds.rows.emplace_back(newRow(*range->second.back(), std::move(rRow)));
+    ds.rows.emplace_back(newRow(*range->back(), std::move(rRow)));
   }
 }
 
@@ -16,6 +16,9 @@ folly::Future<Status> IntersectExecutor::execute() {
 
   auto left = getLeftInputData();
   auto right = getRightInputData();
+  if (multiJobs(left, right)) {
+    return probeMultiJobs(std::move(left), std::move(right), true);
+  }
 
   std::unordered_set<const Row*> hashSet;
   for (; right.iterRef()->valid(); right.iterRef()->next()) {
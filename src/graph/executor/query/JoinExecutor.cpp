@@ -5,6 +5,7 @@
 #include "graph/executor/query/JoinExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
 
 namespace nebula {
 namespace graph {
@@ -29,6 +30,7 @@ Status JoinExecutor::checkInputDataSets() {
     return Status::Error(ss.str());
   }
   colSize_ = join->colNames().size();
+  bindKeys(join->hashKeys(), join->probeKeys());
   return Status::OK();
 }
 
@@ -49,6 +51,7 @@ Status JoinExecutor::checkBiInputDataSets() {
     return Status::Error(ss.str());
   }
   colSize_ = join->colNames().size();
+  bindKeys(join->hashKeys(), join->probeKeys());
 
   auto& lhsResult = ectx_->getResult(join->leftInputVar());
   auto& lhsColNames = lhsResult.valuePtr()->getDataSet().colNames;
@@ -73,9 +76,21 @@ Status JoinExecutor::checkBiInputDataSets() {
   return Status::OK();
 }
 
+void JoinExecutor::bindKeys(const std::vector<Expression*>& hashKeys,
+                            const std::vector<Expression*>& probeKeys) {
+  for (auto* key : hashKeys) {
+    ExpressionUtils::bindColumns(key, lhsIter_.get());
+  }
+  for (auto* key : probeKeys) {
+    ExpressionUtils::bindColumns(key, rhsIter_.get());
+  }
+}
+
 void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
                                   Iterator* iter,
-                                  std::unordered_map<List, std::vector<const Row*>>& hashTable) {
+                                  JoinHashTable<List>& hashTable) {
+  buildTime_.reset();
+  auto buildRows = iter->size();
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     List list;
@@ -85,22 +100,41 @@ void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
       list.values.emplace_back(std::move(val));
     }
 
-    auto& vals = hashTable[list];
-    vals.emplace_back(iter->row());
+    hashTable.add(std::move(list), iter->row());
   }
+  hashTable.build();
+  addBuildStats(iter, buildRows, hashTable.size());
 }
 
-void JoinExecutor::buildSingleKeyHashTable(
-    Expression* hashKey,
-    Iterator* iter,
-    std::unordered_map<Value, std::vector<const Row*>>& hashTable) {
+void JoinExecutor::buildSingleKeyHashTable(Expression* hashKey,
+                                           Iterator* iter,
+                                           JoinHashTable<Value>& hashTable) {
+  buildTime_.reset();
+  auto buildRows = iter->size();
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
-    auto& val = hashKey->eval(ctx(iter));
-
-    auto& vals = hashTable[val];
-    vals.emplace_back(iter->row());
+    hashTable.add(hashKey->eval(ctx(iter)), iter->row());
   }
+  hashTable.build();
+  addBuildStats(iter, buildRows, hashTable.size());
+}
+
+void JoinExecutor::addBuildStats(const Iterator* iter, size_t buildRows, size_t keys) {
+  addState("build_time", buildTime_);
+  folly::dynamic stats = folly::dynamic::object();
+  stats.insert("side", iter == lhsIter_.get() ? "left" : "right");
+  stats.insert("rows", buildRows);
+  stats.insert("keys", keys);
+  addState("build", stats);
+  probeTime_.reset();
+}
+
+void JoinExecutor::addProbeStats(size_t probeRows, size_t outputRows) {
+  addState("probe_time", probeTime_);
+  folly::dynamic stats = folly::dynamic::object();
+  stats.insert("rows", probeRows);
+  stats.insert("output_rows", outputRows);
+  addState("probe", stats);
 }
 
 Row JoinExecutor::newRow(Row left, Row right) const {
@@ -6,6 +6,7 @@
 #define GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 
 #include "graph/executor/Executor.h"
+#include "graph/executor/query/JoinHashTable.h"
 
 namespace nebula {
 namespace graph {
@@ -20,13 +21,21 @@ class JoinExecutor : public Executor {
 
   Status checkBiInputDataSets();
 
+  // The keys of the left are evaluated on lhsIter_, and the ones of the right on rhsIter_
+  void bindKeys(const std::vector<Expression*>& hashKeys,
+                const std::vector<Expression*>& probeKeys);
+
   void buildHashTable(const std::vector<Expression*>& hashKeys,
                       Iterator* iter,
-                      std::unordered_map<List, std::vector<const Row*>>& hashTable);
+                      JoinHashTable<List>& hashTable);
 
   void buildSingleKeyHashTable(Expression* hashKey,
                                Iterator* iter,
-                               std::unordered_map<Value, std::vector<const Row*>>& hashTable);
+                               JoinHashTable<Value>& hashTable);
+
+  // Record the cardinalities of the probe side and the output, and the time since the hash table
+  // was built, in the profiling stats. The build side is recorded by building the hash table.
+  void addProbeStats(size_t probeRows, size_t outputRows);
 
   // concat rows
   Row newRow(Row left, Row right) const;
@@ -40,8 +49,15 @@ class JoinExecutor : public Executor {
   // If the join is natural join, rhsOutputColIdxs_ will be used to record the output column index
   // of the right. If not, rhsOutputColIdxs_ will be empty.
   std::optional<std::vector<size_t>> rhsOutputColIdxs_;
-  std::unordered_map<Value, std::vector<const Row*>> hashTable_;
-  std::unordered_map<List, std::vector<const Row*>> listHashTable_;
+  JoinHashTable<Value> hashTable_;
+  JoinHashTable<List> listHashTable_;
+
+ private:
+  void addBuildStats(const Iterator* iter, size_t buildRows, size_t keys);
+
+  time::Duration buildTime_;
+  // Restarted when the hash table is built
+  time::Duration probeTime_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -0,0 +1,216 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_QUERY_JOINHASHTABLE_H_
+#define GRAPH_EXECUTOR_QUERY_JOINHASHTABLE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/base/Arena.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+// The hash table of the build side of the hash joins, from the join key (a Value or a List) to
+// the build rows having it.
+//
+// The keys are added first, then the table is built at once: the keys are partitioned by the
+// radix of their hashes so that each partition is an open addressing table small enough to stay
+// in cache, and the slots keep the hashes to skip comparing the keys of the other hashes. A bloom
+// filter over the hashes rejects most of the probe keys without a match before touching the
+// partitions. The lists of the build rows are allocated from an arena owned by the table, so they
+// are released with a few chunks rather than one by one.
+//
+// Usage:
+//   JoinHashTable<Value> table;
+//   table.reserve(n);
+//   table.add(key, row);  // n times
+//   table.build();
+//   auto* rows = table.find(key);
+template <typename K>
+class JoinHashTable final {
+ public:
+  using Rows = std::vector<const Row*, ArenaAllocator<const Row*>>;
+
+  // The number of the build rows per partition is about kPartitionRows
+  static constexpr size_t kPartitionRows = 1024;
+  static constexpr size_t kMaxRadixBits = 8;
+
+  JoinHashTable() : arena_(std::make_unique<Arena>()) {}
+
+  void clear() {
+    pending_.clear();
+    partitions_.clear();
+    arena_ = std::make_unique<Arena>();
+    bloom_.clear();
+    radixBits_ = 0;
+    size_ = 0;
+  }
+
+  void reserve(size_t n) {
+    pending_.reserve(n);
+  }
+
+  void add(K key, const Row* row) {
+    auto hash = hashOf(key);
+    pending_.emplace_back(Pending{hash, std::move(key), row});
+  }
+
+  // Move the added keys into the partitions, the table could be probed after it
+  void build() {
+    auto n = pending_.size();
+    radixBits_ = 0;
+    while (radixBits_ < kMaxRadixBits && (kPartitionRows << radixBits_) < n) {
+      ++radixBits_;
+    }
+    partitions_.clear();
+    partitions_.resize(size_t(1) << radixBits_);
+
+    std::vector<size_t> offsets(partitions_.size() + 1, 0);
+    for (auto& p : pending_) {
+      ++offsets[partitionOf(p.hash) + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+    // The rows of the same key stay in the order of adding
+    std::vector<uint32_t> order(n);
+    {
+      auto next = offsets;
+      for (size_t i = 0; i < n; ++i) {
+        order[next[partitionOf(pending_[i].hash)]++] = static_cast<uint32_t>(i);
+      }
+    }
+
+    bloom_.assign(std::max<size_t>(1, n / 8), 0);
+    for (size_t p = 0; p < partitions_.size(); ++p) {
+      auto& partition = partitions_[p];
+      auto count = offsets[p + 1] - offsets[p];
+      size_t capacity = 8;
+      while (capacity < count * 2) {
+        capacity <<= 1;
+      }
+      partition.slots.assign(capacity, Slot{0, 0});
+      partition.mask = capacity - 1;
+      for (auto i = offsets[p]; i < offsets[p + 1]; ++i) {
+        auto& item = pending_[order[i]];
+        insert(&partition, item.hash, std::move(item.key), item.row);
+        bloom_[bloomWord(item.hash)] |= bloomBits(item.hash);
+      }
+    }
+    std::vector<Pending>().swap(pending_);
+  }
+
+  // The build rows of the key, or nullptr if there is none
+  const Rows* find(const K& key) const {
+    if (size_ == 0) {
+      return nullptr;
+    }
+    auto hash = hashOf(key);
+    auto bits = bloomBits(hash);
+    if ((bloom_[bloomWord(hash)] & bits) != bits) {
+      return nullptr;
+    }
+    auto& partition = partitions_[partitionOf(hash)];
+    for (auto i = hash & partition.mask;; i = (i + 1) & partition.mask) {
+      auto& slot = partition.slots[i];
+      if (slot.entry == 0) {
+        return nullptr;
+      }
+      if (slot.hash == hash) {
+        auto& entry = partition.entries[slot.entry - 1];
+        if (entry.first == key) {
+          return &entry.second;
+        }
+      }
+    }
+  }
+
+  // The number of distinct keys
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  struct Pending {
+    uint64_t hash;
+    K key;
+    const Row* row;
+  };
+
+  struct Slot {
+    uint64_t hash;
+    // The index of the entry plus one, zero if the slot is empty
+    size_t entry;
+  };
+
+  struct Partition {
+    std::vector<Slot> slots;
+    size_t mask{0};
+    std::vector<std::pair<K, Rows>> entries;
+  };
+
+  using Hash = std::conditional_t<std::is_same<K, List>::value, MixedListHash, MixedValueHash>;
+
+  // The hashes are mixed to spread over the radix bits
+  static uint64_t hashOf(const K& key) {
+    return Hash()(key);
+  }
+
+  size_t partitionOf(uint64_t hash) const {
+    return radixBits_ == 0 ? 0 : hash >> (64 - radixBits_);
+  }
+
+  size_t bloomWord(uint64_t hash) const {
+    return (hash >> 12) % bloom_.size();
+  }
+
+  static uint64_t bloomBits(uint64_t hash) {
+    return (uint64_t(1) << (hash & 63)) | (uint64_t(1) << ((hash >> 6) & 63));
+  }
+
+  void insert(Partition* partition, uint64_t hash, K key, const Row* row) {
+    for (auto i = hash & partition->mask;; i = (i + 1) & partition->mask) {
+      auto& slot = partition->slots[i];
+      if (slot.entry == 0) {
+        partition->entries.emplace_back(std::move(key),
+                                        Rows(1, row, ArenaAllocator<const Row*>(arena_.get())));
+        slot.hash = hash;
+        slot.entry = partition->entries.size();
+        ++size_;
+        return;
+      }
+      if (slot.hash == hash) {
+        auto& entry = partition->entries[slot.entry - 1];
+        if (entry.first == key) {
+          entry.second.emplace_back(row);
+          return;
+        }
+      }
+    }
+  }
+
+  std::vector<Pending> pending_;
+  // The entries of the partitions refer to the arena, so it's released after them
+  std::unique_ptr<Arena> arena_;
+  std::vector<Partition> partitions_;
+  std::vector<uint64_t> bloom_;
+  size_t radixBits_{0};
+  size_t size_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_QUERY_JOINHASHTABLE_H_
@@ -35,7 +35,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
   DCHECK_EQ(hashKeys.size(), probeKeys.size());
   DataSet result;
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
+    JoinHashTable<Value> hashTable;
     hashTable.reserve(rhsIter_->empty() ? 1 : rhsIter_->size());
     if (!lhsIter_->empty()) {
       buildSingleKeyHashTable(probeKeys.front(), rhsIter_.get(), hashTable);
@@ -43,7 +43,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    JoinHashTable<List> hashTable;
     hashTable.reserve(rhsIter_->empty() ? 1 : rhsIter_->size());
     if (!lhsIter_->empty()) {
       buildHashTable(probeKeys, rhsIter_.get(), hashTable);
@@ -51,15 +51,17 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
       result = probe(hashKeys, lhsIter_.get(), hashTable);
     }
   }
+  if (!lhsIter_->empty()) {
+    addProbeStats(lhsIter_->size(), result.rows.size());
+  }
 
   result.colNames = colNames;
   return finish(ResultBuilder().value(Value(std::move(result))).build());
 }
 
-DataSet LeftJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+DataSet LeftJoinExecutor::probe(const std::vector<Expression*>& probeKeys,
+                                Iterator* probeIter,
+                                const JoinHashTable<List>& hashTable) const {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -82,10 +84,9 @@ DataSet LeftJoinExecutor::probe(
   return ds;
 }
 
-DataSet LeftJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
+DataSet LeftJoinExecutor::singleKeyProbe(Expression* probeKey,
+                                         Iterator* probeIter,
+                                         const JoinHashTable<Value>& hashTable) const {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -149,7 +150,8 @@ folly::Future<Status> LeftJoinExecutor::probe(const std::vector<Expression*>& pr
     return ds;
   };
 
-  auto gather = [this](std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
+  auto gather = [this, probeRows = probeIter->size()](
+                    std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
     memory::MemoryCheckGuard guard;
     DataSet result;
     auto* joinNode = asNode<Join>(node());
@@ -170,6 +172,7 @@ folly::Future<Status> LeftJoinExecutor::probe(const std::vector<Expression*>& pr
                          std::make_move_iterator(rows.begin()),
                          std::make_move_iterator(rows.end()));
     }
+    addProbeStats(probeRows, result.rows.size());
     return finish(ResultBuilder().value(Value(std::move(result))).build());
   };
 
@@ -190,7 +193,8 @@ folly::Future<Status> LeftJoinExecutor::singleKeyProbe(Expression* probeKey, Ite
     return ds;
   };
 
-  auto gather = [this](std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
+  auto gather = [this, probeRows = probeIter->size()](
+                    std::vector<folly::Try<StatusOr<DataSet>>>&& results) mutable -> Status {
     memory::MemoryCheckGuard guard;
     DataSet result;
     auto* joinNode = asNode<Join>(node());
@@ -211,6 +215,7 @@ folly::Future<Status> LeftJoinExecutor::singleKeyProbe(Expression* probeKey, Ite
                          std::make_move_iterator(rows.begin()),
                          std::make_move_iterator(rows.end()));
     }
+    addProbeStats(probeRows, result.rows.size());
     finish(ResultBuilder().value(Value(std::move(result))).build());
     return Status::OK();
   };
@@ -219,12 +224,12 @@ folly::Future<Status> LeftJoinExecutor::singleKeyProbe(Expression* probeKey, Ite
 }
 
 template <class T>
-void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
+void LeftJoinExecutor::buildNewRow(const JoinHashTable<T>& hashTable,
                                    const T& val,
                                    Row lRow,
                                    DataSet& ds) const {
-  auto range = hashTable.find(val);
-  if (range == hashTable.end()) {
+  const auto* range = hashTable.find(val);
+  if (range == nullptr) {
     auto lRowSize = lRow.size();
     Row newRow;
     newRow.reserve(colSize_);
@@ -235,11 +240,11 @@ void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const
     values.insert(values.end(), colSize_ - lRowSize, Value::kNullValue);
     ds.rows.emplace_back(std::move(newRow));
   } else {
-    for (std::size_t i = 0; i < (range->second.size() - 1); ++i) {
-      ds.rows.emplace_back(newRow(lRow, *range->second[i]));
+    for (std::size_t i = 0; i < (range->size() - 1); ++i) {
+      ds.rows.emplace_back(newRow(lRow, *(*range)[i]));
     }
     // Move probe row in last new row creating
-    ds.rows.emplace_back(newRow(std::move(lRow), *range->second.back()));
+    ds.rows.emplace_back(newRow(std::move(lRow), *range->back()));
   }
 }
 
@@ -18,6 +18,9 @@ folly::Future<Status> MinusExecutor::execute() {
 
   auto left = getLeftInputData();
   auto right = getRightInputData();
+  if (multiJobs(left, right)) {
+    return probeMultiJobs(std::move(left), std::move(right), false);
+  }
 
   robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> hashSet;
   hashSet.reserve(right.iterRef()->size());
@@ -0,0 +1,68 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/query/PartitionedRowSet.h"
+
+#include "graph/context/iterator/SequentialIter.h"
+
+namespace nebula {
+namespace graph {
+
+// static
+std::vector<PartitionedRowSet::HashedRow> PartitionedRowSet::hashRows(Iterator* iter,
+                                                                      size_t begin,
+                                                                      size_t end) {
+  std::vector<HashedRow> hashed;
+  hashed.reserve(end - begin);
+  for (; iter->valid() && begin++ < end; iter->next()) {
+    auto* row = iter->row();
+    hashed.emplace_back(HashedRow{MixedListHash()(*row), row});
+  }
+  return hashed;
+}
+
+// static
+void PartitionedRowSet::keepRows(Iterator* iter, const std::vector<uint8_t>& keep) {
+  DCHECK(iter->isSequentialIter() || iter->isPropIter());
+  DCHECK_EQ(keep.size(), iter->size());
+  auto rows = static_cast<SequentialIter*>(iter)->begin();
+  size_t kept = 0;
+  for (size_t i = 0; i < keep.size(); ++i) {
+    if (keep[i]) {
+      if (kept != i) {
+        rows[kept] = std::move(rows[i]);
+      }
+      ++kept;
+    }
+  }
+  iter->eraseRange(kept, keep.size());
+  iter->reset();
+}
+
+void PartitionedRowSet::build(size_t partition,
+                              const std::vector<HashedRow>& rows,
+                              std::vector<uint8_t>* firsts) {
+  auto& set = sets_[partition];
+  set.reserve(rows.size() / sets_.size() + 1);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    if (partitionOf(rows[i].hash) != partition) {
+      continue;
+    }
+    if (set.emplace(rows[i]).second && firsts != nullptr) {
+      (*firsts)[i] = 1;
+    }
+  }
+}
+
+bool PartitionedRowSet::empty() const {
+  for (auto& set : sets_) {
+    if (!set.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_QUERY_PARTITIONEDROWSET_H_
+#define GRAPH_EXECUTOR_QUERY_PARTITIONEDROWSET_H_
+
+#include <robin_hood.h>
+
+#include <vector>
+
+#include "common/datatypes/DataSet.h"
+#include "graph/context/iterator/Iterator.h"
+
+namespace nebula {
+namespace graph {
+
+// The set of rows partitioned by their hashes, which are computed once. Each partition is built by
+// its own job, so the dedup and set executors could build the sets of large inputs in parallel.
+//
+// Usage:
+//   auto hashed = PartitionedRowSet::hashRows(iter, 0, iter->size());  // in jobs by ranges
+//   PartitionedRowSet set(numPartitions);
+//   set.build(p, hashed, &firsts);  // for each partition p in parallel
+//   set.contains(row);
+class PartitionedRowSet final {
+ public:
+  struct HashedRow {
+    size_t hash;
+    const Row* row;
+  };
+
+  explicit PartitionedRowSet(size_t numPartitions) : sets_(numPartitions) {}
+
+  // The hashed rows of [begin, end) of the iterator that is at the begin
+  static std::vector<HashedRow> hashRows(Iterator* iter, size_t begin, size_t end);
+
+  // Keep the flagged rows of the sequential iterator in order, and erase the others
+  static void keepRows(Iterator* iter, const std::vector<uint8_t>& keep);
+
+  size_t numPartitions() const {
+    return sets_.size();
+  }
+
+  // Insert the rows of the partition, and flag the first ones of the equal rows in firsts, which
+  // could be nullptr. The builds of the different partitions could run at the same time.
+  void build(size_t partition, const std::vector<HashedRow>& rows, std::vector<uint8_t>* firsts);
+
+  bool contains(const HashedRow& row) const {
+    auto& set = sets_[partitionOf(row.hash)];
+    return set.find(row) != set.end();
+  }
+
+  bool empty() const;
+
+ private:
+  struct Hash {
+    size_t operator()(const HashedRow& row) const {
+      return row.hash;
+    }
+  };
+
+  struct Equal {
+    bool operator()(const HashedRow& lhs, const HashedRow& rhs) const {
+      return lhs.hash == rhs.hash && *lhs.row == *rhs.row;
+    }
+  };
+
+  // The high bits pick the partition, the low bits are left to the set of the partition
+  size_t partitionOf(size_t hash) const {
+    return (hash >> 32) % sets_.size();
+  }
+
+  std::vector<robin_hood::unordered_flat_set<HashedRow, Hash, Equal>> sets_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_QUERY_PARTITIONEDROWSET_H_
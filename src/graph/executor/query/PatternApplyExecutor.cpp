@@ -38,10 +38,24 @@ Status PatternApplyExecutor::checkBiInputDataSets() {
   return Status::OK();
 }
 
+bool PatternApplyExecutor::isValidKeysCollected() {
+  if (node()->loopLayers() == 0) {
+    return false;
+  }
+  auto input = ectx_->getResult(asNode<PatternApply>(node())->rightInputVar()).valuePtr();
+  if (input == collectedInput_) {
+    return true;
+  }
+  // Holding the input makes sure it's not another value at the same address
+  collectedInput_ = std::move(input);
+  return false;
+}
+
 void PatternApplyExecutor::collectValidKeys(const std::vector<Expression*>& keyCols,
                                             Iterator* iter,
-                                            std::unordered_set<List>& validKeys) const {
+                                            ListSet& validKeys) const {
   QueryExpressionContext ctx(ectx_);
+  validKeys.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
     List list;
     list.values.reserve(keyCols.size());
@@ -55,8 +69,9 @@ void PatternApplyExecutor::collectValidKeys(const std::vector<Expression*>& keyC
 
 void PatternApplyExecutor::collectValidKey(Expression* keyCol,
                                            Iterator* iter,
-                                           std::unordered_set<Value>& validKey) const {
+                                           ValueSet& validKey) const {
   QueryExpressionContext ctx(ectx_);
+  validKey.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
     auto& val = keyCol->eval(ctx(iter));
     validKey.emplace(val);
@@ -65,20 +80,20 @@ void PatternApplyExecutor::collectValidKey(Expression* keyCol,
 
 DataSet PatternApplyExecutor::applyZeroKey(Iterator* appliedIter, const bool allValid) {
   DataSet ds;
+  if (!allValid) {
+    return ds;
+  }
   ds.rows.reserve(appliedIter->size());
-  QueryExpressionContext ctx(ectx_);
   for (; appliedIter->valid(); appliedIter->next()) {
     Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
-    if (allValid) {
-      ds.rows.emplace_back(std::move(row));
-    }
+    ds.rows.emplace_back(std::move(row));
   }
   return ds;
 }
 
 DataSet PatternApplyExecutor::applySingleKey(Expression* appliedKey,
                                              Iterator* appliedIter,
-                                             const std::unordered_set<Value>& validKey) {
+                                             const ValueSet& validKey) {
   DataSet ds;
   ds.rows.reserve(appliedIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -95,7 +110,7 @@ DataSet PatternApplyExecutor::applySingleKey(Expression* appliedKey,
 
 DataSet PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys,
                                             Iterator* appliedIter,
-                                            const std::unordered_set<List>& validKeys) {
+                                            const ListSet& validKeys) {
   DataSet ds;
   ds.rows.reserve(appliedIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -125,11 +140,13 @@ folly::Future<Status> PatternApplyExecutor::patternApply() {
   auto keyCols = patternApplyNode->keyCols();
   if (keyCols.size() == 0) {
     // Reverse the valid flag if the pattern predicate is an anti-predicate
-    applyZeroKey(lhsIter_.get(), (rhsIter_->size() > 0) ^ isAntiPred_);
+    result = applyZeroKey(lhsIter_.get(), (rhsIter_->size() > 0) ^ isAntiPred_);
   } else if (keyCols.size() == 1) {
-    std::unordered_set<Value> validKey;
-    collectValidKey(keyCols[0]->clone(), rhsIter_.get(), validKey);
-    result = applySingleKey(keyCols[0]->clone(), lhsIter_.get(), validKey);
+    if (!isValidKeysCollected()) {
+      validKey_.clear();
+      collectValidKey(keyCols[0]->clone(), rhsIter_.get(), validKey_);
+    }
+    result = applySingleKey(keyCols[0]->clone(), lhsIter_.get(), validKey_);
   } else {
     // Copy the keyCols to refresh the inside propIndex_ cache
     auto cloneExpr = [](std::vector<Expression*> exprs) {
@@ -141,9 +158,15 @@ folly::Future<Status> PatternApplyExecutor::patternApply() {
       return applyColsCopy;
     };
 
-    std::unordered_set<List> validKeys;
-    collectValidKeys(cloneExpr(keyCols), rhsIter_.get(), validKeys);
-    result = applyMultiKey(cloneExpr(keyCols), lhsIter_.get(), validKeys);
+    if (!isValidKeysCollected()) {
+      validKeys_.clear();
+      collectValidKeys(cloneExpr(keyCols), rhsIter_.get(), validKeys_);
+    }
+    result = applyMultiKey(cloneExpr(keyCols), lhsIter_.get(), validKeys_);
+  }
+  if (node()->loopLayers() == 0) {
+    ValueSet().swap(validKey_);
+    ListSet().swap(validKeys_);
   }
 
   result.colNames = patternApplyNode->colNames();
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -18,25 +20,28 @@ class PatternApplyExecutor : public Executor {
   folly::Future<Status> execute() override;
 
  protected:
+  using ValueSet = folly::F14FastSet<Value, MixedValueHash>;
+  using ListSet = folly::F14FastSet<List, MixedListHash>;
+
   Status checkBiInputDataSets();
 
+  // Whether the valid keys collected from the right input last time still hold, i.e. the right
+  // input is invariant in the loop and it's the same value as the last iteration
+  bool isValidKeysCollected();
+
   void collectValidKeys(const std::vector<Expression*>& keyCols,
                         Iterator* iter,
-                        std::unordered_set<List>& validKeys) const;
+                        ListSet& validKeys) const;
 
-  void collectValidKey(Expression* keyCol,
-                       Iterator* iter,
-                       std::unordered_set<Value>& validKey) const;
+  void collectValidKey(Expression* keyCol, Iterator* iter, ValueSet& validKey) const;
 
   DataSet applyZeroKey(Iterator* appliedIter, const bool allValid);
 
-  DataSet applySingleKey(Expression* appliedCol,
-                         Iterator* appliedIter,
-                         const std::unordered_set<Value>& validKey);
+  DataSet applySingleKey(Expression* appliedCol, Iterator* appliedIter, const ValueSet& validKey);
 
   DataSet applyMultiKey(std::vector<Expression*> appliedKeys,
                         Iterator* appliedIter,
-                        const std::unordered_set<List>& validKeys);
+                        const ListSet& validKeys);
 
   folly::Future<Status> patternApply();
   std::unique_ptr<Iterator> lhsIter_;
@@ -46,6 +51,11 @@ class PatternApplyExecutor : public Executor {
   bool isAntiPred_{false};
   // Check if the apply side dataset movable
   bool mv_{false};
+
+  // The right input the valid keys are collected from, kept only in the loops
+  std::shared_ptr<Value> collectedInput_;
+  ValueSet validKey_;
+  ListSet validKeys_;
 };
 
 }  // namespace graph
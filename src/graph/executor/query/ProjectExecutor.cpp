@@ -4,8 +4,12 @@
 
 #include "graph/executor/query/ProjectExecutor.h"
 
+#include <algorithm>
+
+#include "common/expression/BatchEvaluator.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
 
 namespace nebula {
 namespace graph {
@@ -17,8 +21,10 @@ folly::Future<Status> ProjectExecutor::execute() {
   auto iter = ectx_->getResult(project->inputVar()).iter();
   DCHECK(!!iter);
 
-  if (FLAGS_max_job_size <= 1) {
-    auto ds = handleJob(0, iter->size(), iter.get());
+  // Only the rows needed by a limit are projected
+  auto limit = outputRowLimit();
+  if (FLAGS_max_job_size <= 1 || limit < iter->size()) {
+    auto ds = handleJob(0, std::min(limit, iter->size()), iter.get());
     return finish(ResultBuilder().value(Value(std::move(ds))).build());
   } else {
     DataSet ds;
@@ -59,14 +65,49 @@ folly::Future<Status> ProjectExecutor::execute() {
 DataSet ProjectExecutor::handleJob(size_t begin, size_t end, Iterator *iter) {
   auto *project = asNode<Project>(node());
   auto columns = project->columns()->clone();
+  for (auto *col : columns->columns()) {
+    ExpressionUtils::bindColumns(col->expr(), iter);
+  }
   DataSet ds;
   ds.colNames = project->colNames();
   QueryExpressionContext ctx(qctx()->ectx());
   ds.rows.reserve(end - begin);
-  for (; iter->valid() && begin++ < end; iter->next()) {
+
+  // The computed columns over a sequential iterator are evaluated in batch, while the properties
+  // are still read from the rows directly.
+  const auto &cols = columns->columns();
+  std::vector<Column> batchCols(cols.size());
+  std::vector<uint8_t> batched(cols.size(), 0);
+  if (iter->isSequentialIter()) {
+    auto *seqIter = static_cast<SequentialIter *>(iter);
+    BatchEvaluator evaluator(seqIter->getColIndices(), seqIter->getColIndices().size());
+    bool anyBatched = false;
+    for (size_t i = 0; i < cols.size(); ++i) {
+      auto kind = cols[i]->expr()->kind();
+      if (kind != Expression::Kind::kInputProperty && kind != Expression::Kind::kColumn &&
+          kind != Expression::Kind::kConstant && evaluator.accept(cols[i]->expr())) {
+        batched[i] = 1;
+        anyBatched = true;
+      }
+    }
+    if (anyBatched) {
+      auto batch = seqIter->columnBatch(evaluator.inputColumns(), begin, end);
+      for (size_t i = 0; i < cols.size(); ++i) {
+        if (batched[i]) {
+          batchCols[i] = evaluator.eval(cols[i]->expr(), batch);
+        }
+      }
+    }
+  }
+
+  for (size_t rowIndex = 0; iter->valid() && begin++ < end; iter->next(), ++rowIndex) {
     Row row;
-    for (auto &col : columns->columns()) {
-      Value val = col->expr()->eval(ctx(iter));
+    for (size_t i = 0; i < cols.size(); ++i) {
+      if (batched[i]) {
+        row.values.emplace_back(batchCols[i].value(rowIndex));
+        continue;
+      }
+      Value val = cols[i]->expr()->eval(ctx(iter));
       row.values.emplace_back(std::move(val));
     }
     ds.rows.emplace_back(std::move(row));
@@ -34,15 +34,30 @@ Status RollUpApplyExecutor::checkBiInputDataSets() {
     return Status::Error(ss.str());
   }
   colSize_ = rollUpApply->colNames().size();
+  auto collectColIdx = rhsIter_->getColumnIndex(rollUpApply->collectCol()->prop());
+  collectColIdx_ =
+      collectColIdx.ok() ? std::make_optional(collectColIdx.value()) : std::nullopt;
   return Status::OK();
 }
 
+bool RollUpApplyExecutor::isHashTableBuilt() {
+  if (node()->loopLayers() == 0) {
+    return false;
+  }
+  auto input = ectx_->getResult(asNode<RollUpApply>(node())->rightInputVar()).valuePtr();
+  if (input == builtInput_) {
+    return true;
+  }
+  // Holding the input keeps the rows referred by the hash tables alive
+  builtInput_ = std::move(input);
+  return false;
+}
+
 void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compareCols,
-                                         const InputPropertyExpression* collectCol,
                                          Iterator* iter,
-                                         std::unordered_map<List, List>& hashTable) const {
+                                         JoinHashTable<List>& hashTable) const {
   QueryExpressionContext ctx(ectx_);
-
+  hashTable.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
     List list;
     list.values.reserve(compareCols.size());
@@ -50,43 +65,54 @@ void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compare
       Value val = col->eval(ctx(iter));
       list.values.emplace_back(std::move(val));
     }
-
-    auto& vals = hashTable[list];
-    vals.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
+    hashTable.add(std::move(list), iter->row());
   }
+  hashTable.build();
 }
 
-void RollUpApplyExecutor::buildSingleKeyHashTable(
-    Expression* compareCol,
-    const InputPropertyExpression* collectCol,
-    Iterator* iter,
-    std::unordered_map<Value, List>& hashTable) const {
+void RollUpApplyExecutor::buildSingleKeyHashTable(Expression* compareCol,
+                                                  Iterator* iter,
+                                                  JoinHashTable<Value>& hashTable) const {
   QueryExpressionContext ctx(ectx_);
+  hashTable.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
-    auto& val = compareCol->eval(ctx(iter));
-
-    auto& vals = hashTable[val];
-    vals.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
+    hashTable.add(compareCol->eval(ctx(iter)), iter->row());
   }
+  hashTable.build();
 }
 
-void RollUpApplyExecutor::buildZeroKeyHashTable(const InputPropertyExpression* collectCol,
-                                                Iterator* iter,
-                                                List& hashTable) const {
-  QueryExpressionContext ctx(ectx_);
+void RollUpApplyExecutor::buildZeroKeyHashTable(Iterator* iter, List& hashTable) const {
   hashTable.reserve(iter->size());
   for (; iter->valid(); iter->next()) {
-    hashTable.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
+    hashTable.emplace_back(collectColIdx_ ? (*iter->row())[*collectColIdx_] : Value::kNullValue);
+  }
+}
+
+List RollUpApplyExecutor::collect(const JoinHashTable<Value>::Rows* rows) const {
+  List vals;
+  if (rows == nullptr) {
+    return vals;
+  }
+  vals.values.reserve(rows->size());
+  for (auto* row : *rows) {
+    vals.values.emplace_back(collectColIdx_ ? (*row)[*collectColIdx_] : Value::kNullValue);
   }
+  return vals;
 }
 
-DataSet RollUpApplyExecutor::probeZeroKey(Iterator* probeIter, const List& hashTable) {
+DataSet RollUpApplyExecutor::probeZeroKey(Iterator* probeIter, List& hashTable) {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
-  QueryExpressionContext ctx(ectx_);
-  for (; probeIter->valid(); probeIter->next()) {
+  // The last probe row takes the collected values if they're not kept for the next iteration
+  bool mvLast = node()->loopLayers() == 0;
+  auto rows = probeIter->size();
+  for (size_t i = 0; probeIter->valid(); probeIter->next(), ++i) {
     Row row = mv_ ? probeIter->moveRow() : *probeIter->row();
-    row.emplace_back(std::move(hashTable));
+    if (mvLast && i + 1 == rows) {
+      row.emplace_back(std::move(hashTable));
+    } else {
+      row.emplace_back(hashTable);
+    }
     ds.rows.emplace_back(std::move(row));
   }
   return ds;
@@ -94,17 +120,13 @@ DataSet RollUpApplyExecutor::probeZeroKey(Iterator* probeIter, const List& hashT
 
 DataSet RollUpApplyExecutor::probeSingleKey(Expression* probeKey,
                                             Iterator* probeIter,
-                                            const std::unordered_map<Value, List>& hashTable) {
+                                            const JoinHashTable<Value>& hashTable) {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
   for (; probeIter->valid(); probeIter->next()) {
     auto& val = probeKey->eval(ctx(probeIter));
-    List vals;
-    auto found = hashTable.find(val);
-    if (found != hashTable.end()) {
-      vals = found->second;
-    }
+    List vals = collect(hashTable.find(val));
     Row row = mv_ ? probeIter->moveRow() : *probeIter->row();
     row.emplace_back(std::move(vals));
     ds.rows.emplace_back(std::move(row));
@@ -114,7 +136,7 @@ DataSet RollUpApplyExecutor::probeSingleKey(Expression* probeKey,
 
 DataSet RollUpApplyExecutor::probe(std::vector<Expression*> probeKeys,
                                    Iterator* probeIter,
-                                   const std::unordered_map<List, List>& hashTable) {
+                                   const JoinHashTable<List>& hashTable) {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -126,11 +148,7 @@ DataSet RollUpApplyExecutor::probe(std::vector<Expression*> probeKeys,
       list.values.emplace_back(std::move(val));
     }
 
-    List vals;
-    auto found = hashTable.find(list);
-    if (found != hashTable.end()) {
-      vals = found->second;
-    }
+    List vals = collect(hashTable.find(list));
     Row row = mv_ ? probeIter->moveRow() : *probeIter->row();
     row.emplace_back(std::move(vals));
     ds.rows.emplace_back(std::move(row));
@@ -145,16 +163,20 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
   mv_ = movable(node()->inputVars()[0]);
 
   auto compareCols = rollUpApplyNode->compareCols();
+  bool built = isHashTableBuilt();
 
   if (compareCols.size() == 0) {
-    List hashTable;
-    buildZeroKeyHashTable(rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
-    result = probeZeroKey(lhsIter_.get(), hashTable);
+    if (!built) {
+      zeroKeyHashTable_.clear();
+      buildZeroKeyHashTable(rhsIter_.get(), zeroKeyHashTable_);
+    }
+    result = probeZeroKey(lhsIter_.get(), zeroKeyHashTable_);
   } else if (compareCols.size() == 1) {
-    std::unordered_map<Value, List> hashTable;
-    buildSingleKeyHashTable(
-        compareCols[0]->clone(), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
-    result = probeSingleKey(compareCols[0]->clone(), lhsIter_.get(), hashTable);
+    if (!built) {
+      hashTable_.clear();
+      buildSingleKeyHashTable(compareCols[0]->clone(), rhsIter_.get(), hashTable_);
+    }
+    result = probeSingleKey(compareCols[0]->clone(), lhsIter_.get(), hashTable_);
   } else {
     // Copy the compareCols to make sure the propIndex_ is not cached in the expr
     auto cloneExpr = [](std::vector<Expression*> exprs) {
@@ -166,11 +188,16 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
       return collectColsCopy;
     };
 
-    std::unordered_map<List, List> hashTable;
-    buildHashTable(
-        cloneExpr(compareCols), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
-
-    result = probe(cloneExpr(compareCols), lhsIter_.get(), hashTable);
+    if (!built) {
+      listHashTable_.clear();
+      buildHashTable(cloneExpr(compareCols), rhsIter_.get(), listHashTable_);
+    }
+    result = probe(cloneExpr(compareCols), lhsIter_.get(), listHashTable_);
+  }
+  if (node()->loopLayers() == 0) {
+    zeroKeyHashTable_.clear();
+    hashTable_.clear();
+    listHashTable_.clear();
   }
   result.colNames = rollUpApplyNode->colNames();
   return finish(ResultBuilder().value(Value(std::move(result))).build());
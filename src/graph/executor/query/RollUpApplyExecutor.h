@@ -6,6 +6,7 @@
 #pragma once
 
 #include "graph/executor/Executor.h"
+#include "graph/executor/query/JoinHashTable.h"
 
 namespace nebula {
 namespace graph {
@@ -18,33 +19,36 @@ class RollUpApplyExecutor : public Executor {
   folly::Future<Status> execute() override;
 
  protected:
-  void buildHashTable(const std::vector<Expression*>& compareCols, Iterator* iter);
-
   Status checkBiInputDataSets();
 
+  // Whether the hash table built from the right input last time still holds, i.e. the right input
+  // is invariant in the loop and it's the same value as the last iteration
+  bool isHashTableBuilt();
+
+  // The hash tables refer to the rows of the right input, the collected values are copied out of
+  // them by the probe rows
   void buildHashTable(const std::vector<Expression*>& compareCols,
-                      const InputPropertyExpression* collectCol,
                       Iterator* iter,
-                      std::unordered_map<List, List>& hashTable) const;
+                      JoinHashTable<List>& hashTable) const;
 
   void buildSingleKeyHashTable(Expression* compareCol,
-                               const InputPropertyExpression* collectCol,
                                Iterator* iter,
-                               std::unordered_map<Value, List>& hashTable) const;
+                               JoinHashTable<Value>& hashTable) const;
 
-  void buildZeroKeyHashTable(const InputPropertyExpression* collectCol,
-                             Iterator* iter,
-                             List& hashTable) const;
+  void buildZeroKeyHashTable(Iterator* iter, List& hashTable) const;
 
-  DataSet probeZeroKey(Iterator* probeIter, const List& hashTable);
+  DataSet probeZeroKey(Iterator* probeIter, List& hashTable);
 
   DataSet probeSingleKey(Expression* probeKey,
                          Iterator* probeIter,
-                         const std::unordered_map<Value, List>& hashTable);
+                         const JoinHashTable<Value>& hashTable);
 
   DataSet probe(std::vector<Expression*> probeKeys,
                 Iterator* probeIter,
-                const std::unordered_map<List, List>& hashTable);
+                const JoinHashTable<List>& hashTable);
+
+  // The collected values of the rows found
+  List collect(const JoinHashTable<Value>::Rows* rows) const;
 
   folly::Future<Status> rollUpApply();
 
@@ -53,6 +57,14 @@ class RollUpApplyExecutor : public Executor {
   size_t colSize_{0};
   // Does the probe result movable?
   bool mv_{false};
+  // The index of the collected column in the right rows, none if it's not found
+  std::optional<size_t> collectColIdx_;
+
+  // The right input the hash tables are built from, kept only in the loops
+  std::shared_ptr<Value> builtInput_;
+  List zeroKeyHashTable_;
+  JoinHashTable<Value> hashTable_;
+  JoinHashTable<List> listHashTable_;
 };
 
 }  // namespace graph
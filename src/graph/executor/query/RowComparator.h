@@ -0,0 +1,259 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_QUERY_ROWCOMPARATOR_H_
+#define GRAPH_EXECUTOR_QUERY_ROWCOMPARATOR_H_
+
+#include <cmath>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/datatypes/DataSet.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+namespace graph {
+
+// The comparators of the rows by the sort factors, which are the pairs of the column index and
+// the order type, shared by the sort and topn executors.
+class RowComparator final {
+ public:
+  using Factors = std::vector<std::pair<size_t, OrderFactor::OrderType>>;
+
+  // Call f with the comparator of the factors over the rows in [begin, end). When the column of
+  // each factor is of the same INT, FLOAT, STRING or BOOL type in all the rows, the comparator
+  // compares the unboxed values, specialized for the only factor. Otherwise it compares the
+  // Values of all factors.
+  template <typename RowIter, typename F>
+  static auto dispatch(const Factors& factors, RowIter begin, RowIter end, F&& f) {
+    if (factors.size() == 1) {
+      auto index = factors.front().first;
+      bool ascend = factors.front().second == OrderFactor::OrderType::ASCEND;
+      switch (columnType(index, begin, end)) {
+        case Value::Type::INT:
+          return ascend ? f(IntComparator<true>{index}) : f(IntComparator<false>{index});
+        case Value::Type::FLOAT:
+          return ascend ? f(FloatComparator<true>{index}) : f(FloatComparator<false>{index});
+        case Value::Type::STRING:
+          return ascend ? f(StringComparator<true>{index}) : f(StringComparator<false>{index});
+        default:
+          break;
+      }
+    } else if (!factors.empty()) {
+      TypedComparator comparator;
+      for (const auto& factor : factors) {
+        auto type = columnType(factor.first, begin, end);
+        if (type == Value::Type::__EMPTY__) {
+          return f(ValueComparator{&factors});
+        }
+        comparator.columns.push_back(
+            {factor.first, type, factor.second == OrderFactor::OrderType::ASCEND});
+      }
+      return f(std::move(comparator));
+    }
+    return f(ValueComparator{&factors});
+  }
+
+  // The memcmp comparable keys of the rows in [begin, end) by the factors, in the order of the
+  // rows, if the column of each factor is of the same INT, STRING or BOOL type in all the rows.
+  // Such a key is the ordered encodings of the values of the factors concatenated, so the rows
+  // are sorted by comparing the keys only. The FLOAT columns aren't encoded since the floats
+  // within kEpsilon are equal.
+  template <typename RowIter>
+  static std::optional<std::vector<std::string>> normalizedKeys(const Factors& factors,
+                                                                RowIter begin,
+                                                                RowIter end) {
+    for (const auto& factor : factors) {
+      auto type = columnType(factor.first, begin, end);
+      if (type != Value::Type::INT && type != Value::Type::STRING && type != Value::Type::BOOL) {
+        return std::nullopt;
+      }
+    }
+    std::vector<std::string> keys;
+    keys.reserve(std::distance(begin, end));
+    for (auto it = begin; it != end; ++it) {
+      std::string key;
+      for (const auto& factor : factors) {
+        auto offset = key.size();
+        encodeKey((*it)[factor.first], &key);
+        if (factor.second == OrderFactor::OrderType::DESCEND) {
+          for (auto i = offset; i < key.size(); ++i) {
+            key[i] = static_cast<char>(~key[i]);
+          }
+        }
+      }
+      keys.emplace_back(std::move(key));
+    }
+    return keys;
+  }
+
+  struct ValueComparator {
+    const Factors* factors;
+
+    bool operator()(const Row& lhs, const Row& rhs) const {
+      for (auto& item : *factors) {
+        auto index = item.first;
+        auto orderType = item.second;
+        if (lhs[index] == rhs[index]) {
+          continue;
+        }
+
+        if (orderType == OrderFactor::OrderType::ASCEND) {
+          return lhs[index] < rhs[index];
+        } else if (orderType == OrderFactor::OrderType::DESCEND) {
+          return lhs[index] > rhs[index];
+        }
+      }
+      return false;
+    }
+  };
+
+  // The columns are compared one by one as the unboxed values of their types, the same as the
+  // comparison of the Values
+  struct TypedComparator {
+    struct Column {
+      size_t index;
+      Value::Type type;
+      bool ascend;
+    };
+    std::vector<Column> columns;
+
+    bool operator()(const Row& lhs, const Row& rhs) const {
+      for (const auto& col : columns) {
+        const auto& l = lhs[col.index];
+        const auto& r = rhs[col.index];
+        switch (col.type) {
+          case Value::Type::INT: {
+            if (l.getInt() == r.getInt()) {
+              continue;
+            }
+            return col.ascend ? l.getInt() < r.getInt() : l.getInt() > r.getInt();
+          }
+          case Value::Type::FLOAT: {
+            if (std::abs(l.getFloat() - r.getFloat()) < kEpsilon) {
+              continue;
+            }
+            return col.ascend ? l.getFloat() < r.getFloat() : l.getFloat() > r.getFloat();
+          }
+          case Value::Type::STRING: {
+            auto cmp = l.getStr().compare(r.getStr());
+            if (cmp == 0) {
+              continue;
+            }
+            return col.ascend ? cmp < 0 : cmp > 0;
+          }
+          case Value::Type::BOOL: {
+            if (l.getBool() == r.getBool()) {
+              continue;
+            }
+            return col.ascend ? !l.getBool() : l.getBool();
+          }
+          default: {
+            DLOG(FATAL) << "Unexpected column type " << col.type;
+            return false;
+          }
+        }
+      }
+      return false;
+    }
+  };
+
+  template <bool kAscend>
+  struct IntComparator {
+    size_t index;
+
+    bool operator()(const Row& lhs, const Row& rhs) const {
+      auto l = lhs[index].getInt();
+      auto r = rhs[index].getInt();
+      return kAscend ? l < r : l > r;
+    }
+  };
+
+  // The floats within kEpsilon are equal, the same as the comparison of the Values
+  template <bool kAscend>
+  struct FloatComparator {
+    size_t index;
+
+    bool operator()(const Row& lhs, const Row& rhs) const {
+      auto l = lhs[index].getFloat();
+      auto r = rhs[index].getFloat();
+      if (std::abs(l - r) < kEpsilon) {
+        return false;
+      }
+      return kAscend ? l < r : l > r;
+    }
+  };
+
+  template <bool kAscend>
+  struct StringComparator {
+    size_t index;
+
+    bool operator()(const Row& lhs, const Row& rhs) const {
+      const auto& l = lhs[index].getStr();
+      const auto& r = rhs[index].getStr();
+      return kAscend ? l < r : l > r;
+    }
+  };
+
+ private:
+  // The type of the column if it's INT, FLOAT, STRING or BOOL in all the rows, otherwise
+  // __EMPTY__
+  template <typename RowIter>
+  static Value::Type columnType(size_t index, RowIter begin, RowIter end) {
+    if (begin == end) {
+      return Value::Type::__EMPTY__;
+    }
+    auto type = (*begin)[index].type();
+    if (type != Value::Type::INT && type != Value::Type::FLOAT && type != Value::Type::STRING &&
+        type != Value::Type::BOOL) {
+      return Value::Type::__EMPTY__;
+    }
+    for (auto it = begin; it != end; ++it) {
+      if ((*it)[index].type() != type) {
+        return Value::Type::__EMPTY__;
+      }
+    }
+    return type;
+  }
+
+  // Append the encoding of the INT, STRING or BOOL value, which is ordered by memcmp as the
+  // values. An INT is big endian with the sign bit flipped, and a STRING is terminated by two
+  // zero bytes with its zero bytes escaped as 0x00 0xFF, so a prefix is smaller.
+  static void encodeKey(const Value& val, std::string* key) {
+    switch (val.type()) {
+      case Value::Type::INT: {
+        auto v = static_cast<uint64_t>(val.getInt()) ^ (1ULL << 63);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+          key->push_back(static_cast<char>((v >> shift) & 0xFF));
+        }
+        break;
+      }
+      case Value::Type::STRING: {
+        for (auto c : val.getStr()) {
+          key->push_back(c);
+          if (c == '\0') {
+            key->push_back(static_cast<char>(0xFF));
+          }
+        }
+        key->append(2, '\0');
+        break;
+      }
+      case Value::Type::BOOL: {
+        key->push_back(val.getBool() ? 1 : 0);
+        break;
+      }
+      default: {
+        DLOG(FATAL) << "Unexpected key type " << val.type();
+        break;
+      }
+    }
+  }
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_QUERY_ROWCOMPARATOR_H_
@@ -5,6 +5,7 @@
 #include "graph/executor/query/ScanEdgesExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/SchemaUtil.h"
 
 using nebula::storage::StorageClient;
@@ -28,6 +29,15 @@ folly::Future<Status> ScanEdgesExecutor::scanEdges() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
+  param.sampleRatio = qctx()->sampleRatio();
+  if (se->limit() < 0 && FLAGS_scan_batch_size > 0) {
+    auto scan = [client, param, se](const ScanCursors *cursors) {
+      return client->scanEdge(param, *se->props(), FLAGS_scan_batch_size, se->filter(), cursors);
+    };
+    auto page = scan(nullptr);
+    return scanByPage(std::move(page), std::move(scan), {});
+  }
   return DCHECK_NOTNULL(client)
       ->scanEdge(param, *DCHECK_NOTNULL(se->props()), se->limit(), se->filter())
       .via(runner())
@@ -5,6 +5,7 @@
 #include "graph/executor/query/ScanVerticesExecutor.h"
 
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/SchemaUtil.h"
 
 using nebula::storage::StorageClient;
@@ -29,8 +30,34 @@ folly::Future<Status> ScanVerticesExecutor::scanVertices() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
+  param.sampleRatio = qctx()->sampleRatio();
+  Expression *filter = sv->filter();
+  if (!sv->runtimeFilterVar().empty()) {
+    auto keys = runtimeFilterKeys(sv);
+    if (keys.empty()) {
+      DataSet ds(sv->colNames());
+      return finish(
+          ResultBuilder().value(Value(std::move(ds))).iter(Iterator::Kind::kProp).build());
+    }
+    std::vector<std::string> tags;
+    for (const auto &prop : *DCHECK_NOTNULL(sv->props())) {
+      auto tagName = qctx()->schemaMng()->toTagName(sv->space(), prop.get_tag());
+      NG_RETURN_IF_ERROR(tagName);
+      tags.emplace_back(std::move(tagName).value());
+    }
+    filter = addRuntimeFilter(filter, keys, tags);
+  }
+  if (sv->limit() < 0 && FLAGS_scan_batch_size > 0) {
+    auto scan = [storageClient, param, sv, filter](const ScanCursors *cursors) {
+      return storageClient->scanVertex(
+          param, *sv->props(), FLAGS_scan_batch_size, filter, cursors);
+    };
+    auto page = scan(nullptr);
+    return scanByPage(std::move(page), std::move(scan), sv->colNames());
+  }
   return DCHECK_NOTNULL(storageClient)
-      ->scanVertex(param, *DCHECK_NOTNULL(sv->props()), sv->limit(), sv->filter())
+      ->scanVertex(param, *DCHECK_NOTNULL(sv->props()), sv->limit(), filter)
       .via(runner())
       .ensure([this, scanVertexTime]() {
         SCOPED_TIMER(&execTime_);
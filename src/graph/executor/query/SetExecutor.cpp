@@ -4,7 +4,9 @@
 
 #include "graph/executor/query/SetExecutor.h"
 
+#include "graph/executor/query/PartitionedRowSet.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -71,5 +73,97 @@ Result SetExecutor::getRightInputData() const {
   return ectx_->getResult(right);
 }
 
+bool SetExecutor::multiJobs(const Result& left, const Result& right) const {
+  auto* lIter = left.iterRef();
+  return FLAGS_max_job_size > 1 && (lIter->isSequentialIter() || lIter->isPropIter()) &&
+         !right.iterRef()->empty() &&
+         lIter->size() + right.iterRef()->size() > static_cast<size_t>(FLAGS_min_batch_size);
+}
+
+folly::Future<Status> SetExecutor::probeMultiJobs(Result left, Result right, bool kept) {
+  using HashedRows = std::vector<PartitionedRowSet::HashedRow>;
+  auto* rIter = right.iterRef();
+  size_t numPartitions = FLAGS_max_job_size;
+  auto hashScatter = [](size_t begin, size_t end, Iterator* tmpIter) -> StatusOr<HashedRows> {
+    return PartitionedRowSet::hashRows(tmpIter, begin, end);
+  };
+
+  auto buildGather = [this, numPartitions, kept, left = std::move(left), right = std::move(right)](
+                         std::vector<folly::Try<StatusOr<HashedRows>>>&& results) mutable
+      -> folly::Future<Status> {
+    memory::MemoryCheckGuard guard;
+    auto hashed = std::make_shared<HashedRows>();
+    hashed->reserve(right.iterRef()->size());
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      auto rows = std::move(res).value();
+      hashed->insert(hashed->end(), rows.begin(), rows.end());
+    }
+
+    auto set = std::make_shared<PartitionedRowSet>(numPartitions);
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(numPartitions);
+    for (size_t p = 0; p < numPartitions; ++p) {
+      futures.emplace_back(folly::via(runner(), [set, hashed, p]() {
+        memory::MemoryCheckGuard guard;
+        set->build(p, *hashed, nullptr);
+      }));
+    }
+    return folly::collect(futures).via(runner()).thenValue(
+        [this, kept, set, left = std::move(left), right = std::move(right)](auto&&) mutable {
+          memory::MemoryCheckGuard guard;
+          // The jobs only read the set, which is kept alive by the gather
+          auto probeScatter = [kept, rowSet = set.get()](
+                                  size_t begin, size_t end, Iterator* tmpIter)
+              -> StatusOr<std::vector<uint8_t>> {
+            std::vector<uint8_t> keep;
+            keep.reserve(end - begin);
+            for (auto& row : PartitionedRowSet::hashRows(tmpIter, begin, end)) {
+              keep.emplace_back(rowSet->contains(row) == kept);
+            }
+            return keep;
+          };
+          auto* lIter = left.iterRef();
+          auto probeGather = [this, set, left = std::move(left), right = std::move(right)](
+                                 std::vector<folly::Try<StatusOr<std::vector<uint8_t>>>>&&
+                                     results) mutable -> Status {
+            memory::MemoryCheckGuard guard;
+            std::vector<uint8_t> keep;
+            keep.reserve(left.iterRef()->size());
+            for (auto& respVal : results) {
+              if (respVal.hasException()) {
+                auto ex = respVal.exception().get_exception<std::bad_alloc>();
+                if (ex) {
+                  throw std::bad_alloc();
+                } else {
+                  throw std::runtime_error(respVal.exception().what().c_str());
+                }
+              }
+              auto res = std::move(respVal).value();
+              NG_RETURN_IF_ERROR(res);
+              auto flags = std::move(res).value();
+              keep.insert(keep.end(), flags.begin(), flags.end());
+            }
+            PartitionedRowSet::keepRows(left.iterRef(), keep);
+            ResultBuilder builder;
+            builder.value(left.valuePtr()).iter(std::move(left).iter());
+            return finish(builder.build());
+          };
+          return runMultiJobs(std::move(probeScatter), std::move(probeGather), lIter);
+        });
+  };
+
+  return runMultiJobs(std::move(hashScatter), std::move(buildGather), rIter);
+}
+
 }  // namespace graph
 }  // namespace nebula
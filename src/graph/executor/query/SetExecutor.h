@@ -20,6 +20,14 @@ class SetExecutor : public Executor {
   SetExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
       : Executor(name, node, qctx) {}
 
+  // Whether the left rows are large enough to be probed in multiple jobs
+  bool multiJobs(const Result &left, const Result &right) const;
+
+  // Keep the left rows which are in the right rows if kept is true, or not in them otherwise. The
+  // set of the right rows is built by the partitions in jobs, then the left rows are probed in
+  // jobs by ranges.
+  folly::Future<Status> probeMultiJobs(Result left, Result right, bool kept);
+
   std::vector<std::string> colNames_;
 };
 
@@ -4,7 +4,11 @@
 
 #include "graph/executor/query/SortExecutor.h"
 
+#include <numeric>
+
+#include "graph/executor/query/RowComparator.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -24,28 +28,100 @@ folly::Future<Status> SortExecutor::execute() {
     return Status::Error(ss.str());
   }
 
-  auto &factors = sort->factors();
-  auto comparator = [&factors](const Row &lhs, const Row &rhs) {
-    for (auto &item : factors) {
-      auto index = item.first;
-      auto orderType = item.second;
-      if (lhs[index] == rhs[index]) {
-        continue;
-      }
-
-      if (orderType == OrderFactor::OrderType::ASCEND) {
-        return lhs[index] < rhs[index];
-      } else if (orderType == OrderFactor::OrderType::DESCEND) {
-        return lhs[index] > rhs[index];
-      }
+  auto seqIter = static_cast<SequentialIter *>(iter);
+  // The rows sorted by multiple factors are compared by the memcmp comparable keys if possible
+  if (sort->factors().size() > 1) {
+    auto keys = RowComparator::normalizedKeys(sort->factors(), seqIter->begin(), seqIter->end());
+    if (keys) {
+      return sortByKeys(std::move(*keys), std::move(result));
     }
-    return false;
-  };
+  }
+  return RowComparator::dispatch(
+      sort->factors(), seqIter->begin(), seqIter->end(), [this, &result](auto comparator) {
+        return sortRows(std::move(comparator), std::move(result));
+      });
+}
 
-  auto seqIter = static_cast<SequentialIter *>(iter);
-  std::sort(seqIter->begin(), seqIter->end(), comparator);
+template <typename Comparator>
+folly::Future<Status> SortExecutor::sortRows(Comparator comparator, Result result) {
+  auto seqIter = static_cast<SequentialIter *>(result.iterRef());
+  size_t size = seqIter->size();
+  size_t batchSize = getBatchSize(size);
+  if (FLAGS_max_job_size <= 1 || batchSize >= size) {
+    std::sort(seqIter->begin(), seqIter->end(), comparator);
+    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  }
+
+  // Each job sorts a batch of the rows, then the sorted runs are merged
+  auto rows = seqIter->begin();
+  std::vector<size_t> bounds;
+  std::vector<folly::Future<folly::Unit>> futures;
+  for (size_t begin = 0; begin < size; begin += batchSize) {
+    auto end = std::min(begin + batchSize, size);
+    bounds.emplace_back(begin);
+    futures.emplace_back(folly::via(runner(), [rows, begin, end, comparator]() {
+      memory::MemoryCheckGuard guard;
+      std::sort(rows + begin, rows + end, comparator);
+    }));
+  }
+  bounds.emplace_back(size);
+
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, rows, bounds = std::move(bounds), comparator, result = std::move(result)](
+          auto &&) mutable {
+        return mergeRuns(rows, std::move(bounds), comparator, std::move(result));
+      });
+}
+
+folly::Future<Status> SortExecutor::sortByKeys(std::vector<std::string> keys, Result result) {
+  auto seqIter = static_cast<SequentialIter *>(result.iterRef());
+  auto rows = seqIter->begin();
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+    return keys[lhs] < keys[rhs];
+  });
+  std::vector<Row> sorted;
+  sorted.reserve(order.size());
+  for (auto i : order) {
+    sorted.emplace_back(std::move(rows[i]));
+  }
+  std::move(sorted.begin(), sorted.end(), rows);
   return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
 }
 
+template <typename Comparator>
+folly::Future<Status> SortExecutor::mergeRuns(std::vector<Row>::iterator rows,
+                                              std::vector<size_t> bounds,
+                                              Comparator comparator,
+                                              Result result) {
+  if (bounds.size() <= 2) {
+    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  }
+
+  std::vector<size_t> merged;
+  std::vector<folly::Future<folly::Unit>> futures;
+  size_t i = 0;
+  for (; i + 2 < bounds.size(); i += 2) {
+    merged.emplace_back(bounds[i]);
+    futures.emplace_back(folly::via(
+        runner(), [rows, begin = bounds[i], mid = bounds[i + 1], end = bounds[i + 2], comparator]() {
+          memory::MemoryCheckGuard guard;
+          std::inplace_merge(rows + begin, rows + mid, rows + end, comparator);
+        }));
+  }
+  // The last run is left to the next round if the number of runs is odd
+  if (i + 1 < bounds.size()) {
+    merged.emplace_back(bounds[i]);
+  }
+  merged.emplace_back(bounds.back());
+
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, rows, merged = std::move(merged), comparator, result = std::move(result)](
+          auto &&) mutable {
+        return mergeRuns(rows, std::move(merged), comparator, std::move(result));
+      });
+}
+
 }  // namespace graph
 }  // namespace nebula
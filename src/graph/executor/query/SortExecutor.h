@@ -14,6 +14,21 @@ class SortExecutor final : public Executor {
   SortExecutor(const PlanNode *node, QueryContext *qctx) : Executor("SortExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  template <typename Comparator>
+  folly::Future<Status> sortRows(Comparator comparator, Result result);
+
+  // Sort the rows by their normalized keys, which are in the order of the rows
+  folly::Future<Status> sortByKeys(std::vector<std::string> keys, Result result);
+
+  // Merge the adjacent sorted runs of the rows, whose boundaries are in bounds, in pairs until
+  // only one run is left
+  template <typename Comparator>
+  folly::Future<Status> mergeRuns(std::vector<Row>::iterator rows,
+                                  std::vector<size_t> bounds,
+                                  Comparator comparator,
+                                  Result result);
 };
 
 }  // namespace graph
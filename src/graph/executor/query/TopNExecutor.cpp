@@ -4,7 +4,9 @@
 
 #include "graph/executor/query/TopNExecutor.h"
 
+#include "graph/executor/query/RowComparator.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -23,24 +25,6 @@ folly::Future<Status> TopNExecutor::execute() {
     return Status::Error(ss.str());
   }
 
-  auto &factors = topn->factors();
-  comparator_ = [&factors](const Row &lhs, const Row &rhs) {
-    for (auto &item : factors) {
-      auto index = item.first;
-      auto orderType = item.second;
-      if (lhs[index] == rhs[index]) {
-        continue;
-      }
-
-      if (orderType == OrderFactor::OrderType::ASCEND) {
-        return lhs[index] < rhs[index];
-      } else if (orderType == OrderFactor::OrderType::DESCEND) {
-        return lhs[index] > rhs[index];
-      }
-    }
-    return false;
-  };
-
   offset_ = topn->offset();
   auto count = topn->count();
   auto size = iter->size();
@@ -59,32 +43,80 @@ folly::Future<Status> TopNExecutor::execute() {
     return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
   }
 
-  executeTopN<SequentialIter>(iter);
-  iter->eraseRange(maxCount_, size);
-  return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  auto seqIter = static_cast<SequentialIter *>(iter);
+  return RowComparator::dispatch(
+      topn->factors(), seqIter->begin(), seqIter->end(), [this, &result](auto comparator) {
+        return executeTopN(std::move(comparator), std::move(result));
+      });
 }
 
-template <typename U>
-void TopNExecutor::executeTopN(Iterator *iter) {
-  auto uIter = static_cast<U *>(iter);
-  std::vector<Row> heap(uIter->begin(), uIter->begin() + heapSize_);
-  std::make_heap(heap.begin(), heap.end(), comparator_);
-  auto it = uIter->begin() + heapSize_;
-  while (it != uIter->end()) {
-    if (comparator_(*it, heap[0])) {
-      std::pop_heap(heap.begin(), heap.end(), comparator_);
+template <typename Comparator>
+folly::Future<Status> TopNExecutor::executeTopN(Comparator comparator, Result result) {
+  auto seqIter = static_cast<SequentialIter *>(result.iterRef());
+  size_t size = seqIter->size();
+  size_t batchSize = getBatchSize(size);
+  if (FLAGS_max_job_size <= 1 || batchSize >= size) {
+    auto heap = topHeap(seqIter->begin(), seqIter->end(), comparator);
+    return finishTopN(std::move(heap), std::move(result));
+  }
+
+  // Each job keeps the heap of its own batch, and the final rows are selected from all the heaps
+  auto rows = seqIter->begin();
+  std::vector<folly::Future<std::vector<Row>>> futures;
+  for (size_t begin = 0; begin < size; begin += batchSize) {
+    auto end = std::min(begin + batchSize, size);
+    futures.emplace_back(folly::via(runner(), [this, rows, begin, end, comparator]() {
+      memory::MemoryCheckGuard guard;
+      return topHeap(rows + begin, rows + end, comparator);
+    }));
+  }
+
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, comparator, result = std::move(result)](
+          std::vector<std::vector<Row>> &&heaps) mutable {
+        memory::MemoryCheckGuard guard;
+        std::vector<Row> candidates;
+        candidates.reserve(heaps.size() * heapSize_);
+        for (auto &heap : heaps) {
+          candidates.insert(candidates.end(),
+                            std::make_move_iterator(heap.begin()),
+                            std::make_move_iterator(heap.end()));
+        }
+        auto heap = topHeap(candidates.begin(), candidates.end(), comparator);
+        return finishTopN(std::move(heap), std::move(result));
+      });
+}
+
+template <typename Comparator>
+std::vector<Row> TopNExecutor::topHeap(std::vector<Row>::iterator begin,
+                                       std::vector<Row>::iterator end,
+                                       Comparator comparator) const {
+  auto heapSize = std::min<int64_t>(heapSize_, end - begin);
+  std::vector<Row> heap(begin, begin + heapSize);
+  std::make_heap(heap.begin(), heap.end(), comparator);
+  auto it = begin + heapSize;
+  while (it != end) {
+    if (comparator(*it, heap[0])) {
+      std::pop_heap(heap.begin(), heap.end(), comparator);
       heap.pop_back();
       heap.push_back(*it);
-      std::push_heap(heap.begin(), heap.end(), comparator_);
+      std::push_heap(heap.begin(), heap.end(), comparator);
     }
     ++it;
   }
-  std::sort_heap(heap.begin(), heap.end(), comparator_);
+  std::sort_heap(heap.begin(), heap.end(), comparator);
+  return heap;
+}
 
-  auto beg = uIter->begin();
+folly::Future<Status> TopNExecutor::finishTopN(std::vector<Row> heap, Result result) {
+  auto *iter = static_cast<SequentialIter *>(result.iterRef());
+  auto size = iter->size();
+  auto beg = iter->begin();
   for (int i = 0; i < maxCount_; ++i) {
-    beg[i] = heap[offset_ + i];
+    beg[i] = std::move(heap[offset_ + i]);
   }
+  iter->eraseRange(maxCount_, size);
+  return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
 }
 
 }  // namespace graph
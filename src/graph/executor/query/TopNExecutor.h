@@ -16,13 +16,20 @@ class TopNExecutor final : public Executor {
   folly::Future<Status> execute() override;
 
  private:
-  template <typename U>
-  void executeTopN(Iterator *iter);
+  template <typename Comparator>
+  folly::Future<Status> executeTopN(Comparator comparator, Result result);
+
+  // The first heapSize_ rows of [begin, end) in order, or all of them if there are fewer
+  template <typename Comparator>
+  std::vector<Row> topHeap(std::vector<Row>::iterator begin,
+                           std::vector<Row>::iterator end,
+                           Comparator comparator) const;
+
+  folly::Future<Status> finishTopN(std::vector<Row> heap, Result result);
 
   int64_t offset_;
   int64_t maxCount_;
   int64_t heapSize_;
-  std::function<bool(const Row &, const Row &)> comparator_;
 };
 
 }  // namespace graph
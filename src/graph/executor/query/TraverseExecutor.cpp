@@ -5,6 +5,10 @@
 #include "graph/executor/query/TraverseExecutor.h"
 
 #include "clients/storage/StorageClient.h"
+#include "common/expression/ContainerExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
 #include "common/memory/MemoryTracker.h"
 #include "graph/context/iterator/GetNbrsRespDataSetIter.h"
 #include "graph/service/GraphFlags.h"
@@ -14,6 +18,10 @@
 DEFINE_uint64(traverse_parallel_threshold_rows,
               150000,
               "threshold row number of traverse executor in parallel");
+DEFINE_uint64(traverse_closing_vids_threshold,
+              10000,
+              "The max number of the closing vids of a cycle pushed down to storage as an edge "
+              "filter, 0 means not to push them down");
 
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
@@ -26,6 +34,12 @@ folly::Future<Status> TraverseExecutor::execute() {
   range_ = traverse_->stepRange();
   genPath_ = traverse_->genPath();
   NG_RETURN_IF_ERROR(buildRequestVids());
+  // The sources are sampled here unless the rows they come from are sampled by the scans
+  if (qctx()->sampleRatio() < 1.0 && sampledSources(node()) == 0) {
+    for (auto it = vids_.begin(); it != vids_.end();) {
+      it = qctx()->sampled() ? std::next(it) : vids_.erase(it);
+    }
+  }
   if (vids_.empty()) {
     DataSet emptyDs;
     return finish(ResultBuilder().value(Value(std::move(emptyDs))).build());
@@ -45,7 +59,20 @@ Status TraverseExecutor::buildRequestVids() {
 
   bool mv = movable(traverse_->inputVars().front());
   if (traverse_->trackPrevPath()) {
+    auto* closingVid = range_.min() == 1 && range_.max() == 1 &&
+                               FLAGS_traverse_closing_vids_threshold > 0
+                           ? traverse_->closingVid()
+                           : nullptr;
+    VidHashSet closingVids;
     for (; iter->valid(); iter->next()) {
+      if (closingVid != nullptr) {
+        const auto& closing = closingVid->eval(ctx(iter));
+        if (!closing.isStr() && !closing.isInt()) {
+          closingVid = nullptr;
+        } else if (closingVids.size() <= FLAGS_traverse_closing_vids_threshold) {
+          closingVids.emplace(closing);
+        }
+      }
       const auto& vid = src->eval(ctx(iter));
       auto prevPath = mv ? iter->moveRow() : *iter->row();
       auto vidIter = dst2PathsMap_.find(vid);
@@ -56,6 +83,9 @@ Status TraverseExecutor::buildRequestVids() {
       }
       vids_.emplace(vid);
     }
+    if (closingVid != nullptr && closingVids.size() <= FLAGS_traverse_closing_vids_threshold) {
+      closingFilter_ = buildClosingFilter(closingVids);
+    }
   } else {
     const auto& spaceInfo = qctx()->rctx()->session()->space();
     const auto& metaVidType = *(spaceInfo.spaceDesc.vid_type_ref());
@@ -85,6 +115,7 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.followerRead = FLAGS_enable_follower_read;
   std::vector<Value> vids(vids_.size());
   std::move(vids_.begin(), vids_.end(), vids.begin());
   return storageClient
@@ -102,7 +133,10 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
                      finalStep ? traverse_->orderBy() : std::vector<storage::cpp2::OrderBy>(),
                      finalStep ? traverse_->limit(qctx()) : -1,
                      selectFilter(),
-                     currentStep_ == 1 ? traverse_->tagFilter() : nullptr)
+                     currentStep_ == 1 ? traverse_->tagFilter() : nullptr,
+                     false,
+                     nullptr,
+                     isExpandedDirectly())
       .via(runner())
       .thenValue([this, getNbrTime](StorageRpcResponse<GetNeighborsResponse>&& resp) mutable {
         // MemoryTrackerVerified
@@ -124,6 +158,35 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
       });
 }
 
+Expression* TraverseExecutor::buildClosingFilter(const VidHashSet& closingVids) {
+  // The dst of a step closing a cycle must be the vid of a node before, so the edges to the other
+  // vertices are dropped in storage instead of returned to be dropped by the filter after, e.g.
+  // _any(like._dst, serve._dst) IN ["a", "b"]
+  auto* pool = &objPool_;
+  auto* dsts = ArgumentList::make(pool);
+  std::unordered_set<std::string> edgeNames;
+  for (const auto& edgeProp : *DCHECK_NOTNULL(traverse_->edgeProps())) {
+    auto edgeName =
+        qctx()->schemaMng()->toEdgeName(traverse_->space(), std::abs(edgeProp.get_type()));
+    if (!edgeName.ok()) {
+      return nullptr;
+    }
+    if (edgeNames.emplace(edgeName.value()).second) {
+      dsts->addArgument(EdgeDstIdExpression::make(pool, edgeName.value()));
+    }
+  }
+  if (dsts->numArgs() == 0) {
+    return nullptr;
+  }
+  auto* items = ExpressionList::make(pool, closingVids.size());
+  for (const auto& vid : closingVids) {
+    items->add(ConstantExpression::make(pool, vid));
+  }
+  auto* dst = dsts->numArgs() == 1 ? dsts->args().front()
+                                   : FunctionCallExpression::make(pool, "_any", dsts);
+  return RelationalExpression::makeIn(pool, dst, ListExpression::make(pool, items));
+}
+
 Expression* TraverseExecutor::selectFilter() {
   Expression* filter = nullptr;
   if (!(currentStep_ == 1 && range_.min() == 0)) {
@@ -135,6 +198,11 @@ Expression* TraverseExecutor::selectFilter() {
     } else if (traverse_->firstStepFilter() != nullptr) {
       filter = LogicalExpression::makeAnd(&objPool_, filter, traverse_->firstStepFilter());
     }
+    if (filter == nullptr) {
+      filter = closingFilter_;
+    } else if (closingFilter_ != nullptr) {
+      filter = LogicalExpression::makeAnd(&objPool_, filter, closingFilter_);
+    }
   }
   return filter;
 }
@@ -178,10 +246,11 @@ size_t sizeOf(const std::vector<T>& v) {
 }
 
 void TraverseExecutor::buildAdjList(DataSet& dataset,
+                                    const std::vector<storage::cpp2::NeighborEdges>* edges,
                                     std::vector<Value>& initVertices,
                                     VidHashSet& vids,
                                     VertexMap<Value>& adjList) const {
-  for (GetNbrsRespDataSetIter iter(&dataset); iter.valid(); iter.next()) {
+  for (GetNbrsRespDataSetIter iter(&dataset, edges); iter.valid(); iter.next()) {
     Value v = iter.getVertex();
     initVertices.emplace_back(v);
     VidHashSet dstSet;
@@ -208,17 +277,27 @@ folly::Future<Status> TraverseExecutor::asyncExpandOneStep(RpcResponse&& resps)
   futures.reserve(numResps);
 
   for (size_t i = 0; i < numResps; i++) {
-    auto dataset = resps.responses()[i].get_vertices();
-    if (!dataset) continue;
+    auto dataset = resps.responses()[i].vertices_ref();
+    if (!dataset.has_value()) continue;
+    auto flatEdges = resps.responses()[i].edges_ref();
     auto func = [this,
                  dataset = std::move(*dataset),
+                 hasEdges = flatEdges.has_value(),
+                 edges = flatEdges.has_value() ? std::move(*flatEdges)
+                                               : std::vector<storage::cpp2::NeighborEdges>(),
                  i,
                  initVerticesList,
                  vidsList,
                  adjLists,
                  taskRunTime]() mutable {
       SCOPED_TIMER(&((*taskRunTime)[i]));
-      buildAdjList(dataset, (*initVerticesList)[i], (*vidsList)[i], (*adjLists)[i]);
+      internStrings(dataset);
+      internStrings(edges);
+      buildAdjList(dataset,
+                   hasEdges ? &edges : nullptr,
+                   (*initVerticesList)[i],
+                   (*vidsList)[i],
+                   (*adjLists)[i]);
     };
     futures.emplace_back(folly::via(runner(), std::move(func)));
   }
@@ -266,7 +345,12 @@ folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
   for (auto& resp : resps.responses()) {
     auto dataset = resp.get_vertices();
     if (dataset) {
-      buildAdjList(*dataset, initVertices_, vids_, adjList_);
+      auto edges = resp.edges_ref();
+      internStrings(*dataset);
+      if (edges.has_value()) {
+        internStrings(*edges);
+      }
+      buildAdjList(*dataset, edges.has_value() ? &*edges : nullptr, initVertices_, vids_, adjList_);
     }
   }
 
@@ -276,7 +360,7 @@ folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
 folly::Future<Status> TraverseExecutor::handleResponse(RpcResponse&& resps) {
   NG_RETURN_IF_ERROR(handleCompleteness(resps, FLAGS_accept_partial_success));
 
-  if (currentStep_ == 1 && !traverse_->eFilter() && !traverse_->vFilter()) {
+  if (isExpandedDirectly()) {
     return expandOneStep(std::move(resps)).thenValue([this](Status s) {
       NG_RETURN_IF_ERROR(s);
       if (range_.min() == 0) {
@@ -288,8 +372,9 @@ folly::Future<Status> TraverseExecutor::handleResponse(RpcResponse&& resps) {
 
   List list;
   for (auto& resp : resps.responses()) {
-    auto dataset = resp.get_vertices();
-    if (dataset) {
+    auto dataset = resp.vertices_ref();
+    if (dataset.has_value()) {
+      internStrings(*dataset);
       list.values.emplace_back(std::move(*dataset));
     }
   }
@@ -64,7 +64,13 @@ class TraverseExecutor final : public StorageAccessExecutor {
   size_t numRowsOfRpcResp(const RpcResponse& resps) const;
 
   void expand(GetNeighborsIter* iter);
+  // The edges of the first step are expanded directly if there is no filter on them, which are
+  // returned in columns then
+  bool isExpandedDirectly() const {
+    return currentStep_ == 1 && !traverse_->eFilter() && !traverse_->vFilter();
+  }
   void buildAdjList(DataSet& dataset,
+                    const std::vector<storage::cpp2::NeighborEdges>* edges,
                     std::vector<Value>& initVertices,
                     VidHashSet& vids,
                     VertexMap<Value>& adjList) const;
@@ -90,6 +96,9 @@ class TraverseExecutor final : public StorageAccessExecutor {
 
   Expression* selectFilter();
 
+  // Filter of the edges to the closing vids, nullptr if it's not pushed down
+  Expression* buildClosingFilter(const VidHashSet& closingVids);
+
  private:
   ObjectPool objPool_;
 
@@ -103,6 +112,7 @@ class TraverseExecutor final : public StorageAccessExecutor {
   const Traverse* traverse_{nullptr};
   MatchStepRange range_;
   size_t currentStep_{0};
+  Expression* closingFilter_{nullptr};
 };
 
 }  // namespace graph
@@ -4,7 +4,10 @@
 
 #include "graph/executor/query/UnwindExecutor.h"
 
+#include "common/datatypes/Set.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
 
 namespace nebula {
 namespace graph {
@@ -16,38 +19,85 @@ folly::Future<Status> UnwindExecutor::execute() {
   auto &inputRes = ectx_->getResult(unwind->inputVar());
   auto iter = inputRes.iter();
   bool emptyInput = inputRes.valuePtr()->type() == Value::Type::DATASET ? false : true;
-  QueryExpressionContext ctx(ectx_);
-  auto *unwindExpr = unwind->unwindExpr();
+  keepInputRow_ = !unwind->fromPipe() && !emptyInput;
+  mv_ = keepInputRow_ && movable(unwind->inputVars().front());
+
+  // Only the rows needed by a limit are unwound, which is known only after the rows before
+  auto limit = outputRowLimit();
+  if (FLAGS_max_job_size <= 1 || limit < std::numeric_limits<size_t>::max()) {
+    auto ds = handleJob(0, iter->size(), iter.get(), limit);
+    return finish(ResultBuilder().value(Value(std::move(ds))).build());
+  }
 
   DataSet ds;
   ds.colNames = unwind->colNames();
-  for (; iter->valid(); iter->next()) {
-    const Value &list = unwindExpr->eval(ctx(iter.get()));
-    std::vector<Value> vals = extractList(list);
-    for (auto &v : vals) {
-      Row row;
-      if (!unwind->fromPipe() && !emptyInput) {
-        row = *(iter->row());
+  auto scatter = [this](size_t begin, size_t end, Iterator *tmpIter) -> StatusOr<DataSet> {
+    return handleJob(begin, end, tmpIter, std::numeric_limits<size_t>::max());
+  };
+
+  auto gather = [this, result = std::move(ds)](
+                    std::vector<folly::Try<StatusOr<DataSet>>> &&results) mutable {
+    memory::MemoryCheckGuard guard;
+    for (auto &respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
       }
-      row.values.emplace_back(std::move(v));
-      ds.rows.emplace_back(std::move(row));
+      auto res = std::move(respVal).value();
+      NG_RETURN_IF_ERROR(res);
+      auto &&rows = std::move(res).value();
+      result.rows.insert(result.rows.end(),
+                         std::make_move_iterator(rows.begin()),
+                         std::make_move_iterator(rows.end()));
     }
-  }
-  return finish(ResultBuilder().value(Value(std::move(ds))).build());
+    finish(ResultBuilder().value(Value(std::move(result))).build());
+    return Status::OK();
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), iter.get());
 }
 
-std::vector<Value> UnwindExecutor::extractList(const Value &val) {
-  std::vector<Value> ret;
-  if (val.isList()) {
-    auto &list = val.getList();
-    ret = list.values;
-  } else {
-    if (!(val.isNull() || val.empty())) {
-      ret.push_back(val);
+DataSet UnwindExecutor::handleJob(size_t begin, size_t end, Iterator *iter, size_t limit) {
+  auto *unwind = asNode<Unwind>(node());
+  auto *unwindExpr = unwind->unwindExpr()->clone();
+  ExpressionUtils::bindColumns(unwindExpr, iter);
+  QueryExpressionContext ctx(qctx()->ectx());
+
+  DataSet ds;
+  ds.colNames = unwind->colNames();
+  ds.rows.reserve(std::min(limit, end - begin));
+  for (; iter->valid() && begin++ < end && ds.rows.size() < limit; iter->next()) {
+    const Value &val = unwindExpr->eval(ctx(iter));
+    // The input row is moved into the row of its last element, so the element is copied first
+    auto unwindOne = [&](const Value &elem, bool last) {
+      Value v = elem;
+      Row row;
+      if (keepInputRow_) {
+        row = mv_ && last ? iter->moveRow() : *iter->row();
+      }
+      row.values.emplace_back(std::move(v));
+      ds.rows.emplace_back(std::move(row));
+    };
+    if (val.isList()) {
+      const auto &values = val.getList().values;
+      for (size_t i = 0; i < values.size() && ds.rows.size() < limit; ++i) {
+        unwindOne(values[i], i + 1 == values.size());
+      }
+    } else if (val.isSet()) {
+      const auto &values = val.getSet().values;
+      size_t i = 0;
+      for (auto it = values.begin(); it != values.end() && ds.rows.size() < limit; ++it) {
+        unwindOne(*it, ++i == values.size());
+      }
+    } else if (!(val.isNull() || val.empty())) {
+      unwindOne(val, true);
     }
   }
-
-  return ret;
+  return ds;
 }
 
 }  // namespace graph
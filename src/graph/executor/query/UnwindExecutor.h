@@ -18,7 +18,14 @@ class UnwindExecutor final : public Executor {
   folly::Future<Status> execute() override;
 
  private:
-  std::vector<Value> extractList(const Value &val);
+  // Unwind the lists, or the sets, of the input rows [begin, end) into at most limit rows. The
+  // value neither a list nor a set is unwound as itself unless it's null or empty.
+  DataSet handleJob(size_t begin, size_t end, Iterator *iter, size_t limit);
+
+  // Whether the input rows are kept in the output ones
+  bool keepInputRow_{false};
+  // Whether the input rows are movable
+  bool mv_{false};
 };
 
 }  // namespace graph
@@ -8,6 +8,7 @@
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/AggregateExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -2177,5 +2178,41 @@ TEST_F(AggregateTest, BitXor) {
     TEST_AGG_4("BIT_XOR", "bit_xor", true)
   }
 }
+
+TEST_F(AggregateTest, MultiJobs) {
+  // The result of the two-phase aggregation in multiple jobs is the same as one job
+  auto aggregate = [](int32_t maxJobSize) {
+    auto maxJobSizeBak = FLAGS_max_job_size;
+    auto minBatchSizeBak = FLAGS_min_batch_size;
+    FLAGS_max_job_size = maxJobSize;
+    FLAGS_min_batch_size = 2;
+    std::vector<Expression*> groupKeys = {InputPropertyExpression::make(pool_, "col3")};
+    std::vector<Expression*> groupItems = {InputPropertyExpression::make(pool_, "col3")};
+    std::vector<std::string> colNames = {"col3"};
+    for (auto name : {"COUNT", "SUM", "AVG", "MAX", "MIN", "STD", "BIT_OR", "COLLECT_SET"}) {
+      groupItems.emplace_back(
+          AggregateExpression::make(pool_, name, InputPropertyExpression::make(pool_, "col1")));
+      colNames.emplace_back(name);
+    }
+    auto* agg = Aggregate::make(qctx_.get(), nullptr, std::move(groupKeys), std::move(groupItems));
+    agg->setInputVar(*input_);
+    agg->setColNames(colNames);
+
+    auto aggExe = std::make_unique<AggregateExecutor>(agg, qctx_.get());
+    auto status = aggExe->execute().get();
+    EXPECT_TRUE(status.ok());
+    FLAGS_max_job_size = maxJobSizeBak;
+    FLAGS_min_batch_size = minBatchSizeBak;
+    auto& result = qctx_->ectx()->getResult(agg->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    DataSet sortedDs = result.value().getDataSet();
+    std::sort(sortedDs.rows.begin(), sortedDs.rows.end(), RowCmp());
+    return sortedDs;
+  };
+  auto expected = aggregate(1);
+  EXPECT_EQ(4u, expected.rowSize());
+  EXPECT_EQ(expected, aggregate(3));
+  EXPECT_EQ(expected, aggregate(16));
+}
 }  // namespace graph
 }  // namespace nebula
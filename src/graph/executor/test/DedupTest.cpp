@@ -9,6 +9,7 @@
 #include "graph/executor/query/ProjectExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -75,5 +76,41 @@ TEST_F(DedupTest, WrongTypeIterator) {
   DEDUP_RESULT_CHECK(
       "input_neighbor", "dedup_sequential", "YIELD DISTINCT $-.v_dst as name", expected);
 }
+
+TEST_F(DedupTest, MultiJobs) {
+  // Dedup in multiple jobs keeps the first ones of the equal rows in order
+  DataSet ds({"int", "str"});
+  DataSet expected({"int", "str"});
+  for (int64_t i = 0; i < 100; ++i) {
+    int64_t k = i * 37 % 30;
+    auto row = Row({k, folly::to<std::string>(k % 7)});
+    if (i < 30) {
+      expected.emplace_back(row);
+    }
+    ds.emplace_back(std::move(row));
+  }
+  qctx_->symTable()->newVariable("input_multi_jobs");
+  qctx_->ectx()->setResult("input_multi_jobs", ResultBuilder().value(Value(ds)).build());
+
+  auto maxJobSizeBak = FLAGS_max_job_size;
+  auto minBatchSizeBak = FLAGS_min_batch_size;
+  FLAGS_max_job_size = 4;
+  FLAGS_min_batch_size = 8;
+  auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+  dedupNode->setInputVar("input_multi_jobs");
+  auto dedupExec = Executor::create(dedupNode, qctx_.get());
+  EXPECT_TRUE(dedupExec->execute().get().ok());
+  FLAGS_max_job_size = maxJobSizeBak;
+  FLAGS_min_batch_size = minBatchSizeBak;
+
+  auto& result = qctx_->ectx()->getResult(dedupNode->outputVar());
+  EXPECT_EQ(result.state(), Result::State::kSuccess);
+  DataSet deduped({"int", "str"});
+  for (auto iter = result.iter(); iter->valid(); iter->next()) {
+    deduped.rows.emplace_back(*iter->row());
+  }
+  EXPECT_EQ(deduped, expected);
+}
+
 }  // namespace graph
 }  // namespace nebula
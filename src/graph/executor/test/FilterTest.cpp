@@ -86,5 +86,36 @@ TEST_F(FilterTest, TestEmpty) {
                       "YIELD $^.person.name AS name WHERE study.start_year >= 2010",
                       expected);
 }
+TEST_F(FilterTest, StopAtLimit) {
+  DataSet input({"k"});
+  for (int64_t i = 0; i < 100; ++i) {
+    input.emplace_back(Row({i}));
+  }
+  qctx_->symTable()->newVariable("limit_input");
+  qctx_->ectx()->setResult("limit_input", ResultBuilder().value(Value(std::move(input))).build());
+
+  auto* pool = qctx_->objPool();
+  auto* condition = RelationalExpression::makeEQ(
+      pool,
+      ArithmeticExpression::makeMod(
+          pool, InputPropertyExpression::make(pool, "k"), ConstantExpression::make(pool, 2)),
+      ConstantExpression::make(pool, 0));
+  auto* filter = Filter::make(qctx_.get(), nullptr, condition);
+  filter->setInputVar("limit_input");
+  filter->setColNames({"k"});
+  // Only the first three rows meeting the condition are read by the limit
+  Limit::make(qctx_.get(), filter, 1, 2);
+
+  auto filterExec = std::make_unique<FilterExecutor>(filter, qctx_.get());
+  EXPECT_TRUE(filterExec->execute().get().ok());
+  auto& result = qctx_->ectx()->getResult(filter->outputVar());
+  EXPECT_EQ(result.state(), Result::State::kSuccess);
+
+  DataSet expected({"k"});
+  expected.emplace_back(Row({0}));
+  expected.emplace_back(Row({2}));
+  expected.emplace_back(Row({4}));
+  EXPECT_EQ(result.value().getDataSet(), expected);
+}
 }  // namespace graph
 }  // namespace nebula
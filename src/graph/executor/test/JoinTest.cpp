@@ -7,6 +7,7 @@
 
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/InnerJoinExecutor.h"
+#include "graph/executor/query/JoinHashTable.h"
 #include "graph/executor/query/LeftJoinExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
@@ -397,5 +398,56 @@ TEST_F(JoinTest, HashLeftJoin) {
   EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST(JoinHashTableTest, Partitioned) {
+  // Enough rows to spread over several partitions
+  std::vector<Row> rows;
+  for (int64_t i = 0; i < 5000; ++i) {
+    rows.emplace_back(Row({i % 2000, folly::to<std::string>(i % 1500), i}));
+  }
+  rows.emplace_back(Row({Value::kNullValue, Value::kNullValue, 5000}));
+
+  JoinHashTable<Value> table;
+  JoinHashTable<List> listTable;
+  table.reserve(rows.size());
+  listTable.reserve(rows.size());
+  for (auto& row : rows) {
+    table.add(row[0], &row);
+    listTable.add(List({row[0], row[1]}), &row);
+  }
+  table.build();
+  listTable.build();
+  EXPECT_EQ(table.size(), 2001);
+  EXPECT_EQ(listTable.size(), 5001);
+
+  for (int64_t key = 0; key < 2000; ++key) {
+    auto* found = table.find(Value(key));
+    ASSERT_NE(found, nullptr);
+    // The rows of a key are in the order of adding
+    std::vector<const Row*> expected;
+    for (int64_t i = key; i < 5000; i += 2000) {
+      expected.emplace_back(&rows[i]);
+    }
+    EXPECT_EQ(std::vector<const Row*>(found->begin(), found->end()), expected);
+  }
+  auto* found = table.find(Value::kNullValue);
+  ASSERT_NE(found, nullptr);
+  ASSERT_EQ(found->size(), 1);
+  EXPECT_EQ(found->front(), &rows.back());
+  for (int64_t key = 2000; key < 3000; ++key) {
+    EXPECT_EQ(table.find(Value(key)), nullptr);
+  }
+  EXPECT_EQ(table.find(Value("0")), nullptr);
+
+  auto* listFound = listTable.find(List({4999 % 2000, folly::to<std::string>(4999 % 1500)}));
+  ASSERT_NE(listFound, nullptr);
+  ASSERT_EQ(listFound->size(), 1);
+  EXPECT_EQ(listFound->front(), &rows[4999]);
+  EXPECT_EQ(listTable.find(List({0, "1"})), nullptr);
+
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.find(Value(0)), nullptr);
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -11,6 +11,7 @@
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "parser/Clauses.h"
 
 namespace nebula {
@@ -107,6 +108,41 @@ TEST_F(ProjectTest, Project2Col) {
   EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST_F(ProjectTest, MultiJobsInMorsels) {
+  // The jobs pull the morsels of 3 rows out of the batches of 5 rows, gathered in order
+  auto maxJobSizeBak = FLAGS_max_job_size;
+  auto minBatchSizeBak = FLAGS_min_batch_size;
+  auto morselSizeBak = FLAGS_morsel_size;
+  FLAGS_max_job_size = 2;
+  FLAGS_min_batch_size = 1;
+  FLAGS_morsel_size = 3;
+  std::string input = "input_project";
+  auto yieldColumns = qctx_->objPool()->makeAndAdd<YieldColumns>();
+  yieldColumns->addColumn(new YieldColumn(
+      VariablePropertyExpression::make(qctx_->objPool(), "input_project", "vid"), "vid"));
+  auto* project = Project::make(qctx_.get(), start_, yieldColumns);
+  project->setInputVar(input);
+  project->setColNames(std::vector<std::string>{"vid"});
+
+  auto proExe = Executor::create(project, qctx_.get());
+  auto status = proExe->execute().get();
+  FLAGS_max_job_size = maxJobSizeBak;
+  FLAGS_min_batch_size = minBatchSizeBak;
+  FLAGS_morsel_size = morselSizeBak;
+  EXPECT_TRUE(status.ok());
+  auto& result = qctx_->ectx()->getResult(project->outputVar());
+
+  DataSet expected;
+  expected.colNames = {"vid"};
+  for (auto i = 0; i < 10; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    expected.rows.emplace_back(std::move(row));
+  }
+  EXPECT_EQ(result.value().getDataSet(), expected);
+  EXPECT_EQ(result.state(), Result::State::kSuccess);
+}
+
 TEST_F(ProjectTest, EmptyInput) {
   std::string input = "empty";
   auto yieldColumns = qctx_->objPool()->makeAndAdd<YieldColumns>();
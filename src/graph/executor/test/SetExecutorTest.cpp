@@ -13,6 +13,7 @@
 #include "graph/executor/query/UnionExecutor.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 using folly::stringPrintf;
 
@@ -460,5 +461,58 @@ TEST_F(SetExecutorTest, TestMinus) {
   }
 }
 
+TEST_F(SetExecutorTest, MultiJobs) {
+  // Intersect and minus in multiple jobs keep the left rows in order
+  DataSet lds({"col1", "col2"});
+  DataSet rds({"col1", "col2"});
+  DataSet intersected({"col1", "col2"});
+  DataSet minused({"col1", "col2"});
+  for (int64_t i = 0; i < 100; ++i) {
+    auto row = Row({i % 40, folly::to<std::string>(i % 40)});
+    if (i % 40 % 3 == 0) {
+      intersected.emplace_back(row);
+    } else {
+      minused.emplace_back(row);
+    }
+    lds.emplace_back(std::move(row));
+  }
+  for (int64_t i = 0; i < 60; i += 3) {
+    rds.emplace_back(Row({i, folly::to<std::string>(i)}));
+  }
+
+  auto run = [this, &lds, &rds](bool intersect) {
+    auto left = StartNode::make(qctx_.get());
+    auto right = StartNode::make(qctx_.get());
+    SetOp* setOp = intersect ? static_cast<SetOp*>(Intersect::make(qctx_.get(), left, right))
+                             : static_cast<SetOp*>(Minus::make(qctx_.get(), left, right));
+    setOp->setLeftVar(left->outputVar());
+    setOp->setRightVar(right->outputVar());
+    qctx_->ectx()->setResult(
+        left->outputVar(),
+        ResultBuilder().value(Value(lds)).iter(Iterator::Kind::kSequential).build());
+    qctx_->ectx()->setResult(
+        right->outputVar(),
+        ResultBuilder().value(Value(rds)).iter(Iterator::Kind::kSequential).build());
+
+    auto maxJobSizeBak = FLAGS_max_job_size;
+    auto minBatchSizeBak = FLAGS_min_batch_size;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 8;
+    auto executor = Executor::create(setOp, qctx_.get());
+    EXPECT_TRUE(executor->execute().get().ok());
+    FLAGS_max_job_size = maxJobSizeBak;
+    FLAGS_min_batch_size = minBatchSizeBak;
+
+    auto& result = qctx_->ectx()->getResult(setOp->outputVar());
+    DataSet ds({"col1", "col2"});
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      ds.rows.emplace_back(*iter->row());
+    }
+    return ds;
+  };
+  EXPECT_EQ(run(true), intersected);
+  EXPECT_EQ(run(false), minused);
+}
+
 }  // namespace graph
 }  // namespace nebula
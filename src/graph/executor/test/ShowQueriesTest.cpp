@@ -51,7 +51,8 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
                    "StartTime",
                    "DurationInUSec",
                    "Status",
-                   "Query"});
+                   "Query",
+                   "MemoryInBytes"});
   DataSet expected = dataSet;
   {
     Row row;
@@ -65,6 +66,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     row.emplace_back(100);
     row.emplace_back("RUNNING");
     row.emplace_back("");
+    row.emplace_back(0);
     expected.rows.emplace_back(std::move(row));
   }
   {
@@ -79,6 +81,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     row.emplace_back(200);
     row.emplace_back("RUNNING");
     row.emplace_back("");
+    row.emplace_back(0);
     expected.rows.emplace_back(std::move(row));
   }
 
@@ -7,10 +7,12 @@
 
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/ProjectExecutor.h"
+#include "graph/executor/query/RowComparator.h"
 #include "graph/executor/query/SortExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -130,5 +132,91 @@ TEST_F(SortTest, sortTwoColDesDes_union) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
   SORT_RESULT_CHECK("union_sequential", "union_sort_two_cols_des_des", true, factors, expected);
 }
+
+TEST_F(SortTest, MultiJobs) {
+  // The result of sorting in multiple jobs is the same as one job
+  DataSet ds({"int", "float", "str", "mixed"});
+  for (int64_t i = 0; i < 100; ++i) {
+    int64_t k = i * 37 % 50;
+    auto str = folly::to<std::string>(k);
+    ds.emplace_back(Row({k, k / 2.0, str, k % 3 == 0 ? Value(str) : Value(k)}));
+  }
+  qctx_->symTable()->newVariable("input_multi_jobs");
+  using Factors = std::vector<std::pair<size_t, OrderFactor::OrderType>>;
+  auto sort = [this, &ds](const Factors& factors, int32_t maxJobSize) {
+    auto maxJobSizeBak = FLAGS_max_job_size;
+    auto minBatchSizeBak = FLAGS_min_batch_size;
+    FLAGS_max_job_size = maxJobSize;
+    FLAGS_min_batch_size = 2;
+    // The rows are sorted in place, so the input is reset for every run
+    qctx_->ectx()->setResult("input_multi_jobs", ResultBuilder().value(Value(ds)).build());
+    auto* sortNode = Sort::make(qctx_.get(), nullptr, factors);
+    sortNode->setInputVar("input_multi_jobs");
+    auto sortExec = Executor::create(sortNode, qctx_.get());
+    EXPECT_TRUE(sortExec->execute().get().ok());
+    FLAGS_max_job_size = maxJobSizeBak;
+    FLAGS_min_batch_size = minBatchSizeBak;
+    auto& result = qctx_->ectx()->getResult(sortNode->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    DataSet sorted;
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      sorted.rows.emplace_back(*iter->row());
+    }
+    return sorted;
+  };
+  for (const auto& factors : {Factors{{0, OrderFactor::OrderType::ASCEND}},
+                              Factors{{1, OrderFactor::OrderType::DESCEND}},
+                              Factors{{2, OrderFactor::OrderType::ASCEND}},
+                              Factors{{3, OrderFactor::OrderType::DESCEND}},
+                              Factors{{3, OrderFactor::OrderType::ASCEND},
+                                      {2, OrderFactor::OrderType::DESCEND}}}) {
+    auto expected = sort(factors, 1);
+    EXPECT_EQ(100u, expected.rowSize());
+    EXPECT_EQ(expected, sort(factors, 3));
+    EXPECT_EQ(expected, sort(factors, 16));
+  }
+}
+
+TEST_F(SortTest, TypedColumns) {
+  // The rows sorted by the typed comparators or the normalized keys are the same as by the Values
+  DataSet ds({"int", "float", "str", "bool"});
+  for (int64_t i = 0; i < 100; ++i) {
+    int64_t k = (i * 37 % 50) - 25;
+    auto str = folly::to<std::string>(i % 7);
+    if (i % 5 == 0) {
+      str.push_back('\0');
+    }
+    ds.emplace_back(Row({k, i * 37 % 11 / 2.0, str, i % 3 == 0}));
+  }
+  qctx_->symTable()->newVariable("input_typed");
+  using Factors = RowComparator::Factors;
+  auto asc = OrderFactor::OrderType::ASCEND;
+  auto desc = OrderFactor::OrderType::DESCEND;
+  for (const auto& factors : {Factors{{2, asc}, {0, desc}},
+                              Factors{{3, desc}, {2, asc}, {0, asc}},
+                              Factors{{1, desc}, {3, asc}, {0, asc}},
+                              Factors{{0, asc}, {2, desc}}}) {
+    auto expected = ds;
+    std::sort(
+        expected.rows.begin(), expected.rows.end(), RowComparator::ValueComparator{&factors});
+    qctx_->ectx()->setResult("input_typed", ResultBuilder().value(Value(ds)).build());
+    auto* sortNode = Sort::make(qctx_.get(), nullptr, factors);
+    sortNode->setInputVar("input_typed");
+    auto sortExec = Executor::create(sortNode, qctx_.get());
+    EXPECT_TRUE(sortExec->execute().get().ok());
+    auto& result = qctx_->ectx()->getResult(sortNode->outputVar());
+    DataSet sorted;
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      sorted.rows.emplace_back(*iter->row());
+    }
+    // The rows of the equal factors are in any order
+    ASSERT_EQ(expected.rowSize(), sorted.rowSize());
+    for (size_t i = 0; i < sorted.rowSize(); ++i) {
+      EXPECT_FALSE(RowComparator::ValueComparator{&factors}(sorted.rows[i], expected.rows[i]));
+      EXPECT_FALSE(RowComparator::ValueComparator{&factors}(expected.rows[i], sorted.rows[i]));
+    }
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -11,6 +11,7 @@
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -112,5 +113,52 @@ TEST_F(TopNTest, topnTwoColDesAsc) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::ASCEND));
   TOPN_RESULT_CHECK("input_sequential", "topn_two_cols_des_asc", true, factors, 1, 9, expected);
 }
+
+TEST_F(TopNTest, MultiJobs) {
+  // The result of topn in multiple jobs is the same as one job
+  DataSet ds({"int", "float", "str", "mixed"});
+  for (int64_t i = 0; i < 100; ++i) {
+    int64_t k = i * 37 % 50;
+    auto str = folly::to<std::string>(k);
+    ds.emplace_back(Row({k, k / 2.0, str, k % 3 == 0 ? Value(str) : Value(k)}));
+  }
+  qctx_->symTable()->newVariable("input_multi_jobs");
+  using Factors = std::vector<std::pair<size_t, OrderFactor::OrderType>>;
+  auto topn = [this, &ds](
+                  const Factors& factors, int64_t offset, int64_t count, int32_t maxJobSize) {
+    auto maxJobSizeBak = FLAGS_max_job_size;
+    auto minBatchSizeBak = FLAGS_min_batch_size;
+    FLAGS_max_job_size = maxJobSize;
+    FLAGS_min_batch_size = 2;
+    // The rows are reordered in place, so the input is reset for every run
+    qctx_->ectx()->setResult("input_multi_jobs", ResultBuilder().value(Value(ds)).build());
+    auto* topnNode = TopN::make(qctx_.get(), nullptr, factors, offset, count);
+    topnNode->setInputVar("input_multi_jobs");
+    auto topnExec = Executor::create(topnNode, qctx_.get());
+    EXPECT_TRUE(topnExec->execute().get().ok());
+    FLAGS_max_job_size = maxJobSizeBak;
+    FLAGS_min_batch_size = minBatchSizeBak;
+    auto& result = qctx_->ectx()->getResult(topnNode->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    DataSet top;
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+      top.rows.emplace_back(*iter->row());
+    }
+    return top;
+  };
+  for (const auto& factors : {Factors{{0, OrderFactor::OrderType::ASCEND}},
+                              Factors{{1, OrderFactor::OrderType::DESCEND}},
+                              Factors{{2, OrderFactor::OrderType::ASCEND}},
+                              Factors{{3, OrderFactor::OrderType::DESCEND},
+                                      {0, OrderFactor::OrderType::ASCEND}}}) {
+    for (auto range : {std::make_pair(0, 10), std::make_pair(7, 30), std::make_pair(95, 10)}) {
+      auto expected = topn(factors, range.first, range.second, 1);
+      EXPECT_EQ(static_cast<size_t>(std::min(range.second, 100 - range.first)),
+                expected.rowSize());
+      EXPECT_EQ(expected, topn(factors, range.first, range.second, 3));
+      EXPECT_EQ(expected, topn(factors, range.first, range.second, 16));
+    }
+  }
+}
 }  // namespace graph
 }  // namespace nebula
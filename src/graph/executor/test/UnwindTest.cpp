@@ -5,11 +5,14 @@
 
 #include <gtest/gtest.h>
 
+#include "common/datatypes/Set.h"
+#include "common/expression/PropertyExpression.h"
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/UnwindExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -65,5 +68,61 @@ TEST_F(UnwindTest, UnwindList) {
   TEST_UNWIND(testSuite["case2"]);
 }
 
+TEST_F(UnwindTest, UnwindSet) {
+  auto set = ConstantExpression::make(pool_, Set({1, 2, 3}));
+  auto* unwind = Unwind::make(qctx_.get(), start_, set, "items");
+  unwind->setColNames(std::vector<std::string>{"items"});
+
+  auto unwExe = Executor::create(unwind, qctx_.get());
+  auto status = unwExe->execute().get();
+  EXPECT_TRUE(status.ok());
+  auto& result = qctx_->ectx()->getResult(unwind->outputVar());
+  std::unordered_set<Value> items;
+  for (auto& row : result.value().getDataSet().rows) {
+    ASSERT_EQ(row.size(), 1);
+    items.emplace(row[0]);
+  }
+  EXPECT_EQ(items, std::unordered_set<Value>({1, 2, 3}));
+}
+
+TEST_F(UnwindTest, MultiJobs) {
+  // The rows unwound by the jobs are gathered in the order of the input rows
+  auto maxJobSizeBak = FLAGS_max_job_size;
+  auto minBatchSizeBak = FLAGS_min_batch_size;
+  auto morselSizeBak = FLAGS_morsel_size;
+  FLAGS_max_job_size = 2;
+  FLAGS_min_batch_size = 1;
+  FLAGS_morsel_size = 3;
+  {
+    DataSet ds;
+    ds.colNames = {"id", "list"};
+    for (auto i = 0; i < 10; ++i) {
+      ds.rows.emplace_back(Row({i, List({i, i * 10})}));
+    }
+    qctx_->symTable()->newVariable("input_unwind");
+    qctx_->ectx()->setResult("input_unwind", ResultBuilder().value(Value(std::move(ds))).build());
+  }
+  auto list = VariablePropertyExpression::make(pool_, "input_unwind", "list");
+  auto* unwind = Unwind::make(qctx_.get(), start_, list, "item");
+  unwind->setInputVar("input_unwind");
+  unwind->setColNames(std::vector<std::string>{"id", "list", "item"});
+
+  auto unwExe = Executor::create(unwind, qctx_.get());
+  auto status = unwExe->execute().get();
+  FLAGS_max_job_size = maxJobSizeBak;
+  FLAGS_min_batch_size = minBatchSizeBak;
+  FLAGS_morsel_size = morselSizeBak;
+  EXPECT_TRUE(status.ok());
+  auto& result = qctx_->ectx()->getResult(unwind->outputVar());
+
+  DataSet expected;
+  expected.colNames = {"id", "list", "item"};
+  for (auto i = 0; i < 10; ++i) {
+    expected.rows.emplace_back(Row({i, List({i, i * 10}), i}));
+    expected.rows.emplace_back(Row({i, List({i, i * 10}), i * 10}));
+  }
+  EXPECT_EQ(result.value().getDataSet(), expected);
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -5,6 +5,7 @@
 #include "graph/gc/GC.h"
 
 #include "common/memory/MemoryTracker.h"
+#include "common/stats/StatsManager.h"
 #include "graph/service/GraphFlags.h"
 
 namespace nebula {
@@ -22,18 +23,76 @@ GC::GC() {
     workers_.start(FLAGS_gc_worker_size, "GC");
   }
   workers_.addRepeatTaskForAll(50, &GC::periodicTask, this);
+  stats::StatsManager::registerGauge("gc_pending_bytes", {}, [this] { return pendingBytes(); });
 }
 
 void GC::clear(std::vector<Result>&& garbage) {
   memory::MemoryCheckOffGuard guard;
+  Garbage g;
+  for (const auto& result : garbage) {
+    auto value = result.valuePtr();
+    if (value != nullptr && value->isDataSet()) {
+      g.bytes += estimateBytes(value->getDataSet().rows);
+    }
+  }
+  g.results = std::move(garbage);
+  if (FLAGS_gc_max_pending_bytes > 0 &&
+      pendingBytes() + g.bytes > static_cast<int64_t>(FLAGS_gc_max_pending_bytes)) {
+    // The workers fall behind, so the garbage is released by the caller instead of piling up
+    release(std::move(g));
+    return;
+  }
   // do not bother folly
+  enqueue(std::move(g));
+}
+
+void GC::enqueue(Garbage&& garbage) {
+  pendingBytes_.fetch_add(garbage.bytes, std::memory_order_relaxed);
   queue_.enqueue(std::move(garbage));
 }
 
 void GC::periodicTask() {
-  while (!queue_.empty()) {
-    queue_.try_dequeue();
+  while (auto garbage = queue_.try_dequeue()) {
+    pendingBytes_.fetch_sub(garbage->bytes, std::memory_order_relaxed);
+    release(std::move(garbage).value());
+  }
+}
+
+void GC::release(Garbage&& garbage) {
+  memory::MemoryCheckOffGuard guard;
+  std::vector<std::shared_ptr<Value>> values;
+  values.reserve(garbage.results.size());
+  for (const auto& result : garbage.results) {
+    values.emplace_back(result.valuePtr());
+  }
+  // Drop the iterators, which share the values as well
+  garbage.results.clear();
+  garbage.rows.clear();
+
+  auto batchRows = std::max(FLAGS_gc_batch_rows, static_cast<uint32_t>(1));
+  for (auto& value : values) {
+    if (value.use_count() != 1 || !value->isDataSet()) {
+      continue;
+    }
+    // Moving the rows out is much cheaper than releasing them
+    auto& rows = value->mutableDataSet().rows;
+    while (rows.size() > batchRows) {
+      Garbage batch;
+      batch.rows.assign(std::make_move_iterator(rows.end() - batchRows),
+                        std::make_move_iterator(rows.end()));
+      batch.bytes = estimateBytes(batch.rows);
+      rows.resize(rows.size() - batchRows);
+      enqueue(std::move(batch));
+    }
+  }
+  values.clear();
+}
+
+/*static*/ int64_t GC::estimateBytes(const std::vector<Row>& rows) {
+  if (rows.empty()) {
+    return 0;
   }
+  return static_cast<int64_t>(rows.size() * (sizeof(Row) + rows.front().size() * sizeof(Value)));
 }
 
 }  // namespace graph
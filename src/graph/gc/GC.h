@@ -15,6 +15,11 @@ namespace graph {
 // Clean the unused memory on background threads, this is helpful
 // for big queries since the memory release of interim results may
 // cost too much time.
+//
+// A huge DataSet is split into the batches of gc_batch_rows rows, which
+// are released by the workers in parallel, so no worker is stuck in one
+// of them. The garbage queued is accounted by the estimated bytes, and
+// it's released by the caller when the backlog exceeds gc_max_pending_bytes.
 class GC {
  public:
   static GC& instance();
@@ -25,10 +30,32 @@ class GC {
 
   void clear(std::vector<Result>&& garbage);
 
+  // The estimated bytes of the garbage queued
+  int64_t pendingBytes() const {
+    return pendingBytes_.load(std::memory_order_relaxed);
+  }
+
  private:
+  // The results, or a batch of the rows split from a DataSet
+  struct Garbage {
+    std::vector<Result> results;
+    std::vector<Row> rows;
+    int64_t bytes{0};
+  };
+
   GC();
   void periodicTask();
-  folly::UMPMCQueue<std::vector<Result>, false> queue_;
+
+  void enqueue(Garbage&& garbage);
+
+  // Release the garbage, the huge DataSets only referred by it are split into batches
+  void release(Garbage&& garbage);
+
+  // The bytes of the values in the rows, without the ones they point to
+  static int64_t estimateBytes(const std::vector<Row>& rows);
+
+  folly::UMPMCQueue<Garbage, false> queue_;
+  std::atomic<int64_t> pendingBytes_{0};
   thread::GenericThreadPool workers_;
 };
 }  // namespace graph
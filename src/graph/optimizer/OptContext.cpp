@@ -17,6 +17,7 @@ OptContext::OptContext(graph::QueryContext *qctx)
     : qctx_(DCHECK_NOTNULL(qctx)), objPool_(std::make_unique<ObjectPool>()) {}
 
 void OptContext::addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode) {
+  planNodeKinds_.emplace(optGroupNode->node()->kind());
   auto pair = planNodeToOptGroupNodeMap_.emplace(planNodeId, optGroupNode);
   if (UNLIKELY(!pair.second)) {
     const auto &pn = pair.first->second->node()->toString();
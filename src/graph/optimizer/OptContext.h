@@ -12,6 +12,7 @@
 #include <unordered_set>
 
 #include "common/cpp/helpers.h"
+#include "graph/planner/plan/PlanNode.h"
 
 namespace nebula {
 
@@ -48,6 +49,17 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
     changed_ = changed;
   }
 
+  // Each rule applied in each round of the exploration is a new pass, the groups and the group
+  // nodes explored in the previous passes are unexplored in the current one naturally.
+  uint64_t pass() const {
+    return pass_;
+  }
+
+  // Kinds of all the plan nodes ever put in the memo
+  const std::unordered_set<graph::PlanNode::Kind> &planNodeKinds() const {
+    return planNodeKinds_;
+  }
+
   void addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode);
   const OptGroupNode *findOptGroupNodeByPlanNodeId(int64_t planNodeId) const;
 
@@ -56,11 +68,15 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
   friend Optimizer;
   // A global flag to record whether this iteration caused a change to the plan
   bool changed_{true};
+  uint64_t pass_{1};
+  // The number of the transforms made by the rules
+  size_t transforms_{0};
   graph::QueryContext *qctx_{nullptr};
   // Memo memory management in the Optimizer phase
   std::unique_ptr<ObjectPool> objPool_;
   std::unordered_map<int64_t, const OptGroupNode *> planNodeToOptGroupNodeMap_;
   std::unordered_set<const OptGroup *> visited_;
+  std::unordered_set<graph::PlanNode::Kind> planNodeKinds_;
   std::unordered_map<const OptGroup *, const graph::PlanNode *> group2PlanNodeMap_;
 };
 
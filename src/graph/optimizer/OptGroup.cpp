@@ -27,14 +27,21 @@ OptGroup *OptGroup::create(OptContext *ctx) {
   return ctx->objPool()->makeAndAdd<OptGroup>(ctx);
 }
 
+bool OptGroup::isExplored(const OptRule *rule) const {
+  UNUSED(rule);
+  return exploredPass_ == ctx_->pass();
+}
+
+void OptGroup::setExplored(const OptRule *rule) {
+  UNUSED(rule);
+  exploredPass_ = ctx_->pass();
+}
+
 void OptGroup::setUnexplored(const OptRule *rule) {
   if (!ctx_->visited_.emplace(this).second) {
     return;
   }
-  auto iter = std::find(exploredRules_.begin(), exploredRules_.end(), rule);
-  if (iter != exploredRules_.end()) {
-    exploredRules_.erase(iter);
-  }
+  exploredPass_ = 0;
   for (auto node : groupNodes_) {
     node->setUnexplored(rule);
   }
@@ -169,6 +176,7 @@ Status OptGroup::explore(const OptRule *rule) {
       continue;
     }
     ctx_->setChanged(true);
+    ctx_->transforms_++;
     auto matched = std::move(status).value();
     matched.collectPatternLeaves(leaves);
     auto resStatus = rule->transform(ctx_, matched);
@@ -279,11 +287,18 @@ OptGroupNode *OptGroupNode::create(OptContext *ctx, PlanNode *node, const OptGro
   return optGNode;
 }
 
+bool OptGroupNode::isExplored(const OptRule *rule) const {
+  UNUSED(rule);
+  return exploredPass_ == group_->ctx()->pass();
+}
+
+void OptGroupNode::setExplored(const OptRule *rule) {
+  UNUSED(rule);
+  exploredPass_ = group_->ctx()->pass();
+}
+
 void OptGroupNode::setUnexplored(const OptRule *rule) {
-  auto iter = std::find(exploredRules_.begin(), exploredRules_.end(), rule);
-  if (iter != exploredRules_.end()) {
-    exploredRules_.erase(iter);
-  }
+  exploredPass_ = 0;
   for (auto dep : dependencies_) {
     dep->setUnexplored(rule);
   }
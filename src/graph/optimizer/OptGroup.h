@@ -24,13 +24,10 @@ class OptGroup final {
  public:
   static OptGroup *create(OptContext *ctx);
 
-  bool isExplored(const OptRule *rule) const {
-    return std::find(exploredRules_.cbegin(), exploredRules_.cend(), rule) != exploredRules_.cend();
-  }
+  // Whether it's explored in the current pass of the rule
+  bool isExplored(const OptRule *rule) const;
 
-  void setExplored(const OptRule *rule) {
-    exploredRules_.emplace_back(rule);
-  }
+  void setExplored(const OptRule *rule);
 
   void setUnexplored(const OptRule *rule);
 
@@ -54,6 +51,10 @@ class OptGroup final {
 
   void deleteRefGroupNode(const OptGroupNode *node);
 
+  OptContext *ctx() const {
+    return ctx_;
+  }
+
   void setRootGroup() {
     isRootGroup_ = true;
   }
@@ -73,7 +74,8 @@ class OptGroup final {
 
   OptContext *ctx_{nullptr};
   std::list<OptGroupNode *> groupNodes_;
-  std::vector<const OptRule *> exploredRules_;
+  // The pass of the rule explored in, see OptContext::pass()
+  uint64_t exploredPass_{0};
   // The output variable should be same across the whole group.
   std::string outputVar_;
 
@@ -110,13 +112,10 @@ class OptGroupNode final {
     return bodies_;
   }
 
-  bool isExplored(const OptRule *rule) const {
-    return std::find(exploredRules_.cbegin(), exploredRules_.cend(), rule) != exploredRules_.cend();
-  }
+  // Whether it's explored in the current pass of the rule
+  bool isExplored(const OptRule *rule) const;
 
-  void setExplored(const OptRule *rule) {
-    exploredRules_.emplace_back(rule);
-  }
+  void setExplored(const OptRule *rule);
 
   void setUnexplored(const OptRule *rule);
 
@@ -145,7 +144,7 @@ class OptGroupNode final {
   const OptGroup *group_{nullptr};
   std::vector<OptGroup *> dependencies_;
   std::vector<OptGroup *> bodies_;
-  std::vector<const OptRule *> exploredRules_;
+  uint64_t exploredPass_{0};
 };
 
 }  // namespace opt
@@ -87,6 +87,18 @@ StatusOr<MatchedResult> Pattern::match(const OptGroupNode *groupNode) const {
   return result;
 }
 
+bool Pattern::match(const std::unordered_set<graph::PlanNode::Kind> &kinds) const {
+  if (!node_.match(kinds)) {
+    return false;
+  }
+  for (const auto &dep : dependencies_) {
+    if (!dep.match(kinds)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 StatusOr<MatchedResult> Pattern::match(const OptGroup *group) const {
   for (auto node : group->groupNodes()) {
     auto status = match(node);
@@ -62,6 +62,16 @@ class MatchNode {
     return false;
   }
 
+  // Whether any plan node of the kinds could be matched
+  bool match(const std::unordered_set<graph::PlanNode::Kind> &kinds) const {
+    for (auto kind : node_) {
+      if (kind == graph::PlanNode::Kind::kUnknown || kinds.count(kind)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
  private:
   const std::unordered_set<graph::PlanNode::Kind> node_;
 };
@@ -74,6 +84,10 @@ class Pattern final {
 
   StatusOr<MatchedResult> match(const OptGroupNode *groupNode) const;
 
+  // Whether the pattern could be matched by the plan nodes of the kinds, the rules are skipped
+  // quickly if none of the kinds they expect is in the memo
+  bool match(const std::unordered_set<graph::PlanNode::Kind> &kinds) const;
+
  private:
   explicit Pattern(graph::PlanNode::Kind kind, std::initializer_list<Pattern> patterns = {})
       : node_(kind), dependencies_(patterns) {}
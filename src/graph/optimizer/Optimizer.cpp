@@ -5,10 +5,12 @@
 
 #include "graph/optimizer/Optimizer.h"
 
+#include "common/time/Duration.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/OptContext.h"
 #include "graph/optimizer/OptGroup.h"
 #include "graph/optimizer/OptRule.h"
+#include "graph/optimizer/RuntimeFilterPushdown.h"
 #include "graph/planner/plan/ExecutionPlan.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/PlanNode.h"
@@ -22,7 +24,14 @@ using nebula::graph::Select;
 using nebula::graph::SingleDependencyNode;
 
 DEFINE_bool(enable_optimizer_property_pruner_rule, true, "");
+DEFINE_bool(enable_optimizer_runtime_filter_rule,
+            false,
+            "Whether to filter the vertices scanned by the keys of the build side of the join");
 DEFINE_uint64(max_plan_depth, 512, "The max depth of plan tree");
+DEFINE_uint64(optimizer_time_budget_us,
+              0,
+              "The time budget of exploring the plan in the optimizer, the rules are no longer "
+              "applied beyond it and the best plan found so far is chosen, 0 means no limit");
 
 namespace nebula {
 namespace opt {
@@ -52,7 +61,7 @@ StatusOr<const PlanNode *> Optimizer::findBestPlan(QueryContext *qctx) {
   return newRoot;
 }
 
-// Just for Properties Pruning
+// Properties pruning and runtime filters pushdown
 Status Optimizer::postprocess(PlanNode *root, graph::QueryContext *qctx, GraphSpaceID spaceID) {
   std::unordered_set<const PlanNode *> visitedPlanNode;
   NG_RETURN_IF_ERROR(rewriteArgumentInputVar(root, visitedPlanNode));
@@ -65,6 +74,9 @@ Status Optimizer::postprocess(PlanNode *root, graph::QueryContext *qctx, GraphSp
                 << visitor.status();
     }
   }
+  if (FLAGS_enable_optimizer_runtime_filter_rule) {
+    RuntimeFilterPushdown::pushDown(qctx, root);
+  }
   return Status::OK();
 }
 
@@ -74,6 +86,7 @@ StatusOr<OptGroup *> Optimizer::prepare(OptContext *ctx, PlanNode *root) {
 }
 
 Status Optimizer::doExploration(OptContext *octx, OptGroup *rootGroup) {
+  time::Duration duration;
   // Terminate when the maximum number of iterations(RuleSets) is reached or the execution plan is
   // unchanged
   int8_t appliedTimes = kMaxIterationRound;
@@ -82,13 +95,27 @@ Status Optimizer::doExploration(OptContext *octx, OptGroup *rootGroup) {
     octx->setChanged(false);
     for (auto ruleSet : ruleSets_) {
       for (auto rule : ruleSet->rules()) {
+        // None of the plan nodes expected by the rule is in the memo
+        if (!rule->pattern().match(octx->planNodeKinds())) {
+          continue;
+        }
+        auto transforms = octx->transforms_;
         // Explore until the maximum number of iterations(Rules) is reached
         NG_RETURN_IF_ERROR(rootGroup->exploreUntilMaxRound(rule));
         octx->visited_.clear();
-        NG_RETURN_IF_ERROR(rootGroup->validate(rule));
-        octx->visited_.clear();
-        rootGroup->setUnexplored(rule);
-        octx->visited_.clear();
+        // The memo is validated already if it's unchanged by the rule
+        if (octx->transforms_ != transforms) {
+          NG_RETURN_IF_ERROR(rootGroup->validate(rule));
+          octx->visited_.clear();
+        }
+        // Everything explored is unexplored in the next pass
+        octx->pass_++;
+        if (FLAGS_optimizer_time_budget_us > 0 &&
+            duration.elapsedInUSec() > FLAGS_optimizer_time_budget_us) {
+          VLOG(1) << "Stop exploring the plan beyond the time budget of the optimizer: "
+                  << duration.elapsedInUSec() << "us";
+          return Status::OK();
+        }
       }
     }
   }
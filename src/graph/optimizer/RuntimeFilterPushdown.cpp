@@ -0,0 +1,200 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/RuntimeFilterPushdown.h"
+
+#include "graph/context/QueryContext.h"
+
+using nebula::graph::PlanNode;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// The property of the input of node, i.e. $-.prop or $.prop
+const PropertyExpression *inputProp(const Expression *expr) {
+  if (expr->kind() == Expression::Kind::kInputProperty) {
+    return static_cast<const PropertyExpression *>(expr);
+  }
+  if (expr->kind() == Expression::Kind::kVarProperty) {
+    auto *prop = static_cast<const PropertyExpression *>(expr);
+    return prop->sym().empty() ? prop : nullptr;
+  }
+  return nullptr;
+}
+
+// Whether the result of node is read by its only consumer
+bool readOnce(graph::QueryContext *qctx, const PlanNode *node) {
+  auto *var = qctx->symTable()->getVar(node->outputVar());
+  return var != nullptr && var->readBy.size() == 1U;
+}
+
+}  // namespace
+
+/*static*/ void RuntimeFilterPushdown::pushDown(graph::QueryContext *qctx, PlanNode *root) {
+  std::unordered_set<const PlanNode *> visited;
+  std::vector<PlanNode *> stack{root};
+  while (!stack.empty()) {
+    auto *node = stack.back();
+    stack.pop_back();
+    if (!visited.emplace(node).second) {
+      continue;
+    }
+    if (node->kind() == PlanNode::Kind::kHashInnerJoin ||
+        node->kind() == PlanNode::Kind::kHashLeftJoin) {
+      pushDown(qctx, static_cast<graph::HashJoin *>(node));
+    }
+    // The joins in the bodies of loop and select are left as is, the bodies are scheduled
+    // separately
+    for (auto *dep : node->dependencies()) {
+      stack.emplace_back(const_cast<PlanNode *>(dep));
+    }
+  }
+}
+
+/*static*/ void RuntimeFilterPushdown::pushDown(graph::QueryContext *qctx, graph::HashJoin *join) {
+  const auto &hashKeys = join->hashKeys();
+  const auto &probeKeys = join->probeKeys();
+  for (size_t i = 0; i < probeKeys.size() && i < hashKeys.size(); ++i) {
+    const Expression *key = probeKeys[i];
+    bool isVertex = false;
+    if (key->kind() == Expression::Kind::kFunctionCall) {
+      auto *func = static_cast<const FunctionCallExpression *>(key);
+      const auto &args = func->args()->args();
+      if ((func->name() != "id" && func->name() != "_joinkey") || args.size() != 1U) {
+        continue;
+      }
+      key = args.front();
+      isVertex = true;
+    }
+    if (key->kind() != Expression::Kind::kInputProperty) {
+      continue;
+    }
+    auto &col = static_cast<const PropertyExpression *>(key)->prop();
+    auto *right = const_cast<PlanNode *>(join->right());
+    auto *scan = findScan(qctx, right, col, isVertex);
+    // The build side must not wait for the scan
+    if (scan == nullptr || !scan->runtimeFilterVar().empty() || contains(join->left(), scan)) {
+      continue;
+    }
+    scan->setRuntimeFilter(join->leftInputVar(), hashKeys[i]->clone());
+    return;
+  }
+}
+
+/*static*/ graph::Explore *RuntimeFilterPushdown::findScan(graph::QueryContext *qctx,
+                                                           PlanNode *node,
+                                                           std::string col,
+                                                           bool isVertex) {
+  while (node != nullptr) {
+    // The scan filtered would change the results of the others reading them
+    if (!readOnce(qctx, node)) {
+      return nullptr;
+    }
+    switch (node->kind()) {
+      case PlanNode::Kind::kFilter:
+      case PlanNode::Kind::kDedup: {
+        break;
+      }
+      case PlanNode::Kind::kProject: {
+        auto *project = static_cast<const graph::Project *>(node);
+        const PropertyExpression *prop = nullptr;
+        for (auto *column : project->columns()->columns()) {
+          if (column->alias() == col) {
+            prop = inputProp(column->expr());
+            break;
+          }
+        }
+        if (prop == nullptr) {
+          return nullptr;
+        }
+        col = prop->prop();
+        break;
+      }
+      case PlanNode::Kind::kAppendVertices:
+      case PlanNode::Kind::kTraverse: {
+        bool trackPrevPath = false;
+        const Expression *src = nullptr;
+        std::string nodeAlias;
+        if (node->kind() == PlanNode::Kind::kTraverse) {
+          auto *traverse = static_cast<const graph::Traverse *>(node);
+          if (traverse->edgeAlias() == col) {
+            return nullptr;
+          }
+          trackPrevPath = traverse->trackPrevPath();
+          src = traverse->src();
+          nodeAlias = traverse->nodeAlias();
+        } else {
+          auto *appendVertices = static_cast<const graph::AppendVertices *>(node);
+          trackPrevPath = appendVertices->trackPrevPath();
+          src = appendVertices->src();
+          nodeAlias = appendVertices->nodeAlias();
+        }
+        if (nodeAlias != col) {
+          // The column is passed through from the input
+          if (!trackPrevPath) {
+            return nullptr;
+          }
+          break;
+        }
+        // The vertex is made of its vid in src
+        auto *prop = isVertex && src != nullptr ? inputProp(src) : nullptr;
+        if (prop == nullptr) {
+          return nullptr;
+        }
+        col = prop->prop();
+        isVertex = false;
+        break;
+      }
+      case PlanNode::Kind::kScanVertices:
+      case PlanNode::Kind::kIndexScan:
+      case PlanNode::Kind::kTagIndexFullScan:
+      case PlanNode::Kind::kTagIndexPrefixScan:
+      case PlanNode::Kind::kTagIndexRangeScan: {
+        if (isVertex || col != kVid) {
+          return nullptr;
+        }
+        if (node->kind() != PlanNode::Kind::kScanVertices &&
+            static_cast<const graph::IndexScan *>(node)->isEdge()) {
+          return nullptr;
+        }
+        // The vertices limited would be different if filtered before the limit
+        auto *scan = static_cast<graph::Explore *>(node);
+        auto limit = scan->limit(qctx);
+        if (limit >= 0 && limit != std::numeric_limits<int64_t>::max()) {
+          return nullptr;
+        }
+        return scan;
+      }
+      default:
+        return nullptr;
+    }
+    node = node->numDeps() == 1U ? const_cast<PlanNode *>(node->dep()) : nullptr;
+  }
+  return nullptr;
+}
+
+/*static*/ bool RuntimeFilterPushdown::contains(const PlanNode *root, const PlanNode *node) {
+  std::unordered_set<const PlanNode *> visited;
+  std::vector<const PlanNode *> stack{root};
+  while (!stack.empty()) {
+    auto *current = stack.back();
+    stack.pop_back();
+    if (current == node) {
+      return true;
+    }
+    if (!visited.emplace(current).second) {
+      continue;
+    }
+    for (auto *dep : current->dependencies()) {
+      stack.emplace_back(dep);
+    }
+  }
+  return false;
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,56 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RUNTIMEFILTERPUSHDOWN_H_
+#define GRAPH_OPTIMIZER_RUNTIMEFILTERPUSHDOWN_H_
+
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+namespace nebula {
+namespace graph {
+class QueryContext;
+}  // namespace graph
+
+namespace opt {
+
+/**
+ * RuntimeFilterPushdown makes the semi join reduction of the hash joins. When the probe side of a
+ * join takes its key from the vid of the vertices scanned, e.g.
+ *
+ *   HashInnerJoin(_joinkey($-.v))
+ *     |- ...
+ *     `- Project($-.v AS v) <- AppendVertices(v, src: $-._vid) <- ScanVertices
+ *
+ * the scan waits for the build side of the join, and the vertices scanned are filtered by the
+ * keys of the build side in storage, so the rows dropped by the join are not fetched at all.
+ *
+ * It's applied only if the rows between the scan and the join are dropped row by row, and the
+ * results in between are not read by any other plan node. Whether the filter is made of the keys
+ * or their range, or not made at all, is decided at runtime by the number of the keys.
+ */
+class RuntimeFilterPushdown final {
+ public:
+  RuntimeFilterPushdown() = delete;
+
+  static void pushDown(graph::QueryContext *qctx, graph::PlanNode *root);
+
+ private:
+  static void pushDown(graph::QueryContext *qctx, graph::HashJoin *join);
+
+  // Find the scan whose vid makes the column col of node, nullptr if none. The vid is taken from
+  // the vertex in col if isVertex.
+  static graph::Explore *findScan(graph::QueryContext *qctx,
+                                  graph::PlanNode *node,
+                                  std::string col,
+                                  bool isVertex);
+
+  static bool contains(const graph::PlanNode *root, const graph::PlanNode *node);
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RUNTIMEFILTERPUSHDOWN_H_
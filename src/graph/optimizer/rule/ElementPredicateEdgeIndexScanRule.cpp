@@ -0,0 +1,31 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/ElementPredicateEdgeIndexScanRule.h"
+
+using Kind = nebula::graph::PlanNode::Kind;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> ElementPredicateEdgeIndexScanRule::kInstance =
+    std::unique_ptr<ElementPredicateEdgeIndexScanRule>(new ElementPredicateEdgeIndexScanRule());
+
+ElementPredicateEdgeIndexScanRule::ElementPredicateEdgeIndexScanRule() {
+  RuleSet::DefaultRules().addRule(this);
+}
+
+const Pattern& ElementPredicateEdgeIndexScanRule::pattern() const {
+  static Pattern pattern =
+      Pattern::create(Kind::kFilter, {Pattern::create(Kind::kEdgeIndexFullScan)});
+  return pattern;
+}
+
+std::string ElementPredicateEdgeIndexScanRule::toString() const {
+  return "ElementPredicateEdgeIndexScanRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
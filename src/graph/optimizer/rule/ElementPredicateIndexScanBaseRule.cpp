@@ -0,0 +1,127 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/ElementPredicateIndexScanBaseRule.h"
+
+#include "common/utils/IndexKeyUtils.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/optimizer/OptRule.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/planner/plan/Scan.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/util/OptimizerUtils.h"
+
+using nebula::graph::Filter;
+using nebula::graph::IndexScan;
+using nebula::graph::OptimizerUtils;
+using nebula::storage::cpp2::IndexColumnHint;
+using nebula::storage::cpp2::IndexQueryContext;
+
+using Kind = nebula::graph::PlanNode::Kind;
+using ExprKind = nebula::Expression::Kind;
+using TransformResult = nebula::opt::OptRule::TransformResult;
+
+namespace nebula {
+namespace opt {
+
+bool ElementPredicateIndexScanBaseRule::match(OptContext* ctx, const MatchedResult& matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  auto filter = static_cast<const Filter*>(matched.planNode());
+  auto scan = static_cast<const IndexScan*>(matched.planNode({0, 0}));
+  for (auto& ictx : scan->queryContext()) {
+    if (ictx.column_hints_ref().is_set()) {
+      return false;
+    }
+  }
+  auto condition = filter->condition();
+  if (condition->kind() != ExprKind::kRelIn) {
+    return false;
+  }
+  auto* relExpr = static_cast<const RelationalExpression*>(condition);
+  auto rightKind = relExpr->right()->kind();
+  return (rightKind == ExprKind::kTagProperty || rightKind == ExprKind::kEdgeProperty) &&
+         graph::ExpressionUtils::isEvaluableExpr(relExpr->left(), ctx->qctx());
+}
+
+StatusOr<TransformResult> ElementPredicateIndexScanBaseRule::transform(
+    OptContext* ctx, const MatchedResult& matched) const {
+  auto qctx = ctx->qctx();
+  auto filter = static_cast<const Filter*>(matched.planNode());
+  auto node = matched.planNode({0, 0});
+  auto scan = static_cast<const IndexScan*>(node);
+
+  auto metaClient = qctx->getMetaClient();
+  auto status = node->kind() == graph::PlanNode::Kind::kTagIndexFullScan
+                    ? metaClient->getTagIndexesFromCache(scan->space())
+                    : metaClient->getEdgeIndexesFromCache(scan->space());
+
+  NG_RETURN_IF_ERROR(status);
+  auto indexItems = std::move(status).value();
+
+  OptimizerUtils::eraseInvalidIndexItems(scan->schemaId(), &indexItems, true);
+
+  auto* relExpr = static_cast<const RelationalExpression*>(filter->condition());
+  const std::string& prop = static_cast<const PropertyExpression*>(relExpr->right())->prop();
+
+  std::shared_ptr<nebula::meta::cpp2::IndexItem> elementIndexItem = nullptr;
+  for (auto& indexItem : indexItems) {
+    if (OptimizerUtils::isElementIndex(*indexItem) &&
+        indexItem->get_fields().back().get_name() == prop) {
+      elementIndexItem = indexItem;
+      break;
+    }
+  }
+  if (!elementIndexItem) {
+    return TransformResult::noTransform();
+  }
+
+  // The element is compared with the key of the same type, so convert the numeric value the same
+  // way as the comparison with a list or set does
+  auto value = relExpr->left()->eval(graph::QueryExpressionContext(qctx->ectx())());
+  auto& field = elementIndexItem->get_fields().back();
+  auto elemType = IndexKeyUtils::toValueType(field.get_type().get_type());
+  if (elemType == Value::Type::FLOAT && value.isInt()) {
+    value = value.toFloat();
+  } else if (elemType == Value::Type::INT && value.isFloat()) {
+    double f = value.getFloat();
+    if (std::abs(f - std::round(f)) >= kEpsilon) {
+      return TransformResult::noTransform();
+    }
+    value = static_cast<int64_t>(std::round(f));
+  }
+  if (value.type() != elemType) {
+    return TransformResult::noTransform();
+  }
+
+  IndexColumnHint hint;
+  hint.scan_type_ref() = storage::cpp2::ScanType::PREFIX;
+  hint.column_name_ref() = field.get_name();
+  hint.begin_value_ref() = std::move(value);
+  IndexQueryContext ictx;
+  ictx.index_id_ref() = elementIndexItem->get_index_id();
+  ictx.column_hints_ref() = {std::move(hint)};
+
+  auto scanNode = IndexScan::make(qctx, nullptr);
+  OptimizerUtils::copyIndexScanData(scan, scanNode, qctx);
+  scanNode->setIndexQueryContext({std::move(ictx)});
+  scanNode->setOutputVar(filter->outputVar());
+  scanNode->setColNames(filter->colNames());
+  auto filterGroup = matched.node->group();
+  auto optScanNode = OptGroupNode::create(ctx, scanNode, filterGroup);
+  for (auto group : matched.dependencies[0].node->dependencies()) {
+    optScanNode->dependsOn(group);
+  }
+  TransformResult result;
+  result.newGroupNodes.emplace_back(optScanNode);
+  result.eraseAll = true;
+  return result;
+}
+
+}  // namespace opt
+}  // namespace nebula
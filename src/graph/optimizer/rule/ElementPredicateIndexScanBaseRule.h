@@ -0,0 +1,23 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_ELEMENTPREDICATEINDEXSCANBASERULE_H
+#define GRAPH_OPTIMIZER_RULE_ELEMENTPREDICATEINDEXSCANBASERULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+// Turn `value IN prop` of a list or set property into a prefix scan of the element index
+class ElementPredicateIndexScanBaseRule : public OptRule {
+ public:
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -0,0 +1,31 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/ElementPredicateTagIndexScanRule.h"
+
+using Kind = nebula::graph::PlanNode::Kind;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> ElementPredicateTagIndexScanRule::kInstance =
+    std::unique_ptr<ElementPredicateTagIndexScanRule>(new ElementPredicateTagIndexScanRule());
+
+ElementPredicateTagIndexScanRule::ElementPredicateTagIndexScanRule() {
+  RuleSet::DefaultRules().addRule(this);
+}
+
+const Pattern& ElementPredicateTagIndexScanRule::pattern() const {
+  static Pattern pattern =
+      Pattern::create(Kind::kFilter, {Pattern::create(Kind::kTagIndexFullScan)});
+  return pattern;
+}
+
+std::string ElementPredicateTagIndexScanRule::toString() const {
+  return "ElementPredicateTagIndexScanRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
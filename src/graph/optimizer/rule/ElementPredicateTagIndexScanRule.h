@@ -0,0 +1,28 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_ELEMENTPREDICATETAGINDEXSCANRULE_H
+#define GRAPH_OPTIMIZER_RULE_ELEMENTPREDICATETAGINDEXSCANRULE_H
+
+#include "graph/optimizer/rule/ElementPredicateIndexScanBaseRule.h"
+
+namespace nebula {
+namespace opt {
+
+// Apply the transformation of base class(ElementPredicateIndexScanBaseRule::transform)
+class ElementPredicateTagIndexScanRule final : public ElementPredicateIndexScanBaseRule {
+ public:
+  const Pattern &pattern() const override;
+  std::string toString() const override;
+
+ private:
+  ElementPredicateTagIndexScanRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -0,0 +1,217 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/EliminateCommonSubexprRule.h"
+
+#include "common/function/FunctionManager.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/visitor/RewriteVisitor.h"
+
+DEFINE_bool(enable_optimizer_cse_rule, true, "");
+
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// The expressions read the input by the columns only, so the columns could be evaluated by another
+// Project in between
+bool readByColumns(const Expression *expr) {
+  static const std::unordered_set<Expression::Kind> kIterKinds = {
+      Expression::Kind::kTagProperty,     Expression::Kind::kSrcProperty,
+      Expression::Kind::kDstProperty,     Expression::Kind::kEdgeProperty,
+      Expression::Kind::kEdgeSrc,         Expression::Kind::kEdgeType,
+      Expression::Kind::kEdgeRank,        Expression::Kind::kEdgeDst,
+      Expression::Kind::kVertex,          Expression::Kind::kEdge,
+      Expression::Kind::kColumn,          Expression::Kind::kAggregate,
+      Expression::Kind::kMatchPathPattern};
+  if (graph::ExpressionUtils::hasAny(expr, kIterKinds)) {
+    return false;
+  }
+  auto props = graph::ExpressionUtils::collectAll(expr, {Expression::Kind::kVarProperty});
+  return std::all_of(props.begin(), props.end(), [](const Expression *prop) {
+    return static_cast<const PropertyExpression *>(prop)->sym().empty();
+  });
+}
+
+// Whether expr is the same whenever it's evaluated on the same row
+bool pure(const Expression *expr) {
+  if (graph::ExpressionUtils::hasAny(expr,
+                                     {Expression::Kind::kVar, Expression::Kind::kVersionedVar})) {
+    return false;
+  }
+  if (!graph::ExpressionUtils::hasAny(
+          expr, {Expression::Kind::kInputProperty, Expression::Kind::kVarProperty})) {
+    // The constant is folded already
+    return false;
+  }
+  auto funcs = graph::ExpressionUtils::collectAll(expr, {Expression::Kind::kFunctionCall});
+  return std::all_of(funcs.begin(), funcs.end(), [](const Expression *e) {
+    auto *func = static_cast<const FunctionCallExpression *>(e);
+    auto isPure = FunctionManager::getIsPure(func->name(), func->args()->numArgs());
+    return isPure.ok() && isPure.value();
+  });
+}
+
+}  // namespace
+
+std::unique_ptr<OptRule> EliminateCommonSubexprRule::kInstance =
+    std::unique_ptr<EliminateCommonSubexprRule>(new EliminateCommonSubexprRule());
+
+EliminateCommonSubexprRule::EliminateCommonSubexprRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &EliminateCommonSubexprRule::pattern() const {
+  static Pattern pattern = Pattern::create({PlanNode::Kind::kProject, PlanNode::Kind::kFilter});
+  return pattern;
+}
+
+bool EliminateCommonSubexprRule::match(OptContext *octx, const MatchedResult &matched) const {
+  if (!FLAGS_enable_optimizer_cse_rule) {
+    return false;
+  }
+  return OptRule::match(octx, matched);
+}
+
+StatusOr<OptRule::TransformResult> EliminateCommonSubexprRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *groupNode = matched.node;
+  auto *node = groupNode->node();
+  auto *qctx = octx->qctx();
+  auto *pool = qctx->objPool();
+  bool isFilter = node->kind() == PlanNode::Kind::kFilter;
+
+  // The new node evaluating the common subexpressions by the columns of the node below
+  graph::PlanNode *newNode = node->clone();
+  std::vector<YieldColumn *> columns;
+  std::vector<Expression *> exprs;
+  if (isFilter) {
+    auto *filter = static_cast<graph::Filter *>(newNode);
+    filter->setCondition(filter->condition()->clone());
+    exprs.emplace_back(filter->condition());
+  } else {
+    columns = static_cast<graph::Project *>(newNode)->columns()->columns();
+    for (auto *column : columns) {
+      exprs.emplace_back(column->expr());
+    }
+  }
+  if (!std::all_of(exprs.begin(), exprs.end(), readByColumns)) {
+    return TransformResult::noTransform();
+  }
+
+  static const std::unordered_set<Expression::Kind> kCandidateKinds = {
+      Expression::Kind::kFunctionCall,
+      Expression::Kind::kAttribute,
+      Expression::Kind::kSubscript,
+      Expression::Kind::kLabelTagProperty};
+  std::unordered_map<std::string, size_t> counts;
+  for (auto *expr : exprs) {
+    for (auto *e : graph::ExpressionUtils::collectAll(expr, kCandidateKinds)) {
+      counts[e->toString()]++;
+    }
+  }
+  // The common subexpressions and the columns evaluating them
+  std::unordered_map<std::string, std::string> commonCols;
+  std::vector<std::pair<const Expression *, std::string>> commonExprs;
+  for (auto *expr : exprs) {
+    for (auto *e : graph::ExpressionUtils::collectAll(expr, kCandidateKinds)) {
+      auto str = e->toString();
+      if (counts[str] < 2U || commonCols.count(str) || !pure(e)) {
+        continue;
+      }
+      auto col = qctx->vctx()->anonColGen()->getCol();
+      commonCols.emplace(str, col);
+      commonExprs.emplace_back(e->clone(), col);
+    }
+  }
+  if (commonExprs.empty()) {
+    return TransformResult::noTransform();
+  }
+
+  // The outer ones are replaced first, the inner ones left unused are not evaluated
+  auto matcher = [&commonCols](const Expression *e) -> bool {
+    return commonCols.count(e->toString()) != 0;
+  };
+  auto rewriter = [&commonCols, pool](const Expression *e) -> Expression * {
+    return InputPropertyExpression::make(pool, commonCols[e->toString()]);
+  };
+  std::unordered_set<std::string> used;
+  for (size_t i = 0; i < exprs.size(); ++i) {
+    auto *newExpr = graph::RewriteVisitor::transform(exprs[i], matcher, rewriter);
+    if (newExpr == nullptr) {
+      return TransformResult::noTransform();
+    }
+    exprs[i] = newExpr;
+    for (auto *prop : graph::ExpressionUtils::collectAll(
+             newExpr, {Expression::Kind::kInputProperty, Expression::Kind::kVarProperty})) {
+      used.emplace(static_cast<const PropertyExpression *>(prop)->prop());
+    }
+  }
+  if (isFilter) {
+    static_cast<graph::Filter *>(newNode)->setCondition(exprs.front());
+  } else {
+    for (size_t i = 0; i < columns.size(); ++i) {
+      columns[i]->setExpr(exprs[i]);
+    }
+  }
+
+  // All the columns are kept for the Filter, only the ones used for the Project
+  auto *cols = pool->makeAndAdd<YieldColumns>();
+  const auto &inputCols = qctx->symTable()->getVar(node->inputVar())->colNames;
+  for (const auto &col : inputCols) {
+    if (isFilter || used.count(col)) {
+      cols->addColumn(new YieldColumn(InputPropertyExpression::make(pool, col), col));
+    }
+  }
+  for (auto &common : commonExprs) {
+    if (used.count(common.second)) {
+      cols->addColumn(new YieldColumn(const_cast<Expression *>(common.first), common.second));
+    }
+  }
+  auto *below = graph::Project::make(qctx, nullptr, cols);
+  below->setInputVar(node->inputVar());
+  auto *belowGroup = OptGroup::create(octx);
+  auto *belowGroupNode = belowGroup->makeGroupNode(below);
+  belowGroupNode->setDeps(groupNode->dependencies());
+
+  newNode->setInputVar(below->outputVar());
+  OptGroup *newGroup = belowGroup;
+  if (isFilter) {
+    newNode->setColNames(below->colNames());
+    auto *filterGroup = OptGroup::create(octx);
+    filterGroup->makeGroupNode(newNode)->dependsOn(belowGroup);
+    newGroup = filterGroup;
+    // Drop the common subexpressions evaluated
+    auto *restoreCols = pool->makeAndAdd<YieldColumns>();
+    for (const auto &col : inputCols) {
+      restoreCols->addColumn(new YieldColumn(InputPropertyExpression::make(pool, col), col));
+    }
+    newNode = graph::Project::make(qctx, nullptr, restoreCols);
+    newNode->setInputVar(filterGroup->outputVar());
+  }
+  newNode->setOutputVar(node->outputVar());
+  auto *resultGroupNode = OptGroupNode::create(octx, newNode, groupNode->group());
+  resultGroupNode->dependsOn(newGroup);
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(resultGroupNode);
+  return result;
+}
+
+std::string EliminateCommonSubexprRule::toString() const {
+  return "EliminateCommonSubexprRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
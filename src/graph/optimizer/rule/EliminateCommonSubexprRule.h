@@ -0,0 +1,65 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_ELIMINATECOMMONSUBEXPRRULE_H_
+#define GRAPH_OPTIMIZER_RULE_ELIMINATECOMMONSUBEXPRRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+DECLARE_bool(enable_optimizer_cse_rule);
+
+namespace nebula {
+namespace opt {
+
+//  Evaluate the pure subexpressions repeated in the Project or the Filter only once
+//  Required conditions:
+//   1. Match the pattern
+//   2. A pure function call, attribute, subscript or property of the label is repeated, and the
+//      expressions read the input only by its columns
+//  Benefits:
+//   1. The subexpression, e.g. the decoding and copying of the collection property, is evaluated
+//      once for each row
+//
+//  Transformation:
+//  Before:
+//
+//  +---------+--------------------------------------------------+
+//  | Filter(size($-.v.t.items) > 3 AND size($-.v.t.items) < 10) |
+//  +---------+--------------------------------------------------+
+//
+//  After:
+//
+//  +---------+----------+
+//  | Project($-.v AS v) |
+//  +---------+----------+
+//            |
+//  +---------+----------------------------------+
+//  | Filter($-.__COL_0 > 3 AND $-.__COL_0 < 10) |
+//  +---------+----------------------------------+
+//            |
+//  +---------+-----------------------------------------+
+//  | Project($-.v AS v, size($-.v.t.items) AS __COL_0) |
+//  +---------+-----------------------------------------+
+
+class EliminateCommonSubexprRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  EliminateCommonSubexprRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_ELIMINATECOMMONSUBEXPRRULE_H_
@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/EmbedFilterIntoCrossJoinRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+
+using nebula::graph::CrossJoin;
+using nebula::graph::ExpressionUtils;
+using nebula::graph::Filter;
+using nebula::graph::PlanNode;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> EmbedFilterIntoCrossJoinRule::kInstance =
+    std::unique_ptr<EmbedFilterIntoCrossJoinRule>(new EmbedFilterIntoCrossJoinRule());
+
+EmbedFilterIntoCrossJoinRule::EmbedFilterIntoCrossJoinRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern& EmbedFilterIntoCrossJoinRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      PlanNode::Kind::kFilter,
+      {Pattern::create(
+          PlanNode::Kind::kCrossJoin,
+          {Pattern::create(PlanNode::Kind::kUnknown), Pattern::create(PlanNode::Kind::kUnknown)})});
+  return pattern;
+}
+
+bool EmbedFilterIntoCrossJoinRule::match(OptContext* octx, const MatchedResult& matched) const {
+  if (!OptRule::match(octx, matched)) {
+    return false;
+  }
+  const auto* condition = static_cast<const Filter*>(matched.planNode())->condition();
+  for (const auto* child : {matched.planNode({0, 0, 0}), matched.planNode({0, 0, 1})}) {
+    const auto& colNames = child->colNames();
+    auto picker = [&colNames](const Expression* e) -> bool {
+      return ExpressionUtils::checkColName(colNames, e);
+    };
+    Expression *picked = nullptr, *unpicked = nullptr;
+    ExpressionUtils::splitFilter(condition, picker, &picked, &unpicked);
+    if (picked != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+StatusOr<OptRule::TransformResult> EmbedFilterIntoCrossJoinRule::transform(
+    OptContext* octx, const MatchedResult& matched) const {
+  auto* filterGroupNode = matched.node;
+  const auto* filter = static_cast<const Filter*>(filterGroupNode->node());
+  const auto& crossJoinMatched = matched.dependencies.front();
+  const auto* crossJoin = static_cast<const CrossJoin*>(crossJoinMatched.node->node());
+
+  auto* newCrossJoin = static_cast<CrossJoin*>(crossJoin->clone());
+  auto* condition = filter->condition()->clone();
+  if (crossJoin->filter() != nullptr) {
+    condition =
+        LogicalExpression::makeAnd(octx->qctx()->objPool(), crossJoin->filter()->clone(), condition);
+  }
+  newCrossJoin->setFilter(condition);
+  newCrossJoin->setOutputVar(filter->outputVar());
+  newCrossJoin->setColNames(crossJoin->colNames());
+  auto* newGroupNode = OptGroupNode::create(octx, newCrossJoin, filterGroupNode->group());
+  newGroupNode->setDeps(crossJoinMatched.node->dependencies());
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newGroupNode);
+  return result;
+}
+
+std::string EmbedFilterIntoCrossJoinRule::toString() const {
+  return "EmbedFilterIntoCrossJoinRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,59 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_EMBEDFILTERINTOCROSSJOINRULE_H_
+#define GRAPH_OPTIMIZER_RULE_EMBEDFILTERINTOCROSSJOINRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embed the condition of [[Filter]] into [[CrossJoin]]
+//  Required conditions:
+//   1. Match the pattern
+//   2. No part of the condition is of a single branch, which is pushed down by
+//      PushFilterDownCrossJoinRule instead
+//  Benefits:
+//   1. The rows of the product are filtered when they are generated, so the ones filtered out are
+//      never materialized, and the limit above stops the product at the rows kept
+//
+//  Transformation:
+//  Before:
+//
+//  +-------+--------+
+//  | Filter(A == B) |
+//  +-------+--------+
+//          |
+//  +-------+--------+
+//  |    CrossJoin   |
+//  +-------+--------+
+//
+//  After:
+//
+//  +-------+---------+
+//  | CrossJoin(A==B) |
+//  +-------+---------+
+
+class EmbedFilterIntoCrossJoinRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  EmbedFilterIntoCrossJoinRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_EMBEDFILTERINTOCROSSJOINRULE_H_
@@ -0,0 +1,154 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/optimizer/rule/ExpandTransformRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+
+using nebula::graph::AppendVertices;
+using nebula::graph::Expand;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::Traverse;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> ExpandTransformRule::kInstance =
+    std::unique_ptr<ExpandTransformRule>(new ExpandTransformRule());
+
+ExpandTransformRule::ExpandTransformRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &ExpandTransformRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      PlanNode::Kind::kDedup,
+      {Pattern::create(
+          PlanNode::Kind::kProject,
+          {Pattern::create(PlanNode::Kind::kAppendVertices,
+                           {Pattern::create(PlanNode::Kind::kTraverse)})})});
+  return pattern;
+}
+
+bool ExpandTransformRule::match(OptContext *ctx, const MatchedResult &matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  auto *project = static_cast<const Project *>(matched.planNode({0, 0}));
+  auto *appendVertices = static_cast<const AppendVertices *>(matched.planNode({0, 0, 0}));
+  auto *traverse = static_cast<const Traverse *>(matched.planNode({0, 0, 0, 0}));
+  // The edges are checked not to be duplicate with the path before the traverse, and the steps
+  // more than one make a trail, while GetDstBySrc is neither. So only the first step of a pattern
+  // whose input is just the start vertex is transformed
+  auto prevCols = traverse->colNames().size() - (traverse->genPath() ? 3 : 2);
+  if ((traverse->trackPrevPath() && prevCols > 1) || !traverse->isOneStep()) {
+    return false;
+  }
+  if (traverse->vFilter() != nullptr || traverse->eFilter() != nullptr ||
+      traverse->firstStepFilter() != nullptr || traverse->tagFilter() != nullptr ||
+      traverse->filter() != nullptr) {
+    return false;
+  }
+  auto *limit = traverse->limitExpr();
+  if (limit != nullptr && (!graph::ExpressionUtils::isEvaluableExpr(limit, ctx->qctx()) ||
+                           traverse->limit(ctx->qctx()) >= 0)) {
+    return false;
+  }
+  if (traverse->random() || traverse->edgeProps() == nullptr || traverse->edgeProps()->empty()) {
+    return false;
+  }
+  if (appendVertices->vFilter() != nullptr || appendVertices->filter() != nullptr) {
+    return false;
+  }
+  // Only the vertex appended is referred, so the src and edge of each row are never used
+  const auto &nodeAlias = appendVertices->nodeAlias();
+  for (auto *column : project->columns()->columns()) {
+    auto exprs = graph::ExpressionUtils::collectAll(column->expr(),
+                                                    {Expression::Kind::kVarProperty,
+                                                     Expression::Kind::kInputProperty,
+                                                     Expression::Kind::kVar,
+                                                     Expression::Kind::kPathBuild});
+    for (auto *expr : exprs) {
+      if (expr->kind() == Expression::Kind::kVar || expr->kind() == Expression::Kind::kPathBuild) {
+        return false;
+      }
+      if (static_cast<const PropertyExpression *>(expr)->prop() != nodeAlias) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+StatusOr<OptRule::TransformResult> ExpandTransformRule::transform(
+    OptContext *ctx, const MatchedResult &matched) const {
+  auto *qctx = ctx->qctx();
+  auto *pool = qctx->objPool();
+  auto *dedupGroupNode = matched.node;
+  auto *dedup = dedupGroupNode->node();
+  auto *project = static_cast<const Project *>(matched.planNode({0, 0}));
+  auto *appendVertices = static_cast<const AppendVertices *>(matched.planNode({0, 0, 0}));
+  auto *traverseGroupNode = matched.dependencies[0].dependencies[0].dependencies[0].node;
+  auto *traverse = static_cast<const Traverse *>(traverseGroupNode->node());
+
+  // Project(src AS _vid), Expand reads vids from the first column of its input
+  auto *vidColumns = pool->makeAndAdd<YieldColumns>();
+  vidColumns->addColumn(new YieldColumn(traverse->src()->clone(), nebula::kVid));
+  auto *vidProject = Project::make(qctx, nullptr, vidColumns);
+  vidProject->setInputVar(traverse->inputVar());
+  vidProject->setColNames({nebula::kVid});
+  auto *vidProjectGroup = OptGroup::create(ctx);
+  auto *vidProjectGroupNode = vidProjectGroup->makeGroupNode(vidProject);
+  vidProjectGroupNode->setDeps(traverseGroupNode->dependencies());
+
+  std::vector<EdgeType> edgeTypes;
+  for (const auto &edgeProp : *traverse->edgeProps()) {
+    edgeTypes.emplace_back(edgeProp.get_type());
+  }
+  auto *expand = Expand::make(qctx, nullptr, traverse->space(), false, 1);
+  expand->setEdgeTypes(std::move(edgeTypes));
+  expand->setInputVar(vidProject->outputVar());
+  expand->setColNames({"_expand_vid"});
+  auto *expandGroup = OptGroup::create(ctx);
+  auto *expandGroupNode = expandGroup->makeGroupNode(expand);
+  expandGroupNode->dependsOn(vidProjectGroup);
+
+  auto *newAppendVertices = appendVertices->clone();
+  newAppendVertices->setSrc(InputPropertyExpression::make(pool, "_expand_vid"));
+  newAppendVertices->setTrackPrevPath(false);
+  newAppendVertices->setColNames({appendVertices->nodeAlias()});
+  newAppendVertices->setInputVar(expand->outputVar());
+  auto *newAppendVerticesGroup = OptGroup::create(ctx);
+  auto *newAppendVerticesGroupNode = newAppendVerticesGroup->makeGroupNode(newAppendVertices);
+  newAppendVerticesGroupNode->dependsOn(expandGroup);
+
+  auto *newProject = project->clone();
+  newProject->setInputVar(newAppendVertices->outputVar());
+  auto *newProjectGroup = OptGroup::create(ctx);
+  auto *newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+  newProjectGroupNode->dependsOn(newAppendVerticesGroup);
+
+  auto *newDedup = dedup->clone();
+  newDedup->setOutputVar(dedup->outputVar());
+  newDedup->setInputVar(newProject->outputVar());
+  auto *newDedupGroupNode = OptGroupNode::create(ctx, newDedup, dedupGroupNode->group());
+  newDedupGroupNode->dependsOn(newProjectGroup);
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newDedupGroupNode);
+  return result;
+}
+
+std::string ExpandTransformRule::toString() const {
+  return "ExpandTransformRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#pragma once
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+// Expand the dsts by GetDstBySrc if only the distinct dst vertices of one step are used, to avoid
+// returning and decoding the edges by GetNeighbors
+//
+// Required conditions:
+//  1. The Traverse is the one step from the start of the pattern, without any filter or limit
+//  2. The AppendVertices has no filter
+//  3. The Project only refers to the vertex of AppendVertices, and it's deduplicated
+//
+// Benefits:
+//  1. The dsts are deduplicated in storage and returned in one column
+//
+// Transformation:
+// Before:
+//
+// +---------+---------+
+// |       Dedup       |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |      Project      |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |   AppendVertices  |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |      Traverse     |
+// +---------+---------+
+//
+// After:
+//
+// +---------+---------+
+// |       Dedup       |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |      Project      |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |   AppendVertices  |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |       Expand      |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |   Project(src)    |
+// +---------+---------+
+
+class ExpandTransformRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  ExpandTransformRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
@@ -5,6 +5,7 @@
 
 #include "graph/optimizer/rule/GeoPredicateIndexScanBaseRule.h"
 
+#include "common/base/ConcurrentLRUCache.h"
 #include "common/geo/GeoIndex.h"
 #include "graph/optimizer/OptContext.h"
 #include "graph/optimizer/OptGroup.h"
@@ -12,6 +13,7 @@
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/planner/plan/Scan.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/ExpressionUtils.h"
 #include "graph/util/OptimizerUtils.h"
 
@@ -29,6 +31,29 @@ using TransformResult = nebula::opt::OptRule::TransformResult;
 namespace nebula {
 namespace opt {
 
+namespace {
+
+using CoveringCache =
+    ConcurrentLRUCache<std::string, std::shared_ptr<const std::vector<geo::ScanRange>>>;
+
+CoveringCache& coveringCache() {
+  static CoveringCache cache(std::max<size_t>(FLAGS_geo_covering_cache_capacity, 64));
+  return cache;
+}
+
+// Round the distance up to at most 1/16 more, so the distances close to each other share the
+// covering. The covering of a larger distance covers the smaller one, and the predicate filters
+// the rows anyway.
+double distanceBucket(double distance) {
+  if (distance <= 1) {
+    return 1;
+  }
+  auto step = std::exp2(std::floor(std::log2(distance)) - 4);
+  return std::ceil(distance / step) * step;
+}
+
+}  // namespace
+
 bool GeoPredicateIndexScanBaseRule::match(OptContext* ctx, const MatchedResult& matched) const {
   if (!OptRule::match(ctx, matched)) {
     return false;
@@ -133,13 +158,8 @@ StatusOr<TransformResult> GeoPredicateIndexScanBaseRule::transform(
   }
   geo::GeoIndex geoIndex(rc, isPointColumn);
   std::vector<geo::ScanRange> scanRanges;
-  if (geoPredicateName == "st_intersects") {
-    scanRanges = geoIndex.intersects(geog);
-  } else if (geoPredicateName == "st_covers") {
-    scanRanges = geoIndex.coveredBy(geog);
-  } else if (geoPredicateName == "st_coveredby") {
-    scanRanges = geoIndex.covers(geog);
-  } else if (geoPredicateName == "st_dwithin") {
+  double distanceInMeters = 0;
+  if (geoPredicateName == "st_dwithin") {
     if (geoPredicate->args()->numArgs() < 3) {
       return TransformResult::noTransform();
     }
@@ -151,9 +171,41 @@ StatusOr<TransformResult> GeoPredicateIndexScanBaseRule::transform(
     if (!thirdVal.isNumeric()) {
       return TransformResult::noTransform();
     }
-    auto distanceInMeters = thirdVal.isFloat() ? thirdVal.getFloat() : thirdVal.getInt();
+    distanceInMeters =
+        distanceBucket(thirdVal.isFloat() ? thirdVal.getFloat() : thirdVal.getInt());
+  }
+  std::string cacheKey;
+  bool cached = false;
+  if (FLAGS_geo_covering_cache_capacity > 0) {
+    cacheKey = folly::sformat("{}/{}/{}/{}/{}/{}/{}",
+                              geoPredicateName,
+                              rc.minCellLevel_,
+                              rc.maxCellLevel_,
+                              rc.maxCellNum_,
+                              isPointColumn,
+                              distanceInMeters,
+                              geog.asWKB());
+    auto cachedRanges = coveringCache().get(cacheKey);
+    if (cachedRanges.ok()) {
+      scanRanges = *cachedRanges.value();
+      cached = true;
+    }
+  }
+  if (cached) {
+    VLOG(2) << "The covering of " << geoPredicateName << " is cached";
+  } else if (geoPredicateName == "st_intersects") {
+    scanRanges = geoIndex.intersects(geog);
+  } else if (geoPredicateName == "st_covers") {
+    scanRanges = geoIndex.coveredBy(geog);
+  } else if (geoPredicateName == "st_coveredby") {
+    scanRanges = geoIndex.covers(geog);
+  } else if (geoPredicateName == "st_dwithin") {
     scanRanges = geoIndex.dWithin(geog, distanceInMeters);
   }
+  if (!cached && !cacheKey.empty() && !scanRanges.empty()) {
+    coveringCache().insert(std::move(cacheKey),
+                           std::make_shared<const std::vector<geo::ScanRange>>(scanRanges));
+  }
   std::vector<IndexQueryContext> idxCtxs;
   idxCtxs.reserve(scanRanges.size());
   auto fieldName = geoField.get_name();
@@ -128,7 +128,8 @@ StatusOr<TransformResult> OptimizeEdgeIndexScanByFilterRule::transform(
 
   IndexQueryContext ictx;
   bool isPrefixScan = false;
-  if (!OptimizerUtils::findOptimalIndex(transformedExpr, indexItems, &isPrefixScan, &ictx)) {
+  if (!OptimizerUtils::findOptimalIndex(
+          transformedExpr, indexItems, &isPrefixScan, &ictx, &scan->returnColumns())) {
     return TransformResult::noTransform();
   }
 
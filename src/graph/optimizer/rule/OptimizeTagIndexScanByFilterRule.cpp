@@ -162,7 +162,8 @@ StatusOr<TransformResult> OptimizeTagIndexScanByFilterRule::transform(
 
   IndexQueryContext ictx;
   bool isPrefixScan = false;
-  if (!OptimizerUtils::findOptimalIndex(transformedExpr, indexItems, &isPrefixScan, &ictx)) {
+  if (!OptimizerUtils::findOptimalIndex(
+          transformedExpr, indexItems, &isPrefixScan, &ictx, &scan->returnColumns())) {
     return TransformResult::noTransform();
   }
 
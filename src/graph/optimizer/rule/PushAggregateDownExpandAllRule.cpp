@@ -0,0 +1,279 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushAggregateDownExpandAllRule.h"
+
+#include "common/expression/AggregateExpression.h"
+#include "common/expression/ColumnExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::ExpandAll;
+using nebula::graph::GetNeighbors;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::storage::cpp2::StatType;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// The expression of ExpandAll evaluated for the input prop of the Aggregate, or nullptr if the
+// prop is not an edge column of ExpandAll
+const Expression *edgeExprOf(const Project *project,
+                             const ExpandAll *expandAll,
+                             const Expression *expr) {
+  if (expr->kind() != Expression::Kind::kInputProperty) {
+    return nullptr;
+  }
+  const auto &name = static_cast<const InputPropertyExpression *>(expr)->prop();
+  const auto &colNames = project->colNames();
+  auto columns = project->columns()->columns();
+  const Expression *colExpr = nullptr;
+  for (size_t i = 0; i < colNames.size() && i < columns.size(); ++i) {
+    if (colNames[i] == name) {
+      colExpr = columns[i]->expr();
+      break;
+    }
+  }
+  if (colExpr == nullptr || colExpr->kind() != Expression::Kind::kVarProperty) {
+    return nullptr;
+  }
+  auto *varProp = static_cast<const VariablePropertyExpression *>(colExpr);
+  if (!varProp->sym().empty()) {
+    return nullptr;
+  }
+  for (auto *col : expandAll->edgeColumns()->columns()) {
+    if (col->alias() == varProp->prop()) {
+      return col->expr();
+    }
+  }
+  return nullptr;
+}
+
+// The edge expression on the edge type that storage evaluates for the stats, or nullptr if it's
+// not supported
+Expression *statExprOf(ObjectPool *pool, const Expression *edgeExpr, const std::string &edgeName) {
+  switch (edgeExpr->kind()) {
+    case Expression::Kind::kEdgeSrc:
+    case Expression::Kind::kEdgeDst:
+    case Expression::Kind::kEdgeRank:
+    case Expression::Kind::kEdgeType:
+    case Expression::Kind::kEdgeProperty:
+      break;
+    default:
+      return nullptr;
+  }
+  auto *propExpr = static_cast<const PropertyExpression *>(edgeExpr);
+  if (propExpr->sym() != "*" && propExpr->sym() != edgeName) {
+    return nullptr;
+  }
+  switch (edgeExpr->kind()) {
+    case Expression::Kind::kEdgeSrc:
+      return EdgeSrcIdExpression::make(pool, edgeName);
+    case Expression::Kind::kEdgeDst:
+      return EdgeDstIdExpression::make(pool, edgeName);
+    case Expression::Kind::kEdgeRank:
+      return EdgeRankExpression::make(pool, edgeName);
+    case Expression::Kind::kEdgeType:
+      return EdgeTypeExpression::make(pool, edgeName);
+    default:
+      return EdgePropertyExpression::make(pool, edgeName, propExpr->prop());
+  }
+}
+
+bool isNumeric(nebula::cpp2::PropertyType type) {
+  switch (type) {
+    case nebula::cpp2::PropertyType::INT64:
+    case nebula::cpp2::PropertyType::INT32:
+    case nebula::cpp2::PropertyType::INT16:
+    case nebula::cpp2::PropertyType::INT8:
+    case nebula::cpp2::PropertyType::FLOAT:
+    case nebula::cpp2::PropertyType::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<OptRule> PushAggregateDownExpandAllRule::kInstance =
+    std::unique_ptr<PushAggregateDownExpandAllRule>(new PushAggregateDownExpandAllRule());
+
+PushAggregateDownExpandAllRule::PushAggregateDownExpandAllRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushAggregateDownExpandAllRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      PlanNode::Kind::kAggregate,
+      {Pattern::create(PlanNode::Kind::kProject, {Pattern::create(PlanNode::Kind::kExpandAll)})});
+  return pattern;
+}
+
+bool PushAggregateDownExpandAllRule::match(OptContext *ctx, const MatchedResult &matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  auto *agg = static_cast<const Aggregate *>(matched.planNode({0}));
+  auto *expandAll = static_cast<const ExpandAll *>(matched.planNode({0, 0, 0}));
+  if (agg->groupKeys().size() != 1 || agg->groupItems().empty()) {
+    return false;
+  }
+  // Only the edges of the first step, which are all returned to the Project
+  if (expandAll->minSteps() != 1 || expandAll->maxSteps() != 1 || expandAll->joinInput() ||
+      expandAll->sample() || !expandAll->stepLimits().empty() || expandAll->filter() != nullptr ||
+      expandAll->limit(ctx->qctx()) != std::numeric_limits<int64_t>::max()) {
+    return false;
+  }
+  if (expandAll->edgeColumns() == nullptr ||
+      (expandAll->vertexColumns() != nullptr && !expandAll->vertexColumns()->empty())) {
+    return false;
+  }
+  auto *edgeProps = expandAll->edgeProps();
+  return edgeProps != nullptr && edgeProps->size() == 1 && *edgeProps->front().type_ref() > 0;
+}
+
+StatusOr<OptRule::TransformResult> PushAggregateDownExpandAllRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto *pool = qctx->objPool();
+  auto *aggGroupNode = matched.node;
+  const auto &projectMatched = matched.dependencies.front();
+  auto *expandAllGroupNode = projectMatched.dependencies.front().node;
+
+  auto *agg = static_cast<const Aggregate *>(aggGroupNode->node());
+  auto *project = static_cast<const Project *>(projectMatched.node->node());
+  auto *expandAll = static_cast<const ExpandAll *>(expandAllGroupNode->node());
+
+  auto edgeType = *expandAll->edgeProps()->front().type_ref();
+  auto edgeNameRet = qctx->schemaMng()->toEdgeName(expandAll->space(), edgeType);
+  if (!edgeNameRet.ok()) {
+    return TransformResult::noTransform();
+  }
+  const auto &edgeName = edgeNameRet.value();
+
+  // The group key has to be the src of the edges, which is the vid of GetNeighbors
+  auto *keyExpr = agg->groupKeys().front();
+  auto *keyEdgeExpr = edgeExprOf(project, expandAll, keyExpr);
+  if (keyEdgeExpr == nullptr || statExprOf(pool, keyEdgeExpr, edgeName) == nullptr ||
+      keyEdgeExpr->kind() != Expression::Kind::kEdgeSrc) {
+    return TransformResult::noTransform();
+  }
+
+  auto statProps = std::make_unique<std::vector<graph::StatProp>>();
+  auto *columns = pool->makeAndAdd<YieldColumns>();
+  for (auto *item : agg->groupItems()) {
+    auto *itemEdgeExpr = edgeExprOf(project, expandAll, item);
+    if (*item == *keyExpr ||
+        (itemEdgeExpr != nullptr && itemEdgeExpr->kind() == Expression::Kind::kEdgeSrc)) {
+      columns->addColumn(new YieldColumn(InputPropertyExpression::make(pool, nebula::kVid)));
+      continue;
+    }
+    if (item->kind() != Expression::Kind::kAggregate) {
+      return TransformResult::noTransform();
+    }
+    auto *aggExpr = static_cast<AggregateExpression *>(item);
+    auto name = aggExpr->name();
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    auto *arg = aggExpr->arg();
+
+    Expression *statExpr = nullptr;
+    auto statType = StatType::COUNT;
+    if (name == "COUNT" && !aggExpr->distinct()) {
+      statType = StatType::COUNT;
+      if (arg->kind() == Expression::Kind::kConstant &&
+          static_cast<const ConstantExpression *>(arg)->value() == Value("*")) {
+        // Every edge is counted by its rank, which is never null
+        statExpr = EdgeRankExpression::make(pool, edgeName);
+      } else if (auto *argEdgeExpr = edgeExprOf(project, expandAll, arg);
+                 argEdgeExpr != nullptr && argEdgeExpr->kind() != Expression::Kind::kEdgeProperty) {
+        // Storage counts the nulls as well, so only the props in the key are counted
+        statExpr = statExprOf(pool, argEdgeExpr, edgeName);
+      }
+    } else if (name == "SUM" && !aggExpr->distinct()) {
+      statType = StatType::SUM;
+      auto *argEdgeExpr = edgeExprOf(project, expandAll, arg);
+      if (argEdgeExpr != nullptr && argEdgeExpr->kind() == Expression::Kind::kEdgeProperty) {
+        // Storage rejects the sum of the props not numeric, but graph sums them to BAD_TYPE
+        auto schema = qctx->schemaMng()->getEdgeSchema(expandAll->space(), edgeType);
+        auto &prop = static_cast<const PropertyExpression *>(argEdgeExpr)->prop();
+        if (schema != nullptr && isNumeric(schema->getFieldType(prop))) {
+          statExpr = statExprOf(pool, argEdgeExpr, edgeName);
+        }
+      }
+    } else if (name == "COLLECT_SET") {
+      statType = StatType::COLLECT_SET;
+      auto *argEdgeExpr = edgeExprOf(project, expandAll, arg);
+      if (argEdgeExpr != nullptr) {
+        statExpr = statExprOf(pool, argEdgeExpr, edgeName);
+      }
+    }
+    if (statExpr == nullptr) {
+      return TransformResult::noTransform();
+    }
+
+    auto alias = "_agg_" + folly::to<std::string>(statProps->size());
+    graph::StatProp statProp;
+    statProp.alias_ref() = alias;
+    statProp.prop_ref() = Expression::encode(*statExpr);
+    statProp.stat_ref() = statType;
+    statProps->emplace_back(std::move(statProp));
+    columns->addColumn(new YieldColumn(InputPropertyExpression::make(pool, alias)));
+  }
+
+  std::vector<std::string> gnColNames{nebula::kVid};
+  for (const auto &statProp : *statProps) {
+    gnColNames.emplace_back(*statProp.alias_ref());
+  }
+  auto edgeProps = std::make_unique<std::vector<graph::EdgeProp>>(1);
+  edgeProps->front().type_ref() = edgeType;
+  // ExpandAll expands the vids of the last column of its input
+  auto *gn = GetNeighbors::make(qctx,
+                                nullptr,
+                                expandAll->space(),
+                                ColumnExpression::make(pool, -1),
+                                {edgeType},
+                                storage::cpp2::EdgeDirection::OUT_EDGE,
+                                nullptr,
+                                std::move(edgeProps),
+                                std::move(statProps),
+                                nullptr,
+                                true);
+  gn->setStatsOnly(true);
+  gn->setInputVar(expandAll->inputVar());
+  gn->setColNames(std::move(gnColNames));
+  auto *gnGroup = OptGroup::create(octx);
+  auto *gnGroupNode = gnGroup->makeGroupNode(gn);
+  for (auto *dep : expandAllGroupNode->dependencies()) {
+    gnGroupNode->dependsOn(dep);
+  }
+
+  auto *newProject = Project::make(qctx, gn, columns);
+  newProject->setInputVar(gn->outputVar());
+  newProject->setOutputVar(agg->outputVar());
+  newProject->setColNames(agg->colNames());
+  auto *newProjectGroupNode = OptGroupNode::create(octx, newProject, aggGroupNode->group());
+  newProjectGroupNode->dependsOn(gnGroup);
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newProjectGroupNode);
+  return result;
+}
+
+std::string PushAggregateDownExpandAllRule::toString() const {
+  return "PushAggregateDownExpandAllRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
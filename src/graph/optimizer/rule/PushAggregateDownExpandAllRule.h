@@ -0,0 +1,71 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNEXPANDALLRULE_H_
+#define GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNEXPANDALLRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Aggregate the edges of each src vertex in storage, rather than returning all edges to graph
+//  Required conditions:
+//   1. Match the pattern
+//   2. The ExpandAll expands one step over one edge type, without filter, limit or sample
+//   3. The only group key is the src of the edges
+//   4. The group items are the key, count(*), count of src/dst/rank/type, sum of a numeric edge
+//      prop, or collect_set of any of them
+//  Benefits:
+//   1. Only one row of the stats of each vertex is returned by storage
+//
+//  Transformation:
+//  Before:
+//
+//  +-------------+-------------+
+//  |         Aggregate         |
+//  |($-.s, count(*), sum($-.w))|
+//  +-------------+-------------+
+//                |
+//  +-------------+-------------+
+//  |          Project          |
+//  |   (src(edge) AS s, ...)   |
+//  +-------------+-------------+
+//                |
+//        +-------+-------+
+//        |   ExpandAll   |
+//        +-------+-------+
+//
+//  After:
+//
+//  +-------------+-------------+
+//  |          Project          |
+//  | ($-._vid, $-._agg_0, ...) |
+//  +-------------+-------------+
+//                |
+//  +-------------+-------------+
+//  |       GetNeighbors        |
+//  |     (statsOnly=true)      |
+//  +-------------+-------------+
+
+class PushAggregateDownExpandAllRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushAggregateDownExpandAllRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNEXPANDALLRULE_H_
@@ -0,0 +1,113 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushLimitDownTraverseRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+
+DECLARE_bool(optimize_appendvertices);
+
+using nebula::graph::AppendVertices;
+using nebula::graph::Limit;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+using nebula::graph::Traverse;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushLimitDownTraverseRule::kInstance =
+    std::unique_ptr<PushLimitDownTraverseRule>(new PushLimitDownTraverseRule());
+
+PushLimitDownTraverseRule::PushLimitDownTraverseRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushLimitDownTraverseRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      graph::PlanNode::Kind::kLimit,
+      {Pattern::create(graph::PlanNode::Kind::kAppendVertices,
+                       {Pattern::create(graph::PlanNode::Kind::kTraverse)})});
+  return pattern;
+}
+
+bool PushLimitDownTraverseRule::match(OptContext *ctx, const MatchedResult &matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  auto av = static_cast<const AppendVertices *>(matched.planNode({0, 0}));
+  // The rows are dropped if the vertices fetched don't exist or don't pass the filters
+  if (av->vFilter() != nullptr || av->filter() != nullptr) {
+    return false;
+  }
+  if (!FLAGS_optimize_appendvertices || !av->noNeedFetchProp()) {
+    return false;
+  }
+  auto traverse = static_cast<const Traverse *>(matched.planNode({0, 0, 0}));
+  // The edges of the final step are limited in storage, which is the only step
+  if (!traverse->isOneStep()) {
+    return false;
+  }
+  return traverse->vFilter() == nullptr && traverse->eFilter() == nullptr &&
+         traverse->firstStepFilter() == nullptr;
+}
+
+StatusOr<OptRule::TransformResult> PushLimitDownTraverseRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto limitGroupNode = matched.node;
+  auto avGroupNode = matched.dependencies.front().node;
+  auto traverseGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto limit = static_cast<const Limit *>(limitGroupNode->node());
+  const auto av = static_cast<const AppendVertices *>(avGroupNode->node());
+  const auto traverse = static_cast<const Traverse *>(traverseGroupNode->node());
+
+  if (!graph::ExpressionUtils::isEvaluableExpr(limit->countExpr()) ||
+      !graph::ExpressionUtils::isEvaluableExpr(traverse->limitExpr(), qctx)) {
+    return TransformResult::noTransform();
+  }
+  int64_t limitRows = limit->offset() + limit->count(qctx);
+  if (traverse->limit(qctx) >= 0 && limitRows >= traverse->limit(qctx)) {
+    return TransformResult::noTransform();
+  }
+
+  auto newLimit = static_cast<Limit *>(limit->clone());
+  newLimit->setOutputVar(limit->outputVar());
+  auto newLimitGroupNode = OptGroupNode::create(octx, newLimit, limitGroupNode->group());
+
+  auto newAv = static_cast<AppendVertices *>(av->clone());
+  auto newAvGroup = OptGroup::create(octx);
+  auto newAvGroupNode = newAvGroup->makeGroupNode(newAv);
+
+  auto newTraverse = static_cast<Traverse *>(traverse->clone());
+  newTraverse->setLimit(limitRows);
+  auto newTraverseGroup = OptGroup::create(octx);
+  auto newTraverseGroupNode = newTraverseGroup->makeGroupNode(newTraverse);
+
+  newLimitGroupNode->dependsOn(newAvGroup);
+  newLimit->setInputVar(newAv->outputVar());
+  newAvGroupNode->dependsOn(newTraverseGroup);
+  newAv->setInputVar(newTraverse->outputVar());
+  for (auto dep : traverseGroupNode->dependencies()) {
+    newTraverseGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newLimitGroupNode);
+  return result;
+}
+
+std::string PushLimitDownTraverseRule::toString() const {
+  return "PushLimitDownTraverseRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
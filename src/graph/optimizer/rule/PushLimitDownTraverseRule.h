@@ -0,0 +1,74 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHLIMITDOWNTRAVERSERULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHLIMITDOWNTRAVERSERULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embedding limit to [[Traverse]] of one step, e.g.
+//  MATCH (v:player)-[e]->(n) WHERE id(v) == "Tim Duncan" RETURN n LIMIT 3
+//  Required conditions:
+//   1. Match the pattern
+//   2. The [[Traverse]] is of one step, and all its filters evaluated in graphd are nullptr
+//   3. The [[AppendVertices]] keeps each row of its input, without fetching the vertices
+//  Benefits:
+//   1. Each storaged returns the edges limited of each vertex only
+//
+//  Transformation:
+//  Before:
+//
+//  +--------+--------+
+//  |      Limit      |
+//  |    (limit=3)    |
+//  +--------+--------+
+//           |
+// +---------+---------+
+// |   AppendVertices  |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |      Traverse     |
+// +---------+---------+
+//
+//  After:
+//
+//  +--------+--------+
+//  |      Limit      |
+//  |    (limit=3)    |
+//  +--------+--------+
+//           |
+// +---------+---------+
+// |   AppendVertices  |
+// +---------+---------+
+//           |
+// +---------+---------+
+// |      Traverse     |
+// |     (limit=3)     |
+// +---------+---------+
+
+class PushLimitDownTraverseRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushLimitDownTraverseRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHLIMITDOWNTRAVERSERULE_H
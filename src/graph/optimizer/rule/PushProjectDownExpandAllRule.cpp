@@ -0,0 +1,280 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushProjectDownExpandAllRule.h"
+
+#include "common/expression/PropertyExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+
+using nebula::graph::ExpandAll;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+using PropsMap = std::unordered_map<std::string, std::unordered_set<std::string>>;
+
+// The names of the input columns the project reads, false if it reads the input in other ways
+bool collectUsedColumns(const Project *project,
+                        const ExpandAll *expandAll,
+                        std::unordered_set<std::string> &used) {
+  for (const auto *col : project->columns()->columns()) {
+    if (graph::ExpressionUtils::hasAny(col->expr(),
+                                       {Expression::Kind::kColumn,
+                                        Expression::Kind::kVar,
+                                        Expression::Kind::kVersionedVar,
+                                        Expression::Kind::kVertex,
+                                        Expression::Kind::kEdge})) {
+      return false;
+    }
+    auto propExprs = graph::ExpressionUtils::collectAll(
+        col->expr(), {Expression::Kind::kVarProperty, Expression::Kind::kInputProperty});
+    for (const auto *expr : propExprs) {
+      auto *propExpr = static_cast<const PropertyExpression *>(expr);
+      if (expr->kind() == Expression::Kind::kVarProperty && !propExpr->sym().empty() &&
+          propExpr->sym() != expandAll->outputVar()) {
+        return false;
+      }
+      used.emplace(propExpr->prop());
+    }
+  }
+  return true;
+}
+
+// The columns used, nullptr if none of them is
+YieldColumns *pruneColumns(ObjectPool *pool,
+                           const YieldColumns *columns,
+                           const std::unordered_set<std::string> &used) {
+  if (columns == nullptr) {
+    return nullptr;
+  }
+  YieldColumns *pruned = nullptr;
+  for (const auto *col : columns->columns()) {
+    if (used.find(col->name()) == used.end()) {
+      continue;
+    }
+    if (pruned == nullptr) {
+      pruned = pool->makeAndAdd<YieldColumns>();
+    }
+    pruned->addColumn(col->clone().release());
+  }
+  return pruned;
+}
+
+// The props of the src tags and the edges read by the columns, false if the columns read the
+// entities rather than their props
+bool collectProps(const YieldColumns *columns, PropsMap &tagProps, PropsMap &edgeProps) {
+  if (columns == nullptr) {
+    return true;
+  }
+  for (const auto *col : columns->columns()) {
+    if (graph::ExpressionUtils::hasAny(col->expr(),
+                                       {Expression::Kind::kVertex,
+                                        Expression::Kind::kEdge,
+                                        Expression::Kind::kTagProperty,
+                                        Expression::Kind::kDstProperty,
+                                        Expression::Kind::kLabelTagProperty,
+                                        Expression::Kind::kInputProperty,
+                                        Expression::Kind::kVarProperty})) {
+      return false;
+    }
+    auto propExprs = graph::ExpressionUtils::collectAll(col->expr(),
+                                                        {Expression::Kind::kSrcProperty,
+                                                         Expression::Kind::kEdgeProperty,
+                                                         Expression::Kind::kEdgeSrc,
+                                                         Expression::Kind::kEdgeType,
+                                                         Expression::Kind::kEdgeRank,
+                                                         Expression::Kind::kEdgeDst});
+    for (const auto *expr : propExprs) {
+      auto *propExpr = static_cast<const PropertyExpression *>(expr);
+      auto &props = expr->kind() == Expression::Kind::kSrcProperty ? tagProps : edgeProps;
+      props[propExpr->sym()].emplace(propExpr->prop());
+    }
+  }
+  return true;
+}
+
+bool isUsed(const PropsMap &propsMap, const std::string &name, const std::string &prop) {
+  // The reserved props, e.g. _dst, are kept for the traversal
+  if (!prop.empty() && prop[0] == '_') {
+    return true;
+  }
+  for (const auto &key : {name, std::string("*")}) {
+    auto iter = propsMap.find(key);
+    if (iter != propsMap.end() && iter->second.find(prop) != iter->second.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::unique_ptr<OptRule> PushProjectDownExpandAllRule::kInstance =
+    std::unique_ptr<PushProjectDownExpandAllRule>(new PushProjectDownExpandAllRule());
+
+PushProjectDownExpandAllRule::PushProjectDownExpandAllRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushProjectDownExpandAllRule::pattern() const {
+  static Pattern pattern = Pattern::create(graph::PlanNode::Kind::kProject,
+                                           {Pattern::create(graph::PlanNode::Kind::kExpandAll)});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushProjectDownExpandAllRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto *pool = qctx->objPool();
+  auto projGroupNode = matched.node;
+  auto expandAllGroupNode = matched.dependencies.front().node;
+
+  const auto project = static_cast<const Project *>(projGroupNode->node());
+  const auto expandAll = static_cast<const ExpandAll *>(expandAllGroupNode->node());
+
+  std::unordered_set<std::string> used;
+  if (!collectUsedColumns(project, expandAll, used)) {
+    return TransformResult::noTransform();
+  }
+  auto *vertexColumns = expandAll->vertexColumns();
+  auto *edgeColumns = expandAll->edgeColumns();
+  auto *prunedVertexColumns = pruneColumns(pool, vertexColumns, used);
+  auto *prunedEdgeColumns = pruneColumns(pool, edgeColumns, used);
+  auto numColumns = [](const YieldColumns *columns) {
+    return columns == nullptr ? 0 : columns->size();
+  };
+  auto prunedNum = numColumns(prunedVertexColumns) + numColumns(prunedEdgeColumns);
+  // ExpandAll without any column gets the dsts only, so keep the columns as they are
+  if (prunedNum == 0 || prunedNum == numColumns(vertexColumns) + numColumns(edgeColumns)) {
+    return TransformResult::noTransform();
+  }
+
+  PropsMap tagProps, edgeProps;
+  if (!collectProps(prunedVertexColumns, tagProps, edgeProps) ||
+      !collectProps(prunedEdgeColumns, tagProps, edgeProps)) {
+    return TransformResult::noTransform();
+  }
+
+  // The props used by the filter embedded are read in storage without being returned
+  auto *schemaMng = qctx->schemaMng();
+  auto space = expandAll->space();
+  std::unique_ptr<std::vector<VertexProp>> newVertexProps;
+  if (expandAll->vertexProps() != nullptr) {
+    newVertexProps = std::make_unique<std::vector<VertexProp>>();
+    for (const auto &vertexProp : *expandAll->vertexProps()) {
+      auto tagId = vertexProp.tag_ref().value();
+      auto tagName = schemaMng->toTagName(space, tagId);
+      if (!tagName.ok()) {
+        return TransformResult::noTransform();
+      }
+      if (tagProps.find(tagName.value()) == tagProps.end()) {
+        continue;
+      }
+      const auto &props = vertexProp.props_ref().value();
+      if (props.empty()) {
+        // All props of the tag
+        newVertexProps->emplace_back(vertexProp);
+        continue;
+      }
+      std::vector<std::string> newProps;
+      for (const auto &prop : props) {
+        if (isUsed(tagProps, tagName.value(), prop)) {
+          newProps.emplace_back(prop);
+        }
+      }
+      if (newProps.empty()) {
+        continue;
+      }
+      VertexProp newVertexProp;
+      newVertexProp.tag_ref() = tagId;
+      newVertexProp.props_ref() = std::move(newProps);
+      newVertexProps->emplace_back(std::move(newVertexProp));
+    }
+    if (newVertexProps->empty()) {
+      newVertexProps.reset();
+    }
+  }
+
+  std::unique_ptr<std::vector<EdgeProp>> newEdgeProps;
+  if (expandAll->edgeProps() != nullptr) {
+    newEdgeProps = std::make_unique<std::vector<EdgeProp>>();
+    newEdgeProps->reserve(expandAll->edgeProps()->size());
+    // Each edge type is kept, which is traversed as well
+    for (const auto &edgeProp : *expandAll->edgeProps()) {
+      auto edgeType = edgeProp.type_ref().value();
+      const auto &props = edgeProp.props_ref().value();
+      auto edgeName = schemaMng->toEdgeName(space, std::abs(edgeType));
+      if (!edgeName.ok()) {
+        return TransformResult::noTransform();
+      }
+      std::vector<std::string> newProps;
+      for (const auto &prop : props) {
+        if (isUsed(edgeProps, edgeName.value(), prop)) {
+          newProps.emplace_back(prop);
+        }
+      }
+      if (newProps.empty()) {
+        // The empty props are all props of the edge
+        newEdgeProps->emplace_back(edgeProp);
+        continue;
+      }
+      EdgeProp newEdgeProp;
+      newEdgeProp.type_ref() = edgeType;
+      newEdgeProp.props_ref() = std::move(newProps);
+      newEdgeProps->emplace_back(std::move(newEdgeProp));
+    }
+  }
+
+  auto newExpandAll = static_cast<ExpandAll *>(expandAll->clone());
+  newExpandAll->setVertexColumns(prunedVertexColumns);
+  newExpandAll->setEdgeColumns(prunedEdgeColumns);
+  newExpandAll->setVertexProps(std::move(newVertexProps));
+  newExpandAll->setEdgeProps(std::move(newEdgeProps));
+  std::vector<std::string> colNames;
+  if (newExpandAll->joinInput()) {
+    colNames.emplace_back("_expand_vid");
+  }
+  for (const auto *columns : {prunedVertexColumns, prunedEdgeColumns}) {
+    if (columns != nullptr) {
+      auto names = columns->names();
+      colNames.insert(colNames.end(), names.begin(), names.end());
+    }
+  }
+  newExpandAll->setColNames(std::move(colNames));
+
+  auto newProject = static_cast<Project *>(project->clone());
+  newProject->setOutputVar(project->outputVar());
+  auto newProjectGroupNode = OptGroupNode::create(octx, newProject, projGroupNode->group());
+
+  auto newExpandAllGroup = OptGroup::create(octx);
+  auto newExpandAllGroupNode = newExpandAllGroup->makeGroupNode(newExpandAll);
+
+  newProjectGroupNode->dependsOn(newExpandAllGroup);
+  newProject->setInputVar(newExpandAll->outputVar());
+  for (auto dep : expandAllGroupNode->dependencies()) {
+    newExpandAllGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newProjectGroupNode);
+  return result;
+}
+
+std::string PushProjectDownExpandAllRule::toString() const {
+  return "PushProjectDownExpandAllRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,71 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHPROJECTDOWNEXPANDALLRULE_H_
+#define GRAPH_OPTIMIZER_RULE_PUSHPROJECTDOWNEXPANDALLRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Prune the columns of [[ExpandAll]] not used by the [[Project]], and the properties read
+//  from storage only for them
+//  Required conditions:
+//   1. Match the pattern
+//   2. Some columns of ExpandAll are not referenced by the Project, e.g. the ones only used by
+//   the filter embedded into ExpandAll, which is evaluated in storage
+//  Benefits:
+//   1. Storage returns the properties the Project uses only
+//
+//  Transformation:
+//  Before:
+//
+//  +---------+---------+
+//  |      Project      |
+//  |  ($-.like._dst)   |
+//  +---------+---------+
+//            |
+//  +---------+---------+
+//  |     ExpandAll     |
+//  |($^.player.age>30) |
+//  | (edgeColumns:     |
+//  | [like._dst],      |
+//  | vertexColumns:    |
+//  | [$^.player.age])  |
+//  +---------+---------+
+//
+//  After:
+//
+//  +---------+---------+
+//  |      Project      |
+//  |  ($-.like._dst)   |
+//  +---------+---------+
+//            |
+//  +---------+---------+
+//  |     ExpandAll     |
+//  |($^.player.age>30) |
+//  | (edgeColumns:     |
+//  | [like._dst])      |
+//  +---------+---------+
+
+class PushProjectDownExpandAllRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushProjectDownExpandAllRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHPROJECTDOWNEXPANDALLRULE_H_
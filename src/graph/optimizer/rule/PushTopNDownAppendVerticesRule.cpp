@@ -0,0 +1,147 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushTopNDownAppendVerticesRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+
+DECLARE_bool(optimize_appendvertices);
+
+using nebula::graph::AppendVertices;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+using nebula::graph::TopN;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushTopNDownAppendVerticesRule::kInstance =
+    std::unique_ptr<PushTopNDownAppendVerticesRule>(new PushTopNDownAppendVerticesRule());
+
+PushTopNDownAppendVerticesRule::PushTopNDownAppendVerticesRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushTopNDownAppendVerticesRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      PlanNode::Kind::kTopN,
+      {Pattern::create(PlanNode::Kind::kProject,
+                       {Pattern::create(PlanNode::Kind::kAppendVertices)})});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushTopNDownAppendVerticesRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto topNGroupNode = matched.node;
+  auto projectGroupNode = matched.dependencies.front().node;
+  auto avGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto topN = static_cast<const TopN *>(topNGroupNode->node());
+  const auto project = static_cast<const Project *>(projectGroupNode->node());
+  const auto av = static_cast<const AppendVertices *>(avGroupNode->node());
+
+  // The vertices filtered in graphd, or not fetched from storage, can't be limited in storage
+  if (av->vFilter() != nullptr || !av->orderBy().empty() || av->props() == nullptr ||
+      (FLAGS_optimize_appendvertices && av->noNeedFetchProp())) {
+    return TransformResult::noTransform();
+  }
+  if (av->limitExpr() != nullptr) {
+    if (!graph::ExpressionUtils::isEvaluableExpr(av->limitExpr(), qctx)) {
+      return TransformResult::noTransform();
+    }
+    auto limit = av->limit(qctx);
+    if (limit >= 0 && limit != std::numeric_limits<int64_t>::max()) {
+      return TransformResult::noTransform();
+    }
+  }
+
+  const auto &columns = project->columns()->columns();
+  std::vector<storage::cpp2::OrderBy> orderBys;
+  orderBys.reserve(topN->factors().size());
+  for (auto &factor : topN->factors()) {
+    if (factor.first >= columns.size()) {
+      return TransformResult::noTransform();
+    }
+    // The property of a tag of the vertex appended, e.g. n.player.age
+    auto *expr = columns[factor.first]->expr();
+    if (expr->kind() != Expression::Kind::kLabelTagProperty) {
+      return TransformResult::noTransform();
+    }
+    auto *tagProp = static_cast<const LabelTagPropertyExpression *>(expr);
+    auto *label = tagProp->label();
+    if (label->kind() != Expression::Kind::kInputProperty &&
+        label->kind() != Expression::Kind::kVarProperty) {
+      return TransformResult::noTransform();
+    }
+    auto *labelProp = static_cast<const PropertyExpression *>(label);
+    if (!labelProp->sym().empty() || labelProp->prop() != av->nodeAlias()) {
+      return TransformResult::noTransform();
+    }
+    auto tagId = qctx->schemaMng()->toTagID(av->space(), tagProp->sym());
+    if (!tagId.ok()) {
+      return TransformResult::noTransform();
+    }
+    // The vertices are ordered by the columns of the properties fetched
+    bool fetched = false;
+    for (const auto &vertexProp : *av->props()) {
+      const auto &props = vertexProp.get_props();
+      if (vertexProp.get_tag() == tagId.value() &&
+          std::find(props.begin(), props.end(), tagProp->prop()) != props.end()) {
+        fetched = true;
+        break;
+      }
+    }
+    if (!fetched) {
+      return TransformResult::noTransform();
+    }
+    storage::cpp2::OrderBy orderBy;
+    orderBy.prop_ref() = tagProp->sym() + "." + tagProp->prop();
+    orderBy.direction_ref() = factor.second == OrderFactor::OrderType::ASCEND
+                                  ? storage::cpp2::OrderDirection::ASCENDING
+                                  : storage::cpp2::OrderDirection::DESCENDING;
+    orderBys.emplace_back(std::move(orderBy));
+  }
+  int64_t limitRows = topN->offset() + topN->count();
+
+  auto newTopN = static_cast<TopN *>(topN->clone());
+  newTopN->setOutputVar(topN->outputVar());
+  auto newTopNGroupNode = OptGroupNode::create(octx, newTopN, topNGroupNode->group());
+
+  auto newProject = static_cast<Project *>(project->clone());
+  auto newProjectGroup = OptGroup::create(octx);
+  auto newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+
+  auto newAv = static_cast<AppendVertices *>(av->clone());
+  newAv->setLimit(limitRows);
+  newAv->setOrderBy(std::move(orderBys));
+  auto newAvGroup = OptGroup::create(octx);
+  auto newAvGroupNode = newAvGroup->makeGroupNode(newAv);
+
+  newTopNGroupNode->dependsOn(newProjectGroup);
+  newTopN->setInputVar(newProject->outputVar());
+  newProjectGroupNode->dependsOn(newAvGroup);
+  newProject->setInputVar(newAv->outputVar());
+  for (auto dep : avGroupNode->dependencies()) {
+    newAvGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newTopNGroupNode);
+  return result;
+}
+
+std::string PushTopNDownAppendVerticesRule::toString() const {
+  return "PushTopNDownAppendVerticesRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNAPPENDVERTICESRULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNAPPENDVERTICESRULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embedding TopN factors into the requests of AppendVertices, e.g.
+//  MATCH (v)-[e]->(n) RETURN n ORDER BY n.player.age LIMIT 10
+//  Required conditions:
+//   1. Match the pattern
+//   2. The factors are the properties of the tags of the vertices appended, which are fetched
+//   3. The vertices are not filtered in graphd, and not ordered or limited yet
+//  Benefits:
+//   1. Each storaged returns the top vertices only, which are merged by the TopN
+//
+//  Transformation:
+//  Before:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |    AppendVertices   |
+//  +----------+----------+
+//
+//  After:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |    AppendVertices   |
+//  | (limit_=limitRows)  |
+//  | (orderBy_=orderBys) |
+//  +----------+----------+
+
+class PushTopNDownAppendVerticesRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushTopNDownAppendVerticesRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNAPPENDVERTICESRULE_H
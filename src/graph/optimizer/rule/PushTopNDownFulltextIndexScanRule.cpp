@@ -0,0 +1,168 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushTopNDownFulltextIndexScanRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/Constants.h"
+
+using nebula::graph::Argument;
+using nebula::graph::Explore;
+using nebula::graph::FulltextIndexScan;
+using nebula::graph::HashInnerJoin;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+using nebula::graph::TopN;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushTopNDownFulltextIndexScanRule::kInstance =
+    std::unique_ptr<PushTopNDownFulltextIndexScanRule>(new PushTopNDownFulltextIndexScanRule());
+
+PushTopNDownFulltextIndexScanRule::PushTopNDownFulltextIndexScanRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushTopNDownFulltextIndexScanRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      PlanNode::Kind::kTopN,
+      {
+          Pattern::create(
+              PlanNode::Kind::kProject,
+              {
+                  Pattern::create(
+                      PlanNode::Kind::kHashInnerJoin,
+                      {
+                          Pattern::create(PlanNode::Kind::kFulltextIndexScan),
+                          Pattern::create(PlanNode::Kind::kProject,
+                                          {
+                                              Pattern::create(
+                                                  {
+                                                      PlanNode::Kind::kGetVertices,
+                                                      PlanNode::Kind::kGetEdges,
+                                                  },
+                                                  {
+                                                      Pattern::create(PlanNode::Kind::kArgument),
+                                                  }),
+                                          }),
+                      }),
+              }),
+      });
+  return pattern;
+}
+
+bool PushTopNDownFulltextIndexScanRule::match(OptContext *, const MatchedResult &matched) const {
+  auto ft = static_cast<const FulltextIndexScan *>(matched.planNode({0, 0, 0, 0}));
+  if (ft->limitExpr() && ft->limit() >= 0 && ft->offset() >= 0) {
+    return false;
+  }
+  auto topN = static_cast<const TopN *>(matched.planNode());
+  const auto &factors = topN->factors();
+  if (factors.size() != 1 || factors.front().second != OrderFactor::OrderType::DESCEND) {
+    return false;
+  }
+  // The sorted column must be the score yielded
+  auto project = static_cast<const Project *>(matched.planNode({0, 0}));
+  const auto &columns = project->columns()->columns();
+  if (factors.front().first >= columns.size()) {
+    return false;
+  }
+  auto *expr = columns[factors.front().first]->expr();
+  if (expr->kind() != Expression::Kind::kVarProperty) {
+    return false;
+  }
+  auto *varProp = static_cast<const VariablePropertyExpression *>(expr);
+  return varProp->sym().empty() && varProp->prop() == graph::kScore;
+}
+
+StatusOr<OptRule::TransformResult> PushTopNDownFulltextIndexScanRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto topNGroupNode = matched.result().node;
+  const auto topN = static_cast<const TopN *>(topNGroupNode->node());
+  auto newTopN = static_cast<TopN *>(topN->clone());
+  newTopN->setOutputVar(topN->outputVar());
+  auto newTopNGroupNode = OptGroupNode::create(octx, newTopN, topNGroupNode->group());
+
+  auto projectGroupNode = matched.result({0, 0}).node;
+  auto project = static_cast<const Project *>(projectGroupNode->node());
+  auto newProject = static_cast<Project *>(project->clone());
+  auto newProjectGroup = OptGroup::create(octx);
+  auto newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+
+  newTopNGroupNode->dependsOn(newProjectGroup);
+  newTopN->setInputVar(newProject->outputVar());
+
+  auto joinGroupNode = matched.result({0, 0, 0}).node;
+  auto join = static_cast<const HashInnerJoin *>(joinGroupNode->node());
+  auto newJoin = static_cast<HashInnerJoin *>(join->clone());
+  auto newJoinGroup = OptGroup::create(octx);
+  auto newJoinGroupNode = newJoinGroup->makeGroupNode(newJoin);
+
+  newProjectGroupNode->dependsOn(newJoinGroup);
+  newProject->setInputVar(newJoin->outputVar());
+
+  // TopN still sorts the top documents and skips the offset of them
+  auto ftGroupNode = matched.result({0, 0, 0, 0}).node;
+  const auto ft = static_cast<const FulltextIndexScan *>(ftGroupNode->node());
+  auto newFt = static_cast<FulltextIndexScan *>(ft->clone());
+  newFt->setLimit(topN->count() + topN->offset());
+  newFt->setOffset(0);
+  auto newFtGroup = OptGroup::create(octx);
+  auto newFtGroupNode = newFtGroup->makeGroupNode(newFt);
+
+  newJoinGroupNode->dependsOn(newFtGroup);
+  newJoin->setLeftVar(newFt->outputVar());
+  for (auto dep : ftGroupNode->dependencies()) {
+    newFtGroupNode->dependsOn(dep);
+  }
+
+  auto projGroupNode = matched.result({0, 0, 0, 1}).node;
+  auto proj = static_cast<const Project *>(projGroupNode->node());
+  auto newProj = static_cast<Project *>(proj->clone());
+  auto newProjGroup = OptGroup::create(octx);
+  auto newProjGroupNode = newProjGroup->makeGroupNode(newProj);
+
+  newJoinGroupNode->dependsOn(newProjGroup);
+  newJoin->setRightVar(newProj->outputVar());
+
+  auto exploreGroupNode = matched.result({0, 0, 0, 1, 0}).node;
+  auto explore = static_cast<const Explore *>(exploreGroupNode->node());
+  auto newExplore = static_cast<Explore *>(explore->clone());
+  auto newExploreGroup = OptGroup::create(octx);
+  auto newExploreGroupNode = newExploreGroup->makeGroupNode(newExplore);
+
+  newProjGroupNode->dependsOn(newExploreGroup);
+  newProj->setInputVar(newExplore->outputVar());
+
+  auto argGroupNode = matched.result({0, 0, 0, 1, 0, 0}).node;
+  auto arg = static_cast<const Argument *>(argGroupNode->node());
+  auto newArg = static_cast<Argument *>(arg->clone());
+  auto newArgGroup = OptGroup::create(octx);
+  auto newArgGroupNode = newArgGroup->makeGroupNode(newArg);
+
+  newExploreGroupNode->dependsOn(newArgGroup);
+  newExplore->setInputVar(newArg->outputVar());
+  for (auto dep : argGroupNode->dependencies()) {
+    newArgGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newTopNGroupNode);
+  return result;
+}
+
+std::string PushTopNDownFulltextIndexScanRule::toString() const {
+  return "PushTopNDownFulltextIndexScanRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
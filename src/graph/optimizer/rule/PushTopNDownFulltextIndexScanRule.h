@@ -0,0 +1,65 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNFULLTEXTINDEXSCANRULE_H_
+#define GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNFULLTEXTINDEXSCANRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embedding the limit of TopN by the score descending to [[FulltextIndexScan]], since
+//  elasticsearch returns the documents by their scores descending, so only the top documents are
+//  requested and their vertices/edges fetched
+//  Required conditions:
+//   1. Match the pattern
+//   2. TopN sorts by the score column only, descending
+//  Benefits:
+//   1. Limit data early to optimize performance
+//
+//  Transformation:
+//  Before:
+//
+// TopN (factors=[score DESC], count=3, offset=1)
+//   `- Project (score() AS sc, ...)
+//       `- HashInnerJoin
+//           |- Project
+//           |   `- GetVertices/GetEdges
+//           |       `- Argument
+//           `- FulltextIndexScan
+//
+//  After:
+//
+// TopN (factors=[score DESC], count=3, offset=1)
+//   `- Project (score() AS sc, ...)
+//       `- HashInnerJoin
+//           |- Project
+//           |   `- GetVertices/GetEdges
+//           |       `- Argument
+//           `- FulltextIndexScan (limit=4)
+//
+
+class PushTopNDownFulltextIndexScanRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushTopNDownFulltextIndexScanRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNFULLTEXTINDEXSCANRULE_H_
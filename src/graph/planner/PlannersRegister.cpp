@@ -22,6 +22,7 @@
 #include "graph/planner/ngql/LookupPlanner.h"
 #include "graph/planner/ngql/MaintainPlanner.h"
 #include "graph/planner/ngql/PathPlanner.h"
+#include "graph/planner/ngql/RandomWalkPlanner.h"
 #include "graph/planner/ngql/SubgraphPlanner.h"
 
 namespace nebula {
@@ -73,6 +74,10 @@ void PlannersRegister::registerSequential() {
     auto& planners = Planner::plannersMap()[Sentence::Kind::kGetSubgraph];
     planners.emplace_back(&SubgraphPlanner::match, &SubgraphPlanner::make);
   }
+  {
+    auto& planners = Planner::plannersMap()[Sentence::Kind::kRandomWalk];
+    planners.emplace_back(&RandomWalkPlanner::match, &RandomWalkPlanner::make);
+  }
   {
     auto& planners = Planner::plannersMap()[Sentence::Kind::kFetchVertices];
     planners.emplace_back(&FetchVerticesPlanner::match, &FetchVerticesPlanner::make);
@@ -6,7 +6,9 @@
 #include "graph/planner/SequentialPlanner.h"
 
 #include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Mutate.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/validator/SequentialValidator.h"
 #include "parser/Sentence.h"
 
@@ -19,14 +21,21 @@ bool SequentialPlanner::match(AstContext* astCtx) {
 StatusOr<SubPlan> SequentialPlanner::transform(AstContext* astCtx) {
   SubPlan subPlan;
   auto* seqCtx = static_cast<SequentialAstContext*>(astCtx);
-  const auto& validators = seqCtx->validators;
+  std::vector<Validator*> validators;
+  validators.reserve(seqCtx->validators.size());
+  for (const auto& validator : seqCtx->validators) {
+    if (!validators.empty() && mergeInserts(validators.back(), validator.get())) {
+      continue;
+    }
+    validators.emplace_back(validator.get());
+  }
   subPlan.root = validators.back()->root();
   for (auto iter = validators.begin(); iter < validators.end() - 1; ++iter) {
     // Remove left tail kStart plannode before append plan.
     // It allows that kUse sentence to append kMatch Sentence.
     // For example: Use ...; Match ...
-    rmLeftTailStartNode((iter + 1)->get());
-    NG_RETURN_IF_ERROR((iter + 1)->get()->appendPlan(iter->get()->root()));
+    rmLeftTailStartNode(*(iter + 1));
+    NG_RETURN_IF_ERROR((*(iter + 1))->appendPlan((*iter)->root()));
   }
   if (validators.front()->tail()->isSingleInput()) {
     subPlan.tail = seqCtx->startNode;
@@ -56,5 +65,45 @@ void SequentialPlanner::rmLeftTailStartNode(Validator* validator) {
     validator->setTail(node);
   }
 }
+
+bool SequentialPlanner::mergeInserts(Validator* prev, Validator* next) {
+  auto* prevNode = prev->root();
+  auto* nextNode = next->root();
+  // Only the plans of the inserts alone
+  if (prevNode != prev->tail() || nextNode != next->tail() ||
+      prevNode->kind() != nextNode->kind()) {
+    return false;
+  }
+  if (prevNode->kind() == PlanNode::Kind::kInsertVertices) {
+    auto* prevInsert = static_cast<InsertVertices*>(prevNode);
+    auto* nextInsert = static_cast<const InsertVertices*>(nextNode);
+    if (prevInsert->getSpace() != nextInsert->getSpace() ||
+        prevInsert->getPropNames() != nextInsert->getPropNames() ||
+        prevInsert->getIfNotExists() != nextInsert->getIfNotExists() ||
+        prevInsert->getIgnoreExistedIndex() != nextInsert->getIgnoreExistedIndex() ||
+        prevInsert->getVertices().size() + nextInsert->getVertices().size() >
+            FLAGS_insert_batch_max_rows) {
+      return false;
+    }
+    prevInsert->appendVertices(nextInsert->getVertices());
+    return true;
+  }
+  if (prevNode->kind() == PlanNode::Kind::kInsertEdges) {
+    auto* prevInsert = static_cast<InsertEdges*>(prevNode);
+    auto* nextInsert = static_cast<const InsertEdges*>(nextNode);
+    if (prevInsert->getSpace() != nextInsert->getSpace() ||
+        prevInsert->getPropNames() != nextInsert->getPropNames() ||
+        prevInsert->getIfNotExists() != nextInsert->getIfNotExists() ||
+        prevInsert->getIgnoreExistedIndex() != nextInsert->getIgnoreExistedIndex() ||
+        prevInsert->useChainInsert() != nextInsert->useChainInsert() ||
+        prevInsert->getEdges().size() + nextInsert->getEdges().size() >
+            FLAGS_insert_batch_max_rows) {
+      return false;
+    }
+    prevInsert->appendEdges(nextInsert->getEdges());
+    return true;
+  }
+  return false;
+}
 }  // namespace graph
 }  // namespace nebula
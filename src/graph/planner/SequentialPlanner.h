@@ -28,6 +28,12 @@ class SequentialPlanner final : public Planner {
 
   void rmLeftTailStartNode(Validator* validator);
 
+  /**
+   * Merge the insert of next into the one of prev if both of them are the inserts of the same
+   * space, props and flags, so the consecutive inserts take one round trip of storage.
+   */
+  static bool mergeInserts(Validator* prev, Validator* next);
+
  private:
   SequentialPlanner() = default;
 };
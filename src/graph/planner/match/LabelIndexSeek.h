@@ -22,6 +22,10 @@ class LabelIndexSeek final : public StartVidFinder {
     return "LabelIndexSeekFinder";
   }
 
+  bool estimable() const override {
+    return true;
+  }
+
  private:
   LabelIndexSeek() = default;
 
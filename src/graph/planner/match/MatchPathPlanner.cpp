@@ -110,8 +110,24 @@ Status MatchPathPlanner::findStarts(WhereClauseContext* bindWhereClause,
   auto* qctx = ctx_->qctx;
   const auto& nodeInfos = path_.nodeInfos;
   const auto& edgeInfos = path_.edgeInfos;
+  auto* metaClient = qctx->getMetaClient();
+  auto stats = metaClient == nullptr ? nullptr : metaClient->getStatsFromCache(spaceId);
   // Find the start plan node
   for (auto& finder : startVidFinders) {
+    if (stats != nullptr && finder()->estimable()) {
+      NG_RETURN_IF_ERROR(findEstimatedStart(finder,
+                                            *stats,
+                                            bindWhereClause,
+                                            &nodeAliasesSeen,
+                                            startFromEdge,
+                                            startIndex,
+                                            foundStart,
+                                            matchClausePlan));
+      if (foundStart) {
+        break;
+      }
+      continue;
+    }
     for (size_t i = 0; i < nodeInfos.size() && !foundStart; ++i) {
       NodeContext nodeCtx(qctx, bindWhereClause, spaceId, &nodeInfos[i]);
       nodeCtx.aliasesAvailable = &nodeAliasesSeen;
@@ -158,6 +174,57 @@ Status MatchPathPlanner::findStarts(WhereClauseContext* bindWhereClause,
   return Status::OK();
 }
 
+Status MatchPathPlanner::findEstimatedStart(const StartVidFinderInstantiateFunc& finder,
+                                            const meta::cpp2::StatsItem& stats,
+                                            WhereClauseContext* bindWhereClause,
+                                            std::unordered_set<std::string>* nodeAliasesSeen,
+                                            bool& startFromEdge,
+                                            size_t& startIndex,
+                                            bool& foundStart,
+                                            SubPlan& matchClausePlan) {
+  auto spaceId = ctx_->space.id;
+  auto* qctx = ctx_->qctx;
+  const auto& nodeInfos = path_.nodeInfos;
+  const auto& edgeInfos = path_.edgeInfos;
+  // Match all the nodes and edges, the first one of the least rows wins
+  std::unique_ptr<StartVidFinder> bestFinder;
+  std::unique_ptr<PatternContext> bestCtx;
+  auto bestRows = std::numeric_limits<double>::infinity();
+  auto tryStart = [&](std::unique_ptr<PatternContext> patternCtx, size_t index) {
+    auto patternFinder = finder();
+    if (!patternFinder->match(patternCtx.get())) {
+      return;
+    }
+    auto rows = MatchSolver::estimateStartRows(patternCtx.get(), stats);
+    if (bestCtx == nullptr || rows < bestRows) {
+      bestFinder = std::move(patternFinder);
+      bestCtx = std::move(patternCtx);
+      bestRows = rows;
+      startIndex = index;
+    }
+  };
+  for (size_t i = 0; i < nodeInfos.size(); ++i) {
+    auto nodeCtx = std::make_unique<NodeContext>(qctx, bindWhereClause, spaceId, &nodeInfos[i]);
+    nodeCtx->aliasesAvailable = nodeAliasesSeen;
+    tryStart(std::move(nodeCtx), i);
+    if (i != nodeInfos.size() - 1) {
+      tryStart(std::make_unique<EdgeContext>(qctx, bindWhereClause, spaceId, &edgeInfos[i]), i);
+    }
+  }
+  if (bestCtx == nullptr) {
+    return Status::OK();
+  }
+  auto plan = bestFinder->transform(bestCtx.get());
+  NG_RETURN_IF_ERROR(plan);
+  matchClausePlan = std::move(plan).value();
+  startFromEdge = bestCtx->kind == PatternKind::kEdge;
+  foundStart = true;
+  initialExpr_ = bestCtx->initialExpr->clone();
+  VLOG(1) << "Find starts: " << startIndex << " by " << bestFinder->name() << ", estimated rows: "
+          << bestRows << ", from edge: " << startFromEdge;
+  return Status::OK();
+}
+
 Status MatchPathPlanner::expand(bool startFromEdge, size_t startIndex, SubPlan& subplan) {
   if (startFromEdge) {
     return expandFromEdge(startIndex, subplan);
@@ -235,6 +302,9 @@ Status MatchPathPlanner::leftExpandFromNode(size_t startIndex, SubPlan& subplan)
     subplan.root = traverse;
     nextTraverseStart = genNextTraverseStart(qctx->objPool(), edge, node);
     if (expandInto) {
+      if (trackPrevPath && stepRange.min() == 1 && stepRange.max() == 1) {
+        traverse->setClosingVid(nodeId(qctx->objPool(), dst));
+      }
       // TODO(shylock) optimize to embed filter to Traverse
       auto* startVid = nodeId(qctx->objPool(), dst);
       auto* endVid = nextTraverseStart;
@@ -305,6 +375,9 @@ Status MatchPathPlanner::rightExpandFromNode(size_t startIndex, SubPlan& subplan
     subplan.root = traverse;
     nextTraverseStart = genNextTraverseStart(qctx->objPool(), edge, node);
     if (expandInto) {
+      if (i != startIndex && stepRange.min() == 1 && stepRange.max() == 1) {
+        traverse->setClosingVid(nodeId(qctx->objPool(), dst));
+      }
       auto* startVid = nodeId(qctx->objPool(), dst);
       auto* endVid = nextTraverseStart;
       auto* filterExpr = RelationalExpression::makeEQ(qctx->objPool(), startVid, endVid);
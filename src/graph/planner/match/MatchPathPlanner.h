@@ -5,6 +5,7 @@
 #pragma once
 
 #include "graph/planner/match/CypherClausePlanner.h"
+#include "graph/planner/match/StartVidFinder.h"
 
 namespace nebula {
 namespace graph {
@@ -24,6 +25,17 @@ class MatchPathPlanner final {
                     size_t& startIndex,
                     SubPlan& matchClausePlan);
 
+  // Choose the start of the least rows estimated by the statistics among the patterns the finder
+  // matches, foundStart is false if it matches none
+  Status findEstimatedStart(const StartVidFinderInstantiateFunc& finder,
+                            const meta::cpp2::StatsItem& stats,
+                            WhereClauseContext* bindWhereClause,
+                            std::unordered_set<std::string>* nodeAliasesSeen,
+                            bool& startFromEdge,
+                            size_t& startIndex,
+                            bool& foundStart,
+                            SubPlan& matchClausePlan);
+
   Status expand(bool startFromEdge, size_t startIndex, SubPlan& subplan);
   Status expandFromNode(size_t startIndex, SubPlan& subplan);
   Status leftExpandFromNode(size_t startIndex, SubPlan& subplan);
@@ -321,5 +321,39 @@ void MatchSolver::buildProjectColumns(QueryContext* qctx, const Path& path, SubP
   plan.root = project;
 }
 
+/*static*/ double MatchSolver::estimateStartRows(const PatternContext* patternCtx,
+                                                 const meta::cpp2::StatsItem& stats) {
+  auto unknown = std::numeric_limits<double>::infinity();
+  if (patternCtx->kind == PatternKind::kNode) {
+    const auto* node = static_cast<const NodeContext*>(patternCtx)->info;
+    if (node->labels.empty()) {
+      return static_cast<double>(stats.get_space_vertices());
+    }
+    auto rows = unknown;
+    const auto& tagVertices = stats.get_tag_vertices();
+    for (const auto& label : node->labels) {
+      auto found = tagVertices.find(label);
+      if (found != tagVertices.end()) {
+        rows = std::min(rows, static_cast<double>(found->second));
+      }
+    }
+    return rows;
+  }
+  const auto* edge = static_cast<const EdgeContext*>(patternCtx)->info;
+  if (edge->types.empty()) {
+    return static_cast<double>(stats.get_space_edges());
+  }
+  double rows = 0;
+  const auto& edges = stats.get_edges();
+  for (const auto& type : edge->types) {
+    auto found = edges.find(type);
+    if (found == edges.end()) {
+      return unknown;
+    }
+    rows += static_cast<double>(found->second);
+  }
+  return rows;
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -58,6 +58,11 @@ class MatchSolver final {
   // Build yield columns for match & shortestPath statement
   static void buildProjectColumns(QueryContext* qctx, const Path& path, SubPlan& plan);
 
+  // Estimate the rows the pattern starts from by the statistics of the space, i.e. the vertices
+  // of the least tag of the node or the edges of all types of the edge. Infinity if unknown.
+  static double estimateStartRows(const PatternContext* patternCtx,
+                                  const meta::cpp2::StatsItem& stats);
+
   static bool extractLabelAndConstant(const Expression* left,
                                       const Expression* right,
                                       const string& label,
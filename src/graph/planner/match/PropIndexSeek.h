@@ -30,6 +30,10 @@ class PropIndexSeek final : public StartVidFinder {
     return "PropIndexSeekFinder";
   }
 
+  bool estimable() const override {
+    return true;
+  }
+
  private:
   PropIndexSeek() = default;
 };
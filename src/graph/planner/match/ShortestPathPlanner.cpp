@@ -114,6 +114,7 @@ StatusOr<SubPlan> ShortestPathPlanner::transform(WhereClauseContext* bindWhereCl
   shortestPath->setReverseEdgeProps(SchemaUtil::getEdgeProps(edge, true, qctx, spaceId));
   shortestPath->setEdgeDirection(edge.direction);
   shortestPath->setStepRange(stepRange);
+  shortestPath->setWeightProp(path_.weightProp);
   shortestPath->setColNames(std::move(colNames));
 
   subplan.root = shortestPath;
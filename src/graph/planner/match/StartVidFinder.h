@@ -78,6 +78,12 @@ class StartVidFinder {
 
   virtual const char* name() const = 0;
 
+  // Whether the patterns matched by the finder could be compared by the rows estimated to choose
+  // the start, i.e. match only writes the pattern context
+  virtual bool estimable() const {
+    return false;
+  }
+
  protected:
   StartVidFinder() = default;
 };
@@ -9,6 +9,7 @@
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/util/ExpressionUtils.h"
+#include "graph/util/OptimizerUtils.h"
 
 using nebula::meta::cpp2::IndexItem;
 using nebula::storage::cpp2::IndexQueryContext;
@@ -122,7 +123,8 @@ bool VariablePropIndexSeek::getIndexItem(const NodeContext* nodeCtx,
   std::vector<std::shared_ptr<IndexItem>> idxItemList;
   for (auto itemPtr : status.value()) {
     auto schemaId = itemPtr->get_schema_id();
-    if (schemaId.get_tag_id() == nodeCtx->info->tids.back()) {
+    if (schemaId.get_tag_id() == nodeCtx->info->tids.back() &&
+        !OptimizerUtils::isElementIndex(*itemPtr)) {
       const auto& fields = itemPtr->get_fields();
       if (!fields.empty() && fields.front().get_name() == propName) {
         idxItemList.push_back(itemPtr);
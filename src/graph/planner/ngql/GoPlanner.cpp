@@ -6,6 +6,7 @@
 #include "graph/planner/ngql/GoPlanner.h"
 
 #include "graph/planner/plan/Logic.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/ExpressionUtils.h"
 #include "graph/util/PlannerUtil.h"
 
@@ -122,6 +123,15 @@ PlanNode* GoPlanner::buildJoinDstPlan(PlanNode* dep) {
                                       buildVertexProps(goCtx_->exprProps.dstTagProps()),
                                       {},
                                       true);
+  if (FLAGS_join_dst_props_in_storage && dep->kind() == PlanNode::Kind::kExpandAll) {
+    // The dsts led by the storaged of the neighbors are returned along with them, GetVertices
+    // fetches the others only
+    auto dstVerticesVar = folly::sformat("{}_dst_vertices", dep->outputVar());
+    qctx->symTable()->newVariable(dstVerticesVar);
+    static_cast<ExpandAll*>(dep)->setDstVertices(
+        buildVertexProps(goCtx_->exprProps.dstTagProps()), dstVerticesVar);
+    getVertex->setPrefetchedVar(std::move(dstVerticesVar));
+  }
 
   auto& dstPropsExpr = goCtx_->dstPropsExpr;
   // extract dst's prop
@@ -0,0 +1,57 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#include "graph/planner/ngql/RandomWalkPlanner.h"
+
+#include "graph/planner/plan/Algo.h"
+#include "graph/util/PlannerUtil.h"
+
+namespace nebula {
+namespace graph {
+
+std::unique_ptr<std::vector<EdgeProp>> RandomWalkPlanner::buildEdgeProps() {
+  auto edgeProps = std::make_unique<std::vector<EdgeProp>>();
+  auto direction = walkCtx_->over.direction;
+  for (auto edgeType : walkCtx_->over.edgeTypes) {
+    if (direction != storage::cpp2::EdgeDirection::IN_EDGE) {
+      EdgeProp ep;
+      ep.type_ref() = edgeType;
+      ep.props_ref() = {kDst};
+      edgeProps->emplace_back(std::move(ep));
+    }
+    if (direction != storage::cpp2::EdgeDirection::OUT_EDGE) {
+      EdgeProp ep;
+      ep.type_ref() = -edgeType;
+      ep.props_ref() = {kDst};
+      edgeProps->emplace_back(std::move(ep));
+    }
+  }
+  return edgeProps;
+}
+
+StatusOr<SubPlan> RandomWalkPlanner::transform(AstContext* astCtx) {
+  walkCtx_ = static_cast<RandomWalkContext*>(astCtx);
+  auto* qctx = walkCtx_->qctx;
+  std::string vidsVar;
+
+  auto startPlan = PlannerUtil::buildStart(qctx, walkCtx_->from, vidsVar);
+  auto* walk = RandomWalk::make(qctx,
+                                startPlan.root,
+                                walkCtx_->space.id,
+                                walkCtx_->from.src,
+                                walkCtx_->steps.steps(),
+                                walkCtx_->walks);
+  walk->setBias(walkCtx_->p, walkCtx_->q);
+  walk->setEdgeProps(buildEdgeProps());
+  walk->setInputVar(vidsVar);
+  walk->setColNames(walkCtx_->colNames);
+
+  SubPlan subPlan;
+  subPlan.root = walk;
+  subPlan.tail = startPlan.tail == nullptr ? walk : startPlan.tail;
+  return subPlan;
+}
+
+}  //  namespace graph
+}  //  namespace nebula
@@ -67,6 +67,12 @@ std::unique_ptr<PlanNodeDescription> ShowParts::explain() const {
   return desc;
 }
 
+std::unique_ptr<PlanNodeDescription> ShowHotParts::explain() const {
+  auto desc = SingleDependencyNode::explain();
+  addDescription("spaceId", folly::toJson(util::toJson(spaceId_)), desc.get());
+  return desc;
+}
+
 std::unique_ptr<PlanNodeDescription> ShowConfigs::explain() const {
   auto desc = SingleDependencyNode::explain();
   addDescription("module", apache::thrift::util::enumNameSafe(module_), desc.get());
@@ -899,6 +899,26 @@ class ShowParts final : public SingleDependencyNode {
   std::vector<PartitionID> partIds_;
 };
 
+class ShowHotParts final : public SingleDependencyNode {
+ public:
+  static ShowHotParts* make(QueryContext* qctx, PlanNode* input, GraphSpaceID spaceId) {
+    return qctx->objPool()->makeAndAdd<ShowHotParts>(qctx, input, spaceId);
+  }
+
+  std::unique_ptr<PlanNodeDescription> explain() const override;
+
+  GraphSpaceID getSpaceId() const {
+    return spaceId_;
+  }
+
+ private:
+  friend ObjectPool;
+  ShowHotParts(QueryContext* qctx, PlanNode* input, GraphSpaceID spaceId)
+      : SingleDependencyNode(qctx, Kind::kShowHotParts, input), spaceId_(spaceId) {}
+
+  GraphSpaceID spaceId_{-1};
+};
+
 class SubmitJob final : public SingleDependencyNode {
  public:
   static SubmitJob* make(QueryContext* qctx,
@@ -115,6 +115,9 @@ std::unique_ptr<PlanNodeDescription> ShortestPath::explain() const {
       "vertexProps", vertexProps_ ? folly::toJson(util::toJson(*vertexProps_)) : "", desc.get());
   addDescription(
       "edgeProps", edgeProps_ ? folly::toJson(util::toJson(*edgeProps_)) : "", desc.get());
+  if (!weightProp_.empty()) {
+    addDescription("weightProp", weightProp_, desc.get());
+  }
   return desc;
 }
 
@@ -128,6 +131,7 @@ void ShortestPath::cloneMembers(const ShortestPath& path) {
   SingleInputNode::cloneMembers(path);
   setStepRange(path.range_);
   setEdgeDirection(path.edgeDirection_);
+  setWeightProp(path.weightProp_);
   if (path.vertexProps_) {
     auto vertexProps = *path.vertexProps_;
     auto vertexPropsPtr = std::make_unique<decltype(vertexProps)>(vertexProps);
@@ -189,5 +193,32 @@ std::unique_ptr<PlanNodeDescription> Subgraph::explain() const {
   return desc;
 }
 
+PlanNode* RandomWalk::clone() const {
+  auto* walk = RandomWalk::make(qctx_, nullptr, space_, src_->clone(), steps_, walks_);
+  walk->cloneMembers(*this);
+  return walk;
+}
+
+void RandomWalk::cloneMembers(const RandomWalk& walk) {
+  SingleInputNode::cloneMembers(walk);
+  setBias(walk.p_, walk.q_);
+  if (walk.edgeProps_) {
+    auto edgeProps = *walk.edgeProps_;
+    setEdgeProps(std::make_unique<decltype(edgeProps)>(std::move(edgeProps)));
+  }
+}
+
+std::unique_ptr<PlanNodeDescription> RandomWalk::explain() const {
+  auto desc = SingleInputNode::explain();
+  addDescription("src", src_ ? src_->toString() : "", desc.get());
+  addDescription("steps", folly::toJson(util::toJson(steps_)), desc.get());
+  addDescription("walks", folly::toJson(util::toJson(walks_)), desc.get());
+  addDescription("p", folly::to<std::string>(p_), desc.get());
+  addDescription("q", folly::to<std::string>(q_), desc.get());
+  addDescription(
+      "edgeProps", edgeProps_ ? folly::toJson(util::toJson(*edgeProps_)) : "", desc.get());
+  return desc;
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -325,6 +325,11 @@ class ShortestPath final : public SingleInputNode {
     return singleShortest_;
   }
 
+  // The edge property as the weight of the path, empty for the number of steps
+  const std::string& weightProp() const {
+    return weightProp_;
+  }
+
   void setStepRange(const MatchStepRange& range) {
     range_ = range;
   }
@@ -345,6 +350,10 @@ class ShortestPath final : public SingleInputNode {
     reverseEdgeProps_ = std::move(reverseEdgeProps);
   }
 
+  void setWeightProp(std::string prop) {
+    weightProp_ = std::move(prop);
+  }
+
  private:
   friend ObjectPool;
   ShortestPath(QueryContext* qctx, PlanNode* node, GraphSpaceID space, bool singleShortest)
@@ -362,6 +371,7 @@ class ShortestPath final : public SingleInputNode {
   std::unique_ptr<std::vector<EdgeProp>> reverseEdgeProps_;
   std::unique_ptr<std::vector<VertexProp>> vertexProps_;
   storage::cpp2::EdgeDirection edgeDirection_{Direction::OUT_EDGE};
+  std::string weightProp_;
 };
 
 class CartesianProduct final : public SingleDependencyNode {
@@ -490,6 +500,92 @@ class Subgraph final : public SingleInputNode {
   std::unique_ptr<std::vector<EdgeProp>> edgeProps_;
 };
 
+// Random walks of steps from each vertex of src, one row of the LIST of the vids per walk. The
+// next vertex is sampled from the neighbors of the current one, biased like node2vec by the return
+// parameter p and the in-out parameter q.
+class RandomWalk final : public SingleInputNode {
+ public:
+  static RandomWalk* make(QueryContext* qctx,
+                          PlanNode* input,
+                          GraphSpaceID space,
+                          Expression* src,
+                          size_t steps,
+                          size_t walks) {
+    return qctx->objPool()->makeAndAdd<RandomWalk>(
+        qctx, input, space, DCHECK_NOTNULL(src), steps, walks);
+  }
+
+  GraphSpaceID space() const {
+    return space_;
+  }
+
+  Expression* src() const {
+    return src_;
+  }
+
+  size_t steps() const {
+    return steps_;
+  }
+
+  size_t walks() const {
+    return walks_;
+  }
+
+  double p() const {
+    return p_;
+  }
+
+  double q() const {
+    return q_;
+  }
+
+  // A uniform walk, the neighbors are sampled in storage
+  bool unbiased() const {
+    return p_ == 1.0 && q_ == 1.0;
+  }
+
+  const std::vector<EdgeProp>* edgeProps() const {
+    return edgeProps_.get();
+  }
+
+  void setBias(double p, double q) {
+    p_ = p;
+    q_ = q;
+  }
+
+  void setEdgeProps(std::unique_ptr<std::vector<EdgeProp>> edgeProps) {
+    edgeProps_ = std::move(edgeProps);
+  }
+
+  PlanNode* clone() const override;
+
+  std::unique_ptr<PlanNodeDescription> explain() const override;
+
+ private:
+  friend ObjectPool;
+  RandomWalk(QueryContext* qctx,
+             PlanNode* input,
+             GraphSpaceID space,
+             Expression* src,
+             size_t steps,
+             size_t walks)
+      : SingleInputNode(qctx, Kind::kRandomWalk, input),
+        space_(space),
+        src_(src),
+        steps_(steps),
+        walks_(walks) {}
+
+  void cloneMembers(const RandomWalk&);
+
+  GraphSpaceID space_;
+  Expression* src_{nullptr};
+  size_t steps_{1};
+  size_t walks_{1};
+  double p_{1.0};
+  double q_{1.0};
+  std::unique_ptr<std::vector<EdgeProp>> edgeProps_;
+};
+
 }  // namespace graph
 }  // namespace nebula
 #endif  // GRAPH_PLANNER_PLAN_ALGO_H_
@@ -6,6 +6,7 @@
 #include "graph/planner/plan/ExecutionPlan.h"
 
 #include "common/graph/Response.h"
+#include "common/memory/MemoryTracker.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/planner/plan/Query.h"
@@ -26,6 +27,13 @@ void SubPlan::appendStartNode(QueryContext* qctx) {
 
 ExecutionPlan::ExecutionPlan(PlanNode* root) : id_(EPIdGenerator::instance().id()), root_(root) {}
 
+void ExecutionPlan::renewId() {
+  id_ = EPIdGenerator::instance().id();
+  std::lock_guard<std::mutex> guard(statsLock_);
+  nodeRows_.clear();
+  memoryPeak_ = 0;
+}
+
 ExecutionPlan::~ExecutionPlan() {}
 
 uint64_t ExecutionPlan::makePlanNodeDesc(const PlanNode* node) {
@@ -83,6 +91,12 @@ void ExecutionPlan::describe(PlanDescription* planDesc) {
 }
 
 void ExecutionPlan::addProfileStats(int64_t planNodeId, ProfilingStats&& profilingStats) {
+  {
+    auto used = memory::MemoryStats::instance().used();
+    std::lock_guard<std::mutex> guard(statsLock_);
+    nodeRows_[planNodeId] += profilingStats.rows;
+    memoryPeak_ = std::max(memoryPeak_, used);
+  }
   // return directly if not enable profile
   if (!planDescription_) return;
 
@@ -93,5 +107,15 @@ void ExecutionPlan::addProfileStats(int64_t planNodeId, ProfilingStats&& profili
   planNodeDesc.profiles->emplace_back(std::move(profilingStats));
 }
 
+std::unordered_map<int64_t, uint64_t> ExecutionPlan::nodeRows() const {
+  std::lock_guard<std::mutex> guard(statsLock_);
+  return nodeRows_;
+}
+
+int64_t ExecutionPlan::memoryPeak() const {
+  std::lock_guard<std::mutex> guard(statsLock_);
+  return memoryPeak_;
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -7,7 +7,9 @@
 #define GRAPH_PLANNER_PLAN_EXECUTIONPLAN_H_
 
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace nebula {
 
@@ -38,6 +40,9 @@ class ExecutionPlan final {
     return id_;
   }
 
+  // A cached plan runs as a new query each time, so it takes a new id
+  void renewId();
+
   void setRoot(PlanNode* root) {
     root_ = root;
   }
@@ -52,6 +57,13 @@ class ExecutionPlan final {
 
   void addProfileStats(int64_t planNodeId, ProfilingStats&& profilingStats);
 
+  // The rows output by each plan node in the run, summed over the runs of the loops, kept even if
+  // the plan is not profiled
+  std::unordered_map<int64_t, uint64_t> nodeRows() const;
+
+  // The peak of the memory used by graphd sampled as the executors finish in the run
+  int64_t memoryPeak() const;
+
   void describe(PlanDescription* planDesc);
 
   void setExplainFormat(const std::string& format) {
@@ -73,6 +85,10 @@ class ExecutionPlan final {
   // plan description for explain and profile query
   PlanDescription* planDescription_{nullptr};
   std::string explainFormat_;
+
+  mutable std::mutex statsLock_;
+  std::unordered_map<int64_t, uint64_t> nodeRows_;
+  int64_t memoryPeak_{0};
 };
 
 }  // namespace graph
@@ -53,6 +53,11 @@ class InsertVertices final : public SingleDependencyNode {
     return ignoreExistedIndex_;
   }
 
+  // Append the vertices of the insert after this one, of the same tags, props and flags
+  void appendVertices(const std::vector<storage::cpp2::NewVertex>& vertices) {
+    vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+  }
+
  private:
   friend ObjectPool;
   InsertVertices(QueryContext* qctx,
@@ -123,6 +128,11 @@ class InsertEdges final : public SingleDependencyNode {
     return useChainInsert_;
   }
 
+  // Append the edges of the insert after this one, of the same props and flags
+  void appendEdges(const std::vector<storage::cpp2::NewEdge>& edges) {
+    edges_.insert(edges_.end(), edges.begin(), edges.end());
+  }
+
  private:
   friend ObjectPool;
   InsertEdges(QueryContext* qctx,
@@ -225,6 +225,8 @@ const char* PlanNode::toString(PlanNode::Kind kind) {
       return "ShowMetaLeader";
     case Kind::kShowParts:
       return "ShowParts";
+    case Kind::kShowHotParts:
+      return "ShowHotParts";
     case Kind::kShowCharset:
       return "ShowCharset";
     case Kind::kShowCollation:
@@ -245,6 +247,8 @@ const char* PlanNode::toString(PlanNode::Kind kind) {
       return "CartesianProduct";
     case Kind::kSubgraph:
       return "Subgraph";
+    case Kind::kRandomWalk:
+      return "RandomWalk";
     case Kind::kAddHosts:
       return "AddHosts";
     case Kind::kDropHosts:
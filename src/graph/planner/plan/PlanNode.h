@@ -68,6 +68,7 @@ class PlanNode {
     kAllPaths,
     kCartesianProduct,
     kSubgraph,
+    kRandomWalk,
     kDataCollect,
     kInnerJoin,
     kHashLeftJoin,
@@ -152,6 +153,7 @@ class PlanNode {
 
     // Show
     kShowParts,
+    kShowHotParts,
     kShowCharset,
     kShowCollation,
     kShowStats,
@@ -40,6 +40,11 @@ std::unique_ptr<PlanNodeDescription> Explore::explain() const {
   addDescription("limit", limit_ ? limit_->toString() : "", desc.get());
   addDescription("filter", filter_ ? filter_->toString() : "", desc.get());
   addDescription("orderBy", folly::toJson(util::toJson(orderBy_)), desc.get());
+  if (runtimeFilterKey_ != nullptr) {
+    addDescription("runtimeFilter",
+                   folly::sformat("{} of {}", runtimeFilterKey_->toString(), runtimeFilterVar_),
+                   desc.get());
+  }
   return desc;
 }
 
@@ -51,6 +56,8 @@ void Explore::cloneMembers(const Explore& e) {
   limit_ = e.limit_;
   filter_ = e.filter_;
   orderBy_ = e.orderBy_;
+  runtimeFilterVar_ = e.runtimeFilterVar_;
+  runtimeFilterKey_ = e.runtimeFilterKey_;
 }
 
 std::unique_ptr<PlanNodeDescription> GetNeighbors::explain() const {
@@ -66,6 +73,7 @@ std::unique_ptr<PlanNodeDescription> GetNeighbors::explain() const {
       "statProps", statProps_ ? folly::toJson(util::toJson(*statProps_)) : "", desc.get());
   addDescription("exprs", exprs_ ? folly::toJson(util::toJson(*exprs_)) : "", desc.get());
   addDescription("random", folly::toJson(util::toJson(random_)), desc.get());
+  addDescription("statsOnly", folly::toJson(util::toJson(statsOnly_)), desc.get());
   return desc;
 }
 
@@ -82,6 +90,7 @@ void GetNeighbors::cloneMembers(const GetNeighbors& g) {
   setEdgeTypes(g.edgeTypes_);
   setEdgeDirection(g.edgeDirection_);
   setRandom(g.random_);
+  setStatsOnly(g.statsOnly_);
   if (g.vertexProps_) {
     auto vertexProps = *g.vertexProps_;
     auto vertexPropsPtr = std::make_unique<decltype(vertexProps)>(vertexProps);
@@ -163,6 +172,9 @@ std::unique_ptr<PlanNodeDescription> ExpandAll::explain() const {
     }
     addDescription("edgeColumns", folly::toJson(edgeColumns), desc.get());
   }
+  if (dstVertexProps_) {
+    addDescription("dstVertexProps", folly::toJson(util::toJson(*dstVertexProps_)), desc.get());
+  }
   return desc;
 }
 
@@ -192,6 +204,10 @@ void ExpandAll::cloneMembers(const ExpandAll& expandAll) {
       edgeColumns_->addColumn(col->clone().release());
     }
   }
+  if (expandAll.dstVertexProps()) {
+    auto dstVertexProps = std::make_unique<std::vector<VertexProp>>(*expandAll.dstVertexProps());
+    setDstVertices(std::move(dstVertexProps), expandAll.dstVerticesVar());
+  }
 }
 
 std::unique_ptr<PlanNodeDescription> GetVertices::explain() const {
@@ -199,6 +215,9 @@ std::unique_ptr<PlanNodeDescription> GetVertices::explain() const {
   addDescription("src", src_ ? src_->toString() : "", desc.get());
   addDescription("props", props_ ? folly::toJson(util::toJson(*props_)) : "", desc.get());
   addDescription("exprs", exprs_ ? folly::toJson(util::toJson(*exprs_)) : "", desc.get());
+  if (!prefetchedVar_.empty()) {
+    addDescription("prefetchedVar", prefetchedVar_, desc.get());
+  }
   return desc;
 }
 
@@ -224,6 +243,7 @@ void GetVertices::cloneMembers(const GetVertices& gv) {
     auto exprsPtr = std::make_unique<decltype(exprs)>(std::move(exprs));
     setExprs(std::move(exprsPtr));
   }
+  prefetchedVar_ = gv.prefetchedVar_;
 }
 
 std::unique_ptr<PlanNodeDescription> GetEdges::explain() const {
@@ -842,6 +862,9 @@ void Traverse::cloneMembers(const Traverse& g) {
     setTagFilter(g.tagFilter_->clone());
   }
   genPath_ = g.genPath();
+  if (g.closingVid_ != nullptr) {
+    setClosingVid(g.closingVid_->clone());
+  }
 }
 
 std::unique_ptr<PlanNodeDescription> Traverse::explain() const {
@@ -854,6 +877,9 @@ std::unique_ptr<PlanNodeDescription> Traverse::explain() const {
                  firstStepFilter_ != nullptr ? firstStepFilter_->toString() : "",
                  desc.get());
   addDescription("tag filter", tagFilter_ != nullptr ? tagFilter_->toString() : "", desc.get());
+  if (closingVid_ != nullptr) {
+    addDescription("closing vid", closingVid_->toString(), desc.get());
+  }
   return desc;
 }
 
@@ -969,7 +995,11 @@ void HashInnerJoin::cloneMembers(const HashInnerJoin& l) {
 }
 
 std::unique_ptr<PlanNodeDescription> CrossJoin::explain() const {
-  return BinaryInputNode::explain();
+  auto desc = BinaryInputNode::explain();
+  if (filter_ != nullptr) {
+    addDescription("filter", filter_->toString(), desc.get());
+  }
+  return desc;
 }
 
 PlanNode* CrossJoin::clone() const {
@@ -980,6 +1010,7 @@ PlanNode* CrossJoin::clone() const {
 
 void CrossJoin::cloneMembers(const CrossJoin& r) {
   BinaryInputNode::cloneMembers(r);
+  filter_ = r.filter_ != nullptr ? r.filter_->clone() : nullptr;
 }
 
 CrossJoin::CrossJoin(QueryContext* qctx, PlanNode* left, PlanNode* right)
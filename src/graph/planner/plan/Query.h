@@ -85,6 +85,22 @@ class Explore : public SingleInputNode {
     orderBy_ = std::move(orderBy);
   }
 
+  // The variable of the build side of the join on the vertices explored, the vertices not
+  // matching any key of it are filtered out in storage, see RuntimeFilterPushdown
+  const std::string& runtimeFilterVar() const {
+    return runtimeFilterVar_;
+  }
+
+  // The key of the join evaluated on the rows of runtimeFilterVar
+  Expression* runtimeFilterKey() const {
+    return runtimeFilterKey_;
+  }
+
+  void setRuntimeFilter(std::string var, Expression* key) {
+    runtimeFilterVar_ = std::move(var);
+    runtimeFilterKey_ = key;
+  }
+
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
  protected:
@@ -131,6 +147,8 @@ class Explore : public SingleInputNode {
   Expression* limit_{nullptr};
   Expression* filter_{nullptr};
   std::vector<storage::cpp2::OrderBy> orderBy_;
+  std::string runtimeFilterVar_;
+  Expression* runtimeFilterKey_{nullptr};
 };
 
 using VertexProp = nebula::storage::cpp2::VertexProp;
@@ -209,6 +227,11 @@ class GetNeighbors : public Explore {
     return random_;
   }
 
+  // Only the stats of each vertex are returned, one row per vertex having any edge
+  bool statsOnly() const {
+    return statsOnly_;
+  }
+
   void setSrc(Expression* src) {
     src_ = src;
   }
@@ -241,6 +264,10 @@ class GetNeighbors : public Explore {
     random_ = random;
   }
 
+  void setStatsOnly(bool statsOnly = false) {
+    statsOnly_ = statsOnly;
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -262,6 +289,7 @@ class GetNeighbors : public Explore {
   std::unique_ptr<std::vector<StatProp>> statProps_;
   std::unique_ptr<std::vector<Expr>> exprs_;
   bool random_{false};
+  bool statsOnly_{false};
 };
 
 class Expand : public Explore {
@@ -386,10 +414,33 @@ class ExpandAll : public Expand {
     return edgeColumns_;
   }
 
+  void setVertexColumns(YieldColumns* vertexColumns) {
+    vertexColumns_ = vertexColumns;
+  }
+
+  void setEdgeColumns(YieldColumns* edgeColumns) {
+    edgeColumns_ = edgeColumns;
+  }
+
   void setVertexProps(std::unique_ptr<std::vector<VertexProp>> vertexProps) {
     vertexProps_ = std::move(vertexProps);
   }
 
+  // The props of the dsts returned along with the neighbors by the storaged leading them
+  const std::vector<VertexProp>* dstVertexProps() const {
+    return dstVertexProps_.get();
+  }
+
+  // The variable the dst vertices returned are kept in, in the layout of GetVertices
+  const std::string& dstVerticesVar() const {
+    return dstVerticesVar_;
+  }
+
+  void setDstVertices(std::unique_ptr<std::vector<VertexProp>> dstVertexProps, std::string var) {
+    dstVertexProps_ = std::move(dstVertexProps);
+    dstVerticesVar_ = std::move(var);
+  }
+
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
   PlanNode* clone() const override;
@@ -433,6 +484,8 @@ class ExpandAll : public Expand {
   std::unique_ptr<std::vector<VertexProp>> vertexProps_{nullptr};
   YieldColumns* vertexColumns_{nullptr};
   YieldColumns* edgeColumns_{nullptr};
+  std::unique_ptr<std::vector<VertexProp>> dstVertexProps_{nullptr};
+  std::string dstVerticesVar_;
 };
 
 // Get property with given vertex keys.
@@ -507,6 +560,16 @@ class GetVertices : public Explore {
     exprs_ = std::move(exprs);
   }
 
+  // The variable of the vertices got already, e.g. by ExpandAll along with the neighbors, which
+  // are not fetched again
+  const std::string& prefetchedVar() const {
+    return prefetchedVar_;
+  }
+
+  void setPrefetchedVar(std::string var) {
+    prefetchedVar_ = std::move(var);
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -537,6 +600,7 @@ class GetVertices : public Explore {
   std::unique_ptr<std::vector<VertexProp>> props_;
   // expression to get
   std::unique_ptr<std::vector<Expr>> exprs_;
+  std::string prefetchedVar_;
 };
 
 // Get property with given edge keys.
@@ -1766,6 +1830,16 @@ class Traverse final : public GetNeighbors {
     tagFilter_ = tagFilter;
   }
 
+  // The vid the dst must be, evaluated on the previous path, if the step closes a cycle of the
+  // pattern, e.g. the last step of (a)-->(b)-->(c)-->(a)
+  Expression* closingVid() const {
+    return closingVid_;
+  }
+
+  void setClosingVid(Expression* closingVid) {
+    closingVid_ = closingVid;
+  }
+
  private:
   friend ObjectPool;
   Traverse(QueryContext* qctx, PlanNode* input, GraphSpaceID space)
@@ -1784,6 +1858,7 @@ class Traverse final : public GetNeighbors {
   Expression* firstStepFilter_{nullptr};
   Expression* tagFilter_{nullptr};
   bool genPath_{false};
+  Expression* closingVid_{nullptr};
 };
 
 // Append vertices to a path.
@@ -1942,6 +2017,15 @@ class CrossJoin final : public BinaryInputNode {
     return qctx->objPool()->makeAndAdd<CrossJoin>(qctx, left, right);
   }
 
+  // The condition of the Filter above embedded, so only the rows meeting it are produced
+  Expression* filter() const {
+    return filter_;
+  }
+
+  void setFilter(Expression* filter) {
+    filter_ = filter;
+  }
+
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
   PlanNode* clone() const override;
@@ -1961,6 +2045,8 @@ class CrossJoin final : public BinaryInputNode {
   CrossJoin(QueryContext* qctx, PlanNode* left, PlanNode* right);
   // use for clone
   explicit CrossJoin(QueryContext* qctx);
+
+  Expression* filter_{nullptr};
 };
 
 // Roll Up Apply two results from two inputs.
@@ -5,6 +5,9 @@
 
 #include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
 
+#include "common/tracing/Tracing.h"
+#include "graph/planner/plan/Query.h"
+
 DECLARE_bool(enable_lifetime_optimize);
 
 namespace nebula {
@@ -81,6 +84,17 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::doSchedule(Executor* root) c
         promises.emplace_back(std::move(p));
       }
     }
+    // The vertices filtered at runtime by the keys of the build side of the join wait for it
+    const auto& runtimeFilterVar = runtimeFilterVarOf(exe->node());
+    if (!runtimeFilterVar.empty()) {
+      const auto& writtenBy = qctx_->symTable()->getVar(runtimeFilterVar)->writtenBy;
+      for (auto& node : writtenBy) {
+        folly::Promise<Status> p;
+        futures.emplace_back(p.getFuture());
+        auto& promises = promiseMap[node->id()];
+        promises.emplace_back(std::move(p));
+      }
+    }
   }
 
   while (!queue2.empty()) {
@@ -124,6 +138,21 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::doSchedule(Executor* root) c
   return resultFuture;
 }
 
+/*static*/ const std::string& AsyncMsgNotifyBasedScheduler::runtimeFilterVarOf(
+    const PlanNode* node) {
+  static const std::string kNone;
+  switch (node->kind()) {
+    case PlanNode::Kind::kScanVertices:
+    case PlanNode::Kind::kIndexScan:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kTagIndexRangeScan:
+      return static_cast<const Explore*>(node)->runtimeFilterVar();
+    default:
+      return kNone;
+  }
+}
+
 folly::Future<Status> AsyncMsgNotifyBasedScheduler::scheduleExecutor(
     std::vector<folly::Future<Status>>&& futures, Executor* exe, folly::Executor* runner) const {
   switch (exe->node()->kind()) {
@@ -244,19 +273,28 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::execute(Executor* executor)
     return executor->error(std::move(status));
   }
 
-  auto exeStatus = runExecute(executor);
+  // The storage rpcs of the executor are traced as the children of it
+  auto span = tracing::Span::child(executor->name());
+  folly::Future<Status> exeStatus = Status::OK();
+  {
+    tracing::SpanScope traceScope(span);
+    exeStatus = runExecute(executor);
+  }
 
-  return std::move(exeStatus).thenValue([this, executor](Status s) {
-    if (!s.ok()) {
-      DLOG(INFO) << formatPrettyId(executor) << " failed with: " << s.toString();
-      setFailStatus(s);
-      removeExecuting(executor);
-      return Status::from(s);
-    }
-    auto ret = executor->close();
-    removeExecuting(executor);
-    return ret;
-  });
+  return std::move(exeStatus).thenValue(
+      [this, executor, span = std::move(span)](Status s) mutable {
+        if (!s.ok()) {
+          DLOG(INFO) << formatPrettyId(executor) << " failed with: " << s.toString();
+          span.setError(s.toString());
+          setFailStatus(s);
+          removeExecuting(executor);
+          return Status::from(s);
+        }
+        auto ret = executor->close();
+        span.end();
+        removeExecuting(executor);
+        return ret;
+      });
 }
 
 folly::Future<Status> AsyncMsgNotifyBasedScheduler::runExecute(Executor* executor) const {
@@ -266,6 +304,10 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::runExecute(Executor* executo
     if (hasFailStatus()) return failedStatus_.value();
     folly::Future<Status> status = Status::OK();
     {
+      // The memory of the executor, including the futures it starts, is attributed to it
+      folly::ShallowCopyRequestContextScopeGuard memoryGuard(
+          memory::MemoryTrackerData::token(),
+          std::make_unique<memory::MemoryTrackerData>(executor->memoryTracker()));
       memory::MemoryCheckGuard guard;
       status = executor->execute();
     }
@@ -32,6 +32,9 @@ class AsyncMsgNotifyBasedScheduler final : public Scheduler {
  private:
   folly::Future<Status> doSchedule(Executor* root) const;
 
+  // The variable of the build side of the runtime filter of node, empty if there is none
+  static const std::string& runtimeFilterVarOf(const PlanNode* node);
+
   /**
    * futures: current executor will be triggered when all the futures are
    * notified. exe: current executor runner: a thread-pool promises: the
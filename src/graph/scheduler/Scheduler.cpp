@@ -5,6 +5,7 @@
 
 #include "graph/scheduler/Scheduler.h"
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
 
@@ -40,6 +41,10 @@ namespace graph {
     if (!visited.emplace(currentNode).second) {
       continue;
     }
+    if (currentNode->outputVarPtr() != nullptr) {
+      currentNode->outputVarPtr()->latestOnly =
+          currentLoopLayers != 0 && readLatestOnly(currentNode);
+    }
 
     for (auto dep : currentNode->dependencies()) {
       stack.push(std::make_tuple(dep, currentLoopLayers));
@@ -69,5 +74,32 @@ namespace graph {
   }
 }
 
+/*static*/ bool Scheduler::readLatestOnly(const PlanNode* node) {
+  // The subgraph reads the versions of its own output
+  if (node->kind() == PlanNode::Kind::kSubgraph || node->kind() == PlanNode::Kind::kLoop ||
+      node->kind() == PlanNode::Kind::kSelect) {
+    return false;
+  }
+  const auto* var = node->outputVarPtr();
+  // The variables of the users may be read by the other sentences
+  if (var->name.compare(0, 2, "__") != 0) {
+    return false;
+  }
+  // The readers of the history or of the versions given
+  return std::none_of(var->readBy.begin(), var->readBy.end(), [](const PlanNode* reader) {
+    switch (reader->kind()) {
+      case PlanNode::Kind::kDataCollect:
+      case PlanNode::Kind::kUnionAllVersionVar:
+      case PlanNode::Kind::kInnerJoin:
+      case PlanNode::Kind::kHashLeftJoin:
+      case PlanNode::Kind::kHashInnerJoin:
+      case PlanNode::Kind::kCrossJoin:
+        return true;
+      default:
+        return false;
+    }
+  });
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -26,6 +26,10 @@ class Scheduler : private boost::noncopyable, private cpp::NonMovable {
 
   static void analyzeLifetime(const PlanNode *node, std::size_t loopLayers = 0);
 
+ private:
+  // Whether the readers of the output of node in a loop only read the latest version of it
+  static bool readLatestOnly(const PlanNode *node);
+
  protected:
   // use by debugger to check query which crash in runtime
   std::string query_;
@@ -0,0 +1,98 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/AdmissionController.h"
+
+#include "common/memory/MemoryTracker.h"
+#include "common/stats/StatsManager.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/session/ClientSession.h"
+#include "graph/stats/GraphStats.h"
+
+namespace nebula {
+namespace graph {
+
+/*static*/ AdmissionController& AdmissionController::instance() {
+  static AdmissionController controller;
+  return controller;
+}
+
+/*static*/ bool AdmissionController::enabled() {
+  return FLAGS_max_running_analytic_queries > 0 || FLAGS_analytic_query_memory_budget_mb > 0;
+}
+
+/*static*/ std::string AdmissionController::groupOf(const ClientSession* session) {
+  if (FLAGS_admission_group == "user") {
+    return "user:" + session->user();
+  }
+  return "space:" + session->spaceName();
+}
+
+/*static*/ bool AdmissionController::canRun(const Group& group, int64_t memory) {
+  if (group.running == 0) {
+    return true;
+  }
+  if (FLAGS_max_running_analytic_queries > 0 &&
+      group.running >= FLAGS_max_running_analytic_queries) {
+    return false;
+  }
+  auto budget = static_cast<int64_t>(FLAGS_analytic_query_memory_budget_mb) * memory::MiB;
+  return budget == 0 || group.memory + memory <= budget;
+}
+
+StatusOr<bool> AdmissionController::admit(const std::string& group,
+                                          int64_t memory,
+                                          folly::Function<void()> run) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto& entry = groups_[group];
+  if (entry.waiting.empty() && canRun(entry, memory)) {
+    entry.running++;
+    entry.memory += memory;
+    return true;
+  }
+  if (entry.waiting.size() >= FLAGS_max_queued_analytic_queries) {
+    stats::StatsManager::addValue(kNumRejectedAnalyticQueries);
+    return Status::Error("Too many analytic queries are waiting in the resource group `%s'",
+                         group.c_str());
+  }
+  VLOG(1) << "An analytic query waits in the resource group " << group << " of "
+          << entry.running << " running";
+  stats::StatsManager::addValue(kNumQueuedAnalyticQueries);
+  entry.waiting.emplace_back(Waiting{memory, std::move(run)});
+  return false;
+}
+
+void AdmissionController::release(const std::string& group, int64_t memory) {
+  std::vector<folly::Function<void()>> runs;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto found = groups_.find(group);
+    if (found == groups_.end()) {
+      DLOG(FATAL) << "Release the unknown resource group " << group;
+      return;
+    }
+    auto& entry = found->second;
+    DCHECK_GT(entry.running, 0);
+    entry.running--;
+    entry.memory -= memory;
+    // In order, a waiting query is not passed by the ones of less memory behind it
+    while (!entry.waiting.empty() && canRun(entry, entry.waiting.front().memory)) {
+      auto& waiting = entry.waiting.front();
+      entry.running++;
+      entry.memory += waiting.memory;
+      runs.emplace_back(std::move(waiting.run));
+      entry.waiting.pop_front();
+    }
+    if (entry.running == 0 && entry.waiting.empty()) {
+      groups_.erase(found);
+    }
+  }
+  for (auto& run : runs) {
+    run();
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
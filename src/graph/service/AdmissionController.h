@@ -0,0 +1,80 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
+#define GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
+
+#include <folly/Function.h>
+
+#include <deque>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+
+namespace nebula {
+namespace graph {
+
+class ClientSession;
+
+/**
+ * AdmissionController keeps the analytic queries of a resource group, i.e. a space or a user,
+ * from starving the interactive ones on the shared worker threads.
+ *
+ * A query is analytic if the runs of its plan shape in the PlanStats are slow, see
+ * analytic_query_latency_ms. At most max_running_analytic_queries of a group run at the same
+ * time, and their memory estimated by the peaks of their shapes is within
+ * analytic_query_memory_budget_mb.
+ * The others wait in the queue of the group in order, and run once the running ones finish. A
+ * query runs anyway if none of its group is running, even beyond the budget. The interactive
+ * queries never wait.
+ */
+class AdmissionController final {
+ public:
+  static AdmissionController& instance();
+
+  // Whether any limit of the analytic queries is set
+  static bool enabled();
+
+  // The resource group of the queries of the session, by FLAGS_admission_group
+  static std::string groupOf(const ClientSession* session);
+
+  /**
+   * @brief Admit an analytic query of the group.
+   *
+   * @param memory The memory estimated of the query
+   * @param run Called once the query waiting is admitted, in the thread of the query finished
+   * @return true if the query is admitted to run now, false if it waits, and an error if the queue
+   * of the group is full
+   */
+  StatusOr<bool> admit(const std::string& group, int64_t memory, folly::Function<void()> run);
+
+  // Release an analytic query admitted, the waiting ones of the group are admitted if they could
+  void release(const std::string& group, int64_t memory);
+
+ private:
+  struct Waiting {
+    int64_t memory{0};
+    folly::Function<void()> run;
+  };
+
+  struct Group {
+    size_t running{0};
+    int64_t memory{0};
+    std::deque<Waiting> waiting;
+  };
+
+  AdmissionController() = default;
+
+  static bool canRun(const Group& group, int64_t memory);
+
+  std::mutex lock_;
+  std::unordered_map<std::string, Group> groups_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_ADMISSIONCONTROLLER_H_
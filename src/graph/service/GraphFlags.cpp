@@ -16,6 +16,14 @@ DEFINE_int32(
     session_reclaim_interval_secs,
     60,
     "Period we try to reclaim expired sessions and update session information to the meta server");
+DEFINE_int32(session_update_batch_size,
+             1024,
+             "The max number of the sessions updated to the meta server by an RPC");
+DEFINE_int32(session_full_update_rounds,
+             10,
+             "All the sessions are updated to the meta server once every the number of reclaim "
+             "intervals, to find the ones killed by the others. Otherwise only the sessions "
+             "changed or running queries are updated");
 DEFINE_int32(num_netio_threads,
              0,
              "The number of networking threads, 0 for number of physical CPU cores");
@@ -72,6 +80,18 @@ DEFINE_string(client_white_list,
 
 #endif
 
+DEFINE_bool(enable_compact_result,
+            true,
+            "Whether to return the data encoded in columns to the clients asking for it");
+
+DEFINE_int32(max_cursors_per_session,
+             8,
+             "The max cursors of the results kept for a session, the least recently fetched one is "
+             "closed for a new one");
+DEFINE_int32(cursor_idle_timeout_secs,
+             600,
+             "The number of seconds before the cursors of the results not fetched are closed");
+
 DEFINE_bool(accept_partial_success, false, "Whether to accept partial success, default false");
 
 DEFINE_bool(disable_octal_escape_char,
@@ -90,6 +110,9 @@ DEFINE_int32(max_sessions_per_ip_per_user,
 DEFINE_bool(optimize_appendvertices, false, "if true, return directly without go through RPC");
 
 DEFINE_uint32(num_path_thread, 10, "number of threads to build path");
+DEFINE_uint32(weighted_path_batch_size,
+              1000,
+              "max number of vertices expanded by one step of the weighted shortest path");
 
 // Sanity-checking Flag Values
 static bool ValidateSessIdleTimeout(const char* flagname, int32_t value) {
@@ -110,11 +133,133 @@ DEFINE_int32(min_batch_size,
              "The min batch size for handling dataset in multi job mode, only enabled when "
              "max_job_size is greater than 1.");
 DEFINE_int32(max_job_size, 1, "The max job size in multi job mode.");
+DEFINE_int32(morsel_size,
+             1024,
+             "The number of rows pulled at a time by a job in multi job mode until all are "
+             "handled, 0 means each job handles a batch of min_batch_size rows at least");
+
+DEFINE_int64(scan_batch_size,
+             100000,
+             "The max rows of each page when scanning the vertices or edges without limit, the "
+             "next page is scanned while the rows of the current page are merged. Scan all the "
+             "rows at once if it's not positive.");
+DEFINE_uint32(runtime_filter_max_values,
+              1024,
+              "The max keys of the build side of a join pushed down to the vertices scanned of "
+              "the probe side, only the range of the keys is pushed down beyond it if they're "
+              "integers");
 
 DEFINE_bool(enable_async_gc, false, "If enable async gc.");
 DEFINE_uint32(
     gc_worker_size,
     0,
     "Background garbage clean workers, default number is 0 which means using hardware core size.");
+DEFINE_uint32(gc_batch_rows,
+              10000,
+              "The rows of a batch a DataSet is split into, by which the gc workers release it");
+DEFINE_uint64(gc_max_pending_bytes,
+              2UL * 1024 * 1024 * 1024,
+              "The garbage is released by the caller if the bytes queued exceed it, "
+              "0 means unlimited");
 
 DEFINE_bool(graph_use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_bool(enable_follower_read,
+            false,
+            "Whether the reads of vertices and edges could be served by the storage followers not "
+            "far behind the leaders, which are bounded by follower_read_max_lag of storaged");
+
+DEFINE_bool(expand_steps_in_storage,
+            false,
+            "Whether GO expands the rest of its steps in storaged, the dsts led by the same host "
+            "are expanded in place and only the others come back to graphd. Requires storaged to "
+            "support multiple steps of GetDstBySrc");
+
+DEFINE_bool(join_dst_props_in_storage,
+            false,
+            "Whether GO gets the props of the dst vertices along with the neighbors, the dsts led "
+            "by the same host are joined in storaged and only the others are fetched by graphd. "
+            "Requires storaged to support the dst_vertex_props of GetNeighbors");
+
+DEFINE_uint32(max_random_walks, 1000, "The max number of random walks started from each vertex");
+
+DEFINE_uint32(plan_cache_capacity,
+              0,
+              "The max number of queries whose plans are cached, 0 means the plan cache is off");
+DEFINE_uint32(plan_cache_instances_per_query,
+              4,
+              "The max number of plans cached for the same query, each serves one run at a time");
+DEFINE_uint32(plan_cache_max_reuses,
+              100,
+              "A cached plan is dropped after it runs so many times, as each run allocates its "
+              "executors in the object pool of the plan");
+
+DEFINE_uint32(result_cache_capacity_mb,
+              0,
+              "The memory in MB the results of the read-only queries are cached in, so the same "
+              "query is answered without running until the space is written, 0 means the result "
+              "cache is off");
+DEFINE_uint32(result_cache_ttl_ms,
+              5000,
+              "How long in milliseconds a result is cached, which bounds how stale it could be "
+              "after the space is written by the other graphds");
+
+DEFINE_uint32(plan_stats_capacity,
+              1024,
+              "The max number of plan shapes whose stats are kept, see /plan_stats of the http "
+              "service, 0 means the plan stats are off");
+
+DEFINE_uint32(insert_batch_window_us,
+              0,
+              "The time in microseconds the inserts of the same space, props and flags wait to be "
+              "sent to storage in one batch, 0 means each insert is sent at once");
+DEFINE_uint32(insert_batch_max_rows,
+              1024,
+              "A batch of inserts is sent without waiting for the window once it has so many rows, "
+              "so are the consecutive insert statements of a query planned as one");
+
+DEFINE_uint32(query_memory_limit_mb,
+              0,
+              "The max memory in MiB a query could use, beyond which it fails with "
+              "E_GRAPH_MEMORY_EXCEEDED, 0 means unlimited. Only effective with the memory tracker");
+
+DEFINE_string(admission_group,
+              "space",
+              "The resource group of a query for the admission control, by its space or its user, "
+              "which is space or user");
+DEFINE_uint32(analytic_query_latency_ms,
+              1000,
+              "A query is analytic if the mean latency of its plan shape in the plan stats is at "
+              "least so many milliseconds, the others are interactive and never wait");
+DEFINE_uint32(max_running_analytic_queries,
+              0,
+              "The max number of the analytic queries running at the same time in a resource "
+              "group, beyond which they wait in the queue of the group, 0 means unlimited");
+DEFINE_uint32(analytic_query_memory_budget_mb,
+              0,
+              "The max memory in MiB of the analytic queries running at the same time in a "
+              "resource group, estimated by the memory peaks of their plan shapes, 0 means "
+              "unlimited");
+DEFINE_uint32(max_queued_analytic_queries,
+              1024,
+              "The max number of the analytic queries waiting in a resource group, beyond which "
+              "they fail");
+
+DEFINE_uint32(query_string_dict_capacity,
+              65536,
+              "The max number of the distinct strings interned for a query, so a string repeated "
+              "in the results from storage is kept once, 0 means no interning");
+DEFINE_uint32(query_string_dict_max_length,
+              64,
+              "The max length in bytes of a string interned for a query");
+
+DEFINE_uint32(ft_query_cache_ttl_ms,
+              0,
+              "How long in milliseconds the results of a fulltext query are cached, so the same "
+              "query is not sent to elasticsearch again meanwhile, 0 means no caching");
+DEFINE_uint32(ft_query_cache_capacity, 1024, "The max number of the fulltext queries cached");
+
+DEFINE_uint32(geo_covering_cache_capacity,
+              1024,
+              "The max number of the cell coverings of the geo index predicates cached, so the "
+              "same geography doesn't build its covering again, 0 means no caching");
@@ -12,6 +12,8 @@ DECLARE_int32(port);
 DECLARE_int32(client_idle_timeout_secs);
 DECLARE_int32(session_idle_timeout_secs);
 DECLARE_int32(session_reclaim_interval_secs);
+DECLARE_int32(session_update_batch_size);
+DECLARE_int32(session_full_update_rounds);
 DECLARE_int32(num_netio_threads);
 DECLARE_int32(num_accept_threads);
 DECLARE_uint32(num_max_connections);
@@ -55,6 +57,7 @@ DECLARE_uint32(password_lock_time_in_secs);
 DECLARE_bool(enable_optimizer);
 DECLARE_bool(optimize_appendvertice);
 DECLARE_uint32(num_path_thread);
+DECLARE_uint32(weighted_path_batch_size);
 
 DECLARE_int64(max_allowed_connections);
 
@@ -63,15 +66,60 @@ DECLARE_bool(enable_data_balance);
 
 DECLARE_bool(enable_client_white_list);
 DECLARE_string(client_white_list);
+DECLARE_bool(enable_compact_result);
+DECLARE_int32(max_cursors_per_session);
+DECLARE_int32(cursor_idle_timeout_secs);
 
 DECLARE_int32(num_rows_to_check_memory);
 
 DECLARE_int32(min_batch_size);
 DECLARE_int32(max_job_size);
+DECLARE_int32(morsel_size);
+
+DECLARE_int64(scan_batch_size);
+DECLARE_uint32(runtime_filter_max_values);
 
 DECLARE_bool(enable_async_gc);
 DECLARE_uint32(gc_worker_size);
+DECLARE_uint32(gc_batch_rows);
+DECLARE_uint64(gc_max_pending_bytes);
 
 DECLARE_bool(graph_use_vertex_key);
 
+DECLARE_bool(enable_follower_read);
+
+DECLARE_bool(expand_steps_in_storage);
+
+DECLARE_bool(join_dst_props_in_storage);
+
+DECLARE_uint32(max_random_walks);
+
+DECLARE_uint32(plan_cache_capacity);
+DECLARE_uint32(plan_cache_instances_per_query);
+DECLARE_uint32(plan_cache_max_reuses);
+
+DECLARE_uint32(result_cache_capacity_mb);
+DECLARE_uint32(result_cache_ttl_ms);
+
+DECLARE_uint32(plan_stats_capacity);
+
+DECLARE_uint32(insert_batch_window_us);
+DECLARE_uint32(insert_batch_max_rows);
+
+DECLARE_uint32(query_memory_limit_mb);
+
+DECLARE_string(admission_group);
+DECLARE_uint32(analytic_query_latency_ms);
+DECLARE_uint32(max_running_analytic_queries);
+DECLARE_uint32(analytic_query_memory_budget_mb);
+DECLARE_uint32(max_queued_analytic_queries);
+
+DECLARE_uint32(query_string_dict_capacity);
+DECLARE_uint32(query_string_dict_max_length);
+
+DECLARE_uint32(ft_query_cache_ttl_ms);
+DECLARE_uint32(ft_query_cache_capacity);
+
+DECLARE_uint32(geo_covering_cache_capacity);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "common/id/Snowflake.h"
+#include "common/thrift/ThreadManagerObserver.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/GraphService.h"
 namespace nebula {
@@ -29,6 +30,7 @@ bool GraphServer::start() {
       PriorityThreadManager::newPriorityThreadManager(numThreads));
   threadManager->setNamePrefix("executor");
   threadManager->start();
+  watchThreadManager("executor", threadManager);
 
   thriftServer_ = std::make_unique<apache::thrift::ThriftServer>();
   thriftServer_->setIOThreadPool(ioThreadPool);
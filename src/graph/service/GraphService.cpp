@@ -11,6 +11,7 @@
 
 #include "clients/storage/StorageClient.h"
 #include "common/base/Base.h"
+#include "common/graph/CompactDataSet.h"
 #include "common/memory/MemoryTracker.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
@@ -147,8 +148,17 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
     int64_t sessionId,
     const std::string& query,
     const std::unordered_map<std::string, Value>& parameterMap) {
+  return execute(sessionId, query, parameterMap, 1.0);
+}
+
+folly::Future<ExecutionResponse> GraphService::execute(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap,
+    double sampleRatio) {
   auto ctx = std::make_unique<RequestContext<ExecutionResponse>>();
   ctx->setQuery(query);
+  ctx->setSampleRatio(sampleRatio);
   ctx->setRunner(getThreadManager());
   ctx->setSessionMgr(sessionManager_.get());
   auto future = ctx->future();
@@ -203,6 +213,93 @@ folly::Future<ExecutionResponse> GraphService::future_execute(int64_t sessionId,
   return future_executeWithParameter(sessionId, query, std::unordered_map<std::string, Value>{});
 }
 
+folly::Future<ExecutionResponse> GraphService::future_executeWithOptions(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap,
+    const cpp2::ExecutionOptions& options) {
+  auto sampleRatio = options.sample_ratio_ref().value_or(1.0);
+  // The ratio out of (0, 1] samples nothing
+  if (!(sampleRatio > 0.0 && sampleRatio < 1.0)) {
+    sampleRatio = 1.0;
+  }
+  auto future = execute(sessionId, query, parameterMap, sampleRatio);
+  auto fetchSize = options.fetch_size_ref().value_or(0);
+  if (!isColumnar(options) && fetchSize <= 0) {
+    return future;
+  }
+  return std::move(future).thenValue(
+      [this, sessionId, fetchSize, options](ExecutionResponse&& resp) {
+        if (resp.data != nullptr && fetchSize > 0 &&
+            resp.data->rows.size() > static_cast<size_t>(fetchSize)) {
+          // The session is in the cache since the query was just run by it
+          auto session = sessionManager_->findSessionFromCache(sessionId);
+          if (session != nullptr) {
+            auto& rows = resp.data->rows;
+            ResultCursor cursor;
+            cursor.colNames = resp.data->colNames;
+            cursor.rows.insert(cursor.rows.end(),
+                               std::make_move_iterator(rows.begin() + fetchSize),
+                               std::make_move_iterator(rows.end()));
+            cursor.options = options;
+            rows.resize(fetchSize);
+            resp.cursorId = std::make_unique<int64_t>(session->addCursor(std::move(cursor)));
+          }
+        }
+        formatResult(&resp, options);
+        return std::move(resp);
+      });
+}
+
+folly::Future<ExecutionResponse> GraphService::future_fetchNext(int64_t sessionId,
+                                                               int64_t cursorId,
+                                                               int32_t fetchSize) {
+  time::Duration duration;
+  ExecutionResponse resp;
+  auto session = sessionManager_->findSessionFromCache(sessionId);
+  if (session == nullptr) {
+    resp.errorCode = ErrorCode::E_SESSION_INVALID;
+    resp.errorMsg = std::make_unique<std::string>(
+        folly::stringPrintf("SessionId[%ld] does not exist", sessionId));
+    return folly::makeFuture<ExecutionResponse>(std::move(resp));
+  }
+  session->charge();
+  auto chunk = session->fetchCursor(cursorId, std::max(fetchSize, 1));
+  if (!chunk.ok()) {
+    resp.errorCode = ErrorCode::E_EXECUTION_ERROR;
+    resp.errorMsg = std::make_unique<std::string>(chunk.status().toString());
+    return folly::makeFuture<ExecutionResponse>(std::move(resp));
+  }
+  resp.data = std::make_unique<DataSet>(std::move(chunk.value().data));
+  if (chunk.value().hasMore) {
+    resp.cursorId = std::make_unique<int64_t>(cursorId);
+  }
+  formatResult(&resp, chunk.value().options);
+  resp.latencyInUs = duration.elapsedInUSec();
+  return folly::makeFuture<ExecutionResponse>(std::move(resp));
+}
+
+void GraphService::closeCursor(int64_t sessionId, int64_t cursorId) {
+  auto session = sessionManager_->findSessionFromCache(sessionId);
+  if (session != nullptr) {
+    session->closeCursor(cursorId);
+  }
+}
+
+// static
+bool GraphService::isColumnar(const cpp2::ExecutionOptions& options) {
+  return FLAGS_enable_compact_result && options.get_result_format() == cpp2::ResultFormat::COLUMNAR;
+}
+
+// static
+void GraphService::formatResult(ExecutionResponse* resp, const cpp2::ExecutionOptions& options) {
+  if (resp->data != nullptr && isColumnar(options)) {
+    resp->compactData =
+        std::make_unique<std::string>(CompactDataSet::encode(*resp->data, options.get_compress()));
+    resp->data.reset();
+  }
+}
+
 folly::Future<std::string> GraphService::future_executeJson(int64_t sessionId,
                                                             const std::string& query) {
   return future_executeJsonWithParameter(
@@ -267,6 +364,11 @@ folly::Future<cpp2::VerifyClientVersionResp> GraphService::future_verifyClientVe
                                                req.get_version().c_str());
   } else {
     resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
+    std::vector<cpp2::ResultFormat> formats{cpp2::ResultFormat::ROWS};
+    if (FLAGS_enable_compact_result) {
+      formats.emplace_back(cpp2::ResultFormat::COLUMNAR);
+    }
+    resp.result_formats_ref() = std::move(formats);
   }
 
   return folly::makeFuture<cpp2::VerifyClientVersionResp>(std::move(resp));
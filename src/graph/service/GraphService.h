@@ -40,6 +40,18 @@ class GraphService final : public cpp2::GraphServiceSvIf {
   folly::Future<ExecutionResponse> future_execute(int64_t sessionId,
                                                   const std::string& stmt) override;
 
+  folly::Future<ExecutionResponse> future_executeWithOptions(
+      int64_t sessionId,
+      const std::string& stmt,
+      const std::unordered_map<std::string, Value>& parameterMap,
+      const cpp2::ExecutionOptions& options) override;
+
+  folly::Future<ExecutionResponse> future_fetchNext(int64_t sessionId,
+                                                   int64_t cursorId,
+                                                   int32_t fetchSize) override;
+
+  void closeCursor(int64_t sessionId, int64_t cursorId) override;
+
   folly::Future<std::string> future_executeJsonWithParameter(
       int64_t sessionId,
       const std::string& stmt,
@@ -56,6 +68,18 @@ class GraphService final : public cpp2::GraphServiceSvIf {
  private:
   Status auth(const std::string& username, const std::string& password);
 
+  // Run the query, with the ratio of the rows sampled by its scans and its traversals
+  folly::Future<ExecutionResponse> execute(
+      int64_t sessionId,
+      const std::string& query,
+      const std::unordered_map<std::string, Value>& parameterMap,
+      double sampleRatio);
+
+  static bool isColumnar(const cpp2::ExecutionOptions& options);
+
+  // Encode the data of the response in columns if the options ask for it
+  static void formatResult(ExecutionResponse* resp, const cpp2::ExecutionOptions& options);
+
   std::unique_ptr<GraphSessionManager> sessionManager_;
   std::unique_ptr<QueryEngine> queryEngine_;
 };
@@ -143,6 +143,7 @@ namespace graph {
     case Sentence::Kind::kFetchEdges:
     case Sentence::Kind::kFindPath:
     case Sentence::Kind::kGetSubgraph:
+    case Sentence::Kind::kRandomWalk:
     case Sentence::Kind::kLimit:
     case Sentence::Kind::kGroupBy:
     case Sentence::Kind::kUnwind:
@@ -150,6 +151,7 @@ namespace graph {
       return PermissionManager::canReadSchemaOrData(session, vctx);
     }
     case Sentence::Kind::kShowParts:
+    case Sentence::Kind::kShowHotParts:
     case Sentence::Kind::kShowTags:
     case Sentence::Kind::kShowEdges:
     case Sentence::Kind::kShowStats:
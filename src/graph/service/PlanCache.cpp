@@ -0,0 +1,126 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/PlanCache.h"
+
+#include "graph/service/GraphFlags.h"
+#include "parser/SequentialSentences.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+namespace graph {
+
+/*static*/ std::string PlanCache::keyOf(const RequestContext<ExecutionResponse>* rctx) {
+  auto session = rctx->session();
+  std::string key = folly::to<std::string>(session->space().id, '\0', session->user(), '\0');
+  // The parameters in the order of name
+  std::map<std::string, const Value*> params;
+  for (const auto& param : rctx->parameterMap()) {
+    params.emplace(param.first, &param.second);
+  }
+  for (const auto& param : params) {
+    folly::toAppend(param.first,
+                    '\0',
+                    static_cast<int64_t>(param.second->type()),
+                    '\0',
+                    param.second->toString(),
+                    '\0',
+                    &key);
+  }
+  key.append(rctx->query());
+  return key;
+}
+
+/*static*/ bool PlanCache::cacheable(const Sentence* sentence) {
+  switch (sentence->kind()) {
+    case Sentence::Kind::kGo:
+    case Sentence::Kind::kMatch:
+    case Sentence::Kind::kLookup:
+    case Sentence::Kind::kYield:
+    case Sentence::Kind::kOrderBy:
+    case Sentence::Kind::kFetchVertices:
+    case Sentence::Kind::kFetchEdges:
+    case Sentence::Kind::kFindPath:
+    case Sentence::Kind::kGetSubgraph:
+    case Sentence::Kind::kRandomWalk:
+    case Sentence::Kind::kLimit:
+    case Sentence::Kind::kGroupBy:
+    case Sentence::Kind::kUnwind:
+      return true;
+    case Sentence::Kind::kPipe: {
+      auto pipe = static_cast<const PipedSentence*>(sentence);
+      return cacheable(pipe->left()) && cacheable(pipe->right());
+    }
+    case Sentence::Kind::kAssignment:
+      return cacheable(static_cast<const AssignmentSentence*>(sentence)->sentence());
+    case Sentence::Kind::kSequential: {
+      for (auto s : static_cast<const SequentialSentences*>(sentence)->sentences()) {
+        if (!cacheable(s)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<PlanCache::Entry> PlanCache::get(const std::string& key, int64_t metaVersion) {
+  std::vector<std::unique_ptr<Entry>> stale;
+  std::unique_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto found = cache_.find(key);
+    if (found == cache_.end()) {
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, found->second.pos);
+    auto& entries = found->second.entries;
+    while (!entries.empty() && entry == nullptr) {
+      auto e = std::move(entries.back());
+      entries.pop_back();
+      if (e->metaVersion == metaVersion) {
+        entry = std::move(e);
+      } else {
+        stale.emplace_back(std::move(e));
+      }
+    }
+  }
+  // The stale entries are released out of the lock
+  return entry;
+}
+
+void PlanCache::put(const std::string& key, std::unique_ptr<Entry> entry) {
+  std::vector<std::unique_ptr<Entry>> evicted;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto found = cache_.find(key);
+    if (found == cache_.end()) {
+      lru_.push_front(key);
+      found = cache_.emplace(key, Entries{lru_.begin(), {}}).first;
+    } else {
+      lru_.splice(lru_.begin(), lru_, found->second.pos);
+    }
+    auto& entries = found->second.entries;
+    if (entries.size() < FLAGS_plan_cache_instances_per_query) {
+      entries.emplace_back(std::move(entry));
+    } else {
+      evicted.emplace_back(std::move(entry));
+    }
+    while (cache_.size() > capacity_) {
+      auto last = cache_.find(lru_.back());
+      DCHECK(last != cache_.end());
+      for (auto& e : last->second.entries) {
+        evicted.emplace_back(std::move(e));
+      }
+      cache_.erase(last);
+      lru_.pop_back();
+    }
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
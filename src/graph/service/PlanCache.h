@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_PLANCACHE_H_
+#define GRAPH_SERVICE_PLANCACHE_H_
+
+#include "common/base/Base.h"
+#include "graph/context/ExecutionContext.h"
+#include "graph/context/QueryContext.h"
+#include "graph/service/RequestContext.h"
+#include "parser/Sentence.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * PlanCache keeps the optimized plans of the read-only queries, so a query repeated skips the
+ * parser, the validator, the planner and the optimizer.
+ *
+ * A plan is not shared by the concurrent runs, as the executors write the results into the
+ * execution context of the plan. Each entry owns the whole query context of a plan, it's taken out
+ * of the cache to run and put back when the run succeeds, with the execution context restored to
+ * the snapshot taken before the first run. Each query keeps at most plan_cache_instances_per_query
+ * entries, and the queries least recently used are evicted beyond plan_cache_capacity.
+ *
+ * The parameters are folded into the plan by the validators, so the key is made of the space, the
+ * user, the parameters and the text of the query, only the same query with the same parameters
+ * hits. The entries cached before the meta data changed are dropped when they're taken out.
+ */
+class PlanCache final {
+ public:
+  struct Entry {
+    std::unique_ptr<QueryContext> qctx;
+    std::unique_ptr<Sentence> sentence;
+    // The values in the execution context before the first run
+    ExecutionContext::Snapshot snapshot;
+    // Version of the meta cache when the plan is made
+    int64_t metaVersion{-1};
+    size_t runs{0};
+  };
+
+  explicit PlanCache(size_t capacity) : capacity_(capacity) {}
+
+  // The key of the query of rctx
+  static std::string keyOf(const RequestContext<ExecutionResponse>* rctx);
+
+  // Whether the plan of sentence could be cached, i.e. it's a query without side effect
+  static bool cacheable(const Sentence* sentence);
+
+  // Take an entry of key out, nullptr if there is none made of the meta data of metaVersion
+  std::unique_ptr<Entry> get(const std::string& key, int64_t metaVersion);
+
+  // Put back an entry after it runs
+  void put(const std::string& key, std::unique_ptr<Entry> entry);
+
+ private:
+  using LruList = std::list<std::string>;
+
+  struct Entries {
+    LruList::iterator pos;
+    std::vector<std::unique_ptr<Entry>> entries;
+  };
+
+  const size_t capacity_;
+  std::mutex lock_;
+  // The keys, the most recently used first
+  LruList lru_;
+  std::unordered_map<std::string, Entries> cache_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_PLANCACHE_H_
@@ -0,0 +1,189 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/PlanStats.h"
+
+#include <folly/hash/Hash.h>
+
+#include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// The slow queries are kept for reference, the long ones are truncated
+constexpr size_t kMaxQueryLength = 4096;
+
+void makeShape(const PlanNode* node,
+               std::unordered_set<int64_t>* visited,
+               std::vector<const PlanNode*>* nodes,
+               std::string* shape) {
+  shape->append(PlanNode::toString(node->kind()));
+  // The nodes depended by more than one are described once
+  if (!visited->emplace(node->id()).second) {
+    return;
+  }
+  nodes->emplace_back(node);
+  if (node->kind() == PlanNode::Kind::kSelect) {
+    auto* select = static_cast<const Select*>(node);
+    shape->append("{");
+    makeShape(select->then(), visited, nodes, shape);
+    shape->append(",");
+    makeShape(select->otherwise(), visited, nodes, shape);
+    shape->append("}");
+  } else if (node->kind() == PlanNode::Kind::kLoop) {
+    shape->append("{");
+    makeShape(static_cast<const Loop*>(node)->body(), visited, nodes, shape);
+    shape->append("}");
+  }
+  if (node->numDeps() == 0) {
+    return;
+  }
+  shape->append("(");
+  for (size_t i = 0; i < node->numDeps(); ++i) {
+    if (i != 0) {
+      shape->append(",");
+    }
+    makeShape(node->dep(i), visited, nodes, shape);
+  }
+  shape->append(")");
+}
+
+}  // namespace
+
+/*static*/ PlanStats& PlanStats::instance() {
+  static PlanStats stats;
+  return stats;
+}
+
+/*static*/ std::string PlanStats::shapeOf(const PlanNode* root,
+                                          std::vector<const PlanNode*>* nodes) {
+  std::string shape;
+  std::unordered_set<int64_t> visited;
+  makeShape(root, &visited, nodes, &shape);
+  return shape;
+}
+
+/*static*/ std::string PlanStats::fingerprintOf(const std::string& shape) {
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << folly::hash::fnv64(shape);
+  return ss.str();
+}
+
+void PlanStats::add(const ExecutionPlan* plan,
+                    int64_t latencyInUs,
+                    int64_t memoryBefore,
+                    const std::string& query) {
+  if (FLAGS_plan_stats_capacity == 0 || plan->root() == nullptr) {
+    return;
+  }
+  std::vector<const PlanNode*> nodes;
+  auto shape = shapeOf(plan->root(), &nodes);
+  auto fingerprint = fingerprintOf(shape);
+  auto nodeRows = plan->nodeRows();
+  auto memory = std::max<int64_t>(plan->memoryPeak() - memoryBefore, 0);
+  bool slow = latencyInUs > FLAGS_slow_query_threshold_us;
+
+  std::lock_guard<std::mutex> guard(lock_);
+  auto found = entries_.find(fingerprint);
+  if (found == entries_.end()) {
+    if (entries_.size() >= FLAGS_plan_stats_capacity) {
+      auto least = std::min_element(entries_.begin(), entries_.end(), [](auto& l, auto& r) {
+        return l.second.totalLatencyInUs < r.second.totalLatencyInUs;
+      });
+      entries_.erase(least);
+    }
+    Entry entry;
+    entry.shape = std::move(shape);
+    entry.nodes.reserve(nodes.size());
+    for (auto* node : nodes) {
+      entry.nodes.emplace_back(NodeStats{PlanNode::toString(node->kind())});
+    }
+    found = entries_.emplace(fingerprint, std::move(entry)).first;
+  }
+  auto& entry = found->second;
+  entry.count++;
+  entry.totalLatencyInUs += latencyInUs;
+  entry.maxLatencyInUs = std::max(entry.maxLatencyInUs, latencyInUs);
+  auto bucket = std::lower_bound(kLatencyBoundsInUs.begin(), kLatencyBoundsInUs.end(), latencyInUs);
+  entry.latencyBuckets[bucket - kLatencyBoundsInUs.begin()]++;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto nodeRow = nodeRows.find(nodes[i]->id());
+    if (nodeRow != nodeRows.end()) {
+      auto rows = static_cast<int64_t>(nodeRow->second);
+      entry.nodes[i].rows += rows;
+      entry.nodes[i].maxRows = std::max(entry.nodes[i].maxRows, rows);
+    }
+  }
+  entry.memoryPeak = std::max(entry.memoryPeak, memory);
+  if (slow) {
+    entry.slowCount++;
+    entry.slowQuery = query.substr(0, kMaxQueryLength);
+  }
+}
+
+std::optional<PlanStats::Estimate> PlanStats::estimateOf(const PlanNode* root) const {
+  if (FLAGS_plan_stats_capacity == 0 || root == nullptr) {
+    return std::nullopt;
+  }
+  std::vector<const PlanNode*> nodes;
+  auto fingerprint = fingerprintOf(shapeOf(root, &nodes));
+  std::lock_guard<std::mutex> guard(lock_);
+  auto found = entries_.find(fingerprint);
+  if (found == entries_.end() || found->second.count == 0) {
+    return std::nullopt;
+  }
+  const auto& entry = found->second;
+  return Estimate{entry.totalLatencyInUs / entry.count, entry.memoryPeak};
+}
+
+folly::dynamic PlanStats::toJson(size_t top) const {
+  std::vector<std::pair<std::string, Entry>> entries;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    entries.assign(entries_.begin(), entries_.end());
+  }
+  auto size = std::min(top, entries.size());
+  std::partial_sort(
+      entries.begin(), entries.begin() + size, entries.end(), [](auto& l, auto& r) {
+        return l.second.totalLatencyInUs > r.second.totalLatencyInUs;
+      });
+
+  auto result = folly::dynamic::array();
+  for (size_t i = 0; i < size; ++i) {
+    const auto& [fingerprint, entry] = entries[i];
+    auto histogram = folly::dynamic::object();
+    for (size_t j = 0; j < entry.latencyBuckets.size(); ++j) {
+      auto bound = j < kLatencyBoundsInUs.size() ? folly::to<std::string>(kLatencyBoundsInUs[j])
+                                                 : std::string("inf");
+      histogram["le_" + bound + "_us"] = entry.latencyBuckets[j];
+    }
+    auto nodes = folly::dynamic::array();
+    for (const auto& node : entry.nodes) {
+      nodes.push_back(folly::dynamic::object("kind", node.kind)(
+          "avg_rows", node.rows / entry.count)("max_rows", node.maxRows));
+    }
+    result.push_back(folly::dynamic::object("fingerprint", fingerprint)("shape", entry.shape)(
+        "count", entry.count)("total_latency_us", entry.totalLatencyInUs)(
+        "avg_latency_us", entry.totalLatencyInUs / entry.count)(
+        "max_latency_us", entry.maxLatencyInUs)("latency_histogram", std::move(histogram))(
+        "memory_peak_bytes", entry.memoryPeak)("slow_count", entry.slowCount)(
+        "slow_query", entry.slowQuery)("nodes", std::move(nodes)));
+  }
+  return result;
+}
+
+void PlanStats::clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  entries_.clear();
+}
+
+}  // namespace graph
+}  // namespace nebula
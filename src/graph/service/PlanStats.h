@@ -0,0 +1,98 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_PLANSTATS_H_
+#define GRAPH_SERVICE_PLANSTATS_H_
+
+#include <folly/dynamic.h>
+
+#include <array>
+#include <mutex>
+#include <optional>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace graph {
+
+class ExecutionPlan;
+class PlanNode;
+
+/**
+ * PlanStats keeps the stats of the runs of each plan shape in graphd, to find the few shapes
+ * responsible for most of the load without profiling all the queries.
+ *
+ * The shape of a plan is the tree of the kinds of its nodes, e.g.
+ * Project(Filter(AppendVertices(Traverse(IndexScan(Start))))), without the expressions, the
+ * constants and the variables, so the same query of different constants shares the shape, whose
+ * hash is the fingerprint. For each shape it keeps the histogram of the latencies, the rows output
+ * by each node, the peak of the memory and the last slow query. At most plan_stats_capacity shapes
+ * are kept, the one of the least total latency is evicted for a new one.
+ *
+ * They're exposed by /plan_stats of the http service, the shapes of the most total latency first.
+ */
+class PlanStats final {
+ public:
+  static PlanStats& instance();
+
+  // The shape of the plan of root, with its nodes in the order they appear in the shape
+  static std::string shapeOf(const PlanNode* root, std::vector<const PlanNode*>* nodes);
+
+  static std::string fingerprintOf(const std::string& shape);
+
+  // Add the stats of a run of plan, memoryBefore is the memory used by graphd before the run
+  void add(const ExecutionPlan* plan,
+           int64_t latencyInUs,
+           int64_t memoryBefore,
+           const std::string& query);
+
+  // The mean latency and the memory peak of the runs of a plan shape
+  struct Estimate {
+    int64_t meanLatencyInUs{0};
+    int64_t memoryPeak{0};
+  };
+
+  // The estimate of the plan of root by the runs of its shape, none if it's never run
+  std::optional<Estimate> estimateOf(const PlanNode* root) const;
+
+  // The stats of at most top shapes, of the most total latency
+  folly::dynamic toJson(size_t top) const;
+
+  void clear();
+
+ private:
+  // The upper bounds of the buckets of the latencies, the last one is unbounded
+  static constexpr std::array<int64_t, 5> kLatencyBoundsInUs = {
+      1000, 10000, 100000, 1000000, 10000000};
+
+  struct NodeStats {
+    std::string kind;
+    int64_t rows{0};
+    int64_t maxRows{0};
+  };
+
+  struct Entry {
+    std::string shape;
+    int64_t count{0};
+    int64_t totalLatencyInUs{0};
+    int64_t maxLatencyInUs{0};
+    std::array<int64_t, kLatencyBoundsInUs.size() + 1> latencyBuckets{};
+    std::vector<NodeStats> nodes;
+    int64_t memoryPeak{0};
+    int64_t slowCount{0};
+    std::string slowQuery;
+  };
+
+  PlanStats() = default;
+
+  mutable std::mutex lock_;
+  // Fingerprint -> stats
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_PLANSTATS_H_
@@ -0,0 +1,90 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/PlanStatsHandler.h"
+
+#include <folly/json.h>
+#include <proxygen/httpserver/ResponseBuilder.h>
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+#include "graph/service/PlanStats.h"
+
+namespace nebula {
+namespace graph {
+
+using proxygen::HTTPMessage;
+using proxygen::HTTPMethod;
+using proxygen::ProxygenError;
+using proxygen::ResponseBuilder;
+using proxygen::UpgradeProtocol;
+
+void PlanStatsHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
+  if (!headers->getMethod() || headers->getMethod().value() != HTTPMethod::GET) {
+    // Unsupported method
+    err_ = HttpCode::E_UNSUPPORTED_METHOD;
+    return;
+  }
+
+  if (headers->hasQueryParam("top")) {
+    auto top = folly::tryTo<size_t>(headers->getQueryParam("top"));
+    if (!top.hasValue()) {
+      err_ = HttpCode::E_ILLEGAL_ARGUMENT;
+      return;
+    }
+    top_ = top.value();
+  }
+  if (headers->hasQueryParam("reset")) {
+    reset_ = headers->getQueryParam("reset") == "true";
+  }
+}
+
+void PlanStatsHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
+  // Do nothing, we only support GET
+}
+
+void PlanStatsHandler::onEOM() noexcept {
+  switch (err_) {
+    case HttpCode::E_UNSUPPORTED_METHOD:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::METHOD_NOT_ALLOWED),
+                  WebServiceUtils::toString(HttpStatusCode::METHOD_NOT_ALLOWED))
+          .sendWithEOM();
+      return;
+    case HttpCode::E_ILLEGAL_ARGUMENT:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::BAD_REQUEST),
+                  WebServiceUtils::toString(HttpStatusCode::BAD_REQUEST))
+          .sendWithEOM();
+      return;
+    default:
+      break;
+  }
+
+  auto stats = PlanStats::instance().toJson(top_);
+  if (reset_) {
+    PlanStats::instance().clear();
+  }
+  ResponseBuilder(downstream_)
+      .status(WebServiceUtils::to(HttpStatusCode::OK),
+              WebServiceUtils::toString(HttpStatusCode::OK))
+      .body(folly::toPrettyJson(stats))
+      .sendWithEOM();
+}
+
+void PlanStatsHandler::onUpgrade(UpgradeProtocol) noexcept {
+  // Do nothing
+}
+
+void PlanStatsHandler::requestComplete() noexcept {
+  delete this;
+}
+
+void PlanStatsHandler::onError(ProxygenError err) noexcept {
+  LOG(ERROR) << "Web service PlanStatsHandler got error: " << proxygen::getErrorString(err);
+  delete this;
+}
+
+}  // namespace graph
+}  // namespace nebula
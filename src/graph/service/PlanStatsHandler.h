@@ -0,0 +1,46 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_PLANSTATSHANDLER_H_
+#define GRAPH_SERVICE_PLANSTATSHANDLER_H_
+
+#include <proxygen/httpserver/RequestHandler.h>
+
+#include "common/base/Base.h"
+#include "webservice/Common.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * @brief Get the stats of the plan shapes of the most total latency in json, see PlanStats.
+ *        e.g. curl "http://graphd:19669/plan_stats?top=10", top is 100 by default.
+ *        The stats are cleared after they're read if reset=true.
+ */
+class PlanStatsHandler : public proxygen::RequestHandler {
+ public:
+  PlanStatsHandler() = default;
+
+  void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
+
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override;
+
+  void onEOM() noexcept override;
+
+  void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override;
+
+  void requestComplete() noexcept override;
+
+  void onError(proxygen::ProxygenError err) noexcept override;
+
+ private:
+  HttpCode err_{HttpCode::SUCCEEDED};
+  size_t top_{100};
+  bool reset_{false};
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SERVICE_PLANSTATSHANDLER_H_
@@ -9,11 +9,13 @@
 #include "common/memory/MemoryUtils.h"
 #include "common/meta/ServerBasedIndexManager.h"
 #include "common/meta/ServerBasedSchemaManager.h"
+#include "common/stats/StatsManager.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/PlannersRegister.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/QueryInstance.h"
+#include "graph/stats/GraphStats.h"
 #include "version/Version.h"
 
 DECLARE_bool(local_config);
@@ -41,12 +43,47 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
     rulesets.emplace_back(&opt::RuleSet::QueryRules());
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
+  if (FLAGS_plan_cache_capacity > 0) {
+    planCache_ = std::make_unique<PlanCache>(FLAGS_plan_cache_capacity);
+  }
+  if (FLAGS_result_cache_capacity_mb > 0) {
+    resultCache_ = std::make_unique<ResultCache>(
+        static_cast<int64_t>(FLAGS_result_cache_capacity_mb) * memory::MiB);
+  }
 
   return setupMemoryMonitorThread();
 }
 
 // Create query context and query instance and execute it
 void QueryEngine::execute(RequestContextPtr rctx) {
+  std::string cacheKey;
+  int64_t metaVersion = -1;
+  if (planCache_ != nullptr || resultCache_ != nullptr) {
+    cacheKey = PlanCache::keyOf(rctx.get());
+    metaVersion = metaClient_->localDataVersion();
+  }
+  int64_t spaceVersion = -1;
+  if (resultCache_ != nullptr) {
+    if (respondByResultCache(rctx.get(), cacheKey, metaVersion)) {
+      return;
+    }
+    // Taken before the run, so the result is not cached if the space is written meanwhile
+    spaceVersion = resultCache_->versionOf(rctx->session()->space().id);
+  }
+  if (planCache_ != nullptr) {
+    auto entry = planCache_->get(cacheKey, metaVersion);
+    if (entry != nullptr) {
+      entry->qctx->reuse(std::move(rctx));
+      auto* instance = new QueryInstance(
+          std::move(entry), optimizer_.get(), planCache_.get(), cacheKey);
+      if (resultCache_ != nullptr) {
+        instance->enableResultCache(
+            resultCache_.get(), std::move(cacheKey), metaVersion, spaceVersion);
+      }
+      instance->execute();
+      return;
+    }
+  }
   auto qctx = std::make_unique<QueryContext>(std::move(rctx),
                                              schemaManager_.get(),
                                              indexManager_.get(),
@@ -54,9 +91,38 @@ void QueryEngine::execute(RequestContextPtr rctx) {
                                              metaClient_,
                                              charsetInfo_);
   auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
+  if (planCache_ != nullptr) {
+    instance->enablePlanCache(planCache_.get(), cacheKey, metaVersion);
+  }
+  if (resultCache_ != nullptr) {
+    instance->enableResultCache(resultCache_.get(), std::move(cacheKey), metaVersion, spaceVersion);
+  }
   instance->execute();
 }
 
+bool QueryEngine::respondByResultCache(RequestContext<ExecutionResponse>* rctx,
+                                       const std::string& cacheKey,
+                                       int64_t metaVersion) {
+  auto session = rctx->session();
+  auto space = session->space();
+  auto result = resultCache_->get(cacheKey, space.id, metaVersion);
+  if (result == nullptr) {
+    return false;
+  }
+  // All the queries cached read the data of the space
+  if (FLAGS_enable_authorize && !session->isGod() && !session->roleWithSpace(space.id).ok()) {
+    return false;
+  }
+  VLOG(1) << "Respond by the result cached of query: " << rctx->query();
+  stats::StatsManager::addValue(kNumResultCacheHits);
+  auto& resp = rctx->resp();
+  resp.data = std::make_unique<DataSet>(*result);
+  resp.spaceName = std::make_unique<std::string>(space.name);
+  resp.latencyInUs = rctx->duration().elapsedInUSec();
+  rctx->finish();
+  return true;
+}
+
 Status QueryEngine::setupMemoryMonitorThread() {
   memoryMonitorThread_ = std::make_unique<thread::GenericWorker>();
   if (!memoryMonitorThread_ || !memoryMonitorThread_->start("graph-memory-monitor")) {
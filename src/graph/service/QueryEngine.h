@@ -18,7 +18,9 @@
 #include "common/meta/SchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/service/PlanCache.h"
 #include "graph/service/RequestContext.h"
+#include "graph/service/ResultCache.h"
 #include "interface/gen-cpp2/GraphService.h"
 
 namespace nebula {
@@ -26,8 +28,10 @@ namespace graph {
 
 /**
  * QueryEngine is responsible to create and manage ExecutionPlan.
- * For the time being, we don't have the execution plan cache support,
- * instead we create a plan for each query, and destroy it upon finish.
+ * A plan is created for each query and destroyed upon finish, unless
+ * plan_cache_capacity is set, then the plans of the read-only queries are
+ * kept in the PlanCache to run the same queries again. The results of them
+ * are kept in the ResultCache if result_cache_capacity_mb is set.
  */
 class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
  public:
@@ -46,11 +50,17 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
 
  private:
   Status setupMemoryMonitorThread();
+  // Answer the request by the result cached, return false if there is none
+  bool respondByResultCache(RequestContext<ExecutionResponse>* rctx,
+                            const std::string& cacheKey,
+                            int64_t metaVersion);
 
   std::unique_ptr<meta::SchemaManager> schemaManager_;
   std::unique_ptr<meta::IndexManager> indexManager_;
   std::unique_ptr<storage::StorageClient> storage_;
   std::unique_ptr<opt::Optimizer> optimizer_;
+  std::unique_ptr<PlanCache> planCache_;
+  std::unique_ptr<ResultCache> resultCache_;
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
@@ -6,6 +6,7 @@
 #include "graph/service/QueryInstance.h"
 
 #include "common/base/Base.h"
+#include "common/memory/MemoryTracker.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/ScopedTimer.h"
 #include "graph/executor/ExecutionError.h"
@@ -15,6 +16,10 @@
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
 #include "graph/scheduler/Scheduler.h"
+#include "graph/service/AdmissionController.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/service/PermissionManager.h"
+#include "graph/service/PlanStats.h"
 #include "graph/stats/GraphStats.h"
 #include "graph/util/AstUtils.h"
 #include "graph/validator/Validator.h"
@@ -33,16 +38,73 @@ QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *opti
   qctx_ = std::move(qctx);
   optimizer_ = DCHECK_NOTNULL(optimizer);
   scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
+  // Each run has its own tracker, as a cached plan might run for another session
+  auto limit = FLAGS_query_memory_limit_mb == 0
+                   ? std::numeric_limits<int64_t>::max()
+                   : static_cast<int64_t>(FLAGS_query_memory_limit_mb) * memory::MiB;
+  qctx_->setMemoryTracker(std::make_shared<memory::MemoryTrackerNode>(
+      qctx_->rctx()->session()->memoryTracker(), limit, true));
   qctx_->rctx()->session()->addQuery(qctx_.get());
 }
 
+QueryInstance::QueryInstance(std::unique_ptr<PlanCache::Entry> entry,
+                             Optimizer *optimizer,
+                             PlanCache *planCache,
+                             std::string cacheKey)
+    : QueryInstance(std::move(entry->qctx), optimizer) {
+  sentence_ = std::move(entry->sentence);
+  planCache_ = DCHECK_NOTNULL(planCache);
+  cacheKey_ = std::move(cacheKey);
+  cacheEntry_ = std::move(entry);
+  planCached_ = true;
+}
+
+void QueryInstance::enablePlanCache(PlanCache *planCache,
+                                    std::string cacheKey,
+                                    int64_t metaVersion) {
+  planCache_ = DCHECK_NOTNULL(planCache);
+  cacheKey_ = std::move(cacheKey);
+  cacheEntry_ = std::make_unique<PlanCache::Entry>();
+  cacheEntry_->metaVersion = metaVersion;
+}
+
+void QueryInstance::enableResultCache(ResultCache *resultCache,
+                                      std::string cacheKey,
+                                      int64_t metaVersion,
+                                      int64_t spaceVersion) {
+  resultCache_ = DCHECK_NOTNULL(resultCache);
+  resultCacheKey_ = std::move(cacheKey);
+  resultMetaVersion_ = metaVersion;
+  resultSpaceVersion_ = spaceVersion;
+  resultSpace_ = qctx_->rctx()->session()->space().id;
+}
+
 void QueryInstance::execute() {
+  // The memory of the run, including the futures it starts, is attributed to its tracker
+  folly::ShallowCopyRequestContextScopeGuard memoryGuard(
+      memory::MemoryTrackerData::token(),
+      std::make_unique<memory::MemoryTrackerData>(qctx_->memoryTracker()));
+  // The executors and the storage rpcs of the query are traced as the children of it
+  span_ = tracing::Span::start("query", std::nullopt, tracing::SpanKind::kServer);
+  if (span_.sampled()) {
+    span_.addAttribute("query", qctx_->rctx()->query());
+    span_.addAttribute("session", folly::to<std::string>(qctx_->rctx()->session()->id()));
+  }
+  tracing::SpanScope traceScope(span_);
   try {
-    Status status = validateAndOptimize();
+    Status status = planCached_ ? checkCachedPlan() : validateAndOptimize();
     if (!status.ok()) {
       onError(std::move(status));
       return;
     }
+    if (cacheEntry_ != nullptr && !planCached_) {
+      if (PlanCache::cacheable(sentence_.get())) {
+        // Taken before the run, the executors would write the execution context
+        cacheEntry_->snapshot = qctx_->ectx()->snapshot();
+      } else {
+        cacheEntry_.reset();
+      }
+    }
 
     // Sentence is explain query, finish
     if (!explainOrContinue()) {
@@ -50,6 +112,55 @@ void QueryInstance::execute() {
       return;
     }
 
+    auto admitted = admit();
+    if (!admitted.ok()) {
+      onError(std::move(admitted).status());
+      return;
+    }
+    if (admitted.value()) {
+      schedule();
+    }
+  } catch (std::bad_alloc &e) {
+    onError(Status::GraphMemoryExceeded(
+        "(%d)", static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
+  } catch (std::exception &e) {
+    onError(Status::Error("%s", e.what()));
+  } catch (...) {
+    onError(Status::Error("unknown error"));
+  }
+}
+
+StatusOr<bool> QueryInstance::admit() {
+  if (!AdmissionController::enabled()) {
+    return true;
+  }
+  auto estimate = PlanStats::instance().estimateOf(qctx_->plan()->root());
+  if (!estimate.has_value() ||
+      estimate->meanLatencyInUs < static_cast<int64_t>(FLAGS_analytic_query_latency_ms) * 1000) {
+    return true;
+  }
+  // Set before the query is queued, it may be admitted and released by another thread before
+  // admit returns, and nothing of the instance is touched once it's queued
+  admission_ = std::make_pair(AdmissionController::groupOf(qctx_->rctx()->session()),
+                              estimate->memoryPeak);
+  // Run by the thread of the query which frees the slot, so it's moved back to the worker threads
+  auto admitted = AdmissionController::instance().admit(
+      admission_->first, admission_->second, [this]() {
+        qctx_->rctx()->runner()->add([this]() { schedule(); });
+      });
+  if (!admitted.ok()) {
+    admission_.reset();
+  }
+  return admitted;
+}
+
+void QueryInstance::schedule() {
+  folly::ShallowCopyRequestContextScopeGuard memoryGuard(
+      memory::MemoryTrackerData::token(),
+      std::make_unique<memory::MemoryTrackerData>(qctx_->memoryTracker()));
+  tracing::SpanScope traceScope(span_);
+  try {
+    memoryBefore_ = memory::MemoryStats::instance().used();
     // The execution engine converts the physical execution plan generated by the Planner into a
     // series of Executors through the Scheduler to drive the execution of the Executors.
     scheduler_->schedule()
@@ -74,6 +185,13 @@ void QueryInstance::execute() {
   }
 }
 
+void QueryInstance::releaseAdmission() {
+  if (admission_.has_value()) {
+    AdmissionController::instance().release(admission_->first, admission_->second);
+    admission_.reset();
+  }
+}
+
 Status QueryInstance::validateAndOptimize() {
   auto *rctx = qctx()->rctx();
   auto &spaceName = rctx->session()->space().name;
@@ -82,20 +200,7 @@ Status QueryInstance::validateAndOptimize() {
   auto result = GQLParser(qctx()).parse(rctx->query());
   NG_RETURN_IF_ERROR(result);
   sentence_ = std::move(result).value();
-  if (sentence_->kind() == Sentence::Kind::kSequential) {
-    size_t num = static_cast<const SequentialSentences *>(sentence_.get())->numSentences();
-    stats::StatsManager::addValue(kNumSentences, num);
-    if (FLAGS_enable_space_level_metrics && spaceName != "") {
-      stats::StatsManager::addValue(
-          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}), num);
-    }
-  } else {
-    stats::StatsManager::addValue(kNumSentences);
-    if (FLAGS_enable_space_level_metrics && spaceName != "") {
-      stats::StatsManager::addValue(
-          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}));
-    }
-  }
+  addSentenceStats(spaceName);
 
   // Validate the query, if failed, return
   NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
@@ -113,6 +218,32 @@ Status QueryInstance::validateAndOptimize() {
   return Status::OK();
 }
 
+Status QueryInstance::checkCachedPlan() {
+  auto *rctx = qctx()->rctx();
+  VLOG(1) << "Run the cached plan of query: " << rctx->query();
+  addSentenceStats(rctx->session()->space().name);
+  stats::StatsManager::addValue(kNumPlanCacheHits);
+  // All the cacheable sentences read the schema or data of the space
+  return PermissionManager::canReadSchemaOrData(rctx->session(), qctx()->vctx());
+}
+
+void QueryInstance::addSentenceStats(const std::string &spaceName) const {
+  if (sentence_->kind() == Sentence::Kind::kSequential) {
+    size_t num = static_cast<const SequentialSentences *>(sentence_.get())->numSentences();
+    stats::StatsManager::addValue(kNumSentences, num);
+    if (FLAGS_enable_space_level_metrics && spaceName != "") {
+      stats::StatsManager::addValue(
+          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}), num);
+    }
+  } else {
+    stats::StatsManager::addValue(kNumSentences);
+    if (FLAGS_enable_space_level_metrics && spaceName != "") {
+      stats::StatsManager::addValue(
+          stats::StatsManager::counterWithLabels(kNumSentences, {{"space", spaceName}}));
+    }
+  }
+}
+
 bool QueryInstance::explainOrContinue() {
   if (sentence_->kind() != Sentence::Kind::kExplain) {
     return true;
@@ -130,6 +261,19 @@ void QueryInstance::onFinish() {
   rctx->resp().spaceName = std::make_unique<std::string>(spaceName);
 
   fillRespData(&rctx->resp());
+  if (qctx()->sampleRatio() < 1.0) {
+    auto comment = folly::stringPrintf("Approximate result sampled by the ratio %g",
+                                      qctx()->sampleRatio());
+    if (qctx()->sampledError() > 0.0) {
+      comment += folly::stringPrintf(
+          ", the counts and sums are scaled, with the relative standard error within %.2f%%",
+          qctx()->sampledError() * 100);
+    }
+    rctx->resp().comment = std::make_unique<std::string>(std::move(comment));
+  }
+  if (resultCache_ != nullptr) {
+    updateResultCache(rctx->resp());
+  }
 
   auto latency = rctx->duration().elapsedInUSec();
   rctx->resp().latencyInUs = latency;
@@ -138,6 +282,14 @@ void QueryInstance::onFinish() {
 
   rctx->session()->deleteQuery(qctx_.get());
   scheduler_->waitFinish();
+  releaseAdmission();
+  if (sentence_->kind() != Sentence::Kind::kExplain ||
+      static_cast<const ExplainSentence *>(sentence_.get())->isProfile()) {
+    PlanStats::instance().add(qctx_->plan(), latency, memoryBefore_, rctx->query());
+  }
+  if (cacheEntry_ != nullptr) {
+    recyclePlan();
+  }
   // The `QueryInstance' is the root node holding all resources during the
   // execution. When the whole query process is done, it's safe to release this
   // object, as long as no other contexts have chances to access these resources
@@ -146,10 +298,60 @@ void QueryInstance::onFinish() {
   delete this;
 }
 
+void QueryInstance::recyclePlan() {
+  // Each run allocates the executors in the object pool of the plan, drop it to bound the memory
+  if (++cacheEntry_->runs >= FLAGS_plan_cache_max_reuses) {
+    return;
+  }
+  qctx_->ectx()->restore(cacheEntry_->snapshot);
+  qctx_->setRCtx(nullptr);
+  cacheEntry_->qctx = std::move(qctx_);
+  cacheEntry_->sentence = std::move(sentence_);
+  planCache_->put(cacheKey_, std::move(cacheEntry_));
+}
+
+void QueryInstance::updateResultCache(const ExecutionResponse &resp) {
+  if (sentence_ == nullptr) {
+    return;
+  }
+  const Sentence *sentence = sentence_.get();
+  bool explained = sentence->kind() == Sentence::Kind::kExplain;
+  if (explained) {
+    auto explain = static_cast<const ExplainSentence *>(sentence);
+    if (!explain->isProfile()) {
+      return;
+    }
+    sentence = explain->seqSentences();
+  }
+  if (!PlanCache::cacheable(sentence)) {
+    // It may write the space it started in or the one it switched to
+    resultCache_->invalidate(resultSpace_);
+    resultCache_->invalidate(qctx_->rctx()->session()->space().id);
+    return;
+  }
+  // The results of profile come with the plan descriptions, not cached
+  // Nor the approximate ones, which would answer the exact queries
+  if (explained || resp.errorCode != ErrorCode::SUCCEEDED || resp.data == nullptr ||
+      !qctx_->deterministic() || qctx_->sampleRatio() < 1.0) {
+    return;
+  }
+  try {
+    auto result = std::make_shared<const DataSet>(*resp.data);
+    resultCache_->put(resultCacheKey_,
+                      resultSpace_,
+                      resultMetaVersion_,
+                      resultSpaceVersion_,
+                      std::move(result));
+  } catch (std::bad_alloc &e) {
+    // Not cached if the query runs out of its memory
+  }
+}
+
 void QueryInstance::onError(Status status) {
   auto *rctx = qctx()->rctx();
   LOG(ERROR) << status << ", query: " << rctx->query();
   auto &spaceName = rctx->session()->space().name;
+  span_.setError(status.toString());
   switch (status.code()) {
     case Status::Code::kOk:
       rctx->resp().errorCode = ErrorCode::SUCCEEDED;
@@ -206,8 +408,12 @@ void QueryInstance::onError(Status status) {
         stats::StatsManager::counterWithLabels(kNumQueryErrors, {{"space", spaceName}}));
   }
   addSlowQueryStats(latency, spaceName);
+  if (resultCache_ != nullptr) {
+    updateResultCache(rctx->resp());
+  }
   rctx->session()->deleteQuery(qctx_.get());
   rctx->finish();
+  releaseAdmission();
   delete this;
 }
 
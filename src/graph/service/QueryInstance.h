@@ -9,10 +9,14 @@
 #include <boost/core/noncopyable.hpp>
 
 #include "common/base/Status.h"
+#include "common/base/StatusOr.h"
 #include "common/cpp/helpers.h"
+#include "common/tracing/Tracing.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/Optimizer.h"
 #include "graph/scheduler/Scheduler.h"
+#include "graph/service/PlanCache.h"
+#include "graph/service/ResultCache.h"
 #include "parser/GQLParser.h"
 
 /**
@@ -27,8 +31,23 @@ namespace graph {
 class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
  public:
   QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+  // Run the plan cached by entry, its query context has been prepared for the request
+  QueryInstance(std::unique_ptr<PlanCache::Entry> entry,
+                opt::Optimizer* optimizer,
+                PlanCache* planCache,
+                std::string cacheKey);
   ~QueryInstance() = default;
 
+  // Put the plan into planCache once it runs successfully, if the query is cacheable
+  void enablePlanCache(PlanCache* planCache, std::string cacheKey, int64_t metaVersion);
+
+  // Put the result into resultCache once the query finishes, if it's cacheable and deterministic,
+  // or invalidate the results of the space if the query may write it
+  void enableResultCache(ResultCache* resultCache,
+                         std::string cacheKey,
+                         int64_t metaVersion,
+                         int64_t spaceVersion);
+
   // Entrance of the Validate, Optimize, Schedule, Execute process
   void execute();
 
@@ -52,16 +71,48 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   void onError(Status);
 
   Status validateAndOptimize();
+  // Admit the query by the AdmissionController if it's analytic, return false if it waits to be
+  // scheduled once admitted
+  StatusOr<bool> admit();
+  // Run the plan by the scheduler
+  void schedule();
+  // Release the query admitted by the AdmissionController
+  void releaseAdmission();
   // Return true if continue to execute
   bool explainOrContinue();
+  void addSentenceStats(const std::string& spaceName) const;
   void addSlowQueryStats(uint64_t latency, const std::string& spaceName) const;
   void fillRespData(ExecutionResponse* resp);
   Status findBestPlan();
+  // Check the permission again before a cached plan runs, as the roles may have changed
+  Status checkCachedPlan();
+  // Put the plan back into the plan cache after the run
+  void recyclePlan();
+  // Cache the result of the query, or invalidate the results of the space it may write
+  void updateResultCache(const ExecutionResponse& resp);
 
   std::unique_ptr<Sentence> sentence_;
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
+
+  PlanCache* planCache_{nullptr};
+  std::string cacheKey_;
+  // The plan cached to run or to be cached, without qctx and sentence while it runs
+  std::unique_ptr<PlanCache::Entry> cacheEntry_;
+  bool planCached_{false};
+  ResultCache* resultCache_{nullptr};
+  std::string resultCacheKey_;
+  // The versions when the query starts, which the result is cached with
+  int64_t resultMetaVersion_{-1};
+  int64_t resultSpaceVersion_{-1};
+  GraphSpaceID resultSpace_{-1};
+  // The memory used by graphd before the plan runs, see PlanStats
+  int64_t memoryBefore_{0};
+  // The resource group and the memory estimated of the query admitted as analytic
+  std::optional<std::pair<std::string, int64_t>> admission_;
+  // The root span of the trace of the query, ends when the query instance is destroyed
+  tracing::Span span_;
 };
 
 }  // namespace graph
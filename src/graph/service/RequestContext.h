@@ -98,6 +98,16 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
     return parameterMap_;
   }
 
+  // The ratio by which the query samples the vertices and edges it scans and the sources it
+  // traverses from, 1 if it's answered exactly
+  void setSampleRatio(double sampleRatio) {
+    sampleRatio_ = sampleRatio;
+  }
+
+  double sampleRatio() const {
+    return sampleRatio_;
+  }
+
  private:
   time::Duration duration_;
   std::string query_;
@@ -107,6 +117,7 @@ class RequestContext final : public boost::noncopyable, public cpp::NonMovable {
   folly::Executor* runner_{nullptr};
   GraphSessionManager* sessionMgr_{nullptr};
   std::unordered_map<std::string, Value> parameterMap_;
+  double sampleRatio_{1.0};
 };
 
 }  // namespace graph
@@ -0,0 +1,193 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/ResultCache.h"
+
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+#include "common/memory/MemoryUtils.h"
+#include "common/time/WallClock.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+int64_t bytesOfValue(const Value& value);
+
+int64_t bytesOfVertex(const Vertex& vertex) {
+  int64_t bytes = sizeof(Vertex) + bytesOfValue(vertex.vid);
+  for (const auto& tag : vertex.tags) {
+    bytes += sizeof(Tag) + tag.name.size();
+    for (const auto& prop : tag.props) {
+      bytes += prop.first.size() + bytesOfValue(prop.second);
+    }
+  }
+  return bytes;
+}
+
+// The shared vertices and edges are counted by each of the values, so it's an upper bound
+int64_t bytesOfValue(const Value& value) {
+  int64_t bytes = sizeof(Value);
+  switch (value.type()) {
+    case Value::Type::STRING:
+      return bytes + value.getStr().size();
+    case Value::Type::LIST:
+      for (const auto& v : value.getList().values) {
+        bytes += bytesOfValue(v);
+      }
+      return bytes;
+    case Value::Type::SET:
+      for (const auto& v : value.getSet().values) {
+        bytes += bytesOfValue(v);
+      }
+      return bytes;
+    case Value::Type::MAP:
+      for (const auto& kv : value.getMap().kvs) {
+        bytes += kv.first.size() + bytesOfValue(kv.second);
+      }
+      return bytes;
+    case Value::Type::VERTEX:
+      return bytes + bytesOfVertex(value.getVertex());
+    case Value::Type::EDGE: {
+      const auto& edge = value.getEdge();
+      bytes += sizeof(Edge) + bytesOfValue(edge.src) + bytesOfValue(edge.dst) + edge.name.size();
+      for (const auto& prop : edge.props) {
+        bytes += prop.first.size() + bytesOfValue(prop.second);
+      }
+      return bytes;
+    }
+    case Value::Type::PATH: {
+      const auto& path = value.getPath();
+      bytes += bytesOfVertex(path.src);
+      for (const auto& step : path.steps) {
+        bytes += sizeof(Step) + bytesOfVertex(step.dst) + step.name.size();
+        for (const auto& prop : step.props) {
+          bytes += prop.first.size() + bytesOfValue(prop.second);
+        }
+      }
+      return bytes;
+    }
+    case Value::Type::DATASET:
+      return bytes + ResultCache::bytesOf(value.getDataSet());
+    default:
+      return bytes;
+  }
+}
+
+}  // namespace
+
+/*static*/ int64_t ResultCache::bytesOf(const DataSet& result) {
+  int64_t bytes = sizeof(DataSet);
+  for (const auto& name : result.colNames) {
+    bytes += sizeof(std::string) + name.size();
+  }
+  for (const auto& row : result.rows) {
+    bytes += sizeof(Row);
+    for (const auto& value : row.values) {
+      bytes += bytesOfValue(value);
+    }
+  }
+  return bytes;
+}
+
+int64_t ResultCache::versionOf(GraphSpaceID space) {
+  std::lock_guard<std::mutex> g(lock_);
+  return spaceVersions_[space];
+}
+
+std::shared_ptr<const DataSet> ResultCache::get(const std::string& key,
+                                                GraphSpaceID space,
+                                                int64_t metaVersion) {
+  std::vector<std::shared_ptr<const DataSet>> released;
+  std::shared_ptr<const DataSet> result;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    if (memory::MemoryUtils::kHitMemoryHighWatermark.load()) {
+      for (auto& entry : cache_) {
+        released.emplace_back(std::move(entry.second.result));
+      }
+      cache_.clear();
+      lru_.clear();
+      bytes_ = 0;
+      return nullptr;
+    }
+    auto found = cache_.find(key);
+    if (found == cache_.end()) {
+      return nullptr;
+    }
+    auto& entry = found->second;
+    if (entry.space != space || entry.metaVersion != metaVersion ||
+        entry.spaceVersion != spaceVersions_[space] ||
+        entry.expireAt <= time::WallClock::fastNowInMilliSec()) {
+      released.emplace_back(std::move(entry.result));
+      eraseLocked(found);
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, entry.pos);
+    result = entry.result;
+  }
+  // The results dropped are released out of the lock
+  return result;
+}
+
+void ResultCache::put(const std::string& key,
+                      GraphSpaceID space,
+                      int64_t metaVersion,
+                      int64_t spaceVersion,
+                      std::shared_ptr<const DataSet> result) {
+  if (memory::MemoryUtils::kHitMemoryHighWatermark.load()) {
+    return;
+  }
+  auto bytes = bytesOf(*result) + static_cast<int64_t>(key.size());
+  if (bytes > capacity_) {
+    return;
+  }
+  auto expireAt = time::WallClock::fastNowInMilliSec() + FLAGS_result_cache_ttl_ms;
+  std::vector<std::shared_ptr<const DataSet>> released;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    // Written while the query ran
+    if (spaceVersion != spaceVersions_[space]) {
+      released.emplace_back(std::move(result));
+      return;
+    }
+    auto found = cache_.find(key);
+    if (found != cache_.end()) {
+      released.emplace_back(std::move(found->second.result));
+      eraseLocked(found);
+    }
+    lru_.push_front(key);
+    Entry entry{std::move(result), space, metaVersion, spaceVersion, expireAt, bytes, lru_.begin()};
+    cache_.emplace(key, std::move(entry));
+    bytes_ += bytes;
+    while (bytes_ > capacity_) {
+      auto last = cache_.find(lru_.back());
+      DCHECK(last != cache_.end());
+      released.emplace_back(std::move(last->second.result));
+      eraseLocked(last);
+    }
+  }
+}
+
+void ResultCache::invalidate(GraphSpaceID space) {
+  std::lock_guard<std::mutex> g(lock_);
+  // The entries of the space are dropped lazily by get
+  ++spaceVersions_[space];
+}
+
+void ResultCache::eraseLocked(std::unordered_map<std::string, Entry>::iterator iter) {
+  bytes_ -= iter->second.bytes;
+  lru_.erase(iter->second.pos);
+  cache_.erase(iter);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,80 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_RESULTCACHE_H_
+#define GRAPH_SERVICE_RESULTCACHE_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * ResultCache keeps the results of the read-only queries, so a query repeated, e.g. by the
+ * dashboards, is answered without running while the data it reads is not written.
+ *
+ * A result is keyed like the plans of PlanCache, i.e. by the space, the user, the parameters and
+ * the text of the query, and it's kept with the versions of the meta data and of the data of the
+ * space when the query started. The version of a space advances whenever a query which may write
+ * it finishes in this graphd, so the results read before are invalidated. The writes by the other
+ * graphds are not told here, result_cache_ttl_ms bounds how long a result is used after them.
+ *
+ * The results are bounded by the bytes estimated, the ones least recently used are evicted beyond
+ * the capacity, and all of them are dropped once the memory of graphd hits the high watermark.
+ */
+class ResultCache final {
+ public:
+  explicit ResultCache(int64_t capacity) : capacity_(capacity) {}
+
+  // The version of the data of space, taken before a query runs
+  int64_t versionOf(GraphSpaceID space);
+
+  // The result of key, null if there is none of the current versions within the ttl
+  std::shared_ptr<const DataSet> get(const std::string& key,
+                                     GraphSpaceID space,
+                                     int64_t metaVersion);
+
+  // Cache the result of the query of key, which started at the versions
+  void put(const std::string& key,
+           GraphSpaceID space,
+           int64_t metaVersion,
+           int64_t spaceVersion,
+           std::shared_ptr<const DataSet> result);
+
+  // Advance the version of the data of space, as a query may have written it
+  void invalidate(GraphSpaceID space);
+
+  // The bytes estimated of a result
+  static int64_t bytesOf(const DataSet& result);
+
+ private:
+  using LruList = std::list<std::string>;
+
+  struct Entry {
+    std::shared_ptr<const DataSet> result;
+    GraphSpaceID space;
+    int64_t metaVersion;
+    int64_t spaceVersion;
+    int64_t expireAt;
+    int64_t bytes;
+    LruList::iterator pos;
+  };
+
+  void eraseLocked(std::unordered_map<std::string, Entry>::iterator iter);
+
+  const int64_t capacity_;
+  std::mutex lock_;
+  int64_t bytes_{0};
+  // The keys, the most recently used first
+  LruList lru_;
+  std::unordered_map<std::string, Entry> cache_;
+  std::unordered_map<GraphSpaceID, int64_t> spaceVersions_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_RESULTCACHE_H_
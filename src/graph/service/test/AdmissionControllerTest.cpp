@@ -0,0 +1,121 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/memory/MemoryTracker.h"
+#include "graph/service/AdmissionController.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+class AdmissionControllerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_max_running_analytic_queries = 2;
+    FLAGS_analytic_query_memory_budget_mb = 0;
+    FLAGS_max_queued_analytic_queries = 2;
+  }
+
+  // Admit a query, which appends its id to runs_ once a waiting one is admitted
+  StatusOr<bool> admit(const std::string& group, int64_t memory, int32_t id) {
+    return AdmissionController::instance().admit(
+        group, memory, [this, id]() { runs_.emplace_back(id); });
+  }
+
+  void release(const std::string& group, int64_t memory) {
+    AdmissionController::instance().release(group, memory);
+  }
+
+  // Restores the flags set by the tests
+  gflags::FlagSaver flagSaver_;
+  std::vector<int32_t> runs_;
+};
+
+TEST_F(AdmissionControllerTest, AdmitThenQueue) {
+  ASSERT_TRUE(AdmissionController::enabled());
+  // The first ones run at once, the ones beyond max_running_analytic_queries wait in order
+  EXPECT_TRUE(admit("space:order", 0, 1).value());
+  EXPECT_TRUE(admit("space:order", 0, 2).value());
+  EXPECT_FALSE(admit("space:order", 0, 3).value());
+  EXPECT_FALSE(admit("space:order", 0, 4).value());
+  // Another group is not limited by them
+  EXPECT_TRUE(admit("space:other", 0, 5).value());
+  EXPECT_TRUE(runs_.empty());
+
+  release("space:order", 0);
+  EXPECT_EQ(std::vector<int32_t>({3}), runs_);
+  release("space:order", 0);
+  EXPECT_EQ(std::vector<int32_t>({3, 4}), runs_);
+  // Nothing waits any more
+  release("space:order", 0);
+  release("space:order", 0);
+  release("space:other", 0);
+  EXPECT_EQ(std::vector<int32_t>({3, 4}), runs_);
+}
+
+TEST_F(AdmissionControllerTest, QueueFull) {
+  FLAGS_max_running_analytic_queries = 1;
+  EXPECT_TRUE(admit("space:full", 0, 1).value());
+  EXPECT_FALSE(admit("space:full", 0, 2).value());
+  EXPECT_FALSE(admit("space:full", 0, 3).value());
+  // Beyond max_queued_analytic_queries
+  auto rejected = admit("space:full", 0, 4);
+  EXPECT_FALSE(rejected.ok());
+
+  release("space:full", 0);
+  release("space:full", 0);
+  release("space:full", 0);
+  // The query rejected never runs
+  EXPECT_EQ(std::vector<int32_t>({2, 3}), runs_);
+  // Not limited once the queue is drained
+  EXPECT_TRUE(admit("space:full", 0, 5).value());
+  release("space:full", 0);
+}
+
+TEST_F(AdmissionControllerTest, MemoryBudget) {
+  FLAGS_max_running_analytic_queries = 0;
+  FLAGS_analytic_query_memory_budget_mb = 100;
+  ASSERT_TRUE(AdmissionController::enabled());
+  constexpr int64_t kMiB = memory::MiB;
+  // A query runs anyway if none of its group is running, even beyond the budget
+  EXPECT_TRUE(admit("user:budget", 200 * kMiB, 1).value());
+  release("user:budget", 200 * kMiB);
+
+  EXPECT_TRUE(admit("user:budget", 60 * kMiB, 2).value());
+  EXPECT_TRUE(admit("user:budget", 40 * kMiB, 3).value());
+  EXPECT_FALSE(admit("user:budget", 50 * kMiB, 4).value());
+  // Not passing the one waiting before it, though it fits in the budget
+  EXPECT_FALSE(admit("user:budget", 0, 5).value());
+
+  // 40 MiB is running with the one of 50 MiB, and the next one fits as well
+  release("user:budget", 60 * kMiB);
+  EXPECT_EQ(std::vector<int32_t>({4, 5}), runs_);
+  release("user:budget", 40 * kMiB);
+  release("user:budget", 50 * kMiB);
+  release("user:budget", 0);
+}
+
+TEST_F(AdmissionControllerTest, ReleaseWakesSameGroup) {
+  FLAGS_max_running_analytic_queries = 1;
+  EXPECT_TRUE(admit("space:a", 0, 1).value());
+  EXPECT_FALSE(admit("space:a", 0, 2).value());
+  EXPECT_TRUE(admit("space:b", 0, 3).value());
+  EXPECT_FALSE(admit("space:b", 0, 4).value());
+
+  // Only the one waiting in the group released is woken
+  release("space:b", 0);
+  EXPECT_EQ(std::vector<int32_t>({4}), runs_);
+  release("space:a", 0);
+  EXPECT_EQ(std::vector<int32_t>({4, 2}), runs_);
+  release("space:a", 0);
+  release("space:b", 0);
+  EXPECT_EQ(std::vector<int32_t>({4, 2}), runs_);
+}
+
+}  // namespace graph
+}  // namespace nebula
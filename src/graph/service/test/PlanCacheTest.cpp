@@ -0,0 +1,220 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/executors/InlineExecutor.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/optimizer/Optimizer.h"
+#include "graph/planner/plan/Logic.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/service/PlanCache.h"
+#include "graph/service/QueryInstance.h"
+#include "graph/session/ClientSession.h"
+#include "parser/GQLParser.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanCacheTest : public ::testing::Test {
+ protected:
+  static constexpr char kQuery[] = "GO FROM \"1\" OVER e YIELD dst(edge) AS id";
+
+  void SetUp() override {
+    space_.name = "test_space";
+    space_.id = 1;
+    space_.spaceDesc.space_name_ref() = "test_space";
+  }
+
+  static std::unique_ptr<PlanCache::Entry> entryOf(int64_t metaVersion) {
+    auto entry = std::make_unique<PlanCache::Entry>();
+    entry->qctx = std::make_unique<QueryContext>();
+    entry->metaVersion = metaVersion;
+    return entry;
+  }
+
+  static bool cacheable(const std::string& query) {
+    QueryContext qctx;
+    auto result = GQLParser(&qctx).parse(query);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return result.ok() && PlanCache::cacheable(result.value().get());
+  }
+
+  // An entry of kQuery as cached after it's planned, the plan of which yields result
+  std::unique_ptr<PlanCache::Entry> planOf(DataSet result) {
+    auto entry = entryOf(1);
+    auto* qctx = entry->qctx.get();
+    auto parsed = GQLParser(qctx).parse(kQuery);
+    CHECK(parsed.ok()) << parsed.status();
+    entry->sentence = std::move(parsed).value();
+    qctx->vctx()->switchToSpace(space_);
+    auto* start = StartNode::make(qctx);
+    qctx->plan()->setRoot(ValueNode::make(qctx, start, std::move(result)));
+    entry->snapshot = qctx->ectx()->snapshot();
+    return entry;
+  }
+
+  std::shared_ptr<ClientSession> sessionOf(const std::string& user,
+                                           GraphSpaceID space,
+                                           meta::cpp2::RoleType role) {
+    meta::cpp2::Session session;
+    session.session_id_ref() = 1;
+    session.user_name_ref() = user;
+    auto clientSession = ClientSession::create(std::move(session), nullptr);
+    clientSession->setSpace(space_);
+    clientSession->setRole(space, role);
+    return clientSession;
+  }
+
+  // Run entry the way the query engine does on a hit, the executors run in the calling thread
+  ExecutionResponse runCached(PlanCache* cache,
+                              std::unique_ptr<PlanCache::Entry> entry,
+                              std::shared_ptr<ClientSession> session) {
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(std::move(session));
+    rctx->setQuery(kQuery);
+    rctx->setRunner(&folly::InlineExecutor::instance());
+    auto future = rctx->future();
+    entry->qctx->reuse(std::move(rctx));
+    // Deletes itself once finished
+    auto* instance = new QueryInstance(std::move(entry), &optimizer_, cache, kQuery);
+    instance->execute();
+    return std::move(future).get();
+  }
+
+  SpaceInfo space_;
+  opt::Optimizer optimizer_{std::vector<const opt::RuleSet*>{}};
+  // Restores the flags set by the tests
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(PlanCacheTest, HitAndMiss) {
+  PlanCache cache(16);
+  auto entry = entryOf(1);
+  auto* qctx = entry->qctx.get();
+  cache.put("q1", std::move(entry));
+  EXPECT_EQ(nullptr, cache.get("q2", 1));
+
+  // Taken out to run, the other runs miss until it's put back
+  entry = cache.get("q1", 1);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(qctx, entry->qctx.get());
+  EXPECT_EQ(nullptr, cache.get("q1", 1));
+  cache.put("q1", std::move(entry));
+  EXPECT_NE(nullptr, cache.get("q1", 1));
+}
+
+TEST_F(PlanCacheTest, MetaVersionChanged) {
+  PlanCache cache(16);
+  cache.put("q1", entryOf(1));
+  cache.put("q1", entryOf(2));
+  // The one made of the old meta data is dropped
+  auto entry = cache.get("q1", 2);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(2, entry->metaVersion);
+  EXPECT_EQ(nullptr, cache.get("q1", 2));
+  EXPECT_EQ(nullptr, cache.get("q1", 1));
+
+  cache.put("q1", entryOf(1));
+  EXPECT_EQ(nullptr, cache.get("q1", 2));
+  EXPECT_EQ(nullptr, cache.get("q1", 1));
+}
+
+TEST_F(PlanCacheTest, InstancesPerQuery) {
+  FLAGS_plan_cache_instances_per_query = 2;
+  PlanCache cache(16);
+  cache.put("q1", entryOf(1));
+  cache.put("q1", entryOf(1));
+  cache.put("q1", entryOf(1));
+  EXPECT_NE(nullptr, cache.get("q1", 1));
+  EXPECT_NE(nullptr, cache.get("q1", 1));
+  EXPECT_EQ(nullptr, cache.get("q1", 1));
+}
+
+TEST_F(PlanCacheTest, EvictLeastRecentlyUsed) {
+  PlanCache cache(2);
+  cache.put("q1", entryOf(1));
+  cache.put("q2", entryOf(1));
+  auto entry = cache.get("q1", 1);
+  ASSERT_NE(nullptr, entry);
+  cache.put("q1", std::move(entry));
+
+  // q2 is the least recently used
+  cache.put("q3", entryOf(1));
+  EXPECT_EQ(nullptr, cache.get("q2", 1));
+  EXPECT_NE(nullptr, cache.get("q1", 1));
+  EXPECT_NE(nullptr, cache.get("q3", 1));
+}
+
+TEST_F(PlanCacheTest, Cacheable) {
+  EXPECT_TRUE(cacheable("GO FROM \"1\" OVER e YIELD dst(edge) AS id"));
+  EXPECT_TRUE(cacheable("MATCH (v) WHERE id(v) == \"1\" RETURN v"));
+  EXPECT_TRUE(cacheable("GO FROM \"1\" OVER e YIELD dst(edge) AS id | LIMIT 1"));
+  EXPECT_TRUE(cacheable("$a = GO FROM \"1\" OVER e YIELD dst(edge) AS id; YIELD $a.id"));
+  // With side effects
+  EXPECT_FALSE(cacheable("INSERT VERTEX t(p) VALUES \"1\":(1)"));
+  EXPECT_FALSE(cacheable("USE s; GO FROM \"1\" OVER e YIELD dst(edge)"));
+  EXPECT_FALSE(
+      cacheable("GO FROM \"1\" OVER e YIELD dst(edge) AS id | DELETE VERTEX $-.id WITH EDGE"));
+  EXPECT_FALSE(cacheable("EXPLAIN GO FROM \"1\" OVER e YIELD dst(edge)"));
+}
+
+TEST_F(PlanCacheTest, RestoreVariables) {
+  // The variables of a plan reused are set again from the snapshot, no result of the last run
+  // leaks into the next one
+  QueryContext qctx;
+  auto* ectx = qctx.ectx();
+  ectx->setValue("param", Value(1));
+  ectx->initVar("a");
+  auto snapshot = ectx->snapshot();
+
+  ectx->setValue("a", Value(List({1, 2})));
+  ectx->setValue("a", Value(List({3})));
+  ectx->setValue("param", Value(2));
+  ectx->restore(snapshot);
+  EXPECT_TRUE(ectx->exist("a"));
+  EXPECT_EQ(0, ectx->numVersions("a"));
+  EXPECT_EQ(Value(1), ectx->getValue("param"));
+  EXPECT_EQ(1, ectx->numVersions("param"));
+}
+
+TEST_F(PlanCacheTest, MaxReuses) {
+  FLAGS_enable_authorize = true;
+  FLAGS_plan_cache_max_reuses = 3;
+  DataSet result({"id"});
+  result.emplace_back(Row({"2"}));
+  PlanCache cache(16);
+  auto session = sessionOf("guest", space_.id, meta::cpp2::RoleType::GUEST);
+
+  auto entry = planOf(result);
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_NE(nullptr, entry);
+    auto resp = runCached(&cache, std::move(entry), session);
+    EXPECT_EQ(ErrorCode::SUCCEEDED, resp.errorCode);
+    // Nothing of the last run is left in the plan reused
+    ASSERT_NE(nullptr, resp.data);
+    EXPECT_EQ(result, *resp.data);
+    entry = cache.get(kQuery, 1);
+  }
+  // Dropped after it's run plan_cache_max_reuses times
+  EXPECT_EQ(nullptr, entry);
+}
+
+TEST_F(PlanCacheTest, CheckPermissionOnHit) {
+  FLAGS_enable_authorize = true;
+  PlanCache cache(16);
+  // The user has no role on the space of the plan
+  auto session = sessionOf("other", space_.id + 1, meta::cpp2::RoleType::ADMIN);
+
+  auto resp = runCached(&cache, planOf(DataSet({"id"})), session);
+  EXPECT_EQ(ErrorCode::E_BAD_PERMISSION, resp.errorCode);
+  EXPECT_EQ(nullptr, resp.data);
+  // Not put back, as it fails
+  EXPECT_EQ(nullptr, cache.get(kQuery, 1));
+}
+
+}  // namespace graph
+}  // namespace nebula
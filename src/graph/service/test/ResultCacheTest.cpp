@@ -0,0 +1,94 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/service/ResultCache.h"
+
+namespace nebula {
+namespace graph {
+
+class ResultCacheTest : public ::testing::Test {
+ protected:
+  static std::shared_ptr<const DataSet> resultOf(int64_t value) {
+    DataSet ds({"a"});
+    ds.emplace_back(Row({value}));
+    return std::make_shared<const DataSet>(std::move(ds));
+  }
+
+  // Restores the flags set by the tests
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(ResultCacheTest, HitAndMiss) {
+  ResultCache cache(1024 * 1024);
+  GraphSpaceID space = 1;
+  auto version = cache.versionOf(space);
+  auto result = resultOf(1);
+  cache.put("q1", space, 10, version, result);
+
+  EXPECT_EQ(result, cache.get("q1", space, 10));
+  EXPECT_EQ(result, cache.get("q1", space, 10));
+  EXPECT_EQ(nullptr, cache.get("q2", space, 10));
+  // Another space
+  EXPECT_EQ(nullptr, cache.get("q1", 2, 10));
+  // The meta data changed, and the entry is dropped
+  EXPECT_EQ(nullptr, cache.get("q1", space, 11));
+  EXPECT_EQ(nullptr, cache.get("q1", space, 10));
+}
+
+TEST_F(ResultCacheTest, InvalidateByWrite) {
+  ResultCache cache(1024 * 1024);
+  auto version = cache.versionOf(1);
+  cache.put("q1", 1, 10, version, resultOf(1));
+  cache.put("q2", 2, 10, cache.versionOf(2), resultOf(2));
+
+  // A query which may write space 1 finished
+  cache.invalidate(1);
+  EXPECT_EQ(nullptr, cache.get("q1", 1, 10));
+  EXPECT_NE(nullptr, cache.get("q2", 2, 10));
+
+  // The query ran across the write, its result is not cached
+  cache.put("q1", 1, 10, version, resultOf(1));
+  EXPECT_EQ(nullptr, cache.get("q1", 1, 10));
+  cache.put("q1", 1, 10, cache.versionOf(1), resultOf(1));
+  EXPECT_NE(nullptr, cache.get("q1", 1, 10));
+}
+
+TEST_F(ResultCacheTest, Expire) {
+  ResultCache cache(1024 * 1024);
+  FLAGS_result_cache_ttl_ms = 0;
+  cache.put("q1", 1, 10, cache.versionOf(1), resultOf(1));
+  EXPECT_EQ(nullptr, cache.get("q1", 1, 10));
+
+  FLAGS_result_cache_ttl_ms = 3600 * 1000;
+  cache.put("q1", 1, 10, cache.versionOf(1), resultOf(1));
+  EXPECT_NE(nullptr, cache.get("q1", 1, 10));
+}
+
+TEST_F(ResultCacheTest, EvictLeastRecentlyUsed) {
+  // The keys are of the same size, so are the results
+  auto bytes = ResultCache::bytesOf(*resultOf(1)) + 2;
+  ResultCache cache(bytes * 2);
+  cache.put("q1", 1, 10, cache.versionOf(1), resultOf(1));
+  cache.put("q2", 1, 10, cache.versionOf(1), resultOf(2));
+  EXPECT_NE(nullptr, cache.get("q1", 1, 10));
+
+  // q2 is the least recently used
+  cache.put("q3", 1, 10, cache.versionOf(1), resultOf(3));
+  EXPECT_EQ(nullptr, cache.get("q2", 1, 10));
+  EXPECT_NE(nullptr, cache.get("q1", 1, 10));
+  EXPECT_NE(nullptr, cache.get("q3", 1, 10));
+
+  // Beyond the capacity by itself
+  ResultCache small(bytes - 1);
+  small.put("q1", 1, 10, small.versionOf(1), resultOf(1));
+  EXPECT_EQ(nullptr, small.get("q1", 1, 10));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -7,6 +7,7 @@
 #include "common/stats/StatsManager.h"
 #include "common/time/WallClock.h"
 #include "graph/context/QueryContext.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/stats/GraphStats.h"
 
 namespace nebula {
@@ -26,6 +27,7 @@ void ClientSession::charge() {
   folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
   idleDuration_.reset();
   session_.update_time_ref() = time::WallClock::fastNowInMicroSec();
+  dirty_ = true;
 }
 
 uint64_t ClientSession::idleSeconds() {
@@ -33,6 +35,18 @@ uint64_t ClientSession::idleSeconds() {
   return idleDuration_.elapsedInSec();
 }
 
+meta::cpp2::Session ClientSession::getSession() const {
+  folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+  auto session = session_;
+  for (const auto& [epId, qctx] : contexts_) {
+    auto query = session.queries_ref()->find(epId);
+    if (query != session.queries_ref()->end() && qctx->memoryTracker() != nullptr) {
+      query->second.memory_bytes_ref() = std::max<int64_t>(qctx->memoryTracker()->used(), 0);
+    }
+  }
+  return session;
+}
+
 void ClientSession::addQuery(QueryContext* qctx) {
   auto epId = qctx->plan()->id();
   meta::cpp2::QueryDesc queryDesc;
@@ -45,6 +59,7 @@ void ClientSession::addQuery(QueryContext* qctx) {
   folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
   contexts_.emplace(epId, qctx);
   session_.queries_ref()->emplace(epId, std::move(queryDesc));
+  dirty_ = true;
 }
 
 void ClientSession::deleteQuery(QueryContext* qctx) {
@@ -53,6 +68,7 @@ void ClientSession::deleteQuery(QueryContext* qctx) {
   folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
   contexts_.erase(epId);
   session_.queries_ref()->erase(epId);
+  dirty_ = true;
 }
 
 bool ClientSession::findQuery(nebula::ExecutionPlanID epId) const {
@@ -104,5 +120,65 @@ void ClientSession::markAllQueryKilled() {
         contexts_.size());
   }
 }
+int64_t ClientSession::addCursor(ResultCursor cursor) {
+  std::lock_guard<std::mutex> guard(cursorLock_);
+  expireCursors();
+  auto maxCursors = static_cast<size_t>(std::max(FLAGS_max_cursors_per_session, 1));
+  while (cursors_.size() >= maxCursors) {
+    auto idlest = std::max_element(cursors_.begin(), cursors_.end(), [](auto& lhs, auto& rhs) {
+      return lhs.second.idleDuration.elapsedInUSec() < rhs.second.idleDuration.elapsedInUSec();
+    });
+    VLOG(1) << "Close the idlest cursor " << idlest->first << " of session " << id();
+    cursors_.erase(idlest);
+  }
+  auto cursorId = nextCursorId_++;
+  cursor.idleDuration.reset();
+  cursors_.emplace(cursorId, std::move(cursor));
+  return cursorId;
+}
+
+StatusOr<ResultChunk> ClientSession::fetchCursor(int64_t cursorId, size_t num) {
+  std::lock_guard<std::mutex> guard(cursorLock_);
+  expireCursors();
+  auto iter = cursors_.find(cursorId);
+  if (iter == cursors_.end()) {
+    return Status::Error("Cursor %ld does not exist or has expired", cursorId);
+  }
+  auto& cursor = iter->second;
+  ResultChunk chunk;
+  chunk.data.colNames = cursor.colNames;
+  chunk.options = cursor.options;
+  num = std::min(num, cursor.rows.size());
+  chunk.data.rows.reserve(num);
+  for (size_t i = 0; i < num; i++) {
+    chunk.data.rows.emplace_back(std::move(cursor.rows.front()));
+    cursor.rows.pop_front();
+  }
+  chunk.hasMore = !cursor.rows.empty();
+  if (chunk.hasMore) {
+    cursor.idleDuration.reset();
+  } else {
+    cursors_.erase(iter);
+  }
+  return chunk;
+}
+
+void ClientSession::closeCursor(int64_t cursorId) {
+  std::lock_guard<std::mutex> guard(cursorLock_);
+  cursors_.erase(cursorId);
+}
+
+void ClientSession::expireCursors() {
+  auto timeout = static_cast<uint64_t>(FLAGS_cursor_idle_timeout_secs);
+  for (auto iter = cursors_.begin(); iter != cursors_.end();) {
+    if (iter->second.idleDuration.elapsedInSec() > timeout) {
+      VLOG(1) << "Cursor " << iter->first << " of session " << id() << " expired";
+      iter = cursors_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -5,8 +5,13 @@
 #ifndef GRAPH_SESSION_CLIENTSESSION_H_
 #define GRAPH_SESSION_CLIENTSESSION_H_
 
+#include <deque>
+
 #include "clients/meta/MetaClient.h"
+#include "common/datatypes/DataSet.h"
+#include "common/memory/MemoryTracker.h"
 #include "common/time/Duration.h"
+#include "interface/gen-cpp2/graph_types.h"
 #include "interface/gen-cpp2/meta_types.h"
 
 namespace nebula {
@@ -23,6 +28,24 @@ struct SpaceInfo {
   meta::cpp2::SpaceDesc spaceDesc;
 };
 
+// The rows of a result left for the client to fetch in chunks, which are released once fetched.
+struct ResultCursor {
+  std::vector<std::string> colNames;
+  std::deque<Row> rows;
+  // The options of the query, by which the chunks are returned
+  cpp2::ExecutionOptions options;
+  // When the idle time exceeds FLAGS_cursor_idle_timeout_secs, the cursor is closed.
+  time::Duration idleDuration;
+};
+
+// A chunk of the rows fetched from a cursor.
+struct ResultChunk {
+  DataSet data;
+  cpp2::ExecutionOptions options;
+  // Whether there are rows left in the cursor, which is closed if not
+  bool hasMore{false};
+};
+
 // ClientSession saves those information, including who created it, executed queries,
 // space role, etc. The information of session will be persisted in meta server.
 // One user corresponds to one ClientSession.
@@ -50,6 +73,7 @@ class ClientSession final {
       folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
       space_ = std::move(space);
       session_.space_name_ref() = space_.name;
+      dirty_ = true;
     }
   }
 
@@ -102,6 +126,21 @@ class ClientSession final {
   // Resets the idle time of the session.
   void charge();
 
+  // Whether the session needs to be updated to the meta server, i.e. it's changed since the last
+  // update or it's running queries, whose durations change. The change is cleared.
+  bool takeUpdate() {
+    folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+    bool dirty = dirty_;
+    dirty_ = false;
+    return dirty || !contexts_.empty();
+  }
+
+  // Marks the session changed again, e.g. when its update to the meta server failed.
+  void markDirty() {
+    folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+    dirty_ = true;
+  }
+
   int32_t getTimezone() const {
     folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
     return session_.get_timezone();
@@ -116,6 +155,7 @@ class ClientSession final {
     {
       folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
       session_.timezone_ref() = timezone;
+      dirty_ = true;
       // TODO: if support ngql to set client's timezone,
       //  need to update the timezone config to metad when timezone executor
     }
@@ -128,17 +168,22 @@ class ClientSession final {
         return;
       }
       session_.graph_addr_ref() = hostAddr;
+      dirty_ = true;
     }
   }
 
-  meta::cpp2::Session getSession() const {
-    folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
-    return session_;
+  // The session with the memory used by each query running
+  meta::cpp2::Session getSession() const;
+
+  // The memory tracker of the session, the parent of the trackers of its queries
+  const std::shared_ptr<memory::MemoryTrackerNode>& memoryTracker() const {
+    return memoryTracker_;
   }
 
   void updateSpaceName(const std::string& spaceName) {
     folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
     session_.space_name_ref() = spaceName;
+    dirty_ = true;
   }
 
   // Binds a query to the session.
@@ -160,6 +205,16 @@ class ClientSession final {
   // Marks all queries as killed.
   void markAllQueryKilled();
 
+  // Keeps the rows of a result for the client to fetch by the id returned.
+  // The least recently fetched cursor is closed if there are FLAGS_max_cursors_per_session.
+  int64_t addCursor(ResultCursor cursor);
+
+  // Takes the next num rows of a cursor.
+  // cursorId: returned by addCursor.
+  StatusOr<ResultChunk> fetchCursor(int64_t cursorId, size_t num);
+
+  void closeCursor(int64_t cursorId);
+
  private:
   ClientSession() = default;
 
@@ -170,6 +225,8 @@ class ClientSession final {
   // When the idle time exceeds FLAGS_session_idle_timeout_secs,
   // the session will expire and then be reclaimed.
   time::Duration idleDuration_;
+  // Whether session_ is changed since the last update to the meta server
+  bool dirty_{true};
   meta::cpp2::Session session_;            // The session object used in RPC.
   meta::MetaClient* metaClient_{nullptr};  // The client of the meta server.
   mutable folly::RWSpinLock rwSpinLock_;
@@ -181,6 +238,15 @@ class ClientSession final {
   // An ExecutionPlanID represents a query.
   // A QueryContext also represents a query.
   std::unordered_map<ExecutionPlanID, QueryContext*> contexts_;
+  std::shared_ptr<memory::MemoryTrackerNode> memoryTracker_{
+      std::make_shared<memory::MemoryTrackerNode>()};
+
+  // Close the cursors idle for longer than FLAGS_cursor_idle_timeout_secs, with cursorLock_ held
+  void expireCursors();
+
+  std::mutex cursorLock_;
+  int64_t nextCursorId_{1};
+  std::unordered_map<int64_t, ResultCursor> cursors_;
 };
 
 }  // namespace graph
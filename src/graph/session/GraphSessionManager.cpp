@@ -22,6 +22,12 @@ GraphSessionManager::GraphSessionManager(meta::MetaClient* metaClient, const Hos
       FLAGS_session_reclaim_interval_secs * 1000, &GraphSessionManager::threadFunc, this);
 }
 
+GraphSessionManager::~GraphSessionManager() {
+  for (auto& timer : expiryTimers_) {
+    thread::TimerWheel::instance().cancel(timer.second);
+  }
+}
+
 folly::Future<StatusOr<std::shared_ptr<ClientSession>>> GraphSessionManager::findSession(
     SessionID id, folly::Executor* runner) {
   auto sessionPtr = findSessionFromCache(id);
@@ -85,6 +91,7 @@ folly::Future<StatusOr<std::shared_ptr<ClientSession>>> GraphSessionManager::fin
         }
         std::string key = session.get_user_name() + session.get_client_ip();
         addSessionCount(key);
+        scheduleExpiry(id, FLAGS_session_idle_timeout_secs * 1000L);
 
         // update the space info to sessionPtr
         if (!spaceName.empty()) {
@@ -145,6 +152,7 @@ folly::Future<StatusOr<std::shared_ptr<ClientSession>>> GraphSessionManager::cre
         }
         std::string sessionKey = userName + clientIp;
         addSessionCount(sessionKey);
+        scheduleExpiry(sid, FLAGS_session_idle_timeout_secs * 1000L);
         updateSessionInfo(sessionPtr.get());
         return sessionPtr;
       }
@@ -182,8 +190,6 @@ void GraphSessionManager::threadFunc() {
       FLAGS_session_reclaim_interval_secs * 1000, &GraphSessionManager::threadFunc, this);
 }
 
-// TODO(dutor) Now we do a brute-force scanning, of course we could make it more
-// efficient.
 void GraphSessionManager::reclaimExpiredSessions() {
   DCHECK_GT(FLAGS_session_idle_timeout_secs, 0);
   if (FLAGS_session_idle_timeout_secs == 0) {
@@ -192,23 +198,31 @@ void GraphSessionManager::reclaimExpiredSessions() {
     return;
   }
 
-  if (activeSessions_.empty()) {
+  std::vector<SessionID> expiring;
+  expiring_->wlock()->swap(expiring);
+  if (expiring.empty()) {
     return;
   }
 
-  FVLOG3("Try to reclaim expired sessions out of %lu ones", activeSessions_.size());
+  FVLOG3("Try to reclaim expired sessions out of %lu ones", expiring.size());
   std::vector<SessionID> expiredSessions;
 
   // collect expired sessions
-  for (const auto& iter : activeSessions_) {
-    int32_t idleSecs = iter.second->idleSeconds();
-    VLOG(2) << "SessionId: " << iter.first << ", idleSecs: " << idleSecs;
+  for (auto id : expiring) {
+    auto iter = activeSessions_.find(id);
+    if (iter == activeSessions_.end()) {
+      continue;
+    }
+    int32_t idleSecs = iter->second->idleSeconds();
+    VLOG(2) << "SessionId: " << id << ", idleSecs: " << idleSecs;
     if (idleSecs < FLAGS_session_idle_timeout_secs) {
+      // Used since the timer was scheduled, so it's checked again when it would expire
+      scheduleExpiry(id, (FLAGS_session_idle_timeout_secs - idleSecs) * 1000L);
       continue;
     }
-    FLOG_INFO("ClientSession %ld has expired", iter.first);
+    FLOG_INFO("ClientSession %ld has expired", id);
 
-    expiredSessions.emplace_back(iter.first);
+    expiredSessions.emplace_back(id);
     // TODO: Disconnect the connection of the session
   }
 
@@ -217,44 +231,75 @@ void GraphSessionManager::reclaimExpiredSessions() {
     return;
   }
 
-  auto resp = metaClient_->removeSessions(std::move(expiredSessions)).get();
+  auto resp = metaClient_->removeSessions(expiredSessions).get();
   if (!resp.ok()) {
-    // TODO: Handle cases where the delete client failed
+    // Retried by the next reclaim
     LOG(ERROR) << "Remove session failed: " << resp.status();
+    auto retried = expiring_->wlock();
+    retried->insert(retried->end(), expiredSessions.begin(), expiredSessions.end());
     return;
   }
 
   auto killedSessions = resp.value().get_removed_session_ids();
   // Remove expired sessions from local cache
   removeSessionFromLocalCache(killedSessions);
+  // The ones not removed by the meta server are retried by the next reclaim
+  auto retried = expiring_->wlock();
+  for (auto id : expiredSessions) {
+    if (activeSessions_.find(id) != activeSessions_.end()) {
+      retried->emplace_back(id);
+    }
+  }
+}
+
+void GraphSessionManager::scheduleExpiry(SessionID id, int64_t delayMs) {
+  auto timer = thread::TimerWheel::instance().schedule(
+      std::max<int64_t>(delayMs, 0), [expiring = expiring_, id] {
+        expiring->wlock()->emplace_back(id);
+      });
+  expiryTimers_.insert_or_assign(id, timer);
 }
 
 void GraphSessionManager::updateSessionsToMeta() {
-  std::vector<meta::cpp2::Session> sessions;
-  {
-    if (activeSessions_.empty()) {
-      return;
+  if (activeSessions_.empty()) {
+    return;
+  }
+  // The sessions unchanged since the last update are skipped except in a full update, which finds
+  // the ones removed from the meta server by the others
+  auto fullRounds = std::max(FLAGS_session_full_update_rounds, 1);
+  bool fullUpdate = ++updateRounds_ % fullRounds == 0;
+  auto batchSize = static_cast<size_t>(std::max(FLAGS_session_update_batch_size, 1));
+
+  std::vector<std::vector<std::shared_ptr<ClientSession>>> batches;
+  std::vector<std::vector<meta::cpp2::Session>> sessionBatches;
+  for (auto& ses : activeSessions_) {
+    if (!ses.second->takeUpdate() && !fullUpdate) {
+      continue;
     }
-
-    for (auto& ses : activeSessions_) {
-      VLOG(3) << "Add Update session id: " << ses.second->getSession().get_session_id();
-      auto sessionCopy = ses.second->getSession();
-      for (auto& query : *sessionCopy.queries_ref()) {
-        query.second.duration_ref() =
-            time::WallClock::fastNowInMicroSec() - query.second.get_start_time();
-      }
-      sessions.emplace_back(std::move(sessionCopy));
+    VLOG(3) << "Add Update session id: " << ses.first;
+    auto sessionCopy = ses.second->getSession();
+    for (auto& query : *sessionCopy.queries_ref()) {
+      query.second.duration_ref() =
+          time::WallClock::fastNowInMicroSec() - query.second.get_start_time();
+    }
+    if (batches.empty() || batches.back().size() >= batchSize) {
+      batches.emplace_back();
+      sessionBatches.emplace_back();
+      batches.back().reserve(batchSize);
+      sessionBatches.back().reserve(batchSize);
     }
+    batches.back().emplace_back(ses.second);
+    sessionBatches.back().emplace_back(std::move(sessionCopy));
+  }
+  if (batches.empty()) {
+    return;
   }
+  VLOG(2) << "Update " << (batches.size() - 1) * batchSize + batches.back().size()
+          << " sessions to meta in " << batches.size() << " batches";
 
   // There may be expired queries, and the
   // expired queries will be killed here.
   auto handleKilledQueries = [this](auto&& resp) {
-    if (!resp.ok()) {
-      LOG(ERROR) << "Update sessions failed: " << resp.status();
-      return;
-    }
-
     auto& killedQueriesForEachSession = *resp.value().killed_queries_ref();
     for (auto& killedQueries : killedQueriesForEachSession) {
       auto sessionId = killedQueries.first;
@@ -276,22 +321,31 @@ void GraphSessionManager::updateSessionsToMeta() {
   // The response from meta contains sessions that are marked as killed, so we need to clean the
   // local cache and update statistics
   auto handleKilledSessions = [this](auto&& resp) {
-    if (!resp.ok()) {
-      LOG(ERROR) << "Update sessions failed: " << resp.status();
-      return;
-    }
-
     auto killSessions = resp.value().get_killed_sessions();
     removeSessionFromLocalCache(killSessions);
   };
 
-  auto result = metaClient_->updateSessions(sessions).get();
-  if (!result.ok()) {
-    LOG(ERROR) << "Update sessions failed: " << result.status();
-    return;
+  std::vector<folly::Future<StatusOr<meta::cpp2::UpdateSessionsResp>>> futures;
+  futures.reserve(sessionBatches.size());
+  for (const auto& sessions : sessionBatches) {
+    futures.emplace_back(metaClient_->updateSessions(sessions));
+  }
+  auto results = folly::collectAll(std::move(futures)).get();
+  for (size_t i = 0; i < results.size(); i++) {
+    auto& result = results[i];
+    if (result.hasException() || !result.value().ok()) {
+      LOG(ERROR) << "Update sessions failed: "
+                 << (result.hasException() ? result.exception().what().toStdString()
+                                           : result.value().status().toString());
+      // Retry them by the next update
+      for (auto& session : batches[i]) {
+        session->markDirty();
+      }
+      continue;
+    }
+    handleKilledQueries(result.value());
+    handleKilledSessions(result.value());
   }
-  handleKilledQueries(result);
-  handleKilledSessions(result);
 }
 
 void GraphSessionManager::updateSessionInfo(ClientSession* session) {
@@ -332,6 +386,7 @@ Status GraphSessionManager::init() {
     }
     addSessionCount(key);
     updateSessionInfo(sessionPtr.get());
+    scheduleExpiry(sessionId, (FLAGS_session_idle_timeout_secs - idleSecs) * 1000L);
     loadSessionCount++;
   }
   LOG(INFO) << "Total of " << loadSessionCount << " sessions are loaded";
@@ -347,6 +402,11 @@ void GraphSessionManager::removeSessionFromLocalCache(const std::vector<SessionI
     }
     auto sessionPtr = iter->second;
     activeSessions_.erase(iter);
+    auto timer = expiryTimers_.find(id);
+    if (timer != expiryTimers_.end()) {
+      thread::TimerWheel::instance().cancel(timer->second);
+      expiryTimers_.erase(id);
+    }
 
     // All queries on the session need to be marked as killed.
     sessionPtr->markAllQueryKilled();
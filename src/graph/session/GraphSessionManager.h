@@ -5,11 +5,14 @@
 #ifndef GRAPH_SESSION_GRAPHSESSIONMANAGER_H_
 #define GRAPH_SESSION_GRAPHSESSIONMANAGER_H_
 
+#include <folly/Synchronized.h>
+
 #include "clients/meta/MetaClient.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/session/SessionManager.h"
 #include "common/thread/GenericWorker.h"
+#include "common/thread/TimerWheel.h"
 #include "common/thrift/ThriftTypes.h"
 #include "graph/session/ClientSession.h"
 #include "interface/gen-cpp2/GraphService.h"
@@ -35,7 +38,7 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
   // metaClient: The client of the meta server.
   // hostAddr: The address of the current graph server.
   GraphSessionManager(meta::MetaClient* metaClient, const HostAddr& hostAddr);
-  ~GraphSessionManager() {}
+  ~GraphSessionManager();
 
   // Pulls sessions from the meta server and chooses its own sessions for management.
   Status init();
@@ -102,16 +105,34 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
   // All queries within the expired session will be marked as killed and stats will be updated.
   void removeSessionFromLocalCache(const std::vector<SessionID>& ids);
 
-  // Reclaims expired sessions.
+  // Reclaims expired sessions, out of the ones whose expiry timers have fired.
   // All queries within the expired session will be marked as killed.
   void reclaimExpiredSessions();
 
-  // Updates sessions into to meta server.
+  // Schedules the check of the expiry of the session after delayMs in the shared timer wheel,
+  // so the sessions aren't scanned for the expired ones.
+  // id: The id of the session.
+  // delayMs: Milliseconds from now when the session expires if it's not used.
+  void scheduleExpiry(SessionID id, int64_t delayMs);
+
+  // Updates sessions into to meta server, in batches of FLAGS_session_update_batch_size.
+  // Only the sessions changed or running queries are updated, except once every
+  // FLAGS_session_full_update_rounds.
   void updateSessionsToMeta();
 
   // Updates session info locally.
   // session: ClientSession which will be updated.
   void updateSessionInfo(ClientSession* session);
+
+  // The number of the updates to meta, accessed by the background thread only
+  int64_t updateRounds_{0};
+
+  // The sessions whose expiry timers have fired, checked by the next reclaim. They're shared with
+  // the timers, which only add to them.
+  std::shared_ptr<folly::Synchronized<std::vector<SessionID>>> expiring_{
+      std::make_shared<folly::Synchronized<std::vector<SessionID>>>()};
+  // The expiry timer of each session, cancelled when the session is removed
+  folly::ConcurrentHashMap<SessionID, uint64_t> expiryTimers_;
 };
 
 }  // namespace graph
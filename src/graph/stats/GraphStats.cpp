@@ -29,6 +29,10 @@ stats::CounterId kNumKilledQueries;
 stats::CounterId kNumQueriesHitMemoryWatermark;
 
 stats::CounterId kOptimizerLatencyUs;
+stats::CounterId kNumPlanCacheHits;
+stats::CounterId kNumResultCacheHits;
+stats::CounterId kNumQueuedAnalyticQueries;
+stats::CounterId kNumRejectedAnalyticQueries;
 
 stats::CounterId kNumAggregateExecutors;
 stats::CounterId kNumSortExecutors;
@@ -61,6 +65,12 @@ void initGraphStats() {
 
   kOptimizerLatencyUs = stats::StatsManager::registerHisto(
       "optimizer_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+  kNumPlanCacheHits = stats::StatsManager::registerStats("num_plan_cache_hits", "rate, sum");
+  kNumResultCacheHits = stats::StatsManager::registerStats("num_result_cache_hits", "rate, sum");
+  kNumQueuedAnalyticQueries =
+      stats::StatsManager::registerStats("num_queued_analytic_queries", "rate, sum");
+  kNumRejectedAnalyticQueries =
+      stats::StatsManager::registerStats("num_rejected_analytic_queries", "rate, sum");
 
   kNumAggregateExecutors =
       stats::StatsManager::registerStats("num_aggregate_executors", "rate, sum");
@@ -29,6 +29,10 @@ extern stats::CounterId kNumKilledQueries;
 extern stats::CounterId kNumQueriesHitMemoryWatermark;
 
 extern stats::CounterId kOptimizerLatencyUs;
+extern stats::CounterId kNumPlanCacheHits;
+extern stats::CounterId kNumResultCacheHits;
+extern stats::CounterId kNumQueuedAnalyticQueries;
+extern stats::CounterId kNumRejectedAnalyticQueries;
 
 // Executor
 extern stats::CounterId kNumAggregateExecutors;
@@ -12,6 +12,7 @@
 #include "common/expression/Expression.h"
 #include "common/expression/PropertyExpression.h"
 #include "common/function/AggFunctionManager.h"
+#include "graph/context/Iterator.h"
 #include "graph/context/QueryContext.h"
 #include "graph/context/QueryExpressionContext.h"
 #include "graph/visitor/FoldConstantExprVisitor.h"
@@ -99,6 +100,31 @@ std::vector<const Expression *> ExpressionUtils::collectAll(
   return std::move(visitor).results();
 }
 
+void ExpressionUtils::bindColumns(Expression *expr, const Iterator *iter) {
+  auto props =
+      collectAll(expr, {Expression::Kind::kInputProperty, Expression::Kind::kVarProperty});
+  // The columns of the other iterators are resolved on the first row as before
+  bool bindable = iter != nullptr && (iter->isSequentialIter() || iter->isPropIter());
+  for (auto *prop : props) {
+    auto *propExpr = static_cast<const PropertyExpression *>(prop);
+    std::optional<std::size_t> index;
+    if (bindable) {
+      auto found = iter->getColumnIndex(propExpr->prop());
+      if (found.ok()) {
+        index = found.value();
+      }
+    }
+    if (prop->kind() == Expression::Kind::kInputProperty) {
+      const_cast<InputPropertyExpression *>(static_cast<const InputPropertyExpression *>(prop))
+          ->bindPropIndex(index);
+    } else {
+      const_cast<VariablePropertyExpression *>(
+          static_cast<const VariablePropertyExpression *>(prop))
+          ->bindPropIndex(index);
+    }
+  }
+}
+
 bool ExpressionUtils::checkVarExprIfExist(const Expression *expr, const QueryContext *qctx) {
   auto vars = ExpressionUtils::collectAll(expr, {Expression::Kind::kVar});
   for (auto *var : vars) {
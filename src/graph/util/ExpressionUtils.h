@@ -28,6 +28,8 @@ class ObjectPool;
 
 namespace graph {
 
+class Iterator;
+
 class ExpressionUtils {
  public:
   explicit ExpressionUtils(...) = delete;
@@ -60,6 +62,11 @@ class ExpressionUtils {
   static std::vector<const Expression*> collectAll(
       const Expression* self, const std::unordered_set<Expression::Kind>& expected);
 
+  // Binds the input and variable properties of expr to the indexes of their columns in iter, so
+  // the columns are resolved once for each execution instead of cached from the previous one.
+  // Only the columns of the sequential and prop iterators are bound.
+  static void bindColumns(Expression* expr, const Iterator* iter);
+
   // Determines if the
   static bool checkVarExprIfExist(const Expression* expr, const QueryContext* qctx);
 
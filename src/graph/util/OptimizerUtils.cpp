@@ -7,6 +7,7 @@
 
 #include "common/base/Status.h"
 #include "common/datatypes/Value.h"
+#include "common/utils/IndexKeyUtils.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/util/ExpressionUtils.h"
 #include "graph/util/IndexUtil.h"
@@ -46,6 +47,9 @@ struct IndexResult {
   // expressions not used in all `ScoredColumnHint'
   std::vector<const Expression*> unusedExprs;
   std::vector<ScoredColumnHint> hints;
+  // whether the filter and the returned columns are all read from the index key, so storage
+  // doesn't fetch the base data of the keys filtered out, or of any key
+  bool covering{false};
 
   bool operator<(const IndexResult& rhs) const {
     if (hints.empty()) return true;
@@ -58,10 +62,50 @@ struct IndexResult {
         return false;
       }
     }
-    return hints.size() < rhs.hints.size();
+    if (hints.size() != rhs.hints.size()) {
+      return hints.size() < rhs.hints.size();
+    }
+    return !covering && rhs.covering;
   }
 };
 
+// Same as the columns decoded from the index key by storage, the string column may be truncated
+// in the key
+bool coveredByIndex(const Expression* condition,
+                    const std::vector<std::string>* returnColumns,
+                    const IndexItem& index) {
+  std::unordered_set<std::string> columns;
+  if (returnColumns != nullptr) {
+    columns.insert(returnColumns->begin(), returnColumns->end());
+  }
+  auto props = ExpressionUtils::collectAll(
+      condition, {ExprKind::kTagProperty, ExprKind::kEdgeProperty, ExprKind::kLabelTagProperty});
+  for (auto* prop : props) {
+    if (prop->kind() == ExprKind::kLabelTagProperty) {
+      columns.insert(static_cast<const LabelTagPropertyExpression*>(prop)->prop());
+    } else {
+      columns.insert(static_cast<const PropertyExpression*>(prop)->prop());
+    }
+  }
+  for (const auto& field : index.get_fields()) {
+    switch (field.get_type().get_type()) {
+      case nebula::cpp2::PropertyType::STRING:
+      case nebula::cpp2::PropertyType::FIXED_STRING:
+      case nebula::cpp2::PropertyType::GEOGRAPHY:
+        continue;
+      default:
+        if (IndexKeyUtils::isElementIndexColumn(field.get_type().get_type())) {
+          continue;
+        }
+        columns.erase(field.get_name());
+    }
+  }
+  for (const auto& col : {kVid, kTag, kSrc, kDst, kRank, kType}) {
+    columns.erase(col);
+  }
+  return columns.empty();
+}
+
 Status handleRangeIndex(const meta::cpp2::ColumnDef& field,
                         const Expression* expr,
                         const Value& value,
@@ -320,7 +364,9 @@ StatusOr<IndexResult> selectIndex(const Expression* expr, const IndexItem& index
 }  // namespace
 
 void OptimizerUtils::eraseInvalidIndexItems(
-    int32_t schemaId, std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>>* indexItems) {
+    int32_t schemaId,
+    std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>>* indexItems,
+    bool keepElementIndex) {
   // Erase invalid index items
   for (auto iter = indexItems->begin(); iter != indexItems->end();) {
     auto schema = (*iter)->get_schema_id();
@@ -328,16 +374,37 @@ void OptimizerUtils::eraseInvalidIndexItems(
       iter = indexItems->erase(iter);
     } else if (schema.edge_type_ref().has_value() && schema.get_edge_type() != schemaId) {
       iter = indexItems->erase(iter);
+    } else if (!keepElementIndex && isElementIndex(**iter)) {
+      iter = indexItems->erase(iter);
     } else {
       iter++;
     }
   }
 }
 
+bool OptimizerUtils::isElementIndex(const IndexItem& indexItem) {
+  const auto& fields = indexItem.get_fields();
+  if (fields.size() != 1) {
+    return false;
+  }
+  switch (fields[0].get_type().get_type()) {
+    case nebula::cpp2::PropertyType::LIST_STRING:
+    case nebula::cpp2::PropertyType::LIST_INT:
+    case nebula::cpp2::PropertyType::LIST_FLOAT:
+    case nebula::cpp2::PropertyType::SET_STRING:
+    case nebula::cpp2::PropertyType::SET_INT:
+    case nebula::cpp2::PropertyType::SET_FLOAT:
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool OptimizerUtils::findOptimalIndex(const Expression* condition,
                                       const std::vector<std::shared_ptr<IndexItem>>& indexItems,
                                       bool* isPrefixScan,
-                                      IndexQueryContext* ictx) {
+                                      IndexQueryContext* ictx,
+                                      const std::vector<std::string>* returnColumns) {
   // Return directly if there is no valid index to use.
   if (indexItems.empty()) {
     return false;
@@ -347,7 +414,9 @@ bool OptimizerUtils::findOptimalIndex(const Expression* condition,
   for (auto& index : indexItems) {
     auto resStatus = selectIndex(condition, *index);
     if (resStatus.ok()) {
-      results.emplace_back(std::move(resStatus).value());
+      auto result = std::move(resStatus).value();
+      result.covering = coveredByIndex(condition, returnColumns, *index);
+      results.emplace_back(std::move(result));
     }
   }
 
@@ -549,7 +618,7 @@ std::vector<IndexItemPtr> OptimizerUtils::allIndexesBySchema(graph::QueryContext
     const auto& schemaId = index->get_schema_id();
     // TODO (sky) : ignore rebuilding indexes
     auto id = isEdge ? schemaId.get_edge_type() : schemaId.get_tag_id();
-    if (id == node->schemaId()) {
+    if (id == node->schemaId() && !isElementIndex(*index)) {
       indexes.emplace_back(index);
     }
   }
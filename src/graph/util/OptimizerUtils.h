@@ -34,8 +34,16 @@ class OptimizerUtils {
 
   // Compare `a` and `b`, if `a`>`b` then swap a and b.That means `b`>=`a` after call this function.
   static Status compareAndSwapBound(std::pair<Value, bool> &a, std::pair<Value, bool> &b);
+  // Erase the indexes not on the given schema. The element indexes on LIST_* or SET_* properties
+  // only serve the IN predicates on the elements, so they are erased too unless keepElementIndex.
   static void eraseInvalidIndexItems(
-      int32_t schemaId, std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> *indexItems);
+      int32_t schemaId,
+      std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> *indexItems,
+      bool keepElementIndex = false);
+
+  // Whether the index is an element index on a LIST_* or SET_* property, which has an index key
+  // for every element of the property.
+  static bool isElementIndex(const nebula::meta::cpp2::IndexItem &indexItem);
 
   // Find optimal index according to filter expression and all valid indexes.
   //
@@ -63,11 +71,15 @@ class OptimizerUtils {
   // For logical `OR' condition expression, use above steps to generate
   // different `IndexQueryContext' for each operand of filter condition, nebula
   // storage will union all results of multiple index contexts
+  //
+  // Among the indexes of the same score, the one covering the props of condition and the
+  // returnColumns is preferred, so storage reads them from the index key only
   static bool findOptimalIndex(
       const Expression *condition,
       const std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> &indexItems,
       bool *isPrefixScan,
-      nebula::storage::cpp2::IndexQueryContext *ictx);
+      nebula::storage::cpp2::IndexQueryContext *ictx,
+      const std::vector<std::string> *returnColumns = nullptr);
 
   static bool relExprHasIndex(
       const Expression *expr,
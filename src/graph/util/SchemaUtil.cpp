@@ -8,6 +8,7 @@
 
 #include "common/base/Base.h"
 #include "common/base/Status.h"
+#include "common/utils/NeighborhoodAggregate.h"
 #include "graph/context/QueryContext.h"
 #include "graph/context/QueryExpressionContext.h"
 #include "graph/context/ast/CypherAstContext.h"
@@ -38,6 +39,9 @@ Status SchemaUtil::validateProps(const std::vector<SchemaPropItem *> &schemaProp
           status = setComment(schemaProp, schema);
           NG_RETURN_IF_ERROR(status);
           break;
+        case SchemaPropItem::MATERIALIZED:
+          NG_RETURN_IF_ERROR(setMaterialized(schemaProp, schema));
+          break;
       }
     }
 
@@ -48,6 +52,10 @@ Status SchemaUtil::validateProps(const std::vector<SchemaPropItem *> &schemaProp
         return Status::Error("Implicit ttl_col not support");
       }
     }
+    // The edges expired are not written, so they can't be taken off the aggregates
+    if (prop.materialized_ref().has_value() && prop.get_ttl_col() && !prop.get_ttl_col()->empty()) {
+      return Status::Error("Materialized aggregates not support ttl");
+    }
   }
 
   return Status::OK();
@@ -122,6 +130,37 @@ Status SchemaUtil::setComment(SchemaPropItem *schemaProp, meta::cpp2::Schema &sc
   return Status::OK();
 }
 
+// static
+Status SchemaUtil::setMaterialized(SchemaPropItem *schemaProp, meta::cpp2::Schema &schema) {
+  auto ret = schemaProp->getMaterialized();
+  NG_RETURN_IF_ERROR(ret);
+  auto aggregates = NeighborhoodAggregate::parse(ret.value());
+  NG_RETURN_IF_ERROR(aggregates);
+  for (const auto &aggregate : aggregates.value()) {
+    if (aggregate.kind() == NeighborhoodAggregate::Kind::kCount) {
+      continue;
+    }
+    auto &cols = *schema.columns_ref();
+    auto col = std::find_if(cols.begin(), cols.end(), [&aggregate](const auto &c) {
+      return c.name == aggregate.prop();
+    });
+    if (col == cols.end()) {
+      return Status::Error("Materialized column `%s' not found", aggregate.prop().c_str());
+    }
+    auto type = col->type.type;
+    if (aggregate.kind() == NeighborhoodAggregate::Kind::kSum &&
+        type != nebula::cpp2::PropertyType::INT64 && type != nebula::cpp2::PropertyType::INT32 &&
+        type != nebula::cpp2::PropertyType::INT16 && type != nebula::cpp2::PropertyType::INT8 &&
+        type != nebula::cpp2::PropertyType::FLOAT && type != nebula::cpp2::PropertyType::DOUBLE) {
+      return Status::Error("Materialized column `%s' of sum must be numeric",
+                           aggregate.prop().c_str());
+    }
+  }
+  schema.schema_prop_ref()->materialized_ref() =
+      NeighborhoodAggregate::toString(aggregates.value());
+  return Status::OK();
+}
+
 // static
 StatusOr<Value> SchemaUtil::toVertexID(Expression *expr, Value::Type vidType) {
   QueryExpressionContext ctx;
@@ -251,6 +290,11 @@ StatusOr<DataSet> SchemaUtil::toShowCreateSchema(bool isTag,
     createStr += *prop.comment_ref();
     createStr += "\"";
   }
+  if (prop.materialized_ref().has_value()) {
+    createStr += ", materialized = \"";
+    createStr += *prop.materialized_ref();
+    createStr += "\"";
+  }
   row.emplace_back(std::move(createStr));
   dataSet.rows.emplace_back(std::move(row));
   return dataSet;
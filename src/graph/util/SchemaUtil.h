@@ -43,6 +43,9 @@ class SchemaUtil final {
   // Sets Comment from shcemaProp into shcema.
   static Status setComment(SchemaPropItem* schemaProp, meta::cpp2::Schema& schema);
 
+  // Sets the aggregates materialized from schemaProp into schema, which are only of the edges.
+  static Status setMaterialized(SchemaPropItem* schemaProp, meta::cpp2::Schema& schema);
+
   // Calculates the vid value from expr.
   // If the result value type mismatches vidType, returns Status error.
   static StatusOr<Value> toVertexID(Expression* expr, Value::Type vidType);
@@ -11,7 +11,12 @@ namespace nebula::graph::util {
 folly::dynamic getStorageDetail(const std::map<std::string, int32_t>& profileDetail) {
   folly::dynamic profileData = folly::dynamic::object();
   for (auto& p : profileDetail) {
-    profileData.insert(p.first, folly::sformat("{}(us)", p.second));
+    // The rocksdb perf context of the request are counts rather than latencies
+    if (folly::StringPiece(p.first).startsWith("Rocksdb")) {
+      profileData.insert(p.first, p.second);
+    } else {
+      profileData.insert(p.first, folly::sformat("{}(us)", p.second));
+    }
   }
   return profileData;
 }
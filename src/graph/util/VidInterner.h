@@ -0,0 +1,126 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_VIDINTERNER_H_
+#define GRAPH_UTIL_VIDINTERNER_H_
+
+#include <robin_hood.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Maps the vids of a query to dense ids starting from 0, so the traversal keeps its frontier,
+// visited set and adjacency list in flat arrays indexed by id instead of hash tables keyed by
+// Value. The vids are interned once when the GetNeighbors response is read, and converted back only
+// when the result is built. Not thread safe, each executor has its own.
+class VidInterner final {
+ public:
+  using Id = uint32_t;
+
+  static constexpr Id kInvalidId = std::numeric_limits<Id>::max();
+
+  // Return the id of vid, a new one is assigned if it's not interned yet
+  Id intern(const Value& vid) {
+    auto found = ids_.find(vid);
+    if (found != ids_.end()) {
+      return found->second;
+    }
+    DCHECK_LT(vids_.size(), kInvalidId);
+    Id id = vids_.size();
+    vids_.emplace_back(vid);
+    ids_.emplace(vid, id);
+    return id;
+  }
+
+  // Return the id of vid, or kInvalidId if it's not interned
+  Id find(const Value& vid) const {
+    auto found = ids_.find(vid);
+    return found == ids_.end() ? kInvalidId : found->second;
+  }
+
+  const Value& vid(Id id) const {
+    DCHECK_LT(id, vids_.size());
+    return vids_[id];
+  }
+
+  size_t size() const {
+    return vids_.size();
+  }
+
+ private:
+  robin_hood::unordered_flat_map<Value, Id, std::hash<Value>> ids_;
+  std::vector<Value> vids_;
+};
+
+// A set of the ids of VidInterner, a bitmap for lookup and a vector of the ids in the order of
+// insertion for iteration. clear only resets the bits set, so it's cheap to reuse it every step.
+// As the ids are dense, the bitmap takes one bit per vid interned, much less than a hash set of
+// Value even without compression.
+class DenseIdSet final {
+ public:
+  using Id = VidInterner::Id;
+
+  // Return false if id is already in the set
+  bool insert(Id id) {
+    if (id >= bits_.size()) {
+      bits_.resize(std::max<size_t>(id + 1, bits_.size() * 2), false);
+    }
+    if (bits_[id]) {
+      return false;
+    }
+    bits_[id] = true;
+    ids_.emplace_back(id);
+    return true;
+  }
+
+  // Union other into the set
+  void merge(const DenseIdSet& other) {
+    for (auto id : other.ids_) {
+      insert(id);
+    }
+  }
+
+  bool contains(Id id) const {
+    return id < bits_.size() && bits_[id];
+  }
+
+  void clear() {
+    for (auto id : ids_) {
+      bits_[id] = false;
+    }
+    ids_.clear();
+  }
+
+  void swap(DenseIdSet& other) {
+    bits_.swap(other.bits_);
+    ids_.swap(other.ids_);
+  }
+
+  bool empty() const {
+    return ids_.empty();
+  }
+
+  size_t size() const {
+    return ids_.size();
+  }
+
+  std::vector<Id>::const_iterator begin() const {
+    return ids_.begin();
+  }
+
+  std::vector<Id>::const_iterator end() const {
+    return ids_.end();
+  }
+
+ private:
+  std::vector<bool> bits_;
+  std::vector<Id> ids_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_UTIL_VIDINTERNER_H_
@@ -7,6 +7,8 @@
 #include "common/expression/ArithmeticExpression.h"
 #include "common/expression/ConstantExpression.h"
 #include "common/expression/TypeCastingExpression.h"
+#include "graph/context/Iterator.h"
+#include "graph/context/QueryExpressionContext.h"
 #include "graph/util/ExpressionUtils.h"
 #include "parser/GQLParser.h"
 
@@ -827,5 +829,32 @@ TEST_F(ExpressionUtilsTest, simplifyLogicalExpr) {
   }
 }
 
+TEST_F(ExpressionUtilsTest, bindColumns) {
+  DataSet lhs({"a", "b"});
+  lhs.emplace_back(Row({1, 2}));
+  DataSet rhs({"b", "a"});
+  rhs.emplace_back(Row({3, 4}));
+  SequentialIter lhsIter(std::make_shared<Value>(std::move(lhs)));
+  SequentialIter rhsIter(std::make_shared<Value>(std::move(rhs)));
+  QueryExpressionContext ctx(qctx_->ectx());
+
+  auto *expr = ArithmeticExpression::makeAdd(pool,
+                                             InputPropertyExpression::make(pool, "b"),
+                                             VariablePropertyExpression::make(pool, "v", "a"));
+  ExpressionUtils::bindColumns(expr, &lhsIter);
+  EXPECT_EQ(Value(3), expr->eval(ctx(&lhsIter)));
+  // The columns cached from the previous iterator are bound again
+  ExpressionUtils::bindColumns(expr, &rhsIter);
+  EXPECT_EQ(Value(7), expr->eval(ctx(&rhsIter)));
+  // The columns not found are left to the evaluation
+  DataSet other({"c"});
+  other.emplace_back(Row({5}));
+  SequentialIter otherIter(std::make_shared<Value>(std::move(other)));
+  auto *prop = InputPropertyExpression::make(pool, "b");
+  ExpressionUtils::bindColumns(prop, &lhsIter);
+  ExpressionUtils::bindColumns(prop, &otherIter);
+  EXPECT_EQ(Value::kEmpty, prop->eval(ctx(&otherIter)));
+}
+
 }  // namespace graph
 }  // namespace nebula
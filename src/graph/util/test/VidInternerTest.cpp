@@ -0,0 +1,68 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/util/VidInterner.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(VidInternerTest, Intern) {
+  VidInterner interner;
+  EXPECT_EQ(0, interner.intern(Value("a")));
+  EXPECT_EQ(1, interner.intern(Value(1)));
+  EXPECT_EQ(2, interner.intern(Value("b")));
+  // the id of an interned vid doesn't change
+  EXPECT_EQ(0, interner.intern(Value("a")));
+  EXPECT_EQ(1, interner.intern(Value(1)));
+  EXPECT_EQ(3, interner.size());
+
+  EXPECT_EQ(2, interner.find(Value("b")));
+  EXPECT_EQ(VidInterner::kInvalidId, interner.find(Value("c")));
+  EXPECT_EQ(Value("a"), interner.vid(0));
+  EXPECT_EQ(Value(1), interner.vid(1));
+  EXPECT_EQ(Value("b"), interner.vid(2));
+}
+
+TEST(VidInternerTest, DenseIdSet) {
+  DenseIdSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.insert(5));
+  EXPECT_TRUE(set.insert(0));
+  EXPECT_FALSE(set.insert(5));
+  EXPECT_TRUE(set.insert(100));
+  EXPECT_EQ(3, set.size());
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_TRUE(set.contains(100));
+  EXPECT_FALSE(set.contains(1));
+  EXPECT_FALSE(set.contains(1000));
+  // iterated in the order of insertion
+  std::vector<DenseIdSet::Id> ids(set.begin(), set.end());
+  EXPECT_EQ((std::vector<DenseIdSet::Id>{5, 0, 100}), ids);
+
+  DenseIdSet other;
+  other.insert(7);
+  set.swap(other);
+  EXPECT_EQ(1, set.size());
+  EXPECT_TRUE(set.contains(7));
+  EXPECT_FALSE(set.contains(5));
+  EXPECT_TRUE(other.contains(5));
+
+  other.clear();
+  EXPECT_TRUE(other.empty());
+  EXPECT_FALSE(other.contains(5));
+  EXPECT_FALSE(other.contains(100));
+  EXPECT_TRUE(other.insert(100));
+
+  // merge keeps the ids already in the set
+  other.insert(3);
+  set.merge(other);
+  ids.assign(set.begin(), set.end());
+  EXPECT_EQ((std::vector<DenseIdSet::Id>{7, 100, 3}), ids);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -429,6 +429,17 @@ Status ShowPartsValidator::toPlan() {
   return Status::OK();
 }
 
+Status ShowHotPartsValidator::validateImpl() {
+  return Status::OK();
+}
+
+Status ShowHotPartsValidator::toPlan() {
+  auto *node = ShowHotParts::make(qctx_, nullptr, vctx_->whichSpace().id);
+  root_ = node;
+  tail_ = root_;
+  return Status::OK();
+}
+
 Status ShowCharsetValidator::validateImpl() {
   return Status::OK();
 }
@@ -666,6 +677,7 @@ Status ShowQueriesValidator::validateImpl() {
   outputs_.emplace_back("DurationInUSec", Value::Type::INT);
   outputs_.emplace_back("Status", Value::Type::STRING);
   outputs_.emplace_back("Query", Value::Type::STRING);
+  outputs_.emplace_back("MemoryInBytes", Value::Type::INT);
   return Status::OK();
 }
 
@@ -250,6 +250,17 @@ class ShowPartsValidator final : public Validator {
   Status toPlan() override;
 };
 
+class ShowHotPartsValidator final : public Validator {
+ public:
+  ShowHotPartsValidator(Sentence* sentence, QueryContext* context)
+      : Validator(sentence, context) {}
+
+ private:
+  Status validateImpl() override;
+
+  Status toPlan() override;
+};
+
 class ShowCharsetValidator final : public Validator {
  public:
   ShowCharsetValidator(Sentence* sentence, QueryContext* context) : Validator(sentence, context) {
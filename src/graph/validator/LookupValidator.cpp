@@ -7,6 +7,7 @@
 
 #include "common/base/Status.h"
 #include "common/meta/NebulaSchemaProvider.h"
+#include "common/utils/IndexKeyUtils.h"
 #include "graph/context/ast/QueryAstContext.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/util/Constants.h"
@@ -187,7 +188,10 @@ Status LookupValidator::validateWhere() {
       }
       filter = graph::ExpressionUtils::rewriteParameter(filter, qctx_);
     }
-    auto ret = checkFilter(filter);
+    // The element predicate is only pushed down to the element index as the whole filter
+    auto ret = isElementPredicate(filter)
+                   ? rewriteElementPredicate(static_cast<RelationalExpression*>(filter))
+                   : checkFilter(filter);
     NG_RETURN_IF_ERROR(ret);
     lookupCtx_->filter = std::move(ret).value();
     // Make sure the type of the rewritten filter expr is right
@@ -222,6 +226,9 @@ StatusOr<Expression*> LookupValidator::checkFilter(Expression* expr) {
   if (ExpressionUtils::isGeoIndexAcceleratedPredicate(expr)) {
     NG_RETURN_IF_ERROR(checkGeoPredicate(expr));
     return rewriteGeoPredicate(expr);
+  } else if (isElementPredicate(expr)) {
+    return Status::SemanticError("Expression %s is only supported as the whole filter",
+                                 expr->toString().c_str());
   } else if (expr->isRelExpr()) {
     // Only starts with can be pushed down as a range scan, so forbid other string-related relExpr
     if (expr->kind() == ExprKind::kRelREG || expr->kind() == ExprKind::kContains ||
@@ -409,6 +416,53 @@ StatusOr<Expression*> LookupValidator::rewriteGeoPredicate(Expression* expr) {
   return geoFuncExpr;
 }
 
+// Whether the expression is `value IN schema.col`, which tests the elements of a list or set
+bool LookupValidator::isElementPredicate(const Expression* expr) const {
+  return expr->kind() == ExprKind::kRelIn &&
+         static_cast<const RelationalExpression*>(expr)->right()->kind() ==
+             ExprKind::kLabelAttribute &&
+         static_cast<const RelationalExpression*>(expr)->left()->kind() !=
+             ExprKind::kLabelAttribute;
+}
+
+// Rewrite `value IN schema.col` of a list or set column.
+// Fold the value to a constant of the element type, rewrite attribute expression to fit semantic.
+StatusOr<Expression*> LookupValidator::rewriteElementPredicate(RelationalExpression* expr) {
+  auto* la = static_cast<LabelAttributeExpression*>(expr->right());
+  if (la->left()->name() != sentence()->from()) {
+    return Status::SemanticError("Schema name error: %s", la->left()->name().c_str());
+  }
+  auto* left = expr->left();
+  if (!ExpressionUtils::isEvaluableExpr(left, qctx_)) {
+    return Status::SemanticError("'%s' is not an evaluable expression.", left->toString().c_str());
+  }
+  std::string prop = la->right()->value().getStr();
+  auto schemaMgr = qctx_->schemaMng();
+  auto schema = lookupCtx_->isEdge ? schemaMgr->getEdgeSchema(spaceId(), schemaId())
+                                   : schemaMgr->getTagSchema(spaceId(), schemaId());
+  auto type = schema->getFieldType(prop);
+  if (type == nebula::cpp2::PropertyType::UNKNOWN) {
+    return Status::SemanticError("Invalid column: %s", prop.c_str());
+  }
+  if (!IndexKeyUtils::isElementIndexColumn(type)) {
+    return Status::SemanticError("Column %s is not a list or set", prop.c_str());
+  }
+  auto v = Expression::eval(left, QueryExpressionContext(qctx_->ectx())());
+  auto elemType = IndexKeyUtils::toValueType(type);
+  if (elemType == Value::Type::FLOAT && v.isInt()) {
+    v = v.toFloat();
+  }
+  if (v.type() != elemType) {
+    return Status::SemanticError("Column type error : %s", prop.c_str());
+  }
+  auto* pool = qctx_->objPool();
+  expr->setLeft(ConstantExpression::make(pool, std::move(v)));
+  auto propExpr = lookupCtx_->isEdge ? ExpressionUtils::rewriteLabelAttr2EdgeProp(la)
+                                     : ExpressionUtils::rewriteLabelAttr2TagProp(la);
+  expr->setRight(propExpr);
+  return expr;
+}
+
 // Check does constant expression could compare to given property.
 // \param expr constant expression
 // \param prop property name
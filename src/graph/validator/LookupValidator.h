@@ -42,6 +42,8 @@ class LookupValidator final : public Validator {
                                        const Expression::Kind kind);
   StatusOr<Expression*> rewriteRelExpr(RelationalExpression* expr);
   StatusOr<Expression*> rewriteGeoPredicate(Expression* expr);
+  bool isElementPredicate(const Expression* expr) const;
+  StatusOr<Expression*> rewriteElementPredicate(RelationalExpression* expr);
   Expression* reverseRelKind(RelationalExpression* expr);
   Expression* reverseGeoPredicate(Expression* expr);
 
@@ -165,6 +165,11 @@ Status CreateTagValidator::validateImpl() {
   if (pro != nullptr) {
     return Status::SemanticError("Has the same name `%s' in the SequentialSentences", name.c_str());
   }
+  for (auto *prop : sentence->getSchemaProps()) {
+    if (prop->getPropType() == SchemaPropItem::MATERIALIZED) {
+      return Status::SemanticError("Materialized aggregates are only of the edges");
+    }
+  }
   meta::cpp2::Schema schema;
   NG_RETURN_IF_ERROR(checkColName(sentence->columnSpecs()));
   NG_RETURN_IF_ERROR(validateColumns(sentence->columnSpecs(), schema));
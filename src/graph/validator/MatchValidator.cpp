@@ -11,6 +11,7 @@
 #include "common/expression/UnaryExpression.h"
 #include "graph/planner/match/MatchSolver.h"
 #include "graph/util/ExpressionUtils.h"
+#include "graph/util/SchemaUtil.h"
 #include "graph/visitor/DeduceAliasTypeVisitor.h"
 #include "graph/visitor/ExtractGroupSuiteVisitor.h"
 #include "graph/visitor/RewriteVisitor.h"
@@ -174,6 +175,10 @@ Status MatchValidator::buildPathExpr(const MatchPath *path,
       }
     }
     pathInfo.pathType = static_cast<Path::PathType>(pathType);
+    if (path->weightProp() != nullptr) {
+      NG_RETURN_IF_ERROR(validateWeightProp(*path->weightProp(), edgeInfos.front()));
+      pathInfo.weightProp = *path->weightProp();
+    }
   }
 
   auto *pathAlias = path->alias();
@@ -197,6 +202,30 @@ Status MatchValidator::buildPathExpr(const MatchPath *path,
   return Status::OK();
 }
 
+// The weight of shortestPath must be a numeric property of all edge types of the pattern
+Status MatchValidator::validateWeightProp(const std::string &prop, const EdgeInfo &edgeInfo) {
+  auto *sm = qctx_->schemaMng();
+  for (auto edgeType : edgeInfo.edgeTypes) {
+    auto schema = sm->getEdgeSchema(space_.id, std::abs(edgeType));
+    if (schema == nullptr) {
+      return Status::SemanticError("No schema found for edge type `%d'", edgeType);
+    }
+    auto *field = schema->field(prop);
+    if (field == nullptr) {
+      auto edgeName = sm->toEdgeName(space_.id, std::abs(edgeType));
+      return Status::SemanticError("The weight `%s' of shortestPath is not a property of `%s'",
+                                   prop.c_str(),
+                                   edgeName.ok() ? edgeName.value().c_str() : "");
+    }
+    auto type = SchemaUtil::propTypeToValueType(field->type());
+    if (type != Value::Type::INT && type != Value::Type::FLOAT) {
+      return Status::SemanticError("The weight `%s' of shortestPath must be a number",
+                                   prop.c_str());
+    }
+  }
+  return Status::OK();
+}
+
 // Build nodes information by match pattern.
 Status MatchValidator::buildNodeInfo(const MatchPath *path,
                                      std::vector<NodeInfo> &nodeInfos,
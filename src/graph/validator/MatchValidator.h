@@ -75,6 +75,8 @@ class MatchValidator final : public Validator {
                        Path &pathInfo,
                        std::unordered_map<std::string, AliasType> &aliasesGenerated);
 
+  Status validateWeightProp(const std::string &prop, const EdgeInfo &edgeInfo);
+
   Status combineAliases(std::unordered_map<std::string, AliasType> &curAliases,
                         const std::unordered_map<std::string, AliasType> &lastAliases) const;
 
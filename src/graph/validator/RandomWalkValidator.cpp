@@ -0,0 +1,71 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/validator/RandomWalkValidator.h"
+
+#include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/util/ValidateUtil.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+namespace graph {
+
+Status RandomWalkValidator::validateImpl() {
+  auto* rwSentence = static_cast<RandomWalkSentence*>(sentence_);
+  walkCtx_ = getContext<RandomWalkContext>();
+
+  NG_RETURN_IF_ERROR(validateStarts(rwSentence->from(), walkCtx_->from));
+  NG_RETURN_IF_ERROR(ValidateUtil::validateStep(rwSentence->step(), walkCtx_->steps));
+  if (walkCtx_->steps.steps() == 0) {
+    return Status::SemanticError("The steps of random walk should be greater than 0.");
+  }
+  NG_RETURN_IF_ERROR(ValidateUtil::validateOver(qctx_, rwSentence->over(), walkCtx_->over));
+  NG_RETURN_IF_ERROR(validateOptions(rwSentence->options()));
+
+  outputs_.emplace_back("walk", Value::Type::LIST);
+  walkCtx_->colNames = getOutColNames();
+  return Status::OK();
+}
+
+// Check the options {walks: <int>, p: <number>, q: <number>}, all of them are optional
+Status RandomWalkValidator::validateOptions(const Expression* options) {
+  if (options == nullptr) {
+    return Status::OK();
+  }
+  DCHECK_EQ(options->kind(), Expression::Kind::kMap);
+  QueryExpressionContext ctx(qctx_->ectx());
+  for (const auto& item : static_cast<const MapExpression*>(options)->items()) {
+    auto* expr = item.second;
+    if (!ExpressionUtils::isEvaluableExpr(expr, qctx_)) {
+      return Status::SemanticError("`%s' is not evaluable.", expr->toString().c_str());
+    }
+    auto val = expr->eval(ctx);
+    auto name = folly::toLowerAscii(item.first);
+    if (name == "walks") {
+      if (!val.isInt() || val.getInt() <= 0 ||
+          val.getInt() > static_cast<int64_t>(FLAGS_max_random_walks)) {
+        return Status::SemanticError("`walks: %s', expected an integer in [1, %u].",
+                                     expr->toString().c_str(),
+                                     FLAGS_max_random_walks);
+      }
+      walkCtx_->walks = val.getInt();
+    } else if (name == "p" || name == "q") {
+      auto weight = val.isInt() ? val.getInt() : val.isFloat() ? val.getFloat() : 0.0;
+      if (weight <= 0) {
+        return Status::SemanticError("`%s: %s', expected a positive number.",
+                                     item.first.c_str(),
+                                     expr->toString().c_str());
+      }
+      (name == "p" ? walkCtx_->p : walkCtx_->q) = weight;
+    } else {
+      return Status::SemanticError("Unknown option `%s' of random walk.", item.first.c_str());
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -30,6 +30,7 @@
 #include "graph/validator/MutateValidator.h"
 #include "graph/validator/OrderByValidator.h"
 #include "graph/validator/PipeValidator.h"
+#include "graph/validator/RandomWalkValidator.h"
 #include "graph/validator/ReportError.h"
 #include "graph/validator/SequentialValidator.h"
 #include "graph/validator/SetValidator.h"
@@ -73,6 +74,8 @@ std::unique_ptr<Validator> Validator::makeValidator(Sentence* sentence, QueryCon
       return std::make_unique<UseValidator>(sentence, context);
     case Sentence::Kind::kGetSubgraph:
       return std::make_unique<GetSubgraphValidator>(sentence, context);
+    case Sentence::Kind::kRandomWalk:
+      return std::make_unique<RandomWalkValidator>(sentence, context);
     case Sentence::Kind::kLimit:
       return std::make_unique<LimitValidator>(sentence, context);
     case Sentence::Kind::kOrderBy:
@@ -172,6 +175,8 @@ std::unique_ptr<Validator> Validator::makeValidator(Sentence* sentence, QueryCon
       return std::make_unique<ShowMetaLeaderValidator>(sentence, context);
     case Sentence::Kind::kShowParts:
       return std::make_unique<ShowPartsValidator>(sentence, context);
+    case Sentence::Kind::kShowHotParts:
+      return std::make_unique<ShowHotPartsValidator>(sentence, context);
     case Sentence::Kind::kShowCharset:
       return std::make_unique<ShowCharsetValidator>(sentence, context);
     case Sentence::Kind::kShowCollation:
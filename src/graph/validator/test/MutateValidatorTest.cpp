@@ -27,6 +27,19 @@ TEST_F(MutateValidatorTest, InsertVertexTest) {
     auto cmd = "INSERT VERTEX person(name, age) VALUES lower(\"TOM\"):(\"a\", 19);";
     ASSERT_TRUE(checkResult(cmd, {PK::kInsertVertices, PK::kStart}));
   }
+  // the consecutive inserts of the same props are planned as one
+  {
+    auto cmd =
+        "INSERT VERTEX person(name, age) VALUES \"A\":(\"a\", 19);"
+        "INSERT VERTEX person(name, age) VALUES \"B\":(\"b\", 20)";
+    ASSERT_TRUE(checkResult(cmd, {PK::kInsertVertices, PK::kStart}));
+  }
+  {
+    auto cmd =
+        "INSERT VERTEX person(name, age) VALUES \"A\":(\"a\", 19);"
+        "INSERT VERTEX IF NOT EXISTS person(name, age) VALUES \"B\":(\"b\", 20)";
+    ASSERT_TRUE(checkResult(cmd, {PK::kInsertVertices, PK::kInsertVertices, PK::kStart}));
+  }
 }
 
 TEST_F(MutateValidatorTest, InsertEdgeTest) {
@@ -492,12 +492,14 @@ void DeduceTypeVisitor::visit(AggregateExpression *expr) {
   if (!ok()) return;
   auto func = expr->name();
   std::transform(func.begin(), func.end(), func.begin(), ::toupper);
-  if ("COUNT" == func) {
+  if ("COUNT" == func || "APPROX_COUNT_DISTINCT" == func) {
     type_ = Value::Type::INT;
   } else if ("COLLECT" == func) {
     type_ = Value::Type::LIST;
   } else if ("COLLECT_SET" == func) {
     type_ = Value::Type::SET;
+  } else if ("APPROX_QUANTILES" == func) {
+    type_ = Value::Type::MAP;
   } else if ("AVG" == func || "SUM" == func) {
     type_ = Value::Type::FLOAT;
   } else if ("MAX" == func || "MIN" == func) {
@@ -681,9 +683,9 @@ void DeduceTypeVisitor::visit(PredicateExpression *expr) {
   if (type_ == Value::Type::NULLVALUE || type_ == Value::Type::__EMPTY__) {
     return;
   }
-  if (type_ != Value::Type::LIST) {
+  if (type_ != Value::Type::LIST && type_ != Value::Type::SET) {
     std::stringstream ss;
-    ss << "`" << expr->collection()->toString() << "', expected LIST, but was " << type_;
+    ss << "`" << expr->collection()->toString() << "', expected LIST or SET, but was " << type_;
     status_ = Status::SemanticError(ss.str());
     return;
   }
@@ -714,9 +716,9 @@ void DeduceTypeVisitor::visit(ListComprehensionExpression *expr) {
     return;
   }
 
-  if (type_ != Value::Type::LIST) {
+  if (type_ != Value::Type::LIST && type_ != Value::Type::SET) {
     std::stringstream ss;
-    ss << "`" << expr->collection()->toString() << "', expected LIST, but was " << type_;
+    ss << "`" << expr->collection()->toString() << "', expected LIST or SET, but was " << type_;
     status_ = Status::SemanticError(ss.str());
     return;
   }
@@ -737,9 +739,9 @@ void DeduceTypeVisitor::visit(ReduceExpression *expr) {
     return;
   }
 
-  if (type_ != Value::Type::LIST) {
+  if (type_ != Value::Type::LIST && type_ != Value::Type::SET) {
     std::stringstream ss;
-    ss << "`" << expr->collection()->toString() << "', expected LIST, but was " << type_;
+    ss << "`" << expr->collection()->toString() << "', expected LIST or SET, but was " << type_;
     status_ = Status::SemanticError(ss.str());
     return;
   }
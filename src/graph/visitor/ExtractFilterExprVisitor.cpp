@@ -498,9 +498,5 @@ void ExtractFilterExprVisitor::visit(LogicalExpression *expr) {
   return;
 }
 
-void ExtractFilterExprVisitor::visit(SubscriptRangeExpression *) {
-  canBePushed_ = false;
-}
-
 }  // namespace graph
 }  // namespace nebula
@@ -83,7 +83,6 @@ class ExtractFilterExprVisitor final : public ExprVisitorImpl {
   void visit(EdgeExpression *) override;
   void visit(LogicalExpression *) override;
   void visit(ColumnExpression *) override;
-  void visit(SubscriptRangeExpression *) override;
   void visit(UnaryExpression *) override;
 
  private:
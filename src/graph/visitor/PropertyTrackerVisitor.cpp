@@ -334,13 +334,26 @@ void PropertyTrackerVisitor::visit(FunctionCallExpression *expr) {
   static const std::unordered_set<std::string> ignoreFuncs = {
       "src", "dst", "type", "typeid", "id", "rank" /*, "length"*/};
 
+  // The functions read the tags of the vertex only, so none of the properties is fetched for them,
+  // e.g. match (v) return labels(v)
+  static const std::unordered_set<std::string> tagFuncs = {"labels", "tags"};
+
   auto funName = expr->name();
   std::transform(funName.begin(), funName.end(), funName.begin(), ::tolower);
   if (ignoreFuncs.find(funName) != ignoreFuncs.end()) {
     return;
   }
+  auto &args = expr->args()->args();
+  if (tagFuncs.find(funName) != tagFuncs.end() && args.size() == 1) {
+    auto kind = args.front()->kind();
+    if (kind == Expression::Kind::kInputProperty || kind == Expression::Kind::kVarProperty) {
+      auto &aliasName = static_cast<PropertyExpression *>(args.front())->prop();
+      propsUsed_.insertVertexProp(aliasName, unknownType_, nebula::kTag);
+      return;
+    }
+  }
 
-  for (auto *arg : expr->args()->args()) {
+  for (auto *arg : args) {
     arg->accept(this);
     if (!ok()) {
       break;
@@ -527,6 +527,13 @@ void PrunePropertiesVisitor::visit(CrossJoin *node) {
   if (!visitedPlanNode_.emplace(node).second) {
     return;
   }
+  // The filter embedded uses the properties of both branches
+  if (node->filter() != nullptr) {
+    status_ = extractPropsFromExpr(node->filter());
+    if (!status_.ok()) {
+      return;
+    }
+  }
   status_ = pruneBinaryBranch(node->dependencies());
 }
 
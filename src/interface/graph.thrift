@@ -86,6 +86,10 @@ struct ExecutionResponse {
     5: optional binary                  error_msg;
     6: optional PlanDescription         plan_desc;
     7: optional binary                  comment;        // Supplementary instruction
+    // The data encoded in columns instead of data, if ExecutionOptions asks for it
+    8: optional binary                  compact_data;
+    // The cursor to fetch the rest of the rows by fetchNext, if there are more than the fetch size
+    9: optional i64                     cursor_id;
 } (cpp.type = "nebula::ExecutionResponse", cpp.noncopyable)
 
 
@@ -98,9 +102,32 @@ struct AuthResponse {
 } (cpp.type = "nebula::AuthResponse", cpp.noncopyable)
 
 
+// The format of the data in the responses of the queries
+enum ResultFormat {
+    // The rows of the DataSet in data
+    ROWS        = 0,
+    // The DataSet encoded in columns with the dictionaries of the repeated values in compact_data
+    COLUMNAR    = 1,
+} (cpp.enum_strict)
+
+
+struct ExecutionOptions {
+    1: ResultFormat result_format = ResultFormat.ROWS,
+    // Compress the compact_data by LZ4 if it's large
+    2: bool         compress = false,
+    // Return at most so many rows, the rest are kept in a cursor for fetchNext if set
+    3: optional i32 fetch_size,
+    // Answer approximately by sampling the vertices and edges scanned and the sources of the
+    // traversals by the ratio in (0, 1), the counts and sums aggregated are scaled by it
+    4: optional double sample_ratio,
+}
+
+
 struct VerifyClientVersionResp {
     1: required common.ErrorCode error_code;
     2: optional binary           error_msg;
+    // The result formats supported by the server, only ROWS if not set
+    3: optional list<ResultFormat> result_formats;
 }
 
 
@@ -119,6 +146,12 @@ service GraphService {
     // Same as execute(), but response will be a json string
     binary executeJson(1: i64 sessionId, 2: binary stmt)
     binary executeJsonWithParameter(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
+    // Same as executeWithParameter(), but the data is returned in the format of the options
+    ExecutionResponse executeWithOptions(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap, 4: ExecutionOptions options)
+    // The next rows of the cursor of executeWithOptions, in the same options. The cursor is closed
+    // once its rows are all fetched, and cursor_id is not set in the response
+    ExecutionResponse fetchNext(1: i64 sessionId, 2: i64 cursorId, 3: i32 fetchSize)
+    oneway void closeCursor(1: i64 sessionId, 2: i64 cursorId)
     
     VerifyClientVersionResp verifyClientVersion(1: VerifyClientVersionReq req)
 }
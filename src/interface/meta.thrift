@@ -88,6 +88,8 @@ struct SchemaProp {
     1: optional i64      ttl_duration,
     2: optional binary   ttl_col,
     3: optional binary   comment,
+    // The aggregates of the edges of each vertex materialized, e.g. "count, sum(weight)"
+    4: optional binary   materialized,
 }
 
 struct Schema {
@@ -308,6 +310,27 @@ struct Correlativity {
     2: double             proportion,
 }
 
+// The distribution of some values, each field could be merged across the parts
+struct ValueStats {
+    // The number of values not null
+    1: i64                  values,
+    2: i64                  nulls,
+    // Registers of the HyperLogLog sketch of the distinct values
+    3: binary               ndv_sketch,
+    // Upper bounds of the equi-depth buckets in ascending order, with the values in each
+    4: list<common.Value>   bucket_bounds,
+    5: list<i64>            bucket_values,
+    // The most frequent values in descending order of frequency
+    6: list<common.Value>   top_values,
+    7: list<i64>            top_frequencies,
+}
+
+struct PropStats {
+    1: ValueStats           values,
+    // The elements of the values of LIST_* and SET_* properties
+    2: optional ValueStats  elements,
+}
+
 struct StatsItem {
     // The number of vertices of tagName
     1: map<binary, i64>
@@ -328,6 +351,12 @@ struct StatsItem {
     6: map<common.PartitionID, list<Correlativity>>
         (cpp.template = "std::unordered_map") negative_part_correlativity,
     7: JobStatus                              status,
+    // The stats of the properties of each tag by name, if stats_collect_props of storaged is set
+    8: optional map<binary, map<binary, PropStats>>
+        (cpp.template = "std::unordered_map") tag_props,
+    // The stats of the properties of each edge type by name, of the out edges
+    9: optional map<binary, map<binary, PropStats>>
+        (cpp.template = "std::unordered_map") edge_props,
 }
 
 // Graph space related operations.
@@ -546,6 +575,9 @@ struct HBResp {
     3: ClusterID        cluster_id,
     4: i64              last_update_time_in_ms,
     5: i32              meta_version,
+    // The spaces changed since the last update time loaded by the client, only set if they are
+    // all logged, otherwise the client reloads all the spaces
+    6: optional list<common.GraphSpaceID> changed_spaces,
 }
 
 enum HostRole {
@@ -566,6 +598,46 @@ struct PartitionList {
     1: list<common.PartitionID> part_list;
 }
 
+// A vertex accessed frequently, whose count is estimated by a count-min sketch and halved at each
+// heartbeat. The vid is in the key encoding, i.e. 8 bytes in little endian for an int vid
+struct HotVertex {
+    1: binary   vid,
+    2: i64      count,
+}
+
+// The access rates of a part on a storaged since its last heartbeat
+struct PartHotness {
+    1: common.GraphSpaceID  space_id,
+    2: common.PartitionID   part_id,
+    3: double               read_qps,
+    4: double               write_qps,
+    5: double               read_bytes_per_sec,
+    6: double               write_bytes_per_sec,
+    7: list<HotVertex>      hot_vertices,
+}
+
+// The hottest parts reported by a storaged, saved by metad
+struct HostHotParts {
+    1: i64                  report_time_ms,
+    2: list<PartHotness>    parts,
+}
+
+struct ListHotPartsReq {
+    1: common.GraphSpaceID      space_id,
+}
+
+struct HotPartItem {
+    1: common.HostAddr          host,
+    2: PartHotness              hotness,
+}
+
+struct ListHotPartsResp {
+    1: common.ErrorCode code,
+    2: common.HostAddr  leader,
+    // Sorted from the hottest
+    3: list<HotPartItem> parts,
+}
+
 struct HBReq {
     1: HostRole                 role,
     2: common.HostAddr          host,
@@ -579,6 +651,10 @@ struct HBReq {
     7: optional common.DirInfo  dir,
     // version of binary
     8: optional binary          version,
+    // The hottest parts of storaged
+    9: optional list<PartHotness> hot_parts,
+    // The last update time of the meta data loaded by the client
+    10: optional i64            last_update_time_in_ms,
 }
 
 // service(agent/metad/storaged/graphd) info
@@ -1080,6 +1156,8 @@ struct QueryDesc {
     // The session might transfer between query engines, but the query do not, we must
     // record which query engine the query belongs to
     5: common.HostAddr graph_addr,
+    // The memory used by the query, counted by the memory tracker of graphd
+    6: i64 memory_bytes = 0,
 }
 
 struct Session {
@@ -1233,6 +1311,7 @@ service MetaService {
 
     GetPartsAllocResp getPartsAlloc(1: GetPartsAllocReq req);
     ListPartsResp listParts(1: ListPartsReq req);
+    ListHotPartsResp listHotParts(1: ListHotPartsReq req);
 
     GetWorkerIdResp getWorkerId(1: GetWorkerIdReq req);
 
@@ -56,6 +56,8 @@ struct RaftLogEntry {
     1: ClusterID cluster;
     2: binary    log_str;
     3: TermID    log_term;
+    // Whether log_str is compressed, only sent to the peers support compression
+    4: bool      compressed = false;
 }
 
 struct AppendLogRequest {
@@ -78,6 +80,21 @@ struct AppendLogResponse {
     5: LogID            committed_log_id;
     6: LogID            last_matched_log_id;
     7: TermID           last_matched_log_term;
+    // Whether the peer accepts the compressed logs and snapshot rows
+    8: bool             support_compression = false;
+    // Whether the peer ingests the snapshot in sst files
+    9: bool             support_snapshot_files = false;
+}
+
+// The append log requests of different partitions to the same peer, at most one request of
+// each partition
+struct BatchAppendLogRequest {
+    1: list<AppendLogRequest> requests;
+}
+
+// The responses in the order of requests in BatchAppendLogRequest
+struct BatchAppendLogResponse {
+    1: list<AppendLogResponse> responses;
 }
 
 struct SendSnapshotRequest {
@@ -92,6 +109,13 @@ struct SendSnapshotRequest {
     9: i64          total_size;
     10: i64         total_count;
     11: bool        done;
+    // The compressed rows, rows is empty if it's set
+    12: optional binary compressed_rows;
+    // A chunk of the sst file of snapshot at file_offset, rows is empty if it's set. The file is
+    // ingested once the chunk of file_end is received, total_count is the number of files then.
+    13: optional binary file_chunk;
+    14: i64             file_offset = 0;
+    15: bool            file_end = false;
 }
 
 struct HeartbeatRequest {
@@ -113,11 +137,15 @@ struct HeartbeatResponse {
     5: LogID            committed_log_id;
     6: LogID            last_log_id;
     7: TermID           last_log_term;
+    // Whether the peer accepts the compressed logs and snapshot rows
+    8: bool             support_compression = false;
 }
 
 struct SendSnapshotResponse {
     1: common.ErrorCode error_code;
     2: TermID           current_term;
+    // Whether the peer accepts the compressed logs and snapshot rows
+    3: bool             support_compression = false;
 }
 
 struct GetStateRequest {
@@ -140,6 +168,7 @@ struct GetStateResponse {
 service RaftexService {
     AskForVoteResponse askForVote(1: AskForVoteRequest req);
     AppendLogResponse appendLog(1: AppendLogRequest req);
+    BatchAppendLogResponse batchAppendLog(1: BatchAppendLogRequest req);
     SendSnapshotResponse sendSnapshot(1: SendSnapshotRequest req);
     HeartbeatResponse heartbeat(1: HeartbeatRequest req) (thread = 'eb');
     GetStateResponse getState(1: GetStateRequest req);
@@ -25,6 +25,13 @@ struct RequestCommon {
     1: optional common.SessionID session_id,
     2: optional common.ExecutionPlanID plan_id,
     3: optional bool profile_detail,
+    // Whether the reads could be served by the followers not far behind the leader
+    4: optional bool follower_read,
+    // The span of the request in the W3C traceparent format, only set if it's traced
+    5: optional binary trace_parent,
+    // The ratio in (0, 1) of the vertices and edges kept by the scans, each of which is kept
+    // independently by the ratio, for the approximate queries
+    6: optional double sample_ratio,
 }
 
 struct PartitionResult {
@@ -41,6 +48,9 @@ struct ResponseCommon {
     // Query latency from storage service
     2: required i64                     latency_in_us,
     3: optional map<string,i32>         latency_detail_us,
+    // The suggested delay of the requests to the host to retry after, when the writes of some
+    // parts are stalled, i.e. failed with E_WRITE_STALLED
+    4: optional i64                     retry_after_ms,
 }
 
 
@@ -56,6 +66,8 @@ enum StatType {
     AVG = 3,
     MAX = 4,
     MIN = 5,
+    // The set of the distinct values, only for GetNeighbors
+    COLLECT_SET = 6,
 } (cpp.enum_strict)
 
 
@@ -163,6 +175,17 @@ struct TraverseSpec {
     //            when filter contains logicalOR expression
     //            bcz $^.player.age > 30 OR like.likeness > 80 can't filter data only by tag_Filter
     12: optional binary                         tag_filter,
+    // If true, only the stats of the vertices having any valid edge are returned, one row per
+    // vertex without the edges, so the aggregations over the edges of each vertex are done in
+    // storage. The stat_props must be given.
+    13: optional bool                           stats_only,
+    // A list of dst vertex properties to be returned in GetNeighborsResponse::dst_vertices, only
+    //   for the dsts led by the same host, the others are left to the caller to fetch. The
+    //   "_dst" of the edges must be returned by edge_props.
+    14: optional list<VertexProp>               dst_vertex_props,
+    // If true, the edges are returned in GetNeighborsResponse::edges in columns instead of the
+    //   edge columns of GetNeighborsResponse::vertices, which are left empty
+    15: optional bool                           flat_edges,
 }
 
 
@@ -181,6 +204,17 @@ struct GetNeighborsRequest {
 }
 
 
+// The edges of an edge column of GetNeighborsResponse::vertices in columns
+struct NeighborEdges {
+    // The edges of the i-th row of the vertices are in [offsets[i], offsets[i + 1]), so there
+    //   is one offset more than the rows
+    1: list<i32>                                offsets,
+    // One list per prop named by the edge column, the j-th value of which is the prop of the
+    //   j-th edge. It's empty if there is no edge
+    2: list<list<common.Value>>                 props,
+}
+
+
 struct GetNeighborsResponse {
     1: required ResponseCommon result,
     // The result will be returned in a dataset, which is in the following form
@@ -235,6 +269,12 @@ struct GetNeighborsResponse {
     //   "_expr:<alias1>:<alias2>:..."
     //
     2: optional common.DataSet vertices,
+    // The props of the dst vertices led by this host in the layout of GetPropResponse::props,
+    //   if TraverseSpec::dst_vertex_props is given. The dsts missing are not led by this host,
+    //   or have none of the tags
+    3: optional common.DataSet dst_vertices,
+    // One per edge column of the vertices in order, if TraverseSpec::flat_edges is true
+    4: optional list<NeighborEdges> edges,
 }
 /*
  * End of GetNeighbors section
@@ -247,12 +287,18 @@ struct GetDstBySrcRequest {
         (cpp.template = "std::unordered_map")   parts,
     3: list<common.EdgeType>                    edge_types,
     4: optional RequestCommon                   common,
+    // Number of steps to expand, the dsts of each step led by this host are expanded in place
+    5: optional i32                             steps = 1,
 }
 
 struct GetDstBySrcResponse {
     1: required ResponseCommon                  result,
-    // Only one dst column, each row is a dst
+    // Only one dst column, each row is a dst of the last step
     2: optional common.DataSet                  dsts,
+    // The dsts reached after the step of key not led by this host, they are left to the
+    // caller to expand the rest of the steps
+    3: optional map<i32, list<common.Value>>
+        (cpp.template = "std::unordered_map")   remote_dsts,
 }
 
 
@@ -569,6 +615,9 @@ struct LookupIndexRequest {
     6: optional i64                         limit,
     7: optional list<OrderBy>               order_by,
     8: optional list<StatProp>              stat_columns,
+    // Wait at most so long in milliseconds for the async indexes looked up to apply the writes
+    // before the request, 0 or absent means to read them without waiting
+    9: optional i64                         async_index_wait_ms,
 }
 
 
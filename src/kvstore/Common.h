@@ -9,6 +9,7 @@
 #include <folly/Function.h>
 #include <rocksdb/slice.h>
 
+#include <optional>
 #include <sstream>
 
 #include "common/base/Base.h"
@@ -45,6 +46,43 @@ class KVFilter {
                       GraphSpaceID spaceId,
                       const folly::StringPiece& key,
                       const folly::StringPiece& val) const = 0;
+
+  /**
+   * @brief The time in milliseconds the key expires at by its ttl, std::nullopt if never
+   *
+   * @param spaceId
+   * @param key
+   * @param val
+   * @return std::optional<int64_t>
+   */
+  virtual std::optional<int64_t> expireTime(GraphSpaceID spaceId,
+                                            const folly::StringPiece& key,
+                                            const folly::StringPiece& val) const {
+    UNUSED(spaceId);
+    UNUSED(key);
+    UNUSED(val);
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Rewrite the value of the key kept during compaction
+   *
+   * @param spaceId
+   * @param key
+   * @param val
+   * @param newVal The value rewritten
+   * @return true If the value is rewritten into newVal
+   */
+  virtual bool rewrite(GraphSpaceID spaceId,
+                       const folly::StringPiece& key,
+                       const folly::StringPiece& val,
+                       std::string* newVal) const {
+    UNUSED(spaceId);
+    UNUSED(key);
+    UNUSED(val);
+    UNUSED(newVal);
+    return false;
+  }
 };
 
 /**
@@ -261,6 +299,8 @@ inline std::ostream& operator<<(std::ostream& os, const Peers& peers) {
 using KV = std::pair<std::string, std::string>;
 using KVCallback = folly::Function<void(nebula::cpp2::ErrorCode code)>;
 using NewLeaderCallback = folly::Function<void(HostAddr nLeader)>;
+// Visit the value of the index-th key read, the value is only valid during the call
+using ValueVisitor = std::function<void(size_t index, folly::StringPiece value)>;
 
 /**
  * @brief folly::StringPiece to rocksdb::Slice
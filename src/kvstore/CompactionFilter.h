@@ -7,6 +7,7 @@
 #define KVSTORE_COMPACTIONFILTER_H_
 
 #include <rocksdb/compaction_filter.h>
+#include <rocksdb/table_properties.h>
 
 #include "common/base/Base.h"
 #include "common/time/WallClock.h"
@@ -32,23 +33,28 @@ class KVCompactionFilter final : public rocksdb::CompactionFilter {
       : spaceId_(spaceId), kvFilter_(std::move(kvFilter)) {}
 
   /**
-   * @brief whether remove the key during compaction
+   * @brief whether remove the key during compaction, the value of the key kept may be rewritten
    *
    * @param level Levels of key in rocksdb
    * @param key Rocksdb key
    * @param val Rocksdb val
-   * @return true Key will not be removed
-   * @return false Key will be removed
+   * @param newVal The value rewritten
+   * @param valueChanged Whether the value is rewritten
+   * @return true Key will be removed
+   * @return false Key will not be removed
    */
   bool Filter(int level,
               const rocksdb::Slice& key,
               const rocksdb::Slice& val,
-              std::string*,
-              bool*) const override {
-    return kvFilter_->filter(level,
-                             spaceId_,
-                             folly::StringPiece(key.data(), key.size()),
-                             folly::StringPiece(val.data(), val.size()));
+              std::string* newVal,
+              bool* valueChanged) const override {
+    folly::StringPiece k(key.data(), key.size());
+    folly::StringPiece v(val.data(), val.size());
+    if (kvFilter_->filter(level, spaceId_, k, v)) {
+      return true;
+    }
+    *valueChanged = kvFilter_->rewrite(spaceId_, k, v, newVal);
+    return false;
   }
 
   const char* Name() const override {
@@ -93,8 +99,137 @@ class KVCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
 
   virtual std::unique_ptr<KVFilter> createKVFilter() = 0;
 
+  GraphSpaceID spaceId() const {
+    return spaceId_;
+  }
+
+ private:
+  GraphSpaceID spaceId_;
+};
+
+/**
+ * @brief The user properties of a sst file about the ttl of its keys, the keys with ttl and the
+ * range of the time they expire at, by which the files of many keys expired are compacted
+ */
+struct TtlTableProperties {
+  static constexpr char kTtlKeys[] = "nebula.ttl.keys";
+  static constexpr char kMinExpireTime[] = "nebula.ttl.min_expire_ms";
+  static constexpr char kMaxExpireTime[] = "nebula.ttl.max_expire_ms";
+
+  int64_t ttlKeys{0};
+  int64_t minExpireTime{std::numeric_limits<int64_t>::max()};
+  int64_t maxExpireTime{std::numeric_limits<int64_t>::min()};
+
+  /**
+   * @brief Parse the properties of a sst file, std::nullopt if it has no key with ttl
+   */
+  static std::optional<TtlTableProperties> parse(const rocksdb::TableProperties& props) {
+    const auto& user = props.user_collected_properties;
+    auto keys = user.find(kTtlKeys);
+    auto minTime = user.find(kMinExpireTime);
+    auto maxTime = user.find(kMaxExpireTime);
+    if (keys == user.end() || minTime == user.end() || maxTime == user.end()) {
+      return std::nullopt;
+    }
+    TtlTableProperties ret;
+    ret.ttlKeys = folly::to<int64_t>(keys->second);
+    ret.minExpireTime = folly::to<int64_t>(minTime->second);
+    ret.maxExpireTime = folly::to<int64_t>(maxTime->second);
+    if (ret.ttlKeys <= 0) {
+      return std::nullopt;
+    }
+    return ret;
+  }
+
+  /**
+   * @brief The estimated number of keys expired at now, as the expire times are taken evenly
+   * distributed in the range
+   */
+  double expiredKeys(int64_t now) const {
+    if (now < minExpireTime) {
+      return 0;
+    }
+    if (now >= maxExpireTime) {
+      return ttlKeys;
+    }
+    return static_cast<double>(ttlKeys) * (now - minExpireTime) / (maxExpireTime - minExpireTime);
+  }
+};
+
+/**
+ * @brief Collect the TtlTableProperties of a sst file by the expire time of KVFilter
+ */
+class KVTtlPropertiesCollector final : public rocksdb::TablePropertiesCollector {
+ public:
+  KVTtlPropertiesCollector(GraphSpaceID spaceId, std::unique_ptr<KVFilter> kvFilter)
+      : spaceId_(spaceId), kvFilter_(std::move(kvFilter)) {}
+
+  rocksdb::Status AddUserKey(const rocksdb::Slice& key,
+                             const rocksdb::Slice& value,
+                             rocksdb::EntryType type,
+                             rocksdb::SequenceNumber,
+                             uint64_t) override {
+    if (type != rocksdb::kEntryPut) {
+      return rocksdb::Status::OK();
+    }
+    auto expireTime = kvFilter_->expireTime(spaceId_,
+                                            folly::StringPiece(key.data(), key.size()),
+                                            folly::StringPiece(value.data(), value.size()));
+    if (expireTime.has_value()) {
+      ++props_.ttlKeys;
+      props_.minExpireTime = std::min(props_.minExpireTime, *expireTime);
+      props_.maxExpireTime = std::max(props_.maxExpireTime, *expireTime);
+    }
+    return rocksdb::Status::OK();
+  }
+
+  rocksdb::Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    if (props_.ttlKeys > 0) {
+      properties->emplace(TtlTableProperties::kTtlKeys, folly::to<std::string>(props_.ttlKeys));
+      properties->emplace(TtlTableProperties::kMinExpireTime,
+                          folly::to<std::string>(props_.minExpireTime));
+      properties->emplace(TtlTableProperties::kMaxExpireTime,
+                          folly::to<std::string>(props_.maxExpireTime));
+    }
+    return rocksdb::Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    return {{TtlTableProperties::kTtlKeys, folly::to<std::string>(props_.ttlKeys)}};
+  }
+
+  const char* Name() const override {
+    return "KVTtlPropertiesCollector";
+  }
+
+ private:
+  GraphSpaceID spaceId_;
+  std::unique_ptr<KVFilter> kvFilter_;
+  TtlTableProperties props_;
+};
+
+/**
+ * @brief Build the KVTtlPropertiesCollector of each sst file by the filters of the compaction
+ * filter factory
+ */
+class KVTtlPropertiesCollectorFactory final : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  KVTtlPropertiesCollectorFactory(GraphSpaceID spaceId,
+                                  std::shared_ptr<KVCompactionFilterFactory> cfFactory)
+      : spaceId_(spaceId), cfFactory_(std::move(cfFactory)) {}
+
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context) override {
+    return new KVTtlPropertiesCollector(spaceId_, cfFactory_->createKVFilter());
+  }
+
+  const char* Name() const override {
+    return "KVTtlPropertiesCollectorFactory";
+  }
+
  private:
   GraphSpaceID spaceId_;
+  std::shared_ptr<KVCompactionFilterFactory> cfFactory_;
 };
 
 /**
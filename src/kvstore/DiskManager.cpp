@@ -12,11 +12,31 @@ namespace nebula {
 namespace kvstore {
 
 DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
-                         std::shared_ptr<thread::GenericWorker> bgThread)
+                         std::shared_ptr<thread::GenericWorker> bgThread,
+                         const std::vector<std::string>& coldPaths)
     : bgThread_(bgThread) {
   try {
     // atomic is not copy-constructible
     std::vector<std::atomic_uint64_t> freeBytes(dataPaths.size() + 1);
+    std::vector<std::atomic_uint64_t> coldFreeBytes(dataPaths.size() + 1);
+    for (auto& bytes : coldFreeBytes) {
+      bytes = std::numeric_limits<uint64_t>::max();
+    }
+    coldPaths_.resize(dataPaths.size());
+    for (size_t i = 0; i < coldPaths.size() && i < dataPaths.size(); i++) {
+      if (coldPaths[i].empty()) {
+        continue;
+      }
+      auto absolute = boost::filesystem::absolute(coldPaths[i]);
+      if (!boost::filesystem::exists(absolute) &&
+          !boost::filesystem::create_directories(absolute)) {
+        LOG(FATAL) << folly::sformat("Cold data path:{} does not exist, create failed.",
+                                     coldPaths[i]);
+      }
+      coldPaths_[i] = boost::filesystem::canonical(absolute);
+      coldFreeBytes[i] = boost::filesystem::space(coldPaths_[i]).available;
+    }
+    coldFreeBytes_ = std::move(coldFreeBytes);
     Paths* paths = new Paths();
     paths_.store(paths);
     size_t index = 0;
@@ -147,7 +167,10 @@ bool DiskManager::hasEnoughSpace(GraphSpaceID spaceId, PartitionID partId) const
   if (partIt == spaceIt->second.end()) {
     return false;
   }
-  return freeBytes_[partIt->second].load(std::memory_order_relaxed) >= FLAGS_minimum_reserved_bytes;
+  return freeBytes_[partIt->second].load(std::memory_order_relaxed) >=
+             FLAGS_minimum_reserved_bytes &&
+         coldFreeBytes_[partIt->second].load(std::memory_order_relaxed) >=
+             FLAGS_minimum_reserved_bytes;
 }
 
 void DiskManager::refresh() {
@@ -164,6 +187,19 @@ void DiskManager::refresh() {
       LOG(WARNING) << "Get filesystem info of " << paths->dataPaths_[i] << " failed";
     }
   }
+  for (size_t i = 0; i < coldPaths_.size(); i++) {
+    if (coldPaths_[i].empty()) {
+      continue;
+    }
+    boost::system::error_code ec;
+    auto info = boost::filesystem::space(coldPaths_[i], ec);
+    if (!ec) {
+      VLOG(2) << "Refresh filesystem info of " << coldPaths_[i];
+      coldFreeBytes_[i] = info.available;
+    } else {
+      LOG(WARNING) << "Get filesystem info of " << coldPaths_[i] << " failed";
+    }
+  }
 }
 
 }  // namespace kvstore
@@ -38,9 +38,12 @@ class DiskManager {
    *
    * @param dataPaths `data_path` in configuration
    * @param bgThread Background thread to refresh remaining spaces of each data path
+   * @param coldPaths The cold data paths of the data paths in the same order, an empty one if the
+   * data path has none. A part has enough space only if both of its paths have.
    */
   DiskManager(const std::vector<std::string>& dataPaths,
-              std::shared_ptr<thread::GenericWorker> bgThread = nullptr);
+              std::shared_ptr<thread::GenericWorker> bgThread = nullptr,
+              const std::vector<std::string>& coldPaths = {});
 
   ~DiskManager();
 
@@ -123,6 +126,10 @@ class DiskManager {
   std::atomic<Paths*> paths_;
   // free space available to a non-privileged process, in bytes
   std::vector<std::atomic_uint64_t> freeBytes_;
+  // canonical cold data path of each data path, empty if none
+  std::vector<boost::filesystem::path> coldPaths_;
+  // free bytes of each cold data path, the max if none
+  std::vector<std::atomic_uint64_t> coldFreeBytes_;
 
   // lock used to protect partPath_ and partIndex_
   std::mutex lock_;
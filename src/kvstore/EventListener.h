@@ -3,6 +3,11 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#ifndef KVSTORE_EVENTLISTENER_H_
+#define KVSTORE_EVENTLISTENER_H_
+
+#include <mutex>
+
 #include "common/base/Base.h"
 #include "rocksdb/db.h"
 #include "rocksdb/listener.h"
@@ -386,5 +391,42 @@ class EventListener : public rocksdb::EventListener {
   }
 };
 
+/**
+ * @brief WriteStallListener keeps the worst stall condition of the column families of a rocksdb,
+ * by which the writes are rejected rather than blocked once stopped
+ */
+class WriteStallListener : public rocksdb::EventListener {
+ public:
+  void OnStallConditionsChanged(const rocksdb::WriteStallInfo& info) override {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (info.condition.cur == rocksdb::WriteStallCondition::kNormal) {
+      conditions_.erase(info.cf_name);
+    } else {
+      conditions_[info.cf_name] = info.condition.cur;
+    }
+    auto worst = rocksdb::WriteStallCondition::kNormal;
+    for (const auto& entry : conditions_) {
+      if (entry.second == rocksdb::WriteStallCondition::kStopped) {
+        worst = rocksdb::WriteStallCondition::kStopped;
+        break;
+      }
+      worst = rocksdb::WriteStallCondition::kDelayed;
+    }
+    condition_ = worst;
+  }
+
+  rocksdb::WriteStallCondition condition() const {
+    return condition_.load();
+  }
+
+ private:
+  std::mutex lock_;
+  // The column families not in the normal condition
+  std::unordered_map<std::string, rocksdb::WriteStallCondition> conditions_;
+  std::atomic<rocksdb::WriteStallCondition> condition_{rocksdb::WriteStallCondition::kNormal};
+};
+
 }  // namespace kvstore
 }  // namespace nebula
+
+#endif  // KVSTORE_EVENTLISTENER_H_
@@ -0,0 +1,218 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/HotPartStats.h"
+
+#include <folly/hash/Hash.h>
+
+#include "common/time/WallClock.h"
+#include "common/utils/Types.h"
+
+DEFINE_bool(enable_hot_part_stats,
+            true,
+            "Whether to report the access rates of the hottest parts and their hottest vertices "
+            "to meta by the heartbeats");
+DEFINE_int32(hot_parts_report_num, 32, "The max number of the hottest parts reported by a host");
+DEFINE_int32(hot_vertices_per_part, 8, "The max number of the hottest vertices reported of a part");
+DEFINE_int32(hot_vertex_sample_interval,
+             8,
+             "One of the interval reads is counted for the hottest vertices");
+
+namespace nebula {
+namespace kvstore {
+
+void HotVertexSketch::add(GraphSpaceID spaceId,
+                          PartitionID partId,
+                          folly::StringPiece vid,
+                          uint32_t weight) {
+  auto key = candidateKey(spaceId, partId, vid);
+  uint64_t estimate = std::numeric_limits<uint64_t>::max();
+  auto slots = slotsOf(key);
+  for (size_t i = 0; i < kDepth; i++) {
+    uint64_t count = counts_[i][slots[i]].fetch_add(weight, std::memory_order_relaxed) + weight;
+    estimate = std::min(estimate, count);
+  }
+  if (estimate < threshold_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  candidates_[std::move(key)] = estimate;
+  if (candidates_.size() >= capacity_ * 2) {
+    prune();
+  }
+}
+
+uint64_t HotVertexSketch::estimate(GraphSpaceID spaceId,
+                                   PartitionID partId,
+                                   folly::StringPiece vid) const {
+  return estimate(candidateKey(spaceId, partId, vid));
+}
+
+uint64_t HotVertexSketch::estimate(folly::StringPiece key) const {
+  uint64_t estimate = std::numeric_limits<uint64_t>::max();
+  auto slots = slotsOf(key);
+  for (size_t i = 0; i < kDepth; i++) {
+    estimate = std::min<uint64_t>(estimate, counts_[i][slots[i]].load(std::memory_order_relaxed));
+  }
+  return estimate;
+}
+
+std::unordered_map<std::pair<GraphSpaceID, PartitionID>, std::vector<meta::cpp2::HotVertex>>
+HotVertexSketch::topAndDecay(size_t num) {
+  std::unordered_map<std::pair<GraphSpaceID, PartitionID>, std::vector<meta::cpp2::HotVertex>> ret;
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto& [key, count] : candidates_) {
+    // The candidate might be less hot than when it's added
+    count = estimate(key);
+    auto spaceId = *reinterpret_cast<const GraphSpaceID*>(key.data());
+    auto partId = *reinterpret_cast<const PartitionID*>(key.data() + sizeof(GraphSpaceID));
+    meta::cpp2::HotVertex vertex;
+    vertex.vid_ref() = key.substr(sizeof(GraphSpaceID) + sizeof(PartitionID));
+    vertex.count_ref() = static_cast<int64_t>(count);
+    ret[{spaceId, partId}].emplace_back(std::move(vertex));
+  }
+  for (auto& [part, vertices] : ret) {
+    std::sort(vertices.begin(), vertices.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.get_count() > rhs.get_count();
+    });
+    if (vertices.size() > num) {
+      vertices.resize(num);
+    }
+  }
+
+  for (auto& row : counts_) {
+    for (auto& count : row) {
+      count.store(count.load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+    }
+  }
+  for (auto iter = candidates_.begin(); iter != candidates_.end();) {
+    iter->second >>= 1;
+    if (iter->second == 0) {
+      iter = candidates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  threshold_.store(std::max<uint64_t>(threshold_.load(std::memory_order_relaxed) >> 1, 1),
+                   std::memory_order_relaxed);
+  return ret;
+}
+
+// static
+std::string HotVertexSketch::candidateKey(GraphSpaceID spaceId,
+                                          PartitionID partId,
+                                          folly::StringPiece vid) {
+  std::string key;
+  key.reserve(sizeof(GraphSpaceID) + sizeof(PartitionID) + vid.size());
+  key.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID))
+      .append(reinterpret_cast<const char*>(&partId), sizeof(PartitionID))
+      .append(vid.data(), vid.size());
+  return key;
+}
+
+// static
+std::array<size_t, HotVertexSketch::kDepth> HotVertexSketch::slotsOf(folly::StringPiece key) {
+  // The hashes of the rows are derived from two, which is as good for a count-min sketch
+  uint64_t h1 = std::hash<std::string_view>()(std::string_view(key.data(), key.size()));
+  uint64_t h2 = folly::hash::twang_mix64(h1) | 1;
+  std::array<size_t, kDepth> slots;
+  for (size_t i = 0; i < kDepth; i++) {
+    slots[i] = (h1 + i * h2) % kWidth;
+  }
+  return slots;
+}
+
+void HotVertexSketch::prune() {
+  std::vector<uint64_t> counts;
+  counts.reserve(candidates_.size());
+  for (const auto& [key, count] : candidates_) {
+    counts.emplace_back(count);
+  }
+  auto nth = counts.begin() + (capacity_ - 1);
+  std::nth_element(counts.begin(), nth, counts.end(), std::greater<uint64_t>());
+  auto threshold = *nth;
+  for (auto iter = candidates_.begin(); iter != candidates_.end();) {
+    if (iter->second < threshold) {
+      iter = candidates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  threshold_.store(threshold, std::memory_order_relaxed);
+}
+
+HotPartStats::HotPartStats()
+    : vertices_(static_cast<size_t>(std::max(FLAGS_hot_parts_report_num, 1)) *
+                std::max(FLAGS_hot_vertices_per_part, 1)) {}
+
+void HotPartStats::addKey(GraphSpaceID spaceId,
+                          PartitionID partId,
+                          size_t vIdLen,
+                          folly::StringPiece key) {
+  static thread_local uint32_t reads = 0;
+  auto interval = static_cast<uint32_t>(std::max(FLAGS_hot_vertex_sample_interval, 1));
+  if (++reads < interval) {
+    return;
+  }
+  reads = 0;
+  // The vid follows the part and the type in the tag keys and the edge prefixes
+  constexpr size_t kHeaderLen = sizeof(PartitionID);
+  if (key.size() < kHeaderLen + vIdLen) {
+    return;
+  }
+  auto type = static_cast<NebulaKeyType>(*reinterpret_cast<const uint32_t*>(key.data()) &
+                                         kTypeMask);
+  if (type != NebulaKeyType::kTag_ && type != NebulaKeyType::kEdge) {
+    return;
+  }
+  vertices_.add(spaceId, partId, key.subpiece(kHeaderLen, vIdLen), interval);
+}
+
+std::vector<meta::cpp2::PartHotness> HotPartStats::report(
+    const std::vector<std::pair<PartKey, PartAccessCounters::Snapshot>>& parts) {
+  auto now = time::WallClock::fastNowInMilliSec();
+  auto seconds = lastReportMs_ == 0 ? 0.0 : (now - lastReportMs_) / 1000.0;
+  lastReportMs_ = now;
+  auto vertices = vertices_.topAndDecay(std::max(FLAGS_hot_vertices_per_part, 0));
+
+  std::vector<meta::cpp2::PartHotness> ret;
+  std::unordered_map<PartKey, PartAccessCounters::Snapshot> counters;
+  for (const auto& [key, current] : parts) {
+    counters.emplace(key, current);
+    auto iter = lastCounters_.find(key);
+    if (seconds <= 0 || iter == lastCounters_.end()) {
+      continue;
+    }
+    const auto& last = iter->second;
+    if (current.reads == last.reads && current.writes == last.writes) {
+      continue;
+    }
+    meta::cpp2::PartHotness hotness;
+    hotness.space_id_ref() = key.first;
+    hotness.part_id_ref() = key.second;
+    hotness.read_qps_ref() = (current.reads - last.reads) / seconds;
+    hotness.write_qps_ref() = (current.writes - last.writes) / seconds;
+    hotness.read_bytes_per_sec_ref() = (current.readBytes - last.readBytes) / seconds;
+    hotness.write_bytes_per_sec_ref() = (current.writeBytes - last.writeBytes) / seconds;
+    auto vertexIter = vertices.find(key);
+    if (vertexIter != vertices.end()) {
+      hotness.hot_vertices_ref() = std::move(vertexIter->second);
+    }
+    ret.emplace_back(std::move(hotness));
+  }
+  // The parts removed are dropped
+  lastCounters_ = std::move(counters);
+
+  std::sort(ret.begin(), ret.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.get_read_qps() + lhs.get_write_qps() > rhs.get_read_qps() + rhs.get_write_qps();
+  });
+  if (ret.size() > static_cast<size_t>(std::max(FLAGS_hot_parts_report_num, 0))) {
+    ret.resize(FLAGS_hot_parts_report_num);
+  }
+  return ret;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
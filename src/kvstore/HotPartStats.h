@@ -0,0 +1,143 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_HOTPARTSTATS_H_
+#define KVSTORE_HOTPARTSTATS_H_
+
+#include <array>
+#include <atomic>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftTypes.h"
+#include "interface/gen-cpp2/meta_types.h"
+
+DECLARE_bool(enable_hot_part_stats);
+DECLARE_int32(hot_parts_report_num);
+DECLARE_int32(hot_vertices_per_part);
+DECLARE_int32(hot_vertex_sample_interval);
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief The access counters of a part, added by the reads and the writes of NebulaStore with
+ * relaxed atomic increments. The rates are the differences between the heartbeats.
+ *
+ * A read is a key got or a scan started, the bytes of the scans are unknown. A write is a batch
+ * committed, such as a put of many keys or an atomic op.
+ */
+struct PartAccessCounters {
+  struct Snapshot {
+    uint64_t reads{0};
+    uint64_t readBytes{0};
+    uint64_t writes{0};
+    uint64_t writeBytes{0};
+  };
+
+  void addRead(uint64_t num, uint64_t bytes) {
+    reads.fetch_add(num, std::memory_order_relaxed);
+    readBytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void addWrite(uint64_t num, uint64_t bytes) {
+    writes.fetch_add(num, std::memory_order_relaxed);
+    writeBytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  Snapshot snapshot() const {
+    Snapshot ret;
+    ret.reads = reads.load(std::memory_order_relaxed);
+    ret.readBytes = readBytes.load(std::memory_order_relaxed);
+    ret.writes = writes.load(std::memory_order_relaxed);
+    ret.writeBytes = writeBytes.load(std::memory_order_relaxed);
+    return ret;
+  }
+
+  std::atomic<uint64_t> reads{0};
+  std::atomic<uint64_t> readBytes{0};
+  std::atomic<uint64_t> writes{0};
+  std::atomic<uint64_t> writeBytes{0};
+};
+
+/**
+ * @brief The hottest vertices of a host, counted by a count-min sketch, whose errors are only
+ * overestimates. The vertices whose estimates reach the smallest of the top ones are kept aside as
+ * the candidates, so adding a vertex is lock free unless it's likely among the top.
+ *
+ * The counts are halved at each report so the recent accesses dominate.
+ */
+class HotVertexSketch final {
+ public:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kWidth = 1 << 12;
+
+  explicit HotVertexSketch(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  void add(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece vid, uint32_t weight = 1);
+
+  // The estimated count of the vertex
+  uint64_t estimate(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece vid) const;
+
+  /**
+   * @brief The hottest vertices of each part, at most num of a part and the hottest first, then
+   * halve the counts. Some increments racing with halving might be lost, which is fine for an
+   * estimate.
+   */
+  std::unordered_map<std::pair<GraphSpaceID, PartitionID>, std::vector<meta::cpp2::HotVertex>>
+  topAndDecay(size_t num);
+
+ private:
+  static std::string candidateKey(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece vid);
+
+  static std::array<size_t, kDepth> slotsOf(folly::StringPiece key);
+
+  uint64_t estimate(folly::StringPiece key) const;
+
+  // Keep the capacity_ largest candidates, and raise the threshold to the smallest of them
+  void prune();
+
+  const size_t capacity_;
+  std::array<std::array<std::atomic<uint32_t>, kWidth>, kDepth> counts_{};
+  // The estimate to become a candidate
+  std::atomic<uint64_t> threshold_{1};
+  std::mutex lock_;
+  std::unordered_map<std::string, uint64_t> candidates_;
+};
+
+/**
+ * @brief The hotness of the parts of a host, reported to meta by the heartbeats of storaged: the
+ * access rates of the hottest parts and their hottest vertices.
+ */
+class HotPartStats final {
+ public:
+  using PartKey = std::pair<GraphSpaceID, PartitionID>;
+
+  HotPartStats();
+
+  /**
+   * @brief Count the vertex of a tag key or an edge prefix read, the other keys are skipped. Only
+   * one of FLAGS_hot_vertex_sample_interval keys is counted, to keep it cheap.
+   */
+  void addKey(GraphSpaceID spaceId, PartitionID partId, size_t vIdLen, folly::StringPiece key);
+
+  /**
+   * @brief The rates of the parts since the last report, the hottest FLAGS_hot_parts_report_num
+   * parts are returned, nothing on the first report. Called by the heartbeat thread only.
+   *
+   * @param parts The counters of all parts on the host
+   */
+  std::vector<meta::cpp2::PartHotness> report(
+      const std::vector<std::pair<PartKey, PartAccessCounters::Snapshot>>& parts);
+
+ private:
+  HotVertexSketch vertices_;
+  int64_t lastReportMs_{0};
+  std::unordered_map<PartKey, PartAccessCounters::Snapshot> lastCounters_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_HOTPARTSTATS_H_
@@ -0,0 +1,155 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/IOScheduler.h"
+
+#include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
+#include "kvstore/stats/KVStats.h"
+
+DEFINE_int32(background_io_rate_limit,
+             0,
+             "Bandwidth of each data path shared by compaction, snapshot, ingest and rebuild index "
+             "in MB per second, 0 means each of them is limited by its own flags");
+DEFINE_int64(background_io_latency_target_us,
+             0,
+             "The background io is slowed down when the p99 latency of the foreground writes "
+             "exceeds it, 0 means not adaptive");
+
+namespace nebula {
+namespace kvstore {
+
+namespace {
+
+// Weights of IOClass, the compaction goes first otherwise the writes would be stalled
+constexpr std::array<int64_t, 4> kWeights = {8, 4, 2, 1};
+
+// The budget is not lower than 1/kMinRateRatio of background_io_rate_limit
+constexpr int64_t kMinRateRatio = 10;
+
+}  // namespace
+
+IOScheduler& IOScheduler::instance() {
+  static IOScheduler scheduler;
+  return scheduler;
+}
+
+int64_t IOScheduler::maxRate() const {
+  return static_cast<int64_t>(FLAGS_background_io_rate_limit) * 1024 * 1024;
+}
+
+void IOScheduler::addDisk(const std::string& path) {
+  if (FLAGS_background_io_rate_limit <= 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> g(lock_);
+  for (const auto& disk : disks_) {
+    if (disk->path == path) {
+      return;
+    }
+  }
+  auto disk = std::make_unique<Disk>(path);
+  disk->rate = maxRate();
+  disk->compaction.reset(rocksdb::NewGenericRateLimiter(maxRate()));
+  share(disk.get(), time::WallClock::fastNowInSec());
+  LOG(INFO) << "Background io of " << path << " is limited to " << FLAGS_background_io_rate_limit
+            << " MB/s";
+  disks_.emplace_back(std::move(disk));
+}
+
+IOScheduler::Disk* IOScheduler::diskOf(const std::string& path) {
+  std::lock_guard<std::mutex> g(lock_);
+  Disk* found = nullptr;
+  for (const auto& disk : disks_) {
+    // The longest data path the path is under
+    auto under = folly::StringPiece(path).startsWith(disk->path) &&
+                 (path.size() == disk->path.size() || path[disk->path.size()] == '/');
+    if (under && (found == nullptr || disk->path.size() > found->path.size())) {
+      found = disk.get();
+    }
+  }
+  return found;
+}
+
+void IOScheduler::consume(const std::string& path, IOClass ioClass, int64_t bytes) {
+  if (FLAGS_background_io_rate_limit <= 0 || bytes <= 0) {
+    return;
+  }
+  auto* disk = diskOf(path);
+  if (disk == nullptr) {
+    return;
+  }
+  auto index = static_cast<size_t>(ioClass);
+  auto now = time::WallClock::fastNowInSec();
+  if (disk->activeSec[index].exchange(now) < now - 1) {
+    // The class was idle, take its share immediately instead of waiting for adjust
+    share(disk, now);
+  }
+  while (bytes > 0) {
+    // The rate may change during the wait, the budget of one second is consumed at most each time
+    auto rate = std::max(disk->classRate[index].load(), int64_t(1));
+    auto toConsume = std::min(bytes, rate);
+    disk->limiters[index].consume(static_cast<double>(toConsume),  // toConsume
+                                  static_cast<double>(rate),       // rate
+                                  static_cast<double>(rate));      // burstSize
+    bytes -= toConsume;
+  }
+}
+
+std::shared_ptr<rocksdb::RateLimiter> IOScheduler::compactionLimiter(const std::string& path) {
+  if (FLAGS_background_io_rate_limit <= 0) {
+    return nullptr;
+  }
+  auto* disk = diskOf(path);
+  return disk == nullptr ? nullptr : disk->compaction;
+}
+
+void IOScheduler::share(Disk* disk, int64_t nowInSec) {
+  int64_t totalWeight = 0;
+  for (size_t i = 0; i < kNumIOClass; ++i) {
+    if (i == static_cast<size_t>(IOClass::kCompaction) || disk->activeSec[i] >= nowInSec - 1) {
+      totalWeight += kWeights[i];
+    }
+  }
+  auto rate = disk->rate.load();
+  for (size_t i = 0; i < kNumIOClass; ++i) {
+    // The idle classes get a share as if they were active, it's recomputed once they consume
+    auto active = i == static_cast<size_t>(IOClass::kCompaction) ||
+                  disk->activeSec[i] >= nowInSec - 1;
+    auto weight = active ? totalWeight : totalWeight + kWeights[i];
+    disk->classRate[i] = rate * kWeights[i] / weight;
+  }
+  disk->compaction->SetBytesPerSecond(
+      std::max(disk->classRate[static_cast<size_t>(IOClass::kCompaction)].load(), int64_t(1)));
+}
+
+void IOScheduler::adjust() {
+  if (FLAGS_background_io_rate_limit <= 0) {
+    return;
+  }
+  auto upper = maxRate();
+  auto lower = std::max(upper / kMinRateRatio, int64_t(1));
+  bool slow = false;
+  if (FLAGS_background_io_latency_target_us > 0) {
+    auto p99 = stats::StatsManager::readHisto(
+        kCommitLogLatencyUs, stats::StatsManager::TimeRange::FIVE_SECONDS, 99.0);
+    slow = p99.ok() && p99.value() > FLAGS_background_io_latency_target_us;
+  }
+  auto now = time::WallClock::fastNowInSec();
+  std::lock_guard<std::mutex> g(lock_);
+  for (auto& disk : disks_) {
+    auto rate = disk->rate.load();
+    // Decrease multiplicatively and increase additively, the foreground writes recover quickly
+    auto newRate = slow ? std::max(rate / 2, lower) : std::min(rate + upper / 10, upper);
+    if (newRate != rate) {
+      VLOG(1) << "Background io of " << disk->path << " is limited to " << newRate << " bytes/s";
+    }
+    disk->rate = newRate;
+    share(disk.get(), now);
+  }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
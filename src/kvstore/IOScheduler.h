@@ -0,0 +1,113 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_IOSCHEDULER_H
+#define KVSTORE_IOSCHEDULER_H
+
+#include <gtest/gtest_prod.h>
+#include <rocksdb/rate_limiter.h>
+
+#include "common/base/Base.h"
+#include "kvstore/RateLimiter.h"
+
+DECLARE_int32(background_io_rate_limit);
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief Background IO sharing the budget of a disk, in the order of priority
+ */
+enum class IOClass : uint8_t {
+  kCompaction = 0,
+  kIngest = 1,
+  kSnapshot = 2,
+  kRebuild = 3,
+};
+
+/**
+ * @brief The bandwidth of each data path shared by all background IO, the foreground writes are
+ * never throttled but take the rest of it.
+ *
+ * The budget of a disk is background_io_rate_limit, which is split between the classes of IO
+ * active in the last second by their weights, so a class runs at the full budget when it's the only
+ * one. The budget is halved when the p99 latency of the foreground writes exceeds
+ * background_io_latency_target_us, and grows back slowly if not. The compaction is throttled by the
+ * rocksdb rate limiter of the disk, the others call consume before they do IO.
+ */
+class IOScheduler {
+  FRIEND_TEST(IOSchedulerTest, ShareTest);
+  FRIEND_TEST(IOSchedulerTest, AdjustTest);
+
+ public:
+  static IOScheduler& instance();
+
+  /**
+   * @brief Add a data path as a disk, the IO of the paths under it shares its budget
+   *
+   * @param path Data path
+   */
+  void addDisk(const std::string& path);
+
+  /**
+   * @brief Consume the budget of the disk of path, wait until there is enough. Do nothing if
+   * background_io_rate_limit is not set or the path is not under any disk.
+   *
+   * @param path Path of the IO, usually the data root of an engine
+   * @param ioClass Class of the IO
+   * @param bytes Bytes to read or write
+   */
+  void consume(const std::string& path, IOClass ioClass, int64_t bytes);
+
+  /**
+   * @brief Rate limiter of the compaction of the disk of path
+   *
+   * @param path Data root of the engine
+   * @return std::shared_ptr<rocksdb::RateLimiter> nullptr if background_io_rate_limit is not set
+   * or the path is not under any disk
+   */
+  std::shared_ptr<rocksdb::RateLimiter> compactionLimiter(const std::string& path);
+
+  /**
+   * @brief Adapt the budget of disks to the foreground latency, and split the budget between the
+   * active classes of IO again. Called every second.
+   */
+  void adjust();
+
+ private:
+  static constexpr size_t kNumIOClass = 4;
+
+  struct Disk {
+    explicit Disk(std::string p) : path(std::move(p)) {}
+
+    std::string path;
+    // Budget in bytes per second of the disk
+    std::atomic<int64_t> rate{0};
+    // Budget of each class, split from the rate by adjust
+    std::array<std::atomic<int64_t>, kNumIOClass> classRate{};
+    // The last second the class consumed
+    std::array<std::atomic<int64_t>, kNumIOClass> activeSec{};
+    std::array<RateLimiter, kNumIOClass> limiters;
+    std::shared_ptr<rocksdb::RateLimiter> compaction;
+  };
+
+  IOScheduler() = default;
+
+  Disk* diskOf(const std::string& path);
+
+  /**
+   * @brief Split the rate of disk between the active classes, the compaction is always active
+   */
+  void share(Disk* disk, int64_t nowInSec);
+
+  int64_t maxRate() const;
+
+  std::mutex lock_;
+  std::vector<std::unique_ptr<Disk>> disks_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif
@@ -47,6 +47,15 @@ class WriteBatch {
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) = 0;
+
+  /**
+   * @brief Encode the operation of merge the operand into the value of key into write batch
+   *
+   * @param key Key to merge
+   * @param operand Operand merged by the merge operator of the engine
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode merge(folly::StringPiece key, folly::StringPiece operand) = 0;
 };
 
 /**
@@ -74,6 +83,15 @@ class KVEngine {
    */
   virtual const char* getWalRoot() const = 0;
 
+  /**
+   * @brief Retrieve the path of the cold sst files of kv engine
+   *
+   * @return std::string Cold data path of kv engine, empty if it has no cold data path
+   */
+  virtual std::string getColdDataRoot() const {
+    return "";
+  }
+
   /**
    * @brief return a WriteBatch object to do batch operation
    *
@@ -132,6 +150,27 @@ class KVEngine {
   virtual std::vector<Status> multiGet(const std::vector<std::string>& keys,
                                        std::vector<std::string>* values) = 0;
 
+  /**
+   * @brief Read a list of keys without copying the values, the value of each existing key is
+   * passed to the visitor in place
+   *
+   * @param keys Keys to read
+   * @param visitor Called with the index and the value of each existing key
+   * @return std::vector<Status> Result status of each key, if key[i] does not exist, the i-th value
+   * in return value would be Status::KeyNotFound
+   */
+  virtual std::vector<Status> multiGetView(const std::vector<std::string>& keys,
+                                           const ValueVisitor& visitor) {
+    std::vector<std::string> values;
+    auto status = multiGet(keys, &values);
+    for (size_t i = 0; i < status.size(); i++) {
+      if (status[i].ok()) {
+        visitor(i, values[i]);
+      }
+    }
+    return status;
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -274,6 +313,14 @@ class KVEngine {
   virtual nebula::cpp2::ErrorCode ingest(const std::vector<std::string>& files,
                                          bool verifyFileChecksum = false) = 0;
 
+  /**
+   * @brief Whether the writes are stopped by the engine, e.g. too many L0 files or pending
+   * compaction bytes of rocksdb, which would block the writes until the compactions catch up
+   */
+  virtual bool isWriteStopped() const {
+    return false;
+  }
+
   /**
    * @brief Set config option, only used in rocksdb
    *
@@ -310,6 +357,28 @@ class KVEngine {
    */
   virtual nebula::cpp2::ErrorCode compact() = 0;
 
+  /**
+   * @brief Compact the keys in [start, end], e.g. of a part
+   *
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode compactRange(const std::string& start, const std::string& end) {
+    UNUSED(start);
+    UNUSED(end);
+    return compact();
+  }
+
+  /**
+   * @brief Compact the ranges of the sst files whose keys are expired by ttl more than the ratio
+   *
+   * @param ratio Estimated keys expired of all in a file
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode compactExpired(double ratio) {
+    UNUSED(ratio);
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   /**
    * @brief Flush data in memtable into sst
    *
@@ -325,6 +394,18 @@ class KVEngine {
    */
   virtual nebula::cpp2::ErrorCode createCheckpoint(const std::string& checkpointPath) = 0;
 
+  /**
+   * @brief Write the data of a prefix into a sst file, for sending the snapshot in files
+   *
+   * @param path Path of the sst file
+   * @param prefix The prefix of keys to write
+   * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
+   * @return ErrorOr<nebula::cpp2::ErrorCode, int64_t> Count of keys written, the file is not
+   * created if there is no key
+   */
+  virtual ErrorOr<nebula::cpp2::ErrorCode, int64_t> writeSstFile(
+      const std::string& path, const std::string& prefix, const void* snapshot = nullptr) = 0;
+
   // For meta
   /**
    * @brief Backup the data of a table prefix, for meta backup
@@ -153,6 +153,35 @@ class KVStore {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) = 0;
 
+  /**
+   * @brief Read a list of keys without copying the values, the value of each existing key is
+   * passed to the visitor in place, such as decoding it by RowReader
+   *
+   * @param spaceId
+   * @param partId
+   * @param keys Keys to read
+   * @param visitor Called with the index and the value of each existing key
+   * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @return Return std::vector<Status> when succeeded: Result status of each key, if key[i] does
+   * not exist, the i-th value in return value would be Status::KeyNotFound. Return ErrorCode when
+   * failed
+   */
+  virtual std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> multiGetView(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      const std::vector<std::string>& keys,
+      const ValueVisitor& visitor,
+      bool canReadFromFollower = false) {
+    std::vector<std::string> values;
+    auto ret = multiGet(spaceId, partId, keys, &values, canReadFromFollower);
+    for (size_t i = 0; i < ret.second.size(); i++) {
+      if (ret.second[i].ok()) {
+        visitor(i, values[i]);
+      }
+    }
+    return ret;
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
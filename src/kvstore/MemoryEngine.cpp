@@ -0,0 +1,446 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/MemoryEngine.h"
+
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "common/fs/FileUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace kvstore {
+
+using fs::FileType;
+using fs::FileUtils;
+
+namespace {
+
+/**
+ * @brief The operations of a batch, applied to the engine at once when committed
+ */
+class MemoryWriteBatch : public WriteBatch {
+ public:
+  enum class Op : uint8_t {
+    kPut,
+    kRemove,
+    kRemoveRange,
+  };
+
+  struct Record {
+    Op op;
+    std::string first;
+    std::string second;
+  };
+
+  nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
+    records_.push_back({Op::kPut, key.str(), value.str()});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
+    records_.push_back({Op::kRemove, key.str(), ""});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
+    records_.push_back({Op::kRemoveRange, start.str(), end.str()});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // There is no merge operator in memory
+  nebula::cpp2::ErrorCode merge(folly::StringPiece, folly::StringPiece) override {
+    return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+  }
+
+  std::vector<Record>& records() {
+    return records_;
+  }
+
+ private:
+  std::vector<Record> records_;
+};
+
+}  // namespace
+
+MemoryEngine::MemoryEngine(GraphSpaceID spaceId,
+                           const std::string& dataPath,
+                           const std::string& walPath)
+    : KVEngine(spaceId), dataPath_(folly::stringPrintf("%s/nebula/%d", dataPath.c_str(), spaceId)) {
+  // set wal path as dataPath by default
+  if (walPath.empty()) {
+    walPath_ = dataPath_;
+  } else {
+    walPath_ = folly::stringPrintf("%s/nebula/%d", walPath.c_str(), spaceId);
+  }
+  if (FileUtils::fileType(dataPath_.c_str()) == FileType::NOTEXIST &&
+      !FileUtils::makeDir(dataPath_)) {
+    LOG(FATAL) << "makeDir " << dataPath_ << " failed";
+  }
+  LOG(INFO) << "Open the memory engine of space " << spaceId
+            << ", the parts will be rebuilt by raft";
+}
+
+std::unique_ptr<WriteBatch> MemoryEngine::startBatchWrite() {
+  return std::make_unique<MemoryWriteBatch>();
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                                       bool disableWAL,
+                                                       bool sync,
+                                                       bool wait) {
+  UNUSED(disableWAL);
+  UNUSED(sync);
+  UNUSED(wait);
+  auto* memoryBatch = dynamic_cast<MemoryWriteBatch*>(batch.get());
+  if (memoryBatch == nullptr) {
+    return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+  }
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  for (auto& record : memoryBatch->records()) {
+    switch (record.op) {
+      case MemoryWriteBatch::Op::kPut:
+        data_[std::move(record.first)] = std::move(record.second);
+        break;
+      case MemoryWriteBatch::Op::kRemove:
+        data_.erase(record.first);
+        break;
+      case MemoryWriteBatch::Op::kRemoveRange:
+        removeRangeLocked(record.first, record.second);
+        break;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+const void* MemoryEngine::GetSnapshot() {
+  folly::SharedMutex::ReadHolder guard(lock_);
+  return new Snapshot{data_};
+}
+
+void MemoryEngine::ReleaseSnapshot(const void* snapshot) {
+  delete static_cast<const Snapshot*>(snapshot);
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::get(const std::string& key,
+                                          std::string* value,
+                                          const void* snapshot) {
+  if (snapshot != nullptr) {
+    const auto& data = static_cast<const Snapshot*>(snapshot)->data;
+    auto iter = data.find(key);
+    if (iter == data.end()) {
+      return nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND;
+    }
+    *value = iter->second;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  folly::SharedMutex::ReadHolder guard(lock_);
+  auto iter = data_.find(key);
+  if (iter == data_.end()) {
+    return nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND;
+  }
+  *value = iter->second;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+std::vector<Status> MemoryEngine::multiGet(const std::vector<std::string>& keys,
+                                           std::vector<std::string>* values) {
+  std::vector<Status> ret;
+  ret.reserve(keys.size());
+  values->resize(keys.size());
+  folly::SharedMutex::ReadHolder guard(lock_);
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto iter = data_.find(keys[i]);
+    if (iter == data_.end()) {
+      ret.emplace_back(Status::KeyNotFound());
+    } else {
+      (*values)[i] = iter->second;
+      ret.emplace_back(Status::OK());
+    }
+  }
+  return ret;
+}
+
+std::vector<KV> MemoryEngine::collect(const Map& data,
+                                      const std::string& start,
+                                      const std::string& prefix) {
+  std::vector<KV> kvs;
+  for (auto iter = data.lower_bound(start);
+       iter != data.end() && folly::StringPiece(iter->first).startsWith(prefix);
+       ++iter) {
+    kvs.emplace_back(iter->first, iter->second);
+  }
+  return kvs;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::range(const std::string& start,
+                                            const std::string& end,
+                                            std::unique_ptr<KVIterator>* storageIter) {
+  std::vector<KV> kvs;
+  {
+    folly::SharedMutex::ReadHolder guard(lock_);
+    for (auto iter = data_.lower_bound(start); iter != data_.end() && iter->first < end; ++iter) {
+      kvs.emplace_back(iter->first, iter->second);
+    }
+  }
+  storageIter->reset(new MemoryIter(std::move(kvs)));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::prefix(const std::string& prefix,
+                                             std::unique_ptr<KVIterator>* storageIter,
+                                             const void* snapshot) {
+  if (snapshot != nullptr) {
+    const auto& data = static_cast<const Snapshot*>(snapshot)->data;
+    storageIter->reset(new MemoryIter(collect(data, prefix, prefix)));
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  folly::SharedMutex::ReadHolder guard(lock_);
+  storageIter->reset(new MemoryIter(collect(data_, prefix, prefix)));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::rangeWithPrefix(const std::string& start,
+                                                      const std::string& prefix,
+                                                      std::unique_ptr<KVIterator>* storageIter) {
+  folly::SharedMutex::ReadHolder guard(lock_);
+  storageIter->reset(new MemoryIter(collect(data_, start, prefix)));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
+  folly::SharedMutex::ReadHolder guard(lock_);
+  storageIter->reset(new MemoryIter(std::vector<KV>(data_.begin(), data_.end())));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::put(std::string key, std::string value) {
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  data_[std::move(key)] = std::move(value);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::multiPut(std::vector<KV> keyValues) {
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  for (auto& kv : keyValues) {
+    data_[std::move(kv.first)] = std::move(kv.second);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::remove(const std::string& key) {
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  data_.erase(key);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::multiRemove(std::vector<std::string> keys) {
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  for (const auto& key : keys) {
+    data_.erase(key);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::removeRange(const std::string& start,
+                                                  const std::string& end) {
+  std::unique_lock<folly::SharedMutex> guard(lock_);
+  removeRangeLocked(start, end);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void MemoryEngine::removeRangeLocked(const std::string& start, const std::string& end) {
+  if (start >= end) {
+    return;
+  }
+  data_.erase(data_.lower_bound(start), data_.lower_bound(end));
+}
+
+void MemoryEngine::addPart(PartitionID partId, const Peers& raftPeers) {
+  auto ret = put(NebulaKeyUtils::systemPartKey(partId), "");
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    partsNum_++;
+    CHECK_GE(partsNum_, 0);
+  }
+
+  if (!raftPeers.allNormalPeers()) {
+    put(NebulaKeyUtils::systemBalanceKey(partId), raftPeers.toString());
+  }
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::updatePart(PartitionID partId, const Peer& raftPeer) {
+  auto balanceKey = NebulaKeyUtils::systemBalanceKey(partId);
+  std::string val;
+  auto ret = get(balanceKey, &val);
+
+  Peers peers;
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    peers = Peers::fromString(val);
+  } else if (ret != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    LOG(INFO) << "Update part failed when get, partId=" << partId;
+    return ret;
+  }
+
+  peers.addOrUpdate(raftPeer);
+  if (peers.allNormalPeers()) {
+    return remove(balanceKey);
+  }
+  return put(balanceKey, peers.toString());
+}
+
+void MemoryEngine::removePart(PartitionID partId) {
+  auto code = multiRemove({NebulaKeyUtils::systemPartKey(partId),
+                           NebulaKeyUtils::systemBalanceKey(partId),
+                           NebulaKeyUtils::systemCommitKey(partId)});
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    partsNum_--;
+    CHECK_GE(partsNum_, 0);
+  }
+}
+
+std::vector<PartitionID> MemoryEngine::allParts() {
+  std::unique_ptr<KVIterator> iter;
+  std::vector<PartitionID> parts;
+  static const std::string prefixStr = NebulaKeyUtils::systemPrefix();
+  prefix(prefixStr, &iter);
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    if (NebulaKeyUtils::isSystemPart(key)) {
+      parts.emplace_back(*reinterpret_cast<const PartitionID*>(key.data()) >> 8);
+    }
+  }
+  return parts;
+}
+
+std::map<PartitionID, Peers> MemoryEngine::balancePartPeers() {
+  std::unique_ptr<KVIterator> iter;
+  std::map<PartitionID, Peers> partRaftPeers;
+  static const std::string prefixStr = NebulaKeyUtils::systemPrefix();
+  prefix(prefixStr, &iter);
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    if (NebulaKeyUtils::isSystemBalance(key)) {
+      PartitionID partId = *reinterpret_cast<const PartitionID*>(key.data()) >> 8;
+      partRaftPeers.emplace(partId, Peers::fromString(iter->val().toString()));
+    }
+  }
+  return partRaftPeers;
+}
+
+int32_t MemoryEngine::totalPartsNum() {
+  return partsNum_;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::ingest(const std::vector<std::string>& files,
+                                             bool verifyFileChecksum) {
+  std::vector<KV> kvs;
+  for (const auto& file : files) {
+    rocksdb::SstFileReader reader(rocksdb::Options{});
+    auto s = reader.Open(file);
+    if (s.ok() && verifyFileChecksum) {
+      s = reader.VerifyChecksum();
+    }
+    if (!s.ok()) {
+      LOG(WARNING) << "Ingest Failed: " << file << ", error: " << s.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      kvs.emplace_back(iter->key().ToString(), iter->value().ToString());
+    }
+    if (!iter->status().ok()) {
+      LOG(WARNING) << "Ingest Failed: " << file << ", error: " << iter->status().ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+  }
+  return multiPut(std::move(kvs));
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::setOption(const std::string& configKey,
+                                                const std::string& configValue) {
+  LOG(WARNING) << "The memory engine has no option " << configKey << "=" << configValue;
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::setDBOption(const std::string& configKey,
+                                                  const std::string& configValue) {
+  LOG(WARNING) << "The memory engine has no db option " << configKey << "=" << configValue;
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> MemoryEngine::getProperty(
+    const std::string& property) {
+  LOG(WARNING) << "The memory engine has no property " << property;
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+nebula::cpp2::ErrorCode MemoryEngine::createCheckpoint(const std::string& checkpointPath) {
+  LOG(INFO) << "Target checkpoint data path : " << checkpointPath;
+  if (fs::FileUtils::exist(checkpointPath) && !fs::FileUtils::remove(checkpointPath.data(), true)) {
+    LOG(WARNING) << "Remove exist checkpoint data dir failed: " << checkpointPath;
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  if (!FileUtils::makeDir(checkpointPath)) {
+    LOG(WARNING) << "Make dir " << checkpointPath << " failed";
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  // Write a snapshot, so the writes are not blocked while the file is written
+  auto* snapshot = GetSnapshot();
+  SCOPE_EXIT {
+    ReleaseSnapshot(snapshot);
+  };
+  auto ret = writeSstFile(folly::stringPrintf("%s/data.sst", checkpointPath.c_str()), "", snapshot);
+  if (!ok(ret)) {
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, int64_t> MemoryEngine::writeSstFile(const std::string& path,
+                                                                    const std::string& prefix,
+                                                                    const void* snapshot) {
+  std::unique_ptr<KVIterator> iter;
+  auto ret = this->prefix(prefix, &iter, snapshot);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  if (!iter->valid()) {
+    return 0;
+  }
+
+  rocksdb::SstFileWriter sstFileWriter(rocksdb::EnvOptions(), rocksdb::Options());
+  auto s = sstFileWriter.Open(path);
+  int64_t count = 0;
+  for (; s.ok() && iter->valid(); iter->next()) {
+    auto key = iter->key();
+    auto val = iter->val();
+    s = sstFileWriter.Put(rocksdb::Slice(key.data(), key.size()),
+                          rocksdb::Slice(val.data(), val.size()));
+    ++count;
+  }
+  if (s.ok()) {
+    s = sstFileWriter.Finish();
+  }
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to write the sst file " << path << ", error: " << s.ToString();
+    unlink(path.c_str());
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  return count;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> MemoryEngine::backupTable(
+    const std::string& path,
+    const std::string& tablePrefix,
+    std::function<bool(const folly::StringPiece& key)> filter) {
+  UNUSED(filter);
+  // The tables are of meta, whose engine is never in memory
+  LOG(WARNING) << "The memory engine doesn't backup the table " << tablePrefix << " to " << path;
+  return nebula::cpp2::ErrorCode::E_BACKUP_FAILED;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
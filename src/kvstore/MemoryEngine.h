@@ -0,0 +1,215 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_MEMORYENGINE_H_
+#define KVSTORE_MEMORYENGINE_H_
+
+#include <folly/SharedMutex.h>
+
+#include <map>
+
+#include "common/base/Base.h"
+#include "kvstore/KVEngine.h"
+#include "kvstore/KVIterator.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief Iterator of the key values copied out of MemoryEngine, so it's not invalidated by the
+ * writes meanwhile
+ */
+class MemoryIter : public KVIterator {
+ public:
+  explicit MemoryIter(std::vector<KV> kvs) : kvs_(std::move(kvs)) {}
+
+  bool valid() const override {
+    return index_ < kvs_.size();
+  }
+
+  void next() override {
+    ++index_;
+  }
+
+  void prev() override {
+    index_ = index_ == 0 ? kvs_.size() : index_ - 1;
+  }
+
+  folly::StringPiece key() const override {
+    return kvs_[index_].first;
+  }
+
+  folly::StringPiece val() const override {
+    return kvs_[index_].second;
+  }
+
+ private:
+  std::vector<KV> kvs_;
+  size_t index_{0};
+};
+
+/**
+ * @brief The KVEngine keeping the keys in memory only, for the small and hot spaces whose reads
+ * should not touch the disks. Nothing but the raft wal is persisted, so the parts are rebuilt
+ * from raft, i.e. the wal or a snapshot of the leader, after restart. createCheckpoint writes the
+ * keys into a sst file on demand.
+ *
+ * The keys are kept in a sorted map, the reads share the lock and the writes are exclusive. An
+ * iterator copies the keys it reads, which suits the prefix reads of the vertices, but a scan of
+ * the whole engine copies all of them. A snapshot is a copy of the map as well.
+ */
+class MemoryEngine : public KVEngine {
+ public:
+  using Map = std::map<std::string, std::string>;
+
+  /**
+   * @brief Construct a new memory engine
+   *
+   * @param spaceId
+   * @param dataPath Where the checkpoints are written
+   * @param walPath Raft wal path, dataPath by default
+   */
+  MemoryEngine(GraphSpaceID spaceId,
+               const std::string& dataPath,
+               const std::string& walPath = "");
+
+  ~MemoryEngine() override = default;
+
+  void stop() override {}
+
+  const char* getDataRoot() const override {
+    return dataPath_.c_str();
+  }
+
+  const char* getWalRoot() const override {
+    return walPath_.c_str();
+  }
+
+  std::unique_ptr<WriteBatch> startBatchWrite() override;
+
+  nebula::cpp2::ErrorCode commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                           bool disableWAL,
+                                           bool sync,
+                                           bool wait) override;
+
+  const void* GetSnapshot() override;
+
+  void ReleaseSnapshot(const void* snapshot) override;
+
+  /*********************
+   * Data retrieval
+   ********************/
+  nebula::cpp2::ErrorCode get(const std::string& key,
+                              std::string* value,
+                              const void* snapshot = nullptr) override;
+
+  std::vector<Status> multiGet(const std::vector<std::string>& keys,
+                               std::vector<std::string>* values) override;
+
+  nebula::cpp2::ErrorCode range(const std::string& start,
+                                const std::string& end,
+                                std::unique_ptr<KVIterator>* iter) override;
+
+  nebula::cpp2::ErrorCode prefix(const std::string& prefix,
+                                 std::unique_ptr<KVIterator>* iter,
+                                 const void* snapshot = nullptr) override;
+
+  nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
+                                          const std::string& prefix,
+                                          std::unique_ptr<KVIterator>* iter) override;
+
+  nebula::cpp2::ErrorCode scan(std::unique_ptr<KVIterator>* storageIter) override;
+
+  /*********************
+   * Data modification
+   ********************/
+  nebula::cpp2::ErrorCode put(std::string key, std::string value) override;
+
+  nebula::cpp2::ErrorCode multiPut(std::vector<KV> keyValues) override;
+
+  nebula::cpp2::ErrorCode remove(const std::string& key) override;
+
+  nebula::cpp2::ErrorCode multiRemove(std::vector<std::string> keys) override;
+
+  nebula::cpp2::ErrorCode removeRange(const std::string& start, const std::string& end) override;
+
+  /*********************
+   * Non-data operation
+   ********************/
+  void addPart(PartitionID partId, const Peers& raftPeers) override;
+
+  nebula::cpp2::ErrorCode updatePart(PartitionID partId, const Peer& raftPeer) override;
+
+  void removePart(PartitionID partId) override;
+
+  std::vector<PartitionID> allParts() override;
+
+  std::map<PartitionID, Peers> balancePartPeers() override;
+
+  int32_t totalPartsNum() override;
+
+  /**
+   * @brief Put the keys of the sst files
+   */
+  nebula::cpp2::ErrorCode ingest(const std::vector<std::string>& files,
+                                 bool verifyFileChecksum = false) override;
+
+  nebula::cpp2::ErrorCode setOption(const std::string& configKey,
+                                    const std::string& configValue) override;
+
+  nebula::cpp2::ErrorCode setDBOption(const std::string& configKey,
+                                      const std::string& configValue) override;
+
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> getProperty(const std::string& property) override;
+
+  nebula::cpp2::ErrorCode compact() override {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode flush() override {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  /**
+   * @brief Write all the keys into checkpointPath/data.sst, which could be ingested
+   */
+  nebula::cpp2::ErrorCode createCheckpoint(const std::string& checkpointPath) override;
+
+  ErrorOr<nebula::cpp2::ErrorCode, int64_t> writeSstFile(const std::string& path,
+                                                         const std::string& prefix,
+                                                         const void* snapshot = nullptr) override;
+
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> backupTable(
+      const std::string& path,
+      const std::string& tablePrefix,
+      std::function<bool(const folly::StringPiece& key)> filter) override;
+
+  nebula::cpp2::ErrorCode backup() override {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+ private:
+  struct Snapshot {
+    Map data;
+  };
+
+  // The keys with the prefix from start in data
+  static std::vector<KV> collect(const Map& data,
+                                 const std::string& start,
+                                 const std::string& prefix);
+
+  void removeRangeLocked(const std::string& start, const std::string& end);
+
+  std::string dataPath_;
+  std::string walPath_;
+  folly::SharedMutex lock_;
+  Map data_;
+  std::atomic<int32_t> partsNum_{0};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_MEMORYENGINE_H_
@@ -5,7 +5,9 @@
 
 #include "kvstore/NebulaSnapshotManager.h"
 
+#include "common/fs/FileUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/IOScheduler.h"
 #include "kvstore/LogEncoder.h"
 #include "kvstore/RateLimiter.h"
 
@@ -49,20 +51,13 @@ void NebulaSnapshotManager::accessAllRowsInSnapshot(GraphSpaceID spaceId,
     }
   };
   auto part = nebula::value(partRet);
-  // Get the commit log id and commit log term of specified partition
-  std::string val;
-  auto commitRet = part->engine()->get(NebulaKeyUtils::systemCommitKey(partId), &val, snapshot);
-  if (commitRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
-    LOG(INFO) << folly::sformat(
-        "Cannot fetch the commit log id and term of space {} part {}", spaceId, partId);
+  auto commit = commitLogIdAndTerm(part.get(), snapshot);
+  if (!commit.has_value()) {
     cb(kInvalidLogId, kInvalidLogTerm, data, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
     return;
   }
-  CHECK_EQ(val.size(), sizeof(LogID) + sizeof(TermID));
-  LogID commitLogId;
-  TermID commitLogTerm;
-  memcpy(reinterpret_cast<void*>(&commitLogId), val.data(), sizeof(LogID));
-  memcpy(reinterpret_cast<void*>(&commitLogTerm), val.data() + sizeof(LogID), sizeof(TermID));
+  auto commitLogId = commit->first;
+  auto commitLogTerm = commit->second;
 
   LOG(INFO) << folly::sformat(
       "Space {} Part {} start send snapshot of commitLogId {} commitLogTerm {}, rate limited to "
@@ -81,6 +76,7 @@ void NebulaSnapshotManager::accessAllRowsInSnapshot(GraphSpaceID spaceId,
                      partId,
                      snapshot,
                      prefix,
+                     part->engine()->getDataRoot(),
                      cb,
                      commitLogId,
                      commitLogTerm,
@@ -94,12 +90,146 @@ void NebulaSnapshotManager::accessAllRowsInSnapshot(GraphSpaceID spaceId,
   cb(commitLogId, commitLogTerm, data, totalCount, totalSize, raftex::SnapshotStatus::DONE);
 }
 
+bool NebulaSnapshotManager::accessAllFilesInSnapshot(GraphSpaceID spaceId,
+                                                     PartitionID partId,
+                                                     raftex::SnapshotFileCallback cb) {
+  CHECK_NOTNULL(store_);
+  auto partRet = store_->part(spaceId, partId);
+  if (!ok(partRet)) {
+    return false;
+  }
+  auto snapshot = store_->GetSnapshot(spaceId, partId);
+  SCOPE_EXIT {
+    if (snapshot != nullptr) {
+      store_->ReleaseSnapshot(spaceId, partId, snapshot);
+    }
+  };
+  auto part = nebula::value(partRet);
+  auto commit = commitLogIdAndTerm(part.get(), snapshot);
+  if (!commit.has_value()) {
+    return false;
+  }
+  auto commitLogId = commit->first;
+  auto commitLogTerm = commit->second;
+  auto dir = folly::stringPrintf("%s/snapshot", part->engine()->getDataRoot());
+  if (!fs::FileUtils::exist(dir) && !fs::FileUtils::makeDir(dir)) {
+    LOG(WARNING) << "Failed to make the snapshot dir " << dir << ", send the rows instead";
+    return false;
+  }
+
+  LOG(INFO) << folly::sformat(
+      "Space {} Part {} start send snapshot files of commitLogId {} commitLogTerm {}, rate "
+      "limited to {}, batch size is {}",
+      spaceId,
+      partId,
+      commitLogId,
+      commitLogTerm,
+      FLAGS_snapshot_part_rate_limit,
+      FLAGS_snapshot_batch_size);
+
+  // Each table is dumped into a sst file and sent before the next one, nothing is sent until the
+  // first table is dumped, so we could still fall back to the rows if it fails
+  auto rateLimiter = std::make_unique<kvstore::RateLimiter>();
+  int64_t totalCount = 0;
+  int64_t totalSize = 0;
+  bool sent = false;
+  auto failed = [&]() {
+    if (sent) {
+      cb(commitLogId,
+         commitLogTerm,
+         "",
+         0,
+         false,
+         totalCount,
+         totalSize,
+         raftex::SnapshotStatus::FAILED);
+    }
+    return sent;
+  };
+  std::string buf(std::max(FLAGS_snapshot_batch_size, 1U), '\0');
+  for (const auto& prefix : NebulaKeyUtils::snapshotPrefix(partId)) {
+    auto path = folly::stringPrintf("%s/%d.%ld.sst", dir.c_str(), partId, fileSeq_++);
+    SCOPE_EXIT {
+      unlink(path.c_str());
+    };
+    auto ret = part->engine()->writeSstFile(path, prefix, snapshot);
+    if (!ok(ret)) {
+      LOG(WARNING) << folly::sformat(
+          "Space {} Part {} failed to dump the snapshot file {}", spaceId, partId, path);
+      return failed();
+    }
+    if (nebula::value(ret) == 0) {
+      continue;
+    }
+    int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      LOG(WARNING) << "Failed to open " << path << ", error: " << strerror(errno);
+      return failed();
+    }
+    SCOPE_EXIT {
+      close(fd);
+    };
+    auto fileSize = static_cast<int64_t>(fs::FileUtils::fileSize(path.c_str()));
+    int64_t offset = 0;
+    while (offset < fileSize) {
+      auto bytes = pread(fd, buf.data(), buf.size(), offset);
+      if (bytes <= 0) {
+        LOG(WARNING) << "Failed to read " << path << ", error: " << strerror(errno);
+        return failed();
+      }
+      rateLimiter->consume(static_cast<double>(bytes),                            // toConsume
+                           static_cast<double>(FLAGS_snapshot_part_rate_limit),   // rate
+                           static_cast<double>(FLAGS_snapshot_part_rate_limit));  // burstSize
+      IOScheduler::instance().consume(dir, IOClass::kSnapshot, bytes);
+      bool fileEnd = offset + bytes >= fileSize;
+      totalSize += bytes;
+      totalCount += fileEnd ? 1 : 0;
+      sent = true;
+      if (!cb(commitLogId,
+              commitLogTerm,
+              folly::StringPiece(buf.data(), bytes),
+              offset,
+              fileEnd,
+              totalCount,
+              totalSize,
+              raftex::SnapshotStatus::IN_PROGRESS)) {
+        VLOG(2) << "[spaceId:" << spaceId << ", partId:" << partId << "] send snapshot failed";
+        return true;
+      }
+      offset += bytes;
+    }
+  }
+  cb(commitLogId, commitLogTerm, "", 0, false, totalCount, totalSize, raftex::SnapshotStatus::DONE);
+  return true;
+}
+
+std::optional<std::pair<LogID, TermID>> NebulaSnapshotManager::commitLogIdAndTerm(
+    Part* part, const void* snapshot) {
+  // Get the commit log id and commit log term of specified partition
+  std::string val;
+  auto commitRet =
+      part->engine()->get(NebulaKeyUtils::systemCommitKey(part->partitionId()), &val, snapshot);
+  if (commitRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    LOG(INFO) << folly::sformat("Cannot fetch the commit log id and term of space {} part {}",
+                                part->spaceId(),
+                                part->partitionId());
+    return std::nullopt;
+  }
+  CHECK_EQ(val.size(), sizeof(LogID) + sizeof(TermID));
+  LogID commitLogId;
+  TermID commitLogTerm;
+  memcpy(reinterpret_cast<void*>(&commitLogId), val.data(), sizeof(LogID));
+  memcpy(reinterpret_cast<void*>(&commitLogTerm), val.data() + sizeof(LogID), sizeof(TermID));
+  return std::make_pair(commitLogId, commitLogTerm);
+}
+
 // Promise is set in callback. Access part of the data, and try to send to
 // peers. If send failed, will return false.
 bool NebulaSnapshotManager::accessTable(GraphSpaceID spaceId,
                                         PartitionID partId,
                                         const void* snapshot,
                                         const std::string& prefix,
+                                        const std::string& dataRoot,
                                         raftex::SnapshotCallback& cb,
                                         LogID commitLogId,
                                         TermID commitLogTerm,
@@ -122,6 +252,7 @@ bool NebulaSnapshotManager::accessTable(GraphSpaceID spaceId,
       rateLimiter->consume(static_cast<double>(batchSize),                        // toConsume
                            static_cast<double>(FLAGS_snapshot_part_rate_limit),   // rate
                            static_cast<double>(FLAGS_snapshot_part_rate_limit));  // burstSize
+      IOScheduler::instance().consume(dataRoot, IOClass::kSnapshot, batchSize);
       if (cb(commitLogId,
              commitLogTerm,
              data,
@@ -31,6 +31,19 @@ class NebulaSnapshotManager : public raftex::SnapshotManager {
                                PartitionID partId,
                                raftex::SnapshotCallback cb) override;
 
+  /**
+   * @brief Dump the data into sst files table by table, and trigger callback to send the chunks of
+   * them to peer
+   *
+   * @param spaceId
+   * @param partId
+   * @param cb Callback when read some amount of a file
+   * @return False if nothing is sent because failed to dump the files
+   */
+  bool accessAllFilesInSnapshot(GraphSpaceID spaceId,
+                                PartitionID partId,
+                                raftex::SnapshotFileCallback cb) override;
+
  private:
   /**
    * @brief Collect some data by prefix, and trigger callback when scan some amount of data
@@ -38,6 +51,7 @@ class NebulaSnapshotManager : public raftex::SnapshotManager {
    * @param spaceId
    * @param partId
    * @param prefix Prefix to scan
+   * @param dataRoot Data root of the engine, whose io budget is consumed
    * @param cb Callback when scan some amount of data
    * @param data Data container
    * @param totalCount Data count
@@ -49,6 +63,7 @@ class NebulaSnapshotManager : public raftex::SnapshotManager {
                    PartitionID partId,
                    const void* snapshot,
                    const std::string& prefix,
+                   const std::string& dataRoot,
                    raftex::SnapshotCallback& cb,
                    LogID commitLogId,
                    TermID commitLogTerm,
@@ -57,7 +72,18 @@ class NebulaSnapshotManager : public raftex::SnapshotManager {
                    int64_t& totalSize,
                    kvstore::RateLimiter* rateLimiter);
 
+  /**
+   * @brief Get the commit log id and commit log term of the part in snapshot
+   *
+   * @param part
+   * @param snapshot
+   * @return std::optional<std::pair<LogID, TermID>> std::nullopt if not found
+   */
+  std::optional<std::pair<LogID, TermID>> commitLogIdAndTerm(Part* part, const void* snapshot);
+
   NebulaStore* store_;
+  // Sequence to name the snapshot files, the same part may send snapshots to several peers
+  std::atomic<int64_t> fileSeq_{0};
 };
 
 }  // namespace kvstore
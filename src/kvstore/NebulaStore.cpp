@@ -7,22 +7,43 @@
 
 #include <folly/Likely.h>
 #include <folly/ScopeGuard.h>
+#include <folly/String.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include <algorithm>
 
 #include "common/fs/FileUtils.h"
 #include "common/network/NetworkUtils.h"
+#include "common/stats/ContentionStats.h"
+#include "common/time/Duration.h"
 #include "common/time/WallClock.h"
+#include "common/utils/MetaKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/IOScheduler.h"
+#include "kvstore/MemoryEngine.h"
 #include "kvstore/NebulaSnapshotManager.h"
 #include "kvstore/RocksEngine.h"
 #include "kvstore/listener/elasticsearch/ESListener.h"
+#include "kvstore/stats/KVStats.h"
 
 DEFINE_string(engine_type, "rocksdb", "rocksdb, memory...");
+DEFINE_string(memory_engine_spaces,
+              "",
+              "The comma separated ids of the spaces kept in memory only, which are rebuilt by "
+              "raft after restart");
 DEFINE_int32(num_workers, 4, "Number of worker threads");
 DEFINE_int32(clean_wal_interval_secs, 600, "interval to trigger clean expired wal");
+DEFINE_int32(ttl_compaction_interval_secs,
+             3600,
+             "interval to compact the sst files mostly expired by ttl, 0 means disabled");
+DEFINE_double(ttl_compaction_expired_ratio,
+              0.5,
+              "the ratio of the expired keys of a sst file to compact it");
 DEFINE_bool(auto_remove_invalid_space, true, "whether remove data of invalid space when restart");
+DEFINE_int32(num_part_load_threads,
+             0,
+             "Number of threads to open the local parts at startup, the number of cpu cores if it "
+             "is not positive");
 
 DECLARE_bool(rocksdb_disable_wal);
 DECLARE_int32(rocksdb_backup_interval_secs);
@@ -47,8 +68,10 @@ NebulaStore::~NebulaStore() {
 bool NebulaStore::init() {
   LOG(INFO) << "Start the raft service...";
   bgWorkers_ = std::make_shared<thread::GenericThreadPool>();
+  bgWorkers_->setTaskObserver(stats::ExecutorStats::of("nebula-bgworkers"));
   bgWorkers_->start(FLAGS_num_workers, "nebula-bgworkers");
   storeWorker_ = std::make_shared<thread::GenericWorker>();
+  storeWorker_->setTaskObserver(stats::ExecutorStats::of("nebula-store-worker"));
   CHECK(storeWorker_->start());
   snapshot_.reset(new NebulaSnapshotManager(this));
   raftService_ = raftex::RaftexService::createService(ioPool_, workers_, raftAddr_.port);
@@ -56,7 +79,21 @@ bool NebulaStore::init() {
     LOG(ERROR) << "Start the raft service failed";
     return false;
   }
-  diskMan_.reset(new DiskManager(options_.dataPaths_, storeWorker_));
+  std::vector<std::string> coldPaths;
+  for (const auto& dataPath : options_.dataPaths_) {
+    coldPaths.emplace_back(coldDataPath(dataPath));
+  }
+  diskMan_.reset(new DiskManager(options_.dataPaths_, storeWorker_, coldPaths));
+  if (FLAGS_enable_hot_part_stats) {
+    hotParts_ = std::make_unique<HotPartStats>();
+  }
+  // The background io of the engines on the same data path shares its budget
+  for (const auto& path : options_.dataPaths_) {
+    IOScheduler::instance().addDisk(path);
+  }
+  if (FLAGS_background_io_rate_limit > 0) {
+    storeWorker_->addRepeatTask(1000, &IOScheduler::adjust, &IOScheduler::instance());
+  }
   // todo(doodle): we could support listener and normal storage start at same
   // instance
   if (!isListener()) {
@@ -70,6 +107,10 @@ bool NebulaStore::init() {
   }
 
   storeWorker_->addDelayTask(FLAGS_clean_wal_interval_secs * 1000, &NebulaStore::cleanWAL, this);
+  if (!isListener() && FLAGS_ttl_compaction_interval_secs > 0) {
+    storeWorker_->addDelayTask(
+        FLAGS_ttl_compaction_interval_secs * 1000, &NebulaStore::compactExpired, this);
+  }
   storeWorker_->addRepeatTask(
       FLAGS_rocksdb_backup_interval_secs * 1000, &NebulaStore::backup, this);
   LOG(INFO) << "Register handler...";
@@ -125,6 +166,16 @@ void NebulaStore::loadPartFromDataPath() {
     ++index;
   }
 
+  // The parts of all engines are opened concurrently, most of the time is spent on scanning the
+  // wal and opening the raft of each part
+  time::Duration loadAllDur;
+  auto loadThreads = FLAGS_num_part_load_threads > 0
+                         ? static_cast<size_t>(FLAGS_num_part_load_threads)
+                         : std::max(std::thread::hardware_concurrency(), 1U);
+  thread::GenericThreadPool loadPool;
+  loadPool.start(loadThreads, "part-loader");
+  std::vector<folly::SemiFuture<folly::Unit>> loads;
+
   // avoid duplicate engine created
   std::unordered_set<std::pair<GraphSpaceID, PartitionID>> partSet;
   for (auto& spaceEngine : spaceEngines) {
@@ -201,11 +252,15 @@ void NebulaStore::loadPartFromDataPath() {
 
       // there is no valid part in this engine, remove it
       if (partRaftPeers.empty()) {
-        auto spaceDir = engine->getDataRoot();
+        std::string spaceDir = engine->getDataRoot();
+        auto coldSpaceDir = engine->getColdDataRoot();
         engine.reset();  // close engine
         if (!options_.partMan_->spaceExist(storeSvcAddr_, spaceId).ok()) {
           if (FLAGS_auto_remove_invalid_space) {
             removeSpaceDir(spaceDir);
+            if (!coldSpaceDir.empty()) {
+              removeSpaceDir(coldSpaceDir);
+            }
           }
         }
         continue;
@@ -224,15 +279,13 @@ void NebulaStore::loadPartFromDataPath() {
         enginePtr = spaceIt->second->engines_.back().get();
       }
 
-      std::atomic<size_t> counter(partRaftPeers.size());
-      folly::Baton<true, std::atomic> baton;
       LOG(INFO) << "Need to open " << partRaftPeers.size() << " parts of space " << spaceId;
       for (auto& it : partRaftPeers) {
-        auto& partId = it.first;
-        Peers& raftPeers = it.second;
+        auto partId = it.first;
 
-        bgWorkers_->addTask(
-            [spaceId, partId, &raftPeers, enginePtr, &counter, &baton, this]() mutable {
+        loads.emplace_back(loadPool.addTask(
+            [spaceId, partId, raftPeers = std::move(it.second), enginePtr, this]() mutable {
+              time::Duration loadDur;
               // create part
               bool isLearner = false;
               std::vector<HostAddr> addrs;  // raft peers
@@ -276,16 +329,15 @@ void NebulaStore::loadPartFromDataPath() {
                   LOG(FATAL) << "Part already exists, partId " << partId;
                 }
               }
-              counter.fetch_sub(1);
-              if (counter.load() == 0) {
-                baton.post();
-              }
-            });
+              stats::StatsManager::addValue(kLoadPartLatencyMs, loadDur.elapsedInMSec());
+            }));
       }
-      baton.wait();
-      LOG(INFO) << "Load space " << spaceId << " complete";
     }
   }
+  folly::collectAll(loads).wait();
+  stats::StatsManager::addValue(kLoadPartsLatencyMs, loadAllDur.elapsedInMSec());
+  LOG(INFO) << "Load " << loads.size() << " parts from disk in " << loadAllDur.elapsedInMSec()
+            << " ms";
 }
 
 void NebulaStore::loadPartFromPartManager() {
@@ -355,7 +407,9 @@ folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>> NebulaStore::n
     GraphSpaceID spaceId, const std::string& dataPath, const std::string& walPath) {
   return folly::via(folly::getGlobalIOExecutor().get(), [this, spaceId, dataPath, walPath]() {
     std::unique_ptr<KVEngine> engine;
-    if (FLAGS_engine_type == "rocksdb") {
+    if (isMemorySpace(spaceId)) {
+      engine = std::make_unique<MemoryEngine>(spaceId, dataPath, walPath);
+    } else if (FLAGS_engine_type == "rocksdb") {
       std::shared_ptr<KVCompactionFilterFactory> cfFactory = nullptr;
       if (options_.cffBuilder_ != nullptr) {
         cfFactory = options_.cffBuilder_->buildCfFactory(spaceId);
@@ -370,6 +424,25 @@ folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>> NebulaStore::n
   });
 }
 
+bool NebulaStore::isMemorySpace(GraphSpaceID spaceId) {
+  // The meta data is always persisted
+  if (spaceId == kDefaultSpaceId) {
+    return false;
+  }
+  if (FLAGS_engine_type == "memory") {
+    return true;
+  }
+  std::vector<folly::StringPiece> ids;
+  folly::split(',', FLAGS_memory_engine_spaces, ids, true);
+  for (auto id : ids) {
+    auto space = folly::tryTo<GraphSpaceID>(folly::trimWhitespace(id));
+    if (space.hasValue() && space.value() == spaceId) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::unique_ptr<KVEngine> NebulaStore::newEngine(GraphSpaceID spaceId,
                                                  const std::string& dataPath,
                                                  const std::string& walPath) {
@@ -551,6 +624,10 @@ void NebulaStore::removeSpace(GraphSpaceID spaceId) {
     if (FLAGS_auto_remove_invalid_space) {
       for (auto& engine : engines) {
         enginePaths.emplace_back(engine->getDataRoot());
+        auto coldPath = engine->getColdDataRoot();
+        if (!coldPath.empty()) {
+          enginePaths.emplace_back(std::move(coldPath));
+        }
       }
     }
     if (FLAGS_auto_remove_invalid_space) {
@@ -723,6 +800,22 @@ void NebulaStore::fetchDiskParts(SpaceDiskPartsMap& diskParts) {
   diskMan_->getDiskParts(diskParts);
 }
 
+void NebulaStore::fetchHotParts(std::vector<meta::cpp2::PartHotness>& hotParts) {
+  if (hotParts_ == nullptr) {
+    return;
+  }
+  std::vector<std::pair<HotPartStats::PartKey, PartAccessCounters::Snapshot>> counters;
+  {
+    folly::RWSpinLock::ReadHolder rh(&lock_);
+    for (const auto& [spaceId, space] : spaces_) {
+      for (const auto& [partId, part] : space->parts_) {
+        counters.emplace_back(std::make_pair(spaceId, partId), part->accessCounters().snapshot());
+      }
+    }
+  }
+  hotParts = hotParts_->report(counters);
+}
+
 void NebulaStore::updateSpaceOption(GraphSpaceID spaceId,
                                     const std::unordered_map<std::string, std::string>& options,
                                     bool isDbOption) {
@@ -765,7 +858,16 @@ nebula::cpp2::ErrorCode NebulaStore::get(GraphSpaceID spaceId,
     return part->isLeader() ? nebula::cpp2::ErrorCode::E_LEADER_LEASE_FAILED
                             : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->get(key, value, snapshot);
+  auto code = part->engine()->get(key, value, snapshot);
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    part->accessCounters().addRead(1, value->size());
+  } else {
+    part->accessCounters().addRead(1, 0);
+  }
+  if (hotParts_ != nullptr) {
+    hotParts_->addKey(spaceId, partId, part->vIdLen(), key);
+  }
+  return code;
 }
 
 const void* NebulaStore::GetSnapshot(GraphSpaceID spaceId, PartitionID partId) {
@@ -804,6 +906,50 @@ std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGet(
     return {nebula::cpp2::ErrorCode::E_LEADER_CHANGED, status};
   }
   status = part->engine()->multiGet(keys, values);
+  uint64_t bytes = 0;
+  for (const auto& value : *values) {
+    bytes += value.size();
+  }
+  part->accessCounters().addRead(keys.size(), bytes);
+  if (hotParts_ != nullptr) {
+    for (const auto& key : keys) {
+      hotParts_->addKey(spaceId, partId, part->vIdLen(), key);
+    }
+  }
+  auto allExist = std::all_of(status.begin(), status.end(), [](const auto& s) { return s.ok(); });
+  if (allExist) {
+    return {nebula::cpp2::ErrorCode::SUCCEEDED, status};
+  } else {
+    return {nebula::cpp2::ErrorCode::E_PARTIAL_RESULT, status};
+  }
+}
+
+std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGetView(
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    const std::vector<std::string>& keys,
+    const ValueVisitor& visitor,
+    bool canReadFromFollower) {
+  std::vector<Status> status;
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return {error(ret), status};
+  }
+  auto part = nebula::value(ret);
+  if (!checkLeader(part, canReadFromFollower)) {
+    return {nebula::cpp2::ErrorCode::E_LEADER_CHANGED, status};
+  }
+  uint64_t bytes = 0;
+  status = part->engine()->multiGetView(keys, [&visitor, &bytes](size_t i, folly::StringPiece val) {
+    bytes += val.size();
+    visitor(i, val);
+  });
+  part->accessCounters().addRead(keys.size(), bytes);
+  if (hotParts_ != nullptr) {
+    for (const auto& key : keys) {
+      hotParts_->addKey(spaceId, partId, part->vIdLen(), key);
+    }
+  }
   auto allExist = std::all_of(status.begin(), status.end(), [](const auto& s) { return s.ok(); });
   if (allExist) {
     return {nebula::cpp2::ErrorCode::SUCCEEDED, status};
@@ -826,6 +972,7 @@ nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
+  part->accessCounters().addRead(1, 0);
   return part->engine()->range(start, end, iter);
 }
 
@@ -843,6 +990,10 @@ nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
+  part->accessCounters().addRead(1, 0);
+  if (hotParts_ != nullptr) {
+    hotParts_->addKey(spaceId, partId, part->vIdLen(), prefix);
+  }
   return part->engine()->prefix(prefix, iter, snapshot);
 }
 
@@ -860,6 +1011,7 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
+  part->accessCounters().addRead(1, 0);
   return part->engine()->rangeWithPrefix(start, prefix, iter);
 }
 
@@ -886,12 +1038,13 @@ void NebulaStore::asyncAppendBatch(GraphSpaceID spaceId,
                                    PartitionID partId,
                                    std::string&& batch,
                                    KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  part->accessCounters().addWrite(1, batch.size());
   part->asyncAppendBatch(std::move(batch), std::move(cb));
 }
 
@@ -899,12 +1052,17 @@ void NebulaStore::asyncMultiPut(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 std::vector<KV>&& keyValues,
                                 KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  uint64_t bytes = 0;
+  for (const auto& kv : keyValues) {
+    bytes += kv.first.size() + kv.second.size();
+  }
+  part->accessCounters().addWrite(1, bytes);
   part->asyncMultiPut(std::move(keyValues), std::move(cb));
 }
 
@@ -912,12 +1070,13 @@ void NebulaStore::asyncRemove(GraphSpaceID spaceId,
                               PartitionID partId,
                               const std::string& key,
                               KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  part->accessCounters().addWrite(1, key.size());
   part->asyncRemove(key, std::move(cb));
 }
 
@@ -925,12 +1084,17 @@ void NebulaStore::asyncMultiRemove(GraphSpaceID spaceId,
                                    PartitionID partId,
                                    std::vector<std::string>&& keys,
                                    KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  uint64_t bytes = 0;
+  for (const auto& key : keys) {
+    bytes += key.size();
+  }
+  part->accessCounters().addWrite(1, bytes);
   part->asyncMultiRemove(std::move(keys), std::move(cb));
 }
 
@@ -939,12 +1103,13 @@ void NebulaStore::asyncRemoveRange(GraphSpaceID spaceId,
                                    const std::string& start,
                                    const std::string& end,
                                    KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  part->accessCounters().addWrite(1, start.size() + end.size());
   part->asyncRemoveRange(start, end, std::move(cb));
 }
 
@@ -952,15 +1117,27 @@ void NebulaStore::asyncAtomicOp(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 MergeableAtomicOp op,
                                 KVCallback cb) {
-  auto ret = part(spaceId, partId);
+  auto ret = writablePart(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
     return;
   }
   auto part = nebula::value(ret);
+  // The size of the batch is unknown until the op is done
+  part->accessCounters().addWrite(1, 0);
   part->asyncAtomicOp(std::move(op), std::move(cb));
 }
 
+ErrorOr<nebula::cpp2::ErrorCode, std::shared_ptr<Part>> NebulaStore::writablePart(
+    GraphSpaceID spaceId, PartitionID partId) {
+  auto ret = part(spaceId, partId);
+  if (ok(ret) && nebula::value(ret)->engine()->isWriteStopped()) {
+    // Reject at once rather than block the write until the compactions catch up
+    return nebula::cpp2::ErrorCode::E_WRITE_STALLED;
+  }
+  return ret;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::shared_ptr<Part>> NebulaStore::part(GraphSpaceID spaceId,
                                                                           PartitionID partId) {
   folly::RWSpinLock::ReadHolder rh(&lock_);
@@ -1327,6 +1504,22 @@ void NebulaStore::cleanWAL() {
   }
 }
 
+void NebulaStore::compactExpired() {
+  folly::RWSpinLock::ReadHolder rh(&lock_);
+  SCOPE_EXIT {
+    storeWorker_->addDelayTask(
+        FLAGS_ttl_compaction_interval_secs * 1000, &NebulaStore::compactExpired, this);
+  };
+  for (const auto& spaceEntry : spaces_) {
+    for (const auto& engine : spaceEntry.second->engines_) {
+      auto code = engine->compactExpired(FLAGS_ttl_compaction_expired_ratio);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(WARNING) << "Compact the expired keys of space " << spaceEntry.first << " failed";
+      }
+    }
+  }
+}
+
 nebula::cpp2::ErrorCode NebulaStore::backup() {
   for (const auto& spaceEntry : spaces_) {
     for (const auto& engine : spaceEntry.second->engines_) {
@@ -15,6 +15,7 @@
 #include "common/utils/Utils.h"
 #include "interface/gen-cpp2/RaftexServiceAsyncClient.h"
 #include "kvstore/DiskManager.h"
+#include "kvstore/HotPartStats.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/KVStore.h"
 #include "kvstore/Part.h"
@@ -240,6 +241,26 @@ class NebulaStore : public KVStore, public Handler {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) override;
 
+  /**
+   * @brief Read a list of keys without copying the values, the value of each existing key is
+   * passed to the visitor in place
+   *
+   * @param spaceId
+   * @param partId
+   * @param keys Keys to read
+   * @param visitor Called with the index and the value of each existing key
+   * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @return Return std::vector<Status> when succeeded: Result status of each key, if key[i] does
+   * not exist, the i-th value in return value would be Status::KeyNotFound. Return ErrorCode when
+   * failed
+   */
+  std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> multiGetView(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      const std::vector<std::string>& keys,
+      const ValueVisitor& visitor,
+      bool canReadFromFollower = false) override;
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -677,6 +698,14 @@ class NebulaStore : public KVStore, public Handler {
    */
   void fetchDiskParts(SpaceDiskPartsMap& diskParts) override;
 
+  /**
+   * @brief Get the access rates of the hottest partitions since the last call, empty if
+   * FLAGS_enable_hot_part_stats is off
+   *
+   * @param hotParts The hottest partitions, the hottest first
+   */
+  void fetchHotParts(std::vector<meta::cpp2::PartHotness>& hotParts) override;
+
   /**
    * @brief return a WriteBatch object to do batch operation
    *
@@ -743,6 +772,12 @@ class NebulaStore : public KVStore, public Handler {
   }
 
  private:
+  /**
+   * @brief Get the part to write, E_WRITE_STALLED if the writes of its engine are stopped
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, std::shared_ptr<Part>> writablePart(GraphSpaceID spaceId,
+                                                                       PartitionID partId);
+
   /**
    * @brief Load partitions by reading system part keys in kv engine
    */
@@ -785,6 +820,13 @@ class NebulaStore : public KVStore, public Handler {
   folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>> newEngineAsync(
       GraphSpaceID spaceId, const std::string& dataPath, const std::string& walPath);
 
+  /**
+   * @brief Whether the space is kept in MemoryEngine, by engine_type or memory_engine_spaces
+   *
+   * @param spaceId
+   */
+  static bool isMemorySpace(GraphSpaceID spaceId);
+
   /**
    * @brief Start a new kv engine on specified path
    *
@@ -851,6 +893,11 @@ class NebulaStore : public KVStore, public Handler {
    */
   void cleanWAL();
 
+  /**
+   * @brief Compact the sst files whose keys are mostly expired by ttl
+   */
+  void compactExpired();
+
   /**
    * @brief Get the vertex id length of given space
    *
@@ -882,6 +929,8 @@ class NebulaStore : public KVStore, public Handler {
   std::shared_ptr<raftex::SnapshotManager> snapshot_;
   std::shared_ptr<thrift::ThriftClientManager<raftex::cpp2::RaftexServiceAsyncClient>> clientMan_;
   std::shared_ptr<DiskManager> diskMan_;
+  // nullptr if FLAGS_enable_hot_part_stats is off
+  std::unique_ptr<HotPartStats> hotParts_;
   folly::ConcurrentHashMap<std::string, std::function<void(std::shared_ptr<Part>&)>>
       onNewPartAdded_;
   std::function<void(GraphSpaceID)> beforeRemoveSpace_{nullptr};
@@ -5,7 +5,9 @@
 
 #include "kvstore/Part.h"
 
+#include "common/fs/FileUtils.h"
 #include "common/time/ScopedTimer.h"
+#include "common/time/WallClock.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
@@ -69,47 +71,80 @@ std::pair<LogID, TermID> Part::lastCommittedLogId() {
 void Part::asyncPut(folly::StringPiece key, folly::StringPiece value, KVCallback cb) {
   std::string log = encodeMultiValues(OP_PUT, key, value);
 
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncAppendBatch(std::string&& batch, KVCallback cb) {
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(batch))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb) {
   std::string log = encodeMultiValues(OP_MULTI_PUT, keyValues);
 
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncRemove(folly::StringPiece key, KVCallback cb) {
   std::string log = encodeSingleValue(OP_REMOVE, key);
 
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncMultiRemove(const std::vector<std::string>& keys, KVCallback cb) {
   std::string log = encodeMultiValues(OP_MULTI_REMOVE, keys);
 
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncRemoveRange(folly::StringPiece start, folly::StringPiece end, KVCallback cb) {
   std::string log = encodeMultiValues(OP_REMOVE_RANGE, start, end);
 
+  auto span = commitSpan();
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
+}
+
+tracing::Span Part::commitSpan() const {
+  auto span = tracing::Span::child("raft commit");
+  if (span.sampled()) {
+    span.addAttribute("space", folly::to<std::string>(spaceId_));
+    span.addAttribute("part", folly::to<std::string>(partId_));
+  }
+  return span;
 }
 
 void Part::sync(KVCallback cb) {
@@ -118,9 +153,13 @@ void Part::sync(KVCallback cb) {
 }
 
 void Part::asyncAtomicOp(MergeableAtomicOp op, KVCallback cb) {
+  auto span = commitSpan();
   atomicOpAsync(std::move(op))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callback = std::move(cb), span = std::move(span)](
+                     nebula::cpp2::ErrorCode code) mutable {
+        span.end();
+        callback(code);
+      });
 }
 
 void Part::asyncAddLearner(const HostAddr& learner, KVCallback cb) {
@@ -222,6 +261,8 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   auto batch = engine_->startBatchWrite();
   LogID lastId = kNoCommitLogId;
   TermID lastTerm = kNoCommitLogTerm;
+  int64_t numLogs = 0;
+  int64_t lastTs = 0;
   while (iter->valid()) {
     lastId = iter->logId();
     lastTerm = iter->logTerm();
@@ -232,6 +273,8 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       continue;
     }
     DCHECK_GE(log.size(), sizeof(int64_t) + 1 + sizeof(uint32_t));
+    ++numLogs;
+    lastTs = getTimestamp(log);
     // Skip the timestamp (type of int64_t)
     switch (log[sizeof(int64_t)]) {
       case OP_PUT: {
@@ -301,6 +344,8 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
             code = batch->remove(op.second.first);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
             code = batch->removeRange(op.second.first, op.second.second);
+          } else if (op.first == BatchLogType::OP_BATCH_MERGE) {
+            code = batch->merge(op.second.first, op.second.second);
           }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch";
@@ -357,6 +402,13 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   auto code = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
   if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    if (numLogs > 0) {
+      stats::StatsManager::addValue(kNumCommitLogs, numLogs);
+      // The timestamp is taken by the leader when the log is encoded, so the lag on the followers
+      // includes the clock skew
+      auto lag = static_cast<int64_t>(time::WallClock::fastNowInMilliSec()) - lastTs;
+      stats::StatsManager::addValue(kCommitLogLagMs, std::max<int64_t>(lag, 0));
+    }
     return {code, lastId, lastTerm};
   } else {
     return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -400,6 +452,63 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
   return {code, count, size};
 }
 
+std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshotFile(
+    folly::StringPiece chunk,
+    int64_t offset,
+    bool fileEnd,
+    LogID committedLogId,
+    TermID committedLogTerm,
+    bool finished) {
+  SCOPED_TIMER([](uint64_t elapsedTime) {
+    stats::StatsManager::addValue(kCommitSnapshotLatencyUs, elapsedTime);
+  });
+  auto dir = folly::stringPrintf("%s/snapshot", engine_->getDataRoot());
+  auto path = folly::stringPrintf("%s/%d.recv.sst", dir.c_str(), partId_);
+  if (!chunk.empty()) {
+    if (!fs::FileUtils::exist(dir) && !fs::FileUtils::makeDir(dir)) {
+      VLOG(3) << idStr_ << "Failed to make the snapshot dir " << dir;
+      return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+    }
+    int32_t fd = open(path.c_str(), O_CREAT | O_WRONLY | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      VLOG(3) << idStr_ << "Failed to open " << path << ", error: " << strerror(errno);
+      return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+    }
+    // Drop the chunks after the offset, which are left by the failed or resent requests
+    bool succeeded = lseek(fd, 0, SEEK_END) >= offset && ftruncate(fd, offset) == 0 &&
+                     pwrite(fd, chunk.data(), chunk.size(), offset) ==
+                         static_cast<ssize_t>(chunk.size());
+    close(fd);
+    if (!succeeded) {
+      VLOG(3) << idStr_ << "Failed to write " << path << " at offset " << offset;
+      return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+    }
+  }
+  int64_t count = 0;
+  if (fileEnd) {
+    auto code = engine_->ingest({path});
+    unlink(path.c_str());
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(3) << idStr_ << "Failed to ingest the snapshot file";
+      return {code, kNoSnapshotCount, kNoSnapshotSize};
+    }
+    count++;
+  }
+  if (finished) {
+    auto batch = engine_->startBatchWrite();
+    auto code = putCommitMsg(batch.get(), committedLogId, committedLogTerm);
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      code = engine_->commitBatchWrite(
+          std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, true);
+    }
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(3) << idStr_ << "Put commit id failed";
+      return {code, kNoSnapshotCount, kNoSnapshotSize};
+    }
+  }
+  return {nebula::cpp2::ErrorCode::SUCCEEDED, count, static_cast<int64_t>(chunk.size())};
+}
+
 nebula::cpp2::ErrorCode Part::putCommitMsg(WriteBatch* batch,
                                            LogID committedLogId,
                                            TermID committedLogTerm) {
@@ -540,6 +649,25 @@ nebula::cpp2::ErrorCode Part::cleanup() {
     return ret;
   }
 
+  // The pending records are keyed by the data keys, which begin with the part of them
+  const auto& pendingIndexPre = OperationKeyUtils::pendingIndexPrefix(partId_);
+  ret = batch->removeRange(NebulaKeyUtils::firstKey(pendingIndexPre, sizeof(PartitionID)),
+                           NebulaKeyUtils::lastKey(pendingIndexPre, sizeof(PartitionID)));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    VLOG(3) << idStr_ << "Failed to encode removeRange() when cleanup pending index, error "
+            << apache::thrift::util::enumNameSafe(ret);
+    return ret;
+  }
+
+  const auto& neighborhoodPre = NebulaKeyUtils::neighborhoodPrefix(partId_);
+  ret = batch->removeRange(NebulaKeyUtils::firstKey(neighborhoodPre, vIdLen_),
+                           NebulaKeyUtils::lastKey(neighborhoodPre, vIdLen_));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    VLOG(3) << idStr_ << "Failed to encode removeRange() when cleanup neighborhood, error "
+            << apache::thrift::util::enumNameSafe(ret);
+    return ret;
+  }
+
   const auto& vertexPre = NebulaKeyUtils::vertexPrefix(partId_);
   ret = batch->removeRange(NebulaKeyUtils::firstKey(vertexPre, vIdLen_),
                            NebulaKeyUtils::lastKey(vertexPre, vIdLen_));
@@ -7,8 +7,10 @@
 #define KVSTORE_PART_H_
 
 #include "common/base/Base.h"
+#include "common/tracing/Tracing.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/Common.h"
+#include "kvstore/HotPartStats.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/raftex/SnapshotManager.h"
 #include "kvstore/wal/FileBasedWal.h"
@@ -66,6 +68,17 @@ class Part : public raftex::RaftPart {
     return engine_;
   }
 
+  int32_t vIdLen() const {
+    return vIdLen_;
+  }
+
+  /**
+   * @brief The reads and the writes of the part, counted by NebulaStore
+   */
+  PartAccessCounters& accessCounters() {
+    return accessCounters_;
+  }
+
   /**
    * @brief Write single key/values to kvstore asynchronously
    *
@@ -294,6 +307,34 @@ class Part : public raftex::RaftPart {
       TermID committedLogTerm,
       bool finished) override;
 
+  /**
+   * @brief The sst files of snapshot is ingested into the engine
+   */
+  bool canIngestSnapshotFiles() override {
+    return true;
+  }
+
+  /**
+   * @brief Write the chunk of a sst file of snapshot into the local file, which is ingested once
+   * its last chunk is received. The chunks resent are written again at their offset.
+   *
+   * @param chunk Data of the file at offset
+   * @param offset Offset of the chunk in the file
+   * @param fileEnd Whether it's the last chunk of the file
+   * @param committedLogId Commit log id of snapshot
+   * @param committedLogTerm Commit log term of snapshot
+   * @param finished Whether spapshot is finished
+   * @return std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Return {ok, files ingested, size}
+   * if succeed, else return {errorcode, -1, -1}
+   */
+  std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> commitSnapshotFile(
+      folly::StringPiece chunk,
+      int64_t offset,
+      bool fileEnd,
+      LogID committedLogId,
+      TermID committedLogTerm,
+      bool finished) override;
+
   /**
    * @brief Encode the commit log id and commit log term to write batch
    *
@@ -348,8 +389,14 @@ class Part : public raftex::RaftPart {
   std::vector<LeaderChangeCB> leaderLostCB_;
 
  private:
+  /**
+   * @brief The span of the raft commit of a write, a child of the span of the request if traced
+   */
+  tracing::Span commitSpan() const;
+
   KVEngine* engine_ = nullptr;
   int32_t vIdLen_;
+  PartAccessCounters accessCounters_;
 };
 
 }  // namespace kvstore
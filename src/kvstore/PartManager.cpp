@@ -191,6 +191,12 @@ void MetaServerBasedPartManager::fetchDiskParts(SpaceDiskPartsMap& diskParts) {
   }
 }
 
+void MetaServerBasedPartManager::fetchHotParts(std::vector<meta::cpp2::PartHotness>& hotParts) {
+  if (handler_ != nullptr) {
+    handler_->fetchHotParts(hotParts);
+  }
+}
+
 meta::ListenersMap MetaServerBasedPartManager::listeners(const HostAddr& host) {
   auto ret = client_->getListenersByHostFromCache(host);
   if (ret.ok()) {
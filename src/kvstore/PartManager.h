@@ -145,6 +145,13 @@ class Handler {
    * @param diskParts Get all space data path and all partition in the path
    */
   virtual void fetchDiskParts(SpaceDiskPartsMap& diskParts) = 0;
+
+  /**
+   * @brief Get the access rates of the hottest partitions since the last call
+   *
+   * @param hotParts The hottest partitions, the hottest first
+   */
+  virtual void fetchHotParts(std::vector<meta::cpp2::PartHotness>& hotParts) = 0;
 };
 
 /**
@@ -499,6 +506,13 @@ class MetaServerBasedPartManager : public PartManager, public meta::MetaChangedL
    */
   void fetchDiskParts(SpaceDiskPartsMap& diskParts) override;
 
+  /**
+   * @brief Fetch the hottest partitions from handler
+   *
+   * @param hotParts The hottest partitions, the hottest first
+   */
+  void fetchHotParts(std::vector<meta::cpp2::PartHotness>& hotParts) override;
+
   /**
    * @brief Found a new space of listener, call handler's method
    *
@@ -0,0 +1,62 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/PrefetchIter.h"
+
+#include <folly/executors/GlobalExecutor.h>
+
+DEFINE_int32(kv_prefetch_batch_size,
+             256,
+             "The number of the key values read ahead in the background by a long scan, such as "
+             "the stats or rebuilding an index, 0 means reading them in the caller");
+
+namespace nebula {
+namespace kvstore {
+
+PrefetchIter::PrefetchIter(std::unique_ptr<KVIterator> iter, size_t batchSize)
+    : iter_(std::move(iter)), batchSize_(std::max<size_t>(batchSize, 1)) {
+  current_ = readBatch();
+  if (iter_->valid()) {
+    pending_ = folly::via(folly::getGlobalIOExecutor().get(), [this] { return readBatch(); });
+  }
+}
+
+PrefetchIter::~PrefetchIter() {
+  if (pending_.valid()) {
+    pending_.wait();
+  }
+}
+
+std::unique_ptr<KVIterator> PrefetchIter::wrap(std::unique_ptr<KVIterator> iter) {
+  if (iter == nullptr || FLAGS_kv_prefetch_batch_size <= 0) {
+    return iter;
+  }
+  return std::make_unique<PrefetchIter>(std::move(iter), FLAGS_kv_prefetch_batch_size);
+}
+
+std::vector<KV> PrefetchIter::readBatch() {
+  std::vector<KV> batch;
+  batch.reserve(batchSize_);
+  for (; iter_->valid() && batch.size() < batchSize_; iter_->next()) {
+    batch.emplace_back(iter_->key().str(), iter_->val().str());
+  }
+  return batch;
+}
+
+void PrefetchIter::advance() {
+  index_ = 0;
+  if (!pending_.valid()) {
+    current_.clear();
+    return;
+  }
+  current_ = std::move(pending_).get();
+  // The iterator wrapped is only used by one batch at a time
+  if (iter_->valid()) {
+    pending_ = folly::via(folly::getGlobalIOExecutor().get(), [this] { return readBatch(); });
+  }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
@@ -0,0 +1,78 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_PREFETCHITER_H_
+#define KVSTORE_PREFETCHITER_H_
+
+#include <folly/futures/Future.h>
+
+#include "common/base/Base.h"
+#include "kvstore/KVIterator.h"
+
+DECLARE_int32(kv_prefetch_batch_size);
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief The iterator reading the key values of the iterator wrapped in batches, the next batch is
+ * read on the global io executor while the caller processes the current one. So a long scan, e.g.
+ * of the stats or rebuilding an index, doesn't wait for the io of each block between decoding the
+ * rows.
+ *
+ * The key values are copied into the batches, prev only moves within the current batch.
+ */
+class PrefetchIter : public KVIterator {
+ public:
+  PrefetchIter(std::unique_ptr<KVIterator> iter, size_t batchSize);
+
+  // Wait for the batch being read, which uses the iterator wrapped
+  ~PrefetchIter() override;
+
+  /**
+   * @brief Wrap the iterator by kv_prefetch_batch_size, or return it as is if prefetching is
+   * disabled
+   */
+  static std::unique_ptr<KVIterator> wrap(std::unique_ptr<KVIterator> iter);
+
+  bool valid() const override {
+    return index_ < current_.size();
+  }
+
+  void next() override {
+    if (++index_ >= current_.size()) {
+      advance();
+    }
+  }
+
+  void prev() override {
+    index_ = index_ == 0 ? current_.size() : index_ - 1;
+  }
+
+  folly::StringPiece key() const override {
+    return current_[index_].first;
+  }
+
+  folly::StringPiece val() const override {
+    return current_[index_].second;
+  }
+
+ private:
+  std::vector<KV> readBatch();
+
+  // Take the batch prefetched and start reading the next one
+  void advance();
+
+  std::unique_ptr<KVIterator> iter_;
+  const size_t batchSize_;
+  std::vector<KV> current_;
+  size_t index_{0};
+  folly::Future<std::vector<KV>> pending_{folly::Future<std::vector<KV>>::makeEmpty()};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_PREFETCHITER_H_
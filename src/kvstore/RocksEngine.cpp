@@ -5,14 +5,20 @@
 
 #include "kvstore/RocksEngine.h"
 
+#include <folly/FileUtil.h>
 #include <folly/String.h>
 #include <rocksdb/convenience.h>
+#include <rocksdb/sst_file_reader.h>
 
 #include "common/base/Base.h"
 #include "common/fs/FileUtils.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/CompactionFilter.h"
+#include "kvstore/EventListener.h"
+#include "kvstore/IOScheduler.h"
 #include "kvstore/KVStore.h"
+#include "kvstore/ScanCacheGuard.h"
 
 DEFINE_bool(move_files, false, "Move the SST files instead of copy when ingest into dataset");
 DEFINE_int64(balance_expired_sesc,
@@ -25,6 +31,77 @@ namespace kvstore {
 using fs::FileType;
 using fs::FileUtils;
 
+namespace {
+
+/**
+ * @brief Route the records of a batch written into the default column family, such as the batch
+ * started by NebulaStore, to the separated column families
+ */
+class ColumnFamilyRouter : public rocksdb::WriteBatch::Handler {
+ public:
+  ColumnFamilyRouter(const RocksColumnFamilies* columnFamilies, rocksdb::WriteBatch* batch)
+      : columnFamilies_(columnFamilies), batch_(batch) {}
+
+  rocksdb::Status PutCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+    return batch_->Put(columnFamilyOf(key), key, value);
+  }
+
+  rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice& key) override {
+    return batch_->Delete(columnFamilyOf(key), key);
+  }
+
+  rocksdb::Status SingleDeleteCF(uint32_t, const rocksdb::Slice& key) override {
+    return batch_->SingleDelete(columnFamilyOf(key), key);
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t,
+                                const rocksdb::Slice& begin,
+                                const rocksdb::Slice& end) override {
+    for (auto* cf : columnFamilies_->ofRange(folly::StringPiece(begin.data(), begin.size()),
+                                             folly::StringPiece(end.data(), end.size()))) {
+      auto status = batch_->DeleteRange(cf, begin, end);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+    return rocksdb::Status::OK();
+  }
+
+  rocksdb::Status MergeCF(uint32_t,
+                          const rocksdb::Slice& key,
+                          const rocksdb::Slice& value) override {
+    return batch_->Merge(columnFamilyOf(key), key, value);
+  }
+
+  void LogData(const rocksdb::Slice& blob) override {
+    batch_->PutLogData(blob);
+  }
+
+ private:
+  rocksdb::ColumnFamilyHandle* columnFamilyOf(const rocksdb::Slice& key) const {
+    return columnFamilies_->of(folly::StringPiece(key.data(), key.size()));
+  }
+
+  const RocksColumnFamilies* columnFamilies_;
+  rocksdb::WriteBatch* batch_;
+};
+
+// The iterators of a scan over a whole part, see ScanCacheGuard, read their blocks once and in
+// order, so they don't fill the block cache and read ahead, in the background with async io
+void setScanOptions(rocksdb::ReadOptions* options) {
+  if (!ScanCacheGuard::active()) {
+    return;
+  }
+  options->fill_cache = FLAGS_rocksdb_scan_fill_cache;
+  if (FLAGS_rocksdb_scan_readahead_size > 0) {
+    options->readahead_size = FLAGS_rocksdb_scan_readahead_size;
+  }
+  options->adaptive_readahead = true;
+  options->async_io = FLAGS_rocksdb_enable_async_io;
+}
+
+}  // namespace
+
 /***************************************
  *
  * Implementation of RocksEngine
@@ -67,20 +144,38 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   rocksdb::DB* db = nullptr;
   rocksdb::Status status = initRocksdbOptions(options, spaceId, vIdLen);
   CHECK(status.ok()) << status.ToString();
+  auto coldPath = coldDataPath(dataPath);
+  if (!coldPath.empty()) {
+    coldDataPath_ = folly::stringPrintf("%s/nebula/%d", coldPath.c_str(), spaceId);
+    auto coldDataDir = folly::stringPrintf("%s/data", coldDataPath_.c_str());
+    if (FileUtils::fileType(coldDataDir.c_str()) == FileType::NOTEXIST && !readonly &&
+        !FileUtils::makeDir(coldDataDir)) {
+      LOG(FATAL) << "makeDir " << coldDataDir << " failed";
+    }
+    initRocksdbTieredPaths(options, path, coldDataDir);
+  }
+  // The compaction shares the background io budget of the data path if it's set
+  if (auto limiter = IOScheduler::instance().compactionLimiter(dataPath_)) {
+    options.rate_limiter = limiter;
+  }
   if (mergeOp != nullptr) {
     options.merge_operator = mergeOp;
   }
+  stallListener_ = std::make_shared<WriteStallListener>();
+  options.listeners.emplace_back(stallListener_);
   if (cfFactory != nullptr) {
     options.compaction_filter_factory = cfFactory;
+    // The ttl of the keys of each sst file is collected by the same filters
+    if (auto kvFactory = std::dynamic_pointer_cast<KVCompactionFilterFactory>(cfFactory)) {
+      options.table_properties_collector_factories.emplace_back(
+          std::make_shared<KVTtlPropertiesCollectorFactory>(spaceId, std::move(kvFactory)));
+    }
   }
 
-  if (readonly) {
-    status = rocksdb::DB::OpenForReadOnly(options, path, &db);
-  } else {
-    status = rocksdb::DB::Open(options, path, &db);
-  }
+  status = openDB(options, path, readonly, &db);
   CHECK(status.ok()) << status.ToString();
   if (!readonly && spaceId_ != kDefaultSpaceId /* only for storage*/) {
+    // The data version key is a system key, which is always in the default column family
     rocksdb::ReadOptions readOptions;
     std::string dataVersionValue = "";
     status = db->Get(readOptions, NebulaKeyUtils::dataVersionKey(), &dataVersionValue);
@@ -95,6 +190,10 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   std::string factoryName = options.table_factory->Name();
   if (factoryName == rocksdb::TableFactory::kBlockBasedTableName()) {
     extractorLen_ = sizeof(PartitionID) + vIdLen;
+    edgeExtractorLen_ = extractorLen_;
+    if (useEdgeTypePrefix(spaceId)) {
+      edgeExtractorLen_ += sizeof(EdgeType);
+    }
   } else if (factoryName == rocksdb::TableFactory::kPlainTableName()) {
     // PlainTable only support prefix-based seek, which means if the prefix is not inserted into
     // rocksdb, we can't read them from "prefix" api anymore. For simplicity, we just set the length
@@ -102,6 +201,7 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     // tagPrefix(partId) or edgePrefix(partId).
     isPlainTable_ = true;
     extractorLen_ = sizeof(PartitionID);
+    edgeExtractorLen_ = extractorLen_;
   }
   partsNum_ = allParts().size();
   LOG(INFO) << "open rocksdb on " << path;
@@ -109,6 +209,64 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   backup();
 }
 
+rocksdb::Status RocksEngine::openDB(const rocksdb::Options& options,
+                                    const std::string& path,
+                                    bool readonly,
+                                    rocksdb::DB** db) {
+  // The layout of an existing instance never changes, the flag only decides the layout of a new
+  // one. The meta keys are not NebulaKeyUtils keys, so they are always in the default one.
+  bool separated = false;
+  if (spaceId_ != kDefaultSpaceId) {
+    std::vector<std::string> existing;
+    if (rocksdb::DB::ListColumnFamilies(options, path, &existing).ok()) {
+      separated = existing.size() > 1;
+      if (separated != FLAGS_rocksdb_separate_column_families) {
+        LOG(WARNING) << "Space " << spaceId_ << " keeps its column families layout, separated: "
+                     << separated;
+      }
+    } else {
+      separated = FLAGS_rocksdb_separate_column_families;
+    }
+  }
+
+  rocksdb::Status status;
+  if (!separated) {
+    if (readonly) {
+      status = rocksdb::DB::OpenForReadOnly(options, path, db);
+    } else {
+      status = rocksdb::DB::Open(options, path, db);
+    }
+    if (status.ok()) {
+      columnFamilies_.reset({(*db)->DefaultColumnFamily()});
+    }
+    return status;
+  }
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  for (const auto& name : RocksColumnFamilies::separatedNames()) {
+    rocksdb::ColumnFamilyOptions cfOpts;
+    status = initRocksdbColumnFamilyOptions(options, name, cfOpts);
+    if (!status.ok()) {
+      return status;
+    }
+    descriptors.emplace_back(name, std::move(cfOpts));
+  }
+  rocksdb::DBOptions dbOpts(options);
+  dbOpts.create_missing_column_families = true;
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  if (readonly) {
+    status = rocksdb::DB::OpenForReadOnly(dbOpts, path, descriptors, &handles, db);
+  } else {
+    status = rocksdb::DB::Open(dbOpts, path, descriptors, &handles, db);
+  }
+  if (status.ok()) {
+    LOG(INFO) << "Space " << spaceId_ << " separates the vertices, edges and indexes into "
+              << handles.size() - 1 << " column families";
+    columnFamilies_.reset(std::move(handles));
+  }
+  return status;
+}
+
 void RocksEngine::stop() {
   if (db_) {
     // Because we trigger compaction in WebService, we need to stop all
@@ -118,7 +276,7 @@ void RocksEngine::stop() {
 }
 
 std::unique_ptr<WriteBatch> RocksEngine::startBatchWrite() {
-  return std::make_unique<RocksWriteBatch>();
+  return std::make_unique<RocksWriteBatch>(&columnFamilies_);
 }
 
 nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
@@ -130,7 +288,19 @@ nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch
   options.sync = sync;
   options.no_slowdown = !wait;
   auto* b = static_cast<RocksWriteBatch*>(batch.get());
-  rocksdb::Status status = db_->Write(options, b->data());
+  rocksdb::Status status;
+  if (columnFamilies_.separated() && b->columnFamilies() != &columnFamilies_) {
+    rocksdb::WriteBatch routed(FLAGS_rocksdb_batch_size);
+    ColumnFamilyRouter router(&columnFamilies_, &routed);
+    status = b->data()->Iterate(&router);
+    if (!status.ok()) {
+      VLOG(3) << "Route the batch into column families failed because of " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    status = db_->Write(options, &routed);
+  } else {
+    status = db_->Write(options, b->data());
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else if (!wait && status.IsIncomplete()) {
@@ -148,7 +318,8 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
   if (UNLIKELY(snapshot != nullptr)) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
-  rocksdb::Status status = db_->Get(options, rocksdb::Slice(key), value);
+  rocksdb::Status status =
+      db_->Get(options, columnFamilies_.of(key), rocksdb::Slice(key), value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else if (status.IsNotFound()) {
@@ -162,14 +333,42 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
 
 std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
                                           std::vector<std::string>* values) {
+  values->clear();
+  values->resize(keys.size());
+  return multiGetView(keys, [values](size_t index, folly::StringPiece value) {
+    (*values)[index].assign(value.data(), value.size());
+  });
+}
+
+std::vector<Status> RocksEngine::multiGetView(const std::vector<std::string>& keys,
+                                              const ValueVisitor& visitor) {
   memory::MemoryCheckOffGuard guard;
   rocksdb::ReadOptions options;
+  options.async_io = FLAGS_rocksdb_enable_async_io;
   std::vector<rocksdb::Slice> slices;
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs;
   for (size_t index = 0; index < keys.size(); index++) {
     slices.emplace_back(keys[index]);
+    cfs.emplace_back(columnFamilies_.of(keys[index]));
   }
 
-  auto status = db_->MultiGet(options, slices, values);
+  // The batched MultiGet looks up the keys of the same block and file together, the keys sorted
+  // already, such as the keys of an index scan in the same column family, skip its sorting
+  bool sorted = !columnFamilies_.separated() && std::is_sorted(keys.begin(), keys.end());
+  std::vector<rocksdb::PinnableSlice> pinnables(keys.size());
+  std::vector<rocksdb::Status> status(keys.size());
+  db_->MultiGet(options,
+                slices.size(),
+                cfs.data(),
+                slices.data(),
+                pinnables.data(),
+                status.data(),
+                sorted);
+  for (size_t index = 0; index < keys.size(); index++) {
+    if (status[index].ok()) {
+      visitor(index, folly::StringPiece(pinnables[index].data(), pinnables[index].size()));
+    }
+  }
   std::vector<Status> ret;
   std::transform(status.begin(), status.end(), std::back_inserter(ret), [](const auto& s) {
     if (s.ok()) {
@@ -187,20 +386,38 @@ nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
                                            const std::string& end,
                                            std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
-  storageIter->reset(new RocksRangeIter(start, end));
+  auto cfs = columnFamilies_.ofRange(start, end);
+  if (cfs.size() == 1) {
+    *storageIter = rangeIter(cfs.front(), start, end);
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  std::vector<std::unique_ptr<KVIterator>> iters;
+  for (auto* cf : cfs) {
+    iters.emplace_back(rangeIter(cf, start, end));
+  }
+  storageIter->reset(new RocksMergedIter(std::move(iters)));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+std::unique_ptr<KVIterator> RocksEngine::rangeIter(rocksdb::ColumnFamilyHandle* cf,
+                                                   const std::string& start,
+                                                   const std::string& end) {
+  auto storageIter = std::make_unique<RocksRangeIter>(start, end);
   rocksdb::ReadOptions options;
-  options.iterate_upper_bound = dynamic_cast<RocksRangeIter*>(storageIter->get())->upperBound();
+  options.iterate_upper_bound = storageIter->upperBound();
+  options.readahead_size = FLAGS_rocksdb_range_readahead_size;
+  setScanOptions(&options);
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cf));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
-    dynamic_cast<RocksRangeIter*>(storageIter->get())->reset(std::move(iter));
+    storageIter->reset(std::move(iter));
   }
-  return nebula::cpp2::ErrorCode::SUCCEEDED;
+  return storageIter;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefix(const std::string& prefix,
@@ -209,7 +426,8 @@ nebula::cpp2::ErrorCode RocksEngine::prefix(const std::string& prefix,
   memory::MemoryCheckOffGuard guard;
   // In fact, we don't need to check prefix.size() >= extractorLen_, which is caller's duty to make
   // sure the prefix bloom filter exists. But this is quite error-prone, so we do a check here.
-  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen_) {
+  auto extractorLen = NebulaKeyUtils::isEdgeType(prefix) ? edgeExtractorLen_ : extractorLen_;
+  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen) {
     return prefixWithExtractor(prefix, snapshot, storageIter);
   } else {
     return prefixWithoutExtractor(prefix, snapshot, storageIter);
@@ -220,37 +438,24 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithExtractor(const std::string& pref
                                                          const void* snapshot,
                                                          std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
-  storageIter->reset(new RocksPrefixIter(prefix));
-  rocksdb::ReadOptions options;
-  options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
-  if (UNLIKELY(snapshot != nullptr)) {
-    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
-  }
-  options.prefix_same_as_start = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
-  if (iter) {
-    iter->Seek(rocksdb::Slice(prefix));
-    dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
-  }
+  *storageIter =
+      prefixIter(columnFamilies_.of(prefix), prefix, prefix, snapshot, SeekMode::kPrefix);
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
     const std::string& prefix, const void* snapshot, std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
-  storageIter->reset(new RocksPrefixIter(prefix));
-  rocksdb::ReadOptions options;
-  options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
-  if (snapshot != nullptr) {
-    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
-  }
-  // prefix_same_as_start is false by default
-  options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
-  if (iter) {
-    iter->Seek(rocksdb::Slice(prefix));
-    dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
+  if (prefix.empty() && columnFamilies_.separated()) {
+    std::vector<std::unique_ptr<KVIterator>> iters;
+    for (auto* cf : columnFamilies_.all()) {
+      iters.emplace_back(prefixIter(cf, prefix, prefix, snapshot, SeekMode::kTotalOrder));
+    }
+    storageIter->reset(new RocksMergedIter(std::move(iters)));
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
+  *storageIter =
+      prefixIter(columnFamilies_.of(prefix), prefix, prefix, snapshot, SeekMode::kTotalOrder);
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
@@ -258,36 +463,74 @@ nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
                                                      const std::string& prefix,
                                                      std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
-  storageIter->reset(new RocksPrefixIter(prefix));
+  if (prefix.empty() && columnFamilies_.separated()) {
+    std::vector<std::unique_ptr<KVIterator>> iters;
+    for (auto* cf : columnFamilies_.ofRange(start, "")) {
+      iters.emplace_back(prefixIter(cf, start, prefix, nullptr, SeekMode::kRange));
+    }
+    storageIter->reset(new RocksMergedIter(std::move(iters)));
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  *storageIter = prefixIter(columnFamilies_.of(prefix), start, prefix, nullptr, SeekMode::kRange);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+std::unique_ptr<KVIterator> RocksEngine::prefixIter(rocksdb::ColumnFamilyHandle* cf,
+                                                    const std::string& start,
+                                                    const std::string& prefix,
+                                                    const void* snapshot,
+                                                    SeekMode mode) {
+  auto storageIter = std::make_unique<RocksPrefixIter>(prefix);
   rocksdb::ReadOptions options;
-  options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
-  if (!isPlainTable_) {
-    options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
-  } else {
+  options.iterate_upper_bound = storageIter->upperBound();
+  if (snapshot != nullptr) {
+    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  }
+  if (mode == SeekMode::kPrefix) {
     options.prefix_same_as_start = true;
+  } else if (mode == SeekMode::kRange) {
+    options.readahead_size = FLAGS_rocksdb_range_readahead_size;
+    if (!isPlainTable_) {
+      options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
+    } else {
+      options.prefix_same_as_start = true;
+    }
+  } else {
+    // prefix_same_as_start is false by default
+    options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  setScanOptions(&options);
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cf));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
-    dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
+    storageIter->reset(std::move(iter));
   }
-  return nebula::cpp2::ErrorCode::SUCCEEDED;
+  return storageIter;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
   rocksdb::ReadOptions options;
   options.total_order_seek = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
-  iter->SeekToFirst();
-  storageIter->reset(new RocksCommonIter(std::move(iter)));
+  setScanOptions(&options);
+  std::vector<std::unique_ptr<KVIterator>> iters;
+  for (auto* cf : columnFamilies_.all()) {
+    std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cf));
+    iter->SeekToFirst();
+    iters.emplace_back(new RocksCommonIter(std::move(iter)));
+  }
+  if (iters.size() == 1) {
+    *storageIter = std::move(iters.front());
+  } else {
+    storageIter->reset(new RocksMergedIter(std::move(iters)));
+  }
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  rocksdb::Status status = db_->Put(options, key, value);
+  rocksdb::Status status = db_->Put(options, columnFamilies_.of(key), key, value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -299,7 +542,7 @@ nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
 nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
   rocksdb::WriteBatch updates(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keyValues.size(); i++) {
-    updates.Put(keyValues[i].first, keyValues[i].second);
+    updates.Put(columnFamilies_.of(keyValues[i].first), keyValues[i].first, keyValues[i].second);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -315,7 +558,7 @@ nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
 nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->Delete(options, key);
+  auto status = db_->Delete(options, columnFamilies_.of(key), key);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -327,7 +570,7 @@ nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
 nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys) {
   rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keys.size(); i++) {
-    deletes.Delete(keys[i]);
+    deletes.Delete(columnFamilies_.of(keys[i]), keys[i]);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -341,9 +584,13 @@ nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys)
 }
 
 nebula::cpp2::ErrorCode RocksEngine::removeRange(const std::string& start, const std::string& end) {
+  rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
+  for (auto* cf : columnFamilies_.ofRange(start, end)) {
+    deletes.DeleteRange(cf, start, end);
+  }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+  auto status = db_->Write(options, &deletes);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -474,6 +721,14 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   if (files.empty()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
+  int64_t bytes = 0;
+  for (const auto& file : files) {
+    bytes += FileUtils::fileSize(file.c_str());
+  }
+  IOScheduler::instance().consume(dataPath_, IOClass::kIngest, bytes);
+  if (columnFamilies_.separated()) {
+    return ingestIntoColumnFamilies(files, verifyFileChecksum);
+  }
   rocksdb::IngestExternalFileOptions options;
   options.move_files = FLAGS_move_files;
   options.verify_file_checksum = verifyFileChecksum;
@@ -486,11 +741,70 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   }
 }
 
+bool RocksEngine::isWriteStopped() const {
+  return stallListener_ != nullptr &&
+         stallListener_->condition() == rocksdb::WriteStallCondition::kStopped;
+}
+
+nebula::cpp2::ErrorCode RocksEngine::ingestIntoColumnFamilies(const std::vector<std::string>& files,
+                                                              bool verifyFileChecksum) {
+  // An external file could only be ingested into one column family, so the keys are written in
+  // batches instead
+  static constexpr size_t kIngestBatchBytes = 16 * 1024 * 1024;
+  rocksdb::Options options;
+  rocksdb::WriteOptions writeOptions;
+  writeOptions.disableWAL = FLAGS_rocksdb_disable_wal;
+  for (const auto& file : files) {
+    rocksdb::SstFileReader reader(options);
+    auto status = reader.Open(file);
+    if (status.ok() && verifyFileChecksum) {
+      status = reader.VerifyChecksum();
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Ingest Failed: " << file << " " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+    rocksdb::WriteBatch batch(FLAGS_rocksdb_batch_size);
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      auto key = iter->key();
+      batch.Put(columnFamilies_.of(folly::StringPiece(key.data(), key.size())), key, iter->value());
+      if (batch.GetDataSize() >= kIngestBatchBytes) {
+        status = db_->Write(writeOptions, &batch);
+        if (!status.ok()) {
+          break;
+        }
+        batch.Clear();
+      }
+    }
+    if (status.ok()) {
+      status = iter->status();
+    }
+    if (status.ok()) {
+      status = db_->Write(writeOptions, &batch);
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Ingest Failed: " << file << " " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    if (FLAGS_move_files) {
+      FileUtils::remove(file.c_str());
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::setOption(const std::string& configKey,
                                                const std::string& configValue) {
   std::unordered_map<std::string, std::string> configOptions = {{configKey, configValue}};
 
-  rocksdb::Status status = db_->SetOptions(configOptions);
+  rocksdb::Status status;
+  for (auto* cf : columnFamilies_.all()) {
+    status = db_->SetOptions(cf, configOptions);
+    if (!status.ok()) {
+      break;
+    }
+  }
   if (status.ok()) {
     LOG(INFO) << "SetOption Succeeded: " << configKey << ":" << configValue;
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -516,6 +830,13 @@ nebula::cpp2::ErrorCode RocksEngine::setDBOption(const std::string& configKey,
 
 ErrorOr<nebula::cpp2::ErrorCode, std::string> RocksEngine::getProperty(
     const std::string& property) {
+  if (columnFamilies_.separated()) {
+    // The integer properties are aggregated over all column families
+    uint64_t aggregated = 0;
+    if (db_->GetAggregatedIntProperty(property, &aggregated)) {
+      return folly::to<std::string>(aggregated);
+    }
+  }
   std::string value;
   if (!db_->GetProperty(property, &value)) {
     return nebula::cpp2::ErrorCode::E_INVALID_PARM;
@@ -528,7 +849,14 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   rocksdb::CompactRangeOptions options;
   options.change_level = FLAGS_rocksdb_compact_change_level;
   options.target_level = FLAGS_rocksdb_compact_target_level;
-  rocksdb::Status status = db_->CompactRange(options, nullptr, nullptr);
+  // Each column family is compacted independently
+  rocksdb::Status status;
+  for (auto* cf : columnFamilies_.all()) {
+    status = db_->CompactRange(options, cf, nullptr, nullptr);
+    if (!status.ok()) {
+      break;
+    }
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -537,9 +865,76 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::compactRange(const std::string& start,
+                                                  const std::string& end) {
+  rocksdb::CompactRangeOptions options;
+  options.exclusive_manual_compaction = false;
+  options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+  rocksdb::Slice beginKey(start);
+  rocksdb::Slice endKey(end);
+  auto status = db_->CompactRange(options, columnFamilies_.of(start), &beginKey, &endKey);
+  if (!status.ok()) {
+    LOG(WARNING) << "Compact the range failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode RocksEngine::compactExpired(double ratio) {
+  std::vector<rocksdb::LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  std::unordered_map<std::string, const rocksdb::LiveFileMetaData*> filesByPath;
+  for (const auto& file : files) {
+    filesByPath.emplace(file.db_path + file.name, &file);
+  }
+
+  auto now = time::WallClock::fastNowInMilliSec();
+  rocksdb::CompactRangeOptions options;
+  options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+  for (auto* cf : columnFamilies_.all()) {
+    rocksdb::TablePropertiesCollection props;
+    auto status = db_->GetPropertiesOfAllTables(cf, &props);
+    if (!status.ok()) {
+      LOG(WARNING) << "Get the table properties failed: " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    std::vector<std::pair<std::string, std::string>> ranges;
+    for (const auto& [path, tableProps] : props) {
+      auto ttl = TtlTableProperties::parse(*tableProps);
+      auto file = filesByPath.find(path);
+      if (!ttl.has_value() || file == filesByPath.end() || tableProps->num_entries == 0 ||
+          ttl->expiredKeys(now) < ratio * tableProps->num_entries) {
+        continue;
+      }
+      ranges.emplace_back(file->second->smallestkey, file->second->largestkey);
+    }
+    // The overlapped ranges are compacted once
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 0; i < ranges.size();) {
+      auto end = ranges[i].second;
+      size_t next = i + 1;
+      while (next < ranges.size() && ranges[next].first <= end) {
+        end = std::max(end, ranges[next].second);
+        ++next;
+      }
+      // The range is compacted through the filter dropping the expired keys
+      rocksdb::Slice beginKey(ranges[i].first);
+      rocksdb::Slice endKey(end);
+      VLOG(1) << "Compact the expired keys of " << next - i << " files in space " << spaceId_;
+      status = db_->CompactRange(options, cf, &beginKey, &endKey);
+      if (!status.ok()) {
+        LOG(WARNING) << "Compact the expired keys failed: " << status.ToString();
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+      i = next;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::flush() {
   rocksdb::FlushOptions options;
-  rocksdb::Status status = db_->Flush(options);
+  rocksdb::Status status = db_->Flush(options, columnFamilies_.all());
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -626,9 +1021,58 @@ nebula::cpp2::ErrorCode RocksEngine::createCheckpoint(const std::string& checkpo
     LOG(WARNING) << "Create checkpoint Failed: " << status.ToString();
     return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
   }
+
+  auto files = FileUtils::listAllFilesInDir(checkpointPath.c_str(), false, "*.sst");
+  std::sort(files.begin(), files.end());
+  std::string manifest;
+  for (const auto& file : files) {
+    auto bytes = FileUtils::fileSize(folly::sformat("{}/{}", checkpointPath, file).c_str());
+    manifest.append(folly::sformat("{} {}\n", file, bytes));
+  }
+  // Written by renaming, so a manifest found is always complete
+  auto manifestPath = folly::sformat("{}/{}", checkpointPath, kSstManifest);
+  auto tmpPath = manifestPath + ".tmp";
+  if (!folly::writeFile(manifest, tmpPath.c_str()) ||
+      ::rename(tmpPath.c_str(), manifestPath.c_str()) != 0) {
+    LOG(WARNING) << "Write the sst manifest failed: " << manifestPath;
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+ErrorOr<nebula::cpp2::ErrorCode, int64_t> RocksEngine::writeSstFile(const std::string& path,
+                                                                   const std::string& prefix,
+                                                                   const void* snapshot) {
+  std::unique_ptr<KVIterator> iter;
+  auto ret = this->prefix(prefix, &iter, snapshot);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  if (!iter->valid()) {
+    return 0;
+  }
+
+  rocksdb::SstFileWriter sstFileWriter(rocksdb::EnvOptions(), rocksdb::Options());
+  auto s = sstFileWriter.Open(path);
+  int64_t count = 0;
+  for (; s.ok() && iter->valid(); iter->next()) {
+    auto key = iter->key();
+    auto val = iter->val();
+    s = sstFileWriter.Put(rocksdb::Slice(key.data(), key.size()),
+                          rocksdb::Slice(val.data(), val.size()));
+    ++count;
+  }
+  if (s.ok()) {
+    s = sstFileWriter.Finish();
+  }
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to write the sst file " << path << ", error: " << s.ToString();
+    unlink(path.c_str());
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  return count;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::string> RocksEngine::backupTable(
     const std::string& name,
     const std::string& tablePrefix,
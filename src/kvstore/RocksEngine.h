@@ -11,6 +11,7 @@
 #include <rocksdb/utilities/backup_engine.h>
 #include <rocksdb/utilities/checkpoint.h>
 
+#include <array>
 #include <memory>
 
 #include "common/base/Base.h"
@@ -22,6 +23,8 @@
 namespace nebula {
 namespace kvstore {
 
+class WriteStallListener;
+
 /**
  * @brief Rocksdb range iterator, only scan data in range [start, end)
  */
@@ -173,6 +176,137 @@ class RocksCommonIter : public KVIterator {
   std::unique_ptr<rocksdb::Iterator> iter_;
 };
 
+/**
+ * @brief Merge the iterators of several column families in the order of keys, only iterate
+ * forward. The keys of different column families never overlap.
+ */
+class RocksMergedIter : public KVIterator {
+ public:
+  explicit RocksMergedIter(std::vector<std::unique_ptr<KVIterator>> iters)
+      : iters_(std::move(iters)) {
+    pick();
+  }
+
+  ~RocksMergedIter() = default;
+
+  bool valid() const override {
+    return current_ != nullptr;
+  }
+
+  void next() override {
+    current_->next();
+    pick();
+  }
+
+  void prev() override {
+    LOG(FATAL) << "RocksMergedIter only iterates forward";
+  }
+
+  folly::StringPiece key() const override {
+    return current_->key();
+  }
+
+  folly::StringPiece val() const override {
+    return current_->val();
+  }
+
+ private:
+  void pick() {
+    current_ = nullptr;
+    for (auto& iter : iters_) {
+      if (iter->valid() && (current_ == nullptr || iter->key() < current_->key())) {
+        current_ = iter.get();
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<KVIterator>> iters_;
+  KVIterator* current_{nullptr};
+};
+
+/**
+ * @brief Column families of a rocksdb instance. All keys are in the default column family, unless
+ * the column families are separated, then the vertices, edges and indexes are routed to their own
+ * column families by the NebulaKeyType in the first byte of the key, and the other keys such as
+ * system keys and operation logs stay in the default one.
+ */
+class RocksColumnFamilies {
+ public:
+  /**
+   * @brief Names of the separated column families, the first one is the default column family
+   */
+  static const std::vector<std::string>& separatedNames() {
+    static const std::vector<std::string> names = {rocksdb::kDefaultColumnFamilyName,
+                                                   kVertexColumnFamily,
+                                                   kEdgeColumnFamily,
+                                                   kIndexColumnFamily};
+    return names;
+  }
+
+  /**
+   * @brief Set the column family handles opened in the order of separatedNames, or only the
+   * default column family
+   */
+  void reset(std::vector<rocksdb::ColumnFamilyHandle*> handles) {
+    handles_ = std::move(handles);
+    byType_.fill(handles_.front());
+    if (separated()) {
+      byType_[static_cast<uint8_t>(NebulaKeyType::kTag_)] = handles_[1];
+      byType_[static_cast<uint8_t>(NebulaKeyType::kVertex)] = handles_[1];
+      byType_[static_cast<uint8_t>(NebulaKeyType::kEdge)] = handles_[2];
+      byType_[static_cast<uint8_t>(NebulaKeyType::kIndex)] = handles_[3];
+    }
+  }
+
+  bool separated() const {
+    return handles_.size() > 1;
+  }
+
+  const std::vector<rocksdb::ColumnFamilyHandle*>& all() const {
+    return handles_;
+  }
+
+  /**
+   * @brief The column family of the key, or of all keys with the key as prefix
+   */
+  rocksdb::ColumnFamilyHandle* of(folly::StringPiece key) const {
+    if (key.empty()) {
+      return handles_.front();
+    }
+    return byType_[static_cast<uint8_t>(key[0])];
+  }
+
+  /**
+   * @brief The column families which may have keys in range [start, end), an empty end means no
+   * upper bound
+   */
+  std::vector<rocksdb::ColumnFamilyHandle*> ofRange(folly::StringPiece start,
+                                                    folly::StringPiece end) const {
+    if (!separated()) {
+      return handles_;
+    }
+    uint8_t first = start.empty() ? 0 : static_cast<uint8_t>(start[0]);
+    uint8_t last = end.empty() ? 0xFF : static_cast<uint8_t>(end[0]);
+    std::vector<rocksdb::ColumnFamilyHandle*> ret;
+    for (auto* handle : handles_) {
+      for (uint32_t type = first; type <= last; type++) {
+        if (byType_[type] == handle) {
+          ret.emplace_back(handle);
+          break;
+        }
+      }
+    }
+    if (ret.empty()) {
+      ret.emplace_back(of(start));
+    }
+    return ret;
+  }
+
+ private:
+  std::vector<rocksdb::ColumnFamilyHandle*> handles_;
+  std::array<rocksdb::ColumnFamilyHandle*, 256> byType_;
+};
+
 /***************************************
  *
  * Implementation of WriteBatch
@@ -181,14 +315,26 @@ class RocksCommonIter : public KVIterator {
 class RocksWriteBatch : public WriteBatch {
  private:
   rocksdb::WriteBatch batch_;
+  // The default column family is used for all keys if not set
+  const RocksColumnFamilies* columnFamilies_{nullptr};
+
+  rocksdb::ColumnFamilyHandle* columnFamilyOf(folly::StringPiece key) const {
+    return columnFamilies_ == nullptr ? nullptr : columnFamilies_->of(key);
+  }
 
  public:
   RocksWriteBatch() : batch_(FLAGS_rocksdb_batch_size) {}
 
+  explicit RocksWriteBatch(const RocksColumnFamilies* columnFamilies)
+      : batch_(FLAGS_rocksdb_batch_size), columnFamilies_(columnFamilies) {}
+
   virtual ~RocksWriteBatch() = default;
 
   nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
-    if (batch_.Put(toSlice(key), toSlice(value)).ok()) {
+    auto* cf = columnFamilyOf(key);
+    auto status = cf == nullptr ? batch_.Put(toSlice(key), toSlice(value))
+                                : batch_.Put(cf, toSlice(key), toSlice(value));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -196,7 +342,9 @@ class RocksWriteBatch : public WriteBatch {
   }
 
   nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
-    if (batch_.Delete(toSlice(key)).ok()) {
+    auto* cf = columnFamilyOf(key);
+    auto status = cf == nullptr ? batch_.Delete(toSlice(key)) : batch_.Delete(cf, toSlice(key));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -205,7 +353,26 @@ class RocksWriteBatch : public WriteBatch {
 
   // Remove all keys in the range [start, end)
   nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
-    if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
+    if (columnFamilies_ == nullptr) {
+      if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      } else {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+    }
+    for (auto* cf : columnFamilies_->ofRange(start, end)) {
+      if (!batch_.DeleteRange(cf, toSlice(start), toSlice(end)).ok()) {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode merge(folly::StringPiece key, folly::StringPiece operand) override {
+    auto* cf = columnFamilyOf(key);
+    auto status = cf == nullptr ? batch_.Merge(toSlice(key), toSlice(operand))
+                                : batch_.Merge(cf, toSlice(key), toSlice(operand));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -215,6 +382,10 @@ class RocksWriteBatch : public WriteBatch {
   rocksdb::WriteBatch* data() {
     return &batch_;
   }
+
+  const RocksColumnFamilies* columnFamilies() const {
+    return columnFamilies_;
+  }
 };
 /**
  * @brief An implementation of KVEngine based on Rocksdb
@@ -245,6 +416,11 @@ class RocksEngine : public KVEngine {
 
   ~RocksEngine() {
     LOG(INFO) << "Release rocksdb on " << dataPath_;
+    if (db_ != nullptr && columnFamilies_.separated()) {
+      for (auto* handle : columnFamilies_.all()) {
+        db_->DestroyColumnFamilyHandle(handle);
+      }
+    }
   }
 
   void stop() override;
@@ -264,6 +440,13 @@ class RocksEngine : public KVEngine {
     return walPath_.c_str();
   }
 
+  /**
+   * @brief Return the path of the cold sst files, e.g. "/ColdDataPath/nebula/spaceId"
+   */
+  std::string getColdDataRoot() const override {
+    return coldDataPath_;
+  }
+
   /**
    * @brief Get the rocksdb snapshot
    *
@@ -329,6 +512,18 @@ class RocksEngine : public KVEngine {
   std::vector<Status> multiGet(const std::vector<std::string>& keys,
                                std::vector<std::string>* values) override;
 
+  /**
+   * @brief Read a list of keys by the batched MultiGet, the values are pinned in the block cache or
+   * memtable rather than copied, and passed to the visitor in place
+   *
+   * @param keys Keys to read
+   * @param visitor Called with the index and the value of each existing key
+   * @return std::vector<Status> Result status of each key, if key[i] does not exist, the i-th value
+   * in return value would be Status::KeyNotFound
+   */
+  std::vector<Status> multiGetView(const std::vector<std::string>& keys,
+                                   const ValueVisitor& visitor) override;
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -496,6 +691,11 @@ class RocksEngine : public KVEngine {
   nebula::cpp2::ErrorCode ingest(const std::vector<std::string>& files,
                                  bool verifyFileChecksum = false) override;
 
+  /**
+   * @brief Whether any column family of rocksdb is in the stopped stall condition
+   */
+  bool isWriteStopped() const override;
+
   /**
    * @brief Set config option
    *
@@ -531,6 +731,21 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode compact() override;
 
+  /**
+   * @brief Compact the keys in [start, end] of the column family of start, the background
+   * compactions go on meanwhile
+   */
+  nebula::cpp2::ErrorCode compactRange(const std::string& start, const std::string& end) override;
+
+  /**
+   * @brief Compact the key ranges of the sst files of many keys expired, by the ttl properties
+   * collected when they are written
+   *
+   * @param ratio Estimated keys expired of all in a file
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode compactExpired(double ratio) override;
+
   /**
    * @brief Flush data in memtable into sst
    *
@@ -549,13 +764,31 @@ class RocksEngine : public KVEngine {
    * Checkpoint operation
    ********************/
   /**
-   * @brief Create a rocksdb check point
+   * @brief Create a rocksdb check point, with the manifest of its sst files in kSstManifest. The
+   * sst files are immutable and named uniquely in a db, so a backup only uploads the ones missing
+   * from the manifest of the previous backup
    *
    * @param checkpointPath
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode createCheckpoint(const std::string& checkpointPath) override;
 
+  // The manifest in a checkpoint, a line of "<name> <bytes>" for each sst file sorted by the name
+  static constexpr const char* kSstManifest = "SST_MANIFEST";
+
+  /**
+   * @brief Write the data of a prefix into a sst file, for sending the snapshot in files
+   *
+   * @param path Path of the sst file
+   * @param prefix The prefix of keys to write
+   * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
+   * @return ErrorOr<nebula::cpp2::ErrorCode, int64_t> Count of keys written, the file is not
+   * created if there is no key
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, int64_t> writeSstFile(const std::string& path,
+                                                         const std::string& prefix,
+                                                         const void* snapshot = nullptr) override;
+
   /**
    * @brief Backup the data of a table prefix, for meta backup
    *
@@ -594,16 +827,67 @@ class RocksEngine : public KVEngine {
    */
   void openBackupEngine(GraphSpaceID spaceId);
 
+  /**
+   * @brief Open the rocksdb instance with the separated column families, or only the default one
+   *
+   * @param options Rocksdb options
+   * @param path Rocksdb data path
+   * @param readonly Whether open as read only instance
+   * @param db Opened rocksdb instance
+   * @return rocksdb::Status
+   */
+  rocksdb::Status openDB(const rocksdb::Options& options,
+                         const std::string& path,
+                         bool readonly,
+                         rocksdb::DB** db);
+
+  /**
+   * @brief Create the iterator of a column family in range [start, end)
+   */
+  std::unique_ptr<KVIterator> rangeIter(rocksdb::ColumnFamilyHandle* cf,
+                                        const std::string& start,
+                                        const std::string& end);
+
+  // How the prefix iterator seeks: with prefix extractor, by total order seek, or as a range scan
+  enum class SeekMode {
+    kPrefix,
+    kTotalOrder,
+    kRange,
+  };
+
+  /**
+   * @brief Create the iterator of a column family of keys starts with 'prefix' beginning from
+   * 'start'
+   */
+  std::unique_ptr<KVIterator> prefixIter(rocksdb::ColumnFamilyHandle* cf,
+                                         const std::string& start,
+                                         const std::string& prefix,
+                                         const void* snapshot,
+                                         SeekMode mode);
+
+  /**
+   * @brief Ingest the sst files by writing their keys into the separated column families, the
+   * keys of a file could belong to different column families
+   */
+  nebula::cpp2::ErrorCode ingestIntoColumnFamilies(const std::vector<std::string>& files,
+                                                   bool verifyFileChecksum);
+
  private:
   GraphSpaceID spaceId_;
   std::string dataPath_;
   std::string walPath_;
+  // The lower levels are placed in it if the data path has a cold data path
+  std::string coldDataPath_;
   std::unique_ptr<rocksdb::DB> db_{nullptr};
+  RocksColumnFamilies columnFamilies_;
   std::string backupPath_;
   std::unique_ptr<rocksdb::BackupEngine> backupDb_{nullptr};
   int32_t partsNum_ = -1;
   size_t extractorLen_;
+  // The length of the prefixes of the edge keys, which covers the edge types if useEdgeTypePrefix
+  size_t edgeExtractorLen_;
   bool isPlainTable_{false};
+  std::shared_ptr<WriteStallListener> stallListener_;
 };
 
 }  // namespace kvstore
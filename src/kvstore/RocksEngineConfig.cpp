@@ -5,6 +5,7 @@
 
 #include "kvstore/RocksEngineConfig.h"
 
+#include <folly/String.h>
 #include <rocksdb/cache.h>
 #include <rocksdb/concurrent_task_limiter.h>
 #include <rocksdb/convenience.h>
@@ -13,6 +14,7 @@
 #include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/utilities/options_util.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
 
 #include "common/base/Base.h"
 #include "common/conf/Configuration.h"
@@ -28,16 +30,49 @@ DEFINE_bool(rocksdb_wal_sync, false, "Whether WAL writes are synchronized to dis
 // [DBOptions]
 DEFINE_string(rocksdb_db_options, "{}", "json string of DBOptions, all keys and values are string");
 
+DEFINE_bool(rocksdb_enable_pipelined_write,
+            true,
+            "Whether the WAL writes and the memtable writes of the batches committed by the parts "
+            "are pipelined, unless enable_pipelined_write or unordered_write is set in "
+            "rocksdb_db_options");
+
 // [CFOptions "default"]
 DEFINE_string(rocksdb_column_family_options,
               "{}",
               "json string of ColumnFamilyOptions, all keys and values are string");
 
+// [CFOptions "vertex"], [CFOptions "edge"] and [CFOptions "index"]
+DEFINE_bool(rocksdb_separate_column_families,
+            false,
+            "Whether to store the vertices, edges and indexes of a new space in their own column "
+            "families, the existing spaces keep their layout");
+
+DEFINE_string(rocksdb_vertex_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the vertices, which overrides "
+              "rocksdb_column_family_options, only used if rocksdb_separate_column_families");
+
+DEFINE_string(rocksdb_edge_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the edges, which overrides "
+              "rocksdb_column_family_options, only used if rocksdb_separate_column_families");
+
+DEFINE_string(rocksdb_index_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the indexes, which overrides "
+              "rocksdb_column_family_options, only used if rocksdb_separate_column_families");
+
 //  [TableOptions/BlockBasedTable "default"]
 DEFINE_string(rocksdb_block_based_table_options,
               "{}",
               "json string of BlockBasedTableOptions, all keys and values are string");
 
+DEFINE_int32(rocksdb_index_block_restart_interval,
+             16,
+             "The number of the keys between the restart points of the delta encoding of the index "
+             "blocks, unless it's set in rocksdb_block_based_table_options. 1 disables the delta "
+             "encoding, which is rocksdb's default.");
+
 DEFINE_int32(rocksdb_batch_size, 4 * 1024, "default reserved bytes for one batch operation");
 
 /*
@@ -56,6 +91,21 @@ DEFINE_bool(disable_page_cache,
 
 DEFINE_int32(rocksdb_row_cache_num, 16 * 1000 * 1000, "Total keys inside the cache");
 
+DEFINE_string(rocksdb_space_block_cache,
+              "{}",
+              "json map of the space ids to the sizes of their own block caches in MB, e.g. "
+              "{\"1\":\"512\"}, the other spaces share rocksdb_block_cache");
+
+DEFINE_string(rocksdb_space_row_cache_num,
+              "{}",
+              "json map of the space ids to the numbers of the keys of their own row caches, the "
+              "other spaces share rocksdb_row_cache_num");
+
+DEFINE_bool(rocksdb_scan_fill_cache,
+            false,
+            "Whether the blocks read by the scans over the whole parts, e.g. ScanVertex, ScanEdge "
+            "and rebuilding the indexes, are put into the block cache");
+
 DEFINE_int32(cache_bucket_exp, 8, "Total buckets number is 1 << cache_bucket_exp");
 
 DEFINE_bool(enable_partitioned_index_filter, false, "True for partitioned index filters");
@@ -80,6 +130,10 @@ DEFINE_string(rocksdb_compression_per_level,
 
 DEFINE_bool(enable_rocksdb_statistics, false, "Whether or not to enable rocksdb's statistics");
 DEFINE_string(rocksdb_stats_level, "kExceptHistogramOrTimers", "rocksdb statistics level");
+DEFINE_double(rocksdb_perf_context_sample_ratio,
+              0,
+              "The ratio of the read requests whose rocksdb perf context is counted by the "
+              "processor, in [0, 1]. The requests profiled are always counted");
 
 DEFINE_int32(num_compaction_threads, 0, "Number of total compaction threads. 0 means unlimited.");
 
@@ -95,6 +149,28 @@ DEFINE_bool(enable_rocksdb_prefix_filtering,
             true,
             "Whether or not to enable rocksdb's prefix bloom filter.");
 
+DEFINE_string(rocksdb_edge_type_prefix_filter_spaces,
+              "",
+              "Comma separated ids of the spaces whose prefix bloom filters of the edges cover the "
+              "edge types, so seeking the edges of a type skips the blocks of the other types. "
+              "Seeking all the edges of a vertex no longer uses the filter in these spaces.");
+
+DEFINE_uint64(rocksdb_range_readahead_size,
+              0,
+              "The bytes prefetched ahead by the iterator of range scans, such as the range scans "
+              "of index. 0 means rocksdb's auto readahead, which grows after sequential reads.");
+
+DEFINE_uint64(rocksdb_scan_readahead_size,
+              0,
+              "The bytes prefetched ahead by the iterators of the scans over whole parts, such as "
+              "the stats or rebuilding an index. 0 means rocksdb's auto readahead.");
+
+DEFINE_bool(rocksdb_enable_async_io,
+            false,
+            "Whether the batched MultiGet reads the blocks of different files in parallel, and "
+            "the scans over whole parts prefetch the blocks ahead in the background, by async "
+            "io, which needs rocksdb built with io_uring");
+
 DEFINE_bool(rocksdb_compact_change_level,
             true,
             "If true, compacted files will be moved to the minimum level capable "
@@ -116,6 +192,18 @@ DEFINE_string(rocksdb_table_format,
 
 DEFINE_string(rocksdb_wal_dir, "", "Rocksdb wal directory");
 
+DEFINE_string(rocksdb_cold_data_paths,
+              "{}",
+              "json map of the data paths to the directories on the slower volumes, e.g. "
+              "{\"/data/nvme\":\"/data/hdd\"}, where the lower levels of the sst files of the "
+              "spaces on the data paths are placed");
+
+DEFINE_int32(rocksdb_hot_levels,
+             3,
+             "The number of the levels of the sst files kept in the data path if it has a cold "
+             "data path, e.g. 3 keeps L0 to L2, whose sizes are estimated by "
+             "max_bytes_for_level_base and max_bytes_for_level_multiplier");
+
 DEFINE_string(rocksdb_backup_dir, "", "Rocksdb backup directory, only used in PlainTable format");
 
 DEFINE_int32(rocksdb_backup_interval_secs,
@@ -142,6 +230,15 @@ DEFINE_bool(rocksdb_enable_blob_garbage_collection,
             "Set this to true to make BlobDB actively relocate valid blobs "
             "from the oldest blob files as they are encountered during compaction");
 
+DEFINE_uint64(rocksdb_deletion_compaction_window,
+              128 * 1024,
+              "sliding window of the keys of a sst file in which the tombstones are counted, the "
+              "files of dense tombstones are compacted, 0 means disabled");
+
+DEFINE_uint64(rocksdb_deletion_compaction_trigger,
+              16 * 1024,
+              "a sst file is compacted once any sliding window of it has so many tombstones");
+
 namespace nebula {
 namespace kvstore {
 
@@ -200,6 +297,106 @@ static rocksdb::Status initRocksdbCompression(rocksdb::Options& baseOpts) {
   return rocksdb::Status::OK();
 }
 
+// The prefix of an edge key is its part, src and edge type, and the prefix of the others is the
+// part and the vid, e.g. of a tag key. A key shorter than its prefix is a prefix itself, as
+// NewCappedPrefixTransform.
+class EdgeTypePrefixTransform final : public rocksdb::SliceTransform {
+ public:
+  explicit EdgeTypePrefixTransform(size_t vidLen)
+      : vertexLen_(sizeof(PartitionID) + vidLen),
+        edgeLen_(vertexLen_ + sizeof(EdgeType)),
+        name_("nebula.EdgeTypePrefix." + std::to_string(vidLen)) {}
+
+  const char* Name() const override {
+    return name_.c_str();
+  }
+
+  rocksdb::Slice Transform(const rocksdb::Slice& key) const override {
+    folly::StringPiece rawKey(key.data(), key.size());
+    auto len = NebulaKeyUtils::isEdgeType(rawKey) ? edgeLen_ : vertexLen_;
+    return rocksdb::Slice(key.data(), std::min(key.size(), len));
+  }
+
+  bool InDomain(const rocksdb::Slice&) const override {
+    return true;
+  }
+
+ private:
+  const size_t vertexLen_;
+  const size_t edgeLen_;
+  const std::string name_;
+};
+
+bool useEdgeTypePrefix(GraphSpaceID spaceId) {
+  std::vector<folly::StringPiece> spaces;
+  folly::split(',', FLAGS_rocksdb_edge_type_prefix_filter_spaces, spaces, true);
+  for (auto space : spaces) {
+    auto id = folly::tryTo<GraphSpaceID>(folly::trimWhitespace(space));
+    if (id.hasValue() && id.value() == spaceId) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The caches of the spaces with their own quotas, shared by the engines of the same space on all
+// the data paths
+struct SpaceCaches {
+  using Caches = std::unordered_map<GraphSpaceID, std::shared_ptr<rocksdb::Cache>>;
+
+  std::mutex lock;
+  Caches blockCaches;
+  Caches rowCaches;
+};
+
+static SpaceCaches& spaceCaches() {
+  static SpaceCaches caches;
+  return caches;
+}
+
+// The json map of the space ids to their quotas, which are positive
+static rocksdb::Status loadSpaceQuotas(const std::string& gflags,
+                                       std::unordered_map<GraphSpaceID, int64_t>& quotas) {
+  std::unordered_map<std::string, std::string> map;
+  if (!loadOptionsMap(map, gflags)) {
+    return rocksdb::Status::InvalidArgument("Bad quotas of the spaces: " + gflags);
+  }
+  for (const auto& [space, quota] : map) {
+    auto spaceId = folly::tryTo<GraphSpaceID>(space);
+    auto value = folly::tryTo<int64_t>(quota);
+    if (!spaceId.hasValue() || !value.hasValue() || value.value() <= 0) {
+      return rocksdb::Status::InvalidArgument("Bad quota of space " + space + ": " + quota);
+    }
+    quotas.emplace(spaceId.value(), value.value());
+  }
+  return rocksdb::Status::OK();
+}
+
+// The cache of the space if it has its own quota, otherwise nullptr. It's created once, and
+// resized by updateSpaceCaches.
+static rocksdb::Status spaceCache(const std::string& gflags,
+                                  GraphSpaceID spaceId,
+                                  size_t unit,
+                                  SpaceCaches::Caches& caches,
+                                  std::shared_ptr<rocksdb::Cache>& cache) {
+  std::unordered_map<GraphSpaceID, int64_t> quotas;
+  auto s = loadSpaceQuotas(gflags, quotas);
+  if (!s.ok()) {
+    return s;
+  }
+  auto quota = quotas.find(spaceId);
+  if (quota == quotas.end()) {
+    return rocksdb::Status::OK();
+  }
+  auto& entry = caches[spaceId];
+  if (entry == nullptr) {
+    entry = rocksdb::NewLRUCache(quota->second * unit, FLAGS_cache_bucket_exp);
+    LOG(INFO) << "Space " << spaceId << " has its own cache of " << quota->second * unit;
+  }
+  cache = entry;
+  return rocksdb::Status::OK();
+}
+
 static rocksdb::Status initRocksdbKVSeparation(rocksdb::Options& baseOpts) {
   if (FLAGS_rocksdb_enable_kv_separation) {
     baseOpts.enable_blob_files = true;
@@ -242,6 +439,14 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
     dbOpts.stats_dump_period_sec = 0;  // exposing statistics ourself
   }
   dbOpts.listeners.emplace_back(new EventListener());
+  // The parts of a space on a disk commit into the same db from their own raft threads, the
+  // pipelined writes let the batch of a part be written into the memtables while the next one is
+  // written into the WAL. The commit order, which the raft logs rely on, is kept, unlike by the
+  // unordered writes.
+  if (dbOptsMap.find("enable_pipelined_write") == dbOptsMap.end() &&
+      dbOptsMap.find("unordered_write") == dbOptsMap.end()) {
+    dbOpts.enable_pipelined_write = FLAGS_rocksdb_enable_pipelined_write;
+  }
 
   // if rocksdb_wal_dir is set, specify it to rocksdb
   if (!FLAGS_rocksdb_wal_dir.empty()) {
@@ -281,6 +486,14 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
     baseOpts.use_direct_reads = true;
   }
 
+  if (FLAGS_rocksdb_deletion_compaction_window > 0) {
+    // The files of many tombstones, e.g. by deleting vertices and edges, are compacted to keep
+    // the scans over them fast
+    baseOpts.table_properties_collector_factories.emplace_back(
+        rocksdb::NewCompactOnDeletionCollectorFactory(FLAGS_rocksdb_deletion_compaction_window,
+                                                      FLAGS_rocksdb_deletion_compaction_trigger));
+  }
+
   if (FLAGS_num_compaction_threads > 0) {
     static std::shared_ptr<rocksdb::ConcurrentTaskLimiter> compaction_thread_limiter{
         rocksdb::NewConcurrentTaskLimiter("compaction", FLAGS_num_compaction_threads)};
@@ -304,7 +517,38 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
       return s;
     }
 
-    if (FLAGS_rocksdb_block_cache <= 0) {
+    // The keys are padded to the fixed vid length, so the adjacent separators of the index blocks
+    // share most of their bytes, which are kept once by the delta encoding. The index blocks are
+    // read by a binary search over the restart points followed by a short scan.
+    if (bbtOptsMap.find("index_block_restart_interval") == bbtOptsMap.end()) {
+      bbtOpts.index_block_restart_interval = FLAGS_rocksdb_index_block_restart_interval;
+    }
+
+    // A space with its own quota has its own caches, so the scans or the hot keys of a space
+    // don't evict the blocks of the others
+    std::shared_ptr<rocksdb::Cache> spaceBlockCache;
+    std::shared_ptr<rocksdb::Cache> spaceRowCache;
+    {
+      auto& caches = spaceCaches();
+      std::lock_guard<std::mutex> guard(caches.lock);
+      s = spaceCache(FLAGS_rocksdb_space_block_cache,
+                     spaceId,
+                     1024 * 1024,
+                     caches.blockCaches,
+                     spaceBlockCache);
+      if (!s.ok()) {
+        return s;
+      }
+      s = spaceCache(
+          FLAGS_rocksdb_space_row_cache_num, spaceId, 1, caches.rowCaches, spaceRowCache);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+
+    if (spaceBlockCache != nullptr) {
+      bbtOpts.block_cache = spaceBlockCache;
+    } else if (FLAGS_rocksdb_block_cache <= 0) {
       bbtOpts.no_block_cache = true;
     } else {
       static std::shared_ptr<rocksdb::Cache> blockCache =
@@ -312,7 +556,9 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
       bbtOpts.block_cache = blockCache;
     }
 
-    if (FLAGS_rocksdb_row_cache_num) {
+    if (spaceRowCache != nullptr) {
+      baseOpts.row_cache = spaceRowCache;
+    } else if (FLAGS_rocksdb_row_cache_num) {
       static std::shared_ptr<rocksdb::Cache> rowCache =
           rocksdb::NewLRUCache(FLAGS_rocksdb_row_cache_num, FLAGS_cache_bucket_exp);
       baseOpts.row_cache = rowCache;
@@ -329,8 +575,12 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
           baseOpts.compaction_style == rocksdb::CompactionStyle::kCompactionStyleLevel;
     }
     if (FLAGS_enable_rocksdb_prefix_filtering) {
-      size_t prefixLength = sizeof(PartitionID) + vidLen;
-      baseOpts.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
+      if (useEdgeTypePrefix(spaceId)) {
+        baseOpts.prefix_extractor = std::make_shared<EdgeTypePrefixTransform>(vidLen);
+      } else {
+        size_t prefixLength = sizeof(PartitionID) + vidLen;
+        baseOpts.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
+      }
     }
     bbtOpts.whole_key_filtering = FLAGS_enable_rocksdb_whole_key_filtering;
     baseOpts.table_factory.reset(NewBlockBasedTableFactory(bbtOpts));
@@ -361,6 +611,84 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
   return s;
 }
 
+rocksdb::Status initRocksdbColumnFamilyOptions(const rocksdb::Options& baseOpts,
+                                               const std::string& name,
+                                               rocksdb::ColumnFamilyOptions& cfOpts) {
+  const std::string* gflags = nullptr;
+  if (name == kVertexColumnFamily) {
+    gflags = &FLAGS_rocksdb_vertex_column_family_options;
+  } else if (name == kEdgeColumnFamily) {
+    gflags = &FLAGS_rocksdb_edge_column_family_options;
+  } else if (name == kIndexColumnFamily) {
+    gflags = &FLAGS_rocksdb_index_column_family_options;
+  } else {
+    cfOpts = rocksdb::ColumnFamilyOptions(baseOpts);
+    return rocksdb::Status::OK();
+  }
+  std::unordered_map<std::string, std::string> cfOptsMap;
+  if (!loadOptionsMap(cfOptsMap, *gflags)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  // The options not in the map, such as the table factory and the prefix extractor, are the same
+  // as the default column family
+  return GetColumnFamilyOptionsFromMap(
+      rocksdb::ColumnFamilyOptions(baseOpts), cfOptsMap, &cfOpts, true);
+}
+
+std::string coldDataPath(const std::string& dataPath) {
+  std::unordered_map<std::string, std::string> map;
+  if (!loadOptionsMap(map, FLAGS_rocksdb_cold_data_paths)) {
+    LOG(FATAL) << "Bad rocksdb_cold_data_paths: " << FLAGS_rocksdb_cold_data_paths;
+  }
+  auto iter = map.find(dataPath);
+  return iter == map.end() ? "" : iter->second;
+}
+
+void initRocksdbTieredPaths(rocksdb::Options& baseOpts,
+                            const std::string& hotPath,
+                            const std::string& coldPath) {
+  // The same estimate of the sizes of the levels as rocksdb, which regards L0 as large as L1
+  uint64_t levelSize = baseOpts.max_bytes_for_level_base;
+  uint64_t hotSize = 0;
+  for (int32_t level = 0; level < FLAGS_rocksdb_hot_levels; level++) {
+    hotSize += levelSize;
+    if (level > 0) {
+      levelSize = static_cast<uint64_t>(levelSize * baseOpts.max_bytes_for_level_multiplier);
+    }
+  }
+  // The levels beyond the target size of the hot path fall back to the cold one
+  baseOpts.db_paths.clear();
+  baseOpts.db_paths.emplace_back(hotPath, hotSize);
+  baseOpts.db_paths.emplace_back(coldPath, std::numeric_limits<uint64_t>::max());
+  LOG(INFO) << "The levels after L" << FLAGS_rocksdb_hot_levels - 1 << " of " << hotPath
+            << " are placed in " << coldPath << ", the hot size is " << hotSize;
+}
+
+void updateSpaceCaches() {
+  auto resize = [](const std::string& gflags, size_t unit, SpaceCaches::Caches& caches) {
+    std::unordered_map<GraphSpaceID, int64_t> quotas;
+    auto s = loadSpaceQuotas(gflags, quotas);
+    if (!s.ok()) {
+      LOG(ERROR) << s.ToString();
+      return;
+    }
+    for (auto& [spaceId, cache] : caches) {
+      auto quota = quotas.find(spaceId);
+      if (quota == quotas.end()) {
+        // The engines keep the cache until they're reopened
+        LOG(WARNING) << "The quota of space " << spaceId << " is removed, keep its cache";
+        continue;
+      }
+      cache->SetCapacity(quota->second * unit);
+      LOG(INFO) << "Resize the cache of space " << spaceId << " to " << quota->second * unit;
+    }
+  };
+  auto& caches = spaceCaches();
+  std::lock_guard<std::mutex> guard(caches.lock);
+  resize(FLAGS_rocksdb_space_block_cache, 1024 * 1024, caches.blockCaches);
+  resize(FLAGS_rocksdb_space_row_cache_num, 1, caches.rowCaches);
+}
+
 bool loadOptionsMap(std::unordered_map<std::string, std::string>& map, const std::string& gflags) {
   conf::Configuration conf;
   auto status = conf.parseFromString(gflags);
@@ -16,12 +16,20 @@ DECLARE_string(rocksdb_options_version);
 
 // [DBOptions]
 DECLARE_string(rocksdb_db_options);
+DECLARE_bool(rocksdb_enable_pipelined_write);
 
 // [CFOptions "default"]
 DECLARE_string(rocksdb_column_family_options);
 
+// [CFOptions "vertex"], [CFOptions "edge"] and [CFOptions "index"]
+DECLARE_bool(rocksdb_separate_column_families);
+DECLARE_string(rocksdb_vertex_column_family_options);
+DECLARE_string(rocksdb_edge_column_family_options);
+DECLARE_string(rocksdb_index_column_family_options);
+
 //  [TableOptions/BlockBasedTable "default"]
 DECLARE_string(rocksdb_block_based_table_options);
+DECLARE_int32(rocksdb_index_block_restart_interval);
 
 // memtable_factory
 DECLARE_string(memtable_factory);
@@ -38,6 +46,10 @@ DECLARE_int32(rocksdb_batch_size);
 
 DECLARE_int32(rocksdb_row_cache_num);
 
+DECLARE_string(rocksdb_space_block_cache);
+DECLARE_string(rocksdb_space_row_cache_num);
+DECLARE_bool(rocksdb_scan_fill_cache);
+
 DECLARE_int32(cache_bucket_exp);
 
 // rocksdb table format
@@ -51,8 +63,13 @@ DECLARE_string(rocksdb_bottommost_compression);
 
 DECLARE_bool(enable_rocksdb_statistics);
 DECLARE_string(rocksdb_stats_level);
+DECLARE_double(rocksdb_perf_context_sample_ratio);
 
 DECLARE_bool(enable_rocksdb_prefix_filtering);
+DECLARE_string(rocksdb_edge_type_prefix_filter_spaces);
+DECLARE_uint64(rocksdb_range_readahead_size);
+DECLARE_uint64(rocksdb_scan_readahead_size);
+DECLARE_bool(rocksdb_enable_async_io);
 DECLARE_bool(enable_rocksdb_whole_key_filtering);
 
 // rocksdb compact RangeOptions
@@ -60,6 +77,8 @@ DECLARE_bool(rocksdb_compact_change_level);
 DECLARE_int32(rocksdb_compact_target_level);
 
 DECLARE_string(rocksdb_wal_dir);
+DECLARE_string(rocksdb_cold_data_paths);
+DECLARE_int32(rocksdb_hot_levels);
 DECLARE_string(rocksdb_backup_dir);
 DECLARE_int32(rocksdb_backup_interval_secs);
 
@@ -70,6 +89,11 @@ DECLARE_uint64(rocksdb_kv_separation_threshold);
 namespace nebula {
 namespace kvstore {
 
+// Column families of the vertices, edges and indexes if rocksdb_separate_column_families
+static constexpr char kVertexColumnFamily[] = "vertex";
+static constexpr char kEdgeColumnFamily[] = "edge";
+static constexpr char kIndexColumnFamily[] = "index";
+
 /**
  * @brief Build rocksdb options form gflags
  *
@@ -82,6 +106,49 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options &baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen = 8);
 
+/**
+ * @brief Build the options of a column family, the options of the vertex, edge and index column
+ * families are overridden by their gflags, the others are the same as the default column family
+ *
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param name Name of the column family
+ * @param cfOpts Options of the column family
+ * @return rocksdb::Status
+ */
+rocksdb::Status initRocksdbColumnFamilyOptions(const rocksdb::Options &baseOpts,
+                                               const std::string &name,
+                                               rocksdb::ColumnFamilyOptions &cfOpts);
+
+/**
+ * @brief The cold data path of the data path in rocksdb_cold_data_paths, empty if none
+ */
+std::string coldDataPath(const std::string &dataPath);
+
+/**
+ * @brief Keep the first rocksdb_hot_levels levels of the sst files in hotPath, and place the
+ * others in coldPath
+ *
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param hotPath The data directory of the engine in the data path
+ * @param coldPath The data directory of the engine in the cold data path
+ */
+void initRocksdbTieredPaths(rocksdb::Options &baseOpts,
+                            const std::string &hotPath,
+                            const std::string &coldPath);
+
+/**
+ * @brief Whether the prefixes of the edge keys of the space cover the edge types, see
+ * rocksdb_edge_type_prefix_filter_spaces
+ */
+bool useEdgeTypePrefix(GraphSpaceID spaceId);
+
+/**
+ * @brief Resize the caches of the spaces after rocksdb_space_block_cache or
+ * rocksdb_space_row_cache_num is modified. A space which has no cache of its own yet gets it when
+ * its engines are opened.
+ */
+void updateSpaceCaches();
+
 /**
  * @brief Load a gflag into map
  *
@@ -0,0 +1,144 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_ROCKSPERFCONTEXT_H_
+#define KVSTORE_ROCKSPERFCONTEXT_H_
+
+#include <rocksdb/iostats_context.h>
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief The RocksDB perf context counters of the reads of a request, summed over the threads
+ * which serve its parts.
+ */
+class RocksPerfStats final {
+ public:
+  enum Metric : size_t {
+    kBlockReads = 0,
+    kBlockReadBytes,
+    kBlockCacheHits,
+    kSeeks,
+    kNexts,
+    kSkippedKeys,
+    // The sst files and memtables skipped by the bloom filters
+    kBloomUseful,
+    kBytesRead,
+    kNumMetrics,
+  };
+
+  static const char* nameOf(Metric metric) {
+    static const char* names[] = {"BlockReads",
+                                  "BlockReadBytes",
+                                  "BlockCacheHits",
+                                  "Seeks",
+                                  "Nexts",
+                                  "SkippedKeys",
+                                  "BloomUseful",
+                                  "BytesRead"};
+    static_assert(sizeof(names) / sizeof(names[0]) == kNumMetrics);
+    return names[metric];
+  }
+
+  // The name of the counter of the metric in the stats of storaged
+  static const char* counterNameOf(Metric metric) {
+    static const char* names[] = {"rocksdb_perf_block_reads",
+                                  "rocksdb_perf_block_read_bytes",
+                                  "rocksdb_perf_block_cache_hits",
+                                  "rocksdb_perf_seeks",
+                                  "rocksdb_perf_nexts",
+                                  "rocksdb_perf_skipped_keys",
+                                  "rocksdb_perf_bloom_useful",
+                                  "rocksdb_perf_bytes_read"};
+    static_assert(sizeof(names) / sizeof(names[0]) == kNumMetrics);
+    return names[metric];
+  }
+
+  void add(Metric metric, uint64_t value) {
+    values_[metric].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t get(Metric metric) const {
+    return values_[metric].load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumMetrics> values_{};
+};
+
+/**
+ * @brief Count the RocksDB perf context of the current thread in the scope into the stats, nothing
+ * is done if the stats is nullptr.
+ *
+ * The perf context is thread local and not reset, the difference between the begin and the end of
+ * the scope is added, so the scopes could be nested, e.g. a part of a request run in the thread of
+ * the request. Nothing is added if the scope ends in another thread, whose perf context is not
+ * comparable.
+ */
+class RocksPerfScope final {
+ public:
+  explicit RocksPerfScope(RocksPerfStats* stats) : stats_(stats) {
+    if (stats_ == nullptr) {
+      return;
+    }
+    thread_ = std::this_thread::get_id();
+    level_ = rocksdb::GetPerfLevel();
+    if (level_ < rocksdb::PerfLevel::kEnableCount) {
+      rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+    }
+    begin_ = current();
+  }
+
+  RocksPerfScope(const RocksPerfScope&) = delete;
+  RocksPerfScope& operator=(const RocksPerfScope&) = delete;
+
+  ~RocksPerfScope() {
+    if (stats_ == nullptr || thread_ != std::this_thread::get_id()) {
+      return;
+    }
+    auto end = current();
+    for (size_t i = 0; i < RocksPerfStats::kNumMetrics; i++) {
+      stats_->add(static_cast<RocksPerfStats::Metric>(i), end[i] - begin_[i]);
+    }
+    rocksdb::SetPerfLevel(level_);
+  }
+
+ private:
+  using Values = std::array<uint64_t, RocksPerfStats::kNumMetrics>;
+
+  static Values current() {
+    const auto* perf = rocksdb::get_perf_context();
+    Values values;
+    values[RocksPerfStats::kBlockReads] = perf->block_read_count;
+    values[RocksPerfStats::kBlockReadBytes] = perf->block_read_byte;
+    values[RocksPerfStats::kBlockCacheHits] = perf->block_cache_hit_count;
+    values[RocksPerfStats::kSeeks] = perf->iter_seek_count;
+    values[RocksPerfStats::kNexts] = perf->iter_next_count;
+    values[RocksPerfStats::kSkippedKeys] = perf->internal_key_skipped_count;
+    values[RocksPerfStats::kBloomUseful] =
+        perf->bloom_sst_miss_count + perf->bloom_memtable_miss_count;
+    values[RocksPerfStats::kBytesRead] = rocksdb::get_iostats_context()->bytes_read;
+    return values;
+  }
+
+  RocksPerfStats* stats_{nullptr};
+  std::thread::id thread_;
+  rocksdb::PerfLevel level_{rocksdb::PerfLevel::kDisable};
+  Values begin_{};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_ROCKSPERFCONTEXT_H_
@@ -0,0 +1,38 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_SCANCACHEGUARD_H_
+#define KVSTORE_SCANCACHEGUARD_H_
+
+namespace nebula {
+namespace kvstore {
+
+// The iterators created in its scope in the current thread don't fill the block cache unless
+// rocksdb_scan_fill_cache, so a scan over a whole part, e.g. ScanVertex or rebuilding an index,
+// reads its blocks once without evicting the hot blocks of the point lookups. They read ahead by
+// rocksdb_scan_readahead_size as well.
+struct ScanCacheGuard {
+  bool previous;
+  ScanCacheGuard() {
+    previous = active_;
+    active_ = true;
+  }
+
+  ~ScanCacheGuard() {
+    active_ = previous;
+  }
+
+  static bool active() {
+    return active_;
+  }
+
+ private:
+  static inline thread_local bool active_{false};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_SCANCACHEGUARD_H_
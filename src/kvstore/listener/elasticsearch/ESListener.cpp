@@ -5,12 +5,28 @@
 
 #include "kvstore/listener/elasticsearch/ESListener.h"
 
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/hash/Hash.h>
+
 #include "common/plugin/fulltext/elasticsearch/ESAdapter.h"
+#include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
 #include "common/utils/NebulaKeyUtils.h"
 
 DECLARE_uint32(ft_request_retry_times);
 DECLARE_int32(ft_bulk_batch_size);
 DEFINE_int32(listener_commit_batch_size, 1000, "Max batch size when listener commit");
+DEFINE_int64(listener_commit_batch_bytes,
+             32 * 1024 * 1024,
+             "Max bytes of the keys and the values of a batch when listener commit");
+DEFINE_int32(ft_bulk_concurrency,
+             4,
+             "The number of the bulk requests of a listener part sent concurrently, the "
+             "operations of a document are always in the same request stream");
+DEFINE_int32(ft_bulk_retry_backoff_ms,
+             100,
+             "The backoff before retrying a failed bulk request, doubled on each retry");
 
 namespace nebula {
 namespace kvstore {
@@ -31,39 +47,110 @@ void ESListener::init() {
     LOG(FATAL) << "space name error";
   }
   spaceName_ = std::make_unique<std::string>(sRet.value());
+
+  // The logs committed by the leader but not applied to elasticsearch yet
+  std::weak_ptr<raftex::RaftPart> weak = shared_from_this();
+  stats::StatsManager::registerGauge(
+      "fulltext_listener_lag_logs",
+      {{"space", *spaceName_}, {"part", folly::to<std::string>(partId_)}},
+      [weak]() -> int64_t {
+        auto locked = weak.lock();
+        if (locked == nullptr) {
+          return 0;
+        }
+        auto* listener = static_cast<ESListener*>(locked.get());
+        std::lock_guard<std::mutex> guard(listener->raftLock_);
+        return std::max<int64_t>(listener->leaderCommitId_ - listener->lastApplyLogId_, 0);
+      });
+}
+
+ESListener::~ESListener() {
+  if (spaceName_ != nullptr) {
+    stats::StatsManager::removeGauge(
+        "fulltext_listener_lag_logs",
+        {{"space", *spaceName_}, {"part", folly::to<std::string>(partId_)}});
+  }
 }
 
 bool ESListener::apply(const BatchHolder& batch) {
-  nebula::plugin::ESBulk bulk;
-  auto callback = [&bulk](BatchLogType type,
-                          const std::string& index,
-                          const std::string& vid,
-                          const std::string& src,
-                          const std::string& dst,
-                          int64_t rank,
-                          std::map<std::string, std::string> data) {
+  size_t shardNum = std::max(FLAGS_ft_bulk_concurrency, 1);
+  size_t bulkSize = std::max(FLAGS_ft_bulk_batch_size, 1);
+  std::vector<std::vector<nebula::plugin::ESBulk>> shards(shardNum);
+  std::vector<size_t> lastBulkSizes(shardNum, 0);
+  bool empty = true;
+  auto callback = [&](BatchLogType type,
+                      const std::string& index,
+                      const std::string& vid,
+                      const std::string& src,
+                      const std::string& dst,
+                      int64_t rank,
+                      std::map<std::string, std::string> data) {
+    auto shard = folly::hash::hash_combine(index, vid, src, dst, rank) % shardNum;
+    auto& bulks = shards[shard];
+    if (bulks.empty() || lastBulkSizes[shard] >= bulkSize) {
+      bulks.emplace_back();
+      lastBulkSizes[shard] = 0;
+    }
     if (type == BatchLogType::OP_BATCH_PUT) {
-      bulk.put(index, vid, src, dst, rank, std::move(data));
+      bulks.back().put(index, vid, src, dst, rank, std::move(data));
     } else if (type == BatchLogType::OP_BATCH_REMOVE) {
-      bulk.delete_(index, vid, src, dst, rank);
+      bulks.back().delete_(index, vid, src, dst, rank);
     } else {
       LOG(FATAL) << "Unexpect";
     }
+    lastBulkSizes[shard]++;
+    empty = false;
   };
   for (const auto& log : batch.getBatch()) {
     pickTagAndEdgeData(std::get<0>(log), std::get<1>(log), std::get<2>(log), callback);
   }
-  if (!bulk.empty()) {
-    auto esAdapterRes = getESAdapter();
-    if (!esAdapterRes.ok()) {
-      LOG(ERROR) << esAdapterRes.status();
-      return false;
+  if (empty) {
+    return true;
+  }
+  auto esAdapterRes = getESAdapter();
+  if (!esAdapterRes.ok()) {
+    LOG(ERROR) << esAdapterRes.status();
+    return false;
+  }
+  auto esAdapter = std::move(esAdapterRes).value();
+  // The first shard is sent by the current thread. If any shard fails, the whole batch is applied
+  // again, which is idempotent since the operations of a document are sent in order.
+  std::vector<folly::Future<bool>> futures;
+  for (size_t i = 1; i < shardNum; i++) {
+    if (shards[i].empty()) {
+      continue;
     }
-    auto esAdapter = std::move(esAdapterRes).value();
-    auto status = esAdapter.bulk(bulk);
-    if (!status.ok()) {
-      LOG(ERROR) << status;
-      return false;
+    futures.emplace_back(folly::via(folly::getGlobalIOExecutor().get(),
+                                    [this, &esAdapter, &bulks = shards[i]]() {
+                                      return sendBulks(esAdapter, bulks);
+                                    }));
+  }
+  bool succeeded = sendBulks(esAdapter, shards[0]);
+  for (auto& result : folly::collectAll(futures).get()) {
+    succeeded = succeeded && result.hasValue() && result.value();
+  }
+  return succeeded;
+}
+
+bool ESListener::sendBulks(::nebula::plugin::ESAdapter adapter,
+                           std::vector<::nebula::plugin::ESBulk>& bulks) {
+  for (auto& bulk : bulks) {
+    auto backoffMs = FLAGS_ft_bulk_retry_backoff_ms;
+    for (uint32_t retry = 0;; retry++) {
+      auto start = time::WallClock::fastNowInMicroSec();
+      auto status = adapter.bulk(bulk);
+      stats::StatsManager::latencyHisto("fulltext_bulk_latency_us")
+          ->add(time::WallClock::fastNowInMicroSec() - start);
+      if (status.ok()) {
+        break;
+      }
+      if (retry >= FLAGS_ft_request_retry_times || isStopped()) {
+        LOG(ERROR) << idStr_ << "Bulk failed after " << retry << " retries: " << status;
+        return false;
+      }
+      LOG(WARNING) << idStr_ << "Bulk failed, retry in " << backoffMs << "ms: " << status;
+      std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+      backoffMs *= 2;
     }
   }
   return true;
@@ -230,11 +317,17 @@ std::string ESListener::encodeAppliedId(LogID lastId, TermID lastTerm, LogID las
 }
 
 void ESListener::processLogs() {
+  // Keep applying the batches until caught up, rather than one batch per commit interval
+  while (!isStopped() && processLogBatch()) {
+  }
+}
+
+bool ESListener::processLogBatch() {
   std::unique_ptr<LogIterator> iter;
   {
     std::lock_guard<std::mutex> guard(raftLock_);
     if (lastApplyLogId_ >= committedLogId_) {
-      return;
+      return false;
     }
     iter = wal_->iterator(lastApplyLogId_ + 1, committedLogId_);
   }
@@ -299,6 +392,10 @@ void ESListener::processLogs() {
               batch.rangeRemove(op.second.first.toString(), op.second.second.toString());
               break;
             }
+            case BatchLogType::OP_BATCH_MERGE: {
+              // The aggregates materialized are not of the full text indexes
+              break;
+            }
           }
         }
         break;
@@ -314,7 +411,9 @@ void ESListener::processLogs() {
       }
     }
 
-    if (static_cast<int32_t>(batch.size()) > FLAGS_listener_commit_batch_size) {
+    // The batch is bounded by both the number of the operations and their bytes
+    if (static_cast<int32_t>(batch.getBatch().size()) > FLAGS_listener_commit_batch_size ||
+        static_cast<int64_t>(batch.size()) > FLAGS_listener_commit_batch_bytes) {
       break;
     }
     ++(*iter);
@@ -326,7 +425,9 @@ void ESListener::processLogs() {
     lastApplyLogId_ = lastApplyId;
     persist(committedLogId_, term_, lastApplyLogId_);
     VLOG(2) << idStr_ << "Listener succeeded apply log to " << lastApplyLogId_;
+    return lastApplyLogId_ < committedLogId_;
   }
+  return false;
 }
 
 std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> ESListener::commitSnapshot(
@@ -42,6 +42,8 @@ class ESListener : public Listener {
         folly::stringPrintf("%s/last_apply_log_%d", walPath.c_str(), partId));
   }
 
+  ~ESListener() override;
+
  protected:
   /**
    * @brief Init work: get vid length, get es client
@@ -49,7 +51,9 @@ class ESListener : public Listener {
   void init() override;
 
   /**
-   * @brief Send data by es client
+   * @brief Send data by es client. The documents are sharded by their ids, and the shards are sent
+   * concurrently by the bulks of at most ft_bulk_batch_size operations, so the operations of a
+   * document are sent in their order.
    *
    * @param data Key/value to apply
    * @return True if succeed. False if failed.
@@ -120,6 +124,19 @@ class ESListener : public Listener {
 
   std::string normalizeVid(const std::string& vid);
 
+  /**
+   * @brief Send the bulks in order, a failed bulk is retried with exponential backoff
+   */
+  bool sendBulks(::nebula::plugin::ESAdapter adapter,
+                 std::vector<::nebula::plugin::ESBulk>& bulks);
+
+  /**
+   * @brief Apply a batch of the logs committed
+   *
+   * @return Whether there are more logs to apply
+   */
+  bool processLogBatch();
+
   StatusOr<::nebula::plugin::ESAdapter> getESAdapter();
 
   std::unique_ptr<std::string> lastApplyLogFile_{nullptr};
@@ -185,6 +185,9 @@ class DummyListener : public Listener {
                 batch.rangeRemove(op.second.first.toString(), op.second.second.toString());
                 break;
               }
+              case BatchLogType::OP_BATCH_MERGE: {
+                break;
+              }
             }
           }
           break;
@@ -233,6 +236,10 @@ class DummyListener : public Listener {
               break;
             }
           }
+          break;
+        }
+        case BatchLogType::OP_BATCH_MERGE: {
+          break;
         }
       }
     }
@@ -0,0 +1,134 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/raftex/AppendLogBatcher.h"
+
+#include <folly/io/async/EventBase.h>
+
+DEFINE_uint32(raft_group_commit_max_parts,
+              64,
+              "The max number of partitions whose append log requests are sent in one rpc");
+DEFINE_uint32(raft_group_commit_max_inflight,
+              2,
+              "The max number of append log rpcs in flight to each peer");
+
+DECLARE_int32(raft_rpc_timeout_ms);
+
+namespace nebula {
+namespace raftex {
+
+AppendLogBatcher& AppendLogBatcher::instance() {
+  static AppendLogBatcher batcher;
+  return batcher;
+}
+
+std::shared_ptr<AppendLogBatcher::Peer> AppendLogBatcher::peer(const HostAddr& addr) {
+  std::lock_guard<std::mutex> g(lock_);
+  auto& peer = peers_[addr];
+  if (peer == nullptr) {
+    peer = std::make_shared<Peer>();
+  }
+  return peer;
+}
+
+folly::Future<cpp2::AppendLogResponse> AppendLogBatcher::appendLog(
+    std::shared_ptr<ClientManager> clientMan,
+    const HostAddr& addr,
+    folly::EventBase* eb,
+    std::shared_ptr<cpp2::AppendLogRequest> req) {
+  auto p = peer(addr);
+  folly::Promise<cpp2::AppendLogResponse> promise;
+  auto future = promise.getFuture();
+  std::vector<PendingRequest> batch;
+  {
+    std::lock_guard<std::mutex> g(p->lock);
+    p->pending.emplace_back(PendingRequest{std::move(req), std::move(promise)});
+    if (p->inflight < std::max(FLAGS_raft_group_commit_max_inflight, 1U)) {
+      p->inflight++;
+      batch = takeBatch(*p);
+    }
+  }
+  if (!batch.empty()) {
+    send(std::move(clientMan), addr, eb, std::move(p), std::move(batch));
+  }
+  return future;
+}
+
+std::vector<AppendLogBatcher::PendingRequest> AppendLogBatcher::takeBatch(Peer& peer) {
+  std::vector<PendingRequest> batch;
+  auto maxParts = std::max(FLAGS_raft_group_commit_max_parts, 1U);
+  std::unordered_set<std::pair<GraphSpaceID, PartitionID>> parts;
+  while (!peer.pending.empty() && batch.size() < maxParts) {
+    const auto& req = *peer.pending.front().req;
+    // The next request of the same part waits for the next batch to keep the order
+    if (!parts.emplace(req.get_space(), req.get_part()).second) {
+      break;
+    }
+    batch.emplace_back(std::move(peer.pending.front()));
+    peer.pending.pop_front();
+  }
+  return batch;
+}
+
+void AppendLogBatcher::send(std::shared_ptr<ClientManager> clientMan,
+                            const HostAddr& addr,
+                            folly::EventBase* eb,
+                            std::shared_ptr<Peer> peer,
+                            std::vector<PendingRequest> batch) {
+  auto onSent = [this, clientMan, addr, eb, peer]() {
+    std::vector<PendingRequest> next;
+    {
+      std::lock_guard<std::mutex> g(peer->lock);
+      next = takeBatch(*peer);
+      if (next.empty()) {
+        peer->inflight--;
+      }
+    }
+    if (!next.empty()) {
+      send(clientMan, addr, eb, peer, std::move(next));
+    }
+  };
+
+  auto client = clientMan->client(addr, eb, false, FLAGS_raft_rpc_timeout_ms);
+  if (batch.size() == 1) {
+    // A single request is sent as it is
+    auto req = batch.front().req;
+    client->future_appendLog(*req).via(eb).thenTry(
+        [batch = std::move(batch), onSent](folly::Try<cpp2::AppendLogResponse>&& t) mutable {
+          batch.front().promise.setTry(std::move(t));
+          onSent();
+        });
+    return;
+  }
+
+  cpp2::BatchAppendLogRequest batchReq;
+  batchReq.requests_ref()->reserve(batch.size());
+  for (const auto& pending : batch) {
+    batchReq.requests_ref()->emplace_back(*pending.req);
+  }
+  VLOG(3) << "Send the append log requests of " << batch.size() << " parts to " << addr;
+  client->future_batchAppendLog(batchReq).via(eb).thenTry(
+      [batch = std::move(batch), onSent](folly::Try<cpp2::BatchAppendLogResponse>&& t) mutable {
+        if (t.hasException()) {
+          for (auto& pending : batch) {
+            pending.promise.setException(t.exception());
+          }
+        } else if (t.value().get_responses().size() != batch.size()) {
+          for (auto& pending : batch) {
+            pending.promise.setException(
+                std::runtime_error("Mismatched responses of batch append log"));
+          }
+        } else {
+          auto& responses = *t.value().responses_ref();
+          for (size_t i = 0; i < batch.size(); i++) {
+            batch[i].promise.setValue(std::move(responses[i]));
+          }
+        }
+        onSent();
+      });
+}
+
+}  // namespace raftex
+}  // namespace nebula
@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef RAFTEX_APPENDLOGBATCHER_H_
+#define RAFTEX_APPENDLOGBATCHER_H_
+
+#include <folly/futures/Future.h>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftClientManager.h"
+#include "interface/gen-cpp2/RaftexServiceAsyncClient.h"
+#include "interface/gen-cpp2/raftex_types.h"
+
+namespace folly {
+class EventBase;
+}  // namespace folly
+
+namespace nebula {
+namespace raftex {
+
+/**
+ * @brief Group commit of the append log requests of all partitions to the same peer. The first
+ * request to a peer is sent at once, and the requests of other partitions arriving while the rpc
+ * is in flight are sent together in one batchAppendLog rpc when it finishes. A batch holds at most
+ * one request of each partition, since the peer processes the requests of a batch concurrently.
+ */
+class AppendLogBatcher final {
+ public:
+  using ClientManager = thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient>;
+
+  static AppendLogBatcher& instance();
+
+  /**
+   * @brief Send the append log request to the peer with the requests of other partitions
+   *
+   * @param clientMan Client manager of the RaftPart
+   * @param addr Peer address
+   * @param eb The eventbase to send rpc
+   * @param req The rpc request
+   * @return folly::Future<cpp2::AppendLogResponse>
+   */
+  folly::Future<cpp2::AppendLogResponse> appendLog(std::shared_ptr<ClientManager> clientMan,
+                                                   const HostAddr& addr,
+                                                   folly::EventBase* eb,
+                                                   std::shared_ptr<cpp2::AppendLogRequest> req);
+
+ private:
+  struct PendingRequest {
+    std::shared_ptr<cpp2::AppendLogRequest> req;
+    folly::Promise<cpp2::AppendLogResponse> promise;
+  };
+
+  struct Peer {
+    std::mutex lock;
+    std::deque<PendingRequest> pending;
+    uint32_t inflight{0};
+  };
+
+  AppendLogBatcher() = default;
+
+  std::shared_ptr<Peer> peer(const HostAddr& addr);
+
+  /**
+   * @brief Take the requests of the next batch until a partition repeats, the peer lock must be
+   * held
+   */
+  static std::vector<PendingRequest> takeBatch(Peer& peer);
+
+  /**
+   * @brief Send a batch, and send the next one if any requests are pending when it finishes
+   */
+  void send(std::shared_ptr<ClientManager> clientMan,
+            const HostAddr& addr,
+            folly::EventBase* eb,
+            std::shared_ptr<Peer> peer,
+            std::vector<PendingRequest> batch);
+
+  std::mutex lock_;
+  std::unordered_map<HostAddr, std::shared_ptr<Peer>> peers_;
+};
+
+}  // namespace raftex
+}  // namespace nebula
+
+#endif  // RAFTEX_APPENDLOGBATCHER_H_
@@ -12,15 +12,29 @@
 #include "common/network/NetworkUtils.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/WallClock.h"
+#include "kvstore/raftex/AppendLogBatcher.h"
 #include "kvstore/raftex/RaftPart.h"
 #include "kvstore/stats/KVStats.h"
 #include "kvstore/wal/FileBasedWal.h"
+#include "kvstore/wal/LogCompression.h"
 
 DEFINE_uint32(max_appendlog_batch_size,
               128,
               "The max number of logs in each appendLog request batch");
 DEFINE_uint32(max_outstanding_requests, 1024, "The max number of outstanding appendLog requests");
 DEFINE_int32(raft_rpc_timeout_ms, 1000, "rpc timeout for raft client");
+DEFINE_uint32(raft_max_inflight_appendlog_batches,
+              1,
+              "The max number of appendLog request batches in flight to each peer, the next batch "
+              "is sent before the response of the previous one if it is larger than 1");
+DEFINE_bool(raft_group_commit,
+            false,
+            "Whether to send the append log requests of all partitions to the same peer together, "
+            "all peers need to support the batchAppendLog rpc");
+DEFINE_string(raft_log_compression,
+              "none",
+              "Codec to compress the logs and snapshot rows sent to the peers supporting it: none, "
+              "lz4 or zstd");
 DEFINE_int32(pause_host_time_factor,
              4,
              "The factor of pause host time based on raft heartbeat interval");
@@ -98,7 +112,7 @@ folly::Future<cpp2::AppendLogResponse> Host::appendLogs(folly::EventBase* eb,
   VLOG(4) << idStr_ << "Entering Host::appendLogs()";
 
   auto ret = folly::Future<cpp2::AppendLogResponse>::makeEmpty();
-  std::shared_ptr<cpp2::AppendLogRequest> req;
+  std::vector<std::shared_ptr<cpp2::AppendLogRequest>> reqs;
   {
     std::lock_guard<std::mutex> g(lock_);
 
@@ -107,15 +121,9 @@ folly::Future<cpp2::AppendLogResponse> Host::appendLogs(folly::EventBase* eb,
     if (UNLIKELY(sendingSnapshot_)) {
       VLOG_EVERY_N(2, 1000) << idStr_ << "The target host is waiting for a snapshot";
       res = nebula::cpp2::ErrorCode::E_RAFT_WAITING_SNAPSHOT;
-    } else if (requestOnGoing_) {
-      // buffer incoming request to pendingReq_
-      if (cachingPromise_.size() <= FLAGS_max_outstanding_requests) {
-        pendingReq_ = std::make_tuple(term, logId, committedLogId);
-        return cachingPromise_.getFuture();
-      } else {
-        VLOG_EVERY_N(2, 1000) << idStr_ << "Too many requests are waiting, return error";
-        res = nebula::cpp2::ErrorCode::E_RAFT_TOO_MANY_REQUESTS;
-      }
+    } else if (requestOnGoing_ && cachingPromise_.size() > FLAGS_max_outstanding_requests) {
+      VLOG_EVERY_N(2, 1000) << idStr_ << "Too many requests are waiting, return error";
+      res = nebula::cpp2::ErrorCode::E_RAFT_TOO_MANY_REQUESTS;
     }
 
     if (res != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -125,52 +133,165 @@ folly::Future<cpp2::AppendLogResponse> Host::appendLogs(folly::EventBase* eb,
       return r;
     }
 
-    VLOG(4) << idStr_ << "About to send the AppendLog request";
-
-    // No request is ongoing, let's send a new request
-    if (UNLIKELY(lastLogIdSent_ == 0 && lastLogTermSent_ == 0)) {
-      lastLogIdSent_ = prevLogId;
-      lastLogTermSent_ = prevLogTerm;
-      VLOG(2) << idStr_ << "This is the first time to send the logs to this host"
-              << ", lastLogIdSent = " << lastLogIdSent_
-              << ", lastLogTermSent = " << lastLogTermSent_;
+    if (!requestOnGoing_) {
+      VLOG(4) << idStr_ << "About to send the AppendLog request";
+      // No request is ongoing, let's send a new request
+      if (UNLIKELY(lastLogIdSent_ == 0 && lastLogTermSent_ == 0)) {
+        lastLogIdSent_ = prevLogId;
+        lastLogTermSent_ = prevLogTerm;
+        VLOG(2) << idStr_ << "This is the first time to send the logs to this host"
+                << ", lastLogIdSent = " << lastLogIdSent_
+                << ", lastLogTermSent = " << lastLogTermSent_;
+      }
+      lastLogIdInFlight_ = lastLogIdSent_;
+      lastLogTermInFlight_ = lastLogTermSent_;
     }
-    logTermToSend_ = term;
-    logIdToSend_ = logId;
-    committedLogId_ = committedLogId;
 
-    auto result = prepareAppendLogRequest();
-    if (ok(result)) {
+    // buffer incoming request to pendingReq_, it is sent at once if the window is not full
+    pendingReq_ = std::make_tuple(term, logId, committedLogId);
+    ret = cachingPromise_.getFuture();
+    reqs = prepareInFlightRequests();
+  }
+
+  for (auto& req : reqs) {
+    appendLogsInternal(eb, std::move(req));
+  }
+  return ret;
+}
+
+void Host::setResponse(const cpp2::AppendLogResponse& r) {
+  CHECK(!lock_.try_lock());
+  for (auto& promise : promises_) {
+    promise.second.setValue(r);
+  }
+  promises_.clear();
+  cachingPromise_.setValue(r);
+  cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
+  pendingReq_ = std::make_tuple(0, 0, 0);
+  // The batches still in flight are waited before the host is vacant
+  requestOnGoing_ = inFlight_ > 0;
+  if (!requestOnGoing_) {
+    noMoreRequestCV_.notify_all();
+  }
+}
+
+void Host::setMatchedResponse(const cpp2::AppendLogResponse& resp) {
+  CHECK(!lock_.try_lock());
+  while (!promises_.empty() && promises_.front().first <= lastLogIdSent_) {
+    promises_.front().second.setValue(resp);
+    promises_.pop_front();
+  }
+}
+
+std::vector<std::shared_ptr<cpp2::AppendLogRequest>> Host::prepareInFlightRequests() {
+  CHECK(!lock_.try_lock());
+  std::vector<std::shared_ptr<cpp2::AppendLogRequest>> reqs;
+  auto window = std::max(FLAGS_raft_max_inflight_appendlog_batches, 1U);
+  while (!resync_ && inFlight_ < window) {
+    if (promises_.empty() || lastLogIdInFlight_ >= logIdToSend_) {
+      // All logs of the ongoing requests have been sent, check if there are any pending request
+      if (noRequest()) {
+        break;
+      }
+      auto& tup = pendingReq_;
+      logTermToSend_ = std::get<0>(tup);
+      logIdToSend_ = std::max(std::get<1>(tup), lastLogIdInFlight_);
+      committedLogId_ = std::get<2>(tup);
+
       VLOG_IF(1, FLAGS_trace_raft) << idStr_ << "Sending the pending request in the queue"
-                                   << ", from " << lastLogIdSent_ + 1 << " to " << logIdToSend_;
-      req = std::move(value(result));
+                                   << ", from " << lastLogIdInFlight_ + 1 << " to "
+                                   << logIdToSend_;
       pendingReq_ = std::make_tuple(0, 0, 0);
-      promise_ = std::move(cachingPromise_);
+      promises_.emplace_back(logIdToSend_, std::move(cachingPromise_));
       cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
-      ret = promise_.getFuture();
-      requestOnGoing_ = true;
-    } else {
+    }
+
+    auto result = prepareAppendLogRequest();
+    if (!ok(result)) {
       // target host is waiting for a snapshot or wal not found
       cpp2::AppendLogResponse r;
       r.error_code_ref() = error(result);
-      return r;
+      setResponse(r);
+      break;
+    }
+    auto req = std::move(value(result));
+    const auto& logs = req->get_log_str_list();
+    if (!logs.empty()) {
+      lastLogIdInFlight_ += logs.size();
+      lastLogTermInFlight_ = logs.back().get_log_term();
     }
+    ++inFlight_;
+    reqs.emplace_back(std::move(req));
   }
 
-  // Get a new promise
-  appendLogsInternal(eb, std::move(req));
-
-  return ret;
+  requestOnGoing_ = inFlight_ > 0;
+  if (!requestOnGoing_) {
+    noMoreRequestCV_.notify_all();
+  }
+  return reqs;
 }
 
-void Host::setResponse(const cpp2::AppendLogResponse& r) {
+std::vector<std::shared_ptr<cpp2::AppendLogRequest>> Host::onResponse(
+    const cpp2::AppendLogRequest& req, const cpp2::AppendLogResponse& resp) {
   CHECK(!lock_.try_lock());
-  promise_.setValue(r);
-  cachingPromise_.setValue(r);
-  cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
-  pendingReq_ = std::make_tuple(0, 0, 0);
-  requestOnGoing_ = false;
-  noMoreRequestCV_.notify_all();
+  CHECK_GT(inFlight_, 0) << idStr_;
+  --inFlight_;
+  switch (resp.get_error_code()) {
+    case nebula::cpp2::ErrorCode::SUCCEEDED: {
+      supportCompression_ = resp.get_support_compression();
+      supportSnapshotFiles_ = resp.get_support_snapshot_files();
+      // The responses may come out of order, only move forward
+      if (resp.get_last_matched_log_id() > lastLogIdSent_) {
+        lastLogIdSent_ = resp.get_last_matched_log_id();
+        lastLogTermSent_ = resp.get_last_matched_log_term();
+      }
+      followerCommittedLogId_ = std::max(followerCommittedLogId_, resp.get_committed_log_id());
+      break;
+    }
+    case nebula::cpp2::ErrorCode::E_RAFT_LOG_GAP:
+    case nebula::cpp2::ErrorCode::E_RAFT_LOG_STALE: {
+      supportCompression_ = resp.get_support_compression();
+      supportSnapshotFiles_ = resp.get_support_snapshot_files();
+      // If the logs before this batch have been received, the log of peer doesn't match and we
+      // send the logs it asks for. Otherwise they are still in flight or lost, and the batches are
+      // sent again from the last log received once all in flight are finished.
+      if (req.get_last_log_id_sent() <= lastLogIdSent_) {
+        lastLogIdSent_ = resp.get_last_matched_log_id();
+        lastLogTermSent_ = resp.get_last_matched_log_term();
+      }
+      followerCommittedLogId_ = std::max(followerCommittedLogId_, resp.get_committed_log_id());
+      resync_ = true;
+      break;
+    }
+    // Usually the peer is not in proper state, for example:
+    // E_RAFT_UNKNOWN_PART/E_RAFT_STOPPED/E_RAFT_NOT_READY/E_RAFT_WAITING_SNAPSHOT
+    // In this case, nothing changed, just return the error
+    default: {
+      resync_ = true;
+      setResponse(resp);
+      break;
+    }
+  }
+
+  if (resync_ && inFlight_ == 0) {
+    VLOG_IF(1, FLAGS_trace_raft) << idStr_ << "Send the logs again from " << lastLogIdSent_ + 1;
+    resync_ = false;
+    lastLogIdInFlight_ = lastLogIdSent_;
+    lastLogTermInFlight_ = lastLogTermSent_;
+  }
+
+  auto res = canAppendLog();
+  if (res != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    cpp2::AppendLogResponse r;
+    r.error_code_ref() = res;
+    setResponse(r);
+    return {};
+  }
+  // All logs up to the logId of a request have been received, fulfill its promise
+  setMatchedResponse(resp);
+  // Either send more logs of the ongoing requests or the pending request if any, or set Host to
+  // vacant
+  return prepareInFlightRequests();
 }
 
 void Host::appendLogsInternal(folly::EventBase* eb, std::shared_ptr<cpp2::AppendLogRequest> req) {
@@ -178,7 +299,7 @@ void Host::appendLogsInternal(folly::EventBase* eb, std::shared_ptr<cpp2::Append
   auto beforeRpcUs = time::WallClock::fastNowInMicroSec();
   sendAppendLogRequest(eb, req)
       .via(eb)
-      .thenValue([eb, beforeRpcUs, self = shared_from_this()](cpp2::AppendLogResponse&& resp) {
+      .thenValue([eb, beforeRpcUs, req, self = shared_from_this()](cpp2::AppendLogResponse&& resp) {
         stats::StatsManager::addValue(kAppendLogLatencyUs,
                                       time::WallClock::fastNowInMicroSec() - beforeRpcUs);
         VLOG_IF(1, FLAGS_trace_raft)
@@ -192,67 +313,30 @@ void Host::appendLogsInternal(folly::EventBase* eb, std::shared_ptr<cpp2::Append
           case nebula::cpp2::ErrorCode::E_RAFT_LOG_GAP:
           case nebula::cpp2::ErrorCode::E_RAFT_LOG_STALE: {
             VLOG(3) << self->idStr_ << "AppendLog request sent successfully";
-
-            std::shared_ptr<cpp2::AppendLogRequest> newReq;
-            {
-              std::lock_guard<std::mutex> g(self->lock_);
-              auto res = self->canAppendLog();
-              if (res != nebula::cpp2::ErrorCode::SUCCEEDED) {
-                cpp2::AppendLogResponse r;
-                r.error_code_ref() = res;
-                self->setResponse(r);
-                return;
-              }
-              // Host is working
-              self->lastLogIdSent_ = resp.get_last_matched_log_id();
-              self->lastLogTermSent_ = resp.get_last_matched_log_term();
-              self->followerCommittedLogId_ = resp.get_committed_log_id();
-              if (self->lastLogIdSent_ < self->logIdToSend_) {
-                // More to send
-                VLOG(3) << self->idStr_ << "There are more logs to send";
-                auto result = self->prepareAppendLogRequest();
-                if (ok(result)) {
-                  newReq = std::move(value(result));
-                } else {
-                  cpp2::AppendLogResponse r;
-                  r.error_code_ref() = error(result);
-                  self->setResponse(r);
-                  return;
-                }
-              } else {
-                // resp.get_last_matched_log_id() >= self->logIdToSend_
-                // All logs up to logIdToSend_ has been sent, fulfill the promise
-                self->promise_.setValue(resp);
-                // Check if there are any pending request:
-                // Either send pending request if any, or set Host to vacant
-                newReq = self->getPendingReqIfAny(self);
-              }
-            }
-            if (newReq) {
-              self->appendLogsInternal(eb, newReq);
-            }
-            return;
+            break;
           }
-          // Usually the peer is not in proper state, for example:
-          // E_RAFT_UNKNOWN_PART/E_RAFT_STOPPED/E_RAFT_NOT_READY/E_RAFT_WAITING_SNAPSHOT
-          // In this case, nothing changed, just return the error
           default: {
             VLOG_EVERY_N(2, 1000) << self->idStr_ << "Failed to append logs to the host (Err: "
                                   << apache::thrift::util::enumNameSafe(resp.get_error_code())
                                   << ")";
-            {
-              std::lock_guard<std::mutex> g(self->lock_);
-              self->setResponse(resp);
-            }
-            return;
+            break;
           }
         }
+        std::vector<std::shared_ptr<cpp2::AppendLogRequest>> newReqs;
+        {
+          std::lock_guard<std::mutex> g(self->lock_);
+          newReqs = self->onResponse(*req, resp);
+        }
+        for (auto& newReq : newReqs) {
+          self->appendLogsInternal(eb, std::move(newReq));
+        }
       })
       .thenError(folly::tag_t<TransportException>{},
-                 [self = shared_from_this(), req](TransportException&& ex) {
+                 [eb, self = shared_from_this(), req](TransportException&& ex) {
                    VLOG(4) << self->idStr_ << ex.what();
                    cpp2::AppendLogResponse r;
                    r.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+                   std::vector<std::shared_ptr<cpp2::AppendLogRequest>> newReqs;
                    {
                      std::lock_guard<std::mutex> g(self->lock_);
                      if (ex.getType() == TransportException::TIMED_OUT) {
@@ -262,32 +346,38 @@ void Host::appendLogsInternal(folly::EventBase* eb, std::shared_ptr<cpp2::Append
                            << ", current term " << req->get_current_term() << ", committed_id "
                            << req->get_committed_log_id() << ", last_log_term_sent "
                            << req->get_last_log_term_sent() << ", last_log_id_sent "
-                           << req->get_last_log_id_sent() << ", set lastLogIdSent_ to logIdToSend_ "
+                           << req->get_last_log_id_sent() << ", logIdToSend_ "
                            << self->logIdToSend_ << ", logs size "
                            << req->get_log_str_list().size();
                      }
-                     self->setResponse(r);
+                     newReqs = self->onResponse(*req, r);
                    }
                    // a new raft log or heartbeat will trigger another appendLogs in Host
-                   return;
+                   for (auto& newReq : newReqs) {
+                     self->appendLogsInternal(eb, std::move(newReq));
+                   }
                  })
-      .thenError(folly::tag_t<std::exception>{}, [self = shared_from_this()](std::exception&& ex) {
-        VLOG(4) << self->idStr_ << ex.what();
-        cpp2::AppendLogResponse r;
-        r.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
-        {
-          std::lock_guard<std::mutex> g(self->lock_);
-          self->setResponse(r);
-        }
-        // a new raft log or heartbeat will trigger another appendLogs in Host
-        return;
-      });
+      .thenError(folly::tag_t<std::exception>{},
+                 [eb, self = shared_from_this(), req](std::exception&& ex) {
+                   VLOG(4) << self->idStr_ << ex.what();
+                   cpp2::AppendLogResponse r;
+                   r.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+                   std::vector<std::shared_ptr<cpp2::AppendLogRequest>> newReqs;
+                   {
+                     std::lock_guard<std::mutex> g(self->lock_);
+                     newReqs = self->onResponse(*req, r);
+                   }
+                   // a new raft log or heartbeat will trigger another appendLogs in Host
+                   for (auto& newReq : newReqs) {
+                     self->appendLogsInternal(eb, std::move(newReq));
+                   }
+                 });
 }
 
 ErrorOr<nebula::cpp2::ErrorCode, std::shared_ptr<cpp2::AppendLogRequest>>
 Host::prepareAppendLogRequest() {
   CHECK(!lock_.try_lock());
-  VLOG(3) << idStr_ << "Prepare AppendLogs request from Log " << lastLogIdSent_ + 1 << " to "
+  VLOG(3) << idStr_ << "Prepare AppendLogs request from Log " << lastLogIdInFlight_ + 1 << " to "
           << logIdToSend_;
 
   auto makeReq = [this]() -> std::shared_ptr<cpp2::AppendLogRequest> {
@@ -298,42 +388,50 @@ Host::prepareAppendLogRequest() {
     req->committed_log_id_ref() = committedLogId_;
     req->leader_addr_ref() = part_->address().host;
     req->leader_port_ref() = part_->address().port;
-    req->last_log_term_sent_ref() = lastLogTermSent_;
-    req->last_log_id_sent_ref() = lastLogIdSent_;
+    req->last_log_term_sent_ref() = lastLogTermInFlight_;
+    req->last_log_id_sent_ref() = lastLogIdInFlight_;
     return req;
   };
 
-  // We need to use lastLogIdSent_ + 1 to check whether need to send snapshot
-  if (UNLIKELY(lastLogIdSent_ + 1 < part_->wal()->firstLogId())) {
+  // We need to use lastLogIdInFlight_ + 1 to check whether need to send snapshot
+  if (UNLIKELY(lastLogIdInFlight_ + 1 < part_->wal()->firstLogId())) {
     return startSendSnapshot();
   }
 
-  if (lastLogIdSent_ == logIdToSend_) {
+  if (lastLogIdInFlight_ == logIdToSend_) {
     auto req = makeReq();
     return req;
   }
 
-  if (lastLogIdSent_ + 1 > part_->wal()->lastLogId()) {
+  if (lastLogIdInFlight_ + 1 > part_->wal()->lastLogId()) {
     VLOG_IF(1, FLAGS_trace_raft) << idStr_ << "My lastLogId in wal is " << part_->wal()->lastLogId()
-                                 << ", but you are seeking " << lastLogIdSent_ + 1
+                                 << ", but you are seeking " << lastLogIdInFlight_ + 1
                                  << ", so i have nothing to send, logIdToSend_ = " << logIdToSend_;
     return nebula::cpp2::ErrorCode::E_RAFT_NO_WAL_FOUND;
   }
 
-  auto it = part_->wal()->iterator(lastLogIdSent_ + 1, logIdToSend_);
+  auto it = part_->wal()->iterator(lastLogIdInFlight_ + 1, logIdToSend_);
   if (it->valid()) {
     auto req = makeReq();
     std::vector<cpp2::RaftLogEntry> logs;
+    auto codec = supportCompression_ ? wal::toLogCompression(FLAGS_raft_log_compression)
+                                     : wal::LogCompression::NONE;
     for (size_t cnt = 0; it->valid() && cnt < FLAGS_max_appendlog_batch_size; ++(*it), ++cnt) {
       cpp2::RaftLogEntry entry;
       entry.cluster_ref() = it->logSource();
-      entry.log_str_ref() = it->logMsg().toString();
+      auto compressed = wal::compressLog(codec, it->logMsg());
+      if (compressed) {
+        entry.log_str_ref() = std::move(*compressed);
+        entry.compressed_ref() = true;
+      } else {
+        entry.log_str_ref() = it->logMsg().toString();
+      }
       entry.log_term_ref() = it->logTerm();
       logs.emplace_back(std::move(entry));
     }
-    // the last log entry's id is (lastLogIdSent_ + cnt), when iterator is invalid and last log
+    // the last log entry's id is (lastLogIdInFlight_ + cnt), when iterator is invalid and last log
     // entry's id is not logIdToSend_, which means the log has been rollbacked
-    if (!it->valid() && (lastLogIdSent_ + static_cast<int64_t>(logs.size()) != logIdToSend_)) {
+    if (!it->valid() && (lastLogIdInFlight_ + static_cast<int64_t>(logs.size()) != logIdToSend_)) {
       VLOG_IF(1, FLAGS_trace_raft)
           << idStr_ << "Can't find log in wal, logIdToSend_ = " << logIdToSend_;
       return nebula::cpp2::ErrorCode::E_RAFT_NO_WAL_FOUND;
@@ -348,19 +446,22 @@ Host::prepareAppendLogRequest() {
 nebula::cpp2::ErrorCode Host::startSendSnapshot() {
   CHECK(!lock_.try_lock());
   if (!sendingSnapshot_) {
-    VLOG(1) << idStr_ << "Can't find log " << lastLogIdSent_ + 1 << " in wal, send the snapshot"
+    VLOG(1) << idStr_ << "Can't find log " << lastLogIdInFlight_ + 1 << " in wal, send the snapshot"
             << ", logIdToSend = " << logIdToSend_
             << ", firstLogId in wal = " << part_->wal()->firstLogId()
             << ", lastLogId in wal = " << part_->wal()->lastLogId();
     sendingSnapshot_ = true;
     stats::StatsManager::addValue(kNumSendSnapshot);
-    part_->snapshot_->sendSnapshot(part_, addr_)
+    auto codec = wal::toLogCompression(FLAGS_raft_log_compression);
+    part_->snapshot_->sendSnapshot(part_, addr_, codec, supportSnapshotFiles_)
         .thenValue([self = shared_from_this()](auto&& status) {
           std::lock_guard<std::mutex> g(self->lock_);
           if (status.ok()) {
             auto commitLogIdAndTerm = status.value();
             self->lastLogIdSent_ = commitLogIdAndTerm.first;
             self->lastLogTermSent_ = commitLogIdAndTerm.second;
+            self->lastLogIdInFlight_ = commitLogIdAndTerm.first;
+            self->lastLogTermInFlight_ = commitLogIdAndTerm.second;
             self->followerCommittedLogId_ = commitLogIdAndTerm.first;
             VLOG(1) << self->idStr_ << "Send snapshot succeeded!"
                     << " commitLogId = " << commitLogIdAndTerm.first
@@ -400,6 +501,9 @@ folly::Future<cpp2::AppendLogResponse> Host::sendAppendLogRequest(
                                << req->get_last_log_term_sent() << ", last_log_id_sent "
                                << req->get_last_log_id_sent() << ", logs in request "
                                << req->get_log_str_list().size();
+  if (FLAGS_raft_group_commit) {
+    return AppendLogBatcher::instance().appendLog(part_->clientMan_, addr_, eb, std::move(req));
+  }
   // Get client connection
   auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
   return client->future_appendLog(*req);
@@ -456,6 +560,7 @@ folly::Future<cpp2::HeartbeatResponse> Host::sendHeartbeat(
             if (self->paused_) {
               self->paused_ = false;
             }
+            self->supportCompression_ = resp.get_support_compression();
           }
           self->setLastHeartbeatTime(time::WallClock::fastNowInMilliSec());
           pro.setValue(std::move(t.value()));
@@ -496,40 +601,5 @@ bool Host::noRequest() const {
   return pendingReq_ == emptyTup;
 }
 
-std::shared_ptr<cpp2::AppendLogRequest> Host::getPendingReqIfAny(std::shared_ptr<Host> self) {
-  CHECK(!self->lock_.try_lock());
-  CHECK(self->requestOnGoing_) << self->idStr_;
-
-  // Check if there are any pending request to send
-  if (self->noRequest()) {
-    self->requestOnGoing_ = false;
-    self->noMoreRequestCV_.notify_all();
-    return nullptr;
-  }
-
-  // there is pending request
-  auto& tup = self->pendingReq_;
-  self->logTermToSend_ = std::get<0>(tup);
-  self->logIdToSend_ = std::get<1>(tup);
-  self->committedLogId_ = std::get<2>(tup);
-
-  VLOG_IF(1, FLAGS_trace_raft) << self->idStr_ << "Sending the pending request in the queue"
-                               << ", from " << self->lastLogIdSent_ + 1 << " to "
-                               << self->logIdToSend_;
-  self->pendingReq_ = std::make_tuple(0, 0, 0);
-  self->promise_ = std::move(self->cachingPromise_);
-  self->cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
-
-  auto result = self->prepareAppendLogRequest();
-  if (ok(result)) {
-    return value(result);
-  } else {
-    cpp2::AppendLogResponse r;
-    r.error_code_ref() = error(result);
-    self->setResponse(r);
-    return nullptr;
-  }
-}
-
 }  // namespace raftex
 }  // namespace nebula
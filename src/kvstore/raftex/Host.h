@@ -89,6 +89,9 @@ class Host final : public std::enable_shared_from_this<Host> {
     logTermToSend_ = 0;
     lastLogIdSent_ = 0;
     lastLogTermSent_ = 0;
+    lastLogIdInFlight_ = 0;
+    lastLogTermInFlight_ = 0;
+    resync_ = false;
     committedLogId_ = 0;
     sendingSnapshot_ = false;
     followerCommittedLogId_ = 0;
@@ -194,6 +197,24 @@ class Host final : public std::enable_shared_from_this<Host> {
    */
   void appendLogsInternal(folly::EventBase* eb, std::shared_ptr<cpp2::AppendLogRequest> req);
 
+  /**
+   * @brief Handle the response of a batch in flight, the lock must be held
+   *
+   * @param req The rpc request of the batch
+   * @param resp The rpc response, or the error if the rpc failed
+   * @return std::vector<std::shared_ptr<cpp2::AppendLogRequest>> The batches to send next
+   */
+  std::vector<std::shared_ptr<cpp2::AppendLogRequest>> onResponse(
+      const cpp2::AppendLogRequest& req, const cpp2::AppendLogResponse& resp);
+
+  /**
+   * @brief Build the batches to send until the window of batches in flight is full, the lock must
+   * be held. The pending request will be sent when all logs of the ongoing ones have been sent.
+   *
+   * @return std::vector<std::shared_ptr<cpp2::AppendLogRequest>> The batches to send
+   */
+  std::vector<std::shared_ptr<cpp2::AppendLogRequest>> prepareInFlightRequests();
+
   folly::Future<cpp2::HeartbeatResponse> sendHeartbeatRequest(
       folly::EventBase* eb, std::shared_ptr<cpp2::HeartbeatRequest> req);
 
@@ -218,12 +239,20 @@ class Host final : public std::enable_shared_from_this<Host> {
   bool noRequest() const;
 
   /**
-   * @brief Notify the RaftPart the result of sending logs to peers
+   * @brief Notify the RaftPart the result of sending logs to peers, all the ongoing and pending
+   * requests are finished with the response
    *
    * @param resp RPC response
    */
   void setResponse(const cpp2::AppendLogResponse& resp);
 
+  /**
+   * @brief Fulfill the ongoing requests whose logs have all been received by the peer
+   *
+   * @param resp RPC response
+   */
+  void setMatchedResponse(const cpp2::AppendLogResponse& resp);
+
   void setLastHeartbeatTime(int64_t time) {
     lastHeartbeatTime_ = time;
   }
@@ -232,15 +261,6 @@ class Host final : public std::enable_shared_from_this<Host> {
     return lastHeartbeatTime_;
   }
 
-  /**
-   * @brief If there are more logs to send, build the append log request
-   *
-   * @param self Shared ptr of Host itself
-   * @return std::shared_ptr<cpp2::AppendLogRequest> The request if there are logs to send, return
-   * nullptr there are none
-   */
-  std::shared_ptr<cpp2::AppendLogRequest> getPendingReqIfAny(std::shared_ptr<Host> self);
-
  private:
   // <term, logId, committedLogId>
   using Request = std::tuple<TermID, LogID, LogID>;
@@ -263,11 +283,16 @@ class Host final : public std::enable_shared_from_this<Host> {
 
   // whether there is a batch of logs for target host in on going
   bool requestOnGoing_{false};
+  // number of batches sent to target host waiting for response
+  uint32_t inFlight_{0};
+  // whether the batches have to be sent again from lastLogIdSent_ once all in flight are finished
+  bool resync_{false};
   // whether there is a snapshot for target host in on going
   bool sendingSnapshot_{false};
 
   std::condition_variable noMoreRequestCV_;
-  folly::SharedPromise<cpp2::AppendLogResponse> promise_;
+  // <logId, promise> of the ongoing requests, fulfilled once the peer has received the logId
+  std::deque<std::pair<LogID, folly::SharedPromise<cpp2::AppendLogResponse>>> promises_;
   folly::SharedPromise<cpp2::AppendLogResponse> cachingPromise_;
 
   Request pendingReq_{0, 0, 0};
@@ -276,10 +301,14 @@ class Host final : public std::enable_shared_from_this<Host> {
   LogID logIdToSend_{0};
   TermID logTermToSend_{0};
 
-  // The previous log before this batch
+  // The last log received by the peer
   LogID lastLogIdSent_{0};
   TermID lastLogTermSent_{0};
 
+  // The last log of the batches in flight, the previous log before the next batch
+  LogID lastLogIdInFlight_{0};
+  TermID lastLogTermInFlight_{0};
+
   LogID committedLogId_{0};
 
   // CommittedLogId of follower
@@ -287,6 +316,12 @@ class Host final : public std::enable_shared_from_this<Host> {
 
   // last HB response time from the peer
   int64_t lastHeartbeatTime_{0};
+
+  // Whether the peer accepts the compressed logs, learned from its responses
+  bool supportCompression_{false};
+
+  // Whether the peer ingests the snapshot in sst files, learned from its responses
+  bool supportSnapshotFiles_{false};
 };
 
 }  // namespace raftex
@@ -13,8 +13,10 @@
 #include "common/base/Base.h"
 #include "common/base/CollectNSucceeded.h"
 #include "common/network/NetworkUtils.h"
+#include "common/stats/ContentionStats.h"
 #include "common/stats/StatsManager.h"
 #include "common/thread/NamedThread.h"
+#include "common/thread/TimerWheel.h"
 #include "common/thrift/ThriftClientManager.h"
 #include "common/time/ScopedTimer.h"
 #include "common/time/WallClock.h"
@@ -38,7 +40,10 @@ DEFINE_bool(trace_raft, false, "Enable trace one raft request");
 DECLARE_int32(wal_ttl);
 DECLARE_int64(wal_file_size);
 DECLARE_int32(wal_buffer_size);
+DECLARE_int32(wal_buffer_node_length);
+DECLARE_int32(wal_buffer_node_pool_size);
 DECLARE_bool(wal_sync);
+DECLARE_string(wal_compression);
 
 namespace nebula {
 namespace raftex {
@@ -306,6 +311,7 @@ class AppendLogsIteratorFactory {
             auto end = op.second.second;
             ranges.emplace_back(std::make_pair(begin, end));
           }
+          // The merges commute, which don't conflict with each other
         }
         break;
       }
@@ -357,11 +363,16 @@ RaftPart::RaftPart(
   FileBasedWalPolicy policy;
   policy.fileSize = FLAGS_wal_file_size;
   policy.bufferSize = FLAGS_wal_buffer_size;
+  policy.bufferNodeLength = FLAGS_wal_buffer_node_length;
+  policy.bufferNodePoolSize = FLAGS_wal_buffer_node_pool_size;
   policy.sync = FLAGS_wal_sync;
+  policy.compression = wal::toLogCompression(FLAGS_wal_compression);
   FileBasedWalInfo info;
   info.idStr_ = idStr_;
   info.spaceId_ = spaceId_;
   info.partId_ = partId_;
+  // Most of the time to open a part is spent on scanning the wal
+  time::Duration scanWalDur;
   wal_ = FileBasedWal::getWal(
       walRoot,
       std::move(info),
@@ -370,6 +381,7 @@ RaftPart::RaftPart(
         return this->preProcessLog(logId, logTermId, logClusterId, log);
       },
       diskMan);
+  stats::StatsManager::addValue(kScanWalLatencyUs, scanWalDur.elapsedInUSec());
   CHECK(!!executor_) << idStr_ << "Should not be nullptr";
 }
 
@@ -448,9 +460,7 @@ void RaftPart::start(std::vector<HostAddr>&& peers, bool asLearner) {
   startTimeMs_ = time::WallClock::fastNowInMilliSec();
   // Set up a leader election task
   size_t delayMS = 100 + folly::Random::rand32(900);
-  bgWorkers_->addDelayTask(delayMS, [self = shared_from_this(), startTime = startTimeMs_] {
-    self->statusPolling(startTime);
-  });
+  scheduleStatusPolling(delayMS, startTimeMs_);
 }
 
 void RaftPart::stop() {
@@ -804,7 +814,7 @@ folly::Future<nebula::cpp2::ErrorCode> RaftPart::appendLogAsync(ClusterID source
     return nebula::cpp2::ErrorCode::E_RAFT_BUFFER_OVERFLOW;
   }
   {
-    std::lock_guard<std::mutex> lck(logsLock_);
+    stats::TimedLockGuard<std::mutex> lck(logsLock_, kRaftLogsLockWaitUs.get());
 
     VLOG(4) << idStr_ << "Checking whether buffer overflow";
 
@@ -839,7 +849,7 @@ folly::Future<nebula::cpp2::ErrorCode> RaftPart::appendLogAsync(ClusterID source
   TermID termId = 0;
   nebula::cpp2::ErrorCode res;
   {
-    std::lock_guard<std::mutex> g(raftLock_);
+    stats::TimedLockGuard<std::mutex> g(raftLock_, kRaftLockWaitUs.get());
     res = canAppendLogs();
     if (res == nebula::cpp2::ErrorCode::SUCCEEDED) {
       firstId = lastLogId_ + 1;
@@ -857,7 +867,7 @@ folly::Future<nebula::cpp2::ErrorCode> RaftPart::appendLogAsync(ClusterID source
   // until majority accept the logs, the leadership changes, or
   // the partition stops
   {
-    std::lock_guard<std::mutex> lck(logsLock_);
+    stats::TimedLockGuard<std::mutex> lck(logsLock_, kRaftLogsLockWaitUs.get());
     AppendLogsIteratorFactory::make(logs_, sendingLogs_);
     bufferOverFlow_ = false;
     if (sendingLogs_.empty()) {
@@ -879,7 +889,7 @@ void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
   LogID lastId = 0;
   nebula::cpp2::ErrorCode res = nebula::cpp2::ErrorCode::SUCCEEDED;
   do {
-    std::lock_guard<std::mutex> g(raftLock_);
+    stats::TimedLockGuard<std::mutex> g(raftLock_, kRaftLockWaitUs.get());
     res = canAppendLogs(termId);
     if (res != nebula::cpp2::ErrorCode::SUCCEEDED) {
       break;
@@ -1429,12 +1439,17 @@ void RaftPart::statusPolling(int64_t startTime) {
     std::lock_guard<std::mutex> g(raftLock_);
     if (status_ == Status::RUNNING || status_ == Status::WAITING_SNAPSHOT) {
       VLOG(4) << idStr_ << "Schedule new task";
-      bgWorkers_->addDelayTask(
-          delay, [self = shared_from_this(), startTime] { self->statusPolling(startTime); });
+      scheduleStatusPolling(delay, startTime);
     }
   }
 }
 
+void RaftPart::scheduleStatusPolling(size_t delayMS, int64_t startTime) {
+  thread::TimerWheel::instance().schedule(delayMS, [self = shared_from_this(), startTime] {
+    self->bgWorkers_->addTask([self, startTime] { self->statusPolling(startTime); });
+  });
+}
+
 bool RaftPart::needToCleanupSnapshot() {
   std::lock_guard<std::mutex> g(raftLock_);
   return status_ == Status::WAITING_SNAPSHOT && role_ != Role::LEADER &&
@@ -1624,7 +1639,7 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
                                << ", local committedLogId = " << committedLogId_
                                << ", local current term = " << term_
                                << ", wal lastLogId = " << wal_->lastLogId();
-  std::lock_guard<std::mutex> g(raftLock_);
+  stats::TimedLockGuard<std::mutex> g(raftLock_, kRaftLockWaitUs.get());
 
   resp.current_term_ref() = term_;
   resp.leader_addr_ref() = leader_.host;
@@ -1633,6 +1648,7 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
   // by default we ask leader send logs after committedLogId_
   resp.last_matched_log_id_ref() = committedLogId_;
   resp.last_matched_log_term_ref() = committedLogTerm_;
+  resp.support_snapshot_files_ref() = canIngestSnapshotFiles();
 
   // Check status
   if (UNLIKELY(status_ == Status::STOPPED)) {
@@ -1663,6 +1679,7 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
 
   // Reset the timeout timer
   lastMsgRecvDur_.reset();
+  leaderCommittedLogId_ = req.get_committed_log_id();
 
   // `lastMatchedLogId` is the last log id of which leader's and follower's log are matched
   // (which means log term of same log id are the same)
@@ -1907,7 +1924,7 @@ void RaftPart::processHeartbeatRequest(const cpp2::HeartbeatRequest& req,
                                << ", local lastLogTerm = " << lastLogTerm_
                                << ", local committedLogId = " << committedLogId_
                                << ", local current term = " << term_;
-  std::lock_guard<std::mutex> g(raftLock_);
+  stats::TimedLockGuard<std::mutex> g(raftLock_, kRaftLockWaitUs.get());
 
   // As for heartbeat, last_log_id and last_log_term is not checked by leader, follower only verify
   // whether leader is legal, just return lastLogId_ and lastLogTerm_ in resp. And we don't do any
@@ -1945,6 +1962,7 @@ void RaftPart::processHeartbeatRequest(const cpp2::HeartbeatRequest& req,
 
   // Reset the timeout timer
   lastMsgRecvDur_.reset();
+  leaderCommittedLogId_ = req.get_committed_log_id();
 
   // As for heartbeat, return ok after verifyLeader
   resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -2004,9 +2022,17 @@ void RaftPart::processSendSnapshotRequest(const cpp2::SendSnapshotRequest& req,
             << " of term " << req.get_current_term();
   }
   lastSnapshotRecvDur_.reset();
-  // TODO(heng): Maybe we should save them into one sst firstly?
-  auto ret = commitSnapshot(
-      req.get_rows(), req.get_committed_log_id(), req.get_committed_log_term(), req.get_done());
+  auto ret = req.file_chunk_ref().has_value()
+                 ? commitSnapshotFile(*req.file_chunk_ref(),
+                                      req.get_file_offset(),
+                                      req.get_file_end(),
+                                      req.get_committed_log_id(),
+                                      req.get_committed_log_term(),
+                                      req.get_done())
+                 : commitSnapshot(req.get_rows(),
+                                  req.get_committed_log_id(),
+                                  req.get_committed_log_term(),
+                                  req.get_done());
   if (std::get<0>(ret) != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << idStr_ << "Persist snapshot failed";
     resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_PERSIST_SNAPSHOT_FAILED;
@@ -2038,6 +2064,13 @@ void RaftPart::processSendSnapshotRequest(const cpp2::SendSnapshotRequest& req,
   return;
 }
 
+std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> RaftPart::commitSnapshotFile(
+    folly::StringPiece, int64_t, bool, LogID, TermID, bool) {
+  VLOG(2) << idStr_ << "The snapshot files are not supported";
+  return {
+      nebula::cpp2::ErrorCode::E_RAFT_PERSIST_SNAPSHOT_FAILED, kNoSnapshotCount, kNoSnapshotSize};
+}
+
 void RaftPart::sendHeartbeat() {
   // If leader has not commit any logs in this term, it must commit all logs in
   // previous term, so heartbeat is send by appending one empty log.
@@ -2251,6 +2284,18 @@ void RaftPart::checkRemoteListeners(const std::set<HostAddr>& expected) {
   }
 }
 
+bool RaftPart::followerReadable(LogID maxLag) {
+  std::lock_guard<std::mutex> g(raftLock_);
+  if (status_ != Status::RUNNING || role_ != Role::FOLLOWER || leader_ == HostAddr("", 0)) {
+    return false;
+  }
+  // The committed log id of leader is stale if no message is received for a heartbeat interval
+  if (lastMsgRecvDur_.elapsedInMSec() >= FLAGS_raft_heartbeat_interval_secs * 1000) {
+    return false;
+  }
+  return leaderCommittedLogId_ - committedLogId_ <= maxLag;
+}
+
 bool RaftPart::leaseValid() {
   std::lock_guard<std::mutex> g(raftLock_);
   if (hosts_.empty()) {
@@ -360,6 +360,14 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    */
   bool leaseValid();
 
+  /**
+   * @brief Return whether the follower could serve the reads, which requires the leader is heard
+   * from within a heartbeat interval and the committed log id of follower is close to the leader's
+   *
+   * @param maxLag Max count of committed logs the follower could fall behind the leader
+   */
+  bool followerReadable(LogID maxLag);
+
   /**
    * @brief Return whether we need to clean expired wal
    */
@@ -530,6 +538,34 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
       TermID committedLogTerm,
       bool finished) = 0;
 
+  /**
+   * @brief Whether the snapshot could be applied by ingesting the sst files, the leader sends the
+   * files instead of the rows then
+   */
+  virtual bool canIngestSnapshotFiles() {
+    return false;
+  }
+
+  /**
+   * @brief Apply a chunk of the sst file of snapshot, the file is ingested into the state machine
+   * once its last chunk is received
+   *
+   * @param chunk Data of the file at offset
+   * @param offset Offset of the chunk in the file
+   * @param fileEnd Whether it's the last chunk of the file
+   * @param committedLogId Commit log id of snapshot
+   * @param committedLogTerm Commit log term of snapshot
+   * @param finished Whether spapshot is finished
+   * @return std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Return {ok, files ingested, size}
+   */
+  virtual std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> commitSnapshotFile(
+      folly::StringPiece chunk,
+      int64_t offset,
+      bool fileEnd,
+      LogID committedLogId,
+      TermID committedLogTerm,
+      bool finished);
+
   /**
    * @brief Clean up extra data about the partition, usually related to state machine
    *
@@ -615,6 +651,15 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    */
   void statusPolling(int64_t startTime);
 
+  /**
+   * @brief Schedule the next status polling in the shared timer wheel, which runs it in the
+   * background workers, so the timers of thousands of parts don't load their event loops
+   *
+   * @param delayMS Milliseconds from now
+   * @param startTime Start time of the RaftPart
+   */
+  void scheduleStatusPolling(size_t delayMS, int64_t startTime);
+
   /**
    * @brief Return whether need to send heartbeat
    */
@@ -835,6 +880,8 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   // The last id and term when logs has been applied to state machine
   LogID committedLogId_{0};
   TermID committedLogTerm_{0};
+  // As for follower, the committed log id of leader in the last message received
+  LogID leaderCommittedLogId_{0};
   static constexpr LogID kNoCommitLogId{-1};
   static constexpr TermID kNoCommitLogTerm{-1};
   static constexpr int64_t kNoSnapshotCount{-1};
@@ -11,6 +11,7 @@
 #include "common/base/ErrorOr.h"
 #include "common/ssl/SSLConfig.h"
 #include "kvstore/raftex/RaftPart.h"
+#include "kvstore/wal/LogCompression.h"
 
 namespace nebula {
 namespace raftex {
@@ -137,6 +138,7 @@ void RaftexService::askForVote(cpp2::AskForVoteResponse& resp, const cpp2::AskFo
 }
 
 void RaftexService::appendLog(cpp2::AppendLogResponse& resp, const cpp2::AppendLogRequest& req) {
+  resp.support_compression_ref() = true;
   auto part = findPart(req.get_space(), req.get_part());
   if (!part) {
     // Not found
@@ -144,11 +146,67 @@ void RaftexService::appendLog(cpp2::AppendLogResponse& resp, const cpp2::AppendL
     return;
   }
 
-  part->processAppendLogRequest(req, resp);
+  const auto& logs = req.get_log_str_list();
+  auto isCompressed = [](const auto& log) { return log.get_compressed(); };
+  if (std::none_of(logs.begin(), logs.end(), isCompressed)) {
+    part->processAppendLogRequest(req, resp);
+    return;
+  }
+  // The logs are uncompressed before processed, RaftPart never sees the compressed ones
+  auto uncompressed = req;
+  try {
+    for (auto& log : *uncompressed.log_str_list_ref()) {
+      if (log.get_compressed()) {
+        log.log_str_ref() = wal::uncompressLog(log.get_log_str());
+        log.compressed_ref() = false;
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to uncompress the logs of space " << req.get_space() << " part "
+               << req.get_part() << ": " << e.what();
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+    return;
+  }
+  part->processAppendLogRequest(uncompressed, resp);
+}
+
+folly::Future<cpp2::BatchAppendLogResponse> RaftexService::future_batchAppendLog(
+    const cpp2::BatchAppendLogRequest& req) {
+  // The requests are of different partitions, so the order of each partition is kept by its
+  // leader, which never sends the next request before the response of the last one
+  auto workers = getThreadManager();
+  // The request is released once the handler returns, so the requests are kept until processed
+  auto requests = std::make_shared<std::vector<cpp2::AppendLogRequest>>(req.get_requests());
+  std::vector<folly::Future<cpp2::AppendLogResponse>> futures;
+  futures.reserve(requests->size());
+  for (size_t i = 0; i < requests->size(); i++) {
+    futures.emplace_back(folly::via(workers.get(), [this, requests, i] {
+      cpp2::AppendLogResponse resp;
+      appendLog(resp, (*requests)[i]);
+      return resp;
+    }));
+  }
+  return folly::collectAll(std::move(futures))
+      .via(workers.get())
+      .thenValue([](std::vector<folly::Try<cpp2::AppendLogResponse>>&& tries) {
+        cpp2::BatchAppendLogResponse resp;
+        resp.responses_ref()->reserve(tries.size());
+        for (auto& t : tries) {
+          if (t.hasValue()) {
+            resp.responses_ref()->emplace_back(std::move(t).value());
+          } else {
+            cpp2::AppendLogResponse r;
+            r.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+            resp.responses_ref()->emplace_back(std::move(r));
+          }
+        }
+        return resp;
+      });
 }
 
 void RaftexService::sendSnapshot(cpp2::SendSnapshotResponse& resp,
                                  const cpp2::SendSnapshotRequest& req) {
+  resp.support_compression_ref() = true;
   auto part = findPart(req.get_space(), req.get_part());
   if (!part) {
     // Not found
@@ -156,13 +214,29 @@ void RaftexService::sendSnapshot(cpp2::SendSnapshotResponse& resp,
     return;
   }
 
-  part->processSendSnapshotRequest(req, resp);
+  if (!req.compressed_rows_ref().has_value()) {
+    part->processSendSnapshotRequest(req, resp);
+    return;
+  }
+  // The rows are uncompressed before processed, RaftPart never sees the compressed ones
+  auto uncompressed = req;
+  try {
+    uncompressed.rows_ref() = wal::uncompressRows(*req.compressed_rows_ref());
+    uncompressed.compressed_rows_ref().reset();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to uncompress the snapshot rows of space " << req.get_space()
+               << " part " << req.get_part() << ": " << e.what();
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+    return;
+  }
+  part->processSendSnapshotRequest(uncompressed, resp);
 }
 
 void RaftexService::async_eb_heartbeat(
     std::unique_ptr<apache::thrift::HandlerCallback<cpp2::HeartbeatResponse>> callback,
     const cpp2::HeartbeatRequest& req) {
   cpp2::HeartbeatResponse resp;
+  resp.support_compression_ref() = true;
   auto part = findPart(req.get_space(), req.get_part());
   if (!part) {
     // Not found
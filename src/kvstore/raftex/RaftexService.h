@@ -92,6 +92,16 @@ class RaftexService : public cpp2::RaftexServiceSvIf {
    */
   void appendLog(cpp2::AppendLogResponse& resp, const cpp2::AppendLogRequest& req) override;
 
+  /**
+   * @brief Handle the append log requests of different partitions from the same leader host, each
+   * request is processed by its partition in worker thread concurrently
+   *
+   * @param req
+   * @return folly::Future<cpp2::BatchAppendLogResponse>
+   */
+  folly::Future<cpp2::BatchAppendLogResponse> future_batchAppendLog(
+      const cpp2::BatchAppendLogRequest& req) override;
+
   /**
    * @brief Handle send snapshot reqtuest in worker thread
    *
@@ -13,6 +13,10 @@ DEFINE_int32(snapshot_worker_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_io_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_send_retry_times, 3, "Retry times if send failed");
 DEFINE_int32(snapshot_send_timeout_ms, 60000, "Rpc timeout for sending snapshot");
+DEFINE_bool(snapshot_send_files,
+            true,
+            "Whether to send the snapshot in sst files to the peers able to ingest them, instead "
+            "of the rows");
 
 namespace nebula {
 namespace raftex {
@@ -29,13 +33,16 @@ SnapshotManager::SnapshotManager() {
 }
 
 folly::Future<StatusOr<std::pair<LogID, TermID>>> SnapshotManager::sendSnapshot(
-    std::shared_ptr<RaftPart> part, const HostAddr& dst) {
+    std::shared_ptr<RaftPart> part,
+    const HostAddr& dst,
+    wal::LogCompression codec,
+    bool sendFiles) {
   folly::Promise<StatusOr<std::pair<LogID, TermID>>> p;
   // if use getFuture(), the future's executor is InlineExecutor, and if the promise setValue first,
   // the future's callback will be called directly in thenValue in the same thread, the Host::lock_
   // would be locked twice in one thread, this will cause deadlock
   auto fut = p.getSemiFuture().via(executor_.get());
-  executor_->add([this, p = std::move(p), part, dst]() mutable {
+  executor_->add([this, p = std::move(p), part, dst, codec, sendFiles]() mutable {
     auto spaceId = part->spaceId_;
     auto partId = part->partId_;
     auto tr = part->getTermAndRole();
@@ -46,66 +53,123 @@ folly::Future<StatusOr<std::pair<LogID, TermID>>> SnapshotManager::sendSnapshot(
     }
     auto termId = tr.first;
     const auto& localhost = part->address();
+    // The rows are sent uncompressed until the peer responds it supports compression, the sst
+    // files are compressed already
+    bool supportCompression = false;
+    auto sendChunk = [&, this](LogID commitLogId,
+                               TermID commitLogTerm,
+                               folly::StringPiece chunk,
+                               int64_t offset,
+                               bool fileEnd,
+                               int64_t totalCount,
+                               int64_t totalSize,
+                               SnapshotStatus status) -> bool {
+      if (status == SnapshotStatus::FAILED) {
+        VLOG(1) << part->idStr_ << "Snapshot send failed, the leader changed?";
+        p.setValue(Status::Error("Send snapshot failed!"));
+        return false;
+      }
+      auto sendRequest = [&, this](bool) {
+        return sendFile(spaceId,
+                        partId,
+                        termId,
+                        commitLogId,
+                        commitLogTerm,
+                        localhost,
+                        chunk,
+                        offset,
+                        fileEnd,
+                        totalSize,
+                        totalCount,
+                        dst,
+                        status == SnapshotStatus::DONE);
+      };
+      if (!sendWithRetry(part->idStr_, supportCompression, std::move(sendRequest))) {
+        p.setValue(Status::Error("Send snapshot failed!"));
+        return false;
+      }
+      if (status == SnapshotStatus::DONE) {
+        VLOG(1) << part->idStr_ << "Finished, total files " << totalCount << ", totalSize "
+                << totalSize;
+        p.setValue(std::make_pair(commitLogId, commitLogTerm));
+      }
+      return true;
+    };
+    // Fall back to the rows if the snapshot could not be sent in files
+    if (sendFiles && FLAGS_snapshot_send_files &&
+        accessAllFilesInSnapshot(spaceId, partId, std::move(sendChunk))) {
+      return;
+    }
     accessAllRowsInSnapshot(
         spaceId,
         partId,
-        [&, this, p = std::move(p)](LogID commitLogId,
-                                    TermID commitLogTerm,
-                                    const std::vector<std::string>& data,
-                                    int64_t totalCount,
-                                    int64_t totalSize,
-                                    SnapshotStatus status) mutable -> bool {
+        [&, this](LogID commitLogId,
+                  TermID commitLogTerm,
+                  const std::vector<std::string>& data,
+                  int64_t totalCount,
+                  int64_t totalSize,
+                  SnapshotStatus status) -> bool {
           if (status == SnapshotStatus::FAILED) {
             VLOG(1) << part->idStr_ << "Snapshot send failed, the leader changed?";
             p.setValue(Status::Error("Send snapshot failed!"));
             return false;
           }
-          int retry = FLAGS_snapshot_send_retry_times;
-          while (retry-- > 0) {
-            auto f = send(spaceId,
-                          partId,
-                          termId,
-                          commitLogId,
-                          commitLogTerm,
-                          localhost,
-                          data,
-                          totalSize,
-                          totalCount,
-                          dst,
-                          status == SnapshotStatus::DONE);
-            // TODO(heng): we send request one by one to avoid too large memory
-            // occupied.
-            try {
-              auto resp = std::move(f).get();
-              if (resp.get_error_code() == nebula::cpp2::ErrorCode::SUCCEEDED) {
-                VLOG(3) << part->idStr_ << "has sended count " << totalCount;
-                if (status == SnapshotStatus::DONE) {
-                  VLOG(1) << part->idStr_ << "Finished, totalCount " << totalCount << ", totalSize "
-                          << totalSize;
-                  p.setValue(std::make_pair(commitLogId, commitLogTerm));
-                }
-                return true;
-              } else {
-                VLOG(2) << part->idStr_ << "Sending snapshot failed, the error code is "
-                        << apache::thrift::util::enumNameSafe(resp.get_error_code());
-                sleep(1);
-                continue;
-              }
-            } catch (const std::exception& e) {
-              VLOG(3) << part->idStr_ << "Send snapshot failed, exception " << e.what()
-                      << ", retry " << retry << " times";
-              sleep(1);
-              continue;
-            }
+          auto sendRows = [&, this](bool compress) {
+            return send(spaceId,
+                        partId,
+                        termId,
+                        commitLogId,
+                        commitLogTerm,
+                        localhost,
+                        data,
+                        totalSize,
+                        totalCount,
+                        dst,
+                        status == SnapshotStatus::DONE,
+                        compress ? codec : wal::LogCompression::NONE);
+          };
+          if (!sendWithRetry(part->idStr_, supportCompression, std::move(sendRows))) {
+            p.setValue(Status::Error("Send snapshot failed!"));
+            return false;
+          }
+          VLOG(3) << part->idStr_ << "has sended count " << totalCount;
+          if (status == SnapshotStatus::DONE) {
+            VLOG(1) << part->idStr_ << "Finished, totalCount " << totalCount << ", totalSize "
+                    << totalSize;
+            p.setValue(std::make_pair(commitLogId, commitLogTerm));
           }
-          VLOG(2) << part->idStr_ << "Send snapshot failed!";
-          p.setValue(Status::Error("Send snapshot failed!"));
-          return false;
+          return true;
         });
   });
   return fut;
 }
 
+bool SnapshotManager::sendWithRetry(
+    const std::string& idStr,
+    bool& supportCompression,
+    folly::Function<folly::Future<raftex::cpp2::SendSnapshotResponse>(bool)> send) {
+  int retry = FLAGS_snapshot_send_retry_times;
+  while (retry-- > 0) {
+    // TODO(heng): we send request one by one to avoid too large memory
+    // occupied.
+    try {
+      auto resp = send(supportCompression).get();
+      supportCompression = resp.get_support_compression();
+      if (resp.get_error_code() == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return true;
+      }
+      VLOG(2) << idStr << "Sending snapshot failed, the error code is "
+              << apache::thrift::util::enumNameSafe(resp.get_error_code());
+    } catch (const std::exception& e) {
+      VLOG(3) << idStr << "Send snapshot failed, exception " << e.what() << ", retry " << retry
+              << " times";
+    }
+    sleep(1);
+  }
+  VLOG(2) << idStr << "Send snapshot failed!";
+  return false;
+}
+
 folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
     GraphSpaceID spaceId,
     PartitionID partId,
@@ -117,7 +181,8 @@ folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
     int64_t totalSize,
     int64_t totalCount,
     const HostAddr& addr,
-    bool finished) {
+    bool finished,
+    wal::LogCompression codec) {
   VLOG(4) << "Send snapshot request to " << addr;
   raftex::cpp2::SendSnapshotRequest req;
   req.space_ref() = spaceId;
@@ -127,7 +192,48 @@ folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
   req.committed_log_term_ref() = committedLogTerm;
   req.leader_addr_ref() = localhost.host;
   req.leader_port_ref() = localhost.port;
-  req.rows_ref() = data;
+  auto compressed = wal::compressRows(codec, data);
+  if (compressed) {
+    req.compressed_rows_ref() = std::move(*compressed);
+  } else {
+    req.rows_ref() = data;
+  }
+  req.total_size_ref() = totalSize;
+  req.total_count_ref() = totalCount;
+  req.done_ref() = finished;
+  auto* evb = ioThreadPool_->getEventBase();
+  return folly::via(evb, [this, addr, evb, req = std::move(req)]() mutable {
+    auto client = connManager_->client(addr, evb, false, FLAGS_snapshot_send_timeout_ms);
+    return client->future_sendSnapshot(req);
+  });
+}
+
+folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::sendFile(
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    TermID termId,
+    LogID committedLogId,
+    TermID committedLogTerm,
+    const HostAddr& localhost,
+    folly::StringPiece chunk,
+    int64_t offset,
+    bool fileEnd,
+    int64_t totalSize,
+    int64_t totalCount,
+    const HostAddr& addr,
+    bool finished) {
+  VLOG(4) << "Send snapshot file request to " << addr;
+  raftex::cpp2::SendSnapshotRequest req;
+  req.space_ref() = spaceId;
+  req.part_ref() = partId;
+  req.current_term_ref() = termId;
+  req.committed_log_id_ref() = committedLogId;
+  req.committed_log_term_ref() = committedLogTerm;
+  req.leader_addr_ref() = localhost.host;
+  req.leader_port_ref() = localhost.port;
+  req.file_chunk_ref() = chunk.str();
+  req.file_offset_ref() = offset;
+  req.file_end_ref() = fileEnd;
   req.total_size_ref() = totalSize;
   req.total_count_ref() = totalCount;
   req.done_ref() = finished;
@@ -16,6 +16,7 @@
 #include "common/thrift/ThriftClientManager.h"
 #include "interface/gen-cpp2/RaftexServiceAsyncClient.h"
 #include "interface/gen-cpp2/raftex_types.h"
+#include "kvstore/wal/LogCompression.h"
 
 namespace nebula {
 namespace raftex {
@@ -33,6 +34,17 @@ using SnapshotCallback = folly::Function<bool(LogID commitLogID,
                                               int64_t totalCount,
                                               int64_t totalSize,
                                               SnapshotStatus status)>;
+
+// Return false if send snapshot failed, will not send the rest of it. The chunk is part of a sst
+// file at offset, fileEnd marks the last chunk of the file. The totalCount is the number of files.
+using SnapshotFileCallback = folly::Function<bool(LogID commitLogID,
+                                                  TermID commitLogTerm,
+                                                  folly::StringPiece chunk,
+                                                  int64_t offset,
+                                                  bool fileEnd,
+                                                  int64_t totalCount,
+                                                  int64_t totalSize,
+                                                  SnapshotStatus status)>;
 class RaftPart;
 
 class SnapshotManager {
@@ -45,11 +57,16 @@ class SnapshotManager {
    *
    * @param part The RaftPart
    * @param dst The address of target peer
+   * @param codec Codec to compress the rows, used once the peer responds it supports compression
+   * @param sendFiles Whether the peer ingests the snapshot in sst files
    * @return folly::Future<StatusOr<std::pair<LogID, TermID>>> Future of snapshot result, return the
    * commit log id and commit log term if succeed
    */
-  folly::Future<StatusOr<std::pair<LogID, TermID>>> sendSnapshot(std::shared_ptr<RaftPart> part,
-                                                                 const HostAddr& dst);
+  folly::Future<StatusOr<std::pair<LogID, TermID>>> sendSnapshot(
+      std::shared_ptr<RaftPart> part,
+      const HostAddr& dst,
+      wal::LogCompression codec = wal::LogCompression::NONE,
+      bool sendFiles = false);
 
  private:
   /**
@@ -66,6 +83,7 @@ class SnapshotManager {
    * @param totalCount Count of key/value has been sent
    * @param addr Address of target peer
    * @param finished Whether this is the last batch of snapshot
+   * @param codec Codec to compress the key/value
    * @return folly::Future<raftex::cpp2::SendSnapshotResponse>
    */
   folly::Future<raftex::cpp2::SendSnapshotResponse> send(GraphSpaceID spaceId,
@@ -78,7 +96,53 @@ class SnapshotManager {
                                                          int64_t totalSize,
                                                          int64_t totalCount,
                                                          const HostAddr& addr,
-                                                         bool finished);
+                                                         bool finished,
+                                                         wal::LogCompression codec);
+
+  /**
+   * @brief Send the chunk of a sst file of snapshot
+   *
+   * @param spaceId
+   * @param partId
+   * @param termId Current term of RaftPart
+   * @param committedLogId The commit log id of snapshot
+   * @param committedLogTerm The commit log term of snapshot
+   * @param localhost Local address
+   * @param chunk Data of the file at offset
+   * @param offset Offset of the chunk in the file
+   * @param fileEnd Whether it's the last chunk of the file
+   * @param totalSize The bytes of files has been sent
+   * @param totalCount Count of files has been sent
+   * @param addr Address of target peer
+   * @param finished Whether this is the last request of snapshot
+   * @return folly::Future<raftex::cpp2::SendSnapshotResponse>
+   */
+  folly::Future<raftex::cpp2::SendSnapshotResponse> sendFile(GraphSpaceID spaceId,
+                                                             PartitionID partId,
+                                                             TermID termId,
+                                                             LogID committedLogId,
+                                                             TermID committedLogTerm,
+                                                             const HostAddr& localhost,
+                                                             folly::StringPiece chunk,
+                                                             int64_t offset,
+                                                             bool fileEnd,
+                                                             int64_t totalSize,
+                                                             int64_t totalCount,
+                                                             const HostAddr& addr,
+                                                             bool finished);
+
+  /**
+   * @brief Send a request of snapshot by the function, retry if it fails
+   *
+   * @param idStr Id of the part in logs
+   * @param supportCompression Whether the peer accepts compression, updated by the response
+   * @param send Function to send the request, whether to compress it is passed
+   * @return True if succeed
+   */
+  bool sendWithRetry(
+      const std::string& idStr,
+      bool& supportCompression,
+      folly::Function<folly::Future<raftex::cpp2::SendSnapshotResponse>(bool)> send);
 
   /**
    * @brief Interface to scan data, and trigger callback to send them
@@ -91,6 +155,19 @@ class SnapshotManager {
                                        PartitionID partId,
                                        SnapshotCallback cb) = 0;
 
+  /**
+   * @brief Interface to dump data into sst files, and trigger callback to send them
+   *
+   * @param spaceId
+   * @param partId
+   * @param cb Callback to send the files
+   * @return False if the snapshot could not be dumped into files and nothing is sent, the rows are
+   * sent then
+   */
+  virtual bool accessAllFilesInSnapshot(GraphSpaceID, PartitionID, SnapshotFileCallback) {
+    return false;
+  }
+
  private:
   std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
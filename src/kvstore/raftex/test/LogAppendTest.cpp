@@ -17,6 +17,12 @@
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
 DECLARE_uint32(max_batch_size);
+DECLARE_bool(raft_group_commit);
+DECLARE_uint32(max_appendlog_batch_size);
+DECLARE_uint32(raft_max_inflight_appendlog_batches);
+DECLARE_string(raft_log_compression);
+DECLARE_string(wal_compression);
+DECLARE_uint32(log_compression_min_size);
 
 namespace nebula {
 namespace raftex {
@@ -63,6 +69,85 @@ TEST(LogAppend, SimpleAppendWithThreeCopies) {
   finishRaft(services, copies, workers, leader);
 }
 
+TEST(LogAppend, GroupCommitAppend) {
+  fs::TempDir walRoot("/tmp/group_commit_append.XXXXXX");
+  FLAGS_raft_group_commit = true;
+  std::shared_ptr<thread::GenericThreadPool> workers;
+  std::vector<std::string> wals;
+  std::vector<HostAddr> allHosts;
+  std::vector<std::shared_ptr<RaftexService>> services;
+  std::vector<std::shared_ptr<test::TestShard>> copies;
+
+  std::shared_ptr<test::TestShard> leader;
+  setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+
+  // Check all hosts agree on the same leader
+  checkLeadership(copies, leader);
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 99, leader, msgs);
+  checkConsensus(copies, 0, 99, msgs);
+
+  finishRaft(services, copies, workers, leader);
+  FLAGS_raft_group_commit = false;
+}
+
+TEST(LogAppend, CompressedAppend) {
+  fs::TempDir walRoot("/tmp/compressed_append.XXXXXX");
+  FLAGS_raft_log_compression = "lz4";
+  FLAGS_wal_compression = "zstd";
+  FLAGS_log_compression_min_size = 0;
+  std::shared_ptr<thread::GenericThreadPool> workers;
+  std::vector<std::string> wals;
+  std::vector<HostAddr> allHosts;
+  std::vector<std::shared_ptr<RaftexService>> services;
+  std::vector<std::shared_ptr<test::TestShard>> copies;
+
+  std::shared_ptr<test::TestShard> leader;
+  setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+
+  // Check all hosts agree on the same leader
+  checkLeadership(copies, leader);
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 99, leader, msgs);
+  checkConsensus(copies, 0, 99, msgs);
+
+  finishRaft(services, copies, workers, leader);
+  FLAGS_raft_log_compression = "none";
+  FLAGS_wal_compression = "none";
+  FLAGS_log_compression_min_size = 256;
+}
+
+TEST(LogAppend, FollowerRead) {
+  fs::TempDir walRoot("/tmp/follower_read.XXXXXX");
+  std::shared_ptr<thread::GenericThreadPool> workers;
+  std::vector<std::string> wals;
+  std::vector<HostAddr> allHosts;
+  std::vector<std::shared_ptr<RaftexService>> services;
+  std::vector<std::shared_ptr<test::TestShard>> copies;
+
+  std::shared_ptr<test::TestShard> leader;
+  setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+
+  // Check all hosts agree on the same leader
+  checkLeadership(copies, leader);
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 99, leader, msgs);
+  checkConsensus(copies, 0, 99, msgs);
+
+  // Leader serves the reads by itself, the followers are at most 100 logs behind the leader
+  EXPECT_FALSE(leader->followerReadable(100));
+  for (auto& c : copies) {
+    if (c != leader) {
+      EXPECT_TRUE(c->followerReadable(100));
+    }
+  }
+
+  finishRaft(services, copies, workers, leader);
+}
+
 TEST(LogAppend, MultiThreadAppend) {
   fs::TempDir walRoot("/tmp/multi_thread_append.XXXXXX");
   std::shared_ptr<thread::GenericThreadPool> workers;
@@ -131,6 +216,65 @@ TEST(LogAppend, MultiThreadAppend) {
   finishRaft(services, copies, workers, leader);
 }
 
+TEST(LogAppend, PipelinedAppend) {
+  fs::TempDir walRoot("/tmp/pipelined_append.XXXXXX");
+  // Send many small batches, several of them in flight at the same time
+  FLAGS_max_appendlog_batch_size = 8;
+  FLAGS_raft_max_inflight_appendlog_batches = 4;
+  std::shared_ptr<thread::GenericThreadPool> workers;
+  std::vector<std::string> wals;
+  std::vector<HostAddr> allHosts;
+  std::vector<std::shared_ptr<RaftexService>> services;
+  std::vector<std::shared_ptr<test::TestShard>> copies;
+
+  std::shared_ptr<test::TestShard> leader;
+  setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+
+  // Check all hosts agree on the same leader
+  checkLeadership(copies, leader);
+
+  const int numThreads = 4;
+  const int numLogs = 100;
+  FLAGS_max_batch_size = numThreads * numLogs + 1;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back(std::thread([i, leader] {
+      for (int j = 1; j <= numLogs; ++j) {
+        auto fut = leader->appendAsync(0, folly::stringPrintf("Log %03d for t%d", j, i));
+        if (j == numLogs) {
+          // Only wait on the last log message
+          ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, std::move(fut).get());
+        }
+      }
+    }));
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Sleep a while to make sure the last log has been committed on followers
+  sleep(FLAGS_raft_heartbeat_interval_secs);
+
+  for (auto& c : copies) {
+    ASSERT_EQ(numThreads * numLogs, c->getNumLogs());
+  }
+  for (int i = 0; i < numThreads * numLogs; ++i) {
+    folly::StringPiece msg;
+    ASSERT_TRUE(leader->getLogMsg(i, msg));
+    for (auto& c : copies) {
+      if (c != leader) {
+        folly::StringPiece log;
+        ASSERT_TRUE(c->getLogMsg(i, log));
+        ASSERT_EQ(msg, log);
+      }
+    }
+  }
+
+  finishRaft(services, copies, workers, leader);
+  FLAGS_max_appendlog_batch_size = 128;
+  FLAGS_raft_max_inflight_appendlog_batches = 1;
+}
+
 }  // namespace raftex
 }  // namespace nebula
 
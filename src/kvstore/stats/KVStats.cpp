@@ -6,11 +6,14 @@
 #include "kvstore/stats/KVStats.h"
 
 #include "common/base/Base.h"
+#include "common/stats/ContentionStats.h"
 #include "common/stats/StatsManager.h"
 
 namespace nebula {
 
 stats::CounterId kCommitLogLatencyUs;
+stats::CounterId kNumCommitLogs;
+stats::CounterId kCommitLogLagMs;
 stats::CounterId kCommitSnapshotLatencyUs;
 stats::CounterId kAppendWalLatencyUs;
 stats::CounterId kReplicateLogLatencyUs;
@@ -19,10 +22,18 @@ stats::CounterId kTransferLeaderLatencyUs;
 stats::CounterId kNumStartElect;
 stats::CounterId kNumGrantVotes;
 stats::CounterId kNumSendSnapshot;
+std::shared_ptr<stats::LatencyHistogram> kRaftLockWaitUs;
+std::shared_ptr<stats::LatencyHistogram> kRaftLogsLockWaitUs;
+stats::CounterId kLoadPartLatencyMs;
+stats::CounterId kLoadPartsLatencyMs;
+stats::CounterId kScanWalLatencyUs;
 
 void initKVStats() {
   kCommitLogLatencyUs = stats::StatsManager::registerHisto(
       "commit_log_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+  kNumCommitLogs = stats::StatsManager::registerStats("num_commit_logs", "rate, sum");
+  kCommitLogLagMs = stats::StatsManager::registerHisto(
+      "commit_log_lag_ms", 10, 0, 10000, "avg, p75, p95, p99, p999");
   kCommitSnapshotLatencyUs = stats::StatsManager::registerHisto(
       "commit_snapshot_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
   kAppendWalLatencyUs = stats::StatsManager::registerHisto(
@@ -36,6 +47,13 @@ void initKVStats() {
   kNumStartElect = stats::StatsManager::registerStats("num_start_elect", "rate, sum");
   kNumGrantVotes = stats::StatsManager::registerStats("num_grant_votes", "rate, sum");
   kNumSendSnapshot = stats::StatsManager::registerStats("num_send_snapshot", "rate, sum");
+  kRaftLockWaitUs = stats::lockWaitHisto("raft");
+  kRaftLogsLockWaitUs = stats::lockWaitHisto("raft_logs");
+  kLoadPartLatencyMs = stats::StatsManager::registerHisto(
+      "load_part_latency_ms", 100, 0, 60000, "avg, p75, p95, p99, p999");
+  kLoadPartsLatencyMs = stats::StatsManager::registerStats("load_parts_latency_ms", "sum");
+  kScanWalLatencyUs = stats::StatsManager::registerHisto(
+      "scan_wal_latency_us", 1000, 0, 1000000, "avg, p75, p95, p99, p999");
 }
 
 }  // namespace nebula
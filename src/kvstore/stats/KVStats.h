@@ -13,6 +13,9 @@ namespace nebula {
 
 // Raft related stats
 extern stats::CounterId kCommitLogLatencyUs;
+// The logs committed, and the lag from their being appended by the leader to being applied
+extern stats::CounterId kNumCommitLogs;
+extern stats::CounterId kCommitLogLagMs;
 extern stats::CounterId kCommitSnapshotLatencyUs;
 extern stats::CounterId kAppendWalLatencyUs;
 extern stats::CounterId kReplicateLogLatencyUs;
@@ -21,6 +24,13 @@ extern stats::CounterId kTransferLeaderLatencyUs;
 extern stats::CounterId kNumStartElect;
 extern stats::CounterId kNumGrantVotes;
 extern stats::CounterId kNumSendSnapshot;
+// The waits of the contended raft locks on the hot paths
+extern std::shared_ptr<stats::LatencyHistogram> kRaftLockWaitUs;
+extern std::shared_ptr<stats::LatencyHistogram> kRaftLogsLockWaitUs;
+// Startup related stats
+extern stats::CounterId kLoadPartLatencyMs;
+extern stats::CounterId kLoadPartsLatencyMs;
+extern stats::CounterId kScanWalLatencyUs;
 
 void initKVStats();
 
@@ -0,0 +1,92 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/HotPartStats.h"
+
+namespace nebula {
+namespace kvstore {
+
+TEST(HotPartStatsTest, SketchTest) {
+  HotVertexSketch sketch(2);
+  for (int i = 0; i < 100; i++) {
+    sketch.add(1, 1, "hot");
+  }
+  for (int i = 0; i < 50; i++) {
+    sketch.add(1, 2, "warm");
+  }
+  for (int i = 0; i < 1000; i++) {
+    sketch.add(1, 1, folly::to<std::string>("cold", i));
+  }
+  // Only overestimated
+  EXPECT_GE(sketch.estimate(1, 1, "hot"), 100);
+  EXPECT_GE(sketch.estimate(1, 2, "warm"), 50);
+
+  auto top = sketch.topAndDecay(1);
+  ASSERT_EQ(1, top[std::make_pair(1, 1)].size());
+  EXPECT_EQ("hot", top[std::make_pair(1, 1)][0].get_vid());
+  ASSERT_EQ(1, top[std::make_pair(1, 2)].size());
+  EXPECT_EQ("warm", top[std::make_pair(1, 2)][0].get_vid());
+
+  // The counts are halved
+  EXPECT_LT(sketch.estimate(1, 1, "hot"), 100);
+  EXPECT_GE(sketch.estimate(1, 1, "hot"), 50);
+}
+
+TEST(HotPartStatsTest, ReportTest) {
+  FLAGS_hot_vertex_sample_interval = 1;
+  FLAGS_hot_parts_report_num = 1;
+  HotPartStats stats;
+  size_t vIdLen = 8;
+  PartAccessCounters part1, part2;
+  auto snapshots = [&] {
+    return std::vector<std::pair<HotPartStats::PartKey, PartAccessCounters::Snapshot>>{
+        {{1, 1}, part1.snapshot()}, {{1, 2}, part2.snapshot()}};
+  };
+  // Nothing to compare to on the first report
+  EXPECT_TRUE(stats.report(snapshots()).empty());
+
+  for (int i = 0; i < 10; i++) {
+    part1.addRead(1, 100);
+    stats.addKey(1, 1, vIdLen, NebulaKeyUtils::tagKey(vIdLen, 1, "v1", 1));
+  }
+  part1.addWrite(1, 10);
+  part2.addRead(1, 100);
+  stats.addKey(1, 2, vIdLen, NebulaKeyUtils::edgePrefix(vIdLen, 2, "v2"));
+  // The vertex keys are not counted
+  stats.addKey(1, 1, vIdLen, NebulaKeyUtils::vertexKey(vIdLen, 1, "v3"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // Only the hottest part is reported
+  auto parts = stats.report(snapshots());
+  ASSERT_EQ(1, parts.size());
+  EXPECT_EQ(1, parts[0].get_part_id());
+  EXPECT_GT(parts[0].get_read_qps(), parts[0].get_write_qps());
+  EXPECT_GT(parts[0].get_write_qps(), 0);
+  EXPECT_GT(parts[0].get_read_bytes_per_sec(), parts[0].get_write_bytes_per_sec());
+  ASSERT_EQ(1, parts[0].get_hot_vertices().size());
+  EXPECT_EQ(std::string("v1", 2), parts[0].get_hot_vertices()[0].get_vid().substr(0, 2));
+  EXPECT_EQ(vIdLen, parts[0].get_hot_vertices()[0].get_vid().size());
+
+  // The idle parts are not reported
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_TRUE(stats.report(snapshots()).empty());
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/time/WallClock.h"
+#include "kvstore/IOScheduler.h"
+
+DECLARE_int64(background_io_latency_target_us);
+
+namespace nebula {
+namespace kvstore {
+
+TEST(IOSchedulerTest, ShareTest) {
+  FLAGS_background_io_rate_limit = 10;
+  IOScheduler scheduler;
+  scheduler.addDisk("/data1");
+  scheduler.addDisk("/data1/sub");
+  EXPECT_EQ(nullptr, scheduler.diskOf("/data10/nebula/1"));
+  auto* disk = scheduler.diskOf("/data1/nebula/1");
+  ASSERT_NE(nullptr, disk);
+  EXPECT_EQ("/data1", disk->path);
+  EXPECT_EQ("/data1/sub", scheduler.diskOf("/data1/sub/nebula/1")->path);
+
+  // The compaction takes all budget if the others are idle
+  int64_t rate = 10 * 1024 * 1024;
+  auto compaction = static_cast<size_t>(IOClass::kCompaction);
+  auto snapshot = static_cast<size_t>(IOClass::kSnapshot);
+  EXPECT_EQ(rate, disk->classRate[compaction]);
+  auto limiter = scheduler.compactionLimiter("/data1/nebula/1");
+  ASSERT_NE(nullptr, limiter);
+  EXPECT_EQ(rate, limiter->GetBytesPerSecond());
+
+  // Shared by weights once the snapshot is active
+  disk->activeSec[snapshot] = time::WallClock::fastNowInSec();
+  scheduler.share(disk, time::WallClock::fastNowInSec());
+  EXPECT_EQ(rate * 8 / 10, disk->classRate[compaction]);
+  EXPECT_EQ(rate * 2 / 10, disk->classRate[snapshot]);
+  EXPECT_EQ(rate * 8 / 10, limiter->GetBytesPerSecond());
+
+  FLAGS_background_io_rate_limit = 0;
+  EXPECT_EQ(nullptr, scheduler.compactionLimiter("/data1/nebula/1"));
+}
+
+TEST(IOSchedulerTest, AdjustTest) {
+  FLAGS_background_io_rate_limit = 10;
+  FLAGS_background_io_latency_target_us = 0;
+  IOScheduler scheduler;
+  scheduler.addDisk("/data1");
+  auto* disk = scheduler.diskOf("/data1");
+  ASSERT_NE(nullptr, disk);
+
+  // The budget grows back to the limit if the foreground is not slow
+  int64_t rate = 10 * 1024 * 1024;
+  disk->rate = rate / 2;
+  scheduler.adjust();
+  EXPECT_EQ(rate / 2 + rate / 10, disk->rate);
+  for (int i = 0; i < 10; i++) {
+    scheduler.adjust();
+  }
+  EXPECT_EQ(rate, disk->rate);
+  EXPECT_EQ(rate, disk->classRate[static_cast<size_t>(IOClass::kCompaction)]);
+
+  // Nothing is throttled without the limit
+  FLAGS_background_io_rate_limit = 0;
+  auto start = time::WallClock::fastNowInMilliSec();
+  scheduler.consume("/data1/nebula/1", IOClass::kRebuild, rate * 10);
+  EXPECT_LT(time::WallClock::fastNowInMilliSec() - start, 1000);
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
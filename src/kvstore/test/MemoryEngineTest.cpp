@@ -0,0 +1,137 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/FileUtils.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/MemoryEngine.h"
+
+namespace nebula {
+namespace kvstore {
+
+TEST(MemoryEngineTest, SimpleTest) {
+  fs::TempDir rootPath("/tmp/memory_engine_SimpleTest.XXXXXX");
+  auto engine = std::make_unique<MemoryEngine>(1, rootPath.path());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key", "val"));
+  std::string val;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get("key", &val));
+  EXPECT_EQ("val", val);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->remove("key"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get("key", &val));
+}
+
+TEST(MemoryEngineTest, RangeAndPrefixTest) {
+  fs::TempDir rootPath("/tmp/memory_engine_RangeAndPrefixTest.XXXXXX");
+  auto engine = std::make_unique<MemoryEngine>(1, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 10; i < 20; i++) {
+    data.emplace_back(folly::stringPrintf("a_%d", i), folly::stringPrintf("val_%d", i));
+    data.emplace_back(folly::stringPrintf("b_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+  auto checkIter = [](std::unique_ptr<KVIterator> iter,
+                      const std::string& keyPrefix,
+                      int32_t from,
+                      int32_t to) {
+    int32_t num = from;
+    for (; iter->valid(); iter->next()) {
+      EXPECT_EQ(folly::stringPrintf("%s_%d", keyPrefix.c_str(), num), iter->key());
+      EXPECT_EQ(folly::stringPrintf("val_%d", num), iter->val());
+      num++;
+    }
+    EXPECT_EQ(to, num);
+  };
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->range("a_12", "a_15", &iter));
+  checkIter(std::move(iter), "a", 12, 15);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("b_", &iter));
+  checkIter(std::move(iter), "b", 10, 20);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->rangeWithPrefix("a_17", "a_", &iter));
+  checkIter(std::move(iter), "a", 17, 20);
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->removeRange("b_10", "b_15"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("b_", &iter));
+  checkIter(std::move(iter), "b", 15, 20);
+}
+
+TEST(MemoryEngineTest, BatchAndSnapshotTest) {
+  fs::TempDir rootPath("/tmp/memory_engine_BatchAndSnapshotTest.XXXXXX");
+  auto engine = std::make_unique<MemoryEngine>(1, rootPath.path());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_0", "val_0"));
+  auto* snapshot = engine->GetSnapshot();
+
+  auto batch = engine->startBatchWrite();
+  batch->put("key_1", "val_1");
+  batch->put("key_2", "val_2");
+  batch->remove("key_0");
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->commitBatchWrite(std::move(batch), false, false, true));
+
+  // The snapshot sees the keys before the batch
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter, snapshot));
+  ASSERT_TRUE(iter->valid());
+  EXPECT_EQ("key_0", iter->key());
+  iter->next();
+  EXPECT_FALSE(iter->valid());
+  engine->ReleaseSnapshot(snapshot);
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter));
+  std::vector<std::string> keys;
+  for (; iter->valid(); iter->next()) {
+    keys.emplace_back(iter->key().str());
+  }
+  EXPECT_EQ((std::vector<std::string>{"key_1", "key_2"}), keys);
+}
+
+TEST(MemoryEngineTest, PartsTest) {
+  fs::TempDir rootPath("/tmp/memory_engine_PartsTest.XXXXXX");
+  auto engine = std::make_unique<MemoryEngine>(1, rootPath.path());
+  engine->addPart(1, Peers());
+  engine->addPart(2, Peers());
+  EXPECT_EQ(2, engine->totalPartsNum());
+  EXPECT_EQ((std::vector<PartitionID>{1, 2}), engine->allParts());
+  engine->removePart(1);
+  EXPECT_EQ(1, engine->totalPartsNum());
+  EXPECT_EQ((std::vector<PartitionID>{2}), engine->allParts());
+}
+
+TEST(MemoryEngineTest, CheckpointTest) {
+  fs::TempDir rootPath("/tmp/memory_engine_CheckpointTest.XXXXXX");
+  auto engine = std::make_unique<MemoryEngine>(1, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 10; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+  auto checkpointPath = folly::stringPrintf("%s/checkpoint", rootPath.path());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->createCheckpoint(checkpointPath));
+
+  // The checkpoint could be ingested into another engine
+  auto other = std::make_unique<MemoryEngine>(2, rootPath.path());
+  auto file = folly::stringPrintf("%s/data.sst", checkpointPath.c_str());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, other->ingest({file}));
+  for (int32_t i = 0; i < 10; i++) {
+    std::string val;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              other->get(folly::stringPrintf("key_%d", i), &val));
+    EXPECT_EQ(folly::stringPrintf("val_%d", i), val);
+  }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
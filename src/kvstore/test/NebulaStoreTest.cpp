@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/FileUtil.h>
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
@@ -728,6 +729,20 @@ TEST(NebulaStoreTest, CheckpointTest) {
   ASSERT_TRUE(ret.isRightType());
   ret = store->createCheckpoint(2, "test_checkpoint");
   ASSERT_TRUE(ret.isRightType());
+
+  // The manifest of the engine of the part 1 lists the sst flushed by the checkpoint
+  auto engineRet = store->engine(1, 1);
+  ASSERT_TRUE(ok(engineRet));
+  auto dataPath =
+      folly::sformat("{}/checkpoints/test_checkpoint/data", value(engineRet)->getDataRoot());
+  std::string manifest;
+  ASSERT_TRUE(folly::readFile(
+      folly::sformat("{}/{}", dataPath, RocksEngine::kSstManifest).c_str(), manifest));
+  auto files = fs::FileUtils::listAllFilesInDir(dataPath.c_str(), false, "*.sst");
+  ASSERT_FALSE(files.empty());
+  for (const auto& file : files) {
+    EXPECT_NE(std::string::npos, manifest.find(file + " "));
+  }
 }
 
 TEST(NebulaStoreTest, ThreeCopiesCheckpointTest) {
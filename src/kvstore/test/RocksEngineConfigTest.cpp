@@ -208,6 +208,58 @@ TEST(RocksEngineConfigTest, KeyValueSeparationTest) {
   ASSERT_EQ(value, read_value);
 }
 
+TEST(RocksEngineConfigTest, TieredPathsTest) {
+  FLAGS_rocksdb_cold_data_paths = "{\"/data/nvme\":\"/data/hdd\"}";
+  SCOPE_EXIT {
+    FLAGS_rocksdb_cold_data_paths = "{}";
+  };
+  EXPECT_EQ("/data/hdd", coldDataPath("/data/nvme"));
+  EXPECT_EQ("", coldDataPath("/data/ssd"));
+
+  rocksdb::Options options;
+  options.max_bytes_for_level_base = 256;
+  options.max_bytes_for_level_multiplier = 10;
+  FLAGS_rocksdb_hot_levels = 3;
+  initRocksdbTieredPaths(options, "hot", "cold");
+  ASSERT_EQ(2, options.db_paths.size());
+  EXPECT_EQ("hot", options.db_paths[0].path);
+  // L0 is estimated as large as L1
+  EXPECT_EQ(256 + 256 + 2560, options.db_paths[0].target_size);
+  EXPECT_EQ("cold", options.db_paths[1].path);
+}
+
+TEST(RocksEngineConfigTest, SpaceCacheTest) {
+  FLAGS_rocksdb_space_block_cache = "{\"2\":\"4\"}";
+  FLAGS_rocksdb_space_row_cache_num = "{\"2\":\"1000\"}";
+  SCOPE_EXIT {
+    FLAGS_rocksdb_space_block_cache = "{}";
+    FLAGS_rocksdb_space_row_cache_num = "{}";
+  };
+  auto blockCache = [](const rocksdb::Options& options) {
+    return options.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>()->block_cache;
+  };
+
+  rocksdb::Options shared, space, same;
+  ASSERT_TRUE(initRocksdbOptions(shared, 1).ok());
+  ASSERT_TRUE(initRocksdbOptions(space, 2).ok());
+  ASSERT_TRUE(initRocksdbOptions(same, 2).ok());
+  // The engines of space 2 share its own caches
+  EXPECT_NE(blockCache(shared), blockCache(space));
+  EXPECT_EQ(blockCache(space), blockCache(same));
+  EXPECT_EQ(4 * 1024 * 1024, blockCache(space)->GetCapacity());
+  EXPECT_NE(shared.row_cache, space.row_cache);
+  EXPECT_EQ(space.row_cache, same.row_cache);
+  EXPECT_EQ(1000, space.row_cache->GetCapacity());
+
+  FLAGS_rocksdb_space_block_cache = "{\"2\":\"8\"}";
+  updateSpaceCaches();
+  EXPECT_EQ(8 * 1024 * 1024, blockCache(space)->GetCapacity());
+
+  FLAGS_rocksdb_space_block_cache = "{\"2\":\"-1\"}";
+  rocksdb::Options bad;
+  EXPECT_FALSE(initRocksdbOptions(bad, 2).ok());
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
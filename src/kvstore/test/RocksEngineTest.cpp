@@ -9,8 +9,13 @@
 #include <rocksdb/table.h>
 
 #include "common/base/Base.h"
+#include "common/fs/FileUtils.h"
 #include "common/fs/TempDir.h"
+#include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/CompactionFilter.h"
+#include "kvstore/EventListener.h"
+#include "kvstore/PrefetchIter.h"
 #include "kvstore/RocksEngine.h"
 #include "kvstore/RocksEngineConfig.h"
 
@@ -47,6 +52,46 @@ TEST_P(RocksEngineTest, SimpleTest) {
   EXPECT_EQ("val", val);
 }
 
+TEST_P(RocksEngineTest, MultiGetTest) {
+  fs::TempDir rootPath("/tmp/rocksdb_engine_MultiGetTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 10; i += 2) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+  if (flush_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+  }
+
+  // The keys are neither sorted nor all existing
+  std::vector<std::string> keys;
+  for (int32_t i = 9; i >= 0; i--) {
+    keys.emplace_back(folly::stringPrintf("key_%d", i));
+  }
+  std::vector<std::string> values = {"stale"};
+  auto status = engine->multiGet(keys, &values);
+  ASSERT_EQ(keys.size(), status.size());
+  ASSERT_EQ(keys.size(), values.size());
+  for (int32_t i = 9; i >= 0; i--) {
+    auto index = 9 - i;
+    if (i % 2 == 0) {
+      EXPECT_TRUE(status[index].ok());
+      EXPECT_EQ(folly::stringPrintf("val_%d", i), values[index]);
+    } else {
+      EXPECT_EQ(Status::Code::kKeyNotFound, status[index].code());
+      EXPECT_TRUE(values[index].empty());
+    }
+  }
+
+  // The values are visited in place, and only the existing ones
+  std::vector<std::string> visited(keys.size());
+  status = engine->multiGetView(
+      keys, [&](size_t index, folly::StringPiece value) { visited[index] = value.str(); });
+  ASSERT_EQ(keys.size(), status.size());
+  EXPECT_EQ(values, visited);
+}
+
 TEST_P(RocksEngineTest, RangeTest) {
   fs::TempDir rootPath("/tmp/rocksdb_engine_RangeTest.XXXXXX");
   auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
@@ -316,6 +361,46 @@ TEST_P(RocksEngineTest, BackupRestoreTable) {
   EXPECT_EQ(num, 5);
 }
 
+TEST_P(RocksEngineTest, WriteSstFileTest) {
+  if (FLAGS_rocksdb_table_format == "PlainTable") {
+    return;
+  }
+  fs::TempDir rootPath("/tmp/rocksdb_engine_WriteSstFileTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 10; i++) {
+    data.emplace_back(folly::stringPrintf("part_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+  // Only the data in snapshot is written
+  auto snapshot = engine->GetSnapshot();
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("part_10", "val_10"));
+
+  auto file = folly::stringPrintf("%s/part.sst", rootPath.path());
+  auto ret = engine->writeSstFile(file, "part_", snapshot);
+  ASSERT_TRUE(ok(ret));
+  EXPECT_EQ(10, value(ret));
+  auto emptyFile = folly::stringPrintf("%s/empty.sst", rootPath.path());
+  ret = engine->writeSstFile(emptyFile, "tags_", snapshot);
+  ASSERT_TRUE(ok(ret));
+  EXPECT_EQ(0, value(ret));
+  EXPECT_FALSE(fs::FileUtils::exist(emptyFile));
+  engine->ReleaseSnapshot(snapshot);
+
+  fs::TempDir ingestRootPath("/tmp/rocksdb_engine_WriteSstFileIngest.XXXXXX");
+  auto ingestEngine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, ingestRootPath.path());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, ingestEngine->ingest({file}));
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, ingestEngine->prefix("part_", &iter));
+  int num = 0;
+  while (iter->valid()) {
+    EXPECT_EQ(folly::stringPrintf("val_%s", iter->key().subpiece(5).str().c_str()), iter->val());
+    iter->next();
+    num++;
+  }
+  EXPECT_EQ(10, num);
+}
+
 TEST_P(RocksEngineTest, VertexWholeKeyBloomFilterTest) {
   if (FLAGS_rocksdb_table_format == "PlainTable") {
     return;
@@ -557,6 +642,149 @@ TEST_P(RocksEngineTest, PrefixBloomTest) {
   }
 }
 
+TEST_P(RocksEngineTest, EdgeTypePrefixBloomTest) {
+  if (FLAGS_rocksdb_table_format == "PlainTable") {
+    return;
+  }
+  FLAGS_rocksdb_edge_type_prefix_filter_spaces = "1";
+  SCOPE_EXIT {
+    FLAGS_rocksdb_edge_type_prefix_filter_spaces = "";
+  };
+  fs::TempDir rootPath("/tmp/rocksdb_engine_EdgeTypePrefixBloomTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(1, kDefaultVIdLen, rootPath.path());
+
+  std::vector<KV> data;
+  for (EdgeType edgeType = 1; edgeType <= 5; edgeType++) {
+    for (auto dst = 0; dst < 10; dst++) {
+      data.emplace_back(
+          NebulaKeyUtils::edgeKey(kDefaultVIdLen, 1, "1", edgeType, 0, std::to_string(dst)),
+          folly::stringPrintf("val_%d", dst));
+    }
+  }
+  for (auto tagId = 0; tagId < 10; tagId++) {
+    data.emplace_back(NebulaKeyUtils::tagKey(kDefaultVIdLen, 1, "1", tagId),
+                      folly::stringPrintf("val_%d", tagId));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+  if (flush_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+  }
+
+  auto count = [&](const std::string& prefix) {
+    std::unique_ptr<KVIterator> iter;
+    auto code = engine->prefix(prefix, &iter);
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+    int32_t num = 0;
+    while (iter->valid()) {
+      num++;
+      iter->next();
+    }
+    return num;
+  };
+  // The edges of a type, of all the types of a vertex, and the tags of a vertex
+  EXPECT_EQ(10, count(NebulaKeyUtils::edgePrefix(kDefaultVIdLen, 1, "1", 3)));
+  EXPECT_EQ(0, count(NebulaKeyUtils::edgePrefix(kDefaultVIdLen, 1, "1", 6)));
+  EXPECT_EQ(50, count(NebulaKeyUtils::edgePrefix(kDefaultVIdLen, 1, "1")));
+  EXPECT_EQ(50, count(NebulaKeyUtils::edgePrefix(1)));
+  EXPECT_EQ(10, count(NebulaKeyUtils::tagPrefix(kDefaultVIdLen, 1, "1")));
+  EXPECT_EQ(0, count(NebulaKeyUtils::tagPrefix(kDefaultVIdLen, 1, "2")));
+}
+
+TEST_P(RocksEngineTest, SeparatedColumnFamiliesTest) {
+  if (FLAGS_rocksdb_table_format == "PlainTable") {
+    return;
+  }
+  fs::TempDir rootPath("/tmp/rocksdb_engine_SeparatedColumnFamiliesTest.XXXXXX");
+  FLAGS_rocksdb_separate_column_families = true;
+  auto engine = std::make_unique<RocksEngine>(1, kDefaultVIdLen, rootPath.path());
+  PartitionID partId = 1;
+  auto tagKey = NebulaKeyUtils::tagKey(kDefaultVIdLen, partId, "v1", 1);
+  auto vertexKey = NebulaKeyUtils::vertexKey(kDefaultVIdLen, partId, "v1");
+  auto edgeKey1 = NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, "v1", 1, 0, "v2");
+  auto edgeKey2 = NebulaKeyUtils::edgeKey(kDefaultVIdLen, partId, "v2", 1, 0, "v1");
+  auto indexKey = IndexKeyUtils::indexPrefix(partId, 1) + "v1";
+  auto commitKey = NebulaKeyUtils::systemCommitKey(partId);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put(tagKey, "tag"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->multiPut({{vertexKey, "vertex"}, {edgeKey1, "edge1"}}));
+  {
+    auto batch = engine->startBatchWrite();
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, batch->put(edgeKey2, "edge2"));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              engine->commitBatchWrite(std::move(batch), false, false, true));
+  }
+  {
+    // The batch without the column families is routed when committed
+    auto batch = std::make_unique<RocksWriteBatch>();
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, batch->put(indexKey, "index"));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, batch->put(commitKey, "commit"));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              engine->commitBatchWrite(std::move(batch), false, false, true));
+  }
+  if (flush_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+  }
+
+  std::vector<std::string> keys = {tagKey, vertexKey, edgeKey1, edgeKey2, indexKey, commitKey};
+  std::vector<std::string> values;
+  auto status = engine->multiGet(keys, &values);
+  for (const auto& s : status) {
+    EXPECT_TRUE(s.ok());
+  }
+  EXPECT_EQ(
+      (std::vector<std::string>{"tag", "vertex", "edge1", "edge2", "index", "commit"}), values);
+
+  auto collect = [](std::unique_ptr<KVIterator> iter) {
+    std::vector<std::string> ret;
+    for (; iter->valid(); iter->next()) {
+      ret.emplace_back(iter->val().str());
+    }
+    return ret;
+  };
+  auto tagPrefix = NebulaKeyUtils::tagPrefix(partId);
+  auto edgePrefix = NebulaKeyUtils::edgePrefix(partId);
+  auto indexPrefix = IndexKeyUtils::indexPrefix(partId);
+  {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix(edgePrefix, &iter));
+    EXPECT_EQ((std::vector<std::string>{"edge1", "edge2"}), collect(std::move(iter)));
+  }
+  {
+    // The range over the tags and edges merges their column families in the order of keys
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->range(tagPrefix, indexPrefix, &iter));
+    EXPECT_EQ((std::vector<std::string>{"tag", "edge1", "edge2"}), collect(std::move(iter)));
+  }
+  {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->scan(&iter));
+    std::vector<std::string> scanned;
+    for (; iter->valid(); iter->next()) {
+      scanned.emplace_back(iter->key().str());
+    }
+    EXPECT_TRUE(std::is_sorted(scanned.begin(), scanned.end()));
+    for (const auto& key : keys) {
+      EXPECT_NE(scanned.end(), std::find(scanned.begin(), scanned.end(), key));
+    }
+  }
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->removeRange(edgePrefix, indexPrefix));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->compact());
+  EXPECT_TRUE(ok(engine->getProperty("rocksdb.estimate-num-keys")));
+
+  // The layout of an existing instance is kept regardless of the flag
+  engine.reset();
+  FLAGS_rocksdb_separate_column_families = false;
+  engine = std::make_unique<RocksEngine>(1, kDefaultVIdLen, rootPath.path());
+  std::string value;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(indexKey, &value));
+  EXPECT_EQ("index", value);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(tagKey, &value));
+  EXPECT_EQ("tag", value);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get(edgeKey1, &value));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get(edgeKey2, &value));
+}
+
 INSTANTIATE_TEST_SUITE_P(EnablePrefixExtractor_EnableWholeKeyFilter_TableFormat_FlushOrNot,
                          RocksEngineTest,
                          ::testing::Values(std::make_tuple(false, false, "BlockBasedTable", true),
@@ -908,6 +1136,77 @@ TEST(RebuildPrefixBloomFilter, RebuildPrefixBloomFilter) {
   checkNewData();
 }
 
+TEST(WriteStallListenerTest, ConditionTest) {
+  WriteStallListener listener;
+  auto change = [&](const std::string& cf, rocksdb::WriteStallCondition cur) {
+    rocksdb::WriteStallInfo info;
+    info.cf_name = cf;
+    info.condition.cur = cur;
+    listener.OnStallConditionsChanged(info);
+  };
+  EXPECT_EQ(rocksdb::WriteStallCondition::kNormal, listener.condition());
+  change("default", rocksdb::WriteStallCondition::kDelayed);
+  EXPECT_EQ(rocksdb::WriteStallCondition::kDelayed, listener.condition());
+  change("edge", rocksdb::WriteStallCondition::kStopped);
+  EXPECT_EQ(rocksdb::WriteStallCondition::kStopped, listener.condition());
+  // The worst of the column families
+  change("default", rocksdb::WriteStallCondition::kNormal);
+  EXPECT_EQ(rocksdb::WriteStallCondition::kStopped, listener.condition());
+  change("edge", rocksdb::WriteStallCondition::kNormal);
+  EXPECT_EQ(rocksdb::WriteStallCondition::kNormal, listener.condition());
+}
+
+TEST(TtlTablePropertiesTest, ExpiredKeysTest) {
+  rocksdb::TableProperties props;
+  EXPECT_FALSE(TtlTableProperties::parse(props).has_value());
+  props.user_collected_properties[TtlTableProperties::kTtlKeys] = "100";
+  props.user_collected_properties[TtlTableProperties::kMinExpireTime] = "1000";
+  props.user_collected_properties[TtlTableProperties::kMaxExpireTime] = "2000";
+  auto ttl = TtlTableProperties::parse(props);
+  ASSERT_TRUE(ttl.has_value());
+  EXPECT_EQ(100, ttl->ttlKeys);
+  EXPECT_DOUBLE_EQ(0, ttl->expiredKeys(999));
+  EXPECT_DOUBLE_EQ(50, ttl->expiredKeys(1500));
+  EXPECT_DOUBLE_EQ(100, ttl->expiredKeys(2000));
+  EXPECT_DOUBLE_EQ(100, ttl->expiredKeys(3000));
+}
+
+TEST(PrefetchIterTest, PrefixTest) {
+  fs::TempDir rootPath("/tmp/rocksdb_engine_PrefetchIterTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 1000; i < 2000; i++) {
+    data.emplace_back(folly::stringPrintf("a_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  data.emplace_back("b_1000", "val_1000");
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+  // The batches are not aligned with the keys
+  for (size_t batchSize : {1, 7, 1000, 4096}) {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("a_", &iter));
+    PrefetchIter prefetchIter(std::move(iter), batchSize);
+    int32_t num = 1000;
+    for (; prefetchIter.valid(); prefetchIter.next()) {
+      EXPECT_EQ(folly::stringPrintf("a_%d", num), prefetchIter.key());
+      EXPECT_EQ(folly::stringPrintf("val_%d", num), prefetchIter.val());
+      num++;
+    }
+    EXPECT_EQ(2000, num);
+  }
+
+  // Destroyed while a batch is being read
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("a_", &iter));
+  auto prefetchIter = std::make_unique<PrefetchIter>(std::move(iter), 10);
+  EXPECT_TRUE(prefetchIter->valid());
+  prefetchIter.reset();
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("c_", &iter));
+  iter = PrefetchIter::wrap(std::move(iter));
+  EXPECT_FALSE(iter->valid());
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
@@ -34,7 +34,7 @@ LogIterator& AtomicLogBuffer::Iterator::operator++() {
       currIndex_ = 0;
     }
   }
-  DCHECK_LT(currIndex_, kMaxLength);
+  DCHECK_LT(currIndex_, currNode_->length_);
   currRec_ = DCHECK_NOTNULL(currNode_)->rec(currIndex_);
   return *this;
 }
@@ -45,7 +45,7 @@ void AtomicLogBuffer::Iterator::seek(LogID logId) {
     currIndex_ = logId - currNode_->firstLogId_;
     // Since reader is only a snapshot, a possible case is that logId > currNode->firstLogId_,
     // however, the logId we search may not in currNode. (e.g. currNode_ is the latest node,
-    // but currIndex_ >= kMaxLength). In this case, currRec_ will be an invalid one.
+    // but currIndex_ >= length of node). In this case, currRec_ will be an invalid one.
     currRec_ = currNode_->rec(currIndex_);
     valid_ = (currRec_ != nullptr);
   } else {
@@ -53,18 +53,89 @@ void AtomicLogBuffer::Iterator::seek(LogID logId) {
   }
 }
 
+AtomicLogBuffer::AtomicLogBuffer(int32_t capacity, int32_t nodeLength, int32_t poolSize)
+    : capacity_(capacity), nodeLength_(std::max(nodeLength, 1)), poolSize_(poolSize) {
+  Node* pool = nullptr;
+  for (int32_t i = 0; i < poolSize_; i++) {
+    auto* node = new Node(nodeLength_);
+    node->next_ = pool;
+    pool = node;
+  }
+  pool_.store(pool, std::memory_order_relaxed);
+  poolNodes_.store(std::max(poolSize_, 0), std::memory_order_relaxed);
+}
+
 AtomicLogBuffer::~AtomicLogBuffer() {
   auto refs = refs_.load(std::memory_order_acquire);
   CHECK_EQ(0, refs);
-  auto* curr = head_.load(std::memory_order_relaxed);
-  auto* prev = curr;
-  while (curr != nullptr) {
-    curr = curr->next_;
-    delete prev;
-    prev = curr;
+  auto* head = head_.load(std::memory_order_relaxed);
+  auto* pool = pool_.load(std::memory_order_relaxed);
+  for (auto* curr : {head, pool}) {
+    while (curr != nullptr) {
+      auto* del = curr;
+      curr = curr->next_;
+      delete del;
+    }
+  }
+}
+
+Node* AtomicLogBuffer::allocNode(LogID firstLogId) {
+  auto* node = pool_.load(std::memory_order_acquire);
+  // The nodes are only taken by the writer, so node won't be popped by others during the loop
+  while (node != nullptr &&
+         !pool_.compare_exchange_weak(
+             node, node->next_, std::memory_order_acquire, std::memory_order_acquire)) {
+  }
+  if (node == nullptr) {
+    node = new Node(nodeLength_);
+    node->firstLogId_ = firstLogId;
+    return node;
+  }
+  poolNodes_.fetch_sub(1, std::memory_order_relaxed);
+  node->reset(firstLogId);
+  return node;
+}
+
+void AtomicLogBuffer::freeNode(Node* node) {
+  if (poolNodes_.load(std::memory_order_relaxed) >= poolSize_) {
+    delete node;
+    return;
+  }
+  poolNodes_.fetch_add(1, std::memory_order_relaxed);
+  auto* top = pool_.load(std::memory_order_relaxed);
+  do {
+    node->next_ = top;
+  } while (!pool_.compare_exchange_weak(
+      top, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void AtomicLogBuffer::evict(Node* head, int32_t recSize) {
+  if (size_ + recSize <= capacity_) {
+    return;
   }
-  if (prev != nullptr) {
-    delete prev;
+  auto* tail = tail_.load(std::memory_order_relaxed);
+  // todo(doodle): there is a potential problem is that: since Node::isFull
+  // is judged by log count, we can only add new node when previous node
+  // has enough logs. So when tail is equal to head, we need to wait tail is
+  // full, after head moves forward, at then tail can be marked as deleted.
+  // So the log buffer would takes up more memory than its capacity. Since
+  // it does not affect correctness, we could fix it later if necessary.
+  if (tail != head) {
+    // We have more than one nodes in current list.
+    // So we mark the tail to be deleted.
+    bool expected = false;
+    VLOG(5) << "Mark node " << tail->firstLogId_ << " to be deleted!";
+    auto marked =
+        tail->markDeleted_.compare_exchange_strong(expected, true, std::memory_order_relaxed);
+    auto* prev = tail->prev_.load(std::memory_order_relaxed);
+    firstLogId_.store(prev->firstLogId_, std::memory_order_relaxed);
+    // All operations above SHOULD NOT be reordered.
+    tail_.store(tail->prev_, std::memory_order_release);
+    if (marked) {
+      size_.fetch_sub(tail->size_, std::memory_order_relaxed);
+      // dirtyNodes_ changes SHOULD after the tail move.
+      dirtyNodes_.fetch_add(1, std::memory_order_release);
+    }
   }
 }
 
@@ -72,8 +143,11 @@ void AtomicLogBuffer::push(LogID logId, Record&& record) {
   auto* head = head_.load(std::memory_order_relaxed);
   auto recSize = record.size();
   if (head == nullptr || head->isFull() || head->markDeleted_.load(std::memory_order_relaxed)) {
-    auto* newNode = new Node();
-    newNode->firstLogId_ = logId;
+    if (head != nullptr && !head->markDeleted_.load(std::memory_order_relaxed)) {
+      // Keep the size within capacity when the buffer grows by a new node as well
+      evict(head, recSize);
+    }
+    auto* newNode = allocNode(logId);
     newNode->next_ = head;
     newNode->push_back(std::move(record));
     if (head == nullptr || head->markDeleted_.load(std::memory_order_relaxed)) {
@@ -88,32 +162,7 @@ void AtomicLogBuffer::push(LogID logId, Record&& record) {
     head_.store(newNode, std::memory_order_relaxed);
     return;
   }
-  if (size_ + recSize > capacity_) {
-    auto* tail = tail_.load(std::memory_order_relaxed);
-    // todo(doodle): there is a potential problem is that: since Node::isFull
-    // is judged by log count, we can only add new node when previous node
-    // has enough logs. So when tail is equal to head, we need to wait tail is
-    // full, after head moves forward, at then tail can be marked as deleted.
-    // So the log buffer would takes up more memory than its capacity. Since
-    // it does not affect correctness, we could fix it later if necessary.
-    if (tail != head) {
-      // We have more than one nodes in current list.
-      // So we mark the tail to be deleted.
-      bool expected = false;
-      VLOG(5) << "Mark node " << tail->firstLogId_ << " to be deleted!";
-      auto marked =
-          tail->markDeleted_.compare_exchange_strong(expected, true, std::memory_order_relaxed);
-      auto* prev = tail->prev_.load(std::memory_order_relaxed);
-      firstLogId_.store(prev->firstLogId_, std::memory_order_relaxed);
-      // All operations above SHOULD NOT be reordered.
-      tail_.store(tail->prev_, std::memory_order_release);
-      if (marked) {
-        size_.fetch_sub(tail->size_, std::memory_order_relaxed);
-        // dirtyNodes_ changes SHOULD after the tail move.
-        dirtyNodes_.fetch_add(1, std::memory_order_release);
-      }
-    }
-  }
+  evict(head, recSize);
   size_.fetch_add(recSize, std::memory_order_relaxed);
   head->push_back(std::move(record));
 }
@@ -200,7 +249,7 @@ void AtomicLogBuffer::releaseRef() {
         VLOG(5) << "Delete node " << curr->firstLogId_;
         auto* del = curr;
         curr = curr->next_;
-        delete del;
+        freeNode(del);
         dirtyNodes_.fetch_sub(1, std::memory_order_release);
         CHECK_GE(dirtyNodes_, 0);
       }
@@ -6,7 +6,6 @@
 #ifndef WAL_ATOMICLOGBUFFER_H_
 #define WAL_ATOMICLOGBUFFER_H_
 
-#include <folly/lang/Aligned.h>
 #include <gtest/gtest_prod.h>
 
 #include "common/thrift/ThriftTypes.h"
@@ -15,6 +14,7 @@
 namespace nebula {
 namespace wal {
 
+// The default number of records in each node
 constexpr int32_t kMaxLength = 64;
 
 /**
@@ -42,13 +42,31 @@ struct Record {
  * @brief A node contains fix count of wal
  */
 struct Node {
-  Node() = default;
+  explicit Node(int32_t length = kMaxLength) : length_(length), records_(new Record[length]) {}
+
+  /**
+   * @brief Reset the node to reuse it for the logs from firstLogId, no readers could access it
+   *
+   * @param firstLogId The first log id in node
+   */
+  void reset(LogID firstLogId) {
+    auto pos = pos_.load(std::memory_order_relaxed);
+    for (int32_t i = 0; i < pos; i++) {
+      records_[i] = Record();
+    }
+    firstLogId_ = firstLogId;
+    size_ = 0;
+    next_ = nullptr;
+    pos_.store(0, std::memory_order_relaxed);
+    markDeleted_.store(false, std::memory_order_relaxed);
+    prev_.store(nullptr, std::memory_order_relaxed);
+  }
 
   /**
    * @brief Return current node is full or not
    */
   bool isFull() {
-    return pos_.load(std::memory_order_acquire) == kMaxLength;
+    return pos_.load(std::memory_order_acquire) == length_;
   }
 
   /**
@@ -63,7 +81,7 @@ struct Node {
     }
     size_ += rec.size();
     auto pos = pos_.load(std::memory_order_acquire);
-    (*records_)[pos] = std::move(rec);
+    records_[pos] = std::move(rec);
     pos_.fetch_add(1, std::memory_order_release);
     return true;
   }
@@ -75,13 +93,13 @@ struct Node {
    * @return Record* Wal record if exists
    */
   Record* rec(int32_t index) {
-    if (UNLIKELY(index >= kMaxLength)) {
+    if (UNLIKELY(index >= length_)) {
       return nullptr;
     }
     CHECK_GE(index, 0);
     auto pos = pos_.load(std::memory_order_acquire);
     CHECK_LE(index, pos);
-    return &(*records_)[index];
+    return &records_[index];
   }
 
   /**
@@ -96,12 +114,15 @@ struct Node {
   LogID firstLogId_{0};
   // total size for current Node.
   int32_t size_{0};
+  // The next node in list, or the next free node in the pool of AtomicLogBuffer
   Node* next_{nullptr};
 
   /******* readers maybe access the fields below ******************/
 
+  // max count of records in current node.
+  const int32_t length_;
   // We should ensure the records appended happens-before pos_ increment.
-  folly::cacheline_aligned<std::array<Record, kMaxLength>> records_;
+  std::unique_ptr<Record[]> records_;
   // current valid position for the next record.
   std::atomic<int32_t> pos_{0};
   // The field only be accessed when the refs count down to zero
@@ -118,6 +139,7 @@ struct Node {
  */
 class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
   FRIEND_TEST(AtomicLogBufferTest, ResetThenPushExceedLimit);
+  FRIEND_TEST(AtomicLogBufferTest, ReuseNodesTest);
 
  public:
   /**
@@ -247,10 +269,14 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
    *
    * @param capacity Max capacity in bytes, when size exceeds capacity, which would trigger garbage
    * collection
+   * @param nodeLength Max count of records in each node
+   * @param poolSize Count of free nodes kept for reuse, they are allocated at once
    * @return std::shared_ptr<AtomicLogBuffer>
    */
-  static std::shared_ptr<AtomicLogBuffer> instance(int32_t capacity = 8 * 1024 * 1024) {
-    return std::shared_ptr<AtomicLogBuffer>(new AtomicLogBuffer(capacity));
+  static std::shared_ptr<AtomicLogBuffer> instance(int32_t capacity = 8 * 1024 * 1024,
+                                                   int32_t nodeLength = kMaxLength,
+                                                   int32_t poolSize = 0) {
+    return std::shared_ptr<AtomicLogBuffer>(new AtomicLogBuffer(capacity, nodeLength, poolSize));
   }
 
   /**
@@ -279,6 +305,13 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
    */
   void push(LogID logId, Record&& record);
 
+  /**
+   * @brief Return the size in bytes of the records in buffer
+   */
+  int32_t size() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief Return the first log id in buffer
    */
@@ -323,8 +356,34 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
    *
    * @param capacity Max capacity in bytes, when size exceeds capacity, which would trigger garbage
    * collection
+   * @param nodeLength Max count of records in each node
+   * @param poolSize Count of free nodes kept for reuse
+   */
+  AtomicLogBuffer(int32_t capacity, int32_t nodeLength, int32_t poolSize);
+
+  /**
+   * @brief Take a free node from the pool or allocate one, only called by the writer
+   *
+   * @param firstLogId The first log id in node
+   * @return Node*
+   */
+  Node* allocNode(LogID firstLogId);
+
+  /**
+   * @brief Put the node no readers access back to the pool, or delete it if the pool is full
+   *
+   * @param node The node to free
+   */
+  void freeNode(Node* node);
+
+  /**
+   * @brief Mark the tail to be deleted if there is more than one node, so the record could be
+   * pushed within the capacity
+   *
+   * @param head Current head
+   * @param recSize Size of the record to push
    */
-  explicit AtomicLogBuffer(int32_t capacity) : capacity_(capacity) {}
+  void evict(Node* head, int32_t recSize);
 
   /**
    * @brief Find the node which contains the log with given id
@@ -364,6 +423,12 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
   std::atomic<bool> gcOnGoing_{false};
   std::atomic<int32_t> dirtyNodes_{0};
   int32_t dirtyNodesLimit_{5};
+
+  const int32_t nodeLength_{kMaxLength};
+  // The free nodes linked by next_. Only the writer takes nodes from it, so it's safe from ABA.
+  std::atomic<Node*> pool_{nullptr};
+  std::atomic<int32_t> poolNodes_{0};
+  const int32_t poolSize_{0};
 };
 
 }  // namespace wal
@@ -5,6 +5,7 @@
 
 #include "kvstore/wal/FileBasedWal.h"
 
+#include <sys/uio.h>
 #include <utime.h>
 
 #include "common/base/Base.h"
@@ -15,13 +16,31 @@
 DEFINE_int32(wal_ttl, 14400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
 DEFINE_int32(wal_buffer_size, 8 * 1024 * 1024, "Default wal buffer size");
+DEFINE_int32(wal_buffer_node_length, 64, "Count of log messages in each node of wal buffer");
+DEFINE_int32(wal_buffer_node_pool_size, 2, "Count of free nodes kept by wal buffer for reuse");
 DEFINE_bool(wal_sync, false, "Whether fsync needs to be called every write");
+DEFINE_string(wal_compression, "none", "Codec to compress the wal records: none, lz4 or zstd");
 
 namespace nebula {
 namespace wal {
 
 using nebula::fs::FileUtils;
 
+namespace {
+
+// The index of a wal file, which is written when the file is closed
+struct WalIndex {
+  LogID lastId;
+  TermID lastTerm;
+  int64_t size;
+};
+
+std::string walIndexPath(const char* walPath) {
+  return folly::stringPrintf("%s.idx", walPath);
+}
+
+}  // namespace
+
 /**********************************************
  *
  * Implementation of FileBasedWal
@@ -56,7 +75,8 @@ FileBasedWal::FileBasedWal(const folly::StringPiece dir,
     }
   }
 
-  logBuffer_ = AtomicLogBuffer::instance(policy_.bufferSize);
+  logBuffer_ = AtomicLogBuffer::instance(
+      policy_.bufferSize, policy_.bufferNodeLength, policy_.bufferNodePoolSize);
   scanAllWalFiles();
   if (!walFiles_.empty()) {
     firstLogId_ = walFiles_.begin()->second->firstId();
@@ -161,6 +181,7 @@ void FileBasedWal::scanAllWalFiles() {
       close(fd);
       continue;
     }
+    succMsgLen = walMsgLen(succMsgLen);
 
     // Verify the last log length
     if (lseek(fd, -(sizeof(int32_t) * 2 + succMsgLen + sizeof(ClusterID)), SEEK_END) < 0) {
@@ -176,7 +197,7 @@ void FileBasedWal::scanAllWalFiles() {
       close(fd);
       continue;
     }
-    if (precMsgLen != succMsgLen) {
+    if (walMsgLen(precMsgLen) != succMsgLen) {
       LOG(WARNING) << "It seems the wal file \"" << fn << "\" is corrupted. Ignore it";
       // TODO We might want to fix it as much as possible
       close(fd);
@@ -226,10 +247,15 @@ void FileBasedWal::scanAllWalFiles() {
 
   if (!walFiles_.empty()) {
     auto it = walFiles_.rbegin();
-    // Try to scan last wal, if it is invalid or empty, scan the previous one
-    scanLastWal(it->second, it->second->firstId());
+    // The last wal is scanned unless it's closed properly with an index. The index is removed
+    // since the file would be appended again.
+    if (!readWalIndex(it->second)) {
+      // Try to scan last wal, if it is invalid or empty, scan the previous one
+      scanLastWal(it->second, it->second->firstId());
+    }
+    unlink(walIndexPath(it->second->path()).c_str());
     if (it->second->lastId() <= 0) {
-      unlink(it->second->path());
+      removeWalFile(it->second);
       walFiles_.erase(it->first);
     }
   }
@@ -253,7 +279,7 @@ void FileBasedWal::scanAllWalFiles() {
       it = walFiles_.begin();
       while (it->second->firstId() < logIdAfterLastGap) {
         LOG(WARNING) << "Removing the wal file \"" << it->second->path() << "\"";
-        unlink(it->second->path());
+        removeWalFile(it->second);
         it = walFiles_.erase(it);
       }
     }
@@ -267,11 +293,13 @@ void FileBasedWal::closeCurrFile() {
     return;
   }
 
-  if (!policy_.sync) {
+  if (!policy_.sync || unsynced_) {
     if (::fsync(currFd_) == -1) {
       LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
     }
+    unsynced_ = false;
   }
+  writeWalIndex(currInfo_);
 
   // Close the file
   if (::close(currFd_) == -1) {
@@ -289,6 +317,51 @@ void FileBasedWal::closeCurrFile() {
   currInfo_.reset();
 }
 
+void FileBasedWal::writeWalIndex(WalFileInfoPtr info) {
+  if (info->lastId() <= 0) {
+    return;
+  }
+  WalIndex index{info->lastId(), info->lastTerm(), static_cast<int64_t>(info->size())};
+  auto path = walIndexPath(info->path());
+  int32_t fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Failed to open wal index \"" << path << "\", error: " << strerror(errno);
+    return;
+  }
+  if (write(fd, &index, sizeof(WalIndex)) != sizeof(WalIndex)) {
+    LOG(WARNING) << "Failed to write wal index \"" << path << "\", error: " << strerror(errno);
+    close(fd);
+    unlink(path.c_str());
+    return;
+  }
+  close(fd);
+}
+
+bool FileBasedWal::readWalIndex(WalFileInfoPtr info) {
+  auto path = walIndexPath(info->path());
+  int32_t fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  WalIndex index;
+  auto bytes = read(fd, &index, sizeof(WalIndex));
+  close(fd);
+  // The file is appended or truncated after the index is written
+  if (bytes != sizeof(WalIndex) || index.size != static_cast<int64_t>(info->size()) ||
+      index.lastId < info->firstId()) {
+    VLOG(2) << idStr_ << "Ignore the stale wal index \"" << path << "\"";
+    return false;
+  }
+  info->setLastId(index.lastId);
+  info->setLastTerm(index.lastTerm);
+  return true;
+}
+
+void FileBasedWal::removeWalFile(WalFileInfoPtr info) {
+  unlink(info->path());
+  unlink(walIndexPath(info->path()).c_str());
+}
+
 void FileBasedWal::prepareNewFile(LogID startLogId) {
   CHECK_LT(currFd_, 0) << "The current file needs to be closed first";
 
@@ -310,6 +383,8 @@ void FileBasedWal::prepareNewFile(LogID startLogId) {
 
 void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
   auto path = info->path();
+  // The index is stale once the file is truncated
+  unlink(walIndexPath(path).c_str());
   int32_t fd = open(path, O_RDWR);
   if (fd < 0) {
     LOG(FATAL) << "Failed to open file \"" << path << "\" (errno: " << errno
@@ -341,7 +416,8 @@ void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
     }
 
     // Move to the next log
-    pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + 2 * sizeof(int32_t) + len;
+    pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + 2 * sizeof(int32_t) +
+           walMsgLen(len);
 
     if (id == logId) {
       break;
@@ -403,6 +479,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
         sizeof(int32_t)) {
       break;
     }
+    head = walMsgLen(head);
 
     if (pread(fd,
               &foot,
@@ -412,7 +489,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
       break;
     }
 
-    if (head != foot) {
+    if (head != walMsgLen(foot)) {
       LOG(WARNING) << "Message size doesn't match: " << head << " != " << foot;
       break;
     }
@@ -454,22 +531,38 @@ bool FileBasedWal::appendLogInternal(LogID id,
     return false;
   }
 
-  // Write to the WAL file first
-  std::string strBuf;
-  strBuf.reserve(sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + msg.size() +
-                 2 * sizeof(int32_t));
-  strBuf.append(reinterpret_cast<char*>(&id), sizeof(LogID));
-  strBuf.append(reinterpret_cast<char*>(&term), sizeof(TermID));
-  int32_t len = msg.size();
-  strBuf.append(reinterpret_cast<char*>(&len), sizeof(int32_t));
-  strBuf.append(reinterpret_cast<char*>(&cluster), sizeof(ClusterID));
-  strBuf.append(reinterpret_cast<const char*>(msg.data()), msg.size());
-  strBuf.append(reinterpret_cast<char*>(&len), sizeof(int32_t));
+  // The compressed message is marked in its length, the log buffer keeps the uncompressed one
+  auto compressed = compressLog(policy_.compression, msg);
+  auto stored = compressed ? folly::StringPiece(*compressed) : msg;
+  int32_t len = stored.size();
+  if (compressed) {
+    len |= kCompressedMsgFlag;
+  }
+
+  // Write to the WAL file first, the message is written in place by writev rather than being
+  // copied into a buffer with the head and the tail
+  char head[sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID)];
+  char* pos = head;
+  memcpy(pos, &id, sizeof(LogID));
+  pos += sizeof(LogID);
+  memcpy(pos, &term, sizeof(TermID));
+  pos += sizeof(TermID);
+  memcpy(pos, &len, sizeof(int32_t));
+  pos += sizeof(int32_t);
+  memcpy(pos, &cluster, sizeof(ClusterID));
+  struct iovec iov[3];
+  iov[0].iov_base = head;
+  iov[0].iov_len = sizeof(head);
+  iov[1].iov_base = const_cast<char*>(stored.data());
+  iov[1].iov_len = stored.size();
+  iov[2].iov_base = &len;
+  iov[2].iov_len = sizeof(int32_t);
+  ssize_t totalSize = sizeof(head) + stored.size() + sizeof(int32_t);
 
   // Prepare the WAL file if it's not opened
   if (currFd_ < 0) {
     prepareNewFile(id);
-  } else if (currInfo_->size() + strBuf.size() > policy_.fileSize) {
+  } else if (currInfo_->size() + totalSize > policy_.fileSize) {
     // Need to roll over
     closeCurrFile();
 
@@ -477,16 +570,15 @@ bool FileBasedWal::appendLogInternal(LogID id,
     prepareNewFile(id);
   }
 
-  ssize_t bytesWritten = write(currFd_, strBuf.data(), strBuf.size());
-  if (bytesWritten != (ssize_t)strBuf.size()) {
-    LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << strBuf.size()
+  ssize_t bytesWritten = writev(currFd_, iov, 3);
+  if (bytesWritten != totalSize) {
+    LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << totalSize
                << ", error:" << strerror(errno);
   }
 
-  if (policy_.sync && ::fsync(currFd_) == -1) {
-    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
-  }
-  currInfo_->setSize(currInfo_->size() + strBuf.size());
+  // The logs are synced once after all logs of the batch are written, see syncCurrFile
+  unsynced_ = policy_.sync;
+  currInfo_->setSize(currInfo_->size() + totalSize);
   currInfo_->setLastId(id);
   currInfo_->setLastTerm(term);
 
@@ -507,8 +599,10 @@ bool FileBasedWal::appendLog(LogID id, TermID term, ClusterID cluster, std::stri
   }
   if (!appendLogInternal(id, term, cluster, folly::StringPiece(msg))) {
     VLOG(3) << "Failed to append log for logId " << id;
+    syncCurrFile();
     return false;
   }
+  syncCurrFile();
   return true;
 }
 
@@ -520,18 +614,32 @@ bool FileBasedWal::appendLogs(LogIterator& iter) {
   for (; iter.valid(); ++iter) {
     if (!appendLogInternal(iter.logId(), iter.logTerm(), iter.logSource(), iter.logMsg())) {
       VLOG(3) << idStr_ << "Failed to append log for logId " << iter.logId();
+      syncCurrFile();
       return false;
     }
   }
 
+  syncCurrFile();
   return true;
 }
 
+void FileBasedWal::syncCurrFile() {
+  if (!unsynced_ || currFd_ < 0) {
+    return;
+  }
+  if (::fsync(currFd_) == -1) {
+    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
+  }
+  unsynced_ = false;
+}
+
 std::unique_ptr<LogIterator> FileBasedWal::iterator(LogID firstLogId, LogID lastLogId) {
   auto iter = logBuffer_->iterator(firstLogId, lastLogId);
   if (iter->valid()) {
+    bufferHits_.fetch_add(1, std::memory_order_relaxed);
     return iter;
   }
+  bufferMisses_.fetch_add(1, std::memory_order_relaxed);
   return std::make_unique<WalFileIterator>(shared_from_this(), firstLogId, lastLogId);
 }
 
@@ -591,7 +699,7 @@ bool FileBasedWal::rollbackToLog(LogID id) {
       while (it != walFiles_.end()) {
         // Need to remove the file
         VLOG(4) << "Removing file " << it->second->path();
-        unlink(it->second->path());
+        removeWalFile(it->second);
         it = walFiles_.erase(it);
       }
     }
@@ -632,6 +740,9 @@ bool FileBasedWal::reset() {
     VLOG(3) << "Removing " << absFn;
     unlink(absFn.c_str());
   }
+  for (auto& fn : FileUtils::listAllFilesInDir(dir_.c_str(), false, "*.wal.idx")) {
+    unlink(FileUtils::joinPath(dir_, fn).c_str());
+  }
   lastLogId_ = firstLogId_ = 0;
   lastLogTerm_ = 0;
   return true;
@@ -660,7 +771,7 @@ void FileBasedWal::cleanWAL() {
     if (index++ < size - 2 && (now - it->second->mtime() > walTTL)) {
       VLOG(3) << "Clean wals, Remove " << it->second->path() << ", now: " << now
               << ", mtime: " << it->second->mtime();
-      unlink(it->second->path());
+      removeWalFile(it->second);
       it = walFiles_.erase(it);
       count++;
     } else {
@@ -696,7 +807,7 @@ void FileBasedWal::cleanWAL(LogID id) {
   while (iter != walFiles_.end()) {
     if (iter->second->lastId() < id && index < size - 2 && (now - iter->second->mtime() > walTTL)) {
       VLOG(3) << "Clean wals, Remove " << iter->second->path();
-      unlink(iter->second->path());
+      removeWalFile(iter->second);
       iter = walFiles_.erase(iter);
       index++;
     } else {
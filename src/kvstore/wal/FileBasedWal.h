@@ -13,6 +13,7 @@
 #include "common/base/Cord.h"
 #include "kvstore/DiskManager.h"
 #include "kvstore/wal/AtomicLogBuffer.h"
+#include "kvstore/wal/LogCompression.h"
 #include "kvstore/wal/Wal.h"
 #include "kvstore/wal/WalFileInfo.h"
 
@@ -27,8 +28,17 @@ struct FileBasedWalPolicy {
   // Size of each buffer (in byte)
   size_t bufferSize = 8 * 1024L * 1024L;
 
+  // Count of log messages in each node of the buffer
+  int32_t bufferNodeLength = kMaxLength;
+
+  // Count of free nodes kept by the buffer for reuse
+  int32_t bufferNodePoolSize = 0;
+
   // Whether fsync needs to be called every write
   bool sync = false;
+
+  // Codec to compress the log messages in the wal files
+  LogCompression compression = LogCompression::NONE;
 };
 
 struct FileBasedWalInfo {
@@ -183,6 +193,20 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
     return logBuffer_;
   }
 
+  /**
+   * @brief Return how many iterators have been served by the log buffer
+   */
+  int64_t bufferHits() const {
+    return bufferHits_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Return how many iterators have to read the wal files since the logs are not in buffer
+   */
+  int64_t bufferMisses() const {
+    return bufferMisses_.load(std::memory_order_relaxed);
+  }
+
  private:
   /***************************************
    *
@@ -223,6 +247,30 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
    */
   void closeCurrFile();
 
+  /**
+   * @brief Write the index of a closed wal file, which saves the last log id, term and the file
+   * size, so that the file needn't be scanned when the wal is opened next time
+   *
+   * @param info Wal file info
+   */
+  void writeWalIndex(WalFileInfoPtr info);
+
+  /**
+   * @brief Read the index of the wal file, the last log id and term are set if the file size
+   * matches the index
+   *
+   * @param info Wal file info
+   * @return Whether the index is valid
+   */
+  bool readWalIndex(WalFileInfoPtr info);
+
+  /**
+   * @brief Remove the wal file and its index
+   *
+   * @param info Wal file info
+   */
+  void removeWalFile(WalFileInfoPtr info);
+
   /**
    * @brief Prepare a new wal file starting from the given log id
    *
@@ -249,6 +297,12 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
    */
   bool appendLogInternal(LogID id, TermID term, ClusterID cluster, folly::StringPiece msg);
 
+  /**
+   * @brief Sync the logs written into current wal file since the last sync, so the logs of a
+   * batch are synced by one fsync
+   */
+  void syncCurrFile();
+
  private:
   using WalFiles = std::map<LogID, WalFileInfoPtr>;
 
@@ -278,8 +332,12 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
   int32_t currFd_{-1};
   // The WalFileInfo corresponding to the currFd_
   WalFileInfoPtr currInfo_;
+  // Whether some logs written into currFd_ are not synced yet, only if policy_.sync
+  bool unsynced_{false};
 
   std::shared_ptr<AtomicLogBuffer> logBuffer_;
+  std::atomic<int64_t> bufferHits_{0};
+  std::atomic<int64_t> bufferMisses_{0};
 
   PreProcessor preProcessor_;
 
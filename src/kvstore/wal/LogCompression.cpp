@@ -0,0 +1,113 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/wal/LogCompression.h"
+
+#include <folly/compression/Compression.h>
+
+DEFINE_uint32(log_compression_min_size,
+              256,
+              "The raft log messages and snapshot rows shorter than it are not compressed");
+
+namespace nebula {
+namespace wal {
+
+namespace {
+
+folly::io::Codec* codecOf(LogCompression codec) {
+  // Codecs are not thread safe, each thread has its own
+  static thread_local auto lz4 = folly::io::getCodec(folly::io::CodecType::LZ4_VARINT_SIZE);
+  static thread_local auto zstd = folly::io::getCodec(folly::io::CodecType::ZSTD);
+  switch (codec) {
+    case LogCompression::LZ4:
+      return lz4.get();
+    case LogCompression::ZSTD:
+      return zstd.get();
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+LogCompression toLogCompression(const std::string& name) {
+  if (name == "lz4") {
+    return LogCompression::LZ4;
+  } else if (name == "zstd") {
+    return LogCompression::ZSTD;
+  }
+  return LogCompression::NONE;
+}
+
+std::optional<std::string> compressLog(LogCompression codec, folly::StringPiece msg) {
+  auto* c = codecOf(codec);
+  if (c == nullptr || msg.size() < FLAGS_log_compression_min_size) {
+    return std::nullopt;
+  }
+  auto compressed = c->compress(msg);
+  if (compressed.size() + 1 >= msg.size()) {
+    return std::nullopt;
+  }
+  std::string result;
+  result.reserve(compressed.size() + 1);
+  result.push_back(static_cast<char>(codec));
+  result.append(compressed);
+  return result;
+}
+
+std::string uncompressLog(folly::StringPiece compressed) {
+  if (compressed.empty()) {
+    throw std::runtime_error("Empty compressed log");
+  }
+  auto* c = codecOf(static_cast<LogCompression>(compressed[0]));
+  if (c == nullptr) {
+    throw std::runtime_error(
+        folly::stringPrintf("Unknown log compression %d", static_cast<int32_t>(compressed[0])));
+  }
+  compressed.advance(1);
+  return c->uncompress(compressed);
+}
+
+std::optional<std::string> compressRows(LogCompression codec,
+                                        const std::vector<std::string>& rows) {
+  if (codecOf(codec) == nullptr) {
+    return std::nullopt;
+  }
+  // Each row is prefixed by its length
+  std::string packed;
+  size_t size = 0;
+  for (const auto& row : rows) {
+    size += sizeof(uint32_t) + row.size();
+  }
+  packed.reserve(size);
+  for (const auto& row : rows) {
+    uint32_t len = row.size();
+    packed.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
+    packed.append(row);
+  }
+  return compressLog(codec, packed);
+}
+
+std::vector<std::string> uncompressRows(folly::StringPiece compressed) {
+  auto packed = uncompressLog(compressed);
+  std::vector<std::string> rows;
+  folly::StringPiece remain(packed);
+  while (!remain.empty()) {
+    if (remain.size() < sizeof(uint32_t)) {
+      throw std::runtime_error("Corrupted compressed rows");
+    }
+    uint32_t len = *reinterpret_cast<const uint32_t*>(remain.data());
+    remain.advance(sizeof(uint32_t));
+    if (remain.size() < len) {
+      throw std::runtime_error("Corrupted compressed rows");
+    }
+    rows.emplace_back(remain.data(), len);
+    remain.advance(len);
+  }
+  return rows;
+}
+
+}  // namespace wal
+}  // namespace nebula
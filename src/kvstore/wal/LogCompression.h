@@ -0,0 +1,79 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WAL_LOGCOMPRESSION_H_
+#define WAL_LOGCOMPRESSION_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace wal {
+
+/**
+ * @brief Codec of the compressed raft log messages and snapshot rows
+ */
+enum class LogCompression : uint8_t {
+  NONE = 0,
+  LZ4 = 1,
+  ZSTD = 2,
+};
+
+// The bit of the message length in a wal record marking the message is compressed
+constexpr int32_t kCompressedMsgFlag = 0x40000000;
+
+/**
+ * @brief Return the message length in a wal record without the compressed flag
+ */
+inline int32_t walMsgLen(int32_t len) {
+  return len & ~kCompressedMsgFlag;
+}
+
+/**
+ * @brief Parse the codec name of the flags, "lz4", "zstd" or "none"
+ *
+ * @param name Codec name
+ * @return LogCompression NONE if the name is unknown
+ */
+LogCompression toLogCompression(const std::string& name);
+
+/**
+ * @brief Compress the log message, the codec is recorded in the compressed message
+ *
+ * @param codec Codec to use
+ * @param msg Log message
+ * @return std::optional<std::string> The compressed message, or std::nullopt if the codec is NONE,
+ * the message is shorter than log_compression_min_size or not reduced by compression
+ */
+std::optional<std::string> compressLog(LogCompression codec, folly::StringPiece msg);
+
+/**
+ * @brief Uncompress the output of compressLog, throw if it's corrupted
+ *
+ * @param compressed Compressed message
+ * @return std::string The log message
+ */
+std::string uncompressLog(folly::StringPiece compressed);
+
+/**
+ * @brief Pack the rows into one message and compress it
+ *
+ * @param codec Codec to use
+ * @param rows Rows to pack
+ * @return std::optional<std::string> The compressed rows, or std::nullopt same as compressLog
+ */
+std::optional<std::string> compressRows(LogCompression codec, const std::vector<std::string>& rows);
+
+/**
+ * @brief Uncompress the output of compressRows, throw if it's corrupted
+ *
+ * @param compressed Compressed rows
+ * @return std::vector<std::string> The rows
+ */
+std::vector<std::string> uncompressRows(folly::StringPiece compressed);
+
+}  // namespace wal
+}  // namespace nebula
+
+#endif  // WAL_LOGCOMPRESSION_H_
@@ -7,6 +7,7 @@
 
 #include "common/base/Base.h"
 #include "kvstore/wal/FileBasedWal.h"
+#include "kvstore/wal/LogCompression.h"
 #include "kvstore/wal/WalFileInfo.h"
 
 namespace nebula {
@@ -89,6 +90,8 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
         eof_ = true;
         break;
       }
+      currCompressed_ = (currMsgLen_ & kCompressedMsgFlag) != 0;
+      currMsgLen_ = walMsgLen(currMsgLen_);
       if (logId == currId_) {
         break;
       }
@@ -165,6 +168,8 @@ LogIterator& WalFileIterator::operator++() {
         eof_ = true;
         break;
       }
+      currCompressed_ = (currMsgLen_ & kCompressedMsgFlag) != 0;
+      currMsgLen_ = walMsgLen(currMsgLen_);
     } while (false);
   }
 
@@ -210,6 +215,9 @@ folly::StringPiece WalFileIterator::logMsg() const {
            static_cast<ssize_t>(currMsgLen_))
       << "Failed to read. Curr position is " << currPos_ << ", expected read length is "
       << currMsgLen_ << " (errno: " << errno << "): " << strerror(errno);
+  if (currCompressed_) {
+    currLog_ = uncompressLog(currLog_);
+  }
 
   return currLog_;
 }
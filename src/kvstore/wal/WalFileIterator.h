@@ -88,6 +88,8 @@ class WalFileIterator final : public LogIterator {
   std::list<int> fds_;
   int64_t currPos_{0};
   int32_t currMsgLen_{0};
+  // Whether the message of current log is compressed
+  bool currCompressed_{false};
   // Whether we have encounter end of wal file during building iterator or iterating
   bool eof_{false};
   mutable std::string currLog_;
@@ -146,6 +146,22 @@ TEST(AtomicLogBufferTest, ResetThenPushExceedLimit) {
   CHECK(logBuffer->seek(logId) != nullptr);
 }
 
+TEST(AtomicLogBufferTest, ReuseNodesTest) {
+  // Each node saves 16 logs, the capacity could hold the logs of about 2 nodes
+  int32_t nodeLength = 16;
+  int32_t capacity = 24 * nodeLength * 2;
+  auto logBuffer = AtomicLogBuffer::instance(capacity, nodeLength, 2);
+  EXPECT_EQ(2, logBuffer->poolNodes_);
+  for (LogID logId = 0; logId < 1000L; logId++) {
+    logBuffer->push(logId, Record(0, 0, folly::stringPrintf("str_%ld", logId)));
+    EXPECT_GE(capacity, logBuffer->size());
+    // The released reader would trigger gc, which puts the deleted nodes back to pool
+    checkIterator(logBuffer, logBuffer->firstLogId(), logId, logId + 1);
+    EXPECT_GE(2, logBuffer->poolNodes_);
+  }
+  EXPECT_GT(logBuffer->firstLogId(), 0);
+}
+
 }  // namespace wal
 }  // namespace nebula
 
@@ -98,7 +98,7 @@ TEST(FileBasedWal, CacheOverflow) {
   wal.reset();
 
   // Check the number of files
-  auto files = FileUtils::listAllFilesInDir(walDir.path());
+  auto files = FileUtils::listAllFilesInDir(walDir.path(), false, "*.wal");
   ASSERT_EQ(11, files.size());
 
   // Now let's open it to read
@@ -194,6 +194,75 @@ TEST(FileBasedWal, Rollback) {
   EXPECT_EQ(6001, id);
 }
 
+TEST(FileBasedWal, CompressedLogs) {
+  // Small buffer to read most logs from the wal files
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 64L * 1024L;
+  policy.bufferSize = 16L * 1024L;
+  auto msgOf = [](LogID id) {
+    // The short messages are not compressed
+    return id % 2 == 0 ? folly::stringPrintf(kLongMsg, id) : folly::stringPrintf("Log %ld", id);
+  };
+
+  TempDir walDir("/tmp/testWal.XXXXXX");
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  for (int i = 1; i <= 100; i++) {
+    ASSERT_TRUE(wal->appendLog(i /*id*/, 1 /*term*/, 0 /*cluster*/, msgOf(i)));
+  }
+  wal.reset();
+
+  // The uncompressed logs written before are still readable
+  for (auto codec : {LogCompression::LZ4, LogCompression::ZSTD}) {
+    policy.compression = codec;
+    wal = FileBasedWal::getWal(
+        walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+          return true;
+        });
+    auto firstId = wal->lastLogId() + 1;
+    for (LogID i = firstId; i < firstId + 100; i++) {
+      ASSERT_TRUE(wal->appendLog(i /*id*/, 1 /*term*/, 0 /*cluster*/, msgOf(i)));
+    }
+    wal.reset();
+  }
+
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  ASSERT_EQ(300, wal->lastLogId());
+  wal->rollbackToLog(250);
+  ASSERT_EQ(250, wal->lastLogId());
+  wal.reset();
+
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  ASSERT_EQ(250, wal->lastLogId());
+  auto it = wal->iterator(1, 250);
+  LogID id = 1;
+  while (it->valid()) {
+    ASSERT_EQ(id, it->logId());
+    ASSERT_EQ(msgOf(id), it->logMsg());
+    ++(*it);
+    ++id;
+  }
+  EXPECT_EQ(251, id);
+
+  std::vector<std::string> rows;
+  for (int i = 0; i < 10; i++) {
+    rows.emplace_back(msgOf(i));
+  }
+  auto compressed = compressRows(LogCompression::LZ4, rows);
+  ASSERT_TRUE(compressed.has_value());
+  EXPECT_EQ(rows, uncompressRows(*compressed));
+  EXPECT_FALSE(compressRows(LogCompression::NONE, rows).has_value());
+}
+
 TEST(FileBasedWal, RollbackThenReopen) {
   // Force to make each file 1MB, each buffer is 1MB, and there are two
   // buffers at most
@@ -223,7 +292,7 @@ TEST(FileBasedWal, RollbackThenReopen) {
   wal.reset();
 
   // Check the number of files
-  auto files = FileUtils::listAllFilesInDir(walDir.path());
+  auto files = FileUtils::listAllFilesInDir(walDir.path(), false, "*.wal");
   ASSERT_EQ(1, files.size());
 
   // Now let's open it to read
@@ -245,6 +314,55 @@ TEST(FileBasedWal, RollbackThenReopen) {
   EXPECT_EQ(801, id);
 }
 
+TEST(FileBasedWal, ReopenByIndex) {
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 1024L * 1024L;
+  policy.bufferSize = 1024L * 1024L;
+
+  TempDir walDir("/tmp/testWal.XXXXXX");
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  for (int i = 1; i <= 1500; i++) {
+    ASSERT_TRUE(wal->appendLog(i, i / 100, 0, folly::stringPrintf(kLongMsg, i)));
+  }
+  // Each closed wal file has an index
+  wal.reset();
+  ASSERT_EQ(2, FileUtils::listAllFilesInDir(walDir.path(), false, "*.wal").size());
+  ASSERT_EQ(2, FileUtils::listAllFilesInDir(walDir.path(), false, "*.wal.idx").size());
+
+  // The last wal is not scanned but recovered from the index, which is removed once it's opened
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(1500, wal->lastLogId());
+  EXPECT_EQ(15, wal->lastLogTerm());
+  EXPECT_EQ(1, FileUtils::listAllFilesInDir(walDir.path(), false, "*.wal.idx").size());
+  ASSERT_TRUE(wal->appendLog(1501, 15, 0, folly::stringPrintf(kLongMsg, 1501)));
+
+  // Rollback removes the index of the files changed
+  wal->rollbackToLog(800);
+  wal.reset();
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(800, wal->lastLogId());
+  EXPECT_EQ(8, wal->lastLogTerm());
+  auto it = wal->iterator(1, 800);
+  LogID id = 1;
+  while (it->valid()) {
+    ASSERT_EQ(id, it->logId());
+    ASSERT_EQ(folly::stringPrintf(kLongMsg, id), it->logMsg());
+    ++(*it);
+    ++id;
+  }
+  EXPECT_EQ(801, id);
+}
+
 TEST(FileBasedWal, RollbackToZero) {
   // Force to make each file 1MB, each buffer is 1MB, and there are two
   // buffers at most
@@ -55,7 +55,7 @@ void runInMemoryLogBufferWriteTest(size_t iters, int32_t len) {
   }
 }
 
-void runAtomicLogBufferWriteTest(size_t iters, int32_t len) {
+void runAtomicLogBufferWriteTest(size_t iters, int32_t len, int32_t nodeLength = kMaxLength) {
   std::shared_ptr<AtomicLogBuffer> logBuffer;
   std::vector<Record> recs;
   BENCHMARK_SUSPEND {
@@ -63,7 +63,7 @@ void runAtomicLogBufferWriteTest(size_t iters, int32_t len) {
     for (size_t i = 0; i < iters; i++) {
       recs.emplace_back(0, 0, std::string(len, 'A'));
     }
-    logBuffer = AtomicLogBuffer::instance();
+    logBuffer = AtomicLogBuffer::instance(8 * 1024 * 1024, nodeLength);
   }
   for (size_t i = 0; i < iters; i++) {
     logBuffer->push(i, std::move(recs[i]));
@@ -107,6 +107,10 @@ BENCHMARK_RELATIVE(AtomicLogBufferWritePush2Short, iters) {
   runAtomicLogBufferWriteTestPush2(iters, 16);
 }
 
+BENCHMARK_RELATIVE(AtomicLogBufferWriteLargeNodeShort, iters) {
+  runAtomicLogBufferWriteTest(iters, 16, 256);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(InMemoryLogBufferWriteMiddle, iters) {
@@ -120,6 +124,10 @@ BENCHMARK_RELATIVE(AtomicLogBufferWriteMiddle, iters) {
 BENCHMARK_RELATIVE(AtomicLogBufferWritePush2Middle, iters) {
   runAtomicLogBufferWriteTestPush2(iters, 128);
 }
+
+BENCHMARK_RELATIVE(AtomicLogBufferWriteLargeNodeMiddle, iters) {
+  runAtomicLogBufferWriteTest(iters, 128, 256);
+}
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(InMemoryLogBufferWriteLong, iters) {
@@ -133,6 +141,10 @@ BENCHMARK_RELATIVE(AtomicLogBufferWriteLong, iters) {
 BENCHMARK_RELATIVE(AtomicLogBufferWritePush2Long, iters) {
   runAtomicLogBufferWriteTestPush2(iters, 1024);
 }
+
+BENCHMARK_RELATIVE(AtomicLogBufferWriteLargeNodeLong, iters) {
+  runAtomicLogBufferWriteTest(iters, 1024, 256);
+}
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(InMemoryLogBufferWriteVeryLong, iters) {
@@ -146,6 +158,10 @@ BENCHMARK_RELATIVE(AtomicLogBufferWriteVeryLong, iters) {
 BENCHMARK_RELATIVE(AtomicLogBufferWritePush2VeryLong, iters) {
   runAtomicLogBufferWriteTestPush2(iters, 4096);
 }
+
+BENCHMARK_RELATIVE(AtomicLogBufferWriteLargeNodeVeryLong, iters) {
+  runAtomicLogBufferWriteTest(iters, 4096, 256);
+}
 BENCHMARK_DRAW_LINE();
 
 #endif
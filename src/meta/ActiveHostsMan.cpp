@@ -5,6 +5,7 @@
 
 #include "meta/ActiveHostsMan.h"
 
+#include <folly/synchronization/Baton.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include "common/utils/Utils.h"
@@ -13,6 +14,14 @@
 DECLARE_int32(heartbeat_interval_secs);
 DEFINE_int32(agent_heartbeat_interval_secs, 60, "Agent heartbeat interval in seconds");
 DECLARE_uint32(expired_time_factor);
+DEFINE_int32(meta_change_log_retention_secs,
+             3600,
+             "How long the spaces changed are logged, by which the clients reload the spaces "
+             "changed only. The clients not loading the meta data for longer reload all");
+DEFINE_int64(meta_follower_read_max_lag,
+             0,
+             "max count of committed logs a metad follower could fall behind the leader to serve "
+             "the reads of the meta data loaded by the clients");
 
 namespace nebula {
 namespace meta {
@@ -24,13 +33,17 @@ nebula::cpp2::ErrorCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
                                                        const AllLeaders* allLeaders) {
   CHECK_NOTNULL(kv);
   std::vector<std::string> leaderKeys;
+  std::vector<GraphSpaceID> leaderSpaces;
   std::vector<int64_t> terms;
+  // The spaces whose leaders are changed, the terms of their parts are reloaded by the clients
+  std::unordered_set<GraphSpaceID> changedSpaces;
   if (allLeaders != nullptr) {
     for (auto& spaceLeaders : *allLeaders) {
       auto spaceId = spaceLeaders.first;
       for (auto& partLeader : spaceLeaders.second) {
         auto key = MetaKeyUtils::leaderKey(spaceId, partLeader.get_part_id());
         leaderKeys.emplace_back(std::move(key));
+        leaderSpaces.emplace_back(spaceId);
         terms.emplace_back(partLeader.get_term());
       }
     }
@@ -58,6 +71,7 @@ nebula::cpp2::ErrorCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
       // write directly if not exist, or update if has greater term
       auto val = MetaKeyUtils::leaderValV3(hostAddr, terms[i]);
       data.emplace_back(std::make_pair(leaderKeys[i], std::move(val)));
+      changedSpaces.emplace(leaderSpaces[i]);
     }
   }
   // indicate whether any leader info is updated
@@ -65,8 +79,10 @@ nebula::cpp2::ErrorCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
   data.emplace_back(MetaKeyUtils::hostKey(hostAddr.host, hostAddr.port), HostInfo::encodeV2(info));
 
   if (hasUpdate) {
+    // The disk parts are not loaded by the clients, so they are not logged as the spaces changed
     auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-    LastUpdateTimeMan::update(data, timeInMilliSec);
+    std::vector<GraphSpaceID> spaces(changedSpaces.begin(), changedSpaces.end());
+    LastUpdateTimeMan::update(data, timeInMilliSec, spaces);
   }
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
@@ -239,6 +255,63 @@ ErrorOr<nebula::cpp2::ErrorCode, bool> ActiveHostsMan::isLived(kvstore::KVStore*
   return std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end();
 }
 
+ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::HotPartItem>> ActiveHostsMan::getHotParts(
+    kvstore::KVStore* kv, GraphSpaceID spaceId) {
+  auto activeHostsRet = getActiveHosts(kv);
+  if (!nebula::ok(activeHostsRet)) {
+    return nebula::error(activeHostsRet);
+  }
+  auto activeHosts = nebula::value(activeHostsRet);
+
+  const auto& prefix = MetaKeyUtils::hotPartsPrefix();
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto retCode = kv->prefix(kDefaultSpaceId, kDefaultPartId, prefix, &iter);
+  if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    LOG(INFO) << "Failed to get hot parts, error " << apache::thrift::util::enumNameSafe(retCode);
+    return retCode;
+  }
+
+  std::vector<cpp2::HotPartItem> items;
+  while (iter->valid()) {
+    // The parts of the hosts offline are stale
+    auto host = MetaKeyUtils::parseHotPartsKey(iter->key());
+    if (std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end()) {
+      auto hotParts = MetaKeyUtils::parseHotPartsVal(iter->val());
+      for (auto& hotness : *hotParts.parts_ref()) {
+        if (hotness.get_space_id() != spaceId) {
+          continue;
+        }
+        cpp2::HotPartItem item;
+        item.host_ref() = host;
+        item.hotness_ref() = std::move(hotness);
+        items.emplace_back(std::move(item));
+      }
+    }
+    iter->next();
+  }
+  std::sort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs) {
+    const auto& l = lhs.get_hotness();
+    const auto& r = rhs.get_hotness();
+    return l.get_read_qps() + l.get_write_qps() > r.get_read_qps() + r.get_write_qps();
+  });
+  return items;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::unordered_map<PartitionID, double>>
+ActiveHostsMan::getHotPartsQps(kvstore::KVStore* kv, GraphSpaceID spaceId) {
+  auto ret = getHotParts(kv, spaceId);
+  if (!nebula::ok(ret)) {
+    return nebula::error(ret);
+  }
+  std::unordered_map<PartitionID, double> partsQps;
+  for (const auto& item : nebula::value(ret)) {
+    const auto& hotness = item.get_hotness();
+    auto& qps = partsQps[hotness.get_part_id()];
+    qps = std::max(qps, hotness.get_read_qps() + hotness.get_write_qps());
+  }
+  return partsQps;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, HostInfo> ActiveHostsMan::getHostInfo(kvstore::KVStore* kv,
                                                                        const HostAddr& host) {
   auto machineKey = MetaKeyUtils::machineKey(host.host, host.port);
@@ -262,13 +335,96 @@ ErrorOr<nebula::cpp2::ErrorCode, HostInfo> ActiveHostsMan::getHostInfo(kvstore::
 }
 
 void LastUpdateTimeMan::update(std::vector<kvstore::KV>& data, const int64_t timeInMilliSec) {
+  update(data, timeInMilliSec, {kAllSpaces});
+}
+
+void LastUpdateTimeMan::update(kvstore::BatchHolder* batchHolder, const int64_t timeInMilliSec) {
+  update(batchHolder, timeInMilliSec, {kAllSpaces});
+}
+
+void LastUpdateTimeMan::update(std::vector<kvstore::KV>& data,
+                               const int64_t timeInMilliSec,
+                               const std::vector<GraphSpaceID>& spaces) {
   data.emplace_back(MetaKeyUtils::lastUpdateTimeKey(),
                     MetaKeyUtils::lastUpdateTimeVal(timeInMilliSec));
+  for (auto spaceId : spaces) {
+    data.emplace_back(MetaKeyUtils::metaChangeKey(timeInMilliSec, spaceId), "");
+  }
 }
 
-void LastUpdateTimeMan::update(kvstore::BatchHolder* batchHolder, const int64_t timeInMilliSec) {
+void LastUpdateTimeMan::update(kvstore::BatchHolder* batchHolder,
+                               const int64_t timeInMilliSec,
+                               const std::vector<GraphSpaceID>& spaces) {
   batchHolder->put(MetaKeyUtils::lastUpdateTimeKey(),
                    MetaKeyUtils::lastUpdateTimeVal(timeInMilliSec));
+  for (auto spaceId : spaces) {
+    batchHolder->put(MetaKeyUtils::metaChangeKey(timeInMilliSec, spaceId), "");
+  }
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::optional<std::vector<GraphSpaceID>>>
+LastUpdateTimeMan::changedSpaces(kvstore::KVStore* kv, int64_t sinceMs) {
+  std::string val;
+  auto code = kv->get(kDefaultSpaceId, kDefaultPartId, MetaKeyUtils::metaChangesCoverKey(), &val);
+  if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    // Not pruned yet, the changes before the upgrade are not logged
+    return std::optional<std::vector<GraphSpaceID>>();
+  } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto coverMs = *reinterpret_cast<const int64_t*>(val.data());
+  if (sinceMs < coverMs) {
+    return std::optional<std::vector<GraphSpaceID>>();
+  }
+
+  const auto& prefix = MetaKeyUtils::metaChangePrefix();
+  auto start = MetaKeyUtils::metaChangeStartKey(sinceMs);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  code = kv->rangeWithPrefix(kDefaultSpaceId, kDefaultPartId, start, prefix, &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  std::unordered_set<GraphSpaceID> spaces;
+  for (; iter->valid(); iter->next()) {
+    auto spaceId = MetaKeyUtils::parseMetaChangeKey(iter->key()).second;
+    if (spaceId == kAllSpaces) {
+      return std::optional<std::vector<GraphSpaceID>>();
+    }
+    spaces.emplace(spaceId);
+  }
+  return std::make_optional<std::vector<GraphSpaceID>>(spaces.begin(), spaces.end());
+}
+
+nebula::cpp2::ErrorCode LastUpdateTimeMan::pruneChanges(kvstore::KVStore* kv, int64_t nowMs) {
+  std::string val;
+  auto code = kv->get(kDefaultSpaceId, kDefaultPartId, MetaKeyUtils::metaChangesCoverKey(), &val);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+      code != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return code;
+  }
+  // The changes are logged from now on if none was pruned before
+  int64_t coverMs = nowMs;
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    coverMs = nowMs - FLAGS_meta_change_log_retention_secs * 1000L;
+    if (coverMs <= *reinterpret_cast<const int64_t*>(val.data())) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+  }
+
+  auto batchHolder = std::make_unique<kvstore::BatchHolder>();
+  batchHolder->rangeRemove(std::string(MetaKeyUtils::metaChangePrefix()),
+                           MetaKeyUtils::metaChangeStartKey(coverMs));
+  batchHolder->put(std::string(MetaKeyUtils::metaChangesCoverKey()),
+                   std::string(reinterpret_cast<const char*>(&coverMs), sizeof(int64_t)));
+  auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
+  folly::Baton<true, std::atomic> baton;
+  kv->asyncAppendBatch(
+      kDefaultSpaceId, kDefaultPartId, std::move(batch), [&](nebula::cpp2::ErrorCode ret) {
+        code = ret;
+        baton.post();
+      });
+  baton.wait();
+  return code;
 }
 
 }  // namespace meta
@@ -196,6 +196,28 @@ class ActiveHostsMan final {
    */
   static ErrorOr<nebula::cpp2::ErrorCode, bool> isLived(kvstore::KVStore* kv, const HostAddr& host);
 
+  /**
+   * @brief Get the hottest parts of the space reported by the active storage hosts in the
+   * heartbeats, a part is listed once for each host reporting it
+   *
+   * @param kv From where to get
+   * @param spaceId Id of the space
+   * @return The parts sorted by the sum of the read and the write qps, the hottest first
+   */
+  static ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::HotPartItem>> getHotParts(
+      kvstore::KVStore* kv, GraphSpaceID spaceId);
+
+  /**
+   * @brief Get the qps of the hot parts of the space, i.e. the max sum of the read and the write
+   * qps reported by the hosts of a part, which is mostly reported by its leader
+   *
+   * @param kv From where to get
+   * @param spaceId Id of the space
+   * @return Part id => qps, the parts not reported are not hot
+   */
+  static ErrorOr<nebula::cpp2::ErrorCode, std::unordered_map<PartitionID, double>> getHotPartsQps(
+      kvstore::KVStore* kv, GraphSpaceID spaceId);
+
   /**
    * @brief Get hostInfo for a host
    *
@@ -210,14 +232,50 @@ class ActiveHostsMan final {
   ActiveHostsMan() = default;
 };
 
+/**
+ * @brief The last update time of the meta data, bumped by each change and polled by the clients
+ * in the heartbeats. Each bump also logs the spaces changed, so the clients reload only the spaces
+ * changed since the time they loaded, besides the meta data not of a space.
+ */
 class LastUpdateTimeMan final {
  public:
+  // The change which might affect all the spaces, e.g. a balance
+  static constexpr GraphSpaceID kAllSpaces = -1;
+
   ~LastUpdateTimeMan() = default;
 
+  // Bump the last update time, taking all the spaces as changed
   static void update(std::vector<kvstore::KV>& data, const int64_t timeInMilliSec);
 
   static void update(kvstore::BatchHolder* batchHolder, const int64_t timeInMilliSec);
 
+  // Bump the last update time with only the spaces changed, none if only the meta data not of a
+  // space is changed, e.g. the users
+  static void update(std::vector<kvstore::KV>& data,
+                     const int64_t timeInMilliSec,
+                     const std::vector<GraphSpaceID>& spaces);
+
+  static void update(kvstore::BatchHolder* batchHolder,
+                     const int64_t timeInMilliSec,
+                     const std::vector<GraphSpaceID>& spaces);
+
+  /**
+   * @brief The spaces changed at or after the time
+   *
+   * @param kv From where to get
+   * @param sinceMs The last update time loaded by the client
+   * @return None if the changes since the time are not all logged or any change is of all the
+   * spaces, then the client reloads all
+   */
+  static ErrorOr<nebula::cpp2::ErrorCode, std::optional<std::vector<GraphSpaceID>>> changedSpaces(
+      kvstore::KVStore* kv, int64_t sinceMs);
+
+  /**
+   * @brief Drop the changes logged before FLAGS_meta_change_log_retention_secs, the clients which
+   * loaded the meta data earlier than them reload all
+   */
+  static nebula::cpp2::ErrorCode pruneChanges(kvstore::KVStore* kv, int64_t nowMs);
+
  protected:
   LastUpdateTimeMan() = default;
 };
@@ -46,6 +46,7 @@
 #include "meta/processors/parts/GetPartsAllocProcessor.h"
 #include "meta/processors/parts/GetSpaceProcessor.h"
 #include "meta/processors/parts/ListHostsProcessor.h"
+#include "meta/processors/parts/ListHotPartsProcessor.h"
 #include "meta/processors/parts/ListPartsProcessor.h"
 #include "meta/processors/parts/ListSpacesProcessor.h"
 #include "meta/processors/schema/AlterEdgeProcessor.h"
@@ -115,6 +116,7 @@ folly::Future<cpp2::ExecResp> MetaServiceHandler::future_clearSpace(
 folly::Future<cpp2::ListSpacesResp> MetaServiceHandler::future_listSpaces(
     const cpp2::ListSpacesReq& req) {
   auto* processor = ListSpacesProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -133,6 +135,7 @@ folly::Future<cpp2::ExecResp> MetaServiceHandler::future_reportTaskFinish(
 folly::Future<cpp2::GetSpaceResp> MetaServiceHandler::future_getSpace(
     const cpp2::GetSpaceReq& req) {
   auto* processor = GetSpaceProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -158,9 +161,16 @@ folly::Future<cpp2::ListPartsResp> MetaServiceHandler::future_listParts(
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::ListHotPartsResp> MetaServiceHandler::future_listHotParts(
+    const cpp2::ListHotPartsReq& req) {
+  auto* processor = ListHotPartsProcessor::instance(kvstore_);
+  RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::GetPartsAllocResp> MetaServiceHandler::future_getPartsAlloc(
     const cpp2::GetPartsAllocReq& req) {
   auto* processor = GetPartsAllocProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -187,6 +197,7 @@ folly::Future<cpp2::GetTagResp> MetaServiceHandler::future_getTag(const cpp2::Ge
 folly::Future<cpp2::ListTagsResp> MetaServiceHandler::future_listTags(
     const cpp2::ListTagsReq& req) {
   auto* processor = ListTagsProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -214,6 +225,7 @@ folly::Future<cpp2::GetEdgeResp> MetaServiceHandler::future_getEdge(const cpp2::
 folly::Future<cpp2::ListEdgesResp> MetaServiceHandler::future_listEdges(
     const cpp2::ListEdgesReq& req) {
   auto* processor = ListEdgesProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -238,6 +250,7 @@ folly::Future<cpp2::GetTagIndexResp> MetaServiceHandler::future_getTagIndex(
 folly::Future<cpp2::ListTagIndexesResp> MetaServiceHandler::future_listTagIndexes(
     const cpp2::ListTagIndexesReq& req) {
   auto* processor = ListTagIndexesProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -268,6 +281,7 @@ folly::Future<cpp2::GetEdgeIndexResp> MetaServiceHandler::future_getEdgeIndex(
 folly::Future<cpp2::ListEdgeIndexesResp> MetaServiceHandler::future_listEdgeIndexes(
     const cpp2::ListEdgeIndexesReq& req) {
   auto* processor = ListEdgeIndexesProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -354,6 +368,7 @@ folly::Future<cpp2::ExecResp> MetaServiceHandler::future_revokeRole(
 folly::Future<cpp2::ListUsersResp> MetaServiceHandler::future_listUsers(
     const cpp2::ListUsersReq& req) {
   auto* processor = ListUsersProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
@@ -372,6 +387,7 @@ folly::Future<cpp2::ExecResp> MetaServiceHandler::future_changePassword(
 folly::Future<cpp2::ListRolesResp> MetaServiceHandler::future_getUserRoles(
     const cpp2::GetUserRolesReq& req) {
   auto* processor = GetUserRolesProcessor::instance(kvstore_);
+  processor->allowFollowerRead();
   RETURN_FUTURE(processor);
 }
 
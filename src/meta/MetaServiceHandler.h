@@ -56,6 +56,9 @@ class MetaServiceHandler final : public cpp2::MetaServiceSvIf {
 
   folly::Future<cpp2::ListPartsResp> future_listParts(const cpp2::ListPartsReq& req) override;
 
+  folly::Future<cpp2::ListHotPartsResp> future_listHotParts(
+      const cpp2::ListHotPartsReq& req) override;
+
   folly::Future<cpp2::GetPartsAllocResp> future_getPartsAlloc(
       const cpp2::GetPartsAllocReq& req) override;
 
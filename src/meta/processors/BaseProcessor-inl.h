@@ -7,11 +7,19 @@
 #define META_PROCESSORS_BASEPROCESSOR_INL_H
 
 #include "interface/gen-cpp2/storage_types.h"
+#include "kvstore/Part.h"
 #include "meta/processors/BaseProcessor.h"
 
 namespace nebula {
 namespace meta {
 
+template <typename RESP>
+void BaseProcessor<RESP>::allowFollowerRead() {
+  auto part = kvstore_->part(kDefaultSpaceId, kDefaultPartId);
+  followerRead_ = nebula::ok(part) &&
+                  nebula::value(part)->followerReadable(FLAGS_meta_follower_read_max_lag);
+}
+
 template <typename RESP>
 nebula::cpp2::ErrorCode BaseProcessor<RESP>::doSyncPut(std::vector<kvstore::KV> data) {
   folly::Baton<true, std::atomic> baton;
@@ -34,7 +42,8 @@ template <typename RESP>
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<kvstore::KVIterator>>
 BaseProcessor<RESP>::doPrefix(const std::string& key, bool canReadFromFollower) {
   std::unique_ptr<kvstore::KVIterator> iter;
-  auto code = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId, key, &iter, canReadFromFollower);
+  auto code = kvstore_->prefix(
+      kDefaultSpaceId, kDefaultPartId, key, &iter, canReadFromFollower || followerRead_);
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "Prefix Failed";
     return code;
@@ -45,7 +54,7 @@ BaseProcessor<RESP>::doPrefix(const std::string& key, bool canReadFromFollower)
 template <typename RESP>
 ErrorOr<nebula::cpp2::ErrorCode, std::string> BaseProcessor<RESP>::doGet(const std::string& key) {
   std::string value;
-  auto code = kvstore_->get(kDefaultSpaceId, kDefaultPartId, key, &value);
+  auto code = kvstore_->get(kDefaultSpaceId, kDefaultPartId, key, &value, followerRead_);
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "Get Failed";
     return code;
@@ -57,7 +66,7 @@ template <typename RESP>
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>> BaseProcessor<RESP>::doMultiGet(
     const std::vector<std::string>& keys) {
   std::vector<std::string> values;
-  auto ret = kvstore_->multiGet(kDefaultSpaceId, kDefaultPartId, keys, &values);
+  auto ret = kvstore_->multiGet(kDefaultSpaceId, kDefaultPartId, keys, &values, followerRead_);
   auto code = ret.first;
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "MultiGet Failed";
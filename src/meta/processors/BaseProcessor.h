@@ -22,6 +22,8 @@
 #include "meta/MetaServiceUtils.h"
 #include "meta/processors/Common.h"
 
+DECLARE_int64(meta_follower_read_max_lag);
+
 namespace nebula {
 namespace meta {
 
@@ -53,6 +55,14 @@ class BaseProcessor {
     return promise_.getFuture();
   }
 
+  /**
+   * @brief Read the local data if this metad is a follower, which got a message from the leader
+   *        within the heartbeat interval, i.e. the lease of the leader it follows is not expired,
+   *        and is within meta_follower_read_max_lag logs behind it. Otherwise it's read on the
+   *        leader only. It's called for the read-only processors before process.
+   */
+  void allowFollowerRead();
+
  protected:
   /**
    * @brief Destroy current instance when finished.
@@ -470,6 +480,8 @@ class BaseProcessor {
   RESP resp_;
   folly::Promise<RESP> promise_;
   time::Duration duration_;
+  // Whether the reads are served by the local data of a follower
+  bool followerRead_{false};
 
   static const int32_t maxIndexLimit = 16;
 };
@@ -16,6 +16,9 @@ namespace meta {
 HBCounters kHBCounters;
 
 std::atomic<int64_t> HBProcessor::metaVersion_ = -1;
+std::atomic<int64_t> HBProcessor::lastPruneTimeMs_ = 0;
+HBProcessor::Batch HBProcessor::pending_;
+bool HBProcessor::flushing_ = false;
 
 void HBProcessor::onFinished() {
   if (counters_) {
@@ -83,6 +86,15 @@ void HBProcessor::process(const cpp2::HBReq& req) {
     return;
   }
 
+  // The hottest parts since the last heartbeat replace the ones reported before. They are added
+  // after the host info, as they are not the meta changes to bump the last update time for
+  if (role == cpp2::HostRole::STORAGE && req.hot_parts_ref().has_value()) {
+    cpp2::HostHotParts hotParts;
+    hotParts.report_time_ms_ref() = time::WallClock::fastNowInMilliSec();
+    hotParts.parts_ref() = *req.hot_parts_ref();
+    data.emplace_back(MetaKeyUtils::hotPartsKey(host), MetaKeyUtils::hotPartsVal(hotParts));
+  }
+
   // update host dir info
   if (role == cpp2::HostRole::STORAGE || role == cpp2::HostRole::GRAPH) {
     if (req.dir_ref().has_value()) {
@@ -102,6 +114,13 @@ void HBProcessor::process(const cpp2::HBReq& req) {
     auto val = nebula::value(lastUpdateTimeRet);
     int64_t time = *reinterpret_cast<const int64_t*>(val.data());
     resp_.last_update_time_in_ms_ref() = time;
+    auto loadedTime = req.last_update_time_in_ms_ref();
+    if (loadedTime.has_value() && *loadedTime != time) {
+      auto changedRet = LastUpdateTimeMan::changedSpaces(kvstore_, *loadedTime);
+      if (nebula::ok(changedRet) && nebula::value(changedRet).has_value()) {
+        resp_.changed_spaces_ref() = std::move(*nebula::value(changedRet));
+      }
+    }
   } else if (nebula::error(lastUpdateTimeRet) == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
     resp_.last_update_time_in_ms_ref() = 0;
   }
@@ -117,9 +136,84 @@ void HBProcessor::process(const cpp2::HBReq& req) {
   }
 
   resp_.meta_version_ref() = metaVersion_.load();
-  ret = doSyncPut(std::move(data));
-  handleErrorCode(ret);
-  onFinished();
+  auto now = time::WallClock::fastNowInMilliSec();
+  if (now - lastPruneTimeMs_.load() >= kPruneIntervalMs) {
+    lastPruneTimeMs_ = now;
+    auto code = LastUpdateTimeMan::pruneChanges(kvstore_, now);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << "Prune the meta changes failed, " << apache::thrift::util::enumNameSafe(code);
+    }
+  }
+
+  // The heartbeats prepared while a batch is being written are written by the next batch at once,
+  // by the heartbeat which finds none is being written
+  pending_.processors.emplace_back(this);
+  std::move(data.begin(), data.end(), std::back_inserter(pending_.data));
+  if (flushing_) {
+    return;
+  }
+  flushing_ = true;
+  holder.unlock();
+  flush();
+}
+
+void HBProcessor::flush() {
+  while (true) {
+    Batch batch;
+    nebula::cpp2::ErrorCode code;
+    {
+      // The lock is held until the batch is written, so the heartbeats of the next batch read
+      // the leader terms written by this one
+      folly::SharedMutex::WriteHolder holder(LockUtils::lock());
+      if (pending_.processors.empty()) {
+        flushing_ = false;
+        return;
+      }
+      std::swap(batch, pending_);
+      auto data = batch.processors.size() > 1 ? mergeLeaders(std::move(batch.data))
+                                              : std::move(batch.data);
+      code = batch.processors.front()->doSyncPut(std::move(data));
+    }
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << "Write " << batch.processors.size() << " heartbeats failed, "
+                << apache::thrift::util::enumNameSafe(code);
+    }
+    for (auto* processor : batch.processors) {
+      processor->handleErrorCode(code);
+      processor->onFinished();
+    }
+  }
+}
+
+std::vector<kvstore::KV> HBProcessor::mergeLeaders(std::vector<kvstore::KV> data) {
+  // The heartbeats of a batch compare their leaders with the same terms read, so a part reported
+  // by several of them is kept with the greatest term only
+  const auto& prefix = MetaKeyUtils::leaderPrefix();
+  std::unordered_map<std::string, std::pair<size_t, int64_t>> leaders;
+  std::vector<bool> dropped(data.size(), false);
+  for (size_t i = 0; i < data.size(); i++) {
+    if (!folly::StringPiece(data[i].first).startsWith(prefix)) {
+      continue;
+    }
+    auto term = std::get<1>(MetaKeyUtils::parseLeaderValV3(data[i].second));
+    auto found = leaders.find(data[i].first);
+    if (found == leaders.end()) {
+      leaders.emplace(data[i].first, std::make_pair(i, term));
+    } else if (term > found->second.second) {
+      dropped[found->second.first] = true;
+      found->second = std::make_pair(i, term);
+    } else {
+      dropped[i] = true;
+    }
+  }
+  std::vector<kvstore::KV> merged;
+  merged.reserve(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    if (!dropped[i]) {
+      merged.emplace_back(std::move(data[i]));
+    }
+  }
+  return merged;
 }
 
 void HBProcessor::setLeaderInfo() {
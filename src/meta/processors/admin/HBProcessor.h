@@ -38,6 +38,7 @@ extern HBCounters kHBCounters;
  */
 class HBProcessor : public BaseProcessor<cpp2::HBResp> {
   FRIEND_TEST(HBProcessorTest, HBTest);
+  FRIEND_TEST(HBProcessorTest, MergeLeadersTest);
   FRIEND_TEST(MetaClientTest, HeartbeatTest);
 
   using Base = BaseProcessor<cpp2::HBResp>;
@@ -60,9 +61,27 @@ class HBProcessor : public BaseProcessor<cpp2::HBResp> {
 
   void setLeaderInfo();
 
+  // The heartbeats prepared but not written yet, and the data they write
+  struct Batch {
+    std::vector<HBProcessor*> processors;
+    std::vector<kvstore::KV> data;
+  };
+
+  // Write the pending heartbeats batch by batch, until there are none
+  static void flush();
+
+  // Keep the leader of each part with the greatest term in the data of a batch
+  static std::vector<kvstore::KV> mergeLeaders(std::vector<kvstore::KV> data);
+
   ClusterID clusterId_{0};
   const HBCounters* counters_{nullptr};
   static std::atomic<int64_t> metaVersion_;
+  // The meta changes logged are pruned once a minute by the heartbeats
+  static constexpr int64_t kPruneIntervalMs = 60 * 1000;
+  static std::atomic<int64_t> lastPruneTimeMs_;
+  // Guarded by the write lock of LockUtils
+  static Batch pending_;
+  static bool flushing_;
 };
 
 }  // namespace meta
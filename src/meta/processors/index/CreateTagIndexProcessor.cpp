@@ -6,6 +6,7 @@
 #include "meta/processors/index/CreateTagIndexProcessor.h"
 
 #include "common/base/CommonMacro.h"
+#include "common/utils/IndexKeyUtils.h"
 
 namespace nebula {
 namespace meta {
@@ -144,20 +145,40 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
       onFinished();
       return;
     }
-    // Add checks for list and set types that cannot be indexed
-    if (col.type.get_type() == nebula::cpp2::PropertyType::LIST_STRING ||
-        col.type.get_type() == nebula::cpp2::PropertyType::LIST_INT ||
-        col.type.get_type() == nebula::cpp2::PropertyType::LIST_FLOAT ||
-        col.type.get_type() == nebula::cpp2::PropertyType::SET_STRING ||
-        col.type.get_type() == nebula::cpp2::PropertyType::SET_INT ||
-        col.type.get_type() == nebula::cpp2::PropertyType::SET_FLOAT) {
-      LOG(INFO) << "Field " << field.get_name() << " in Tag " << tagName
-                << " is of a list or set type that cannot be indexed.";
-      handleErrorCode(nebula::cpp2::ErrorCode::E_INVALID_PARM);
-      onFinished();
-      return;
-    }
-    if (col.type.get_type() == nebula::cpp2::PropertyType::FIXED_STRING) {
+    if (IndexKeyUtils::isElementIndexColumn(col.type.get_type())) {
+      // A list or set column is indexed by its elements, one key for each element
+      if (fields.size() > 1) {
+        LOG(INFO) << "Only support to create index on a single list or set column currently : "
+                  << field.get_name();
+        handleErrorCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED);
+        onFinished();
+        return;
+      }
+      if (col.type.get_type() == nebula::cpp2::PropertyType::LIST_STRING ||
+          col.type.get_type() == nebula::cpp2::PropertyType::SET_STRING) {
+        if (!field.type_length_ref().has_value()) {
+          LOG(INFO) << "No type length set : " << field.get_name();
+          handleErrorCode(nebula::cpp2::ErrorCode::E_INVALID_PARM);
+          onFinished();
+          return;
+        }
+        if (*field.get_type_length() > MAX_INDEX_TYPE_LENGTH ||
+            *field.get_type_length() <= 0) {
+          LOG(INFO) << "Unsupported index type length " << *field.get_type_length() << " : "
+                    << field.get_name();
+          handleErrorCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED);
+          onFinished();
+          return;
+        }
+        // Keep the collection type, the length is the one of each string element
+        col.type.type_length_ref() = *field.get_type_length();
+      } else if (field.type_length_ref().has_value()) {
+        LOG(INFO) << "No need to set type length : " << field.get_name();
+        handleErrorCode(nebula::cpp2::ErrorCode::E_INVALID_PARM);
+        onFinished();
+        return;
+      }
+    } else if (col.type.get_type() == nebula::cpp2::PropertyType::FIXED_STRING) {
       if (field.get_type_length() != nullptr) {
         LOG(INFO) << "Length should not be specified of fixed_string index :" << field.get_name();
         handleErrorCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED);
@@ -232,7 +253,7 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
   LOG(INFO) << "Create Tag Index " << indexName << ", tagIndex " << tagIndex;
   resp_.id_ref() = to(tagIndex, EntryType::INDEX);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {space});
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
@@ -66,7 +66,7 @@ void DropEdgeIndexProcessor::process(const cpp2::DropEdgeIndexReq& req) {
   resp_.id_ref() = to(edgeIndexID, EntryType::INDEX);
 
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {spaceID});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
@@ -67,7 +67,7 @@ void DropTagIndexProcessor::process(const cpp2::DropTagIndexReq& req) {
   resp_.id_ref() = to(tagIndexID, EntryType::INDEX);
 
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {spaceID});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
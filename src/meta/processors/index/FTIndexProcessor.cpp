@@ -140,7 +140,7 @@ void CreateFTIndexProcessor::process(const cpp2::CreateFTIndexReq& req) {
   std::vector<kvstore::KV> data;
   data.emplace_back(MetaKeyUtils::fulltextIndexKey(name), MetaKeyUtils::fulltextIndexVal(index));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {});
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
@@ -203,7 +203,7 @@ void DropFTIndexProcessor::process(const cpp2::DropFTIndexReq& req) {
   auto batchHolder = std::make_unique<kvstore::BatchHolder>();
   batchHolder->remove(std::move(indexKey));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
@@ -15,6 +15,34 @@ CompactJobExecutor::CompactJobExecutor(GraphSpaceID space,
                                        const std::vector<std::string>& paras)
     : SimpleConcurrentJobExecutor(space, jobId, kvstore, adminClient, paras) {}
 
+nebula::cpp2::ErrorCode CompactJobExecutor::check() {
+  if (paras_.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (paras_.size() != 1) {
+    return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+  }
+  folly::StringPiece para(paras_.front());
+  if (para.removePrefix("parts=")) {
+    std::vector<folly::StringPiece> parts;
+    folly::split(',', para, parts, true);
+    for (auto part : parts) {
+      if (!folly::tryTo<PartitionID>(part).hasValue()) {
+        return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+      }
+    }
+    return parts.empty() ? nebula::cpp2::ErrorCode::E_INVALID_JOB
+                         : nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (para.removePrefix("expired_ratio=")) {
+    auto ratio = folly::tryTo<double>(para);
+    if (ratio.hasValue() && ratio.value() > 0 && ratio.value() <= 1) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+  }
+  return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+}
+
 folly::Future<Status> CompactJobExecutor::executeInternal(HostAddr&& address,
                                                           std::vector<PartitionID>&& parts) {
   folly::Promise<Status> pro;
@@ -25,7 +53,7 @@ folly::Future<Status> CompactJobExecutor::executeInternal(HostAddr&& address,
                 taskId_++,
                 space_,
                 std::move(address),
-                {},
+                paras_,
                 std::move(parts))
       .then([pro = std::move(pro)](auto&& t) mutable {
         CHECK(!t.hasException());
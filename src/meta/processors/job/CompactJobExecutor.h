@@ -22,6 +22,14 @@ class CompactJobExecutor : public SimpleConcurrentJobExecutor {
                      AdminClient* adminClient,
                      const std::vector<std::string>& params);
 
+  /**
+   * @brief The paras are empty, or one of "parts=<part ids separated by comma>" and
+   * "expired_ratio=<ratio in (0, 1]>", which are passed to the compact tasks
+   *
+   * @return
+   */
+  nebula::cpp2::ErrorCode check() override;
+
   /**
    * @brief
    *
@@ -11,6 +11,21 @@
 
 #include "common/utils/MetaKeyUtils.h"
 #include "kvstore/NebulaStore.h"
+#include "meta/ActiveHostsMan.h"
+
+DEFINE_bool(balance_data_by_hotness,
+            true,
+            "Whether to move the hottest parts of the hosts with more parts than the average "
+            "first when balancing the data, by the hot parts reported");
+DEFINE_int32(balance_data_hotness_max_swaps,
+             0,
+             "The max number of the parts swapped between the hottest and the coolest hosts of a "
+             "zone after the part counts are balanced, each swap moves the data of two parts, "
+             "0 to disable");
+DEFINE_double(balance_data_hotness_deviation,
+              0.2,
+              "The parts are swapped while the qps of the parts of the hottest host of a zone is "
+              "more than avg * (1 + deviation)");
 
 namespace nebula {
 namespace meta {
@@ -102,8 +117,22 @@ Status DataBalanceJobExecutor::buildBalancePlan() {
     }
   }
   lostZoneHost.clear();
+  // The hottest part of a host is moved first, which takes the most load off it
+  auto partsQps = hotPartsQps();
+  auto partToMove = [&partsQps](const Host* host) {
+    PartitionID partId = *(host->parts_.begin());
+    double maxQps = 0;
+    for (auto part : host->parts_) {
+      auto iter = partsQps.find(part);
+      if (iter != partsQps.end() && iter->second > maxQps) {
+        partId = part;
+        maxQps = iter->second;
+      }
+    }
+    return partId;
+  };
   // rebalance for hosts in a zone
-  auto balanceHostVec = [this, &existTasks](std::vector<Host*>& hostVec) {
+  auto balanceHostVec = [this, &existTasks, &partToMove](std::vector<Host*>& hostVec) {
     size_t totalPartNum = 0;
     size_t avgPartNum = 0;
     for (Host* h : hostVec) {
@@ -142,7 +171,7 @@ Status DataBalanceJobExecutor::buildBalancePlan() {
         right++;
         continue;
       }
-      PartitionID partId = *(srcHost->parts_.begin());
+      PartitionID partId = partToMove(srcHost);
       hostVec[leftBegin]->parts_.insert(partId);
       srcHost->parts_.erase(partId);
       insertOneTask(BalanceTask(jobId_,
@@ -169,9 +198,95 @@ Status DataBalanceJobExecutor::buildBalancePlan() {
       }
     }
   };
+  // Swap a hot part of the hottest host and a cold part of the coolest host of a zone, which keeps
+  // the part counts. Moving a part copies all its data, so the swaps are limited, and the leaders
+  // are expected to be balanced by hotness in the first place.
+  auto swapHotParts = [this, &existTasks, &partsQps](std::vector<Host*>& hostVec) {
+    if (partsQps.empty() || hostVec.size() < 2) {
+      return;
+    }
+    auto qpsOf = [&partsQps](PartitionID partId) {
+      auto iter = partsQps.find(partId);
+      return iter == partsQps.end() ? 0.0 : iter->second;
+    };
+    std::unordered_map<Host*, double> loads;
+    double totalLoad = 0;
+    for (Host* h : hostVec) {
+      for (auto partId : h->parts_) {
+        loads[h] += qpsOf(partId);
+      }
+      totalLoad += loads[h];
+    }
+    auto expectedMax = totalLoad / hostVec.size() * (1 + FLAGS_balance_data_hotness_deviation);
+    auto movable = [&existTasks](PartitionID partId) {
+      auto iter = existTasks.find(partId);
+      return iter == existTasks.end() || iter->second.empty();
+    };
+    for (int32_t swaps = 0; swaps < FLAGS_balance_data_hotness_max_swaps; swaps++) {
+      auto [coolest, hottest] = std::minmax_element(
+          loads.begin(), loads.end(), [](const auto& l, const auto& r) {
+            return l.second < r.second;
+          });
+      Host* src = hottest->first;
+      Host* dst = coolest->first;
+      auto srcLoad = hottest->second;
+      auto dstLoad = coolest->second;
+      if (srcLoad <= expectedMax) {
+        break;
+      }
+      auto bestLoad = srcLoad;
+      std::optional<std::pair<PartitionID, PartitionID>> best;
+      for (auto hot : src->parts_) {
+        auto hotQps = qpsOf(hot);
+        if (hotQps <= 0 || !movable(hot)) {
+          continue;
+        }
+        for (auto cold : dst->parts_) {
+          auto coldQps = qpsOf(cold);
+          if (coldQps >= hotQps || !movable(cold)) {
+            continue;
+          }
+          auto load = std::max(srcLoad - hotQps + coldQps, dstLoad + hotQps - coldQps);
+          if (load < bestLoad) {
+            bestLoad = load;
+            best.emplace(hot, cold);
+          }
+        }
+      }
+      if (!best.has_value()) {
+        break;
+      }
+      auto [hot, cold] = *best;
+      LOG(INFO) << "Swap the hot part " << hot << " of " << src->host_ << " and the part " << cold
+                << " of " << dst->host_;
+      src->parts_.erase(hot);
+      dst->parts_.insert(hot);
+      dst->parts_.erase(cold);
+      src->parts_.insert(cold);
+      loads[src] += qpsOf(cold) - qpsOf(hot);
+      loads[dst] += qpsOf(hot) - qpsOf(cold);
+      insertOneTask(BalanceTask(jobId_,
+                                spaceInfo_.spaceId_,
+                                hot,
+                                src->host_,
+                                dst->host_,
+                                kvstore_,
+                                adminClient_),
+                    &existTasks);
+      insertOneTask(BalanceTask(jobId_,
+                                spaceInfo_.spaceId_,
+                                cold,
+                                dst->host_,
+                                src->host_,
+                                kvstore_,
+                                adminClient_),
+                    &existTasks);
+    }
+  };
   for (auto& pair : activeSortedHost) {
     std::vector<Host*>& hvec = pair.second;
     balanceHostVec(hvec);
+    swapHotParts(hvec);
   }
   bool empty = std::find_if(existTasks.begin(),
                             existTasks.end(),
@@ -218,5 +333,19 @@ nebula::cpp2::ErrorCode DataBalanceJobExecutor::prepare() {
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+std::unordered_map<PartitionID, double> DataBalanceJobExecutor::hotPartsQps() {
+  std::unordered_map<PartitionID, double> partsQps;
+  if (!FLAGS_balance_data_by_hotness) {
+    return partsQps;
+  }
+  auto ret = ActiveHostsMan::getHotPartsQps(kvstore_, spaceInfo_.spaceId_);
+  if (!nebula::ok(ret)) {
+    LOG(INFO) << "Get hot parts failed, balance without them, error "
+              << apache::thrift::util::enumNameSafe(nebula::error(ret));
+    return partsQps;
+  }
+  return std::move(nebula::value(ret));
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -59,6 +59,14 @@ class DataBalanceJobExecutor : public BalanceJobExecutor {
   Status buildBalancePlan() override;
 
  private:
+  /**
+   * @brief The qps of the parts of the space reported hot by the storage hosts, the hottest replica
+   * of a part is counted. Empty if FLAGS_balance_data_by_hotness is off.
+   *
+   * @return
+   */
+  std::unordered_map<PartitionID, double> hotPartsQps();
+
   std::vector<HostAddr> lostHosts_;
   JobDescription jobDescription_;
 };
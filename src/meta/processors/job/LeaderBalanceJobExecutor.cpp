@@ -9,11 +9,20 @@
 
 #include "common/utils/MetaKeyUtils.h"
 #include "kvstore/NebulaStore.h"
+#include "meta/ActiveHostsMan.h"
 
 DEFINE_double(leader_balance_deviation,
               0.05,
               "after leader balance, leader count should in range "
               "[avg * (1 - deviation), avg * (1 + deviation)]");
+DEFINE_bool(leader_balance_by_hotness,
+            false,
+            "Whether to transfer the leaders of the hot parts off the hottest hosts after the "
+            "leader counts are balanced, by the qps of the hot parts reported");
+DEFINE_double(leader_balance_hotness_deviation,
+              0.2,
+              "after leader balance by hotness, the qps of the leaders of a host should be at "
+              "most avg * (1 + deviation) if possible");
 
 namespace nebula {
 namespace meta {
@@ -431,9 +440,131 @@ ErrorOr<nebula::cpp2::ErrorCode, bool> LeaderBalanceJobExecutor::buildLeaderBala
       break;
     }
   }
+
+  if (FLAGS_leader_balance_by_hotness) {
+    auto qpsRet = ActiveHostsMan::getHotPartsQps(kvstore_, spaceId);
+    if (nebula::ok(qpsRet)) {
+      auto taskCount = balanceLeadersByHotness(
+          leaderHostParts, peersMap, activeHosts, nebula::value(qpsRet), plan, spaceId);
+      LOG(INFO) << "Transfer " << taskCount << " leaders of space " << spaceId << " by hotness";
+    } else {
+      LOG(INFO) << "Get hot parts failed, balance leaders without them, error "
+                << apache::thrift::util::enumNameSafe(nebula::error(qpsRet));
+    }
+  }
   return true;
 }
 
+int32_t LeaderBalanceJobExecutor::balanceLeadersByHotness(
+    HostParts& leaderHostParts,
+    PartAllocation& peersMap,
+    const std::unordered_set<HostAddr>& activeHosts,
+    const std::unordered_map<PartitionID, double>& partsQps,
+    LeaderBalancePlan& plan,
+    GraphSpaceID spaceId) {
+  if (partsQps.empty() || activeHosts.size() < 2) {
+    return 0;
+  }
+  auto qpsOf = [&partsQps](PartitionID partId) {
+    auto iter = partsQps.find(partId);
+    return iter == partsQps.end() ? 0.0 : iter->second;
+  };
+  std::unordered_map<HostAddr, double> loads;
+  double totalLoad = 0;
+  for (const auto& host : activeHosts) {
+    auto& load = loads[host];
+    for (auto partId : leaderHostParts[host]) {
+      load += qpsOf(partId);
+    }
+    totalLoad += load;
+  }
+  auto expectedMax = totalLoad / activeHosts.size() * (1 + FLAGS_leader_balance_hotness_deviation);
+
+  // The parts transferred by count are not transferred again, or their transfers would merge into
+  // one from a host to itself
+  std::unordered_set<PartitionID> transferred;
+  for (const auto& task : plan) {
+    transferred.emplace(std::get<1>(task));
+  }
+  auto transfer = [&](PartitionID partId, const HostAddr& source, const HostAddr& target) {
+    auto& sourceLeaders = leaderHostParts[source];
+    sourceLeaders.erase(std::find(sourceLeaders.begin(), sourceLeaders.end(), partId));
+    leaderHostParts[target].emplace_back(partId);
+    loads[source] -= qpsOf(partId);
+    loads[target] += qpsOf(partId);
+    transferred.emplace(partId);
+    plan.emplace_back(spaceId, partId, source, target);
+  };
+
+  int32_t taskCount = 0;
+  // Each round lowers the loads of the hottest host, and a part is transferred at most once
+  while (true) {
+    auto hottest = std::max_element(loads.begin(), loads.end(), [](const auto& l, const auto& r) {
+      return l.second < r.second;
+    });
+    auto source = hottest->first;
+    auto sourceLoad = hottest->second;
+    if (sourceLoad <= expectedMax) {
+      break;
+    }
+    // The transfer making the max load of the source and the target the lowest
+    auto bestLoad = sourceLoad;
+    std::optional<std::tuple<PartitionID, HostAddr, std::optional<PartitionID>>> best;
+    const auto& sourceLeaders = leaderHostParts[source];
+    auto sourceCount = static_cast<int32_t>(sourceLeaders.size());
+    for (auto partId : sourceLeaders) {
+      auto qps = qpsOf(partId);
+      if (qps <= 0 || transferred.count(partId) != 0) {
+        continue;
+      }
+      for (const auto& target : peersMap[partId]) {
+        if (target == source || activeHosts.count(target) == 0) {
+          continue;
+        }
+        const auto& targetLeaders = leaderHostParts[target];
+        auto targetCount = static_cast<int32_t>(targetLeaders.size());
+        auto targetLoad = loads[target];
+        if (sourceCount > hostBounds_[source].first && targetCount < hostBounds_[target].second) {
+          auto load = std::max(sourceLoad - qps, targetLoad + qps);
+          if (load < bestLoad) {
+            bestLoad = load;
+            best.emplace(partId, target, std::nullopt);
+          }
+        }
+        // Swap with a colder leader of the target, which the source is a peer of
+        for (auto other : targetLeaders) {
+          auto otherQps = qpsOf(other);
+          if (otherQps >= qps || transferred.count(other) != 0) {
+            continue;
+          }
+          const auto& otherPeers = peersMap[other];
+          if (std::find(otherPeers.begin(), otherPeers.end(), source) == otherPeers.end()) {
+            continue;
+          }
+          auto load = std::max(sourceLoad - qps + otherQps, targetLoad + qps - otherQps);
+          if (load < bestLoad) {
+            bestLoad = load;
+            best.emplace(partId, target, other);
+          }
+        }
+      }
+    }
+    if (!best.has_value()) {
+      LOG(INFO) << "Host " << source << " serves " << sourceLoad << " qps by leaders, more than "
+                << expectedMax << ", but no leader could be transferred";
+      break;
+    }
+    auto [partId, target, other] = *best;
+    transfer(partId, source, target);
+    taskCount++;
+    if (other.has_value()) {
+      transfer(*other, target, source);
+      taskCount++;
+    }
+  }
+  return taskCount;
+}
+
 int32_t LeaderBalanceJobExecutor::acquireLeaders(HostParts& allHostParts,
                                                  HostParts& leaderHostParts,
                                                  PartAllocation& peersMap,
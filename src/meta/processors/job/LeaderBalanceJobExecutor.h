@@ -26,6 +26,7 @@ class LeaderBalanceJobExecutor : public MetaJobExecutor {
   FRIEND_TEST(BalanceTest, LeaderBalanceWithZoneTest);
   FRIEND_TEST(BalanceTest, LeaderBalanceWithLargerZoneTest);
   FRIEND_TEST(BalanceTest, LeaderBalanceWithComplexZoneTest);
+  FRIEND_TEST(BalanceTest, LeaderBalanceByHotnessTest);
 
  public:
   LeaderBalanceJobExecutor(JobDescription jobDescription,
@@ -88,6 +89,27 @@ class LeaderBalanceJobExecutor : public MetaJobExecutor {
                         LeaderBalancePlan& plan,
                         GraphSpaceID spaceId);
 
+  /**
+   * @brief After the leader counts are balanced, transfer the leaders of the hot parts off the
+   * hosts whose leaders serve much more qps than the average, to the peers of the parts serving
+   * less. A leader is swapped with a colder one of the target if the counts are out of the bounds
+   * otherwise.
+   *
+   * @param leaderHostParts
+   * @param peersMap
+   * @param activeHosts
+   * @param partsQps Qps of the hot parts
+   * @param plan
+   * @param spaceId
+   * @return The number of the leaders transferred
+   */
+  int32_t balanceLeadersByHotness(HostParts& leaderHostParts,
+                                  PartAllocation& peersMap,
+                                  const std::unordered_set<HostAddr>& activeHosts,
+                                  const std::unordered_map<PartitionID, double>& partsQps,
+                                  LeaderBalancePlan& plan,
+                                  GraphSpaceID spaceId);
+
   void simplifyLeaderBalancePlan(GraphSpaceID spaceId, LeaderBalancePlan& plan);
 
   nebula::cpp2::ErrorCode getAllSpaces(
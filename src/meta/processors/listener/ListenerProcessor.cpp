@@ -56,7 +56,7 @@ void AddListenerProcessor::process(const cpp2::AddListenerReq& req) {
                       MetaKeyUtils::serializeHostAddr(hosts[i % hosts.size()]));
   }
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {space});
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
@@ -98,7 +98,7 @@ void RemoveListenerProcessor::process(const cpp2::RemoveListenerReq& req) {
   }
 
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {space});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
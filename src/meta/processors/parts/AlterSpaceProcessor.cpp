@@ -71,7 +71,7 @@ nebula::cpp2::ErrorCode AlterSpaceProcessor::addZones(const std::string& spaceNa
   std::vector<kvstore::KV> data;
   data.emplace_back(MetaKeyUtils::spaceKey(spaceId), MetaKeyUtils::spaceVal(properties));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {spaceId});
   auto ret = doSyncPut(std::move(data));
   return ret;
 }
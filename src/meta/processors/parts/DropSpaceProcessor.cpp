@@ -147,7 +147,7 @@ void DropSpaceProcessor::process(const cpp2::DropSpaceReq& req) {
   }
 
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {spaceId});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
   LOG(INFO) << "Drop space " << spaceName << ", id " << spaceId;
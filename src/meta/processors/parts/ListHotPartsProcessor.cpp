@@ -0,0 +1,32 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "meta/processors/parts/ListHotPartsProcessor.h"
+
+#include "meta/ActiveHostsMan.h"
+
+namespace nebula {
+namespace meta {
+
+void ListHotPartsProcessor::process(const cpp2::ListHotPartsReq& req) {
+  auto spaceId = req.get_space_id();
+  folly::SharedMutex::ReadHolder holder(LockUtils::lock());
+  CHECK_SPACE_ID_AND_RETURN(spaceId);
+
+  auto ret = ActiveHostsMan::getHotParts(kvstore_, spaceId);
+  if (!nebula::ok(ret)) {
+    auto retCode = nebula::error(ret);
+    LOG(INFO) << "List hot parts failed, error " << apache::thrift::util::enumNameSafe(retCode);
+    handleErrorCode(retCode);
+    onFinished();
+    return;
+  }
+  resp_.parts_ref() = std::move(nebula::value(ret));
+  handleErrorCode(nebula::cpp2::ErrorCode::SUCCEEDED);
+  onFinished();
+}
+
+}  // namespace meta
+}  // namespace nebula
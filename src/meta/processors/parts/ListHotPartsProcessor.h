@@ -0,0 +1,35 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef META_LISTHOTPARTSPROCESSOR_H_
+#define META_LISTHOTPARTSPROCESSOR_H_
+
+#include "meta/processors/BaseProcessor.h"
+
+namespace nebula {
+namespace meta {
+
+/**
+ * @brief Used for command `show hot parts`, will show the access rates and the hottest vertices of
+ *        the hottest parts of a space, reported by the heartbeats of the active storage hosts.
+ *
+ */
+class ListHotPartsProcessor : public BaseProcessor<cpp2::ListHotPartsResp> {
+ public:
+  static ListHotPartsProcessor* instance(kvstore::KVStore* kvstore) {
+    return new ListHotPartsProcessor(kvstore);
+  }
+
+  void process(const cpp2::ListHotPartsReq& req);
+
+ private:
+  explicit ListHotPartsProcessor(kvstore::KVStore* kvstore)
+      : BaseProcessor<cpp2::ListHotPartsResp>(kvstore) {}
+};
+
+}  // namespace meta
+}  // namespace nebula
+
+#endif  // META_LISTHOTPARTSPROCESSOR_H_
@@ -5,6 +5,7 @@
 
 #include "meta/processors/schema/AlterEdgeProcessor.h"
 
+#include "common/utils/NeighborhoodAggregate.h"
 #include "meta/processors/schema/SchemaUtil.h"
 
 namespace nebula {
@@ -105,6 +106,39 @@ void AlterEdgeProcessor::process(const cpp2::AlterEdgeReq& req) {
     }
   }
 
+  // The columns of the aggregates materialized could not be dropped or changed, and the ttl could
+  // not be set, since the aggregates kept would be wrong about the edges then.
+  if (prop.materialized_ref().has_value()) {
+    auto aggregates = NeighborhoodAggregate::parse(*prop.materialized_ref());
+    if (!aggregates.ok()) {
+      handleErrorCode(nebula::cpp2::ErrorCode::E_INVALID_PARM);
+      onFinished();
+      return;
+    }
+    if (alterSchemaProp.get_ttl_col() && !alterSchemaProp.get_ttl_col()->empty()) {
+      LOG(INFO) << "Alter edge error, materialized aggregates and ttl conflict";
+      handleErrorCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED);
+      onFinished();
+      return;
+    }
+    for (auto& edgeItem : edgeItems) {
+      if (*edgeItem.op_ref() == cpp2::AlterSchemaOp::ADD) {
+        continue;
+      }
+      for (auto& col : edgeItem.get_schema().get_columns()) {
+        for (const auto& aggregate : aggregates.value()) {
+          if (aggregate.prop() == col.get_name()) {
+            LOG(INFO) << "Alter edge error, column " << col.get_name() << " is materialized by "
+                      << aggregate.toString();
+            handleErrorCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED);
+            onFinished();
+            return;
+          }
+        }
+      }
+    }
+  }
+
   // Check fulltext index
   auto ftIdxRet = getFTIndex(spaceId, edgeType);
   if (nebula::ok(ftIdxRet)) {
@@ -161,7 +195,7 @@ void AlterEdgeProcessor::process(const cpp2::AlterEdgeReq& req) {
                     MetaKeyUtils::schemaVal(edgeName, schema));
   resp_.id_ref() = to(edgeType, EntryType::EDGE);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {spaceId});
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
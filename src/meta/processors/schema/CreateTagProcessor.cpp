@@ -88,7 +88,7 @@ void CreateTagProcessor::process(const cpp2::CreateTagReq& req) {
 
   resp_.id_ref() = to(tagId, EntryType::TAG);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {spaceId});
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
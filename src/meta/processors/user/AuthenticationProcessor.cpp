@@ -37,7 +37,7 @@ void CreateUserProcessor::process(const cpp2::CreateUserReq& req) {
   std::vector<kvstore::KV> data;
   data.emplace_back(MetaKeyUtils::userKey(account), MetaKeyUtils::userVal(password));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {});
   auto ret = doSyncPut(std::move(data));
   handleErrorCode(ret);
   onFinished();
@@ -67,7 +67,7 @@ void AlterUserProcessor::process(const cpp2::AlterUserReq& req) {
   std::vector<kvstore::KV> data;
   data.emplace_back(std::move(userKey), std::move(userVal));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {});
   auto ret = doSyncPut(std::move(data));
   handleErrorCode(ret);
   onFinished();
@@ -122,7 +122,7 @@ void DropUserProcessor::process(const cpp2::DropUserReq& req) {
 
   LOG(INFO) << "Drop User " << account;
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
@@ -157,7 +157,7 @@ void GrantProcessor::process(const cpp2::GrantRoleReq& req) {
   data.emplace_back(MetaKeyUtils::roleKey(spaceId, account),
                     MetaKeyUtils::roleVal(roleItem.get_role_type()));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {});
   auto ret = doSyncPut(std::move(data));
   handleErrorCode(ret);
   onFinished();
@@ -208,7 +208,7 @@ void RevokeProcessor::process(const cpp2::RevokeRoleReq& req) {
   auto batchHolder = std::make_unique<kvstore::BatchHolder>();
   batchHolder->remove(std::move(roleKey));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec, {});
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
 }
@@ -253,7 +253,7 @@ void ChangePasswordProcessor::process(const cpp2::ChangePasswordReq& req) {
   std::vector<kvstore::KV> data;
   data.emplace_back(std::move(userKey), std::move(userVal));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, timeInMilliSec, {});
   auto ret = doSyncPut(std::move(data));
   handleErrorCode(ret);
   onFinished();
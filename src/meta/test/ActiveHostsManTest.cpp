@@ -14,6 +14,7 @@
 
 DECLARE_int32(heartbeat_interval_secs);
 DECLARE_uint32(expired_time_factor);
+DECLARE_int32(meta_change_log_retention_secs);
 
 namespace nebula {
 namespace meta {
@@ -199,6 +200,70 @@ TEST(ActiveHostsManTest, LeaderTest) {
   ASSERT_EQ(1, nebula::value(hostsRet).size());
 }
 
+TEST(ActiveHostsManTest, ChangedSpacesTest) {
+  fs::TempDir rootPath("/tmp/ActiveHostsManTest.XXXXXX");
+  std::unique_ptr<kvstore::KVStore> kv(MockCluster::initMetaKV(rootPath.path()));
+  auto now = time::WallClock::fastNowInMilliSec();
+
+  // Nothing is logged before the first prune
+  {
+    std::vector<kvstore::KV> data;
+    LastUpdateTimeMan::update(data, now, {1});
+    TestUtils::doPut(kv.get(), data);
+    auto ret = LastUpdateTimeMan::changedSpaces(kv.get(), now - 1);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).has_value());
+  }
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, LastUpdateTimeMan::pruneChanges(kv.get(), now));
+  {
+    std::vector<kvstore::KV> data;
+    LastUpdateTimeMan::update(data, now + 10, {1, 2});
+    LastUpdateTimeMan::update(data, now + 20, {2});
+    TestUtils::doPut(kv.get(), data);
+
+    auto ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 1);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_TRUE(nebula::value(ret).has_value());
+    auto spaces = *nebula::value(ret);
+    std::sort(spaces.begin(), spaces.end());
+    ASSERT_EQ(std::vector<GraphSpaceID>({1, 2}), spaces);
+
+    ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 20);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_EQ(std::vector<GraphSpaceID>({2}), *nebula::value(ret));
+
+    // The time before the log covers
+    ret = LastUpdateTimeMan::changedSpaces(kv.get(), now - 1);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).has_value());
+  }
+  // A change of all the spaces
+  {
+    std::vector<kvstore::KV> data;
+    LastUpdateTimeMan::update(data, now + 30);
+    TestUtils::doPut(kv.get(), data);
+    auto ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 20);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).has_value());
+  }
+  // The changes before the retention are pruned
+  {
+    auto later = now + FLAGS_meta_change_log_retention_secs * 1000L + 25;
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              LastUpdateTimeMan::pruneChanges(kv.get(), later));
+    auto ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 20);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).has_value());
+    ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 25);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).has_value());
+    ret = LastUpdateTimeMan::changedSpaces(kv.get(), now + 31);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_TRUE(nebula::value(ret).has_value());
+    ASSERT_TRUE(nebula::value(ret)->empty());
+  }
+}
+
 }  // namespace meta
 }  // namespace nebula
 
@@ -1032,6 +1032,82 @@ TEST(BalanceTest, SimpleLeaderBalancePlanTest) {
   }
 }
 
+TEST(BalanceTest, LeaderBalanceByHotnessTest) {
+  fs::TempDir rootPath("/tmp/LeaderBalanceByHotnessTest.XXXXXX");
+  auto store = MockCluster::initMetaKV(rootPath.path());
+  auto* kv = dynamic_cast<kvstore::KVStore*>(store.get());
+  std::vector<HostAddr> hosts = {{"0", 0}, {"1", 1}, {"2", 2}};
+  TestUtils::createSomeHosts(kv, hosts);
+  GraphSpaceID space = 1;
+  TestUtils::assembleSpace(kv, space, 9, 3, 3);
+
+  NiceMock<MockAdminClient> client;
+  JobDescription jobDesc(
+      space, testJobId.fetch_add(1, std::memory_order_relaxed), cpp2::JobType::LEADER_BALANCE);
+  LeaderBalanceJobExecutor balancer(jobDesc, kv, &client, {});
+
+  PartAllocation peersMap;
+  for (PartitionID part = 1; part <= 9; part++) {
+    peersMap[part] = hosts;
+  }
+  std::unordered_set<HostAddr> activeHosts(hosts.begin(), hosts.end());
+  // The leader counts are balanced, but the hot parts are all led by host 0
+  std::unordered_map<PartitionID, double> partsQps = {{1, 100}, {2, 100}, {3, 100}};
+  {
+    HostParts leaderHostParts;
+    leaderHostParts[hosts[0]] = {1, 2, 3};
+    leaderHostParts[hosts[1]] = {4, 5, 6};
+    leaderHostParts[hosts[2]] = {7, 8, 9};
+    for (const auto& host : hosts) {
+      balancer.hostBounds_[host] = std::make_pair(3, 3);
+    }
+
+    LeaderBalancePlan plan;
+    auto taskCount = balancer.balanceLeadersByHotness(
+        leaderHostParts, peersMap, activeHosts, partsQps, plan, space);
+    // Two hot leaders are swapped with the cold ones
+    EXPECT_EQ(4, taskCount);
+    EXPECT_EQ(4, plan.size());
+    for (const auto& host : hosts) {
+      const auto& leaders = leaderHostParts[host];
+      EXPECT_EQ(3, leaders.size());
+      EXPECT_EQ(1, std::count_if(leaders.begin(), leaders.end(), [](auto part) {
+                  return part <= 3;
+                }));
+    }
+  }
+  {
+    HostParts leaderHostParts;
+    leaderHostParts[hosts[0]] = {1, 2, 3};
+    leaderHostParts[hosts[1]] = {4, 5, 6};
+    leaderHostParts[hosts[2]] = {7, 8, 9};
+    for (const auto& host : hosts) {
+      balancer.hostBounds_[host] = std::make_pair(1, 4);
+    }
+
+    LeaderBalancePlan plan;
+    auto taskCount = balancer.balanceLeadersByHotness(
+        leaderHostParts, peersMap, activeHosts, partsQps, plan, space);
+    // The hot leaders are transferred without swapping in the bounds
+    EXPECT_EQ(2, taskCount);
+    EXPECT_EQ(1, leaderHostParts[hosts[0]].size());
+    EXPECT_EQ(4, leaderHostParts[hosts[1]].size());
+    EXPECT_EQ(4, leaderHostParts[hosts[2]].size());
+  }
+  {
+    // Nothing to do without the hot parts
+    HostParts leaderHostParts;
+    leaderHostParts[hosts[0]] = {1, 2, 3};
+    leaderHostParts[hosts[1]] = {4, 5, 6};
+    leaderHostParts[hosts[2]] = {7, 8, 9};
+    LeaderBalancePlan plan;
+    EXPECT_EQ(0,
+              balancer.balanceLeadersByHotness(
+                  leaderHostParts, peersMap, activeHosts, {}, plan, space));
+    EXPECT_TRUE(plan.empty());
+  }
+}
+
 TEST(BalanceTest, IntersectHostsLeaderBalancePlanTest) {
   fs::TempDir rootPath("/tmp/IntersectHostsLeaderBalancePlanTest.XXXXXX");
   auto store = MockCluster::initMetaKV(rootPath.path());
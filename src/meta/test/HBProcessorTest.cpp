@@ -63,6 +63,27 @@ TEST(HBProcessorTest, HBTest) {
   }
 }
 
+TEST(HBProcessorTest, MergeLeadersTest) {
+  HostAddr host1("1", 1), host2("2", 2);
+  std::vector<kvstore::KV> data;
+  data.emplace_back(MetaKeyUtils::leaderKey(1, 1), MetaKeyUtils::leaderValV3(host1, 5));
+  data.emplace_back(MetaKeyUtils::leaderKey(1, 2), MetaKeyUtils::leaderValV3(host1, 3));
+  data.emplace_back(MetaKeyUtils::hostKey(host1.host, host1.port), "host1");
+  data.emplace_back(MetaKeyUtils::leaderKey(1, 1), MetaKeyUtils::leaderValV3(host2, 4));
+  data.emplace_back(MetaKeyUtils::leaderKey(1, 2), MetaKeyUtils::leaderValV3(host2, 6));
+  data.emplace_back(MetaKeyUtils::hostKey(host2.host, host2.port), "host2");
+
+  auto merged = HBProcessor::mergeLeaders(std::move(data));
+  ASSERT_EQ(4, merged.size());
+  EXPECT_EQ(MetaKeyUtils::leaderKey(1, 1), merged[0].first);
+  EXPECT_EQ(host1, std::get<0>(MetaKeyUtils::parseLeaderValV3(merged[0].second)));
+  EXPECT_EQ("host1", merged[1].second);
+  EXPECT_EQ(MetaKeyUtils::leaderKey(1, 2), merged[2].first);
+  EXPECT_EQ(host2, std::get<0>(MetaKeyUtils::parseLeaderValV3(merged[2].second)));
+  EXPECT_EQ(6, std::get<1>(MetaKeyUtils::parseLeaderValV3(merged[2].second)));
+  EXPECT_EQ("host2", merged[3].second);
+}
+
 }  // namespace meta
 }  // namespace nebula
 
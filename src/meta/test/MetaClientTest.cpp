@@ -1132,6 +1132,10 @@ class TestListener : public MetaChangedListener {
     LOG(INFO) << "Fetch Disk Paths";
   }
 
+  void fetchHotParts(std::vector<cpp2::PartHotness>& hotParts) override {
+    UNUSED(hotParts);
+  }
+
   int32_t spaceNum = 0;
   int32_t partNum = 0;
   int32_t partChanged = 0;
@@ -33,6 +33,10 @@ std::string ShowPartsSentence::toString() const {
   return std::string("SHOW PARTS");
 }
 
+std::string ShowHotPartsSentence::toString() const {
+  return std::string("SHOW HOT PARTS");
+}
+
 std::string ShowUsersSentence::toString() const {
   return std::string("SHOW USERS");
 }
@@ -245,8 +249,15 @@ std::string AdminJobSentence::toString() const {
   switch (op_) {
     case meta::cpp2::JobOp::ADD: {
       switch (type_) {
-        case meta::cpp2::JobType::COMPACT:
+        case meta::cpp2::JobType::COMPACT: {
+          folly::StringPiece para(paras_.empty() ? "" : paras_.front());
+          if (para.removePrefix("parts=")) {
+            return folly::stringPrintf("SUBMIT JOB COMPACT ON PARTS %s", para.str().c_str());
+          } else if (para.removePrefix("expired_ratio=")) {
+            return folly::stringPrintf("SUBMIT JOB COMPACT TTL %s", para.str().c_str());
+          }
           return "SUBMIT JOB COMPACT";
+        }
         case meta::cpp2::JobType::FLUSH:
           return "SUBMIT JOB FLUSH";
         case meta::cpp2::JobType::REBUILD_TAG_INDEX:
@@ -88,6 +88,15 @@ class ShowPartsSentence : public Sentence {
   std::unique_ptr<std::vector<int32_t>> list_;
 };
 
+class ShowHotPartsSentence : public Sentence {
+ public:
+  ShowHotPartsSentence() {
+    kind_ = Kind::kShowHotParts;
+  }
+
+  std::string toString() const override;
+};
+
 class ShowUsersSentence : public Sentence {
  public:
   ShowUsersSentence() {
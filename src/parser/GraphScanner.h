@@ -96,22 +96,23 @@ class GraphScanner : public yyFlexLexer {
 
   using TokenType = nebula::GraphParser::token;
   auto parseDecimal() {
-    try {
-      folly::StringPiece text(yytext, yyleng);
-      uint64_t val = folly::to<uint64_t>(text);
-      if (val > MAX_ABS_INTEGER) {
-        throw GraphParser::syntax_error(*yylloc, "Out of range:");
-      }
-      if (val == MAX_ABS_INTEGER && !hasUnaryMinus()) {
+    // The digits are accumulated in place, since a generated statement could have thousands of
+    // the literals
+    uint64_t val = 0;
+    for (int i = 0; i < yyleng; ++i) {
+      auto digit = static_cast<uint64_t>(yytext[i] - '0');
+      if (val > (MAX_ABS_INTEGER - digit) / 10) {
         throw GraphParser::syntax_error(*yylloc, "Out of range:");
       }
-      if (val == MAX_ABS_INTEGER && hasUnaryMinus()) {
-        setIsIntMin(true);
-      }
-      yylval->intval = val;
-    } catch (...) {
+      val = val * 10 + digit;
+    }
+    if (val == MAX_ABS_INTEGER && !hasUnaryMinus()) {
       throw GraphParser::syntax_error(*yylloc, "Out of range:");
     }
+    if (val == MAX_ABS_INTEGER && hasUnaryMinus()) {
+      setIsIntMin(true);
+    }
+    yylval->intval = val;
     return TokenType::INTEGER;
   }
 
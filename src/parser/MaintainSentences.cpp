@@ -24,6 +24,9 @@ std::string SchemaPropItem::toString() const {
       return folly::stringPrintf("ttl_col = \"%s\"", std::get<std::string>(propValue_).c_str());
     case COMMENT:
       return folly::stringPrintf("comment = \"%s\"", std::get<std::string>(propValue_).c_str());
+    case MATERIALIZED:
+      return folly::stringPrintf("materialized = \"%s\"",
+                                 std::get<std::string>(propValue_).c_str());
   }
   DLOG(FATAL) << "Schema property type illegal";
   return "";
@@ -190,7 +190,7 @@ class SchemaPropItem final {
  public:
   using Value = std::variant<int64_t, bool, std::string>;
 
-  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT };
+  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT, MATERIALIZED };
 
   SchemaPropItem(PropType op, int64_t val) {
     propType_ = op;
@@ -227,6 +227,15 @@ class SchemaPropItem final {
     }
   }
 
+  // The aggregates of the edges materialized, e.g. "count, sum(weight)"
+  StatusOr<std::string> getMaterialized() {
+    if (propType_ == MATERIALIZED) {
+      return asString();
+    } else {
+      return Status::Error("Not exists materialized.");
+    }
+  }
+
   StatusOr<std::string> getComment() {
     if (propType_ == COMMENT) {
       return asString();
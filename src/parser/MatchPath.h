@@ -350,6 +350,15 @@ class MatchPath final {
     pathType_ = type;
   }
 
+  // The edge property summed as the length of the shortest path, nullptr for the number of steps
+  const std::string* weightProp() const {
+    return weightProp_.get();
+  }
+
+  void setWeightProp(std::string* prop) {
+    weightProp_.reset(prop);
+  }
+
   bool isPredicate() const {
     return isPred_;
   }
@@ -385,6 +394,7 @@ class MatchPath final {
   std::vector<std::unique_ptr<MatchNode>> nodes_;
   std::vector<std::unique_ptr<MatchEdge>> edges_;
   PathType pathType_{PathType::kDefault};
+  std::unique_ptr<std::string> weightProp_;
 
   bool isPred_{false};
   bool isAntiPred_{false};
@@ -60,6 +60,7 @@ class Sentence {
     kShowHosts,
     kShowSpaces,
     kShowParts,
+    kShowHotParts,
     kShowTags,
     kShowEdges,
     kShowTagIndexes,
@@ -112,6 +113,7 @@ class Sentence {
     kAdminJob,
     kAdminShowJobs,
     kGetSubgraph,
+    kRandomWalk,
     kMergeZone,
     kRenameZone,
     kDropZone,
@@ -299,4 +299,20 @@ std::string GetSubgraphSentence::toString() const {
   }
   return buf;
 }
+
+std::string RandomWalkSentence::toString() const {
+  std::string buf;
+  buf.reserve(256);
+  buf += "RANDOM WALK ";
+  buf += step_->toString();
+  buf += " ";
+  buf += from_->toString();
+  buf += " ";
+  buf += over_->toString();
+  if (options_ != nullptr) {
+    buf += " WITH ";
+    buf += options_->toString();
+  }
+  return buf;
+}
 }  // namespace nebula
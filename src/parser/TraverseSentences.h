@@ -690,5 +690,42 @@ class GetSubgraphSentence final : public Sentence {
   std::unique_ptr<WhereClause> where_;
   std::unique_ptr<YieldClause> yield_;
 };
+
+// RANDOM WALK <n> STEPS FROM <vids> OVER <edges> [WITH {walks: <m>, p: <p>, q: <q>}]
+class RandomWalkSentence final : public Sentence {
+ public:
+  RandomWalkSentence(StepClause* step, FromClause* from, OverClause* over, Expression* options) {
+    kind_ = Kind::kRandomWalk;
+    step_.reset(step);
+    from_.reset(from);
+    over_.reset(over);
+    options_ = options;
+  }
+
+  StepClause* step() const {
+    return step_.get();
+  }
+
+  FromClause* from() const {
+    return from_.get();
+  }
+
+  OverClause* over() const {
+    return over_.get();
+  }
+
+  // The map of the options of the walk, nullptr if not specified
+  Expression* options() const {
+    return options_;
+  }
+
+  std::string toString() const override;
+
+ private:
+  std::unique_ptr<StepClause> step_;
+  std::unique_ptr<FromClause> from_;
+  std::unique_ptr<OverClause> over_;
+  Expression* options_{nullptr};
+};
 }  // namespace nebula
 #endif  // PARSER_TRAVERSESENTENCES_H_
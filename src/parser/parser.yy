@@ -56,6 +56,8 @@ using namespace nebula;
 
     void ifOutOfRange(const int64_t input,
                       const nebula::GraphParser::location_type& loc);
+
+    void checkPure(nebula::graph::QueryContext* qctx, const nebula::Expression* expr);
 }
 
 // Define types of semantic values
@@ -183,7 +185,7 @@ using namespace nebula;
 %token KW_IF KW_NOT KW_EXISTS KW_WITH
 %token KW_BY KW_DOWNLOAD KW_HDFS KW_UUID KW_CONFIGS KW_FORCE
 %token KW_GET KW_DECLARE KW_GRAPH KW_META KW_STORAGE KW_AGENT
-%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_DATA KW_STOP
+%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_MATERIALIZED KW_DATA KW_STOP
 %token KW_FETCH KW_PROP KW_UPDATE KW_UPSERT KW_WHEN
 %token KW_ORDER KW_ASC KW_LIMIT KW_SAMPLE KW_OFFSET KW_ASCENDING KW_DESCENDING
 %token KW_DISTINCT KW_ALL KW_OF
@@ -214,6 +216,8 @@ using namespace nebula;
 %token KW_GEOGRAPHY KW_POINT KW_LINESTRING KW_POLYGON
 %token KW_LIST KW_MAP
 %token KW_MERGE KW_DIVIDE KW_RENAME
+%token KW_RANDOM KW_WALK
+%token KW_HOT
 %token KW_JOIN KW_LEFT KW_RIGHT KW_OUTER KW_INNER KW_SEMI KW_ANTI
 
 
@@ -399,6 +403,7 @@ using namespace nebula;
 
 %type <sentence> traverse_sentence unwind_sentence
 %type <sentence> go_sentence match_sentence lookup_sentence find_path_sentence get_subgraph_sentence
+%type <sentence> random_walk_sentence
 %type <sentence> group_by_sentence order_by_sentence limit_sentence
 %type <sentence> fetch_sentence fetch_vertices_sentence fetch_edges_sentence
 %type <sentence> set_sentence piped_sentence assignment_sentence match_sentences
@@ -512,6 +517,7 @@ unreserved_keyword
     | KW_ATOMIC_EDGE        { $$ = new std::string("atomic_edge"); }
     | KW_TTL_DURATION       { $$ = new std::string("ttl_duration"); }
     | KW_TTL_COL            { $$ = new std::string("ttl_col"); }
+    | KW_MATERIALIZED       { $$ = new std::string("materialized"); }
     | KW_SNAPSHOT           { $$ = new std::string("snapshot"); }
     | KW_SNAPSHOTS          { $$ = new std::string("snapshots"); }
     | KW_GRAPH              { $$ = new std::string("graph"); }
@@ -583,6 +589,9 @@ unreserved_keyword
     | KW_DIVIDE             { $$ = new std::string("divide"); }
     | KW_RENAME             { $$ = new std::string("rename"); }
     | KW_CLEAR              { $$ = new std::string("clear"); }
+    | KW_RANDOM             { $$ = new std::string("random"); }
+    | KW_WALK               { $$ = new std::string("walk"); }
+    | KW_HOT                { $$ = new std::string("hot"); }
     | KW_ANALYZER           { $$ = new std::string("analyzer"); }
     ;
 
@@ -1061,6 +1070,7 @@ function_call_expression
             delete($1);
         } else if (FunctionManager::find(*$1, $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), *$1, $3);
+            checkPure(qctx, $$);
             delete($1);
         } else {
             delete($1);
@@ -1091,6 +1101,7 @@ function_call_expression
     | KW_TIMESTAMP L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("timestamp", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "timestamp", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1098,6 +1109,7 @@ function_call_expression
     | KW_DATE L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("date", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "date", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1105,6 +1117,7 @@ function_call_expression
     | KW_TIME L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("time", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "time", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1112,6 +1125,7 @@ function_call_expression
     | KW_DATETIME L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("datetime", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "datetime", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1119,6 +1133,7 @@ function_call_expression
     | KW_TAGS L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("tags", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "tags", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1126,6 +1141,7 @@ function_call_expression
     | KW_SIGN L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("sign", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "sign", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1133,6 +1149,15 @@ function_call_expression
     | KW_DURATION L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("duration", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "duration", $3);
+            checkPure(qctx, $$);
+        } else {
+            throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
+        }
+    }
+    | KW_UNION L_PAREN opt_argument_list R_PAREN {
+        if (FunctionManager::find("union", $3->numArgs()).ok()) {
+            $$ = FunctionCallExpression::make(qctx->objPool(), "union", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1140,6 +1165,7 @@ function_call_expression
     | KW_LEFT L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("left", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "left", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1147,6 +1173,7 @@ function_call_expression
     | KW_RIGHT L_PAREN opt_argument_list R_PAREN {
         if (FunctionManager::find("right", $3->numArgs()).ok()) {
             $$ = FunctionCallExpression::make(qctx->objPool(), "right", $3);
+            checkPure(qctx, $$);
         } else {
             throw nebula::GraphParser::syntax_error(@1, "Unknown function ");
         }
@@ -1414,6 +1441,8 @@ truncate_clause
         if(graph::ExpressionUtils::findAny($2, {Expression::Kind::kVar})) {
             throw nebula::GraphParser::syntax_error(@2, "Parameter is not supported in sample clause");
         }
+        // The edges sampled differ from run to run
+        qctx->setNonDeterministic();
         $$ = new TruncateClause($2, true);
     }
     | KW_LIMIT expression {
@@ -1874,6 +1903,11 @@ match_path_pattern
         $$ = $3;
         $$->setPathType(MatchPath::PathType::kSingleShortest);
     }
+    | KW_SHORTESTPATH L_PAREN match_path_pattern COMMA name_label R_PAREN {
+        $$ = $3;
+        $$->setPathType(MatchPath::PathType::kSingleShortest);
+        $$->setWeightProp($5);
+    }
     | KW_ALLSHORTESTPATHS L_PAREN match_path_pattern R_PAREN {
         $$ = $3;
         $$->setPathType(MatchPath::PathType::kAllShortest);
@@ -2428,6 +2462,17 @@ get_subgraph_sentence
         $$ = new GetSubgraphSentence($3, $4, $5, $6, $7, $8, $9, $10);
     }
 
+random_walk_sentence
+    : KW_RANDOM KW_WALK legal_integer KW_STEPS from_clause over_clause {
+        qctx->setNonDeterministic();
+        $$ = new RandomWalkSentence(new StepClause($3), $5, $6, nullptr);
+    }
+    | KW_RANDOM KW_WALK legal_integer KW_STEPS from_clause over_clause KW_WITH map_expression {
+        qctx->setNonDeterministic();
+        $$ = new RandomWalkSentence(new StepClause($3), $5, $6, $8);
+    }
+    ;
+
 use_sentence
     : KW_USE name_label { $$ = new UseSentence($2); }
     ;
@@ -2475,6 +2520,10 @@ create_schema_prop_item
         $$ = new SchemaPropItem(SchemaPropItem::TTL_COL, *$3);
         delete $3;
     }
+    | KW_MATERIALIZED ASSIGN STRING {
+        $$ = new SchemaPropItem(SchemaPropItem::MATERIALIZED, *$3);
+        delete $3;
+    }
     | comment_prop_assignment {
         $$ = new SchemaPropItem(SchemaPropItem::COMMENT, *$1);
         delete $1;
@@ -2975,6 +3024,7 @@ traverse_sentence
     | find_path_sentence { $$ = $1; }
     | yield_sentence { $$ = $1; }
     | get_subgraph_sentence { $$ = $1; }
+    | random_walk_sentence { $$ = $1; }
     | delete_vertex_sentence { $$ = $1; }
     | delete_tag_sentence { $$ = $1; }
     | delete_edge_sentence { $$ = $1; }
@@ -3373,6 +3423,22 @@ admin_job_sentence
                                              meta::cpp2::JobType::COMPACT);
         $$ = sentence;
     }
+    | KW_SUBMIT KW_JOB KW_COMPACT KW_ON KW_PARTS integer_list {
+        auto sentence = new AdminJobSentence(meta::cpp2::JobOp::ADD,
+                                             meta::cpp2::JobType::COMPACT);
+        sentence->addPara("parts=" + folly::join(",", *$6));
+        delete $6;
+        $$ = sentence;
+    }
+    | KW_SUBMIT KW_JOB KW_COMPACT KW_TTL DOUBLE {
+        if ($5 <= 0 || $5 > 1) {
+            throw nebula::GraphParser::syntax_error(@5, "Expired ratio should be in (0, 1]");
+        }
+        auto sentence = new AdminJobSentence(meta::cpp2::JobOp::ADD,
+                                             meta::cpp2::JobType::COMPACT);
+        sentence->addPara("expired_ratio=" + folly::to<std::string>($5));
+        $$ = sentence;
+    }
     | KW_SUBMIT KW_JOB KW_FLUSH {
         auto sentence = new AdminJobSentence(meta::cpp2::JobOp::ADD,
                                              meta::cpp2::JobType::FLUSH);
@@ -3473,6 +3539,9 @@ show_sentence
     | KW_SHOW KW_PARTS integer_list {
         $$ = new ShowPartsSentence($3);
     }
+    | KW_SHOW KW_HOT KW_PARTS {
+        $$ = new ShowHotPartsSentence();
+    }
     | KW_SHOW KW_TAGS {
         $$ = new ShowTagsSentence();
     }
@@ -4140,6 +4209,20 @@ void ifOutOfRange(const int64_t input,
     }
 }
 
+// mark the query non-deterministic if it calls a non-pure function, e.g. rand() or now()
+void checkPure(nebula::graph::QueryContext* qctx, const nebula::Expression* expr) {
+    if (expr->kind() != nebula::Expression::Kind::kFunctionCall) {
+        return;
+    }
+    auto func = static_cast<const nebula::FunctionCallExpression*>(expr);
+    auto pure = nebula::FunctionManager::getIsPure(func->name(), func->args()->numArgs());
+    // rand() is taken as pure to be folded, while its results differ from run to run
+    if (!pure.ok() || !pure.value() ||
+        nebula::graph::ExpressionUtils::findInnerRandFunction(func)) {
+        qctx->setNonDeterministic();
+    }
+}
+
 static int yylex(nebula::GraphParser::semantic_type* yylval,
                  nebula::GraphParser::location_type *yylloc,
                  nebula::GraphScanner& scanner) {
@@ -435,6 +435,18 @@ TEST_F(ParserTest, EdgeOperation) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    std::string query =
+        "CREATE EDGE follow(name string, degree int) "
+        "materialized = \"count, sum(degree), union(name)\"";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "ALTER EDGE follow materialized = \"count\"";
+    auto result = parse(query);
+    ASSERT_FALSE(result.ok());
+  }
   {
     std::string query =
         "CREATE EDGE man(name string default \"\", age int default 18, "
@@ -764,6 +776,12 @@ TEST_F(ParserTest, Set) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    // The set functions
+    std::string query = "YIELD union({1, 2}, [2, 3]) AS u UNION YIELD intersection({1}, [1]) AS u";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
 }
 
 TEST_F(ParserTest, Pipe) {
@@ -1483,6 +1501,35 @@ TEST_F(ParserTest, subgraph) {
   }
 }
 
+TEST_F(ParserTest, RandomWalk) {
+  {
+    std::string query = "RANDOM WALK 3 STEPS FROM \"TOM\" OVER like";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "RANDOM WALK 3 STEPS FROM \"TOM\", \"Jerry\" OVER like, serve BIDIRECT";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "RANDOM WALK 5 STEPS FROM \"TOM\" OVER * WITH {walks: 10, p: 1.0, q: 0.5}";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "GO FROM \"TOM\" OVER like YIELD dst(edge) AS id | "
+                        "RANDOM WALK 2 STEPS FROM $-.id OVER like REVERSELY";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "RANDOM WALK FROM \"TOM\" OVER like";
+    auto result = parse(query);
+    ASSERT_FALSE(result.ok());
+  }
+}
+
 TEST_F(ParserTest, AdminOperation) {
   {
     GQLParser parser;
@@ -1548,6 +1595,11 @@ TEST_F(ParserTest, AdminOperation) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    std::string query = "SHOW HOT PARTS";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
   {
     std::string query = "SHOW TAGS";
     auto result = parse(query);
@@ -3108,6 +3160,12 @@ TEST_F(ParserTest, JobTest) {
     ASSERT_EQ(result.value()->toString(), expectedStr);
   };
   checkTest("SUBMIT JOB COMPACT", "SUBMIT JOB COMPACT");
+  checkTest("SUBMIT JOB COMPACT ON PARTS 1, 2, 3", "SUBMIT JOB COMPACT ON PARTS 1,2,3");
+  checkTest("SUBMIT JOB COMPACT TTL 0.5", "SUBMIT JOB COMPACT TTL 0.5");
+  {
+    auto result = parse("SUBMIT JOB COMPACT TTL 1.5");
+    ASSERT_FALSE(result.ok());
+  }
   checkTest("SUBMIT JOB FLUSH", "SUBMIT JOB FLUSH");
 
   checkTest("SUBMIT JOB DOWNLOAD HDFS \"hdfs://127.0.0.1:9090/data\"",
@@ -3259,4 +3317,30 @@ TEST_F(ParserTest, TestSpecialWhiteSpaceChar) {
   }
 }
 
+TEST_F(ParserTest, NonDeterministic) {
+  auto deterministic = [this](const std::string& query) {
+    qctx_ = std::make_unique<graph::QueryContext>();
+    auto result = parse(query);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return qctx_->deterministic();
+  };
+  EXPECT_TRUE(deterministic("GO FROM \"1\" OVER e YIELD e.p + abs(-1)"));
+  EXPECT_TRUE(deterministic("MATCH (v) WHERE id(v) == \"1\" RETURN v"));
+  // In each clause
+  EXPECT_FALSE(deterministic("YIELD rand()"));
+  EXPECT_FALSE(deterministic("YIELD [1, 2][rand32(2)]"));
+  EXPECT_FALSE(deterministic("GO FROM \"1\" OVER e YIELD now()"));
+  EXPECT_FALSE(deterministic("GO FROM \"1\" OVER e WHERE e.p > rand64(10) YIELD e.p"));
+  EXPECT_FALSE(deterministic("GO FROM rand64(10) OVER e YIELD e.p"));
+  EXPECT_FALSE(deterministic("FETCH PROP ON t rand32(10) YIELD t.p"));
+  EXPECT_FALSE(deterministic("LOOKUP ON t WHERE t.p < timestamp() YIELD t.p"));
+  EXPECT_FALSE(deterministic("MATCH (v) WHERE v.t.p < datetime() RETURN v"));
+  EXPECT_FALSE(deterministic("MATCH (v) RETURN v ORDER BY rand()"));
+  EXPECT_FALSE(deterministic("YIELD 1 AS a | YIELD $-.a + rand32(2) AS b"));
+  EXPECT_FALSE(deterministic("$a = YIELD time() AS t; YIELD $a.t"));
+  // Sampled
+  EXPECT_FALSE(deterministic("GO 2 STEPS FROM \"1\" OVER e YIELD e.p SAMPLE [1, 2]"));
+  EXPECT_FALSE(deterministic("RANDOM WALK 2 STEPS FROM \"1\" OVER e"));
+}
+
 }  // namespace nebula
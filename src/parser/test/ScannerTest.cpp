@@ -341,6 +341,9 @@ TEST(Scanner, Basic) {
       CHECK_SEMANTIC_TYPE("TTL_COL", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("ttl_col", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("Ttl_col", TokenType::KW_TTL_COL),
+      CHECK_SEMANTIC_TYPE("MATERIALIZED", TokenType::KW_MATERIALIZED),
+      CHECK_SEMANTIC_TYPE("materialized", TokenType::KW_MATERIALIZED),
+      CHECK_SEMANTIC_TYPE("Materialized", TokenType::KW_MATERIALIZED),
       CHECK_SEMANTIC_TYPE("DOWNLOAD", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("download", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("Download", TokenType::KW_DOWNLOAD),
@@ -515,6 +518,15 @@ TEST(Scanner, Basic) {
       CHECK_SEMANTIC_TYPE("RENAME", TokenType::KW_RENAME),
       CHECK_SEMANTIC_TYPE("Rename", TokenType::KW_RENAME),
       CHECK_SEMANTIC_TYPE("rename", TokenType::KW_RENAME),
+      CHECK_SEMANTIC_TYPE("RANDOM", TokenType::KW_RANDOM),
+      CHECK_SEMANTIC_TYPE("Random", TokenType::KW_RANDOM),
+      CHECK_SEMANTIC_TYPE("random", TokenType::KW_RANDOM),
+      CHECK_SEMANTIC_TYPE("WALK", TokenType::KW_WALK),
+      CHECK_SEMANTIC_TYPE("Walk", TokenType::KW_WALK),
+      CHECK_SEMANTIC_TYPE("walk", TokenType::KW_WALK),
+      CHECK_SEMANTIC_TYPE("HOT", TokenType::KW_HOT),
+      CHECK_SEMANTIC_TYPE("Hot", TokenType::KW_HOT),
+      CHECK_SEMANTIC_TYPE("hot", TokenType::KW_HOT),
 
       CHECK_SEMANTIC_TYPE("_type", TokenType::TYPE_PROP),
       CHECK_SEMANTIC_TYPE("_id", TokenType::ID_PROP),
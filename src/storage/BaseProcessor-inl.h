@@ -6,6 +6,9 @@
 #ifndef STORAGE_BASEPROCESSOR_INL_H
 #define STORAGE_BASEPROCESSOR_INL_H
 
+#include <numeric>
+
+#include "kvstore/LogEncoder.h"
 #include "storage/BaseProcessor.h"
 
 namespace nebula {
@@ -111,8 +114,13 @@ template <typename RESP>
 void BaseProcessor<RESP>::doPut(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 std::vector<kvstore::KV>&& data) {
+  auto cachedKeys = cachedKeysOf(data);
   this->env_->kvstore_->asyncMultiPut(
-      spaceId, partId, std::move(data), [spaceId, partId, this](nebula::cpp2::ErrorCode code) {
+      spaceId,
+      partId,
+      std::move(data),
+      [spaceId, partId, cachedKeys = std::move(cachedKeys), this](nebula::cpp2::ErrorCode code) {
+        evictCaches(spaceId, cachedKeys);
         handleAsync(spaceId, partId, code);
       });
 }
@@ -121,12 +129,72 @@ template <typename RESP>
 void BaseProcessor<RESP>::doRemove(GraphSpaceID spaceId,
                                    PartitionID partId,
                                    std::vector<std::string>&& keys) {
+  auto cachedKeys = cachedKeysOf(keys);
   this->env_->kvstore_->asyncMultiRemove(
-      spaceId, partId, std::move(keys), [spaceId, partId, this](nebula::cpp2::ErrorCode code) {
+      spaceId,
+      partId,
+      std::move(keys),
+      [spaceId, partId, cachedKeys = std::move(cachedKeys), this](nebula::cpp2::ErrorCode code) {
+        evictCaches(spaceId, cachedKeys);
         handleAsync(spaceId, partId, code);
       });
 }
 
+template <typename RESP>
+CachedKeys BaseProcessor<RESP>::cachedKeysOf(const std::vector<kvstore::KV>& data) const {
+  CachedKeys keys;
+  for (const auto& kv : data) {
+    addCachedKey(kv.first, &keys);
+  }
+  return keys;
+}
+
+template <typename RESP>
+CachedKeys BaseProcessor<RESP>::cachedKeysOf(const std::vector<std::string>& keys) const {
+  CachedKeys ret;
+  for (const auto& key : keys) {
+    addCachedKey(key, &ret);
+  }
+  return ret;
+}
+
+template <typename RESP>
+CachedKeys BaseProcessor<RESP>::cachedKeysOf(folly::StringPiece batch) const {
+  CachedKeys keys;
+  if (env_->vertexCache_ == nullptr && env_->adjacencyCache_ == nullptr) {
+    return keys;
+  }
+  for (const auto& op : kvstore::decodeBatchValue(batch)) {
+    if (op.first != kvstore::BatchLogType::OP_BATCH_REMOVE_RANGE) {
+      addCachedKey(op.second.first, &keys);
+    }
+  }
+  return keys;
+}
+
+template <typename RESP>
+void BaseProcessor<RESP>::addCachedKey(folly::StringPiece key, CachedKeys* keys) const {
+  if (env_->vertexCache_ != nullptr && NebulaKeyUtils::isTag(spaceVidLen_, key)) {
+    keys->tagKeys.emplace_back(key.str());
+  } else if (env_->adjacencyCache_ != nullptr && NebulaKeyUtils::isEdge(spaceVidLen_, key)) {
+    // The edge prefix of the source vertex and the edge type
+    auto prefix = key.subpiece(0, sizeof(PartitionID) + spaceVidLen_ + sizeof(EdgeType));
+    if (keys->edgePrefixes.empty() || folly::StringPiece(keys->edgePrefixes.back()) != prefix) {
+      keys->edgePrefixes.emplace_back(prefix.str());
+    }
+  }
+}
+
+template <typename RESP>
+void BaseProcessor<RESP>::evictCaches(GraphSpaceID spaceId, const CachedKeys& keys) {
+  if (env_->vertexCache_ != nullptr) {
+    env_->vertexCache_->evict(spaceId, keys.tagKeys);
+  }
+  if (env_->adjacencyCache_ != nullptr) {
+    env_->adjacencyCache_->evict(spaceId, keys.edgePrefixes);
+  }
+}
+
 template <typename RESP>
 void BaseProcessor<RESP>::doRemoveRange(GraphSpaceID spaceId,
                                         PartitionID partId,
@@ -170,11 +238,50 @@ StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(const meta::NebulaSchema
   return std::move(rowWrite).moveEncodedStr();
 }
 
+template <typename RESP>
+nebula::cpp2::ErrorCode BaseProcessor<RESP>::findOldValues(GraphSpaceID spaceId,
+                                                           PartitionID partId,
+                                                           const std::vector<std::string>& keys,
+                                                           std::vector<std::string>* values) {
+  values->clear();
+  values->resize(keys.size());
+  if (keys.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  // The keys sorted are looked up in the same block and file together by the MultiGet of rocksdb
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t l, size_t r) { return keys[l] < keys[r]; });
+  std::vector<std::string> sortedKeys;
+  sortedKeys.reserve(keys.size());
+  for (auto i : order) {
+    sortedKeys.emplace_back(keys[i]);
+  }
+  std::vector<std::string> sortedValues;
+  auto ret = env_->kvstore_->multiGet(spaceId, partId, sortedKeys, &sortedValues);
+  if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+      ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+    LOG(ERROR) << "Error! ret = " << apache::thrift::util::enumNameSafe(ret.first) << ", spaceId "
+               << spaceId;
+    return ret.first;
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    const auto& status = ret.second[i];
+    if (status.ok()) {
+      (*values)[order[i]] = std::move(sortedValues[i]);
+    } else if (!status.isKeyNotFound()) {
+      LOG(ERROR) << "Error! status = " << status << ", spaceId " << spaceId;
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 template <typename RESP>
 nebula::cpp2::ErrorCode BaseProcessor<RESP>::checkStatType(
     const meta::NebulaSchemaProvider::SchemaField& field, cpp2::StatType statType) {
-  // todo(doodle): how to deal with nullable fields? For now, null add anything
-  // is null, if there is even one null, the result will be invalid
+  // todo(doodle): how to deal with nullable fields? The stats of GetNeighbors skip the nulls like
+  // the aggregate functions of graph, but the ones of lookup are null if there is any null
   auto fType = field.type();
   switch (statType) {
     case cpp2::StatType::SUM:
@@ -190,7 +297,8 @@ nebula::cpp2::ErrorCode BaseProcessor<RESP>::checkStatType(
       }
       return nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
     }
-    case cpp2::StatType::COUNT: {
+    case cpp2::StatType::COUNT:
+    case cpp2::StatType::COLLECT_SET: {
       break;
     }
   }
@@ -6,6 +6,7 @@
 #ifndef STORAGE_BASEPROCESSOR_H_
 #define STORAGE_BASEPROCESSOR_H_
 
+#include <folly/Random.h>
 #include <folly/SpinLock.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/Promise.h>
@@ -16,8 +17,13 @@
 #include "common/base/Base.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
+#include "common/tracing/Tracing.h"
 #include "common/utils/IndexKeyUtils.h"
+#include "kvstore/RocksEngineConfig.h"
+#include "kvstore/RocksPerfContext.h"
 #include "storage/CommonUtils.h"
+#include "storage/StorageFlags.h"
+#include "storage/stats/StorageStats.h"
 
 namespace nebula {
 namespace storage {
@@ -38,25 +44,61 @@ class BaseProcessor {
     return promise_.getFuture();
   }
 
+  /**
+   * @brief Begin the span of the request if the rpc span of the client is traced, which ends when
+   * the processor is done.
+   */
+  template <typename REQ>
+  void startSpan(const char* name, const REQ& req) {
+    auto parent = tracing::traceParentOf(req);
+    if (parent.has_value()) {
+      span_ = tracing::Span::start(name, parent, tracing::SpanKind::kServer);
+    }
+  }
+
+  const tracing::Span& span() const {
+    return span_;
+  }
+
+  // The space of the request, by which the latency is labeled
+  void setRequestSpace(GraphSpaceID spaceId) {
+    requestSpace_ = spaceId;
+  }
+
   virtual void onFinished() {
     memory::MemoryCheckOffGuard guard;
     if (counters_) {
       stats::StatsManager::addValue(counters_->numCalls_);
+      stats::StatsManager::addValue(kNumForegroundRequests);
       if (!this->codes_.empty()) {
         stats::StatsManager::addValue(counters_->numErrors_);
       }
     }
 
+    if (perfStats_) {
+      // Count the reads in the thread of the request if it's finished in the same thread
+      requestPerf_.reset();
+      addPerfStats();
+    }
     this->result_.latency_in_us_ref() = this->duration_.elapsedInUSec();
     if (!profileDetail_.empty()) {
       this->result_.latency_detail_us_ref() = std::move(profileDetail_);
     }
+    for (const auto& code : this->codes_) {
+      if (code.get_code() == nebula::cpp2::ErrorCode::E_WRITE_STALLED) {
+        // The clients back off the host
+        this->result_.retry_after_ms_ref() = FLAGS_write_stall_retry_after_ms;
+        break;
+      }
+    }
     this->result_.failed_parts_ref() = this->codes_;
     this->resp_.result_ref() = std::move(this->result_);
     this->promise_.setValue(std::move(this->resp_));
 
     if (counters_) {
-      stats::StatsManager::addValue(counters_->latency_, this->duration_.elapsedInUSec());
+      auto latency = this->duration_.elapsedInUSec();
+      stats::StatsManager::addValue(counters_->latency_, latency);
+      counters_->addLatency(requestSpace_, latency);
     }
 
     delete this;
@@ -66,6 +108,7 @@ class BaseProcessor {
     memory::MemoryCheckOffGuard guard;
     if (counters_) {
       stats::StatsManager::addValue(counters_->numCalls_);
+      stats::StatsManager::addValue(kNumForegroundRequests);
       if (!this->result_.get_failed_parts().empty()) {
         stats::StatsManager::addValue(counters_->numErrors_);
       }
@@ -76,6 +119,7 @@ class BaseProcessor {
       this->result_.latency_detail_us_ref() = std::move(profileDetail_);
     }
 
+    span_.setError(memoryExceeded_ ? "memory exceeded" : "unknown error");
     cpp2::PartitionResult thriftRet;
     thriftRet.code_ref() = memoryExceeded_ ? nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED
                                            : nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -116,6 +160,27 @@ class BaseProcessor {
                      const std::string& start,
                      const std::string& end);
 
+  /**
+   * @brief Read the old values of the keys to overwrite by one MultiGet, e.g. to delete their
+   * index entries. The value of a key not found is empty.
+   */
+  nebula::cpp2::ErrorCode findOldValues(GraphSpaceID spaceId,
+                                        PartitionID partId,
+                                        const std::vector<std::string>& keys,
+                                        std::vector<std::string>* values);
+
+  /**
+   * @brief The tag keys and the edge prefixes of the keys to write, which are evicted from the
+   * caches after the write is committed. Empty for the caches which are off.
+   */
+  CachedKeys cachedKeysOf(const std::vector<kvstore::KV>& data) const;
+  CachedKeys cachedKeysOf(const std::vector<std::string>& keys) const;
+  CachedKeys cachedKeysOf(folly::StringPiece batch) const;
+
+  void evictCaches(GraphSpaceID spaceId, const CachedKeys& keys);
+
+  void addCachedKey(folly::StringPiece key, CachedKeys* keys) const;
+
   nebula::cpp2::ErrorCode writeResultTo(WriteResult code, bool isEdge);
 
   nebula::meta::cpp2::ColumnDef columnDef(std::string name, nebula::cpp2::PropertyType type);
@@ -138,6 +203,41 @@ class BaseProcessor {
                                      const std::vector<Value>& props,
                                      WriteResult& wRet);
 
+  /**
+   * @brief Decide whether to count the rocksdb perf context of the reads of the request, which is
+   * always done when it's profiled, or else by FLAGS_rocksdb_perf_context_sample_ratio. Called
+   * after profileDetailFlag_ is set, in the thread of the request, whose reads are counted until
+   * it's finished. The parts run by the executor count their own by perfScope.
+   */
+  void samplePerfContext() {
+    auto ratio = FLAGS_rocksdb_perf_context_sample_ratio;
+    if (profileDetailFlag_ || (ratio > 0 && folly::Random::randDouble01() < ratio)) {
+      perfStats_ = std::make_unique<kvstore::RocksPerfStats>();
+      requestPerf_.emplace(perfStats_.get());
+    }
+  }
+
+  // Count the rocksdb perf context of the current thread until the scope returned is destroyed
+  kvstore::RocksPerfScope perfScope() {
+    return kvstore::RocksPerfScope(perfStats_.get());
+  }
+
+  // Add the perf context counted to the counters of the processor, and to the profile
+  void addPerfStats() {
+    if (counters_) {
+      counters_->addPerfStats(*perfStats_);
+    }
+    if (!profileDetailFlag_) {
+      return;
+    }
+    for (size_t i = 0; i < kvstore::RocksPerfStats::kNumMetrics; i++) {
+      auto metric = static_cast<kvstore::RocksPerfStats::Metric>(i);
+      auto value = std::min<uint64_t>(perfStats_->get(metric), std::numeric_limits<int32_t>::max());
+      profileDetail_[std::string("Rocksdb") + kvstore::RocksPerfStats::nameOf(metric)] =
+          static_cast<int32_t>(value);
+    }
+  }
+
   virtual void profileDetail(const std::string& name, int32_t latency) {
     if (!profileDetail_.count(name)) {
       profileDetail_[name] = latency;
@@ -164,6 +264,12 @@ class BaseProcessor {
   std::mutex profileMut_;
   bool profileDetailFlag_{false};
   bool memoryExceeded_{false};
+  // Not sampled unless the request is traced by graphd
+  tracing::Span span_;
+  GraphSpaceID requestSpace_{0};
+  // Not null if the rocksdb perf context of the request is counted
+  std::unique_ptr<kvstore::RocksPerfStats> perfStats_;
+  std::optional<kvstore::RocksPerfScope> requestPerf_;
 };
 
 /// Helper class wrap the passed in Func in a MemoryTracker turned on scope.
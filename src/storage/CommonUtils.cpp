@@ -5,6 +5,9 @@
 
 #include "storage/CommonUtils.h"
 
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/Part.h"
+#include "storage/StorageFlags.h"
 #include "storage/exec/QueryUtils.h"
 
 DEFINE_bool(ttl_use_ms,
@@ -14,6 +17,23 @@ DEFINE_bool(ttl_use_ms,
 namespace nebula {
 namespace storage {
 
+bool RuntimeContext::canReadFromFollower(PartitionID partId) {
+  if (!planContext_->followerRead_ || env() == nullptr || env()->kvstore_ == nullptr) {
+    return false;
+  }
+  auto found = followerReadable_.find(partId);
+  if (found != followerReadable_.end()) {
+    return found->second;
+  }
+  bool readable = false;
+  auto part = env()->kvstore_->part(spaceId(), partId);
+  if (nebula::ok(part)) {
+    readable = nebula::value(part)->followerReadable(FLAGS_follower_read_max_lag);
+  }
+  followerReadable_.emplace(partId, readable);
+  return readable;
+}
+
 bool CommonUtils::checkDataExpiredForTTL(const meta::NebulaSchemaProvider* schema,
                                          RowReaderWrapper* reader,
                                          const std::string& ttlCol,
@@ -81,5 +101,85 @@ StatusOr<Value> CommonUtils::ttlValue(const meta::NebulaSchemaProvider* schema,
   return reader->getValueByName(std::move(ttlProp).second.second);
 }
 
+std::vector<NeighborhoodAggregate> CommonUtils::neighborhoodAggregates(
+    const meta::NebulaSchemaProvider* schema) {
+  auto definitions = schema->getProp().materialized_ref();
+  if (!definitions.has_value() || definitions->empty()) {
+    return {};
+  }
+  auto aggregates = NeighborhoodAggregate::parse(*definitions);
+  if (!aggregates.ok()) {
+    // It's checked when the edge is created
+    LOG(ERROR) << aggregates.status();
+    return {};
+  }
+  return std::move(aggregates).value();
+}
+
+nebula::cpp2::ErrorCode CommonUtils::mergeNeighborhood(
+    StorageEnv* env,
+    GraphSpaceID spaceId,
+    size_t vIdLen,
+    PartitionID partId,
+    folly::StringPiece edgeKey,
+    folly::StringPiece oldVal,
+    folly::StringPiece newVal,
+    const std::vector<NeighborhoodAggregate>& aggregates,
+    kvstore::BatchHolder* batch) {
+  auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, edgeKey);
+  auto vId = NebulaKeyUtils::getSrcId(vIdLen, edgeKey).str();
+  RowReaderWrapper oldReader;
+  RowReaderWrapper newReader;
+  for (const auto& aggregate : aggregates) {
+    auto propOf = [&](folly::StringPiece val, RowReaderWrapper* reader) -> StatusOr<Value> {
+      if (val.empty()) {
+        return Value::kEmpty;
+      }
+      if (aggregate.kind() == NeighborhoodAggregate::Kind::kCount) {
+        return Value::kNullValue;
+      }
+      if (*reader == nullptr) {
+        *reader = RowReaderWrapper::getEdgePropReader(
+            env->schemaMan_, spaceId, std::abs(edgeType), val);
+        if (*reader == nullptr) {
+          return Status::Error("Bad format edge");
+        }
+      }
+      return (*reader)->getValueByName(aggregate.prop());
+    };
+    auto oldProp = propOf(oldVal, &oldReader);
+    auto newProp = propOf(newVal, &newReader);
+    if (!oldProp.ok() || !newProp.ok()) {
+      return nebula::cpp2::ErrorCode::E_INVALID_DATA;
+    }
+    auto delta = aggregate.delta(oldProp.value(), newProp.value());
+    if (!delta.empty()) {
+      batch->merge(
+          NebulaKeyUtils::neighborhoodKey(vIdLen, partId, vId, edgeType, aggregate.toString()),
+          NeighborhoodAggregate::encode(delta));
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+bool CommonUtils::isAsyncIndex(const meta::cpp2::IndexItem& index) {
+  if (FLAGS_async_index_names.empty()) {
+    return false;
+  }
+  // The names are split again only when the flag is changed
+  thread_local std::string flag;
+  thread_local std::unordered_set<std::string> names;
+  if (flag != FLAGS_async_index_names) {
+    flag = FLAGS_async_index_names;
+    std::vector<std::string> split;
+    folly::split(',', flag, split, true);
+    names.clear();
+    for (auto& name : split) {
+      names.emplace(folly::trimWhitespace(name).str());
+    }
+  }
+  return names.count(index.get_index_name()) != 0;
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -6,8 +6,11 @@
 #ifndef STORAGE_COMMON_H_
 #define STORAGE_COMMON_H_
 
+#include <folly/Random.h>
 #include <folly/concurrency/ConcurrentHashMap.h>
 
+#include <shared_mutex>
+
 #include "codec/RowReaderWrapper.h"
 #include "common/base/Base.h"
 #include "common/base/ConcurrentLRUCache.h"
@@ -15,9 +18,13 @@
 #include "common/meta/SchemaManager.h"
 #include "common/stats/StatsManager.h"
 #include "common/utils/MemoryLockWrapper.h"
+#include "common/utils/NeighborhoodAggregate.h"
 #include "interface/gen-cpp2/storage_types.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/KVStore.h"
+#include "kvstore/LogEncoder.h"
+#include "kvstore/RocksPerfContext.h"
+#include "storage/mutate/UpdateCoalescer.h"
 
 namespace nebula {
 namespace storage {
@@ -26,16 +33,47 @@ struct ProcessorCounters {
   stats::CounterId numCalls_;
   stats::CounterId numErrors_;
   stats::CounterId latency_;
+  std::string name_;
+  // The latency histograms of the spaces, labeled by the space and the processor
+  mutable folly::ConcurrentHashMap<GraphSpaceID, std::shared_ptr<stats::LatencyHistogram>>
+      spaceLatencies_;
+  // The rocksdb perf context counters of the requests sampled, labeled by the processor
+  std::array<stats::CounterId, kvstore::RocksPerfStats::kNumMetrics> perfCounters_;
 
   virtual ~ProcessorCounters() = default;
 
+  void addLatency(GraphSpaceID spaceId, int64_t latency) const {
+    auto iter = spaceLatencies_.find(spaceId);
+    if (iter == spaceLatencies_.end()) {
+      auto histo = stats::StatsManager::latencyHisto(
+          "storage_processor_latency_us",
+          {{"processor", name_}, {"space", folly::to<std::string>(spaceId)}});
+      iter = spaceLatencies_.insert(spaceId, std::move(histo)).first;
+    }
+    iter->second->add(latency);
+  }
+
+  void addPerfStats(const kvstore::RocksPerfStats& perfStats) const {
+    for (size_t i = 0; i < kvstore::RocksPerfStats::kNumMetrics; i++) {
+      auto value = perfStats.get(static_cast<kvstore::RocksPerfStats::Metric>(i));
+      stats::StatsManager::addValue(perfCounters_[i], static_cast<int64_t>(value));
+    }
+  }
+
   virtual void init(const std::string& counterName) {
     if (!numCalls_.valid()) {
+      name_ = counterName;
       numCalls_ = stats::StatsManager::registerStats("num_" + counterName, "rate, sum");
       numErrors_ =
           stats::StatsManager::registerStats("num_" + counterName + "_errors", "rate, sum");
       latency_ = stats::StatsManager::registerHisto(
           counterName + "_latency_us", 1000, 0, 20000, "avg, p75, p95, p99");
+      for (size_t i = 0; i < kvstore::RocksPerfStats::kNumMetrics; i++) {
+        auto metric = static_cast<kvstore::RocksPerfStats::Metric>(i);
+        auto id = stats::StatsManager::registerStats(kvstore::RocksPerfStats::counterNameOf(metric),
+                                                     "rate, sum");
+        perfCounters_[i] = stats::StatsManager::counterWithLabels(id, {{"processor", name_}});
+      }
       VLOG(1) << "Succeeded in initializing the ProcessorCounters instance";
     } else {
       VLOG(1) << "ProcessorCounters instance has been initialized";
@@ -51,7 +89,91 @@ enum class IndexState {
   FINISHED,  // The part is building index successfully.
 };
 
-using VertexCache = ConcurrentLRUCache<std::pair<VertexID, TagID>, std::string>;
+/**
+ * @brief Read-through cache in front of the kvstore, keyed by the space and a kvstore key (or
+ * prefix).
+ *
+ * The readers get the epoch before reading from the kvstore, and fill what they read with it. The
+ * evictions of the keys written bump the epoch, and the fills of an older epoch are dropped, so a
+ * value read before a write is committed never outlives the eviction after the write.
+ */
+template <typename V>
+class EpochCache final {
+ public:
+  EpochCache(size_t capacity, uint32_t bucketsExp) : cache_(capacity, bucketsExp) {}
+
+  uint64_t epoch() const {
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  std::optional<V> get(GraphSpaceID spaceId, folly::StringPiece key) {
+    auto ret = cache_.get(cacheKey(spaceId, key));
+    if (!ret.ok()) {
+      return std::nullopt;
+    }
+    return std::move(ret).value();
+  }
+
+  /**
+   * @brief Cache the value read from the kvstore, unless any key has been evicted since epoch.
+   */
+  void fill(GraphSpaceID spaceId, folly::StringPiece key, V value, uint64_t epoch) {
+    std::shared_lock<std::shared_mutex> guard(lock_);
+    if (epoch_.load(std::memory_order_acquire) != epoch) {
+      return;
+    }
+    cache_.insert(cacheKey(spaceId, key), std::move(value));
+  }
+
+  void evict(GraphSpaceID spaceId, const std::vector<std::string>& keys) {
+    if (keys.empty()) {
+      return;
+    }
+    std::unique_lock<std::shared_mutex> guard(lock_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (const auto& key : keys) {
+      cache_.evict(cacheKey(spaceId, key));
+    }
+  }
+
+  void clear() {
+    std::unique_lock<std::shared_mutex> guard(lock_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    cache_.clear();
+  }
+
+ private:
+  static std::string cacheKey(GraphSpaceID spaceId, folly::StringPiece key) {
+    std::string ret;
+    ret.reserve(sizeof(GraphSpaceID) + key.size());
+    ret.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID))
+        .append(key.data(), key.size());
+    return ret;
+  }
+
+  ConcurrentLRUCache<std::string, V> cache_;
+  std::atomic<uint64_t> epoch_{0};
+  // Shared by the fills and exclusive for the evictions, so a fill checks the epoch and inserts the
+  // value at once
+  std::shared_mutex lock_;
+};
+
+// The tag rows keyed by the tag keys
+using VertexCache = EpochCache<std::string>;
+
+// The edge rows of a source vertex and an edge type, in the order of the keys, keyed by the edge
+// prefix of them
+using AdjacencyBlock = std::shared_ptr<const std::vector<kvstore::KV>>;
+using AdjacencyCache = EpochCache<AdjacencyBlock>;
+
+/**
+ * @brief The keys written by a request which are evicted from the caches after the write.
+ */
+struct CachedKeys {
+  std::vector<std::string> tagKeys;
+  std::vector<std::string> edgePrefixes;
+};
+
 using IndexKey = std::tuple<GraphSpaceID, PartitionID>;
 using IndexGuard = folly::ConcurrentHashMap<IndexKey, IndexState>;
 
@@ -80,7 +202,16 @@ class StorageEnv {
   std::unique_ptr<VerticesMemLock> verticesML_{nullptr};
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
+  // nullptr if the vertex cache is off
+  std::unique_ptr<VertexCache> vertexCache_{nullptr};
+  // nullptr if the adjacency cache is off
+  std::unique_ptr<AdjacencyCache> adjacencyCache_{nullptr};
+  // nullptr if the updates are not coalesced
+  std::unique_ptr<UpdateCoalescer> updateCoalescer_{nullptr};
   int32_t adminSeqId_{0};
+  // The time in microseconds of each part, before which the writes are all applied to the async
+  // indexes, advanced by the AsyncIndexApplier
+  folly::ConcurrentHashMap<IndexKey, int64_t> asyncIndexWatermark_;
 
   IndexState getIndexState(GraphSpaceID space, PartitionID part) {
     auto key = std::make_tuple(space, part);
@@ -98,6 +229,14 @@ class StorageEnv {
   bool checkIndexLocked(IndexState indexState) {
     return indexState == IndexState::LOCKED;
   }
+
+  int64_t getAsyncIndexWatermark(GraphSpaceID space, PartitionID part) {
+    auto iter = asyncIndexWatermark_.find(std::make_tuple(space, part));
+    if (iter != asyncIndexWatermark_.cend()) {
+      return iter->second;
+    }
+    return 0;
+  }
 };
 
 class IndexCountWrapper {
@@ -164,6 +303,8 @@ class PlanContext {
       auto& common = commonRef.value();
       sessionId_ = common.session_id_ref().value_or(0);
       planId_ = common.plan_id_ref().value_or(0);
+      followerRead_ = common.follower_read_ref().value_or(false);
+      sampleRatio_ = common.sample_ratio_ref().value_or(1.0);
     }
   }
 
@@ -183,6 +324,12 @@ class PlanContext {
   // will be true if query is killed during execution
   bool isKilled_ = false;
 
+  // whether the request allows the followers to serve the reads
+  bool followerRead_ = false;
+
+  // the ratio of the vertices and edges kept by the scans
+  double sampleRatio_ = 1.0;
+
   // Manage expressions
   ObjectPool objPool_;
 };
@@ -226,6 +373,24 @@ struct RuntimeContext {
            env()->metaClient_->checkIsPlanKilled(planContext_->sessionId_, planContext_->planId_);
   }
 
+  /**
+   * @brief Whether the reads of the part are served by current host as a follower, which requires
+   * the request allows the follower read and the part is within follower_read_max_lag logs behind
+   * the leader. It's checked once for each part during the request.
+   *
+   * @param partId Partition to read
+   */
+  bool canReadFromFollower(PartitionID partId);
+
+  /**
+   * @brief Whether a vertex or an edge scanned is kept by the Bernoulli sampling of the request,
+   * i.e. with the probability of its sample_ratio. It's called before the row is decoded.
+   */
+  bool sampled() const {
+    return planContext_->sampleRatio_ >= 1.0 ||
+           folly::Random::randDouble01() < planContext_->sampleRatio_;
+  }
+
   PlanContext* planContext_;
   TagID tagId_ = 0;
   std::string tagName_ = "";
@@ -247,6 +412,9 @@ struct RuntimeContext {
   bool filterInvalidResultOut = false;
 
   ResultStatus resultStat_{ResultStatus::NORMAL};
+
+  // partId -> whether current host reads the part as a follower
+  std::unordered_map<PartitionID, bool> followerReadable_;
 };
 
 class CommonUtils final {
@@ -275,6 +443,36 @@ class CommonUtils final {
 
   static StatusOr<Value> ttlValue(const meta::NebulaSchemaProvider* schema,
                                   RowReaderWrapper* reader);
+
+  /**
+   * @brief Whether the index is maintained asynchronously, i.e. named in async_index_names
+   */
+  static bool isAsyncIndex(const meta::cpp2::IndexItem& index);
+
+  /**
+   * @brief The aggregates materialized of the edges of the schema, none if they are not defined
+   */
+  static std::vector<NeighborhoodAggregate> neighborhoodAggregates(
+      const meta::NebulaSchemaProvider* schema);
+
+  /**
+   * @brief Merge the changes of the aggregates materialized by the write of an edge into batch
+   *
+   * @param edgeKey Key of the edge, the aggregates of its first vertex are changed
+   * @param oldVal Value of the edge before the write, empty if it didn't exist
+   * @param newVal Value of the edge after the write, empty if it's deleted
+   * @return nebula::cpp2::ErrorCode E_INVALID_DATA if a value is not decoded
+   */
+  static nebula::cpp2::ErrorCode mergeNeighborhood(
+      StorageEnv* env,
+      GraphSpaceID spaceId,
+      size_t vIdLen,
+      PartitionID partId,
+      folly::StringPiece edgeKey,
+      folly::StringPiece oldVal,
+      folly::StringPiece newVal,
+      const std::vector<NeighborhoodAggregate>& aggregates,
+      kvstore::BatchHolder* batch);
 };
 
 }  // namespace storage
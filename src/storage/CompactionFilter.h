@@ -6,9 +6,14 @@
 #ifndef STORAGE_COMPACTIONFILTER_H_
 #define STORAGE_COMPACTIONFILTER_H_
 
+#include <folly/container/F14Map.h>
+
 #include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
 #include "common/base/Base.h"
+#include "common/expression/Expression.h"
 #include "common/meta/NebulaSchemaProvider.h"
+#include "common/utils/DefaultValueContext.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
@@ -16,9 +21,7 @@
 #include "storage/CommonUtils.h"
 #include "storage/StorageFlags.h"
 
-DEFINE_int32(min_level_for_custom_filter,
-             0,
-             "Minimal level compaction which will go through custom compaction filter");
+DECLARE_bool(ttl_use_ms);
 
 namespace nebula {
 namespace storage {
@@ -51,6 +54,8 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
       return true;
     } else if (NebulaKeyUtils::isLock(vIdLen_, key)) {
       return !lockValid(spaceId, key);
+    } else if (NebulaKeyUtils::isNeighborhood(key)) {
+      return !neighborhoodValid(spaceId, key);
     } else {
       // skip uuid/system/operation
       VLOG(3) << "Skip the system key inside, key " << key;
@@ -58,7 +63,188 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     return false;
   }
 
+  std::optional<int64_t> expireTime(GraphSpaceID spaceId,
+                                    const folly::StringPiece& key,
+                                    const folly::StringPiece& val) const override {
+    if (NebulaKeyUtils::isTag(vIdLen_, key)) {
+      auto tagId = NebulaKeyUtils::getTagId(vIdLen_, key);
+      auto schema = schemaMan_->getTagSchema(spaceId, tagId);
+      if (!schema) {
+        return std::nullopt;
+      }
+      auto reader = RowReaderWrapper::getTagPropReader(schemaMan_, spaceId, tagId, val);
+      return expireTime(schema.get(), reader.get());
+    } else if (NebulaKeyUtils::isEdge(vIdLen_, key)) {
+      auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen_, key);
+      if (edgeType < 0 && val.empty()) {
+        return std::nullopt;
+      }
+      auto schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
+      if (!schema) {
+        return std::nullopt;
+      }
+      auto reader =
+          RowReaderWrapper::getEdgePropReader(schemaMan_, spaceId, std::abs(edgeType), val);
+      return expireTime(schema.get(), reader.get());
+    } else if (IndexKeyUtils::isIndexKey(key) && !val.empty()) {
+      auto indexId = IndexKeyUtils::getIndexId(key);
+      std::shared_ptr<const meta::NebulaSchemaProvider> schema;
+      auto eRet = indexMan_->getEdgeIndex(spaceId, indexId);
+      if (eRet.ok()) {
+        schema = schemaMan_->getEdgeSchema(spaceId,
+                                           eRet.value()->get_schema_id().get_edge_type());
+      } else {
+        auto tRet = indexMan_->getTagIndex(spaceId, indexId);
+        if (!tRet.ok()) {
+          return std::nullopt;
+        }
+        schema = schemaMan_->getTagSchema(spaceId, tRet.value()->get_schema_id().get_tag_id());
+      }
+      if (!schema) {
+        return std::nullopt;
+      }
+      return expireTime(schema.get(), IndexKeyUtils::parseIndexTTL(val));
+    }
+    return std::nullopt;
+  }
+
+  // Upgrade the rows in the older schema versions to the latest one, by compaction_upgrade_rows
+  bool rewrite(GraphSpaceID spaceId,
+               const folly::StringPiece& key,
+               const folly::StringPiece& val,
+               std::string* newVal) const override {
+    if (!FLAGS_compaction_upgrade_rows || val.empty()) {
+      return false;
+    }
+    std::shared_ptr<const meta::NebulaSchemaProvider> latest;
+    RowReaderWrapper reader;
+    int32_t schemaId;
+    if (NebulaKeyUtils::isTag(vIdLen_, key)) {
+      auto tagId = NebulaKeyUtils::getTagId(vIdLen_, key);
+      latest = schemaMan_->getTagSchema(spaceId, tagId);
+      if (!latest || !outdated(latest.get(), val)) {
+        return false;
+      }
+      reader = RowReaderWrapper::getTagPropReader(schemaMan_, spaceId, tagId, val);
+      schemaId = tagId;
+    } else if (NebulaKeyUtils::isEdge(vIdLen_, key)) {
+      auto edgeType = std::abs(NebulaKeyUtils::getEdgeType(vIdLen_, key));
+      latest = schemaMan_->getEdgeSchema(spaceId, edgeType);
+      if (!latest || !outdated(latest.get(), val)) {
+        return false;
+      }
+      reader = RowReaderWrapper::getEdgePropReader(schemaMan_, spaceId, edgeType, val);
+      // The edge types are negative in the keys of the schemas cached, to tell them from the tags
+      schemaId = -edgeType;
+    } else {
+      return false;
+    }
+    if (reader == nullptr) {
+      return false;
+    }
+    return upgrade(schemaId, latest.get(), &reader, newVal);
+  }
+
  private:
+  // Whether the row is not encoded by RowWriterV2 in the latest schema version
+  static bool outdated(const meta::NebulaSchemaProvider* latest, const folly::StringPiece& val) {
+    SchemaVer schemaVer;
+    int32_t readerVer;
+    RowReaderWrapper::getVersions(val, schemaVer, readerVer);
+    return schemaVer != latest->getVersion() || readerVer != 2;
+  }
+
+  bool upgrade(int32_t schemaId,
+               const meta::NebulaSchemaProvider* latest,
+               RowReaderWrapper* reader,
+               std::string* newVal) const {
+    const auto* schema = reader->getSchema();
+    const auto* missing = missingValues(schemaId, latest, schema);
+    if (missing == nullptr) {
+      return false;
+    }
+    RowWriterV2 writer(latest);
+    for (size_t i = 0; i < latest->getNumFields(); i++) {
+      const auto* name = latest->getFieldName(i);
+      auto value =
+          schema->getFieldIndex(name) >= 0 ? reader->getValueByName(name) : (*missing)[i];
+      if (writer.setValue(i, value) != WriteResult::SUCCEEDED) {
+        return false;
+      }
+    }
+    if (writer.finish() != WriteResult::SUCCEEDED) {
+      return false;
+    }
+    *newVal = writer.moveEncodedStr();
+    return true;
+  }
+
+  // The values in the row of schema of the fields added in latest, which are read as the default
+  // values or null. nullptr if a default value is not a constant, e.g. now(), which is evaluated
+  // at the time read, or a field has neither default value nor null, so the row is kept as is.
+  const std::vector<Value>* missingValues(int32_t schemaId,
+                                          const meta::NebulaSchemaProvider* latest,
+                                          const meta::NebulaSchemaProvider* schema) const {
+    auto key = std::make_tuple(schemaId, latest->getVersion(), schema->getVersion());
+    auto iter = missing_.find(key);
+    if (iter != missing_.end()) {
+      return iter->second ? &iter->second.value() : nullptr;
+    }
+    std::optional<std::vector<Value>> values(std::in_place, latest->getNumFields());
+    for (size_t i = 0; i < latest->getNumFields() && values; i++) {
+      const auto* field = latest->field(i);
+      if (schema->getFieldIndex(field->name()) >= 0) {
+        continue;
+      }
+      if (field->hasDefault()) {
+        ObjectPool pool;
+        const auto& exprStr = field->defaultValue();
+        auto* expr = Expression::decode(&pool, folly::StringPiece(exprStr.data(), exprStr.size()));
+        if (expr == nullptr || expr->kind() != Expression::Kind::kConstant) {
+          values.reset();
+          break;
+        }
+        DefaultValueContext expCtx;
+        (*values)[i] = Expression::eval(expr, expCtx);
+      } else if (field->nullable()) {
+        (*values)[i] = Value::kNullValue;
+      } else {
+        values.reset();
+      }
+    }
+    auto& entry = missing_[key];
+    entry = std::move(values);
+    return entry ? &entry.value() : nullptr;
+  }
+
+  std::optional<int64_t> expireTime(const meta::NebulaSchemaProvider* schema,
+                                    nebula::RowReaderWrapper* reader) const {
+    if (reader == nullptr) {
+      return std::nullopt;
+    }
+    auto v = CommonUtils::ttlValue(schema, reader);
+    if (!v.ok()) {
+      return std::nullopt;
+    }
+    return expireTime(schema, v.value());
+  }
+
+  // The time in milliseconds the row of ttl value v expires at
+  std::optional<int64_t> expireTime(const meta::NebulaSchemaProvider* schema,
+                                    const Value& v) const {
+    auto ttl = CommonUtils::ttlProps(schema);
+    if (!ttl.first || !v.isInt()) {
+      return std::nullopt;
+    }
+    const auto& ftype = schema->getFieldType(ttl.second.second);
+    if (ftype != nebula::cpp2::PropertyType::TIMESTAMP &&
+        ftype != nebula::cpp2::PropertyType::INT64) {
+      return std::nullopt;
+    }
+    auto expire = v.getInt() + ttl.second.first;
+    return FLAGS_ttl_use_ms ? expire : expire * 1000;
+  }
+
   bool tagValid(GraphSpaceID spaceId,
                 const folly::StringPiece& key,
                 const folly::StringPiece& val) const {
@@ -115,6 +301,17 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     return true;
   }
 
+  // The aggregates materialized are dropped with the edge type
+  bool neighborhoodValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
+    auto edgeType = NebulaKeyUtils::getNeighborhoodEdgeType(vIdLen_, key);
+    auto schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
+    if (!schema) {
+      VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
+      return false;
+    }
+    return true;
+  }
+
   // TODO(panda) Optimize the method in the future
   bool ttlExpired(const meta::NebulaSchemaProvider* schema,
                   nebula::RowReaderWrapper* reader) const {
@@ -183,6 +380,11 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
   meta::SchemaManager* schemaMan_ = nullptr;
   meta::IndexManager* indexMan_ = nullptr;
   size_t vIdLen_;
+  // The missing values of the schema id, the latest version and the version of the row. The filter
+  // is used by one compaction thread.
+  mutable folly::F14FastMap<std::tuple<int32_t, SchemaVer, SchemaVer>,
+                            std::optional<std::vector<Value>>>
+      missing_;
 };
 
 class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterFactory {
@@ -5,24 +5,17 @@
 
 #include "GraphStorageLocalServer.h"
 
-#include <folly/ExceptionWrapper.h>
 #include <unistd.h>
 
 #include "common/base/Base.h"
 #include "storage/GraphStorageServiceHandler.h"
 
-using folly::exception_wrapper;
-
-#define LOCAL_RETURN_FUTURE(RespType, callFunc)                                                  \
-  auto promise = std::make_shared<folly::Promise<RespType>>();                                   \
-  auto f = promise->getFuture();                                                                 \
-  threadManager_->add([this, promise, request] {                                                 \
-    std::dynamic_pointer_cast<GraphStorageServiceHandler>(handler_)                              \
-        ->callFunc(std::move(request))                                                           \
-        .thenValue([promise](RespType&& resp) { promise->setValue(std::move(resp)); })           \
-        .thenError([promise](exception_wrapper&& ex) { promise->setException(std::move(ex)); }); \
-  });                                                                                            \
-  return f;
+// The request is run by the handler in the thread manager of storage like a thrift request, and
+// the response is moved back without serialization
+#define LOCAL_RETURN_FUTURE(RespType, callFunc)                                      \
+  return folly::via(threadManager_.get(), [handler = graphHandler_, request]() {     \
+    return handler->callFunc(request);                                               \
+  });
 
 namespace nebula::storage {
 
@@ -37,6 +30,8 @@ void GraphStorageLocalServer::setThreadManager(
 void GraphStorageLocalServer::setInterface(
     std::shared_ptr<apache::thrift::ServerInterface> handler) {
   handler_ = handler;
+  graphHandler_ = std::dynamic_pointer_cast<GraphStorageServiceHandler>(handler_).get();
+  CHECK(graphHandler_ != nullptr);
 }
 
 folly::Future<cpp2::GetNeighborsResponse> GraphStorageLocalServer::future_getNeighbors(
@@ -17,6 +17,8 @@
 #include "folly/fibers/Semaphore.h"
 #include "interface/gen-cpp2/GraphStorageServiceAsyncClient.h"
 namespace nebula::storage {
+class GraphStorageServiceHandler;
+
 class GraphStorageLocalServer final : public boost::noncopyable, public nebula::cpp::NonMovable {
  public:
   static std::shared_ptr<GraphStorageLocalServer> getInstance() {
@@ -61,6 +63,8 @@ class GraphStorageLocalServer final : public boost::noncopyable, public nebula::
  private:
   std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager_;
   std::shared_ptr<apache::thrift::ServerInterface> handler_;
+  // The handler_ cast once instead of on each request
+  GraphStorageServiceHandler* graphHandler_{nullptr};
 };
 }  // namespace nebula::storage
 #endif
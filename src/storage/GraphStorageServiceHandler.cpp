@@ -6,6 +6,8 @@
 #include "storage/GraphStorageServiceHandler.h"
 
 #include "common/memory/MemoryTracker.h"
+#include "common/stats/ContentionStats.h"
+#include "common/thrift/ThreadManagerObserver.h"
 #include "storage/index/LookupProcessor.h"
 #include "storage/kv/GetProcessor.h"
 #include "storage/kv/PutProcessor.h"
@@ -31,20 +33,24 @@
 //    Processors DO NOT NEED handle error in their logic.
 //  else (do some work in another thread)
 //    Processors need handle error in that thread by itself
-#define RETURN_FUTURE(processor)             \
-  auto f = processor->getFuture();           \
-  try {                                      \
-    processor->process(req);                 \
-  } catch (std::bad_alloc & e) {             \
-    LOG(ERROR) << processor << " bad_alloc"; \
-    processor->memoryExceeded();             \
-    processor->onError();                    \
-  } catch (std::exception & e) {             \
-    LOG(ERROR) << e.what();                  \
-    processor->onError();                    \
-  } catch (...) {                            \
-    processor->onError();                    \
-  }                                          \
+//  The raft commits of the processor are traced as the children of its span, if it's traced.
+#define RETURN_FUTURE(processor)                  \
+  auto f = processor->getFuture();                \
+  processor->startSpan(__func__, req);            \
+  processor->setRequestSpace(req.get_space_id()); \
+  tracing::SpanScope scope(processor->span());    \
+  try {                                           \
+    processor->process(req);                      \
+  } catch (std::bad_alloc & e) {                  \
+    LOG(ERROR) << processor << " bad_alloc";      \
+    processor->memoryExceeded();                  \
+    processor->onError();                         \
+  } catch (std::exception & e) {                  \
+    LOG(ERROR) << e.what();                       \
+    processor->onError();                         \
+  } catch (...) {                                 \
+    processor->onError();                         \
+  }                                               \
   return f;
 
 namespace nebula {
@@ -53,8 +59,22 @@ namespace storage {
 GraphStorageServiceHandler::GraphStorageServiceHandler(StorageEnv* env) : env_(env) {
   if (FLAGS_reader_handlers_type == "io") {
     auto tf = std::make_shared<folly::NamedThreadFactory>("reader-pool");
-    readerPool_ =
+    auto pool =
         std::make_shared<folly::IOThreadPoolExecutor>(FLAGS_reader_handlers, std::move(tf));
+    auto executorStats = stats::ExecutorStats::of("reader-pool");
+    pool->subscribeToTaskStats([executorStats](const folly::ThreadPoolExecutor::TaskStats& ts) {
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+      executorStats->onRun(duration_cast<microseconds>(ts.waitTime),
+                           duration_cast<microseconds>(ts.runTime));
+    });
+    std::weak_ptr<folly::IOThreadPoolExecutor> weak = pool;
+    stats::StatsManager::registerGauge(
+        "executor_pending_tasks", {{"pool", "reader-pool"}}, [weak]() -> int64_t {
+          auto locked = weak.lock();
+          return locked == nullptr ? 0 : static_cast<int64_t>(locked->getPendingTaskCount());
+        });
+    readerPool_ = std::move(pool);
   } else {
     if (FLAGS_reader_handlers_type != "cpu") {
       LOG(WARNING) << "Unknown value for --reader_handlers_type, using `cpu'";
@@ -63,6 +83,7 @@ GraphStorageServiceHandler::GraphStorageServiceHandler(StorageEnv* env) : env_(e
     auto pool = TM::newPriorityThreadManager(FLAGS_reader_handlers);
     pool->setNamePrefix("reader-pool");
     pool->start();
+    watchThreadManager("reader-pool", pool);
     readerPool_ = std::move(pool);
   }
 
@@ -9,10 +9,16 @@
 #include <rocksdb/merge_operator.h>
 
 #include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "common/utils/NeighborhoodAggregate.h"
 
 namespace nebula {
 namespace storage {
 
+/**
+ * @brief The merge operator of storage, which merges the changes of the aggregates materialized of
+ * the edges of the vertices, see NeighborhoodAggregate. The other keys are never merged.
+ */
 class NebulaOperator : public rocksdb::MergeOperator {
  public:
   const char* Name() const override {
@@ -22,10 +28,26 @@ class NebulaOperator : public rocksdb::MergeOperator {
  private:
   bool FullMergeV2(const MergeOperationInput& merge_in,
                    MergeOperationOutput* merge_out) const override {
-    UNUSED(merge_in);
-    UNUSED(merge_out);
-    LOG(ERROR) << "NebulaMergeOperator not supported yet";
-    return false;
+    if (!NebulaKeyUtils::isNeighborhood(toStringPiece(merge_in.key))) {
+      LOG(ERROR) << "NebulaMergeOperator not supported of the key " << toStringPiece(merge_in.key);
+      return false;
+    }
+    try {
+      Value merged;
+      if (merge_in.existing_value != nullptr) {
+        merged = NeighborhoodAggregate::decode(toStringPiece(*merge_in.existing_value));
+      }
+      for (const auto& operand : merge_in.operand_list) {
+        merged = NeighborhoodAggregate::merge(
+            merged, NeighborhoodAggregate::decode(toStringPiece(operand)));
+      }
+      merge_out->new_value = NeighborhoodAggregate::encode(merged);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Bad materialized aggregate of the key " << toStringPiece(merge_in.key) << ": "
+                 << e.what();
+      return false;
+    }
+    return true;
   }
 
   bool PartialMerge(const rocksdb::Slice& key,
@@ -33,13 +55,23 @@ class NebulaOperator : public rocksdb::MergeOperator {
                     const rocksdb::Slice& right_operand,
                     std::string* new_value,
                     rocksdb::Logger* logger) const override {
-    UNUSED(key);
-    UNUSED(left_operand);
-    UNUSED(right_operand);
-    UNUSED(new_value);
     UNUSED(logger);
-    LOG(ERROR) << "NebulaMergeOperator not supported yet";
-    return false;
+    if (!NebulaKeyUtils::isNeighborhood(toStringPiece(key))) {
+      return false;
+    }
+    try {
+      // The changes are added, so any two of them are merged into one
+      auto lhs = NeighborhoodAggregate::decode(toStringPiece(left_operand));
+      auto rhs = NeighborhoodAggregate::decode(toStringPiece(right_operand));
+      *new_value = NeighborhoodAggregate::encode(NeighborhoodAggregate::merge(lhs, rhs));
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
+  static folly::StringPiece toStringPiece(const rocksdb::Slice& slice) {
+    return folly::StringPiece(slice.data(), slice.size());
   }
 };
 
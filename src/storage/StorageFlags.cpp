@@ -28,6 +28,11 @@ DEFINE_uint32(rebuild_index_part_rate_limit,
 
 DEFINE_uint32(rebuild_index_batch_size, 1024 * 128, "batch size for rebuild index, in bytes");
 
+DEFINE_uint32(rebuild_index_inflight_batches,
+              4,
+              "max batches of the index keys of a part being written by raft at a time when "
+              "rebuilding index, the part is scanned on meanwhile");
+
 DEFINE_int32(reader_handlers, 32, "Total reader handlers");
 
 DEFINE_uint64(default_mvcc_ver,
@@ -40,6 +45,15 @@ DEFINE_string(reader_handlers_type, "cpu", "Type of reader handlers, options: cp
 
 DEFINE_bool(trace_toss, false, "output verbose log of toss");
 
+DEFINE_bool(enable_toss, false, "whether the chain add edges of toss are processed");
+
+DEFINE_int32(toss_chain_pipeline_depth,
+             2,
+             "max chains of a pair of local part and remote part running at the same time, the "
+             "chain add edges coming while they are all running are merged into the next ones");
+
+DEFINE_int32(toss_batch_max_edges, 512, "max edges of the chain add edges merged into a chain");
+
 DEFINE_int32(max_edge_returned_per_vertex, INT_MAX, "Max edge number returned searching vertex");
 
 DEFINE_bool(query_concurrently,
@@ -47,4 +61,80 @@ DEFINE_bool(query_concurrently,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
 
+DEFINE_int32(query_concurrently_min_vids,
+             32,
+             "the go requests of fewer vids run in a single thread even if query_concurrently is "
+             "on, since the fan-out costs more than the work");
+
+DEFINE_int32(query_concurrently_vids_per_task,
+             256,
+             "the vids of a part in a go request are split into the tasks of at most this many "
+             "vids when running concurrently, so a hot part doesn't stall a single thread");
+
 DEFINE_bool(use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_bool(enable_vertex_cache, false, "whether to cache the tag rows read by the queries");
+
+DEFINE_int32(vertex_cache_num, 16 * 1000 * 1000, "max number of the tag rows in the vertex cache");
+
+DEFINE_int32(vertex_cache_bucket_exp, 4, "the vertex cache has 2^vertex_cache_bucket_exp buckets");
+
+DEFINE_bool(enable_adjacency_cache,
+            false,
+            "whether to cache the edge rows of the vertices expanded by the queries");
+
+DEFINE_int32(adjacency_cache_num,
+             100 * 1000,
+             "max number of the edge blocks, each of a vertex and an edge type, in the cache");
+
+DEFINE_int32(adjacency_cache_bucket_exp,
+             4,
+             "the adjacency cache has 2^adjacency_cache_bucket_exp buckets");
+
+DEFINE_int32(adjacency_cache_max_edges,
+             1024,
+             "the edge blocks having more edges than it are not cached");
+
+DEFINE_int64(follower_read_max_lag,
+             1000,
+             "max count of committed logs a follower could fall behind the leader to serve the "
+             "follower reads");
+
+DEFINE_string(async_index_names,
+              "",
+              "comma separated names of the indexes maintained asynchronously, whose entries are "
+              "applied by the background applier after the writes return");
+
+DEFINE_int32(async_index_interval_ms, 100, "interval of the passes of the async index applier");
+
+DEFINE_int32(async_index_batch_size, 1024, "max count of the rows applied in a pass of a part");
+
+DEFINE_int32(update_lock_wait_ms,
+             1000,
+             "max time the updates of a vertex or an edge wait for the updates of it running, 0 "
+             "means to fail with E_DATA_CONFLICT_ERROR at once");
+
+DEFINE_bool(enable_update_coalescing,
+            true,
+            "whether the writes of the updates of a part submitted while one is being appended are "
+            "merged into one raft entry, the next update of a row reading the row not committed");
+
+DEFINE_int32(write_stall_retry_after_ms,
+             500,
+             "the delay suggested to the clients to retry after, when the writes are rejected as "
+             "rocksdb stops them");
+
+DEFINE_int32(delete_range_min_keys,
+             16,
+             "the tags of the vertices deleted from a part are removed by one range tombstone for "
+             "each vertex once the part has at least so many keys removed and the tags have no "
+             "index, 0 means always by point deletes");
+
+DEFINE_int32(min_level_for_custom_filter,
+             0,
+             "Minimal level compaction which will go through custom compaction filter");
+
+DEFINE_bool(compaction_upgrade_rows,
+            false,
+            "whether the compactions rewrite the rows of the tags and the edges in the older "
+            "schema versions in the latest one, so the reads of them need no other schema");
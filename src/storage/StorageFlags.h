@@ -22,6 +22,8 @@ DECLARE_uint32(rebuild_index_part_rate_limit);
 
 DECLARE_uint32(rebuild_index_batch_size);
 
+DECLARE_uint32(rebuild_index_inflight_batches);
+
 DECLARE_int32(reader_handlers);
 
 DECLARE_uint64(default_mvcc_ver);
@@ -30,10 +32,54 @@ DECLARE_string(reader_handlers_type);
 
 DECLARE_bool(trace_toss);
 
+DECLARE_bool(enable_toss);
+
+DECLARE_int32(toss_chain_pipeline_depth);
+
+DECLARE_int32(toss_batch_max_edges);
+
 DECLARE_int32(max_edge_returned_per_vertex);
 
 DECLARE_bool(query_concurrently);
 
+DECLARE_int32(query_concurrently_min_vids);
+
+DECLARE_int32(query_concurrently_vids_per_task);
+
 DECLARE_bool(use_vertex_key);
 
+DECLARE_bool(enable_vertex_cache);
+
+DECLARE_int32(vertex_cache_num);
+
+DECLARE_int32(vertex_cache_bucket_exp);
+
+DECLARE_bool(enable_adjacency_cache);
+
+DECLARE_int32(adjacency_cache_num);
+
+DECLARE_int32(adjacency_cache_bucket_exp);
+
+DECLARE_int32(adjacency_cache_max_edges);
+
+DECLARE_int64(follower_read_max_lag);
+
+DECLARE_string(async_index_names);
+
+DECLARE_int32(async_index_interval_ms);
+
+DECLARE_int32(async_index_batch_size);
+
+DECLARE_int32(update_lock_wait_ms);
+
+DECLARE_bool(enable_update_coalescing);
+
+DECLARE_int32(write_stall_retry_after_ms);
+
+DECLARE_int32(delete_range_min_keys);
+
+DECLARE_int32(min_level_for_custom_filter);
+
+DECLARE_bool(compaction_upgrade_rows);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
@@ -11,11 +11,13 @@
 
 #include "common/hdfs/HdfsCommandHelper.h"
 #include "common/memory/MemoryUtils.h"
+#include "common/meta/GflagsManager.h"
 #include "common/meta/ServerBasedIndexManager.h"
 #include "common/meta/ServerBasedSchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/thread/GenericThreadPool.h"
+#include "common/thrift/ThreadManagerObserver.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/utils/Utils.h"
 #include "kvstore/PartManager.h"
@@ -24,6 +26,7 @@
 #include "storage/CompactionFilter.h"
 #include "storage/GraphStorageLocalServer.h"
 #include "storage/GraphStorageServiceHandler.h"
+#include "storage/MergeOperator.h"
 #include "storage/StorageAdminServiceHandler.h"
 #include "storage/StorageFlags.h"
 #include "storage/http/StorageHttpAdminHandler.h"
@@ -102,6 +105,7 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   if (!FLAGS_storage_kv_mode) {
     options.cffBuilder_ =
         std::make_unique<StorageCompactionFilterFactoryBuilder>(schemaMan_.get(), indexMan_.get());
+    options.mergeOp_ = std::make_shared<NebulaOperator>();
   }
   options.schemaMan_ = schemaMan_.get();
   if (FLAGS_store_type == "nebula") {
@@ -186,6 +190,7 @@ bool StorageServer::start() {
       numWorkerThreads);
   workers_->setNamePrefix("executor");
   workers_->start();
+  watchThreadManager("executor", workers_);
 
   // Meta client
   meta::MetaClientOptions options;
@@ -201,6 +206,10 @@ bool StorageServer::start() {
   options.rootPath_ = boost::filesystem::current_path().string();
   options.dataPaths_ = dataPaths_;
 
+  // The caches of the spaces are resized online
+  meta::GflagsManager::registerCallback("rocksdb_space_block_cache", kvstore::updateSpaceCaches);
+  meta::GflagsManager::registerCallback("rocksdb_space_row_cache_num", kvstore::updateSpaceCaches);
+
   metaClient_ = std::make_unique<meta::MetaClient>(ioThreadPool_, metaAddrs_, options);
 
 #ifdef BUILD_STANDALONE
@@ -278,6 +287,9 @@ bool StorageServer::start() {
 
   env_->verticesML_ = std::make_unique<VerticesMemLock>();
   env_->edgesML_ = std::make_unique<EdgesMemLock>();
+  if (FLAGS_enable_update_coalescing) {
+    env_->updateCoalescer_ = std::make_unique<UpdateCoalescer>(kvstore_.get());
+  }
   env_->adminStore_ = getAdminStoreInstance();
   env_->adminSeqId_ = getAdminStoreSeqId();
   if (env_->adminSeqId_ < 0) {
@@ -285,12 +297,51 @@ bool StorageServer::start() {
     return false;
   }
 
+  if (FLAGS_store_type == "nebula" && (FLAGS_enable_vertex_cache || FLAGS_enable_adjacency_cache)) {
+    if (FLAGS_enable_vertex_cache) {
+      env_->vertexCache_ =
+          std::make_unique<VertexCache>(FLAGS_vertex_cache_num, FLAGS_vertex_cache_bucket_exp);
+    }
+    if (FLAGS_enable_adjacency_cache) {
+      env_->adjacencyCache_ = std::make_unique<AdjacencyCache>(FLAGS_adjacency_cache_num,
+                                                               FLAGS_adjacency_cache_bucket_exp);
+    }
+    // The rows cached by a leader may be overwritten by the next one, so the caches are cleared
+    // whenever the leadership of a part changes
+    auto* env = env_.get();
+    auto onLeaderChanged = [env](const kvstore::Part::CallbackOptions&) {
+      if (env->vertexCache_ != nullptr) {
+        env->vertexCache_->clear();
+      }
+      if (env->adjacencyCache_ != nullptr) {
+        env->adjacencyCache_->clear();
+      }
+    };
+    std::vector<std::pair<GraphSpaceID, PartitionID>> existParts;
+    static_cast<kvstore::NebulaStore*>(kvstore_.get())
+        ->registerOnNewPartAdded(
+            "StorageCache",
+            [onLeaderChanged](std::shared_ptr<kvstore::Part>& part) {
+              part->registerOnLeaderReady(onLeaderChanged);
+              part->registerOnLeaderLost(onLeaderChanged);
+            },
+            existParts);
+  }
+
   taskMgr_ = AdminTaskManager::instance(env_.get());
   if (!taskMgr_->init()) {
     LOG(ERROR) << "Init task manager failed!";
     return false;
   }
 
+  if (!FLAGS_async_index_names.empty()) {
+    asyncIndexApplier_ = std::make_unique<AsyncIndexApplier>(env_.get());
+    if (!asyncIndexApplier_->start()) {
+      LOG(ERROR) << "Start async index applier failed!";
+      return false;
+    }
+  }
+
   storageServer_ = getStorageServer();
   adminServer_ = getAdminServer();
   if (!storageServer_ || !adminServer_) {
@@ -335,6 +386,11 @@ void StorageServer::stop() {
   // Stop http service
   webSvc_.reset();
 
+  // Stop applying the async indexes, which waits for the atomic ops of the parts
+  if (asyncIndexApplier_) {
+    asyncIndexApplier_->stop();
+  }
+
   // Stop all thrift server: raft/storage/admin
   if (kvstore_) {
     // stop kvstore background job and raft services
@@ -18,6 +18,7 @@
 #include "storage/CommonUtils.h"
 #include "storage/GraphStorageLocalServer.h"
 #include "storage/admin/AdminTaskManager.h"
+#include "storage/index/AsyncIndexApplier.h"
 #include "storage/transaction/TransactionManager.h"
 #include "webservice/WebService.h"
 
@@ -119,6 +120,9 @@ class StorageServer final {
 
   AdminTaskManager* taskMgr_{nullptr};
 
+  // nullptr if no index is async
+  std::unique_ptr<AsyncIndexApplier> asyncIndexApplier_;
+
   std::unique_ptr<LogMonitor> logMonitor_;
 
   ServiceStatus serverStatus_{STATUS_UNINITIALIZED};
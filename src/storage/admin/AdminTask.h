@@ -223,6 +223,8 @@ class AdminTask {
 
  public:
   std::atomic<size_t> unFinishedSubTask_;
+  // The subtasks generated, by which the progress is reported
+  size_t totalSubTask_{0};
   SubTaskQueue subtasks_;
   std::atomic<bool> running_{false};
 
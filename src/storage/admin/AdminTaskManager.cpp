@@ -10,10 +10,19 @@
 
 #include <tuple>
 
+#include "common/time/Duration.h"
 #include "storage/admin/AdminTask.h"
 #include "storage/admin/AdminTaskProcessor.h"
+#include "storage/stats/StorageStats.h"
 
 DEFINE_uint32(max_concurrent_subtasks, 10, "The sub tasks could be invoked simultaneously");
+DEFINE_uint32(admin_task_pause_qps,
+              0,
+              "The sub tasks wait before starting while the foreground requests per second "
+              "exceed it, 0 means never");
+DEFINE_uint32(admin_task_max_pause_secs,
+              600,
+              "The longest a sub task waits for the foreground load, so the task goes on anyway");
 
 namespace nebula {
 namespace storage {
@@ -268,6 +277,7 @@ void AdminTaskManager::schedule() {
     auto subTaskConcurrency =
         std::min(static_cast<size_t>(FLAGS_max_concurrent_subtasks), subTasks.size());
     task->unFinishedSubTask_ = subTasks.size();
+    task->totalSubTask_ = subTasks.size();
 
     if (0 == subTasks.size()) {
       FLOG_INFO("task(%d, %d) finished, no subtask", task->getJobId(), task->getTaskId());
@@ -297,6 +307,7 @@ void AdminTaskManager::runSubTask(TaskHandle handle) {
   auto task = it->second;
   std::chrono::milliseconds take_dura{10};
   if (auto subTask = task->subtasks_.try_take_for(take_dura)) {
+    waitForegroundLoad(task);
     if (task->status() == nebula::cpp2::ErrorCode::SUCCEEDED) {
       auto rc = nebula::cpp2::ErrorCode::E_UNKNOWN;
       try {
@@ -312,10 +323,12 @@ void AdminTaskManager::runSubTask(TaskHandle handle) {
     }
 
     auto unFinishedSubTask = --task->unFinishedSubTask_;
-    FLOG_INFO("subtask of task(%d, %d) finished, unfinished task %zu",
+    FLOG_INFO("subtask of task(%d, %d) finished, unfinished task %zu, progress %zu/%zu",
               task->getJobId(),
               task->getTaskId(),
-              unFinishedSubTask);
+              unFinishedSubTask,
+              task->totalSubTask_ - unFinishedSubTask,
+              task->totalSubTask_);
     if (0 == unFinishedSubTask) {
       task->finish();
       tasks_.erase(handle);
@@ -327,6 +340,31 @@ void AdminTaskManager::runSubTask(TaskHandle handle) {
   }
 }
 
+void AdminTaskManager::waitForegroundLoad(std::shared_ptr<AdminTask> task) {
+  if (FLAGS_admin_task_pause_qps == 0) {
+    return;
+  }
+  auto busy = []() {
+    auto qps = stats::StatsManager::readStats(kNumForegroundRequests,
+                                              stats::StatsManager::TimeRange::FIVE_SECONDS,
+                                              stats::StatsManager::StatsMethod::RATE);
+    return qps.ok() && qps.value() > FLAGS_admin_task_pause_qps;
+  };
+  if (!busy()) {
+    return;
+  }
+  FLOG_INFO("task(%d, %d) paused by the foreground load", task->getJobId(), task->getTaskId());
+  time::Duration paused;
+  while (!shutdown_ && !task->isCanceled() && busy() &&
+         paused.elapsedInSec() < FLAGS_admin_task_max_pause_secs) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+  FLOG_INFO("task(%d, %d) resumed after %lds paused",
+            task->getJobId(),
+            task->getTaskId(),
+            static_cast<int64_t>(paused.elapsedInSec()));
+}
+
 void AdminTaskManager::notifyReporting() {
   std::unique_lock<std::mutex> lk(unreportedMutex_);
   ifAnyUnreported_ = true;
@@ -101,6 +101,14 @@ class AdminTaskManager {
 
   void runSubTask(TaskHandle handle);
 
+  /**
+   * @brief Wait before a subtask of the task starts while the foreground requests exceed
+   * admin_task_pause_qps, until the task is canceled or the wait exceeds admin_task_max_pause_secs
+   *
+   * @param task
+   */
+  void waitForegroundLoad(std::shared_ptr<AdminTask> task);
+
  private:
   std::atomic<bool> shutdown_{false};
   std::unique_ptr<ThreadPool> pool_{nullptr};
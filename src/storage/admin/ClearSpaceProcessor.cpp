@@ -20,6 +20,12 @@ void ClearSpaceProcessor::process(const cpp2::ClearSpaceReq& req) {
   }
   auto* store = static_cast<kvstore::NebulaStore*>(env_->kvstore_);
   this->resp_.code_ref() = store->clearSpace(spaceId);
+  if (env_->vertexCache_ != nullptr) {
+    env_->vertexCache_->clear();
+  }
+  if (env_->adjacencyCache_ != nullptr) {
+    env_->adjacencyCache_->clear();
+  }
   onFinished();
 }
 
@@ -6,12 +6,45 @@
 #include "storage/admin/CompactTask.h"
 
 #include "common/base/Logging.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
 
 namespace nebula {
 namespace storage {
 
 bool CompactTask::check() {
-  return env_->kvstore_ != nullptr;
+  if (env_->kvstore_ == nullptr) {
+    return false;
+  }
+  if (!ctx_.parameters_.task_specific_paras_ref().has_value()) {
+    return true;
+  }
+  for (const auto& para : *ctx_.parameters_.task_specific_paras_ref()) {
+    folly::StringPiece view(para);
+    if (view.removePrefix(kParts)) {
+      std::vector<folly::StringPiece> parts;
+      folly::split(',', view, parts, true);
+      for (auto part : parts) {
+        auto partId = folly::tryTo<PartitionID>(part);
+        if (!partId.hasValue()) {
+          LOG(INFO) << "Invalid part of compaction: " << part;
+          return false;
+        }
+        parts_.emplace(partId.value());
+      }
+    } else if (view.removePrefix(kExpiredRatio)) {
+      auto ratio = folly::tryTo<double>(view);
+      if (!ratio.hasValue() || ratio.value() <= 0 || ratio.value() > 1) {
+        LOG(INFO) << "Invalid expired ratio of compaction: " << view;
+        return false;
+      }
+      expiredRatio_ = ratio.value();
+    } else {
+      LOG(INFO) << "Unknown para of compaction: " << para;
+      return false;
+    }
+  }
+  return true;
 }
 
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> CompactTask::genSubTasks() {
@@ -28,15 +61,61 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> CompactTask::genSubT
 
   auto space = nebula::value(errOrSpace);
 
+  // The subtasks of the engines on different data paths run in parallel, bounded by
+  // max_concurrent_subtasks and the compaction rate limiters of the data paths
   for (auto& engine : space->engines_) {
-    auto task = std::bind(&CompactTask::subTask, this, engine.get());
-    ret.emplace_back(task);
+    if (parts_.empty()) {
+      auto task = std::bind(&CompactTask::subTask, this, engine.get());
+      ret.emplace_back(task);
+      continue;
+    }
+    for (auto part : engine->allParts()) {
+      if (parts_.count(part)) {
+        auto task = std::bind(&CompactTask::compactPart, this, engine.get(), part);
+        ret.emplace_back(task);
+      }
+    }
   }
+  totalSubTasks_ = ret.size();
   return ret;
 }
 
 nebula::cpp2::ErrorCode CompactTask::subTask(kvstore::KVEngine* engine) {
-  return engine->compact();
+  auto code = expiredRatio_.has_value() ? engine->compactExpired(expiredRatio_.value())
+                                        : engine->compact();
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    onSubTaskDone(folly::sformat("engine {}", engine->getDataRoot()));
+  }
+  return code;
+}
+
+nebula::cpp2::ErrorCode CompactTask::compactPart(kvstore::KVEngine* engine, PartitionID part) {
+  for (const auto& prefix : {NebulaKeyUtils::tagPrefix(part),
+                             NebulaKeyUtils::vertexPrefix(part),
+                             NebulaKeyUtils::edgePrefix(part),
+                             IndexKeyUtils::indexPrefix(part)}) {
+    if (isCanceled()) {
+      return nebula::cpp2::ErrorCode::E_USER_CANCEL;
+    }
+    auto code = engine->compactRange(prefix, NebulaKeyUtils::lastKey(prefix, 128));
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << "Compact part " << part << " failed";
+      return code;
+    }
+  }
+  onSubTaskDone(folly::sformat("part {}", part));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void CompactTask::onSubTaskDone(const std::string& what) {
+  auto finished = ++finishedSubTasks_;
+  LOG(INFO) << folly::sformat("Compaction job {} task {} compacted {} of space {}, {}/{} done",
+                              ctx_.jobId_,
+                              ctx_.taskId_,
+                              what,
+                              *ctx_.parameters_.space_id_ref(),
+                              finished,
+                              totalSubTasks_);
 }
 
 }  // namespace storage
@@ -16,9 +16,16 @@ namespace storage {
 /**
  * @brief Task class to do compact tasks.
  *
+ * It compacts the whole engines by default. The task specific paras could limit it:
+ *  - "parts=1,2,3": compact the key ranges of these parts only, each part is a subtask
+ *  - "expired_ratio=0.5": compact the ranges of the sst files whose keys expired by ttl are more
+ *    than the ratio
  */
 class CompactTask : public AdminTask {
  public:
+  static constexpr char kParts[] = "parts=";
+  static constexpr char kExpiredRatio[] = "expired_ratio=";
+
   CompactTask(StorageEnv* env, TaskContext&& ctx) : AdminTask(env, std::move(ctx)) {}
 
   bool check() override;
@@ -31,6 +38,20 @@ class CompactTask : public AdminTask {
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> genSubTasks() override;
 
   nebula::cpp2::ErrorCode subTask(nebula::kvstore::KVEngine* engine);
+
+  /**
+   * @brief Compact the key ranges of the part, i.e. its tags, vertices, edges and indexes
+   */
+  nebula::cpp2::ErrorCode compactPart(nebula::kvstore::KVEngine* engine, PartitionID part);
+
+ private:
+  // Log the progress after each subtask
+  void onSubTaskDone(const std::string& what);
+
+  std::unordered_set<PartitionID> parts_;
+  std::optional<double> expiredRatio_;
+  size_t totalSubTasks_{0};
+  std::atomic<size_t> finishedSubTasks_{0};
 };
 
 }  // namespace storage
@@ -24,8 +24,19 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
   }
 
   auto space = nebula::value(errOrSpace);
-  results.emplace_back([space = space]() {
-    for (auto& engine : space->engines_) {
+  // One subtask of each engine, so the disks ingest at the same time
+  for (auto& engine : space->engines_) {
+    results.emplace_back([engine = engine.get(), env = env_]() {
+      SCOPE_EXIT {
+        // The ingested rows bypass the write paths evicting the caches, each engine clears them
+        // once done, as the rows of it may be cached again while the others ingest
+        if (env->vertexCache_ != nullptr) {
+          env->vertexCache_->clear();
+        }
+        if (env->adjacencyCache_ != nullptr) {
+          env->adjacencyCache_->clear();
+        }
+      };
       auto parts = engine->allParts();
       for (auto part : parts) {
         auto path = folly::stringPrintf("%s/download/%d", engine->getDataRoot(), part);
@@ -41,9 +52,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
           return code;
         }
       }
-    }
-    return nebula::cpp2::ErrorCode::SUCCEEDED;
-  });
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    });
+  }
   return results;
 }
 
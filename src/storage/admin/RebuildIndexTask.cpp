@@ -7,6 +7,8 @@
 
 #include "common/utils/OperationKeyUtils.h"
 #include "kvstore/Common.h"
+#include "kvstore/IOScheduler.h"
+#include "kvstore/Part.h"
 #include "storage/StorageFlags.h"
 
 namespace nebula {
@@ -81,6 +83,22 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> RebuildIndexTask::ge
     }
   }
 
+  // The subtasks run at the same time are of the parts on different disks
+  std::map<std::string, std::deque<PartitionID>> diskParts;
+  for (const auto& part : parts) {
+    auto partRet = env_->kvstore_->part(space_, part);
+    auto root = ok(partRet) ? nebula::value(partRet)->engine()->getDataRoot() : "";
+    diskParts[root].emplace_back(part);
+  }
+  parts.clear();
+  while (!diskParts.empty()) {
+    for (auto it = diskParts.begin(); it != diskParts.end();) {
+      parts.emplace_back(it->second.front());
+      it->second.pop_front();
+      it = it->second.empty() ? diskParts.erase(it) : std::next(it);
+    }
+  }
+
   for (const auto& part : parts) {
     env_->rebuildIndexGuard_->insert_or_assign(std::make_tuple(space_, part), IndexState::STARTING);
     TaskFunction task = std::bind(&RebuildIndexTask::invoke, this, space_, part, items);
@@ -234,25 +252,59 @@ nebula::cpp2::ErrorCode RebuildIndexTask::removeLegacyLogs(GraphSpaceID space, P
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
-nebula::cpp2::ErrorCode RebuildIndexTask::writeData(GraphSpaceID space,
-                                                    PartitionID part,
-                                                    std::vector<kvstore::KV> data,
-                                                    size_t batchSize,
-                                                    kvstore::RateLimiter* rateLimiter) {
-  folly::Baton<true, std::atomic> baton;
-  auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
+void RebuildIndexTask::consumeIO(GraphSpaceID space, PartitionID part, int64_t bytes) {
+  auto partRet = env_->kvstore_->part(space, part);
+  if (ok(partRet)) {
+    kvstore::IOScheduler::instance().consume(
+        nebula::value(partRet)->engine()->getDataRoot(), kvstore::IOClass::kRebuild, bytes);
+  }
+}
+
+folly::Future<nebula::cpp2::ErrorCode> RebuildIndexTask::writeData(
+    GraphSpaceID space,
+    PartitionID part,
+    std::vector<kvstore::KV> data,
+    size_t batchSize,
+    kvstore::RateLimiter* rateLimiter) {
   rateLimiter->consume(static_cast<double>(batchSize),                             // toConsume
                        static_cast<double>(FLAGS_rebuild_index_part_rate_limit),   // rate
                        static_cast<double>(FLAGS_rebuild_index_part_rate_limit));  // burstSize
-  env_->kvstore_->asyncMultiPut(
-      space, part, std::move(data), [&result, &baton](nebula::cpp2::ErrorCode code) {
-        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-          result = code;
-        }
-        baton.post();
-      });
-  baton.wait();
-  return result;
+  consumeIO(space, part, batchSize);
+  auto promise = std::make_shared<folly::Promise<nebula::cpp2::ErrorCode>>();
+  auto future = promise->getFuture();
+  env_->kvstore_->asyncMultiPut(space, part, std::move(data), [promise](auto code) {
+    promise->setValue(code);
+  });
+  return future;
+}
+
+nebula::cpp2::ErrorCode RebuildIndexTask::PartIndexWriter::write(std::vector<kvstore::KV> data,
+                                                                 size_t batchSize) {
+  while (!inflight_.empty() &&
+         inflight_.size() >= std::max<size_t>(FLAGS_rebuild_index_inflight_batches, 1)) {
+    waitEarliest();
+  }
+  if (result_ == nebula::cpp2::ErrorCode::SUCCEEDED && !data.empty()) {
+    inflight_.emplace_back(
+        task_->writeData(space_, part_, std::move(data), batchSize, rateLimiter_));
+  }
+  return result_;
+}
+
+nebula::cpp2::ErrorCode RebuildIndexTask::PartIndexWriter::finish() {
+  while (!inflight_.empty()) {
+    waitEarliest();
+  }
+  return result_;
+}
+
+nebula::cpp2::ErrorCode RebuildIndexTask::PartIndexWriter::waitEarliest() {
+  auto code = std::move(inflight_.front()).get();
+  inflight_.pop_front();
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED && result_ == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    result_ = code;
+  }
+  return code;
 }
 
 nebula::cpp2::ErrorCode RebuildIndexTask::writeOperation(GraphSpaceID space,
@@ -265,6 +317,7 @@ nebula::cpp2::ErrorCode RebuildIndexTask::writeOperation(GraphSpaceID space,
   rateLimiter->consume(static_cast<double>(batchHolder->size()),                   // toConsume
                        static_cast<double>(FLAGS_rebuild_index_part_rate_limit),   // rate
                        static_cast<double>(FLAGS_rebuild_index_part_rate_limit));  // burstSize
+  consumeIO(space, part, batchHolder->size());
   env_->kvstore_->asyncAppendBatch(
       space, part, std::move(encoded), [&result, &baton](nebula::cpp2::ErrorCode code) {
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -6,6 +6,10 @@
 #ifndef STORAGE_ADMIN_REBUILDINDEXTASK_H_
 #define STORAGE_ADMIN_REBUILDINDEXTASK_H_
 
+#include <folly/futures/Future.h>
+
+#include <deque>
+
 #include "common/meta/IndexManager.h"
 #include "interface/gen-cpp2/storage_types.h"
 #include "kvstore/LogEncoder.h"
@@ -60,11 +64,52 @@ class RebuildIndexTask : public AdminTask {
   // Remove the legacy operation log to make sure the index is correct.
   nebula::cpp2::ErrorCode removeLegacyLogs(GraphSpaceID space, PartitionID part);
 
-  nebula::cpp2::ErrorCode writeData(GraphSpaceID space,
-                                    PartitionID part,
-                                    std::vector<kvstore::KV> data,
-                                    size_t batchSize,
-                                    kvstore::RateLimiter* rateLimiter);
+  folly::Future<nebula::cpp2::ErrorCode> writeData(GraphSpaceID space,
+                                                   PartitionID part,
+                                                   std::vector<kvstore::KV> data,
+                                                   size_t batchSize,
+                                                   kvstore::RateLimiter* rateLimiter);
+
+  /**
+   * @brief The writer of the index keys of a part, which keeps at most
+   * rebuild_index_inflight_batches batches being written by raft, so the part is scanned on
+   * while they're replicated. The batches are appended to raft in order.
+   */
+  class PartIndexWriter {
+   public:
+    PartIndexWriter(RebuildIndexTask* task,
+                    GraphSpaceID space,
+                    PartitionID part,
+                    kvstore::RateLimiter* rateLimiter)
+        : task_(task), space_(space), part_(part), rateLimiter_(rateLimiter) {}
+
+    // Wait for the batches being written, e.g. when the task is canceled
+    ~PartIndexWriter() {
+      finish();
+    }
+
+    /**
+     * @brief Write a batch, waiting for the earliest one if there are too many being written
+     *
+     * @return nebula::cpp2::ErrorCode The error of a batch written before
+     */
+    nebula::cpp2::ErrorCode write(std::vector<kvstore::KV> data, size_t batchSize);
+
+    /**
+     * @brief Wait for all the batches written
+     */
+    nebula::cpp2::ErrorCode finish();
+
+   private:
+    nebula::cpp2::ErrorCode waitEarliest();
+
+    RebuildIndexTask* task_;
+    GraphSpaceID space_;
+    PartitionID part_;
+    kvstore::RateLimiter* rateLimiter_;
+    std::deque<folly::Future<nebula::cpp2::ErrorCode>> inflight_;
+    nebula::cpp2::ErrorCode result_{nebula::cpp2::ErrorCode::SUCCEEDED};
+  };
 
   nebula::cpp2::ErrorCode writeOperation(GraphSpaceID space,
                                          PartitionID part,
@@ -73,6 +118,9 @@ class RebuildIndexTask : public AdminTask {
 
   nebula::cpp2::ErrorCode invoke(GraphSpaceID space, PartitionID part, const IndexItems& items);
 
+  // Consume the background io budget of the disk of part
+  void consumeIO(GraphSpaceID space, PartitionID part, int64_t bytes);
+
  protected:
   GraphSpaceID space_;
   bool changedSpaceGuard_{false};
@@ -7,6 +7,8 @@
 
 #include "codec/RowReaderWrapper.h"
 #include "common/utils/IndexKeyUtils.h"
+#include "kvstore/PrefetchIter.h"
+#include "kvstore/ScanCacheGuard.h"
 #include "storage/StorageFlags.h"
 
 namespace nebula {
@@ -53,12 +55,17 @@ nebula::cpp2::ErrorCode RebuildTagIndexTask::buildIndexGlobal(GraphSpaceID space
   auto vidSize = vidSizeRet.value();
   std::unique_ptr<kvstore::KVIterator> iter;
   auto prefix = NebulaKeyUtils::tagPrefix(part);
+  // The part is read once, keep the blocks of the online queries in the cache
+  kvstore::ScanCacheGuard scanGuard;
   auto ret = env_->kvstore_->prefix(space, part, prefix, &iter);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Processing Part " << part << " Failed";
     return ret;
   }
+  // Read the next rows while building the index of the current ones
+  iter = kvstore::PrefetchIter::wrap(std::move(iter));
 
+  PartIndexWriter writer(this, space, part, rateLimiter);
   std::vector<kvstore::KV> data;
   data.reserve(kReserveNum);
   RowReaderWrapper reader;
@@ -70,7 +77,7 @@ nebula::cpp2::ErrorCode RebuildTagIndexTask::buildIndexGlobal(GraphSpaceID space
     }
 
     if (batchSize >= FLAGS_rebuild_index_batch_size) {
-      auto result = writeData(space, part, std::move(data), batchSize, rateLimiter);
+      auto result = writer.write(std::move(data), batchSize);
       if (result != nebula::cpp2::ErrorCode::SUCCEEDED) {
         LOG(ERROR) << "Write Part " << part << " Index Failed";
         return result;
@@ -143,7 +150,8 @@ nebula::cpp2::ErrorCode RebuildTagIndexTask::buildIndexGlobal(GraphSpaceID space
     iter->next();
   }
 
-  auto result = writeData(space, part, std::move(data), batchSize, rateLimiter);
+  writer.write(std::move(data), batchSize);
+  auto result = writer.finish();
   if (result != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Write Part " << part << " Index Failed";
     return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
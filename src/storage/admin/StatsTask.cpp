@@ -7,19 +7,103 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include "codec/RowReaderWrapper.h"
 #include "common/base/MurmurHash2.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "common/utils/PropStatsUtils.h"
 #include "kvstore/Common.h"
+#include "kvstore/PrefetchIter.h"
+#include "kvstore/ScanCacheGuard.h"
 #include "storage/StorageFlags.h"
 
 DEFINE_int32(stats_sleep_interval_ms,
              0,
              "If interval is greater than 0, sleep a period of time when scanned 1000 records. "
              "Default value 0 means won't sleep");
+DEFINE_bool(stats_collect_props,
+            false,
+            "Whether the stats job collects the histograms, the most frequent values and the "
+            "distinct values of each property, which decodes all the vertices and edges");
 
 namespace nebula {
 namespace storage {
 
+namespace {
+
+// The stats of a property of the latest schema, with the elements of a list or set
+struct PropStatsBuilder {
+  std::string name;
+  ValueStatsBuilder values;
+  std::unique_ptr<ValueStatsBuilder> elements;
+
+  void add(const Value& value) {
+    if (elements == nullptr) {
+      values.add(value);
+      return;
+    }
+    values.addUnordered(value);
+    if (value.isList()) {
+      for (const auto& element : value.getList().values) {
+        elements->add(element);
+      }
+    } else if (value.isSet()) {
+      for (const auto& element : value.getSet().values) {
+        elements->add(element);
+      }
+    }
+  }
+
+  meta::cpp2::PropStats build() {
+    meta::cpp2::PropStats stats;
+    stats.values_ref() = values.build();
+    if (elements != nullptr) {
+      stats.elements_ref() = elements->build();
+    }
+    return stats;
+  }
+};
+
+std::vector<PropStatsBuilder> makePropStatsBuilders(const meta::NebulaSchemaProvider* schema) {
+  std::vector<PropStatsBuilder> builders;
+  if (schema == nullptr) {
+    return builders;
+  }
+  for (size_t i = 0; i < schema->getNumFields(); ++i) {
+    PropStatsBuilder builder;
+    builder.name = schema->getFieldName(i);
+    switch (schema->getFieldType(i)) {
+      case nebula::cpp2::PropertyType::LIST_STRING:
+      case nebula::cpp2::PropertyType::LIST_INT:
+      case nebula::cpp2::PropertyType::LIST_FLOAT:
+      case nebula::cpp2::PropertyType::SET_STRING:
+      case nebula::cpp2::PropertyType::SET_INT:
+      case nebula::cpp2::PropertyType::SET_FLOAT:
+        builder.elements = std::make_unique<ValueStatsBuilder>();
+        break;
+      default:
+        break;
+    }
+    builders.emplace_back(std::move(builder));
+  }
+  return builders;
+}
+
+void addProps(RowReaderWrapper* reader, std::vector<PropStatsBuilder>& builders) {
+  for (auto& builder : builders) {
+    builder.add(reader->getValueByName(builder.name));
+  }
+}
+
+std::map<std::string, meta::cpp2::PropStats> buildProps(std::vector<PropStatsBuilder>& builders) {
+  std::map<std::string, meta::cpp2::PropStats> props;
+  for (auto& builder : builders) {
+    props.emplace(builder.name, builder.build());
+  }
+  return props;
+}
+
+}  // namespace
+
 bool StatsTask::check() {
   return env_->kvstore_ != nullptr && env_->schemaMan_ != nullptr;
 }
@@ -115,6 +199,8 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   auto vertexPrefix = NebulaKeyUtils::vertexPrefix(part);
   std::unique_ptr<kvstore::KVIterator> vertexIter;
 
+  // The part is read once, keep the blocks of the online queries in the cache
+  kvstore::ScanCacheGuard scanGuard;
   // When the storage occurs leader change, continue to read data from the
   // follower instead of reporting an error.
   auto ret = env_->kvstore_->prefix(spaceId, part, tagPrefix, &tagIter, true);
@@ -134,6 +220,10 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
       return ret;
     }
   }
+  // Read the next keys while decoding the current ones
+  tagIter = kvstore::PrefetchIter::wrap(std::move(tagIter));
+  edgeIter = kvstore::PrefetchIter::wrap(std::move(edgeIter));
+  vertexIter = kvstore::PrefetchIter::wrap(std::move(vertexIter));
   std::unordered_map<TagID, int64_t> tagsVertices;
   std::unordered_map<EdgeType, int64_t> edgetypeEdges;
   std::unordered_map<PartitionID, int64_t> positiveRelevancy;
@@ -152,6 +242,23 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     edgetypeEdges[edge.first] = 0;
   }
 
+  // The stats of the properties of the tags and the out edges
+  std::unordered_map<TagID, std::vector<PropStatsBuilder>> tagProps;
+  std::unordered_map<EdgeType, std::vector<PropStatsBuilder>> edgeProps;
+  if (FLAGS_stats_collect_props) {
+    for (const auto& tag : tags) {
+      auto schema = env_->schemaMan_->getTagSchema(spaceId, tag.first);
+      tagProps.emplace(tag.first, makePropStatsBuilders(schema.get()));
+    }
+    for (const auto& edge : edges) {
+      if (edge.first > 0) {
+        auto schema = env_->schemaMan_->getEdgeSchema(spaceId, edge.first);
+        edgeProps.emplace(edge.first, makePropStatsBuilders(schema.get()));
+      }
+    }
+  }
+  RowReaderWrapper reader;
+
   VertexID lastVertexId = "";
 
   // Only stats valid vertex data, no multi version
@@ -187,6 +294,14 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
       lastVertexId = vId;
     }
 
+    auto props = tagProps.find(tagId);
+    if (props != tagProps.end()) {
+      reader = RowReaderWrapper::getTagPropReader(env_->schemaMan_, spaceId, tagId, tagIter->val());
+      if (reader != nullptr) {
+        addProps(&reader, props->second);
+      }
+    }
+
     tagIter->next();
     sleepIfScannedSomeRecord(++countToSleep);
   }
@@ -219,6 +334,15 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
       spaceEdges++;
       edgetypeEdges[edgeType] += 1;
 
+      auto props = edgeProps.find(edgeType);
+      if (props != edgeProps.end()) {
+        reader = RowReaderWrapper::getEdgePropReader(
+            env_->schemaMan_, spaceId, edgeType, edgeIter->val());
+        if (reader != nullptr) {
+          addProps(&reader, props->second);
+        }
+      }
+
       uint64_t destinationVid = 0;
       if (isIntId) {
         memcpy(static_cast<void*>(&destinationVid), destination.data(), 8);
@@ -264,6 +388,25 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     }
   }
 
+  if (FLAGS_stats_collect_props) {
+    std::unordered_map<std::string, std::map<std::string, meta::cpp2::PropStats>> tagPropStats;
+    for (auto& props : tagProps) {
+      auto iter = tags_.find(props.first);
+      if (iter != tags_.end()) {
+        tagPropStats.emplace(iter->second, buildProps(props.second));
+      }
+    }
+    std::unordered_map<std::string, std::map<std::string, meta::cpp2::PropStats>> edgePropStats;
+    for (auto& props : edgeProps) {
+      auto iter = edges_.find(props.first);
+      if (iter != edges_.end()) {
+        edgePropStats.emplace(iter->second, buildProps(props.second));
+      }
+    }
+    statsItem.tag_props_ref() = std::move(tagPropStats);
+    statsItem.edge_props_ref() = std::move(edgePropStats);
+  }
+
   statsItem.space_vertices_ref() = FLAGS_use_vertex_key ? verticesCountByVertexKey : spaceVertices;
   statsItem.space_edges_ref() = spaceEdges;
   using Correlativities = std::vector<nebula::meta::cpp2::Correlativity>;
@@ -344,6 +487,8 @@ void StatsTask::finish(nebula::cpp2::ErrorCode rc) {
         }
       }
 
+      PropStatsUtils::mergeProps(result, item);
+
       (*result.positive_part_correlativity_ref())
           .insert((*item.positive_part_correlativity_ref()).begin(),
                   (*item.positive_part_correlativity_ref()).end());
@@ -122,6 +122,71 @@ Value StorageExpressionContext::getSrcProp(const std::string& tagName,
   }
 }
 
+bool StorageExpressionContext::evalCollectionProp(bool isEdge,
+                                                  const std::string& sym,
+                                                  const std::string& prop,
+                                                  CollectionOp op,
+                                                  const Value& operand,
+                                                  Value& result) const {
+  if (isIndex_ || reader_ == nullptr || isEdge != isEdge_ || sym != name_) {
+    return false;
+  }
+  auto index = reader_->getSchema()->getFieldIndex(prop);
+  CollectionView view;
+  // A NULL or a missing property falls back to read the value with its default
+  if (index < 0 || !reader_->getCollectionView(index, view)) {
+    return false;
+  }
+  switch (op) {
+    case CollectionOp::kSize:
+      result = static_cast<int64_t>(view.size());
+      return true;
+    case CollectionOp::kContains:
+      if (operand.isNull()) {
+        return false;
+      }
+      result = view.contains(operand);
+      return true;
+    case CollectionOp::kAt: {
+      if (view.isSet() || !operand.isInt()) {
+        return false;
+      }
+      auto size = static_cast<int64_t>(view.size());
+      auto i = operand.getInt();
+      if (i < 0) {
+        i += size;
+      }
+      if (i < 0 || i >= size) {
+        result = Value::kNullOutOfRange;
+      } else {
+        result = view.at(i);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StorageExpressionContext::getStringPropView(bool isEdge,
+                                                 const std::string& sym,
+                                                 const std::string& prop,
+                                                 folly::StringPiece& view) const {
+  if (isIndex_ || reader_ == nullptr || schema_ == nullptr || isEdge != isEdge_ || sym != name_) {
+    return false;
+  }
+  // The props missing in the row are read with their defaults
+  auto index = reader_->getSchema()->getFieldIndex(prop);
+  auto field = schema_->field(prop);
+  if (index < 0 || field == nullptr || !reader_->getStringView(index, view)) {
+    return false;
+  }
+  // The same as QueryUtils::readValue
+  if (field->type() == nebula::cpp2::PropertyType::FIXED_STRING) {
+    view = view.subpiece(0, view.find('\0'));
+  }
+  return true;
+}
+
 Value StorageExpressionContext::getIndexValue(const std::string& prop, bool isEdge) const {
   // Handle string type values.
   // when field type is FIXED_STRING type,
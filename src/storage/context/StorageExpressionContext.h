@@ -155,6 +155,40 @@ class StorageExpressionContext final : public ExpressionContext {
    */
   Value getSrcProp(const std::string& tagName, const std::string& prop) const override;
 
+  /**
+   * @brief Evaluate op on the collection property of the row being read, through the view of the
+   * encoded collection, instead of decoding the whole collection into a Value.
+   *
+   * @param isEdge Whether it's the property of an edge.
+   * @param sym Given tag or edge name.
+   * @param prop Given property name.
+   * @param op The operation to evaluate.
+   * @param operand The element to check for kContains, the index for kAt.
+   * @param result The result of the operation.
+   * @return false if it's not the row being read or the property is not a collection.
+   */
+  bool evalCollectionProp(bool isEdge,
+                          const std::string& sym,
+                          const std::string& prop,
+                          CollectionOp op,
+                          const Value& operand,
+                          Value& result) const override;
+
+  /**
+   * @brief Borrow the STRING or FIXED_STRING property of the row being read from the row buffer,
+   * the same as the value read by getEdgeProp or getTagProp but without copy.
+   *
+   * @param isEdge Whether it's the property of an edge.
+   * @param sym Given tag or edge name.
+   * @param prop Given property name.
+   * @param view The bytes of the property, valid until the next row is read.
+   * @return false if it's not the row being read or the property is not a string.
+   */
+  bool getStringPropView(bool isEdge,
+                         const std::string& sym,
+                         const std::string& prop,
+                         folly::StringPiece& view) const override;
+
   /**
    * @brief Get vid length.
    *
@@ -8,6 +8,7 @@
 #define STORAGE_EXEC_AGGREGATENODE_H_
 
 #include "common/base/Base.h"
+#include "common/datatypes/Set.h"
 #include "storage/exec/FilterNode.h"
 
 namespace nebula {
@@ -24,6 +25,7 @@ struct PropStat {
   mutable Value count_ = 0L;
   mutable Value min_ = std::numeric_limits<int64_t>::max();
   mutable Value max_ = std::numeric_limits<int64_t>::min();
+  mutable Set set_;
 };
 
 // AggregateNode will only be used in GetNeighbors for now, it need to calculate
@@ -49,6 +51,7 @@ class AggregateNode : public IterateNode<T> {
 
     CHECK_GT(edgeContext_->statCount_, 0);
     initStatValue(edgeContext_);
+    edgeCount_ = 0;
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
@@ -63,6 +66,7 @@ class AggregateNode : public IterateNode<T> {
   void next() override {
     // we need to collect the stat during `next`
     collectEdgeStats(this->key(), this->reader(), context_->props_);
+    ++edgeCount_;
     IterateNode<T>::next();
   }
 
@@ -80,11 +84,18 @@ class AggregateNode : public IterateNode<T> {
         result.values.emplace_back(stat.max_);
       } else if (stat.statType_ == cpp2::StatType::MIN) {
         result.values.emplace_back(stat.min_);
+      } else if (stat.statType_ == cpp2::StatType::COLLECT_SET) {
+        result.values.emplace_back(std::move(stat.set_));
       }
     }
     this->result_.setList(std::move(result));
   }
 
+  // The number of the valid edges collected since the last vertex
+  int64_t edgeCount() const {
+    return edgeCount_;
+  }
+
  private:
   VertexIDSlice srcId() const {
     return NebulaKeyUtils::getSrcId(context_->vIdLen(), this->key());
@@ -123,12 +134,21 @@ class AggregateNode : public IterateNode<T> {
   nebula::cpp2::ErrorCode collectEdgeStats(folly::StringPiece key,
                                            RowReaderWrapper* reader,
                                            const std::vector<PropContext>* props) {
-    for (const auto& prop : *props) {
+    const std::vector<PropProjection::Field>* fields = nullptr;
+    if (reader != nullptr) {
+      fields = &projection_.fields(reader->getSchema(), props);
+    }
+    for (size_t i = 0; i < props->size(); i++) {
+      const auto& prop = (*props)[i];
       if (prop.hasStat_) {
         for (const auto statIndex : prop.statIndex_) {
           VLOG(2) << "Collect stat prop " << prop.name_;
-          auto value =
-              QueryUtils::readEdgeProp(key, context_->vIdLen(), context_->isIntId(), reader, prop);
+          auto value = QueryUtils::readEdgeProp(key,
+                                                context_->vIdLen(),
+                                                context_->isIntId(),
+                                                reader,
+                                                prop,
+                                                fields != nullptr ? &(*fields)[i] : nullptr);
           if (!value.ok()) {
             return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
           }
@@ -140,6 +160,11 @@ class AggregateNode : public IterateNode<T> {
   }
 
   void addStatValue(const Value& value, PropStat& stat) {
+    // The nulls are skipped like the aggregate functions of graphd, except by COUNT which counts
+    // the edges
+    if (stat.statType_ != cpp2::StatType::COUNT && (value.isNull() || value.empty())) {
+      return;
+    }
     if (stat.statType_ == cpp2::StatType::SUM || stat.statType_ == cpp2::StatType::AVG) {
       stat.sum_ = stat.sum_ + value;
       stat.count_ = stat.count_ + 1;
@@ -149,6 +174,8 @@ class AggregateNode : public IterateNode<T> {
       stat.max_ = value > stat.max_ ? value : stat.max_;
     } else if (stat.statType_ == cpp2::StatType::MIN) {
       stat.min_ = value < stat.min_ ? value : stat.min_;
+    } else if (stat.statType_ == cpp2::StatType::COLLECT_SET) {
+      stat.set_.values.emplace(value);
     }
   }
 
@@ -156,6 +183,8 @@ class AggregateNode : public IterateNode<T> {
   RuntimeContext* context_;
   EdgeContext* edgeContext_;
   std::vector<PropStat> stats_;
+  int64_t edgeCount_{0};
+  PropProjection projection_;
   nebula::DataSet* resultSet_;
 };
 
@@ -9,6 +9,7 @@
 #include "common/base/Base.h"
 #include "storage/exec/RelNode.h"
 #include "storage/exec/StorageIterator.h"
+#include "storage/stats/StorageStats.h"
 
 namespace nebula {
 namespace storage {
@@ -133,7 +134,11 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
                                    *edgeKey.edge_type_ref(),
                                    *edgeKey.ranking_ref(),
                                    (*edgeKey.dst_ref()).getStr());
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &val_);
+    if (pending_.has_value() && pending_->first == key_) {
+      return doExecute(key_, pending_->second);
+    }
+    ret = context_->env()->kvstore_->get(
+        context_->spaceId(), partId, key_, &val_, context_->canReadFromFollower(partId));
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
       return doExecute(key_, val_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
@@ -157,6 +162,16 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
     reader_.reset();
   }
 
+  /**
+   * @brief Read value as the row of key rather than the kvstore, for the update reading the row
+   * submitted but not committed yet.
+   *
+   * @see UpdateCoalescer
+   */
+  void setPending(std::string key, std::string value) {
+    pending_ = std::make_pair(std::move(key), std::move(value));
+  }
+
  private:
   void resetReader() {
     reader_.reset(*schemas_, val_);
@@ -174,6 +189,8 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
   std::string key_;
   std::string val_;
   RowReaderWrapper reader_;
+  // The row set by setPending
+  std::optional<std::pair<std::string, std::string>> pending_;
 };
 
 // SingleEdgeNode is used to scan all edges of a specified edgeType of the same
@@ -192,6 +209,15 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
     name_ = "SingleEdgeNode";
   }
 
+  ~SingleEdgeNode() override {
+    if (cacheHits_ > 0) {
+      stats::StatsManager::addValue(kNumAdjacencyCacheHits, cacheHits_);
+    }
+    if (cacheMisses_ > 0) {
+      stats::StatsManager::addValue(kNumAdjacencyCacheMisses, cacheMisses_);
+    }
+  }
+
   SingleEdgeIterator* iter() {
     return iter_.get();
   }
@@ -226,7 +252,14 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
             << ", prop size " << props_->size();
     std::unique_ptr<kvstore::KVIterator> iter;
     prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
-    ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+    // The cache is evicted by the writes on leader, so it's bypassed by the follower reads
+    auto followerRead = context_->canReadFromFollower(partId);
+    if (context_->env()->adjacencyCache_ != nullptr && !followerRead) {
+      ret = cachedPrefix(partId, &iter);
+    } else {
+      ret = context_->env()->kvstore_->prefix(
+          context_->spaceId(), partId, prefix_, &iter, followerRead);
+    }
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter && iter->valid()) {
       if (!skipDecode_) {
         iter_.reset(new SingleEdgeIterator(context_, std::move(iter), edgeType_, schemas_, &ttl_));
@@ -240,8 +273,46 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
   }
 
  private:
+  /**
+   * @brief Iterate the edges of prefix_ in the adjacency cache, or read them from the kvstore and
+   * fill the cache with them if there are no more than adjacency_cache_max_edges ones.
+   */
+  nebula::cpp2::ErrorCode cachedPrefix(PartitionID partId,
+                                       std::unique_ptr<kvstore::KVIterator>* iter) {
+    auto* cache = context_->env()->adjacencyCache_.get();
+    auto cached = cache->get(context_->spaceId(), prefix_);
+    if (cached.has_value()) {
+      ++cacheHits_;
+      iter->reset(new AdjacencyBlockIter(std::move(cached).value()));
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    ++cacheMisses_;
+    auto epoch = cache->epoch();
+    std::unique_ptr<kvstore::KVIterator> kvIter;
+    auto ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &kvIter);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    auto edges = std::make_shared<std::vector<kvstore::KV>>();
+    auto maxEdges = static_cast<size_t>(std::max(0, FLAGS_adjacency_cache_max_edges));
+    for (; kvIter->valid() && edges->size() < maxEdges; kvIter->next()) {
+      edges->emplace_back(kvIter->key().str(), kvIter->val().str());
+    }
+    if (kvIter->valid()) {
+      // Too many edges to cache, iterate them from the kvstore
+      return context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, iter);
+    }
+    AdjacencyBlock block = std::move(edges);
+    cache->fill(context_->spaceId(), prefix_, block, epoch);
+    iter->reset(new AdjacencyBlockIter(std::move(block)));
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   std::unique_ptr<SingleEdgeIterator> iter_;
   std::string prefix_;
+  // Flushed to the stats when the plan is done, rather than for each vertex
+  int64_t cacheHits_{0};
+  int64_t cacheMisses_{0};
 };
 
 }  // namespace storage
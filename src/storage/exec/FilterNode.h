@@ -6,7 +6,10 @@
 #ifndef STORAGE_EXEC_FILTERNODE_H_
 #define STORAGE_EXEC_FILTERNODE_H_
 
+#include <optional>
+
 #include "common/base/Base.h"
+#include "common/expression/CompiledExpression.h"
 #include "common/expression/Expression.h"
 #include "storage/context/StorageExpressionContext.h"
 #include "storage/exec/HashJoinNode.h"
@@ -47,6 +50,13 @@ class FilterNode : public IterateNode<T> {
         filterExp_(exp),
         tagFilterExp_(tagFilterExp) {
     IterateNode<T>::name_ = "FilterNode";
+    // The filters are evaluated on each edge or vertex scanned, which are compiled once
+    if (filterExp_ != nullptr) {
+      filter_ = CompiledExpression::compile(filterExp_);
+    }
+    if (tagFilterExp_ != nullptr) {
+      tagFilter_ = CompiledExpression::compile(tagFilterExp_);
+    }
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const T& vId) override {
@@ -91,7 +101,7 @@ class FilterNode : public IterateNode<T> {
   }
 
   bool checkTagOnly() {
-    auto result = filterExp_->eval(*expCtx_);
+    const auto& result = filter_->eval(*expCtx_);
     // NULL is always false
     auto ret = result.toBool();
     return ret.isBool() && ret.getBool();
@@ -101,14 +111,14 @@ class FilterNode : public IterateNode<T> {
   bool checkTagAndEdge() {
     expCtx_->reset(this->reader(), this->key().str());
     if (tagFilterExp_ != nullptr) {
-      auto res = tagFilterExp_->eval(*expCtx_);
+      const auto& res = tagFilter_->eval(*expCtx_);
       if (!res.isBool() || !res.getBool()) {
         context_->resultStat_ = ResultStatus::TAG_FILTER_OUT;
         return false;
       }
     }
     // result is false when filter out
-    auto result = filterExp_->eval(*expCtx_);
+    const auto& result = filter_->eval(*expCtx_);
     // NULL is always false
     auto ret = result.toBool();
     return ret.isBool() && ret.getBool();
@@ -119,6 +129,8 @@ class FilterNode : public IterateNode<T> {
   StorageExpressionContext* expCtx_;
   Expression* filterExp_{nullptr};
   Expression* tagFilterExp_{nullptr};
+  std::optional<CompiledExpression> filter_;
+  std::optional<CompiledExpression> tagFilter_;
   FilterMode mode_{FilterMode::TAG_AND_EDGE};
   int32_t callCheck{0};
 };
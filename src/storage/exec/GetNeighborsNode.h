@@ -18,7 +18,8 @@ namespace storage {
 // GetNeighborsNode will generate a row in response of GetNeighbors, so it need
 // to get the tag result from HashJoinNode, and the stat info and edge iterator
 // from AggregateNode. Then collect some edge props, and put them into the
-// target cell of a row.
+// target cell of a row. If the flat edges are given, the edge props are put into
+// the columns of them instead, one per edge column, and the cells are left empty.
 class GetNeighborsNode : public QueryNode<VertexID> {
  public:
   using RelNode::doExecute;
@@ -28,17 +29,28 @@ class GetNeighborsNode : public QueryNode<VertexID> {
                    IterateNode<VertexID>* upstream,
                    EdgeContext* edgeContext,
                    nebula::DataSet* resultDataSet,
-                   int64_t limit = 0)
+                   int64_t limit = 0,
+                   std::vector<cpp2::NeighborEdges>* flatEdges = nullptr)
       : context_(context),
         hashJoinNode_(hashJoinNode),
         upstream_(upstream),
         edgeContext_(edgeContext),
         resultDataSet_(resultDataSet),
-        limit_(limit) {
+        limit_(limit),
+        flatEdges_(flatEdges) {
     name_ = "GetNeighborsNode";
+    if (flatEdges_ != nullptr) {
+      numEdges_.resize(flatEdges_->size(), 0);
+    }
   }
 
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
+    if (flatEdges_ != nullptr) {
+      truncateFlatEdges(flatEdges_);
+      for (size_t i = 0; i < flatEdges_->size(); ++i) {
+        numEdges_[i] = (*flatEdges_)[i].get_offsets().back();
+      }
+    }
     auto ret = RelNode::doExecute(partId, vId);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
@@ -73,11 +85,28 @@ class GetNeighborsNode : public QueryNode<VertexID> {
       row.emplace_back(std::move(value));
     }
 
-    // add default null for each edge node and the last column of yield
-    // expression
-    row.resize(row.size() + edgeContext_->propContexts_.size() + 1, Value());
-
-    ret = iterateEdges(row);
+    if (edgeContext_->statsOnly_) {
+      // only the last column of yield expression, the edges are not returned
+      row.resize(row.size() + 1, Value());
+      if (!edgeContext_->materializedStats_.empty()) {
+        int64_t count = 0;
+        ret = readMaterializedStats(partId, vId, &count, &row[1]);
+        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED || count == 0) {
+          // the vertex without any edge has no row, the same as the stats collected
+          return ret;
+        }
+        if (!row[1].empty()) {
+          resultDataSet_->rows.emplace_back(std::move(row));
+          return nebula::cpp2::ErrorCode::SUCCEEDED;
+        }
+      }
+      ret = iterateStats();
+    } else {
+      // add default null for each edge node and the last column of yield
+      // expression
+      row.resize(row.size() + edgeContext_->propContexts_.size() + 1, Value());
+      ret = iterateEdges(row);
+    }
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
     }
@@ -85,6 +114,10 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     if (edgeContext_->statCount_ > 0) {
       auto agg = dynamic_cast<AggregateNode<VertexID>*>(upstream_);
       CHECK_NOTNULL(agg);
+      if (edgeContext_->statsOnly_ && agg->edgeCount() == 0) {
+        // the vertex without any valid edge has no row, like it's not expanded by graph
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      }
       agg->calculateStat();
       // set stat list to second columns
       row[1].setList(agg->mutableResult().moveList());
@@ -94,11 +127,29 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     // so if it it an edge, this test is always true
     if (!context_->filterInvalidResultOut || context_->resultStat_ == ResultStatus::NORMAL) {
       resultDataSet_->rows.emplace_back(std::move(row));
+      if (flatEdges_ != nullptr) {
+        // the end of the edges of the row
+        for (size_t i = 0; i < flatEdges_->size(); ++i) {
+          (*flatEdges_)[i].offsets_ref()->emplace_back(numEdges_[i]);
+        }
+      }
     }
 
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  // Drop the flat edges after the last offset, which are of the vertex failed
+  static void truncateFlatEdges(std::vector<cpp2::NeighborEdges>* flatEdges) {
+    for (auto& edges : *flatEdges) {
+      auto end = static_cast<size_t>(edges.get_offsets().back());
+      for (auto& prop : *edges.props_ref()) {
+        if (prop.size() > end) {
+          prop.resize(end);
+        }
+      }
+    }
+  }
+
  protected:
   GetNeighborsNode() = default;
 
@@ -125,22 +176,113 @@ class GetNeighborsNode : public QueryNode<VertexID> {
 
       list.reserve(props->size());
       // collect props need to return
-      if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader, props, list)
+      if (!QueryUtils::collectEdgeProps(key,
+                                        context_->vIdLen(),
+                                        context_->isIntId(),
+                                        reader,
+                                        props,
+                                        list,
+                                        nullptr,
+                                        "",
+                                        &projection_)
                .ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
 
       // add edge prop value to the target column
+      appendEdge(row, columnIdx, list);
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // Add the props of an edge to the target column of the row, or to the flat edges of the column
+  void appendEdge(std::vector<Value>& row, size_t columnIdx, nebula::List& list) {
+    if (flatEdges_ == nullptr) {
       if (row[columnIdx].empty()) {
         row[columnIdx].setList(nebula::List());
       }
       auto& cell = row[columnIdx].mutableList();
       cell.values.emplace_back(std::move(list));
+      return;
+    }
+    auto edgeIdx = columnIdx - edgeContext_->offset_;
+    DCHECK_LT(edgeIdx, flatEdges_->size());
+    auto& props = *(*flatEdges_)[edgeIdx].props_ref();
+    if (props.size() < list.size()) {
+      props.resize(list.size());
+    }
+    for (size_t i = 0; i < list.size(); ++i) {
+      props[i].emplace_back(std::move(list.values[i]));
+    }
+    // the list is reused by the next edge
+    list.values.clear();
+    ++numEdges_[edgeIdx];
+  }
+
+  // The stats are collected by AggregateNode during `next`, so the edges are only iterated
+  nebula::cpp2::ErrorCode iterateStats() {
+    for (int64_t edgeRowCount = 0; upstream_->valid(); upstream_->next(), ++edgeRowCount) {
+      if (context_->isPlanKilled()) {
+        return nebula::cpp2::ErrorCode::E_PLAN_IS_KILLED;
+      }
+      if (edgeRowCount >= limit_) {
+        break;
+      }
     }
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  // The stats read from the aggregates materialized of the vertex, which are left EMPTY if it has
+  // more edges than the limit, as only the edges in the limit are aggregated then
+  nebula::cpp2::ErrorCode readMaterializedStats(PartitionID partId,
+                                                const VertexID& vId,
+                                                int64_t* count,
+                                                Value* stats) {
+    auto followerRead = context_->canReadFromFollower(partId);
+    auto read = [&](const NeighborhoodAggregate& aggregate, Value* value) {
+      auto key = NebulaKeyUtils::neighborhoodKey(context_->vIdLen(),
+                                                 partId,
+                                                 vId,
+                                                 edgeContext_->materializedType_,
+                                                 aggregate.toString());
+      std::string raw;
+      auto code = context_->env()->kvstore_->get(
+          context_->spaceId(), partId, key, &raw, followerRead);
+      if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        *value = aggregate.result(Value::kEmpty);
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      }
+      if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        *value = aggregate.result(NeighborhoodAggregate::decode(raw));
+      }
+      return code;
+    };
+    Value counted;
+    auto ret = read(NeighborhoodAggregate(NeighborhoodAggregate::Kind::kCount, ""), &counted);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    *count = counted.isInt() ? counted.getInt() : 0;
+    if (*count == 0 || *count > limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    nebula::List list;
+    list.values.resize(edgeContext_->materializedStats_.size());
+    for (size_t i = 0; i < list.values.size(); i++) {
+      const auto& aggregate = edgeContext_->materializedStats_[i];
+      if (aggregate.kind() == NeighborhoodAggregate::Kind::kCount) {
+        list.values[i] = counted;
+        continue;
+      }
+      ret = read(aggregate, &list.values[i]);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    stats->setList(std::move(list));
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   bool isDuplicatedSelfReflectiveEdge(const folly::StringPiece& key) {
     folly::StringPiece srcID = NebulaKeyUtils::getSrcId(context_->vIdLen(), key);
     folly::StringPiece dstID = NebulaKeyUtils::getDstId(context_->vIdLen(), key);
@@ -165,6 +307,10 @@ class GetNeighborsNode : public QueryNode<VertexID> {
   EdgeContext* edgeContext_;
   nebula::DataSet* resultDataSet_;
   int64_t limit_;
+  PropProjection projection_;
+  std::vector<cpp2::NeighborEdges>* flatEdges_{nullptr};
+  // The number of the edges put into each of the flat edges
+  std::vector<int32_t> numEdges_;
 };
 
 class GetNeighborsSampleNode : public GetNeighborsNode {
@@ -174,8 +320,10 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
                          IterateNode<VertexID>* upstream,
                          EdgeContext* edgeContext,
                          nebula::DataSet* resultDataSet,
-                         int64_t limit)
-      : GetNeighborsNode(context, hashJoinNode, upstream, edgeContext, resultDataSet, limit) {
+                         int64_t limit,
+                         std::vector<cpp2::NeighborEdges>* flatEdges = nullptr)
+      : GetNeighborsNode(
+            context, hashJoinNode, upstream, edgeContext, resultDataSet, limit, flatEdges) {
     sampler_ = std::make_unique<nebula::algorithm::ReservoirSampling<Sample>>(limit);
     name_ = "GetNeighborsSampleNode";
   }
@@ -188,23 +336,23 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
     int64_t edgeRowCount = 0;
     nebula::List list;
     for (; upstream_->valid(); upstream_->next(), ++edgeRowCount) {
+      // Most edges of a supernode are not kept, so they are skipped without copying them
+      auto slot = sampler_->nextSlot();
+      if (slot < 0) {
+        continue;
+      }
       auto val = upstream_->val();
       auto key = upstream_->key();
       auto edgeType = context_->edgeType_;
       auto props = context_->props_;
       auto columnIdx = context_->columnIdx_;
-      sampler_->sampling(std::make_tuple(edgeType, val.str(), key.str(), props, columnIdx));
+      sampler_->put(slot, std::make_tuple(edgeType, val.str(), key.str(), props, columnIdx));
     }
 
     RowReaderWrapper reader;
     auto samples = sampler_->samples();
     for (auto& sample : samples) {
       auto columnIdx = std::get<4>(sample);
-      // add edge prop value to the target column
-      if (row[columnIdx].empty()) {
-        row[columnIdx].setList(nebula::List());
-      }
-
       auto edgeType = std::get<0>(sample);
       const auto& val = std::get<1>(sample);
       reader = RowReaderWrapper::getEdgePropReader(
@@ -215,13 +363,20 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
 
       const auto& key = std::get<2>(sample);
       const auto& props = std::get<3>(sample);
-      if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader.get(), props, list)
+      if (!QueryUtils::collectEdgeProps(key,
+                                        context_->vIdLen(),
+                                        context_->isIntId(),
+                                        reader.get(),
+                                        props,
+                                        list,
+                                        nullptr,
+                                        "",
+                                        &projection_)
                .ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
-      auto& cell = row[columnIdx].mutableList();
-      cell.values.emplace_back(std::move(list));
+      // add edge prop value to the target column
+      appendEdge(row, columnIdx, list);
     }
 
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -65,7 +65,11 @@ class GetTagPropNode : public QueryNode<VertexID> {
         // check if vId has any valid tag by prefix scan
         std::unique_ptr<kvstore::KVIterator> iter;
         auto tagPrefix = NebulaKeyUtils::tagPrefix(context_->vIdLen(), partId, vId);
-        ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, tagPrefix, &iter);
+        ret = context_->env()->kvstore_->prefix(context_->spaceId(),
+                                                partId,
+                                                tagPrefix,
+                                                &iter,
+                                                context_->canReadFromFollower(partId));
         if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return ret;
         } else if (!iter->valid()) {
@@ -130,8 +134,15 @@ class GetTagPropNode : public QueryNode<VertexID> {
               folly::StringPiece key,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectVertexProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), tagNode->getTagName());
+            auto status = QueryUtils::collectVertexProps(key,
+                                                         vIdLen,
+                                                         isIntId,
+                                                         reader,
+                                                         props,
+                                                         row,
+                                                         expCtx_.get(),
+                                                         tagNode->getTagName(),
+                                                         &projection_);
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -163,6 +174,7 @@ class GetTagPropNode : public QueryNode<VertexID> {
   Expression* filter_{nullptr};
   const std::size_t limit_{std::numeric_limits<std::size_t>::max()};
   TagContext* tagContext_;
+  PropProjection projection_;
 };
 
 class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
@@ -214,8 +226,15 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
               folly::StringPiece key,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            auto status = QueryUtils::collectEdgeProps(
-                key, vIdLen, isIntId, reader, props, row, expCtx_.get(), edgeNode->getEdgeName());
+            auto status = QueryUtils::collectEdgeProps(key,
+                                                       vIdLen,
+                                                       isIntId,
+                                                       reader,
+                                                       props,
+                                                       row,
+                                                       expCtx_.get(),
+                                                       edgeNode->getEdgeName(),
+                                                       &projection_);
             if (!status.ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
@@ -246,6 +265,7 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
   std::unique_ptr<StorageExpressionContext> expCtx_{nullptr};
   Expression* filter_{nullptr};
   const std::size_t limit_{std::numeric_limits<std::size_t>::max()};
+  PropProjection projection_;
 };
 
 }  // namespace storage
@@ -47,52 +47,51 @@ IndexEdgeScanNode::IndexEdgeScanNode(RuntimeContext* context,
   return IndexScanNode::init(ctx);
 }
 
-Row IndexEdgeScanNode::decodeFromIndex(folly::StringPiece key) {
-  std::vector<Value> values(requiredColumns_.size());
-  if (colPosMap_.count(kSrc)) {
+Row IndexEdgeScanNode::decodeFromIndex(folly::StringPiece key,
+                                       const Map<std::string, size_t>& colPosMap) {
+  std::vector<Value> values(colPosMap.size());
+  if (colPosMap.count(kSrc)) {
     auto vId = IndexKeyUtils::getIndexSrcId(context_->vIdLen(), key);
     if (context_->isIntId()) {
-      values[colPosMap_[kSrc]] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
+      values[colPosMap.at(kSrc)] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
     } else {
-      values[colPosMap_[kSrc]] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
+      values[colPosMap.at(kSrc)] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
     }
   }
-  if (colPosMap_.count(kDst)) {
+  if (colPosMap.count(kDst)) {
     auto vId = IndexKeyUtils::getIndexDstId(context_->vIdLen(), key);
     if (context_->isIntId()) {
-      values[colPosMap_[kDst]] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
+      values[colPosMap.at(kDst)] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
     } else {
-      values[colPosMap_[kDst]] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
+      values[colPosMap.at(kDst)] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
     }
   }
-  if (colPosMap_.count(kRank)) {
+  if (colPosMap.count(kRank)) {
     auto rank = IndexKeyUtils::getIndexRank(context_->vIdLen(), key);
-    values[colPosMap_[kRank]] = Value(rank);
+    values[colPosMap.at(kRank)] = Value(rank);
   }
-  if (colPosMap_.count(kType)) {
-    values[colPosMap_[kType]] = Value(context_->edgeType_);
+  if (colPosMap.count(kType)) {
+    values[colPosMap.at(kType)] = Value(context_->edgeType_);
   }
   // Truncate the src/rank/dst at the end to facilitate obtaining the two bytes representing the
   // nullableBit directly at the end when needed
   key.subtract(context_->vIdLen() * 2 + sizeof(EdgeRanking));
-  decodePropFromIndex(key, colPosMap_, values);
+  decodePropFromIndex(key, colPosMap, values);
   return Row(std::move(values));
 }
 
-nebula::cpp2::ErrorCode IndexEdgeScanNode::getBaseData(folly::StringPiece key,
-                                                       std::pair<std::string, std::string>& kv) {
+std::string IndexEdgeScanNode::getBaseKey(folly::StringPiece key) {
   auto vIdLen = context_->vIdLen();
-  kv.first = NebulaKeyUtils::edgeKey(vIdLen,
-                                     partId_,
-                                     IndexKeyUtils::getIndexSrcId(vIdLen, key).str(),
-                                     context_->edgeType_,
-                                     IndexKeyUtils::getIndexRank(vIdLen, key),
-                                     IndexKeyUtils::getIndexDstId(vIdLen, key).str());
-  return kvstore_->get(context_->spaceId(), partId_, kv.first, &kv.second);
+  return NebulaKeyUtils::edgeKey(vIdLen,
+                                 partId_,
+                                 IndexKeyUtils::getIndexSrcId(vIdLen, key).str(),
+                                 context_->edgeType_,
+                                 IndexKeyUtils::getIndexRank(vIdLen, key),
+                                 IndexKeyUtils::getIndexDstId(vIdLen, key).str());
 }
 
 Map<std::string, Value> IndexEdgeScanNode::decodeFromBase(const std::string& key,
-                                                          const std::string& value) {
+                                                          folly::StringPiece value) {
   Map<std::string, Value> values;
   auto reader = RowReaderWrapper::getRowReader(edge_, value);
   for (auto& col : requiredAndHintColumns_) {
@@ -30,10 +30,9 @@ class IndexEdgeScanNode : public IndexScanNode {
   std::unique_ptr<IndexNode> copy() override;
 
  private:
-  Row decodeFromIndex(folly::StringPiece key) override;
-  nebula::cpp2::ErrorCode getBaseData(folly::StringPiece key,
-                                      std::pair<std::string, std::string>& kv) override;
-  Map<std::string, Value> decodeFromBase(const std::string& key, const std::string& value) override;
+  Row decodeFromIndex(folly::StringPiece key, const Map<std::string, size_t>& colPosMap) override;
+  std::string getBaseKey(folly::StringPiece key) override;
+  Map<std::string, Value> decodeFromBase(const std::string& key, folly::StringPiece value) override;
 
   using EdgeSchemas = std::vector<std::shared_ptr<const nebula::meta::NebulaSchemaProvider>>;
   using IndexItem = ::nebula::meta::cpp2::IndexItem;
@@ -4,8 +4,39 @@
  */
 #include "storage/exec/IndexScanNode.h"
 
+#include "storage/exec/IndexSelectionNode.h"
+
 namespace nebula {
 namespace storage {
+
+namespace {
+
+// The first key scanned by path
+const std::string& beginKeyOf(Path* path) {
+  if (path->isRange()) {
+    return dynamic_cast<RangePath*>(path)->getStartKey();
+  }
+  return dynamic_cast<PrefixPath*>(path)->getPrefixKey();
+}
+
+// The key right after all the keys scanned by path
+std::string endKeyOf(Path* path) {
+  if (path->isRange()) {
+    return dynamic_cast<RangePath*>(path)->getEndKey();
+  }
+  // The least key greater than all the keys of the prefix
+  std::string end = dynamic_cast<PrefixPath*>(path)->getPrefixKey();
+  while (!end.empty() && end.back() == '\xFF') {
+    end.pop_back();
+  }
+  if (!end.empty()) {
+    end.back() = static_cast<char>(static_cast<uint8_t>(end.back()) + 1);
+  }
+  return end;
+}
+
+}  // namespace
+
 // Define of Path
 Path::Path(nebula::meta::cpp2::IndexItem* index,
            const meta::NebulaSchemaProvider* schema,
@@ -63,7 +94,9 @@ std::string Path::encodeValue(const Value& value,
   bool isNull = false;
   switch (colDef.get_type()) {
     case ::nebula::cpp2::PropertyType::STRING:
-    case ::nebula::cpp2::PropertyType::FIXED_STRING: {
+    case ::nebula::cpp2::PropertyType::FIXED_STRING:
+    case ::nebula::cpp2::PropertyType::LIST_STRING:
+    case ::nebula::cpp2::PropertyType::SET_STRING: {
       if (value.type() == Value::Type::NULLVALUE) {
         val = IndexKeyUtils::encodeNullValue(Value::Type::STRING, colDef.get_type_length());
         isNull = true;
@@ -316,7 +349,18 @@ PrefixPath::PrefixPath(nebula::meta::cpp2::IndexItem* index,
 
 QualifiedStrategy::Result PrefixPath::qualified(const Map<std::string, Value>& rowData) {
   for (auto& hint : hints_) {
-    if (hint.get_begin_value() != rowData.at(hint.get_column_name())) {
+    auto& value = rowData.at(hint.get_column_name());
+    // The hint of an element index is matched by any element of the list or set
+    if (value.isList()) {
+      auto& values = value.getList().values;
+      if (std::find(values.begin(), values.end(), hint.get_begin_value()) == values.end()) {
+        return QualifiedStrategy::INCOMPATIBLE;
+      }
+    } else if (value.isSet()) {
+      if (!value.getSet().values.count(hint.get_begin_value())) {
+        return QualifiedStrategy::INCOMPATIBLE;
+      }
+    } else if (hint.get_begin_value() != value) {
       return QualifiedStrategy::INCOMPATIBLE;
     }
   }
@@ -342,7 +386,8 @@ void PrefixPath::buildKey() {
         fmt::format("{}={}, ", hint.get_column_name(), hint.get_begin_value().toString());
   }
   for (; fieldIter != index_->get_fields().end(); fieldIter++) {
-    if (UNLIKELY(fieldIter->get_type().get_type() == nebula::cpp2::PropertyType::GEOGRAPHY)) {
+    if (UNLIKELY(fieldIter->get_type().get_type() == nebula::cpp2::PropertyType::GEOGRAPHY ||
+                 IndexKeyUtils::isElementIndexColumn(fieldIter->get_type().get_type()))) {
       strategySet_.insert(QualifiedStrategy::dedupGeoIndex(suffixLength_));
       break;
     }
@@ -359,18 +404,55 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
       indexId_(node.indexId_),
       index_(node.index_),
       columnHints_(node.columnHints_),
+      moreColumnHints_(node.moreColumnHints_),
+      dedupKeys_(node.dedupKeys_),
       kvstore_(node.kvstore_),
       indexNullable_(node.indexNullable_),
       requiredColumns_(node.requiredColumns_),
       requiredAndHintColumns_(node.requiredAndHintColumns_),
       ttlProps_(node.ttlProps_),
       needAccessBase_(node.needAccessBase_),
-      colPosMap_(node.colPosMap_) {
-  if (node.path_->isRange()) {
-    path_ = std::make_unique<RangePath>(*dynamic_cast<RangePath*>(node.path_.get()));
-  } else {
-    path_ = std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(node.path_.get()));
+      colPosMap_(node.colPosMap_),
+      keyFilterColPos_(node.keyFilterColPos_) {
+  for (auto& path : node.paths_) {
+    if (path->isRange()) {
+      paths_.emplace_back(std::make_unique<RangePath>(*dynamic_cast<RangePath*>(path.get())));
+    } else {
+      paths_.emplace_back(std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(path.get())));
+    }
   }
+  path_ = paths_.front().get();
+  if (node.keyFilter_ != nullptr) {
+    keyFilter_ = node.keyFilter_->clone();
+    keyFilterCtx_ = std::make_unique<IndexExprContext>(keyFilterColPos_);
+  }
+}
+
+bool IndexScanNode::coveredByKey(const nebula::meta::cpp2::IndexItem& index,
+                                 Set<std::string> columns) {
+  for (auto& field : index.get_fields()) {
+    // TODO(doodle): Both STRING and FIXED_STRING properties in tag/edge will be transformed into
+    // FIXED_STRING in ColumnDef of IndexItem. As for FIXED_STRING in tag/edge property, we don't
+    // need to access base data actually.
+    if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::FIXED_STRING) {
+      continue;
+    }
+    if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::GEOGRAPHY) {
+      continue;
+    }
+    // The key of an element index only holds one element of the list or set
+    if (IndexKeyUtils::isElementIndexColumn(field.get_type().get_type())) {
+      continue;
+    }
+    columns.erase(field.get_name());
+  }
+  columns.erase(kVid);
+  columns.erase(kTag);
+  columns.erase(kRank);
+  columns.erase(kSrc);
+  columns.erase(kDst);
+  columns.erase(kType);
+  return columns.empty();
 }
 
 ::nebula::cpp2::ErrorCode IndexScanNode::init(InitContext& ctx) {
@@ -378,8 +460,12 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   ttlProps_ = CommonUtils::ttlProps(getSchema().back().get());
   requiredAndHintColumns_ = ctx.requiredColumns;
   auto schema = getSchema().back();
-  for (auto& hint : columnHints_) {
-    requiredAndHintColumns_.insert(hint.get_column_name());
+  std::vector<const std::vector<cpp2::IndexColumnHint>*> allHints{&columnHints_};
+  allHints.insert(allHints.end(), moreColumnHints_.begin(), moreColumnHints_.end());
+  for (auto* hints : allHints) {
+    for (auto& hint : *hints) {
+      requiredAndHintColumns_.insert(hint.get_column_name());
+    }
   }
   for (auto& col : ctx.requiredColumns) {
     requiredColumns_.push_back(col);
@@ -393,81 +479,170 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   // of index fields. In other words, if scan node is required to return property that index does
   // not contain, we need to access base data.
   // TODO(hs.zhang): The performance is better to judge based on whether the string is truncated
-  auto tmp = ctx.requiredColumns;
-  for (auto& field : index_->get_fields()) {
-    // TODO(doodle): Both STRING and FIXED_STRING properties in tag/edge will be transformed into
-    // FIXED_STRING in ColumnDef of IndexItem. As for FIXED_STRING in tag/edge property, we don't
-    // need to access base data actually.
-    if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::FIXED_STRING) {
-      continue;
+  needAccessBase_ = !coveredByKey(*index_, ctx.requiredColumns);
+  if (keyFilter_ != nullptr) {
+    SelectionExprVisitor vis;
+    keyFilter_->accept(&vis);
+    DCHECK(coveredByKey(*index_, vis.getRequiredColumns()));
+    size_t pos = 0;
+    for (auto& col : vis.getRequiredColumns()) {
+      keyFilterColPos_[col] = pos++;
     }
-    if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::GEOGRAPHY) {
-      continue;
+    keyFilterCtx_ = std::make_unique<IndexExprContext>(keyFilterColPos_);
+  }
+  for (auto* hints : allHints) {
+    paths_.emplace_back(Path::make(index_.get(), schema.get(), *hints, context_->vIdLen()));
+  }
+  if (paths_.size() > 1) {
+    std::stable_sort(paths_.begin(), paths_.end(), [](const auto& a, const auto& b) {
+      return beginKeyOf(a.get()) < beginKeyOf(b.get());
+    });
+    std::string end;
+    for (auto& path : paths_) {
+      if (beginKeyOf(path.get()) < end) {
+        dedupKeys_ = true;
+      }
+      end = std::max(end, endKeyOf(path.get()));
     }
-    tmp.erase(field.get_name());
-  }
-  tmp.erase(kVid);
-  tmp.erase(kTag);
-  tmp.erase(kRank);
-  tmp.erase(kSrc);
-  tmp.erase(kDst);
-  tmp.erase(kType);
-  needAccessBase_ = !tmp.empty();
-  path_ = Path::make(index_.get(), getSchema().back().get(), columnHints_, context_->vIdLen());
+    // A row has a key for each element of a list or set, or for each cell of a geography
+    for (auto& field : index_->get_fields()) {
+      auto type = field.get_type().get_type();
+      if (type == nebula::cpp2::PropertyType::GEOGRAPHY ||
+          IndexKeyUtils::isElementIndexColumn(type)) {
+        dedupKeys_ = true;
+      }
+    }
+  }
+  path_ = paths_.front().get();
   return ::nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode IndexScanNode::doExecute(PartitionID partId) {
   partId_ = partId;
+  baseKeys_.clear();
+  baseKeysCompatible_.clear();
+  baseRows_.clear();
+  baseBatchSize_ = 1;
+  pathIdx_ = 0;
+  path_ = paths_.front().get();
+  scannedKeys_.clear();
   auto ret = resetIter(partId);
   return ret;
 }
 
 IndexNode::Result IndexScanNode::doNext() {
-  for (; iter_ && iter_->valid(); iter_->next()) {
-    if (!checkTTL()) {
-      continue;
+  while (baseRows_.empty()) {
+    for (; iter_ && iter_->valid(); iter_->next()) {
+      if (!checkTTL()) {
+        continue;
+      }
+      auto q = path_->qualified(iter_->key());
+      if (q == QualifiedStrategy::INCOMPATIBLE) {
+        continue;
+      }
+      if (keyFilter_ != nullptr && !filterByKey(iter_->key())) {
+        continue;
+      }
+      bool compatible = q == QualifiedStrategy::COMPATIBLE;
+      if (compatible && dedupKeys_ && scannedBefore(getBaseKey(iter_->key()))) {
+        continue;
+      }
+      if (compatible && !needAccessBase_) {
+        if (!baseKeys_.empty()) {
+          // The rows of the keys before this one are returned first
+          break;
+        }
+        auto key = iter_->key().toString();
+        iter_->next();
+        Row row = decodeFromIndex(key, colPosMap_);
+        return Result(std::move(row));
+      }
+      baseKeys_.emplace_back(getBaseKey(iter_->key()));
+      baseKeysCompatible_.emplace_back(compatible);
+      if (baseKeys_.size() >= baseBatchSize_) {
+        iter_->next();
+        break;
+      }
     }
-    auto q = path_->qualified(iter_->key());
-    if (q == QualifiedStrategy::INCOMPATIBLE) {
-      continue;
+    if (baseKeys_.empty()) {
+      // The ranges are scanned one after another, the keys of a range are all fetched before
+      // the next range is scanned, which qualifies its keys in its own way
+      if (pathIdx_ + 1 < paths_.size()) {
+        path_ = paths_[++pathIdx_].get();
+        auto ret = resetIter(partId_);
+        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return Result(ret);
+        }
+        continue;
+      }
+      return Result();
     }
-    bool compatible = q == QualifiedStrategy::COMPATIBLE;
-    if (compatible && !needAccessBase_) {
-      auto key = iter_->key().toString();
-      iter_->next();
-      Row row = decodeFromIndex(key);
-      return Result(std::move(row));
+    auto ret = fetchBaseRows();
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return Result(ret);
     }
-    std::pair<std::string, std::string> kv;
-    auto ret = getBaseData(iter_->key(), kv);
-    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {  // do nothing
-    } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+  }
+  Row row = std::move(baseRows_.front());
+  baseRows_.pop_front();
+  return Result(std::move(row));
+}
+
+bool IndexScanNode::filterByKey(folly::StringPiece key) {
+  Row row = decodeFromIndex(key, keyFilterColPos_);
+  keyFilterCtx_->setRow(row);
+  auto& result = keyFilter_->eval(*keyFilterCtx_);
+  return result.type() == Value::Type::BOOL ? result.getBool() : false;
+}
+
+nebula::cpp2::ErrorCode IndexScanNode::fetchBaseRows() {
+  // The base rows are decoded from the values in place, the order of rows is kept
+  std::vector<std::optional<Row>> rows(baseKeys_.size());
+  auto [code, status] = kvstore_->multiGetView(
+      spaceId_, partId_, baseKeys_, [this, &rows](size_t i, folly::StringPiece value) {
+        Map<std::string, Value> rowData = decodeFromBase(baseKeys_[i], value);
+        if (!baseKeysCompatible_[i]) {
+          auto q = path_->qualified(rowData);
+          CHECK(q != QualifiedStrategy::UNCERTAIN);
+          if (q == QualifiedStrategy::INCOMPATIBLE) {
+            return;
+          }
+          if (dedupKeys_ && scannedBefore(baseKeys_[i])) {
+            return;
+          }
+        }
+        Row row;
+        for (auto& col : requiredColumns_) {
+          row.emplace_back(std::move(rowData.at(col)));
+        }
+        rows[i] = std::move(row);
+      });
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+      code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+    return code;
+  }
+  for (size_t i = 0; i < baseKeys_.size(); i++) {
+    if (status[i].isKeyNotFound()) {
       if (LIKELY(!fatalOnBaseNotFound_)) {
         LOG(WARNING) << "base data not found";
       } else {
         LOG(FATAL) << "base data not found";
       }
       continue;
-    } else {
-      return Result(ret);
+    } else if (!status[i].ok()) {
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
     }
-    Map<std::string, Value> rowData = decodeFromBase(kv.first, kv.second);
-    if (!compatible) {
-      q = path_->qualified(rowData);
-      CHECK(q != QualifiedStrategy::UNCERTAIN);
-      if (q == QualifiedStrategy::INCOMPATIBLE) {
-        continue;
-      }
-    }
-    Row row;
-    for (auto& col : requiredColumns_) {
-      row.emplace_back(std::move(rowData.at(col)));
+    if (rows[i].has_value()) {
+      baseRows_.emplace_back(std::move(rows[i]).value());
     }
-    iter_->next();
-    return Result(std::move(row));
   }
-  return Result();
+  baseKeys_.clear();
+  baseKeysCompatible_.clear();
+  baseBatchSize_ = std::min(baseBatchSize_ * 2, kMaxBaseBatchSize);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+bool IndexScanNode::scannedBefore(const std::string& baseKey) {
+  return !scannedKeys_.insert(baseKey).second;
 }
 
 bool IndexScanNode::checkTTL() {
@@ -559,7 +734,18 @@ void IndexScanNode::decodePropFromIndex(folly::StringPiece key,
 }
 
 std::string IndexScanNode::identify() {
-  return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, path_->toString());
+  std::vector<std::string> paths;
+  for (auto& path : paths_) {
+    paths.emplace_back(path->toString());
+  }
+  if (keyFilter_ != nullptr) {
+    return fmt::format("{}(IndexID={}, Path=({}), KeyFilter=[{}])",
+                       name_,
+                       indexId_,
+                       folly::join("; ", paths),
+                       keyFilter_->toString());
+  }
+  return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, folly::join("; ", paths));
 }
 
 // End of IndexScan
@@ -15,6 +15,7 @@
 #include "interface/gen-cpp2/meta_types.h"
 #include "interface/gen-cpp2/storage_types.h"
 #include "storage/CommonUtils.h"
+#include "storage/exec/IndexExprContext.h"
 #include "storage/exec/IndexNode.h"
 namespace nebula {
 namespace storage {
@@ -70,6 +71,40 @@ class IndexScanNode : public IndexNode {
   ::nebula::cpp2::ErrorCode init(InitContext& ctx) override;
   std::string identify() override;
 
+  /**
+   * @brief Filter the index keys by expr before accessing the base data, so that only the rows
+   * passing the filter are fetched. All the props of expr must be covered by the index key.
+   *
+   * @param expr
+   * @see coveredByKey
+   */
+  void setKeyFilter(Expression* expr) {
+    keyFilter_ = expr->clone();
+  }
+
+  /**
+   * @brief Scan the range of hints on the same index as well, so that the IN or OR over the
+   * columns of one index is read by one scan rather than a scan for each range and a dedup.
+   *
+   * The ranges are scanned in the order of their keys on each part. The rows are deduped by the
+   * scan only if the ranges overlap, or a row has several keys in the index.
+   *
+   * @param hints
+   */
+  void addColumnHints(const std::vector<cpp2::IndexColumnHint>& hints) {
+    moreColumnHints_.emplace_back(&hints);
+  }
+
+  /**
+   * @brief whether all the columns could be decoded exactly from the key of index
+   *
+   * @param index
+   * @param columns
+   * @return true
+   * @return false
+   */
+  static bool coveredByKey(const nebula::meta::cpp2::IndexItem& index, Set<std::string> columns);
+
  protected:
   nebula::cpp2::ErrorCode doExecute(PartitionID partId) final;
   Result doNext() final;
@@ -93,20 +128,20 @@ class IndexScanNode : public IndexNode {
    * decodePropFromIndex() to decode general props.
    *
    * @param key index key
+   * @param colPosMap needed columns and these position(order) in Row
    * @return Row
    * @see decodePropFromIndex
    */
-  virtual Row decodeFromIndex(folly::StringPiece key) = 0;
+  virtual Row decodeFromIndex(folly::StringPiece key,
+                              const Map<std::string, size_t>& colPosMap) = 0;
 
   /**
-   * @brief get the base data key-value according to index key
+   * @brief get the base data key according to index key
    *
    * @param key index key
-   * @param kv base data key-value
-   * @return nebula::cpp2::ErrorCode
+   * @return std::string
    */
-  virtual nebula::cpp2::ErrorCode getBaseData(folly::StringPiece key,
-                                              std::pair<std::string, std::string>& kv) = 0;
+  virtual std::string getBaseKey(folly::StringPiece key) = 0;
 
   /**
    * @brief decode all props from base data key-value.
@@ -116,7 +151,7 @@ class IndexScanNode : public IndexNode {
    * @return Map<std::string, Value>
    */
   virtual Map<std::string, Value> decodeFromBase(const std::string& key,
-                                                 const std::string& value) = 0;
+                                                 folly::StringPiece value) = 0;
   virtual const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& getSchema() = 0;
 
   /**
@@ -135,6 +170,30 @@ class IndexScanNode : public IndexNode {
    * @see Path
    */
   nebula::cpp2::ErrorCode resetIter(PartitionID partId);
+
+  /**
+   * @brief whether the row of the base key has been returned on the current part, and mark it
+   *
+   * @param baseKey
+   * @return true if it's returned already
+   */
+  bool scannedBefore(const std::string& baseKey);
+
+  /**
+   * @brief evaluate `keyFilter_` on the props decoded from index key
+   *
+   * @param key index key
+   * @return true if the key passes the filter
+   */
+  bool filterByKey(folly::StringPiece key);
+
+  /**
+   * @brief fetch the base data of `baseKeys_` by one multiGetView, and append the qualified rows to
+   * `baseRows_`
+   *
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode fetchBaseRows();
   PartitionID partId_;
   /**
    * @brief index_ in this Node to access
@@ -146,9 +205,21 @@ class IndexScanNode : public IndexNode {
   std::shared_ptr<nebula::meta::cpp2::IndexItem> index_;
   const std::vector<cpp2::IndexColumnHint>& columnHints_;
   /**
+   * @brief the hints of the other ranges on the index
+   */
+  std::vector<const std::vector<cpp2::IndexColumnHint>*> moreColumnHints_;
+  /**
+   * @brief the paths of all the ranges in the order of their keys, and the one being scanned
    * @see Path
    */
-  std::unique_ptr<Path> path_;
+  std::vector<std::unique_ptr<Path>> paths_;
+  size_t pathIdx_{0};
+  Path* path_{nullptr};
+  /**
+   * @brief the base keys of the rows returned on the current part, only kept if `dedupKeys_`
+   */
+  bool dedupKeys_{false};
+  Set<std::string> scannedKeys_;
   /**
    * @brief current kvstore iterator.It while be reset `doExecute` and iterated during `doNext`
    */
@@ -173,6 +244,24 @@ class IndexScanNode : public IndexNode {
   bool needAccessBase_{false};
   bool fatalOnBaseNotFound_{false};
   Map<std::string, size_t> colPosMap_;
+  /**
+   * @brief filter evaluated on index key, and its columns' position in the Row decoded from key
+   */
+  Expression* keyFilter_{nullptr};
+  Map<std::string, size_t> keyFilterColPos_;
+  std::unique_ptr<IndexExprContext> keyFilterCtx_;
+  /**
+   * @brief base data keys waiting to be fetched together, and whether the index key of each one is
+   * COMPATIBLE with `path_`
+   *
+   * The batch starts from one key on each part and doubles after each fetch, up to
+   * `kMaxBaseBatchSize`, so that a small limit over the scan doesn't fetch too much base data.
+   */
+  std::vector<std::string> baseKeys_;
+  std::vector<bool> baseKeysCompatible_;
+  std::deque<Row> baseRows_;
+  size_t baseBatchSize_{1};
+  static constexpr size_t kMaxBaseBatchSize = 256;
 };
 class QualifiedStrategy {
  public:
@@ -245,7 +334,8 @@ class QualifiedStrategy {
    * @brief dedup geo index data
    *
    * Because a `GEOGRAPHY` type data will generate multiple index keys pointing to the same base
-   * data,the base data pointed to by the indexkey should be de duplicated.
+   * data,the base data pointed to by the indexkey should be de duplicated. So does the element
+   * index on a list or set property, which has a key for each element.
    *
    * @param dedupSuffixLength If indexed schema is a tag, `dedupSuffixLength` should be vid.len; If
    * the indexed schema is an edge, `dedupSuffixLength` should be srcId.len+sizeof(rank)+dstId.len
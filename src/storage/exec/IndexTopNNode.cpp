@@ -8,6 +8,7 @@ namespace storage {
 IndexTopNNode::IndexTopNNode(const IndexTopNNode& node)
     : IndexLimitNode(node),
       orderBy_(node.orderBy_),
+      ordered_(node.ordered_),
       requiredColumns_(node.requiredColumns_),
       colPos_(node.colPos_) {
   name_ = "IndexTopNNode";
@@ -48,7 +49,11 @@ nebula::cpp2::ErrorCode IndexTopNNode::doExecute(PartitionID partId) {
 IndexNode::Result IndexTopNNode::doNext() {
   DCHECK_EQ(children_.size(), 1);
   if (!finished_) {
-    topN();
+    if (ordered_) {
+      firstN();
+    } else {
+      topN();
+    }
   }
   if (results_.empty()) {
     return Result();
@@ -107,6 +112,20 @@ void IndexTopNNode::topN() {
   finished_ = true;
 }
 
+void IndexTopNNode::firstN() {
+  auto& child = *children_[0];
+  for (uint64_t i = 0; i < offset_ + limit_; i++) {
+    auto result = child.next();
+    if (!result.success() || !result.hasData()) {
+      results_.emplace_back(std::move(result));
+      break;
+    }
+    results_.emplace_back(std::move(result));
+  }
+  // The rows beyond offset_ + limit_ are not read at all
+  finished_ = true;
+}
+
 std::unique_ptr<IndexNode> IndexTopNNode::copy() {
   return std::make_unique<IndexTopNNode>(*this);
 }
@@ -121,6 +140,9 @@ std::string IndexTopNNode::identify() {
       ss << iter->get_prop() << " desc,";
     }
   }
+  if (ordered_) {
+    ss << " ordered,";
+  }
   if (offset_ > 0) {
     return fmt::format("{}({} offset={}, limit={})", name_, ss.str(), offset_, limit_);
   } else {
@@ -84,13 +84,21 @@ class IndexTopNNode : public IndexLimitNode {
   std::unique_ptr<IndexNode> copy() override;
   std::string identify() override;
 
+  // The rows of the child come in the order already, e.g. scanned from an index whose keys are
+  // in the order, so the first ones are taken without reading the others
+  void setOrdered(bool ordered) {
+    ordered_ = ordered;
+  }
+
  private:
   nebula::cpp2::ErrorCode doExecute(PartitionID partId) override;
   Result doNext() override;
   void topN();
+  void firstN();
   const std::vector<cpp2::OrderBy> orderBy_;
   std::deque<Result> results_;
   bool finished_{false};
+  bool ordered_{false};
   std::vector<std::string> requiredColumns_;
   Map<std::string, size_t> colPos_;
 };
@@ -52,37 +52,36 @@ IndexVertexScanNode::IndexVertexScanNode(RuntimeContext* context,
   return IndexScanNode::init(ctx);
 }
 
-nebula::cpp2::ErrorCode IndexVertexScanNode::getBaseData(folly::StringPiece key,
-                                                         std::pair<std::string, std::string>& kv) {
-  kv.first = NebulaKeyUtils::tagKey(context_->vIdLen(),
-                                    partId_,
-                                    key.subpiece(key.size() - context_->vIdLen()).toString(),
-                                    context_->tagId_);
-  return kvstore_->get(context_->spaceId(), partId_, kv.first, &kv.second);
+std::string IndexVertexScanNode::getBaseKey(folly::StringPiece key) {
+  return NebulaKeyUtils::tagKey(context_->vIdLen(),
+                                partId_,
+                                key.subpiece(key.size() - context_->vIdLen()).toString(),
+                                context_->tagId_);
 }
 
-Row IndexVertexScanNode::decodeFromIndex(folly::StringPiece key) {
-  std::vector<Value> values(requiredColumns_.size());
-  if (colPosMap_.count(kVid)) {
+Row IndexVertexScanNode::decodeFromIndex(folly::StringPiece key,
+                                         const Map<std::string, size_t>& colPosMap) {
+  std::vector<Value> values(colPosMap.size());
+  if (colPosMap.count(kVid)) {
     auto vId = IndexKeyUtils::getIndexVertexID(context_->vIdLen(), key);
     if (context_->isIntId()) {
-      values[colPosMap_[kVid]] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
+      values[colPosMap.at(kVid)] = Value(*reinterpret_cast<const int64_t*>(vId.data()));
     } else {
-      values[colPosMap_[kVid]] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
+      values[colPosMap.at(kVid)] = Value(vId.subpiece(0, vId.find_first_of('\0')).toString());
     }
   }
-  if (colPosMap_.count(kTag)) {
-    values[colPosMap_[kTag]] = Value(context_->tagId_);
+  if (colPosMap.count(kTag)) {
+    values[colPosMap.at(kTag)] = Value(context_->tagId_);
   }
   key.subtract(context_->vIdLen());
-  decodePropFromIndex(key, colPosMap_, values);
+  decodePropFromIndex(key, colPosMap, values);
   return Row(std::move(values));
 }
 
 Map<std::string, Value> IndexVertexScanNode::decodeFromBase(const std::string& key,
-                                                            const std::string& value) {
+                                                            folly::StringPiece value) {
   Map<std::string, Value> values;
-  auto reader = RowReaderWrapper::getRowReader(tag_, folly::StringPiece(value));
+  auto reader = RowReaderWrapper::getRowReader(tag_, value);
   for (auto& col : requiredAndHintColumns_) {
     switch (QueryUtils::toReturnColType(col)) {
       case QueryUtils::ReturnColType::kVid: {
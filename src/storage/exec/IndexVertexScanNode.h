@@ -34,10 +34,9 @@ class IndexVertexScanNode final : public IndexScanNode {
   std::unique_ptr<IndexNode> copy() override;
 
  private:
-  nebula::cpp2::ErrorCode getBaseData(folly::StringPiece key,
-                                      std::pair<std::string, std::string>& kv) override;
-  Row decodeFromIndex(folly::StringPiece key) override;
-  Map<std::string, Value> decodeFromBase(const std::string& key, const std::string& value) override;
+  std::string getBaseKey(folly::StringPiece key) override;
+  Row decodeFromIndex(folly::StringPiece key, const Map<std::string, size_t>& colPosMap) override;
+  Map<std::string, Value> decodeFromBase(const std::string& key, folly::StringPiece value) override;
 
   using TagSchemas = std::vector<std::shared_ptr<const nebula::meta::NebulaSchemaProvider>>;
   const TagSchemas& getSchema() override {
@@ -17,6 +17,44 @@
 namespace nebula {
 namespace storage {
 
+/**
+ * @brief The fields of the props in the values of each schema version, which are resolved once
+ * per version rather than by the prop names of each row. The props not in an old version are read
+ * as their default or null values, which are evaluated once as well.
+ */
+class PropProjection final {
+ public:
+  struct Field {
+    // The index in the schema of the row, or -1 if the prop is not in the value
+    int64_t index{-1};
+    bool fixedString{false};
+    // The value of the prop not in the schema of the row, or the error of reading it
+    Status status;
+    Value missing;
+  };
+
+  /**
+   * @brief Get the fields of the props in the schema, one for each prop
+   *
+   * @param schema Schema version of the row
+   * @param props Props to read
+   * @return const std::vector<Field>&
+   */
+  const std::vector<Field>& fields(const meta::NebulaSchemaProvider* schema,
+                                   const std::vector<PropContext>* props);
+
+ private:
+  struct Plan {
+    const meta::NebulaSchemaProvider* schema;
+    const std::vector<PropContext>* props;
+    std::vector<Field> fields;
+  };
+
+  // Only a few edge types and schema versions are read by a node, so they are searched in a list
+  std::vector<Plan> plans_;
+  size_t last_{0};
+};
+
 class QueryUtils final {
  public:
   // The behavior keep same with filter executor
@@ -82,18 +120,7 @@ class QueryUtils final {
 
       if (nullType == NullType::UNKNOWN_PROP) {
         VLOG(1) << "Fail to read prop " << propName;
-        if (!field) {
-          return value;
-        }
-        if (field->hasDefault()) {
-          DefaultValueContext expCtx;
-          ObjectPool pool;
-          auto& exprStr = field->defaultValue();
-          auto expr = Expression::decode(&pool, folly::StringPiece(exprStr.data(), exprStr.size()));
-          return Expression::eval(expr, expCtx);
-        } else if (field->nullable()) {
-          return NullType::__NULL__;
-        }
+        return readMissingValue(propName, field);
       } else if (nullType == NullType::__NULL__) {
         // Need to check whether the field is nullable
         if (field->nullable()) {
@@ -103,8 +130,64 @@ class QueryUtils final {
       return Status::Error(folly::stringPrintf("Fail to read prop %s ", propName.c_str()));
     }
     if (field->type() == nebula::cpp2::PropertyType::FIXED_STRING) {
-      const auto& fixedStr = value.getStr();
-      return fixedStr.substr(0, fixedStr.find_first_of('\0'));
+      // Trimmed in place rather than copied
+      auto& fixedStr = value.mutableStr();
+      fixedStr.resize(std::min(fixedStr.size(), fixedStr.find_first_of('\0')));
+    }
+    return value;
+  }
+
+  /**
+   * @brief Get value of the prop not in the schema of the row, which is the default value or null
+   * of the field in the latest schema
+   *
+   * @param propName Field name
+   * @param field Field definition in the latest schema
+   * @return StatusOr<nebula::Value>
+   */
+  static StatusOr<nebula::Value> readMissingValue(
+      const std::string& propName, const meta::NebulaSchemaProvider::SchemaField* field) {
+    if (!field) {
+      return Value(NullType::UNKNOWN_PROP);
+    }
+    if (field->hasDefault()) {
+      DefaultValueContext expCtx;
+      ObjectPool pool;
+      auto& exprStr = field->defaultValue();
+      auto expr = Expression::decode(&pool, folly::StringPiece(exprStr.data(), exprStr.size()));
+      return Expression::eval(expr, expCtx);
+    } else if (field->nullable()) {
+      return NullType::__NULL__;
+    }
+    return Status::Error(folly::stringPrintf("Fail to read prop %s ", propName.c_str()));
+  }
+
+  /**
+   * @brief Get value of the prop by the field resolved by PropProjection
+   *
+   * @param reader Value set
+   * @param prop Prop to read
+   * @param projected Field of the prop in the schema of the reader
+   * @return StatusOr<nebula::Value>
+   */
+  static StatusOr<nebula::Value> readValue(RowReaderWrapper* reader,
+                                           const PropContext& prop,
+                                           const PropProjection::Field& projected) {
+    if (projected.index < 0) {
+      NG_RETURN_IF_ERROR(projected.status);
+      return projected.missing;
+    }
+    auto value = reader->getValueByIndex(projected.index);
+    if (value.type() == Value::Type::NULLVALUE) {
+      if (value.getNull() == NullType::__NULL__ && prop.field_ != nullptr &&
+          prop.field_->nullable()) {
+        return value;
+      }
+      return Status::Error(folly::stringPrintf("Fail to read prop %s ", prop.name_.c_str()));
+    }
+    if (projected.fixedString) {
+      auto& fixedStr = value.mutableStr();
+      fixedStr.resize(std::min(fixedStr.size(), fixedStr.find_first_of('\0')));
     }
     return value;
   }
@@ -132,10 +215,14 @@ class QueryUtils final {
                                               size_t vIdLen,
                                               bool isIntId,
                                               RowReaderWrapper* reader,
-                                              const PropContext& prop) {
+                                              const PropContext& prop,
+                                              const PropProjection::Field* projected = nullptr) {
     switch (prop.propInKeyType_) {
       // prop in value
       case PropContext::PropInKeyType::NONE: {
+        if (projected != nullptr) {
+          return readValue(reader, prop, *projected);
+        }
         return readValue(reader, prop.name_, prop.field_);
       }
       case PropContext::PropInKeyType::SRC: {
@@ -172,10 +259,14 @@ class QueryUtils final {
                                                 size_t vIdLen,
                                                 bool isIntId,
                                                 RowReaderWrapper* reader,
-                                                const PropContext& prop) {
+                                                const PropContext& prop,
+                                                const PropProjection::Field* projected = nullptr) {
     switch (prop.propInKeyType_) {
       // prop in value
       case PropContext::PropInKeyType::NONE: {
+        if (projected != nullptr) {
+          return readValue(reader, prop, *projected);
+        }
         return readValue(reader, prop.name_, prop.field_);
       }
       case PropContext::PropInKeyType::VID: {
@@ -203,12 +294,19 @@ class QueryUtils final {
                                    const std::vector<PropContext>* props,
                                    nebula::List& list,
                                    StorageExpressionContext* expCtx = nullptr,
-                                   const std::string& tagName = "") {
-    for (const auto& prop : *props) {
+                                   const std::string& tagName = "",
+                                   PropProjection* projection = nullptr) {
+    const std::vector<PropProjection::Field>* fields = nullptr;
+    if (projection != nullptr && reader != nullptr) {
+      fields = &projection->fields(reader->getSchema(), props);
+    }
+    for (size_t i = 0; i < props->size(); i++) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
+      auto value = QueryUtils::readVertexProp(
+          key, vIdLen, isIntId, reader, prop, fields != nullptr ? &(*fields)[i] : nullptr);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -228,12 +326,19 @@ class QueryUtils final {
                                  const std::vector<PropContext>* props,
                                  nebula::List& list,
                                  StorageExpressionContext* expCtx = nullptr,
-                                 const std::string& edgeName = "") {
-    for (const auto& prop : *props) {
+                                 const std::string& edgeName = "",
+                                 PropProjection* projection = nullptr) {
+    const std::vector<PropProjection::Field>* fields = nullptr;
+    if (projection != nullptr && reader != nullptr) {
+      fields = &projection->fields(reader->getSchema(), props);
+    }
+    for (size_t i = 0; i < props->size(); i++) {
+      const auto& prop = (*props)[i];
       if (!(prop.returned_ || (prop.filtered_ && expCtx != nullptr))) {
         continue;
       }
-      auto value = QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
+      auto value = QueryUtils::readEdgeProp(
+          key, vIdLen, isIntId, reader, prop, fields != nullptr ? &(*fields)[i] : nullptr);
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
@@ -281,6 +386,41 @@ class QueryUtils final {
   }
 };
 
+inline const std::vector<PropProjection::Field>& PropProjection::fields(
+    const meta::NebulaSchemaProvider* schema, const std::vector<PropContext>* props) {
+  if (last_ < plans_.size() && plans_[last_].schema == schema && plans_[last_].props == props) {
+    return plans_[last_].fields;
+  }
+  for (size_t i = 0; i < plans_.size(); i++) {
+    if (plans_[i].schema == schema && plans_[i].props == props) {
+      last_ = i;
+      return plans_[i].fields;
+    }
+  }
+  Plan plan{schema, props, {}};
+  plan.fields.reserve(props->size());
+  for (const auto& prop : *props) {
+    Field field;
+    if (prop.propInKeyType_ == PropContext::PropInKeyType::NONE) {
+      field.index = schema->getFieldIndex(prop.name_);
+      field.fixedString =
+          prop.field_ != nullptr && prop.field_->type() == nebula::cpp2::PropertyType::FIXED_STRING;
+      if (field.index < 0) {
+        auto missing = QueryUtils::readMissingValue(prop.name_, prop.field_);
+        if (missing.ok()) {
+          field.missing = std::move(missing).value();
+        } else {
+          field.status = missing.status();
+        }
+      }
+    }
+    plan.fields.emplace_back(std::move(field));
+  }
+  plans_.emplace_back(std::move(plan));
+  last_ = plans_.size() - 1;
+  return plans_[last_].fields;
+}
+
 }  // namespace storage
 }  // namespace nebula
 #endif  // STORAGE_EXEC_QUERYUTILS_H_
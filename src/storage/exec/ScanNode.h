@@ -71,7 +71,12 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
 
     std::unique_ptr<kvstore::KVIterator> iter;
     auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->planContext_->spaceId_, partId, start, prefix, &iter, enableReadFollower_);
+        context_->planContext_->spaceId_,
+        partId,
+        start,
+        prefix,
+        &iter,
+        enableReadFollower_ || context_->canReadFromFollower(partId));
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -80,6 +85,7 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
     auto vIdLen = context_->vIdLen();
     auto isIntId = context_->isIntId();
     std::string currentVertexId;
+    bool sampled = true;
     for (; iter->valid() && static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit;
          iter->next()) {
       auto key = iter->key();
@@ -89,16 +95,23 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
         continue;
       }
       auto vertexId = NebulaKeyUtils::getVertexId(vIdLen, key);
-      if (vertexId != currentVertexId && !currentVertexId.empty()) {
-        ret = collectOneRow(isIntId, vIdLen, currentVertexId);
-        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-          return ret;
-        }
-      }  // collect vertex row
+      if (vertexId != currentVertexId) {
+        if (!currentVertexId.empty()) {
+          ret = collectOneRow(isIntId, vIdLen, currentVertexId);
+          if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+            return ret;
+          }
+        }  // collect vertex row
+        // A vertex is sampled with all of its tags
+        sampled = context_->sampled();
+      }
       currentVertexId = vertexId;
       if (static_cast<int64_t>(resultDataSet_->rowSize()) >= rowLimit) {
         break;
       }
+      if (!sampled) {
+        continue;
+      }
       auto value = iter->val();
       tagNodes_[tagIdIndex->second]->doExecute(key.toString(), value.toString());
     }  // iterate key
@@ -150,9 +163,12 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
                 folly::StringPiece key,
                 RowReaderWrapper* reader,
                 const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-              for (const auto& prop : *props) {
+              const auto& fields = projection_.fields(reader->getSchema(), props);
+              for (size_t i = 0; i < props->size(); i++) {
+                const auto& prop = (*props)[i];
                 if (prop.returned_ || (prop.filtered_ && expCtx_ != nullptr)) {
-                  auto value = QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop);
+                  auto value =
+                      QueryUtils::readVertexProp(key, vIdLen, isIntId, reader, prop, &fields[i]);
                   if (!value.ok()) {
                     return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
                   }
@@ -200,6 +216,7 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
   nebula::DataSet* resultDataSet_;
   StorageExpressionContext* expCtx_{nullptr};
   Expression* filter_{nullptr};
+  PropProjection projection_;
 };
 
 // Node to scan edge of one partition
@@ -245,7 +262,12 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
 
     std::unique_ptr<kvstore::KVIterator> iter;
     auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->spaceId(), partId, start, prefix, &iter, enableReadFollower_);
+        context_->spaceId(),
+        partId,
+        start,
+        prefix,
+        &iter,
+        enableReadFollower_ || context_->canReadFromFollower(partId));
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -261,7 +283,7 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
       }
       auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, key);
       auto edgeNodeIndex = edgeNodesIndex_.find(edgeType);
-      if (edgeNodeIndex == edgeNodesIndex_.end()) {
+      if (edgeNodeIndex == edgeNodesIndex_.end() || !context_->sampled()) {
         continue;
       }
       auto value = iter->val();
@@ -308,9 +330,12 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
               folly::StringPiece key,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            for (const auto& prop : *props) {
+            const auto& fields = projection_.fields(reader->getSchema(), props);
+            for (size_t i = 0; i < props->size(); i++) {
+              const auto& prop = (*props)[i];
               if (prop.returned_ || (prop.filtered_ && expCtx_ != nullptr)) {
-                auto value = QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
+                auto value =
+                    QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop, &fields[i]);
                 if (!value.ok()) {
                   return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
                 }
@@ -357,6 +382,7 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
   nebula::DataSet* resultDataSet_;
   StorageExpressionContext* expCtx_{nullptr};
   Expression* filter_{nullptr};
+  PropProjection projection_;
 };
 
 }  // namespace storage
@@ -59,6 +59,39 @@ class StorageIterator {
   virtual RowReaderWrapper* reader() const = 0;
 };
 
+/**
+ * @brief Iterator over the edge rows of an adjacency block read from the adjacency cache. The
+ * block is shared with the cache and the other readers.
+ */
+class AdjacencyBlockIter final : public kvstore::KVIterator {
+ public:
+  explicit AdjacencyBlockIter(AdjacencyBlock block) : block_(std::move(block)) {}
+
+  bool valid() const override {
+    return pos_ < block_->size();
+  }
+
+  void next() override {
+    ++pos_;
+  }
+
+  void prev() override {
+    --pos_;
+  }
+
+  folly::StringPiece key() const override {
+    return (*block_)[pos_].first;
+  }
+
+  folly::StringPiece val() const override {
+    return (*block_)[pos_].second;
+  }
+
+ private:
+  AdjacencyBlock block_;
+  size_t pos_{0};
+};
+
 /**
  * @brief Iterator of single specified type
  *
@@ -9,6 +9,7 @@
 #include "common/base/Base.h"
 #include "storage/exec/RelNode.h"
 #include "storage/exec/StorageIterator.h"
+#include "storage/stats/StorageStats.h"
 
 namespace nebula {
 namespace storage {
@@ -53,6 +54,15 @@ class TagNode final : public IterateNode<VertexID> {
     name_ = "TagNode";
   }
 
+  ~TagNode() override {
+    if (cacheHits_ > 0) {
+      stats::StatsManager::addValue(kNumVertexCacheHits, cacheHits_);
+    }
+    if (cacheMisses_ > 0) {
+      stats::StatsManager::addValue(kNumVertexCacheMisses, cacheMisses_);
+    }
+  }
+
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
     valid_ = false;
     auto ret = RelNode::doExecute(partId, vId);
@@ -63,8 +73,35 @@ class TagNode final : public IterateNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", tagId " << tagId_ << ", prop size "
             << props_->size();
     key_ = NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_);
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &value_);
+    if (!prefetched_.empty()) {
+      auto found = prefetched_.find(key_);
+      if (found != prefetched_.end()) {
+        if (!found->second.has_value()) {
+          return nebula::cpp2::ErrorCode::SUCCEEDED;
+        }
+        return doExecute(key_, found->second.value());
+      }
+    }
+    // The cache is evicted by the writes on leader, so it's bypassed by the follower reads
+    auto followerRead = context_->canReadFromFollower(partId);
+    auto* cache = followerRead ? nullptr : context_->env()->vertexCache_.get();
+    uint64_t epoch = 0;
+    if (cache != nullptr) {
+      auto cached = cache->get(context_->spaceId(), key_);
+      if (cached.has_value()) {
+        ++cacheHits_;
+        value_ = std::move(cached).value();
+        resetReader();
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      }
+      ++cacheMisses_;
+      epoch = cache->epoch();
+    }
+    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &value_, followerRead);
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      if (cache != nullptr) {
+        cache->fill(context_->spaceId(), key_, value_, epoch);
+      }
       return doExecute(key_, value_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       // regard key not found as succeed as well, upper node will handle it
@@ -73,6 +110,85 @@ class TagNode final : public IterateNode<VertexID> {
     return ret;
   }
 
+  /**
+   * @brief Read value as the row of key rather than the kvstore, for the update reading the row
+   * submitted but not committed yet.
+   *
+   * @see UpdateCoalescer
+   */
+  void setPending(std::string key, std::string value) {
+    prefetched_.insert_or_assign(std::move(key), std::move(value));
+  }
+
+  /**
+   * @brief Read the tag of the vids of a part in one batch, so that doExecute of them needn't
+   * read the kvstore key by key. The keys failed to read are left to doExecute.
+   *
+   * @param partId Partition of the vids.
+   * @param vIds Vids to read.
+   */
+  void prefetch(PartitionID partId, const std::vector<VertexID>& vIds) {
+    prefetched_.clear();
+    std::vector<std::string> keys;
+    keys.reserve(vIds.size());
+    for (const auto& vId : vIds) {
+      keys.emplace_back(NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_));
+    }
+    // The sorted keys are read in the order of the engine
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    auto followerRead = context_->canReadFromFollower(partId);
+    auto* cache = followerRead ? nullptr : context_->env()->vertexCache_.get();
+    uint64_t epoch = 0;
+    if (cache != nullptr) {
+      auto missed = keys.begin();
+      for (auto& key : keys) {
+        auto cached = cache->get(context_->spaceId(), key);
+        if (cached.has_value()) {
+          ++cacheHits_;
+          prefetched_.emplace(std::move(key), std::move(cached));
+        } else {
+          ++cacheMisses_;
+          if (&*missed != &key) {
+            *missed = std::move(key);
+          }
+          ++missed;
+        }
+      }
+      keys.erase(missed, keys.end());
+      epoch = cache->epoch();
+    }
+    if (keys.empty()) {
+      return;
+    }
+    // The values are copied once from the pinned blocks into the prefetched rows
+    std::vector<std::optional<std::string>> values(keys.size());
+    auto ret = context_->env()->kvstore_->multiGetView(
+        context_->spaceId(),
+        partId,
+        keys,
+        [&](size_t i, folly::StringPiece value) {
+          if (cache != nullptr) {
+            cache->fill(context_->spaceId(), keys[i], value.str(), epoch);
+          }
+          values[i] = value.str();
+        },
+        followerRead);
+    if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return;
+    }
+    const auto& status = ret.second;
+    prefetched_.reserve(keys.size());
+    for (size_t i = 0; i < keys.size() && i < status.size(); i++) {
+      if (status[i].ok()) {
+        prefetched_.emplace(std::move(keys[i]), std::move(values[i]));
+      } else if (status[i].code() == Status::Code::kKeyNotFound) {
+        prefetched_.emplace(std::move(keys[i]), std::nullopt);
+      }
+    }
+  }
+
   /**
    * @brief For resuming from a breakpoint.
    *
@@ -165,6 +281,11 @@ class TagNode final : public IterateNode<VertexID> {
   std::string key_;
   std::string value_;
   RowReaderWrapper reader_;
+  // The values read by prefetch, nullopt if the key is not found
+  std::unordered_map<std::string, std::optional<std::string>> prefetched_;
+  // Flushed to the stats when the plan is done, rather than for each row
+  int64_t cacheHits_{0};
+  int64_t cacheMisses_{0};
 };
 
 }  // namespace storage
@@ -8,12 +8,19 @@
 
 #include "common/base/Base.h"
 #include "common/expression/Expression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/function/FunctionManager.h"
+#include "common/stats/ContentionStats.h"
 #include "common/utils/OperationKeyUtils.h"
 #include "kvstore/LogEncoder.h"
 #include "storage/StorageFlags.h"
 #include "storage/context/StorageExpressionContext.h"
+#include "storage/exec/EdgeNode.h"
 #include "storage/exec/FilterNode.h"
 #include "storage/exec/TagNode.h"
+#include "storage/mutate/UpdateCoalescer.h"
+#include "storage/stats/StorageStats.h"
 
 namespace nebula {
 namespace storage {
@@ -156,6 +163,55 @@ class UpdateNode : public RelNode<T> {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  /**
+   * @brief Evaluate `prop = f(prop, operand)` by mutating the collection of prop in place, where f
+   * is a collection mutation such as setadd or listappend, so the collection is not copied. The
+   * prop in the expression context is updated as well.
+   *
+   * @param name The name of the tag or the edge updated
+   * @param propKind kSrcProperty for the tag, kEdgeProperty for the edge
+   * @param propName Updated property name
+   * @param updateExp Update expression
+   * @return Whether the update is applied, otherwise the expression should be evaluated as usual.
+   */
+  bool mutateInPlace(const std::string& name,
+                     Expression::Kind propKind,
+                     const std::string& propName,
+                     Expression* updateExp) {
+    if (updateExp->kind() != Expression::Kind::kFunctionCall) {
+      return false;
+    }
+    auto* funcExpr = static_cast<FunctionCallExpression*>(updateExp);
+    const auto& args = funcExpr->args()->args();
+    if (args.size() != 2 || args[0]->kind() != propKind) {
+      return false;
+    }
+    // The prop of another tag or edge with the same name is not the one updated
+    auto* propExpr = static_cast<const PropertyExpression*>(args[0]);
+    if (propExpr->sym() != name || propExpr->prop() != propName) {
+      return false;
+    }
+    auto iter = props_.find(propName);
+    if (iter == props_.end()) {
+      return false;
+    }
+    auto setProp = [&](Value value) {
+      if (propKind == Expression::Kind::kSrcProperty) {
+        expCtx_->setTagProp(name, propName, std::move(value));
+      } else {
+        expCtx_->setEdgeProp(name, propName, std::move(value));
+      }
+    };
+    // Taken before the prop is dropped from the context, it may read the prop
+    Value operand = args[1]->eval(*expCtx_);
+    // The context holds a copy sharing the collection of the prop, which is dropped so the prop
+    // is its only owner, or else the collection would be copied before it's written
+    setProp(Value());
+    auto mutated = FunctionManager::mutateInPlace(funcExpr->name(), iter->second, operand);
+    setProp(iter->second);
+    return mutated;
+  }
+
  protected:
   // ============================ input
   // =====================================================
@@ -230,14 +286,34 @@ class UpdateTagNode : public UpdateNode<VertexID> {
 
     // Update is read-modify-write, which is an atomic operation.
     std::vector<VMLI> dummyLock = {std::make_tuple(context_->spaceId(), partId, tagId_, vId)};
-    nebula::MemoryLockGuard<VMLI> lg(context_->env()->verticesML_.get(), std::move(dummyLock));
+    // The updates of a hot vertex wait for each other, instead of failing to be retried
+    nebula::MemoryLockGuard<VMLI> lg(context_->env()->verticesML_.get(),
+                                     std::move(dummyLock),
+                                     std::chrono::milliseconds(FLAGS_update_lock_wait_ms));
+    if (lg.waited()) {
+      stats::StatsManager::addValue(kNumLockConflicts);
+      static auto waits = stats::lockWaitHisto("vertex_update");
+      waits->add(lg.waitedUs());
+    }
     if (!lg) {
+      stats::StatsManager::addValue(kNumLockTimeouts);
       auto conflict = lg.conflictKey();
       LOG(ERROR) << "vertex conflict " << std::get<0>(conflict) << ":" << std::get<1>(conflict)
                  << ":" << std::get<2>(conflict) << ":" << std::get<3>(conflict);
       return nebula::cpp2::ErrorCode::E_DATA_CONFLICT_ERROR;
     }
 
+    auto* coalescer = tagNode_ != nullptr ? context_->env()->updateCoalescer_.get() : nullptr;
+    UpdateCoalescer::Request req;
+    if (coalescer != nullptr) {
+      // The row submitted by the last update of the vertex is read, which may not be committed
+      req.key = NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_);
+      std::string row;
+      if (coalescer->pending(context_->spaceId(), partId, &req, &row)) {
+        tagNode_->setPending(req.key, std::move(row));
+      }
+    }
+
     auto ret = RelNode::doExecute(partId, vId);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
@@ -268,21 +344,43 @@ class UpdateTagNode : public UpdateNode<VertexID> {
       return ret;
     }
 
+    // key_ is moved into the batch
+    auto tagKey = this->key_;
     auto batch = this->updateAndWriteBack(partId, vId);
     if (batch == std::nullopt) {
       return nebula::cpp2::ErrorCode::E_INVALID_DATA;
     }
 
-    folly::Baton<true, std::atomic> baton;
-    auto callback = [&ret, &baton](nebula::cpp2::ErrorCode code) {
-      ret = code;
-      baton.post();
-    };
-    context_->env()->kvstore_->asyncAppendBatch(
-        context_->spaceId(), partId, std::move(batch).value(), callback);
-    baton.wait();
+    if (coalescer != nullptr) {
+      req.batch = std::move(batch).value();
+      coalescer->submit(context_->spaceId(), partId, &req);
+      // The next update of the vertex needn't wait for the commit of this one
+      lg.unlock();
+      ret = coalescer->wait(context_->spaceId(), partId, &req);
+    } else {
+      folly::Baton<true, std::atomic> baton;
+      auto callback = [&ret, &baton](nebula::cpp2::ErrorCode code) {
+        ret = code;
+        baton.post();
+      };
+      context_->env()->kvstore_->asyncAppendBatch(
+          context_->spaceId(), partId, std::move(batch).value(), callback);
+      baton.wait();
+    }
+    if (context_->env()->vertexCache_ != nullptr) {
+      context_->env()->vertexCache_->evict(context_->spaceId(), {tagKey});
+    }
     return ret;
   }
+
+  /**
+   * @brief Set the TagNode the vertex is read by, so the updates of the vertex are coalesced if
+   * the UpdateCoalescer is on.
+   */
+  void setTagNode(TagNode* tagNode) {
+    tagNode_ = tagNode;
+  }
+
   /**
    * @brief Get the Latest Tag Schema And Name object
    *
@@ -397,6 +495,9 @@ class UpdateTagNode : public UpdateNode<VertexID> {
         LOG(ERROR) << "Update expression decode failed " << updateProp.get_value();
         return std::nullopt;
       }
+      if (this->mutateInPlace(tagName_, Expression::Kind::kSrcProperty, propName, updateExp)) {
+        continue;
+      }
       auto updateVal = updateExp->eval(*expCtx_);
       // update prop value to props_
       props_[propName] = updateVal;
@@ -514,6 +615,7 @@ class UpdateTagNode : public UpdateNode<VertexID> {
   TagContext* tagContext_;
   TagID tagId_;
   std::string tagName_;
+  TagNode* tagNode_{nullptr};
 };
 
 /**
@@ -557,8 +659,16 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
                                                    edgeKey.get_edge_type(),
                                                    edgeKey.get_ranking(),
                                                    edgeKey.get_dst().getStr())};
-    nebula::MemoryLockGuard<EMLI> lg(context_->env()->edgesML_.get(), std::move(dummyLock));
+    nebula::MemoryLockGuard<EMLI> lg(context_->env()->edgesML_.get(),
+                                     std::move(dummyLock),
+                                     std::chrono::milliseconds(FLAGS_update_lock_wait_ms));
+    if (lg.waited()) {
+      stats::StatsManager::addValue(kNumLockConflicts);
+      static auto waits = stats::lockWaitHisto("edge_update");
+      waits->add(lg.waitedUs());
+    }
     if (!lg) {
+      stats::StatsManager::addValue(kNumLockTimeouts);
       auto conflict = lg.conflictKey();
       LOG(ERROR) << "edge conflict " << std::get<0>(conflict) << ":" << std::get<1>(conflict) << ":"
                  << std::get<2>(conflict) << ":" << std::get<3>(conflict) << ":"
@@ -566,6 +676,22 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
       return nebula::cpp2::ErrorCode::E_DATA_CONFLICT_ERROR;
     }
 
+    auto* coalescer = edgeNode_ != nullptr ? context_->env()->updateCoalescer_.get() : nullptr;
+    UpdateCoalescer::Request req;
+    if (coalescer != nullptr) {
+      // The row submitted by the last update of the edge is read, which may not be committed
+      req.key = NebulaKeyUtils::edgeKey(context_->vIdLen(),
+                                        partId,
+                                        edgeKey.get_src().getStr(),
+                                        edgeKey.get_edge_type(),
+                                        edgeKey.get_ranking(),
+                                        edgeKey.get_dst().getStr());
+      std::string row;
+      if (coalescer->pending(context_->spaceId(), partId, &req, &row)) {
+        edgeNode_->setPending(req.key, std::move(row));
+      }
+    }
+
     auto op = [&partId, &edgeKey, this]() -> std::optional<std::string> {
       this->exeResult_ = RelNode::doExecute(partId, edgeKey);
       if (this->exeResult_ == nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -616,17 +742,39 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
       return this->exeResult_;
     }
 
-    folly::Baton<true, std::atomic> baton;
-    auto callback = [&ret, &baton](nebula::cpp2::ErrorCode code) {
-      ret = code;
-      baton.post();
-    };
-
-    context_->planContext_->env_->kvstore_->asyncAppendBatch(
-        context_->planContext_->spaceId_, partId, std::move(batch).value(), callback);
-    baton.wait();
+    if (coalescer != nullptr) {
+      req.batch = std::move(batch).value();
+      coalescer->submit(context_->spaceId(), partId, &req);
+      // The next update of the edge needn't wait for the commit of this one
+      lg.unlock();
+      ret = coalescer->wait(context_->spaceId(), partId, &req);
+    } else {
+      folly::Baton<true, std::atomic> baton;
+      auto callback = [&ret, &baton](nebula::cpp2::ErrorCode code) {
+        ret = code;
+        baton.post();
+      };
+
+      context_->planContext_->env_->kvstore_->asyncAppendBatch(
+          context_->planContext_->spaceId_, partId, std::move(batch).value(), callback);
+      baton.wait();
+    }
+    if (context_->env()->adjacencyCache_ != nullptr) {
+      auto prefix = NebulaKeyUtils::edgePrefix(
+          context_->vIdLen(), partId, edgeKey.get_src().getStr(), edgeKey.get_edge_type());
+      context_->env()->adjacencyCache_->evict(context_->spaceId(), {prefix});
+    }
     return ret;
   }
+
+  /**
+   * @brief Set the FetchEdgeNode the edge is read by, so the updates of the edge are coalesced if
+   * the UpdateCoalescer is on.
+   */
+  void setEdgeNode(FetchEdgeNode* edgeNode) {
+    edgeNode_ = edgeNode;
+  }
+
   /**
    * @brief Get the Latest Edge Schema And Name object
    *
@@ -750,6 +898,9 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
       if (!updateExp) {
         return std::nullopt;
       }
+      if (this->mutateInPlace(edgeName_, Expression::Kind::kEdgeProperty, propName, updateExp)) {
+        continue;
+      }
       auto updateVal = updateExp->eval(*expCtx_);
       // update prop value to updateContext_
       props_[propName] = updateVal;
@@ -839,7 +990,24 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
         }
       }
     }
-    // step 3, insert new edge data
+    // step 3, merge the changes of the aggregates materialized, the edge is locked by the update
+    auto aggregates = CommonUtils::neighborhoodAggregates(schema_);
+    if (!aggregates.empty()) {
+      auto code = CommonUtils::mergeNeighborhood(context_->env(),
+                                                 context_->spaceId(),
+                                                 context_->vIdLen(),
+                                                 partId,
+                                                 key_,
+                                                 val_,
+                                                 nVal,
+                                                 aggregates,
+                                                 batchHolder.get());
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << "Bad format row";
+        return std::nullopt;
+      }
+    }
+    // step 4, insert new edge data
     batchHolder->put(std::move(key_), std::move(nVal));
 
     // extra phase: if there are some extra requirement.
@@ -873,6 +1041,7 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
   EdgeContext* edgeContext_;
   EdgeType edgeType_;
   std::string edgeName_;
+  FetchEdgeNode* edgeNode_{nullptr};
 };
 
 }  // namespace storage
@@ -48,6 +48,10 @@ folly::dynamic StorageHttpStatsHandler::getStats() const {
   return stats;
 }
 
+std::string StorageHttpStatsHandler::getPrometheus() const {
+  return toPrometheus(getStats());
+}
+
 bool StorageHttpStatsHandler::statFiltered(const std::string& stat) const {
   if (statNames_.empty()) {
     return false;
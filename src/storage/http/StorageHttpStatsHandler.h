@@ -21,6 +21,8 @@ class StorageHttpStatsHandler : public nebula::GetStatsHandler {
   StorageHttpStatsHandler() = default;
   void onError(proxygen::ProxygenError err) noexcept override;
   folly::dynamic getStats() const override;
+  // Only the stats of rocksdb
+  std::string getPrometheus() const override;
 
  private:
   bool statFiltered(const std::string& stat) const;
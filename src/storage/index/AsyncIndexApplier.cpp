@@ -0,0 +1,233 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/index/AsyncIndexApplier.h"
+
+#include <folly/synchronization/Baton.h>
+
+#include "common/time/WallClock.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "common/utils/OperationKeyUtils.h"
+#include "kvstore/LogEncoder.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+bool AsyncIndexApplier::start() {
+  worker_ = std::make_unique<thread::GenericWorker>();
+  if (!worker_->start("async-index-applier")) {
+    LOG(ERROR) << "Start the async index applier failed";
+    return false;
+  }
+  worker_->addRepeatTask(FLAGS_async_index_interval_ms, &AsyncIndexApplier::applyAll, this);
+  return true;
+}
+
+void AsyncIndexApplier::stop() {
+  if (worker_ != nullptr) {
+    worker_->stop();
+    worker_->wait();
+    worker_.reset();
+  }
+}
+
+void AsyncIndexApplier::applyAll() {
+  std::unordered_map<GraphSpaceID, std::vector<meta::cpp2::LeaderInfo>> leaders;
+  env_->kvstore_->allLeader(leaders);
+  for (const auto& [space, infos] : leaders) {
+    for (const auto& info : infos) {
+      auto code = applyPart(space, info.get_part_id());
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        VLOG(1) << "Apply the async indexes of space " << space << " part " << info.get_part_id()
+                << " failed: " << apache::thrift::util::enumNameSafe(code);
+      }
+    }
+  }
+}
+
+nebula::cpp2::ErrorCode AsyncIndexApplier::applyPart(GraphSpaceID space, PartitionID part) {
+  auto vIdLen = env_->schemaMan_->getSpaceVidLen(space);
+  if (!vIdLen.ok()) {
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  auto tagIndexes = env_->indexMan_->getTagIndexes(space);
+  auto edgeIndexes = env_->indexMan_->getEdgeIndexes(space);
+  if (!tagIndexes.ok() || !edgeIndexes.ok()) {
+    return nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND;
+  }
+
+  // The parts of the spaces without async indexes are passed, unless there are records written
+  // before the indexes were no longer async
+  bool hasAsync = false;
+  for (const auto* indexes : {&tagIndexes.value(), &edgeIndexes.value()}) {
+    for (const auto& index : *indexes) {
+      hasAsync = hasAsync || CommonUtils::isAsyncIndex(*index);
+    }
+  }
+  auto prefix = OperationKeyUtils::pendingIndexPrefix(part);
+  if (!hasAsync) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto code = env_->kvstore_->prefix(space, part, prefix, &iter);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED || !iter->valid()) {
+      return code;
+    }
+  }
+
+  // The rows are applied to all the indexes of them, the ones not async are idempotent, so the
+  // records written before an index is no longer async are applied too
+  int64_t passStart = 0;
+  int64_t minPending = std::numeric_limits<int64_t>::max();
+  auto atomicOp = [&, vIdLen = static_cast<size_t>(vIdLen.value())]() {
+    kvstore::MergeableAtomicOpResult ret;
+    ret.code = nebula::cpp2::ErrorCode::E_RAFT_ATOMIC_OP_FAILED;
+    // The writes began in the atomic ops before this one
+    passStart = time::WallClock::fastNowInMicroSec();
+    minPending = std::numeric_limits<int64_t>::max();
+
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto code = env_->kvstore_->prefix(space, part, prefix, &iter);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      ret.code = code;
+      return ret;
+    }
+    auto batchHolder = std::make_unique<kvstore::BatchHolder>();
+    int32_t count = 0;
+    for (; iter->valid(); iter->next()) {
+      if (count >= FLAGS_async_index_batch_size) {
+        // The ones left to the next pass hold the watermark
+        minPending = std::min(minPending, OperationKeyUtils::getPendingTs(iter->val()));
+        continue;
+      }
+      ++count;
+      auto pendingKey = iter->key().str();
+      auto dataKey = OperationKeyUtils::getPendingDataKey(pendingKey);
+      auto oldValue = OperationKeyUtils::getPendingOldValue(iter->val());
+      std::string newValue;
+      code = env_->kvstore_->get(space, part, dataKey, &newValue);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+          code != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        ret.code = code;
+        return ret;
+      }
+
+      bool isTag = NebulaKeyUtils::isTag(vIdLen, dataKey);
+      const std::vector<std::shared_ptr<meta::cpp2::IndexItem>>* indexes = nullptr;
+      std::shared_ptr<const meta::NebulaSchemaProvider> schema;
+      SchemaID schemaId;
+      if (isTag) {
+        schemaId = NebulaKeyUtils::getTagId(vIdLen, dataKey);
+        schema = env_->schemaMan_->getTagSchema(space, schemaId);
+        indexes = &tagIndexes.value();
+      } else {
+        schemaId = NebulaKeyUtils::getEdgeType(vIdLen, dataKey);
+        schema = env_->schemaMan_->getEdgeSchema(space, schemaId);
+        indexes = &edgeIndexes.value();
+      }
+      if (schema != nullptr) {
+        auto reader = [&](folly::StringPiece value) {
+          return isTag ? RowReaderWrapper::getTagPropReader(
+                             env_->schemaMan_, space, schemaId, value)
+                       : RowReaderWrapper::getEdgePropReader(
+                             env_->schemaMan_, space, schemaId, value);
+        };
+        RowReaderWrapper oldReader;
+        RowReaderWrapper newReader;
+        if (!oldValue.empty()) {
+          oldReader = reader(oldValue);
+        }
+        if (!newValue.empty()) {
+          newReader = reader(newValue);
+        }
+        std::string indexVal;
+        if (newReader != nullptr) {
+          auto field = CommonUtils::ttlValue(schema.get(), newReader.get());
+          indexVal = field.ok() ? IndexKeyUtils::indexVal(std::move(field).value()) : "";
+        }
+        for (const auto& index : *indexes) {
+          auto indexSchemaId = isTag ? index->get_schema_id().get_tag_id()
+                                     : index->get_schema_id().get_edge_type();
+          if (indexSchemaId != schemaId) {
+            continue;
+          }
+          if (oldReader != nullptr) {
+            for (auto& idxKey : indexKeys(
+                     vIdLen, part, dataKey, isTag, oldReader.get(), index.get(), schema.get())) {
+              ret.writeSet.emplace_back(idxKey);
+              batchHolder->remove(std::move(idxKey));
+            }
+          }
+          if (newReader != nullptr) {
+            for (auto& idxKey : indexKeys(
+                     vIdLen, part, dataKey, isTag, newReader.get(), index.get(), schema.get())) {
+              ret.writeSet.emplace_back(idxKey);
+              batchHolder->put(std::move(idxKey), std::string(indexVal));
+            }
+          }
+        }
+      }
+      ret.readSet.emplace_back(dataKey);
+      ret.readSet.emplace_back(pendingKey);
+      ret.writeSet.emplace_back(pendingKey);
+      batchHolder->remove(std::move(pendingKey));
+    }
+    ret.batch = encodeBatchValue(batchHolder->getBatch());
+    ret.code = nebula::cpp2::ErrorCode::SUCCEEDED;
+    return ret;
+  };
+
+  folly::Baton<true, std::atomic> baton;
+  auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
+  env_->kvstore_->asyncAtomicOp(
+      space, part, std::move(atomicOp), [&result, &baton](nebula::cpp2::ErrorCode code) {
+        result = code;
+        baton.post();
+      });
+  baton.wait();
+  if (result != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return result;
+  }
+
+  // The writes before the last pass began are all committed before this pass, so they're either
+  // applied or left with minPending
+  auto key = std::make_tuple(space, part);
+  auto lastPass = lastPass_.find(key);
+  if (lastPass != lastPass_.end()) {
+    env_->asyncIndexWatermark_.insert_or_assign(key, std::min(lastPass->second, minPending));
+  }
+  lastPass_[key] = passStart;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+std::vector<std::string> AsyncIndexApplier::indexKeys(size_t vIdLen,
+                                                      PartitionID part,
+                                                      const std::string& dataKey,
+                                                      bool isTag,
+                                                      RowReaderWrapper* reader,
+                                                      const meta::cpp2::IndexItem* index,
+                                                      const meta::NebulaSchemaProvider* schema) {
+  auto values = IndexKeyUtils::collectIndexValues(reader, index, schema);
+  if (!values.ok()) {
+    return {};
+  }
+  if (isTag) {
+    return IndexKeyUtils::vertexIndexKeys(vIdLen,
+                                          part,
+                                          index->get_index_id(),
+                                          NebulaKeyUtils::getVertexId(vIdLen, dataKey).str(),
+                                          std::move(values).value());
+  }
+  return IndexKeyUtils::edgeIndexKeys(vIdLen,
+                                      part,
+                                      index->get_index_id(),
+                                      NebulaKeyUtils::getSrcId(vIdLen, dataKey).str(),
+                                      NebulaKeyUtils::getRank(vIdLen, dataKey),
+                                      NebulaKeyUtils::getDstId(vIdLen, dataKey).str(),
+                                      std::move(values).value());
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_INDEX_ASYNCINDEXAPPLIER_H_
+#define STORAGE_INDEX_ASYNCINDEXAPPLIER_H_
+
+#include "common/base/Base.h"
+#include "common/thread/GenericWorker.h"
+#include "storage/CommonUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief AsyncIndexApplier applies the writes to the async indexes, the ones named in
+ * async_index_names, in the background.
+ *
+ * The writes of the tags and the edges of async indexes don't write their entries, but a pending
+ * record of each row in the same batch, whose value is the row whose entries are the ones written.
+ * Each pass applies the pending records of each part led by the host in an atomic op: the entries
+ * of the old row are removed, the ones of the current row are put, and the record is removed. So
+ * the latency of the writes doesn't depend on the number of the async indexes.
+ *
+ * After each pass of a part, it advances the watermark of the part in StorageEnv, before which the
+ * writes are all applied, for the readers to wait for.
+ */
+class AsyncIndexApplier final {
+ public:
+  explicit AsyncIndexApplier(StorageEnv* env) : env_(env) {}
+
+  ~AsyncIndexApplier() {
+    stop();
+  }
+
+  bool start();
+
+  void stop();
+
+  /**
+   * @brief Apply at most async_index_batch_size pending records of the part, and advance the
+   * watermark of it. Called in the thread of the applier only, or by the tests.
+   */
+  nebula::cpp2::ErrorCode applyPart(GraphSpaceID space, PartitionID part);
+
+ private:
+  void applyAll();
+
+  // The index keys of the row of dataKey in index, the row is of a tag if isTag, or an out-edge
+  std::vector<std::string> indexKeys(size_t vIdLen,
+                                     PartitionID part,
+                                     const std::string& dataKey,
+                                     bool isTag,
+                                     RowReaderWrapper* reader,
+                                     const meta::cpp2::IndexItem* index,
+                                     const meta::NebulaSchemaProvider* schema);
+
+  StorageEnv* env_{nullptr};
+  std::unique_ptr<thread::GenericWorker> worker_;
+  // The time when the last pass of each part began
+  std::unordered_map<IndexKey, int64_t> lastPass_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_INDEX_ASYNCINDEXAPPLIER_H_
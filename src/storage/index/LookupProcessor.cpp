@@ -8,6 +8,7 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "common/memory/MemoryTracker.h"
+#include "common/time/WallClock.h"
 #include "folly/Likely.h"
 #include "interface/gen-cpp2/common_types.tcc"
 #include "interface/gen-cpp2/meta_types.tcc"
@@ -37,9 +38,11 @@ void LookupProcessor::process(const cpp2::LookupIndexRequest& req) {
 }
 
 void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
+  auto since = time::WallClock::fastNowInMicroSec();
   if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
     profileDetailFlag_ = true;
   }
+  samplePerfContext();
   auto code = prepare(req);
   if (UNLIKELY(code != ::nebula::cpp2::ErrorCode::SUCCEEDED)) {
     for (auto& p : req.get_parts()) {
@@ -71,6 +74,7 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
     onFinished();
     return;
   }
+  waitAsyncIndexes(req, since);
   if (!FLAGS_query_concurrently) {
     runInSingleThread(req.get_parts(), std::move(plan));
   } else {
@@ -118,8 +122,22 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::buildPlan(
     const cpp2::LookupIndexRequest& req) {
   std::vector<std::unique_ptr<IndexNode>> nodes;
+  // The contexts of the IN or OR on the columns of one index are scanned by one node rather than
+  // by a node for each of them and deduped
+  std::vector<std::vector<const cpp2::IndexQueryContext*>> groups;
   for (auto& ctx : req.get_indices().get_contexts()) {
-    auto scan = buildOneContext(ctx);
+    auto iter = std::find_if(groups.begin(), groups.end(), [&ctx](const auto& group) {
+      return group.front()->get_index_id() == ctx.get_index_id() &&
+             group.front()->get_filter() == ctx.get_filter();
+    });
+    if (iter == groups.end()) {
+      groups.emplace_back(1, &ctx);
+    } else {
+      iter->emplace_back(&ctx);
+    }
+  }
+  for (auto& group : groups) {
+    auto scan = buildOneContext(group);
     if (!ok(scan)) {
       return error(scan);
     }
@@ -143,12 +161,18 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
       dedup->addChild(std::move(node));
     }
     nodes.clear();
-    nodes[0] = std::move(dedup);
+    nodes.emplace_back(std::move(dedup));
   }
   if (req.limit_ref().has_value()) {
     auto limit = *req.get_limit();
+    limit_ = limit;
     if (req.order_by_ref().has_value() && req.get_order_by()->size() > 0) {
+      orderBy_ = *req.get_order_by();
+      returnColumns_ = *req.get_return_columns();
       auto node = std::make_unique<IndexTopNNode>(context_.get(), limit, req.get_order_by());
+      const auto& contexts = req.get_indices().get_contexts();
+      // The rows of several indexes are deduped in turn rather than merged in order
+      node->setOrdered(contexts.size() == 1 && scannedInOrder(contexts.front(), orderBy_));
       node->addChild(std::move(nodes[0]));
       nodes[0] = std::move(node);
     } else {
@@ -170,9 +194,29 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
   return std::move(nodes[0]);
 }
 
+void LookupProcessor::waitAsyncIndexes(const cpp2::LookupIndexRequest& req, int64_t since) {
+  auto waitMs = req.async_index_wait_ms_ref().value_or(0);
+  if (!hasAsyncIndex_ || waitMs <= 0) {
+    return;
+  }
+  auto deadline = since + waitMs * 1000;
+  for (auto part : req.get_parts()) {
+    while (env_->getAsyncIndexWatermark(req.get_space_id(), part) < since) {
+      if (time::WallClock::fastNowInMicroSec() >= deadline) {
+        VLOG(1) << "Wait for the async indexes of space " << req.get_space_id() << " part " << part
+                << " timeout";
+        return;
+      }
+      usleep(1000);
+    }
+  }
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::buildOneContext(
-    const cpp2::IndexQueryContext& ctx) {
-  std::unique_ptr<IndexNode> node;
+    const std::vector<const cpp2::IndexQueryContext*>& contexts) {
+  const auto& ctx = *contexts.front();
+  std::unique_ptr<IndexScanNode> node;
+  std::shared_ptr<meta::cpp2::IndexItem> index;
   DLOG(INFO) << ctx.get_column_hints().size();
   DLOG(INFO) << &ctx.get_column_hints();
   DLOG(INFO) << ::apache::thrift::SimpleJSONSerializer::serialize<std::string>(ctx);
@@ -181,7 +225,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
     if (!idx.ok()) {
       return nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND;
     }
-    auto cols = idx.value()->get_fields();
+    index = idx.value();
+    hasAsyncIndex_ = hasAsyncIndex_ || CommonUtils::isAsyncIndex(*index);
+    auto cols = index->get_fields();
     bool hasNullableCol =
         std::any_of(cols.begin(), cols.end(), [](const meta::cpp2::ColumnDef& col) {
           return col.nullable_ref().value_or(false);
@@ -196,7 +242,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
     if (!idx.ok()) {
       return nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND;
     }
-    auto cols = idx.value()->get_fields();
+    index = idx.value();
+    hasAsyncIndex_ = hasAsyncIndex_ || CommonUtils::isAsyncIndex(*index);
+    auto cols = index->get_fields();
     bool hasNullableCol =
         std::any_of(cols.begin(), cols.end(), [](const meta::cpp2::ColumnDef& col) {
           return col.nullable_ref().value_or(false);
@@ -207,13 +255,73 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
                                                  context_->env()->kvstore_,
                                                  hasNullableCol);
   }
+  for (size_t i = 1; i < contexts.size(); i++) {
+    node->addColumnHints(contexts[i]->get_column_hints());
+  }
   if (ctx.filter_ref().is_set() && !ctx.get_filter().empty()) {
     auto expr = Expression::decode(context_->objPool(), *ctx.filter_ref());
-    auto filterNode = std::make_unique<IndexSelectionNode>(context_.get(), expr);
-    filterNode->addChild(std::move(node));
-    node = std::move(filterNode);
+    SelectionExprVisitor vis;
+    expr->accept(&vis);
+    if (IndexScanNode::coveredByKey(*index, vis.getRequiredColumns())) {
+      // The filter is evaluated on the index key, and only the base data of the keys passing it
+      // is fetched
+      node->setKeyFilter(expr);
+    } else {
+      auto filterNode = std::make_unique<IndexSelectionNode>(context_.get(), expr);
+      filterNode->addChild(std::move(node));
+      return std::unique_ptr<IndexNode>(std::move(filterNode));
+    }
+  }
+  return std::unique_ptr<IndexNode>(std::move(node));
+}
+
+bool LookupProcessor::scannedInOrder(const cpp2::IndexQueryContext& ctx,
+                                     const std::vector<cpp2::OrderBy>& orderBy) {
+  auto index = context_->isEdge()
+                   ? env_->indexMan_->getEdgeIndex(context_->spaceId(), ctx.get_index_id())
+                   : env_->indexMan_->getTagIndex(context_->spaceId(), ctx.get_index_id());
+  if (!index.ok()) {
+    return false;
+  }
+  const auto& fields = index.value()->get_fields();
+  const auto& hints = ctx.get_column_hints();
+  // The columns of the prefix hints are the same in all the keys scanned
+  std::unordered_set<std::string> fixed;
+  size_t next = 0;
+  while (next < hints.size() && hints[next].get_scan_type() == cpp2::ScanType::PREFIX) {
+    fixed.emplace(hints[next].get_column_name());
+    ++next;
+  }
+  for (const auto& item : orderBy) {
+    if (item.get_direction() != cpp2::OrderDirection::ASCENDING) {
+      // The index is not scanned backward
+      return false;
+    }
+    if (fixed.find(item.get_prop()) != fixed.end()) {
+      continue;
+    }
+    if (next >= fields.size() || fields[next].get_name() != item.get_prop()) {
+      return false;
+    }
+    const auto& field = fields[next];
+    // The nulls are marked at the end of the keys, and the strings are truncated
+    if (field.nullable_ref().value_or(false)) {
+      return false;
+    }
+    switch (field.get_type().get_type()) {
+      case nebula::cpp2::PropertyType::BOOL:
+      case nebula::cpp2::PropertyType::INT64:
+      case nebula::cpp2::PropertyType::INT32:
+      case nebula::cpp2::PropertyType::INT16:
+      case nebula::cpp2::PropertyType::INT8:
+      case nebula::cpp2::PropertyType::TIMESTAMP:
+        break;
+      default:
+        return false;
+    }
+    ++next;
   }
-  return node;
+  return true;
 }
 
 void LookupProcessor::runInSingleThread(const std::vector<PartitionID>& parts,
@@ -260,6 +368,10 @@ void LookupProcessor::runInSingleThread(const std::vector<PartitionID>& parts,
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan.get());
   }
+  if (UNLIKELY(span_.sampled())) {
+    tracePlan(plan.get());
+  }
+  mergeLimitResult();
   onProcessFinished();
   onFinished();
 }
@@ -275,6 +387,7 @@ void LookupProcessor::runInMultipleThread(const std::vector<PartitionID>& parts,
         folly::via(executor_,
                    [this, plan = std::move(planCopy[i]), part = parts[i]]() -> ReturnType {
                      memory::MemoryCheckGuard guard;
+                     auto perf = perfScope();
                      ::nebula::cpp2::ErrorCode code = ::nebula::cpp2::ErrorCode::SUCCEEDED;
                      std::deque<Row> dataset;
                      plan->execute(part);
@@ -293,6 +406,9 @@ void LookupProcessor::runInMultipleThread(const std::vector<PartitionID>& parts,
                      if (UNLIKELY(profileDetailFlag_)) {
                        profilePlan(plan.get());
                      }
+                     if (UNLIKELY(span_.sampled())) {
+                       tracePlan(plan.get());
+                     }
                      Row statResult;
                      if (code == nebula::cpp2::ErrorCode::SUCCEEDED && statTypes_.size() > 0) {
                        auto indexAgg = dynamic_cast<IndexAggregateNode*>(plan.get());
@@ -334,6 +450,7 @@ void LookupProcessor::runInMultipleThread(const std::vector<PartitionID>& parts,
         // IndexAggregateNode has been copied and each part get it's own aggregate info,
         // we need to merge it
         this->mergeStatsResult(statResults);
+        this->mergeLimitResult();
         this->onProcessFinished();
         this->onFinished();
       })
@@ -351,6 +468,9 @@ LookupProcessor::handleStatProps(const std::vector<cpp2::StatProp>& statProps) {
 
   for (size_t statIdx = 0; statIdx < statProps.size(); statIdx++) {
     const auto& statProp = statProps[statIdx];
+    if (statProp.get_stat() == cpp2::StatType::COLLECT_SET) {
+      return nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
+    }
     statTypes_.emplace_back(statProp.get_stat());
     auto exp = Expression::decode(pool, *statProp.prop_ref());
     if (exp == nullptr) {
@@ -413,6 +533,42 @@ LookupProcessor::handleStatProps(const std::vector<cpp2::StatProp>& statProps) {
   return statInfos;
 }
 
+void LookupProcessor::mergeLimitResult() {
+  if (limit_ < 0 || resultDataSet_.rowSize() <= static_cast<size_t>(limit_)) {
+    return;
+  }
+  auto& rows = resultDataSet_.rows;
+  if (!orderBy_.empty()) {
+    std::vector<std::pair<size_t, cpp2::OrderDirection>> keys;
+    for (const auto& orderBy : orderBy_) {
+      auto iter = std::find(returnColumns_.begin(), returnColumns_.end(), orderBy.get_prop());
+      if (iter == returnColumns_.end()) {
+        // The order of the rows is unknown, keep all of them
+        return;
+      }
+      keys.emplace_back(iter - returnColumns_.begin(), orderBy.get_direction());
+    }
+    // Same order as IndexTopNNode
+    auto comparator = [&keys](const Row& lhs, const Row& rhs) -> bool {
+      for (const auto& [pos, direction] : keys) {
+        const auto& lValue = lhs[pos];
+        const auto& rValue = rhs[pos];
+        if (lValue == rValue) {
+          continue;
+        }
+        if (direction == cpp2::OrderDirection::ASCENDING) {
+          return lValue < rValue;
+        } else if (direction == cpp2::OrderDirection::DESCENDING) {
+          return lValue > rValue;
+        }
+      }
+      return false;
+    };
+    std::partial_sort(rows.begin(), rows.begin() + limit_, rows.end(), comparator);
+  }
+  rows.resize(limit_);
+}
+
 void LookupProcessor::mergeStatsResult(const std::vector<Row>& statsResult) {
   if (statsResult.size() == 0 || statTypes_.size() == 0) {
     return;
@@ -472,6 +628,20 @@ void LookupProcessor::profilePlan(IndexNode* root) {
     }
   }
 }
+void LookupProcessor::tracePlan(IndexNode* root) {
+  // The span of a node lasts for its accumulated time since the processor began
+  auto start = span_.startUs();
+  std::queue<IndexNode*> q;
+  q.push(root);
+  while (!q.empty()) {
+    auto node = q.front();
+    q.pop();
+    span_.addChild(node->identify(), start, start + node->duration().elapsedInUSec());
+    for (auto& child : node->children()) {
+      q.push(child.get());
+    }
+  }
+}
 inline void printPlan(IndexNode* node, int tab) {
   for (auto& child : node->children()) {
     printPlan(child.get(), tab + 1);
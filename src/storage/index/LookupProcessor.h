@@ -35,17 +35,40 @@ class LookupProcessor : public BaseProcessor<cpp2::LookupIndexResp> {
     BaseProcessor<cpp2::LookupIndexResp>::resp_.stat_data_ref() = std::move(statsDataSet_);
   }
   void profilePlan(IndexNode* plan);
+  // Export the spans of the nodes of plan, if the request is traced
+  void tracePlan(IndexNode* plan);
+  /**
+   * @brief Wait for the watermarks of the parts to pass since, if any index looked up is async and
+   * the request waits for them. The indexes are read anyway after the wait times out.
+   */
+  void waitAsyncIndexes(const cpp2::LookupIndexRequest& req, int64_t since);
   void runInSingleThread(const std::vector<PartitionID>& parts, std::unique_ptr<IndexNode> plan);
   void runInMultipleThread(const std::vector<PartitionID>& parts, std::unique_ptr<IndexNode> plan);
   ::nebula::cpp2::ErrorCode prepare(const cpp2::LookupIndexRequest& req);
   ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> buildPlan(
       const cpp2::LookupIndexRequest& req);
+  /**
+   * @brief The scan of the contexts on the same index with the same filter, each of which is a
+   * range of the scan
+   */
   ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> buildOneContext(
-      const cpp2::IndexQueryContext& ctx);
+      const std::vector<const cpp2::IndexQueryContext*>& contexts);
+  /**
+   * @brief Whether the keys of the index scanned by ctx are in the order of orderBy, i.e. the
+   * columns ordered follow the ones of the prefix hints in the index, they're ascending, not
+   * nullable, and of the types whose keys are in the order of their values
+   */
+  bool scannedInOrder(const cpp2::IndexQueryContext& ctx,
+                      const std::vector<cpp2::OrderBy>& orderBy);
   std::vector<std::unique_ptr<IndexNode>> reproducePlan(IndexNode* root, size_t count);
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::pair<std::string, cpp2::StatType>>>
   handleStatProps(const std::vector<cpp2::StatProp>& statProps);
   void mergeStatsResult(const std::vector<Row>& statsResult);
+  /**
+   * @brief Each part is limited by its own IndexLimitNode/IndexTopNNode, merge the rows of all
+   * parts to the limit of the request
+   */
+  void mergeLimitResult();
   folly::Executor* executor_{nullptr};
   std::unique_ptr<PlanContext> planContext_;
   std::unique_ptr<RuntimeContext> context_;
@@ -56,6 +79,11 @@ class LookupProcessor : public BaseProcessor<cpp2::LookupIndexResp> {
   nebula::DataSet statsDataSet_;
   std::vector<nebula::DataSet> partResults_;
   std::vector<cpp2::StatType> statTypes_;
+  // negative limit means no limit
+  int64_t limit_{-1};
+  std::vector<cpp2::OrderBy> orderBy_;
+  std::vector<std::string> returnColumns_;
+  bool hasAsyncIndex_{false};
 };
 }  // namespace storage
 }  // namespace nebula
@@ -10,6 +10,7 @@
 #include "codec/RowWriterV2.h"
 #include "common/memory/MemoryTracker.h"
 #include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
@@ -46,6 +47,12 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
     return;
   }
   edgeSchema_ = schema.value();
+  for (const auto& [edgeType, schemas] : edgeSchema_) {
+    auto aggregates = CommonUtils::neighborhoodAggregates(schemas.back().get());
+    if (!aggregates.empty()) {
+      materialized_.emplace(edgeType, std::move(aggregates));
+    }
+  }
 
   spaceVidLen_ = ret.value();
   callingNum_ = partEdges.size();
@@ -65,7 +72,9 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
 
   CHECK_NOTNULL(env_->kvstore_);
 
-  if (indexes_.empty()) {
+  // The aggregates materialized are changed by the old values of the edges, which are read in the
+  // atomic op the same as the indexes
+  if (indexes_.empty() && materialized_.empty()) {
     doProcess(req);
   } else {
     doProcessWithIndex(req);
@@ -149,9 +158,14 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
         auto batchHolder = std::make_unique<kvstore::BatchHolder>();
         (*consistOp_)(*batchHolder, &data);
         auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
+        auto cachedKeys = cachedKeysOf(batch);
 
         env_->kvstore_->asyncAppendBatch(
-            spaceId_, partId, std::move(batch), [partId, this](auto rc) {
+            spaceId_,
+            partId,
+            std::move(batch),
+            [partId, cachedKeys = std::move(cachedKeys), this](auto rc) {
+              evictCaches(spaceId_, cachedKeys);
               handleAsync(spaceId_, partId, rc);
             });
       } else {
@@ -212,11 +226,15 @@ void AddEdgesProcessor::doProcessWithIndex(const cpp2::AddEdgesRequest& req) {
       handleAsync(spaceId_, partId, code);
     } else {
       stats::StatsManager::addValue(kNumEdgesInserted, kvs.size());
+      auto cachedKeys = cachedKeysOf(kvs);
       auto atomicOp =
           [partId, data = std::move(kvs), this]() mutable -> kvstore::MergeableAtomicOpResult {
         return addEdgesWithIndex(partId, std::move(data));
       };
-      auto cb = [partId, this](nebula::cpp2::ErrorCode ec) { handleAsync(spaceId_, partId, ec); };
+      auto cb = [partId, cachedKeys = std::move(cachedKeys), this](nebula::cpp2::ErrorCode ec) {
+        evictCaches(spaceId_, cachedKeys);
+        handleAsync(spaceId_, partId, ec);
+      };
 
       env_->kvstore_->asyncAtomicOp(spaceId_, partId, std::move(atomicOp), std::move(cb));
     }
@@ -229,7 +247,88 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
   ret.code = nebula::cpp2::ErrorCode::E_RAFT_ATOMIC_OP_FAILED;
   IndexCountWrapper wrapper(env_);
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
-  for (auto& [key, value] : data) {
+  // The old values of the out-edges are read at once, only of the edges indexed, unless the edges
+  // existed are not to be overwritten
+  std::vector<std::string> oldValues(data.size());
+  std::vector<bool> oldRead(data.size(), false);
+  if (!ignoreExistedIndex_) {
+    std::unordered_set<EdgeType> indexedEdges;
+    for (const auto& index : indexes_) {
+      indexedEdges.emplace(index->get_schema_id().get_edge_type());
+    }
+    std::vector<size_t> positions;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < data.size(); ++i) {
+      const auto& key = data[i].first;
+      auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
+      if (edgeType > 0 && (ifNotExists_ || indexedEdges.count(edgeType))) {
+        positions.emplace_back(i);
+        keys.emplace_back(key);
+      }
+    }
+    std::vector<std::string> values;
+    if (findOldValues(spaceId_, partId, keys, &values) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // read old value failed
+      return ret;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      oldValues[positions[i]] = std::move(values[i]);
+      oldRead[positions[i]] = true;
+    }
+  }
+  // The old values of the edges materialized of both directions, the ones read above are reused
+  std::vector<std::string> materializedValues(data.size());
+  if (!materialized_.empty()) {
+    std::vector<size_t> positions;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < data.size(); ++i) {
+      const auto& key = data[i].first;
+      auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
+      if (!oldRead[i] && materialized_.count(std::abs(edgeType))) {
+        positions.emplace_back(i);
+        keys.emplace_back(key);
+      }
+    }
+    std::vector<std::string> values;
+    if (findOldValues(spaceId_, partId, keys, &values) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      materializedValues[positions[i]] = std::move(values[i]);
+    }
+  }
+  // The entries of the async indexes are left to the AsyncIndexApplier, which is told by a pending
+  // record of each out-edge. The pending record existed is kept, which tells the entries written.
+  std::unordered_set<EdgeType> asyncEdges;
+  for (const auto& index : indexes_) {
+    if (CommonUtils::isAsyncIndex(*index)) {
+      asyncEdges.emplace(index->get_schema_id().get_edge_type());
+    }
+  }
+  std::vector<std::string> pendingKeys(data.size());
+  std::vector<std::string> pendingValues(data.size());
+  if (!asyncEdges.empty()) {
+    std::vector<size_t> positions;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < data.size(); ++i) {
+      const auto& key = data[i].first;
+      if (asyncEdges.count(NebulaKeyUtils::getEdgeType(spaceVidLen_, key))) {
+        pendingKeys[i] = OperationKeyUtils::pendingIndexKey(partId, key);
+        positions.emplace_back(i);
+        keys.emplace_back(pendingKeys[i]);
+      }
+    }
+    std::vector<std::string> values;
+    if (findOldValues(spaceId_, partId, keys, &values) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      pendingValues[positions[i]] = std::move(values[i]);
+    }
+  }
+  auto now = time::WallClock::fastNowInMicroSec();
+  for (size_t i = 0; i < data.size(); ++i) {
+    auto& [key, value] = data[i];
     auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
     RowReaderWrapper oldReader;
     RowReaderWrapper newReader =
@@ -242,26 +341,19 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
 
     // only out-edge need to handle index
     if (edgeType > 0) {
-      std::string oldVal;
-      if (!ignoreExistedIndex_) {
-        // read the old key value and initialize row reader if exists
-        auto result = findOldValue(partId, key);
-        if (nebula::ok(result)) {
-          if (ifNotExists_ && !nebula::value(result).empty()) {
-            continue;
-          } else if (!nebula::value(result).empty()) {
-            oldVal = std::move(nebula::value(result));
-            oldReader =
-                RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, edgeType, oldVal);
-            ret.readSet.emplace_back(key);
-          }
-        } else {
-          // read old value failed
-          return ret;
+      // initialize row reader if the old value exists
+      const auto& oldVal = oldValues[i];
+      if (!oldVal.empty()) {
+        if (ifNotExists_) {
+          continue;
         }
+        oldReader =
+            RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, edgeType, oldVal);
+        ret.readSet.emplace_back(key);
       }
       for (const auto& index : indexes_) {
-        if (edgeType == index->get_schema_id().get_edge_type()) {
+        if (edgeType == index->get_schema_id().get_edge_type() &&
+            !CommonUtils::isAsyncIndex(*index)) {
           // step 1, Delete old version index if exists.
           if (oldReader != nullptr) {
             auto oldIndexKeys = indexKeys(partId, oldReader.get(), key, index, nullptr);
@@ -314,8 +406,35 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
           }
         }
       }
+      if (!pendingKeys[i].empty()) {
+        ret.readSet.emplace_back(pendingKeys[i]);
+        if (pendingValues[i].empty()) {
+          ret.writeSet.push_back(pendingKeys[i]);
+          batchHolder->put(std::string(pendingKeys[i]),
+                           OperationKeyUtils::pendingIndexVal(now, oldVal));
+        }
+      }
+    }
+    // step 3, Merge the changes of the aggregates materialized. The edge is read, so the writes of
+    // it merged into the same batch are retried after it, rather than both changing the aggregates.
+    auto aggregates = materialized_.find(std::abs(edgeType));
+    if (aggregates != materialized_.end()) {
+      const auto& oldVal = oldRead[i] ? oldValues[i] : materializedValues[i];
+      ret.readSet.emplace_back(key);
+      if (CommonUtils::mergeNeighborhood(env_,
+                                         spaceId_,
+                                         spaceVidLen_,
+                                         partId,
+                                         key,
+                                         oldVal,
+                                         value,
+                                         aggregates->second,
+                                         batchHolder.get()) !=
+          nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
     }
-    // step 3, Insert new edge data
+    // step 4, Insert new edge data
     ret.writeSet.push_back(key);
     // for why use a copy not move here:
     // previously, we use atomicOp(a kind of raft log, raft send this log in sync)
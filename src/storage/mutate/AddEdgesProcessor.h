@@ -58,6 +58,8 @@ class AddEdgesProcessor : public BaseProcessor<cpp2::ExecResponse> {
   bool ifNotExists_{false};
   bool ignoreExistedIndex_{false};
   meta::EdgeSchema edgeSchema_;
+  // The aggregates materialized of the edge types which define them
+  std::unordered_map<EdgeType, std::vector<NeighborhoodAggregate>> materialized_;
 
   /// this is a hook function to keep out-edge and in-edge consist
   using ConsistOper = std::function<void(kvstore::BatchHolder&, std::vector<kvstore::KV>*)>;
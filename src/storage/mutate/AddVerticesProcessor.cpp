@@ -10,6 +10,7 @@
 #include "codec/RowWriterV2.h"
 #include "common/memory/MemoryTracker.h"
 #include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
@@ -214,11 +215,15 @@ void AddVerticesProcessor::doProcessWithIndex(const cpp2::AddVerticesRequest& re
       handleAsync(spaceId_, partId, code);
     } else {
       stats::StatsManager::addValue(kNumVerticesInserted, tags.size());
+      auto cachedKeys = cachedKeysOf(tags);
       auto atomicOp = [=, tags = std::move(tags), vertices = std::move(verticeData)]() mutable {
         return addVerticesWithIndex(partId, tags, vertices);
       };
 
-      auto cb = [partId, this](nebula::cpp2::ErrorCode ec) { handleAsync(spaceId_, partId, ec); };
+      auto cb = [partId, cachedKeys = std::move(cachedKeys), this](nebula::cpp2::ErrorCode ec) {
+        evictCaches(spaceId_, cachedKeys);
+        handleAsync(spaceId_, partId, ec);
+      };
       env_->kvstore_->asyncAtomicOp(spaceId_, partId, std::move(atomicOp), std::move(cb));
     }
   }
@@ -235,7 +240,64 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
   for (auto& vertice : vertices) {
     batchHolder->put(std::string(vertice), "");
   }
-  for (auto& [key, value] : data) {
+  // The old values are read at once, only of the tags indexed, unless the vertices existed are
+  // not to be overwritten
+  std::vector<std::string> oldValues(data.size());
+  if (!ignoreExistedIndex_) {
+    std::unordered_set<TagID> indexedTags;
+    for (const auto& index : indexes_) {
+      indexedTags.emplace(index->get_schema_id().get_tag_id());
+    }
+    std::vector<size_t> positions;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < data.size(); ++i) {
+      const auto& key = data[i].first;
+      if (ifNotExists_ || indexedTags.count(NebulaKeyUtils::getTagId(spaceVidLen_, key))) {
+        positions.emplace_back(i);
+        keys.emplace_back(key);
+      }
+    }
+    std::vector<std::string> values;
+    if (findOldValues(spaceId_, partId, keys, &values) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // read old value failed
+      return ret;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      oldValues[positions[i]] = std::move(values[i]);
+    }
+  }
+  // The entries of the async indexes are left to the AsyncIndexApplier, which is told by a pending
+  // record of each row. The pending record existed is kept, which tells the entries written.
+  std::unordered_set<TagID> asyncTags;
+  for (const auto& index : indexes_) {
+    if (CommonUtils::isAsyncIndex(*index)) {
+      asyncTags.emplace(index->get_schema_id().get_tag_id());
+    }
+  }
+  std::vector<std::string> pendingKeys(data.size());
+  std::vector<std::string> pendingValues(data.size());
+  if (!asyncTags.empty()) {
+    std::vector<size_t> positions;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < data.size(); ++i) {
+      const auto& key = data[i].first;
+      if (asyncTags.count(NebulaKeyUtils::getTagId(spaceVidLen_, key))) {
+        pendingKeys[i] = OperationKeyUtils::pendingIndexKey(partId, key);
+        positions.emplace_back(i);
+        keys.emplace_back(pendingKeys[i]);
+      }
+    }
+    std::vector<std::string> values;
+    if (findOldValues(spaceId_, partId, keys, &values) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      pendingValues[positions[i]] = std::move(values[i]);
+    }
+  }
+  auto now = time::WallClock::fastNowInMicroSec();
+  for (size_t i = 0; i < data.size(); ++i) {
+    const auto& [key, value] = data[i];
     auto vId = NebulaKeyUtils::getVertexId(spaceVidLen_, key);
     auto tagId = NebulaKeyUtils::getTagId(spaceVidLen_, key);
     RowReaderWrapper oldReader;
@@ -248,26 +310,17 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
       return ret;
     }
     auto schema = schemaIter->second.get();
-    std::string oldVal;
-    if (!ignoreExistedIndex_) {
-      // read the old key value and initialize row reader if exists
-      auto result = findOldValue(partId, vId.str(), tagId);
-      if (nebula::ok(result)) {
-        if (ifNotExists_ && !nebula::value(result).empty()) {
-          continue;
-        } else if (!nebula::value(result).empty()) {
-          oldVal = std::move(nebula::value(result));
-          oldReader = RowReaderWrapper::getTagPropReader(env_->schemaMan_, spaceId_, tagId, oldVal);
-          ret.readSet.emplace_back(key);
-        }
-      } else {
-        // read old value failed
-        DLOG(INFO) << "===>>> failed";
-        return ret;
+    // initialize row reader if the old value exists
+    const auto& oldVal = oldValues[i];
+    if (!oldVal.empty()) {
+      if (ifNotExists_) {
+        continue;
       }
+      oldReader = RowReaderWrapper::getTagPropReader(env_->schemaMan_, spaceId_, tagId, oldVal);
+      ret.readSet.emplace_back(key);
     }
     for (const auto& index : indexes_) {
-      if (tagId == index->get_schema_id().get_tag_id()) {
+      if (tagId == index->get_schema_id().get_tag_id() && !CommonUtils::isAsyncIndex(*index)) {
         // step 1, Delete old version index if exists.
         if (oldReader != nullptr) {
           auto oldIndexKeys = indexKeys(partId, vId.str(), oldReader.get(), index, schema);
@@ -322,7 +375,15 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
         }
       }
     }
-    // step 3, Insert new vertex data
+    // step 3, Insert new vertex data, and the pending record if the tag has async indexes
+    if (!pendingKeys[i].empty()) {
+      ret.readSet.emplace_back(pendingKeys[i]);
+      if (pendingValues[i].empty()) {
+        ret.writeSet.emplace_back(pendingKeys[i]);
+        batchHolder->put(std::string(pendingKeys[i]),
+                         OperationKeyUtils::pendingIndexVal(now, oldVal));
+      }
+    }
     ret.writeSet.emplace_back(key);
     batchHolder->put(std::string(key), std::string(value));
   }
@@ -47,9 +47,20 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
     return;
   }
   indexes_ = std::move(iRet).value();
+  auto schemas = env_->schemaMan_->getAllLatestVerEdgeSchema(spaceId_);
+  if (schemas.ok()) {
+    for (const auto& [edgeType, schema] : schemas.value()) {
+      auto aggregates = CommonUtils::neighborhoodAggregates(schema.back().get());
+      if (!aggregates.empty()) {
+        materialized_.emplace(edgeType, std::move(aggregates));
+      }
+    }
+  }
 
   CHECK_NOTNULL(env_->kvstore_);
-  if (indexes_.empty()) {
+  // The edges of the aggregates materialized are read before they are deleted, the same as the
+  // edges indexed
+  if (indexes_.empty() && materialized_.empty()) {
     // Operate every part, the graph layer guarantees the unique of the edgeKey
     for (auto& part : partEdges) {
       std::vector<std::string> keys;
@@ -85,11 +96,15 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
         (*tossHookFunc_)(para);
       }
       if (para.result) {
+        auto cachedKeys = cachedKeysOf(para.result.value());
         env_->kvstore_->asyncAppendBatch(
             spaceId_,
             partId,
             std::move(para.result.value()),
-            [partId, this](nebula::cpp2::ErrorCode rc) { handleAsync(spaceId_, partId, rc); });
+            [partId, cachedKeys = std::move(cachedKeys), this](nebula::cpp2::ErrorCode rc) {
+              evictCaches(spaceId_, cachedKeys);
+              handleAsync(spaceId_, partId, rc);
+            });
       } else {
         doRemove(spaceId_, partId, std::move(keys));
         stats::StatsManager::addValue(kNumEdgesDeleted, keys.size());
@@ -144,13 +159,18 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
       }
       DCHECK(!nebula::value(batch).empty());
       nebula::MemoryLockGuard<EMLI> lg(env_->edgesML_.get(), std::move(dummyLock), false, false);
+      auto cachedKeys = cachedKeysOf(nebula::value(batch));
       env_->kvstore_->asyncAppendBatch(spaceId_,
                                        partId,
                                        std::move(nebula::value(batch)),
-                                       [l = std::move(lg), icw = std::move(wrapper), partId, this](
-                                           nebula::cpp2::ErrorCode code) {
+                                       [l = std::move(lg),
+                                        icw = std::move(wrapper),
+                                        cachedKeys = std::move(cachedKeys),
+                                        partId,
+                                        this](nebula::cpp2::ErrorCode code) {
                                          UNUSED(l);
                                          UNUSED(icw);
+                                         evictCaches(spaceId_, cachedKeys);
                                          handleAsync(spaceId_, partId, code);
                                        });
     }
@@ -210,6 +230,22 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           }
         }
       }
+      auto aggregates = materialized_.find(std::abs(type));
+      if (aggregates != materialized_.end()) {
+        auto code = CommonUtils::mergeNeighborhood(env_,
+                                                   spaceId_,
+                                                   spaceVidLen_,
+                                                   partId,
+                                                   key,
+                                                   val,
+                                                   "",
+                                                   aggregates->second,
+                                                   batchHolder.get());
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          LOG(WARNING) << "Bad format row!";
+          return code;
+        }
+      }
       batchHolder->remove(std::move(key));
       stats::StatsManager::addValue(kNumEdgesDeleted);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
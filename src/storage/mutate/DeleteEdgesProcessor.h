@@ -40,6 +40,8 @@ class DeleteEdgesProcessor : public BaseProcessor<cpp2::ExecResponse> {
  private:
   GraphSpaceID spaceId_;
   std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> indexes_;
+  // The aggregates materialized of the edge types which define them
+  std::unordered_map<EdgeType, std::vector<NeighborhoodAggregate>> materialized_;
 
  protected:
   // TOSS use this hook function to append some delete operation
@@ -78,13 +78,18 @@ void DeleteTagsProcessor::process(const cpp2::DeleteTagsRequest& req) {
       // keys has been locked in deleteTags
       nebula::MemoryLockGuard<VMLI> lg(
           env_->verticesML_.get(), std::move(lockedKeys), false, false);
+      auto cachedKeys = cachedKeysOf(nebula::value(batch));
       env_->kvstore_->asyncAppendBatch(spaceId_,
                                        partId,
                                        std::move(nebula::value(batch)),
-                                       [l = std::move(lg), icw = std::move(wrapper), partId, this](
-                                           nebula::cpp2::ErrorCode code) {
+                                       [l = std::move(lg),
+                                        icw = std::move(wrapper),
+                                        cachedKeys = std::move(cachedKeys),
+                                        partId,
+                                        this](nebula::cpp2::ErrorCode code) {
                                          UNUSED(l);
                                          UNUSED(icw);
+                                         evictCaches(spaceId_, cachedKeys);
                                          handleAsync(spaceId_, partId, code);
                                        });
     }
@@ -54,6 +54,8 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
       auto partId = part.first;
       const auto& vertexIds = part.second;
       keys.clear();
+      // The tag prefixes of the vertices which have any tag
+      std::vector<std::string> tagPrefixes;
       auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
       for (auto& vid : vertexIds) {
         if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vid.getStr())) {
@@ -70,18 +72,33 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
           VLOG(3) << "Error! ret = " << static_cast<int32_t>(code) << ", spaceID " << spaceId_;
           break;
         }
+        auto vertexKeys = keys.size();
         while (iter->valid()) {
           auto key = iter->key();
           keys.emplace_back(key.str());
           iter->next();
         }
+        // The iterator refers to the prefix, which is kept only after its scan
+        iter.reset();
+        if (keys.size() > vertexKeys) {
+          tagPrefixes.emplace_back(std::move(prefix));
+        }
       }
       if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
         handleAsync(spaceId_, partId, code);
         continue;
       }
-      doRemove(spaceId_, partId, std::move(keys));
       stats::StatsManager::addValue(kNumVerticesDeleted, keys.size());
+      auto batchHolder = removeBatch(keys, tagPrefixes);
+      auto cachedKeys = cachedKeysOf(keys);
+      env_->kvstore_->asyncAppendBatch(
+          spaceId_,
+          partId,
+          encodeBatchValue(batchHolder->getBatch()),
+          [cachedKeys = std::move(cachedKeys), partId, this](nebula::cpp2::ErrorCode retCode) {
+            evictCaches(spaceId_, cachedKeys);
+            handleAsync(spaceId_, partId, retCode);
+          });
     }
   } else {
     for (auto& pv : partVertices) {
@@ -96,19 +113,47 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
       }
       DCHECK(!nebula::value(batch).empty());
       nebula::MemoryLockGuard<VMLI> lg(env_->verticesML_.get(), std::move(dummyLock), false, false);
+      auto cachedKeys = cachedKeysOf(nebula::value(batch));
       env_->kvstore_->asyncAppendBatch(spaceId_,
                                        partId,
                                        std::move(nebula::value(batch)),
-                                       [l = std::move(lg), icw = std::move(wrapper), partId, this](
-                                           nebula::cpp2::ErrorCode code) {
+                                       [l = std::move(lg),
+                                        icw = std::move(wrapper),
+                                        cachedKeys = std::move(cachedKeys),
+                                        partId,
+                                        this](nebula::cpp2::ErrorCode code) {
                                          UNUSED(l);
                                          UNUSED(icw);
+                                         evictCaches(spaceId_, cachedKeys);
                                          handleAsync(spaceId_, partId, code);
                                        });
     }
   }
 }
 
+std::unique_ptr<kvstore::BatchHolder> DeleteVerticesProcessor::removeBatch(
+    const std::vector<std::string>& keys, const std::vector<std::string>& tagPrefixes) {
+  auto batchHolder = std::make_unique<kvstore::BatchHolder>();
+  // Only a bulk delete of the part leaves enough tombstones to slow down the scans over them,
+  // while each range tombstone is checked by every read until it's compacted
+  bool byRange = FLAGS_delete_range_min_keys > 0 &&
+                 keys.size() >= static_cast<size_t>(FLAGS_delete_range_min_keys);
+  for (const auto& key : keys) {
+    if (!byRange || !NebulaKeyUtils::isTag(spaceVidLen_, key)) {
+      batchHolder->remove(std::string(key));
+    }
+  }
+  if (byRange) {
+    // All tags of a vertex are in the range of its prefix, one range tombstone for each vertex
+    // instead of one for each of its tags
+    for (const auto& prefix : tagPrefixes) {
+      batchHolder->rangeRemove(NebulaKeyUtils::firstKey(prefix, sizeof(TagID)),
+                               NebulaKeyUtils::lastKey(prefix, sizeof(TagID) + 1));
+    }
+  }
+  return batchHolder;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteVerticesProcessor::deleteVertices(
     PartitionID partId, const std::vector<Value>& vertices, std::vector<VMLI>& target) {
   target.reserve(vertices.size());
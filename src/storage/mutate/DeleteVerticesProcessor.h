@@ -29,6 +29,13 @@ class DeleteVerticesProcessor : public BaseProcessor<cpp2::ExecResponse> {
   DeleteVerticesProcessor(StorageEnv* env, const ProcessorCounters* counters)
       : BaseProcessor<cpp2::ExecResponse>(env, counters) {}
 
+  /**
+   * @brief Build the batch removing the vertex and tag keys of a part. The tags are removed by a
+   * range over each of tagPrefixes if the part has at least delete_range_min_keys keys removed.
+   */
+  std::unique_ptr<kvstore::BatchHolder> removeBatch(const std::vector<std::string>& keys,
+                                                    const std::vector<std::string>& tagPrefixes);
+
   ErrorOr<nebula::cpp2::ErrorCode, std::string> deleteVertices(PartitionID partId,
                                                                const std::vector<Value>& vertices,
                                                                std::vector<VMLI>& target);
@@ -0,0 +1,160 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/mutate/UpdateCoalescer.h"
+
+#include "kvstore/LogEncoder.h"
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+bool UpdateCoalescer::pending(GraphSpaceID space,
+                              PartitionID part,
+                              Request* req,
+                              std::string* row) {
+  auto* state = partOf(space, part);
+  std::lock_guard<std::mutex> guard(state->lock);
+  auto iter = state->rows.find(req->key);
+  if (iter == state->rows.end()) {
+    return false;
+  }
+  *row = iter->second.first;
+  req->epoch = state->epoch;
+  return true;
+}
+
+void UpdateCoalescer::submit(GraphSpaceID space, PartitionID part, Request* req) {
+  // The row written by the batch, which the next update of it reads
+  std::optional<std::string> row;
+  for (const auto& op : kvstore::decodeBatchValue(req->batch)) {
+    if (op.first == kvstore::BatchLogType::OP_BATCH_PUT &&
+        op.second.first == folly::StringPiece(req->key)) {
+      row = op.second.second.str();
+    }
+  }
+
+  auto* state = partOf(space, part);
+  std::lock_guard<std::mutex> guard(state->lock);
+  if (req->epoch != kNoEpoch && req->epoch != state->epoch) {
+    // The row read was of an entry failed
+    req->code = nebula::cpp2::ErrorCode::E_DATA_CONFLICT_ERROR;
+    req->baton.post();
+    return;
+  }
+  if (row.has_value()) {
+    auto& pendingRow = state->rows[req->key];
+    pendingRow.first = std::move(row).value();
+    ++pendingRow.second;
+  }
+  state->queue.emplace_back(req);
+}
+
+nebula::cpp2::ErrorCode UpdateCoalescer::wait(GraphSpaceID space, PartitionID part, Request* req) {
+  auto* state = partOf(space, part);
+  bool append = false;
+  {
+    std::lock_guard<std::mutex> guard(state->lock);
+    if (!state->appending) {
+      state->appending = true;
+      append = true;
+    }
+  }
+  if (append) {
+    appendAll(space, part, state);
+  }
+  req->baton.wait();
+  return req->code;
+}
+
+UpdateCoalescer::PartState* UpdateCoalescer::partOf(GraphSpaceID space, PartitionID part) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto& state = parts_[std::make_tuple(space, part)];
+  if (state == nullptr) {
+    state = std::make_unique<PartState>();
+  }
+  return state.get();
+}
+
+void UpdateCoalescer::appendAll(GraphSpaceID space, PartitionID part, PartState* state) {
+  while (true) {
+    std::vector<Request*> reqs;
+    {
+      std::lock_guard<std::mutex> guard(state->lock);
+      if (state->queue.empty()) {
+        state->appending = false;
+        return;
+      }
+      reqs.swap(state->queue);
+    }
+
+    std::string batch;
+    if (reqs.size() == 1) {
+      batch = std::move(reqs.front()->batch);
+    } else {
+      stats::StatsManager::addValue(kNumUpdatesCoalesced, reqs.size() - 1);
+      batch = merge(reqs);
+    }
+    folly::Baton<true, std::atomic> baton;
+    auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+    kvstore_->asyncAppendBatch(
+        space, part, std::move(batch), [&code, &baton](nebula::cpp2::ErrorCode ret) {
+          code = ret;
+          baton.post();
+        });
+    baton.wait();
+
+    std::vector<Request*> failed;
+    {
+      std::lock_guard<std::mutex> guard(state->lock);
+      if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        for (auto* req : reqs) {
+          auto iter = state->rows.find(req->key);
+          if (iter != state->rows.end() && --iter->second.second == 0) {
+            state->rows.erase(iter);
+          }
+        }
+      } else {
+        // The queued ones may have read the rows of the failed entry
+        ++state->epoch;
+        state->rows.clear();
+        failed.swap(state->queue);
+      }
+    }
+    // The requests are released by the updates once posted
+    for (auto* req : reqs) {
+      req->code = code;
+      req->baton.post();
+    }
+    for (auto* req : failed) {
+      req->code = code;
+      req->baton.post();
+    }
+  }
+}
+
+std::string UpdateCoalescer::merge(const std::vector<Request*>& reqs) {
+  // The last request of each row, the puts of the row by the ones before it are overwritten
+  std::unordered_map<std::string, size_t> last;
+  for (size_t i = 0; i < reqs.size(); i++) {
+    last[reqs[i]->key] = i;
+  }
+  std::vector<std::tuple<kvstore::BatchLogType, std::string, std::string>> ops;
+  for (size_t i = 0; i < reqs.size(); i++) {
+    const auto& key = reqs[i]->key;
+    bool overwritten = last[key] != i;
+    for (const auto& op : kvstore::decodeBatchValue(reqs[i]->batch)) {
+      if (overwritten && op.first == kvstore::BatchLogType::OP_BATCH_PUT &&
+          op.second.first == folly::StringPiece(key)) {
+        continue;
+      }
+      ops.emplace_back(op.first, op.second.first.str(), op.second.second.str());
+    }
+  }
+  return kvstore::encodeBatchValue(ops);
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,100 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_MUTATE_UPDATECOALESCER_H_
+#define STORAGE_MUTATE_UPDATECOALESCER_H_
+
+#include <folly/synchronization/Baton.h>
+
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "kvstore/KVStore.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief UpdateCoalescer coalesces the writes of the updates of each part into fewer raft entries.
+ *
+ * An update is a read-modify-write of a row under the lock of the row, which used to be held until
+ * the batch of it is committed, so the updates of a hot row took a raft round trip each. Instead,
+ * the update submits its batch under the lock, releases the lock and waits for the batch to be
+ * committed. The next update of the row reads the row submitted rather than the kvstore, so it
+ * doesn't wait for the commit. The batches submitted while one is being appended are merged into
+ * one raft entry in the order they're submitted, the rows overwritten in the entry are dropped.
+ * Each update keeps its own result, returned once its batch is committed.
+ *
+ * If an entry fails, the updates of it and the ones queued fail with it, since they may have read
+ * the rows of it, so do the ones submitted later that read the rows of it.
+ */
+class UpdateCoalescer final {
+ public:
+  static constexpr int64_t kNoEpoch = -1;
+
+  // The update of a row, owned by the update till wait returns
+  struct Request {
+    // The key of the row
+    std::string key;
+    // The encoded batch of the update, see BatchHolder
+    std::string batch;
+    // The epoch of the part when the row submitted was read, kNoEpoch if it's read from kvstore
+    int64_t epoch{kNoEpoch};
+    nebula::cpp2::ErrorCode code{nebula::cpp2::ErrorCode::SUCCEEDED};
+    folly::Baton<true, std::atomic> baton;
+  };
+
+  explicit UpdateCoalescer(kvstore::KVStore* kvstore) : kvstore_(kvstore) {}
+
+  /**
+   * @brief Read the row of req->key submitted but not committed yet, called under the lock of the
+   * row. req->epoch is set if there is one.
+   *
+   * @return Whether there is one.
+   */
+  bool pending(GraphSpaceID space, PartitionID part, Request* req, std::string* row);
+
+  /**
+   * @brief Submit the batch of req, called under the lock of the row, which could be released
+   * after that.
+   */
+  void submit(GraphSpaceID space, PartitionID part, Request* req);
+
+  /**
+   * @brief Wait for the batch of req submitted to be committed, appending the batches queued if no
+   * one is.
+   *
+   * @return The result of the batch.
+   */
+  nebula::cpp2::ErrorCode wait(GraphSpaceID space, PartitionID part, Request* req);
+
+ private:
+  struct PartState {
+    std::mutex lock;
+    // Whether one is appending the batches of the part
+    bool appending{false};
+    // Increased when an entry fails, to fail the updates reading the rows of it
+    int64_t epoch{0};
+    std::vector<Request*> queue;
+    // The rows submitted not committed yet, with the number of the updates of each
+    std::unordered_map<std::string, std::pair<std::string, int32_t>> rows;
+  };
+
+  PartState* partOf(GraphSpaceID space, PartitionID part);
+
+  // Append the queued batches of the part till the queue is empty
+  void appendAll(GraphSpaceID space, PartitionID part, PartState* state);
+
+  // Merge the batches of the requests into one, the rows of them overwritten are dropped
+  std::string merge(const std::vector<Request*>& reqs);
+
+  kvstore::KVStore* kvstore_{nullptr};
+  std::mutex lock_;
+  std::unordered_map<std::tuple<GraphSpaceID, PartitionID>, std::unique_ptr<PartState>> parts_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_MUTATE_UPDATECOALESCER_H_
@@ -91,6 +91,9 @@ void UpdateEdgeProcessor::doProcess(const cpp2::UpdateEdgeRequest& req) {
     if (UNLIKELY(profileDetailFlag_)) {
       profilePlan(plan);
     }
+    if (UNLIKELY(span_.sampled())) {
+      tracePlan(plan);
+    }
     onProcessFinished();
   }
   onFinished();
@@ -162,6 +165,7 @@ StoragePlan<cpp2::EdgeKey> UpdateEdgeProcessor::buildPlan(nebula::DataSet* resul
                                                      expCtx_.get(),
                                                      &edgeContext_);
   updateNode->addDependency(filterNode.get());
+  updateNode->setEdgeNode(edgeUpdate.get());
 
   auto resultNode = std::make_unique<UpdateResNode<cpp2::EdgeKey>>(
       context_.get(), updateNode.get(), getReturnPropsExp(), expCtx_.get(), result);
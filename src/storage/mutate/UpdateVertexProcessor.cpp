@@ -84,6 +84,9 @@ void UpdateVertexProcessor::doProcess(const cpp2::UpdateVertexRequest& req) {
     }
   } else {
     profilePlan(plan);
+    if (UNLIKELY(span_.sampled())) {
+      tracePlan(plan);
+    }
     onProcessFinished();
   }
   onFinished();
@@ -148,6 +151,7 @@ StoragePlan<VertexID> UpdateVertexProcessor::buildPlan(nebula::DataSet* result)
                                                     expCtx_.get(),
                                                     &tagContext_);
   updateNode->addDependency(filterNode.get());
+  updateNode->setTagNode(tagUpdate.get());
 
   auto resultNode = std::make_unique<UpdateResNode<VertexID>>(
       context_.get(), updateNode.get(), getReturnPropsExp(), expCtx_.get(), result);
@@ -36,6 +36,7 @@ void GetDstBySrcProcessor::doProcess(const cpp2::GetDstBySrcRequest& req) {
     profileDetail("GetDstBySrcProcessorTotal", 0);
     profileDetail("GetDstBySrcProcessorDedup", 0);
   }
+  samplePerfContext();
 
   spaceId_ = req.get_space_id();
   auto retCode = getSpaceVidLen(spaceId_);
@@ -59,7 +60,10 @@ void GetDstBySrcProcessor::doProcess(const cpp2::GetDstBySrcRequest& req) {
     return;
   }
 
-  if (!FLAGS_query_concurrently) {
+  steps_ = std::max(req.steps_ref().value_or(1), 1);
+  if (steps_ > 1) {
+    runInMultipleSteps(req);
+  } else if (!FLAGS_query_concurrently) {
     runInSingleThread(req);
   } else {
     runInMultipleThread(req);
@@ -98,6 +102,9 @@ void GetDstBySrcProcessor::runInSingleThread(const cpp2::GetDstBySrcRequest& req
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan);
   }
+  if (UNLIKELY(span_.sampled())) {
+    tracePlan(plan);
+  }
   onProcessFinished();
   onFinished();
 }
@@ -156,6 +163,88 @@ void GetDstBySrcProcessor::runInMultipleThread(const cpp2::GetDstBySrcRequest& r
       });
 }
 
+void GetDstBySrcProcessor::runInMultipleSteps(const cpp2::GetDstBySrcRequest& req) {
+  memory::MemoryCheckGuard guard;
+  int32_t numParts = 0;
+  if (env_->metaClient_ != nullptr) {
+    auto ret = env_->metaClient_->partsNum(spaceId_);
+    if (ret.ok()) {
+      numParts = ret.value();
+    }
+  }
+  contexts_.emplace_back(RuntimeContext(planContext_.get()));
+  std::deque<Value> dsts;
+  auto plan = buildPlan(&contexts_.front(), &dsts);
+  std::unordered_map<PartitionID, std::vector<Value>> frontier;
+  for (const auto& partEntry : req.get_parts()) {
+    for (const auto& src : partEntry.second) {
+      if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, src.getStr())) {
+        LOG(INFO) << "Space " << spaceId_ << ", vertex length invalid, "
+                  << " space vid len: " << spaceVidLen_ << ",  vid is " << src.getStr();
+        pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_VID, partEntry.first);
+        onFinished();
+        return;
+      }
+    }
+    frontier.emplace(partEntry.first, partEntry.second);
+  }
+
+  using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
+  for (int32_t step = 1; step <= steps_ && !frontier.empty(); ++step) {
+    std::unordered_map<PartitionID, std::vector<Value>> next;
+    for (auto& [partId, srcs] : frontier) {
+      for (auto& src : srcs) {
+        // the srcs of the first step are encoded by the client, the later ones are the dsts read
+        auto vId = src.isStr() ? src.getStr()
+                               : std::string(reinterpret_cast<const char*>(&src.getInt()), 8);
+        auto ret = plan.go(partId, vId);
+        if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+          continue;
+        }
+        if (step == 1) {
+          handleErrorCode(ret, spaceId_, partId);
+          break;
+        }
+        // e.g. the leader is changed during the expansion, leave it to the caller
+        remoteDsts_[step - 1].emplace_back(std::move(src));
+      }
+    }
+    HashSet unique;
+    unique.reserve(dsts.size());
+    for (auto& dst : dsts) {
+      unique.emplace(std::move(dst));
+    }
+    dsts.clear();
+    for (auto& dst : unique) {
+      if (step == steps_) {
+        flatResult_.emplace_back(dst);
+        continue;
+      }
+      PartitionID partId = 0;
+      if (numParts > 0) {
+        auto vId = dst.isStr() ? dst.getStr()
+                               : std::string(reinterpret_cast<const char*>(&dst.getInt()), 8);
+        partId = env_->metaClient_->partId(numParts, vId);
+      }
+      if (partId > 0 && isLocalPart(partId)) {
+        next[partId].emplace_back(dst);
+      } else {
+        remoteDsts_[step].emplace_back(dst);
+      }
+    }
+    frontier = std::move(next);
+  }
+
+  if (UNLIKELY(profileDetailFlag_)) {
+    profilePlan(plan);
+  }
+  if (UNLIKELY(span_.sampled())) {
+    tracePlan(plan);
+  }
+  onProcessFinished();
+  onFinished();
+}
+
 folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetDstBySrcProcessor::runInExecutor(
     RuntimeContext* context,
     std::deque<Value>* result,
@@ -164,6 +253,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetDstBySrcProces
   return folly::via(executor_,
                     [this, context, result, partId, input = std::move(srcIds)]() mutable {
                       memory::MemoryCheckGuard guard;
+                      auto perf = perfScope();
                       if (memoryExceeded_) {
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
@@ -346,6 +436,9 @@ void GetDstBySrcProcessor::onProcessFinished() {
   }
   resultDataSet_.rows = std::move(deduped);
   resp_.dsts_ref() = std::move(resultDataSet_);
+  if (!remoteDsts_.empty()) {
+    resp_.remote_dsts_ref() = std::move(remoteDsts_);
+  }
 
   if (profileDetailFlag_) {
     profileDetail("GetDstBySrcProcessorDedup", dedupDuration_.elapsedInUSec());
@@ -48,6 +48,10 @@ class GetDstBySrcProcessor
 
   void runInMultipleThread(const cpp2::GetDstBySrcRequest& req);
 
+  // Expand steps_ steps, the dsts of each step are expanded in place if their parts are led by this
+  // host, the others are returned in remoteDsts_ for the caller to expand
+  void runInMultipleSteps(const cpp2::GetDstBySrcRequest& req);
+
   folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> runInExecutor(
       RuntimeContext* context,
       std::deque<Value>* result,
@@ -62,6 +66,9 @@ class GetDstBySrcProcessor
   std::vector<std::deque<Value>> partResults_;
   std::deque<Value> flatResult_;
 
+  int32_t steps_{1};
+  std::unordered_map<int32_t, std::vector<Value>> remoteDsts_;
+
   time::Duration totalDuration_;
   time::Duration dedupDuration_;
 };
@@ -14,12 +14,39 @@
 #include "storage/exec/HashJoinNode.h"
 #include "storage/exec/MultiTagNode.h"
 #include "storage/exec/TagNode.h"
+#include "storage/query/GetPropProcessor.h"
 
 namespace nebula {
 namespace storage {
 
 ProcessorCounters kGetNeighborsCounters;
 
+namespace {
+
+// Append the flat edges of the rows appended, the offsets of which follow the edges before
+void appendEdges(std::vector<cpp2::NeighborEdges>& edges, std::vector<cpp2::NeighborEdges>&& more) {
+  DCHECK_EQ(edges.size(), more.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    auto& offsets = *edges[i].offsets_ref();
+    auto& moreOffsets = *more[i].offsets_ref();
+    auto base = offsets.back();
+    for (size_t j = 1; j < moreOffsets.size(); ++j) {
+      offsets.emplace_back(base + moreOffsets[j]);
+    }
+    auto& props = *edges[i].props_ref();
+    auto& moreProps = *more[i].props_ref();
+    if (props.empty()) {
+      props = std::move(moreProps);
+      continue;
+    }
+    for (size_t j = 0; j < moreProps.size(); ++j) {
+      std::move(moreProps[j].begin(), moreProps[j].end(), std::back_inserter(props[j]));
+    }
+  }
+}
+
+}  // namespace
+
 void GetNeighborsProcessor::process(const cpp2::GetNeighborsRequest& req) {
   if (executor_ != nullptr) {
     executor_->add(
@@ -42,8 +69,18 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
   if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
     profileDetailFlag_ = true;
   }
+  samplePerfContext();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
+  // The dsts are fetched by a GetPropProcessor in the executor after the neighbors
+  const auto& traverseSpec = *req.traverse_spec_ref();
+  if (executor_ != nullptr && traverseSpec.dst_vertex_props_ref().has_value()) {
+    dstVertexProps_ =
+        std::make_unique<std::vector<cpp2::VertexProp>>(*traverseSpec.dst_vertex_props_ref());
+    if (req.common_ref().has_value()) {
+      common_ = *req.common_ref();
+    }
+  }
 
   // build TagContext and EdgeContext
   retCode = checkAndBuildContexts(req);
@@ -65,9 +102,18 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
       random = *(*req.traverse_spec_ref()).random_ref();
     }
   }
+  // The edges filtered or sampled are not the ones aggregated
+  if (filter_ == nullptr && !random) {
+    buildMaterializedStats();
+  }
 
-  // todo(doodle): specify by each query
-  if (!FLAGS_query_concurrently) {
+  // The fan-out costs more than the work of a small request, so it runs in a single thread
+  size_t numVids = 0;
+  for (const auto& part : req.get_parts()) {
+    numVids += part.second.size();
+  }
+  if (!FLAGS_query_concurrently ||
+      numVids < static_cast<size_t>(std::max(FLAGS_query_concurrently_min_vids, 0))) {
     runInSingleThread(req, limit, random);
   } else {
     runInMultipleThread(req, limit, random);
@@ -78,9 +124,15 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
                                               int64_t limit,
                                               bool random) {
   memory::MemoryCheckGuard guard;
+  time::Duration runTime;
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
-  auto plan = buildPlan(&contexts_.front(), &expCtxs_.front(), &resultDataSet_, limit, random);
+  auto plan = buildPlan(&contexts_.front(),
+                        &expCtxs_.front(),
+                        &resultDataSet_,
+                        flatEdges_ ? &resultEdges_ : nullptr,
+                        limit,
+                        random);
   std::unordered_set<PartitionID> failedParts;
   for (const auto& partEntry : req.get_parts()) {
     contexts_.front().resultStat_ = ResultStatus::NORMAL;
@@ -108,32 +160,58 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
   }
   if (UNLIKELY(profileDetailFlag_)) {
     profilePlan(plan);
+    profileDetail("GetNeighborsProcessorTasks", 1);
+    profileDetail("GetNeighborsProcessorRun", static_cast<int32_t>(runTime.elapsedInUSec()));
+  }
+  if (UNLIKELY(span_.sampled())) {
+    tracePlan(plan);
   }
   onProcessFinished();
-  onFinished();
+  fetchDstVerticesAndFinish();
 }
 
 void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest& req,
                                                 int64_t limit,
                                                 bool random) {
   memory::MemoryCheckOffGuard offGuard;
-  for (size_t i = 0; i < req.get_parts().size(); i++) {
+  time::Duration runTime;
+  // The vids of a hot part are split into several tasks, the results of which are appended in
+  // order of the tasks, so the rows of each vid keep their order
+  auto vidsPerTask = static_cast<size_t>(std::max(FLAGS_query_concurrently_vids_per_task, 1));
+  std::vector<std::tuple<PartitionID, const std::vector<nebula::Value>*, size_t, size_t>> tasks;
+  for (const auto& [partId, vids] : req.get_parts()) {
+    size_t begin = 0;
+    do {
+      auto end = std::min(begin + vidsPerTask, vids.size());
+      tasks.emplace_back(partId, &vids, begin, end);
+      begin = end;
+    } while (begin < vids.size());
+  }
+  for (size_t i = 0; i < tasks.size(); i++) {
     nebula::DataSet result = resultDataSet_;
     results_.emplace_back(std::move(result));
+    edgeResults_.emplace_back(resultEdges_);
     contexts_.emplace_back(RuntimeContext(planContext_.get()));
     expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
   }
-  size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
-  for (const auto& [partId, vids] : req.get_parts()) {
-    futures.emplace_back(
-        runInExecutor(&contexts_[i], &expCtxs_[i], &results_[i], partId, vids, limit, random));
-    i++;
+  futures.reserve(tasks.size());
+  for (size_t i = 0; i < tasks.size(); i++) {
+    auto [partId, vids, begin, end] = tasks[i];
+    futures.emplace_back(runInExecutor(&contexts_[i],
+                                       &expCtxs_[i],
+                                       &results_[i],
+                                       flatEdges_ ? &edgeResults_[i] : nullptr,
+                                       partId,
+                                       std::vector<nebula::Value>(vids->begin() + begin,
+                                                                  vids->begin() + end),
+                                       limit,
+                                       random));
   }
 
   folly::collectAll(futures)
       .via(executor_)
-      .thenTry([this](auto&& t) mutable {
+      .thenTry([this, runTime, numTasks = tasks.size()](auto&& t) mutable {
         memory::MemoryCheckGuard guard;
         CHECK(!t.hasException());
         const auto& tries = t.value();
@@ -146,16 +224,26 @@ void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest&
           sum += results_[j].size();
         }
         resultDataSet_.rows.reserve(sum);
+        std::unordered_set<PartitionID> failedParts;
         for (size_t j = 0; j < tries.size(); j++) {
           const auto& [code, partId] = tries[j].value();
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-            handleErrorCode(code, spaceId_, partId);
+            if (failedParts.emplace(partId).second) {
+              handleErrorCode(code, spaceId_, partId);
+            }
           } else {
             resultDataSet_.append(std::move(results_[j]));
+            if (flatEdges_) {
+              appendEdges(resultEdges_, std::move(edgeResults_[j]));
+            }
           }
         }
+        if (UNLIKELY(profileDetailFlag_)) {
+          profileDetail("GetNeighborsProcessorTasks", static_cast<int32_t>(numTasks));
+          profileDetail("GetNeighborsProcessorRun", static_cast<int32_t>(runTime.elapsedInUSec()));
+        }
         this->onProcessFinished();
-        this->onFinished();
+        this->fetchDstVerticesAndFinish();
       })
       .thenError(folly::tag_t<std::bad_alloc>{}, [this](const std::bad_alloc&) {
         memoryExceeded_ = true;
@@ -167,18 +255,28 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
     RuntimeContext* context,
     StorageExpressionContext* expCtx,
     nebula::DataSet* result,
+    std::vector<cpp2::NeighborEdges>* edges,
     PartitionID partId,
-    const std::vector<nebula::Value>& vids,
+    std::vector<nebula::Value> vids,
     int64_t limit,
     bool random) {
   return folly::via(
              executor_,
-             [this, context, expCtx, result, partId, input = std::move(vids), limit, random]() {
+             [this,
+              context,
+              expCtx,
+              result,
+              edges,
+              partId,
+              input = std::move(vids),
+              limit,
+              random]() {
                memory::MemoryCheckGuard guard;
+               auto perf = perfScope();
                if (memoryExceeded_) {
                  return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED, partId);
                }
-               auto plan = buildPlan(context, expCtx, result, limit, random);
+               auto plan = buildPlan(context, expCtx, result, edges, limit, random);
                for (const auto& vid : input) {
                  auto vId = vid.getStr();
 
@@ -197,6 +295,9 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                if (UNLIKELY(this->profileDetailFlag_)) {
                  profilePlan(plan);
                }
+               if (UNLIKELY(this->span_.sampled())) {
+                 tracePlan(plan);
+               }
                return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
              })
       .thenError(folly::tag_t<std::bad_alloc>{}, [this, partId](const std::bad_alloc&) {
@@ -208,6 +309,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
 StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
                                                        StorageExpressionContext* expCtx,
                                                        nebula::DataSet* result,
+                                                       std::vector<cpp2::NeighborEdges>* edges,
                                                        int64_t limit,
                                                        bool random) {
   /*
@@ -299,10 +401,10 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
   std::unique_ptr<GetNeighborsNode> output;
   if (random) {
     output = std::make_unique<GetNeighborsSampleNode>(
-        context, join, upstream, &edgeContext_, result, limit);
+        context, join, upstream, &edgeContext_, result, limit, edges);
   } else {
-    output =
-        std::make_unique<GetNeighborsNode>(context, join, upstream, &edgeContext_, result, limit);
+    output = std::make_unique<GetNeighborsNode>(
+        context, join, upstream, &edgeContext_, result, limit, edges);
   }
   output->addDependency(upstream);
   plan.addNode(std::move(output));
@@ -385,7 +487,22 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::buildEdgeContext(const cpp2::Trav
       return ret;
     }
   }
-  buildEdgeColName(std::move(returnProps));
+  if (req.stats_only_ref().value_or(false)) {
+    if (edgeContext_.statCount_ == 0) {
+      return nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
+    }
+    // The edges are not returned, so there are no edge columns
+    edgeContext_.statsOnly_ = true;
+  } else {
+    buildEdgeColName(std::move(returnProps));
+    if (req.flat_edges_ref().value_or(false)) {
+      flatEdges_ = true;
+      resultEdges_.resize(edgeContext_.propContexts_.size());
+      for (auto& edges : resultEdges_) {
+        edges.offsets_ref()->emplace_back(0);
+      }
+    }
+  }
   buildEdgeTTLInfo();
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
@@ -430,9 +547,12 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::handleEdgeStatProps(
       return nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
     }
 
-    // we only support edge property/rank expression for now
+    // we only support edge property/src/dst/rank/type expression for now
     switch (exp->kind()) {
+      case Expression::Kind::kEdgeSrc:
+      case Expression::Kind::kEdgeDst:
       case Expression::Kind::kEdgeRank:
+      case Expression::Kind::kEdgeType:
       case Expression::Kind::kEdgeProperty: {
         auto* edgeExp = static_cast<const PropertyExpression*>(exp);
         const auto& edgeName = edgeExp->sym();
@@ -488,8 +608,157 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::handleEdgeStatProps(
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+void GetNeighborsProcessor::buildMaterializedStats() {
+  if (!edgeContext_.statsOnly_ || edgeContext_.propContexts_.size() != 1) {
+    return;
+  }
+  const auto& [edgeType, props] = edgeContext_.propContexts_.front();
+  auto schemaIter = edgeContext_.schemas_.find(std::abs(edgeType));
+  if (schemaIter == edgeContext_.schemas_.end() ||
+      edgeContext_.ttlInfo_.count(std::abs(edgeType))) {
+    return;
+  }
+  auto aggregates = CommonUtils::neighborhoodAggregates(schemaIter->second.back().get());
+  auto find = [&aggregates](const std::string& definition) {
+    return std::find_if(aggregates.begin(), aggregates.end(), [&definition](const auto& agg) {
+      return agg.toString() == definition;
+    });
+  };
+  // The count tells whether the vertex has any edge, or more than the limit
+  if (find("count") == aggregates.end()) {
+    return;
+  }
+  std::vector<NeighborhoodAggregate> stats(
+      edgeContext_.statCount_, NeighborhoodAggregate(NeighborhoodAggregate::Kind::kCount, ""));
+  for (const auto& prop : props) {
+    for (size_t i = 0; i < prop.statType_.size(); i++) {
+      std::string definition;
+      switch (prop.statType_[i]) {
+        case cpp2::StatType::COUNT:
+          definition = "count";
+          break;
+        case cpp2::StatType::SUM:
+          definition = "sum(" + prop.name_ + ")";
+          break;
+        case cpp2::StatType::COLLECT_SET:
+          definition = "union(" + prop.name_ + ")";
+          break;
+        default:
+          return;
+      }
+      auto aggregate = find(definition);
+      if (aggregate == aggregates.end()) {
+        return;
+      }
+      stats[prop.statIndex_[i]] = *aggregate;
+    }
+  }
+  edgeContext_.materializedStats_ = std::move(stats);
+  edgeContext_.materializedType_ = edgeType;
+}
+
 void GetNeighborsProcessor::onProcessFinished() {
   resp_.vertices_ref() = std::move(resultDataSet_);
+  if (flatEdges_) {
+    GetNeighborsNode::truncateFlatEdges(&resultEdges_);
+    resp_.edges_ref() = std::move(resultEdges_);
+  }
+}
+
+void GetNeighborsProcessor::fetchDstVerticesAndFinish() {
+  if (dstVertexProps_ == nullptr || env_->metaClient_ == nullptr) {
+    onFinished();
+    return;
+  }
+  auto numParts = env_->metaClient_->partsNum(spaceId_);
+  if (!numParts.ok()) {
+    onFinished();
+    return;
+  }
+  const auto& vertices = *resp_.vertices_ref();
+  // The index of _dst in the props of each edge column
+  std::vector<std::pair<size_t, size_t>> dstIndices;
+  for (size_t i = 0; i < vertices.colNames.size(); ++i) {
+    const auto& colName = vertices.colNames[i];
+    if (colName.compare(0, 6, "_edge:") != 0) {
+      continue;
+    }
+    std::vector<folly::StringPiece> pieces;
+    folly::split(':', colName, pieces);
+    // The name of the column is "_edge:<edge_name>:<prop1>:<prop2>..."
+    for (size_t j = 2; j < pieces.size(); ++j) {
+      if (pieces[j] == kDst) {
+        dstIndices.emplace_back(i, j - 2);
+        break;
+      }
+    }
+  }
+
+  std::unordered_set<Value> visited;
+  std::unordered_map<PartitionID, std::vector<Row>> localDsts;
+  auto addDst = [&](const Value& dst) {
+    if (!(dst.isStr() || dst.isInt()) || !visited.emplace(dst).second) {
+      return;
+    }
+    // The requests take the vids encoded, as the ones sent by the client
+    auto vId = dst.isStr() ? dst.getStr()
+                           : std::string(reinterpret_cast<const char*>(&dst.getInt()), 8);
+    auto partId = env_->metaClient_->partId(numParts.value(), vId);
+    if (isLocalPart(partId)) {
+      localDsts[partId].emplace_back(Row({Value(std::move(vId))}));
+    }
+  };
+  if (resp_.edges_ref().has_value()) {
+    const auto& flatEdges = *resp_.edges_ref();
+    for (const auto& [col, index] : dstIndices) {
+      const auto& props = *flatEdges[col - edgeContext_.offset_].props_ref();
+      if (index < props.size()) {
+        for (const auto& dst : props[index]) {
+          addDst(dst);
+        }
+      }
+    }
+  } else {
+    for (const auto& row : vertices.rows) {
+      for (const auto& [col, index] : dstIndices) {
+        const auto& edges = row.values[col];
+        if (!edges.isList()) {
+          continue;
+        }
+        for (const auto& edge : edges.getList().values) {
+          if (edge.isList() && edge.getList().size() > index) {
+            addDst(edge.getList().values[index]);
+          }
+        }
+      }
+    }
+  }
+  if (localDsts.empty()) {
+    onFinished();
+    return;
+  }
+
+  cpp2::GetPropRequest req;
+  req.space_id_ref() = spaceId_;
+  req.parts_ref() = std::move(localDsts);
+  req.vertex_props_ref() = std::move(*dstVertexProps_);
+  if (common_.has_value()) {
+    req.common_ref() = std::move(common_).value();
+  }
+  // Not counted as a request of GetProp
+  auto* processor = GetPropProcessor::instance(env_, nullptr, executor_);
+  auto future = processor->getFuture();
+  processor->process(req);
+  std::move(future)
+      .via(executor_)
+      .thenValue([this](cpp2::GetPropResponse&& resp) {
+        // The dsts of the parts failed are fetched by the caller
+        if (resp.props_ref().has_value()) {
+          resp_.dst_vertices_ref() = std::move(*resp.props_ref());
+        }
+        onFinished();
+      })
+      .thenError(folly::tag_t<std::exception>{}, [this](const std::exception&) { onFinished(); });
 }
 
 }  // namespace storage
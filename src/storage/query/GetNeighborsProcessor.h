@@ -50,6 +50,7 @@ class GetNeighborsProcessor
   StoragePlan<VertexID> buildPlan(RuntimeContext* context,
                                   StorageExpressionContext* expCtx,
                                   nebula::DataSet* result,
+                                  std::vector<cpp2::NeighborEdges>* edges,
                                   int64_t limit = 0,
                                   bool random = false);
 
@@ -70,6 +71,10 @@ class GetNeighborsProcessor
   // add PropContext of stat
   nebula::cpp2::ErrorCode handleEdgeStatProps(const std::vector<cpp2::StatProp>& statProps);
 
+  // The stats of a single edge type without ttl are read from the aggregates materialized, if
+  // each of them is materialized and the edges are counted
+  void buildMaterializedStats();
+
   void runInSingleThread(const cpp2::GetNeighborsRequest& req, int64_t limit, bool random);
   void runInMultipleThread(const cpp2::GetNeighborsRequest& req, int64_t limit, bool random);
 
@@ -77,15 +82,26 @@ class GetNeighborsProcessor
       RuntimeContext* context,
       StorageExpressionContext* expCtx,
       nebula::DataSet* result,
+      std::vector<cpp2::NeighborEdges>* edges,
       PartitionID partId,
-      const std::vector<nebula::Value>& vids,
+      std::vector<nebula::Value> vids,
       int64_t limit,
       bool random);
 
+  // Get the props of the dsts led by this host into the dst_vertices of the response if they're
+  // requested, then finish
+  void fetchDstVerticesAndFinish();
+
  private:
   std::vector<RuntimeContext> contexts_;
   std::vector<StorageExpressionContext> expCtxs_;
   std::vector<nebula::DataSet> results_;
+  // The edges in columns if they're requested so, as the edges of the results
+  bool flatEdges_{false};
+  std::vector<cpp2::NeighborEdges> resultEdges_;
+  std::vector<std::vector<cpp2::NeighborEdges>> edgeResults_;
+  std::unique_ptr<std::vector<cpp2::VertexProp>> dstVertexProps_;
+  std::optional<cpp2::RequestCommon> common_;
 };
 
 }  // namespace storage
@@ -35,6 +35,10 @@ void GetPropProcessor::doProcess(const cpp2::GetPropRequest& req) {
     onFinished();
     return;
   }
+  if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
+    profileDetailFlag_ = true;
+  }
+  samplePerfContext();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
 
@@ -63,6 +67,7 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
     auto plan = buildTagPlan(&contexts_.front(), &resultDataSet_);
     for (const auto& partEntry : req.get_parts()) {
       auto partId = partEntry.first;
+      prefetchTags(plan, partId, partEntry.second);
       for (const auto& row : partEntry.second) {
         auto vId = row.values[0].getStr();
 
@@ -150,6 +155,7 @@ void GetPropProcessor::runInMultipleThread(const cpp2::GetPropRequest& req) {
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             handleErrorCode(code, spaceId_, partId);
           } else {
+            topN(&results_[j]);
             resultDataSet_.append(std::move(results_[j]));
           }
         }
@@ -170,12 +176,14 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
   return folly::via(executor_,
                     [this, context, result, partId, input = std::move(rows)]() {
                       memory::MemoryCheckGuard guard;
+                      auto perf = perfScope();
                       if (memoryExceeded_) {
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
                       }
                       if (!isEdge_) {
                         auto plan = buildTagPlan(context, result);
+                        prefetchTags(plan, partId, input);
                         for (const auto& row : input) {
                           auto vId = row.values[0].getStr();
 
@@ -235,8 +243,12 @@ StoragePlan<VertexID> GetPropProcessor::buildTagPlan(RuntimeContext* context,
     tags.emplace_back(tag.get());
     plan.addNode(std::move(tag));
   }
-  auto output = std::make_unique<GetTagPropNode>(
-      context, tags, result, filter_ == nullptr ? nullptr : filter_->clone(), limit_, &tagContext_);
+  auto output = std::make_unique<GetTagPropNode>(context,
+                                                 tags,
+                                                 result,
+                                                 filter_ == nullptr ? nullptr : filter_->clone(),
+                                                 planLimit(),
+                                                 &tagContext_);
   for (auto* tag : tags) {
     output->addDependency(tag);
   }
@@ -244,6 +256,29 @@ StoragePlan<VertexID> GetPropProcessor::buildTagPlan(RuntimeContext* context,
   return plan;
 }
 
+void GetPropProcessor::prefetchTags(StoragePlan<VertexID>& plan,
+                                    PartitionID partId,
+                                    const std::vector<Row>& rows) {
+  // A single vid is read by the plan directly
+  if (rows.size() < 2) {
+    return;
+  }
+  std::vector<VertexID> vIds;
+  vIds.reserve(rows.size());
+  for (const auto& row : rows) {
+    const auto& vId = row.values[0].getStr();
+    if (NebulaKeyUtils::isValidVidLen(spaceVidLen_, vId)) {
+      vIds.emplace_back(vId);
+    }
+  }
+  for (const auto& node : plan.getNodes()) {
+    auto* tag = dynamic_cast<TagNode*>(node.get());
+    if (tag != nullptr) {
+      tag->prefetch(partId, vIds);
+    }
+  }
+}
+
 StoragePlan<cpp2::EdgeKey> GetPropProcessor::buildEdgePlan(RuntimeContext* context,
                                                            nebula::DataSet* result) {
   StoragePlan<cpp2::EdgeKey> plan;
@@ -254,7 +289,7 @@ StoragePlan<cpp2::EdgeKey> GetPropProcessor::buildEdgePlan(RuntimeContext* conte
     plan.addNode(std::move(edge));
   }
   auto output = std::make_unique<GetEdgePropNode>(
-      context, edges, result, filter_ == nullptr ? nullptr : filter_->clone(), limit_);
+      context, edges, result, filter_ == nullptr ? nullptr : filter_->clone(), planLimit());
   for (auto* edge : edges) {
     output->addDependency(edge);
   }
@@ -308,7 +343,10 @@ nebula::cpp2::ErrorCode GetPropProcessor::checkAndBuildContexts(const cpp2::GetP
       return nullptr;
     }
   });
-  return code;
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  return buildOrderBy(req);
 }
 
 nebula::cpp2::ErrorCode GetPropProcessor::buildTagContext(const cpp2::GetPropRequest& req) {
@@ -356,7 +394,49 @@ void GetPropProcessor::buildEdgeColName(const std::vector<cpp2::EdgeProp>& edgeP
   }
 }
 
+nebula::cpp2::ErrorCode GetPropProcessor::buildOrderBy(const cpp2::GetPropRequest& req) {
+  if (!req.order_by_ref().has_value()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  const auto& colNames = resultDataSet_.colNames;
+  for (const auto& orderBy : *req.order_by_ref()) {
+    auto found = std::find(colNames.begin(), colNames.end(), orderBy.get_prop());
+    if (found == colNames.end()) {
+      return nebula::cpp2::ErrorCode::E_INVALID_OPERATION;
+    }
+    orderBy_.emplace_back(found - colNames.begin(),
+                          orderBy.get_direction() == cpp2::OrderDirection::ASCENDING);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void GetPropProcessor::topN(nebula::DataSet* result) const {
+  if (orderBy_.empty()) {
+    return;
+  }
+  // The prop of a tag absent is empty in storage, and null in graphd
+  auto normalize = [](const Value& val) -> const Value& {
+    return val.empty() ? Value::kNullValue : val;
+  };
+  auto comparator = [this, &normalize](const Row& lhs, const Row& rhs) -> bool {
+    for (const auto& [col, asc] : orderBy_) {
+      const auto& lValue = normalize(lhs[col]);
+      const auto& rValue = normalize(rhs[col]);
+      if (lValue == rValue) {
+        continue;
+      }
+      return asc ? lValue < rValue : lValue > rValue;
+    }
+    return false;
+  };
+  auto& rows = result->rows;
+  auto size = std::min(limit_, rows.size());
+  std::partial_sort(rows.begin(), rows.begin() + size, rows.end(), comparator);
+  rows.resize(size);
+}
+
 void GetPropProcessor::onProcessFinished() {
+  topN(&resultDataSet_);
   resp_.props_ref() = std::move(resultDataSet_);
 }
 
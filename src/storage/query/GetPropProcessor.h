@@ -56,6 +56,9 @@ class GetPropProcessor : public QueryBaseProcessor<cpp2::GetPropRequest, cpp2::G
  private:
   StoragePlan<VertexID> buildTagPlan(RuntimeContext* context, nebula::DataSet* result);
 
+  // Read the tags of all the vids of a part at once, before the plan goes through them one by one
+  void prefetchTags(StoragePlan<VertexID>& plan, PartitionID partId, const std::vector<Row>& rows);
+
   StoragePlan<cpp2::EdgeKey> buildEdgePlan(RuntimeContext* context, nebula::DataSet* result);
 
   void onProcessFinished() override;
@@ -72,6 +75,17 @@ class GetPropProcessor : public QueryBaseProcessor<cpp2::GetPropRequest, cpp2::G
 
   void buildEdgeColName(const std::vector<cpp2::EdgeProp>& edgeProps);
 
+  // Resolve the props of order_by to the columns of the result, which are built already
+  nebula::cpp2::ErrorCode buildOrderBy(const cpp2::GetPropRequest& req);
+
+  // Keep the first limit_ rows of result in the order of order_by
+  void topN(nebula::DataSet* result) const;
+
+  // The plan limits the rows only when they are not ordered
+  std::size_t planLimit() const {
+    return orderBy_.empty() ? limit_ : std::numeric_limits<std::size_t>::max();
+  }
+
   void runInSingleThread(const cpp2::GetPropRequest& req);
   void runInMultipleThread(const cpp2::GetPropRequest& req);
 
@@ -86,6 +100,8 @@ class GetPropProcessor : public QueryBaseProcessor<cpp2::GetPropRequest, cpp2::G
   std::vector<nebula::DataSet> results_;
   bool isEdge_ = false;  // true for edge, false for tag
   std::size_t limit_{std::numeric_limits<std::size_t>::max()};
+  // The column and whether it's ascending of each order_by
+  std::vector<std::pair<std::size_t, bool>> orderBy_;
 };
 
 }  // namespace storage
@@ -4,6 +4,7 @@
  */
 
 #include "common/expression/SubscriptExpression.h"
+#include "kvstore/Part.h"
 
 namespace nebula {
 namespace storage {
@@ -695,5 +696,28 @@ void QueryBaseProcessor<REQ, RESP>::profilePlan(const StoragePlan<IdType>& plan)
   }
 }
 
+template <typename REQ, typename RESP>
+template <typename IdType>
+void QueryBaseProcessor<REQ, RESP>::tracePlan(const StoragePlan<IdType>& plan) {
+  // A node runs once per vertex, so its span lasts for the accumulated time since the processor
+  // began
+  auto start = this->span_.startUs();
+  for (auto& node : plan.getNodes()) {
+    this->span_.addChild(node->name_, start, start + node->duration_.elapsedInUSec());
+  }
+}
+
+template <typename REQ, typename RESP>
+bool QueryBaseProcessor<REQ, RESP>::isLocalPart(PartitionID partId) {
+  auto found = localParts_.find(partId);
+  if (found != localParts_.end()) {
+    return found->second;
+  }
+  auto part = this->env_->kvstore_->part(spaceId_, partId);
+  auto local = ok(part) && nebula::value(part)->isLeader();
+  localParts_.emplace(partId, local);
+  return local;
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -141,6 +141,12 @@ struct EdgeContext {
   // offset is the start index of first edge type in a response row
   size_t offset_;
   size_t statCount_ = 0;
+  // Return the stats of each vertex without the edges
+  bool statsOnly_ = false;
+  // The aggregates materialized of the stats by the stat index, which are read rather than the
+  // edges of materializedType_, empty if any stat is not materialized
+  std::vector<NeighborhoodAggregate> materializedStats_;
+  EdgeType materializedType_ = 0;
 
   // additional operator for eventually-consistent edges
   std::vector<std::pair<std::string, std::string>> kvAppend;
@@ -206,6 +212,13 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   template <typename IdType>
   void profilePlan(const StoragePlan<IdType>& plan);
 
+  // Export the spans of the nodes of plan, called once the plan is done if the request is traced
+  template <typename IdType>
+  void tracePlan(const StoragePlan<IdType>& plan);
+
+  // Whether the part of spaceId_ is led by this host
+  bool isLocalPart(PartitionID partId);
+
  protected:
   GraphSpaceID spaceId_;
   folly::Executor* executor_{nullptr};
@@ -219,6 +232,9 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   std::unordered_set<std::string> valueProps_;
 
   nebula::DataSet resultDataSet_;
+
+  // led or not of the parts checked by isLocalPart
+  std::unordered_map<PartitionID, bool> localParts_;
 };
 
 }  // namespace storage
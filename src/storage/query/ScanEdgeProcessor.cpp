@@ -7,6 +7,7 @@
 
 #include "common/memory/MemoryTracker.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/ScanCacheGuard.h"
 #include "storage/StorageFlags.h"
 #include "storage/exec/QueryUtils.h"
 
@@ -26,7 +27,11 @@ void ScanEdgeProcessor::process(const cpp2::ScanEdgeRequest& req) {
 
 void ScanEdgeProcessor::doProcess(const cpp2::ScanEdgeRequest& req) {
   spaceId_ = req.get_space_id();
-  enableReadFollower_ = req.get_enable_read_from_follower();
+  // The follower read of the request common is bounded by the lag of follower, which takes over
+  // the unbounded one of enable_read_from_follower
+  auto followerRead =
+      req.common_ref().has_value() && req.get_common()->follower_read_ref().value_or(false);
+  enableReadFollower_ = req.get_enable_read_from_follower() && !followerRead;
   // Negative means no limit
   limit_ = req.get_limit() < 0 ? std::numeric_limits<int64_t>::max() : req.get_limit();
 
@@ -39,6 +44,7 @@ void ScanEdgeProcessor::doProcess(const cpp2::ScanEdgeRequest& req) {
     return;
   }
 
+  samplePerfContext();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
 
@@ -132,6 +138,8 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanEdgeProcessor
   return folly::via(executor_,
                     [this, context, result, cursors, partId, input = std::move(cursor), expCtx]() {
                       memory::MemoryCheckGuard guard;
+                      kvstore::ScanCacheGuard scanGuard;
+                      auto perf = perfScope();
                       if (memoryExceeded_) {
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
@@ -152,6 +160,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanEdgeProcessor
 
 void ScanEdgeProcessor::runInSingleThread(const cpp2::ScanEdgeRequest& req) {
   memory::MemoryCheckGuard guard;
+  kvstore::ScanCacheGuard scanGuard;
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
   std::unordered_set<PartitionID> failedParts;
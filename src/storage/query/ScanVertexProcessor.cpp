@@ -9,6 +9,7 @@
 
 #include "common/memory/MemoryTracker.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/ScanCacheGuard.h"
 #include "storage/StorageFlags.h"
 #include "storage/exec/QueryUtils.h"
 
@@ -30,7 +31,11 @@ void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
   spaceId_ = req.get_space_id();
   // negative limit number means no limit
   limit_ = req.get_limit() < 0 ? std::numeric_limits<int64_t>::max() : req.get_limit();
-  enableReadFollower_ = req.get_enable_read_from_follower();
+  // The follower read of the request common is bounded by the lag of follower, which takes over
+  // the unbounded one of enable_read_from_follower
+  auto followerRead =
+      req.common_ref().has_value() && req.get_common()->follower_read_ref().value_or(false);
+  enableReadFollower_ = req.get_enable_read_from_follower() && !followerRead;
 
   auto retCode = getSpaceVidLen(spaceId_);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -41,6 +46,7 @@ void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
     return;
   }
 
+  samplePerfContext();
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
 
@@ -133,6 +139,8 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanVertexProcess
              executor_,
              [this, context, result, cursorsOfPart, partId, input = std::move(cursor), expCtx]() {
                memory::MemoryCheckGuard guard;
+               kvstore::ScanCacheGuard scanGuard;
+               auto perf = perfScope();
                if (memoryExceeded_) {
                  return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED, partId);
                }
@@ -152,6 +160,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanVertexProcess
 
 void ScanVertexProcessor::runInSingleThread(const cpp2::ScanVertexRequest& req) {
   memory::MemoryCheckGuard guard;
+  kvstore::ScanCacheGuard scanGuard;
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
   std::unordered_set<PartitionID> failedParts;
@@ -13,6 +13,14 @@ stats::CounterId kNumVerticesInserted;
 stats::CounterId kNumEdgesDeleted;
 stats::CounterId kNumTagsDeleted;
 stats::CounterId kNumVerticesDeleted;
+stats::CounterId kNumVertexCacheHits;
+stats::CounterId kNumVertexCacheMisses;
+stats::CounterId kNumAdjacencyCacheHits;
+stats::CounterId kNumAdjacencyCacheMisses;
+stats::CounterId kNumLockConflicts;
+stats::CounterId kNumLockTimeouts;
+stats::CounterId kNumUpdatesCoalesced;
+stats::CounterId kNumForegroundRequests;
 
 void initStorageStats() {
   kNumEdgesInserted = stats::StatsManager::registerStats("num_edges_inserted", "rate, sum");
@@ -20,6 +28,18 @@ void initStorageStats() {
   kNumEdgesDeleted = stats::StatsManager::registerStats("num_edges_deleted", "rate, sum");
   kNumTagsDeleted = stats::StatsManager::registerStats("num_tags_deleted", "rate, sum");
   kNumVerticesDeleted = stats::StatsManager::registerStats("num_vertices_deleted", "rate, sum");
+  kNumVertexCacheHits = stats::StatsManager::registerStats("num_vertex_cache_hits", "rate, sum");
+  kNumVertexCacheMisses =
+      stats::StatsManager::registerStats("num_vertex_cache_misses", "rate, sum");
+  kNumAdjacencyCacheHits =
+      stats::StatsManager::registerStats("num_adjacency_cache_hits", "rate, sum");
+  kNumAdjacencyCacheMisses =
+      stats::StatsManager::registerStats("num_adjacency_cache_misses", "rate, sum");
+  kNumLockConflicts = stats::StatsManager::registerStats("num_lock_conflicts", "rate, sum");
+  kNumLockTimeouts = stats::StatsManager::registerStats("num_lock_timeouts", "rate, sum");
+  kNumUpdatesCoalesced = stats::StatsManager::registerStats("num_updates_coalesced", "rate, sum");
+  kNumForegroundRequests =
+      stats::StatsManager::registerStats("num_foreground_requests", "rate, sum");
 
 #ifndef BUILD_STANDALONE
   initMetaClientStats();
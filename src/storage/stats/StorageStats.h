@@ -15,6 +15,15 @@ extern stats::CounterId kNumVerticesInserted;
 extern stats::CounterId kNumEdgesDeleted;
 extern stats::CounterId kNumTagsDeleted;
 extern stats::CounterId kNumVerticesDeleted;
+extern stats::CounterId kNumVertexCacheHits;
+extern stats::CounterId kNumVertexCacheMisses;
+extern stats::CounterId kNumAdjacencyCacheHits;
+extern stats::CounterId kNumAdjacencyCacheMisses;
+extern stats::CounterId kNumLockConflicts;
+extern stats::CounterId kNumLockTimeouts;
+extern stats::CounterId kNumUpdatesCoalesced;
+// The requests of the graph service, by which the admin tasks back off
+extern stats::CounterId kNumForegroundRequests;
 
 /**
  * @brief Init storage statistic points for storage/meta client/kv
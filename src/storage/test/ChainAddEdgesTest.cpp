@@ -176,6 +176,42 @@ TEST(ChainAddEdgesTest, processRemoteUnknownTest) {
   EXPECT_EQ(334, numOfKey(req, util.genDoublePrime, env));
 }
 
+TEST(ChainAddEdgesTest, BatcherTest) {
+  fs::TempDir rootPath("/tmp/AddEdgesTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto mClient = MetaClientTestUpdater::makeDefault();
+  env->metaClient_ = mClient.get();
+  MetaClientTestUpdater::addPartTerm(env->metaClient_, mockSpaceId, mockPartNum, fackTerm);
+  UPCLT iClient(FakeInternalStorageClient::instance(env));
+  FakeInternalStorageClient::hookInternalStorageClient(env, iClient.get());
+
+  // One chain at a time, the requests coming while it runs are merged into the next
+  FLAGS_toss_chain_pipeline_depth = 1;
+  cpp2::AddEdgesRequest req = mock::MockData::mockAddEdgesReq(false, 1);
+  auto partId = req.get_parts().begin()->first;
+  const auto& edges = req.get_parts().begin()->second;
+  std::vector<folly::SemiFuture<Code>> futures;
+  for (size_t i = 0; i < edges.size(); i++) {
+    cpp2::AddEdgesRequest single;
+    single.space_id_ref() = req.get_space_id();
+    single.prop_names_ref() = req.get_prop_names();
+    single.if_not_exists_ref() = req.get_if_not_exists();
+    (*single.parts_ref())[partId].emplace_back(edges[i]);
+    futures.emplace_back(env->txnMan_->addEdgesBatcher()->add(std::move(single), partId, partId));
+  }
+  for (auto& future : futures) {
+    EXPECT_EQ(suc, std::move(future).get());
+  }
+  FLAGS_toss_chain_pipeline_depth = 2;
+
+  ChainTestUtils util;
+  EXPECT_EQ(334, numOfKey(req, util.genKey, env));
+  EXPECT_EQ(0, numOfKey(req, util.genPrime, env));
+  EXPECT_EQ(0, numOfKey(req, util.genDoublePrime, env));
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -7,6 +7,8 @@
 
 #include "codec/RowWriterV2.h"
 #include "common/base/Base.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
 #include "common/fs/TempDir.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
@@ -15,6 +17,7 @@
 #include "mock/MockCluster.h"
 #include "mock/MockData.h"
 #include "storage/CommonUtils.h"
+#include "storage/CompactionFilter.h"
 #include "storage/test/QueryTestUtils.h"
 #include "storage/test/TestUtils.h"
 
@@ -495,6 +498,63 @@ TEST(CompactionFilterTest, TTLFilterDataIndexNotExpiredTest) {
   FLAGS_mock_ttl_col = false;
 }
 
+TEST(CompactionFilterTest, UpgradeRowTest) {
+  GraphSpaceID spaceId = 1;
+  TagID tagId = 1;
+  size_t vIdLen = 8;
+  ObjectPool pool;
+  mock::AdHocSchemaManager schemaMan;
+  mock::AdHocIndexManager indexMan;
+  auto v0 = std::make_shared<meta::NebulaSchemaProvider>(0);
+  v0->addField("name", nebula::cpp2::PropertyType::STRING);
+  schemaMan.addTagSchema(spaceId, tagId, v0);
+  auto v1 = std::make_shared<meta::NebulaSchemaProvider>(1);
+  v1->addField("name", nebula::cpp2::PropertyType::STRING);
+  v1->addField("age",
+               nebula::cpp2::PropertyType::INT64,
+               0,
+               false,
+               ConstantExpression::make(&pool, 18L)->encode());
+  v1->addField("email", nebula::cpp2::PropertyType::STRING, 0, true);
+  schemaMan.addTagSchema(spaceId, tagId, v1);
+
+  RowWriterV2 writer(v0.get());
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.setValue("name", "Tim"));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  auto val = writer.moveEncodedStr();
+  auto key = NebulaKeyUtils::tagKey(vIdLen, 1, "Tim", tagId);
+
+  StorageCompactionFilter filter(&schemaMan, &indexMan, vIdLen);
+  std::string newVal;
+  FLAGS_compaction_upgrade_rows = false;
+  EXPECT_FALSE(filter.rewrite(spaceId, key, val, &newVal));
+
+  FLAGS_compaction_upgrade_rows = true;
+  ASSERT_TRUE(filter.rewrite(spaceId, key, val, &newVal));
+  auto reader = RowReaderWrapper::getTagPropReader(&schemaMan, spaceId, tagId, newVal);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(1, reader->schemaVer());
+  EXPECT_EQ(Value("Tim"), reader->getValueByName("name"));
+  EXPECT_EQ(Value(18L), reader->getValueByName("age"));
+  EXPECT_EQ(Value::kNullValue, reader->getValueByName("email"));
+
+  // The rows in the latest version are kept as is
+  std::string latestVal;
+  EXPECT_FALSE(filter.rewrite(spaceId, key, newVal, &latestVal));
+
+  // The default value evaluated at the time read is not written into the rows
+  auto v2 = std::make_shared<meta::NebulaSchemaProvider>(2);
+  v2->addField("name", nebula::cpp2::PropertyType::STRING);
+  v2->addField("created",
+               nebula::cpp2::PropertyType::INT64,
+               0,
+               false,
+               FunctionCallExpression::make(&pool, "time")->encode());
+  schemaMan.addTagSchema(spaceId, tagId, v2);
+  EXPECT_FALSE(filter.rewrite(spaceId, key, val, &latestVal));
+  FLAGS_compaction_upgrade_rows = false;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
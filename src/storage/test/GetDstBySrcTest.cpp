@@ -40,7 +40,6 @@ class GetDstBySrcTest : public ::testing::Test {
     checkResponse(*resp.dsts_ref(), expect);
   }
 
- private:
   cpp2::GetDstBySrcRequest buildRequest(const std::vector<VertexID>& vertices,
                                         const std::vector<EdgeType>& edges) {
     std::hash<std::string> hash;
@@ -56,6 +55,7 @@ class GetDstBySrcTest : public ::testing::Test {
     return req;
   }
 
+ private:
   void checkResponse(nebula::DataSet& actual, std::vector<VertexID>& dsts) {
     // sort to make sure the return order are same
     std::sort(actual.rows.begin(), actual.rows.end());
@@ -160,6 +160,27 @@ TEST_F(GetDstBySrcTest, BasicTest) {
   }
 }
 
+TEST_F(GetDstBySrcTest, MultipleStepsTest) {
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+  // The mock env has no meta client to locate the parts of the dsts, so none of them is expanded
+  // in place and all are returned as the remote dsts of the step reached
+  auto req = buildRequest({"Tim Duncan"}, {serve, teammate});
+  req.steps_ref() = 3;
+  auto* processor = GetDstBySrcProcessor::instance(env_, nullptr, threadPool_.get());
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+  EXPECT_TRUE(resp.dsts_ref()->rows.empty());
+  ASSERT_TRUE(resp.remote_dsts_ref().has_value());
+  ASSERT_EQ(1, resp.remote_dsts_ref()->size());
+  auto remotes = resp.remote_dsts_ref()->at(1);
+  std::sort(remotes.begin(), remotes.end());
+  std::vector<Value> expect{"Manu Ginobili", "Spurs", "Tony Parker"};
+  EXPECT_EQ(expect, remotes);
+}
+
 class GetDstBySrcConcurrentTest : public GetDstBySrcTest {
  public:
   void SetUp() override {
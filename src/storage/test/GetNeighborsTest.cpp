@@ -382,6 +382,11 @@ TEST(GetNeighborsTest, PropertyTest) {
 
 TEST(GetNeighborsTest, GoFromMultiVerticesTest) {
   FLAGS_query_concurrently = true;
+  // Run every request concurrently, and split the vids of each part into several tasks
+  auto minVidsBak = FLAGS_query_concurrently_min_vids;
+  auto vidsPerTaskBak = FLAGS_query_concurrently_vids_per_task;
+  FLAGS_query_concurrently_min_vids = 0;
+  FLAGS_query_concurrently_vids_per_task = 1;
   fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
   mock::MockCluster cluster;
   cluster.initStorageKV(rootPath.path());
@@ -527,6 +532,84 @@ TEST(GetNeighborsTest, GoFromMultiVerticesTest) {
     QueryTestUtils::checkResponse(*resp.vertices_ref(), vertices, over, tags, edges, 2, 6);
   }
   FLAGS_query_concurrently = false;
+  FLAGS_query_concurrently_min_vids = minVidsBak;
+  FLAGS_query_concurrently_vids_per_task = vidsPerTaskBak;
+}
+
+TEST(GetNeighborsTest, AdjacencyCacheTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+  env->adjacencyCache_ = std::make_unique<AdjacencyCache>(1024, 4);
+  auto* cache = env->adjacencyCache_.get();
+
+  GraphSpaceID spaceId = 1;
+  TagID player = 1;
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+  VertexID vId = "Tim Duncan";
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+  PartitionID partId = (std::hash<std::string>()(vId) % totalParts) + 1;
+  auto servePrefix = NebulaKeyUtils::edgePrefix(vIdLen, partId, vId, serve);
+  auto teammatePrefix = NebulaKeyUtils::edgePrefix(vIdLen, partId, vId, teammate);
+
+  std::vector<VertexID> vertices = {vId};
+  std::vector<EdgeType> over = {serve, teammate};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  edges.emplace_back(serve, std::vector<std::string>{"teamName", "startYear", "endYear"});
+  edges.emplace_back(teammate, std::vector<std::string>{"player1", "player2", "teamName"});
+  auto getNeighbors = [&]() {
+    auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    return *resp.vertices_ref();
+  };
+
+  DataSet expected;
+  {
+    LOG(INFO) << "FillOnMiss";
+    expected = getNeighbors();
+    // vId, stat, player, serve, teammate, expr
+    QueryTestUtils::checkResponse(expected, vertices, over, tags, edges, 1, 6);
+    auto serveBlock = cache->get(spaceId, servePrefix);
+    ASSERT_TRUE(serveBlock.has_value());
+    ASSERT_EQ(1, serveBlock.value()->size());
+    ASSERT_TRUE(cache->get(spaceId, teammatePrefix).has_value());
+  }
+  {
+    LOG(INFO) << "ReadOnHit";
+    ASSERT_EQ(expected, getNeighbors());
+  }
+  {
+    LOG(INFO) << "EvictOnWrite";
+    cache->evict(spaceId, {servePrefix});
+    ASSERT_FALSE(cache->get(spaceId, servePrefix).has_value());
+    ASSERT_TRUE(cache->get(spaceId, teammatePrefix).has_value());
+    ASSERT_EQ(expected, getNeighbors());
+    ASSERT_TRUE(cache->get(spaceId, servePrefix).has_value());
+  }
+  {
+    LOG(INFO) << "TooManyEdges";
+    auto maxEdges = FLAGS_adjacency_cache_max_edges;
+    FLAGS_adjacency_cache_max_edges = 1;
+    cache->clear();
+    ASSERT_EQ(expected, getNeighbors());
+    // Tim Duncan has a serve edge and more teammate edges
+    ASSERT_TRUE(cache->get(spaceId, servePrefix).has_value());
+    ASSERT_FALSE(cache->get(spaceId, teammatePrefix).has_value());
+    FLAGS_adjacency_cache_max_edges = maxEdges;
+  }
+  env->adjacencyCache_.reset();
 }
 
 TEST(GetNeighborsTest, StatTest) {
@@ -667,6 +750,83 @@ TEST(GetNeighborsTest, StatTest) {
   }
 }
 
+TEST(GetNeighborsTest, StatsOnlyTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  EdgeType serve = 101;
+  std::vector<VertexID> vertices = {"LeBron James", "Tim Duncan", "Not Existed"};
+  std::vector<EdgeType> over = {serve};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  edges.emplace_back(serve, std::vector<std::string>{});
+  auto statProp = [](const Expression& exp, cpp2::StatType stat) {
+    cpp2::StatProp prop;
+    prop.alias_ref() = "_agg";
+    prop.prop_ref() = Expression::encode(exp);
+    prop.stat_ref() = stat;
+    return prop;
+  };
+  auto serveName = folly::to<std::string>(serve);
+
+  {
+    LOG(INFO) << "CountSumAndCollectSet";
+    auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+    std::vector<cpp2::StatProp> statProps;
+    statProps.emplace_back(
+        statProp(*EdgeRankExpression::make(pool, serveName), cpp2::StatType::COUNT));
+    statProps.emplace_back(statProp(*EdgePropertyExpression::make(pool, serveName, "teamGames"),
+                                    cpp2::StatType::SUM));
+    statProps.emplace_back(statProp(*EdgePropertyExpression::make(pool, serveName, "teamName"),
+                                    cpp2::StatType::COLLECT_SET));
+    statProps.emplace_back(
+        statProp(*EdgeDstIdExpression::make(pool, serveName), cpp2::StatType::COLLECT_SET));
+    (*req.traverse_spec_ref()).stat_props_ref() = std::move(statProps);
+    (*req.traverse_spec_ref()).stats_only_ref() = true;
+
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    const auto& ds = *resp.vertices_ref();
+    // The vertex without any edge has no row
+    ASSERT_EQ(2, ds.rows.size());
+    std::unordered_map<VertexID, List> expectStats;
+    expectStats.emplace("LeBron James",
+                        List({4L,
+                              548L + 294L + 301L + 115L,
+                              Set({"Cavaliers", "Heat", "Lakers"}),
+                              Set({"Cavaliers", "Heat", "Lakers"})}));
+    expectStats.emplace("Tim Duncan", List({1L, 1392L, Set({"Spurs"}), Set({"Spurs"})}));
+    for (const auto& row : ds.rows) {
+      // vId, stat, expr
+      ASSERT_EQ(3, row.size());
+      auto iter = expectStats.find(row[0].getStr());
+      ASSERT_TRUE(iter != expectStats.end());
+      ASSERT_EQ(iter->second, row[1].getList());
+    }
+  }
+  {
+    LOG(INFO) << "NoStatProps";
+    auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+    (*req.traverse_spec_ref()).stats_only_ref() = true;
+
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_NE(0, (*resp.result_ref()).failed_parts.size());
+  }
+}
+
 TEST(GetNeighborsTest, LimitSampleTest) {
   fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
   mock::MockCluster cluster;
@@ -2088,6 +2248,125 @@ TEST(GetNeighborsTest, FilterTest) {
   }
 }
 
+TEST(GetNeighborsTest, DstVertexPropsTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  TagID player = 1;
+  TagID team = 2;
+  EdgeType serve = 101;
+
+  std::vector<VertexID> vertices = {"Tim Duncan"};
+  std::vector<EdgeType> over = {serve};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  edges.emplace_back(serve, std::vector<std::string>{kDst, "teamName", "startYear", "endYear"});
+  auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+  cpp2::VertexProp dstProp;
+  dstProp.tag_ref() = team;
+  dstProp.props_ref() = std::vector<std::string>{"name"};
+  (*req.traverse_spec_ref()).dst_vertex_props_ref() = std::vector<cpp2::VertexProp>{dstProp};
+
+  auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+
+  ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+  // The neighbors are the same as without the dst props
+  QueryTestUtils::checkResponse(*resp.vertices_ref(), vertices, over, tags, edges, 1, 5);
+  // The mock env has no meta client to locate the parts of the dsts, so all of them are left to
+  // the caller to fetch
+  EXPECT_FALSE(resp.dst_vertices_ref().has_value());
+}
+
+TEST(GetNeighborsTest, FlatEdgesTest) {
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  TagID player = 1;
+  EdgeType serve = 101;
+  EdgeType teammate = 102;
+
+  std::vector<VertexID> vertices = {"Tim Duncan", "Tony Parker", "LeBron James", "Not Existed"};
+  std::vector<EdgeType> over = {serve, teammate};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age"});
+  edges.emplace_back(serve, std::vector<std::string>{kDst, "teamName", "startYear"});
+  edges.emplace_back(teammate, std::vector<std::string>{kDst, "player1", "player2", "teamName"});
+  auto minVidsBak = FLAGS_query_concurrently_min_vids;
+  auto vidsPerTaskBak = FLAGS_query_concurrently_vids_per_task;
+  FLAGS_query_concurrently_min_vids = 0;
+  FLAGS_query_concurrently_vids_per_task = 1;
+  for (auto concurrently : {false, true}) {
+    LOG(INFO) << "Concurrently: " << concurrently;
+    FLAGS_query_concurrently = concurrently;
+    auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto nested = std::move(fut).get();
+    ASSERT_EQ(0, (*nested.result_ref()).failed_parts.size());
+    EXPECT_FALSE(nested.edges_ref().has_value());
+
+    (*req.traverse_spec_ref()).flat_edges_ref() = true;
+    processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    fut = processor->getFuture();
+    processor->process(req);
+    auto flat = std::move(fut).get();
+    ASSERT_EQ(0, (*flat.result_ref()).failed_parts.size());
+    ASSERT_TRUE(flat.edges_ref().has_value());
+
+    // vId, stat, player, serve, teammate, expr
+    const auto& nestedDs = *nested.vertices_ref();
+    const auto& flatDs = *flat.vertices_ref();
+    ASSERT_EQ(nestedDs.colNames, flatDs.colNames);
+    ASSERT_EQ(nestedDs.rows.size(), flatDs.rows.size());
+    const auto& flatEdges = *flat.edges_ref();
+    ASSERT_EQ(2, flatEdges.size());
+    for (size_t col = 0; col < flatEdges.size(); ++col) {
+      ASSERT_EQ(flatDs.rows.size() + 1, flatEdges[col].get_offsets().size());
+    }
+    for (size_t row = 0; row < flatDs.rows.size(); ++row) {
+      ASSERT_EQ(nestedDs.rows[row][0], flatDs.rows[row][0]);
+      ASSERT_EQ(nestedDs.rows[row][2], flatDs.rows[row][2]);
+      for (size_t col = 0; col < flatEdges.size(); ++col) {
+        // The edge columns are left empty
+        ASSERT_TRUE(flatDs.rows[row][3 + col].empty());
+        const auto& offsets = flatEdges[col].get_offsets();
+        const auto& props = flatEdges[col].get_props();
+        List flatList;
+        for (auto i = offsets[row]; i < offsets[row + 1]; ++i) {
+          List edge;
+          for (const auto& prop : props) {
+            edge.emplace_back(prop[i]);
+          }
+          flatList.emplace_back(std::move(edge));
+        }
+        const auto& cell = nestedDs.rows[row][3 + col];
+        ASSERT_EQ(cell.isList() ? cell.getList() : List(), flatList);
+      }
+    }
+  }
+  FLAGS_query_concurrently = false;
+  FLAGS_query_concurrently_min_vids = minVidsBak;
+  FLAGS_query_concurrently_vids_per_task = vidsPerTaskBak;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
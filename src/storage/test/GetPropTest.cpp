@@ -666,6 +666,69 @@ TEST(GetPropTest, ConcurrencyTest) {
   FLAGS_query_concurrently = false;
 }
 
+TEST(GetPropTest, VertexCacheTest) {
+  fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  env->vertexCache_ = std::make_unique<VertexCache>(1024, 4);
+  auto* cache = env->vertexCache_.get();
+
+  GraphSpaceID spaceId = 1;
+  TagID player = 1;
+  VertexID vId = "Tim Duncan";
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+  PartitionID partId = (std::hash<std::string>()(vId) % totalParts) + 1;
+  auto tagKey = NebulaKeyUtils::tagKey(vIdLen, partId, vId, player);
+
+  nebula::DataSet expected;
+  expected.colNames = {kVid, "1.name", "1.age", "1.avgScore"};
+  expected.rows.emplace_back(nebula::Row({"Tim Duncan", "Tim Duncan", 44, 19.0}));
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  {
+    LOG(INFO) << "FillOnMiss";
+    ASSERT_FALSE(cache->get(spaceId, tagKey).has_value());
+    auto req = buildVertexRequest(totalParts, {vId}, tags);
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    ASSERT_EQ(expected, *resp.props_ref());
+    ASSERT_TRUE(cache->get(spaceId, tagKey).has_value());
+    // Another space doesn't share the rows
+    ASSERT_FALSE(cache->get(spaceId + 1, tagKey).has_value());
+  }
+  {
+    LOG(INFO) << "ReadOnHit";
+    auto req = buildVertexRequest(totalParts, {vId}, tags);
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    ASSERT_EQ(expected, *resp.props_ref());
+  }
+  {
+    LOG(INFO) << "StaleFill";
+    auto epoch = cache->epoch();
+    auto value = cache->get(spaceId, tagKey).value();
+    cache->evict(spaceId, {tagKey});
+    ASSERT_FALSE(cache->get(spaceId, tagKey).has_value());
+    // The row read before the eviction is not cached
+    cache->fill(spaceId, tagKey, value, epoch);
+    ASSERT_FALSE(cache->get(spaceId, tagKey).has_value());
+    cache->fill(spaceId, tagKey, value, cache->epoch());
+    ASSERT_TRUE(cache->get(spaceId, tagKey).has_value());
+    cache->clear();
+    ASSERT_FALSE(cache->get(spaceId, tagKey).has_value());
+  }
+  env->vertexCache_.reset();
+}
+
 TEST(QueryVertexPropsTest, PrefixBloomFilterTest) {
   FLAGS_enable_rocksdb_statistics = true;
   FLAGS_enable_rocksdb_prefix_filtering = true;
@@ -1028,6 +1091,74 @@ TEST(GetPropTest, LimitTest) {
   }
 }
 
+TEST(GetPropTest, OrderByTest) {
+  fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+
+  TagID player = 1;
+  std::vector<VertexID> vertices = {"Tim Duncan", "Tony Parker"};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age"});
+  auto orderBy = [](const std::string& prop, cpp2::OrderDirection direction) {
+    cpp2::OrderBy order;
+    order.prop_ref() = prop;
+    order.direction_ref() = direction;
+    return order;
+  };
+
+  {
+    LOG(INFO) << "OrderByAscending";
+    auto req = buildVertexRequest(totalParts, vertices, tags, nullptr, 1);
+    req.order_by_ref() =
+        std::vector<cpp2::OrderBy>{orderBy("1.age", cpp2::OrderDirection::ASCENDING)};
+
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    nebula::DataSet expected;
+    expected.colNames = {kVid, "1.name", "1.age"};
+    expected.emplace_back(Row({"Tony Parker", "Tony Parker", 38}));
+    ASSERT_EQ(expected, *resp.props_ref());
+  }
+  {
+    LOG(INFO) << "OrderByDescending";
+    auto req = buildVertexRequest(totalParts, vertices, tags, nullptr, 1);
+    req.order_by_ref() =
+        std::vector<cpp2::OrderBy>{orderBy("1.age", cpp2::OrderDirection::DESCENDING)};
+
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    nebula::DataSet expected;
+    expected.colNames = {kVid, "1.name", "1.age"};
+    expected.emplace_back(Row({"Tim Duncan", "Tim Duncan", 44}));
+    ASSERT_EQ(expected, *resp.props_ref());
+  }
+  {
+    LOG(INFO) << "OrderByPropNotFetched";
+    auto req = buildVertexRequest(totalParts, vertices, tags, nullptr, 1);
+    req.order_by_ref() =
+        std::vector<cpp2::OrderBy>{orderBy("1.avgScore", cpp2::OrderDirection::ASCENDING)};
+
+    auto* processor = GetPropProcessor::instance(env, nullptr, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+
+    ASSERT_NE(0, (*resp.result_ref()).failed_parts.size());
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
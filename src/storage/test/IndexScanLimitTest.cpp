@@ -244,10 +244,10 @@ TEST_F(IndexScanLimitTest, LookupTagIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(1 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(1, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part
+  // limit 5 of all parts
   {
     req.limit_ref() = 5;
     auto* processor = LookupProcessor::instance(storageEnv_.get(), nullptr, nullptr);
@@ -255,10 +255,10 @@ TEST_F(IndexScanLimitTest, LookupTagIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part through IndexScanNode->DataNode
+  // limit 5 of all parts through IndexScanNode->DataNode
   {
     req.limit_ref() = 5;
     cpp2::IndexColumnHint columnHint;
@@ -275,10 +275,10 @@ TEST_F(IndexScanLimitTest, LookupTagIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part through IndexScanNode->DataNode->FilterNode
+  // limit 5 of all parts through IndexScanNode->DataNode->FilterNode
   {
     req.limit_ref() = 5;
     cpp2::IndexColumnHint columnHint;
@@ -298,7 +298,7 @@ TEST_F(IndexScanLimitTest, LookupTagIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 }
 
@@ -349,10 +349,10 @@ TEST_F(IndexScanLimitTest, LookupEdgeIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(1 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(1, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part
+  // limit 5 of all parts
   {
     req.limit_ref() = 5;
     auto* processor = LookupProcessor::instance(storageEnv_.get(), nullptr, nullptr);
@@ -360,10 +360,10 @@ TEST_F(IndexScanLimitTest, LookupEdgeIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part through IndexScanNode->DataNode
+  // limit 5 of all parts through IndexScanNode->DataNode
   {
     req.limit_ref() = 5;
     cpp2::IndexColumnHint columnHint;
@@ -381,10 +381,10 @@ TEST_F(IndexScanLimitTest, LookupEdgeIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 
-  // limit 5 by each part through IndexScanNode->DataNode->FilterNode
+  // limit 5 of all parts through IndexScanNode->DataNode->FilterNode
   {
     req.limit_ref() = 5;
     cpp2::IndexColumnHint columnHint;
@@ -404,7 +404,7 @@ TEST_F(IndexScanLimitTest, LookupEdgeIndexLimit) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(5 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(5, resp.get_data()->rows.size());
   }
 }
 
@@ -261,20 +261,15 @@ TEST_F(IndexScanTopNTest, LookupTagIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(1 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(1, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kVid, "col1", "col2"};
     expected.rows.emplace_back(nebula::Row({"10", 10, "row_10"}));
-    expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
     verifyResult(expected, *resp.get_data());
   }
 
-  // limit 3 by each part through IndexScanNode->DataNode
+  // limit 3 of all parts through IndexScanNode->DataNode
   {
     nebula::storage::cpp2::OrderBy orderBy;
     orderBy.prop_ref() = "col1";
@@ -297,32 +292,17 @@ TEST_F(IndexScanTopNTest, LookupTagIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(3 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(3, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kVid, "col1", "col2"};
-    expected.rows.emplace_back(nebula::Row({"17", 17, "row_17"}));
     expected.rows.emplace_back(nebula::Row({"15", 15, "row_15"}));
     expected.rows.emplace_back(nebula::Row({"16", 16, "row_16"}));
-    expected.rows.emplace_back(nebula::Row({"22", 22, "row_22"}));
-    expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"21", 21, "row_21"}));
-    expected.rows.emplace_back(nebula::Row({"32", 32, "row_32"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"31", 31, "row_31"}));
-    expected.rows.emplace_back(nebula::Row({"42", 42, "row_42"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"41", 41, "row_41"}));
-    expected.rows.emplace_back(nebula::Row({"52", 52, "row_52"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"51", 51, "row_51"}));
-    expected.rows.emplace_back(nebula::Row({"62", 62, "row_62"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
-    expected.rows.emplace_back(nebula::Row({"61", 61, "row_61"}));
+    expected.rows.emplace_back(nebula::Row({"17", 17, "row_17"}));
     verifyResult(expected, *resp.get_data());
   }
 
-  // limit 3 by each part through IndexScanNode->DataNode->FilterNode
+  // limit 3 of all parts through IndexScanNode->DataNode->FilterNode
   {
     nebula::storage::cpp2::OrderBy orderBy;
     orderBy.prop_ref() = "col1";
@@ -353,26 +333,13 @@ TEST_F(IndexScanTopNTest, LookupTagIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(3 * parts.size() - 2, resp.get_data()->rows.size());
+    EXPECT_EQ(3, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kVid, "col1", "col2"};
-    expected.rows.emplace_back(nebula::Row({"18", 18, "row_18"}));
     expected.rows.emplace_back(nebula::Row({"16", 16, "row_16"}));
-    expected.rows.emplace_back(nebula::Row({"24", 24, "row_24"}));
+    expected.rows.emplace_back(nebula::Row({"18", 18, "row_18"}));
     expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"22", 22, "row_22"}));
-    expected.rows.emplace_back(nebula::Row({"34", 34, "row_34"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"32", 32, "row_32"}));
-    expected.rows.emplace_back(nebula::Row({"44", 44, "row_44"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"42", 42, "row_42"}));
-    expected.rows.emplace_back(nebula::Row({"54", 54, "row_54"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"52", 52, "row_52"}));
-    expected.rows.emplace_back(nebula::Row({"62", 62, "row_62"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
     verifyResult(expected, *resp.get_data());
   }
 }
@@ -438,20 +405,15 @@ TEST_F(IndexScanTopNTest, LookupEdgeIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(1 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(1, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kSrc, "col1", "col2"};
     expected.rows.emplace_back(nebula::Row({"10", 10, "row_10"}));
-    expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
     verifyResult(expected, *resp.get_data());
   }
 
-  // limit 3 by each part through IndexScanNode->DataNode
+  // limit 3 of all parts through IndexScanNode->DataNode
   {
     nebula::storage::cpp2::OrderBy orderBy;
     orderBy.prop_ref() = "col1";
@@ -474,32 +436,17 @@ TEST_F(IndexScanTopNTest, LookupEdgeIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(3 * parts.size(), resp.get_data()->rows.size());
+    EXPECT_EQ(3, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kSrc, "col1", "col2"};
-    expected.rows.emplace_back(nebula::Row({"17", 17, "row_17"}));
     expected.rows.emplace_back(nebula::Row({"15", 15, "row_15"}));
     expected.rows.emplace_back(nebula::Row({"16", 16, "row_16"}));
-    expected.rows.emplace_back(nebula::Row({"22", 22, "row_22"}));
-    expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"21", 21, "row_21"}));
-    expected.rows.emplace_back(nebula::Row({"32", 32, "row_32"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"31", 31, "row_31"}));
-    expected.rows.emplace_back(nebula::Row({"42", 42, "row_42"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"41", 41, "row_41"}));
-    expected.rows.emplace_back(nebula::Row({"52", 52, "row_52"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"51", 51, "row_51"}));
-    expected.rows.emplace_back(nebula::Row({"62", 62, "row_62"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
-    expected.rows.emplace_back(nebula::Row({"61", 61, "row_61"}));
+    expected.rows.emplace_back(nebula::Row({"17", 17, "row_17"}));
     verifyResult(expected, *resp.get_data());
   }
 
-  // limit 3 by each part through IndexScanNode->DataNode->FilterNode
+  // limit 3 of all parts through IndexScanNode->DataNode->FilterNode
   {
     nebula::storage::cpp2::OrderBy orderBy;
     orderBy.prop_ref() = "col1";
@@ -530,26 +477,13 @@ TEST_F(IndexScanTopNTest, LookupEdgeIndexTopN) {
     processor->process(req);
     auto resp = std::move(fut).get();
     EXPECT_EQ(0, resp.result.failed_parts.size());
-    EXPECT_EQ(3 * parts.size() - 2, resp.get_data()->rows.size());
+    EXPECT_EQ(3, resp.get_data()->rows.size());
 
     nebula::DataSet expected;
     expected.colNames = {kSrc, "col1", "col2"};
-    expected.rows.emplace_back(nebula::Row({"18", 18, "row_18"}));
     expected.rows.emplace_back(nebula::Row({"16", 16, "row_16"}));
-    expected.rows.emplace_back(nebula::Row({"24", 24, "row_24"}));
+    expected.rows.emplace_back(nebula::Row({"18", 18, "row_18"}));
     expected.rows.emplace_back(nebula::Row({"20", 20, "row_20"}));
-    expected.rows.emplace_back(nebula::Row({"22", 22, "row_22"}));
-    expected.rows.emplace_back(nebula::Row({"34", 34, "row_34"}));
-    expected.rows.emplace_back(nebula::Row({"30", 30, "row_30"}));
-    expected.rows.emplace_back(nebula::Row({"32", 32, "row_32"}));
-    expected.rows.emplace_back(nebula::Row({"44", 44, "row_44"}));
-    expected.rows.emplace_back(nebula::Row({"40", 40, "row_40"}));
-    expected.rows.emplace_back(nebula::Row({"42", 42, "row_42"}));
-    expected.rows.emplace_back(nebula::Row({"54", 54, "row_54"}));
-    expected.rows.emplace_back(nebula::Row({"50", 50, "row_50"}));
-    expected.rows.emplace_back(nebula::Row({"52", 52, "row_52"}));
-    expected.rows.emplace_back(nebula::Row({"62", 62, "row_62"}));
-    expected.rows.emplace_back(nebula::Row({"60", 60, "row_60"}));
     verifyResult(expected, *resp.get_data());
   }
 }
@@ -575,6 +575,75 @@ TEST_F(IndexScanTest, Vertex) {
   }  // End of Case 2
 }
 
+TEST_F(IndexScanTest, KeyFilter) {
+  auto rows = R"(
+    int | int
+    1   | 2
+    2   | 3
+    3   | 4
+  )"_row;
+  auto schema = R"(
+    a   | int | | false
+    b   | int | | false
+  )"_schema;
+  auto indices = R"(
+    TAG(t,1)
+    (i1,2):a
+  )"_index(schema);
+  bool hasNullableCol = schema->hasNullableCol();
+  auto kv = encodeTag(rows, 1, schema, indices);
+  auto kvstore = std::make_unique<MockKVStore>();
+  for (auto& item : kv[1]) {
+    kvstore->put(item.first, item.second);
+  }
+  // The base data of the first row is missing, which is fatal if it's fetched
+  for (auto iter = std::next(kv[0].begin()); iter != kv[0].end(); iter++) {
+    kvstore->put(iter->first, iter->second);
+  }
+  ::nebula::ObjectPool pool;
+  auto expr = RelationalExpression::makeGE(&pool,
+                                           TagPropertyExpression::make(&pool, "t", "a"),
+                                           ConstantExpression::make(&pool, Value(2)));
+  std::vector<ColumnHint> columnHints;
+  auto context = makeContext(1, 0);
+  auto scanNode = std::make_unique<IndexVertexScanNode>(
+      context.get(), 0, columnHints, kvstore.get(), hasNullableCol);
+  ASSERT_TRUE(IndexScanNode::coveredByKey(*indices[0], {"a", kVid}));
+  ASSERT_FALSE(IndexScanNode::coveredByKey(*indices[0], {"a", "b"}));
+  scanNode->setKeyFilter(expr);
+  IndexScanTestHelper helper;
+  helper.setIndex(scanNode.get(), indices[0]);
+  helper.setTag(scanNode.get(), schema);
+  helper.setFatal(scanNode.get(), true);
+  InitContext initCtx;
+  initCtx.requiredColumns = {kVid, "b"};
+  scanNode->init(initCtx);
+  scanNode->execute(0);
+
+  std::vector<Row> result;
+  while (true) {
+    auto res = scanNode->next();
+    ASSERT(res.success());
+    if (!res.hasData()) {
+      break;
+    }
+    result.emplace_back(std::move(res).row());
+  }
+  auto expect = R"(
+    string | int
+    1   | 3
+    2   | 4
+  )"_row;
+  std::vector<std::string> colOrder = {kVid, "b"};
+  ASSERT_EQ(result.size(), expect.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(result[i].size(), expect[i].size());
+    for (size_t j = 0; j < expect[i].size(); j++) {
+      ASSERT_EQ(expect[i][j], result[i][initCtx.retColMap[colOrder[j]]]);
+    }
+  }
+}
+
 TEST_F(IndexScanTest, Edge) {
   auto rows = R"(
     int | int | int
@@ -3415,6 +3484,101 @@ TEST_F(IndexScanScalarType, Geography) {
   }
 }
 
+TEST_F(IndexScanTest, MultiRange) {
+  auto rows = R"(
+    int | int
+    1   | 2
+    2   | 3
+    3   | 4
+    4   | 5
+    5   | 6
+  )"_row;
+  auto schema = R"(
+    a   | int | | false
+    b   | int | | false
+  )"_schema;
+  auto indices = R"(
+    TAG(t,1)
+    (i1,2):a
+  )"_index(schema);
+  bool hasNullableCol = schema->hasNullableCol();
+  auto kv = encodeTag(rows, 1, schema, indices);
+  auto kvstore = std::make_unique<MockKVStore>();
+  for (auto& iter : kv) {
+    for (auto& item : iter) {
+      kvstore->put(item.first, item.second);
+    }
+  }
+  auto check = [&](const std::vector<std::vector<ColumnHint>>& ranges,
+                   const std::vector<std::string>& requiredColumns,
+                   const std::vector<Row>& expect,
+                   const std::string& case_) {
+    auto context = makeContext(1, 0);
+    auto scanNode = std::make_unique<IndexVertexScanNode>(
+        context.get(), 0, ranges.front(), kvstore.get(), hasNullableCol);
+    for (size_t i = 1; i < ranges.size(); i++) {
+      scanNode->addColumnHints(ranges[i]);
+    }
+    IndexScanTestHelper helper;
+    helper.setIndex(scanNode.get(), indices[0]);
+    helper.setTag(scanNode.get(), schema);
+    helper.setFatal(scanNode.get(), true);
+    InitContext initCtx;
+    initCtx.requiredColumns = Set<std::string>(requiredColumns.begin(), requiredColumns.end());
+    scanNode->init(initCtx);
+    scanNode->execute(0);
+    std::vector<Row> result;
+    while (true) {
+      auto res = scanNode->next();
+      ASSERT(res.success());
+      if (!res.hasData()) {
+        break;
+      }
+      result.emplace_back(std::move(res).row());
+    }
+    ASSERT_EQ(result.size(), expect.size()) << "Fail at case " << case_;
+    for (size_t i = 0; i < result.size(); i++) {
+      ASSERT_EQ(result[i].size(), expect[i].size());
+      for (size_t j = 0; j < expect[i].size(); j++) {
+        ASSERT_EQ(expect[i][j], result[i][initCtx.retColMap[requiredColumns[j]]])
+            << "Fail at case " << case_;
+      }
+    }
+  };
+  // a IN (4, 1), the ranges are scanned in the order of the keys
+  std::vector<std::vector<ColumnHint>> disjoint{{makeColumnHint("a", Value(4))},
+                                                {makeColumnHint("a", Value(1))}};
+  check(disjoint, {kVid}, R"(
+    string
+    0
+    3
+  )"_row, "disjoint");
+  check(disjoint, {kVid, "b"}, R"(
+    string | int
+    0      | 2
+    3      | 5
+  )"_row, "disjoint with base");
+  // 1<=a<=3 OR a==2 OR 2<=a<=4, the rows of the overlapped keys are returned once
+  std::vector<std::vector<ColumnHint>> overlapped{
+      {makeColumnHint<true, true>("a", Value(1), Value(3))},
+      {makeColumnHint("a", Value(2))},
+      {makeColumnHint<true, true>("a", Value(2), Value(4))}};
+  check(overlapped, {kVid}, R"(
+    string
+    0
+    1
+    2
+    3
+  )"_row, "overlapped");
+  check(overlapped, {kVid, "b"}, R"(
+    string | int
+    0      | 2
+    1      | 3
+    2      | 4
+    3      | 5
+  )"_row, "overlapped with base");
+}
+
 TEST_F(IndexScanTest, Compound) {
   // TODO(hs.zhang): add unittest
 }
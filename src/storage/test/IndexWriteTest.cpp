@@ -8,13 +8,17 @@
 
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
+#include "common/time/WallClock.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "common/utils/OperationKeyUtils.h"
 #include "interface/gen-cpp2/common_types.h"
 #include "interface/gen-cpp2/storage_types.h"
 #include "mock/AdHocIndexManager.h"
 #include "mock/AdHocSchemaManager.h"
 #include "mock/MockCluster.h"
 #include "mock/MockData.h"
+#include "storage/StorageFlags.h"
+#include "storage/index/AsyncIndexApplier.h"
 #include "storage/index/LookupProcessor.h"
 #include "storage/mutate/AddEdgesProcessor.h"
 #include "storage/mutate/AddVerticesProcessor.h"
@@ -482,6 +486,77 @@ TEST(IndexTest, AlterTagIndexTest) {
   }
 }
 
+TEST(IndexTest, AsyncVerticesTest) {
+  fs::TempDir rootPath("/tmp/AsyncVerticesTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(1).value();
+  FLAGS_async_index_names = "index_3";
+
+  auto insert = [&](int64_t colInt) {
+    cpp2::AddVerticesRequest req;
+    req.space_id_ref() = 1;
+    for (auto partId = 1; partId <= 6; partId++) {
+      nebula::storage::cpp2::NewVertex newVertex;
+      nebula::storage::cpp2::NewTag newTag;
+      newTag.tag_id_ref() = 3;
+      std::vector<Value> props;
+      props.emplace_back(Value(true));
+      props.emplace_back(Value(colInt));
+      props.emplace_back(Value(1.1f));
+      props.emplace_back(Value(1.1f));
+      props.emplace_back(Value("string"));
+      props.emplace_back(Value(1L));
+      props.emplace_back(Value(1L));
+      props.emplace_back(Value(1L));
+      props.emplace_back(Value(1L));
+      props.emplace_back(Value(Date(2020, 2, 20)));
+      props.emplace_back(Value(DateTime(2020, 2, 20, 10, 30, 45, 0)));
+      newTag.props_ref() = std::move(props);
+      newVertex.id_ref() = convertVertexId(vIdLen, partId);
+      newVertex.tags_ref() = {std::move(newTag)};
+      (*req.parts_ref())[partId].emplace_back(std::move(newVertex));
+    }
+    auto* processor = AddVerticesProcessor::instance(env, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, resp.result.failed_parts.size());
+  };
+  auto check = [&](int64_t pendingNum, int64_t indexNum) {
+    for (auto partId = 1; partId <= 6; partId++) {
+      auto pendingPrefix = OperationKeyUtils::pendingIndexPrefix(partId);
+      EXPECT_EQ(pendingNum, verifyResultNum(1, partId, pendingPrefix, env->kvstore_));
+      auto indexPrefix = IndexKeyUtils::indexPrefix(partId, 3);
+      EXPECT_EQ(indexNum, verifyResultNum(1, partId, indexPrefix, env->kvstore_));
+    }
+  };
+
+  // The entries are not written by the inserts, but by the applier
+  insert(1);
+  insert(2);
+  check(1, 0);
+  AsyncIndexApplier applier(env);
+  for (auto partId = 1; partId <= 6; partId++) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, applier.applyPart(1, partId));
+    EXPECT_EQ(0, env->getAsyncIndexWatermark(1, partId));
+  }
+  check(0, 1);
+
+  // The entries of the old rows are removed, and the watermark passes the inserts
+  auto before = time::WallClock::fastNowInMicroSec();
+  insert(3);
+  check(1, 1);
+  for (auto partId = 1; partId <= 6; partId++) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, applier.applyPart(1, partId));
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, applier.applyPart(1, partId));
+    EXPECT_LT(before, env->getAsyncIndexWatermark(1, partId));
+  }
+  check(0, 1);
+  FLAGS_async_index_names = "";
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "common/base/Base.h"
 #include "common/utils/MemoryLockWrapper.h"
 
@@ -122,6 +124,57 @@ TEST_F(MemoryLockTest, DedupTest) {
   EXPECT_EQ(0, mlock.size());
 }
 
+TEST_F(MemoryLockTest, WaitTest) {
+  MemoryLockCore<std::string> mlock;
+  std::vector<std::string> keys{"2", "1"};
+  {
+    // The waiter locks the key after the holder unlocks it
+    auto* lk1 = new LockGuard(&mlock, "1");
+    std::thread unlocker([lk1] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      delete lk1;
+    });
+    LockGuard lk2(&mlock, keys, std::chrono::milliseconds(10000));
+    EXPECT_TRUE(lk2);
+    EXPECT_TRUE(lk2.waited());
+    unlocker.join();
+    EXPECT_EQ(2, mlock.size());
+  }
+  EXPECT_EQ(0, mlock.size());
+  {
+    // The keys locked are unlocked after the wait times out
+    LockGuard lk1(&mlock, "1");
+    LockGuard lk2(&mlock, keys, std::chrono::milliseconds(10));
+    EXPECT_FALSE(lk2);
+    EXPECT_EQ("1", lk2.conflictKey());
+    EXPECT_EQ(1, mlock.size());
+  }
+  EXPECT_EQ(0, mlock.size());
+  EXPECT_EQ(2, mlock.numConflicts());
+  EXPECT_EQ(1, mlock.numTimeouts());
+}
+
+TEST_F(MemoryLockTest, ConcurrentWaitTest) {
+  MemoryLockCore<std::string> mlock;
+  int64_t count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1000; j++) {
+        LockGuard lk(&mlock, std::vector<std::string>{"hot", "1"}, std::chrono::seconds(60));
+        ASSERT_TRUE(lk);
+        ++count;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(8000, count);
+  EXPECT_EQ(0, mlock.numTimeouts());
+  EXPECT_EQ(0, mlock.size());
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -14,6 +14,8 @@
 #include "mock/MockCluster.h"
 
 DEFINE_int64(vertex_per_part, 100, "vertex count with each partition");
+DEFINE_int32(edge_types, 10, "edge type count of each vertex");
+DEFINE_int32(edges_per_type, 10, "edge count of each edge type of a vertex");
 
 namespace nebula {
 namespace storage {
@@ -64,6 +66,79 @@ void testPrefixSeek(StorageEnv* env, int32_t partCount, int32_t iters) {
   }
 }
 
+// Each vertex has FLAGS_edge_types types of edges
+void mockEdgeData(StorageEnv* env, int32_t partCount) {
+  LOG(INFO) << "Prepare edge data...";
+  size_t vIdLen = 16;
+  GraphSpaceID spaceId = 1;
+  for (PartitionID partId = 1; partId <= partCount; partId++) {
+    std::vector<kvstore::KV> data;
+    for (int32_t vertexId = partId * FLAGS_vertex_per_part;
+         vertexId < (partId + 1) * FLAGS_vertex_per_part;
+         vertexId++) {
+      for (EdgeType edgeType = 1; edgeType <= FLAGS_edge_types; edgeType++) {
+        for (int32_t dst = 0; dst < FLAGS_edges_per_type; dst++) {
+          auto key = NebulaKeyUtils::edgeKey(
+              vIdLen, partId, std::to_string(vertexId), edgeType, 0, std::to_string(dst));
+          data.emplace_back(std::move(key), folly::stringPrintf("%d_%d", vertexId, dst));
+        }
+      }
+    }
+    folly::Baton<true, std::atomic> baton;
+    env->kvstore_->asyncMultiPut(
+        spaceId, partId, std::move(data), [&](nebula::cpp2::ErrorCode code) {
+          ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+          baton.post();
+          folly::doNotOptimizeAway(code);
+        });
+    baton.wait();
+    ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, env->kvstore_->flush(spaceId));
+  }
+}
+
+// Seek the edges of a type of each vertex, as GetNeighbors of an edge type
+void testEdgePrefixSeek(StorageEnv* env, int32_t partCount, int32_t iters) {
+  size_t vIdLen = 16;
+  GraphSpaceID spaceId = 1;
+  for (decltype(iters) i = 0; i < iters; i++) {
+    for (PartitionID partId = 1; partId <= partCount; partId++) {
+      for (int32_t vertexId = partId * FLAGS_vertex_per_part;
+           vertexId < (partId + 1) * FLAGS_vertex_per_part;
+           vertexId++) {
+        // Half of the seeks are of a type which the vertex doesn't have
+        EdgeType edgeType = (vertexId % 2 == 0) ? 1 : FLAGS_edge_types + 1;
+        auto prefix =
+            NebulaKeyUtils::edgePrefix(vIdLen, partId, std::to_string(vertexId), edgeType);
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto code = env->kvstore_->prefix(spaceId, partId, prefix, &iter);
+        ASSERT_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
+        while (iter->valid()) {
+          folly::doNotOptimizeAway(iter->val());
+          iter->next();
+        }
+      }
+    }
+  }
+}
+
+void runEdgePrefixSeek(int32_t iters, const std::string& edgeTypePrefixSpaces) {
+  folly::BenchmarkSuspender braces;
+  FLAGS_rocksdb_column_family_options = R"({
+        "level0_file_num_compaction_trigger":"100"
+    })";
+  FLAGS_enable_rocksdb_prefix_filtering = true;
+  FLAGS_rocksdb_edge_type_prefix_filter_spaces = edgeTypePrefixSpaces;
+  FLAGS_rocksdb_block_cache = 0;
+  fs::TempDir rootPath("/tmp/GetPropTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto partCount = cluster.getTotalParts();
+  auto* env = cluster.storageEnv_.get();
+  mockEdgeData(env, partCount);
+  braces.dismiss();
+  testEdgePrefixSeek(env, partCount, iters);
+}
+
 BENCHMARK(PrefixWithFilterOff, n) {
   folly::BenchmarkSuspender braces;
   FLAGS_rocksdb_column_family_options = R"({
@@ -97,6 +172,16 @@ BENCHMARK_RELATIVE(PrefixWithFilterOn, n) {
   testPrefixSeek(env, partCount, n);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(EdgePrefixWithVertexFilter, n) {
+  runEdgePrefixSeek(n, "");
+}
+
+BENCHMARK_RELATIVE(EdgePrefixWithEdgeTypeFilter, n) {
+  runEdgePrefixSeek(n, "1");
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -6,9 +6,13 @@
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 
+#include <thread>
+
 #include "codec/RowReaderWrapper.h"
 #include "common/base/Base.h"
+#include "common/expression/ArithmeticExpression.h"
 #include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
 #include "common/fs/TempDir.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "mock/MockCluster.h"
@@ -1480,6 +1484,140 @@ TEST(UpdateVertexTest, Upsert_Field_Type_And_Value_Match_Test) {
   EXPECT_EQ("America", val.getStr());
 }
 
+// The updates of a vertex at the same time are coalesced, each reading the one before it
+TEST(UpdateVertexTest, Coalesced_Update_Test) {
+  fs::TempDir rootPath("/tmp/UpdateVertexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  env->updateCoalescer_ = std::make_unique<UpdateCoalescer>(env->kvstore_);
+  auto parts = cluster.getTotalParts();
+
+  GraphSpaceID spaceId = 1;
+  TagID tagId = 1;
+  auto status = env->schemaMan_->getSpaceVidLen(spaceId);
+  ASSERT_TRUE(status.ok());
+  auto spaceVidLen = status.value();
+
+  EXPECT_TRUE(mockVertexData(env, parts, spaceVidLen));
+
+  auto partId = std::hash<std::string>()("Tim Duncan") % parts + 1;
+  VertexID vertexId("Tim Duncan");
+  auto readAge = [&]() {
+    auto prefix = NebulaKeyUtils::tagPrefix(spaceVidLen, partId, vertexId, tagId);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = env->kvstore_->prefix(spaceId, partId, prefix, &iter);
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, ret);
+    EXPECT_TRUE(iter && iter->valid());
+    auto reader =
+        RowReaderWrapper::getTagPropReader(env->schemaMan_, spaceId, tagId, iter->val());
+    return reader->getValueByName("age").getInt();
+  };
+  auto age = readAge();
+
+  // player.age = player.age + 1, returning the age updated
+  cpp2::UpdateVertexRequest req;
+  req.space_id_ref() = spaceId;
+  req.part_id_ref() = partId;
+  req.vertex_id_ref() = vertexId;
+  req.tag_id_ref() = tagId;
+  cpp2::UpdatedProp uProp;
+  uProp.name_ref() = "age";
+  const auto& incr = *ArithmeticExpression::makeAdd(pool,
+                                                    SourcePropertyExpression::make(pool, "1", "age"),
+                                                    ConstantExpression::make(pool, 1L));
+  uProp.value_ref() = Expression::encode(incr);
+  req.updated_props_ref() = {uProp};
+  const auto& ageProp = *SourcePropertyExpression::make(pool, "1", "age");
+  req.return_props_ref() = {Expression::encode(ageProp)};
+  req.insertable_ref() = false;
+
+  constexpr int32_t kThreads = 8;
+  constexpr int32_t kUpdates = 20;
+  std::vector<std::vector<int64_t>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < kThreads; i++) {
+    threads.emplace_back([&, i] {
+      for (int32_t j = 0; j < kUpdates; j++) {
+        auto* processor = UpdateVertexProcessor::instance(env, nullptr);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+        ASSERT_EQ(1, (*resp.props_ref()).rows.size());
+        results[i].emplace_back((*resp.props_ref()).rows[0].values[1].getInt());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Each update saw the ones before it, and the result of its own
+  std::set<int64_t> ages;
+  for (const auto& result : results) {
+    ages.insert(result.begin(), result.end());
+  }
+  EXPECT_EQ(static_cast<size_t>(kThreads * kUpdates), ages.size());
+  EXPECT_EQ(age + 1, *ages.begin());
+  EXPECT_EQ(age + kThreads * kUpdates, *ages.rbegin());
+  EXPECT_EQ(age + kThreads * kUpdates, readAge());
+}
+
+// Exposes the props collected by the node
+class CollectedUpdateNode final : public UpdateNode<VertexID> {
+ public:
+  CollectedUpdateNode(std::vector<cpp2::UpdatedProp>& updatedProps,
+                      StorageExpressionContext* expCtx)
+      : UpdateNode<VertexID>(nullptr, {}, updatedProps, nullptr, false, {}, expCtx, false) {}
+
+  using UpdateNode<VertexID>::props_;
+};
+
+TEST(UpdateVertexTest, Mutate_In_Place_Test) {
+  std::vector<cpp2::UpdatedProp> updatedProps;
+  StorageExpressionContext expCtx(8, false);
+  CollectedUpdateNode node(updatedProps, &expCtx);
+  // The context shares the collection of the prop, as collected by the node
+  node.props_["likes"] = Value(List({1, 2}));
+  expCtx.setTagProp("player", "likes", node.props_["likes"]);
+  const auto* likes = &node.props_["likes"].getList();
+
+  auto append = [](Expression* prop, Value value) {
+    return FunctionCallExpression::make(
+        pool, "listAppend", {prop, ConstantExpression::make(pool, std::move(value))});
+  };
+  {
+    // player.likes = listAppend(player.likes, 3)
+    auto* exp = append(SourcePropertyExpression::make(pool, "player", "likes"), 3);
+    EXPECT_TRUE(node.mutateInPlace("player", Expression::Kind::kSrcProperty, "likes", exp));
+    EXPECT_EQ(likes, &node.props_["likes"].getList());
+    EXPECT_EQ(Value(List({1, 2, 3})), node.props_["likes"]);
+    EXPECT_EQ(Value(List({1, 2, 3})), expCtx.getTagProp("player", "likes"));
+  }
+  {
+    // The prop of another tag, or an edge, is not the one updated
+    auto* exp = append(SourcePropertyExpression::make(pool, "team", "likes"), 4);
+    EXPECT_FALSE(node.mutateInPlace("player", Expression::Kind::kSrcProperty, "likes", exp));
+    exp = append(EdgePropertyExpression::make(pool, "player", "likes"), 4);
+    EXPECT_FALSE(node.mutateInPlace("player", Expression::Kind::kSrcProperty, "likes", exp));
+    exp = append(SourcePropertyExpression::make(pool, "player", "name"), 4);
+    EXPECT_FALSE(node.mutateInPlace("player", Expression::Kind::kSrcProperty, "likes", exp));
+    EXPECT_EQ(Value(List({1, 2, 3})), node.props_["likes"]);
+    EXPECT_EQ(Value(List({1, 2, 3})), expCtx.getTagProp("player", "likes"));
+  }
+  {
+    // A mutation not applied leaves both untouched
+    auto* exp = FunctionCallExpression::make(pool,
+                                             "listRemoveAt",
+                                             {SourcePropertyExpression::make(pool, "player", "likes"),
+                                              ConstantExpression::make(pool, "a")});
+    EXPECT_FALSE(node.mutateInPlace("player", Expression::Kind::kSrcProperty, "likes", exp));
+    EXPECT_EQ(likes, &node.props_["likes"].getList());
+    EXPECT_EQ(Value(List({1, 2, 3})), expCtx.getTagProp("player", "likes"));
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
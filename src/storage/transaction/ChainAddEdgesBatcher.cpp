@@ -0,0 +1,108 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/transaction/ChainAddEdgesBatcher.h"
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "storage/StorageFlags.h"
+#include "storage/transaction/ChainAddEdgesLocalProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+folly::SemiFuture<Code> ChainAddEdgesBatcher::add(cpp2::AddEdgesRequest req,
+                                                  PartitionID localPart,
+                                                  PartitionID remotePart) {
+  std::vector<std::string> keys;
+  for (const auto& edge : req.get_parts().begin()->second) {
+    keys.emplace_back(apache::thrift::CompactSerializer::serialize<std::string>(edge.get_key()));
+  }
+
+  auto key = std::make_tuple(req.get_space_id(), localPart, remotePart);
+  folly::SemiFuture<Code> future = folly::SemiFuture<Code>::makeEmpty();
+  std::optional<Batch> next;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& state = pairs_[key];
+    if (state.queue.empty() || !mergeable(state.queue.back(), req, keys)) {
+      state.queue.emplace_back();
+      state.queue.back().req = std::move(req);
+      state.queue.back().keys.insert(keys.begin(), keys.end());
+    } else {
+      auto& batch = state.queue.back();
+      auto& edges = (*batch.req.parts_ref())[localPart];
+      auto& more = (*req.parts_ref())[localPart];
+      edges.insert(
+          edges.end(), std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+      batch.keys.insert(keys.begin(), keys.end());
+    }
+    state.queue.back().promises.emplace_back();
+    future = state.queue.back().promises.back().getSemiFuture();
+    if (state.running < FLAGS_toss_chain_pipeline_depth) {
+      ++state.running;
+      next = std::move(state.queue.front());
+      state.queue.pop_front();
+    }
+  }
+  if (next.has_value()) {
+    run(key, std::move(next).value());
+  }
+  return future;
+}
+
+bool ChainAddEdgesBatcher::mergeable(const Batch& batch,
+                                     const cpp2::AddEdgesRequest& req,
+                                     const std::vector<std::string>& keys) {
+  if (batch.req.get_prop_names() != req.get_prop_names() ||
+      batch.req.get_if_not_exists() != req.get_if_not_exists() ||
+      batch.keys.size() + keys.size() > static_cast<size_t>(FLAGS_toss_batch_max_edges)) {
+    return false;
+  }
+  return std::none_of(
+      keys.begin(), keys.end(), [&batch](const auto& k) { return batch.keys.count(k) != 0; });
+}
+
+void ChainAddEdgesBatcher::run(const PairKey& key, Batch batch) {
+  auto* proc = ChainAddEdgesLocalProcessor::instance(env_);
+  proc->setRemotePartId(std::get<2>(key));
+  proc->getFuture().thenTry(
+      [this, key, promises = std::move(batch.promises)](auto&& t) mutable {
+        auto code = Code::SUCCEEDED;
+        if (t.hasException()) {
+          code = Code::E_UNKNOWN;
+        } else if (!t.value().get_result().get_failed_parts().empty()) {
+          code = t.value().get_result().get_failed_parts().begin()->get_code();
+        }
+        for (auto& promise : promises) {
+          promise.setValue(code);
+        }
+        done(key);
+      });
+  proc->process(batch.req);
+}
+
+void ChainAddEdgesBatcher::done(const PairKey& key) {
+  std::optional<Batch> next;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto iter = pairs_.find(key);
+    auto& state = iter->second;
+    if (state.queue.empty()) {
+      if (--state.running == 0) {
+        pairs_.erase(iter);
+      }
+    } else {
+      next = std::move(state.queue.front());
+      state.queue.pop_front();
+    }
+  }
+  if (next.has_value()) {
+    run(key, std::move(next).value());
+  }
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_TRANSACTION_CHAINADDEDGESBATCHER_H
+#define STORAGE_TRANSACTION_CHAINADDEDGESBATCHER_H
+
+#include <folly/futures/Future.h>
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+
+#include "interface/gen-cpp2/storage_types.h"
+#include "storage/CommonUtils.h"
+#include "storage/transaction/ChainBaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief ChainAddEdgesBatcher merges the chain add edges of the same local part and remote part.
+ *
+ * Each chain writes the prime, calls the remote and commits, three round trips of raft and rpc,
+ * which toss_chain_pipeline_depth chains of a pair of parts run at the same time. The requests
+ * coming while the chains of their pair are all running are queued, and each queued batch runs
+ * as one chain, so the stages are paid once per batch rather than once per request. A batch has
+ * no edge twice, as a chain fails to lock an edge it has already locked, and its requests share
+ * the result of the chain.
+ */
+class ChainAddEdgesBatcher final {
+ public:
+  explicit ChainAddEdgesBatcher(StorageEnv* env) : env_(env) {}
+
+  /**
+   * @brief Add the edges of req, all of localPart, whose in-edges are of remotePart
+   */
+  folly::SemiFuture<Code> add(cpp2::AddEdgesRequest req,
+                              PartitionID localPart,
+                              PartitionID remotePart);
+
+ private:
+  using PairKey = std::tuple<GraphSpaceID, PartitionID, PartitionID>;
+
+  struct Batch {
+    cpp2::AddEdgesRequest req;
+    // The serialized edge keys of req
+    std::unordered_set<std::string> keys;
+    std::vector<folly::Promise<Code>> promises;
+  };
+
+  struct PairState {
+    int32_t running{0};
+    std::list<Batch> queue;
+  };
+
+  // Whether the edges of req could be merged into batch
+  static bool mergeable(const Batch& batch,
+                        const cpp2::AddEdgesRequest& req,
+                        const std::vector<std::string>& keys);
+
+  void run(const PairKey& key, Batch batch);
+
+  // Called once a chain of key is done, the next batch is run if any
+  void done(const PairKey& key);
+
+  StorageEnv* env_{nullptr};
+  std::mutex lock_;
+  std::unordered_map<PairKey, PairState> pairs_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif
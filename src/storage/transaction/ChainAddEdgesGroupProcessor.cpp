@@ -15,33 +15,38 @@ namespace nebula {
 namespace storage {
 
 void ChainAddEdgesGroupProcessor::process(const cpp2::AddEdgesRequest& req) {
-  // toss is turned off
-  for (const auto& partEntry : req.get_parts()) {
-    pushResultCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED, partEntry.first);
+  if (!FLAGS_enable_toss) {
+    // toss is turned off
+    for (const auto& partEntry : req.get_parts()) {
+      pushResultCode(nebula::cpp2::ErrorCode::E_UNSUPPORTED, partEntry.first);
+    }
+    onFinished();
+    return;
   }
-  onFinished();
-  /*
   auto space = req.get_space_id();
   ShuffledReq shuffledReq;
   shuffleRequest(req, shuffledReq);
+  if (shuffledReq.empty()) {
+    // the parts number of the space is not found
+    for (const auto& partEntry : req.get_parts()) {
+      pushResultCode(nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND, partEntry.first);
+    }
+    onFinished();
+    return;
+  }
 
   callingNum_ = shuffledReq.size();
 
+  // The chains of the same parts of the concurrent requests are merged by the batcher
   auto delegateProcess = [&](auto& item) {
     auto localPartId = item.first.first;
-    auto* proc = ChainAddEdgesLocalProcessor::instance(env_);
-    proc->setRemotePartId(item.first.second);
-    proc->getFuture().thenValue([=](auto&& resp) {
-      auto code = resp.get_result().get_failed_parts().empty()
-                      ? nebula::cpp2::ErrorCode::SUCCEEDED
-                      : resp.get_result().get_failed_parts().begin()->get_code();
-      handleAsync(space, localPartId, code);
-    });
-    proc->process(item.second);
+    env_->txnMan_->addEdgesBatcher()
+        ->add(std::move(item.second), localPartId, item.first.second)
+        .toUnsafeFuture()
+        .thenValue([=](auto&& code) { handleAsync(space, localPartId, code); });
   };
 
   std::for_each(shuffledReq.begin(), shuffledReq.end(), delegateProcess);
-  */
 }
 
 void ChainAddEdgesGroupProcessor::shuffleRequest(const cpp2::AddEdgesRequest& req,
@@ -20,7 +20,7 @@ namespace storage {
 DEFINE_int32(resume_interval_secs, 10, "Resume interval");
 DEFINE_int32(toss_worker_num, 16, "Resume interval");
 
-TransactionManager::TransactionManager(StorageEnv* env) : env_(env) {
+TransactionManager::TransactionManager(StorageEnv* env) : env_(env), addEdgesBatcher_(env) {
   LOG(INFO) << "TransactionManager ctor()";
   worker_ = std::make_shared<folly::IOThreadPoolExecutor>(FLAGS_toss_worker_num);
   controller_ = std::make_shared<folly::IOThreadPoolExecutor>(1);
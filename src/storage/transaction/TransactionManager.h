@@ -19,6 +19,7 @@
 #include "kvstore/KVStore.h"
 #include "kvstore/Part.h"
 #include "storage/CommonUtils.h"
+#include "storage/transaction/ChainAddEdgesBatcher.h"
 #include "storage/transaction/ConsistUtil.h"
 
 namespace nebula {
@@ -57,6 +58,13 @@ class TransactionManager {
    */
   void addChainTask(ChainBaseProcessor* proc);
 
+  /**
+   * @brief the batcher merging the chain add edges of the same parts into fewer chains
+   */
+  ChainAddEdgesBatcher* addEdgesBatcher() {
+    return &addEdgesBatcher_;
+  }
+
   /**
    * @brief Get the Lock Core object to set a memory lock for a key.
    *
@@ -155,6 +163,8 @@ class TransactionManager {
   folly::ConcurrentHashMap<SpacePart, TermID> currTerm_;
 
   folly::ConcurrentHashMap<SpacePart, TermID> prevTerms_;
+
+  ChainAddEdgesBatcher addEdgesBatcher_;
 };
 
 }  // namespace storage
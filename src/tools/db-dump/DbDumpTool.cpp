@@ -24,10 +24,13 @@ optional:
          A list of meta severs' ip:port separated by comma.
          Default: 127.0.0.1:45500
 
-       --mode= scan | stat
+       --mode= scan | stat | export
          scan: print to screen when records meet the condition, and also print statistics
                to screen in final.
          stat: print statistics to screen.
+         export: export the records meeting the condition into csv files under output_dir,
+               <output_dir>/tag_<name>/<part>.csv and <output_dir>/edge_<name>/<part>.csv,
+               by dump_threads threads. The limit is ignored.
          Default: scan
 
        --vids=<list of vid>
@@ -49,6 +52,17 @@ optional:
          Would output all if set 0 or negative number.
          Default: 1000
 
+       --output_dir=<path>
+         The directory to export into, in the export mode.
+
+       --dump_threads=<N>
+         The parts exported simultaneously, in the export mode.
+         Default: 8
+
+       --props=<list of prop name>
+         A list of prop names separated by comma to export, in the export mode.
+         Would export all props if it is not given.
+
 
 )");
 }
@@ -64,6 +78,11 @@ void printParams() {
   std::cout << "tags: " << FLAGS_tags << "\n";
   std::cout << "edges: " << FLAGS_edges << "\n";
   std::cout << "limit: " << FLAGS_limit << "\n";
+  if (FLAGS_mode == "export") {
+    std::cout << "output dir: " << FLAGS_output_dir << "\n";
+    std::cout << "dump threads: " << FLAGS_dump_threads << "\n";
+    std::cout << "props: " << FLAGS_props << "\n";
+  }
   std::cout << "===========================PARAMS============================\n\n";
 }
 
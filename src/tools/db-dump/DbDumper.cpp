@@ -18,10 +18,35 @@ DEFINE_string(vids, "", "A list of vertex ids separated by comma.");
 DEFINE_string(tags, "", "A list of tag name separated by comma.");
 DEFINE_string(edges, "", "A list of edge name separated by comma.");
 DEFINE_int64(limit, 1000, "Limit to output.");
+DEFINE_string(output_dir, "", "The directory of the csv files exported, in the export mode.");
+DEFINE_int32(dump_threads, 8, "The parts exported simultaneously, in the export mode.");
+DEFINE_string(props, "", "A list of prop names to export separated by comma, all by default.");
 
 namespace nebula {
 namespace storage {
 
+namespace {
+
+std::string csvField(const Value& value) {
+  if (value.isNull() || value.empty()) {
+    return "";
+  }
+  if (!value.isStr()) {
+    return value.toString();
+  }
+  std::string field = "\"";
+  for (auto c : value.getStr()) {
+    if (c == '"') {
+      field.push_back('"');
+    }
+    field.push_back(c);
+  }
+  field.push_back('"');
+  return field;
+}
+
+}  // namespace
+
 Status DbDumper::init() {
   auto status = initMeta();
   if (!status.ok()) {
@@ -109,6 +134,7 @@ Status DbDumper::initParams() {
     }
     folly::splitTo<std::string>(',', FLAGS_tags, std::inserter(tags, tags.begin()), true);
     folly::splitTo<std::string>(',', FLAGS_edges, std::inserter(edges, edges.begin()), true);
+    folly::splitTo<std::string>(',', FLAGS_props, std::inserter(props_, props_.begin()), true);
   } catch (const std::exception& e) {
     return Status::Error("Parse parts/vertexIds/tags/edges error: %s", e.what());
   }
@@ -128,9 +154,13 @@ Status DbDumper::initParams() {
     edgeTypes_.emplace(edgeType.value());
   }
 
-  if (FLAGS_mode.compare("scan") != 0 && FLAGS_mode.compare("stat") != 0) {
+  if (FLAGS_mode.compare("scan") != 0 && FLAGS_mode.compare("stat") != 0 &&
+      FLAGS_mode.compare("export") != 0) {
     return Status::Error("Unknown mode '%s'.", FLAGS_mode.c_str());
   }
+  if (FLAGS_mode == "export" && !fs::FileUtils::makeDir(FLAGS_output_dir)) {
+    return Status::Error("Unable to make the output dir '%s'.", FLAGS_output_dir.c_str());
+  }
   return Status::OK();
 }
 
@@ -167,6 +197,10 @@ bool DbDumper::isValidVidLen(VertexID vid) {
 }
 
 void DbDumper::run() {
+  if (FLAGS_mode == "export") {
+    exportParts();
+    return;
+  }
   time::Duration dur;
   auto noPrint = [](const folly::StringPiece& key) -> bool {
     UNUSED(key);
@@ -417,6 +451,177 @@ void DbDumper::run() {
   std::cout << "Time cost: " << dur.elapsedInUSec() << " us\n\n";
 }
 
+void DbDumper::exportParts() {
+  time::Duration dur;
+  std::vector<PartitionID> parts(parts_.begin(), parts_.end());
+  if (parts.empty()) {
+    for (PartitionID partId = 1; partId <= partNum_; ++partId) {
+      parts.emplace_back(partId);
+    }
+  }
+  // The read only db is shared by the threads, each iterates its own parts
+  std::atomic<size_t> next{0};
+  auto threadNum = std::min(static_cast<size_t>(std::max(FLAGS_dump_threads, 1)), parts.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadNum; ++i) {
+    threads.emplace_back([this, &parts, &next] {
+      for (auto idx = next++; idx < parts.size(); idx = next++) {
+        auto status = exportPart(parts[idx]);
+        if (!status.ok()) {
+          std::cerr << "Export part " << parts[idx] << " failed: " << status << "\n";
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  std::cout << "===========================STATISTICS============================\n";
+  std::cout << "VERTEX COUNT: " << exportedVertices_ << "\n";
+  std::cout << "EDGE COUNT: " << exportedEdges_ << "\n";
+  std::cout << "============================STATISTICS===========================\n";
+  std::cout << "Time cost: " << dur.elapsedInUSec() << " us\n\n";
+}
+
+Status DbDumper::exportPart(PartitionID partId) {
+  // Only the tags are exported if only the tags are given, and so are the edges
+  bool exportVertices = !tagIds_.empty() || edgeTypes_.empty();
+  bool exportEdges = !edgeTypes_.empty() || tagIds_.empty();
+  std::unordered_map<TagID, ExportFile> tagFiles;
+  std::unordered_map<EdgeType, ExportFile> edgeFiles;
+
+  if (exportVertices) {
+    auto prefix = NebulaKeyUtils::tagPrefix(partId);
+    auto it = db_->NewIterator(rocksdb::ReadOptions());
+    it->Seek(rocksdb::Slice(prefix));
+    auto prefixIt = std::make_unique<kvstore::RocksPrefixIter>(it, prefix);
+    for (; prefixIt->valid(); prefixIt->next()) {
+      auto key = prefixIt->key();
+      if (!NebulaKeyUtils::isTag(spaceVidLen_, key)) {
+        continue;
+      }
+      auto tagId = NebulaKeyUtils::getTagId(spaceVidLen_, key);
+      auto vid = NebulaKeyUtils::getVertexId(spaceVidLen_, key);
+      if ((!tagIds_.empty() && !tagIds_.count(tagId)) ||
+          (!vids_.empty() && !vids_.count(trimVertexId(vid).str()))) {
+        continue;
+      }
+      auto file = tagFiles.find(tagId);
+      if (file == tagFiles.end()) {
+        file = tagFiles.emplace(tagId, ExportFile()).first;
+        auto status = openExportFile(true, tagId, partId, &file->second);
+        if (!status.ok()) {
+          return status;
+        }
+      }
+      auto reader =
+          RowReaderWrapper::getTagPropReader(schemaMng_.get(), spaceId_, tagId, prefixIt->val());
+      if (!reader) {
+        std::cerr << "Can't get tag reader of " << tagId << "\n";
+        continue;
+      }
+      auto& out = file->second.out;
+      out << csvField(getVertexId(trimVertexId(vid)));
+      for (const auto& prop : file->second.props) {
+        out << ',' << csvField(reader->getValueByName(prop));
+      }
+      out << '\n';
+      ++exportedVertices_;
+    }
+  }
+
+  if (exportEdges) {
+    auto prefix = NebulaKeyUtils::edgePrefix(partId);
+    auto it = db_->NewIterator(rocksdb::ReadOptions());
+    it->Seek(rocksdb::Slice(prefix));
+    auto prefixIt = std::make_unique<kvstore::RocksPrefixIter>(it, prefix);
+    for (; prefixIt->valid(); prefixIt->next()) {
+      auto key = prefixIt->key();
+      if (!NebulaKeyUtils::isEdge(spaceVidLen_, key)) {
+        continue;
+      }
+      // The reverse edges are duplicates of the out edges
+      auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
+      auto src = NebulaKeyUtils::getSrcId(spaceVidLen_, key);
+      if (edgeType < 0 || (!edgeTypes_.empty() && !edgeTypes_.count(edgeType)) ||
+          (!vids_.empty() && !vids_.count(trimVertexId(src).str()))) {
+        continue;
+      }
+      auto file = edgeFiles.find(edgeType);
+      if (file == edgeFiles.end()) {
+        file = edgeFiles.emplace(edgeType, ExportFile()).first;
+        auto status = openExportFile(false, edgeType, partId, &file->second);
+        if (!status.ok()) {
+          return status;
+        }
+      }
+      auto reader = RowReaderWrapper::getEdgePropReader(
+          schemaMng_.get(), spaceId_, edgeType, prefixIt->val());
+      if (!reader) {
+        std::cerr << "Can't get edge reader of " << edgeType << "\n";
+        continue;
+      }
+      auto& out = file->second.out;
+      auto dst = NebulaKeyUtils::getDstId(spaceVidLen_, key);
+      out << csvField(getVertexId(trimVertexId(src))) << ','
+          << csvField(getVertexId(trimVertexId(dst))) << ','
+          << NebulaKeyUtils::getRank(spaceVidLen_, key);
+      for (const auto& prop : file->second.props) {
+        out << ',' << csvField(reader->getValueByName(prop));
+      }
+      out << '\n';
+      ++exportedEdges_;
+    }
+  }
+
+  for (auto& file : tagFiles) {
+    file.second.out.close();
+  }
+  for (auto& file : edgeFiles) {
+    file.second.out.close();
+  }
+  return Status::OK();
+}
+
+Status DbDumper::openExportFile(bool isTag,
+                                int32_t schemaId,
+                                PartitionID partId,
+                                ExportFile* file) {
+  // A directory for each tag or edge, with a file for each part
+  auto dir = isTag ? folly::sformat("{}/tag_{}", FLAGS_output_dir, getTagName(schemaId))
+                   : folly::sformat("{}/edge_{}", FLAGS_output_dir, getEdgeName(schemaId));
+  {
+    std::lock_guard<std::mutex> guard(dirLock_);
+    if (!fs::FileUtils::makeDir(dir)) {
+      return Status::Error("Unable to make the dir '%s'.", dir.c_str());
+    }
+  }
+  auto schema = isTag ? schemaMng_->getTagSchema(spaceId_, schemaId)
+                      : schemaMng_->getEdgeSchema(spaceId_, schemaId);
+  if (schema == nullptr) {
+    return Status::Error("Schema %d not found.", schemaId);
+  }
+  for (size_t i = 0; i < schema->getNumFields(); ++i) {
+    std::string name = schema->getFieldName(i);
+    if (props_.empty() || props_.count(name)) {
+      file->props.emplace_back(std::move(name));
+    }
+  }
+
+  auto path = folly::sformat("{}/{}.csv", dir, partId);
+  file->out.open(path, std::ios::out | std::ios::trunc);
+  if (!file->out.is_open()) {
+    return Status::Error("Unable to open '%s'.", path.c_str());
+  }
+  file->out << (isTag ? "vid" : "src,dst,rank");
+  for (const auto& prop : file->props) {
+    file->out << ',' << prop;
+  }
+  file->out << '\n';
+  return Status::OK();
+}
+
 void DbDumper::seekToFirst() {
   const auto it = db_->NewIterator(rocksdb::ReadOptions());
   it->SeekToFirst();
@@ -574,6 +779,14 @@ std::string DbDumper::getEdgeName(const EdgeType edgeType) {
   }
 }
 
+folly::StringPiece DbDumper::trimVertexId(const folly::StringPiece& vidStr) {
+  if (spaceVidType_ == nebula::cpp2::PropertyType::INT64) {
+    return vidStr;
+  }
+  auto end = vidStr.find('\0');
+  return end == folly::StringPiece::npos ? vidStr : vidStr.subpiece(0, end);
+}
+
 Value DbDumper::getVertexId(const folly::StringPiece& vidStr) {
   if (spaceVidType_ == nebula::cpp2::PropertyType::INT64) {
     int64_t val;
@@ -8,6 +8,8 @@
 
 #include <rocksdb/db.h>
 
+#include <fstream>
+
 #include "clients/meta/MetaClient.h"
 #include "codec/RowReaderWrapper.h"
 #include "common/base/Base.h"
@@ -24,6 +26,9 @@ DECLARE_string(vids);
 DECLARE_string(tags);
 DECLARE_string(edges);
 DECLARE_int64(limit);
+DECLARE_string(output_dir);
+DECLARE_int32(dump_threads);
+DECLARE_string(props);
 
 namespace nebula {
 namespace storage {
@@ -67,6 +72,23 @@ class DbDumper {
 
   Value getVertexId(const folly::StringPiece& vidStr);
 
+  // The vid in the key without the padding of the fixed string vid
+  folly::StringPiece trimVertexId(const folly::StringPiece& vidStr);
+
+  // A csv file of the tag or the edge in a part, whose columns are the key and the projected
+  // props of the latest schema
+  struct ExportFile {
+    std::ofstream out;
+    std::vector<std::string> props;
+  };
+
+  // Export the parts by dump_threads threads, each pulls the next part when it's done
+  void exportParts();
+
+  Status exportPart(PartitionID partId);
+
+  Status openExportFile(bool isTag, int32_t schemaId, PartitionID partId, ExportFile* file);
+
  private:
   std::unique_ptr<rocksdb::DB> db_;
   rocksdb::Options options_;
@@ -80,6 +102,7 @@ class DbDumper {
   std::unordered_set<VertexID> vids_;
   std::unordered_set<TagID> tagIds_;
   std::unordered_set<EdgeType> edgeTypes_;
+  std::unordered_set<std::string> props_;
   std::vector<std::function<bool(const folly::StringPiece&)>> beforePrintVertex_;
   std::vector<std::function<bool(const folly::StringPiece&)>> beforePrintEdge_;
 
@@ -89,6 +112,9 @@ class DbDumper {
   int64_t count_{0};
   int64_t vertexCount_{0};
   int64_t edgeCount_{0};
+  std::atomic<int64_t> exportedVertices_{0};
+  std::atomic<int64_t> exportedEdges_{0};
+  std::mutex dirLock_;
 };
 
 }  // namespace storage
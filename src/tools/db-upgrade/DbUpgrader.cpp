@@ -5,6 +5,10 @@
 
 #include "tools/db-upgrade/DbUpgrader.h"
 
+#include <folly/FileUtil.h>
+
+#include <fstream>
+
 #include "common/datatypes/Value.h"
 #include "common/fs/FileUtils.h"
 #include "common/utils/IndexKeyUtils.h"
@@ -35,6 +39,10 @@ DEFINE_bool(compactions,
             "whether to compact data");
 DEFINE_uint32(max_concurrent_parts, 10, "The parts could be processed simultaneously");
 DEFINE_uint32(max_concurrent_spaces, 5, "The spaces could be processed simultaneously");
+DEFINE_uint32(upgrade_sst_batch_num, 100000, "The records written into a sst file to ingest");
+DEFINE_bool(upgrade_resume,
+            true,
+            "Skip the parts upgraded by the last run, which are recorded in the data path");
 
 namespace nebula {
 namespace storage {
@@ -107,6 +115,10 @@ Status UpgraderSpace::initSpace(const std::string& sId) {
     return ret;
   }
 
+  if (FLAGS_upgrade_resume && FLAGS_upgrade_version == "2:3") {
+    loadFinishedParts(readEngine_.get());
+  }
+
   pool_ = std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_max_concurrent_parts);
   // Parallel process part
   for (auto& partId : parts_) {
@@ -910,37 +922,9 @@ void UpgraderSpace::runPartV3() {
       }
       return;
     }
-    int64_t ingestFileCount = 0;
-    auto write_sst = [&, this](const std::vector<kvstore::KV>& data) {
-      ::rocksdb::Options option;
-      option.create_if_missing = true;
-      option.compression = ::rocksdb::CompressionType::kNoCompression;
-      ::rocksdb::SstFileWriter sst_file_writer(::rocksdb::EnvOptions(), option);
-      std::string file = ::fmt::format(".nebula_upgrade.space-{}.part-{}-{}-{}.sst",
-                                       spaceId_,
-                                       partId,
-                                       ingestFileCount++,
-                                       std::time(nullptr));
-      ::rocksdb::Status s = sst_file_writer.Open(file);
-      if (!s.ok()) {
-        LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
-                   << s.code();
-      }
-      for (auto item : data) {
-        s = sst_file_writer.Put(item.first, item.second);
-        if (!s.ok()) {
-          LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
-                     << s.code();
-        }
-      }
-      s = sst_file_writer.Finish();
-      if (!s.ok()) {
-        LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
-                   << s.code();
-      }
-      std::lock_guard<std::mutex> lck(this->ingest_sst_file_mut_);
-      ingest_sst_file_.push_back(file);
-    };
+    time::Duration partDuration;
+    int64_t keys = 0;
+    std::vector<std::string> files;
     std::vector<kvstore::KV> data;
     std::string lastVertexKey = "";
     while (iter && iter->valid()) {
@@ -951,18 +935,33 @@ void UpgraderSpace::runPartV3() {
       }
       data.emplace_back(vertex, "");
       lastVertexKey = vertex;
-      if (data.size() >= 100000) {
-        write_sst(data);
+      if (data.size() >= FLAGS_upgrade_sst_batch_num) {
+        keys += data.size();
+        files.emplace_back(writeSstFile(readEngine_.get(), partId, data));
         data.clear();
       }
       iter->next();
     }
     if (!data.empty()) {
-      write_sst(data);
+      keys += data.size();
+      files.emplace_back(writeSstFile(readEngine_.get(), partId, data));
       data.clear();
     }
+    // The files of a part are ingested once it's done, so the parts are ingested in parallel and
+    // the part is upgraded for good before it's recorded
+    if (!files.empty()) {
+      auto code = readEngine_->ingest(files, true);
+      if (code != ::nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(FATAL) << "Failed to upgrade 2:3 when ingest sst file of space " << spaceId_
+                   << ", part " << partId << ":" << static_cast<int>(code);
+      }
+      for (const auto& file : files) {
+        fs::FileUtils::remove(file.c_str());
+      }
+    }
     LOG(INFO) << "Handle vertex/edge/index data in space id " << spaceId_ << " part id " << partId
               << " succeed";
+    finishPart(readEngine_.get(), partId, keys, partDuration);
 
     auto unFinishedPart = --unFinishedPart_;
     if (unFinishedPart == 0) {
@@ -978,6 +977,12 @@ void UpgraderSpace::runPartV3() {
 }
 void UpgraderSpace::doProcessV3() {
   LOG(INFO) << "Start to handle data in space id " << spaceId_;
+  // The files left by an interrupted run belong to the parts not recorded, which are redone
+  auto sstDir = folly::sformat("{}/upgrade_sst", readEngine_->getDataRoot());
+  if (fs::FileUtils::exist(sstDir)) {
+    fs::FileUtils::remove(sstDir.c_str(), true);
+  }
+  spaceDuration_.reset();
   // Parallel process part
   auto partConcurrency = std::min(static_cast<size_t>(FLAGS_max_concurrent_parts), parts_.size());
   LOG(INFO) << "Max concurrent parts: " << partConcurrency;
@@ -992,13 +997,96 @@ void UpgraderSpace::doProcessV3() {
     sleep(10);
   }
 
-  if (ingest_sst_file_.size() != 0) {
-    auto code = readEngine_->ingest(ingest_sst_file_, true);
-    if (code != ::nebula::cpp2::ErrorCode::SUCCEEDED) {
-      LOG(FATAL) << "Failed to upgrade 2:3 when ingest sst file:" << static_cast<int>(code);
+  readEngine_->put(NebulaKeyUtils::dataVersionKey(), NebulaKeyUtilsV3::dataVersionValue());
+  auto secs = std::max(spaceDuration_.elapsedInSec(), static_cast<uint64_t>(1));
+  LOG(INFO) << "Upgrade space id " << spaceId_ << " " << upgradedKeys_ << " keys in " << secs
+            << "s, " << upgradedKeys_ / secs << " keys/s";
+}
+
+std::string UpgraderSpace::writeSstFile(kvstore::RocksEngine* engine,
+                                        PartitionID partId,
+                                        std::vector<kvstore::KV>& data) {
+  // The files are written on the disk of the engine, so the ingestion doesn't cross the disks
+  auto dir = folly::sformat("{}/upgrade_sst", engine->getDataRoot());
+  if (!fs::FileUtils::makeDir(dir)) {
+    LOG(FATAL) << "makeDir " << dir << " failed";
+  }
+  std::sort(data.begin(), data.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+  ::rocksdb::Options option;
+  option.create_if_missing = true;
+  option.compression = ::rocksdb::CompressionType::kNoCompression;
+  ::rocksdb::SstFileWriter sst_file_writer(::rocksdb::EnvOptions(), option);
+  std::string file = ::fmt::format(
+      "{}/space-{}.part-{}-{}-{}.sst", dir, spaceId_, partId, sstFileNum_++, std::time(nullptr));
+  ::rocksdb::Status s = sst_file_writer.Open(file);
+  if (!s.ok()) {
+    LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
+               << s.code();
+  }
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (i > 0 && data[i].first == data[i - 1].first) {
+      continue;
+    }
+    s = sst_file_writer.Put(data[i].first, data[i].second);
+    if (!s.ok()) {
+      LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
+                 << s.code();
+    }
+  }
+  s = sst_file_writer.Finish();
+  if (!s.ok()) {
+    LOG(FATAL) << "Failed to upgrade V3 of space " << spaceId_ << ", part " << partId << ":"
+               << s.code();
+  }
+  return file;
+}
+
+std::string UpgraderSpace::finishedPartsFile(kvstore::RocksEngine* engine) const {
+  return folly::sformat("{}/upgrade_finished_parts", engine->getDataRoot());
+}
+
+void UpgraderSpace::loadFinishedParts(kvstore::RocksEngine* engine) {
+  auto path = finishedPartsFile(engine);
+  std::string content;
+  if (!fs::FileUtils::exist(path) || !folly::readFile(path.c_str(), content)) {
+    return;
+  }
+  std::unordered_set<PartitionID> finished;
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', content, lines, true);
+  for (auto line : lines) {
+    auto partId = folly::tryTo<PartitionID>(line);
+    if (partId.hasValue()) {
+      finished.emplace(partId.value());
     }
   }
-  readEngine_->put(NebulaKeyUtils::dataVersionKey(), NebulaKeyUtilsV3::dataVersionValue());
+  auto total = parts_.size();
+  parts_.erase(std::remove_if(parts_.begin(),
+                              parts_.end(),
+                              [&finished](auto partId) { return finished.count(partId) > 0; }),
+               parts_.end());
+  LOG(INFO) << "Space id " << spaceId_ << " resumes with " << parts_.size() << " of " << total
+            << " parts to upgrade";
+}
+
+void UpgraderSpace::finishPart(kvstore::RocksEngine* engine,
+                               PartitionID partId,
+                               int64_t keys,
+                               const time::Duration& duration) {
+  upgradedKeys_ += keys;
+  {
+    std::lock_guard<std::mutex> guard(finishedPartsLock_);
+    std::ofstream out(finishedPartsFile(engine), std::ios::out | std::ios::app);
+    out << partId << "\n";
+    if (!out.good()) {
+      LOG(ERROR) << "Record the part " << partId << " of space id " << spaceId_ << " failed";
+    }
+  }
+  auto secs = std::max(duration.elapsedInSec(), static_cast<uint64_t>(1));
+  LOG(INFO) << "Upgrade space id " << spaceId_ << " part id " << partId << " " << keys
+            << " keys in " << duration.elapsedInSec() << "s, " << keys / secs << " keys/s";
 }
 std::vector<std::string> UpgraderSpace::indexVertexKeys(
     PartitionID partId,
@@ -17,6 +17,7 @@
 #include "common/base/Status.h"
 #include "common/meta/ServerBasedIndexManager.h"
 #include "common/meta/ServerBasedSchemaManager.h"
+#include "common/time/Duration.h"
 #include "kvstore/RocksEngine.h"
 
 DECLARE_string(src_db_path);
@@ -27,6 +28,8 @@ DECLARE_string(upgrade_version);
 DECLARE_bool(compactions);
 DECLARE_uint32(max_concurrent_parts);
 DECLARE_uint32(max_concurrent_spaces);
+DECLARE_uint32(upgrade_sst_batch_num);
+DECLARE_bool(upgrade_resume);
 
 namespace nebula {
 namespace storage {
@@ -118,6 +121,23 @@ class UpgraderSpace {
 
   void runPartV3();
 
+  // Write the sorted records into a sst file under the data root of engine, return its path
+  std::string writeSstFile(kvstore::RocksEngine* engine,
+                           PartitionID partId,
+                           std::vector<kvstore::KV>& data);
+
+  // The file of the parts upgraded in the data root of engine, one part id a line
+  std::string finishedPartsFile(kvstore::RocksEngine* engine) const;
+
+  // Skip the parts upgraded by the last run, so an interrupted upgrade resumes
+  void loadFinishedParts(kvstore::RocksEngine* engine);
+
+  // Record the part upgraded and log the throughput
+  void finishPart(kvstore::RocksEngine* engine,
+                  PartitionID partId,
+                  int64_t keys,
+                  const time::Duration& duration);
+
  public:
   // Source data path
   std::string srcPath_;
@@ -167,8 +187,13 @@ class UpgraderSpace {
 
   std::atomic<size_t> unFinishedPart_;
 
-  std::mutex ingest_sst_file_mut_;
-  std::vector<std::string> ingest_sst_file_;
+  std::atomic<int64_t> sstFileNum_{0};
+
+  // For the throughput of the space
+  time::Duration spaceDuration_;
+  std::atomic<int64_t> upgradedKeys_{0};
+
+  std::mutex finishedPartsLock_;
 };
 
 // Upgrade one data path in storage conf
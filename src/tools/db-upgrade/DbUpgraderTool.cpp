@@ -60,6 +60,15 @@ required:
        --max_concurrent_spaces<N>
          Maximum number of concurrent spaces allowed.
          Default: 5
+
+       --upgrade_sst_batch_num=<N>
+         The records written into a sst file, which is ingested when its part is done.
+         Default: 100000
+
+       --upgrade_resume=<true|false>
+         Skip the parts upgraded by the last run, which are recorded in
+         <data path>/nebula/<space id>/upgrade_finished_parts.
+         Default: true
 )");
 }
 
@@ -75,6 +84,8 @@ void printParams() {
   std::cout << "maximum number of concurrent parts allowed:" << FLAGS_max_concurrent_parts << "\n";
   std::cout << "maximum number of concurrent spaces allowed: " << FLAGS_max_concurrent_spaces
             << "\n";
+  std::cout << "The records of a sst file: " << FLAGS_upgrade_sst_batch_num << "\n";
+  std::cout << "whether to resume: " << (FLAGS_upgrade_resume ? "true" : "false") << "\n";
   std::cout << "===========================PARAMS============================\n\n";
 }
 
@@ -0,0 +1,498 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include <random>
+#include <unordered_set>
+
+#include "common/base/Base.h"
+#include "common/network/NetworkUtils.h"
+#include "common/stats/LatencyHistogram.h"
+#include "common/thrift/ThriftClientManager.h"
+#include "common/time/Duration.h"
+#include "interface/gen-cpp2/GraphServiceAsyncClient.h"
+
+DEFINE_string(graph_addr, "127.0.0.1:9669", "The address of the graphd to query");
+DEFINE_string(user, "root", "The user to login");
+DEFINE_string(password, "nebula", "The password of the user");
+DEFINE_int32(io_threads, 4, "Client io threads");
+DEFINE_int32(client_timeout_ms, 60000, "The timeout of a query");
+DEFINE_int32(concurrency, 16, "The number of the sessions querying concurrently");
+
+DEFINE_string(space_name, "ldbc_snb_perf", "The space to load the dataset in");
+DEFINE_int32(partition_num, 10, "The partition number of the space");
+DEFINE_int32(replica_factor, 1, "The replica factor of the space");
+DEFINE_bool(load, true, "Create the space and load the dataset before running the workloads");
+DEFINE_bool(drop_space, false, "Drop the space after running the workloads");
+DEFINE_int32(schema_wait_secs, 20, "Wait for the schema to be synchronized by the heartbeats");
+DEFINE_int64(persons, 10000, "The number of the persons, i.e. the scale of the dataset");
+DEFINE_int32(avg_knows, 20, "The average number of the persons a person knows");
+DEFINE_int32(posts_per_person, 5, "The number of the posts created by a person");
+DEFINE_int32(batch_size, 200, "The number of the vertices or edges in an insert when loading");
+DEFINE_int64(seed, 20230101, "The seed of the random generator, to make the run reproducible");
+
+DEFINE_string(workloads,
+              "go,go2,match,find_path,lookup,insert",
+              "The workloads to run in turn, separated by comma");
+DEFINE_int32(warmup_secs, 5, "The seconds to run a workload before measuring it");
+DEFINE_int32(duration_secs, 30, "The seconds to measure a workload");
+
+namespace nebula {
+
+/**
+ * @brief QueryPerf loads a social network in the style of the LDBC SNB interactive workload into a
+ * running cluster, and measures the throughput and the latency percentiles of a suite of queries
+ * sent to graphd by concurrent sessions.
+ *
+ * The dataset is generated by the seed, so two runs of the same flags load the same graph and send
+ * the same queries, and their results are comparable.
+ *
+ *   Person(firstName, lastName, gender, birthday, creationDate)
+ *   Post(content, length, creationDate)
+ *   Person -[KNOWS(creationDate)]-> Person, which are mostly in the same community
+ *   Person -[LIKES(creationDate)]-> Post
+ *   Post -[HAS_CREATOR]-> Person
+ */
+class QueryPerf final {
+ public:
+  int run() {
+    auto hostRet = network::NetworkUtils::toHosts(FLAGS_graph_addr);
+    if (!hostRet.ok() || hostRet.value().size() != 1) {
+      LOG(ERROR) << "Invalid graph_addr " << FLAGS_graph_addr;
+      return EXIT_FAILURE;
+    }
+    host_ = hostRet.value().front();
+    ioThreadPool_ = std::make_shared<folly::IOThreadPoolExecutor>(FLAGS_io_threads);
+    clientsMan_ = std::make_unique<ClientManager>();
+    nextPost_ = firstPost() + numPosts();
+
+    for (int32_t i = 0; i < FLAGS_concurrency; i++) {
+      auto* evb = ioThreadPool_->getEventBase();
+      auto sessionRet = authenticate(evb);
+      if (!sessionRet.ok()) {
+        LOG(ERROR) << "Failed to authenticate: " << sessionRet.status();
+        return EXIT_FAILURE;
+      }
+      sessions_.emplace_back(evb, sessionRet.value());
+    }
+
+    if (FLAGS_load) {
+      auto status = createSchema();
+      if (!status.ok()) {
+        LOG(ERROR) << "Failed to create the schema: " << status;
+        return EXIT_FAILURE;
+      }
+    }
+    for (auto& [evb, sessionId] : sessions_) {
+      auto status = execute(evb, sessionId, "USE " + FLAGS_space_name);
+      if (!status.ok()) {
+        LOG(ERROR) << "Failed to use the space: " << status;
+        return EXIT_FAILURE;
+      }
+    }
+    if (FLAGS_load) {
+      auto status = load();
+      if (!status.ok()) {
+        LOG(ERROR) << "Failed to load the dataset: " << status;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::vector<std::string> workloads;
+    folly::split(",", FLAGS_workloads, workloads, true);
+    std::vector<std::string> reports;
+    for (auto& workload : workloads) {
+      if (!isWorkload(workload)) {
+        LOG(ERROR) << "Unknown workload " << workload;
+        return EXIT_FAILURE;
+      }
+      reports.emplace_back(runWorkload(workload));
+    }
+
+    if (FLAGS_drop_space) {
+      auto& [evb, sessionId] = sessions_.front();
+      auto status = execute(evb, sessionId, "DROP SPACE " + FLAGS_space_name);
+      LOG_IF(ERROR, !status.ok()) << "Failed to drop the space: " << status;
+    }
+    for (auto& [evb, sessionId] : sessions_) {
+      signout(evb, sessionId);
+    }
+
+    std::cout << folly::stringPrintf("%-12s %10s %10s %10s %10s %10s %10s %10s\n",
+                                     "workload",
+                                     "qps",
+                                     "errors",
+                                     "avg(us)",
+                                     "p50(us)",
+                                     "p90(us)",
+                                     "p99(us)",
+                                     "p999(us)");
+    for (auto& report : reports) {
+      std::cout << report;
+    }
+    return EXIT_SUCCESS;
+  }
+
+ private:
+  using Session = std::pair<folly::EventBase*, int64_t>;
+  using ClientManager = thrift::ThriftClientManager<graph::cpp2::GraphServiceAsyncClient>;
+
+  StatusOr<int64_t> authenticate(folly::EventBase* evb) {
+    auto future = folly::via(evb, [this, evb]() {
+      auto client = clientsMan_->client(host_, evb, false, FLAGS_client_timeout_ms);
+      return client->future_authenticate(FLAGS_user, FLAGS_password);
+    });
+    auto t = std::move(future).getTry();
+    if (t.hasException()) {
+      return Status::Error("%s", t.exception().what().c_str());
+    }
+    auto& resp = t.value();
+    if (resp.errorCode != ErrorCode::SUCCEEDED || resp.sessionId == nullptr) {
+      return Status::Error("%s", resp.errorMsg != nullptr ? resp.errorMsg->c_str() : "");
+    }
+    return *resp.sessionId;
+  }
+
+  void signout(folly::EventBase* evb, int64_t sessionId) {
+    folly::via(evb, [this, evb, sessionId]() {
+      auto client = clientsMan_->client(host_, evb, false, FLAGS_client_timeout_ms);
+      client->signout(sessionId);
+    }).wait();
+  }
+
+  // Execute the statement in the session, and wait for the response in the calling thread
+  Status execute(folly::EventBase* evb, int64_t sessionId, const std::string& stmt) {
+    auto future = folly::via(evb, [this, evb, sessionId, &stmt]() {
+      auto client = clientsMan_->client(host_, evb, false, FLAGS_client_timeout_ms);
+      return client->future_execute(sessionId, stmt);
+    });
+    auto t = std::move(future).getTry();
+    if (t.hasException()) {
+      return Status::Error("%s", t.exception().what().c_str());
+    }
+    auto& resp = t.value();
+    if (resp.errorCode != ErrorCode::SUCCEEDED) {
+      return Status::Error("%s: %s",
+                           getErrorCode(resp.errorCode),
+                           resp.errorMsg != nullptr ? resp.errorMsg->c_str() : "");
+    }
+    return Status::OK();
+  }
+
+  Status createSchema() {
+    auto& [evb, sessionId] = sessions_.front();
+    std::vector<std::string> stmts = {
+        folly::stringPrintf("CREATE SPACE IF NOT EXISTS %s(partition_num=%d, replica_factor=%d, "
+                            "vid_type=INT64)",
+                            FLAGS_space_name.c_str(),
+                            FLAGS_partition_num,
+                            FLAGS_replica_factor),
+        "USE " + FLAGS_space_name,
+        "CREATE TAG IF NOT EXISTS Person(firstName string, lastName string, gender string, "
+        "birthday int, creationDate int)",
+        "CREATE TAG IF NOT EXISTS Post(content string, length int, creationDate int)",
+        "CREATE EDGE IF NOT EXISTS KNOWS(creationDate int)",
+        "CREATE EDGE IF NOT EXISTS LIKES(creationDate int)",
+        "CREATE EDGE IF NOT EXISTS HAS_CREATOR()",
+        "CREATE TAG INDEX IF NOT EXISTS person_first_name ON Person(firstName(16))",
+    };
+    for (size_t i = 0; i < stmts.size(); i++) {
+      auto status = execute(evb, sessionId, stmts[i]);
+      if (!status.ok()) {
+        return status;
+      }
+      if (i == 0) {
+        // The new space is known by graphd after the heartbeat
+        std::this_thread::sleep_for(std::chrono::seconds(FLAGS_schema_wait_secs));
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(FLAGS_schema_wait_secs));
+    return Status::OK();
+  }
+
+  Status load() {
+    std::mt19937_64 rng(FLAGS_seed);
+    // The inserts of the batches of the values
+    std::vector<std::string> stmts;
+    std::string values;
+    int32_t count = 0;
+    auto flush = [&](const std::string& prefix) {
+      if (!values.empty()) {
+        values.pop_back();
+        stmts.emplace_back(prefix + values);
+        values.clear();
+      }
+      count = 0;
+    };
+    auto append = [&](const std::string& value, const std::string& prefix) {
+      values.append(value).append(",");
+      if (++count == FLAGS_batch_size) {
+        flush(prefix);
+      }
+    };
+
+    const std::string personPrefix =
+        "INSERT VERTEX Person(firstName, lastName, gender, birthday, creationDate) VALUES ";
+    for (int64_t person = 1; person <= FLAGS_persons; person++) {
+      append(folly::stringPrintf("%ld:(\"%s\", \"%s\", \"%s\", %ld, %ld)",
+                                 person,
+                                 firstName(rng).c_str(),
+                                 lastName(rng).c_str(),
+                                 rng() % 2 == 0 ? "male" : "female",
+                                 kEpoch - static_cast<int64_t>(rng() % (60 * kYear)),
+                                 creationDate(rng)),
+             personPrefix);
+    }
+    flush(personPrefix);
+
+    const std::string postPrefix = "INSERT VERTEX Post(content, length, creationDate) VALUES ";
+    for (int64_t post = firstPost(); post < firstPost() + numPosts(); post++) {
+      auto length = 10 + rng() % 200;
+      append(folly::stringPrintf("%ld:(\"%s\", %lu, %ld)",
+                                 post,
+                                 content(rng, length).c_str(),
+                                 length,
+                                 creationDate(rng)),
+             postPrefix);
+    }
+    flush(postPrefix);
+
+    const std::string creatorPrefix = "INSERT EDGE HAS_CREATOR() VALUES ";
+    for (int64_t post = firstPost(); post < firstPost() + numPosts(); post++) {
+      append(folly::stringPrintf("%ld->%ld:()", post, creatorOf(post)), creatorPrefix);
+    }
+    flush(creatorPrefix);
+
+    const std::string knowsPrefix = "INSERT EDGE KNOWS(creationDate) VALUES ";
+    const std::string likesPrefix = "INSERT EDGE LIKES(creationDate) VALUES ";
+    for (int64_t person = 1; person <= FLAGS_persons; person++) {
+      auto degree = rng() % (2 * FLAGS_avg_knows + 1);
+      for (size_t i = 0; i < degree; i++) {
+        auto friendId = friendOf(person, rng);
+        if (friendId != person) {
+          append(folly::stringPrintf("%ld->%ld:(%ld)", person, friendId, creationDate(rng)),
+                 knowsPrefix);
+        }
+      }
+    }
+    flush(knowsPrefix);
+    for (int64_t person = 1; person <= FLAGS_persons; person++) {
+      for (int32_t i = 0; i < FLAGS_posts_per_person; i++) {
+        auto post = firstPost() + static_cast<int64_t>(rng() % numPosts());
+        append(folly::stringPrintf("%ld->%ld:(%ld)", person, post, creationDate(rng)),
+               likesPrefix);
+      }
+    }
+    flush(likesPrefix);
+
+    LOG(INFO) << "Load the dataset of " << FLAGS_persons << " persons by " << stmts.size()
+              << " inserts";
+    time::Duration duration;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> failed{0};
+    Status firstError = Status::OK();
+    std::mutex lock;
+    parallel([&](folly::EventBase* evb, int64_t sessionId, size_t) {
+      for (auto i = next++; i < stmts.size(); i = next++) {
+        auto status = execute(evb, sessionId, stmts[i]);
+        if (!status.ok()) {
+          std::lock_guard<std::mutex> guard(lock);
+          if (failed++ == 0) {
+            firstError = status;
+          }
+        }
+      }
+    });
+    if (failed > 0) {
+      return Status::Error(
+          "%lu inserts failed, the first error: %s", failed.load(), firstError.toString().c_str());
+    }
+    LOG(INFO) << "Loaded in " << duration.elapsedInMSec() << " ms";
+    return Status::OK();
+  }
+
+  // Run the body in each session concurrently, and wait for all of them
+  void parallel(std::function<void(folly::EventBase*, int64_t, size_t)> body) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < sessions_.size(); i++) {
+      threads.emplace_back(
+          [&body, this, i]() { body(sessions_[i].first, sessions_[i].second, i); });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  static bool isWorkload(const std::string& workload) {
+    static const std::unordered_set<std::string> workloads = {
+        "go", "go2", "match", "find_path", "lookup", "insert"};
+    return workloads.count(workload) != 0;
+  }
+
+  std::string nextStatement(const std::string& workload, std::mt19937_64& rng) {
+    auto person = 1 + static_cast<int64_t>(rng() % FLAGS_persons);
+    if (workload == "go") {
+      return folly::stringPrintf(
+          "GO FROM %ld OVER KNOWS YIELD dst(edge) AS id, properties(edge).creationDate AS date",
+          person);
+    } else if (workload == "go2") {
+      // The friends of the friends, like IC 1
+      return folly::stringPrintf(
+          "GO 1 TO 2 STEPS FROM %ld OVER KNOWS YIELD DISTINCT dst(edge) AS id | LIMIT 1000",
+          person);
+    } else if (workload == "match") {
+      // The recent posts of the friends, like IC 2
+      return folly::stringPrintf(
+          "MATCH (p:Person)-[:KNOWS]->(f:Person)<-[:HAS_CREATOR]-(m:Post) WHERE id(p) == %ld "
+          "RETURN id(f), f.Person.firstName, id(m), m.Post.creationDate AS date "
+          "ORDER BY date DESC LIMIT 20",
+          person);
+    } else if (workload == "find_path") {
+      // The shortest path between two persons, like IC 13
+      auto other = 1 + static_cast<int64_t>(rng() % FLAGS_persons);
+      return folly::stringPrintf(
+          "FIND SHORTEST PATH FROM %ld TO %ld OVER KNOWS UPTO 4 STEPS YIELD path AS p",
+          person,
+          other);
+    } else if (workload == "lookup") {
+      return folly::stringPrintf(
+          "LOOKUP ON Person WHERE Person.firstName == \"%s\" YIELD id(vertex) AS id | LIMIT 100",
+          firstName(rng).c_str());
+    } else {
+      // A new post of the person, like IU 6
+      auto post = nextPost_++;
+      return folly::stringPrintf(
+          "INSERT VERTEX Post(content, length, creationDate) VALUES %ld:(\"%s\", 64, %ld); "
+          "INSERT EDGE HAS_CREATOR() VALUES %ld->%ld:()",
+          post,
+          content(rng, 64).c_str(),
+          creationDate(rng),
+          post,
+          person);
+    }
+  }
+
+  std::string runWorkload(const std::string& workload) {
+    LOG(INFO) << "Run the workload " << workload << " for " << FLAGS_duration_secs << " seconds";
+    stats::LatencyHistogram latencies;
+    std::atomic<int64_t> queries{0};
+    std::atomic<int64_t> errors{0};
+    std::atomic<bool> measuring{false};
+    std::atomic<bool> stopped{false};
+
+    std::thread timer([&]() {
+      std::this_thread::sleep_for(std::chrono::seconds(FLAGS_warmup_secs));
+      measuring = true;
+      std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_secs));
+      stopped = true;
+    });
+    time::Duration duration;
+    parallel([&](folly::EventBase* evb, int64_t sessionId, size_t index) {
+      std::mt19937_64 rng(FLAGS_seed + index);
+      while (!stopped) {
+        auto stmt = nextStatement(workload, rng);
+        time::Duration latency;
+        auto status = execute(evb, sessionId, stmt);
+        if (!measuring || stopped) {
+          continue;
+        }
+        if (!status.ok()) {
+          LOG_EVERY_N(WARNING, 1000) << "Failed to execute `" << stmt << "': " << status;
+          errors++;
+          continue;
+        }
+        queries++;
+        latencies.add(latency.elapsedInUSec());
+      }
+    });
+    timer.join();
+
+    auto snapshot = latencies.snapshot();
+    auto qps = static_cast<double>(queries) / FLAGS_duration_secs;
+    return folly::stringPrintf("%-12s %10.1f %10ld %10ld %10ld %10ld %10ld %10ld\n",
+                               workload.c_str(),
+                               qps,
+                               errors.load(),
+                               snapshot.count == 0 ? 0 : snapshot.sum / snapshot.count,
+                               snapshot.percentile(50),
+                               snapshot.percentile(90),
+                               snapshot.percentile(99),
+                               snapshot.percentile(99.9));
+  }
+
+  int64_t firstPost() const {
+    return FLAGS_persons + 1;
+  }
+
+  int64_t numPosts() const {
+    return FLAGS_persons * FLAGS_posts_per_person;
+  }
+
+  int64_t creatorOf(int64_t post) const {
+    return 1 + (post - firstPost()) / FLAGS_posts_per_person;
+  }
+
+  // Most of the friends are in the community of the person, the others are anywhere
+  int64_t friendOf(int64_t person, std::mt19937_64& rng) const {
+    if (rng() % 10 < 8) {
+      auto offset = static_cast<int64_t>(rng() % (2 * kCommunitySize + 1)) - kCommunitySize;
+      return std::clamp<int64_t>(person + offset, 1, FLAGS_persons);
+    }
+    return 1 + static_cast<int64_t>(rng() % FLAGS_persons);
+  }
+
+  static std::string firstName(std::mt19937_64& rng) {
+    static const std::vector<std::string> names = {
+        "Jun",  "Wei",  "Yang",  "Carmen", "Ali",    "Mahinda", "Hans", "Jose",
+        "Ivan", "John", "Maria", "Anh",    "Chen",   "Abdul",   "Lei",  "Karl",
+        "Ana",  "Otto", "Rahul", "Emma",   "Ken",    "Lin",     "Bryn", "Eli",
+        "Jie",  "Hao",  "Mario", "Ayesha", "Deepak", "Yuki",    "Omar", "Fritz"};
+    // Skewed, the latter names are more common
+    auto r = rng() % (names.size() * names.size());
+    return names[static_cast<size_t>(std::sqrt(static_cast<double>(r)))];
+  }
+
+  static std::string lastName(std::mt19937_64& rng) {
+    static const std::vector<std::string> names = {
+        "Zhang", "Wang", "Li", "Smith", "Khan", "Perera", "Muller", "Garcia",
+        "Ivanov", "Nguyen", "Silva", "Kim", "Sato", "Rossi", "Singh", "Brown"};
+    return names[rng() % names.size()];
+  }
+
+  static std::string content(std::mt19937_64& rng, size_t length) {
+    std::string ret(length, ' ');
+    for (auto& c : ret) {
+      c = 'a' + rng() % 26;
+    }
+    return ret;
+  }
+
+  static int64_t creationDate(std::mt19937_64& rng) {
+    return kEpoch + static_cast<int64_t>(rng() % (3 * kYear));
+  }
+
+  // 2010-01-01, the start of the simulation in LDBC SNB
+  static constexpr int64_t kEpoch = 1262304000;
+  static constexpr int64_t kYear = 365 * 24 * 3600;
+  static constexpr int64_t kCommunitySize = 100;
+
+  HostAddr host_;
+  std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
+  std::unique_ptr<ClientManager> clientsMan_;
+  std::vector<Session> sessions_;
+  std::atomic<int64_t> nextPost_{0};
+};
+
+}  // namespace nebula
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  nebula::QueryPerf perf;
+  return perf.run();
+}
@@ -0,0 +1,609 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "tools/sst-generator/SstGenerator.h"
+
+#include <rocksdb/sst_file_reader.h>
+
+#include <fstream>
+#include <queue>
+#include <thread>
+
+#include "codec/RowWriterV2.h"
+#include "common/fs/FileUtils.h"
+#include "common/time/Duration.h"
+#include "common/time/TimeUtils.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+DEFINE_string(space_name, "", "The space name.");
+DEFINE_string(meta_server, "127.0.0.1:45500", "Meta servers' address.");
+DEFINE_string(input, "", "A list of CSV files or directories of them separated by comma.");
+DEFINE_string(output, "", "The directory the SST files of each part are written into.");
+DEFINE_string(tag, "", "The tag of the rows, either tag or edge is given.");
+DEFINE_string(edge, "", "The edge of the rows, either tag or edge is given.");
+DEFINE_string(props, "", "The props of the columns after the vids, separated by comma.");
+DEFINE_string(delimiter, ",", "The delimiter of the columns.");
+DEFINE_bool(header, false, "Whether the first line of each file is the header.");
+DEFINE_bool(with_rank, false, "Whether the column after the src and dst of an edge is the rank.");
+DEFINE_int32(threads, 0, "The number of the workers, 0 means the number of the cores.");
+DEFINE_int32(run_buffer_mb, 256, "The size of the keys each worker sorts in memory at a time.");
+DEFINE_int32(sst_file_mb, 256, "The max size of each SST file generated.");
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+// The files are split into the ranges of at least the size, encoded in parallel
+constexpr size_t kMinRangeBytes = 64 * 1024 * 1024;
+
+// Split line by delimiter, the delimiters in the double quoted fields are kept
+std::vector<folly::StringPiece> splitLine(folly::StringPiece line, char delimiter) {
+  std::vector<folly::StringPiece> fields;
+  size_t i = 0;
+  while (i <= line.size()) {
+    if (i < line.size() && line[i] == '"') {
+      auto close = line.find('"', i + 1);
+      if (close == folly::StringPiece::npos) {
+        close = line.size();
+      }
+      fields.emplace_back(line.subpiece(i + 1, close - i - 1));
+      i = line.find(delimiter, close);
+    } else {
+      auto next = line.find(delimiter, i);
+      fields.emplace_back(line.subpiece(i, next == folly::StringPiece::npos ? next : next - i));
+      i = next;
+    }
+    if (i == folly::StringPiece::npos) {
+      break;
+    }
+    ++i;
+  }
+  return fields;
+}
+
+}  // namespace
+
+Status SstGenerator::init() {
+  auto status = initMeta();
+  if (!status.ok()) {
+    return status;
+  }
+  status = initSchema();
+  if (!status.ok()) {
+    return status;
+  }
+  return initInput();
+}
+
+Status SstGenerator::initMeta() {
+  auto addrs = network::NetworkUtils::toHosts(FLAGS_meta_server);
+  if (!addrs.ok()) {
+    return addrs.status();
+  }
+
+  auto ioExecutor = std::make_shared<folly::IOThreadPoolExecutor>(1);
+  meta::MetaClientOptions options;
+  options.skipConfig_ = true;
+  metaClient_ = std::make_unique<meta::MetaClient>(ioExecutor, std::move(addrs.value()), options);
+  if (!metaClient_->waitForMetadReady(1)) {
+    return Status::Error("Meta is not ready: '%s'.", FLAGS_meta_server.c_str());
+  }
+  schemaMng_ = std::make_unique<meta::ServerBasedSchemaManager>();
+  schemaMng_->init(metaClient_.get());
+  indexMng_ = meta::ServerBasedIndexManager::create(metaClient_.get());
+  return Status::OK();
+}
+
+Status SstGenerator::initSchema() {
+  if (FLAGS_space_name.empty()) {
+    return Status::Error("Space name is not given.");
+  }
+  auto space = schemaMng_->toGraphSpaceID(FLAGS_space_name);
+  if (!space.ok()) {
+    return Status::Error("Space '%s' not found in meta server.", FLAGS_space_name.c_str());
+  }
+  spaceId_ = space.value();
+  auto spaceVidLen = metaClient_->getSpaceVidLen(spaceId_);
+  if (!spaceVidLen.ok()) {
+    return spaceVidLen.status();
+  }
+  spaceVidLen_ = spaceVidLen.value();
+  auto vidType = metaClient_->getSpaceVidType(spaceId_);
+  if (!vidType.ok()) {
+    return vidType.status();
+  }
+  spaceVidType_ = vidType.value();
+  auto partNum = metaClient_->partsNum(spaceId_);
+  if (!partNum.ok()) {
+    return Status::Error("Get partition number from '%s' failed.", FLAGS_space_name.c_str());
+  }
+  partNum_ = partNum.value();
+
+  if (FLAGS_tag.empty() == FLAGS_edge.empty()) {
+    return Status::Error("Either tag or edge should be given.");
+  }
+  isEdge_ = !FLAGS_edge.empty();
+  schemaName_ = isEdge_ ? FLAGS_edge : FLAGS_tag;
+  if (isEdge_) {
+    auto edgeType = schemaMng_->toEdgeType(spaceId_, schemaName_);
+    if (!edgeType.ok()) {
+      return Status::Error("Edge '%s' not found in meta.", schemaName_.c_str());
+    }
+    schemaId_ = edgeType.value();
+    schema_ = schemaMng_->getEdgeSchema(spaceId_, schemaId_);
+  } else {
+    auto tagId = schemaMng_->toTagID(spaceId_, schemaName_);
+    if (!tagId.ok()) {
+      return Status::Error("Tag '%s' not found in meta.", schemaName_.c_str());
+    }
+    schemaId_ = tagId.value();
+    schema_ = schemaMng_->getTagSchema(spaceId_, schemaId_);
+  }
+  if (schema_ == nullptr) {
+    return Status::Error("Schema of '%s' not found in meta.", schemaName_.c_str());
+  }
+
+  auto indexes = isEdge_ ? indexMng_->getEdgeIndexes(spaceId_) : indexMng_->getTagIndexes(spaceId_);
+  if (!indexes.ok()) {
+    return indexes.status();
+  }
+  for (auto& index : indexes.value()) {
+    const auto& id = index->get_schema_id();
+    if ((isEdge_ ? id.get_edge_type() : id.get_tag_id()) == schemaId_) {
+      indexes_.emplace_back(index);
+    }
+  }
+
+  folly::split(',', FLAGS_props, propNames_, true);
+  for (const auto& name : propNames_) {
+    auto* prop = schema_->field(name);
+    if (prop == nullptr) {
+      return Status::Error("Prop '%s' not found in '%s'.", name.c_str(), schemaName_.c_str());
+    }
+    props_.emplace_back(prop);
+  }
+  if (FLAGS_delimiter.size() != 1) {
+    return Status::Error("The delimiter should be one character.");
+  }
+  delimiter_ = FLAGS_delimiter[0];
+  threads_ = FLAGS_threads > 0 ? FLAGS_threads : std::thread::hardware_concurrency();
+  return Status::OK();
+}
+
+Status SstGenerator::initInput() {
+  if (FLAGS_output.empty()) {
+    return Status::Error("Output is not given.");
+  }
+  std::vector<std::string> paths;
+  folly::split(',', FLAGS_input, paths, true);
+  std::vector<std::string> files;
+  for (const auto& path : paths) {
+    auto type = fs::FileUtils::fileType(path.c_str());
+    if (type == fs::FileType::DIRECTORY) {
+      auto inDir = fs::FileUtils::listAllFilesInDir(path.c_str(), true, "*.csv");
+      files.insert(files.end(), inDir.begin(), inDir.end());
+    } else if (type == fs::FileType::REGULAR) {
+      files.emplace_back(path);
+    } else {
+      return Status::Error("Input '%s' not found.", path.c_str());
+    }
+  }
+  if (files.empty()) {
+    return Status::Error("Input is not given.");
+  }
+  for (const auto& file : files) {
+    auto size = fs::FileUtils::fileSize(file.c_str());
+    auto count = std::max<size_t>(1, std::min<size_t>(size / kMinRangeBytes, threads_));
+    for (size_t i = 0; i < count; i++) {
+      ranges_.emplace_back(Range{file, size * i / count, size * (i + 1) / count});
+    }
+  }
+  return Status::OK();
+}
+
+Status SstGenerator::run() {
+  time::Duration duration;
+  // Pass 1: encode the ranges into the sorted runs of each part
+  std::vector<Buffer> buffers(threads_);
+  for (int32_t i = 0; i < threads_; i++) {
+    buffers[i].worker = i;
+  }
+  auto status = runWorkers(ranges_.size(), [this, &buffers](int32_t worker, size_t i) {
+    return encodeRange(ranges_[i], &buffers[worker]);
+  });
+  if (status.ok()) {
+    status = runWorkers(buffers.size(), [&buffers, this](int32_t, size_t i) {
+      return flushRuns(&buffers[i]);
+    });
+  }
+  if (!status.ok()) {
+    return status;
+  }
+  LOG(INFO) << "Encoded " << numRows_ << " rows into " << numKeys_ << " keys in "
+            << duration.elapsedInSec() << "s";
+
+  // Pass 2: merge the runs of each part
+  status = runWorkers(partNum_, [this](int32_t, size_t i) {
+    return mergeRuns(static_cast<PartitionID>(i + 1));
+  });
+  if (!status.ok()) {
+    return status;
+  }
+  fs::FileUtils::remove(folly::stringPrintf("%s/runs", FLAGS_output.c_str()).c_str(), true);
+  LOG(INFO) << "Generated the SST files of " << partNum_ << " parts in " << duration.elapsedInSec()
+            << "s";
+  return Status::OK();
+}
+
+Status SstGenerator::runWorkers(size_t count, std::function<Status(int32_t, size_t)> f) {
+  std::atomic<size_t> next{0};
+  std::mutex lock;
+  Status result = Status::OK();
+  std::vector<std::thread> workers;
+  for (int32_t worker = 0; worker < threads_; worker++) {
+    workers.emplace_back([&, worker] {
+      for (auto i = next++; i < count; i = next++) {
+        auto status = f(worker, i);
+        if (!status.ok()) {
+          std::lock_guard<std::mutex> guard(lock);
+          if (result.ok()) {
+            result = status;
+          }
+          // The rest are not run
+          next = count;
+          return;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return result;
+}
+
+Status SstGenerator::encodeRange(const Range& range, Buffer* buffer) {
+  std::ifstream in(range.file, std::ios::binary);
+  if (!in) {
+    return Status::Error("Open '%s' failed.", range.file.c_str());
+  }
+  std::string line;
+  if (range.begin > 0) {
+    // The line across the beginning belongs to the range before
+    in.seekg(range.begin - 1);
+    std::getline(in, line);
+  } else if (FLAGS_header) {
+    std::getline(in, line);
+  }
+  while (static_cast<size_t>(in.tellg()) < range.end && std::getline(in, line)) {
+    folly::StringPiece piece(line);
+    if (piece.endsWith('\r')) {
+      piece.pop_back();
+    }
+    if (piece.empty()) {
+      continue;
+    }
+    auto status = encodeLine(splitLine(piece, delimiter_), buffer);
+    if (!status.ok()) {
+      return Status::Error(
+          "'%s': %s, line: %s", range.file.c_str(), status.toString().c_str(), line.c_str());
+    }
+    if (buffer->bytes >= static_cast<size_t>(FLAGS_run_buffer_mb) * 1024 * 1024) {
+      status = flushRuns(buffer);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status SstGenerator::encodeLine(const std::vector<folly::StringPiece>& fields, Buffer* buffer) {
+  size_t vidColumns = isEdge_ ? (FLAGS_with_rank ? 3 : 2) : 1;
+  if (fields.size() != vidColumns + props_.size()) {
+    return Status::Error("Expect %zu columns, got %zu", vidColumns + props_.size(), fields.size());
+  }
+
+  RowWriterV2 writer(schema_.get());
+  for (size_t i = 0; i < props_.size(); i++) {
+    // The props of the empty columns are default or null
+    const auto& field = fields[vidColumns + i];
+    if (field.empty()) {
+      continue;
+    }
+    auto value = toValue(props_[i], field);
+    if (!value.ok()) {
+      return value.status();
+    }
+    auto ret = writer.setValue(propNames_[i], std::move(value).value());
+    if (ret != WriteResult::SUCCEEDED) {
+      return Status::Error("Set prop '%s' failed", propNames_[i].c_str());
+    }
+  }
+  if (writer.finish() != WriteResult::SUCCEEDED) {
+    return Status::Error("Encode the row failed");
+  }
+  auto row = std::move(writer).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(schema_.get(), row);
+  std::string indexVal;
+  if (!indexes_.empty()) {
+    auto ttl = CommonUtils::ttlValue(schema_.get(), &reader);
+    indexVal = ttl.ok() ? IndexKeyUtils::indexVal(std::move(ttl).value()) : "";
+  }
+
+  auto src = toVid(fields[0]);
+  if (!src.ok()) {
+    return src.status();
+  }
+  auto srcPart = metaClient_->partId(partNum_, src.value());
+  std::vector<std::string> indexKeys;
+  if (!isEdge_) {
+    auto key = NebulaKeyUtils::tagKey(spaceVidLen_, srcPart, src.value(), schemaId_);
+    addKey(buffer, srcPart, std::move(key), row);
+    for (const auto& index : indexes_) {
+      auto values = IndexKeyUtils::collectIndexValues(&reader, index.get(), schema_.get());
+      if (!values.ok()) {
+        return values.status();
+      }
+      auto keys = IndexKeyUtils::vertexIndexKeys(
+          spaceVidLen_, srcPart, index->get_index_id(), src.value(), std::move(values).value());
+      indexKeys.insert(indexKeys.end(), keys.begin(), keys.end());
+    }
+  } else {
+    auto dst = toVid(fields[1]);
+    if (!dst.ok()) {
+      return dst.status();
+    }
+    EdgeRanking rank = 0;
+    if (FLAGS_with_rank) {
+      auto parsed = folly::tryTo<EdgeRanking>(fields[2]);
+      if (!parsed.hasValue()) {
+        return Status::Error("Invalid rank '%s'", fields[2].str().c_str());
+      }
+      rank = parsed.value();
+    }
+    // The out-edge in the part of src, and the in-edge in the part of dst
+    auto dstPart = metaClient_->partId(partNum_, dst.value());
+    auto outKey =
+        NebulaKeyUtils::edgeKey(spaceVidLen_, srcPart, src.value(), schemaId_, rank, dst.value());
+    auto inKey =
+        NebulaKeyUtils::edgeKey(spaceVidLen_, dstPart, dst.value(), -schemaId_, rank, src.value());
+    addKey(buffer, srcPart, std::move(outKey), row);
+    addKey(buffer, dstPart, std::move(inKey), row);
+    for (const auto& index : indexes_) {
+      auto values = IndexKeyUtils::collectIndexValues(&reader, index.get(), schema_.get());
+      if (!values.ok()) {
+        return values.status();
+      }
+      auto keys = IndexKeyUtils::edgeIndexKeys(spaceVidLen_,
+                                               srcPart,
+                                               index->get_index_id(),
+                                               src.value(),
+                                               rank,
+                                               dst.value(),
+                                               std::move(values).value());
+      indexKeys.insert(indexKeys.end(), keys.begin(), keys.end());
+    }
+  }
+  for (auto& key : indexKeys) {
+    addKey(buffer, srcPart, std::move(key), indexVal);
+  }
+  ++numRows_;
+  return Status::OK();
+}
+
+void SstGenerator::addKey(Buffer* buffer, PartitionID part, std::string key, std::string value) {
+  buffer->bytes += key.size() + value.size();
+  buffer->parts[part].emplace_back(std::move(key), std::move(value));
+  ++numKeys_;
+}
+
+Status SstGenerator::flushRuns(Buffer* buffer) {
+  for (auto& [part, kvs] : buffer->parts) {
+    if (kvs.empty()) {
+      continue;
+    }
+    // The last one of the same key in the buffer is kept
+    std::stable_sort(kvs.begin(), kvs.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    auto dir = runDir(part);
+    if (!fs::FileUtils::makeDir(dir)) {
+      return Status::Error("Make dir '%s' failed.", dir.c_str());
+    }
+    auto path = folly::stringPrintf("%s/%d-%d.sst", dir.c_str(), buffer->worker, buffer->runs);
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options());
+    auto status = writer.Open(path);
+    for (size_t i = 0; status.ok() && i < kvs.size(); i++) {
+      if (i + 1 < kvs.size() && kvs[i + 1].first == kvs[i].first) {
+        continue;
+      }
+      status = writer.Put(kvs[i].first, kvs[i].second);
+    }
+    if (status.ok()) {
+      status = writer.Finish();
+    }
+    if (!status.ok()) {
+      return Status::Error("Write '%s' failed: %s", path.c_str(), status.ToString().c_str());
+    }
+    kvs.clear();
+  }
+  buffer->bytes = 0;
+  ++buffer->runs;
+  return Status::OK();
+}
+
+Status SstGenerator::mergeRuns(PartitionID part) {
+  auto dir = runDir(part);
+  if (!fs::FileUtils::exist(dir)) {
+    return Status::OK();
+  }
+  auto runs = fs::FileUtils::listAllFilesInDir(dir.c_str(), true, "*.sst");
+  rocksdb::Options options;
+  std::vector<std::unique_ptr<rocksdb::SstFileReader>> readers;
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+  for (const auto& run : runs) {
+    readers.emplace_back(std::make_unique<rocksdb::SstFileReader>(options));
+    auto status = readers.back()->Open(run);
+    if (!status.ok()) {
+      return Status::Error("Open '%s' failed: %s", run.c_str(), status.ToString().c_str());
+    }
+    iters.emplace_back(readers.back()->NewIterator(rocksdb::ReadOptions()));
+    iters.back()->SeekToFirst();
+  }
+
+  // The run of the least key on the top, the ones of the same key are deduplicated
+  auto greater = [&iters](size_t a, size_t b) {
+    auto cmp = iters[a]->key().compare(iters[b]->key());
+    return cmp != 0 ? cmp > 0 : a < b;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+  for (size_t i = 0; i < iters.size(); i++) {
+    if (iters[i]->Valid()) {
+      heap.push(i);
+    }
+  }
+
+  auto outDir = folly::stringPrintf("%s/%d", FLAGS_output.c_str(), part);
+  if (!fs::FileUtils::makeDir(outDir)) {
+    return Status::Error("Make dir '%s' failed.", outDir.c_str());
+  }
+  std::unique_ptr<rocksdb::SstFileWriter> writer;
+  int32_t files = 0;
+  auto status = rocksdb::Status::OK();
+  while (status.ok() && !heap.empty()) {
+    auto top = heap.top();
+    heap.pop();
+    auto key = iters[top]->key().ToString();
+    if (writer == nullptr) {
+      writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options);
+      status = writer->Open(
+          folly::stringPrintf("%s/%s-%d.sst", outDir.c_str(), schemaName_.c_str(), files++));
+      if (!status.ok()) {
+        break;
+      }
+    }
+    status = writer->Put(key, iters[top]->value());
+    iters[top]->Next();
+    if (iters[top]->Valid()) {
+      heap.push(top);
+    }
+    while (!heap.empty() && iters[heap.top()]->key() == rocksdb::Slice(key)) {
+      auto dup = heap.top();
+      heap.pop();
+      iters[dup]->Next();
+      if (iters[dup]->Valid()) {
+        heap.push(dup);
+      }
+    }
+    if (status.ok() && writer->FileSize() >= static_cast<uint64_t>(FLAGS_sst_file_mb) << 20) {
+      status = writer->Finish();
+      writer.reset();
+    }
+  }
+  for (size_t i = 0; status.ok() && i < iters.size(); i++) {
+    status = iters[i]->status();
+  }
+  if (status.ok() && writer != nullptr) {
+    status = writer->Finish();
+  }
+  if (!status.ok()) {
+    return Status::Error("Merge the runs of part %d failed: %s", part, status.ToString().c_str());
+  }
+  iters.clear();
+  readers.clear();
+  fs::FileUtils::remove(dir.c_str(), true);
+  return Status::OK();
+}
+
+StatusOr<std::string> SstGenerator::toVid(folly::StringPiece field) const {
+  if (spaceVidType_ == nebula::cpp2::PropertyType::INT64) {
+    auto vid = folly::tryTo<int64_t>(field);
+    if (!vid.hasValue()) {
+      return Status::Error("Invalid vid '%s'", field.str().c_str());
+    }
+    return std::string(reinterpret_cast<const char*>(&vid.value()), sizeof(int64_t));
+  }
+  if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, field.str())) {
+    return Status::Error("Vid '%s' is longer than %d", field.str().c_str(), spaceVidLen_);
+  }
+  return field.str();
+}
+
+StatusOr<Value> SstGenerator::toValue(const meta::NebulaSchemaProvider::SchemaField* prop,
+                                      folly::StringPiece field) const {
+  switch (prop->type()) {
+    case nebula::cpp2::PropertyType::BOOL: {
+      if (field == "true" || field == "TRUE") {
+        return Value(true);
+      }
+      if (field == "false" || field == "FALSE") {
+        return Value(false);
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::INT8:
+    case nebula::cpp2::PropertyType::INT16:
+    case nebula::cpp2::PropertyType::INT32:
+    case nebula::cpp2::PropertyType::INT64:
+    case nebula::cpp2::PropertyType::TIMESTAMP: {
+      auto value = folly::tryTo<int64_t>(field);
+      if (value.hasValue()) {
+        return Value(value.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::FLOAT:
+    case nebula::cpp2::PropertyType::DOUBLE: {
+      auto value = folly::tryTo<double>(field);
+      if (value.hasValue()) {
+        return Value(value.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::STRING:
+    case nebula::cpp2::PropertyType::FIXED_STRING: {
+      return Value(field.str());
+    }
+    case nebula::cpp2::PropertyType::DATE: {
+      auto value = time::TimeUtils::parseDate(field.str());
+      if (value.ok()) {
+        return Value(value.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::TIME: {
+      auto value = time::TimeUtils::parseTime(field.str());
+      if (value.ok()) {
+        return value.value().withTimeZone ? Value(value.value().t)
+                                          : Value(time::TimeUtils::timeToUTC(value.value().t));
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::DATETIME: {
+      auto value = time::TimeUtils::parseDateTime(field.str());
+      if (value.ok()) {
+        return value.value().withTimeZone
+                   ? Value(value.value().dt)
+                   : Value(time::TimeUtils::dateTimeToUTC(value.value().dt));
+      }
+      break;
+    }
+    default:
+      return Status::Error("Prop '%s' of type %s is not supported",
+                           prop->name(),
+                           apache::thrift::util::enumNameSafe(prop->type()).c_str());
+  }
+  return Status::Error("Invalid value '%s' of prop '%s'", field.str().c_str(), prop->name());
+}
+
+std::string SstGenerator::runDir(PartitionID part) const {
+  return folly::stringPrintf("%s/runs/%d", FLAGS_output.c_str(), part);
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,135 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef TOOLS_SSTGENERATOR_SSTGENERATOR_H_
+#define TOOLS_SSTGENERATOR_SSTGENERATOR_H_
+
+#include <rocksdb/sst_file_writer.h>
+
+#include "clients/meta/MetaClient.h"
+#include "codec/RowReaderWrapper.h"
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/meta/ServerBasedIndexManager.h"
+#include "common/meta/ServerBasedSchemaManager.h"
+#include "kvstore/Common.h"
+#include "storage/CommonUtils.h"
+
+DECLARE_string(space_name);
+DECLARE_string(meta_server);
+DECLARE_string(input);
+DECLARE_string(output);
+DECLARE_string(tag);
+DECLARE_string(edge);
+DECLARE_string(props);
+DECLARE_string(delimiter);
+DECLARE_bool(header);
+DECLARE_bool(with_rank);
+DECLARE_int32(threads);
+DECLARE_int32(run_buffer_mb);
+DECLARE_int32(sst_file_mb);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief SstGenerator generates the SST files of the rows of a tag or an edge in CSV files, to be
+ * downloaded and ingested by storaged.
+ *
+ * It runs in two passes, both in parallel:
+ *   1. The input is split into ranges of lines, each worker encodes the rows of its ranges by
+ *      RowWriterV2, with the index keys of them by IndexKeyUtils, into the keys of their parts by
+ *      vid hash. Once the buffer of a worker is full, the keys of each part are sorted and written
+ *      into a run, which is a sorted SST file of the part.
+ *   2. The runs of each part are merged into the SST files of the part, sorted and not overlapped,
+ *      in output/<part>/, which is the layout DOWNLOAD and INGEST expect.
+ *
+ * The rows of the same key are deduplicated, which one is kept is not defined, as the input is
+ * encoded in parallel.
+ */
+class SstGenerator {
+ public:
+  SstGenerator() = default;
+
+  ~SstGenerator() = default;
+
+  Status init();
+
+  Status run();
+
+ private:
+  // The lines of file in [begin, end), a line belongs to the range it begins in
+  struct Range {
+    std::string file;
+    size_t begin;
+    size_t end;
+  };
+
+  // The keys encoded by a worker not written into runs yet
+  struct Buffer {
+    std::unordered_map<PartitionID, std::vector<kvstore::KV>> parts;
+    size_t bytes{0};
+    int32_t worker{0};
+    int32_t runs{0};
+  };
+
+  Status initMeta();
+
+  Status initSchema();
+
+  Status initInput();
+
+  Status encodeRange(const Range& range, Buffer* buffer);
+
+  Status encodeLine(const std::vector<folly::StringPiece>& fields, Buffer* buffer);
+
+  void addKey(Buffer* buffer, PartitionID part, std::string key, std::string value);
+
+  // Write the keys of each part in the buffer into a run
+  Status flushRuns(Buffer* buffer);
+
+  // Merge the runs of part into the SST files of it
+  Status mergeRuns(PartitionID part);
+
+  StatusOr<std::string> toVid(folly::StringPiece field) const;
+
+  StatusOr<Value> toValue(const meta::NebulaSchemaProvider::SchemaField* prop,
+                          folly::StringPiece field) const;
+
+  // Run f(i) for i in [0, count) by the workers, the first error is returned
+  Status runWorkers(size_t count, std::function<Status(int32_t, size_t)> f);
+
+  std::string runDir(PartitionID part) const;
+
+  std::unique_ptr<meta::MetaClient> metaClient_;
+  std::unique_ptr<meta::ServerBasedSchemaManager> schemaMng_;
+  std::unique_ptr<meta::ServerBasedIndexManager> indexMng_;
+
+  GraphSpaceID spaceId_;
+  int32_t spaceVidLen_;
+  nebula::cpp2::PropertyType spaceVidType_;
+  int32_t partNum_;
+  int32_t threads_;
+
+  bool isEdge_{false};
+  // The tag id or the edge type
+  SchemaID schemaId_;
+  std::string schemaName_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> schema_;
+  std::vector<std::shared_ptr<meta::cpp2::IndexItem>> indexes_;
+  // The props of the columns after the vids, and the rank of an edge
+  std::vector<const meta::NebulaSchemaProvider::SchemaField*> props_;
+  std::vector<std::string> propNames_;
+  char delimiter_{','};
+
+  std::vector<Range> ranges_;
+  std::atomic<int64_t> numRows_{0};
+  std::atomic<int64_t> numKeys_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // TOOLS_SSTGENERATOR_SSTGENERATOR_H_
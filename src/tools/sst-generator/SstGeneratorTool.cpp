@@ -0,0 +1,86 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/base/Base.h"
+#include "tools/sst-generator/SstGenerator.h"
+
+void printHelp() {
+  fprintf(stderr,
+          R"(  ./sst_generator --space_name=<space name> --input=<path,...> --output=<path>
+                  --tag=<tag name> | --edge=<edge name> --props=<prop name,...>
+
+required:
+       --space_name=<space name>
+         A space name must be given.
+
+       --input=<path,...>
+         A list of CSV files, or directories of *.csv files, separated by comma. Each line is
+         the vid of a vertex, or the src, dst (and rank with --with_rank) of an edge, followed
+         by the props. The empty columns are the default or null.
+
+       --output=<path>
+         The directory the SST files of each part are written into, as <output>/<part>/*.sst,
+         which could be uploaded to HDFS, and then downloaded and ingested by storaged.
+
+       --tag=<tag name> | --edge=<edge name>
+         The tag or the edge of the rows, one of them must be given.
+
+optional:
+       --meta_server=<ip:port,...>
+         A list of meta severs' ip:port separated by comma.
+         Default: 127.0.0.1:45500
+
+       --props=<prop name,...>
+         A list of prop names of the columns after the vids, separated by comma.
+
+       --delimiter=<char>
+         The delimiter of the columns.
+         Default: ,
+
+       --header
+         Skip the first line of each file.
+
+       --with_rank
+         The column after the src and dst of an edge is the rank.
+
+       --threads=<N>
+         The number of the workers.
+         Default: the number of the cores
+
+       --run_buffer_mb=<N>
+         The size of the keys each worker sorts in memory before writing them into a run.
+         Default: 256
+
+       --sst_file_mb=<N>
+         The max size of each SST file generated.
+         Default: 256
+
+
+)");
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 1) {
+    printHelp();
+    return EXIT_FAILURE;
+  } else {
+    folly::init(&argc, &argv, true);
+  }
+
+  google::SetStderrLogging(google::INFO);
+
+  nebula::storage::SstGenerator generator;
+  auto status = generator.init();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  status = generator.run();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
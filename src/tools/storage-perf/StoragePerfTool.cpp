@@ -4,12 +4,18 @@
  */
 
 #include <folly/TokenBucket.h>
+#include <folly/hash/Hash.h>
 #include <folly/stats/BucketedTimeSeries.h>
 #include <folly/stats/TimeseriesHistogram.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include <fstream>
+
 #include "clients/storage/StorageClient.h"
 #include "common/base/Base.h"
+#include "common/base/ObjectPool.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/stats/LatencyHistogram.h"
 #include "common/thread/GenericWorker.h"
 #include "common/time/Duration.h"
 
@@ -21,23 +27,46 @@ DEFINE_string(method,
               "getNeighbors",
               "method type being tested,"
               "such as getNeighbors, addVertices, addEdges, "
-              "getVertices, getEdges");
+              "getVertices, getEdges, updateVertex, lookup");
+DEFINE_string(mix,
+              "",
+              "The weighted mix of the methods, e.g. getNeighbors:60,getVertices:20,addEdges:10,"
+              "updateVertex:5,lookup:5, which overrides method if it's not empty");
 DEFINE_string(meta_server_addrs, "", "meta server address");
 DEFINE_int32(min_vertex_id, 1, "The smallest vertex Id, need convert to string");
 DEFINE_int32(max_vertex_id, 10000, "The biggest vertex Id, need convert to string");
+DEFINE_string(key_distribution,
+              "uniform",
+              "The distribution of the vertices read or updated, uniform or zipfian");
+DEFINE_double(zipf_theta, 0.99, "The skew of the zipfian distribution, in (0, 1)");
 DEFINE_string(space_name, "test", "Specify the space name");
 DEFINE_string(tag_name,
               "test_tag",
               "Specify the tag name, "
-              "all property of the tag must be string");
+              "the properties are generated by their types");
 DEFINE_string(edge_name,
               "test_edge",
               "Specify the edge name, "
-              "all property of the edge must be string");
+              "the properties are generated by their types");
+DEFINE_string(index_name, "", "The tag index to lookup by, on the tag of tag_name");
+DEFINE_int32(lookup_limit, 100, "The limit of a lookup");
 DEFINE_int32(property_size, 1000, "The property size of per property");
+DEFINE_int32(collection_size,
+             0,
+             "The number of the elements of a LIST_*/SET_* property, and the tag and edge "
+             "created have a LIST_INT and a SET_STRING property if it's not 0");
 DEFINE_bool(random_message, true, "Whether to write random message to storage service");
 DEFINE_int32(concurrency, 50, "concurrent requests");
 DEFINE_int32(batch_num, 1, "batch vertices for one request");
+DEFINE_bool(open_loop,
+            false,
+            "Send the requests at the rate of qps no matter how the previous ones go, and "
+            "measure the latency from when a request should be sent, to avoid the coordinated "
+            "omission");
+DEFINE_string(latency_output,
+              "",
+              "The file to write the latency percentile distribution of each method to, in the "
+              "format of HdrHistogram");
 
 DECLARE_int32(heartbeat_interval_secs);
 
@@ -46,6 +75,43 @@ namespace storage {
 
 thread_local uint32_t position = 1;
 
+/**
+ * @brief The scrambled zipfian generator of YCSB, the ranks are hashed so that the hot keys are
+ * spread over the parts.
+ */
+class ZipfianGenerator final {
+ public:
+  ZipfianGenerator(uint64_t items, double theta) : items_(items), theta_(theta) {
+    for (uint64_t i = 1; i <= items_; i++) {
+      zetan_ += 1 / std::pow(static_cast<double>(i), theta_);
+    }
+    auto zeta2 = 1 + 1 / std::pow(2.0, theta_);
+    alpha_ = 1 / (1 - theta_);
+    eta_ = (1 - std::pow(2.0 / items_, 1 - theta_)) / (1 - zeta2 / zetan_);
+  }
+
+  uint64_t next() const {
+    auto u = folly::Random::randDouble01();
+    auto uz = u * zetan_;
+    uint64_t rank = 0;
+    if (uz < 1) {
+      rank = 0;
+    } else if (uz < 1 + std::pow(0.5, theta_)) {
+      rank = 1;
+    } else {
+      rank = static_cast<uint64_t>(items_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+    }
+    return folly::hash::twang_mix64(std::min(rank, items_ - 1)) % items_;
+  }
+
+ private:
+  uint64_t items_;
+  double theta_;
+  double zetan_{0};
+  double alpha_{0};
+  double eta_{0};
+};
+
 class Perf {
  public:
   Perf()
@@ -54,6 +120,21 @@ class Perf {
 
   int run() {
     LOG(INFO) << "Total threads " << FLAGS_threads << ", qps " << FLAGS_qps;
+    if (!parseMix()) {
+      return EXIT_FAILURE;
+    }
+    if (FLAGS_key_distribution == "zipfian") {
+      if (FLAGS_zipf_theta <= 0 || FLAGS_zipf_theta >= 1) {
+        LOG(ERROR) << "Invalid zipf_theta " << FLAGS_zipf_theta;
+        return EXIT_FAILURE;
+      }
+      zipfian_ = std::make_unique<ZipfianGenerator>(FLAGS_max_vertex_id - FLAGS_min_vertex_id,
+                                                    FLAGS_zipf_theta);
+    } else if (FLAGS_key_distribution != "uniform") {
+      LOG(ERROR) << "Unknown key_distribution " << FLAGS_key_distribution;
+      return EXIT_FAILURE;
+    }
+
     auto metaAddrsRet = nebula::network::NetworkUtils::toHosts(FLAGS_meta_server_addrs);
     if (!metaAddrsRet.ok() || metaAddrsRet.value().empty()) {
       LOG(ERROR) << "Can't get metaServer address, status:" << metaAddrsRet.status()
@@ -77,12 +158,7 @@ class Perf {
     auto tagResult = mClient_->getTagIDByNameFromCache(spaceId_, FLAGS_tag_name);
     if (!tagResult.ok()) {
       LOG(ERROR) << "Get tag failed, try to create one: " << tagResult.status();
-      nebula::meta::cpp2::Schema schema;
-      nebula::meta::cpp2::ColumnDef column;
-      column.name = "col_1";
-      column.type.type_ref() = nebula::cpp2::PropertyType::STRING;
-      (*schema.columns_ref()).emplace_back(std::move(column));
-      auto ret = mClient_->createTagSchema(spaceId_, FLAGS_tag_name, schema).get();
+      auto ret = mClient_->createTagSchema(spaceId_, FLAGS_tag_name, perfSchema()).get();
       if (!ret.ok()) {
         LOG(ERROR) << "Create tag failed: " << ret.status();
         return false;
@@ -97,20 +173,15 @@ class Perf {
       LOG(ERROR) << "TagID not exist: " << tagSchemaRes.status();
       return EXIT_FAILURE;
     }
-    auto tagSchema = tagSchemaRes.value();
-    for (size_t i = 0; i < tagSchema->getNumFields(); i++) {
-      tagProps_[tagId_].emplace_back(tagSchema->getFieldName(i));
+    tagSchema_ = tagSchemaRes.value();
+    for (size_t i = 0; i < tagSchema_->getNumFields(); i++) {
+      tagProps_[tagId_].emplace_back(tagSchema_->getFieldName(i));
     }
 
     auto edgeResult = mClient_->getEdgeTypeByNameFromCache(spaceId_, FLAGS_edge_name);
     if (!edgeResult.ok()) {
       LOG(ERROR) << "Get edge failed, try to create one: " << edgeResult.status();
-      nebula::meta::cpp2::Schema schema;
-      nebula::meta::cpp2::ColumnDef column;
-      column.name = "col_1";
-      column.type.type_ref() = nebula::cpp2::PropertyType::STRING;
-      (*schema.columns_ref()).emplace_back(std::move(column));
-      auto ret = mClient_->createEdgeSchema(spaceId_, FLAGS_edge_name, schema).get();
+      auto ret = mClient_->createEdgeSchema(spaceId_, FLAGS_edge_name, perfSchema()).get();
       if (!ret.ok()) {
         LOG(ERROR) << "Create tag failed: " << ret.status();
         return false;
@@ -125,9 +196,18 @@ class Perf {
       LOG(ERROR) << "Edge not exist: " << edgeSchemaRes.status();
       return EXIT_FAILURE;
     }
-    auto edgeSchema = edgeSchemaRes.value();
-    for (size_t i = 0; i < edgeSchema->getNumFields(); i++) {
-      edgeProps_.emplace_back(edgeSchema->getFieldName(i));
+    edgeSchema_ = edgeSchemaRes.value();
+    for (size_t i = 0; i < edgeSchema_->getNumFields(); i++) {
+      edgeProps_.emplace_back(edgeSchema_->getFieldName(i));
+    }
+
+    if (std::find(methods_.begin(), methods_.end(), "lookup") != methods_.end()) {
+      auto indexResult = mClient_->getTagIndexByNameFromCache(spaceId_, FLAGS_index_name);
+      if (!indexResult.ok()) {
+        LOG(ERROR) << "Get index " << FLAGS_index_name << " failed: " << indexResult.status();
+        return EXIT_FAILURE;
+      }
+      index_ = indexResult.value();
     }
 
     storageClient_ = std::make_unique<StorageClient>(threadPool_, mClient_.get());
@@ -141,51 +221,239 @@ class Perf {
     for (auto& t : threads) {
       t.join();
     }
+    // Wait for the requests in flight
+    while (inflightRequests_ > 0) {
+      usleep(1000);
+    }
 
     mClient_->notifyStop();
     mClient_->stop();
     threadPool_->stop();
     LOG(INFO) << "Total time cost " << duration.elapsedInMSec() << "ms, "
               << "total requests " << finishedRequests_;
+    report(duration.elapsedInMSec());
     return 0;
   }
 
   void runInternal() {
+    if (FLAGS_open_loop) {
+      // Each thread sends its share of the qps at the fixed interval
+      auto intervalUs = static_cast<int64_t>(1000000 * FLAGS_threads / FLAGS_qps);
+      auto intended = time::WallClock::fastNowInMicroSec();
+      while (sentRequests_++ < FLAGS_totalReqs) {
+        auto now = time::WallClock::fastNowInMicroSec();
+        if (now < intended) {
+          usleep(intended - now);
+        }
+        // The latency is from the intended time, even if the thread is late to send it
+        send(pickMethod(), intended);
+        intended += intervalUs;
+        logProgress();
+      }
+      return;
+    }
     while (finishedRequests_ < FLAGS_totalReqs) {
-      if (FLAGS_method == "getNeighbors") {
-        getNeighborsTask();
-      } else if (FLAGS_method == "addVertices") {
-        addVerticesTask();
-      } else if (FLAGS_method == "addEdges") {
-        addEdgesTask();
-      } else if (FLAGS_method == "getVertices") {
-        getVerticesTask();
-      } else if (FLAGS_method == "getEdges") {
-        getEdgesTask();
-      } else {
-        LOG(FATAL) << "Should not reach here.";
+      auto tokens = tokenBucket_.consumeOrDrain(FLAGS_concurrency, FLAGS_qps, FLAGS_concurrency);
+      for (auto i = 0; i < tokens; i++) {
+        send(pickMethod(), time::WallClock::fastNowInMicroSec());
       }
-      PLOG_EVERY_N(INFO, 2000) << "Progress "
-                               << finishedRequests_ / static_cast<double>(FLAGS_totalReqs) * 100
-                               << "%"
-                               << ", qps=" << qps_.rate(0) << ", latency(us) median = "
-                               << latencies_.getPercentileEstimate(0.5, 0)
-                               << ", p90 = " << latencies_.getPercentileEstimate(0.9, 0)
-                               << ", p99 = " << latencies_.getPercentileEstimate(0.99, 0);
+      logProgress();
       usleep(500);
     }
   }
 
  private:
+  struct MethodStats {
+    stats::LatencyHistogram latencies;
+    std::atomic<int64_t> errors{0};
+  };
+
+  bool parseMix() {
+    std::vector<std::string> entries;
+    folly::split(",", FLAGS_mix.empty() ? FLAGS_method : FLAGS_mix, entries, true);
+    static const std::unordered_set<std::string> allMethods = {"getNeighbors",
+                                                               "addVertices",
+                                                               "addEdges",
+                                                               "getVertices",
+                                                               "getEdges",
+                                                               "updateVertex",
+                                                               "lookup"};
+    for (auto& entry : entries) {
+      std::string method;
+      int32_t weight = 1;
+      if (!folly::split(':', entry, method, weight)) {
+        method = entry;
+      }
+      if (allMethods.count(method) == 0 || weight <= 0) {
+        LOG(ERROR) << "Invalid method " << entry;
+        return false;
+      }
+      methods_.emplace_back(method);
+      totalWeight_ += weight;
+      weights_.emplace_back(totalWeight_);
+      stats_[method] = std::make_unique<MethodStats>();
+    }
+    if (methods_.empty()) {
+      LOG(ERROR) << "No method to test";
+      return false;
+    }
+    return true;
+  }
+
+  const std::string& pickMethod() const {
+    auto r = folly::Random::rand32(totalWeight_);
+    auto it = std::upper_bound(weights_.begin(), weights_.end(), r);
+    return methods_[it - weights_.begin()];
+  }
+
+  void send(const std::string& method, int64_t start) {
+    inflightRequests_++;
+    auto future = folly::makeFuture(false);
+    if (method == "getNeighbors") {
+      future = getNeighborsTask();
+    } else if (method == "addVertices") {
+      future = addVerticesTask();
+    } else if (method == "addEdges") {
+      future = addEdgesTask();
+    } else if (method == "getVertices") {
+      future = getVerticesTask();
+    } else if (method == "getEdges") {
+      future = getEdgesTask();
+    } else if (method == "updateVertex") {
+      future = updateVertexTask();
+    } else if (method == "lookup") {
+      future = lookupTask();
+    } else {
+      LOG(FATAL) << "Should not reach here.";
+    }
+    auto* stats = stats_[method].get();
+    std::move(future)
+        .thenValue([this, start, stats](bool succeeded) {
+          auto now = time::WallClock::fastNowInMicroSec();
+          if (succeeded) {
+            stats->latencies.add(now - start);
+          } else {
+            stats->errors++;
+          }
+          latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
+          qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
+        })
+        .thenError([stats](auto&& e) {
+          LOG(ERROR) << "Request failed, e = " << e.what();
+          stats->errors++;
+        })
+        .ensure([this]() {
+          this->finishedRequests_++;
+          this->inflightRequests_--;
+        });
+  }
+
+  void logProgress() {
+    PLOG_EVERY_N(INFO, 2000) << "Progress "
+                             << finishedRequests_ / static_cast<double>(FLAGS_totalReqs) * 100
+                             << "%"
+                             << ", qps=" << qps_.rate(0) << ", latency(us) median = "
+                             << latencies_.getPercentileEstimate(0.5, 0)
+                             << ", p90 = " << latencies_.getPercentileEstimate(0.9, 0)
+                             << ", p99 = " << latencies_.getPercentileEstimate(0.99, 0);
+  }
+
+  // The summary of each method, and the percentile distributions written to latency_output
+  void report(uint64_t elapsedMs) {
+    std::cout << folly::stringPrintf("%-14s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+                                     "method",
+                                     "requests",
+                                     "errors",
+                                     "qps",
+                                     "p50(us)",
+                                     "p90(us)",
+                                     "p99(us)",
+                                     "p999(us)",
+                                     "max(us)");
+    std::ofstream out;
+    if (!FLAGS_latency_output.empty()) {
+      out.open(FLAGS_latency_output);
+    }
+    for (auto& method : methods_) {
+      auto& stats = *stats_[method];
+      auto snapshot = stats.latencies.snapshot();
+      std::cout << folly::stringPrintf(
+          "%-14s %10lu %10ld %10.1f %10ld %10ld %10ld %10ld %10ld\n",
+          method.c_str(),
+          snapshot.count,
+          stats.errors.load(),
+          snapshot.count * 1000.0 / std::max<uint64_t>(elapsedMs, 1),
+          snapshot.percentile(50),
+          snapshot.percentile(90),
+          snapshot.percentile(99),
+          snapshot.percentile(99.9),
+          snapshot.percentile(100));
+      if (out.is_open()) {
+        out << "# " << method << "\n";
+        writeDistribution(snapshot, out);
+      }
+    }
+  }
+
+  static void writeDistribution(const stats::LatencyHistogram::Snapshot& snapshot,
+                                std::ofstream& out) {
+    out << folly::stringPrintf(
+        "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    uint64_t seen = 0;
+    for (size_t i = 0; i < snapshot.counts.size(); i++) {
+      if (snapshot.counts[i] == 0) {
+        continue;
+      }
+      seen += snapshot.counts[i];
+      auto pct = static_cast<double>(seen) / snapshot.count;
+      auto value = stats::LatencyHistogram::lowerBoundOf(i + 1) - 1;
+      if (seen < snapshot.count) {
+        out << folly::stringPrintf("%12ld %14.12f %10lu %14.2f\n", value, pct, seen, 1 / (1 - pct));
+      } else {
+        out << folly::stringPrintf("%12ld %14.12f %10lu\n", value, pct, seen);
+      }
+    }
+    out << folly::stringPrintf("#[Mean    = %12.3f]\n",
+                               snapshot.count == 0 ? 0.0 : 1.0 * snapshot.sum / snapshot.count);
+    out << folly::stringPrintf("#[Max     = %12ld]\n", snapshot.percentile(100));
+    out << folly::stringPrintf("#[Total count    = %12lu]\n\n", snapshot.count);
+  }
+
+  // The schema of the tag and the edge created if they don't exist
+  nebula::meta::cpp2::Schema perfSchema() {
+    nebula::meta::cpp2::Schema schema;
+    nebula::meta::cpp2::ColumnDef column;
+    column.name = "col_1";
+    column.type.type_ref() = nebula::cpp2::PropertyType::STRING;
+    (*schema.columns_ref()).emplace_back(std::move(column));
+    if (FLAGS_collection_size > 0) {
+      nebula::meta::cpp2::ColumnDef list;
+      list.name = "col_list";
+      list.type.type_ref() = nebula::cpp2::PropertyType::LIST_INT;
+      (*schema.columns_ref()).emplace_back(std::move(list));
+      nebula::meta::cpp2::ColumnDef set;
+      set.name = "col_set";
+      set.type.type_ref() = nebula::cpp2::PropertyType::SET_STRING;
+      (*schema.columns_ref()).emplace_back(std::move(set));
+    }
+    return schema;
+  }
+
+  // A vertex in [min_vertex_id, max_vertex_id) by the key distribution
+  uint32_t nextVertex() const {
+    if (zipfian_ != nullptr) {
+      return FLAGS_min_vertex_id + zipfian_->next();
+    }
+    return FLAGS_min_vertex_id + folly::Random::rand32(FLAGS_max_vertex_id - FLAGS_min_vertex_id);
+  }
+
   std::vector<VertexID> randomVertices() {
-    return {std::to_string(FLAGS_min_vertex_id +
-                           folly::Random::rand32(FLAGS_max_vertex_id - FLAGS_min_vertex_id))};
+    return {std::to_string(nextVertex())};
   }
 
   std::vector<Value> randomEdges() {
     std::vector<Value> values;
-    auto src =
-        folly::Random::rand32(FLAGS_max_vertex_id - FLAGS_min_vertex_id) + FLAGS_min_vertex_id;
+    auto src = nextVertex();
     values.emplace_back(std::to_string(src));
     values.emplace_back(edgeType_);
     values.emplace_back(0);
@@ -211,10 +479,9 @@ class Perf {
     return edgeProps;
   }
 
-  // generate `size` properties, if random_message is set, each property will be
-  // filled with random char
-  std::vector<Value> genData(int32_t size) {
-    std::vector<Value> values;
+  // generate a string of property_size, if random_message is set, it will be filled with random
+  // char
+  std::string genString(int32_t size) {
     std::string value;
     if (FLAGS_random_message) {
       auto randchar = []() -> char {
@@ -226,30 +493,83 @@ class Perf {
         return charset[folly::Random::rand32(maxIndex)];
       };
 
-      value.reserve(FLAGS_property_size);
-      // generate random string of length property_size
-      for (int32_t i = 0; i < FLAGS_property_size; i++) {
+      value.reserve(size);
+      // generate random string of length size
+      for (int32_t i = 0; i < size; i++) {
         value += randchar();
       }
     }
-    for (int32_t i = 0; i < size; i++) {
-      values.emplace_back(value);
+    return value;
+  }
+
+  // generate the properties of the schema, the collections have collection_size elements
+  std::vector<Value> genData(const meta::NebulaSchemaProvider* schema) {
+    std::vector<Value> values;
+    for (size_t i = 0; i < schema->getNumFields(); i++) {
+      values.emplace_back(genValue(schema->getFieldType(i)));
     }
     return values;
   }
 
+  Value genValue(nebula::cpp2::PropertyType type) {
+    using nebula::cpp2::PropertyType;
+    switch (type) {
+      case PropertyType::BOOL:
+        return folly::Random::oneIn(2);
+      case PropertyType::INT8:
+      case PropertyType::INT16:
+      case PropertyType::INT32:
+      case PropertyType::INT64:
+      case PropertyType::TIMESTAMP:
+        return static_cast<int64_t>(folly::Random::rand32());
+      case PropertyType::FLOAT:
+      case PropertyType::DOUBLE:
+        return folly::Random::randDouble01();
+      case PropertyType::LIST_INT:
+      case PropertyType::SET_INT: {
+        std::vector<Value> elems;
+        for (int32_t i = 0; i < FLAGS_collection_size; i++) {
+          elems.emplace_back(static_cast<int64_t>(folly::Random::rand32()));
+        }
+        return type == PropertyType::LIST_INT ? Value(List(std::move(elems)))
+                                              : Value(Set::createFromVector(elems));
+      }
+      case PropertyType::LIST_FLOAT:
+      case PropertyType::SET_FLOAT: {
+        std::vector<Value> elems;
+        for (int32_t i = 0; i < FLAGS_collection_size; i++) {
+          elems.emplace_back(folly::Random::randDouble01());
+        }
+        return type == PropertyType::LIST_FLOAT ? Value(List(std::move(elems)))
+                                                : Value(Set::createFromVector(elems));
+      }
+      case PropertyType::LIST_STRING:
+      case PropertyType::SET_STRING: {
+        // The elements are short, a collection is about property_size in total
+        auto size = std::max(1, FLAGS_property_size / std::max(1, FLAGS_collection_size));
+        std::vector<Value> elems;
+        for (int32_t i = 0; i < FLAGS_collection_size; i++) {
+          elems.emplace_back(genString(size));
+        }
+        return type == PropertyType::LIST_STRING ? Value(List(std::move(elems)))
+                                                 : Value(Set::createFromVector(elems));
+      }
+      default:
+        return genString(FLAGS_property_size);
+    }
+  }
+
   std::vector<cpp2::NewVertex> genVertices() {
     std::vector<cpp2::NewVertex> newVertices;
-    static int vintId = FLAGS_min_vertex_id;
+    static std::atomic<int> vintId{FLAGS_min_vertex_id};
 
     for (int32_t i = 0; i < FLAGS_batch_num; i++) {
       storage::cpp2::NewVertex v;
-      v.id_ref() = std::to_string(vintId);
-      vintId++;
+      v.id_ref() = std::to_string(vintId++);
       std::vector<nebula::storage::cpp2::NewTag> newTags;
       storage::cpp2::NewTag newTag;
       newTag.tag_id_ref() = tagId_;
-      auto props = genData(tagProps_[tagId_].size());
+      auto props = genData(tagSchema_.get());
       newTag.props_ref() = std::move(props);
       newTags.emplace_back(std::move(newTag));
       v.tags_ref() = std::move(newTags);
@@ -260,25 +580,38 @@ class Perf {
 
   std::vector<cpp2::NewEdge> genEdges() {
     std::vector<cpp2::NewEdge> edges;
-    static int vintId = FLAGS_min_vertex_id;
+    static std::atomic<int> vintId{FLAGS_min_vertex_id};
 
     for (int32_t i = 0; i < FLAGS_batch_num; i++) {
+      auto src = vintId++;
       cpp2::NewEdge edge;
       cpp2::EdgeKey eKey;
-      eKey.src_ref() = std::to_string(vintId);
+      eKey.src_ref() = std::to_string(src);
       eKey.edge_type_ref() = edgeType_;
-      eKey.dst_ref() = std::to_string(vintId + 1);
+      eKey.dst_ref() = std::to_string(src + 1);
       eKey.ranking_ref() = 0;
       edge.key_ref() = std::move(eKey);
-      auto props = genData(edgeProps_.size());
+      auto props = genData(edgeSchema_.get());
       edge.props_ref() = std::move(props);
       edges.emplace_back(std::move(edge));
-      vintId++;
     }
     return edges;
   }
 
-  void getNeighborsTask() {
+  template <typename Resp>
+  static bool succeeded(const StorageRpcResponse<Resp>& resps) {
+    if (!resps.succeeded()) {
+      for (auto& entry : resps.failedParts()) {
+        LOG_EVERY_N(ERROR, 1000) << "Request failed, part " << entry.first << ", error "
+                                 << apache::thrift::util::enumNameSafe(entry.second);
+      }
+      return false;
+    }
+    VLOG(3) << "request succeeded!";
+    return true;
+  }
+
+  folly::Future<bool> getNeighborsTask() {
     auto* evb = threadPool_->getEventBase();
     std::vector<std::string> colNames;
     colNames.emplace_back(kVid);
@@ -292,89 +625,31 @@ class Perf {
     auto vProps = vertexProps();
     auto eProps = edgeProps();
 
-    auto tokens = tokenBucket_.consumeOrDrain(FLAGS_concurrency, FLAGS_qps, FLAGS_concurrency);
-    for (auto i = 0; i < tokens; i++) {
-      auto start = time::WallClock::fastNowInMicroSec();
-
-      StorageClient::CommonRequestParam param(spaceId_, 0, 0, false);
-      storageClient_
-          ->getNeighbors(
-              param, colNames, vids, {edgeType_}, edgeDire, &statProps, &vProps, &eProps, nullptr)
-          .via(evb)
-          .thenValue([this, start](auto&& resps) {
-            if (!resps.succeeded()) {
-              LOG(ERROR) << "Request failed!";
-            } else {
-              VLOG(3) << "request succeeded!";
-            }
-            this->finishedRequests_++;
-            auto now = time::WallClock::fastNowInMicroSec();
-            latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
-            qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
-          })
-          .thenError([this](auto&& e) {
-            LOG(ERROR) << "request failed, e = " << e.what();
-            this->finishedRequests_++;
-          });
-    }
+    StorageClient::CommonRequestParam param(spaceId_, 0, 0, false);
+    return storageClient_
+        ->getNeighbors(
+            param, colNames, vids, {edgeType_}, edgeDire, &statProps, &vProps, &eProps, nullptr)
+        .via(evb)
+        .thenValue([](auto&& resps) { return succeeded(resps); });
   }
 
-  void addVerticesTask() {
+  folly::Future<bool> addVerticesTask() {
     auto* evb = threadPool_->getEventBase();
-    auto tokens = tokenBucket_.consumeOrDrain(FLAGS_concurrency, FLAGS_qps, FLAGS_concurrency);
-    for (auto i = 0; i < tokens; i++) {
-      auto start = time::WallClock::fastNowInMicroSec();
-      StorageClient::CommonRequestParam param(spaceId_, 0, 0);
-      storageClient_->addVertices(param, genVertices(), tagProps_, true, false)
-          .via(evb)
-          .thenValue([this, start](auto&& resps) {
-            if (!resps.succeeded()) {
-              for (auto& entry : resps.failedParts()) {
-                LOG(ERROR) << "Request failed, part " << entry.first << ", error "
-                           << apache::thrift::util::enumNameSafe(entry.second);
-              }
-            } else {
-              VLOG(1) << "request succeeded!";
-            }
-            this->finishedRequests_++;
-            auto now = time::WallClock::fastNowInMicroSec();
-            latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
-            qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
-          })
-          .thenError([this](auto&& e) {
-            LOG(ERROR) << "Request failed, e = " << e.what();
-            this->finishedRequests_++;
-          });
-    }
+    StorageClient::CommonRequestParam param(spaceId_, 0, 0);
+    return storageClient_->addVertices(param, genVertices(), tagProps_, true, false)
+        .via(evb)
+        .thenValue([](auto&& resps) { return succeeded(resps); });
   }
 
-  void addEdgesTask() {
+  folly::Future<bool> addEdgesTask() {
     auto* evb = threadPool_->getEventBase();
-    auto tokens = tokenBucket_.consumeOrDrain(FLAGS_concurrency, FLAGS_qps, FLAGS_concurrency);
-    for (auto i = 0; i < tokens; i++) {
-      auto start = time::WallClock::fastNowInMicroSec();
-      StorageClient::CommonRequestParam param(spaceId_, 0, 0);
-      storageClient_->addEdges(param, genEdges(), edgeProps_, true, false)
-          .via(evb)
-          .thenValue([this, start](auto&& resps) {
-            if (!resps.succeeded()) {
-              LOG(ERROR) << "Request failed!";
-            } else {
-              VLOG(3) << "request succeeded!";
-            }
-            this->finishedRequests_++;
-            auto now = time::WallClock::fastNowInMicroSec();
-            latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
-            qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
-          })
-          .thenError([this](auto&&) {
-            LOG(ERROR) << "Request failed!";
-            this->finishedRequests_++;
-          });
-    }
+    StorageClient::CommonRequestParam param(spaceId_, 0, 0);
+    return storageClient_->addEdges(param, genEdges(), edgeProps_, true, false)
+        .via(evb)
+        .thenValue([](auto&& resps) { return succeeded(resps); });
   }
 
-  void getVerticesTask() {
+  folly::Future<bool> getVerticesTask() {
     auto* evb = threadPool_->getEventBase();
     nebula::DataSet input;
     input.colNames = {kVid};
@@ -385,59 +660,106 @@ class Perf {
     }
     input.emplace_back(std::move(row));
     auto vProps = vertexProps();
-    auto start = time::WallClock::fastNowInMicroSec();
     StorageClient::CommonRequestParam param(spaceId_, 0, 0);
-    storageClient_->getProps(param, std::move(input), &vProps, nullptr, nullptr)
+    return storageClient_->getProps(param, std::move(input), &vProps, nullptr, nullptr)
         .via(evb)
-        .thenValue([this, start](auto&& resps) {
-          if (!resps.succeeded()) {
-            LOG(ERROR) << "Request failed!";
-          } else {
-            VLOG(3) << "request succeeded!";
-          }
-          this->finishedRequests_++;
-          auto now = time::WallClock::fastNowInMicroSec();
-          latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
-          qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
-        })
-        .thenError([](auto&&) { LOG(ERROR) << "Request failed!"; });
+        .thenValue([](auto&& resps) { return succeeded(resps); });
   }
 
-  void getEdgesTask() {
+  folly::Future<bool> getEdgesTask() {
     auto* evb = threadPool_->getEventBase();
     nebula::DataSet input;
     input.colNames = {kSrc, kType, kRank, kDst};
     nebula::Row row(randomEdges());
     input.emplace_back(std::move(row));
     auto eProps = edgeProps();
-    auto start = time::WallClock::fastNowInMicroSec();
     StorageClient::CommonRequestParam param(spaceId_, 0, 0);
-    storageClient_->getProps(param, std::move(input), nullptr, &eProps, nullptr)
+    return storageClient_->getProps(param, std::move(input), nullptr, &eProps, nullptr)
         .via(evb)
-        .thenValue([this, start](auto&& resps) {
-          if (!resps.succeeded()) {
-            LOG(ERROR) << "Request failed!";
-          } else {
-            VLOG(3) << "request succeeded!";
+        .thenValue([](auto&& resps) { return succeeded(resps); });
+  }
+
+  // Update the properties of a vertex in the key distribution, e.g. the hot ones
+  folly::Future<bool> updateVertexTask() {
+    auto* evb = threadPool_->getEventBase();
+    ObjectPool pool;
+    std::vector<cpp2::UpdatedProp> updatedProps;
+    auto values = genData(tagSchema_.get());
+    for (size_t i = 0; i < tagSchema_->getNumFields(); i++) {
+      cpp2::UpdatedProp prop;
+      prop.name_ref() = tagSchema_->getFieldName(i);
+      prop.value_ref() = ConstantExpression::make(&pool, std::move(values[i]))->encode();
+      updatedProps.emplace_back(std::move(prop));
+    }
+    StorageClient::CommonRequestParam param(spaceId_, 0, 0);
+    return storageClient_
+        ->updateVertex(param,
+                       std::to_string(nextVertex()),
+                       tagId_,
+                       std::move(updatedProps),
+                       true,
+                       {},
+                       "")
+        .via(evb)
+        .thenValue([](auto&& resp) {
+          if (!resp.ok()) {
+            LOG_EVERY_N(ERROR, 1000) << "Request failed: " << resp.status();
+            return false;
           }
-          this->finishedRequests_++;
-          auto now = time::WallClock::fastNowInMicroSec();
-          latencies_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), now - start);
-          qps_.addValue(std::chrono::seconds(time::WallClock::fastNowInSec()), 1);
-        })
-        .thenError([](auto&&) { LOG(ERROR) << "Request failed!"; });
+          return resp.value().get_result().get_failed_parts().empty();
+        });
+  }
+
+  // Lookup the index by a random prefix of its first column
+  folly::Future<bool> lookupTask() {
+    auto* evb = threadPool_->getEventBase();
+    cpp2::IndexQueryContext context;
+    context.index_id_ref() = index_->get_index_id();
+    const auto& fields = index_->get_fields();
+    if (!fields.empty()) {
+      cpp2::IndexColumnHint hint;
+      hint.column_name_ref() = fields.front().get_name();
+      auto type = fields.front().get_type().get_type();
+      if (type == nebula::cpp2::PropertyType::STRING ||
+          type == nebula::cpp2::PropertyType::FIXED_STRING) {
+        hint.scan_type_ref() = cpp2::ScanType::PREFIX;
+        hint.begin_value_ref() = genString(1);
+      } else {
+        auto begin = static_cast<int64_t>(folly::Random::rand32());
+        hint.scan_type_ref() = cpp2::ScanType::RANGE;
+        hint.begin_value_ref() = begin;
+        hint.end_value_ref() = begin + (1L << 24);
+      }
+      context.column_hints_ref() = {std::move(hint)};
+    }
+    StorageClient::CommonRequestParam param(spaceId_, 0, 0);
+    return storageClient_
+        ->lookupIndex(param, {context}, false, tagId_, {kVid}, {}, FLAGS_lookup_limit)
+        .via(evb)
+        .thenValue([](auto&& resps) { return succeeded(resps); });
   }
 
  private:
   std::atomic_long finishedRequests_{0};
+  std::atomic_long sentRequests_{0};
+  std::atomic_long inflightRequests_{0};
   std::unique_ptr<StorageClient> storageClient_;
   std::unique_ptr<meta::MetaClient> mClient_;
   std::shared_ptr<folly::IOThreadPoolExecutor> threadPool_;
   GraphSpaceID spaceId_;
   TagID tagId_;
   EdgeType edgeType_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> tagSchema_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> edgeSchema_;
+  std::shared_ptr<meta::cpp2::IndexItem> index_;
   std::unordered_map<TagID, std::vector<std::string>> tagProps_;
   std::vector<std::string> edgeProps_;
+  // The methods and their accumulated weights
+  std::vector<std::string> methods_;
+  std::vector<uint32_t> weights_;
+  uint32_t totalWeight_{0};
+  std::unordered_map<std::string, std::unique_ptr<MethodStats>> stats_;
+  std::unique_ptr<ZipfianGenerator> zipfian_;
   folly::DynamicTokenBucket tokenBucket_;
   folly::TimeseriesHistogram<int64_t> latencies_;
   folly::TimeseriesHistogram<int64_t> qps_;
@@ -15,6 +15,7 @@ std::unordered_map<HttpStatusCode, std::string> WebServiceUtils::kStatusStringMa
     {HttpStatusCode::FORBIDDEN, "Forbidden"},
     {HttpStatusCode::NOT_FOUND, "Not Found"},
     {HttpStatusCode::METHOD_NOT_ALLOWED, "Method Not Allowed"},
+    {HttpStatusCode::SERVICE_UNAVAILABLE, "Service Unavailable"},
 };
 
 }  // namespace nebula
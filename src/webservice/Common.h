@@ -25,6 +25,7 @@ enum class HttpStatusCode : int32_t {
   FORBIDDEN = 403,
   NOT_FOUND = 404,
   METHOD_NOT_ALLOWED = 405,
+  SERVICE_UNAVAILABLE = 503,
 };
 
 class WebServiceUtils final {
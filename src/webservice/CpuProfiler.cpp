@@ -0,0 +1,126 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/CpuProfiler.h"
+
+#include <execinfo.h>
+#include <sys/time.h>
+
+#include <fstream>
+
+namespace nebula {
+
+// The frames of the handler and the signal trampoline
+static constexpr size_t kSkippedFrames = 2;
+
+StatusOr<std::string> CpuProfiler::profile(int32_t seconds, int32_t hz) {
+  if (seconds <= 0 || hz <= 0 || hz > 1000) {
+    return Status::Error("Invalid seconds %d or hz %d", seconds, hz);
+  }
+  bool expected = false;
+  if (!running_.compare_exchange_strong(expected, true)) {
+    return Status::Error("A cpu profile is being taken");
+  }
+  SCOPE_EXIT {
+    running_ = false;
+  };
+
+  if (samples_ == nullptr) {
+    samples_ = std::make_unique<Sample[]>(kMaxSamples);
+    // The first call of backtrace loads libgcc, which is not safe in the signal handler
+    void* warmup[kMaxDepth];
+    backtrace(warmup, kMaxDepth);
+  }
+  next_ = 0;
+
+  struct sigaction action, oldAction;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = &CpuProfiler::onSignal;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &oldAction) != 0) {
+    return Status::Error("Failed to install the handler of SIGPROF: %s", strerror(errno));
+  }
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = 1000000 / hz;
+  timer.it_value = timer.it_interval;
+  sampling_ = true;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    sampling_ = false;
+    sigaction(SIGPROF, &oldAction, nullptr);
+    return Status::Error("Failed to set the profiling timer: %s", strerror(errno));
+  }
+  LOG(INFO) << "Take a cpu profile of " << seconds << " seconds at " << hz << " hz";
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  sampling_ = false;
+  // Wait for the handlers still running on the other threads
+  while (inHandler_.load() != 0) {
+    std::this_thread::yield();
+  }
+  // Keep ignoring the pending signals, which would kill the process by default
+  signal(SIGPROF, SIG_IGN);
+
+  auto numSamples = next_.load();
+  if (numSamples > kMaxSamples) {
+    LOG(WARNING) << numSamples - kMaxSamples << " cpu samples are dropped";
+    numSamples = kMaxSamples;
+  }
+  return serialize(numSamples, hz);
+}
+
+// static
+void CpuProfiler::onSignal(int, siginfo_t*, void*) {
+  auto& profiler = instance();
+  profiler.inHandler_++;
+  if (profiler.sampling_.load()) {
+    auto index = profiler.next_.fetch_add(1);
+    if (index < kMaxSamples) {
+      void* pcs[kMaxDepth + kSkippedFrames];
+      auto depth = backtrace(pcs, kMaxDepth + kSkippedFrames);
+      auto& sample = profiler.samples_[index];
+      sample.depth = depth > static_cast<int>(kSkippedFrames) ? depth - kSkippedFrames : 0;
+      memcpy(sample.pcs, pcs + kSkippedFrames, sample.depth * sizeof(void*));
+    }
+  }
+  profiler.inHandler_--;
+}
+
+std::string CpuProfiler::serialize(size_t numSamples, int32_t hz) const {
+  std::map<std::vector<uintptr_t>, uintptr_t> stacks;
+  for (size_t i = 0; i < numSamples; i++) {
+    const auto& sample = samples_[i];
+    if (sample.depth == 0) {
+      continue;
+    }
+    std::vector<uintptr_t> stack(sample.depth);
+    for (size_t j = 0; j < sample.depth; j++) {
+      stack[j] = reinterpret_cast<uintptr_t>(sample.pcs[j]);
+    }
+    stacks[std::move(stack)]++;
+  }
+
+  // The header: the count and the size of the header, the version, the period and the padding
+  std::vector<uintptr_t> words = {0, 3, 0, static_cast<uintptr_t>(1000000 / hz), 0};
+  for (const auto& [stack, count] : stacks) {
+    words.emplace_back(count);
+    words.emplace_back(stack.size());
+    words.insert(words.end(), stack.begin(), stack.end());
+  }
+  // The trailer
+  words.insert(words.end(), {0, 1, 0});
+
+  std::string ret(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uintptr_t));
+  // The mappings to symbolize the addresses
+  std::ifstream maps("/proc/self/maps");
+  ret.append(std::istreambuf_iterator<char>(maps), std::istreambuf_iterator<char>());
+  return ret;
+}
+
+}  // namespace nebula
@@ -0,0 +1,61 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_CPUPROFILER_H_
+#define WEBSERVICE_CPUPROFILER_H_
+
+#include <signal.h>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+
+namespace nebula {
+
+/**
+ * @brief CpuProfiler samples the stacks of the threads burning cpu by SIGPROF, and returns the
+ * profile in the legacy cpu profile format of gperftools, which could be read by pprof directly.
+ *
+ * The samples are written into a preallocated buffer by the signal handler without any lock or
+ * allocation, and aggregated by stacks when the profiling is done. Only one profile could be taken
+ * at a time in a process, since the timer and the handler of SIGPROF are process wide.
+ */
+class CpuProfiler final {
+ public:
+  static constexpr size_t kMaxDepth = 64;
+  static constexpr size_t kMaxSamples = 1L << 16;
+
+  static CpuProfiler& instance() {
+    static CpuProfiler profiler;
+    return profiler;
+  }
+
+  /**
+   * @brief Profile the process for the given seconds at hz samples per cpu second, the calling
+   * thread is blocked during it.
+   */
+  StatusOr<std::string> profile(int32_t seconds, int32_t hz);
+
+ private:
+  struct Sample {
+    size_t depth{0};
+    void* pcs[kMaxDepth];
+  };
+
+  CpuProfiler() = default;
+
+  static void onSignal(int sig, siginfo_t* info, void* ucontext);
+
+  std::string serialize(size_t numSamples, int32_t hz) const;
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> sampling_{false};
+  std::atomic<int32_t> inHandler_{0};
+  std::atomic<size_t> next_{0};
+  std::unique_ptr<Sample[]> samples_;
+};
+
+}  // namespace nebula
+
+#endif  // WEBSERVICE_CPUPROFILER_H_
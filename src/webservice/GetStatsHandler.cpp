@@ -32,6 +32,7 @@ void GetStatsHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
 
   if (headers->hasQueryParam("format")) {
     returnJson_ = (headers->getQueryParam("format") == "json");
+    returnPrometheus_ = (headers->getQueryParam("format") == "prometheus");
   }
 
   if (headers->hasQueryParam("stats")) {
@@ -56,6 +57,16 @@ void GetStatsHandler::onEOM() noexcept {
       break;
   }
 
+  if (returnPrometheus_) {
+    ResponseBuilder(downstream_)
+        .status(WebServiceUtils::to(HttpStatusCode::OK),
+                WebServiceUtils::toString(HttpStatusCode::OK))
+        .header("Content-Type", "text/plain; version=0.0.4")
+        .body(getPrometheus())
+        .sendWithEOM();
+    return;
+  }
+
   // read stats
   folly::dynamic vals = getStats();
   std::string body = returnJson_ ? folly::toPrettyJson(vals) : toStr(vals);
@@ -120,4 +131,58 @@ std::string GetStatsHandler::toStr(folly::dynamic& vals) const {
   return ss.str();
 }
 
+std::string GetStatsHandler::getPrometheus() const {
+  auto text = toPrometheus(getStats());
+  if (statNames_.empty()) {
+    StatsManager::readAllLatencyHistos(&text);
+  }
+  return text;
+}
+
+std::string GetStatsHandler::toPrometheus(const folly::dynamic& vals) const {
+  auto sanitize = [](std::string name) {
+    for (auto& c : name) {
+      if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != ':') {
+        c = '_';
+      }
+    }
+    return name;
+  };
+  std::string text;
+  for (auto& counter : vals) {
+    for (auto& m : counter.items()) {
+      if (!m.second.isNumber()) {
+        // The error of the stat
+        continue;
+      }
+      auto stat = m.first.asString();
+      std::string name = stat;
+      std::string labels;
+      auto begin = stat.find('{');
+      auto end = stat.find('}');
+      if (begin != std::string::npos && end != std::string::npos && begin < end) {
+        name = stat.substr(0, begin) + stat.substr(end + 1);
+        std::vector<std::string> pairs;
+        folly::split(",", stat.substr(begin + 1, end - begin - 1), pairs, true);
+        for (auto& pair : pairs) {
+          auto pos = pair.find('=');
+          if (pos != std::string::npos) {
+            labels.append(sanitize(pair.substr(0, pos)))
+                .append("=\"")
+                .append(pair.substr(pos + 1))
+                .append("\",");
+          }
+        }
+      }
+      text.append(sanitize(name));
+      if (!labels.empty()) {
+        labels.back() = '}';
+        text.append("{").append(labels);
+      }
+      text.append(" ").append(m.second.asString()).append("\n");
+    }
+  }
+  return text;
+}
+
 }  // namespace nebula
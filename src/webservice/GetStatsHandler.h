@@ -37,10 +37,18 @@ class GetStatsHandler : public proxygen::RequestHandler {
                   const std::string& statName,
                   const std::string& error) const;
   std::string toStr(folly::dynamic& vals) const;
+  // The stats in the Prometheus text format, with the latency histograms if no stat is specified
+  virtual std::string getPrometheus() const;
+  /**
+   * @brief Convert the stats to Prometheus gauges, e.g. "num_queries{space=s1}.rate.60" to
+   * num_queries_rate_60{space="s1"}.
+   */
+  std::string toPrometheus(const folly::dynamic& vals) const;
 
  protected:
   HttpCode err_{HttpCode::SUCCEEDED};
   bool returnJson_{false};
+  bool returnPrometheus_{false};
   std::vector<std::string> statNames_;
 };
 
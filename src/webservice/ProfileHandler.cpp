@@ -0,0 +1,177 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/ProfileHandler.h"
+
+#include <folly/io/async/EventBaseManager.h>
+#include <proxygen/httpserver/ResponseBuilder.h>
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+#include <fstream>
+
+#if ENABLE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+#include "common/thread/NamedThread.h"
+#include "common/time/WallClock.h"
+#include "webservice/CpuProfiler.h"
+
+DEFINE_int32(ws_profile_max_seconds, 300, "The max seconds to take a cpu or heap profile");
+DEFINE_string(ws_heap_profile_dir, "/tmp", "The directory to dump the heap profiles temporarily");
+
+namespace nebula {
+
+using proxygen::HTTPMessage;
+using proxygen::HTTPMethod;
+using proxygen::ProxygenError;
+using proxygen::ResponseBuilder;
+using proxygen::UpgradeProtocol;
+
+void ProfileHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
+  if (!headers->getMethod() || headers->getMethod().value() != HTTPMethod::GET) {
+    // Unsupported method
+    err_ = HttpCode::E_UNSUPPORTED_METHOD;
+    return;
+  }
+
+  seconds_ = type_ == Type::kCpu ? 30 : 0;
+  try {
+    if (headers->hasQueryParam("seconds")) {
+      seconds_ = folly::to<int32_t>(headers->getQueryParam("seconds"));
+    }
+    if (headers->hasQueryParam("hz")) {
+      hz_ = folly::to<int32_t>(headers->getQueryParam("hz"));
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Invalid profile parameters: " << e.what();
+    err_ = HttpCode::E_ILLEGAL_ARGUMENT;
+    return;
+  }
+  auto minSeconds = type_ == Type::kCpu ? 1 : 0;
+  if (seconds_ < minSeconds || seconds_ > FLAGS_ws_profile_max_seconds) {
+    err_ = HttpCode::E_ILLEGAL_ARGUMENT;
+  }
+}
+
+void ProfileHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
+  // Do nothing, we only support GET
+}
+
+void ProfileHandler::onEOM() noexcept {
+  switch (err_) {
+    case HttpCode::E_UNSUPPORTED_METHOD:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::METHOD_NOT_ALLOWED),
+                  WebServiceUtils::toString(HttpStatusCode::METHOD_NOT_ALLOWED))
+          .sendWithEOM();
+      return;
+    case HttpCode::E_ILLEGAL_ARGUMENT:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::BAD_REQUEST),
+                  WebServiceUtils::toString(HttpStatusCode::BAD_REQUEST))
+          .body(folly::stringPrintf("Invalid seconds, which should be at most %d\n",
+                                    FLAGS_ws_profile_max_seconds))
+          .sendWithEOM();
+      return;
+    default:
+      break;
+  }
+
+  auto* evb = folly::EventBaseManager::get()->getExistingEventBase();
+  CHECK(evb != nullptr);
+  auto type = type_;
+  auto seconds = seconds_;
+  auto hz = hz_;
+  auto alive = alive_;
+  thread::NamedThread("profiler", [this, evb, type, seconds, hz, alive]() {
+    auto result = type == Type::kCpu ? CpuProfiler::instance().profile(seconds, hz)
+                                     : heapProfile(seconds);
+    evb->runInEventBaseThread([this, alive, result = std::move(result)]() mutable {
+      // The connection might have been closed during the profiling
+      if (*alive) {
+        sendResponse(std::move(result));
+      }
+    });
+  }).detach();
+}
+
+void ProfileHandler::sendResponse(StatusOr<std::string> result) {
+  if (!result.ok()) {
+    LOG(ERROR) << "Failed to take the profile: " << result.status();
+    ResponseBuilder(downstream_)
+        .status(WebServiceUtils::to(HttpStatusCode::SERVICE_UNAVAILABLE),
+                WebServiceUtils::toString(HttpStatusCode::SERVICE_UNAVAILABLE))
+        .body(result.status().toString() + "\n")
+        .sendWithEOM();
+    return;
+  }
+  ResponseBuilder(downstream_)
+      .status(WebServiceUtils::to(HttpStatusCode::OK),
+              WebServiceUtils::toString(HttpStatusCode::OK))
+      .header("Content-Type", "application/octet-stream")
+      .header("Content-Disposition",
+              type_ == Type::kCpu ? "attachment; filename=\"cpu.prof\""
+                                  : "attachment; filename=\"heap.prof\"")
+      .body(std::move(result).value())
+      .sendWithEOM();
+}
+
+void ProfileHandler::onUpgrade(UpgradeProtocol) noexcept {
+  // Do nothing
+}
+
+void ProfileHandler::requestComplete() noexcept {
+  *alive_ = false;
+  delete this;
+}
+
+void ProfileHandler::onError(ProxygenError err) noexcept {
+  LOG(ERROR) << "Web service ProfileHandler got error: " << proxygen::getErrorString(err);
+  *alive_ = false;
+  delete this;
+}
+
+// static
+StatusOr<std::string> ProfileHandler::heapProfile(int32_t seconds) {
+#if ENABLE_JEMALLOC
+  bool enabled = false;
+  size_t size = sizeof(enabled);
+  if (mallctl("opt.prof", &enabled, &size, nullptr, 0) != 0 || !enabled) {
+    return Status::Error("The heap profiling is off, start the daemon with MALLOC_CONF=prof:true");
+  }
+  if (seconds > 0) {
+    // Sample the allocations in the given seconds only
+    bool active = true;
+    bool wasActive = false;
+    size = sizeof(wasActive);
+    if (mallctl("prof.active", &wasActive, &size, &active, sizeof(active)) != 0) {
+      return Status::Error("Failed to activate the heap profiling");
+    }
+    LOG(INFO) << "Sample the allocations for a heap profile of " << seconds << " seconds";
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    mallctl("prof.active", nullptr, nullptr, &wasActive, sizeof(wasActive));
+  }
+
+  auto path = folly::stringPrintf("%s/nebula-heap.%d.%ld.prof",
+                                  FLAGS_ws_heap_profile_dir.c_str(),
+                                  getpid(),
+                                  time::WallClock::fastNowInMicroSec());
+  const char* file = path.c_str();
+  if (mallctl("prof.dump", nullptr, nullptr, &file, sizeof(file)) != 0) {
+    return Status::Error("Failed to dump the heap profile to %s", file);
+  }
+  std::ifstream in(path);
+  std::string ret{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+  unlink(file);
+  return ret;
+#else
+  UNUSED(seconds);
+  return Status::Error("The heap profiling needs jemalloc");
+#endif
+}
+
+}  // namespace nebula
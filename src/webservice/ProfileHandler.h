@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_PROFILEHANDLER_H_
+#define WEBSERVICE_PROFILEHANDLER_H_
+
+#include <proxygen/httpserver/RequestHandler.h>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "webservice/Common.h"
+
+DECLARE_int32(ws_profile_max_seconds);
+
+namespace nebula {
+
+/**
+ * @brief ProfileHandler takes a profile of the daemon on demand and returns it in a format read by
+ * pprof:
+ *   GET /pprof/profile?seconds=30&hz=100  the cpu profile sampled in the given seconds
+ *   GET /pprof/heap?seconds=0              the jemalloc heap profile, the allocations are sampled
+ *                                          in the given seconds before dumping if it's not 0
+ *
+ * The heap profile needs the daemon started with MALLOC_CONF=prof:true, and it could be started
+ * with prof_active:false to keep the sampling off until it's asked for. The profiling is done in a
+ * separate thread, so that the threads of the web service are not blocked.
+ */
+class ProfileHandler : public proxygen::RequestHandler {
+ public:
+  enum class Type {
+    kCpu,
+    kHeap,
+  };
+
+  explicit ProfileHandler(Type type) : type_(type) {}
+
+  void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
+
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override;
+
+  void onEOM() noexcept override;
+
+  void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override;
+
+  void requestComplete() noexcept override;
+
+  void onError(proxygen::ProxygenError err) noexcept override;
+
+  static StatusOr<std::string> heapProfile(int32_t seconds);
+
+ private:
+  void sendResponse(StatusOr<std::string> result);
+
+ private:
+  Type type_;
+  HttpCode err_{HttpCode::SUCCEEDED};
+  int32_t seconds_{0};
+  int32_t hz_{100};
+  // Whether the handler is not deleted, accessed in the thread of the event base only
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+};
+
+}  // namespace nebula
+
+#endif  // WEBSERVICE_PROFILEHANDLER_H_
@@ -13,6 +13,7 @@
 #include "webservice/GetFlagsHandler.h"
 #include "webservice/GetStatsHandler.h"
 #include "webservice/NotFoundHandler.h"
+#include "webservice/ProfileHandler.h"
 #include "webservice/Router.h"
 #include "webservice/SetFlagsHandler.h"
 #include "webservice/StatusHandler.h"
@@ -79,6 +80,14 @@ Status WebService::start(uint16_t httpPort) {
     DCHECK(params.empty());
     return new GetStatsHandler();
   });
+  router().get("/pprof/profile").handler([](web::PathParams&& params) {
+    DCHECK(params.empty());
+    return new ProfileHandler(ProfileHandler::Type::kCpu);
+  });
+  router().get("/pprof/heap").handler([](web::PathParams&& params) {
+    DCHECK(params.empty());
+    return new ProfileHandler(ProfileHandler::Type::kHeap);
+  });
   router().get("/status").handler([](web::PathParams&& params) {
     DCHECK(params.empty());
     return new StatusHandler();
@@ -0,0 +1,84 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/http/HttpClient.h"
+#include "webservice/CpuProfiler.h"
+#include "webservice/WebService.h"
+
+namespace nebula {
+
+class ProfileHandlerTestEnv : public ::testing::Environment {
+ public:
+  void SetUp() override {
+    FLAGS_ws_http_port = 0;
+    VLOG(1) << "Starting web service...";
+
+    webSvc_ = std::make_unique<WebService>();
+    auto status = webSvc_->start();
+    ASSERT_TRUE(status.ok()) << status;
+  }
+
+  void TearDown() override {
+    webSvc_.reset();
+    VLOG(1) << "Web service stopped";
+  }
+
+ protected:
+  std::unique_ptr<WebService> webSvc_;
+};
+
+TEST(ProfileHandlerTest, CpuProfileTest) {
+  // Burn some cpu to be sampled
+  std::atomic<bool> stop{false};
+  std::thread burner([&stop]() {
+    volatile uint64_t sum = 0;
+    while (!stop) {
+      sum += 1;
+    }
+  });
+
+  auto url = folly::stringPrintf(
+      "http://%s:%d/pprof/profile?seconds=1&hz=200", FLAGS_ws_ip.c_str(), FLAGS_ws_http_port);
+  auto resp = HttpClient::instance().get(url);
+  stop = true;
+  burner.join();
+  ASSERT_EQ(0, resp.curlCode);
+
+  // The header of the legacy cpu profile
+  ASSERT_GT(resp.body.size(), 8 * sizeof(uintptr_t));
+  const auto* words = reinterpret_cast<const uintptr_t*>(resp.body.data());
+  EXPECT_EQ(0, words[0]);
+  EXPECT_EQ(3, words[1]);
+  EXPECT_EQ(0, words[2]);
+  EXPECT_EQ(1000000 / 200, words[3]);
+  // At least one stack is sampled
+  EXPECT_GT(words[5], 0);
+  // Followed by the mappings
+  EXPECT_NE(std::string::npos, resp.body.find("r-xp"));
+}
+
+TEST(ProfileHandlerTest, InvalidArgumentTest) {
+  for (auto query : {"seconds=0", "seconds=100000", "seconds=abc", "hz=0"}) {
+    auto url = folly::stringPrintf(
+        "http://%s:%d/pprof/profile?%s", FLAGS_ws_ip.c_str(), FLAGS_ws_http_port, query);
+    auto resp = HttpClient::instance().get(url);
+    ASSERT_EQ(0, resp.curlCode);
+    EXPECT_NE(std::string::npos, resp.body.find("Invalid")) << query;
+  }
+  EXPECT_FALSE(CpuProfiler::instance().profile(1, 100000).ok());
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  ::testing::AddGlobalTestEnvironment(new nebula::ProfileHandlerTestEnv());
+  return RUN_ALL_TESTS();
+}
@@ -319,6 +319,10 @@ class NebulaService(object):
         self.graphd_param['password_lock_time_in_secs'] = '10'
         # expression depth limit
         self.graphd_param['max_expression_depth'] = '128'
+        # plan cache, the plans are reused and dropped in the tests
+        self.graphd_param['plan_cache_capacity'] = '1024'
+        self.graphd_param['plan_cache_max_reuses'] = '3'
+        self.graphd_param['plan_cache_instances_per_query'] = '2'
         if self.query_concurrently:
             self.graphd_param['max_job_size'] = '4'
 
@@ -371,6 +375,10 @@ class NebulaService(object):
         self.graphd_param['raft_heartbeat_interval_secs'] = '30'
         self.graphd_param['skip_wait_in_rate_limiter'] = 'true'
         self.graphd_param['add_local_host'] = 'false'
+        # plan cache, the plans are reused and dropped in the tests
+        self.graphd_param['plan_cache_capacity'] = '1024'
+        self.graphd_param['plan_cache_max_reuses'] = '3'
+        self.graphd_param['plan_cache_instances_per_query'] = '2'
         if self.query_concurrently:
             self.graphd_param['max_job_size'] = '4'
         self.graphd_param["default_parts_num"] = 1
@@ -0,0 +1,128 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+# The test cluster runs with plan_cache_max_reuses 3 and plan_cache_instances_per_query 2
+Feature: Plan cache
+
+  Background:
+    Given an empty graph
+    And create a space with following options:
+      | partition_num  | 1                |
+      | replica_factor | 1                |
+      | vid_type       | FIXED_STRING(20) |
+    And having executed:
+      """
+      CREATE TAG t(p int);
+      CREATE EDGE e(w int);
+      """
+    And wait 3 seconds
+    And having executed:
+      """
+      INSERT VERTEX t(p) VALUES "1":(1), "2":(2), "3":(3);
+      INSERT EDGE e(w) VALUES "1"->"2":(12), "2"->"3":(23), "1"->"3":(13);
+      """
+
+  Scenario: repeat a query beyond the max reuses
+    When executing query:
+      """
+      GO FROM "1" OVER e YIELD dst(edge) AS id, e.w AS w
+      """
+    Then the result should be, in any order:
+      | id  | w  |
+      | "2" | 12 |
+      | "3" | 13 |
+    When executing query:
+      """
+      GO FROM "1" OVER e YIELD dst(edge) AS id, e.w AS w
+      """
+    Then the result should be, in any order:
+      | id  | w  |
+      | "2" | 12 |
+      | "3" | 13 |
+    When executing query:
+      """
+      GO FROM "1" OVER e YIELD dst(edge) AS id, e.w AS w
+      """
+    Then the result should be, in any order:
+      | id  | w  |
+      | "2" | 12 |
+      | "3" | 13 |
+    When executing query:
+      """
+      GO FROM "1" OVER e YIELD dst(edge) AS id, e.w AS w
+      """
+    Then the result should be, in any order:
+      | id  | w  |
+      | "2" | 12 |
+      | "3" | 13 |
+    When executing query:
+      """
+      GO FROM "1" OVER e YIELD dst(edge) AS id, e.w AS w
+      """
+    Then the result should be, in any order:
+      | id  | w  |
+      | "2" | 12 |
+      | "3" | 13 |
+    And drop the used space
+
+  Scenario: repeat a query with the variables and the pipes
+    When executing query:
+      """
+      $a = GO FROM "1" OVER e YIELD dst(edge) AS id;
+      GO FROM $a.id OVER e YIELD dst(edge) AS id | YIELD count(*) AS c
+      """
+    Then the result should be, in any order:
+      | c |
+      | 1 |
+    When executing query:
+      """
+      $a = GO FROM "1" OVER e YIELD dst(edge) AS id;
+      GO FROM $a.id OVER e YIELD dst(edge) AS id | YIELD count(*) AS c
+      """
+    Then the result should be, in any order:
+      | c |
+      | 1 |
+    When executing query:
+      """
+      $a = GO FROM "1" OVER e YIELD dst(edge) AS id;
+      GO FROM $a.id OVER e YIELD dst(edge) AS id | YIELD count(*) AS c
+      """
+    Then the result should be, in any order:
+      | c |
+      | 1 |
+    And drop the used space
+
+  Scenario: plan again after the schema changed
+    When executing query:
+      """
+      FETCH PROP ON t "1" YIELD properties(vertex) AS props
+      """
+    Then the result should be, in any order:
+      | props  |
+      | {p: 1} |
+    When executing query:
+      """
+      FETCH PROP ON t "1" YIELD properties(vertex) AS props
+      """
+    Then the result should be, in any order:
+      | props  |
+      | {p: 1} |
+    When executing query:
+      """
+      ALTER TAG t ADD (q int DEFAULT 0)
+      """
+    Then the execution should be successful
+    And wait 3 seconds
+    When executing query:
+      """
+      INSERT VERTEX t(p, q) VALUES "1":(1, 2)
+      """
+    Then the execution should be successful
+    When executing query:
+      """
+      FETCH PROP ON t "1" YIELD properties(vertex) AS props
+      """
+    Then the result should be, in any order:
+      | props        |
+      | {p: 1, q: 2} |
+    And drop the used space
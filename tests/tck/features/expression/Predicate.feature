@@ -320,7 +320,7 @@ Feature: Predicate
       """
       YIELD single(n IN "Tom" WHERE n == 3) AS r
       """
-    Then a SemanticError should be raised at runtime: `"Tom"', expected LIST, but was STRING
+    Then a SemanticError should be raised at runtime: `"Tom"', expected LIST or SET, but was STRING
     When executing query:
       """
       YIELD single(n IN NULL WHERE n == 3) AS r
@@ -277,6 +277,32 @@ Feature: FulltextIndexTest
       | "5" | "cba"   | "neBula"       | 0.0693102   |
       | "1" | "abc"   | "nebula graph" | 0.054002427 |
       | "2" | "abcde" | "nebula-graph" | 0.054002427 |
+    When profiling query:
+      """
+      LOOKUP ON tag2
+      WHERE ES_QUERY(nebula_index_tag2_props, "nebula")
+      YIELD
+        id(vertex) AS id,
+        tag2.prop1 AS prop1,
+        tag2.prop2 AS prop2,
+        score() AS sc |
+      ORDER BY $-.sc DESC |
+      LIMIT 2
+      """
+    Then the result should be, in any order:
+      | id  | prop1 | prop2    | sc        |
+      | "4" | "zyx" | "Nebula" | 0.0693102 |
+      | "5" | "cba" | "neBula" | 0.0693102 |
+    And the execution plan should be:
+      | id | name              | dependencies | profiling data | operator info |
+      | 12 | TopN              | 13           |                |               |
+      | 13 | Project           | 14           |                |               |
+      | 14 | HashInnerJoin     | 15,16        |                |               |
+      | 15 | FulltextIndexScan | 0            |                | {"limit":2}   |
+      | 0  | Start             |              |                |               |
+      | 16 | Project           | 17           |                |               |
+      | 17 | GetVertices       | 18           |                |               |
+      | 18 | Argument          |              |                |               |
     When executing query:
       """
       LOOKUP ON edge2
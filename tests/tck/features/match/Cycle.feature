@@ -0,0 +1,29 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Match the cycles of the pattern
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: The step closing the cycle
+    When executing query:
+      """
+      MATCH (a)-[:like]->(b)-[:like]->(a)
+      WHERE id(a) == "Tim Duncan"
+      RETURN id(b) AS b
+      """
+    Then the result should be, in any order:
+      | b               |
+      | "Tony Parker"   |
+      | "Manu Ginobili" |
+    When executing query:
+      """
+      MATCH (a)-[:like]->(b)-[:like]->(c)-[:like]->(a)
+      WHERE id(a) == "Tim Duncan"
+      RETURN id(b) AS b, id(c) AS c
+      """
+    Then the result should be, in any order:
+      | b             | c                   |
+      | "Tony Parker" | "Manu Ginobili"     |
+      | "Tony Parker" | "LaMarcus Aldridge" |
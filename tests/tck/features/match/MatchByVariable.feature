@@ -19,8 +19,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 9  | Aggregate      | 8            |                |               |
-      | 8  | Filter         | 7            |                |               |
+      | 9  | Aggregate      | 7            |                |               |
       | 7  | CrossJoin      | 1,6          |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -40,8 +39,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -64,8 +62,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 9  | Aggregate      | 8            |                |               |
-      | 8  | Filter         | 7            |                |               |
+      | 9  | Aggregate      | 7            |                |               |
       | 7  | CrossJoin      | 1,6          |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -85,8 +82,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 10 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -108,8 +104,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 10 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -133,8 +128,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -157,8 +151,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 15 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -184,8 +177,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: ((id($v1) IN $id_list) AND (id($v2) IN $id_list)). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -208,8 +200,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 14 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -234,8 +225,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 14 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -262,8 +252,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 15           |                |               |
@@ -286,8 +275,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -313,8 +301,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: ((id($v1) IN $id_list) AND (id($v2) IN $id_list)). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 15           |                |               |
@@ -337,8 +324,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 14 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -363,8 +349,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (id($v1) IN $id_list). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 14 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -391,8 +376,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 9  | Aggregate      | 8            |                |               |
-      | 8  | Filter         | 7            |                |               |
+      | 9  | Aggregate      | 7            |                |               |
       | 7  | CrossJoin      | 1,6          |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -412,8 +396,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -436,8 +419,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 9  | Aggregate      | 8            |                |               |
-      | 8  | Filter         | 7            |                |               |
+      | 9  | Aggregate      | 7            |                |               |
       | 7  | CrossJoin      | 1,6          |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -457,8 +439,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 10 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -480,8 +461,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 10 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -507,8 +487,7 @@ Feature: Match By Variable
       | 2 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -533,8 +512,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 15 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -562,8 +540,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -588,8 +565,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 14 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -616,8 +592,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 20           |                |               |
-      | 20 | Filter         | 19           |                |               |
+      | 14 | Aggregate      | 19           |                |               |
       | 19 | CrossJoin      | 6,23         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 24           |                |               |
@@ -646,8 +621,7 @@ Feature: Match By Variable
       | 40 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 15           |                |               |
@@ -672,8 +646,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -701,8 +674,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 13 | Aggregate      | 12           |                |               |
-      | 12 | Filter         | 11           |                |               |
+      | 13 | Aggregate      | 11           |                |               |
       | 11 | CrossJoin      | 6,10         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 15           |                |               |
@@ -727,8 +699,7 @@ Feature: Match By Variable
       | 14 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 14 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -755,8 +726,7 @@ Feature: Match By Variable
       | 4 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 14 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -784,8 +754,7 @@ Feature: Match By Variable
       | 44 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 9            |                |               |
-      | 9  | Filter         | 8            |                |               |
+      | 10 | Aggregate      | 8            |                |               |
       | 8  | CrossJoin      | 3,7          |                |               |
       | 3  | Project        | 1            |                |               |
       | 1  | Unwind         | 2            |                |               |
@@ -817,8 +786,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 9            |                |               |
-      | 9  | Filter         | 8            |                |               |
+      | 10 | Aggregate      | 8            |                |               |
       | 8  | CrossJoin      | 1,7          |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -839,8 +807,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 14           |                |               |
-      | 14 | Filter         | 13           |                |               |
+      | 10 | Aggregate      | 13           |                |               |
       | 13 | CrossJoin      | 1,16         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -862,8 +829,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 9            |                |               |
-      | 9  | Filter         | 8            |                |               |
+      | 10 | Aggregate      | 8            |                |               |
       | 8  | CrossJoin      | 1,7          |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -884,8 +850,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -908,8 +873,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Project        | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -933,8 +897,7 @@ Feature: Match By Variable
       """
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -960,8 +923,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 18           |                |               |
-      | 18 | Filter         | 17           |                |               |
+      | 14 | Aggregate      | 17           |                |               |
       | 17 | CrossJoin      | 6,21         |                |               |
       | 6  | Project        | 22           |                |               |
       | 22 | AppendVertices | 2            |                |               |
@@ -986,8 +948,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: ((v1.player.name IN $names) AND (v2.player.name IN $names)). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -1011,8 +972,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 23           |                |               |
       | 23 | AppendVertices | 2            |                |               |
@@ -1038,8 +998,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 23           |                |               |
       | 23 | AppendVertices | 2            |                |               |
@@ -1067,8 +1026,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -1092,8 +1050,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 18           |                |               |
-      | 18 | Filter         | 17           |                |               |
+      | 14 | Aggregate      | 17           |                |               |
       | 17 | CrossJoin      | 6,21         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 22           |                |               |
@@ -1118,8 +1075,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: ((v1.player.name IN $names) AND (v2.player.name IN $names)). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -1143,8 +1099,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -1170,8 +1125,7 @@ Feature: Match By Variable
     Then a ExecutionError should be raised at runtime: Failed to evaluate condition: (v1.player.name IN $names). For boolean conditions, please write in their full forms like <condition> == <true/false> or <condition> IS [NOT] NULL.
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -1199,8 +1153,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 9            |                |               |
-      | 9  | Filter         | 8            |                |               |
+      | 10 | Aggregate      | 8            |                |               |
       | 8  | CrossJoin      | 1,7          |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -1221,8 +1174,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 14           |                |               |
-      | 14 | Filter         | 13           |                |               |
+      | 10 | Aggregate      | 13           |                |               |
       | 13 | CrossJoin      | 1,16         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -1244,8 +1196,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 10 | Aggregate      | 9            |                |               |
-      | 9  | Filter         | 8            |                |               |
+      | 10 | Aggregate      | 8            |                |               |
       | 8  | CrossJoin      | 1,7          |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -1266,8 +1217,7 @@ Feature: Match By Variable
       | 20 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -1290,8 +1240,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 11 | Aggregate      | 15           |                |               |
-      | 15 | Filter         | 14           |                |               |
+      | 11 | Aggregate      | 14           |                |               |
       | 14 | CrossJoin      | 1,17         |                |               |
       | 1  | Unwind         | 2            |                |               |
       | 2  | Start          |              |                |               |
@@ -1318,8 +1267,7 @@ Feature: Match By Variable
       | 2 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -1345,8 +1293,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 18           |                |               |
-      | 18 | Filter         | 17           |                |               |
+      | 14 | Aggregate      | 17           |                |               |
       | 17 | CrossJoin      | 6,21         |                |               |
       | 6  | Project        | 22           |                |               |
       | 22 | AppendVertices | 2            |                |               |
@@ -1373,8 +1320,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -1400,8 +1346,7 @@ Feature: Match By Variable
       | 2 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 23           |                |               |
       | 23 | AppendVertices | 2            |                |               |
@@ -1429,8 +1374,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 23           |                |               |
       | 23 | AppendVertices | 2            |                |               |
@@ -1460,8 +1404,7 @@ Feature: Match By Variable
       | 40 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -1487,8 +1430,7 @@ Feature: Match By Variable
       | 6 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 18           |                |               |
-      | 18 | Filter         | 17           |                |               |
+      | 14 | Aggregate      | 17           |                |               |
       | 17 | CrossJoin      | 6,21         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 22           |                |               |
@@ -1515,8 +1457,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 16           |                |               |
@@ -1542,8 +1483,7 @@ Feature: Match By Variable
       | 18 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -1571,8 +1511,7 @@ Feature: Match By Variable
       | 6 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 15 | Aggregate      | 19           |                |               |
-      | 19 | Filter         | 18           |                |               |
+      | 15 | Aggregate      | 18           |                |               |
       | 18 | CrossJoin      | 6,22         |                |               |
       | 6  | Project        | 5            |                |               |
       | 5  | Filter         | 23           |                |               |
@@ -1622,8 +1561,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -1649,8 +1587,7 @@ Feature: Match By Variable
       | 0 |
     And the execution plan should be:
       | id | name           | dependencies | profiling data | operator info |
-      | 14 | Aggregate      | 13           |                |               |
-      | 13 | Filter         | 12           |                |               |
+      | 14 | Aggregate      | 12           |                |               |
       | 12 | CrossJoin      | 6,11         |                |               |
       | 6  | Project        | 16           |                |               |
       | 16 | AppendVertices | 2            |                |               |
@@ -399,6 +399,26 @@ Feature: single shortestPath
       | shortestPathLength |
       | -1                 |
 
+  Scenario: weighted shortestPath
+    When executing query:
+      """
+      MATCH p = shortestPath( (a:player{name:"Tiago Splitter"})-[e:like*..5]->(b:player{name:"LaMarcus Aldridge"}), likeness ) RETURN  p
+      """
+    Then the result should be, in any order, with relax comparison:
+      | p                                                                                                                                                                                                                                                                                                                                                                               |
+      | <("Tiago Splitter" :player{age: 34, name: "Tiago Splitter"})-[:like@0 {likeness: 80}]->("Tim Duncan" :bachelor{name: "Tim Duncan", speciality: "psychology"} :player{age: 42, name: "Tim Duncan"})-[:like@0 {likeness: 95}]->("Tony Parker" :player{age: 36, name: "Tony Parker"})-[:like@0 {likeness: 90}]->("LaMarcus Aldridge" :player{age: 33, name: "LaMarcus Aldridge"})> |
+    When executing query:
+      """
+      MATCH p = shortestPath( (a:player{name:"Tiago Splitter"})-[e:like*..2]->(b:player{name:"LaMarcus Aldridge"}), likeness ) RETURN  p
+      """
+    Then the result should be, in any order, with relax comparison:
+      | p |
+    When executing query:
+      """
+      MATCH p = shortestPath( (a:player{name:"Tiago Splitter"})-[e:like*..5]->(b:player{name:"LaMarcus Aldridge"}), age ) RETURN  p
+      """
+    Then a SemanticError should be raised at runtime: The weight `age' of shortestPath is not a property of `like'
+
   Scenario: single shortestPaths Can Not find index
     When executing query:
       """
@@ -0,0 +1,97 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Expand the distinct dst vertices by GetDstBySrc
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: Only the distinct dst vertices are returned
+    When profiling query:
+      """
+      MATCH (v)-[:like]->(f)
+      WHERE id(v) == "Tim Duncan"
+      RETURN DISTINCT f.player.name AS name
+      """
+    Then the result should be, in any order:
+      | name            |
+      | "Tony Parker"   |
+      | "Manu Ginobili" |
+    And the execution plan should be:
+      | id | name           | dependencies | operator info |
+      | 12 | Dedup          | 11           |               |
+      | 11 | Project        | 10           |               |
+      | 10 | AppendVertices | 9            |               |
+      | 9  | Expand         | 8            |               |
+      | 8  | Project        | 2            |               |
+      | 2  | Dedup          | 1            |               |
+      | 1  | PassThrough    | 3            |               |
+      | 3  | Start          |              |               |
+    When profiling query:
+      """
+      MATCH (v)<-[:like]-(f)
+      WHERE id(v) == "Tim Duncan"
+      RETURN DISTINCT id(f) AS id
+      """
+    Then the result should be, in any order:
+      | id                  |
+      | "Aron Baynes"       |
+      | "Boris Diaw"        |
+      | "Danny Green"       |
+      | "Dejounte Murray"   |
+      | "LaMarcus Aldridge" |
+      | "Manu Ginobili"     |
+      | "Marco Belinelli"   |
+      | "Shaquille O'Neal"  |
+      | "Tiago Splitter"    |
+      | "Tony Parker"       |
+    And the execution plan should be:
+      | id | name           | dependencies | operator info |
+      | 12 | Dedup          | 11           |               |
+      | 11 | Project        | 10           |               |
+      | 10 | AppendVertices | 9            |               |
+      | 9  | Expand         | 8            |               |
+      | 8  | Project        | 2            |               |
+      | 2  | Dedup          | 1            |               |
+      | 1  | PassThrough    | 3            |               |
+      | 3  | Start          |              |               |
+
+  Scenario: The edges or the vertices before are used
+    When profiling query:
+      """
+      MATCH (v)-[e:like]->(f)
+      WHERE id(v) == "Tim Duncan"
+      RETURN DISTINCT f.player.name AS name, e.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | name            | likeness |
+      | "Tony Parker"   | 95       |
+      | "Manu Ginobili" | 95       |
+    And the execution plan should be:
+      | id | name           | dependencies | operator info |
+      | 7  | Dedup          | 6            |               |
+      | 6  | Project        | 5            |               |
+      | 5  | AppendVertices | 4            |               |
+      | 4  | Traverse       | 2            |               |
+      | 2  | Dedup          | 1            |               |
+      | 1  | PassThrough    | 3            |               |
+      | 3  | Start          |              |               |
+    When profiling query:
+      """
+      MATCH (v)-[:like]->(f)
+      WHERE id(v) == "Tim Duncan"
+      RETURN DISTINCT v.player.name AS src, f.player.name AS name
+      """
+    Then the result should be, in any order:
+      | src          | name            |
+      | "Tim Duncan" | "Tony Parker"   |
+      | "Tim Duncan" | "Manu Ginobili" |
+    And the execution plan should be:
+      | id | name           | dependencies | operator info |
+      | 7  | Dedup          | 6            |               |
+      | 6  | Project        | 5            |               |
+      | 5  | AppendVertices | 4            |               |
+      | 4  | Traverse       | 2            |               |
+      | 2  | Dedup          | 1            |               |
+      | 1  | PassThrough    | 3            |               |
+      | 3  | Start          |              |               |
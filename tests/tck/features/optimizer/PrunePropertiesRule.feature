@@ -435,6 +435,24 @@ Feature: Prune Properties rule
       | 2  | Dedup          | 1            |                                                                                                                                                                                                                            |
       | 1  | PassThrough    | 3            |                                                                                                                                                                                                                            |
       | 3  | Start          |              |                                                                                                                                                                                                                            |
+    When profiling query:
+      """
+      MATCH (v1)-[:like]->(v2)
+      WHERE id(v1) == "Tim Duncan"
+      RETURN size(labels(v1)) AS n, v2.player.name AS name
+      """
+    Then the result should be, in any order:
+      | n | name            |
+      | 2 | "Tony Parker"   |
+      | 2 | "Manu Ginobili" |
+    And the execution plan should be:
+      | id | name           | dependencies | operator info                                                                                                                                                       |
+      | 6  | Project        | 5            |                                                                                                                                                                     |
+      | 5  | AppendVertices | 4            | {  "props": "[{\"props\":[\"name\"] }]" }                                                                                                                           |
+      | 4  | Traverse       | 2            | {"vertexProps": "[{\"props\":[\"_tag\"] }, {\"props\":[\"_tag\"] }, {\"props\":[\"_tag\"] }]" , "edgeProps": "[{  \"props\": [\"_type\", \"_rank\", \"_dst\"]}]"  } |
+      | 2  | Dedup          | 1            |                                                                                                                                                                     |
+      | 1  | PassThrough    | 3            |                                                                                                                                                                     |
+      | 3  | Start          |              |                                                                                                                                                                     |
     When profiling query:
       """
       MATCH (v1)-[e:like*1..5]->(v2)
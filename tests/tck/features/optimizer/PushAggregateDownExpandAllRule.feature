@@ -0,0 +1,44 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Push Aggregate down ExpandAll rule
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: aggregate the edges of each src vertex in storage
+    When profiling query:
+      """
+      GO FROM "Tim Duncan", "Tony Parker" OVER serve
+      YIELD serve._src AS s, serve.start_year AS y |
+      GROUP BY $-.s YIELD $-.s AS s, count(*) AS c, sum($-.y) AS y
+      """
+    Then the result should be, in any order:
+      | s             | c | y    |
+      | "Tim Duncan"  | 1 | 1997 |
+      | "Tony Parker" | 2 | 4017 |
+    And the execution plan should be:
+      | id | name         | dependencies | operator info         |
+      | 6  | Project      | 7            |                       |
+      | 7  | GetNeighbors | 2            | {"statsOnly": "true"} |
+      | 2  | Expand       | 1            |                       |
+      | 1  | Start        |              |                       |
+
+  Scenario: not push the aggregate of other keys
+    When profiling query:
+      """
+      GO FROM "Tim Duncan", "Tony Parker" OVER serve
+      YIELD serve._dst AS d, serve.start_year AS y |
+      GROUP BY $-.d YIELD $-.d AS d, count(*) AS c
+      """
+    Then the result should be, in any order:
+      | d         | c |
+      | "Spurs"   | 2 |
+      | "Hornets" | 1 |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info |
+      | 5  | Aggregate | 4            |               |
+      | 4  | Project   | 3            |               |
+      | 3  | ExpandAll | 2            |               |
+      | 2  | Expand    | 1            |               |
+      | 1  | Start     |              |               |
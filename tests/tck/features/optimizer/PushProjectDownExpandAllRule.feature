@@ -0,0 +1,58 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Push Project down ExpandAll rule
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: prune the src props used by the filter pushed down only
+    When profiling query:
+      """
+      GO 1 STEPS FROM "Boris Diaw" OVER serve
+      WHERE $^.player.age > 18
+      YIELD serve.start_year as start_year
+      """
+    Then the result should be, in any order:
+      | start_year |
+      | 2003       |
+      | 2005       |
+      | 2008       |
+      | 2012       |
+      | 2016       |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info                                       |
+      | 5  | Project   | 6            |                                                     |
+      | 6  | ExpandAll | 2            | {"filter": "($^.player.age>18)", "vertexProps": ""} |
+      | 2  | Expand    | 1            |                                                     |
+      | 1  | Start     |              |                                                     |
+
+  Scenario: prune the edge props used by the filter pushed down only
+    When profiling query:
+      """
+      GO FROM "Tony Parker" OVER like
+      WHERE like.likeness > 90
+      YIELD like._dst AS dst, $^.player.name AS name
+      """
+    Then the result should be, in any order:
+      | dst             | name          |
+      | "Manu Ginobili" | "Tony Parker" |
+      | "Tim Duncan"    | "Tony Parker" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info                    |
+      | 5  | Project   | 6            |                                  |
+      | 6  | ExpandAll | 2            | {"filter": "(like.likeness>90)"} |
+      | 2  | Expand    | 1            |                                  |
+      | 1  | Start     |              |                                  |
+
+  Scenario: keep the props returned
+    When profiling query:
+      """
+      GO FROM "Tony Parker" OVER like
+      WHERE like.likeness > 90
+      YIELD like._dst AS dst, like.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | dst             | likeness |
+      | "Manu Ginobili" | 95       |
+      | "Tim Duncan"    | 95       |
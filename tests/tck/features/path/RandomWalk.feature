@@ -0,0 +1,69 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Random walk
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: invalid options
+    When executing query:
+      """
+      RANDOM WALK 0 STEPS FROM "Tim Duncan" OVER like
+      """
+    Then a SemanticError should be raised at runtime: The steps of random walk should be greater than 0.
+    When executing query:
+      """
+      RANDOM WALK 2 STEPS FROM "Tim Duncan" OVER like WITH {walks: 0}
+      """
+    Then a SemanticError should be raised at runtime: `walks: 0', expected an integer in [1, 1000].
+    When executing query:
+      """
+      RANDOM WALK 2 STEPS FROM "Tim Duncan" OVER like WITH {p: 0}
+      """
+    Then a SemanticError should be raised at runtime: `p: 0', expected a positive number.
+    When executing query:
+      """
+      RANDOM WALK 2 STEPS FROM "Tim Duncan" OVER like WITH {r: 1}
+      """
+    Then a SemanticError should be raised at runtime: Unknown option `r' of random walk.
+
+  Scenario: uniform random walk
+    When executing query:
+      """
+      RANDOM WALK 3 STEPS FROM "Tim Duncan" OVER serve WITH {walks: 2}
+      """
+    Then the result should be, in any order:
+      | walk                    |
+      | ["Tim Duncan", "Spurs"] |
+      | ["Tim Duncan", "Spurs"] |
+    When executing query:
+      """
+      RANDOM WALK 2 STEPS FROM "Tim Duncan" OVER serve REVERSELY
+      """
+    Then the result should be, in any order:
+      | walk           |
+      | ["Tim Duncan"] |
+    When executing query:
+      """
+      GO FROM "Tim Duncan" OVER serve YIELD dst(edge) AS id |
+      RANDOM WALK 1 STEPS FROM $-.id OVER serve REVERSELY WITH {walks: 3} |
+      YIELD size($-.walk) AS len, $-.walk[0] AS start
+      """
+    Then the result should be, in any order:
+      | len | start   |
+      | 2   | "Spurs" |
+      | 2   | "Spurs" |
+      | 2   | "Spurs" |
+
+  Scenario: biased random walk
+    When executing query:
+      """
+      RANDOM WALK 4 STEPS FROM "Tim Duncan" OVER like BIDIRECT WITH {walks: 3, p: 2.0, q: 0.5} |
+      YIELD size($-.walk) AS len, $-.walk[0] AS start
+      """
+    Then the result should be, in any order:
+      | len | start        |
+      | 5   | "Tim Duncan" |
+      | 5   | "Tim Duncan" |
+      | 5   | "Tim Duncan" |
@@ -16,6 +16,9 @@ extern "C" GraphFunction *create() {
 extern "C" void destroy(GraphFunction *function) {
   delete function;
 }
+extern "C" GraphBatchFunction *createBatch() {
+  return new standard_deviation;
+}
 
 char *standard_deviation::name() {
   const char *name = "standard_deviation";
@@ -89,3 +92,15 @@ nebula::Value standard_deviation::body(
     }
   }
 }
+
+nebula::Column standard_deviation::bodyBatch(const std::vector<const nebula::Column *> &args,
+                                             size_t size) {
+  // The lists are boxed, the numeric columns could be read by ints() or floats() instead
+  const auto &lists = *args[0];
+  nebula::Column result;
+  for (size_t i = 0; i < size; i++) {
+    auto list = lists.value(i);
+    result.append(body({std::cref(list)}));
+  }
+  return result;
+}
@@ -40,7 +40,9 @@
 // | 2.357022603955158        |
 // +--------------------------+
 
-class standard_deviation : public GraphFunction {
+// It's also a batch function, so all the rows of a projection are evaluated by one call of
+// bodyBatch.
+class standard_deviation : public GraphBatchFunction {
  public:
   char *name() override;
 
@@ -55,6 +57,8 @@ class standard_deviation : public GraphFunction {
   bool isPure() override;
 
   nebula::Value body(const std::vector<std::reference_wrapper<const nebula::Value>> &args) override;
+
+  nebula::Column bodyBatch(const std::vector<const nebula::Column *> &args, size_t size) override;
 };
 
 #endif  // UDF_PROJECT_STANDARD_DEVIATION_H